@@ -5,10 +5,17 @@
 # SPDX-License-Identifier: BSD-3-Clause
 #
 
+BS_LIB_SOURCES_$(BS_ARCH_ARCH) += arch_cache.c
+BS_LIB_SOURCES_$(BS_ARCH_ARCH) += arch_dwt.c
 BS_LIB_SOURCES_$(BS_ARCH_ARCH) += arch_exceptions.c
 BS_LIB_SOURCES_$(BS_ARCH_ARCH) += arch_handlers.c
 BS_LIB_SOURCES_$(BS_ARCH_ARCH) += arch_main.c
 BS_LIB_SOURCES_$(BS_ARCH_ARCH) += arch_nvic.c
+BS_LIB_SOURCES_$(BS_ARCH_ARCH) += arch_task.c
+
+ifeq ($(BS_FIRMWARE_HAS_MULTITHREADING),yes)
+    BS_LIB_SOURCES_$(BS_ARCH_ARCH) += arch_tickless.c
+endif
 
 BS_LIB_SOURCES_$(BS_ARCH_ARCH) := $(addprefix $(ARCH_DIR)/$(BS_ARCH_VENDOR)/$(BS_ARCH_ARCH)/src/,$(BS_LIB_SOURCES_$(BS_ARCH_ARCH)))
 
@@ -0,0 +1,28 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_CACHE_H
+#define ARCH_CACHE_H
+
+#include <fwk_cache.h>
+
+/*!
+ * \brief Enable the caches and get a cache driver maintaining the data cache.
+ *
+ * \details The instruction and data caches the core implements are enabled,
+ *      and the driver is returned from the firmware's ::fmw_cache_driver().
+ *      When the core does not implement a data cache, no driver is returned.
+ *
+ *      The memory shared with other agents must then either be mapped
+ *      non-cacheable by the MPU or be maintained through the framework cache
+ *      maintenance functions by the modules accessing it.
+ *
+ * \return Cache driver.
+ */
+struct fwk_cache_driver arch_cache_driver(void);
+
+#endif /* ARCH_CACHE_H */
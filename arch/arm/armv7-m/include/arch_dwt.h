@@ -0,0 +1,32 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_DWT_H
+#define ARCH_DWT_H
+
+#include <fwk_time.h>
+
+#include <stdint.h>
+
+/*!
+ * \brief Get a profiling time driver backed by the DWT cycle counter.
+ *
+ * \details The cycle counter is enabled and the driver is returned from the
+ *      firmware's ::fmw_time_profile_driver(). When the core does not
+ *      implement the cycle counter, no driver is returned and the profiling
+ *      clock falls back to the framework time driver.
+ *
+ * \param[out] ctx Context of the driver.
+ * \param[in] frequency Frequency of the core clock, in Hertz.
+ *
+ * \return Profiling time driver.
+ */
+struct fwk_time_profile_driver arch_dwt_profile_driver(
+    const void **ctx,
+    uint32_t frequency);
+
+#endif /* ARCH_DWT_H */
@@ -29,6 +29,12 @@
  *      In this configuration MEM0 represents the RAM region attached to the
  *      instruction bus and MEM1 represents the RAM region attached to the data
  *      bus.
+ *
+ * In all layouts, the firmware may also define an instruction tightly-coupled
+ * memory (ITCM) region with FMW_ITCM_BASE and FMW_ITCM_SIZE. The functions
+ * marked with FWK_HOT are then loaded with the rest of the code and copied to
+ * this region at boot, and run from it. Without this region they run from
+ * MEM0 with the rest of the code.
  */
 
 #ifndef ARCH_SCATTER_H
@@ -72,4 +78,13 @@
 #    define ARCH_MEM1_LIMIT (FMW_MEM1_BASE + FMW_MEM1_SIZE)
 #endif
 
+#if defined(FMW_ITCM_BASE) != defined(FMW_ITCM_SIZE)
+#    error "FMW_ITCM_BASE and FMW_ITCM_SIZE must be configured together"
+#endif
+
+#ifdef FMW_ITCM_BASE
+#    define ARCH_HAS_ITCM 1
+#    define ARCH_ITCM_LIMIT (FMW_ITCM_BASE + FMW_ITCM_SIZE)
+#endif
+
 #endif /* ARCH_SCATTER_H */
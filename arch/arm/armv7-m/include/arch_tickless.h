@@ -0,0 +1,34 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_TICKLESS_H
+#define ARCH_TICKLESS_H
+
+#include <stdint.h>
+
+/*!
+ * \brief Sleep with the kernel tick suppressed.
+ *
+ * \details This function is meant to be called by the idle thread of the RTOS
+ *      between `osKernelSuspend()` and `osKernelResume()`. The SysTick timer,
+ *      stopped by the kernel, is reprogrammed to expire once the given number
+ *      of ticks have elapsed, and the core waits for it or for any other
+ *      interrupt, e.g. an alarm of the timer module, whichever comes first.
+ *
+ * \note The part of the tick the sleep ended in is not accounted for, so the
+ *      kernel time lags behind by up to one tick every time the sleep is
+ *      ended early by another interrupt.
+ *
+ * \param ticks Number of ticks until the next kernel timeout, as returned by
+ *      `osKernelSuspend()`. The sleep is limited to the longest period the
+ *      SysTick timer can count.
+ *
+ * \return Number of whole ticks elapsed, to be passed to `osKernelResume()`.
+ */
+uint32_t arch_tickless_sleep(uint32_t ticks);
+
+#endif /* ARCH_TICKLESS_H */
@@ -0,0 +1,76 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Cache enablement and maintenance.
+ */
+
+#include <arch_cache.h>
+
+#include <fwk_cache.h>
+
+#include <fmw_cmsis.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+/* Size of the data cache lines of the Cortex-M7 */
+#    define ARCH_CACHE_LINE_SIZE 32U
+
+/*
+ * The maintenance by address operates on whole lines, so the range is extended
+ * to the lines it overlaps.
+ */
+static void arch_cache_align(uintptr_t *address, size_t *size)
+{
+    uintptr_t start = *address & ~(uintptr_t)(ARCH_CACHE_LINE_SIZE - 1);
+    uintptr_t end = *address + *size;
+
+    *address = start;
+    *size = (end - start + ARCH_CACHE_LINE_SIZE - 1) &
+        ~(size_t)(ARCH_CACHE_LINE_SIZE - 1);
+}
+
+static void arch_cache_clean(uintptr_t address, size_t size)
+{
+    arch_cache_align(&address, &size);
+
+    SCB_CleanDCache_by_Addr((uint32_t *)address, (int32_t)size);
+}
+
+/*
+ * The lines at the ends of the range may hold data outside of it, which a
+ * plain invalidation would lose, hence they are also cleaned.
+ */
+static void arch_cache_invalidate(uintptr_t address, size_t size)
+{
+    arch_cache_align(&address, &size);
+
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t *)address, (int32_t)size);
+}
+#endif
+
+struct fwk_cache_driver arch_cache_driver(void)
+{
+#if defined(__ICACHE_PRESENT) && (__ICACHE_PRESENT == 1U)
+    SCB_EnableICache();
+#endif
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_EnableDCache();
+
+    return (struct fwk_cache_driver){
+        .clean = arch_cache_clean,
+        .invalidate = arch_cache_invalidate,
+    };
+#else
+    return (struct fwk_cache_driver){
+        .clean = NULL,
+        .invalidate = NULL,
+    };
+#endif
+}
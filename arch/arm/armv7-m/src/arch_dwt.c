@@ -0,0 +1,47 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Cycle counter profiling clock.
+ */
+
+#include <arch_dwt.h>
+
+#include <fwk_time.h>
+
+#include <fmw_cmsis.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+static uint32_t arch_dwt_cycles(const void *ctx)
+{
+    return DWT->CYCCNT;
+}
+
+struct fwk_time_profile_driver arch_dwt_profile_driver(
+    const void **ctx,
+    uint32_t frequency)
+{
+    *ctx = NULL;
+
+    /* The trace block must be enabled for the DWT registers to be accessed */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    if ((DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) != 0) {
+        return (struct fwk_time_profile_driver){
+            .cycles = NULL,
+        };
+    }
+
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    return (struct fwk_time_profile_driver){
+        .cycles = arch_dwt_cycles,
+        .frequency = frequency,
+    };
+}
@@ -28,6 +28,9 @@
  */
 void software_init_hook(void)
 {
+    extern char __tcm_text_load__;
+    extern char __tcm_text_start__;
+    extern char __tcm_text_end__;
     extern char __data_load__;
     extern char __data_start__;
     extern char __data_end__;
@@ -38,6 +41,18 @@ void software_init_hook(void)
 
     if (load != start)
         memcpy(start, load, end - start);
+
+    load = &__tcm_text_load__;
+    start = &__tcm_text_start__;
+    end = &__tcm_text_end__;
+
+    if (load != start) {
+        memcpy(start, load, end - start);
+
+        /* Make sure the hot code is visible to instruction fetches */
+        __DSB();
+        __ISB();
+    }
 }
 #endif
 
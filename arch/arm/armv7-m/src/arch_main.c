@@ -12,6 +12,7 @@
 #include <fwk_macros.h>
 
 #include <arch_nvic.h>
+#include <arch_task.h>
 
 #include <fmw_cmsis.h>
 
@@ -27,8 +28,18 @@ void _exit(int status)
 }
 #endif
 
+#ifdef __NEWLIB__
+extern int arch_mm_init(const struct fwk_arch_mm_driver **driver);
+#endif
+
 static const struct fwk_arch_init_driver arch_init_driver = {
     .interrupt = arch_nvic_init,
+#ifdef __NEWLIB__
+    .mm = arch_mm_init,
+#endif
+#ifndef BUILD_HAS_MULTITHREADING
+    .task = arch_task_init,
+#endif
 };
 
 static void arch_init_ccr(void)
@@ -200,6 +200,49 @@ static int get_current(unsigned int *interrupt)
     return FWK_SUCCESS;
 }
 
+static int get_current_priority(unsigned int *priority)
+{
+    unsigned int exception = __get_IPSR();
+
+    /* Not an interrupt */
+    if (exception == 0)
+        return FWK_E_STATE;
+
+    /* The NMI and the hard fault have fixed, negative priorities */
+    if (exception <= (NVIC_USER_IRQ_OFFSET + HardFault_IRQn))
+        return FWK_E_SUPPORT;
+
+    *priority = NVIC_GetPriority(
+        (IRQn_Type)((int)exception - (int)NVIC_USER_IRQ_OFFSET));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Priority levels are masked through BASEPRI, which holds a priority value
+ * aligned on the most significant bits, and masks the exceptions of that
+ * priority value and above. A value of zero masks nothing.
+ */
+static int mask_priority(unsigned int priority, unsigned int *state)
+{
+    if ((priority == 0) || (priority >= (1U << __NVIC_PRIO_BITS)))
+        return FWK_E_PARAM;
+
+    *state = __get_BASEPRI();
+
+    /* Only ever raise the masking, as nested callers expect */
+    __set_BASEPRI_MAX(priority << (8U - __NVIC_PRIO_BITS));
+
+    return FWK_SUCCESS;
+}
+
+static int unmask_priority(unsigned int state)
+{
+    __set_BASEPRI(state);
+
+    return FWK_SUCCESS;
+}
+
 static const struct fwk_arch_interrupt_driver arch_nvic_driver = {
     .global_enable = global_enable,
     .global_disable = global_disable,
@@ -215,6 +258,9 @@ static const struct fwk_arch_interrupt_driver arch_nvic_driver = {
     .set_isr_nmi_param = set_isr_nmi_param,
     .set_isr_fault = set_isr_fault,
     .get_current = get_current,
+    .get_current_priority = get_current_priority,
+    .mask_priority = mask_priority,
+    .unmask_priority = unmask_priority,
 };
 
 static void irq_invalid(void)
@@ -0,0 +1,89 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Task context switching.
+ */
+
+#include <arch_task.h>
+
+#include <fwk_arch.h>
+#include <fwk_macros.h>
+#include <fwk_status.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * A context is the stack pointer of a suspended flow, below which the callee-
+ * saved registers are pushed: s16-s31 when the floating-point registers are
+ * used, then r4-r12 and the return address. r12 keeps the stack pointer
+ * aligned on a double word boundary, as required by the AAPCS.
+ */
+#if defined(__ARM_FP) && !defined(__SOFTFP__)
+#    define ARCH_TASK_FP_REG_COUNT 16
+#else
+#    define ARCH_TASK_FP_REG_COUNT 0
+#endif
+
+#define ARCH_TASK_CORE_REG_COUNT 10
+
+#define ARCH_TASK_FRAME_SIZE \
+    ((ARCH_TASK_FP_REG_COUNT + ARCH_TASK_CORE_REG_COUNT) * sizeof(uint32_t))
+
+static int create(
+    void *stack,
+    size_t stack_size,
+    void (*entry)(void),
+    void **context)
+{
+    uintptr_t top;
+    uint32_t *frame;
+
+    if (stack_size < (2 * ARCH_TASK_FRAME_SIZE))
+        return FWK_E_PARAM;
+
+    top = ((uintptr_t)stack + stack_size) & ~(uintptr_t)0x7;
+    frame = (uint32_t *)(top - ARCH_TASK_FRAME_SIZE);
+
+    /* The first switch to the context returns into the entry function */
+    memset(frame, 0, ARCH_TASK_FRAME_SIZE);
+    frame[ARCH_TASK_FP_REG_COUNT + ARCH_TASK_CORE_REG_COUNT - 1] =
+        (uint32_t)entry;
+
+    *context = frame;
+
+    return FWK_SUCCESS;
+}
+
+static __attribute__((naked)) void switch_to(void **current, void *next)
+{
+    __asm__ volatile(
+        "push {r4-r12, lr}\n"
+#if ARCH_TASK_FP_REG_COUNT > 0
+        "vpush {s16-s31}\n"
+#endif
+        "mov r2, sp\n"
+        "str r2, [r0]\n"
+        "mov sp, r1\n"
+#if ARCH_TASK_FP_REG_COUNT > 0
+        "vpop {s16-s31}\n"
+#endif
+        "pop {r4-r12, pc}\n");
+}
+
+static const struct fwk_arch_task_driver arch_task_driver = {
+    .create = create,
+    .switch_to = switch_to,
+};
+
+int arch_task_init(const struct fwk_arch_task_driver **driver)
+{
+    *driver = &arch_task_driver;
+
+    return FWK_SUCCESS;
+}
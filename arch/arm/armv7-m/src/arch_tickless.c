@@ -0,0 +1,67 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Tickless idle support for the RTOS.
+ */
+
+#include <arch_tickless.h>
+
+#include <fwk_macros.h>
+
+#include <fmw_cmsis.h>
+
+#include <stdint.h>
+
+uint32_t arch_tickless_sleep(uint32_t ticks)
+{
+    uint32_t reload = SysTick->LOAD;
+    uint32_t tick_cycles = reload + 1;
+    uint32_t sleep_cycles;
+    uint32_t ctrl;
+    uint32_t value;
+    uint32_t elapsed;
+
+    ticks = FWK_MIN(ticks, SysTick_LOAD_RELOAD_Msk / tick_cycles);
+    if (ticks == 0)
+        return 0;
+
+    sleep_cycles = ticks * tick_cycles;
+
+    /*
+     * The SysTick exception must not be taken while the kernel is suspended,
+     * as it would advance the kernel time. With interrupts masked, pending
+     * interrupts still end the sleep, and they are taken once the elapsed
+     * time has been accounted for.
+     */
+    __disable_irq();
+
+    SysTick->LOAD = sleep_cycles - 1;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    __DSB();
+    __WFI();
+
+    /* Reading the control register clears the count flag */
+    ctrl = SysTick->CTRL;
+    value = SysTick->VAL;
+    SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+    if ((ctrl & SysTick_CTRL_COUNTFLAG_Msk) != 0)
+        elapsed = ticks;
+    else
+        elapsed = (sleep_cycles - 1 - value) / tick_cycles;
+
+    /* Restore the kernel tick, which the kernel restarts when resumed */
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0;
+
+    __enable_irq();
+
+    return elapsed;
+}
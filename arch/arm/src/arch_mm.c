@@ -8,7 +8,9 @@
  *     Memory initialization.
  */
 
+#include <fwk_arch.h>
 #include <fwk_macros.h>
+#include <fwk_status.h>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -23,6 +25,15 @@
 
 extern char __stackheap_start__;
 extern char __stackheap_end__;
+extern char __reclaim_start__;
+extern char __reclaim_end__;
+
+/*
+ * Pattern painted over the unused part of the stack and heap region, and
+ * distance kept from the live stack while painting it.
+ */
+#    define ARCH_MM_STACK_PAINT 0xA5A5A5A5UL
+#    define ARCH_MM_STACK_PAINT_GUARD 256
 
 /*!
  * \brief Architecture memory manager context.
@@ -32,8 +43,14 @@ static struct arch_mm_ctx {
      * \brief Current heap break address.
      */
     uintptr_t heap_break;
+
+    /*!
+     * \brief Highest heap break address reached.
+     */
+    uintptr_t heap_break_max;
 } arch_mm_ctx = {
     .heap_break = ((uintptr_t)&__stackheap_start__),
+    .heap_break_max = ((uintptr_t)&__stackheap_start__),
 };
 
 int posix_memalign(void **memptr, size_t alignment, size_t size)
@@ -74,9 +91,77 @@ void *_sbrk(intptr_t increment)
             return (void *)-1;
         } else {
             arch_mm_ctx.heap_break = heap_new;
+            if (heap_new > arch_mm_ctx.heap_break_max)
+                arch_mm_ctx.heap_break_max = heap_new;
 
             return (void *)heap_old;
         }
     }
 }
+
+static int arch_mm_get_high_water(size_t *heap_size, size_t *stack_size)
+{
+    const uint32_t *word;
+    uintptr_t stack_end = (uintptr_t)&__stackheap_end__;
+
+    /*
+     * The stack grows down towards the heap, so its deepest point is the
+     * first word above the heap that no longer holds the paint pattern.
+     */
+    word = (const uint32_t *)FWK_ALIGN_NEXT(
+        arch_mm_ctx.heap_break, sizeof(uint32_t));
+    while (((uintptr_t)word < stack_end) && (*word == ARCH_MM_STACK_PAINT))
+        word++;
+
+    *heap_size =
+        arch_mm_ctx.heap_break_max - (uintptr_t)&__stackheap_start__;
+    *stack_size = stack_end - (uintptr_t)word;
+
+    return FWK_SUCCESS;
+}
+
+static int arch_mm_get_reclaimable(void **base, size_t *size)
+{
+    uintptr_t start = (uintptr_t)&__reclaim_start__;
+    uintptr_t end = (uintptr_t)&__reclaim_end__;
+
+    /* The init-only sections are only gathered in writable memory */
+    if (end == start)
+        return FWK_E_SUPPORT;
+
+    *base = (void *)start;
+    *size = end - start;
+
+    return FWK_SUCCESS;
+}
+
+static const struct fwk_arch_mm_driver arch_mm_driver = {
+    .get_high_water = arch_mm_get_high_water,
+    .get_reclaimable = arch_mm_get_reclaimable,
+};
+
+int arch_mm_init(const struct fwk_arch_mm_driver **driver)
+{
+    uint32_t *word;
+    uintptr_t stack_limit;
+
+    if (driver == NULL)
+        return FWK_E_PARAM;
+
+    /*
+     * Paint the region between the heap and the live stack so the stack
+     * high-water mark can be measured later on.
+     */
+    stack_limit = (uintptr_t)__builtin_frame_address(0) -
+        ARCH_MM_STACK_PAINT_GUARD;
+
+    word = (uint32_t *)FWK_ALIGN_NEXT(
+        arch_mm_ctx.heap_break, sizeof(uint32_t));
+    for (; (uintptr_t)word < stack_limit; word++)
+        *word = ARCH_MM_STACK_PAINT;
+
+    *driver = &arch_mm_driver;
+
+    return FWK_SUCCESS;
+}
 #endif
@@ -0,0 +1,24 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_TASK_H
+#define ARCH_TASK_H
+
+#include <fwk_arch.h>
+
+/*!
+ * \brief Initialize the architecture task component.
+ *
+ * \param[out] driver Pointer to the task driver.
+ *
+ * \retval ::FWK_SUCCESS The operation succeeded.
+ *
+ * \return Status code representing the result of the operation.
+ */
+int arch_task_init(const struct fwk_arch_task_driver **driver);
+
+#endif /* ARCH_TASK_H */
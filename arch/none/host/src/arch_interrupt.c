@@ -6,57 +6,168 @@
  *
  * Description:
  *     Interrupt management.
+ *
+ *     The host has no interrupt controller, so one is emulated: an interrupt
+ *     set pending by the firmware is handled as soon as it is enabled, the
+ *     interrupts are globally enabled and no other interrupt is being handled.
+ *     Interrupts therefore only preempt the firmware at the points where it
+ *     raises or unmasks them, which keeps the execution deterministic.
  */
 
 #include <fwk_arch.h>
+#include <fwk_interrupt.h>
 #include <fwk_status.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+/* Number of emulated interrupt lines */
+#define ARCH_INTERRUPT_COUNT 32
+
+struct arch_interrupt_line {
+    /* Handler taking no parameter, if any */
+    void (*isr)(void);
+
+    /* Handler taking a parameter, if any */
+    void (*isr_param)(uintptr_t param);
+
+    /* Parameter given to the handler */
+    uintptr_t param;
+
+    /* Whether the interrupt is enabled */
+    bool enabled;
+
+    /* Whether the interrupt is pending */
+    bool pending;
+};
+
+static struct arch_interrupt_line line_table[ARCH_INTERRUPT_COUNT];
+
+/* Whether the interrupts are globally enabled */
+static bool globally_enabled = true;
+
+/* Interrupt being handled, FWK_INTERRUPT_NONE outside of any handler */
+static unsigned int current = FWK_INTERRUPT_NONE;
+
+/* Handle the pending interrupts that are allowed to run, lowest line first */
+static void dispatch(void)
+{
+    struct arch_interrupt_line *line;
+    unsigned int interrupt;
+
+    if (current != FWK_INTERRUPT_NONE)
+        return;
+
+    interrupt = 0;
+    while (globally_enabled && (interrupt < ARCH_INTERRUPT_COUNT)) {
+        line = &line_table[interrupt];
+
+        if (!line->enabled || !line->pending) {
+            interrupt++;
+            continue;
+        }
+
+        line->pending = false;
+
+        current = interrupt;
+        if (line->isr_param != NULL)
+            line->isr_param(line->param);
+        else if (line->isr != NULL)
+            line->isr();
+        current = FWK_INTERRUPT_NONE;
+
+        /* The handler may have raised interrupts on lower lines */
+        interrupt = 0;
+    }
+}
+
 static int global_enable(void)
 {
-    return FWK_E_SUPPORT;
+    globally_enabled = true;
+    dispatch();
+
+    return FWK_SUCCESS;
 }
 
 static int global_disable(void)
 {
-    return FWK_E_SUPPORT;
+    globally_enabled = false;
+
+    return FWK_SUCCESS;
 }
 
 static int is_enabled(unsigned int interrupt, bool *state)
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= ARCH_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    *state = line_table[interrupt].enabled;
+
+    return FWK_SUCCESS;
 }
 
 static int enable(unsigned int interrupt)
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= ARCH_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    line_table[interrupt].enabled = true;
+    dispatch();
+
+    return FWK_SUCCESS;
 }
 
 static int disable(unsigned int interrupt)
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= ARCH_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    line_table[interrupt].enabled = false;
+
+    return FWK_SUCCESS;
 }
 
 static int is_pending(unsigned int interrupt, bool *state)
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= ARCH_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    *state = line_table[interrupt].pending;
+
+    return FWK_SUCCESS;
 }
 
 static int set_pending(unsigned int interrupt)
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= ARCH_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    line_table[interrupt].pending = true;
+    dispatch();
+
+    return FWK_SUCCESS;
 }
 
 static int clear_pending(unsigned int interrupt)
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= ARCH_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    line_table[interrupt].pending = false;
+
+    return FWK_SUCCESS;
 }
 
 static int set_isr_irq(unsigned int interrupt, void (*isr)(void))
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= ARCH_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    line_table[interrupt].isr = isr;
+    line_table[interrupt].isr_param = NULL;
+
+    return FWK_SUCCESS;
 }
 
 static int set_isr_irq_param(
@@ -64,7 +175,14 @@ static int set_isr_irq_param(
     void (*isr)(uintptr_t param),
     uintptr_t parameter)
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= ARCH_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    line_table[interrupt].isr = NULL;
+    line_table[interrupt].isr_param = isr;
+    line_table[interrupt].param = parameter;
+
+    return FWK_SUCCESS;
 }
 
 static int set_isr_nmi(void (*isr)(void))
@@ -84,7 +202,13 @@ static int set_isr_fault(void (*isr)(void))
 
 static int get_current(unsigned int *interrupt)
 {
-    return FWK_E_SUPPORT;
+    /* Not an interrupt */
+    if (current == FWK_INTERRUPT_NONE)
+        return FWK_E_STATE;
+
+    *interrupt = current;
+
+    return FWK_SUCCESS;
 }
 
 static const struct fwk_arch_interrupt_driver driver = {
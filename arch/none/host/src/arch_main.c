@@ -10,6 +10,7 @@
 #include <fwk_status.h>
 
 #include <arch_interrupt.h>
+#include <arch_task.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -25,6 +26,9 @@ static noreturn void panic(void)
 
 static const struct fwk_arch_init_driver arch_init_driver = {
     .interrupt = arch_interrupt_init,
+#ifndef BUILD_HAS_MULTITHREADING
+    .task = arch_task_init,
+#endif
 };
 
 int main(void)
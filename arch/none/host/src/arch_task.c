@@ -0,0 +1,74 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Task context switching, backed by the ucontext functions.
+ */
+
+#include <arch_task.h>
+
+#include <fwk_arch.h>
+#include <fwk_macros.h>
+#include <fwk_status.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <ucontext.h>
+
+/* Context of the thread, which runs on the process stack */
+static ucontext_t thread_context;
+
+static int create(
+    void *stack,
+    size_t stack_size,
+    void (*entry)(void),
+    void **context)
+{
+    uintptr_t base;
+    ucontext_t *ucontext;
+
+    /* The context is kept at the bottom of the stack it runs on */
+    base = FWK_ALIGN_NEXT((uintptr_t)stack, _Alignof(ucontext_t));
+    if ((base + sizeof(ucontext_t)) >= ((uintptr_t)stack + stack_size))
+        return FWK_E_PARAM;
+
+    ucontext = (ucontext_t *)base;
+
+    if (getcontext(ucontext) != 0)
+        return FWK_E_PANIC;
+
+    ucontext->uc_stack.ss_sp = ucontext + 1;
+    ucontext->uc_stack.ss_size =
+        (uintptr_t)stack + stack_size - (uintptr_t)(ucontext + 1);
+    ucontext->uc_link = NULL;
+
+    makecontext(ucontext, entry, 0);
+
+    *context = ucontext;
+
+    return FWK_SUCCESS;
+}
+
+static void switch_to(void **current, void *next)
+{
+    /* The thread has no context until it first switches to a task */
+    if (*current == NULL)
+        *current = &thread_context;
+
+    swapcontext(*current, next);
+}
+
+static const struct fwk_arch_task_driver arch_task_driver = {
+    .create = create,
+    .switch_to = switch_to,
+};
+
+int arch_task_init(const struct fwk_arch_task_driver **driver)
+{
+    *driver = &arch_task_driver;
+
+    return FWK_SUCCESS;
+}
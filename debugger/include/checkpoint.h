@@ -7,6 +7,8 @@
 #ifndef CHECKPOINT_H
 #define CHECKPOINT_H
 
+#include <fwk_time.h>
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -33,6 +35,12 @@
  */
 #define CHECKPOINT_NUM 4
 
+/*!
+ * Number of hits kept in the trace ring, a power of two.
+ *
+ */
+#define CHECKPOINT_TRACE_LEN 64
+
 /*!
  * \brief Checkpoint bypass value.
  *
@@ -41,7 +49,9 @@ enum cp_bypass_value {
     /*! Stop execution when checkpoint is reached. */
     CHECKPOINT_ENABLED = 0,
     /*! Ignore checkpoint */
-    CHECKPOINT_DISABLED = -1
+    CHECKPOINT_DISABLED = -1,
+    /*! Record the hit in the trace ring and continue */
+    CHECKPOINT_TRACE = -2
 };
 
 /*!
@@ -62,8 +72,26 @@ typedef struct {
     volatile int32_t bypass;
     /*! Valid checkpoint in the checkpoint table */
     bool in_use;
+    /*! Number of hits recorded while tracing */
+    volatile uint32_t hits;
 } checkpoint_st;
 
+/*!
+ * \brief Checkpoint trace record
+ *
+ * \details A record is added to the trace ring each time a checkpoint in
+ *      tracing mode is reached.
+ *
+ */
+typedef struct {
+    /*! Index of the checkpoint in the checkpoint table */
+    uint32_t index;
+    /*! Line number of the checkpoint */
+    int32_t line;
+    /*! Profiling timestamp of the hit */
+    fwk_timestamp_t timestamp;
+} checkpoint_trace_st;
+
 /*!
  * \brief Disables all checkpoints in the system.
  *
@@ -78,6 +106,23 @@ void checkpoint_disable_all(void);
  */
 void checkpoint_enable_all(void);
 
+/*!
+ * \brief Copy a record of the trace ring.
+ *
+ * \param n Position of the record, 0 being the oldest record still held.
+ * \param[out] record Copy of the record.
+ * \retval true The record was copied.
+ * \retval false There are fewer than n + 1 records in the ring.
+ *
+ */
+bool checkpoint_trace_get(uint32_t n, checkpoint_trace_st *record);
+
+/*!
+ * \brief Empty the trace ring and reset the hit counts.
+ *
+ */
+void checkpoint_trace_clear(void);
+
 /*!
  * \brief Request a new checkpoint structure
  *
@@ -99,6 +144,8 @@ int32_t checkpoint_register(checkpoint_st **c, char *name);
  *      If checkpoints are enabled, it will print a message indicating that
  *      it is pausing and activate the CLI. When the command line exists This
  *      function will return and normal execution is resumed.
+ *      If the checkpoint is in tracing mode, the hit is recorded in the trace
+ *      ring with a timestamp and the function returns without stopping.
  *
  * \param c Pointer to valid checkpoint structure, obtained through a call to
  *          checkpoint_register.
@@ -39,10 +39,19 @@
  *   Size of the debug print buffer used to store characters before they can
  *   be sent to the UART.
  *
+ * CLI_CONFIG_PRINT_DRAIN_SIZE
+ *   Number of characters moved at once from the debug print buffer to the
+ *   UART.  Prints that do not fit in the debug print buffer are dropped rather
+ *   than waited for.
+ *
  * CLI_CONFIG_SCRATCH_BUFFER_SIZE
  *   Number of stack bytes used as scratch space by print statements, size of
  *   this buffer determines the maximum length of a single print.  Threads using
  *   CLI print functionality must have this much extra stack space.
+ *
+ * CLI_CONFIG_WATCH_POLL_PERIOD_MS
+ *   Period, in milliseconds, at which the watch command checks for a key
+ *   press while waiting for the next run of the watched command.
  */
 
 #define CLI_CONFIG_COMMAND_BUF_SIZE (256)
@@ -53,7 +62,9 @@
 #define CLI_CONFIG_DEFAULT_TERM_H (24)
 #define CLI_CONFIG_STACK_SIZE (2048)
 #define CLI_CONFIG_PRINT_BUFFER_SIZE (1024)
+#define CLI_CONFIG_PRINT_DRAIN_SIZE (64)
 #define CLI_CONFIG_SCRATCH_BUFFER_SIZE (256)
+#define CLI_CONFIG_WATCH_POLL_PERIOD_MS (10)
 
 #define CLI_PROMPT  "> "
 
@@ -70,6 +70,49 @@ uint32_t fifo_get(fifo_st *fifo, char *val);
  */
 uint32_t fifo_put(fifo_st *fifo, char *val);
 
+/*
+ * fifo_put_block
+ *   Description
+ *     Places as many bytes of a buffer as fit into a FIFO buffer.
+ *   Parameters
+ *     fifo_st *fifo
+ *       Pointer to fifo_st structure to put the bytes into.
+ *     const char *buf
+ *       Pointer to the bytes to put.
+ *     uint32_t size
+ *       Number of bytes to put.
+ *     uint32_t *put
+ *       Pointer to location in which to place the number of bytes put.
+ *   Return
+ *     Platform return codes defined in cli_config.h, FWK_E_NOMEM if only part
+ *     of the bytes fit.
+ */
+uint32_t fifo_put_block(
+    fifo_st *fifo,
+    const char *buf,
+    uint32_t size,
+    uint32_t *put);
+
+/*
+ * fifo_get_block
+ *   Description
+ *     Gets up to a number of bytes from a FIFO and places them into the buffer
+ *     supplied.
+ *   Parameters
+ *     fifo_st *fifo
+ *       Pointer to fifo_st structure to get the bytes from.
+ *     char *buf
+ *       Pointer to the buffer in which to place the retrieved bytes.
+ *     uint32_t size
+ *       Size of the buffer in bytes.
+ *     uint32_t *got
+ *       Pointer to location in which to place the number of bytes retrieved.
+ *   Return
+ *     Platform return codes defined in cli_config.h, FWK_E_DATA if the FIFO
+ *     was empty.
+ */
+uint32_t fifo_get_block(fifo_st *fifo, char *buf, uint32_t size, uint32_t *got);
+
 /*
  * fifo_free_space
  *   Description
@@ -8,7 +8,9 @@
 #include <checkpoint.h>
 #include <cli.h>
 
+#include <fwk_interrupt.h>
 #include <fwk_status.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 #include <stdlib.h>
@@ -19,6 +21,63 @@ checkpoint_st checkpoint_table[CHECKPOINT_NUM] = {0};
 /* Reset value for bypass. */
 static volatile int32_t bypass_reset = CHECKPOINT_DISABLED;
 
+/* Ring of the most recent hits of checkpoints in tracing mode. */
+static checkpoint_trace_st trace_ring[CHECKPOINT_TRACE_LEN];
+
+/* Number of hits recorded since the ring was last cleared. */
+static uint32_t trace_count;
+
+static void checkpoint_trace(checkpoint_st *c, int32_t line)
+{
+    checkpoint_trace_st *record;
+
+    fwk_interrupt_global_disable();
+
+    record = &trace_ring[trace_count & (CHECKPOINT_TRACE_LEN - 1)];
+    record->index = c->index;
+    record->line = line;
+    record->timestamp = fwk_time_profile_current();
+
+    trace_count++;
+    c->hits++;
+
+    fwk_interrupt_global_enable();
+}
+
+bool checkpoint_trace_get(uint32_t n, checkpoint_trace_st *record)
+{
+    uint32_t count;
+    uint32_t first;
+    bool found = false;
+
+    fwk_interrupt_global_disable();
+
+    count = trace_count;
+    first = (count > CHECKPOINT_TRACE_LEN) ? count - CHECKPOINT_TRACE_LEN : 0;
+
+    if (n < (count - first)) {
+        *record = trace_ring[(first + n) & (CHECKPOINT_TRACE_LEN - 1)];
+        found = true;
+    }
+
+    fwk_interrupt_global_enable();
+
+    return found;
+}
+
+void checkpoint_trace_clear(void)
+{
+    uint32_t i = 0;
+
+    fwk_interrupt_global_disable();
+
+    trace_count = 0;
+    for (i = 0; i < CHECKPOINT_NUM; i++)
+        checkpoint_table[i].hits = 0;
+
+    fwk_interrupt_global_enable();
+}
+
 void checkpoint_enable_all(void)
 {
     uint32_t i = 0;
@@ -71,6 +130,12 @@ int32_t checkpoint_register(checkpoint_st **c, char *name)
 
 void checkpoint(checkpoint_st *c, char *file, int32_t line, char *tag)
 {
+    /* In tracing mode, record the hit and carry on. */
+    if (c->bypass == CHECKPOINT_TRACE) {
+        checkpoint_trace(c, line);
+        return;
+    }
+
     /* If tags match or if bypass == 0, stop here. */
     if ((c->bypass == CHECKPOINT_ENABLED) ||
         ((tag != NULL) && (strncmp(tag, c->tag, CHECKPOINT_TAG_LEN) == 0))) {
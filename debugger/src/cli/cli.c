@@ -50,7 +50,8 @@ extern cli_command_st cli_commands[];
 /* Print buffer structures. */
 static fifo_st cli_print_fifo = { 0 };
 static char cli_print_fifo_buffer[CLI_CONFIG_PRINT_BUFFER_SIZE] = { 0 };
-static bool overflow = false;
+/* Number of characters dropped since the print buffer was last drained. */
+static volatile uint32_t cli_print_dropped = 0;
 
 size_t strnlen(s, maxlen) register const char *s;
 size_t maxlen;
@@ -267,6 +268,21 @@ static uint32_t cli_split(
  */
 static uint32_t cli_command_dispatch(char **args);
 
+/*
+ * cli_watch
+ *   Description
+ *     Runs a command repeatedly, clearing the display before each run, until
+ *     a key press is received.
+ *   Parameters
+ *     char **args
+ *       Pointer to an array of strings holding "watch", the period in
+ *       milliseconds and the command to run with its arguments.
+ *   Return
+ *     uint32_t: FWK_SUCCESS if it works, something else if it
+ *     doesn't.
+ */
+static uint32_t cli_watch(char **args);
+
 /*
  * cli_debug_output
  *   Description
@@ -433,8 +449,8 @@ uint32_t cli_bprintf(cli_option_et options, const char *format, ...)
 
 uint32_t cli_bprint(const char *string)
 {
-    uint32_t i = 0;
-    int32_t status = FWK_SUCCESS;
+    uint32_t length = 0;
+    uint32_t put = 0;
 
     /* Check parameters. */
     if (string == NULL)
@@ -448,22 +464,18 @@ uint32_t cli_bprint(const char *string)
     if (cli_state == CLI_READY)
         return cli_print(string);
 
-    /* Put data into FIFO. */
-    for (i = 0; ; i++) {
-        if ((string[i] == 0) &&
-            (i >= CLI_CONFIG_SCRATCH_BUFFER_SIZE) &&
-            (status != FWK_SUCCESS))
-            break;
-        status = fifo_put(&cli_print_fifo, (char *)&string[i]);
-    }
-
-    /* Print an error message if the print buffer is full. */
-    if ((status != FWK_SUCCESS) && (overflow == false)) {
-        overflow = true;
-        cli_print("\x1B[31mCONSOLE ERROR:\x1B[0m Print buffer overflow.\n");
+    /*
+     * Drop the whole print if the FIFO is too full for it, waiting for the
+     * UART would perturb the caller and a partial print would be misleading.
+     * The drops are reported once the FIFO has been drained.
+     */
+    length = strlen(string);
+    if (fifo_free_space(&cli_print_fifo) < length) {
+        cli_print_dropped += length;
+        return FWK_E_NOMEM;
     }
 
-    return status;
+    return fifo_put_block(&cli_print_fifo, string, length, &put);
 }
 static char sCLIbuffer[CLI_CONFIG_SCRATCH_BUFFER_SIZE] = { 0 };
 
@@ -520,15 +532,8 @@ uint32_t cli_printf(cli_option_et options, const char *format, ...)
 
 uint32_t cli_print(const char *string)
 {
-    uint32_t index = 0;
-    int32_t status = FWK_SUCCESS;
-
-    for (index = 0; string[index] != 0; index++) {
-        status = fwk_io_putch(fwk_io_stdout, string[index]);
-        if (status != FWK_SUCCESS)
-            return status;
-    }
-    return status;
+    /* Hand the whole string to the UART driver in one go. */
+    return fwk_io_puts(fwk_io_stdout, string);
 }
 
 void cli_snprintf(char *s, char *smax, const char *fmt, ...)
@@ -1223,6 +1228,9 @@ static uint32_t cli_command_dispatch(char **args)
 
         cli_printf(NONE, "help\n");
         cli_print("  Displays this information.\n");
+        cli_printf(NONE, "watch\n");
+        cli_print("  Runs a command periodically until a key is pressed.\n"
+                  "    Usage: watch <period ms> <command> [<args>]\n");
         cli_printf(NONE, "Ctrl+C\n");
         cli_print("  Displays debug output from running threads.\n");
         cli_printf(NONE, "Ctrl+d\n");
@@ -1230,6 +1238,9 @@ static uint32_t cli_command_dispatch(char **args)
         return FWK_SUCCESS;
     }
 
+    if (cli_strncmp(args[0], "watch", 6) == 0)
+        return cli_watch(args);
+
     if (cli_strncmp(args[0], "AUTO", 4) == 0) {
         cli_printf(NONE, "AUTO Mode ON\n");
         automation_mode = 1;
@@ -1291,10 +1302,54 @@ static uint32_t cli_command_dispatch(char **args)
         return FWK_E_PARAM;
 }
 
+static uint32_t cli_watch(char **args)
+{
+    uint32_t period_ms;
+    uint32_t elapsed_ms;
+    uint32_t status;
+    char c = 0;
+
+    if ((args[1] == 0) || (args[2] == 0) ||
+        (cli_strncmp(args[2], "watch", 6) == 0))
+        return FWK_E_PARAM;
+
+    period_ms = strtoul(args[1], NULL, 0);
+
+    /* Discard the keys pressed before the watch started. */
+    while (fwk_io_getch(fwk_io_stdin, &c) == FWK_SUCCESS)
+        ;
+
+    while (1) {
+        cli_printf(
+            CLEAR_DISPLAY | RESET_CURSOR,
+            "Every %u ms: %s, press any key to stop.\n",
+            period_ms,
+            args[2]);
+
+        status = cli_command_dispatch(&args[2]);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        /* Wait for the next run, checking for a key press as we go. */
+        for (elapsed_ms = 0;;
+             elapsed_ms += CLI_CONFIG_WATCH_POLL_PERIOD_MS) {
+            if (fwk_io_getch(fwk_io_stdin, &c) == FWK_SUCCESS)
+                return FWK_SUCCESS;
+
+            if (elapsed_ms >= period_ms)
+                break;
+
+            cli_platform_delay_ms(CLI_CONFIG_WATCH_POLL_PERIOD_MS);
+        }
+    }
+}
+
 static uint32_t cli_debug_output(void)
 {
     char c = 0;
-    uint32_t fifo_status = FWK_SUCCESS;
+    char drain_buffer[CLI_CONFIG_PRINT_DRAIN_SIZE];
+    uint32_t count = 0;
+    uint32_t dropped = 0;
 
     cli_printf(
         0,
@@ -1313,13 +1368,27 @@ static uint32_t cli_debug_output(void)
         }
 
         /* Read from print FIFO. */
-        fifo_status = fifo_get(&cli_print_fifo, &c);
-        if (fifo_status == FWK_SUCCESS) {
-            overflow = false;
-            fwk_io_putch(fwk_io_stdout, c);
-        } else
-            /* If no characters are available, let other stuff run. */
-            cli_platform_delay_ms(0);
+        fifo_get_block(
+            &cli_print_fifo, drain_buffer, sizeof(drain_buffer), &count);
+        if (count != 0) {
+            fwk_io_write(
+                fwk_io_stdout, NULL, drain_buffer, sizeof(char), count);
+            continue;
+        }
+
+        /* Report the prints dropped while the print FIFO was full. */
+        dropped = cli_print_dropped;
+        if (dropped != 0) {
+            cli_print_dropped -= dropped;
+            cli_printf(
+                0,
+                "\x1B[31mCONSOLE ERROR:\x1B[0m Print buffer overflow, %u "
+                "characters dropped.\n",
+                dropped);
+        }
+
+        /* If no characters are available, let other stuff run. */
+        cli_platform_delay_ms(0);
     }
 }
 
@@ -11,6 +11,7 @@
 
 #include <fwk_io.h>
 #include <fwk_status.h>
+#include <fwk_time.h>
 
 #include <stdint.h>
 #include <stdlib.h>
@@ -29,7 +30,82 @@ const char checkpoint_help[] =
     "  Enable or disable a checkpoint.\n"
     "    Usage: checkpoint <CP ID> <enable|disable>\n"
     "  Enable or disable all checkpoints.\n"
-    "    Usage: checkpoint <enableall|disableall>";
+    "    Usage: checkpoint <enableall|disableall>\n"
+    "  Record the hits of a checkpoint without stopping.\n"
+    "    Usage: checkpoint <CP ID> trace\n"
+    "  Show the hit counts and the recorded hits, or clear them.\n"
+    "    Usage: checkpoint trace [clear]\n"
+    "  Show min/max/avg time from a checkpoint to the next hit of another.\n"
+    "    Usage: checkpoint trace <from CP ID> <to CP ID>";
+
+/* Clamp a duration to 32 bits, the widest the CLI prints in decimal. */
+static uint32_t checkpoint_ns(fwk_duration_ns_t duration)
+{
+    return (duration > UINT32_MAX) ? UINT32_MAX : (uint32_t)duration;
+}
+
+static void checkpoint_trace_show(void)
+{
+    checkpoint_trace_st record;
+    fwk_timestamp_t previous = 0;
+    uint32_t i = 0;
+
+    for (i = 0; i < CHECKPOINT_NUM; i++) {
+        if (checkpoint_table[i].in_use == true) {
+            cli_printf(NONE, "%d: %s, %u hits\n", i, checkpoint_table[i].name,
+                       checkpoint_table[i].hits);
+        }
+    }
+
+    for (i = 0; checkpoint_trace_get(i, &record); i++) {
+        cli_printf(NONE, "  CP %u line %d +%u ns\n", record.index, record.line,
+                   (i == 0) ? 0 : checkpoint_ns(record.timestamp - previous));
+        previous = record.timestamp;
+    }
+}
+
+static int32_t checkpoint_trace_delta(uint32_t from, uint32_t to)
+{
+    checkpoint_trace_st record;
+    fwk_timestamp_t from_timestamp = 0;
+    fwk_duration_ns_t delta, min = UINT64_MAX, max = 0, total = 0;
+    bool from_seen = false;
+    uint32_t count = 0;
+    uint32_t i = 0;
+
+    if ((from >= CHECKPOINT_NUM) || (to >= CHECKPOINT_NUM)) {
+        cli_print("CP ID out of range.\n");
+        return FWK_E_PARAM;
+    }
+
+    /* Pair each hit of the second checkpoint with the last hit of the first */
+    for (i = 0; checkpoint_trace_get(i, &record); i++) {
+        if ((record.index == to) && from_seen) {
+            delta = record.timestamp - from_timestamp;
+            min = (delta < min) ? delta : min;
+            max = (delta > max) ? delta : max;
+            total += delta;
+            count++;
+            from_seen = false;
+        }
+
+        if (record.index == from) {
+            from_timestamp = record.timestamp;
+            from_seen = true;
+        }
+    }
+
+    if (count == 0) {
+        cli_print("No interval recorded.\n");
+        return FWK_SUCCESS;
+    }
+
+    cli_printf(NONE, "%u intervals: min %u ns, max %u ns, avg %u ns\n", count,
+               checkpoint_ns(min), checkpoint_ns(max),
+               checkpoint_ns(total / count));
+
+    return FWK_SUCCESS;
+}
 
 int32_t checkpoint_f(int32_t argc, char **argv)
 {
@@ -37,7 +113,34 @@ int32_t checkpoint_f(int32_t argc, char **argv)
     uint32_t id = 0;
     uint32_t run_cnt = 0;
 
-    if ((argc == 2) && (cli_strncmp(argv[1], "list", 4) == 0)) {
+    if ((argc == 2) && (cli_strncmp(argv[1], "trace", 5) == 0)) {
+        checkpoint_trace_show();
+        return FWK_SUCCESS;
+    }
+
+    else if ((argc == 3) && (cli_strncmp(argv[1], "trace", 5) == 0) &&
+             (cli_strncmp(argv[2], "clear", 5) == 0)) {
+        checkpoint_trace_clear();
+        return FWK_SUCCESS;
+    }
+
+    else if ((argc == 4) && (cli_strncmp(argv[1], "trace", 5) == 0)) {
+        return checkpoint_trace_delta(strtoul(argv[2], NULL, 0),
+                                      strtoul(argv[3], NULL, 0));
+    }
+
+    else if ((argc == 3) && (cli_strncmp(argv[2], "trace", 5) == 0)) {
+        id = strtoul(argv[1], NULL, 0);
+        if (id >= CHECKPOINT_NUM) {
+            cli_print("CP ID out of range.\n");
+            return FWK_E_PARAM;
+        }
+        checkpoint_table[id].tag[0] = 0;
+        checkpoint_table[id].bypass = CHECKPOINT_TRACE;
+        return FWK_SUCCESS;
+    }
+
+    else if ((argc == 2) && (cli_strncmp(argv[1], "list", 4) == 0)) {
         for (i = 0; i < CHECKPOINT_NUM; i++) {
             if (checkpoint_table[i].in_use == true)
                 cli_printf(NONE, "%d: %s\n", i, checkpoint_table[i].name);
@@ -56,7 +56,17 @@
 #include <cli_fifo.h>
 #include <cli_platform.h>
 
+#include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_io.h>
+#include <fwk_latency.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+#include <fwk_time.h>
 
 #include <stdint.h>
 #include <stdlib.h>
@@ -321,6 +331,506 @@ static int32_t reset_sys_f(int32_t argc, char **argv)
     return 0;
 }
 
+/*
+ * heap_usage
+ * Prints the memory allocated by each module and the stack/heap high-water
+ * marks.
+ */
+static const char heap_usage_call[] = "heapusage";
+static const char heap_usage_help[] =
+    "  Prints the memory allocated by each module and the stack and heap\n"
+    "  high-water marks.\n"
+    "    Usage: heapusage\n";
+static int32_t heap_usage_f(int32_t argc, char **argv)
+{
+    struct fwk_mm_usage usage;
+    size_t heap_size, stack_size;
+    unsigned int module_idx;
+
+    /* Usage lookups fail past the last module */
+    for (module_idx = 0;
+         fwk_mm_get_usage(FWK_ID_MODULE(module_idx), &usage) == FWK_SUCCESS;
+         module_idx++) {
+        if (usage.count == 0)
+            continue;
+
+        cli_printf(
+            NONE,
+            "%s: %u bytes in %u allocations\n",
+            fwk_module_get_name(FWK_ID_MODULE(module_idx)),
+            (unsigned int)usage.size,
+            usage.count);
+    }
+
+    if (fwk_mm_get_usage(FWK_ID_NONE, &usage) == FWK_SUCCESS) {
+        cli_printf(
+            NONE,
+            "framework: %u bytes in %u allocations\n",
+            (unsigned int)usage.size,
+            usage.count);
+    }
+
+    if (fwk_mm_get_stackheap_high_water(&heap_size, &stack_size) ==
+        FWK_SUCCESS) {
+        cli_printf(
+            NONE,
+            "High-water marks: heap %u bytes, stack %u bytes\n",
+            (unsigned int)heap_size,
+            (unsigned int)stack_size);
+    } else
+        cli_print("High-water marks are not available.\n");
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * event_latency
+ * Prints the queueing delay and handler time histograms of each event and
+ * notification processed so far.
+ */
+static const char event_latency_call[] = "latency";
+static const char event_latency_help[] =
+    "  Prints the queueing delay and handler time histograms of each event\n"
+    "  and notification. Bucket 0 counts durations below 1us, bucket n\n"
+    "  durations below 2^n us.\n"
+    "    Usage: latency [reset]\n";
+static void event_latency_print_histogram(
+    const char *name,
+    const struct fwk_latency_histogram *histogram,
+    uint32_t count)
+{
+    unsigned int i;
+
+    cli_printf(
+        NONE,
+        "    %s: avg %u us, max %u us,",
+        name,
+        (unsigned int)fwk_time_duration_us(histogram->total / count),
+        (unsigned int)fwk_time_duration_us(histogram->max));
+
+    for (i = 0; i < FWK_EVENT_LATENCY_BUCKET_COUNT; i++)
+        cli_printf(NONE, " %u", (unsigned int)histogram->buckets[i]);
+
+    cli_print("\n");
+}
+
+static void event_latency_print(const char *module_name, fwk_id_t id)
+{
+    struct fwk_latency_stats stats;
+    uint32_t count = 0;
+    unsigned int i;
+
+    if (fwk_latency_get_stats(id, &stats) != FWK_SUCCESS)
+        return;
+
+    for (i = 0; i < FWK_EVENT_LATENCY_BUCKET_COUNT; i++)
+        count += stats.queue.buckets[i];
+
+    if (count == 0)
+        return;
+
+    cli_printf(
+        NONE,
+        "%s %s: %u processed\n",
+        module_name,
+        FWK_ID_VERBOSE_STR(id),
+        (unsigned int)count);
+
+    event_latency_print_histogram("queue", &stats.queue, count);
+    event_latency_print_histogram("handler", &stats.handler, count);
+}
+
+static int32_t event_latency_f(int32_t argc, char **argv)
+{
+    unsigned int module_idx, idx;
+    const char *module_name;
+
+    if (argc > 2)
+        return FWK_E_PARAM;
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset") != 0)
+            return FWK_E_PARAM;
+
+        return fwk_latency_reset();
+    }
+
+    /* The parameters are only checked when measurements are enabled */
+    if (fwk_latency_get_stats(FWK_ID_NONE, NULL) == FWK_E_SUPPORT) {
+        cli_print("Event latency measurements are not enabled.\n");
+        return FWK_SUCCESS;
+    }
+
+    for (module_idx = 0;
+         fwk_module_is_valid_module_id(FWK_ID_MODULE(module_idx));
+         module_idx++) {
+        module_name = fwk_module_get_name(FWK_ID_MODULE(module_idx));
+
+        for (idx = 0; fwk_module_is_valid_event_id(
+                 FWK_ID_EVENT(module_idx, idx));
+             idx++)
+            event_latency_print(module_name, FWK_ID_EVENT(module_idx, idx));
+
+        for (idx = 0; fwk_module_is_valid_notification_id(
+                 FWK_ID_NOTIFICATION(module_idx, idx));
+             idx++)
+            event_latency_print(
+                module_name, FWK_ID_NOTIFICATION(module_idx, idx));
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * event_queues
+ * Prints the depths of the event queues.
+ */
+static const char event_queues_call[] = "queues";
+static const char event_queues_help[] =
+    "  Prints the number of events awaiting processing in each event queue\n"
+    "  and the number of free event structures, with the peak number of\n"
+    "  event structures used since boot.\n"
+    "    Usage: queues\n";
+static int32_t event_queues_f(int32_t argc, char **argv)
+{
+    struct fwk_thread_queue_stats stats;
+    size_t count, peak_count;
+
+    if (fwk_thread_get_queue_stats(&stats) == FWK_SUCCESS) {
+        cli_printf(
+            NONE,
+            "Queued: high %u, normal %u, isr %u\n",
+            (unsigned int)stats.high_priority,
+            (unsigned int)stats.normal,
+            (unsigned int)stats.isr);
+        cli_printf(
+            NONE,
+            "Free: %u of %u, lowest %u\n",
+            (unsigned int)stats.free,
+            (unsigned int)stats.capacity,
+            (unsigned int)stats.free_low_water);
+        cli_printf(
+            NONE,
+            "Peak used: %u, grown by %u\n",
+            (unsigned int)stats.peak_used,
+            (unsigned int)stats.grown);
+    } else
+        cli_print("Event queue depths are not available.\n");
+
+    if (fwk_thread_get_delayed_response_count(&count, &peak_count) ==
+        FWK_SUCCESS) {
+        cli_printf(
+            NONE,
+            "Delayed responses: %u, highest %u\n",
+            (unsigned int)count,
+            (unsigned int)peak_count);
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * top_handlers
+ * Prints the events and notifications whose handlers took the most time.
+ */
+#define TOP_HANDLERS_MAX 16
+static const char top_handlers_call[] = "top";
+static const char top_handlers_help[] =
+    "  Prints the events and notifications whose handlers took the most\n"
+    "  time since the latency measurements were last reset. Up to 16\n"
+    "  entries, 8 by default, are printed.\n"
+    "    Usage: top [<count>]\n";
+struct top_handlers_entry {
+    fwk_id_t id;
+    fwk_duration_ns_t total;
+    fwk_duration_ns_t max;
+    uint32_t count;
+};
+
+static void top_handlers_insert(
+    struct top_handlers_entry *table,
+    unsigned int *used,
+    unsigned int size,
+    fwk_id_t id)
+{
+    struct fwk_latency_stats stats;
+    struct top_handlers_entry entry = { .id = id };
+    unsigned int i;
+
+    if (fwk_latency_get_stats(id, &stats) != FWK_SUCCESS)
+        return;
+
+    for (i = 0; i < FWK_EVENT_LATENCY_BUCKET_COUNT; i++)
+        entry.count += stats.handler.buckets[i];
+
+    if (entry.count == 0)
+        return;
+
+    entry.total = stats.handler.total;
+    entry.max = stats.handler.max;
+
+    /* Keep the table sorted by decreasing total time */
+    for (i = *used; i > 0; i--) {
+        if (table[i - 1].total >= entry.total)
+            break;
+
+        if (i < size)
+            table[i] = table[i - 1];
+    }
+
+    if (i < size) {
+        table[i] = entry;
+        if (*used < size)
+            (*used)++;
+    }
+}
+
+static int32_t top_handlers_f(int32_t argc, char **argv)
+{
+    struct top_handlers_entry table[TOP_HANDLERS_MAX];
+    unsigned int size = 8;
+    unsigned int used = 0;
+    unsigned int module_idx, idx, i;
+    fwk_id_t module_id;
+
+    if (argc > 2)
+        return FWK_E_PARAM;
+
+    if (argc == 2) {
+        size = strtoul(argv[1], NULL, 0);
+        if ((size == 0) || (size > TOP_HANDLERS_MAX))
+            return FWK_E_PARAM;
+    }
+
+    if (fwk_latency_get_stats(FWK_ID_NONE, NULL) == FWK_E_SUPPORT) {
+        cli_print("Event latency measurements are not enabled.\n");
+        return FWK_SUCCESS;
+    }
+
+    for (module_idx = 0;
+         fwk_module_is_valid_module_id(FWK_ID_MODULE(module_idx));
+         module_idx++) {
+        for (idx = 0; fwk_module_is_valid_event_id(
+                 FWK_ID_EVENT(module_idx, idx));
+             idx++)
+            top_handlers_insert(
+                table, &used, size, FWK_ID_EVENT(module_idx, idx));
+
+        for (idx = 0; fwk_module_is_valid_notification_id(
+                 FWK_ID_NOTIFICATION(module_idx, idx));
+             idx++)
+            top_handlers_insert(
+                table, &used, size, FWK_ID_NOTIFICATION(module_idx, idx));
+    }
+
+    for (i = 0; i < used; i++) {
+        module_id = FWK_ID_MODULE(fwk_id_get_module_idx(table[i].id));
+        cli_printf(
+            NONE,
+            "%s %s: total %u us, %u calls, avg %u us, max %u us\n",
+            fwk_module_get_name(module_id),
+            FWK_ID_VERBOSE_STR(table[i].id),
+            (unsigned int)fwk_time_duration_us(table[i].total),
+            (unsigned int)table[i].count,
+            (unsigned int)fwk_time_duration_us(
+                table[i].total / table[i].count),
+            (unsigned int)fwk_time_duration_us(table[i].max));
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * budget_overruns
+ * Prints the events and notifications whose handlers overran their budget.
+ */
+static const char budget_overruns_call[] = "overruns";
+static const char budget_overruns_help[] =
+    "  Prints the events and notifications whose handlers overran their\n"
+    "  time budget the most since the latency measurements were last reset.\n"
+    "    Usage: overruns\n";
+static int32_t budget_overruns_f(int32_t argc, char **argv)
+{
+    struct fwk_latency_overrun overruns[FWK_EVENT_BUDGET_OFFENDER_COUNT];
+    unsigned int count, i;
+    uint32_t total;
+
+    if (argc > 1)
+        return FWK_E_PARAM;
+
+    if (fwk_latency_get_overruns(overruns, &count, &total) != FWK_SUCCESS) {
+        cli_print("Handler time budgets are not enabled.\n");
+        return FWK_SUCCESS;
+    }
+
+    cli_printf(NONE, "%u overruns\n", (unsigned int)total);
+
+    for (i = 0; i < count; i++) {
+        cli_printf(
+            NONE,
+            "%s -> %s: %u overruns, max %u us\n",
+            FWK_ID_VERBOSE_STR(overruns[i].id),
+            FWK_ID_VERBOSE_STR(overruns[i].target_id),
+            (unsigned int)overruns[i].count,
+            (unsigned int)fwk_time_duration_us(overruns[i].max));
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * irq_stats
+ * Prints the invocation counts and times of the interrupt service routines.
+ */
+static const char irq_stats_call[] = "irqstats";
+static const char irq_stats_help[] =
+    "  Prints the number of invocations and the total, average and longest\n"
+    "  times of the service routine of each interrupt that fired, and the\n"
+    "  longest time interrupts were masked, or clears them.\n"
+    "    Usage: irqstats [reset]\n";
+
+/* Clamp a duration to 32 bits, the widest the CLI prints in decimal. */
+static unsigned int irq_stats_ns(fwk_duration_ns_t duration)
+{
+    return (duration > UINT32_MAX) ? UINT32_MAX : (unsigned int)duration;
+}
+
+static int32_t irq_stats_f(int32_t argc, char **argv)
+{
+    struct fwk_interrupt_stats stats;
+    fwk_duration_ns_t masked_max;
+    unsigned int interrupt;
+
+    if (argc > 2)
+        return FWK_E_PARAM;
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset") != 0)
+            return FWK_E_PARAM;
+
+        return fwk_interrupt_reset_stats();
+    }
+
+    if (fwk_interrupt_get_masked_max(&masked_max) == FWK_E_SUPPORT) {
+        cli_print("Interrupt statistics are not enabled.\n");
+        return FWK_SUCCESS;
+    }
+
+    for (interrupt = 0;
+         fwk_interrupt_get_stats(interrupt, &stats) == FWK_SUCCESS;
+         interrupt++) {
+        if (stats.count == 0)
+            continue;
+
+        cli_printf(
+            NONE,
+            "IRQ %u: %u calls, total %u us, avg %u ns, max %u ns\n",
+            interrupt,
+            (unsigned int)stats.count,
+            (unsigned int)fwk_time_duration_us(stats.total),
+            irq_stats_ns(stats.total / stats.count),
+            irq_stats_ns(stats.max));
+    }
+
+    cli_printf(
+        NONE, "Longest masked section: %u ns\n", irq_stats_ns(masked_max));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * log_level
+ * Prints or changes the runtime log filter level of modules.
+ */
+static const char log_level_call[] = "loglevel";
+static const char log_level_help[] =
+    "  Prints the runtime log filter level of each module, or sets the level\n"
+    "  of a module, given by name or index, or of all modules.\n"
+    "    Usage: loglevel [<module>|all <trace|info|warn|error|crit>]\n";
+static const char *const log_level_names[] = {
+    [FWK_LOG_LEVEL_TRACE] = "trace", [FWK_LOG_LEVEL_INFO] = "info",
+    [FWK_LOG_LEVEL_WARN] = "warn",   [FWK_LOG_LEVEL_ERROR] = "error",
+    [FWK_LOG_LEVEL_CRIT] = "crit",
+};
+
+static int log_level_find_module(const char *arg, unsigned int *module_idx)
+{
+    char *end;
+    unsigned int idx;
+    const char *name;
+
+    idx = (unsigned int)strtoul(arg, &end, 0);
+    if ((*end == '\0') &&
+        fwk_module_is_valid_module_id(FWK_ID_MODULE(idx))) {
+        *module_idx = idx;
+        return FWK_SUCCESS;
+    }
+
+    for (idx = 0; fwk_module_is_valid_module_id(FWK_ID_MODULE(idx)); idx++) {
+        name = fwk_module_get_name(FWK_ID_MODULE(idx));
+        if ((name != NULL) && (strcmp(name, arg) == 0)) {
+            *module_idx = idx;
+            return FWK_SUCCESS;
+        }
+    }
+
+    return FWK_E_PARAM;
+}
+
+static int32_t log_level_f(int32_t argc, char **argv)
+{
+    unsigned int module_idx, level;
+    int status;
+
+    if (argc == 1) {
+        for (module_idx = 0;
+             fwk_module_is_valid_module_id(FWK_ID_MODULE(module_idx));
+             module_idx++) {
+            status = fwk_log_get_level(FWK_ID_MODULE(module_idx), &level);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            cli_printf(
+                NONE,
+                "%2u %s: %s\n",
+                module_idx,
+                fwk_module_get_name(FWK_ID_MODULE(module_idx)),
+                log_level_names[level]);
+        }
+
+        return FWK_SUCCESS;
+    }
+
+    if (argc != 3)
+        return FWK_E_PARAM;
+
+    for (level = 0; level < FWK_ARRAY_SIZE(log_level_names); level++) {
+        if (strcmp(argv[2], log_level_names[level]) == 0)
+            break;
+    }
+
+    if (level == FWK_ARRAY_SIZE(log_level_names))
+        return FWK_E_PARAM;
+
+    if (strcmp(argv[1], "all") == 0) {
+        for (module_idx = 0;
+             fwk_module_is_valid_module_id(FWK_ID_MODULE(module_idx));
+             module_idx++) {
+            status = fwk_log_set_level(FWK_ID_MODULE(module_idx), level);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+
+        return FWK_SUCCESS;
+    }
+
+    status = log_level_find_module(argv[1], &module_idx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_log_set_level(FWK_ID_MODULE(module_idx), level);
+}
+
 /*****************************************************************************/
 /* Command Structure Array                                                   */
 /*****************************************************************************/
@@ -340,6 +850,13 @@ cli_command_st cli_commands[] = {
     { write_memory_call, write_memory_help, &write_memory_f, false },
     { reset_sys_call, reset_sys_help, &reset_sys_f, false },
     { uptime_call, uptime_help, &uptime_f, false },
+    { heap_usage_call, heap_usage_help, &heap_usage_f, false },
+    { event_latency_call, event_latency_help, &event_latency_f, false },
+    { event_queues_call, event_queues_help, &event_queues_f, false },
+    { top_handlers_call, top_handlers_help, &top_handlers_f, false },
+    { budget_overruns_call, budget_overruns_help, &budget_overruns_f, false },
+    { irq_stats_call, irq_stats_help, &irq_stats_f, false },
+    { log_level_call, log_level_help, &log_level_f, false },
     { checkpoint_call, checkpoint_help, &checkpoint_f, false },
 
     /* End of commands. */
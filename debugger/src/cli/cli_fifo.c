@@ -7,6 +7,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <cli_config.h>
 #include <cli_fifo.h>
@@ -71,6 +72,77 @@ uint32_t fifo_put(fifo_st *fifo, char *val)
     return FWK_E_NOMEM;
 }
 
+uint32_t fifo_put_block(
+    fifo_st *fifo,
+    const char *buf,
+    uint32_t size,
+    uint32_t *put)
+{
+    uint32_t used;
+    uint32_t count;
+    uint32_t span;
+
+    /* Checking parameters. */
+    if (fifo == 0 || buf == 0 || put == 0)
+        return FWK_E_PARAM;
+
+    /* Only copying what fits, the rest is left to the caller. */
+    used = (fifo->put_ptr + fifo->buf_size - fifo->get_ptr) % fifo->buf_size;
+    count = fifo->buf_size - 1 - used;
+    if (count > size)
+        count = size;
+
+    /* Copying in up to two spans, wrapping around the end of the buffer. */
+    span = fifo->buf_size - fifo->put_ptr;
+    if (span > count)
+        span = count;
+    memcpy(&fifo->buf[fifo->put_ptr], buf, span);
+    memcpy(fifo->buf, buf + span, count - span);
+
+    fifo->put_ptr = (fifo->put_ptr + count) % fifo->buf_size;
+    fifo->count = fifo->count + count;
+    /* Tracking FIFO high-water mark. */
+    if (fifo->count > fifo->high_water && fifo->reset_high_water == false)
+        fifo->high_water = fifo->count;
+
+    *put = count;
+
+    return (count == size) ? FWK_SUCCESS : FWK_E_NOMEM;
+}
+
+uint32_t fifo_get_block(fifo_st *fifo, char *buf, uint32_t size, uint32_t *got)
+{
+    uint32_t count;
+    uint32_t span;
+
+    /* Checking parameters. */
+    if (fifo == 0 || buf == 0 || got == 0)
+        return FWK_E_PARAM;
+
+    count = (fifo->put_ptr + fifo->buf_size - fifo->get_ptr) % fifo->buf_size;
+    if (count > size)
+        count = size;
+
+    /* Copying out up to two spans, wrapping around the end of the buffer. */
+    span = fifo->buf_size - fifo->get_ptr;
+    if (span > count)
+        span = count;
+    memcpy(buf, &fifo->buf[fifo->get_ptr], span);
+    memcpy(buf + span, fifo->buf, count - span);
+
+    fifo->get_ptr = (fifo->get_ptr + count) % fifo->buf_size;
+    fifo->count = fifo->count - count;
+    /* Tracking FIFO high-water mark. */
+    if ((fifo->reset_high_water == true) && (fifo->count == 0)) {
+        fifo->high_water = 0;
+        fifo->reset_high_water = false;
+    }
+
+    *got = count;
+
+    return (count != 0) ? FWK_SUCCESS : FWK_E_DATA;
+}
+
 uint32_t fifo_free_space(fifo_st *fifo)
 {
     /* Checking parameters. */
@@ -178,6 +178,133 @@ struct fwk_arch_interrupt_driver {
      * \retval ::FWK_E_STATE An interrupt is not currently being serviced.
      */
     int (*get_current)(unsigned int *interrupt);
+
+    /*!
+     * \brief Get the priority level of the current interrupt service routine
+     *      being processed.
+     *
+     * \details Priority levels are numbered from zero, zero being the most
+     *      urgent one. Interrupt service routines sharing a priority level do
+     *      not preempt each other.
+     *
+     * \note This handler is optional and may be \c NULL.
+     *
+     * \param [out] priority Priority level.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     * \retval ::FWK_E_STATE An interrupt is not currently being serviced.
+     * \retval ::FWK_E_SUPPORT The current interrupt has no priority level.
+     */
+    int (*get_current_priority)(unsigned int *priority);
+
+    /*!
+     * \brief Mask the interrupts of a priority level and of all the less
+     *      urgent levels.
+     *
+     * \details The interrupts of the more urgent levels remain unmasked. The
+     *      masking only ever grows: if a more urgent level is already masked,
+     *      the masking is left unchanged.
+     *
+     * \note This handler is optional and may be \c NULL, in which case
+     *      ::fwk_arch_interrupt_driver::unmask_priority must also be \c NULL.
+     *
+     * \param priority Priority level, which must not be zero.
+     * \param [out] state Masking state to give to
+     *      ::fwk_arch_interrupt_driver::unmask_priority to restore the masking
+     *      in place before the call.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     * \retval ::FWK_E_PARAM One or more parameters were invalid.
+     */
+    int (*mask_priority)(unsigned int priority, unsigned int *state);
+
+    /*!
+     * \brief Restore the priority masking in place before a call to
+     *      ::fwk_arch_interrupt_driver::mask_priority.
+     *
+     * \note This handler is optional and may be \c NULL.
+     *
+     * \param state Masking state given by
+     *      ::fwk_arch_interrupt_driver::mask_priority.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     */
+    int (*unmask_priority)(unsigned int state);
+};
+
+/*!
+ * \brief Memory management driver interface.
+ *
+ * \details The memory management driver allows the framework to report how
+ *      much of the memory shared by the stack and the heap has been used.
+ */
+struct fwk_arch_mm_driver {
+    /*!
+     * \brief Get the stack and heap high-water marks.
+     *
+     * \note This handler is optional and may be \c NULL.
+     *
+     * \param [out] heap_size Largest number of bytes claimed by the heap.
+     * \param [out] stack_size Largest number of bytes used by the stack.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     * \retval ::FWK_E_SUPPORT The high-water marks cannot be measured.
+     */
+    int (*get_high_water)(size_t *heap_size, size_t *stack_size);
+
+    /*!
+     * \brief Get the memory holding the init-only code and data.
+     *
+     * \details The memory is handed over to the framework allocator once the
+     *      start stage is complete, see ::FWK_INIT.
+     *
+     * \note This handler is optional and may be \c NULL.
+     *
+     * \param [out] base Start address of the memory.
+     * \param [out] size Size of the memory in bytes.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     * \retval ::FWK_E_SUPPORT The init-only code and data cannot be
+     *      reclaimed.
+     */
+    int (*get_reclaimable)(void **base, size_t *size);
+};
+
+/*!
+ * \brief Task driver interface.
+ *
+ * \details The task driver allows the framework to run cooperative tasks on
+ *      their own stacks, see \ref GroupTask.
+ */
+struct fwk_arch_task_driver {
+    /*!
+     * \brief Prepare a context that runs a function on a stack.
+     *
+     * \details The first switch to the context calls \p entry on \p stack.
+     *      The function must never return.
+     *
+     * \param stack Lowest address of the stack.
+     * \param stack_size Size of the stack in bytes.
+     * \param entry Function run by the context.
+     * \param [out] context Context to give to
+     *      ::fwk_arch_task_driver::switch_to.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     * \retval ::FWK_E_PARAM The stack is too small.
+     */
+    int (*create)(
+        void *stack,
+        size_t stack_size,
+        void (*entry)(void),
+        void **context);
+
+    /*!
+     * \brief Save the current context and switch to another one.
+     *
+     * \param [out] current Saved current context, resumed when switched to.
+     * \param next Context to switch to.
+     */
+    void (*switch_to)(void **current, void *next);
 };
 
 /*!
@@ -200,6 +327,38 @@ struct fwk_arch_init_driver {
      * \retval ::FWK_E_PANIC Unrecoverable initialization error.
      */
     int (*interrupt)(const struct fwk_arch_interrupt_driver **driver);
+
+    /*!
+     * \brief Memory management driver initialization.
+     *
+     * \details This handler is used by the framework library to request the
+     *      memory management driver.
+     *
+     * \note This handler is optional and may be \c NULL.
+     *
+     * \param [out] driver Pointer to a memory management driver.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     * \retval ::FWK_E_PARAM The parameter received by the handler is invalid.
+     * \retval ::FWK_E_PANIC Unrecoverable initialization error.
+     */
+    int (*mm)(const struct fwk_arch_mm_driver **driver);
+
+    /*!
+     * \brief Task driver initialization.
+     *
+     * \details This handler is used by the framework library to request the
+     *      task driver. Tasks are not supported if it is not provided.
+     *
+     * \note This handler is optional and may be \c NULL.
+     *
+     * \param [out] driver Pointer to a task driver.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     * \retval ::FWK_E_PARAM The parameter received by the handler is invalid.
+     * \retval ::FWK_E_PANIC Unrecoverable initialization error.
+     */
+    int (*task)(const struct fwk_arch_task_driver **driver);
 };
 
 /*!
@@ -245,6 +245,63 @@
 #    define FWK_SECTION(SECTION) __attribute__((__section__(SECTION)))
 #endif
 
+/*!
+ * \def FWK_HOT
+ *
+ * \brief "Hot path" attribute.
+ *
+ * \details Places the function that this attribute is attached to into the
+ *      `.text.tcm` section. Architectures supporting it execute the functions
+ *      of this section from tightly-coupled memory, and other architectures
+ *      place them with the rest of the code. This is meant for the few
+ *      functions on the critical path of the message and interrupt handling.
+ *
+ * \see https://gcc.gnu.org/onlinedocs/gcc/Common-Function-Attributes.html#index-section-function-attribute
+ */
+
+#if FWK_HAS_GNU_ATTRIBUTE(__section__)
+#    define FWK_HOT __attribute__((__section__(".text.tcm")))
+#else
+#    define FWK_HOT
+#endif
+
+/*!
+ * \def FWK_INIT
+ * \brief "Init-only code" attribute.
+ * \details Places the function that this attribute is attached to into the
+ *      `.reclaim.text` section. Architectures supporting it hand the memory of
+ *      this section over to the heap once the start stage is complete, so the
+ *      function must neither be called nor referenced from then on. This is
+ *      meant for the one-off setup done by the initialization and bind
+ *      handlers.
+ * \warning The start handlers of deferred modules, see
+ *      ::fwk_module_config::deferred_start, run after the memory is reclaimed.
+ * \see https://gcc.gnu.org/onlinedocs/gcc/Common-Function-Attributes.html#index-section-function-attribute
+ */
+
+#if FWK_HAS_GNU_ATTRIBUTE(__section__)
+#    define FWK_INIT __attribute__((__section__(".reclaim.text")))
+#else
+#    define FWK_INIT
+#endif
+
+/*!
+ * \def FWK_INIT_CONST
+ * \brief "Init-only constant data" attribute.
+ * \details Places the constant object that this attribute is attached to into
+ *      the `.reclaim.rodata` section, which is reclaimed with the init-only
+ *      code, see ::FWK_INIT. This is meant for the tables only read while the
+ *      modules are initialized, and not for the configuration data modules
+ *      keep a pointer to.
+ * \see https://gcc.gnu.org/onlinedocs/gcc/Common-Variable-Attributes.html#index-section-variable-attribute
+ */
+
+#if FWK_HAS_GNU_ATTRIBUTE(__section__)
+#    define FWK_INIT_CONST __attribute__((__section__(".reclaim.rodata")))
+#else
+#    define FWK_INIT_CONST
+#endif
+
 /*!
  * \def FWK_DEPRECATED
  *
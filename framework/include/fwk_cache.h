@@ -0,0 +1,94 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Cache maintenance.
+ */
+
+#ifndef FWK_CACHE_H
+#define FWK_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupLibFramework Framework
+ * \{
+ */
+
+/*!
+ * \defgroup GroupCache Cache Maintenance
+ *
+ * \details Memory shared with other agents, such as mailboxes, may be mapped
+ *      cacheable when the firmware maintains the data cache at the points the
+ *      memory changes hands: the range is cleaned once written for the other
+ *      agents, and invalidated before reading what they wrote.
+ *
+ *      Without a cache driver, the maintenance operations do nothing.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Cache driver.
+ */
+struct fwk_cache_driver {
+    /*!
+     * \brief Write the dirty cache lines of a range back to memory.
+     *
+     * \param address Start address of the range.
+     * \param size Size of the range in bytes.
+     */
+    void (*clean)(uintptr_t address, size_t size);
+
+    /*!
+     * \brief Discard the cache lines of a range.
+     *
+     * \details The cache lines shared with data outside the range must not
+     *      lose the data written to it.
+     *
+     * \param address Start address of the range.
+     * \param size Size of the range in bytes.
+     */
+    void (*invalidate)(uintptr_t address, size_t size);
+};
+
+/*!
+ * \brief Register a cache driver.
+ *
+ * \details This is a weak function provided by the framework that, by default,
+ *      does not register a driver, and should be overridden by the firmware if
+ *      it runs with a data cache enabled.
+ *
+ * \return Cache driver.
+ */
+struct fwk_cache_driver fmw_cache_driver(void);
+
+/*!
+ * \brief Make the data written to a range visible to the other agents.
+ *
+ * \param address Start address of the range.
+ * \param size Size of the range in bytes.
+ */
+void fwk_cache_clean(const volatile void *address, size_t size);
+
+/*!
+ * \brief Make the data written to a range by the other agents visible.
+ *
+ * \param address Start address of the range.
+ * \param size Size of the range in bytes.
+ */
+void fwk_cache_invalidate(const volatile void *address, size_t size);
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* FWK_CACHE_H */
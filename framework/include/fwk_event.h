@@ -13,12 +13,19 @@
 
 #include <fwk_align.h>
 #include <fwk_id.h>
+#include <fwk_latency.h>
 #include <fwk_list.h>
+#include <fwk_macros.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#if FWK_HAS_INCLUDE(<fmw_thread.h>)
+#    include <fmw_thread.h>
+#endif
+
 /*!
  * \addtogroup GroupLibFramework Framework
  * \{
@@ -35,6 +42,37 @@
  */
 #define FWK_EVENT_PARAMETERS_SIZE 16
 
+/*!
+ * \def FWK_EVENT_PAYLOAD_SIZE
+ *
+ * \brief Size in bytes of each buffer of the event payload pool.
+ */
+#ifdef FMW_EVENT_PAYLOAD_SIZE
+#    define FWK_EVENT_PAYLOAD_SIZE FMW_EVENT_PAYLOAD_SIZE
+#else
+#    define FWK_EVENT_PAYLOAD_SIZE 64
+#endif
+
+/*!
+ * \brief Event priority classes.
+ *
+ * \details When several events are awaiting processing, events of the high
+ *      priority class are processed first. Zero-initialized events belong to
+ *      the normal priority class.
+ *
+ * \note Priority classes are only honoured by the single-threaded framework.
+ */
+enum fwk_event_priority {
+    /*! Default priority class */
+    FWK_EVENT_PRIORITY_NORMAL,
+
+    /*! Priority class for latency-critical events */
+    FWK_EVENT_PRIORITY_HIGH,
+
+    /*! Number of priority classes */
+    FWK_EVENT_PRIORITY_COUNT,
+};
+
 /*!
  * \brief Event.
  *
@@ -76,6 +114,13 @@ struct fwk_event {
      */
     bool is_delayed_response;
 
+    /*!
+     * \brief Priority class of the event.
+     *
+     * \details The priority class of an event is inherited by its response.
+     */
+    enum fwk_event_priority priority;
+
 #ifdef BUILD_HAS_MULTITHREADING
     /*!
      * \internal
@@ -85,6 +130,15 @@ struct fwk_event {
     bool is_thread_wakeup_event;
 #endif
 
+#ifdef FWK_EVENT_LATENCY
+    /*!
+     * \brief Time at which the event was queued.
+     *
+     * \note This field is managed by the framework.
+     */
+    fwk_timestamp_t timestamp;
+#endif
+
     /*!
      * \brief Event identifier.
      *
@@ -94,10 +148,68 @@ struct fwk_event {
      */
     fwk_id_t id;
 
+    /*!
+     * \brief Payload buffer, or \c NULL if the event has none.
+     *
+     * \details Events whose parameters do not fit in ::fwk_event::params may
+     *      reference a buffer obtained from ::fwk_event_payload_alloc(). Every
+     *      event queued by the framework holds its own reference to the
+     *      buffer, which is dropped when the event is freed, so the caller of
+     *      ::fwk_thread_put_event() remains responsible for the reference it
+     *      holds. Responses reference the payload of the event they respond
+     *      to; a handler attaching a different payload to its response must
+     *      first release the one already attached and then store one it holds
+     *      a reference to, which is then owned by the response.
+     */
+    void *payload;
+
     /*! Table of event parameters */
     alignas(max_align_t) uint8_t params[FWK_EVENT_PARAMETERS_SIZE];
 };
 
+/*!
+ * \brief Add buffers to the event payload pool.
+ *
+ * \details Modules reserve, when they are initialized, as many buffers as they
+ *      may hold at the same time. The buffers are allocated from the heap and
+ *      are never released.
+ *
+ * \param count Number of buffers to add to the pool.
+ */
+void fwk_event_payload_reserve(unsigned int count);
+
+/*!
+ * \brief Allocate a buffer from the event payload pool.
+ *
+ * \details The buffer is ::FWK_EVENT_PAYLOAD_SIZE bytes long, suitably aligned
+ *      for any object type with fundamental alignment, and is returned with a
+ *      single reference held by the caller.
+ *
+ * \note This function may be called from an interrupt handler.
+ *
+ * \return Pointer to the buffer, or \c NULL if the pool is exhausted.
+ */
+void *fwk_event_payload_alloc(void);
+
+/*!
+ * \brief Acquire an additional reference to an event payload buffer.
+ *
+ * \param payload Payload buffer. May be \c NULL, in which case this function
+ *      does nothing.
+ */
+void fwk_event_payload_acquire(void *payload);
+
+/*!
+ * \brief Release a reference to an event payload buffer.
+ *
+ * \details The buffer returns to the pool once its last reference has been
+ *      released.
+ *
+ * \param payload Payload buffer. May be \c NULL, in which case this function
+ *      does nothing.
+ */
+void fwk_event_payload_release(void *payload);
+
 /*!
  * \}
  */
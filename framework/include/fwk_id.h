@@ -437,6 +437,11 @@ enum fwk_id_type {
  *      where \c M refers to the module index and \c E refers to the element
  *      index.
  *
+ * \note When deferred binary logging is enabled, see ::FMW_LOG_BINARY, the
+ *      string only carries the packed identifier and is formatted when the
+ *      log message is. It must then only be used as an argument of a log
+ *      message; ::FWK_ID_VERBOSE_STR can be used elsewhere.
+ *
  * \param ID Module or element identifier.
  *
  * \return String representation of the identifier.
@@ -12,11 +12,17 @@
 #define FWK_INTERRUPT_H
 
 #include <fwk_arch.h>
+#include <fwk_macros.h>
+#include <fwk_time.h>
 
 #include <limits.h>
 #include <stdbool.h>
 #include <stdint.h>
 
+#if FWK_HAS_INCLUDE(<fmw_interrupt.h>)
+#    include <fmw_interrupt.h>
+#endif
+
 /*!
  * \addtogroup GroupLibFramework Framework
  * \{
@@ -58,6 +64,77 @@
  */
 #define FWK_INTERRUPT_EXCEPTION (UINT_MAX - 2)
 
+/*!
+ * \def FWK_INTERRUPT_CRITICAL_PRIORITY
+ *
+ * \brief Most urgent priority level masked by critical sections.
+ *
+ * \details When the firmware defines `FMW_INTERRUPT_CRITICAL_PRIORITY` in
+ *      `fmw_interrupt.h`, and the interrupt driver supports priority masking,
+ *      ::fwk_interrupt_global_disable() only masks the interrupts of this
+ *      priority level and of the less urgent levels. The interrupts of the
+ *      more urgent levels are never delayed by the critical sections of the
+ *      framework and of the modules.
+ *
+ *      In exchange, their interrupt service routines must not use the
+ *      resources these critical sections protect. In particular, they may
+ *      only raise events through the ISR event rings, which requires
+ *      `FMW_ISR_EVENT_RING_LEVELS` to cover every priority level more urgent
+ *      than this one, and they must not log, allocate event payloads or
+ *      raise signals or notifications.
+ */
+#ifdef FMW_INTERRUPT_CRITICAL_PRIORITY
+#    define FWK_INTERRUPT_CRITICAL_PRIORITY FMW_INTERRUPT_CRITICAL_PRIORITY
+#endif
+
+/*!
+ * \def FWK_INTERRUPT_STATS
+ *
+ * \brief Defined when interrupt statistics are enabled.
+ *
+ * \details When the firmware defines `FMW_INTERRUPT_STATS` to a non-zero value
+ *      in `fmw_interrupt.h`, the framework interposes itself between the
+ *      interrupt driver and the interrupt service routines of the
+ *      ::FWK_INTERRUPT_STATS_COUNT first interrupts. For each of them, it
+ *      counts the invocations of the routine and accumulates the time spent
+ *      in it, excluding the time spent in the routines of the interrupts that
+ *      preempted it. It also keeps the longest time interrupts were masked by
+ *      a critical section, from the outer-most call to
+ *      ::fwk_interrupt_global_disable() to the matching call to
+ *      ::fwk_interrupt_global_enable().
+ *
+ *      The durations are read from the profiling clock, see
+ *      ::fwk_time_profile_current().
+ */
+#if defined(FMW_INTERRUPT_STATS) && (FMW_INTERRUPT_STATS != 0)
+#    define FWK_INTERRUPT_STATS
+#endif
+
+/*!
+ * \def FWK_INTERRUPT_STATS_COUNT
+ *
+ * \brief Number of interrupts, from interrupt 0, with statistics.
+ */
+#ifdef FMW_INTERRUPT_STATS_COUNT
+#    define FWK_INTERRUPT_STATS_COUNT FMW_INTERRUPT_STATS_COUNT
+#else
+#    define FWK_INTERRUPT_STATS_COUNT 64
+#endif
+
+/*!
+ * \brief Statistics of an interrupt.
+ */
+struct fwk_interrupt_stats {
+    /*! Number of invocations of the interrupt service routine */
+    uint32_t count;
+
+    /*! Time spent in the interrupt service routine */
+    fwk_duration_ns_t total;
+
+    /*! Longest invocation of the interrupt service routine */
+    fwk_duration_ns_t max;
+};
+
 /*!
  * \brief Register interrupt driver in the framework.
  *
@@ -71,6 +148,10 @@ int fwk_interrupt_init(const struct fwk_arch_interrupt_driver *driver);
 /*!
  * \brief Enable interrupts.
  *
+ * \details Leaves a critical section entered with
+ *      ::fwk_interrupt_global_disable(). Interrupts are unmasked when leaving
+ *      the outer-most critical section.
+ *
  * \retval ::FWK_SUCCESS Operation succeeded.
  * \retval ::FWK_E_INIT The component has not been initialized.
  */
@@ -79,11 +160,48 @@ int fwk_interrupt_global_enable(void);
 /*!
  * \brief Disable interrupts.
  *
+ * \details Enters a critical section, which may be nested. When the firmware
+ *      defines ::FWK_INTERRUPT_CRITICAL_PRIORITY, only the interrupts of that
+ *      priority level and of the less urgent levels are masked.
+ *
  * \retval ::FWK_SUCCESS Operation succeeded.
  * \retval ::FWK_E_INIT The component has not been initialized.
  */
 int fwk_interrupt_global_disable(void);
 
+/*!
+ * \brief Mask the interrupts of a priority level and of all the less urgent
+ *      levels.
+ *
+ * \details The interrupts of the more urgent levels remain unmasked, so this
+ *      bounds the delay a section of code adds to them. Calls may be nested,
+ *      each with its own state, the masking only growing with the nesting.
+ *
+ * \param priority Priority level, zero being the most urgent level. Level zero
+ *      cannot be masked on its own, use ::fwk_interrupt_global_disable()
+ *      instead.
+ * \param [out] state Masking state to give to
+ *      ::fwk_interrupt_unmask_priority().
+ *
+ * \retval ::FWK_SUCCESS Operation succeeded.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_SUPPORT The interrupt driver does not mask priority levels.
+ * \retval ::FWK_E_INIT The component has not been initialized.
+ */
+int fwk_interrupt_mask_priority(unsigned int priority, unsigned int *state);
+
+/*!
+ * \brief Restore the priority masking in place before the matching call to
+ *      ::fwk_interrupt_mask_priority().
+ *
+ * \param state Masking state given by ::fwk_interrupt_mask_priority().
+ *
+ * \retval ::FWK_SUCCESS Operation succeeded.
+ * \retval ::FWK_E_SUPPORT The interrupt driver does not mask priority levels.
+ * \retval ::FWK_E_INIT The component has not been initialized.
+ */
+int fwk_interrupt_unmask_priority(unsigned int state);
+
 /*!
  * \brief Test whether an interrupt is enabled.
  *
@@ -199,6 +317,55 @@ int fwk_interrupt_set_isr_param(unsigned int interrupt,
  */
 int fwk_interrupt_get_current(unsigned int *interrupt);
 
+/*!
+ * \brief Get the priority level of the interrupt service routine being
+ *      processed.
+ *
+ * \param [out] priority Priority level, zero being the most urgent level.
+ *
+ * \retval ::FWK_SUCCESS Operation succeeded.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_STATE An interrupt is not currently being serviced.
+ * \retval ::FWK_E_SUPPORT The interrupt driver does not report priority
+ *      levels, or the current interrupt has no priority level.
+ * \retval ::FWK_E_INIT The component has not been initialized.
+ */
+int fwk_interrupt_get_current_priority(unsigned int *priority);
+
+/*!
+ * \brief Get the statistics of an interrupt.
+ *
+ * \param interrupt Interrupt number.
+ * \param [out] stats Statistics of the interrupt.
+ *
+ * \retval ::FWK_SUCCESS Operation succeeded.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_SUPPORT Interrupt statistics are disabled.
+ */
+int fwk_interrupt_get_stats(
+    unsigned int interrupt,
+    struct fwk_interrupt_stats *stats);
+
+/*!
+ * \brief Get the longest time interrupts were masked by a critical section.
+ *
+ * \param [out] duration Longest critical section.
+ *
+ * \retval ::FWK_SUCCESS Operation succeeded.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_SUPPORT Interrupt statistics are disabled.
+ */
+int fwk_interrupt_get_masked_max(fwk_duration_ns_t *duration);
+
+/*!
+ * \brief Clear the statistics of all interrupts and the longest critical
+ *      section.
+ *
+ * \retval ::FWK_SUCCESS Operation succeeded.
+ * \retval ::FWK_E_SUPPORT Interrupt statistics are disabled.
+ */
+int fwk_interrupt_reset_stats(void);
+
 /*!
  * \}
  */
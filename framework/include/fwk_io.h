@@ -180,6 +180,48 @@ struct fwk_io_adapter {
      */
     int (*putch)(const struct fwk_io_stream *stream, char ch);
 
+    /*!
+     * \brief Write a span of characters to the stream.
+     *
+     * \details Write every character of the span to the stream, with the same
+     *      result as writing them one by one with
+     *      [putch](::fwk_io_adapter::putch).
+     *
+     *      The `stream` and `buffer` parameters are guaranteed to be non-null.
+     *
+     * \note This field may be set to a null pointer value, in which case the
+     *      characters are written one by one.
+     *
+     * \param[in] stream Stream to write to.
+     * \param[in] buffer Characters to write to the stream.
+     * \param[in] size Number of characters to write.
+     *
+     * \return Status code representing the result of the operation.
+     *
+     * \retval ::FWK_SUCCESS The characters were successfully written.
+     */
+    int (*write)(
+        const struct fwk_io_stream *stream,
+        const char *buffer,
+        size_t size);
+
+    /*!
+     * \brief Flush the stream.
+     *
+     * \details Wait until every character written to the stream has been
+     *      sent, including those buffered by the adapter.
+     *
+     *      The `stream` parameter is guaranteed to be non-null.
+     *
+     * \note This field may be set to a null pointer value if the adapter does
+     *      not buffer characters.
+     *
+     * \param[in] stream Stream to flush.
+     *
+     * \return Status code representing the result of the operation.
+     */
+    int (*flush)(const struct fwk_io_stream *stream);
+
     /*!
      * \brief Close the stream.
      *
@@ -362,6 +404,10 @@ int fwk_io_read(
  *      `size` times for each object, in order. The `written` parameter is
  *      optional, and may be set to a null pointer value.
  *
+ *      When the stream adapter provides a [write](::fwk_io_adapter::write)
+ *      operation, all the objects are handed to it in a single call. If it
+ *      fails, `written` is left at zero.
+ *
  * \param[in] stream Output stream.
  * \param[out] written Number of objects written.
  * \param[in] buffer Pointer to the first object in the array to be written.
@@ -388,7 +434,8 @@ int fwk_io_write(
 /*!
  * \brief Write a string to a stream.
  *
- * \details Writes a string, character by character, to an output stream.
+ * \details Writes a string to an output stream, in the same way as
+ *      ::fwk_io_write.
  *
  * \param[in] stream Stream to write to.
  * \param[in] str String to write.
@@ -469,6 +516,23 @@ int fwk_io_printf(
     const char *restrict format,
     ...);
 
+/*!
+ * \brief Flush a stream.
+ *
+ * \details Waits until every character written to the stream has been sent,
+ *      including those buffered by the stream adapter.
+ *
+ * \param[in] stream Stream to flush.
+ *
+ * \return Status code representing the result of the operation.
+ *
+ * \retval ::FWK_SUCCESS The stream was successfully flushed.
+ * \retval ::FWK_E_PARAM The `stream` parameter was a null pointer value.
+ * \retval ::FWK_E_STATE The stream is not open.
+ * \retval ::FWK_E_HANDLER The stream adapter encountered an error.
+ */
+int fwk_io_flush(const struct fwk_io_stream *stream);
+
 /*!
  * \brief Close a stream.
  *
@@ -0,0 +1,187 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FWK_LATENCY_H
+#define FWK_LATENCY_H
+
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_time.h>
+
+#include <stdint.h>
+
+#if FWK_HAS_INCLUDE(<fmw_thread.h>)
+#    include <fmw_thread.h>
+#endif
+
+/*!
+ * \addtogroup GroupLibFramework Framework
+ * \{
+ */
+
+/*!
+ * \defgroup GroupLatency Event Latency
+ *
+ * \brief Event lifecycle latency measurements.
+ *
+ * \details When the firmware defines `FMW_EVENT_LATENCY` to a non-zero value
+ *      in `fmw_thread.h`, the framework timestamps every event when it is
+ *      queued, when it is dispatched to its target and when the handler of the
+ *      target returns. For each event and notification defined by a module, it
+ *      keeps a histogram of the time spent waiting in the queues and one of the
+ *      time spent in the handler.
+ *
+ *      Histogram bucket `0` counts the durations below one microsecond. Bucket
+ *      `n` counts the durations from 2^(n - 1) up to, but excluding, 2^n
+ *      microseconds, with the last bucket also counting every longer duration.
+ *
+ *      Independently, when the firmware defines `FMW_EVENT_BUDGET_US` to a
+ *      non-zero value in `fmw_thread.h`, the framework times every event and
+ *      notification handler on the profiling clock, see
+ *      ::fwk_time_profile_current(), and checks it against a time budget: that
+ *      of the module processing the event, see ::fwk_module::event_budget_us,
+ *      or `FMW_EVENT_BUDGET_US` microseconds. Overruns are counted and the
+ *      events whose handlers overran the most are kept, and logged whenever
+ *      their longest overrun grows. When `FMW_EVENT_BUDGET_TRAP` is defined to
+ *      a non-zero value, the first overrun traps instead, which suits
+ *      continuous integration.
+ *
+ * \{
+ */
+
+/*!
+ * \def FWK_EVENT_LATENCY
+ *
+ * \brief Defined when event latency measurements are enabled.
+ */
+#if defined(FMW_EVENT_LATENCY) && (FMW_EVENT_LATENCY != 0)
+#    define FWK_EVENT_LATENCY
+#endif
+
+/*!
+ * \def FWK_EVENT_LATENCY_BUCKET_COUNT
+ *
+ * \brief Number of buckets in each latency histogram.
+ */
+#ifdef FMW_EVENT_LATENCY_BUCKETS
+#    define FWK_EVENT_LATENCY_BUCKET_COUNT FMW_EVENT_LATENCY_BUCKETS
+#else
+#    define FWK_EVENT_LATENCY_BUCKET_COUNT 12
+#endif
+
+/*!
+ * \def FWK_EVENT_BUDGET
+ *
+ * \brief Defined when the handler time budget is checked.
+ */
+#if defined(FMW_EVENT_BUDGET_US) && (FMW_EVENT_BUDGET_US != 0)
+#    define FWK_EVENT_BUDGET
+#endif
+
+/*!
+ * \def FWK_EVENT_BUDGET_OFFENDER_COUNT
+ *
+ * \brief Number of events whose handler overruns are kept.
+ */
+#ifdef FMW_EVENT_BUDGET_OFFENDERS
+#    define FWK_EVENT_BUDGET_OFFENDER_COUNT FMW_EVENT_BUDGET_OFFENDERS
+#else
+#    define FWK_EVENT_BUDGET_OFFENDER_COUNT 8
+#endif
+
+/*!
+ * \brief Latency histogram.
+ */
+struct fwk_latency_histogram {
+    /*! Number of samples in each bucket */
+    uint32_t buckets[FWK_EVENT_LATENCY_BUCKET_COUNT];
+
+    /*! Sum of all the samples */
+    fwk_duration_ns_t total;
+
+    /*! Longest sample */
+    fwk_duration_ns_t max;
+};
+
+/*!
+ * \brief Latency statistics of an event or notification.
+ */
+struct fwk_latency_stats {
+    /*! Time between the event being queued and being dispatched */
+    struct fwk_latency_histogram queue;
+
+    /*! Time spent in the handler of the target */
+    struct fwk_latency_histogram handler;
+};
+
+/*!
+ * \brief Handler time budget overruns of an event or notification.
+ */
+struct fwk_latency_overrun {
+    /*! Event or notification identifier */
+    fwk_id_t id;
+
+    /*! Target of the event whose handler overran the most */
+    fwk_id_t target_id;
+
+    /*! Number of overruns */
+    uint32_t count;
+
+    /*! Longest handler time */
+    fwk_duration_ns_t max;
+};
+
+/*!
+ * \brief Get the latency statistics of an event or notification.
+ *
+ * \param id Event or notification identifier.
+ * \param[out] stats Latency statistics.
+ *
+ * \retval ::FWK_SUCCESS The statistics were returned.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_SUPPORT Event latency measurements are disabled.
+ */
+int fwk_latency_get_stats(fwk_id_t id, struct fwk_latency_stats *stats);
+
+/*!
+ * \brief Get the handler time budget overruns.
+ *
+ * \details The events and notifications whose handlers overran their budget
+ *      the most are returned by decreasing longest handler time.
+ *
+ * \param[out] overruns Table of ::FWK_EVENT_BUDGET_OFFENDER_COUNT entries
+ *      receiving the overruns.
+ * \param[out] count Number of entries filled in \p overruns.
+ * \param[out] total Number of overruns of all the events and notifications.
+ *
+ * \retval ::FWK_SUCCESS The overruns were returned.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_SUPPORT The handler time budget is not checked.
+ */
+int fwk_latency_get_overruns(
+    struct fwk_latency_overrun *overruns,
+    unsigned int *count,
+    uint32_t *total);
+
+/*!
+ * \brief Clear all the latency statistics and budget overruns.
+ *
+ * \retval ::FWK_SUCCESS The statistics were cleared.
+ * \retval ::FWK_E_SUPPORT Neither event latency measurements nor the handler
+ *      time budget are enabled.
+ */
+int fwk_latency_reset(void);
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* FWK_LATENCY_H */
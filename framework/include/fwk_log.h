@@ -9,6 +9,7 @@
 #define FWK_LOG_H
 
 #include <fwk_attributes.h>
+#include <fwk_id.h>
 #include <fwk_io.h>
 #include <fwk_macros.h>
 
@@ -16,6 +17,13 @@
 #    include <fmw_log.h>
 #endif
 
+#ifdef BUILD_MODULE_IDX
+#    include <fwk_module_idx.h>
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
 /*!
  * \addtogroup GroupLibFramework Framework
  * \{
@@ -113,6 +121,38 @@
 #    define FWK_LOG_BUFFERED
 #endif
 
+/*!
+ * \def FMW_LOG_BINARY
+ *
+ * \brief Enable deferred binary logging.
+ *
+ * \details When buffering is enabled and this definition is set to a non-zero
+ *      value in a `<fmw_log.h>` header, log messages are not formatted when
+ *      they are logged. Instead, the address of the format string, the raw
+ *      timestamp and the raw arguments are stored in the internal buffer, and
+ *      the message is formatted by ::fwk_log_unbuffer() once the system is
+ *      idle.
+ *
+ * \note Arguments of the `%s` conversion are copied into the buffer, and the
+ *      `%n` conversion is not supported.
+ *
+ * \note Format strings must remain valid for the lifetime of the firmware, as
+ *      it is the case for string literals.
+ */
+#ifndef FMW_LOG_BINARY
+#    define FMW_LOG_BINARY 0
+#endif
+
+#if defined(FWK_LOG_BUFFERED) && (FMW_LOG_BINARY != 0)
+/*!
+ * \def FWK_LOG_BINARY
+ *
+ * \brief Determines whether deferred binary logging has been enabled within
+ *      the logging framework.
+ */
+#    define FWK_LOG_BINARY
+#endif
+
 /*!
  * \def FMW_LOG_COLUMNS
  *
@@ -128,6 +168,19 @@
 #    define FMW_LOG_COLUMNS 80
 #endif
 
+/*!
+ * \def FMW_LOG_CHUNK_SIZE
+ *
+ * \brief Number of characters sent to the logging backend at once by
+ *      ::fwk_log_unbuffer_chunk().
+ *
+ * \note This definition has a default value of `64`.
+ */
+
+#ifndef FMW_LOG_CHUNK_SIZE
+#    define FMW_LOG_CHUNK_SIZE 64
+#endif
+
 /*!
  * \addtogroup GroupLoggingLevels Filter Levels
  *
@@ -135,6 +188,11 @@
  *      of messages, and to filter them if desired. Filtering happens at
  *      preprocessing-time, and consequently filtered messages do not contribute
  *      to the image.
+ *
+ *      Messages logged by a module and kept in the image are filtered again at
+ *      runtime against the level of the module, which can be changed with
+ *      ::fwk_log_set_level(). This check happens before the message is
+ *      formatted, so a filtered message costs a single comparison.
  * \{
  */
 
@@ -183,6 +241,119 @@
  * \}
  */
 
+/*!
+ * \def FMW_LOG_RUNTIME_LEVEL
+ *
+ * \brief Initial runtime filter level of every module.
+ *
+ * \details Messages of a lower level are kept in the image, but are not logged
+ *      until the level of their module is lowered with ::fwk_log_set_level().
+ *
+ * \note This definition has a default value of ::FWK_LOG_LEVEL_TRACE, which
+ *      leaves filtering to ::FWK_LOG_LEVEL.
+ */
+#ifndef FMW_LOG_RUNTIME_LEVEL
+#    define FMW_LOG_RUNTIME_LEVEL FWK_LOG_LEVEL_TRACE
+#endif
+
+/*!
+ * \def FMW_LOG_RATE_BURST
+ *
+ * \brief Number of messages a call site may log in a burst.
+ *
+ * \details When this definition is set to a non-zero value, every logging call
+ *      site owns a token bucket holding up to this number of messages and
+ *      regaining one message every ::FMW_LOG_RATE_PERIOD_MS milliseconds.
+ *      Messages logged while the bucket of their call site is empty are
+ *      dropped before they are formatted, so that a storm of identical errors
+ *      cannot starve the rest of the firmware.
+ *
+ * \note The bucket of each call site takes a few bytes of memory.
+ *
+ * \note This definition has a default value of `0`, which disables rate
+ *      limiting.
+ */
+#ifndef FMW_LOG_RATE_BURST
+#    define FMW_LOG_RATE_BURST 0
+#endif
+
+/*!
+ * \def FMW_LOG_RATE_PERIOD_MS
+ *
+ * \brief Time it takes a call site to regain one message, in milliseconds.
+ *
+ * \note This definition has a default value of `100`.
+ */
+#ifndef FMW_LOG_RATE_PERIOD_MS
+#    define FMW_LOG_RATE_PERIOD_MS 100
+#endif
+
+/*!
+ * \internal
+ *
+ * \brief Runtime filter level of each module, indexed by module index.
+ */
+extern unsigned char fwk_log_level_table[];
+
+/*!
+ * \internal
+ *
+ * \brief Token bucket of a logging call site.
+ */
+struct fwk_log_bucket {
+    /*! Timestamp up to which tokens have been regained */
+    uint64_t refill;
+
+    /*! Number of messages logged since the bucket was last full */
+    unsigned int spent;
+};
+
+/*!
+ * \internal
+ *
+ * \def FWK_LOG_IS_ENABLED
+ *
+ * \brief Check whether a message of a given level is logged by the current
+ *      module.
+ *
+ * \details Code that is not part of a module is only filtered at
+ *      preprocessing time.
+ *
+ * \param[in] LEVEL Filter level of the message.
+ */
+#ifdef BUILD_MODULE_IDX
+#    define FWK_LOG_IS_ENABLED(LEVEL) \
+        (fwk_log_level_table[BUILD_MODULE_IDX] <= (LEVEL))
+#else
+#    define FWK_LOG_IS_ENABLED(LEVEL) true
+#endif
+
+/*!
+ * \internal
+ *
+ * \def FWK_LOG_EMIT
+ *
+ * \brief Log a message if its level and its call site allow it.
+ *
+ * \param[in] LEVEL Filter level of the message.
+ * \param[in] ... Format string and any associated parameters.
+ */
+#if FMW_LOG_RATE_BURST > 0
+#    define FWK_LOG_EMIT(LEVEL, ...) \
+        do { \
+            static struct fwk_log_bucket fwk_log_bucket_; \
+            if (FWK_LOG_IS_ENABLED(LEVEL) && \
+                fwk_log_bucket_take(&fwk_log_bucket_)) \
+                fwk_log_printf(__VA_ARGS__); \
+        } while (0)
+#else
+#    define FWK_LOG_EMIT(LEVEL, ...) \
+        do { \
+            if (FWK_LOG_IS_ENABLED(LEVEL)) \
+                fwk_log_printf(__VA_ARGS__); \
+        } while (0)
+#endif
+
 /*!
  * \internal
  *
@@ -232,7 +403,7 @@
  */
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_TRACE
-#    define FWK_LOG_TRACE(...) fwk_log_printf(__VA_ARGS__)
+#    define FWK_LOG_TRACE(...) FWK_LOG_EMIT(FWK_LOG_LEVEL_TRACE, __VA_ARGS__)
 #else
 #    define FWK_LOG_TRACE(...) FWK_LOG_VOID(__VA_ARGS__)
 #endif
@@ -246,7 +417,7 @@
  */
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_INFO
-#    define FWK_LOG_INFO(...) fwk_log_printf(__VA_ARGS__)
+#    define FWK_LOG_INFO(...) FWK_LOG_EMIT(FWK_LOG_LEVEL_INFO, __VA_ARGS__)
 #else
 #    define FWK_LOG_INFO(...) FWK_LOG_VOID(__VA_ARGS__)
 #endif
@@ -260,7 +431,7 @@
  */
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_WARN
-#    define FWK_LOG_WARN(...) fwk_log_printf(__VA_ARGS__)
+#    define FWK_LOG_WARN(...) FWK_LOG_EMIT(FWK_LOG_LEVEL_WARN, __VA_ARGS__)
 #else
 #    define FWK_LOG_WARN(...) FWK_LOG_VOID(__VA_ARGS__)
 #endif
@@ -274,7 +445,7 @@
  */
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_ERROR
-#    define FWK_LOG_ERR(...) fwk_log_printf(__VA_ARGS__)
+#    define FWK_LOG_ERR(...) FWK_LOG_EMIT(FWK_LOG_LEVEL_ERROR, __VA_ARGS__)
 #else
 #    define FWK_LOG_ERR(...) FWK_LOG_VOID(__VA_ARGS__)
 #endif
@@ -288,7 +459,7 @@
  */
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_CRIT
-#    define FWK_LOG_CRIT(...) fwk_log_printf(__VA_ARGS__)
+#    define FWK_LOG_CRIT(...) FWK_LOG_EMIT(FWK_LOG_LEVEL_CRIT, __VA_ARGS__)
 #else
 #    define FWK_LOG_CRIT(...) FWK_LOG_VOID(__VA_ARGS__)
 #endif
@@ -310,6 +481,45 @@ void fwk_log_printf(const char *format, ...) FWK_PRINTF(1, 2);
  */
 void fwk_log_flush(void);
 
+/*!
+ * \internal
+ *
+ * \brief Take a token from the bucket of a call site.
+ *
+ * \param[in, out] bucket Token bucket of the call site.
+ *
+ * \retval true The message may be logged.
+ * \retval false The message must be dropped.
+ */
+bool fwk_log_bucket_take(struct fwk_log_bucket *bucket);
+
+/*!
+ * \brief Set the runtime filter level of a module.
+ *
+ * \param[in] id Identifier of the module, or of one of its elements.
+ * \param[in] level New filter level, from ::FWK_LOG_LEVEL_TRACE to
+ *      ::FWK_LOG_LEVEL_CRIT.
+ *
+ * \retval ::FWK_SUCCESS The level was set.
+ * \retval ::FWK_E_PARAM The identifier or the level is not valid.
+ *
+ * \return Status code representing the result of the operation.
+ */
+int fwk_log_set_level(fwk_id_t id, unsigned int level);
+
+/*!
+ * \brief Get the runtime filter level of a module.
+ *
+ * \param[in] id Identifier of the module, or of one of its elements.
+ * \param[out] level Current filter level.
+ *
+ * \retval ::FWK_SUCCESS The level was returned.
+ * \retval ::FWK_E_PARAM The identifier is not valid or `level` is `NULL`.
+ *
+ * \return Status code representing the result of the operation.
+ */
+int fwk_log_get_level(fwk_id_t id, unsigned int *level);
+
 /*!
  * \internal
  *
@@ -329,6 +539,28 @@ void fwk_log_flush(void);
  */
 int fwk_log_unbuffer(void);
 
+/*!
+ * \internal
+ *
+ * \brief Unbuffer up to ::FMW_LOG_CHUNK_SIZE characters and send them to the
+ *      logging backend in a single write.
+ *
+ * \details This function is reserved for the framework implementation, and is
+ *      used by the logging thread of multi-threaded firmware. The characters
+ *      are taken from the buffer with interrupts disabled, but written to the
+ *      backend with interrupts enabled.
+ *
+ * \warning This function must only be called from a single thread.
+ *
+ * \retval ::FWK_PENDING Characters were unbuffered successfully but there may
+ *      be characters remaining in the buffer.
+ * \retval ::FWK_SUCCESS The buffer is empty.
+ * \retval ::FWK_E_DEVICE The backend returned an error.
+ *
+ * \return Status code representing the result of the operation.
+ */
+int fwk_log_unbuffer_chunk(void);
+
 /*!
  * \internal
  *
@@ -48,6 +48,21 @@
     unsigned long: __builtin_clzl, \
     unsigned long long: __builtin_clzll)(num)
 
+/*!
+ * \brief Count the trailing zeros of an unsigned integer.
+ *
+ * \param num Operation input. The result is undefined if \p num is \c 0.
+ *
+ * \return Number of trailing zeroes in the \p num parameter.
+ *
+ * \note The type of the value returned by this macro is that of the \p num
+ *      parameter.
+ */
+#define fwk_math_ctz(num) _Generic((num), \
+    unsigned int: __builtin_ctz, \
+    unsigned long: __builtin_ctzl, \
+    unsigned long long: __builtin_ctzll)(num)
+
 /*!
  * \brief Calculate the binary logarithm (log2) of an integer value.
  *
@@ -9,7 +9,9 @@
 #define FWK_MM_H
 
 #include <fwk_attributes.h>
+#include <fwk_id.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
@@ -29,9 +31,49 @@
  *      and stronger portability guarantees across the variety of systems that
  *      the framework supports.
  *
+ * \details When the firmware defines `FMW_MM_ARENA_SIZE` in `fmw_memory.h`,
+ *      ::fwk_mm_alloc(), ::fwk_mm_calloc() and their aligned variants serve
+ *      requests from a statically-allocated arena of that many bytes, without
+ *      per-block bookkeeping. The arena is locked once every module has been
+ *      started; any allocation made through these functions afterwards is
+ *      served by the heap and counted as a late allocation, see
+ *      ::fwk_mm_get_arena_info().
+ *
+ * \details Allocations made through ::fwk_mm_alloc(), ::fwk_mm_calloc() and
+ *      their aligned variants are attributed to the module being initialized,
+ *      bound or started at the time, see ::fwk_mm_get_usage().
+ *
  * \{
  */
 
+/*!
+ * \brief Allocation usage of a module.
+ */
+struct fwk_mm_usage {
+    /*! Number of bytes requested */
+    size_t size;
+
+    /*! Number of allocations */
+    unsigned int count;
+};
+
+/*!
+ * \brief Arena usage information.
+ */
+struct fwk_mm_arena_info {
+    /*! Size of the arena in bytes */
+    size_t size;
+
+    /*! Number of bytes consumed, including any alignment padding */
+    size_t used;
+
+    /*! Whether the arena has been locked */
+    bool locked;
+
+    /*! Number of allocations requested after the arena was locked */
+    unsigned int late_alloc_count;
+};
+
 /*!
  * \brief Allocates memory for an array of `num` objects of `size`.
  *
@@ -275,6 +317,44 @@ void *fwk_mm_realloc(void *ptr, size_t num, size_t size) FWK_LEAF FWK_NOTHROW
  */
 void fwk_mm_free(void *ptr) FWK_LEAF FWK_NOTHROW;
 
+/*!
+ * \brief Get the usage information of the allocation arena.
+ *
+ * \param[out] info Arena usage information.
+ *
+ * \retval ::FWK_SUCCESS The information was returned.
+ * \retval ::FWK_E_PARAM `info` is a null pointer.
+ * \retval ::FWK_E_SUPPORT The firmware does not use an allocation arena.
+ */
+int fwk_mm_get_arena_info(struct fwk_mm_arena_info *info);
+
+/*!
+ * \brief Get the allocation usage attributed to a module.
+ *
+ * \details Only the allocations made through ::fwk_mm_alloc(),
+ *      ::fwk_mm_calloc() and their aligned variants are accounted. Allocations
+ *      made outside of the pre-runtime phase are attributed to the framework.
+ *
+ * \param id Module identifier, or ::FWK_ID_NONE for the framework.
+ * \param[out] usage Allocation usage.
+ *
+ * \retval ::FWK_SUCCESS The usage was returned.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ */
+int fwk_mm_get_usage(fwk_id_t id, struct fwk_mm_usage *usage);
+
+/*!
+ * \brief Get the high-water marks of the stack and heap region.
+ *
+ * \param[out] heap_size Largest number of bytes claimed by the heap.
+ * \param[out] stack_size Largest number of bytes used by the stack.
+ *
+ * \retval ::FWK_SUCCESS The high-water marks were returned.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_SUPPORT The architecture cannot measure them.
+ */
+int fwk_mm_get_stackheap_high_water(size_t *heap_size, size_t *stack_size);
+
 /*!
  * \}
  */
@@ -15,10 +15,17 @@
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_io.h>
+#include <fwk_macros.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#if FWK_HAS_INCLUDE(<fmw_module.h>)
+#    include <fmw_module.h>
+#endif
+
 /*!
  * \addtogroup GroupLibFramework Framework
  * \{
@@ -257,6 +264,21 @@ struct fwk_module {
     int (*process_bind_request)(fwk_id_t source_id, fwk_id_t target_id,
                                 fwk_id_t api_id, const void **api);
 
+    /*!
+     * \brief Mask of the APIs whose bind requests do not depend on the
+     *      requester.
+     *
+     * \details Bit n is set when, for a given target, the bind requests to the
+     *      API of index n are accepted from every requester and always return
+     *      the same implementation. The framework then keeps the
+     *      implementation returned by ::fwk_module::process_bind_request for
+     *      the target and API, and hands it to the next requesters without
+     *      calling the function again.
+     *
+     * \note This field is \b optional.
+     */
+    uint32_t bind_shared_api_mask;
+
     /*!
      * \brief Process an event.
      *
@@ -315,11 +337,25 @@ struct fwk_module {
      * \return One of the other module-defined error codes.
      */
     int (*process_signal)(const fwk_id_t target_id, const fwk_id_t signal_id);
+
+    /*!
+     * \brief Time budget of the event and notification handlers of the
+     *      module, in microseconds.
+     *
+     * \details Handlers taking longer are reported as overruns, see
+     *      \ref GroupLatency.
+     *
+     * \note This field is \b optional. When zero, the budget set by the
+     *      firmware applies.
+     */
+    uint32_t event_budget_us;
 };
 
 /*!
  * \brief Define a static element table with the content of the table.
  *
+ * \details The number of elements of the table is resolved at build time.
+ *
  * \param[in] ... An array of elements in the form `{ X, Y, Z, { 0 } }`.
  *
  * \see ::fwk_module_elements::table
@@ -328,6 +364,8 @@ struct fwk_module {
     { \
         .type = FWK_MODULE_ELEMENTS_TYPE_STATIC, \
         .table = (const struct fwk_element[])__VA_ARGS__, \
+        .count = (sizeof((const struct fwk_element[])__VA_ARGS__) / \
+                  sizeof(struct fwk_element)) - 1, \
     }
 
 /*!
@@ -419,6 +457,16 @@ struct fwk_module_elements {
          */
         const struct fwk_element *table;
     };
+
+    /*!
+     * \brief Number of elements of a static element table, excluding the
+     *      terminating element description.
+     *
+     * \details When zero, the framework counts the elements of the table when
+     *      it initializes the module. ::FWK_MODULE_STATIC_ELEMENTS sets it at
+     *      build time.
+     */
+    size_t count;
 };
 
 /*!
@@ -430,6 +478,89 @@ struct fwk_module_config {
 
     /*! Element table */
     struct fwk_module_elements elements;
+
+    /*!
+     * \brief Defer the start of the module.
+     *
+     * \details The module and its elements are not started during the start
+     *      stage but once the runtime phase has no event left to process, so
+     *      that they do not delay the modules on the critical path. Deferred
+     *      modules are started in module order, and an event or notification
+     *      sent to a deferred module that has not started yet starts it, and
+     *      the deferred modules before it, first.
+     *
+     *      The APIs of a deferred module may be called before it has started,
+     *      so only modules whose APIs are usable once bound should be
+     *      deferred.
+     *
+     * \note This option is ignored by firmware with multithreading support.
+     */
+    bool deferred_start;
+};
+
+/*!
+ * \def FWK_BOOT_PROFILE
+ *
+ * \brief Defined when the firmware defines `FMW_BOOT_PROFILE` to a non-zero
+ *      value in `fmw_module.h`, in which case the framework measures the time
+ *      spent by each module in each of the pre-runtime phases.
+ */
+#if defined(FMW_BOOT_PROFILE) && (FMW_BOOT_PROFILE != 0)
+#    define FWK_BOOT_PROFILE
+#endif
+
+/*!
+ * \brief Pre-runtime phases measured by the boot profiler.
+ */
+enum fwk_module_boot_phase {
+    /*! Element generation and module initialization */
+    FWK_MODULE_BOOT_PHASE_INIT,
+
+    /*! Initialization of the elements */
+    FWK_MODULE_BOOT_PHASE_ELEMENT_INIT,
+
+    /*! Post-initialization */
+    FWK_MODULE_BOOT_PHASE_POST_INIT,
+
+    /*! First binding round of the module and its elements */
+    FWK_MODULE_BOOT_PHASE_BIND_ROUND_0,
+
+    /*! Second binding round of the module and its elements */
+    FWK_MODULE_BOOT_PHASE_BIND_ROUND_1,
+
+    /*! Start of the module and its elements */
+    FWK_MODULE_BOOT_PHASE_START,
+
+    /*! Number of measured phases */
+    FWK_MODULE_BOOT_PHASE_COUNT
+};
+
+/*!
+ * \brief Boot profile of a module.
+ */
+struct fwk_module_boot_profile {
+    /*! Module identifier */
+    fwk_id_t module_id;
+
+    /*! Time spent by the module in each pre-runtime phase */
+    fwk_duration_ns_t phases[FWK_MODULE_BOOT_PHASE_COUNT];
+
+    /*! Time spent by the module in all the pre-runtime phases */
+    fwk_duration_ns_t total;
+
+    /*!
+     * \brief Time spent processing the bind requests made to the module.
+     *
+     * \details This time is accounted to the binding rounds of the
+     *      requesters, and is thus not included in the total of the module.
+     */
+    fwk_duration_ns_t bind_requests;
+
+    /*! Number of bind requests made to the module */
+    unsigned int bind_request_count;
+
+    /*! Number of bind requests made to the module answered from the cache */
+    unsigned int bind_cache_hit_count;
 };
 
 /*!
@@ -586,6 +717,27 @@ int fwk_module_bind(fwk_id_t target_id, fwk_id_t api_id, const void *api);
  */
 int fwk_module_adapter(const struct fwk_io_adapter **adapter, fwk_id_t id);
 
+/*!
+ * \brief Get the boot profile of the modules.
+ *
+ * \details The profile is available once every module has started, and its
+ *      entries are sorted from the module that took the most time to boot to
+ *      the one that took the least. Durations are measured with
+ *      ::fwk_time_current(), and are all zero if the firmware has no time
+ *      driver.
+ *
+ * \param[out] table Table of module boot profiles.
+ * \param[out] count Number of entries in the table.
+ *
+ * \retval ::FWK_SUCCESS The profile was returned.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_STATE The modules have not all started yet.
+ * \retval ::FWK_E_SUPPORT The boot profiler is disabled.
+ */
+int fwk_module_get_boot_profile(
+    const struct fwk_module_boot_profile **table,
+    size_t *count);
+
 /*!
  * \internal
  *
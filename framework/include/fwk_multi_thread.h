@@ -11,7 +11,15 @@
 #include <fwk_attributes.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
+#include <fwk_macros.h>
 #include <fwk_thread.h>
+#include <fwk_time.h>
+
+#include <stdint.h>
+
+#if FWK_HAS_INCLUDE(<fmw_thread.h>)
+#    include <fmw_thread.h>
+#endif
 
 /*!
  * \addtogroup GroupLibFramework Framework
@@ -21,9 +29,65 @@
 /*!
  * \defgroup GroupThread Threading
  *
+ * \details When the firmware defines `FMW_THREAD_PROFILE` to a non-zero value
+ *      in `fmw_thread.h`, the framework keeps a profile of each module: the
+ *      time spent in its handlers, and the time other threads spent waiting
+ *      for it in ::fwk_thread_put_event_and_wait(). From the profiles, it
+ *      plans which modules should be given their own thread: when a module
+ *      waited for by other threads shares the common thread with modules whose
+ *      handlers ran for ::FWK_THREAD_PLAN_HANDLER_US microseconds or more, the
+ *      latter are isolated. The plan is logged with the thread metrics, see
+ *      ::fwk_thread_log_metrics().
+ *
+ *      A plan is applied at boot when the firmware defines `FMW_THREAD_PLAN`
+ *      in `fmw_thread.h` to an initializer list of module indices, e.g.
+ *      `{ FWK_MODULE_IDX_SENSOR }`: a thread is created for each of these
+ *      modules that has not created its own thread during the initialization.
+ *
  * \{
  */
 
+/*!
+ * \def FWK_THREAD_PROFILE
+ *
+ * \brief Defined when the module profiles are kept.
+ */
+#if defined(FMW_THREAD_PROFILE) && (FMW_THREAD_PROFILE != 0)
+#    define FWK_THREAD_PROFILE
+#endif
+
+/*!
+ * \def FWK_THREAD_PLAN_HANDLER_US
+ *
+ * \brief Handler time, in microseconds, from which the thread plan isolates a
+ *      module.
+ */
+#ifdef FMW_THREAD_PLAN_HANDLER_US
+#    define FWK_THREAD_PLAN_HANDLER_US FMW_THREAD_PLAN_HANDLER_US
+#else
+#    define FWK_THREAD_PLAN_HANDLER_US 1000
+#endif
+
+/*!
+ * \brief Profile of a module.
+ */
+struct fwk_thread_profile {
+    /*! Number of events and notifications processed by the module */
+    uint32_t event_count;
+
+    /*! Total time spent in the handlers of the module */
+    fwk_duration_ns_t total_handler_time;
+
+    /*! Longest time spent in a handler of the module */
+    fwk_duration_ns_t max_handler_time;
+
+    /*! Number of times a thread waited for the module to process an event */
+    uint32_t waited_count;
+
+    /*! Total time the threads waited for the module to process events */
+    fwk_duration_ns_t total_waited_time;
+};
+
 /*!
  * \brief Create a thread for a module or element
  *
@@ -67,12 +131,18 @@ int fwk_thread_create(fwk_id_t id);
  *      The event identifier and target identifier are validated and must
  *      belong to the same module.
  *
+ *      While the calling thread waits, the thread processing the event runs
+ *      with at least the priority of the calling thread, so that threads of
+ *      intermediate priority cannot delay the response indefinitely.
+ *
  *      Warning: As this API could have serious adverse effects on system
  *               performance and throughput, this API has been deprecated
  *               and should not be used in single-threaded mode.
  *
  * \param event Event to put into the queue for processing. Must not be \c NULL.
- * \param[out] resp_event The response event. Must not be \c NULL.
+ * \param[out] resp_event The response event. Must not be \c NULL. The caller
+ *      owns a reference to the payload of the response, if any, and must
+ *      release it with ::fwk_event_payload_release().
  *
  * \retval ::FWK_SUCCESS The event was successfully processed.
  * \retval ::FWK_E_STATE The execution is not started.
@@ -93,6 +163,48 @@ int fwk_thread_put_event_and_wait(
 
 #endif
 
+/*!
+ * \brief Log the event queue metrics of the threads.
+ *
+ * \details The logging thread logs, for each thread, the number of events in
+ *      its queue, the highest number of events its queue has held, and the
+ *      time it spent waiting in ::fwk_thread_put_event_and_wait(). When the
+ *      module profiles are kept, the modules the thread plan isolates are
+ *      logged as well.
+ *
+ * \retval ::FWK_SUCCESS The logging thread was requested to log the metrics.
+ * \retval ::FWK_E_INIT The thread framework component is not initialized.
+ * \retval ::FWK_E_OS Operating system error.
+ */
+int fwk_thread_log_metrics(void);
+
+/*!
+ * \brief Get the profile of a module.
+ *
+ * \param module_id Module identifier.
+ * \param[out] profile Profile of the module.
+ *
+ * \retval ::FWK_SUCCESS The profile was returned.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_SUPPORT The module profiles are not kept.
+ */
+int fwk_thread_get_profile(
+    fwk_id_t module_id,
+    struct fwk_thread_profile *profile);
+
+/*!
+ * \brief Get the modules the thread plan gives their own thread.
+ *
+ * \param[out] module_idx_table Table of ::FWK_MODULE_IDX_COUNT entries
+ *      receiving the indices of the modules to isolate.
+ * \param[out] count Number of entries filled in \p module_idx_table.
+ *
+ * \retval ::FWK_SUCCESS The plan was returned.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ * \retval ::FWK_E_SUPPORT The module profiles are not kept.
+ */
+int fwk_thread_get_plan(unsigned int *module_idx_table, unsigned int *count);
+
 /*!
  * \}
  */
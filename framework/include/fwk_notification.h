@@ -37,6 +37,27 @@
 #    define FMW_NOTIFICATION_MAX 64
 #endif
 
+/*!
+ * \brief Parameters of the completion event of a collected notification.
+ *
+ * \details See ::fwk_notification_notify_and_collect().
+ */
+struct fwk_notification_completion_params {
+    /*! Identifier of the notification */
+    fwk_id_t notification_id;
+
+    /*! Number of responses received */
+    unsigned int response_count;
+
+    /*!
+     * \brief Aggregated status of the subscribers.
+     *
+     * \details ::FWK_SUCCESS if every subscriber responded with it, else the
+     *      first other status received.
+     */
+    int status;
+};
+
 /*!
  * \brief Subscribe to a notification.
  *
@@ -93,6 +114,62 @@ int fwk_notification_unsubscribe(fwk_id_t notification_id, fwk_id_t source_id,
 int fwk_notification_notify(struct fwk_event *notification_event,
                             unsigned int *count);
 
+/*!
+ * \brief Send a notification and be sent a single event once all the
+ *      subscribers have responded to it.
+ *
+ * \details The notification is sent with a response requested. The responses
+ *      of the subscribers are not processed by the source of the notification
+ *      but counted by the framework, which then sends the event
+ *      \p completion_event_id to the source. The parameters of this event are
+ *      a ::fwk_notification_completion_params structure.
+ *
+ *      The collection is recorded in the subscriber table of the source for
+ *      this notification, so each source may collect the responses to each
+ *      of its notifications once at a time. When no subscriber is notified,
+ *      there is no response to collect and no completion event is sent.
+ *
+ *      The responses are expected to start with an \c int status, such as
+ *      ::FWK_SUCCESS, which is aggregated into the status of the completion.
+ *
+ * \note This function may only be called from the thread.
+ *
+ * \param notification_event Pointer to the notification event. Must not be
+ *      \c NULL.
+ * \param completion_event_id Identifier of the completion event, defined by
+ *      the module of the source.
+ * \param [out] count Number of notification events that were sent. Must not be
+ *      \c NULL.
+ *
+ * \retval ::FWK_SUCCESS All subscribers were notified successfully.
+ * \retval ::FWK_E_BUSY The responses to the same notification from the same
+ *      source are already being collected.
+ * \retval ::FWK_E_HANDLER The function was called from an interrupt handler.
+ * \retval ::FWK_E_PARAM One of more parameters were invalid.
+ */
+int fwk_notification_notify_and_collect(
+    struct fwk_event *notification_event,
+    fwk_id_t completion_event_id,
+    unsigned int *count);
+
+/*!
+ * \brief Get the number of subscribers to a notification.
+ *
+ * \details Lets a source skip building and sending a notification, and
+ *      waiting for its responses, when nothing has subscribed to it.
+ *
+ * \param notification_id Identifier of the notification.
+ * \param source_id Identifier of the emitter of the notification.
+ * \param [out] count Number of entities subscribed to the notification from
+ *      this source. Must not be \c NULL.
+ *
+ * \retval ::FWK_SUCCESS The number of subscribers was returned.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ */
+int fwk_notification_get_subscriber_count(fwk_id_t notification_id,
+                                          fwk_id_t source_id,
+                                          unsigned int *count);
+
 /*!
  * \}
  */
@@ -26,6 +26,15 @@
  *      connected. It acts like a continuous loop, overwriting old data, by
  *      maintaining extra state.
  *
+ *      In addition to the copying interface, data may be produced and consumed
+ *      in place through ::fwk_ring_reserve() and ::fwk_ring_commit() on the
+ *      producer side, and ::fwk_ring_peek_span() and ::fwk_ring_release() on
+ *      the consumer side. These four functions never overwrite buffered data,
+ *      and may be used by a single producer and a single consumer running in
+ *      different contexts (for example, an interrupt handler and the thread)
+ *      without further synchronization. The same is not true of
+ *      ::fwk_ring_push(), which may drop data from the head of the buffer.
+ *
  * \{
  */
 
@@ -47,19 +56,35 @@ struct fwk_ring {
     size_t capacity;
 
     /*!
-     * \brief Offset of the leading byte of buffered data.
+     * \brief Position of the leading byte of buffered data.
+     *
+     * \details Positions range over twice the capacity of the buffer so that
+     *      a full buffer can be distinguished from an empty one. This field is
+     *      only written by the consumer.
      */
-    size_t head;
+    volatile size_t head;
 
     /*!
-     * \brief Offset of one byte past the trailing byte of buffered data.
+     * \brief Position of one byte past the trailing byte of buffered data.
+     *
+     * \details This field is only written by the producer.
+     */
+    volatile size_t tail;
+};
+
+/*!
+ * \brief Contiguous region of ring buffer storage.
+ */
+struct fwk_ring_span {
+    /*!
+     * \brief Start of the region.
      */
-    size_t tail;
+    char *data;
 
     /*!
-     * \brief Whether the buffer is at full capacity or not.
+     * \brief Size of the region in bytes.
      */
-    bool full;
+    size_t size;
 };
 
 /*!
@@ -169,6 +194,65 @@ size_t fwk_ring_push(
     const char *buffer,
     size_t buffer_size);
 
+/*!
+ * \brief Reserve space at the end of a ring buffer for writing in place.
+ *
+ * \details The reserved region is described by up to two spans: the second
+ *      span is non-empty only if the region wraps around the end of the
+ *      storage. Unlike ::fwk_ring_push(), reserving space never drops buffered
+ *      data, so less than \p size bytes may be reserved if the buffer does not
+ *      have enough free space. The data becomes visible to the consumer once it
+ *      is committed with ::fwk_ring_commit().
+ *
+ * \param[in, out] ring Ring buffer.
+ * \param[in] size Number of bytes to reserve.
+ * \param[out] spans Regions of storage to write the data to.
+ *
+ * \return Number of bytes reserved.
+ */
+size_t fwk_ring_reserve(
+    struct fwk_ring *ring,
+    size_t size,
+    struct fwk_ring_span spans[2]);
+
+/*!
+ * \brief Commit data written in place to the end of a ring buffer.
+ *
+ * \param[in, out] ring Ring buffer.
+ * \param[in] size Number of bytes to commit. This must not exceed the number of
+ *      bytes previously reserved with ::fwk_ring_reserve().
+ */
+void fwk_ring_commit(struct fwk_ring *ring, size_t size);
+
+/*!
+ * \brief Get the regions of storage holding data at the beginning of a ring
+ *      buffer.
+ *
+ * \details The data is described by up to two spans: the second span is
+ *      non-empty only if the data wraps around the end of the storage. The
+ *      data remains in the buffer until it is released with
+ *      ::fwk_ring_release().
+ *
+ * \param[in] ring Ring buffer.
+ * \param[in] size Maximum number of bytes to describe.
+ * \param[out] spans Regions of storage holding the data.
+ *
+ * \return Number of bytes described by \p spans.
+ */
+size_t fwk_ring_peek_span(
+    const struct fwk_ring *ring,
+    size_t size,
+    struct fwk_ring_span spans[2]);
+
+/*!
+ * \brief Release data from the beginning of a ring buffer.
+ *
+ * \param[in, out] ring Ring buffer.
+ * \param[in] size Number of bytes to release. This must not exceed the length
+ *      of the buffer.
+ */
+void fwk_ring_release(struct fwk_ring *ring, size_t size);
+
 /*!
  * \brief Clear all data from a ring buffer.
  *
@@ -0,0 +1,180 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Cooperative tasks.
+ */
+
+#ifndef FWK_TASK_H
+#define FWK_TASK_H
+
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_slist.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupLibFramework Framework
+ * \{
+ */
+
+/*!
+ * \defgroup GroupTask Tasks
+ *
+ * \brief Cooperative tasks running on their own stack.
+ *
+ * \details A task runs a sequential flow on behalf of an entity, on a stack
+ *      given by the entity. Rather than splitting the flow into the stages of
+ *      a state machine driven by events and responses, the task waits for the
+ *      responses to its events with ::fwk_task_await_response() and lets the
+ *      other events be processed in the meantime with ::fwk_task_yield().
+ *
+ *      The tasks are scheduled by the thread when the event queues are empty,
+ *      and run until they wait or yield: they never preempt the processing of
+ *      an event nor each other. While a task runs, the events it raises are
+ *      sourced from its entity, as if the entity was processing an event.
+ *
+ *      Tasks are only available in single-thread firmware whose architecture
+ *      provides a task driver, see ::fwk_arch_task_driver.
+ *
+ * \warning The stack of a task must also be large enough for the interrupt
+ *      handlers, which may run on it.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Task.
+ *
+ * \details The task structure is owned by the entity running the task, and
+ *      must remain valid until the task has returned. Its fields are private
+ *      to the framework.
+ */
+struct fwk_task {
+    /*!
+     * \internal
+     * \brief Linked list node.
+     */
+    struct fwk_slist_node slist_node;
+
+    /*!
+     * \internal
+     * \brief Identifier of the entity the task runs on behalf of.
+     */
+    fwk_id_t id;
+
+    /*!
+     * \internal
+     * \brief Function run by the task.
+     */
+    void (*entry)(uintptr_t param);
+
+    /*!
+     * \internal
+     * \brief Parameter given to the function run by the task.
+     */
+    uintptr_t param;
+
+    /*!
+     * \internal
+     * \brief Saved context of the task.
+     */
+    void *context;
+
+    /*!
+     * \internal
+     * \brief Cookie of the response awaited by the task.
+     */
+    uint32_t cookie;
+
+    /*!
+     * \internal
+     * \brief Where to copy the response awaited by the task.
+     */
+    struct fwk_event *response;
+
+    /*!
+     * \internal
+     * \brief The task has started and has not returned yet.
+     */
+    bool active;
+};
+
+/*!
+ * \brief Start a task.
+ *
+ * \details The task is scheduled to call \p entry with \p param on \p stack.
+ *      It completes when \p entry returns, after which the task structure and
+ *      the stack may be reused.
+ *
+ * \param[out] task Task structure.
+ * \param id Identifier of the entity the task runs on behalf of.
+ * \param entry Function run by the task.
+ * \param param Parameter given to \p entry.
+ * \param stack Stack of the task.
+ * \param stack_size Size of the stack in bytes.
+ *
+ * \retval ::FWK_SUCCESS The task has been scheduled.
+ * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+ * \retval ::FWK_E_BUSY The task is still active.
+ * \retval ::FWK_E_SUPPORT The firmware does not support tasks.
+ */
+int fwk_task_start(
+    struct fwk_task *task,
+    fwk_id_t id,
+    void (*entry)(uintptr_t param),
+    uintptr_t param,
+    void *stack,
+    size_t stack_size);
+
+/*!
+ * \brief Put an event and wait for its response.
+ *
+ * \details The event is put with a response requested, and the task is
+ *      suspended until the response is processed. The response is then
+ *      copied into \p response, in place of being processed by the entity.
+ *      Other events, and other tasks, run while the task is suspended.
+ *
+ * \note The payload of the response, if any, is owned by the caller, which
+ *      must release it, see ::fwk_event_payload_release().
+ *
+ * \param[in, out] event Event to put.
+ * \param[out] response Response to the event.
+ *
+ * \retval ::FWK_SUCCESS The response has been received.
+ * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+ * \retval ::FWK_E_STATE The function was not called from a task.
+ * \return One of the standard error codes returned by
+ *      ::fwk_thread_put_event().
+ */
+int fwk_task_await_response(
+    struct fwk_event *event,
+    struct fwk_event *response);
+
+/*!
+ * \brief Let the pending events and the other tasks run.
+ *
+ * \details The task is resumed once the event queues have been emptied and
+ *      the other tasks ready to run have run. This is how a task waits for a
+ *      condition, such as a register polled in a loop, without holding the
+ *      thread.
+ *
+ * \retval ::FWK_SUCCESS The task has been resumed.
+ * \retval ::FWK_E_STATE The function was not called from a task.
+ */
+int fwk_task_yield(void);
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* FWK_TASK_H */
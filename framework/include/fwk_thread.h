@@ -15,6 +15,7 @@
 #include <fwk_id.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /*!
@@ -116,6 +117,70 @@ int fwk_thread_get_delayed_response(
  */
 int fwk_thread_is_delayed_response_list_empty(fwk_id_t id, bool *is_empty);
 
+/*!
+ * \brief Get the number of delayed responses outstanding across all modules
+ *      and elements.
+ *
+ * \param[out] count Number of delayed responses currently outstanding.
+ * \param[out] peak_count Highest number of delayed responses outstanding at
+ *      the same time since boot.
+ *
+ * \retval ::FWK_SUCCESS The counts were returned.
+ * \retval ::FWK_E_PARAM One or more parameters were invalid.
+ *
+ * \return Status code representing the result of the operation.
+ */
+int fwk_thread_get_delayed_response_count(size_t *count, size_t *peak_count);
+
+/*!
+ * \brief Depths of the event queues.
+ */
+struct fwk_thread_queue_stats {
+    /*! Number of high priority events awaiting processing */
+    size_t high_priority;
+
+    /*! Number of normal priority events awaiting processing */
+    size_t normal;
+
+    /*! Number of events raised by interrupt handlers awaiting processing */
+    size_t isr;
+
+    /*! Number of event structures free to be used */
+    size_t free;
+
+    /*! Lowest number of free event structures since boot */
+    size_t free_low_water;
+
+    /*!
+     * Number of event structures in the pool, including the ones added from
+     * the heap when the pool grew
+     */
+    size_t capacity;
+
+    /*!
+     * Highest number of event structures in use at the same time since boot,
+     * which is the size the event pool needs to never be exhausted
+     */
+    size_t peak_used;
+
+    /*! Number of event structures added to the pool from the heap since boot */
+    size_t grown;
+};
+
+/*!
+ * \brief Get the depths of the event queues.
+ *
+ * \param[out] stats Depths of the event queues.
+ *
+ * \retval ::FWK_SUCCESS The depths were returned.
+ * \retval ::FWK_E_PARAM The `stats` parameter was a null pointer value.
+ * \retval ::FWK_E_SUPPORT The depths are not tracked by the multi-threaded
+ *      framework.
+ *
+ * \return Status code representing the result of the operation.
+ */
+int fwk_thread_get_queue_stats(struct fwk_thread_queue_stats *stats);
+
 /*!
  * \brief Get a copy of the first delayed response event in the list of
  *     delayed response events of a given module or element.
@@ -141,6 +206,43 @@ int fwk_thread_is_delayed_response_list_empty(fwk_id_t id, bool *is_empty);
  */
 int fwk_thread_get_first_delayed_response(fwk_id_t id, struct fwk_event *event);
 
+/*!
+ * \brief Framework idle driver.
+ *
+ * \details The single-threaded framework calls upon this driver once it has no
+ *      event, signal or buffered log message left to process.
+ */
+struct fwk_thread_idle_driver {
+    /*!
+     * \brief Put the processor in a low-power state.
+     *
+     * \details This function is called with interrupts globally disabled, and
+     *      must return once an interrupt is pending, even though it cannot be
+     *      taken until the framework enables interrupts again.
+     *
+     * \param[in] ctx Driver-specific context given by the firmware.
+     */
+    void (*idle)(const void *ctx);
+};
+
+/*!
+ * \brief Register a framework idle driver.
+ *
+ * \details This is a weak function provided by the framework that, by default,
+ *      does not register a driver, in which case the framework polls for new
+ *      events while idle. It should be overridden by the firmware if you wish
+ *      to provide one.
+ *
+ * \note The multi-threaded framework leaves idle handling to the operating
+ *      system and does not use this driver.
+ *
+ * \param[out] ctx Context specific to the driver, provided to calls to the
+ *      driver API.
+ *
+ * \return Framework idle driver.
+ */
+struct fwk_thread_idle_driver fmw_thread_idle_driver(const void **ctx);
+
 /*!
  * \}
  */
@@ -251,6 +251,60 @@ struct fwk_time_driver {
  */
 struct fwk_time_driver fmw_time_driver(const void **ctx);
 
+/*!
+ * \brief Profiling time driver.
+ *
+ * \details The profiling clock is a free-running cycle counter that is cheaper
+ *      to read and finer than the counter behind the framework time driver,
+ *      such as the Cortex-M DWT cycle counter.
+ */
+struct fwk_time_profile_driver {
+    /*!
+     * \brief Read the current value of the cycle counter.
+     *
+     * \details The counter is 32-bit and wraps around. It must be read at
+     *      least once per wrap-around period for the wrap-arounds to be
+     *      accounted for.
+     *
+     * \param[in] Driver-specific context given by the firmware.
+     *
+     * \return Current counter value.
+     */
+    uint32_t (*cycles)(const void *ctx);
+
+    /*! Frequency of the cycle counter, in Hertz */
+    uint32_t frequency;
+};
+
+/*!
+ * \brief Register a framework profiling time driver.
+ *
+ * \details This is a weak function provided by the framework that, by
+ *      default, does not register a driver, and should be overridden by the
+ *      firmware if you wish to provide one. Without a profiling time driver,
+ *      the profiling clock falls back to the framework time driver.
+ *
+ * \param[out] ctx Context specific to the driver, provided to calls to the
+ *      driver API.
+ *
+ * \return Framework profiling time driver.
+ */
+struct fwk_time_profile_driver fmw_time_profile_driver(const void **ctx);
+
+/*!
+ * \brief Get a high-resolution timestamp for profiling.
+ *
+ * \details The timestamp is read from the profiling time driver and scaled to
+ *      nanoseconds, or is the current timestamp if there is no profiling time
+ *      driver. Profiling timestamps should only be compared with each other.
+ *
+ * \note This function is not reentrant when a profiling time driver is
+ *      registered, callers in interrupt handlers must not preempt each other.
+ *
+ * \return Current profiling timestamp.
+ */
+fwk_timestamp_t fwk_time_profile_current(void);
+
 /*!
  * \}
  */
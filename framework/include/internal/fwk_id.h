@@ -8,6 +8,7 @@
 #ifndef FWK_INTERNAL_ID_H
 #define FWK_INTERNAL_ID_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /* Identifier type */
@@ -128,9 +129,25 @@ struct __fwk_id_fmt {
     char str[20]; /* Identifier string representation */
 };
 
+/*
+ * First character of the packed representation of an identifier.
+ *
+ * The marker is followed by __FWK_ID_PACKED_LENGTH characters each holding
+ * seven bits of the identifier value, least significant first, with their top
+ * bit set, and by a null terminator.
+ */
+#define __FWK_ID_PACKED_MARKER '\x1F'
+
+/* Number of characters holding the value of a packed identifier */
+#define __FWK_ID_PACKED_LENGTH 5
+
 /*
  * Build the string representation of an identifier.
  *
+ * With deferred binary logging, the packed representation is returned, see
+ * __fwk_id_pack_str(). Otherwise, the representation is formatted, see
+ * __fwk_id_format_str().
+ *
  * \param id Identifier.
  *
  * \return Buffer structure containing the string representation of the
@@ -138,4 +155,39 @@ struct __fwk_id_fmt {
  */
 struct __fwk_id_fmt __fwk_id_str(union __fwk_id id);
 
+/*
+ * Format the string representation of an identifier.
+ *
+ * \param id Identifier.
+ *
+ * \return Buffer structure containing the string representation of the
+ *      identifier.
+ */
+struct __fwk_id_fmt __fwk_id_format_str(union __fwk_id id);
+
+/*
+ * Build the packed representation of an identifier.
+ *
+ * The packed representation only carries the identifier value, leaving the
+ * formatting to whoever reads it, e.g. when a binary log record is formatted.
+ *
+ * \param id Identifier.
+ *
+ * \return Buffer structure containing the packed representation of the
+ *      identifier.
+ */
+struct __fwk_id_fmt __fwk_id_pack_str(union __fwk_id id);
+
+/*
+ * Retrieve an identifier from its packed representation.
+ *
+ * \param str String to unpack.
+ * \param[out] id Identifier.
+ *
+ * \retval true The string was the packed representation of an identifier.
+ * \retval false The string was not the packed representation of an
+ *      identifier.
+ */
+bool __fwk_id_unpack_str(const char *str, union __fwk_id *id);
+
 #endif /* FWK_INTERNAL_ID_H */
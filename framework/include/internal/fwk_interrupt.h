@@ -33,6 +33,20 @@
  */
 int fwk_interrupt_set_isr_fault(void (*isr)(void));
 
+/*!
+ * \brief Disable all maskable interrupts, whatever the priority level masked
+ *      by critical sections.
+ *
+ * \details Enters a critical section like ::fwk_interrupt_global_disable(),
+ *      left with ::fwk_interrupt_global_enable(). This is used internally by
+ *      the framework before entering the idle state, which must not miss an
+ *      interrupt of any priority level.
+ *
+ * \retval ::FWK_SUCCESS Operation succeeded.
+ * \retval ::FWK_E_INIT The component has not been initialized.
+ */
+int fwk_interrupt_global_disable_all(void);
+
 /*!
  * \}
  */
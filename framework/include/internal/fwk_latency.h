@@ -0,0 +1,43 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FWK_INTERNAL_LATENCY_H
+#define FWK_INTERNAL_LATENCY_H
+
+#include <fwk_event.h>
+#include <fwk_latency.h>
+#include <fwk_time.h>
+
+/*
+ * \brief Record the queueing delay and handler time of an event.
+ *
+ * \details The handler time is measured up to the call to this function, which
+ *      must therefore be made as soon as the handler returns.
+ *
+ * \param event Event whose handler has just returned.
+ * \param dispatch_timestamp Time at which the event was dispatched to its
+ *      handler.
+ */
+void __fwk_latency_record(
+    const struct fwk_event *event,
+    fwk_timestamp_t dispatch_timestamp);
+
+/*
+ * \brief Check the handler time of an event against its budget.
+ *
+ * \details The handler time is measured up to the call to this function, which
+ *      must therefore be made as soon as the handler returns.
+ *
+ * \param event Event whose handler has just returned.
+ * \param dispatch_timestamp Profiling timestamp at which the event was
+ *      dispatched to its handler.
+ */
+void __fwk_latency_check_budget(
+    const struct fwk_event *event,
+    fwk_timestamp_t dispatch_timestamp);
+
+#endif /* FWK_INTERNAL_LATENCY_H */
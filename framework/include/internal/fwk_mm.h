@@ -0,0 +1,80 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Memory management internal resources.
+ */
+
+#ifndef INTERNAL_FWK_MM_H
+#define INTERNAL_FWK_MM_H
+
+#include <fwk_arch.h>
+#include <fwk_id.h>
+
+/*!
+ * \addtogroup GroupLibFramework Framework
+ * \{
+ */
+
+/*!
+ * \addtogroup GroupMM Memory Management
+ * \{
+ */
+
+/*!
+ * \internal
+ *
+ * \brief Initialize the memory management component.
+ *
+ * \param driver Memory management driver provided by the architecture.
+ *
+ * \retval ::FWK_SUCCESS Operation succeeded.
+ */
+int __fwk_mm_init(const struct fwk_arch_mm_driver *driver);
+
+/*!
+ * \internal
+ *
+ * \brief Set the module subsequent allocations are attributed to.
+ *
+ * \param id Identifier of the module, or ::FWK_ID_NONE to attribute
+ *      allocations to the framework.
+ */
+void __fwk_mm_set_owner(fwk_id_t id);
+
+/*!
+ * \internal
+ *
+ * \brief Lock the allocation arena.
+ *
+ * \details Called once the pre-runtime phase is complete. Any further
+ *      allocation is served by the heap and recorded as a late allocation.
+ *      Does nothing if the firmware does not use an allocation arena.
+ */
+void __fwk_mm_lock(void);
+
+/*!
+ * \internal
+ *
+ * \brief Reclaim the memory of the init-only code and data.
+ *
+ * \details Called once the start stage is complete. The memory provided by the
+ *      architecture is used to serve the later allocations before the heap.
+ *
+ * \return Number of bytes reclaimed, 0 if the architecture provides no such
+ *      memory.
+ */
+size_t __fwk_mm_reclaim(void);
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* INTERNAL_FWK_MM_H */
@@ -14,9 +14,11 @@
 #include <internal/fwk_notification.h>
 
 #include <fwk_id.h>
+#include <fwk_latency.h>
 #include <fwk_module.h>
 #include <fwk_slist.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 
 /*
@@ -50,6 +52,19 @@ struct fwk_module_ctx {
      * notification defined by the module.
      */
     struct fwk_dlist *subscription_dlist_table;
+
+    /*
+     * Table of compacted subscriber tables, one per subscription list.
+     */
+    struct __fwk_notification_subscribers *subscribers_table;
+    #endif
+
+    #ifdef FWK_EVENT_LATENCY
+    /*
+     * Table of latency statistics. One entry per type of event defined by the
+     * module, followed by one entry per type of notification.
+     */
+    struct fwk_latency_stats *latency_table;
     #endif
 
     /* List of delayed response events */
@@ -78,6 +93,11 @@ struct fwk_element_ctx {
      * notification defined by the element's module.
      */
     struct fwk_dlist *subscription_dlist_table;
+
+    /*
+     * Table of compacted subscriber tables, one per subscription list.
+     */
+    struct __fwk_notification_subscribers *subscribers_table;
     #endif
 
     /* List of delayed response events */
@@ -96,6 +116,21 @@ struct fwk_element_ctx {
  */
 int fwk_module_start(void);
 
+/*
+ * \brief Start the next deferred module.
+ *
+ * \retval true A deferred module was started.
+ * \retval false No deferred module is left to start.
+ */
+bool __fwk_module_start_next_deferred(void);
+
+/*
+ * \brief Start a deferred module and the deferred modules before it.
+ *
+ * \param id Identifier of the module, or of one of its elements.
+ */
+void __fwk_module_start_deferred(fwk_id_t id);
+
 /*
  * \brief Get a pointer to the context of a module or element.
  *
@@ -17,8 +17,11 @@
 #include <fwk_id.h>
 #include <fwk_list.h>
 #include <fwk_multi_thread.h>
+#include <fwk_slist.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /*
  * Module/element thread context.
@@ -67,6 +70,46 @@ struct __fwk_thread_ctx {
      * processing the event which an event response is expected from.
      */
     struct fwk_event *response_event;
+
+    /* Priority given to the thread when it was created */
+    osPriority_t base_priority;
+
+    /*
+     * Current priority of the thread. It is raised above the base priority
+     * to the priority of the highest-priority thread waiting for the
+     * completion of the processing of one of its events.
+     */
+    osPriority_t priority;
+
+    /*
+     * Context of the thread processing the event the thread is waiting the
+     * completion of, NULL when the thread is not waiting.
+     */
+    struct __fwk_thread_ctx *waited_thread_ctx;
+
+    /* Link for the list of threads waiting for 'waited_thread_ctx' */
+    struct fwk_slist_node waiter_node;
+
+    /*
+     * List of the threads waiting for the completion of the processing of an
+     * event by the thread.
+     */
+    struct fwk_slist waiter_list;
+
+    /* Number of events in the thread queue of events */
+    unsigned int queue_depth;
+
+    /* Highest number of events the thread queue of events has held */
+    unsigned int peak_queue_depth;
+
+    /* Number of times the thread waited for the completion of an event */
+    uint32_t wait_count;
+
+    /* Total time the thread spent waiting for the completion of events */
+    fwk_duration_ns_t total_wait_time;
+
+    /* Longest time the thread spent waiting for the completion of an event */
+    fwk_duration_ns_t max_wait_time;
 };
 
 /*
@@ -135,6 +178,13 @@ struct __fwk_multi_thread_ctx {
      * Storage for signals handling
      */
     struct __fwk_signal_ctx fwk_signal_ctx;
+
+#ifdef FWK_THREAD_PROFILE
+    /*
+     * Table of the module profiles, indexed by module
+     */
+    struct fwk_thread_profile *profile_table;
+#endif
 };
 
 /*
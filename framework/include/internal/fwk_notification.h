@@ -8,6 +8,7 @@
 #ifndef FWK_INTERNAL_NOTIFICATION_H
 #define FWK_INTERNAL_NOTIFICATION_H
 
+#include <fwk_event.h>
 #include <fwk_list.h>
 #include <fwk_notification.h>
 
@@ -24,6 +25,52 @@ struct __fwk_notification_subscription {
     fwk_id_t target_id;
 };
 
+/*
+ * Collection of the responses to a notification, see
+ * fwk_notification_notify_and_collect().
+ */
+struct __fwk_notification_collection {
+    /* Whether the responses are being collected. */
+    bool in_use;
+
+    /* Whether all the notification events have been sent. */
+    bool sent;
+
+    /* Identifier of the event sent to the source once all responses are in. */
+    fwk_id_t completion_event_id;
+
+    /* Number of notification events sent, valid once they have all been. */
+    unsigned int expected_count;
+
+    /* Number of responses received. */
+    unsigned int response_count;
+
+    /* Aggregated status of the responses. */
+    int status;
+};
+
+/*
+ * Contiguous copy of the targets of a subscription list. Built once the
+ * framework has started so that sending a notification does not need to walk
+ * the list.
+ */
+struct __fwk_notification_subscribers {
+    /* Table of target identifiers, in subscription order. */
+    fwk_id_t *target_id_table;
+
+    /* Number of targets in the table. */
+    unsigned int count;
+
+    /* Number of targets the table can hold. */
+    unsigned int capacity;
+
+    /* Whether the table reflects the subscription list. */
+    bool is_valid;
+
+    /* Collection of the responses to the notification from the source. */
+    struct __fwk_notification_collection collection;
+};
+
 /*
  * \brief Initialize the notification framework component.
  *
@@ -38,6 +85,30 @@ struct __fwk_notification_subscription {
  */
 int __fwk_notification_init(size_t notification_count);
 
+/*
+ * \brief Notify the notification framework component that all the modules
+ *      have been started.
+ *
+ * \details From this point onwards, subscription lists are compacted into
+ *      contiguous tables of targets the first time they are used after being
+ *      modified.
+ */
+void __fwk_notification_start(void);
+
+/*
+ * \brief Count a response to a notification whose responses are collected.
+ *
+ * \details The completion event of the collection is sent with the last
+ *      response.
+ *
+ * \param event Response being processed.
+ *
+ * \retval true The response was counted and must not be processed by its
+ *      target.
+ * \retval false The response is not collected.
+ */
+bool __fwk_notification_collect_response(const struct fwk_event *event);
+
 /*
  * \brief Reset the notification framework component.
  *
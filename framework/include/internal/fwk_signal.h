@@ -27,12 +27,18 @@ struct __fwk_signal_ctx {
     /* number of pending signals */
     int pending_signals;
 
+    /* index of the oldest pending signal in the signals array */
+    unsigned int head;
+
 #ifndef BUILD_HAS_MULTITHREADING
     /* signal we are currently handling */
     struct signal current_signal;
 #endif
 
-    /* array of pending signals */
+    /*
+     * Pending signals, in a circular buffer. The pending signals occupy the
+     * entries from head onwards, wrapping around at the end of the array.
+     */
     struct signal signals[FWK_MODULE_SIGNAL_COUNT];
 };
 
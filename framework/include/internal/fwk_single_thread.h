@@ -10,9 +10,98 @@
 
 #include <fwk_event.h>
 #include <fwk_list.h>
+#include <fwk_macros.h>
+#include <fwk_thread.h>
 
 #include <stdbool.h>
 
+#if FWK_HAS_INCLUDE(<fmw_thread.h>)
+#    include <fmw_thread.h>
+#endif
+
+/*
+ * \def FWK_THREAD_PRIORITY_BURST_MAX
+ *
+ * \brief Maximum number of consecutive high priority events processed while
+ *      normal priority events are awaiting processing. Once reached, one
+ *      normal priority event is processed to prevent its starvation.
+ */
+#ifdef FMW_EVENT_PRIORITY_BURST_MAX
+#    define FWK_THREAD_PRIORITY_BURST_MAX FMW_EVENT_PRIORITY_BURST_MAX
+#else
+#    define FWK_THREAD_PRIORITY_BURST_MAX 8
+#endif
+
+/*
+ * \def FWK_THREAD_ISR_EVENT_RING_LEVELS
+ *
+ * \brief Number of interrupt priority levels, starting from the most urgent
+ *      one, given a dedicated ring for the events they raise.
+ *
+ * \details An interrupt service routine is the only producer of the ring of
+ *      its priority level as routines of the same level do not preempt each
+ *      other, and the thread is the only consumer. The ring is thus accessed
+ *      without masking interrupts. Events raised by routines without a ring,
+ *      or while their ring is full, go through the ISR event queue instead.
+ *
+ * \note Setting this definition to a value of `0` disables the rings.
+ */
+#ifdef FMW_ISR_EVENT_RING_LEVELS
+#    define FWK_THREAD_ISR_EVENT_RING_LEVELS FMW_ISR_EVENT_RING_LEVELS
+#else
+#    define FWK_THREAD_ISR_EVENT_RING_LEVELS 0
+#endif
+
+/*
+ * \def FWK_THREAD_ISR_EVENT_RING_CAPACITY
+ *
+ * \brief Number of events each ISR event ring can hold. Must be a power of
+ *      two.
+ */
+#ifdef FMW_ISR_EVENT_RING_CAPACITY
+#    define FWK_THREAD_ISR_EVENT_RING_CAPACITY FMW_ISR_EVENT_RING_CAPACITY
+#else
+#    define FWK_THREAD_ISR_EVENT_RING_CAPACITY 4
+#endif
+
+/*
+ * \def FWK_THREAD_EVENT_POOL_GROWTH
+ *
+ * \brief Number of event structures added to the event pool, allocated from
+ *      the heap, when an event is put outside of an interrupt service routine
+ *      while the pool is exhausted.
+ *
+ * \details The pool only grows: the blocks added to it are never released.
+ *      The highest number of event structures in use at the same time is
+ *      reported by ::fwk_thread_get_queue_stats(), and is the size to give the
+ *      pool in the next build of the firmware.
+ *
+ * \note Setting this definition to a value of `0` disables the growth of the
+ *      pool: an event put while the pool is exhausted is a fatal error.
+ */
+#ifdef FMW_EVENT_POOL_GROWTH
+#    define FWK_THREAD_EVENT_POOL_GROWTH FMW_EVENT_POOL_GROWTH
+#else
+#    define FWK_THREAD_EVENT_POOL_GROWTH 0
+#endif
+
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+/*
+ * Single-producer/single-consumer ring of events raised by the interrupt
+ * service routines of one priority level.
+ */
+struct __fwk_isr_event_ring {
+    /* Event slots */
+    struct fwk_event *events;
+
+    /* Free-running index of the next slot to read, written by the thread */
+    volatile unsigned int head;
+
+    /* Free-running index of the next slot to write, written by the ISRs */
+    volatile unsigned int tail;
+};
+#endif
+
 /*
  * Thread component context. Exposed for testing purposes only.
  */
@@ -32,12 +121,48 @@ struct __fwk_thread_ctx {
      */
     struct fwk_slist free_event_queue;
 
+    /* Number of event structures in the pool, including the added blocks */
+    size_t event_count;
+
+    /* Number of event structures added to the pool from the heap */
+    size_t grown_event_count;
+
+    /* Number of event structures in the free event queue */
+    size_t free_event_count;
+
+    /* Lowest number of event structures in the free event queue */
+    size_t free_event_low_water;
+
+    /* Highest number of event structures in use at the same time */
+    size_t used_event_peak;
+
     /* Queue of events, generated by ISRs, that are awaiting processing */
     struct fwk_slist isr_event_queue;
 
-    /* Queue of events that are awaiting processing */
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+    /* Rings of events generated by ISRs, indexed by interrupt priority */
+    struct __fwk_isr_event_ring
+        isr_event_rings[FWK_THREAD_ISR_EVENT_RING_LEVELS];
+
+    /*
+     * Flag indicating that the ISR event rings are waiting for an event
+     * structure to be freed before they can be drained again.
+     */
+    bool isr_event_ring_stalled;
+#endif
+
+    /* Queue of normal priority events that are awaiting processing */
     struct fwk_slist event_queue;
 
+    /* Queue of high priority events that are awaiting processing */
+    struct fwk_slist high_priority_event_queue;
+
+    /*
+     * Number of high priority events processed in a row while normal priority
+     * events were awaiting processing.
+     */
+    unsigned int priority_burst_count;
+
     /* The event currently being processed */
     struct fwk_event *current_event;
 
@@ -64,6 +189,12 @@ struct __fwk_thread_ctx {
      * The cookie of the event we are waiting for
      */
     uint32_t cookie;
+
+    /* Idle driver given by the firmware */
+    struct fwk_thread_idle_driver idle_driver;
+
+    /* Idle driver context */
+    const void *idle_driver_ctx;
 };
 
 /*
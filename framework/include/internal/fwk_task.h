@@ -0,0 +1,62 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FWK_INTERNAL_TASK_H
+#define FWK_INTERNAL_TASK_H
+
+#include <fwk_arch.h>
+#include <fwk_event.h>
+#include <fwk_task.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * \brief Initialize the task framework component.
+ *
+ * \param driver Context switching driver of the architecture.
+ *
+ * \retval ::FWK_SUCCESS The task framework component was initialized.
+ * \retval ::FWK_E_PARAM The driver is incomplete.
+ */
+int __fwk_task_init(const struct fwk_arch_task_driver *driver);
+
+/*
+ * \brief Get the next task ready to run.
+ *
+ * \return The task, removed from the ready tasks, or \c NULL if no task is
+ *      ready to run.
+ */
+struct fwk_task *__fwk_task_pop_ready(void);
+
+/*
+ * \brief Run a task until it waits, yields or returns.
+ *
+ * \param task Task returned by ::__fwk_task_pop_ready().
+ */
+void __fwk_task_resume(struct fwk_task *task);
+
+/*
+ * \brief Follow a response through the change of its cookie when it is put.
+ *
+ * \param old_cookie Cookie of the event the response is for.
+ * \param new_cookie Cookie given to the response.
+ */
+void __fwk_task_update_cookie(uint32_t old_cookie, uint32_t new_cookie);
+
+/*
+ * \brief Hand a response over to the task awaiting it.
+ *
+ * \param event Response being processed.
+ *
+ * \retval true The response was awaited by a task, which is now ready to run.
+ *      The response must not be processed by its target.
+ * \retval false No task awaits the response.
+ */
+bool __fwk_task_put_response(const struct fwk_event *event);
+
+#endif /* FWK_INTERNAL_TASK_H */
@@ -8,10 +8,92 @@
 #ifndef FWK_INTERNAL_THREAD_DELAYED_RESP_H
 #define FWK_INTERNAL_THREAD_DELAYED_RESP_H
 
+#include <fwk_event.h>
 #include <fwk_id.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
+/*!
+ * \internal
+ *
+ * \brief Initialize the delayed response component.
+ *
+ * \details Allocates the index used to look delayed responses up by cookie.
+ *
+ * \param event_count The maximum number of events in all queues at all time,
+ *      and thus the maximum number of outstanding delayed responses.
+ *
+ * \retval ::FWK_SUCCESS The component was initialized.
+ */
+int __fwk_thread_delayed_response_init(size_t event_count);
+
+/*!
+ * \internal
+ *
+ * \brief Grow the index of the delayed responses for a larger event pool.
+ *
+ * \details The outstanding delayed responses are moved to a new index sized
+ *      for the new number of events. The index is left untouched when it is
+ *      already large enough.
+ *
+ * \param event_count The new number of events.
+ *
+ * \retval ::FWK_SUCCESS The index can hold the delayed responses of
+ *      \p event_count events.
+ * \retval ::FWK_E_NOMEM The new index could not be allocated, the index is
+ *      unchanged.
+ */
+int __fwk_thread_delayed_response_grow(size_t event_count);
+
+/*!
+ * \internal
+ *
+ * \brief Record a delayed response.
+ *
+ * \details The delayed response is queued at the tail of the list of delayed
+ *      responses of the entity \p id and indexed by its cookie.
+ *
+ * \note The function assumes the validity of all its input parameters.
+ *
+ * \param id Identifier of the module or element that delayed the response.
+ * \param event Delayed response event, allocated from the event pool.
+ */
+void __fwk_thread_add_delayed_response(fwk_id_t id, struct fwk_event *event);
+
+/*!
+ * \internal
+ *
+ * \brief Record a delayed response ahead of the other delayed responses.
+ *
+ * \details The delayed response is queued at the head of the list of delayed
+ *      responses of the entity \p id, so that it is the one returned by
+ *      ::fwk_thread_get_first_delayed_response(), and indexed by its cookie.
+ *
+ * \note The function assumes the validity of all its input parameters.
+ *
+ * \param id Identifier of the module or element that delayed the response.
+ * \param event Delayed response event, allocated from the event pool.
+ */
+void __fwk_thread_add_delayed_response_head(
+    fwk_id_t id,
+    struct fwk_event *event);
+
+/*!
+ * \internal
+ *
+ * \brief Forget a delayed response.
+ *
+ * \note The function assumes the validity of all its input parameters.
+ *
+ * \param id Identifier of the module or element that delayed the response.
+ * \param event Delayed response event, as returned by
+ *      __fwk_thread_search_delayed_response().
+ */
+void __fwk_thread_remove_delayed_response(
+    fwk_id_t id,
+    struct fwk_event *event);
+
 /*!
  * \internal
  *
@@ -37,6 +119,8 @@ struct fwk_slist *__fwk_thread_get_delayed_response_list(fwk_id_t id);
  *      for. This cookie identifies the response among the several responses
  *      that the entity 'id' may have delayed.
  *
+ * \note The search is performed in constant time.
+ *
  * \return A pointer to the delayed response event, \c NULL if not found.
  */
 struct fwk_event *__fwk_thread_search_delayed_response(
@@ -8,7 +8,11 @@
  *     Framework API for the architecture layer.
  */
 
+#include <internal/fwk_mm.h>
 #include <internal/fwk_module.h>
+#ifndef BUILD_HAS_MULTITHREADING
+#    include <internal/fwk_task.h>
+#endif
 
 #include <fwk_arch.h>
 #include <fwk_assert.h>
@@ -44,6 +48,51 @@ static int fwk_arch_interrupt_init(int (*interrupt_init_handler)(
     return FWK_SUCCESS;
 }
 
+static int fwk_arch_mm_init(
+    int (*mm_init_handler)(const struct fwk_arch_mm_driver **driver))
+{
+    int status;
+    const struct fwk_arch_mm_driver *driver;
+
+    /*
+     * Retrieve a pointer to the memory management driver from the
+     * architecture layer.
+     */
+    status = mm_init_handler(&driver);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    /* Initialize the memory management component */
+    status = __fwk_mm_init(driver);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
+}
+
+#ifndef BUILD_HAS_MULTITHREADING
+static int fwk_arch_task_init(
+    int (*task_init_handler)(const struct fwk_arch_task_driver **driver))
+{
+    int status;
+    const struct fwk_arch_task_driver *driver;
+
+    /*
+     * Retrieve a pointer to the task driver from the architecture layer.
+     */
+    status = task_init_handler(&driver);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    /* Initialize the task component */
+    status = __fwk_task_init(driver);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
+}
+#endif
+
 int fwk_arch_init(const struct fwk_arch_init_driver *driver)
 {
     int status;
@@ -54,6 +103,22 @@ int fwk_arch_init(const struct fwk_arch_init_driver *driver)
     if (driver->interrupt == NULL)
         return FWK_E_PARAM;
 
+    /* Initialize memory management if the architecture supports it */
+    if (driver->mm != NULL) {
+        status = fwk_arch_mm_init(driver->mm);
+        if (!fwk_expect(status == FWK_SUCCESS))
+            return FWK_E_PANIC;
+    }
+
+#ifndef BUILD_HAS_MULTITHREADING
+    /* Initialize the tasks if the architecture supports them */
+    if (driver->task != NULL) {
+        status = fwk_arch_task_init(driver->task);
+        if (!fwk_expect(status == FWK_SUCCESS))
+            return FWK_E_PANIC;
+    }
+#endif
+
     fwk_module_init();
 
     status = fwk_io_init();
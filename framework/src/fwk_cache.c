@@ -0,0 +1,39 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_attributes.h>
+#include <fwk_cache.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+static struct fwk_cache_driver fwk_cache_driver;
+
+FWK_CONSTRUCTOR void fwk_cache_init(void)
+{
+    fwk_cache_driver = fmw_cache_driver();
+}
+
+void fwk_cache_clean(const volatile void *address, size_t size)
+{
+    if ((fwk_cache_driver.clean != NULL) && (size != 0))
+        fwk_cache_driver.clean((uintptr_t)address, size);
+}
+
+void fwk_cache_invalidate(const volatile void *address, size_t size)
+{
+    if ((fwk_cache_driver.invalidate != NULL) && (size != 0))
+        fwk_cache_driver.invalidate((uintptr_t)address, size);
+}
+
+FWK_WEAK struct fwk_cache_driver fmw_cache_driver(void)
+{
+    return (struct fwk_cache_driver){
+        .clean = NULL,
+        .invalidate = NULL,
+    };
+}
@@ -0,0 +1,106 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Event payload buffers.
+ */
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_interrupt.h>
+#include <fwk_mm.h>
+
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct fwk_event_payload {
+    /* Next free buffer, valid while the buffer is free */
+    struct fwk_event_payload *next;
+
+    /* Number of references to the buffer, 0 if the buffer is free */
+    unsigned int refcount;
+
+    /* Buffer handed out to the users */
+    alignas(max_align_t) unsigned char data[FWK_EVENT_PAYLOAD_SIZE];
+};
+
+/* Free buffers of the pool */
+static struct fwk_event_payload *fwk_event_payload_free;
+
+static struct fwk_event_payload *fwk_event_payload_get(void *payload)
+{
+    struct fwk_event_payload *entry = (struct fwk_event_payload *)(
+        (uintptr_t)payload - offsetof(struct fwk_event_payload, data));
+
+    fwk_assert(entry->refcount > 0);
+
+    return entry;
+}
+
+void fwk_event_payload_reserve(unsigned int count)
+{
+    struct fwk_event_payload *block;
+
+    if (count == 0)
+        return;
+
+    block = fwk_mm_calloc(count, sizeof(struct fwk_event_payload));
+
+    fwk_interrupt_global_disable();
+
+    for (unsigned int i = 0; i < count; i++) {
+        block[i].next = fwk_event_payload_free;
+        fwk_event_payload_free = &block[i];
+    }
+
+    fwk_interrupt_global_enable();
+}
+
+void *fwk_event_payload_alloc(void)
+{
+    struct fwk_event_payload *entry;
+
+    fwk_interrupt_global_disable();
+
+    entry = fwk_event_payload_free;
+    if (entry != NULL) {
+        fwk_event_payload_free = entry->next;
+        entry->refcount = 1;
+    }
+
+    fwk_interrupt_global_enable();
+
+    return (entry == NULL) ? NULL : entry->data;
+}
+
+void fwk_event_payload_acquire(void *payload)
+{
+    if (payload == NULL)
+        return;
+
+    fwk_interrupt_global_disable();
+    fwk_event_payload_get(payload)->refcount++;
+    fwk_interrupt_global_enable();
+}
+
+void fwk_event_payload_release(void *payload)
+{
+    struct fwk_event_payload *entry;
+
+    if (payload == NULL)
+        return;
+
+    fwk_interrupt_global_disable();
+
+    entry = fwk_event_payload_get(payload);
+    if (--entry->refcount == 0) {
+        entry->next = fwk_event_payload_free;
+        fwk_event_payload_free = entry;
+    }
+
+    fwk_interrupt_global_enable();
+}
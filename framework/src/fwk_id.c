@@ -13,6 +13,7 @@
 #include <fwk_assert.h>
 #include <fwk_attributes.h>
 #include <fwk_id.h>
+#include <fwk_log.h>
 #include <fwk_macros.h>
 #include <fwk_module.h>
 
@@ -82,19 +83,22 @@ static void fwk_id_format(
         break;
     }
 
-    module_id = FWK_ID_MODULE(indices[0]);
-    module_name = fwk_module_get_name(module_id);
+    /* Names are only looked up when they are printed */
+    if (verbose) {
+        module_id = FWK_ID_MODULE(indices[0]);
+        module_name = fwk_module_get_name(module_id);
 
-    switch (id.common.type) {
-    case __FWK_ID_TYPE_ELEMENT:
-    case __FWK_ID_TYPE_SUB_ELEMENT:
-        element_id = FWK_ID_ELEMENT(indices[0], indices[1]);
-        element_name = fwk_module_get_name(element_id);
+        switch (id.common.type) {
+        case __FWK_ID_TYPE_ELEMENT:
+        case __FWK_ID_TYPE_SUB_ELEMENT:
+            element_id = FWK_ID_ELEMENT(indices[0], indices[1]);
+            element_name = fwk_module_get_name(element_id);
 
-        break;
+            break;
 
-    default:
-        break;
+        default:
+            break;
+        }
     }
 
     length += snprintf(
@@ -149,7 +153,7 @@ static void fwk_id_format(
     length += snprintf(buffer + length, buffer_size - length, "]");
 }
 
-struct __fwk_id_fmt __fwk_id_str(fwk_id_t id)
+struct __fwk_id_fmt __fwk_id_format_str(fwk_id_t id)
 {
     struct __fwk_id_fmt fmt = { { 0 } };
 
@@ -158,6 +162,52 @@ struct __fwk_id_fmt __fwk_id_str(fwk_id_t id)
     return fmt;
 }
 
+struct __fwk_id_fmt __fwk_id_pack_str(fwk_id_t id)
+{
+    struct __fwk_id_fmt fmt = { { 0 } };
+    unsigned int i;
+
+    fmt.str[0] = __FWK_ID_PACKED_MARKER;
+
+    /* Seven bits per character, with the top bit set so none is null */
+    for (i = 0; i < __FWK_ID_PACKED_LENGTH; i++)
+        fmt.str[i + 1] = (char)(0x80U | ((id.value >> (7U * i)) & 0x7FU));
+
+    return fmt;
+}
+
+bool __fwk_id_unpack_str(const char *str, fwk_id_t *id)
+{
+    uint32_t value = 0;
+    unsigned int i;
+
+    if (str[0] != __FWK_ID_PACKED_MARKER)
+        return false;
+
+    for (i = 0; i < __FWK_ID_PACKED_LENGTH; i++) {
+        if ((str[i + 1] & 0x80) == 0)
+            return false;
+
+        value |= (uint32_t)(str[i + 1] & 0x7F) << (7U * i);
+    }
+
+    if (str[__FWK_ID_PACKED_LENGTH + 1] != '\0')
+        return false;
+
+    id->value = value;
+
+    return true;
+}
+
+struct __fwk_id_fmt __fwk_id_str(fwk_id_t id)
+{
+#ifdef FWK_LOG_BINARY
+    return __fwk_id_pack_str(id);
+#else
+    return __fwk_id_format_str(id);
+#endif
+}
+
 struct fwk_id_verbose_fmt fwk_id_verbose_str(fwk_id_t id)
 {
     struct fwk_id_verbose_fmt fmt = { { 0 } };
@@ -11,16 +11,90 @@
 #include <internal/fwk_interrupt.h>
 
 #include <fwk_arch.h>
+#include <fwk_attributes.h>
 #include <fwk_interrupt.h>
+#include <fwk_macros.h>
 #include <fwk_status.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 
 static bool initialized;
 static const struct fwk_arch_interrupt_driver *driver;
 static unsigned int critical_section_nest_level;
 
+/* The current critical section masks all the maskable interrupts */
+static bool critical_section_masks_all;
+
+#ifdef FWK_INTERRUPT_CRITICAL_PRIORITY
+/*
+ * The current critical section masks the critical priority level, and the
+ * masking state to restore when leaving it.
+ */
+static bool critical_section_masks_priority;
+static unsigned int critical_section_priority_state;
+#endif
+
+#ifdef FWK_INTERRUPT_STATS
+/*
+ * The interrupt service routines of the interrupts with statistics are called
+ * through isr_stats(), registered with the driver in their place.
+ */
+struct isr_stats_entry {
+    void (*isr)(void);
+    void (*isr_param)(uintptr_t param);
+    uintptr_t param;
+    struct fwk_interrupt_stats stats;
+};
+
+static struct isr_stats_entry isr_stats_table[FWK_INTERRUPT_STATS_COUNT];
+
+/* Time spent in the routines preempting the routine being timed */
+static fwk_duration_ns_t isr_preempted;
+
+/* Start of the current critical section, and longest critical section */
+static fwk_timestamp_t masked_start;
+static fwk_duration_ns_t masked_max;
+
+/*
+ * Interrupts are masked while reading the profiling clock and updating the
+ * statistics, as a routine preempting this one would do the same.
+ */
+static FWK_HOT void isr_stats(uintptr_t interrupt)
+{
+    struct isr_stats_entry *entry = &isr_stats_table[interrupt];
+    fwk_duration_ns_t preempted, elapsed, duration;
+    fwk_timestamp_t start;
+
+    driver->global_disable();
+    preempted = isr_preempted;
+    isr_preempted = 0;
+    start = fwk_time_profile_current();
+    driver->global_enable();
+
+    if (entry->isr_param != NULL)
+        entry->isr_param(entry->param);
+    else
+        entry->isr();
+
+    driver->global_disable();
+    elapsed = fwk_time_profile_current() - start;
+
+    /* Exclude the routines that preempted this one */
+    duration = elapsed - FWK_MIN(elapsed, isr_preempted);
+
+    /* Include this routine in the preemption of the one it preempted */
+    isr_preempted = preempted + elapsed;
+
+    entry->stats.count++;
+    entry->stats.total += duration;
+    entry->stats.max = FWK_MAX(entry->stats.max, duration);
+    driver->global_enable();
+}
+#endif
+
 int fwk_interrupt_init(const struct fwk_arch_interrupt_driver *_driver)
 {
     /* Validate driver by checking that all function pointers are non-null */
@@ -54,6 +128,8 @@ int fwk_interrupt_init(const struct fwk_arch_interrupt_driver *_driver)
         return FWK_E_PARAM;
     if (_driver->get_current == NULL)
         return FWK_E_PARAM;
+    if ((_driver->mask_priority == NULL) != (_driver->unmask_priority == NULL))
+        return FWK_E_PARAM;
 
     driver = _driver;
     initialized = true;
@@ -61,34 +137,140 @@ int fwk_interrupt_init(const struct fwk_arch_interrupt_driver *_driver)
     return FWK_SUCCESS;
 }
 
+/* Mask the interrupts when entering the outer-most critical section */
+static int critical_section_enter(void)
+{
+#ifdef FWK_INTERRUPT_CRITICAL_PRIORITY
+    /* Fall back to masking all interrupts if the driver cannot do better */
+    if ((driver->mask_priority != NULL) &&
+        (driver->mask_priority(
+             FWK_INTERRUPT_CRITICAL_PRIORITY,
+             &critical_section_priority_state) == FWK_SUCCESS)) {
+        critical_section_masks_priority = true;
+
+        return FWK_SUCCESS;
+    }
+#endif
+
+    critical_section_masks_all = true;
+
+    return driver->global_disable();
+}
+
+/* Unmask the interrupts when leaving the outer-most critical section */
+static int critical_section_exit(void)
+{
+#ifdef FWK_INTERRUPT_CRITICAL_PRIORITY
+    int status;
+
+    if (critical_section_masks_priority) {
+        critical_section_masks_priority = false;
+
+        status = driver->unmask_priority(critical_section_priority_state);
+        if (!critical_section_masks_all)
+            return status;
+    }
+#endif
+
+    critical_section_masks_all = false;
+
+    return driver->global_enable();
+}
+
 int fwk_interrupt_global_enable(void)
 {
     if (!initialized)
         return FWK_E_INIT;
 
+#ifdef FWK_INTERRUPT_STATS
+    /*
+     * The critical section is timed before leaving it, so that reading the
+     * profiling clock may itself enter a nested critical section.
+     */
+    if (critical_section_nest_level == 1) {
+        masked_max = FWK_MAX(
+            masked_max, fwk_time_profile_current() - masked_start);
+    }
+#endif
+
     /* Decrement critical_section_nest_level only if in critical section */
     if (critical_section_nest_level > 0)
         critical_section_nest_level--;
 
-    /* Enable interrupts globally if now outside critical section */
+    /* Enable interrupts if now outside critical section */
     if (critical_section_nest_level == 0)
-        return driver->global_enable();
+        return critical_section_exit();
 
     return FWK_SUCCESS;
 }
 
 int fwk_interrupt_global_disable(void)
 {
+    int status = FWK_SUCCESS;
+
+    if (!initialized)
+        return FWK_E_INIT;
+
+    critical_section_nest_level++;
+
+    /* If now in outer-most critical section, disable interrupts */
+    if (critical_section_nest_level == 1) {
+        status = critical_section_enter();
+
+#ifdef FWK_INTERRUPT_STATS
+        masked_start = fwk_time_profile_current();
+#endif
+    }
+
+    return status;
+}
+
+int fwk_interrupt_global_disable_all(void)
+{
+    int status = FWK_SUCCESS;
+
     if (!initialized)
         return FWK_E_INIT;
 
     critical_section_nest_level++;
 
-    /* If now in outer-most critical section, disable interrupts globally */
+    /* Mask all interrupts, even within a critical section masking fewer */
+    if (!critical_section_masks_all) {
+        critical_section_masks_all = true;
+        status = driver->global_disable();
+    }
+
+#ifdef FWK_INTERRUPT_STATS
     if (critical_section_nest_level == 1)
-        return driver->global_disable();
+        masked_start = fwk_time_profile_current();
+#endif
 
-    return FWK_SUCCESS;
+    return status;
+}
+
+int fwk_interrupt_mask_priority(unsigned int priority, unsigned int *state)
+{
+    if (!initialized)
+        return FWK_E_INIT;
+
+    if (driver->mask_priority == NULL)
+        return FWK_E_SUPPORT;
+
+    if ((priority == 0) || (state == NULL))
+        return FWK_E_PARAM;
+
+    return driver->mask_priority(priority, state);
+}
+
+int fwk_interrupt_unmask_priority(unsigned int state)
+{
+    if (!initialized)
+        return FWK_E_INIT;
+
+    if (driver->unmask_priority == NULL)
+        return FWK_E_SUPPORT;
+
+    return driver->unmask_priority(state);
 }
 
 int fwk_interrupt_is_enabled(unsigned int interrupt, bool *enabled)
@@ -155,8 +337,17 @@ int fwk_interrupt_set_isr(unsigned int interrupt, void (*isr)(void))
 
     if (interrupt == FWK_INTERRUPT_NMI)
         return driver->set_isr_nmi(isr);
-    else
-        return driver->set_isr_irq(interrupt, isr);
+
+#ifdef FWK_INTERRUPT_STATS
+    if (interrupt < FWK_INTERRUPT_STATS_COUNT) {
+        isr_stats_table[interrupt].isr = isr;
+        isr_stats_table[interrupt].isr_param = NULL;
+
+        return driver->set_isr_irq_param(interrupt, isr_stats, interrupt);
+    }
+#endif
+
+    return driver->set_isr_irq(interrupt, isr);
 }
 
 int fwk_interrupt_set_isr_param(unsigned int interrupt,
@@ -171,8 +362,17 @@ int fwk_interrupt_set_isr_param(unsigned int interrupt,
 
     if (interrupt == FWK_INTERRUPT_NMI)
         return driver->set_isr_nmi_param(isr, param);
-    else
-        return driver->set_isr_irq_param(interrupt, isr, param);
+
+#ifdef FWK_INTERRUPT_STATS
+    if (interrupt < FWK_INTERRUPT_STATS_COUNT) {
+        isr_stats_table[interrupt].isr_param = isr;
+        isr_stats_table[interrupt].param = param;
+
+        return driver->set_isr_irq_param(interrupt, isr_stats, interrupt);
+    }
+#endif
+
+    return driver->set_isr_irq_param(interrupt, isr, param);
 }
 
 int fwk_interrupt_get_current(unsigned int *interrupt)
@@ -186,6 +386,82 @@ int fwk_interrupt_get_current(unsigned int *interrupt)
     return driver->get_current(interrupt);
 }
 
+int fwk_interrupt_get_current_priority(unsigned int *priority)
+{
+    if (!initialized)
+        return FWK_E_INIT;
+
+    if (priority == NULL)
+        return FWK_E_PARAM;
+
+    if (driver->get_current_priority == NULL)
+        return FWK_E_SUPPORT;
+
+    return driver->get_current_priority(priority);
+}
+
+int fwk_interrupt_get_stats(
+    unsigned int interrupt,
+    struct fwk_interrupt_stats *stats)
+{
+#ifdef FWK_INTERRUPT_STATS
+    if (!initialized)
+        return FWK_E_INIT;
+
+    if ((interrupt >= FWK_INTERRUPT_STATS_COUNT) || (stats == NULL))
+        return FWK_E_PARAM;
+
+    fwk_interrupt_global_disable();
+    *stats = isr_stats_table[interrupt].stats;
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
+int fwk_interrupt_get_masked_max(fwk_duration_ns_t *duration)
+{
+#ifdef FWK_INTERRUPT_STATS
+    if (duration == NULL)
+        return FWK_E_PARAM;
+
+    *duration = masked_max;
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
+int fwk_interrupt_reset_stats(void)
+{
+#ifdef FWK_INTERRUPT_STATS
+    unsigned int interrupt;
+
+    if (!initialized)
+        return FWK_E_INIT;
+
+    fwk_interrupt_global_disable();
+
+    for (interrupt = 0; interrupt < FWK_INTERRUPT_STATS_COUNT; interrupt++) {
+        memset(
+            &isr_stats_table[interrupt].stats,
+            0,
+            sizeof(isr_stats_table[interrupt].stats));
+    }
+
+    masked_max = 0;
+
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
 /* This function is only for internal use by the framework */
 int fwk_interrupt_set_isr_fault(void (*isr)(void))
 {
@@ -232,6 +232,7 @@ int fwk_io_write(
     int status = FWK_SUCCESS;
 
     const char *cbuffer = buffer;
+    size_t total;
 
     if (!fwk_expect(cbuffer != NULL))
         return FWK_E_PARAM;
@@ -239,6 +240,22 @@ int fwk_io_write(
     if (written != NULL)
         *written = 0;
 
+    if ((stream != NULL) && (stream->adapter != NULL) &&
+        (stream->adapter->write != NULL) &&
+        (stream->mode & FWK_IO_MODE_WRITE)) {
+        if (__builtin_mul_overflow(size, count, &total))
+            return FWK_E_PARAM;
+
+        status = stream->adapter->write(stream, cbuffer, total);
+        if (status != FWK_SUCCESS)
+            return FWK_E_HANDLER;
+
+        if (written != NULL)
+            *written = count;
+
+        return FWK_SUCCESS;
+    }
+
     for (size_t i = 0; (i < count) && (status == FWK_SUCCESS); i++) {
         for (size_t j = 0; (j < size) && (status == FWK_SUCCESS); j++)
             status = fwk_io_putch(stream, *cbuffer++);
@@ -250,6 +267,26 @@ int fwk_io_write(
     return status;
 }
 
+int fwk_io_flush(const struct fwk_io_stream *stream)
+{
+    int status;
+
+    if (!fwk_expect(stream != NULL))
+        return FWK_E_PARAM;
+
+    if (!fwk_expect(stream->adapter != NULL))
+        return FWK_E_STATE; /* The stream is not open */
+
+    if (stream->adapter->flush == NULL)
+        return FWK_SUCCESS; /* Nothing is buffered by the adapter */
+
+    status = stream->adapter->flush(stream);
+    if (status != FWK_SUCCESS)
+        return FWK_E_HANDLER;
+
+    return FWK_SUCCESS;
+}
+
 int fwk_io_close(struct fwk_io_stream *stream)
 {
     int status;
@@ -0,0 +1,286 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Event latency measurements.
+ */
+
+#include <internal/fwk_latency.h>
+#include <internal/fwk_module.h>
+
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_assert.h>
+#include <fwk_latency.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_math.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_time.h>
+
+#include <inttypes.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef FWK_EVENT_LATENCY
+/*
+ * Get the latency statistics of an event or notification, or NULL if the
+ * identifier does not refer to one.
+ */
+static struct fwk_latency_stats *get_stats(fwk_id_t id)
+{
+    const struct fwk_module_ctx *module_ctx;
+    unsigned int module_idx;
+    unsigned int idx;
+
+    module_idx = fwk_id_get_module_idx(id);
+    if (module_idx >= FWK_MODULE_IDX_COUNT)
+        return NULL;
+
+    module_ctx = fwk_module_get_ctx(FWK_ID_MODULE(module_idx));
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_EVENT)) {
+        idx = fwk_id_get_event_idx(id);
+        if (idx >= module_ctx->desc->event_count)
+            return NULL;
+#ifdef BUILD_HAS_NOTIFICATION
+    } else if (fwk_id_is_type(id, FWK_ID_TYPE_NOTIFICATION)) {
+        idx = fwk_id_get_notification_idx(id);
+        if (idx >= module_ctx->desc->notification_count)
+            return NULL;
+
+        /* Notifications follow the events in the table */
+        idx += module_ctx->desc->event_count;
+#endif
+    } else
+        return NULL;
+
+    if (module_ctx->latency_table == NULL)
+        return NULL;
+
+    return &module_ctx->latency_table[idx];
+}
+
+static void record_sample(
+    struct fwk_latency_histogram *histogram,
+    fwk_timestamp_t start,
+    fwk_timestamp_t end)
+{
+    fwk_duration_ns_t duration = (end > start) ? (end - start) : 0;
+    fwk_duration_us_t duration_us = fwk_time_duration_us(duration);
+    unsigned int bucket = 0;
+
+    if (duration_us > 0) {
+        bucket = FWK_MIN(
+            (unsigned int)fwk_math_log2(duration_us) + 1,
+            FWK_EVENT_LATENCY_BUCKET_COUNT - 1u);
+    }
+
+    histogram->buckets[bucket]++;
+    histogram->total += duration;
+    histogram->max = FWK_MAX(histogram->max, duration);
+}
+
+void __fwk_latency_record(
+    const struct fwk_event *event,
+    fwk_timestamp_t dispatch_timestamp)
+{
+    fwk_timestamp_t return_timestamp = fwk_time_current();
+    struct fwk_latency_stats *stats;
+
+    stats = get_stats(event->id);
+    if (stats == NULL)
+        return;
+
+    record_sample(&stats->queue, event->timestamp, dispatch_timestamp);
+    record_sample(&stats->handler, dispatch_timestamp, return_timestamp);
+}
+#endif
+
+#ifdef FWK_EVENT_BUDGET
+static const char overrun_msg[] =
+    "[FWK] %s -> %s took %" PRIu32 " us, budget %" PRIu32 " us";
+
+static struct {
+    /* Events whose handlers overran the most, unordered */
+    struct fwk_latency_overrun offenders[FWK_EVENT_BUDGET_OFFENDER_COUNT];
+
+    /* Number of overruns */
+    uint32_t count;
+} overruns;
+
+/*
+ * Get the entry of an event in the offender table, or the entry of the least
+ * offender to replace if the event has none. Free entries have no overrun.
+ */
+static struct fwk_latency_overrun *get_offender(fwk_id_t id)
+{
+    struct fwk_latency_overrun *entry = &overruns.offenders[0];
+    struct fwk_latency_overrun *offender;
+    unsigned int i;
+
+    for (i = 0; i < FWK_EVENT_BUDGET_OFFENDER_COUNT; i++) {
+        offender = &overruns.offenders[i];
+
+        if ((offender->count > 0) && fwk_id_is_equal(offender->id, id))
+            return offender;
+
+        if (offender->max < entry->max)
+            entry = offender;
+    }
+
+    return entry;
+}
+
+void __fwk_latency_check_budget(
+    const struct fwk_event *event,
+    fwk_timestamp_t dispatch_timestamp)
+{
+    fwk_duration_ns_t duration;
+    const struct fwk_module *module;
+    struct fwk_latency_overrun *offender;
+    uint32_t budget_us;
+
+    duration = fwk_time_profile_current() - dispatch_timestamp;
+
+    module = fwk_module_get_ctx(event->target_id)->desc;
+    budget_us = (module->event_budget_us != 0) ? module->event_budget_us :
+                                                 FMW_EVENT_BUDGET_US;
+
+    if (duration <= FWK_US(budget_us))
+        return;
+
+    overruns.count++;
+
+#    if defined(FMW_EVENT_BUDGET_TRAP) && (FMW_EVENT_BUDGET_TRAP != 0)
+    FWK_LOG_CRIT(
+        overrun_msg,
+        FWK_ID_STR(event->id),
+        FWK_ID_STR(event->target_id),
+        (uint32_t)fwk_time_duration_us(duration),
+        budget_us);
+    FWK_LOG_FLUSH();
+    fwk_trap();
+#    endif
+
+    offender = get_offender(event->id);
+    if ((offender->count == 0) || !fwk_id_is_equal(offender->id, event->id)) {
+        /* The least offender outranks this event */
+        if (offender->max >= duration)
+            return;
+
+        *offender = (struct fwk_latency_overrun){ .id = event->id };
+    }
+
+    offender->count++;
+
+    if (duration > offender->max) {
+        offender->max = duration;
+        offender->target_id = event->target_id;
+
+        FWK_LOG_WARN(
+            overrun_msg,
+            FWK_ID_STR(event->id),
+            FWK_ID_STR(event->target_id),
+            (uint32_t)fwk_time_duration_us(duration),
+            budget_us);
+    }
+}
+#endif
+
+int fwk_latency_get_stats(fwk_id_t id, struct fwk_latency_stats *stats)
+{
+#ifdef FWK_EVENT_LATENCY
+    const struct fwk_latency_stats *entry;
+
+    if (stats == NULL)
+        return FWK_E_PARAM;
+
+    entry = get_stats(id);
+    if (entry == NULL)
+        return FWK_E_PARAM;
+
+    *stats = *entry;
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
+int fwk_latency_get_overruns(
+    struct fwk_latency_overrun *overruns_table,
+    unsigned int *count,
+    uint32_t *total)
+{
+#ifdef FWK_EVENT_BUDGET
+    struct fwk_latency_overrun offender;
+    unsigned int used = 0;
+    unsigned int i, j;
+
+    if ((overruns_table == NULL) || (count == NULL) || (total == NULL))
+        return FWK_E_PARAM;
+
+    /* Sort the offenders by decreasing longest handler time */
+    for (i = 0; i < FWK_EVENT_BUDGET_OFFENDER_COUNT; i++) {
+        offender = overruns.offenders[i];
+        if (offender.count == 0)
+            continue;
+
+        for (j = used; (j > 0) && (overruns_table[j - 1].max < offender.max);
+             j--)
+            overruns_table[j] = overruns_table[j - 1];
+
+        overruns_table[j] = offender;
+        used++;
+    }
+
+    *count = used;
+    *total = overruns.count;
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
+int fwk_latency_reset(void)
+{
+#if defined(FWK_EVENT_LATENCY) || defined(FWK_EVENT_BUDGET)
+#    ifdef FWK_EVENT_LATENCY
+    const struct fwk_module_ctx *module_ctx;
+    size_t count;
+
+    for (unsigned int i = 0; i < FWK_MODULE_IDX_COUNT; i++) {
+        module_ctx = fwk_module_get_ctx(FWK_ID_MODULE(i));
+        if (module_ctx->latency_table == NULL)
+            continue;
+
+        count = module_ctx->desc->event_count;
+#        ifdef BUILD_HAS_NOTIFICATION
+        count += module_ctx->desc->notification_count;
+#        endif
+
+        memset(
+            module_ctx->latency_table,
+            0,
+            count * sizeof(module_ctx->latency_table[0]));
+    }
+#    endif
+
+#    ifdef FWK_EVENT_BUDGET
+    memset(&overruns, 0, sizeof(overruns));
+#    endif
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
@@ -5,10 +5,14 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <internal/fwk_id.h>
+
 #include <fwk_assert.h>
 #include <fwk_attributes.h>
+#include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_log.h>
+#include <fwk_module_idx.h>
 #include <fwk_ring.h>
 #include <fwk_status.h>
 #include <fwk_time.h>
@@ -24,6 +28,62 @@
 
 static const char FWK_LOG_TERMINATOR[] = { '\n', '\0' };
 
+#ifdef FWK_LOG_BINARY
+/*
+ * Binary log records are stored in the ring buffer prefixed with their length,
+ * and start with this header. The header is followed by the arguments of the
+ * message in the order they are consumed by the format string: integers of
+ * rank `int` or lower as an `int`, other integers as a `long long`, pointers
+ * as a `void *`, floating-point values as a `double` and strings as a copy of
+ * their null-terminated contents.
+ *
+ * Identifiers passed through FWK_ID_STR() are recorded as strings holding
+ * their packed representation: a 0x1F marker followed by five characters each
+ * carrying seven bits of the identifier value, least significant first, with
+ * their top bit set. They are resolved when the record is formatted.
+ */
+struct fwk_log_record_header {
+    const char *format; /* Format string, doubling as its identifier */
+    fwk_timestamp_t timestamp; /* Time at which the message was logged */
+};
+
+/* Class of the argument consumed by a conversion specification */
+enum fwk_log_arg_class {
+    FWK_LOG_ARG_NONE,
+    FWK_LOG_ARG_INT,
+    FWK_LOG_ARG_LONG_LONG,
+    FWK_LOG_ARG_POINTER,
+    FWK_LOG_ARG_DOUBLE,
+    FWK_LOG_ARG_STRING,
+};
+
+/* Length modifier of a conversion specification */
+enum fwk_log_length {
+    FWK_LOG_LENGTH_NONE,
+    FWK_LOG_LENGTH_CHAR, /* hh */
+    FWK_LOG_LENGTH_SHORT, /* h */
+    FWK_LOG_LENGTH_LONG, /* l */
+    FWK_LOG_LENGTH_LONG_LONG, /* ll */
+    FWK_LOG_LENGTH_INTMAX, /* j */
+    FWK_LOG_LENGTH_SIZE, /* z */
+    FWK_LOG_LENGTH_PTRDIFF, /* t */
+    FWK_LOG_LENGTH_LONG_DOUBLE, /* L */
+};
+
+/* Parsed conversion specification */
+struct fwk_log_conversion {
+    const char *start; /* Start of the specification, the `%` character */
+    const char *modifier; /* Start of the length modifier */
+    const char *end; /* End of the specification */
+
+    enum fwk_log_arg_class class; /* Class of the argument */
+    enum fwk_log_length length; /* Length modifier */
+    unsigned int star_count; /* Number of `*` width and precision arguments */
+    bool is_signed; /* Whether the integer argument is signed */
+    char specifier; /* Conversion specifier */
+};
+#endif
+
 static struct {
     unsigned int dropped; /* Count of messages lost */
 
@@ -32,10 +92,19 @@ static struct {
 
     unsigned char remaining; /* Remaining characters in the current message */
 #endif
+
+#ifdef FWK_LOG_BINARY
+    /* Message formatted from the current binary record */
+    char line[FMW_LOG_COLUMNS + sizeof(FWK_LOG_TERMINATOR)];
+
+    unsigned char position; /* Position of the next character in the line */
+#endif
 } fwk_log_ctx = { 0 };
 
 static struct fwk_io_stream *fwk_log_stream;
 
+unsigned char fwk_log_level_table[FWK_MODULE_IDX_COUNT];
+
 #ifdef FWK_LOG_BUFFERED
 static FWK_CONSTRUCTOR void fwk_log_stream_init(void)
 {
@@ -51,6 +120,9 @@ int fwk_log_init(void)
 
     int status = FWK_SUCCESS;
 
+    for (unsigned int i = 0; i < FWK_MODULE_IDX_COUNT; i++)
+        fwk_log_level_table[i] = FMW_LOG_RUNTIME_LEVEL;
+
     if (fwk_id_is_equal(FMW_LOG_DRAIN_ID, FMW_IO_STDOUT_ID))
         fwk_log_stream = fwk_io_stdout;
     else if (!fwk_id_is_equal(FMW_LOG_DRAIN_ID, FWK_ID_NONE)) {
@@ -63,6 +135,37 @@ int fwk_log_init(void)
 }
 
 #ifdef FWK_LOG_BUFFERED
+/*
+ * Store a message in the ring buffer prefixed with its length. Space for both
+ * is reserved up front so the message is copied straight into the storage of
+ * the ring buffer.
+ */
+static bool fwk_log_enqueue(
+    struct fwk_ring *ring,
+    const void *message,
+    unsigned char length)
+{
+    struct fwk_ring_span spans[2];
+    size_t size = sizeof(length) + length;
+    size_t chunk_size;
+
+    if (fwk_ring_reserve(ring, size, spans) != size)
+        return false; /* Not enough buffer space */
+
+    /* The first span always holds at least the length prefix */
+    spans[0].data[0] = (char)length;
+    chunk_size = spans[0].size - sizeof(length);
+
+    memcpy(spans[0].data + sizeof(length), message, chunk_size);
+    memcpy(spans[1].data, (const char *)message + chunk_size, spans[1].size);
+
+    fwk_ring_commit(ring, size);
+
+    return true;
+}
+#endif
+
+#if defined(FWK_LOG_BUFFERED) && !defined(FWK_LOG_BINARY)
 static bool fwk_log_buffer(struct fwk_ring *ring, const char *message)
 {
     unsigned char length = strlen(message) + 1; /* +1 for null terminator */
@@ -73,23 +176,15 @@ static bool fwk_log_buffer(struct fwk_ring *ring, const char *message)
      * of each message does not exceed `UCHAR_MAX`.
      */
 
-    if ((sizeof(length) + length) > fwk_ring_get_free(ring))
-        return false; /* Not enough buffer space */
-
-    fwk_ring_push(ring, (char *)&length, sizeof(length));
-    fwk_ring_push(ring, message, length);
-
-    return true;
+    return fwk_log_enqueue(ring, message, length);
 }
 #endif
 
-static void fwk_log_vsnprintf(
+static size_t fwk_log_timestamp(
     size_t buffer_size,
     char buffer[buffer_size],
-    const char *format,
-    va_list *args)
+    fwk_timestamp_t timestamp)
 {
-    fwk_timestamp_t timestamp = 0;
     fwk_duration_ns_t duration = 0;
 
     uint32_t duration_s = 0;
@@ -97,16 +192,11 @@ static void fwk_log_vsnprintf(
 
     size_t length = 0;
 
-    char *newline;
-
-    buffer_size -= strlen(FWK_LOG_TERMINATOR);
-
     /*
      * We start by generating a timestamp for the message using the number of
      * nanoseconds since boot.
      */
 
-    timestamp = fwk_time_current();
     duration = fwk_time_stamp_duration(timestamp);
 
     /*
@@ -131,13 +221,12 @@ static void fwk_log_vsnprintf(
         duration_us);
     fwk_assert(length < buffer_size);
 
-    /*
-     * We then need to `snprintf()` the message into a temporary buffer because
-     * we need to manipulate it before we print or store it.
-     */
+    return length;
+}
 
-    length += vsnprintf(buffer + length, buffer_size - length, format, *args);
-    length = FWK_MIN(length, buffer_size - 1);
+static void fwk_log_terminate(char *buffer, size_t length)
+{
+    char *newline;
 
     /*
      * Figure out if the user has included a newline, in which case we consider
@@ -160,6 +249,517 @@ static void fwk_log_vsnprintf(
     memcpy(newline, FWK_LOG_TERMINATOR, sizeof(FWK_LOG_TERMINATOR));
 }
 
+static void fwk_log_vsnprintf(
+    size_t buffer_size,
+    char buffer[buffer_size],
+    const char *format,
+    va_list *args)
+{
+    size_t length = 0;
+
+    buffer_size -= strlen(FWK_LOG_TERMINATOR);
+
+    length = fwk_log_timestamp(buffer_size, buffer, fwk_time_current());
+
+    /*
+     * We then need to `snprintf()` the message into a temporary buffer because
+     * we need to manipulate it before we print or store it.
+     */
+
+    length += vsnprintf(buffer + length, buffer_size - length, format, *args);
+    length = FWK_MIN(length, buffer_size - 1);
+
+    fwk_log_terminate(buffer, length);
+}
+
+#ifdef FWK_LOG_BINARY
+/*
+ * Parse the conversion specification starting at `start`, which points to a
+ * `%` character.
+ */
+static void fwk_log_parse_conversion(
+    const char *start,
+    struct fwk_log_conversion *conversion)
+{
+    static const struct {
+        char modifier[3];
+        enum fwk_log_length length;
+    } modifiers[] = {
+        { "hh", FWK_LOG_LENGTH_CHAR },    { "h", FWK_LOG_LENGTH_SHORT },
+        { "ll", FWK_LOG_LENGTH_LONG_LONG }, { "l", FWK_LOG_LENGTH_LONG },
+        { "j", FWK_LOG_LENGTH_INTMAX },   { "z", FWK_LOG_LENGTH_SIZE },
+        { "t", FWK_LOG_LENGTH_PTRDIFF },  { "L", FWK_LOG_LENGTH_LONG_DOUBLE },
+    };
+
+    const char *cursor = start + 1;
+
+    *conversion = (struct fwk_log_conversion){
+        .start = start,
+        .class = FWK_LOG_ARG_NONE,
+        .length = FWK_LOG_LENGTH_NONE,
+    };
+
+    /* Flags */
+    while ((*cursor != '\0') && (strchr("-+ #0", *cursor) != NULL))
+        cursor++;
+
+    /* Field width and precision */
+    for (unsigned int field = 0; field < 2; field++) {
+        if ((field == 1) && (*cursor++ != '.')) {
+            cursor--;
+            break;
+        }
+
+        if (*cursor == '*') {
+            conversion->star_count++;
+            cursor++;
+        } else {
+            while ((*cursor >= '0') && (*cursor <= '9'))
+                cursor++;
+        }
+    }
+
+    /* Length modifier */
+    conversion->modifier = cursor;
+
+    for (unsigned int i = 0; i < FWK_ARRAY_SIZE(modifiers); i++) {
+        size_t length = strlen(modifiers[i].modifier);
+
+        if (strncmp(cursor, modifiers[i].modifier, length) == 0) {
+            conversion->length = modifiers[i].length;
+            cursor += length;
+
+            break;
+        }
+    }
+
+    /* Conversion specifier */
+    conversion->specifier = *cursor;
+    if (*cursor != '\0')
+        cursor++;
+
+    conversion->end = cursor;
+
+    switch (conversion->specifier) {
+    case 'd':
+    case 'i':
+        conversion->is_signed = true;
+
+        /* Fall through */
+
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+        if ((conversion->length == FWK_LOG_LENGTH_NONE) ||
+            (conversion->length == FWK_LOG_LENGTH_CHAR) ||
+            (conversion->length == FWK_LOG_LENGTH_SHORT))
+            conversion->class = FWK_LOG_ARG_INT;
+        else
+            conversion->class = FWK_LOG_ARG_LONG_LONG;
+
+        break;
+
+    case 'c':
+        conversion->class = FWK_LOG_ARG_INT;
+
+        break;
+
+    case 'p':
+    case 'n':
+        conversion->class = FWK_LOG_ARG_POINTER;
+
+        break;
+
+    case 's':
+        conversion->class = FWK_LOG_ARG_STRING;
+
+        break;
+
+    case 'a':
+    case 'A':
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+        conversion->class = FWK_LOG_ARG_DOUBLE;
+
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*
+ * Fetch an integer argument, applying the conversion its length modifier
+ * implies.
+ */
+static long long fwk_log_fetch_integer(
+    const struct fwk_log_conversion *conversion,
+    va_list *args)
+{
+    bool is_signed = conversion->is_signed;
+
+    switch (conversion->length) {
+    case FWK_LOG_LENGTH_CHAR:
+        return is_signed ? (signed char)va_arg(*args, int) :
+                           (unsigned char)va_arg(*args, int);
+
+    case FWK_LOG_LENGTH_SHORT:
+        return is_signed ? (short)va_arg(*args, int) :
+                           (unsigned short)va_arg(*args, int);
+
+    case FWK_LOG_LENGTH_LONG:
+        return is_signed ? va_arg(*args, long) :
+                           (long long)va_arg(*args, unsigned long);
+
+    case FWK_LOG_LENGTH_LONG_LONG:
+        return is_signed ? va_arg(*args, long long) :
+                           (long long)va_arg(*args, unsigned long long);
+
+    case FWK_LOG_LENGTH_INTMAX:
+        return is_signed ? (long long)va_arg(*args, intmax_t) :
+                           (long long)va_arg(*args, uintmax_t);
+
+    case FWK_LOG_LENGTH_SIZE:
+        return (long long)va_arg(*args, size_t);
+
+    case FWK_LOG_LENGTH_PTRDIFF:
+        return (long long)va_arg(*args, ptrdiff_t);
+
+    default:
+        return is_signed ? va_arg(*args, int) :
+                           (long long)va_arg(*args, unsigned int);
+    }
+}
+
+/*
+ * Append an object to a binary record, returning false if it does not fit.
+ */
+static bool fwk_log_record_append(
+    unsigned char *record,
+    size_t *length,
+    const void *data,
+    size_t size)
+{
+    if (size > (UCHAR_MAX - *length))
+        return false;
+
+    memcpy(record + *length, data, size);
+    *length += size;
+
+    return true;
+}
+
+/*
+ * Store a binary record of a message in the ring buffer. Only the arguments
+ * are captured; the message is formatted when the record is unbuffered.
+ */
+static bool fwk_log_record(
+    struct fwk_ring *ring,
+    const char *format,
+    va_list *args)
+{
+    unsigned char record[UCHAR_MAX];
+    unsigned char record_length;
+    size_t length = 0;
+
+    struct fwk_log_conversion conversion;
+    const char *cursor;
+
+    const struct fwk_log_record_header header = {
+        .format = format,
+        .timestamp = fwk_time_current(),
+    };
+
+    fwk_log_record_append(record, &length, &header, sizeof(header));
+
+    for (cursor = strchr(format, '%'); cursor != NULL;
+         cursor = strchr(conversion.end, '%')) {
+        bool fits = true;
+
+        fwk_log_parse_conversion(cursor, &conversion);
+
+        for (unsigned int i = 0; fits && (i < conversion.star_count); i++) {
+            int star = va_arg(*args, int);
+
+            fits = fwk_log_record_append(record, &length, &star, sizeof(star));
+        }
+
+        switch (conversion.class) {
+        case FWK_LOG_ARG_INT: {
+            int value = (int)fwk_log_fetch_integer(&conversion, args);
+
+            fits = fits &&
+                fwk_log_record_append(record, &length, &value, sizeof(value));
+
+            break;
+        }
+
+        case FWK_LOG_ARG_LONG_LONG: {
+            long long value = fwk_log_fetch_integer(&conversion, args);
+
+            fits = fits &&
+                fwk_log_record_append(record, &length, &value, sizeof(value));
+
+            break;
+        }
+
+        case FWK_LOG_ARG_POINTER: {
+            void *value = va_arg(*args, void *);
+
+            fits = fits &&
+                fwk_log_record_append(record, &length, &value, sizeof(value));
+
+            break;
+        }
+
+        case FWK_LOG_ARG_DOUBLE: {
+            double value;
+
+            if (conversion.length == FWK_LOG_LENGTH_LONG_DOUBLE)
+                value = (double)va_arg(*args, long double);
+            else
+                value = va_arg(*args, double);
+
+            fits = fits &&
+                fwk_log_record_append(record, &length, &value, sizeof(value));
+
+            break;
+        }
+
+        case FWK_LOG_ARG_STRING: {
+            const char *value = va_arg(*args, const char *);
+
+            if (value == NULL)
+                value = "(null)";
+
+            /* Strings are truncated to whatever space is left */
+            if (fits && (length < UCHAR_MAX)) {
+                size_t size = FWK_MIN(strlen(value), UCHAR_MAX - length - 1);
+
+                fwk_log_record_append(record, &length, value, size);
+                record[length++] = '\0';
+            } else
+                fits = false;
+
+            break;
+        }
+
+        default:
+            break;
+        }
+
+        if (!fits)
+            return false;
+    }
+
+    record_length = (unsigned char)length;
+
+    return fwk_log_enqueue(ring, record, record_length);
+}
+
+/*
+ * Format a single conversion specification of a binary record into `buffer`,
+ * consuming its arguments from the record.
+ */
+static int fwk_log_format_conversion(
+    size_t buffer_size,
+    char buffer[buffer_size],
+    const struct fwk_log_conversion *conversion,
+    const unsigned char **record,
+    const unsigned char *record_end)
+{
+    char specification[16];
+    size_t prefix_length;
+    int stars[2] = { 0 };
+
+    union {
+        int i;
+        long long ll;
+        void *p;
+        double d;
+    } value = { 0 };
+    const char *string = "";
+    struct __fwk_id_fmt id_fmt;
+    fwk_id_t id;
+
+    /*
+     * Rebuild the specification without its length modifier; integers that
+     * were widened when recorded use `ll` instead.
+     */
+
+    prefix_length = conversion->modifier - conversion->start;
+    if ((prefix_length + 4) > sizeof(specification))
+        return 0;
+
+    memcpy(specification, conversion->start, prefix_length);
+    if (conversion->class == FWK_LOG_ARG_LONG_LONG) {
+        specification[prefix_length++] = 'l';
+        specification[prefix_length++] = 'l';
+    }
+    specification[prefix_length++] = conversion->specifier;
+    specification[prefix_length] = '\0';
+
+#    define FWK_LOG_RECORD_FETCH(OBJECT) \
+        do { \
+            if ((size_t)(record_end - *record) < sizeof(OBJECT)) \
+                return 0; \
+            memcpy(&(OBJECT), *record, sizeof(OBJECT)); \
+            *record += sizeof(OBJECT); \
+        } while (0)
+
+    for (unsigned int i = 0; i < conversion->star_count; i++)
+        FWK_LOG_RECORD_FETCH(stars[i]);
+
+    switch (conversion->class) {
+    case FWK_LOG_ARG_INT:
+        FWK_LOG_RECORD_FETCH(value.i);
+        break;
+
+    case FWK_LOG_ARG_LONG_LONG:
+        FWK_LOG_RECORD_FETCH(value.ll);
+        break;
+
+    case FWK_LOG_ARG_POINTER:
+        FWK_LOG_RECORD_FETCH(value.p);
+        break;
+
+    case FWK_LOG_ARG_DOUBLE:
+        FWK_LOG_RECORD_FETCH(value.d);
+        break;
+
+    case FWK_LOG_ARG_STRING: {
+        const unsigned char *terminator =
+            memchr(*record, '\0', record_end - *record);
+
+        if (terminator == NULL)
+            return 0;
+
+        string = (const char *)*record;
+        *record = terminator + 1;
+
+        if (__fwk_id_unpack_str(string, &id)) {
+            id_fmt = __fwk_id_format_str(id);
+            string = id_fmt.str;
+        }
+
+        break;
+    }
+
+    default:
+        return 0;
+    }
+
+#    undef FWK_LOG_RECORD_FETCH
+
+    /* The `%n` conversion is not supported and prints nothing */
+    if (conversion->specifier == 'n')
+        return 0;
+
+#    define FWK_LOG_FORMAT(VALUE) \
+        ((conversion->star_count == 0) ? \
+             snprintf(buffer, buffer_size, specification, (VALUE)) : \
+             (conversion->star_count == 1) ? \
+             snprintf(buffer, buffer_size, specification, stars[0], (VALUE)) : \
+             snprintf( \
+                 buffer, \
+                 buffer_size, \
+                 specification, \
+                 stars[0], \
+                 stars[1], \
+                 (VALUE)))
+
+    switch (conversion->class) {
+    case FWK_LOG_ARG_INT:
+        if (conversion->specifier == 'd' || conversion->specifier == 'i' ||
+            conversion->specifier == 'c')
+            return FWK_LOG_FORMAT(value.i);
+
+        return FWK_LOG_FORMAT((unsigned int)value.i);
+
+    case FWK_LOG_ARG_LONG_LONG:
+        if (conversion->is_signed)
+            return FWK_LOG_FORMAT(value.ll);
+
+        return FWK_LOG_FORMAT((unsigned long long)value.ll);
+
+    case FWK_LOG_ARG_POINTER:
+        return FWK_LOG_FORMAT(value.p);
+
+    case FWK_LOG_ARG_DOUBLE:
+        return FWK_LOG_FORMAT(value.d);
+
+    default:
+        return FWK_LOG_FORMAT(string);
+    }
+
+#    undef FWK_LOG_FORMAT
+}
+
+/*
+ * Format a binary record into a log line.
+ */
+static void fwk_log_format_record(
+    size_t buffer_size,
+    char buffer[buffer_size],
+    const unsigned char *record,
+    size_t record_length)
+{
+    const unsigned char *record_end = record + record_length;
+
+    struct fwk_log_record_header header;
+    struct fwk_log_conversion conversion;
+    const char *cursor;
+
+    size_t length;
+    int written;
+
+    buffer_size -= strlen(FWK_LOG_TERMINATOR);
+
+    memcpy(&header, record, sizeof(header));
+    record += sizeof(header);
+
+    length = fwk_log_timestamp(buffer_size, buffer, header.timestamp);
+
+    for (cursor = header.format; (*cursor != '\0') && (length < buffer_size);
+         cursor = conversion.end) {
+        if (*cursor != '%') {
+            buffer[length++] = *cursor;
+            conversion.end = cursor + 1;
+
+            continue;
+        }
+
+        fwk_log_parse_conversion(cursor, &conversion);
+
+        if (conversion.specifier == '%') {
+            buffer[length++] = '%';
+
+            continue;
+        }
+
+        written = fwk_log_format_conversion(
+            buffer_size - length,
+            buffer + length,
+            &conversion,
+            &record,
+            record_end);
+
+        if (written > 0)
+            length += (size_t)written;
+    }
+
+    length = FWK_MIN(length, buffer_size - 1);
+    buffer[length] = '\0';
+
+    fwk_log_terminate(buffer, length);
+}
+#endif
+
 static void fwk_log_snprintf(
     size_t buffer_size,
     char buffer[buffer_size],
@@ -202,7 +802,9 @@ void fwk_log_printf(const char *format, ...)
 {
     static bool banner = false;
 
+#ifndef FWK_LOG_BINARY
     char buffer[FMW_LOG_COLUMNS + sizeof(FWK_LOG_TERMINATOR)];
+#endif
 
     va_list args;
 
@@ -218,11 +820,23 @@ void fwk_log_printf(const char *format, ...)
     if (!banner)
         banner = fwk_log_banner();
 
+#if defined(FWK_LOG_BINARY)
+    /*
+     * Only record the raw arguments of the message; formatting it is left to
+     * whoever unbuffers it, typically once we're in an idle state.
+     */
+
+    va_start(args, format);
+    bool dropped = !fwk_log_record(&fwk_log_ctx.ring, format, &args);
+    va_end(args);
+
+    if (dropped)
+        fwk_log_ctx.dropped++;
+#elif defined(FWK_LOG_BUFFERED)
     va_start(args, format);
     fwk_log_vsnprintf(sizeof(buffer), buffer, format, &args);
     va_end(args);
 
-#ifdef FWK_LOG_BUFFERED
     /*
      * Buffer the message that we've received so that the scheduler can choose
      * when we do the heavy-lifting (typically once we're in an idle state).
@@ -240,6 +854,10 @@ void fwk_log_printf(const char *format, ...)
         fwk_log_ctx.dropped++;
     }
 #else
+    va_start(args, format);
+    fwk_log_vsnprintf(sizeof(buffer), buffer, format, &args);
+    va_end(args);
+
     int status = fwk_io_puts(fwk_log_stream, buffer);
     if (status != FWK_SUCCESS)
         fwk_log_ctx.dropped++;
@@ -248,12 +866,70 @@ void fwk_log_printf(const char *format, ...)
     fwk_interrupt_global_enable();
 }
 
+#ifdef FWK_LOG_BUFFERED
+/*
+ * Start unbuffering the next message, returning false if the buffer is empty.
+ * Interrupts must be disabled.
+ */
+static bool fwk_log_fetch_message(void)
+{
+    bool empty = !fwk_ring_pop(
+        &fwk_log_ctx.ring,
+        (char *)&fwk_log_ctx.remaining,
+        sizeof(fwk_log_ctx.remaining));
+
+    if (empty)
+        return false;
+
+#    ifdef FWK_LOG_BINARY
+    /*
+     * The buffer holds a binary record rather than the message itself, so
+     * format it now and print the resulting line instead.
+     */
+
+    unsigned char record[UCHAR_MAX];
+    unsigned char fetched;
+
+    fetched =
+        fwk_ring_pop(&fwk_log_ctx.ring, (char *)record, fwk_log_ctx.remaining);
+    fwk_assert(fetched == fwk_log_ctx.remaining);
+
+    fwk_log_format_record(
+        sizeof(fwk_log_ctx.line), fwk_log_ctx.line, record, fetched);
+
+    fwk_log_ctx.remaining = strlen(fwk_log_ctx.line);
+    fwk_log_ctx.position = 0;
+#    endif
+
+    return true;
+}
+
+/*
+ * Take characters of the current message out of the buffer. Interrupts must be
+ * disabled.
+ */
+static void fwk_log_fetch_chars(char *buffer, unsigned char count)
+{
+#    ifdef FWK_LOG_BINARY
+    memcpy(buffer, &fwk_log_ctx.line[fwk_log_ctx.position], count);
+    fwk_log_ctx.position += count;
+#    else
+    size_t fetched = fwk_ring_pop(&fwk_log_ctx.ring, buffer, count);
+    fwk_assert(fetched == count);
+#    endif
+
+    fwk_log_ctx.remaining -= count;
+}
+#endif
+
 int fwk_log_unbuffer(void)
 {
     int status = FWK_SUCCESS;
 
 #ifdef FWK_LOG_BUFFERED
+#    ifndef FWK_LOG_BINARY
     unsigned char fetched;
+#    endif
     char ch;
 
     fwk_interrupt_global_disable();
@@ -264,12 +940,7 @@ int fwk_log_unbuffer(void)
          * need to try and fetch the next one.
          */
 
-        bool empty = !fwk_ring_pop(
-            &fwk_log_ctx.ring,
-            (char *)&fwk_log_ctx.remaining,
-            sizeof(fwk_log_ctx.remaining));
-
-        if (empty) {
+        if (!fwk_log_fetch_message()) {
             /*
              * At this point we've cleared the buffer of any remaining messages.
              * If we were forced to drop any messages prior to this point, now
@@ -296,12 +967,19 @@ int fwk_log_unbuffer(void)
      * function will run the logic above to finalize the message.
      */
 
+#    ifdef FWK_LOG_BINARY
+    ch = fwk_log_ctx.line[fwk_log_ctx.position];
+#    else
     fetched = fwk_ring_pop(&fwk_log_ctx.ring, &ch, sizeof(ch));
     fwk_assert(fetched == sizeof(char));
+#    endif
 
     status = fwk_io_putch(fwk_log_stream, ch);
     if (status == FWK_SUCCESS) {
         fwk_log_ctx.remaining--;
+#    ifdef FWK_LOG_BINARY
+        fwk_log_ctx.position++;
+#    endif
 
         status = FWK_PENDING;
     }
@@ -313,6 +991,44 @@ exit:
     return status;
 }
 
+int fwk_log_unbuffer_chunk(void)
+{
+#ifdef FWK_LOG_BUFFERED
+    static char chunk[FMW_LOG_CHUNK_SIZE];
+
+    size_t size = 0;
+    unsigned char count;
+    int status;
+
+    fwk_interrupt_global_disable();
+
+    /* Fill the chunk with as many messages as it holds */
+    while (size < sizeof(chunk)) {
+        if ((fwk_log_ctx.remaining == 0) && !fwk_log_fetch_message())
+            break;
+
+        count = (unsigned char)FWK_MIN(
+            sizeof(chunk) - size, (size_t)fwk_log_ctx.remaining);
+        fwk_log_fetch_chars(&chunk[size], count);
+        size += count;
+    }
+
+    fwk_interrupt_global_enable();
+
+    /* Let the buffer report the messages dropped once it is empty */
+    if (size == 0)
+        return fwk_log_unbuffer();
+
+    status = fwk_io_write(fwk_log_stream, NULL, chunk, sizeof(char), size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return FWK_PENDING;
+#else
+    return FWK_SUCCESS;
+#endif
+}
+
 void fwk_log_flush(void)
 {
 #ifdef FWK_LOG_BUFFERED
@@ -326,4 +1042,65 @@ void fwk_log_flush(void)
 
     fwk_interrupt_global_enable();
 #endif
+
+    /* The backend may buffer characters too */
+    if (fwk_log_stream != NULL)
+        (void)fwk_io_flush(fwk_log_stream);
+}
+
+#if FMW_LOG_RATE_BURST > 0
+bool fwk_log_bucket_take(struct fwk_log_bucket *bucket)
+{
+    const fwk_duration_ns_t period = FWK_MS(FMW_LOG_RATE_PERIOD_MS);
+
+    fwk_timestamp_t now = fwk_time_current();
+    uint64_t regained;
+    bool taken;
+
+    fwk_interrupt_global_disable();
+
+    /* Regain the tokens accumulated since the last refill */
+    regained = (now - bucket->refill) / period;
+    if (regained >= bucket->spent) {
+        bucket->spent = 0;
+        bucket->refill = now;
+    } else {
+        bucket->spent -= (unsigned int)regained;
+        bucket->refill += regained * period;
+    }
+
+    taken = bucket->spent < FMW_LOG_RATE_BURST;
+    if (taken)
+        bucket->spent++;
+    else
+        fwk_log_ctx.dropped++;
+
+    fwk_interrupt_global_enable();
+
+    return taken;
+}
+#endif
+
+int fwk_log_set_level(fwk_id_t id, unsigned int level)
+{
+    unsigned int module_idx = fwk_id_get_module_idx(id);
+
+    if ((module_idx >= FWK_MODULE_IDX_COUNT) || (level > FWK_LOG_LEVEL_CRIT))
+        return FWK_E_PARAM;
+
+    fwk_log_level_table[module_idx] = (unsigned char)level;
+
+    return FWK_SUCCESS;
+}
+
+int fwk_log_get_level(fwk_id_t id, unsigned int *level)
+{
+    unsigned int module_idx = fwk_id_get_module_idx(id);
+
+    if ((module_idx >= FWK_MODULE_IDX_COUNT) || (level == NULL))
+        return FWK_E_PARAM;
+
+    *level = fwk_log_level_table[module_idx];
+
+    return FWK_SUCCESS;
 }
@@ -8,19 +8,188 @@
  *     Memory management.
  */
 
+#include <internal/fwk_mm.h>
+
+#include <fwk_arch.h>
 #include <fwk_assert.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
 
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if FWK_HAS_INCLUDE(<fmw_memory.h>)
+#    include <fmw_memory.h>
+#endif
+
+#ifdef FMW_MM_ARENA_SIZE
+#    define FWK_MM_ARENA_SIZE FMW_MM_ARENA_SIZE
+#else
+#    define FWK_MM_ARENA_SIZE 0
+#endif
+
+static struct {
+    /* Architecture memory driver, if the architecture provides one */
+    const struct fwk_arch_mm_driver *driver;
+
+    /*
+     * Index of the module allocations are currently attributed to, or
+     * FWK_MODULE_IDX_COUNT for allocations made by the framework.
+     */
+    unsigned int owner_idx;
+
+    /*
+     * Usage per module, the last entry covering allocations made by the
+     * framework itself.
+     */
+    struct fwk_mm_usage usage_table[FWK_MODULE_IDX_COUNT + 1];
+} mm_ctx = {
+    .owner_idx = FWK_MODULE_IDX_COUNT,
+};
+
+static void *mm_account(void *ptr, size_t num, size_t size)
+{
+    struct fwk_mm_usage *usage = &mm_ctx.usage_table[mm_ctx.owner_idx];
+
+    if (ptr != NULL) {
+        usage->size += num * size;
+        usage->count++;
+    }
+
+    return ptr;
+}
+
+#if FWK_MM_ARENA_SIZE > 0
+static struct {
+    /* Backing storage for all the pre-runtime allocations */
+    alignas(max_align_t) unsigned char memory[FWK_MM_ARENA_SIZE];
+
+    /* Offset of the first free byte in the arena */
+    size_t offset;
+
+    /* Flag indicating whether the arena no longer accepts allocations */
+    bool locked;
+
+    /* Number of allocations that fell back to the heap after locking */
+    unsigned int late_alloc_count;
+} arena_ctx;
+
+static bool arena_contains(const void *ptr)
+{
+    uintptr_t address = (uintptr_t)ptr;
+    uintptr_t base = (uintptr_t)arena_ctx.memory;
+
+    return (address >= base) && (address < (base + arena_ctx.offset));
+}
+
+/*
+ * Carve a block out of the arena. A null pointer is returned once the arena
+ * has been locked, in which case the caller falls back to the heap.
+ */
+static void *arena_alloc(size_t alignment, size_t num, size_t size)
+{
+    uintptr_t base = (uintptr_t)arena_ctx.memory;
+    size_t offset;
+
+    if (arena_ctx.locked) {
+        arena_ctx.late_alloc_count++;
+
+        return NULL;
+    }
+
+    if ((size != 0) && (num > (SIZE_MAX / size)))
+        fwk_trap();
+
+    if (alignment < alignof(max_align_t))
+        alignment = alignof(max_align_t);
+
+    offset = FWK_ALIGN_NEXT(base + arena_ctx.offset, alignment) - base;
+    if ((offset > FWK_MM_ARENA_SIZE) ||
+        ((num * size) > (FWK_MM_ARENA_SIZE - offset)))
+        fwk_trap();
+
+    arena_ctx.offset = offset + (num * size);
+
+    return &arena_ctx.memory[offset];
+}
+#endif
+
+/* Memory reclaimed from the init-only code and data */
+static struct {
+    /* Start of the memory, NULL until the start stage is complete */
+    unsigned char *base;
+
+    /* Size of the memory */
+    size_t size;
+
+    /* Offset of the first free byte in the memory */
+    size_t offset;
+} reclaim_ctx;
+
+static bool reclaim_contains(const void *ptr)
+{
+    uintptr_t address = (uintptr_t)ptr;
+    uintptr_t base = (uintptr_t)reclaim_ctx.base;
+
+    return (reclaim_ctx.base != NULL) && (address >= base) &&
+        (address < (base + reclaim_ctx.offset));
+}
+
+/*
+ * Carve a block out of the reclaimed memory. A null pointer is returned when
+ * it does not fit, in which case the caller falls back to the heap.
+ */
+static void *reclaim_alloc(size_t alignment, size_t num, size_t size)
+{
+    uintptr_t base = (uintptr_t)reclaim_ctx.base;
+    size_t offset;
+
+    if (reclaim_ctx.base == NULL)
+        return NULL;
+
+    if ((size != 0) && (num > (SIZE_MAX / size)))
+        return NULL;
+
+    if (alignment < alignof(max_align_t))
+        alignment = alignof(max_align_t);
+
+    offset = FWK_ALIGN_NEXT(base + reclaim_ctx.offset, alignment) - base;
+    if ((offset > reclaim_ctx.size) ||
+        ((num * size) > (reclaim_ctx.size - offset)))
+        return NULL;
+
+    reclaim_ctx.offset = offset + (num * size);
+
+    return &reclaim_ctx.base[offset];
+}
 
 void *fwk_mm_alloc(size_t num, size_t size)
 {
-    void *ptr = malloc(num * size);
+    void *ptr;
+
+#if FWK_MM_ARENA_SIZE > 0
+    ptr = arena_alloc(alignof(max_align_t), num, size);
+    if (ptr != NULL)
+        return mm_account(ptr, num, size);
+#endif
+
+    ptr = reclaim_alloc(alignof(max_align_t), num, size);
+    if (ptr != NULL)
+        return mm_account(ptr, num, size);
+
+    ptr = malloc(num * size);
 
     if (ptr == NULL)
         fwk_trap();
 
-    return ptr;
+    return mm_account(ptr, num, size);
 }
 
 void *fwk_mm_alloc_notrap(size_t num, size_t size)
@@ -30,21 +199,50 @@ void *fwk_mm_alloc_notrap(size_t num, size_t size)
 
 void *fwk_mm_alloc_aligned(size_t alignment, size_t num, size_t size)
 {
-    void *ptr = aligned_alloc(alignment, num * size);
+    void *ptr;
+
+#if FWK_MM_ARENA_SIZE > 0
+    ptr = arena_alloc(alignment, num, size);
+    if (ptr != NULL)
+        return mm_account(ptr, num, size);
+#endif
+
+    ptr = reclaim_alloc(alignment, num, size);
+    if (ptr != NULL)
+        return mm_account(ptr, num, size);
+
+    ptr = aligned_alloc(alignment, num * size);
 
     if (ptr == NULL)
         fwk_trap();
 
-    return ptr;
+    return mm_account(ptr, num, size);
 }
 
 void *fwk_mm_calloc(size_t num, size_t size)
 {
-    void *ptr = calloc(num, size);
+    void *ptr;
+
+#if FWK_MM_ARENA_SIZE > 0
+    /* The arena is zero-initialized and is never recycled */
+    ptr = arena_alloc(alignof(max_align_t), num, size);
+    if (ptr != NULL)
+        return mm_account(ptr, num, size);
+#endif
+
+    /* The reclaimed memory still holds the init-only code and data */
+    ptr = reclaim_alloc(alignof(max_align_t), num, size);
+    if (ptr != NULL) {
+        memset(ptr, 0, num * size);
+
+        return mm_account(ptr, num, size);
+    }
+
+    ptr = calloc(num, size);
     if (ptr == NULL)
         fwk_trap();
 
-    return ptr;
+    return mm_account(ptr, num, size);
 }
 
 void *fwk_mm_calloc_aligned(size_t alignment, size_t num, size_t size)
@@ -62,10 +260,141 @@ void *fwk_mm_calloc_aligned(size_t alignment, size_t num, size_t size)
 
 void *fwk_mm_realloc(void *ptr, size_t num, size_t size)
 {
-    return realloc(ptr, num * size);
+    const unsigned char *end = NULL;
+    void *new_ptr;
+
+#if FWK_MM_ARENA_SIZE > 0
+    if (arena_contains(ptr))
+        end = &arena_ctx.memory[arena_ctx.offset];
+#endif
+
+    if (reclaim_contains(ptr))
+        end = &reclaim_ctx.base[reclaim_ctx.offset];
+
+    if (end == NULL)
+        return realloc(ptr, num * size);
+
+    /*
+     * Arena and reclaimed blocks carry no header, so the size of the original
+     * block is unknown. Copy as much as the request asks for without reading
+     * past the end of the used part of the memory the block comes from.
+     */
+    new_ptr = malloc(num * size);
+    if (new_ptr == NULL)
+        return NULL;
+
+    memcpy(
+        new_ptr,
+        ptr,
+        FWK_MIN((size_t)(end - (const unsigned char *)ptr), num * size));
+
+    return new_ptr;
 }
 
 void fwk_mm_free(void *ptr)
 {
+#if FWK_MM_ARENA_SIZE > 0
+    /* Arena memory is never returned */
+    if (arena_contains(ptr))
+        return;
+#endif
+
+    /* Neither is the reclaimed memory */
+    if (reclaim_contains(ptr))
+        return;
+
     return free(ptr);
 }
+
+int __fwk_mm_init(const struct fwk_arch_mm_driver *driver)
+{
+    mm_ctx.driver = driver;
+
+    return FWK_SUCCESS;
+}
+
+void __fwk_mm_set_owner(fwk_id_t id)
+{
+    if (fwk_id_is_type(id, FWK_ID_TYPE_NONE))
+        mm_ctx.owner_idx = FWK_MODULE_IDX_COUNT;
+    else
+        mm_ctx.owner_idx = fwk_id_get_module_idx(id);
+}
+
+void __fwk_mm_lock(void)
+{
+#if FWK_MM_ARENA_SIZE > 0
+    arena_ctx.locked = true;
+#endif
+}
+
+size_t __fwk_mm_reclaim(void)
+{
+    const struct fwk_arch_mm_driver *driver = mm_ctx.driver;
+    void *base;
+    size_t size;
+
+    if ((driver == NULL) || (driver->get_reclaimable == NULL))
+        return 0;
+
+    if (driver->get_reclaimable(&base, &size) != FWK_SUCCESS)
+        return 0;
+
+    reclaim_ctx.base = base;
+    reclaim_ctx.size = size;
+    reclaim_ctx.offset = 0;
+
+    return size;
+}
+
+int fwk_mm_get_arena_info(struct fwk_mm_arena_info *info)
+{
+    if (!fwk_expect(info != NULL))
+        return FWK_E_PARAM;
+
+#if FWK_MM_ARENA_SIZE > 0
+    *info = (struct fwk_mm_arena_info){
+        .size = FWK_MM_ARENA_SIZE,
+        .used = arena_ctx.offset,
+        .locked = arena_ctx.locked,
+        .late_alloc_count = arena_ctx.late_alloc_count,
+    };
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
+int fwk_mm_get_usage(fwk_id_t id, struct fwk_mm_usage *usage)
+{
+    unsigned int idx;
+
+    if (!fwk_expect(usage != NULL))
+        return FWK_E_PARAM;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_NONE))
+        idx = FWK_MODULE_IDX_COUNT;
+    else if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE) &&
+             (fwk_id_get_module_idx(id) < FWK_MODULE_IDX_COUNT))
+        idx = fwk_id_get_module_idx(id);
+    else
+        return FWK_E_PARAM;
+
+    *usage = mm_ctx.usage_table[idx];
+
+    return FWK_SUCCESS;
+}
+
+int fwk_mm_get_stackheap_high_water(size_t *heap_size, size_t *stack_size)
+{
+    const struct fwk_arch_mm_driver *driver = mm_ctx.driver;
+
+    if (!fwk_expect((heap_size != NULL) && (stack_size != NULL)))
+        return FWK_E_PARAM;
+
+    if ((driver == NULL) || (driver->get_high_water == NULL))
+        return FWK_E_SUPPORT;
+
+    return driver->get_high_water(heap_size, stack_size);
+}
@@ -9,22 +9,38 @@
  */
 
 #include <internal/fwk_id.h>
+#include <internal/fwk_mm.h>
 #include <internal/fwk_module.h>
 #include <internal/fwk_thread.h>
 
 #include <fwk_assert.h>
+#include <fwk_attributes.h>
 #include <fwk_cli_dbg.h>
 #include <fwk_dlist.h>
 #include <fwk_list.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
-#if FMW_NOTIFICATION_MAX > 64
+#if FWK_HAS_INCLUDE(<fmw_thread.h>)
+#    include <fmw_thread.h>
+#endif
+
+/*
+ * The size of the event pool is given by the firmware when it knows its peak
+ * usage, see ::fwk_thread_queue_stats.
+ */
+#if defined(FMW_EVENT_POOL_SIZE)
+#    define FWK_MODULE_EVENT_COUNT FMW_EVENT_POOL_SIZE
+#elif FMW_NOTIFICATION_MAX > 64
 #    define FWK_MODULE_EVENT_COUNT FMW_NOTIFICATION_MAX
 #else
 #    define FWK_MODULE_EVENT_COUNT 64
@@ -32,6 +48,15 @@
 
 #define FWK_MODULE_BIND_ROUND_MAX 1
 
+static_assert(
+    (FWK_MODULE_BOOT_PHASE_BIND_ROUND_0 + FWK_MODULE_BIND_ROUND_MAX) ==
+        FWK_MODULE_BOOT_PHASE_BIND_ROUND_1,
+    "Every binding round must have a boot phase");
+
+/* The bind cache has 2^FWK_MODULE_BIND_CACHE_ORDER entries */
+#define FWK_MODULE_BIND_CACHE_ORDER 4
+#define FWK_MODULE_BIND_CACHE_SIZE (1U << FWK_MODULE_BIND_CACHE_ORDER)
+
 /* Pre-runtime phase stages */
 enum fwk_module_stage {
     MODULE_STAGE_INITIALIZE,
@@ -39,6 +64,40 @@ enum fwk_module_stage {
     MODULE_STAGE_START
 };
 
+/*
+ * Identifier limits of a module.
+ *
+ * These are copied out of the module descriptions and contexts so that the
+ * identifier validation functions only need a single table access.
+ */
+struct fwk_module_limits {
+    /* Number of elements */
+    unsigned int element_count;
+
+    /* Number of APIs */
+    unsigned int api_count;
+
+    /* Number of events */
+    unsigned int event_count;
+
+    /* Number of notifications */
+    unsigned int notification_count;
+};
+
+/*
+ * API returned for a bind request that does not depend on the requester.
+ */
+struct fwk_module_bind_cache_entry {
+    /* Identifier of the module, element or sub-element bound to */
+    fwk_id_t target_id;
+
+    /* Identifier of the API */
+    fwk_id_t api_id;
+
+    /* Implementation of the API, NULL when the entry is free */
+    const void *api;
+};
+
 static struct {
     /* Flag indicating whether all modules have been initialized */
     bool initialized;
@@ -46,6 +105,9 @@ static struct {
     /* Table of module contexts */
     struct fwk_module_ctx module_ctx_table[FWK_MODULE_IDX_COUNT];
 
+    /* Table of module identifier limits, indexed by module index */
+    struct fwk_module_limits limits_table[FWK_MODULE_IDX_COUNT];
+
     /* Pre-runtime phase stage */
     enum fwk_module_stage stage;
 
@@ -54,6 +116,23 @@ static struct {
      * elements as part as of the binding stage.
      */
     fwk_id_t bind_id;
+
+    /* Index of the first module that may still have a deferred start */
+    unsigned int deferred_idx;
+
+    /*
+     * Cache of the APIs returned for the bind requests that do not depend on
+     * the requester, indexed by a hash of the target and API identifiers.
+     */
+    struct fwk_module_bind_cache_entry bind_cache[FWK_MODULE_BIND_CACHE_SIZE];
+
+#ifdef FWK_BOOT_PROFILE
+    /*
+     * Table of module boot profiles. Indexed by module index until all the
+     * modules have started, then sorted by decreasing total.
+     */
+    struct fwk_module_boot_profile boot_profile[FWK_MODULE_IDX_COUNT];
+#endif
 } fwk_module_ctx;
 
 extern const struct fwk_module *module_table[FWK_MODULE_IDX_COUNT];
@@ -63,7 +142,112 @@ extern const struct fwk_module_config
 static const char fwk_module_err_msg_line[] = "[MOD] Error %d in %s @%d";
 static const char fwk_module_err_msg_func[] = "[MOD] Error %d in %s";
 
-static size_t fwk_module_count_elements(const struct fwk_element *elements)
+/*
+ * Get a timestamp marking the beginning of a boot phase.
+ */
+static fwk_timestamp_t fwk_module_profile_begin(void)
+{
+#ifdef FWK_BOOT_PROFILE
+    return fwk_time_current();
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Account the time elapsed since the beginning of a boot phase to a module.
+ */
+static void fwk_module_profile_end(
+    const struct fwk_module_ctx *ctx,
+    enum fwk_module_boot_phase phase,
+    fwk_timestamp_t start)
+{
+#ifdef FWK_BOOT_PROFILE
+    struct fwk_module_boot_profile *profile;
+    fwk_timestamp_t end = fwk_time_current();
+
+    if (end <= start)
+        return;
+
+    profile = &fwk_module_ctx.boot_profile[ctx->id.common.module_idx];
+    profile->phases[phase] += end - start;
+    profile->total += end - start;
+#endif
+}
+
+/*
+ * Account a bind request to the module it targets.
+ */
+static void fwk_module_profile_bind_request(
+    const struct fwk_module_ctx *ctx,
+    bool cached,
+    fwk_timestamp_t start)
+{
+#ifdef FWK_BOOT_PROFILE
+    struct fwk_module_boot_profile *profile;
+    fwk_timestamp_t end = fwk_time_current();
+
+    profile = &fwk_module_ctx.boot_profile[ctx->id.common.module_idx];
+    profile->bind_request_count++;
+    if (cached)
+        profile->bind_cache_hit_count++;
+
+    if (end > start)
+        profile->bind_requests += end - start;
+#endif
+}
+
+#ifdef FWK_BOOT_PROFILE
+/*
+ * Sort the boot profiles by decreasing total, and log them.
+ */
+static void fwk_module_profile_complete(void)
+{
+    struct fwk_module_boot_profile *table = fwk_module_ctx.boot_profile;
+    struct fwk_module_boot_profile profile;
+    const struct fwk_module_boot_profile *entry;
+    size_t i, j;
+
+    for (i = 1; i < FWK_MODULE_IDX_COUNT; i++) {
+        profile = table[i];
+
+        for (j = i; (j > 0) && (table[j - 1].total < profile.total); j--)
+            table[j] = table[j - 1];
+
+        table[j] = profile;
+    }
+
+    for (i = 0; i < FWK_MODULE_IDX_COUNT; i++) {
+        entry = &table[i];
+
+        FWK_LOG_INFO(
+            "[FWK] Boot %s: %u us (init %u, bind %u, start %u)",
+            fwk_module_get_name(entry->module_id),
+            (unsigned int)fwk_time_duration_us(entry->total),
+            (unsigned int)fwk_time_duration_us(
+                entry->phases[FWK_MODULE_BOOT_PHASE_INIT] +
+                entry->phases[FWK_MODULE_BOOT_PHASE_ELEMENT_INIT] +
+                entry->phases[FWK_MODULE_BOOT_PHASE_POST_INIT]),
+            (unsigned int)fwk_time_duration_us(
+                entry->phases[FWK_MODULE_BOOT_PHASE_BIND_ROUND_0] +
+                entry->phases[FWK_MODULE_BOOT_PHASE_BIND_ROUND_1]),
+            (unsigned int)fwk_time_duration_us(
+                entry->phases[FWK_MODULE_BOOT_PHASE_START]));
+
+        if (entry->bind_request_count != 0) {
+            FWK_LOG_INFO(
+                "[FWK] Bind %s: %u requests (%u cached), %u us",
+                fwk_module_get_name(entry->module_id),
+                entry->bind_request_count,
+                entry->bind_cache_hit_count,
+                (unsigned int)fwk_time_duration_us(entry->bind_requests));
+        }
+    }
+}
+#endif
+
+static FWK_INIT size_t fwk_module_count_elements(
+    const struct fwk_element *elements)
 {
     size_t count = 0;
 
@@ -74,21 +258,59 @@ static size_t fwk_module_count_elements(const struct fwk_element *elements)
 }
 
 #ifdef BUILD_HAS_NOTIFICATION
-static void fwk_module_init_subscriptions(struct fwk_dlist **list, size_t count)
+static FWK_INIT void fwk_module_init_subscriptions(
+    struct fwk_dlist **list,
+    struct __fwk_notification_subscribers **subscribers,
+    size_t count)
 {
     *list = fwk_mm_calloc(count, sizeof((*list)[0]));
     if (!fwk_expect(*list != NULL))
         fwk_trap();
 
+    *subscribers = fwk_mm_calloc(count, sizeof((*subscribers)[0]));
+    if (!fwk_expect(*subscribers != NULL))
+        fwk_trap();
+
     for (size_t i = 0; i < count; i++)
         fwk_list_init(&((*list)[i]));
 }
 #endif
 
-static void fwk_module_init_element_ctx(
+#ifdef FWK_EVENT_LATENCY
+static FWK_INIT void fwk_module_init_latency(struct fwk_module_ctx *ctx)
+{
+    size_t count = ctx->desc->event_count;
+
+#    ifdef BUILD_HAS_NOTIFICATION
+    count += ctx->desc->notification_count;
+#    endif
+
+    if (count == 0)
+        return;
+
+    ctx->latency_table = fwk_mm_calloc(count, sizeof(ctx->latency_table[0]));
+    if (!fwk_expect(ctx->latency_table != NULL))
+        fwk_trap();
+}
+#endif
+
+static FWK_INIT void fwk_module_init_limits(
+    struct fwk_module_limits *limits,
+    const struct fwk_module_ctx *ctx)
+{
+    *limits = (struct fwk_module_limits){
+        .element_count = ctx->element_count,
+        .api_count = ctx->desc->api_count,
+        .event_count = ctx->desc->event_count,
+#ifdef BUILD_HAS_NOTIFICATION
+        .notification_count = ctx->desc->notification_count,
+#endif
+    };
+}
+
+static FWK_INIT void fwk_module_init_element_ctx(
     struct fwk_element_ctx *ctx,
-    const struct fwk_element *element,
-    size_t notification_count)
+    const struct fwk_element *element)
 {
     *ctx = (struct fwk_element_ctx){
         .state = FWK_MODULE_STATE_UNINITIALIZED,
@@ -98,35 +320,64 @@ static void fwk_module_init_element_ctx(
     };
 
     fwk_list_init(&ctx->delayed_response_list);
-
-#ifdef BUILD_HAS_NOTIFICATION
-    if (notification_count > 0) {
-        fwk_module_init_subscriptions(
-            &ctx->subscription_dlist_table, notification_count);
-    }
-#endif
 }
 
-static void fwk_module_init_element_ctxs(
+static FWK_INIT void fwk_module_init_element_ctxs(
     struct fwk_module_ctx *ctx,
     const struct fwk_element *elements,
+    size_t element_count,
     size_t notification_count)
 {
-    ctx->element_count = fwk_module_count_elements(elements);
+#ifdef BUILD_HAS_NOTIFICATION
+    struct fwk_dlist *subscription_dlist_table = NULL;
+    struct __fwk_notification_subscribers *subscribers_table = NULL;
+#endif
+
+    if (element_count == 0)
+        element_count = fwk_module_count_elements(elements);
+    else
+        fwk_assert(elements[element_count].name == NULL);
+
+    ctx->element_count = element_count;
 
     ctx->element_ctx_table =
         fwk_mm_calloc(ctx->element_count, sizeof(ctx->element_ctx_table[0]));
     if (!fwk_expect(ctx->element_ctx_table != NULL))
         fwk_trap();
 
+#ifdef BUILD_HAS_NOTIFICATION
+    /* The subscription tables of all the elements share one allocation */
+    if ((notification_count > 0) && (element_count > 0)) {
+        fwk_module_init_subscriptions(
+            &subscription_dlist_table,
+            &subscribers_table,
+            element_count * notification_count);
+    }
+#endif
+
     for (size_t i = 0; i < ctx->element_count; i++) {
-        fwk_module_init_element_ctx(
-            &ctx->element_ctx_table[i], &elements[i], notification_count);
+        struct fwk_element_ctx *element_ctx = &ctx->element_ctx_table[i];
+
+        fwk_module_init_element_ctx(element_ctx, &elements[i]);
+
+#ifdef BUILD_HAS_NOTIFICATION
+        if (subscription_dlist_table != NULL) {
+            element_ctx->subscription_dlist_table =
+                &subscription_dlist_table[i * notification_count];
+            element_ctx->subscribers_table =
+                &subscribers_table[i * notification_count];
+        }
+#endif
     }
 }
 
-void fwk_module_init(void)
+FWK_INIT void fwk_module_init(void)
 {
+    fwk_module_ctx.deferred_idx = 0;
+
+    for (unsigned int i = 0; i < FWK_MODULE_BIND_CACHE_SIZE; i++)
+        fwk_module_ctx.bind_cache[i].api = NULL;
+
     for (enum fwk_module_idx i = 0; i < FWK_MODULE_IDX_COUNT; i++) {
         struct fwk_module_ctx *ctx = &fwk_module_ctx.module_ctx_table[i];
 
@@ -155,21 +406,38 @@ void fwk_module_init(void)
 #endif
 
             fwk_module_init_element_ctxs(
-                ctx, config->elements.table, notification_count);
+                ctx,
+                config->elements.table,
+                config->elements.count,
+                notification_count);
         }
 
 #ifdef BUILD_HAS_NOTIFICATION
         if (desc->notification_count > 0) {
             fwk_module_init_subscriptions(
-                &ctx->subscription_dlist_table, desc->notification_count);
+                &ctx->subscription_dlist_table,
+                &ctx->subscribers_table,
+                desc->notification_count);
         }
 #endif
+
+#ifdef FWK_EVENT_LATENCY
+        fwk_module_init_latency(ctx);
+#endif
+
+        fwk_module_init_limits(&fwk_module_ctx.limits_table[i], ctx);
+
+#ifdef FWK_BOOT_PROFILE
+        fwk_module_ctx.boot_profile[i] =
+            (struct fwk_module_boot_profile){ .module_id = id };
+#endif
     }
 }
 
-static void fwk_module_init_elements(struct fwk_module_ctx *ctx)
+static FWK_INIT void fwk_module_init_elements(struct fwk_module_ctx *ctx)
 {
     int status;
+    fwk_timestamp_t start;
 
     const struct fwk_module *desc = ctx->desc;
 
@@ -187,8 +455,10 @@ static void fwk_module_init_elements(struct fwk_module_ctx *ctx)
         if (!fwk_expect(element->data != NULL))
             fwk_trap();
 
+        start = fwk_module_profile_begin();
         status = desc->element_init(
             element_id, element->sub_element_count, element->data);
+        fwk_module_profile_end(ctx, FWK_MODULE_BOOT_PHASE_ELEMENT_INIT, start);
         if (!fwk_expect(status == FWK_SUCCESS))
             fwk_trap();
 
@@ -196,9 +466,10 @@ static void fwk_module_init_elements(struct fwk_module_ctx *ctx)
     }
 }
 
-static void fwk_module_init_module(struct fwk_module_ctx *ctx)
+static FWK_INIT void fwk_module_init_module(struct fwk_module_ctx *ctx)
 {
     int status;
+    fwk_timestamp_t start;
 
     const struct fwk_module *desc = ctx->desc;
     const struct fwk_module_config *config = ctx->config;
@@ -216,6 +487,8 @@ static void fwk_module_init_module(struct fwk_module_ctx *ctx)
             (desc->api_count == 0) == (desc->process_bind_request == NULL)))
         fwk_trap();
 
+    start = fwk_module_profile_begin();
+
     if (config->elements.type == FWK_MODULE_ELEMENTS_TYPE_DYNAMIC) {
         size_t notification_count = 0;
 
@@ -232,10 +505,14 @@ static void fwk_module_init_module(struct fwk_module_ctx *ctx)
         notification_count = desc->notification_count;
 #endif
 
-        fwk_module_init_element_ctxs(ctx, elements, notification_count);
+        fwk_module_init_element_ctxs(ctx, elements, 0, notification_count);
+
+        fwk_module_init_limits(
+            &fwk_module_ctx.limits_table[ctx->id.common.module_idx], ctx);
     }
 
     status = desc->init(ctx->id, ctx->element_count, config->data);
+    fwk_module_profile_end(ctx, FWK_MODULE_BOOT_PHASE_INIT, start);
     if (!fwk_expect(status == FWK_SUCCESS))
         fwk_trap();
 
@@ -243,7 +520,9 @@ static void fwk_module_init_module(struct fwk_module_ctx *ctx)
         fwk_module_init_elements(ctx);
 
     if (desc->post_init != NULL) {
+        start = fwk_module_profile_begin();
         status = desc->post_init(ctx->id);
+        fwk_module_profile_end(ctx, FWK_MODULE_BOOT_PHASE_POST_INIT, start);
         if (!fwk_expect(status == FWK_SUCCESS))
             fwk_trap();
     }
@@ -251,13 +530,17 @@ static void fwk_module_init_module(struct fwk_module_ctx *ctx)
     ctx->state = FWK_MODULE_STATE_INITIALIZED;
 }
 
-static void fwk_module_init_modules(void)
+static FWK_INIT void fwk_module_init_modules(void)
 {
-    for (enum fwk_module_idx i = 0; i < FWK_MODULE_IDX_COUNT; i++)
+    for (enum fwk_module_idx i = 0; i < FWK_MODULE_IDX_COUNT; i++) {
+        __fwk_mm_set_owner(FWK_ID_MODULE(i));
         fwk_module_init_module(&fwk_module_ctx.module_ctx_table[i]);
+    }
+
+    __fwk_mm_set_owner(FWK_ID_NONE);
 }
 
-static int fwk_module_bind_elements(
+static FWK_INIT int fwk_module_bind_elements(
     struct fwk_module_ctx *module_ctx,
     unsigned int round)
 {
@@ -286,7 +569,7 @@ static int fwk_module_bind_elements(
     return FWK_SUCCESS;
 }
 
-static int fwk_module_bind_module(
+static FWK_INIT int fwk_module_bind_module(
     struct fwk_module_ctx *module_ctx,
     unsigned int round)
 {
@@ -312,15 +595,21 @@ static int fwk_module_bind_module(
     return fwk_module_bind_elements(module_ctx, round);
 }
 
-static int fwk_module_bind_modules(unsigned int round)
+static FWK_INIT int fwk_module_bind_modules(unsigned int round)
 {
     int status;
+    fwk_timestamp_t start;
     unsigned int module_idx;
     struct fwk_module_ctx *module_ctx;
 
     for (module_idx = 0; module_idx < FWK_MODULE_IDX_COUNT; module_idx++) {
         module_ctx = &fwk_module_ctx.module_ctx_table[module_idx];
+        __fwk_mm_set_owner(module_ctx->id);
+        start = fwk_module_profile_begin();
         status = fwk_module_bind_module(module_ctx, round);
+        fwk_module_profile_end(
+            module_ctx, FWK_MODULE_BOOT_PHASE_BIND_ROUND_0 + round, start);
+        __fwk_mm_set_owner(FWK_ID_NONE);
         if (status != FWK_SUCCESS)
             return status;
     }
@@ -374,15 +663,32 @@ static int fwk_module_start_module(struct fwk_module_ctx *module_ctx)
     return fwk_module_start_elements(module_ctx);
 }
 
+static bool fwk_module_is_deferred(const struct fwk_module_ctx *module_ctx)
+{
+#ifdef BUILD_HAS_MULTITHREADING
+    return false;
+#else
+    return module_ctx->config->deferred_start;
+#endif
+}
+
 static int start_modules(void)
 {
     int status;
+    fwk_timestamp_t start;
     unsigned int module_idx;
     struct fwk_module_ctx *module_ctx;
 
     for (module_idx = 0; module_idx < FWK_MODULE_IDX_COUNT; module_idx++) {
         module_ctx = &fwk_module_ctx.module_ctx_table[module_idx];
+        if (fwk_module_is_deferred(module_ctx))
+            continue;
+
+        __fwk_mm_set_owner(module_ctx->id);
+        start = fwk_module_profile_begin();
         status = fwk_module_start_module(module_ctx);
+        fwk_module_profile_end(module_ctx, FWK_MODULE_BOOT_PHASE_START, start);
+        __fwk_mm_set_owner(FWK_ID_NONE);
         if (status != FWK_SUCCESS)
             return status;
     }
@@ -390,10 +696,48 @@ static int start_modules(void)
     return FWK_SUCCESS;
 }
 
+static void fwk_module_log_mm_usage(void)
+{
+    struct fwk_mm_usage usage;
+    size_t heap_size, stack_size;
+    unsigned int module_idx;
+
+    for (module_idx = 0; module_idx < FWK_MODULE_IDX_COUNT; module_idx++) {
+        if (fwk_mm_get_usage(FWK_ID_MODULE(module_idx), &usage) !=
+            FWK_SUCCESS)
+            continue;
+
+        if (usage.count == 0)
+            continue;
+
+        FWK_LOG_INFO(
+            "[MM] %s: %u bytes in %u allocations",
+            fwk_module_ctx.module_ctx_table[module_idx].desc->name,
+            (unsigned int)usage.size,
+            usage.count);
+    }
+
+    if (fwk_mm_get_usage(FWK_ID_NONE, &usage) == FWK_SUCCESS) {
+        FWK_LOG_INFO(
+            "[MM] framework: %u bytes in %u allocations",
+            (unsigned int)usage.size,
+            usage.count);
+    }
+
+    if (fwk_mm_get_stackheap_high_water(&heap_size, &stack_size) ==
+        FWK_SUCCESS) {
+        FWK_LOG_INFO(
+            "[MM] High-water marks: heap %u bytes, stack %u bytes",
+            (unsigned int)heap_size,
+            (unsigned int)stack_size);
+    }
+}
+
 int fwk_module_start(void)
 {
     int status;
     unsigned int bind_round;
+    size_t reclaimed_size;
 
     if (fwk_module_ctx.initialized) {
         FWK_LOG_CRIT(fwk_module_err_msg_func, FWK_E_STATE, __func__);
@@ -424,6 +768,26 @@ int fwk_module_start(void)
 
     fwk_module_ctx.initialized = true;
 
+#ifdef BUILD_HAS_NOTIFICATION
+    __fwk_notification_start();
+#endif
+
+    __fwk_mm_lock();
+
+    fwk_module_log_mm_usage();
+
+    /* The init-only code has run for the last time */
+    reclaimed_size = __fwk_mm_reclaim();
+    if (reclaimed_size != 0) {
+        FWK_LOG_INFO(
+            "[MM] Reclaimed %u bytes of init-only memory",
+            (unsigned int)reclaimed_size);
+    }
+
+#ifdef FWK_BOOT_PROFILE
+    fwk_module_profile_complete();
+#endif
+
     FWK_LOG_CRIT("[FWK] Module initialization complete!");
 
     __fwk_thread_run();
@@ -431,14 +795,57 @@ int fwk_module_start(void)
     return FWK_SUCCESS;
 }
 
+/*
+ * Start the next deferred module whose index is below a limit. Returns whether
+ * a module was started.
+ */
+static bool start_next_deferred(unsigned int limit)
+{
+    struct fwk_module_ctx *module_ctx;
+
+    for (; fwk_module_ctx.deferred_idx < limit;
+         fwk_module_ctx.deferred_idx++) {
+        module_ctx =
+            &fwk_module_ctx.module_ctx_table[fwk_module_ctx.deferred_idx];
+        if (!fwk_module_is_deferred(module_ctx) ||
+            (module_ctx->state != FWK_MODULE_STATE_BOUND))
+            continue;
+
+        fwk_module_ctx.deferred_idx++;
+
+        /* A failure is logged and the module is left in the bound state */
+        __fwk_mm_set_owner(module_ctx->id);
+        (void)fwk_module_start_module(module_ctx);
+        __fwk_mm_set_owner(FWK_ID_NONE);
+
+        return true;
+    }
+
+    return false;
+}
+
+bool __fwk_module_start_next_deferred(void)
+{
+    return start_next_deferred(FWK_MODULE_IDX_COUNT);
+}
+
+void __fwk_module_start_deferred(fwk_id_t id)
+{
+    unsigned int limit = fwk_id_get_module_idx(id) + 1;
+
+    while (start_next_deferred(limit))
+        continue;
+}
+
 struct fwk_module_ctx *fwk_module_get_ctx(fwk_id_t id)
 {
-    return &fwk_module_ctx.module_ctx_table[fwk_id_get_module_idx(id)];
+    return &fwk_module_ctx.module_ctx_table[id.common.module_idx];
 }
 
 struct fwk_element_ctx *fwk_module_get_element_ctx(fwk_id_t element_id)
 {
-    struct fwk_module_ctx *module_ctx = fwk_module_get_ctx(element_id);
+    struct fwk_module_ctx *module_ctx =
+        &fwk_module_ctx.module_ctx_table[element_id.element.module_idx];
 
     return &module_ctx->element_ctx_table[element_id.element.element_idx];
 }
@@ -466,65 +873,65 @@ void fwk_module_reset(void)
     fwk_module_init();
 }
 
-bool fwk_module_is_valid_module_id(fwk_id_t id)
+/*
+ * Get the identifier limits of the module an identifier of a given type
+ * belongs to, or NULL if the identifier is not of this type or does not refer
+ * to an existing module.
+ */
+static const struct fwk_module_limits *fwk_module_get_limits(
+    fwk_id_t id,
+    enum fwk_id_type type)
 {
-    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
-        return false;
+    if ((id.common.type != (uint32_t)type) ||
+        (id.common.module_idx >= FWK_MODULE_IDX_COUNT))
+        return NULL;
 
-    if (fwk_id_get_module_idx(id) >= FWK_MODULE_IDX_COUNT)
-        return false;
+    return &fwk_module_ctx.limits_table[id.common.module_idx];
+}
 
-    return true;
+bool fwk_module_is_valid_module_id(fwk_id_t id)
+{
+    return fwk_module_get_limits(id, FWK_ID_TYPE_MODULE) != NULL;
 }
 
 bool fwk_module_is_valid_element_id(fwk_id_t id)
 {
-    unsigned int module_idx;
+    const struct fwk_module_limits *limits;
 
-    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+    limits = fwk_module_get_limits(id, FWK_ID_TYPE_ELEMENT);
+    if (limits == NULL)
         return false;
 
-    module_idx = fwk_id_get_module_idx(id);
-    if (module_idx >= FWK_MODULE_IDX_COUNT)
-        return false;
-
-    return (
-        fwk_id_get_element_idx(id) <
-        fwk_module_ctx.module_ctx_table[module_idx].element_count);
+    return id.element.element_idx < limits->element_count;
 }
 
 bool fwk_module_is_valid_sub_element_id(fwk_id_t id)
 {
-    unsigned int module_idx;
-    struct fwk_module_ctx *module_ctx;
-    unsigned int element_idx;
+    const struct fwk_module_limits *limits;
+    const struct fwk_element_ctx *element_ctx;
 
-    if (!fwk_id_is_type(id, FWK_ID_TYPE_SUB_ELEMENT))
+    limits = fwk_module_get_limits(id, FWK_ID_TYPE_SUB_ELEMENT);
+    if (limits == NULL)
         return false;
 
-    module_idx = fwk_id_get_module_idx(id);
-    if (module_idx >= FWK_MODULE_IDX_COUNT)
+    if (id.sub_element.element_idx >= limits->element_count)
         return false;
-    module_ctx = &fwk_module_ctx.module_ctx_table[module_idx];
 
-    element_idx = fwk_id_get_element_idx(id);
-    if (element_idx >= module_ctx->element_count)
-        return false;
+    element_ctx = fwk_module_get_element_ctx(id);
 
-    return (fwk_id_get_sub_element_idx(id) <
-            module_ctx->element_ctx_table[element_idx].sub_element_count);
+    return id.sub_element.sub_element_idx < element_ctx->sub_element_count;
 }
 
 bool fwk_module_is_valid_entity_id(fwk_id_t id)
 {
-    switch (fwk_id_get_type(id)) {
-    case FWK_ID_TYPE_MODULE:
+    switch (id.common.type) {
+    case __FWK_ID_TYPE_MODULE:
         return fwk_module_is_valid_module_id(id);
 
-    case FWK_ID_TYPE_ELEMENT:
+    case __FWK_ID_TYPE_ELEMENT:
         return fwk_module_is_valid_element_id(id);
 
-    case FWK_ID_TYPE_SUB_ELEMENT:
+    case __FWK_ID_TYPE_SUB_ELEMENT:
         return fwk_module_is_valid_sub_element_id(id);
 
     default:
@@ -536,51 +943,36 @@ bool fwk_module_is_valid_entity_id(fwk_id_t id)
 
 bool fwk_module_is_valid_api_id(fwk_id_t id)
 {
-    unsigned int module_idx;
+    const struct fwk_module_limits *limits;
 
-    if (!fwk_id_is_type(id, FWK_ID_TYPE_API))
+    limits = fwk_module_get_limits(id, FWK_ID_TYPE_API);
+    if (limits == NULL)
         return false;
 
-    module_idx = fwk_id_get_module_idx(id);
-    if (module_idx >= FWK_MODULE_IDX_COUNT)
-        return false;
-
-    return (
-        fwk_id_get_api_idx(id) <
-        fwk_module_ctx.module_ctx_table[module_idx].desc->api_count);
+    return id.api.api_idx < limits->api_count;
 }
 
 bool fwk_module_is_valid_event_id(fwk_id_t id)
 {
-    unsigned int module_idx;
+    const struct fwk_module_limits *limits;
 
-    if (!fwk_id_is_type(id, FWK_ID_TYPE_EVENT))
+    limits = fwk_module_get_limits(id, FWK_ID_TYPE_EVENT);
+    if (limits == NULL)
         return false;
 
-    module_idx = fwk_id_get_module_idx(id);
-    if (module_idx >= FWK_MODULE_IDX_COUNT)
-        return false;
-
-    return (
-        fwk_id_get_event_idx(id) <
-        fwk_module_ctx.module_ctx_table[module_idx].desc->event_count);
+    return id.event.event_idx < limits->event_count;
 }
 
 bool fwk_module_is_valid_notification_id(fwk_id_t id)
 {
 #ifdef BUILD_HAS_NOTIFICATION
-    unsigned int module_idx;
+    const struct fwk_module_limits *limits;
 
-    if (!fwk_id_is_type(id, FWK_ID_TYPE_NOTIFICATION))
+    limits = fwk_module_get_limits(id, FWK_ID_TYPE_NOTIFICATION);
+    if (limits == NULL)
         return false;
 
-    module_idx = fwk_id_get_module_idx(id);
-    if (module_idx >= FWK_MODULE_IDX_COUNT)
-        return false;
-
-    return (
-        fwk_id_get_notification_idx(id) <
-        fwk_module_ctx.module_ctx_table[module_idx].desc->notification_count);
+    return id.notification.notification_idx < limits->notification_count;
 #else
     return false;
 #endif
@@ -623,10 +1015,34 @@ const void *fwk_module_get_data(fwk_id_t id)
     return NULL;
 }
 
+/*
+ * Get the bind cache entry of a target and API, or NULL if the API returned to
+ * a requester depends on the requester.
+ */
+static struct fwk_module_bind_cache_entry *fwk_module_bind_cache_get(
+    const struct fwk_module_ctx *module_ctx,
+    fwk_id_t target_id,
+    fwk_id_t api_id)
+{
+    unsigned int api_idx = fwk_id_get_api_idx(api_id);
+    uint32_t key;
+
+    if ((module_ctx->desc->bind_shared_api_mask & (1U << api_idx)) == 0)
+        return NULL;
+
+    /* Fibonacci hashing of the target identifier salted with the API index */
+    key = target_id.value ^ ((uint32_t)api_idx << 28);
+    key = (key * UINT32_C(2654435769)) >> (32 - FWK_MODULE_BIND_CACHE_ORDER);
+
+    return &fwk_module_ctx.bind_cache[key];
+}
+
 int fwk_module_bind(fwk_id_t target_id, fwk_id_t api_id, const void *api)
 {
     int status = FWK_E_PARAM;
     struct fwk_module_ctx *module_ctx;
+    struct fwk_module_bind_cache_entry *entry;
+    fwk_timestamp_t start;
 
     if (!fwk_module_is_valid_entity_id(target_id))
         goto error;
@@ -650,8 +1066,21 @@ int fwk_module_bind(fwk_id_t target_id, fwk_id_t api_id, const void *api)
         goto error;
     }
 
+    start = fwk_module_profile_begin();
+
+    entry = fwk_module_bind_cache_get(module_ctx, target_id, api_id);
+    if ((entry != NULL) && (entry->api != NULL) &&
+        fwk_id_is_equal(entry->target_id, target_id) &&
+        fwk_id_is_equal(entry->api_id, api_id)) {
+        *(const void **)api = entry->api;
+        fwk_module_profile_bind_request(module_ctx, true, start);
+
+        return FWK_SUCCESS;
+    }
+
     status = module_ctx->desc->process_bind_request(
         fwk_module_ctx.bind_id, target_id, api_id, (const void **)api);
+    fwk_module_profile_bind_request(module_ctx, false, start);
     if (!fwk_expect(status == FWK_SUCCESS)) {
         FWK_LOG_CRIT(fwk_module_err_msg_line, status, __func__, __LINE__);
         return status;
@@ -662,6 +1091,14 @@ int fwk_module_bind(fwk_id_t target_id, fwk_id_t api_id, const void *api)
         goto error;
     }
 
+    if (entry != NULL) {
+        *entry = (struct fwk_module_bind_cache_entry){
+            .target_id = target_id,
+            .api_id = api_id,
+            .api = *(const void **)api,
+        };
+    }
+
     return FWK_SUCCESS;
 
 error:
@@ -670,6 +1107,26 @@ error:
     return status;
 }
 
+int fwk_module_get_boot_profile(
+    const struct fwk_module_boot_profile **table,
+    size_t *count)
+{
+#ifdef FWK_BOOT_PROFILE
+    if ((table == NULL) || (count == NULL))
+        return FWK_E_PARAM;
+
+    if (!fwk_module_ctx.initialized)
+        return FWK_E_STATE;
+
+    *table = fwk_module_ctx.boot_profile;
+    *count = FWK_MODULE_IDX_COUNT;
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
 int fwk_module_adapter(const struct fwk_io_adapter **adapter, fwk_id_t id)
 {
     unsigned int idx;
@@ -8,8 +8,10 @@
 #include <cmsis_os2.h>
 
 #include <internal/fwk_id.h>
+#include <internal/fwk_latency.h>
 #include <internal/fwk_module.h>
 #include <internal/fwk_multi_thread.h>
+#include <internal/fwk_notification.h>
 #include <internal/fwk_signal.h>
 #include <internal/fwk_thread.h>
 #include <internal/fwk_thread_delayed_resp.h>
@@ -23,11 +25,13 @@
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 #include <fwk_multi_thread.h>
 #include <fwk_noreturn.h>
 #include <fwk_slist.h>
 #include <fwk_status.h>
 #include <fwk_thread.h>
+#include <fwk_time.h>
 
 #include <inttypes.h>
 #include <stdbool.h>
@@ -48,6 +52,7 @@
 #define SIGNAL_NO_READY_THREAD 0x08
 #define SIGNAL_CHECK_LOGS 0x10
 #define SIGNAL_CHECK_FWK_SIGNALS 0x20
+#define SIGNAL_LOG_METRICS 0x40
 
 static struct __fwk_multi_thread_ctx ctx;
 static const char err_msg_line[] = "[FWK] Error %d @%d";
@@ -66,6 +71,8 @@ static const char err_msg_func[] = "[FWK] Error %d in %s";
  */
 static void free_event(struct fwk_event *event)
 {
+    fwk_event_payload_release(event->payload);
+
     fwk_interrupt_global_disable();
     fwk_list_push_tail(&ctx.event_free_queue, &event->slist_node);
     fwk_interrupt_global_enable();
@@ -97,6 +104,8 @@ static struct fwk_event *duplicate_event(struct fwk_event *event)
 
         allocated_event->slist_node = (struct fwk_slist_node) { 0 };
 
+        fwk_event_payload_acquire(allocated_event->payload);
+
         return allocated_event;
     }
 
@@ -134,6 +143,277 @@ static struct __fwk_thread_ctx *thread_get_ctx(fwk_id_t id)
     return NULL;
 }
 
+/*
+ * Initialize the priority inheritance and metrics of a thread.
+ *
+ * \param thread_ctx Pointer to the thread context. Its OS thread must have been
+ *      created.
+ */
+static void thread_init_ctx(struct __fwk_thread_ctx *thread_ctx)
+{
+    thread_ctx->base_priority = osThreadGetPriority(thread_ctx->os_thread_id);
+    thread_ctx->priority = thread_ctx->base_priority;
+    thread_ctx->waited_thread_ctx = NULL;
+    fwk_list_init(&thread_ctx->waiter_list);
+}
+
+/*
+ * Update the priority of a thread from the priorities of the threads waiting
+ * for it, and propagate the change to the thread it is itself waiting for.
+ *
+ * \param thread_ctx Pointer to the thread context.
+ */
+static void thread_update_priority(struct __fwk_thread_ctx *thread_ctx)
+{
+    osPriority_t priority;
+    struct fwk_slist_node *node;
+    struct __fwk_thread_ctx *waiter_ctx;
+
+    while (thread_ctx != NULL) {
+        priority = thread_ctx->base_priority;
+
+        FWK_LIST_FOR_EACH(
+            &thread_ctx->waiter_list,
+            node,
+            struct __fwk_thread_ctx,
+            waiter_node,
+            waiter_ctx)
+        {
+            if (waiter_ctx->priority > priority)
+                priority = waiter_ctx->priority;
+        }
+
+        if (priority == thread_ctx->priority)
+            return;
+
+        if (osThreadSetPriority(thread_ctx->os_thread_id, priority) != osOK) {
+            FWK_LOG_CRIT(err_msg_line, FWK_E_OS, __LINE__);
+            return;
+        }
+
+        thread_ctx->priority = priority;
+        thread_ctx = thread_ctx->waited_thread_ctx;
+    }
+}
+
+/*
+ * Put an event in a thread queue of events.
+ *
+ * \param thread_ctx Pointer to the thread context.
+ * \param event Pointer to the event.
+ * \param head Whether to put the event at the head of the queue.
+ */
+static void thread_push_event(
+    struct __fwk_thread_ctx *thread_ctx,
+    struct fwk_event *event,
+    bool head)
+{
+    if (head)
+        fwk_list_push_head(&thread_ctx->event_queue, &event->slist_node);
+    else
+        fwk_list_push_tail(&thread_ctx->event_queue, &event->slist_node);
+
+    thread_ctx->queue_depth++;
+    if (thread_ctx->queue_depth > thread_ctx->peak_queue_depth)
+        thread_ctx->peak_queue_depth = thread_ctx->queue_depth;
+}
+
+/*
+ * Pop the event at the head of a thread queue of events.
+ *
+ * \param thread_ctx Pointer to the thread context.
+ *
+ * \return Pointer to the event, NULL if the queue is empty.
+ */
+static struct fwk_event *thread_pop_event(struct __fwk_thread_ctx *thread_ctx)
+{
+    struct fwk_event *event;
+
+    event = FWK_LIST_GET(
+        fwk_list_pop_head(&thread_ctx->event_queue),
+        struct fwk_event,
+        slist_node);
+    if (event != NULL)
+        thread_ctx->queue_depth--;
+
+    return event;
+}
+
+static void thread_log_metrics(const struct __fwk_thread_ctx *thread_ctx)
+{
+    const char *name;
+
+    if (thread_ctx == &ctx.common_thread_ctx)
+        name = "common";
+    else if (thread_ctx == &ctx.signal_thread_ctx)
+        name = "signal";
+    else
+        name = fwk_module_get_name(thread_ctx->id);
+
+    FWK_LOG_INFO(
+        "[FWK] Thread %s: queue %u (peak %u), waits %" PRIu32
+        " (total %" PRIu32 " us, max %" PRIu32 " us)",
+        name,
+        thread_ctx->queue_depth,
+        thread_ctx->peak_queue_depth,
+        thread_ctx->wait_count,
+        (uint32_t)fwk_time_duration_us(thread_ctx->total_wait_time),
+        (uint32_t)fwk_time_duration_us(thread_ctx->max_wait_time));
+}
+
+#ifdef FWK_THREAD_PROFILE
+/*
+ * Account for the time a module spent in a handler.
+ *
+ * \param target_id Identifier of the target of the event.
+ * \param start Time at which the handler was called.
+ */
+static void profile_record_handler(fwk_id_t target_id, fwk_timestamp_t start)
+{
+    struct fwk_thread_profile *profile;
+    fwk_timestamp_t end = fwk_time_current();
+    fwk_duration_ns_t duration = (end > start) ? (end - start) : 0;
+
+    profile = &ctx.profile_table[fwk_id_get_module_idx(target_id)];
+    profile->event_count++;
+    profile->total_handler_time += duration;
+    profile->max_handler_time = FWK_MAX(profile->max_handler_time, duration);
+}
+
+/*
+ * Account for the time a thread waited for a module to process an event.
+ *
+ * \param target_id Identifier of the target of the event.
+ * \param duration Time the thread waited.
+ */
+static void profile_record_wait(fwk_id_t target_id, fwk_duration_ns_t duration)
+{
+    struct fwk_thread_profile *profile;
+
+    profile = &ctx.profile_table[fwk_id_get_module_idx(target_id)];
+    profile->waited_count++;
+    profile->total_waited_time += duration;
+}
+
+/*
+ * Check whether a module runs its events within the common thread.
+ */
+static bool plan_is_common(unsigned int module_idx)
+{
+    return fwk_module_get_ctx(FWK_ID_MODULE(module_idx))->thread_ctx == NULL;
+}
+
+/*
+ * Check whether a module waited for by other threads runs its events within
+ * the common thread, where long-running handlers delay it.
+ */
+static bool plan_has_critical_module(void)
+{
+    const struct fwk_thread_profile *profile;
+    unsigned int module_idx;
+
+    for (module_idx = 0; module_idx < FWK_MODULE_IDX_COUNT; module_idx++) {
+        profile = &ctx.profile_table[module_idx];
+
+        if (plan_is_common(module_idx) && (profile->waited_count != 0) &&
+            (profile->max_handler_time < FWK_US(FWK_THREAD_PLAN_HANDLER_US)))
+            return true;
+    }
+
+    return false;
+}
+
+/*
+ * Check whether the plan gives a module its own thread. The caller must have
+ * checked that a critical module runs within the common thread.
+ */
+static bool plan_isolates(unsigned int module_idx)
+{
+    return plan_is_common(module_idx) &&
+        (ctx.profile_table[module_idx].max_handler_time >=
+         FWK_US(FWK_THREAD_PLAN_HANDLER_US));
+}
+
+/*
+ * Log the modules the plan gives their own thread.
+ *
+ * This function is a sub-routine of logging_thread().
+ */
+static void log_plan(void)
+{
+    unsigned int module_idx;
+
+    if (!plan_has_critical_module())
+        return;
+
+    for (module_idx = 0; module_idx < FWK_MODULE_IDX_COUNT; module_idx++) {
+        if (!plan_isolates(module_idx))
+            continue;
+
+        FWK_LOG_INFO(
+            "[FWK] Thread plan: isolate %s (index %u, max %" PRIu32 " us)",
+            fwk_module_get_name(FWK_ID_MODULE(module_idx)),
+            module_idx,
+            (uint32_t)fwk_time_duration_us(
+                ctx.profile_table[module_idx].max_handler_time));
+    }
+}
+#endif
+
+#ifdef FMW_THREAD_PLAN
+/*
+ * Create a thread for each module of the thread plan of the firmware that has
+ * not created its own thread.
+ */
+static void apply_plan(void)
+{
+    static const unsigned int plan[] = FMW_THREAD_PLAN;
+    fwk_id_t module_id;
+    unsigned int i;
+
+    for (i = 0; i < FWK_ARRAY_SIZE(plan); i++) {
+        module_id = FWK_ID_MODULE(plan[i]);
+
+        if (!fwk_module_is_valid_module_id(module_id) ||
+            (fwk_module_get_ctx(module_id)->thread_ctx != NULL))
+            continue;
+
+        /* Failures are logged, and the module keeps the common thread */
+        (void)fwk_thread_create(module_id);
+    }
+}
+#endif
+
+/*
+ * Log the metrics of every thread.
+ *
+ * This function is a sub-routine of logging_thread().
+ */
+static void log_metrics(void)
+{
+    const struct fwk_module_ctx *module_ctx;
+    const struct fwk_element_ctx *element_ctx;
+
+    thread_log_metrics(&ctx.common_thread_ctx);
+    thread_log_metrics(&ctx.signal_thread_ctx);
+
+    for (unsigned int i = 0; i < FWK_MODULE_IDX_COUNT; i++) {
+        module_ctx = fwk_module_get_ctx(FWK_ID_MODULE(i));
+        if (module_ctx->thread_ctx != NULL)
+            thread_log_metrics(module_ctx->thread_ctx);
+
+        for (size_t j = 0; j < module_ctx->element_count; j++) {
+            element_ctx = &module_ctx->element_ctx_table[j];
+            if (element_ctx->thread_ctx != NULL)
+                thread_log_metrics(element_ctx->thread_ctx);
+        }
+    }
+
+#ifdef FWK_THREAD_PROFILE
+    log_plan();
+#endif
+}
+
 /*
  * Put an event in the ISR event queue.
  *
@@ -223,19 +503,32 @@ static int put_event(struct __fwk_thread_ctx *target_thread_ctx,
     event->is_thread_wakeup_event = is_thread_wakeup_event(
         target_thread_ctx, event);
 
+#ifdef FWK_EVENT_LATENCY
+    event->timestamp = fwk_time_current();
+#endif
+
     if (event->is_delayed_response) {
         allocated_event = __fwk_thread_search_delayed_response(
             event->source_id, event->cookie);
         if (allocated_event == NULL)
             goto error;
 
-        fwk_list_remove(
-            __fwk_thread_get_delayed_response_list(event->source_id),
-            &allocated_event->slist_node);
+        __fwk_thread_remove_delayed_response(
+            event->source_id, allocated_event);
 
         memcpy(allocated_event->params, event->params,
                sizeof(allocated_event->params));
         allocated_event->is_thread_wakeup_event = event->is_thread_wakeup_event;
+
+        if (allocated_event->payload != event->payload) {
+            fwk_event_payload_acquire(event->payload);
+            fwk_event_payload_release(allocated_event->payload);
+            allocated_event->payload = event->payload;
+        }
+
+#ifdef FWK_EVENT_LATENCY
+        allocated_event->timestamp = event->timestamp;
+#endif
     } else {
         allocated_event = duplicate_event(event);
         if (allocated_event == NULL)
@@ -245,14 +538,12 @@ static int put_event(struct __fwk_thread_ctx *target_thread_ctx,
     allocated_event->cookie = event->cookie = ctx.event_cookie_counter++;
 
     if (allocated_event->is_thread_wakeup_event) {
-        fwk_list_push_head(&target_thread_ctx->event_queue,
-                           &allocated_event->slist_node);
+        thread_push_event(target_thread_ctx, allocated_event, true);
         fwk_list_push_head(&ctx.thread_ready_queue,
                            &target_thread_ctx->slist_node);
     } else {
         is_empty = fwk_list_is_empty(&target_thread_ctx->event_queue);
-        fwk_list_push_tail(&target_thread_ctx->event_queue,
-                           &allocated_event->slist_node);
+        thread_push_event(target_thread_ctx, allocated_event, false);
 
         if (is_empty &&
             (target_thread_ctx != ctx.current_thread_ctx) &&
@@ -290,6 +581,12 @@ static void process_event_requiring_response(struct fwk_event *event)
     struct fwk_event resp_event, *allocated_event;
     int (*process_event)(const struct fwk_event *event,
                          struct fwk_event *resp_event);
+#ifdef FWK_EVENT_LATENCY
+    fwk_timestamp_t dispatch_timestamp;
+#endif
+#ifdef FWK_THREAD_PROFILE
+    fwk_timestamp_t profile_timestamp;
+#endif
 
     module = fwk_module_get_ctx(event->target_id)->desc;
     source_thread_ctx = thread_get_ctx(event->source_id);
@@ -302,7 +599,25 @@ static void process_event_requiring_response(struct fwk_event *event)
     resp_event.target_id = event->source_id;
     resp_event.is_delayed_response = false;
 
+    /* The response owns a reference to its payload, see fwk_event */
+    fwk_event_payload_acquire(resp_event.payload);
+
+#ifdef FWK_EVENT_LATENCY
+    dispatch_timestamp = fwk_time_current();
+#endif
+#ifdef FWK_THREAD_PROFILE
+    profile_timestamp = fwk_time_current();
+#endif
+
     status = process_event(event, &resp_event);
+
+#ifdef FWK_THREAD_PROFILE
+    profile_record_handler(event->target_id, profile_timestamp);
+#endif
+#ifdef FWK_EVENT_LATENCY
+    __fwk_latency_record(event, dispatch_timestamp);
+#endif
+
     if (status != FWK_SUCCESS)
         FWK_LOG_CRIT(err_msg_line, status, __LINE__);
 
@@ -313,11 +628,12 @@ static void process_event_requiring_response(struct fwk_event *event)
     else {
         allocated_event = duplicate_event(&resp_event);
         if (allocated_event != NULL) {
-            fwk_list_push_tail(
-                __fwk_thread_get_delayed_response_list(resp_event.source_id),
-                &allocated_event->slist_node);
+            __fwk_thread_add_delayed_response(
+                resp_event.source_id, allocated_event);
         }
     }
+
+    fwk_event_payload_release(resp_event.payload);
 }
 
 /*
@@ -333,6 +649,12 @@ static void process_next_thread_event(struct __fwk_thread_ctx *thread_ctx)
     int status;
     struct fwk_event *event, async_resp_event;
     const struct fwk_module *module;
+#ifdef FWK_EVENT_LATENCY
+    fwk_timestamp_t dispatch_timestamp;
+#endif
+#ifdef FWK_THREAD_PROFILE
+    fwk_timestamp_t profile_timestamp;
+#endif
 
     /*
      * Extract the event from the thread event queue and update the pointer to
@@ -340,9 +662,7 @@ static void process_next_thread_event(struct __fwk_thread_ctx *thread_ctx)
      * event.
      */
     ctx.current_thread_ctx = thread_ctx;
-    ctx.current_event = event =
-        FWK_LIST_GET(fwk_list_pop_head(&thread_ctx->event_queue),
-                     struct fwk_event, slist_node);
+    ctx.current_event = event = thread_pop_event(thread_ctx);
     fwk_assert(event != NULL);
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_TRACE
@@ -356,12 +676,35 @@ static void process_next_thread_event(struct __fwk_thread_ctx *thread_ctx)
 
     if (event->response_requested)
         process_event_requiring_response(event);
+#ifdef BUILD_HAS_NOTIFICATION
+    else if (
+        event->is_response && event->is_notification &&
+        __fwk_notification_collect_response(event)) {
+        /* The response was counted by the framework, see fwk_notification */
+    }
+#endif
     else {
         module = fwk_module_get_ctx(event->target_id)->desc;
+
+#ifdef FWK_EVENT_LATENCY
+        dispatch_timestamp = fwk_time_current();
+#endif
+#ifdef FWK_THREAD_PROFILE
+        profile_timestamp = fwk_time_current();
+#endif
+
         if (event->is_notification)
             status = module->process_notification(event, &async_resp_event);
         else
             status = module->process_event(event, &async_resp_event);
+
+#ifdef FWK_THREAD_PROFILE
+        profile_record_handler(event->target_id, profile_timestamp);
+#endif
+#ifdef FWK_EVENT_LATENCY
+        __fwk_latency_record(event, dispatch_timestamp);
+#endif
+
         if (status != FWK_SUCCESS) {
             FWK_LOG_ERR(
                 "[FWK] %s%s%s error: %s %s -> %s",
@@ -417,13 +760,11 @@ static struct __fwk_thread_ctx *launch_next_event_processing(
 
         if (event->is_thread_wakeup_event) {
             *next_thread_ctx->response_event = *event;
+            fwk_event_payload_acquire(event->payload);
             flags = osThreadFlagsSet(next_thread_ctx->os_thread_id,
                                      SIGNAL_EVENT_PROCESSED);
             if ((int32_t)flags >= 0) {
-                event = FWK_LIST_GET(fwk_list_pop_head(
-                    &next_thread_ctx->event_queue), struct fwk_event,
-                    slist_node);
-                free_event(event);
+                free_event(thread_pop_event(next_thread_ctx));
                 return next_thread_ctx;
             }
         } else {
@@ -434,9 +775,7 @@ static struct __fwk_thread_ctx *launch_next_event_processing(
         }
 
         FWK_LOG_CRIT(err_msg_line, FWK_E_OS, __LINE__);
-        event = FWK_LIST_GET(fwk_list_pop_head(&next_thread_ctx->event_queue),
-                             struct fwk_event, slist_node);
-        free_event(event);
+        free_event(thread_pop_event(next_thread_ctx));
 
         if (!fwk_list_is_empty(&next_thread_ctx->event_queue)) {
             fwk_list_push_tail(&ctx.thread_ready_queue,
@@ -462,6 +801,7 @@ void thread_signals_init()
         signal_ctx->signals[i].signal_id = FWK_ID_NONE;
     };
     signal_ctx->pending_signals = 0;
+    signal_ctx->head = 0;
 }
 
 int execute_signal_handler(fwk_id_t target_id, fwk_id_t signal_id)
@@ -489,35 +829,32 @@ void process_thread_signals(struct __fwk_thread_ctx *thread_ctx)
 {
     struct __fwk_thread_ctx *target_ctx;
     struct __fwk_signal_ctx *signal_ctx;
-    struct signal signal;
-    int i;
+    struct signal *signal;
 
     signal_ctx = &ctx.fwk_signal_ctx;
 
-    if (signal_ctx->pending_signals > 0) {
-        for (i = 0; i < FWK_MODULE_SIGNAL_COUNT; i++) {
-            if (!fwk_id_is_equal(
-                    signal_ctx->signals[i].target_id, FWK_ID_NONE)) {
-                signal = signal_ctx->signals[i];
-                ctx.current_signal = &signal_ctx->signals[i];
-                ctx.current_thread_ctx = thread_ctx;
-                execute_signal_handler(signal.target_id, signal.signal_id);
-
-                target_ctx = thread_get_ctx(signal.target_id);
-                if (!fwk_list_is_empty(&target_ctx->event_queue))
-                    osThreadFlagsSet(
-                        target_ctx->os_thread_id, SIGNAL_EVENT_TO_PROCESS);
-                fwk_interrupt_global_disable();
-                signal_ctx->pending_signals--;
-                signal_ctx->signals[i].target_id = FWK_ID_NONE;
-                fwk_interrupt_global_enable();
-
-                if (signal_ctx->pending_signals == 0)
-                    break;
-            }
-        }
-        ctx.current_signal = NULL;
+    while (signal_ctx->pending_signals > 0) {
+        /*
+         * The oldest signal keeps its slot until its handler has returned so
+         * that the current signal remains valid while it is being processed.
+         */
+        signal = &signal_ctx->signals[signal_ctx->head];
+        ctx.current_signal = signal;
+        ctx.current_thread_ctx = thread_ctx;
+        execute_signal_handler(signal->target_id, signal->signal_id);
+
+        target_ctx = thread_get_ctx(signal->target_id);
+        if (!fwk_list_is_empty(&target_ctx->event_queue))
+            osThreadFlagsSet(target_ctx->os_thread_id, SIGNAL_EVENT_TO_PROCESS);
+
+        fwk_interrupt_global_disable();
+        signal->target_id = FWK_ID_NONE;
+        signal_ctx->head = (signal_ctx->head + 1) % FWK_MODULE_SIGNAL_COUNT;
+        signal_ctx->pending_signals--;
+        fwk_interrupt_global_enable();
     }
+
+    ctx.current_signal = NULL;
 }
 
 void signal_thread(void *arg)
@@ -644,13 +981,8 @@ static void get_next_isr_event(void)
             target_thread_ctx, isr_event);
         isr_event->cookie = ctx.event_cookie_counter++;
 
-        if (isr_event->is_thread_wakeup_event) {
-            fwk_list_push_head(&target_thread_ctx->event_queue,
-                               &isr_event->slist_node);
-        } else {
-            fwk_list_push_tail(&target_thread_ctx->event_queue,
-                               &isr_event->slist_node);
-        }
+        thread_push_event(
+            target_thread_ctx, isr_event, isr_event->is_thread_wakeup_event);
 
         if (!(target_thread_ctx->waiting_event_processing_completion) ||
             isr_event->is_thread_wakeup_event) {
@@ -681,21 +1013,30 @@ static void logging_thread(void *arg)
 {
     while (true) {
         int status;
+        uint32_t flags;
 
-        (void)osThreadFlagsWait(
-            SIGNAL_CHECK_LOGS, osFlagsNoClear, osWaitForever);
+        flags = osThreadFlagsWait(
+            SIGNAL_CHECK_LOGS | SIGNAL_LOG_METRICS,
+            osFlagsWaitAny | osFlagsNoClear,
+            osWaitForever);
+
+        if (((int32_t)flags >= 0) && ((flags & SIGNAL_LOG_METRICS) != 0)) {
+            osThreadFlagsClear(SIGNAL_LOG_METRICS);
+            log_metrics();
+        }
 
         /*
          * At this point we've received a signal from one of the other threads
-         * that there might be log messages we need to process. Because logging
-         * is a low-priority task, we yield as soon as we've printed a character
-         * in order to maintain lower latencies elsewhere.
+         * that there might be log messages we need to process. The messages are
+         * sent to the backend a chunk at a time, with interrupts enabled, and
+         * as logging is a low-priority task the other threads preempt it
+         * whenever they are ready.
          *
          * We will only clear the signal once we have emptied out the log
          * buffer (at which point we will enter an idle state).
          */
 
-        status = fwk_log_unbuffer();
+        status = fwk_log_unbuffer_chunk();
         if (status == FWK_SUCCESS)
             osThreadFlagsClear(SIGNAL_CHECK_LOGS);
         else if (status != FWK_PENDING)
@@ -723,8 +1064,17 @@ int __fwk_thread_init(size_t event_count)
         goto error;
     }
 
+    status = __fwk_thread_delayed_response_init(event_count);
+    if (status != FWK_SUCCESS)
+        goto error;
+
     event_table = fwk_mm_calloc(event_count, sizeof(struct fwk_event));
 
+#ifdef FWK_THREAD_PROFILE
+    ctx.profile_table = fwk_mm_calloc(
+        FWK_MODULE_IDX_COUNT, sizeof(struct fwk_thread_profile));
+#endif
+
     /* All the event structures are free to be used. */
     fwk_list_init(&ctx.event_free_queue);
     fwk_list_init(&(ctx.thread_ready_queue));
@@ -742,6 +1092,8 @@ int __fwk_thread_init(size_t event_count)
         goto error;
     }
 
+    thread_init_ctx(&ctx.common_thread_ctx);
+
     /* Initialize the logging thread */
     thread_attr = (osThreadAttr_t){
         .priority = osPriorityLow,
@@ -768,6 +1120,8 @@ int __fwk_thread_init(size_t event_count)
         goto error;
     }
 
+    thread_init_ctx(&ctx.signal_thread_ctx);
+
     thread_signals_init();
 
     ctx.initialized = true;
@@ -786,6 +1140,10 @@ struct __fwk_multi_thread_ctx *__fwk_multi_thread_get_ctx(void)
 
 noreturn void __fwk_thread_run(void)
 {
+#ifdef FMW_THREAD_PLAN
+    apply_plan();
+#endif
+
     osKernelStart();
 
     while (true)
@@ -867,6 +1225,8 @@ int fwk_thread_create(fwk_id_t id)
         goto error;
     }
 
+    thread_init_ctx(thread_ctx);
+
     *p_thread_ctx = thread_ctx;
 
     return FWK_SUCCESS;
@@ -952,6 +1312,7 @@ int fwk_thread_put_event_and_wait(struct fwk_event *event,
     struct __fwk_thread_ctx *calling_thread_ctx;
     struct fwk_event *processed_event;
     uint32_t flags;
+    fwk_timestamp_t start, end;
 
     if (!ctx.running) {
         status = FWK_E_STATE;
@@ -1000,6 +1361,17 @@ int fwk_thread_put_event_and_wait(struct fwk_event *event,
     calling_thread_ctx = ctx.current_thread_ctx;
     processed_event = ctx.current_event;
 
+    /*
+     * Lend the priority of the calling thread to the target thread for as long
+     * as the calling thread waits.
+     */
+    calling_thread_ctx->waited_thread_ctx = target_thread_ctx;
+    fwk_list_push_tail(
+        &target_thread_ctx->waiter_list, &calling_thread_ctx->waiter_node);
+    thread_update_priority(target_thread_ctx);
+
+    start = fwk_time_current();
+
     /*
      * Launch the processing of the next event if possible.
      */
@@ -1009,6 +1381,24 @@ int fwk_thread_put_event_and_wait(struct fwk_event *event,
     flags = osThreadFlagsWait(SIGNAL_EVENT_PROCESSED,
                               osFlagsWaitAll, osWaitForever);
 
+    end = fwk_time_current();
+
+    fwk_list_remove(
+        &target_thread_ctx->waiter_list, &calling_thread_ctx->waiter_node);
+    calling_thread_ctx->waited_thread_ctx = NULL;
+    thread_update_priority(target_thread_ctx);
+
+    calling_thread_ctx->wait_count++;
+    if (end > start) {
+        calling_thread_ctx->total_wait_time += end - start;
+        calling_thread_ctx->max_wait_time =
+            FWK_MAX(calling_thread_ctx->max_wait_time, end - start);
+    }
+
+#ifdef FWK_THREAD_PROFILE
+    profile_record_wait(event->target_id, (end > start) ? (end - start) : 0);
+#endif
+
     calling_thread_ctx->response_event = NULL;
     calling_thread_ctx->waiting_event_processing_completion = false;
 
@@ -1034,7 +1424,7 @@ int fwk_thread_put_signal(
     fwk_id_t signal_id)
 {
     struct __fwk_signal_ctx *signal_ctx;
-    int signal_idx;
+    struct signal *signal;
     uint32_t flags;
 
     if (!ctx.running)
@@ -1044,24 +1434,22 @@ int fwk_thread_put_signal(
 
     fwk_interrupt_global_disable();
 
-    /*
-     * Find an available slot in the signals array
-     */
-    for (signal_idx = 0; signal_idx < FWK_MODULE_SIGNAL_COUNT; signal_idx++) {
-        if (fwk_id_is_equal(
-                signal_ctx->signals[signal_idx].target_id, FWK_ID_NONE)) {
-            signal_ctx->signals[signal_idx].source_id = source_id;
-            signal_ctx->signals[signal_idx].target_id = target_id;
-            signal_ctx->signals[signal_idx].signal_id = signal_id;
-            break;
-        }
-    }
-
-    if (signal_idx == FWK_MODULE_SIGNAL_COUNT) {
+    if (signal_ctx->pending_signals == FWK_MODULE_SIGNAL_COUNT) {
         fwk_interrupt_global_enable();
         return FWK_E_BUSY;
     }
 
+    /*
+     * Append the signal after the last pending one
+     */
+    signal = &signal_ctx->signals
+                  [(signal_ctx->head +
+                    (unsigned int)signal_ctx->pending_signals) %
+                   FWK_MODULE_SIGNAL_COUNT];
+    signal->source_id = source_id;
+    signal->target_id = target_id;
+    signal->signal_id = signal_id;
+
     signal_ctx->pending_signals++;
     fwk_interrupt_global_enable();
     flags = osThreadFlagsSet(
@@ -1073,3 +1461,66 @@ int fwk_thread_put_signal(
 
     return FWK_SUCCESS;
 }
+
+int fwk_thread_get_queue_stats(struct fwk_thread_queue_stats *stats)
+{
+    return FWK_E_SUPPORT;
+}
+
+int fwk_thread_get_profile(
+    fwk_id_t module_id,
+    struct fwk_thread_profile *profile)
+{
+#ifdef FWK_THREAD_PROFILE
+    if (!fwk_module_is_valid_module_id(module_id) || (profile == NULL))
+        return FWK_E_PARAM;
+
+    *profile = ctx.profile_table[fwk_id_get_module_idx(module_id)];
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
+int fwk_thread_get_plan(unsigned int *module_idx_table, unsigned int *count)
+{
+#ifdef FWK_THREAD_PROFILE
+    unsigned int module_idx;
+
+    if ((module_idx_table == NULL) || (count == NULL))
+        return FWK_E_PARAM;
+
+    *count = 0;
+
+    if (!plan_has_critical_module())
+        return FWK_SUCCESS;
+
+    for (module_idx = 0; module_idx < FWK_MODULE_IDX_COUNT; module_idx++) {
+        if (plan_isolates(module_idx))
+            module_idx_table[(*count)++] = module_idx;
+    }
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
+int fwk_thread_log_metrics(void)
+{
+    uint32_t flags;
+
+    if (!ctx.initialized) {
+        FWK_LOG_CRIT(err_msg_func, FWK_E_INIT, __func__);
+        return FWK_E_INIT;
+    }
+
+    flags = osThreadFlagsSet(ctx.log_thread_id, SIGNAL_LOG_METRICS);
+    if ((int32_t)flags < 0) {
+        FWK_LOG_CRIT(err_msg_func, FWK_E_OS, __func__);
+        return FWK_E_OS;
+    }
+
+    return FWK_SUCCESS;
+}
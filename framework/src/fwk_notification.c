@@ -24,15 +24,39 @@
 #include <fwk_module.h>
 #include <fwk_notification.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 
+#include <assert.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
+
+static_assert(
+    sizeof(struct fwk_notification_completion_params) <=
+        FWK_EVENT_PARAMETERS_SIZE,
+    "The completion parameters do not fit in an event");
 
 struct notification_ctx {
     /*
      * Queue of notification subscription structures that are free.
      */
     struct fwk_dlist free_subscription_dlist;
+
+    /*
+     * Flag indicating whether all the modules have been started and
+     * subscription lists may be compacted.
+     */
+    bool started;
+
+    /*
+     * Storage for the compacted subscriber tables.
+     */
+    fwk_id_t target_id_pool[FMW_NOTIFICATION_MAX];
+
+    /*
+     * Number of entries of the pool handed out to subscriber tables.
+     */
+    unsigned int target_id_pool_used;
 };
 
 static struct notification_ctx ctx;
@@ -70,6 +94,112 @@ static struct fwk_dlist *get_subscription_dlist(
                fwk_id_get_notification_idx(notification_id)];
 }
 
+/*
+ * Get the compacted subscriber table for a given notification emitted by a
+ * given source.
+ *
+ * \note The function assumes the validity of all its input parameters.
+ *
+ * \param notification_id Identifier of the notification.
+ * \param source_id Identifier of the emitter of the notification.
+ *
+ * \return A pointer to the subscriber table, NULL if the source has none.
+ */
+static struct __fwk_notification_subscribers *get_subscribers(
+    fwk_id_t notification_id, fwk_id_t source_id)
+{
+    struct __fwk_notification_subscribers *subscribers_table;
+
+    if (fwk_id_is_type(source_id, FWK_ID_TYPE_MODULE)) {
+        subscribers_table = fwk_module_get_ctx(source_id)->subscribers_table;
+    } else {
+        subscribers_table =
+            fwk_module_get_element_ctx(source_id)->subscribers_table;
+    }
+
+    if (subscribers_table == NULL)
+        return NULL;
+
+    return &subscribers_table[fwk_id_get_notification_idx(notification_id)];
+}
+
+/*
+ * Invalidate the compacted subscriber table of a subscription list following a
+ * change to the list.
+ *
+ * \note The function assumes the validity of all its input parameters.
+ *
+ * \param notification_id Identifier of the notification.
+ * \param source_id Identifier of the emitter of the notification.
+ */
+static void invalidate_subscribers(
+    fwk_id_t notification_id, fwk_id_t source_id)
+{
+    struct __fwk_notification_subscribers *subscribers;
+
+    subscribers = get_subscribers(notification_id, source_id);
+    if (subscribers != NULL)
+        subscribers->is_valid = false;
+}
+
+/*
+ * Rebuild the compacted subscriber table of a subscription list.
+ *
+ * \details The table is rebuilt in place when it is large enough, otherwise a
+ *      new table is taken from the pool. The table is left invalid if the
+ *      pool is exhausted, in which case the list is walked instead.
+ *
+ * \note The function assumes the validity of all its input parameters and
+ *      must be called with interrupts disabled.
+ *
+ * \param subscribers Pointer to the subscriber table.
+ * \param subscription_dlist Pointer to the subscription list.
+ * \param source_id Identifier of the emitter of the notification.
+ */
+static void compact_subscribers(
+    struct __fwk_notification_subscribers *subscribers,
+    struct fwk_dlist *subscription_dlist,
+    fwk_id_t source_id)
+{
+    struct fwk_dlist_node *node;
+    struct __fwk_notification_subscription *subscription;
+    unsigned int count = 0;
+
+    for (node = fwk_list_head(subscription_dlist); node != NULL;
+         node = fwk_list_next(subscription_dlist, node)) {
+        subscription = FWK_LIST_GET(node,
+            struct __fwk_notification_subscription, dlist_node);
+
+        if (fwk_id_is_equal(subscription->source_id, source_id))
+            count++;
+    }
+
+    if (count > subscribers->capacity) {
+        if (count > (FMW_NOTIFICATION_MAX - ctx.target_id_pool_used))
+            return;
+
+        subscribers->target_id_table =
+            &ctx.target_id_pool[ctx.target_id_pool_used];
+        subscribers->capacity = count;
+        ctx.target_id_pool_used += count;
+    }
+
+    subscribers->count = 0;
+
+    for (node = fwk_list_head(subscription_dlist); node != NULL;
+         node = fwk_list_next(subscription_dlist, node)) {
+        subscription = FWK_LIST_GET(node,
+            struct __fwk_notification_subscription, dlist_node);
+
+        if (fwk_id_is_equal(subscription->source_id, source_id)) {
+            subscribers->target_id_table[subscribers->count++] =
+                subscription->target_id;
+        }
+    }
+
+    subscribers->is_valid = true;
+}
+
 /*
  * Search for a subscription with a given source and target identifier in a list
  * of subscriptions.
@@ -117,15 +247,46 @@ static void send_notifications(struct fwk_event *notification_event,
                                unsigned int *count)
 {
     int status;
+    unsigned int interrupt, i;
     struct fwk_dlist *subscription_dlist;
     struct fwk_dlist_node *node;
     struct __fwk_notification_subscription *subscription;
+    struct __fwk_notification_subscribers *subscribers = NULL;
 
     subscription_dlist = get_subscription_dlist(notification_event->id,
                                                 notification_event->source_id);
     notification_event->is_response = false;
     notification_event->is_notification = true;
 
+    if (ctx.started) {
+        subscribers = get_subscribers(
+            notification_event->id, notification_event->source_id);
+    }
+
+    /*
+     * Subscriber tables are only rebuilt from the thread, subscription lists
+     * being modified from the thread only.
+     */
+    if ((subscribers != NULL) && !subscribers->is_valid &&
+        (fwk_interrupt_get_current(&interrupt) != FWK_SUCCESS)) {
+        fwk_interrupt_global_disable();
+        compact_subscribers(
+            subscribers, subscription_dlist, notification_event->source_id);
+        fwk_interrupt_global_enable();
+    }
+
+    if ((subscribers != NULL) && subscribers->is_valid) {
+        for (i = 0; i < subscribers->count; i++) {
+            notification_event->target_id = subscribers->target_id_table[i];
+
+            status = __fwk_thread_put_notification(notification_event);
+            if (status == FWK_SUCCESS)
+                (*count)++;
+        }
+
+        return;
+    }
+
     for (node = fwk_list_head(subscription_dlist); node != NULL;
          node = fwk_list_next(subscription_dlist, node)) {
         subscription = FWK_LIST_GET(node,
@@ -143,6 +304,76 @@ static void send_notifications(struct fwk_event *notification_event,
     }
 }
 
+/*
+ * Check the source of a notification event, which defaults to the target of
+ * the event being processed.
+ *
+ * \param notification_event Pointer to the notification event.
+ *
+ * \retval ::FWK_SUCCESS The source of the notification is valid.
+ * \retval ::FWK_E_PARAM The notification or its source are invalid.
+ */
+static int check_source(struct fwk_event *notification_event)
+{
+    unsigned int interrupt;
+    const struct fwk_event *current_event;
+
+    if (fwk_interrupt_get_current(&interrupt) == FWK_SUCCESS) {
+        if (!fwk_module_is_valid_entity_id(notification_event->source_id))
+            return FWK_E_PARAM;
+    } else {
+        current_event = __fwk_thread_get_current_event();
+
+        if ((current_event != NULL) &&
+            (!fwk_module_is_valid_entity_id(notification_event->source_id))) {
+            /*
+             * The source_id provided is not valid, use the identifier of the
+             * target for the current event.
+             */
+            notification_event->source_id = current_event->target_id;
+        }
+    }
+
+    if (!fwk_module_is_valid_notification_id(notification_event->id) ||
+        (fwk_id_get_module_idx(notification_event->id) !=
+         fwk_id_get_module_idx(notification_event->source_id)))
+        return FWK_E_PARAM;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Send the completion event of a collection and free the collection.
+ *
+ * \param collection Collection whose responses have all been received.
+ * \param notification_id Identifier of the notification.
+ * \param source_id Identifier of the emitter of the notification.
+ */
+static void complete_collection(
+    struct __fwk_notification_collection *collection,
+    fwk_id_t notification_id,
+    fwk_id_t source_id)
+{
+    int status;
+    struct fwk_event completion_event = {
+        .id = collection->completion_event_id,
+        .source_id = source_id,
+        .target_id = source_id,
+    };
+    struct fwk_notification_completion_params *params =
+        (struct fwk_notification_completion_params *)completion_event.params;
+
+    params->notification_id = notification_id;
+    params->response_count = collection->response_count;
+    params->status = collection->status;
+
+    collection->in_use = false;
+
+    status = fwk_thread_put_event(&completion_event);
+    if (status != FWK_SUCCESS)
+        FWK_LOG_CRIT(err_msg_func, status, __func__);
+}
+
 /*
  * Private interface functions
  */
@@ -157,12 +388,49 @@ static FWK_CONSTRUCTOR void fwk_notification_init(void)
     /* All the subscription structures are free to be used */
     fwk_list_init(&ctx.free_subscription_dlist);
 
+    ctx.started = false;
+    ctx.target_id_pool_used = 0;
+
     for (i = 0; i < FMW_NOTIFICATION_MAX; i++) {
         fwk_list_push_tail(
             &ctx.free_subscription_dlist, &subscriptions[i].dlist_node);
     }
 }
 
+bool __fwk_notification_collect_response(const struct fwk_event *event)
+{
+    int response_status;
+    struct __fwk_notification_subscribers *subscribers;
+    struct __fwk_notification_collection *collection;
+    bool complete;
+
+    subscribers = get_subscribers(event->id, event->target_id);
+    if ((subscribers == NULL) || !subscribers->collection.in_use)
+        return false;
+
+    collection = &subscribers->collection;
+
+    memcpy(&response_status, event->params, sizeof(response_status));
+
+    fwk_interrupt_global_disable();
+    collection->response_count++;
+    if (collection->status == FWK_SUCCESS)
+        collection->status = response_status;
+    complete = collection->sent &&
+        (collection->response_count == collection->expected_count);
+    fwk_interrupt_global_enable();
+
+    if (complete)
+        complete_collection(collection, event->id, event->target_id);
+
+    return true;
+}
+
+void __fwk_notification_start(void)
+{
+    ctx.started = true;
+}
+
 void __fwk_notification_reset(void)
 {
     fwk_notification_init();
@@ -215,6 +483,7 @@ int fwk_notification_subscribe(fwk_id_t notification_id, fwk_id_t source_id,
 
     fwk_interrupt_global_disable();
     fwk_list_push_tail(subscription_dlist, &subscription->dlist_node);
+    invalidate_subscribers(notification_id, source_id);
     fwk_interrupt_global_enable();
 
     return FWK_SUCCESS;
@@ -256,6 +525,7 @@ int fwk_notification_unsubscribe(fwk_id_t notification_id, fwk_id_t source_id,
 
     fwk_interrupt_global_disable();
     fwk_list_remove(subscription_dlist, &subscription->dlist_node);
+    invalidate_subscribers(notification_id, source_id);
     fwk_interrupt_global_enable();
     fwk_list_push_tail(&ctx.free_subscription_dlist, &subscription->dlist_node);
 
@@ -270,43 +540,144 @@ int fwk_notification_notify(struct fwk_event *notification_event,
                             unsigned int *count)
 {
     int status;
+
+    if ((notification_event == NULL) || (count == NULL))
+        return FWK_E_PARAM;
+
+    status = check_source(notification_event);
+    if (status != FWK_SUCCESS)
+        goto error;
+
+    *count = 0;
+    send_notifications(notification_event, count);
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_LOG_CRIT(err_msg_func, status, __func__);
+    return status;
+}
+
+int fwk_notification_notify_and_collect(
+    struct fwk_event *notification_event,
+    fwk_id_t completion_event_id,
+    unsigned int *count)
+{
+    int status;
     unsigned int interrupt;
-    const struct fwk_event *current_event;
+    struct __fwk_notification_subscribers *subscribers;
+    struct __fwk_notification_collection *collection;
+    bool complete;
 
     if ((notification_event == NULL) || (count == NULL))
         return FWK_E_PARAM;
 
     if (fwk_interrupt_get_current(&interrupt) == FWK_SUCCESS) {
-        if (!fwk_module_is_valid_entity_id(notification_event->source_id)) {
-            status = FWK_E_PARAM;
-            goto error;
-        }
-    } else {
-        current_event = __fwk_thread_get_current_event();
-
-        if ((current_event != NULL) &&
-            (!fwk_module_is_valid_entity_id(notification_event->source_id))) {
-            /*
-             * The source_id provided is not valid, use the identifier of the
-             * target for the current event.
-             */
-            notification_event->source_id = current_event->target_id;
-        }
+        status = FWK_E_HANDLER;
+        goto error;
     }
 
-    if (!fwk_module_is_valid_notification_id(notification_event->id) ||
-        (fwk_id_get_module_idx(notification_event->id) !=
+    status = check_source(notification_event);
+    if (status != FWK_SUCCESS)
+        goto error;
+
+    if (!fwk_module_is_valid_event_id(completion_event_id) ||
+        (fwk_id_get_module_idx(completion_event_id) !=
          fwk_id_get_module_idx(notification_event->source_id))) {
         status = FWK_E_PARAM;
         goto error;
     }
 
+    subscribers = get_subscribers(
+        notification_event->id, notification_event->source_id);
+    if (subscribers == NULL) {
+        status = FWK_E_PARAM;
+        goto error;
+    }
+
+    collection = &subscribers->collection;
+    if (collection->in_use) {
+        status = FWK_E_BUSY;
+        goto error;
+    }
+
+    *collection = (struct __fwk_notification_collection){
+        .in_use = true,
+        .completion_event_id = completion_event_id,
+        .status = FWK_SUCCESS,
+    };
+
+    notification_event->response_requested = true;
+
     *count = 0;
     send_notifications(notification_event, count);
 
+    /* Responses may have been processed by other threads in the meantime */
+    fwk_interrupt_global_disable();
+    collection->expected_count = *count;
+    collection->sent = true;
+    complete = (collection->response_count == collection->expected_count);
+    fwk_interrupt_global_enable();
+
+    if (!complete)
+        return FWK_SUCCESS;
+
+    /* Without any subscriber notified, there is nothing to complete */
+    if (*count == 0) {
+        collection->in_use = false;
+    } else {
+        complete_collection(
+            collection, notification_event->id, notification_event->source_id);
+    }
+
     return FWK_SUCCESS;
 
 error:
     FWK_LOG_CRIT(err_msg_func, status, __func__);
     return status;
 }
+
+int fwk_notification_get_subscriber_count(fwk_id_t notification_id,
+                                          fwk_id_t source_id,
+                                          unsigned int *count)
+{
+    struct fwk_dlist *subscription_dlist;
+    struct fwk_dlist_node *node;
+    struct __fwk_notification_subscription *subscription;
+    struct __fwk_notification_subscribers *subscribers = NULL;
+
+    if ((count == NULL) ||
+        !fwk_module_is_valid_notification_id(notification_id) ||
+        !fwk_module_is_valid_entity_id(source_id) ||
+        (fwk_id_get_module_idx(notification_id) !=
+         fwk_id_get_module_idx(source_id)))
+        return FWK_E_PARAM;
+
+    if (ctx.started)
+        subscribers = get_subscribers(notification_id, source_id);
+
+    if ((subscribers != NULL) && subscribers->is_valid) {
+        *count = subscribers->count;
+
+        return FWK_SUCCESS;
+    }
+
+    *count = 0;
+
+    subscription_dlist = get_subscription_dlist(notification_id, source_id);
+
+    fwk_interrupt_global_disable();
+
+    for (node = fwk_list_head(subscription_dlist); node != NULL;
+         node = fwk_list_next(subscription_dlist, node)) {
+        subscription = FWK_LIST_GET(node,
+            struct __fwk_notification_subscription, dlist_node);
+
+        if (fwk_id_is_equal(subscription->source_id, source_id))
+            (*count)++;
+    }
+
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
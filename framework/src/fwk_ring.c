@@ -9,13 +9,69 @@
 #include <fwk_macros.h>
 #include <fwk_ring.h>
 
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
+/*
+ * The head and tail of the ring buffer are positions in the range
+ * [0, 2 * capacity). Keeping twice the range of the storage lets a full
+ * buffer be told apart from an empty one without any extra state, so the
+ * producer only ever writes the tail and the consumer only ever writes the
+ * head.
+ */
+
 static size_t fwk_ring_offset(const struct fwk_ring *ring, size_t idx)
 {
-    return (idx % ring->capacity);
+    return (idx < ring->capacity) ? idx : (idx - ring->capacity);
+}
+
+static size_t fwk_ring_advance(
+    const struct fwk_ring *ring,
+    size_t idx,
+    size_t count)
+{
+    idx += count;
+
+    return (idx < (2 * ring->capacity)) ? idx : (idx - (2 * ring->capacity));
+}
+
+static size_t fwk_ring_distance(
+    const struct fwk_ring *ring,
+    size_t head,
+    size_t tail)
+{
+    if (tail >= head)
+        return tail - head;
+
+    return (2 * ring->capacity) - head + tail;
+}
+
+/*
+ * Describe up to `size` bytes of storage starting at position `idx` as one or
+ * two contiguous spans, the second one being used only if the region wraps
+ * around the end of the storage.
+ */
+static void fwk_ring_describe(
+    const struct fwk_ring *ring,
+    size_t idx,
+    size_t size,
+    struct fwk_ring_span spans[2])
+{
+    size_t offset = fwk_ring_offset(ring, idx);
+    size_t chunk_size = FWK_MIN(size, ring->capacity - offset);
+
+    spans[0] = (struct fwk_ring_span){
+        .data = ring->storage + offset,
+        .size = chunk_size,
+    };
+
+    spans[1] = (struct fwk_ring_span){
+        .data = ring->storage,
+        .size = size - chunk_size,
+    };
 }
 
 void fwk_ring_init(struct fwk_ring *ring, char *storage, size_t storage_size)
@@ -23,6 +79,7 @@ void fwk_ring_init(struct fwk_ring *ring, char *storage, size_t storage_size)
     fwk_assert(ring != NULL);
     fwk_assert(storage != NULL);
     fwk_assert(storage_size > 0);
+    fwk_assert(storage_size <= (SIZE_MAX / 2));
 
     *ring = (struct fwk_ring){
         .storage = storage,
@@ -43,10 +100,7 @@ size_t fwk_ring_get_length(const struct fwk_ring *ring)
 {
     fwk_assert(ring != NULL);
 
-    if ((ring->tail >= ring->head) && !ring->full)
-        return (ring->tail - ring->head);
-    else
-        return ((ring->capacity - ring->head) + ring->tail);
+    return fwk_ring_distance(ring, ring->head, ring->tail);
 }
 
 size_t fwk_ring_get_free(const struct fwk_ring *ring)
@@ -60,14 +114,14 @@ bool fwk_ring_is_full(const struct fwk_ring *ring)
 {
     fwk_assert(ring != NULL);
 
-    return ring->full;
+    return fwk_ring_get_length(ring) == ring->capacity;
 }
 
 bool fwk_ring_is_empty(const struct fwk_ring *ring)
 {
     fwk_assert(ring != NULL);
 
-    return ((ring->head == ring->tail) && !ring->full);
+    return ring->head == ring->tail;
 }
 
 size_t fwk_ring_pop(struct fwk_ring *ring, char *buffer, size_t buffer_size)
@@ -78,11 +132,7 @@ size_t fwk_ring_pop(struct fwk_ring *ring, char *buffer, size_t buffer_size)
         FWK_MIN(buffer_size, fwk_ring_get_length(ring)) :
         fwk_ring_peek(ring, buffer, buffer_size);
 
-    if (buffer_size > 0) {
-        ring->head = fwk_ring_offset(ring, ring->head + buffer_size);
-
-        ring->full = false;
-    }
+    fwk_ring_release(ring, buffer_size);
 
     return buffer_size;
 }
@@ -92,21 +142,17 @@ size_t fwk_ring_peek(
     char *buffer,
     size_t buffer_size)
 {
+    struct fwk_ring_span spans[2];
+
     fwk_assert(ring != NULL);
     fwk_assert(buffer != NULL);
 
-    buffer_size = FWK_MIN(buffer_size, fwk_ring_get_length(ring));
+    buffer_size = fwk_ring_peek_span(ring, buffer_size, spans);
     if (buffer_size == 0)
         return buffer_size;
 
-    if (fwk_ring_offset(ring, ring->head + buffer_size) > ring->head)
-        memcpy(buffer, ring->storage + ring->head, buffer_size);
-    else {
-        size_t chunk_size = ring->capacity - ring->head;
-
-        memcpy(buffer, ring->storage + ring->head, chunk_size);
-        memcpy(buffer + chunk_size, ring->storage, buffer_size - chunk_size);
-    }
+    memcpy(buffer, spans[0].data, spans[0].size);
+    memcpy(buffer + spans[0].size, spans[1].data, spans[1].size);
 
     return buffer_size;
 }
@@ -116,6 +162,7 @@ size_t fwk_ring_push(
     const char *buffer,
     size_t buffer_size)
 {
+    struct fwk_ring_span spans[2];
     size_t remaining;
 
     fwk_assert(ring != NULL);
@@ -136,21 +183,16 @@ size_t fwk_ring_push(
 
     remaining = fwk_ring_get_free(ring);
 
-    if (fwk_ring_offset(ring, ring->tail + buffer_size) > ring->tail)
-        memcpy(ring->storage + ring->tail, buffer, buffer_size);
-    else {
-        size_t chunk_size = ring->capacity - ring->tail;
+    /* Make room for the new data by dropping the oldest data */
+    if (buffer_size > remaining)
+        fwk_ring_release(ring, buffer_size - remaining);
 
-        memcpy(ring->storage + ring->tail, buffer, chunk_size);
-        memcpy(ring->storage, buffer + chunk_size, buffer_size - chunk_size);
-    }
+    fwk_ring_reserve(ring, buffer_size, spans);
 
-    ring->tail = fwk_ring_offset(ring, ring->tail + buffer_size);
+    memcpy(spans[0].data, buffer, spans[0].size);
+    memcpy(spans[1].data, buffer + spans[0].size, spans[1].size);
 
-    if (buffer_size >= remaining) {
-        ring->head = ring->tail;
-        ring->full = true;
-    }
+    fwk_ring_commit(ring, buffer_size);
 
     /*
      * Note that if the user tried to write more than the ring buffer could hold
@@ -161,12 +203,72 @@ size_t fwk_ring_push(
     return buffer_size;
 }
 
+size_t fwk_ring_reserve(
+    struct fwk_ring *ring,
+    size_t size,
+    struct fwk_ring_span spans[2])
+{
+    size_t tail;
+
+    fwk_assert(ring != NULL);
+    fwk_assert(spans != NULL);
+
+    tail = ring->tail;
+    size = FWK_MIN(
+        size, ring->capacity - fwk_ring_distance(ring, ring->head, tail));
+
+    fwk_ring_describe(ring, tail, size, spans);
+
+    return size;
+}
+
+void fwk_ring_commit(struct fwk_ring *ring, size_t size)
+{
+    fwk_assert(ring != NULL);
+    fwk_assert(size <= fwk_ring_get_free(ring));
+
+    /* The data must be visible before the consumer can see the new tail */
+    atomic_signal_fence(memory_order_release);
+
+    ring->tail = fwk_ring_advance(ring, ring->tail, size);
+}
+
+size_t fwk_ring_peek_span(
+    const struct fwk_ring *ring,
+    size_t size,
+    struct fwk_ring_span spans[2])
+{
+    size_t head;
+
+    fwk_assert(ring != NULL);
+    fwk_assert(spans != NULL);
+
+    head = ring->head;
+    size = FWK_MIN(size, fwk_ring_distance(ring, head, ring->tail));
+
+    /* The new tail must be read before the data it covers */
+    atomic_signal_fence(memory_order_acquire);
+
+    fwk_ring_describe(ring, head, size, spans);
+
+    return size;
+}
+
+void fwk_ring_release(struct fwk_ring *ring, size_t size)
+{
+    fwk_assert(ring != NULL);
+    fwk_assert(size <= fwk_ring_get_length(ring));
+
+    /* The data must have been read before the producer can reuse it */
+    atomic_signal_fence(memory_order_release);
+
+    ring->head = fwk_ring_advance(ring, ring->head, size);
+}
+
 void fwk_ring_clear(struct fwk_ring *ring)
 {
     fwk_assert(ring != NULL);
 
     ring->head = 0;
     ring->tail = 0;
-
-    ring->full = false;
 }
@@ -0,0 +1,222 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Cooperative tasks.
+ */
+
+#include <internal/fwk_task.h>
+
+#include <fwk_arch.h>
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_list.h>
+#include <fwk_noreturn.h>
+#include <fwk_status.h>
+#include <fwk_task.h>
+#include <fwk_thread.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static struct {
+    /* Context switching driver, NULL if tasks are not supported */
+    const struct fwk_arch_task_driver *driver;
+
+    /* Context of the thread, resumed when a task waits, yields or returns */
+    void *thread_context;
+
+    /* Task currently running, if any */
+    struct fwk_task *current_task;
+
+    /* Tasks ready to run */
+    struct fwk_slist ready_queue;
+
+    /* Tasks awaiting a response */
+    struct fwk_slist waiting_queue;
+} ctx;
+
+static noreturn void task_entry(void)
+{
+    struct fwk_task *task = ctx.current_task;
+
+    task->entry(task->param);
+
+    task->active = false;
+
+    ctx.driver->switch_to(&task->context, ctx.thread_context);
+
+    fwk_unreachable();
+}
+
+static void suspend(struct fwk_task *task)
+{
+    ctx.driver->switch_to(&task->context, ctx.thread_context);
+}
+
+/*
+ * Private interface functions
+ */
+
+int __fwk_task_init(const struct fwk_arch_task_driver *driver)
+{
+    if ((driver->create == NULL) || (driver->switch_to == NULL))
+        return FWK_E_PARAM;
+
+    fwk_list_init(&ctx.ready_queue);
+    fwk_list_init(&ctx.waiting_queue);
+
+    ctx.driver = driver;
+
+    return FWK_SUCCESS;
+}
+
+struct fwk_task *__fwk_task_pop_ready(void)
+{
+    if (ctx.driver == NULL)
+        return NULL;
+
+    return FWK_LIST_GET(
+        fwk_list_pop_head(&ctx.ready_queue), struct fwk_task, slist_node);
+}
+
+void __fwk_task_resume(struct fwk_task *task)
+{
+    ctx.current_task = task;
+
+    ctx.driver->switch_to(&ctx.thread_context, task->context);
+
+    ctx.current_task = NULL;
+}
+
+void __fwk_task_update_cookie(uint32_t old_cookie, uint32_t new_cookie)
+{
+    struct fwk_slist_node *node;
+    struct fwk_task *task;
+
+    if (ctx.driver == NULL)
+        return;
+
+    FWK_LIST_FOR_EACH(
+        &ctx.waiting_queue, node, struct fwk_task, slist_node, task)
+    {
+        if (task->cookie == old_cookie) {
+            task->cookie = new_cookie;
+            return;
+        }
+    }
+}
+
+bool __fwk_task_put_response(const struct fwk_event *event)
+{
+    struct fwk_slist_node *node;
+    struct fwk_task *task;
+
+    if (ctx.driver == NULL)
+        return false;
+
+    FWK_LIST_FOR_EACH(
+        &ctx.waiting_queue, node, struct fwk_task, slist_node, task)
+    {
+        if ((task->cookie == event->cookie) &&
+            fwk_id_is_equal(task->id, event->target_id)) {
+            fwk_list_remove(&ctx.waiting_queue, node);
+
+            /* The response owns a reference to its payload, see fwk_event */
+            *task->response = *event;
+            fwk_event_payload_acquire(task->response->payload);
+
+            fwk_list_push_tail(&ctx.ready_queue, &task->slist_node);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Public interface functions
+ */
+
+int fwk_task_start(
+    struct fwk_task *task,
+    fwk_id_t id,
+    void (*entry)(uintptr_t param),
+    uintptr_t param,
+    void *stack,
+    size_t stack_size)
+{
+    int status;
+
+    if (ctx.driver == NULL)
+        return FWK_E_SUPPORT;
+
+    if ((task == NULL) || (entry == NULL) || (stack == NULL))
+        return FWK_E_PARAM;
+
+    if (task->active)
+        return FWK_E_BUSY;
+
+    status = ctx.driver->create(stack, stack_size, task_entry, &task->context);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    task->id = id;
+    task->entry = entry;
+    task->param = param;
+    task->response = NULL;
+    task->active = true;
+
+    fwk_list_push_tail(&ctx.ready_queue, &task->slist_node);
+
+    return FWK_SUCCESS;
+}
+
+int fwk_task_await_response(
+    struct fwk_event *event,
+    struct fwk_event *response)
+{
+    struct fwk_task *task = ctx.current_task;
+    int status;
+
+    if (task == NULL)
+        return FWK_E_STATE;
+
+    if ((event == NULL) || (response == NULL))
+        return FWK_E_PARAM;
+
+    event->response_requested = true;
+
+    status = fwk_thread_put_event(event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    task->cookie = event->cookie;
+    task->response = response;
+
+    fwk_list_push_tail(&ctx.waiting_queue, &task->slist_node);
+
+    suspend(task);
+
+    return FWK_SUCCESS;
+}
+
+int fwk_task_yield(void)
+{
+    struct fwk_task *task = ctx.current_task;
+
+    if (task == NULL)
+        return FWK_E_STATE;
+
+    fwk_list_push_tail(&ctx.ready_queue, &task->slist_node);
+
+    suspend(task);
+
+    return FWK_SUCCESS;
+}
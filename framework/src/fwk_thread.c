@@ -8,13 +8,18 @@
  *     Single-thread facilities.
  */
 
+#include <internal/fwk_interrupt.h>
+#include <internal/fwk_latency.h>
 #include <internal/fwk_module.h>
+#include <internal/fwk_notification.h>
 #include <internal/fwk_signal.h>
 #include <internal/fwk_single_thread.h>
+#include <internal/fwk_task.h>
 #include <internal/fwk_thread.h>
 #include <internal/fwk_thread_delayed_resp.h>
 
 #include <fwk_assert.h>
+#include <fwk_attributes.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
@@ -25,12 +30,29 @@
 #include <fwk_noreturn.h>
 #include <fwk_slist.h>
 #include <fwk_status.h>
+#include <fwk_task.h>
 #include <fwk_thread.h>
+#include <fwk_time.h>
 
 #include <inttypes.h>
 #include <stdbool.h>
 #include <string.h>
 
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+#    include <stdatomic.h>
+#endif
+
+/*
+ * Interrupts not masked by critical sections may only raise events through the
+ * ISR event rings.
+ */
+#ifdef FWK_INTERRUPT_CRITICAL_PRIORITY
+static_assert(
+    FWK_THREAD_ISR_EVENT_RING_LEVELS >= FWK_INTERRUPT_CRITICAL_PRIORITY,
+    "FMW_ISR_EVENT_RING_LEVELS must cover the interrupt priority levels not "
+    "masked by critical sections");
+#endif
+
 static struct __fwk_thread_ctx ctx;
 
 static const char err_msg_line[] = "[FWK] Error %d in %s @%d";
@@ -57,6 +79,94 @@ static struct __fwk_signal_ctx fwk_signal_ctx;
  * Static functions
  */
 
+/*
+ * Take an event structure from the free event queue, if any is left.
+ */
+static struct fwk_event *pop_free_event(void)
+{
+    struct fwk_event *allocated_event;
+
+    fwk_interrupt_global_disable();
+    allocated_event = FWK_LIST_GET(
+        fwk_list_pop_head(&ctx.free_event_queue), struct fwk_event, slist_node);
+    if (allocated_event != NULL) {
+        ctx.free_event_count--;
+        if (ctx.free_event_count < ctx.free_event_low_water)
+            ctx.free_event_low_water = ctx.free_event_count;
+        if ((ctx.event_count - ctx.free_event_count) > ctx.used_event_peak)
+            ctx.used_event_peak = ctx.event_count - ctx.free_event_count;
+    }
+    fwk_interrupt_global_enable();
+
+    return allocated_event;
+}
+
+#if FWK_THREAD_EVENT_POOL_GROWTH > 0
+/*
+ * Add a block of event structures to the event pool.
+ *
+ * The block is allocated from the heap, which is not accessed from interrupt
+ * service routines: the pool only grows when the thread puts an event.
+ */
+static void grow_event_pool(void)
+{
+    struct fwk_event *block;
+    unsigned int interrupt;
+    size_t i;
+
+    if (fwk_interrupt_get_current(&interrupt) == FWK_SUCCESS)
+        return;
+
+    block = fwk_mm_alloc_notrap(
+        FWK_THREAD_EVENT_POOL_GROWTH, sizeof(struct fwk_event));
+    if (block == NULL)
+        return;
+
+    /* Every event of the pool may become a delayed response */
+    if (__fwk_thread_delayed_response_grow(
+            ctx.event_count + FWK_THREAD_EVENT_POOL_GROWTH) != FWK_SUCCESS) {
+        fwk_mm_free(block);
+        return;
+    }
+
+    fwk_interrupt_global_disable();
+    for (i = 0; i < FWK_THREAD_EVENT_POOL_GROWTH; i++) {
+        block[i].slist_node = (struct fwk_slist_node){ 0 };
+        fwk_list_push_tail(&ctx.free_event_queue, &block[i].slist_node);
+    }
+    ctx.event_count += FWK_THREAD_EVENT_POOL_GROWTH;
+    ctx.grown_event_count += FWK_THREAD_EVENT_POOL_GROWTH;
+    ctx.free_event_count += FWK_THREAD_EVENT_POOL_GROWTH;
+    fwk_interrupt_global_enable();
+
+    FWK_LOG_WARN(
+        "[FWK] Event pool exhausted, grown to %u events",
+        (unsigned int)ctx.event_count);
+}
+#endif
+
+/*
+ * Take an event structure from the free event queue, growing the event pool if
+ * it is exhausted.
+ *
+ * \return The pointer to the event structure, NULL if none is available.
+ */
+static struct fwk_event *alloc_event(void)
+{
+    struct fwk_event *allocated_event;
+
+    allocated_event = pop_free_event();
+
+#if FWK_THREAD_EVENT_POOL_GROWTH > 0
+    if (allocated_event == NULL) {
+        grow_event_pool();
+        allocated_event = pop_free_event();
+    }
+#endif
+
+    return allocated_event;
+}
+
 /*
  * Duplicate an event.
  *
@@ -69,15 +179,11 @@ static struct __fwk_signal_ctx fwk_signal_ctx;
  */
 static struct fwk_event *duplicate_event(struct fwk_event *event)
 {
-    struct fwk_event *allocated_event = NULL;
+    struct fwk_event *allocated_event;
 
     fwk_assert(event != NULL);
 
-    fwk_interrupt_global_disable();
-    allocated_event = FWK_LIST_GET(
-        fwk_list_pop_head(&ctx.free_event_queue), struct fwk_event, slist_node);
-    fwk_interrupt_global_enable();
-
+    allocated_event = alloc_event();
     if (allocated_event == NULL) {
         FWK_LOG_CRIT(err_msg_func, FWK_E_NOMEM, __func__);
         fwk_unexpected();
@@ -88,18 +194,206 @@ static struct fwk_event *duplicate_event(struct fwk_event *event)
     *allocated_event = *event;
     allocated_event->slist_node = (struct fwk_slist_node){ 0 };
 
+    fwk_event_payload_acquire(allocated_event->payload);
+
     return allocated_event;
 }
 
-static int put_event(
+/*
+ * Get the queue an event awaiting processing belongs to.
+ *
+ * \param event Pointer to the event.
+ *
+ * \return The queue associated with the priority class of the event.
+ */
+static struct fwk_slist *get_event_queue(const struct fwk_event *event)
+{
+    if (event->priority == FWK_EVENT_PRIORITY_HIGH)
+        return &ctx.high_priority_event_queue;
+
+    return &ctx.event_queue;
+}
+
+/*
+ * Get the queue the next event to process has to be taken from.
+ *
+ * \details High priority events are processed first. A normal priority event
+ *      is however processed after FWK_THREAD_PRIORITY_BURST_MAX high priority
+ *      events in a row to prevent the starvation of normal priority events.
+ *
+ * \return The queue to take the next event from, NULL if no event is awaiting
+ *      processing.
+ */
+static struct fwk_slist *get_next_event_queue(void)
+{
+    bool is_normal_queue_empty = fwk_list_is_empty(&ctx.event_queue);
+
+    if (fwk_list_is_empty(&ctx.high_priority_event_queue))
+        return is_normal_queue_empty ? NULL : &ctx.event_queue;
+
+    if (!is_normal_queue_empty &&
+        (ctx.priority_burst_count >= FWK_THREAD_PRIORITY_BURST_MAX))
+        return &ctx.event_queue;
+
+    return &ctx.high_priority_event_queue;
+}
+
+/*
+ * Pop the next event to process.
+ *
+ * \param queue Queue given by get_next_event_queue().
+ *
+ * \pre \p queue must not be empty.
+ *
+ * \return The next event to process.
+ */
+static struct fwk_event *pop_next_event(struct fwk_slist *queue)
+{
+    if ((queue == &ctx.high_priority_event_queue) &&
+        !fwk_list_is_empty(&ctx.event_queue))
+        ctx.priority_burst_count++;
+    else
+        ctx.priority_burst_count = 0;
+
+    return FWK_LIST_GET(fwk_list_pop_head(queue), struct fwk_event, slist_node);
+}
+
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+static_assert(
+    (FWK_THREAD_ISR_EVENT_RING_CAPACITY &
+     (FWK_THREAD_ISR_EVENT_RING_CAPACITY - 1)) == 0,
+    "FWK_THREAD_ISR_EVENT_RING_CAPACITY must be a power of two");
+
+/*
+ * Push an event raised by an ISR into the ring of its priority level.
+ *
+ * \param event Pointer to the event to push.
+ *
+ * \return true if the event was pushed, false if the current priority level
+ *      has no ring or its ring is full.
+ */
+static bool push_isr_event_ring(const struct fwk_event *event)
+{
+    struct __fwk_isr_event_ring *ring;
+    struct fwk_event *slot;
+    unsigned int priority;
+    unsigned int tail;
+
+    if (fwk_interrupt_get_current_priority(&priority) != FWK_SUCCESS)
+        return false;
+
+    if (priority >= FWK_THREAD_ISR_EVENT_RING_LEVELS)
+        return false;
+
+    ring = &ctx.isr_event_rings[priority];
+    tail = ring->tail;
+
+    if ((tail - ring->head) == FWK_THREAD_ISR_EVENT_RING_CAPACITY)
+        return false;
+
+    slot = &ring->events[tail % FWK_THREAD_ISR_EVENT_RING_CAPACITY];
+    *slot = *event;
+    slot->slist_node = (struct fwk_slist_node){ 0 };
+
+    /* The slot holds its own reference until the thread duplicates it */
+    fwk_event_payload_acquire(slot->payload);
+
+    /* Publish the slot content before the slot itself */
+    atomic_signal_fence(memory_order_release);
+    ring->tail = tail + 1;
+
+    return true;
+}
+
+/*
+ * Move the oldest event of the most urgent non-empty ISR event ring to the
+ * event queue of its priority class.
+ *
+ * \return true if an event was moved, false if all the rings are empty or no
+ *      event structure is free to move the event to.
+ */
+static bool pull_isr_event_ring(void)
+{
+    struct __fwk_isr_event_ring *ring;
+    struct fwk_event *allocated_event, *slot;
+    unsigned int head;
+    unsigned int level;
+
+    for (level = 0; level < FWK_THREAD_ISR_EVENT_RING_LEVELS; level++) {
+        ring = &ctx.isr_event_rings[level];
+        head = ring->head;
+
+        if (head == ring->tail)
+            continue;
+
+        /* Read the slot content only once it has been published */
+        atomic_signal_fence(memory_order_acquire);
+
+        /*
+         * Without a free event structure, the event is left in its ring and
+         * moved on a later pass, once events have been processed and freed.
+         */
+        allocated_event = alloc_event();
+        if (allocated_event == NULL) {
+            if (!ctx.isr_event_ring_stalled) {
+                FWK_LOG_CRIT(err_msg_func, FWK_E_NOMEM, __func__);
+                ctx.isr_event_ring_stalled = true;
+            }
+
+            return false;
+        }
+
+        ctx.isr_event_ring_stalled = false;
+
+        /* The reference of the slot to the payload is handed over */
+        slot = &ring->events[head % FWK_THREAD_ISR_EVENT_RING_CAPACITY];
+        *allocated_event = *slot;
+        allocated_event->slist_node = (struct fwk_slist_node){ 0 };
+
+        /* Hand the slot back to the ISRs */
+        atomic_signal_fence(memory_order_release);
+        ring->head = head + 1;
+
+        fwk_list_push_tail(
+            get_event_queue(allocated_event), &allocated_event->slist_node);
+
+        return true;
+    }
+
+    return false;
+}
+#endif
+
+static FWK_HOT int put_event(
     struct fwk_event *event,
     enum thread_interrupt_states intr_state)
 {
     struct fwk_event *allocated_event;
     unsigned int interrupt;
     bool is_wakeup_event = false;
+    uint32_t cookie;
     int status;
 
+    if (intr_state == UNKNOWN_THREAD) {
+        status = fwk_interrupt_get_current(&interrupt);
+        if (status != FWK_SUCCESS)
+            intr_state = NOT_INTERRUPT_THREAD;
+        else
+            intr_state = INTERRUPT_THREAD;
+    }
+
+#ifdef FWK_EVENT_LATENCY
+    event->timestamp = fwk_time_current();
+#endif
+
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+    if ((intr_state == INTERRUPT_THREAD) && !event->is_delayed_response) {
+        event->cookie = ctx.event_cookie_counter++;
+        if (push_isr_event_ring(event))
+            return FWK_SUCCESS;
+    }
+#endif
+
     if (event->is_delayed_response) {
         allocated_event = __fwk_thread_search_delayed_response(
             event->source_id, event->cookie);
@@ -108,15 +402,24 @@ static int put_event(
             return FWK_E_PARAM;
         }
 
-        fwk_list_remove(
-            __fwk_thread_get_delayed_response_list(event->source_id),
-            &allocated_event->slist_node);
+        __fwk_thread_remove_delayed_response(
+            event->source_id, allocated_event);
 
         memcpy(
             allocated_event->params,
             event->params,
             sizeof(allocated_event->params));
 
+        if (allocated_event->payload != event->payload) {
+            fwk_event_payload_acquire(event->payload);
+            fwk_event_payload_release(allocated_event->payload);
+            allocated_event->payload = event->payload;
+        }
+
+#ifdef FWK_EVENT_LATENCY
+        allocated_event->timestamp = event->timestamp;
+#endif
+
         /* Is this the event put_event_and_wait is waiting for ? */
         if (ctx.waiting_event_processing_completion &&
             (ctx.cookie == event->cookie))
@@ -127,20 +430,19 @@ static int put_event(
             return FWK_E_NOMEM;
     }
 
+    cookie = event->cookie;
     allocated_event->cookie = event->cookie = ctx.event_cookie_counter++;
 
     if (is_wakeup_event)
         ctx.cookie = event->cookie;
 
-    if (intr_state == UNKNOWN_THREAD) {
-        status = fwk_interrupt_get_current(&interrupt);
-        if (status != FWK_SUCCESS)
-            intr_state = NOT_INTERRUPT_THREAD;
-        else
-            intr_state = INTERRUPT_THREAD;
-    }
+    /* A task may be awaiting this response, see fwk_task_await_response() */
+    if (event->is_response)
+        __fwk_task_update_cookie(cookie, event->cookie);
+
     if (intr_state == NOT_INTERRUPT_THREAD)
-        fwk_list_push_tail(&ctx.event_queue, &allocated_event->slist_node);
+        fwk_list_push_tail(
+            get_event_queue(allocated_event), &allocated_event->slist_node);
     else
         fwk_list_push_tail(&ctx.isr_event_queue, &allocated_event->slist_node);
 
@@ -180,29 +482,16 @@ static int execute_signal_handler(fwk_id_t target_id, fwk_id_t signal_id)
 static bool fwk_process_signal()
 {
     struct signal signal;
-    int i = 0;
 
     while (fwk_signal_ctx.pending_signals > 0) {
         fwk_interrupt_global_disable();
-        for (; i < FWK_MODULE_SIGNAL_COUNT; i++) {
-            if (!fwk_id_is_equal(
-                    fwk_signal_ctx.signals[i].target_id, FWK_ID_NONE)) {
-                signal.source_id = fwk_signal_ctx.signals[i].source_id;
-                signal.target_id = fwk_signal_ctx.signals[i].target_id;
-                signal.signal_id = fwk_signal_ctx.signals[i].signal_id;
-                fwk_signal_ctx.current_signal = fwk_signal_ctx.signals[i];
-                break;
-            }
-        }
+        signal = fwk_signal_ctx.signals[fwk_signal_ctx.head];
+        fwk_signal_ctx.current_signal = signal;
+        fwk_signal_ctx.head =
+            (fwk_signal_ctx.head + 1) % FWK_MODULE_SIGNAL_COUNT;
+        fwk_signal_ctx.pending_signals--;
         fwk_interrupt_global_enable();
 
-        if (i == FWK_MODULE_SIGNAL_COUNT) {
-            fwk_signal_ctx.current_signal.target_id = FWK_ID_NONE;
-            return false;
-        }
-
-        fwk_signal_ctx.pending_signals--;
-        fwk_signal_ctx.signals[i].target_id = FWK_ID_NONE;
         execute_signal_handler(signal.target_id, signal.signal_id);
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_TRACE
@@ -213,26 +502,41 @@ static bool fwk_process_signal()
 #endif
     }
 
+    fwk_signal_ctx.current_signal.target_id = FWK_ID_NONE;
+
     return true;
 }
 
 static void free_event(struct fwk_event *event)
 {
+    fwk_event_payload_release(event->payload);
+
     fwk_interrupt_global_disable();
+    ctx.free_event_count++;
     fwk_list_push_tail(&ctx.free_event_queue, &event->slist_node);
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+    /* A stalled ISR event ring can be drained again */
+    ctx.isr_event_ring_stalled = false;
+#endif
     fwk_interrupt_global_enable();
 }
 
-static void process_next_event(void)
+static FWK_HOT void process_next_event(void)
 {
     int status;
     struct fwk_event *event, *allocated_event, async_response_event = { 0 };
+    struct fwk_module_ctx *module_ctx;
     const struct fwk_module *module;
     int (*process_event)(
         const struct fwk_event *event, struct fwk_event *resp_event);
+#ifdef FWK_EVENT_LATENCY
+    fwk_timestamp_t dispatch_timestamp;
+#endif
+#ifdef FWK_EVENT_BUDGET
+    fwk_timestamp_t budget_timestamp;
+#endif
 
-    ctx.current_event = event = FWK_LIST_GET(
-        fwk_list_pop_head(&ctx.event_queue), struct fwk_event, slist_node);
+    ctx.current_event = event = pop_next_event(get_next_event_queue());
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_TRACE
     FWK_LOG_TRACE(
@@ -243,7 +547,30 @@ static void process_next_event(void)
         FWK_ID_STR(event->target_id));
 #endif
 
-    module = fwk_module_get_ctx(event->target_id)->desc;
+    /* A response awaited by a task is handed over to it */
+    if (event->is_response && __fwk_task_put_response(event)) {
+        ctx.current_event = NULL;
+        free_event(event);
+        return;
+    }
+
+#ifdef BUILD_HAS_NOTIFICATION
+    /* The responses to a collected notification are counted by the framework */
+    if (event->is_response && event->is_notification &&
+        __fwk_notification_collect_response(event)) {
+        ctx.current_event = NULL;
+        free_event(event);
+        return;
+    }
+#endif
+
+    module_ctx = fwk_module_get_ctx(event->target_id);
+
+    /* A deferred module is started before it processes its first event */
+    if (module_ctx->state == FWK_MODULE_STATE_BOUND)
+        __fwk_module_start_deferred(event->target_id);
+
+    module = module_ctx->desc;
     process_event = event->is_notification ? module->process_notification :
                                              module->process_event;
 
@@ -253,7 +580,26 @@ static void process_next_event(void)
         async_response_event.target_id = event->source_id;
         async_response_event.is_delayed_response = false;
 
+        /* The response owns a reference to its payload, see fwk_event */
+        fwk_event_payload_acquire(async_response_event.payload);
+
+#ifdef FWK_EVENT_LATENCY
+        dispatch_timestamp = fwk_time_current();
+#endif
+
+#ifdef FWK_EVENT_BUDGET
+        budget_timestamp = fwk_time_profile_current();
+#endif
+
         status = process_event(event, &async_response_event);
+
+#ifdef FWK_EVENT_BUDGET
+        __fwk_latency_check_budget(event, budget_timestamp);
+#endif
+#ifdef FWK_EVENT_LATENCY
+        __fwk_latency_record(event, dispatch_timestamp);
+#endif
+
         if (status != FWK_SUCCESS)
             FWK_LOG_CRIT(err_msg_line, status, __func__, __LINE__);
 
@@ -264,14 +610,30 @@ static void process_next_event(void)
         else {
             allocated_event = duplicate_event(&async_response_event);
             if (allocated_event != NULL) {
-                fwk_list_push_tail(
-                    __fwk_thread_get_delayed_response_list(
-                        async_response_event.source_id),
-                    &allocated_event->slist_node);
+                __fwk_thread_add_delayed_response(
+                    async_response_event.source_id, allocated_event);
             }
         }
+
+        fwk_event_payload_release(async_response_event.payload);
     } else {
+#ifdef FWK_EVENT_LATENCY
+        dispatch_timestamp = fwk_time_current();
+#endif
+
+#ifdef FWK_EVENT_BUDGET
+        budget_timestamp = fwk_time_profile_current();
+#endif
+
         status = process_event(event, &async_response_event);
+
+#ifdef FWK_EVENT_BUDGET
+        __fwk_latency_check_budget(event, budget_timestamp);
+#endif
+#ifdef FWK_EVENT_LATENCY
+        __fwk_latency_record(event, dispatch_timestamp);
+#endif
+
         if ((status != FWK_SUCCESS) && (status != FWK_PENDING)) {
             FWK_LOG_CRIT(
                 "[FWK] Process event (%s: %s -> %s) (%d)\n",
@@ -291,6 +653,11 @@ static bool process_isr(void)
 {
     struct fwk_event *isr_event;
 
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+    if (pull_isr_event_ring())
+        return true;
+#endif
+
     fwk_interrupt_global_disable();
     isr_event = FWK_LIST_GET(
         fwk_list_pop_head(&ctx.isr_event_queue), struct fwk_event, slist_node);
@@ -307,11 +674,75 @@ static bool process_isr(void)
         FWK_ID_STR(isr_event->target_id));
 #endif
 
-    fwk_list_push_tail(&ctx.event_queue, &isr_event->slist_node);
+    fwk_list_push_tail(get_event_queue(isr_event), &isr_event->slist_node);
 
     return true;
 }
 
+/*
+ * Run the next task ready to run until it waits, yields or returns.
+ */
+static bool process_task(void)
+{
+    struct fwk_task *task;
+    struct fwk_event task_event = { 0 };
+
+    task = __fwk_task_pop_ready();
+    if (task == NULL)
+        return false;
+
+    /* The events put by the task are sourced from its entity */
+    task_event.source_id = task->id;
+    task_event.target_id = task->id;
+
+    ctx.current_event = &task_event;
+    __fwk_task_resume(task);
+    ctx.current_event = NULL;
+
+    return true;
+}
+
+/*
+ * Check whether an interrupt service routine has raised an event or a signal
+ * that is still awaiting processing. The events of stalled ISR event rings
+ * cannot be processed before an event structure is freed, and do not count.
+ */
+static bool is_isr_work_pending(void)
+{
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+    for (unsigned int i = 0; i < FWK_THREAD_ISR_EVENT_RING_LEVELS; i++) {
+        if (!ctx.isr_event_ring_stalled &&
+            (ctx.isr_event_rings[i].head != ctx.isr_event_rings[i].tail))
+            return true;
+    }
+#endif
+
+    return !fwk_list_is_empty(&ctx.isr_event_queue) ||
+        (fwk_signal_ctx.pending_signals > 0);
+}
+
+/*
+ * Enter the low-power state chosen by the idle driver, if any, until an
+ * interrupt is pending.
+ */
+static void process_idle(void)
+{
+    if (ctx.idle_driver.idle == NULL)
+        return;
+
+    /* Any pending interrupt must bring the idle driver back */
+    fwk_interrupt_global_disable_all();
+
+    /*
+     * An interrupt may have raised more work after the queues were checked, so
+     * check again now that interrupts cannot preempt the idle driver.
+     */
+    if (!is_isr_work_pending())
+        ctx.idle_driver.idle(ctx.idle_driver_ctx);
+
+    fwk_interrupt_global_enable();
+}
+
 /*
  * Private interface functions
  */
@@ -319,18 +750,41 @@ static bool process_isr(void)
 int __fwk_thread_init(size_t event_count)
 {
     struct fwk_event *event_table, *event;
+    int status;
     int i;
 
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+    event = fwk_mm_calloc(
+        FWK_THREAD_ISR_EVENT_RING_LEVELS * FWK_THREAD_ISR_EVENT_RING_CAPACITY,
+        sizeof(struct fwk_event));
+
+    for (i = 0; i < FWK_THREAD_ISR_EVENT_RING_LEVELS; i++) {
+        ctx.isr_event_rings[i] = (struct __fwk_isr_event_ring){
+            .events = &event[i * FWK_THREAD_ISR_EVENT_RING_CAPACITY],
+        };
+    }
+#endif
+
+    status = __fwk_thread_delayed_response_init(event_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
     event_table = fwk_mm_calloc(event_count, sizeof(struct fwk_event));
 
     /* All the event structures are free to be used. */
     fwk_list_init(&ctx.free_event_queue);
     fwk_list_init(&ctx.event_queue);
+    fwk_list_init(&ctx.high_priority_event_queue);
     fwk_list_init(&ctx.isr_event_queue);
+    ctx.priority_burst_count = 0;
 
     for (event = event_table; event < (event_table + event_count); event++)
         fwk_list_push_tail(&ctx.free_event_queue, &event->slist_node);
 
+    ctx.event_count = event_count;
+    ctx.free_event_count = event_count;
+    ctx.free_event_low_water = event_count;
+
     for (i = 0; i < FWK_MODULE_SIGNAL_COUNT; i++) {
         fwk_signal_ctx.signals[i].source_id = FWK_ID_NONE;
         fwk_signal_ctx.signals[i].target_id = FWK_ID_NONE;
@@ -338,6 +792,10 @@ int __fwk_thread_init(size_t event_count)
     };
     fwk_signal_ctx.current_signal.target_id = FWK_ID_NONE;
     fwk_signal_ctx.pending_signals = 0;
+    fwk_signal_ctx.head = 0;
+
+    ctx.idle_driver = fmw_thread_idle_driver(&ctx.idle_driver_ctx);
+
     ctx.initialized = true;
 
     return FWK_SUCCESS;
@@ -348,7 +806,7 @@ noreturn void __fwk_thread_run(void)
     for (;;) {
         fwk_process_signal();
 
-        while (!fwk_list_is_empty(&ctx.event_queue)) {
+        while (get_next_event_queue() != NULL) {
             process_next_event();
             fwk_process_signal();
         }
@@ -356,7 +814,16 @@ noreturn void __fwk_thread_run(void)
         if (process_isr())
             continue;
 
-        fwk_log_unbuffer();
+        if (process_task())
+            continue;
+
+        if (__fwk_module_start_next_deferred())
+            continue;
+
+        if (fwk_log_unbuffer() != FWK_SUCCESS)
+            continue;
+
+        process_idle();
     }
 }
 
@@ -464,8 +931,12 @@ int fwk_thread_put_event_and_wait(
     struct fwk_event response_event;
     struct fwk_event *next_event;
     struct fwk_event *allocated_event;
+    struct fwk_slist *event_queue;
     int status = FWK_E_PARAM;
     enum wait_states wait_state = WAITING_FOR_EVENT;
+#ifdef FWK_EVENT_LATENCY
+    fwk_timestamp_t dispatch_timestamp;
+#endif
 #ifdef BUILD_MODE_DEBUG
     unsigned int interrupt;
 
@@ -534,14 +1005,15 @@ int fwk_thread_put_event_and_wait(
 
     for (;;) {
         fwk_process_signal();
-        if (fwk_list_is_empty(&ctx.event_queue)) {
+        event_queue = get_next_event_queue();
+        if (event_queue == NULL) {
             fwk_process_signal();
             process_isr();
             continue;
         }
 
         ctx.current_event = next_event = FWK_LIST_GET(
-            fwk_list_head(&ctx.event_queue), struct fwk_event, slist_node);
+            fwk_list_head(event_queue), struct fwk_event, slist_node);
 
         if (next_event->cookie != ctx.cookie) {
             /*
@@ -553,8 +1025,7 @@ int fwk_thread_put_event_and_wait(
         }
 
         /* This is either the original event or the response event */
-        next_event = FWK_LIST_GET(
-            fwk_list_pop_head(&ctx.event_queue), struct fwk_event, slist_node);
+        next_event = pop_next_event(event_queue);
 
         if (wait_state == WAITING_FOR_EVENT) {
             module = fwk_module_get_ctx(next_event->target_id)->desc;
@@ -565,10 +1036,24 @@ int fwk_thread_put_event_and_wait(
             response_event.target_id = next_event->source_id;
             response_event.is_delayed_response = false;
 
+            /* The response owns a reference to its payload, see fwk_event */
+            fwk_event_payload_acquire(response_event.payload);
+
             /* Execute the event handler */
+#ifdef FWK_EVENT_LATENCY
+            dispatch_timestamp = fwk_time_current();
+#endif
+
             status = process_event(next_event, &response_event);
-            if (status != FWK_SUCCESS)
+
+#ifdef FWK_EVENT_LATENCY
+            __fwk_latency_record(next_event, dispatch_timestamp);
+#endif
+
+            if (status != FWK_SUCCESS) {
+                fwk_event_payload_release(response_event.payload);
                 goto exit;
+            }
 
             /*
              * The response event goes onto the queue now
@@ -579,16 +1064,16 @@ int fwk_thread_put_event_and_wait(
             response_event.response_requested = false;
             if (!response_event.is_delayed_response) {
                 status = put_event(&response_event, UNKNOWN_THREAD);
+                fwk_event_payload_release(response_event.payload);
                 if (status != FWK_SUCCESS)
                     goto exit;
                 ctx.cookie = response_event.cookie;
             } else {
                 allocated_event = duplicate_event(&response_event);
+                fwk_event_payload_release(response_event.payload);
                 if (allocated_event != NULL) {
-                    fwk_list_push_head(
-                        __fwk_thread_get_delayed_response_list(
-                            response_event.source_id),
-                        &allocated_event->slist_node);
+                    __fwk_thread_add_delayed_response_head(
+                        response_event.source_id, allocated_event);
                 } else {
                     status = FWK_E_NOMEM;
                     goto exit;
@@ -616,6 +1101,8 @@ int fwk_thread_put_event_and_wait(
                 resp_event->params,
                 next_event->params,
                 sizeof(resp_event->params));
+            resp_event->payload = next_event->payload;
+            fwk_event_payload_acquire(resp_event->payload);
             free_event(next_event);
             status = FWK_SUCCESS;
             goto exit;
@@ -640,30 +1127,76 @@ int fwk_thread_put_signal(
     const fwk_id_t target_id,
     fwk_id_t signal_id)
 {
-    int signal_idx;
+    struct signal *signal;
 
     fwk_interrupt_global_disable();
 
-    /*
-     * Find an available slot in the signals array
-     */
-    for (signal_idx = 0; signal_idx < FWK_MODULE_SIGNAL_COUNT; signal_idx++) {
-        if (fwk_id_is_equal(
-                fwk_signal_ctx.signals[signal_idx].target_id, FWK_ID_NONE)) {
-            fwk_signal_ctx.signals[signal_idx].source_id = source_id;
-            fwk_signal_ctx.signals[signal_idx].target_id = target_id;
-            fwk_signal_ctx.signals[signal_idx].signal_id = signal_id;
-            break;
-        }
-    }
-
-    if (signal_idx == FWK_MODULE_SIGNAL_COUNT) {
+    if (fwk_signal_ctx.pending_signals == FWK_MODULE_SIGNAL_COUNT) {
         fwk_interrupt_global_enable();
         return FWK_E_BUSY;
     }
 
+    /*
+     * Append the signal after the last pending one
+     */
+    signal = &fwk_signal_ctx.signals
+                  [(fwk_signal_ctx.head +
+                    (unsigned int)fwk_signal_ctx.pending_signals) %
+                   FWK_MODULE_SIGNAL_COUNT];
+    signal->source_id = source_id;
+    signal->target_id = target_id;
+    signal->signal_id = signal_id;
+
     fwk_signal_ctx.pending_signals++;
     fwk_interrupt_global_enable();
 
     return FWK_SUCCESS;
 }
+
+static size_t get_queue_depth(const struct fwk_slist *queue)
+{
+    const struct fwk_slist_node *node;
+    size_t depth = 0;
+
+    for (node = queue->head; node != (const struct fwk_slist_node *)queue;
+         node = node->next)
+        depth++;
+
+    return depth;
+}
+
+int fwk_thread_get_queue_stats(struct fwk_thread_queue_stats *stats)
+{
+    if (stats == NULL)
+        return FWK_E_PARAM;
+
+    fwk_interrupt_global_disable();
+
+    stats->high_priority = get_queue_depth(&ctx.high_priority_event_queue);
+    stats->normal = get_queue_depth(&ctx.event_queue);
+    stats->isr = get_queue_depth(&ctx.isr_event_queue);
+
+#if FWK_THREAD_ISR_EVENT_RING_LEVELS > 0
+    for (unsigned int i = 0; i < FWK_THREAD_ISR_EVENT_RING_LEVELS; i++) {
+        stats->isr +=
+            ctx.isr_event_rings[i].tail - ctx.isr_event_rings[i].head;
+    }
+#endif
+
+    stats->free = ctx.free_event_count;
+    stats->free_low_water = ctx.free_event_low_water;
+    stats->capacity = ctx.event_count;
+    stats->peak_used = ctx.used_event_peak;
+    stats->grown = ctx.grown_event_count;
+
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
+
+FWK_WEAK struct fwk_thread_idle_driver fmw_thread_idle_driver(const void **ctx)
+{
+    return (struct fwk_thread_idle_driver){
+        .idle = NULL,
+    };
+}
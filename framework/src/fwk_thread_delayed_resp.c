@@ -7,13 +7,18 @@
 
 #include <internal/fwk_module.h>
 
+#include <internal/fwk_thread_delayed_resp.h>
+
+#include <fwk_assert.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_list.h>
 #include <fwk_log.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 
 #include <stdbool.h>
 #include <stddef.h>
@@ -21,6 +26,30 @@
 
 static const char err_msg_func[] = "[FWK] Error %d in %s";
 
+/*
+ * Index of the outstanding delayed responses, keyed by cookie.
+ *
+ * The index is an open-addressed table using linear probing. Its size is a
+ * power of two at least twice the size of the event pool, delayed responses
+ * being pool events, so that it never fills up and probe sequences remain
+ * short. It is grown and rehashed along with the event pool. Cookies are
+ * allocated sequentially and their low-order bits are thus used directly as
+ * hash.
+ */
+static struct {
+    /* Table of delayed response events, NULL for empty slots */
+    struct fwk_event **table;
+
+    /* Number of slots in the table minus one */
+    size_t mask;
+
+    /* Number of outstanding delayed responses */
+    size_t count;
+
+    /* Highest number of outstanding delayed responses */
+    size_t peak_count;
+} index_ctx;
+
 /*
  * Static functions
  */
@@ -37,9 +66,145 @@ static int check_api_call(fwk_id_t id, void *data)
     return FWK_SUCCESS;
 }
 
+static size_t index_home_slot(uint32_t cookie)
+{
+    return (size_t)cookie & index_ctx.mask;
+}
+
+static size_t index_next_slot(size_t slot)
+{
+    return (slot + 1) & index_ctx.mask;
+}
+
+static void index_insert(struct fwk_event *event)
+{
+    size_t slot = index_home_slot(event->cookie);
+
+    while (index_ctx.table[slot] != NULL)
+        slot = index_next_slot(slot);
+
+    index_ctx.table[slot] = event;
+
+    if (++index_ctx.count > index_ctx.peak_count)
+        index_ctx.peak_count = index_ctx.count;
+}
+
+static void index_remove(const struct fwk_event *event)
+{
+    size_t hole, slot, home;
+
+    hole = index_home_slot(event->cookie);
+    while (index_ctx.table[hole] != event) {
+        fwk_assert(index_ctx.table[hole] != NULL);
+        hole = index_next_slot(hole);
+    }
+
+    index_ctx.table[hole] = NULL;
+    index_ctx.count--;
+
+    /*
+     * Shift back the entries following the hole that would no longer be
+     * reachable from their home slot, so that no tombstone is needed.
+     */
+    for (slot = index_next_slot(hole); index_ctx.table[slot] != NULL;
+         slot = index_next_slot(slot)) {
+        home = index_home_slot(index_ctx.table[slot]->cookie);
+
+        if ((hole <= slot) ? ((home > hole) && (home <= slot)) :
+                             ((home > hole) || (home <= slot)))
+            continue;
+
+        index_ctx.table[hole] = index_ctx.table[slot];
+        index_ctx.table[slot] = NULL;
+        hole = slot;
+    }
+}
+
 /*
  * Internal interface functions for use by framework only
  */
+static size_t index_size(size_t event_count)
+{
+    size_t size = 1;
+
+    while (size < (2 * event_count))
+        size <<= 1;
+
+    return size;
+}
+
+int __fwk_thread_delayed_response_init(size_t event_count)
+{
+    size_t size = index_size(event_count);
+
+    index_ctx.table = fwk_mm_calloc(size, sizeof(index_ctx.table[0]));
+    index_ctx.mask = size - 1;
+    index_ctx.count = 0;
+    index_ctx.peak_count = 0;
+
+    return FWK_SUCCESS;
+}
+
+int __fwk_thread_delayed_response_grow(size_t event_count)
+{
+    struct fwk_event **old_table = index_ctx.table;
+    size_t old_size = index_ctx.mask + 1;
+    size_t size = index_size(event_count);
+    size_t slot;
+
+    if ((old_table == NULL) || (size <= old_size))
+        return FWK_SUCCESS;
+
+    index_ctx.table = fwk_mm_alloc_notrap(size, sizeof(index_ctx.table[0]));
+    if (index_ctx.table == NULL) {
+        index_ctx.table = old_table;
+        return FWK_E_NOMEM;
+    }
+
+    for (slot = 0; slot < size; slot++)
+        index_ctx.table[slot] = NULL;
+
+    index_ctx.mask = size - 1;
+    index_ctx.count = 0;
+
+    for (slot = 0; slot < old_size; slot++) {
+        if (old_table[slot] != NULL)
+            index_insert(old_table[slot]);
+    }
+
+    fwk_mm_free(old_table);
+
+    return FWK_SUCCESS;
+}
+
+void __fwk_thread_add_delayed_response(fwk_id_t id, struct fwk_event *event)
+{
+    fwk_list_push_tail(
+        __fwk_thread_get_delayed_response_list(id), &event->slist_node);
+
+    index_insert(event);
+}
+
+void __fwk_thread_add_delayed_response_head(
+    fwk_id_t id,
+    struct fwk_event *event)
+{
+    fwk_list_push_head(
+        __fwk_thread_get_delayed_response_list(id), &event->slist_node);
+
+    index_insert(event);
+}
+
+void __fwk_thread_remove_delayed_response(
+    fwk_id_t id,
+    struct fwk_event *event)
+{
+    index_remove(event);
+
+    fwk_list_remove(
+        __fwk_thread_get_delayed_response_list(id), &event->slist_node);
+}
+
 struct fwk_slist *__fwk_thread_get_delayed_response_list(fwk_id_t id)
 {
     if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
@@ -52,21 +217,19 @@ struct fwk_event *__fwk_thread_search_delayed_response(
     fwk_id_t id,
     uint32_t cookie)
 {
-    struct fwk_slist *delayed_response_list;
-    struct fwk_slist_node *delayed_response_node;
     struct fwk_event *delayed_response;
+    size_t slot;
 
-    delayed_response_list = __fwk_thread_get_delayed_response_list(id);
-    delayed_response_node = fwk_list_head(delayed_response_list);
+    if (index_ctx.table == NULL)
+        return NULL;
 
-    while (delayed_response_node != NULL) {
-        delayed_response =
-            FWK_LIST_GET(delayed_response_node, struct fwk_event, slist_node);
-        if (delayed_response->cookie == cookie)
-            return delayed_response;
+    for (slot = index_home_slot(cookie); index_ctx.table[slot] != NULL;
+         slot = index_next_slot(slot)) {
+        delayed_response = index_ctx.table[slot];
 
-        delayed_response_node =
-            fwk_list_next(delayed_response_list, delayed_response_node);
+        if ((delayed_response->cookie == cookie) &&
+            fwk_id_is_equal(delayed_response->source_id, id))
+            return delayed_response;
     }
 
     return NULL;
@@ -153,3 +316,14 @@ error:
     FWK_LOG_CRIT(err_msg_func, status, __func__);
     return status;
 }
+
+int fwk_thread_get_delayed_response_count(size_t *count, size_t *peak_count)
+{
+    if ((count == NULL) || (peak_count == NULL))
+        return FWK_E_PARAM;
+
+    *count = index_ctx.count;
+    *peak_count = index_ctx.peak_count;
+
+    return FWK_SUCCESS;
+}
@@ -15,13 +15,33 @@
 struct {
     struct fwk_time_driver driver; /* Time driver */
     const void *driver_ctx; /* Time driver context */
+
+    struct fwk_time_profile_driver profile_driver; /* Profiling time driver */
+    const void *profile_driver_ctx; /* Profiling time driver context */
+    uint32_t profile_last; /* Last value read from the cycle counter */
+    uint64_t profile_cycles; /* Cycle count, accounting for wrap-arounds */
 } fwk_time_ctx;
 
 FWK_CONSTRUCTOR void fwk_time_init(void)
 {
     struct fwk_time_driver driver = fmw_time_driver(&fwk_time_ctx.driver_ctx);
+    struct fwk_time_profile_driver profile_driver =
+        fmw_time_profile_driver(&fwk_time_ctx.profile_driver_ctx);
 
     memcpy(&fwk_time_ctx.driver, &driver, sizeof(driver));
+
+    if (profile_driver.frequency == 0)
+        profile_driver.cycles = NULL;
+
+    memcpy(
+        &fwk_time_ctx.profile_driver,
+        &profile_driver,
+        sizeof(profile_driver));
+
+    if (profile_driver.cycles != NULL) {
+        fwk_time_ctx.profile_last =
+            profile_driver.cycles(fwk_time_ctx.profile_driver_ctx);
+    }
 }
 
 fwk_timestamp_t fwk_time_current(void)
@@ -32,6 +52,30 @@ fwk_timestamp_t fwk_time_current(void)
     return fwk_time_ctx.driver.timestamp(fwk_time_ctx.driver_ctx);
 }
 
+fwk_timestamp_t fwk_time_profile_current(void)
+{
+    const struct fwk_time_profile_driver *driver =
+        &fwk_time_ctx.profile_driver;
+    uint64_t cycles;
+    uint32_t value;
+
+    if (driver->cycles == NULL)
+        return fwk_time_current();
+
+    /* The unsigned difference accounts for a wrap-around of the counter */
+    value = driver->cycles(fwk_time_ctx.profile_driver_ctx);
+    fwk_time_ctx.profile_cycles +=
+        (uint32_t)(value - fwk_time_ctx.profile_last);
+    fwk_time_ctx.profile_last = value;
+
+    /* Scale in two steps to not overflow on long uptimes */
+    cycles = fwk_time_ctx.profile_cycles;
+
+    return FWK_NS(
+        ((cycles / driver->frequency) * FWK_S(1)) +
+        (((cycles % driver->frequency) * FWK_S(1)) / driver->frequency));
+}
+
 fwk_duration_ns_t fwk_time_stamp_duration(fwk_timestamp_t timestamp)
 {
     return FWK_NS(timestamp);
@@ -75,3 +119,11 @@ FWK_WEAK struct fwk_time_driver fmw_time_driver(const void **ctx)
         .timestamp = NULL,
     };
 }
+
+FWK_WEAK struct fwk_time_profile_driver fmw_time_profile_driver(
+    const void **ctx)
+{
+    return (struct fwk_time_profile_driver){
+        .cycles = NULL,
+    };
+}
@@ -0,0 +1,58 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Basic block counting harness of the performance tests. This file is built
+ *     without the code coverage instrumentation, the hook would otherwise call
+ *     itself.
+ */
+
+#include <fwk_test_perf.h>
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+static bool counting;
+static uint64_t block_count;
+
+/* Called by the instrumentation on entry to every basic block */
+void __sanitizer_cov_trace_pc(void)
+{
+    if (counting)
+        block_count++;
+}
+
+void fwk_test_perf_start(void)
+{
+    block_count = 0;
+    counting = true;
+}
+
+uint64_t fwk_test_perf_stop(void)
+{
+    counting = false;
+
+    return block_count;
+}
+
+bool fwk_test_perf_check(
+    const char *name,
+    uint64_t count,
+    unsigned int operations,
+    unsigned int bound)
+{
+    uint64_t cost = count / operations;
+
+    printf(
+        "    %s: %" PRIu64 " blocks per operation, bound %u\n",
+        name,
+        cost,
+        bound);
+
+    return cost <= bound;
+}
@@ -0,0 +1,74 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FWK_TEST_PERF_H
+#define FWK_TEST_PERF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupLibFramework Framework
+ * \{
+ */
+
+/*!
+ * \addtogroup GroupTest Test
+ *
+ * \{
+ */
+
+/*!
+ * \brief Start counting the basic blocks executed.
+ *
+ * \details Performance tests are built with the code coverage instrumentation
+ *      of the compiler, which calls the harness on entry to every basic block.
+ *      Unlike a cycle counter, the number of basic blocks a scenario executes
+ *      does not depend on the machine running the tests nor on its load, so a
+ *      performance test gives the same result on every run.
+ *
+ * \return None.
+ */
+void fwk_test_perf_start(void);
+
+/*!
+ * \brief Stop counting the basic blocks executed.
+ *
+ * \return Number of basic blocks executed since ::fwk_test_perf_start().
+ */
+uint64_t fwk_test_perf_stop(void);
+
+/*!
+ * \brief Check the cost of an operation against its upper bound.
+ *
+ * \details The cost of one operation is printed so that the bounds can be
+ *      tuned, and so that a change of cost shows in the test logs before it
+ *      reaches the bound.
+ *
+ * \param name Name of the operation.
+ * \param count Number of basic blocks executed by the operations.
+ * \param operations Number of operations executed.
+ * \param bound Highest number of basic blocks allowed per operation.
+ *
+ * \retval true The cost of the operation is within its bound.
+ * \retval false The cost of the operation exceeds its bound.
+ */
+bool fwk_test_perf_check(
+    const char *name,
+    uint64_t count,
+    unsigned int operations,
+    unsigned int bound);
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* FWK_TEST_PERF_H */
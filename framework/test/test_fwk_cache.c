@@ -0,0 +1,93 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_cache.h>
+#include <fwk_macros.h>
+#include <fwk_test.h>
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static uint32_t buffer[16];
+
+static unsigned int clean_count;
+static unsigned int invalidate_count;
+static uintptr_t last_address;
+static size_t last_size;
+
+static void clean(uintptr_t address, size_t size)
+{
+    clean_count++;
+    last_address = address;
+    last_size = size;
+}
+
+static void invalidate(uintptr_t address, size_t size)
+{
+    invalidate_count++;
+    last_address = address;
+    last_size = size;
+}
+
+struct fwk_cache_driver fmw_cache_driver(void)
+{
+    return (struct fwk_cache_driver){
+        .clean = clean,
+        .invalidate = invalidate,
+    };
+}
+
+static void test_case_setup(void)
+{
+    clean_count = 0;
+    invalidate_count = 0;
+    last_address = 0;
+    last_size = 0;
+}
+
+static void test_fwk_cache_clean(void)
+{
+    fwk_cache_clean(&buffer[2], sizeof(buffer[2]));
+
+    assert(clean_count == 1);
+    assert(invalidate_count == 0);
+    assert(last_address == (uintptr_t)&buffer[2]);
+    assert(last_size == sizeof(buffer[2]));
+}
+
+static void test_fwk_cache_invalidate(void)
+{
+    fwk_cache_invalidate(buffer, sizeof(buffer));
+
+    assert(clean_count == 0);
+    assert(invalidate_count == 1);
+    assert(last_address == (uintptr_t)buffer);
+    assert(last_size == sizeof(buffer));
+}
+
+static void test_fwk_cache_empty_range(void)
+{
+    fwk_cache_clean(buffer, 0);
+    fwk_cache_invalidate(buffer, 0);
+
+    assert(clean_count == 0);
+    assert(invalidate_count == 0);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_cache_clean),
+    FWK_TEST_CASE(test_fwk_cache_invalidate),
+    FWK_TEST_CASE(test_fwk_cache_empty_range),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_cache",
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,99 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_event.h>
+#include <fwk_macros.h>
+#include <fwk_status.h>
+#include <fwk_test.h>
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define PAYLOAD_COUNT 2
+
+void *__wrap_fwk_mm_calloc(size_t num, size_t size)
+{
+    return calloc(num, size);
+}
+
+static int test_suite_setup(void)
+{
+    /* The pool is empty until buffers are reserved */
+    if (fwk_event_payload_alloc() != NULL)
+        return FWK_E_STATE;
+
+    fwk_event_payload_reserve(PAYLOAD_COUNT);
+
+    return FWK_SUCCESS;
+}
+
+static void test_fwk_event_payload_alloc(void)
+{
+    unsigned char *a, *b;
+
+    a = fwk_event_payload_alloc();
+    b = fwk_event_payload_alloc();
+
+    assert((a != NULL) && (b != NULL) && (a != b));
+    assert(((uintptr_t)a % alignof(max_align_t)) == 0);
+    assert(((uintptr_t)b % alignof(max_align_t)) == 0);
+
+    /* Both buffers span the whole payload size */
+    a[FWK_EVENT_PAYLOAD_SIZE - 1] = 0xA;
+    b[0] = 0xB;
+    assert(a[FWK_EVENT_PAYLOAD_SIZE - 1] == 0xA);
+
+    /* The pool is exhausted */
+    assert(fwk_event_payload_alloc() == NULL);
+
+    fwk_event_payload_release(a);
+    fwk_event_payload_release(b);
+}
+
+static void test_fwk_event_payload_refcount(void)
+{
+    void *a, *b, *c;
+
+    a = fwk_event_payload_alloc();
+    b = fwk_event_payload_alloc();
+
+    fwk_event_payload_acquire(a);
+    fwk_event_payload_release(a);
+
+    /* One reference is left */
+    assert(fwk_event_payload_alloc() == NULL);
+
+    fwk_event_payload_release(a);
+
+    c = fwk_event_payload_alloc();
+    assert(c == a);
+
+    fwk_event_payload_release(b);
+    fwk_event_payload_release(c);
+}
+
+static void test_fwk_event_payload_null(void)
+{
+    fwk_event_payload_acquire(NULL);
+    fwk_event_payload_release(NULL);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_event_payload_alloc),
+    FWK_TEST_CASE(test_fwk_event_payload_refcount),
+    FWK_TEST_CASE(test_fwk_event_payload_null),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_event",
+    .test_suite_setup = test_suite_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -13,6 +13,7 @@
 #include <fwk_status.h>
 #include <fwk_test.h>
 
+#include <limits.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -36,6 +37,9 @@ static int get_current_return_val;
 static unsigned int global_enable_call_count;
 static unsigned int global_disable_call_count;
 
+/* Most urgent priority level masked, UINT_MAX when none is */
+static unsigned int masked_priority = UINT_MAX;
+
 static void fake_isr(void)
 {
     return;
@@ -137,6 +141,40 @@ static const struct fwk_arch_interrupt_driver driver = {
     .get_current = get_current,
 };
 
+static int mask_priority(unsigned int priority, unsigned int *state)
+{
+    *state = masked_priority;
+    masked_priority = FWK_MIN(masked_priority, priority);
+
+    return FWK_SUCCESS;
+}
+
+static int unmask_priority(unsigned int state)
+{
+    masked_priority = state;
+
+    return FWK_SUCCESS;
+}
+
+static const struct fwk_arch_interrupt_driver driver_priority = {
+    .global_enable = global_enable,
+    .global_disable = global_disable,
+    .is_enabled = is_enabled,
+    .enable = enable,
+    .disable = disable,
+    .is_pending = is_pending,
+    .set_pending = set_pending,
+    .clear_pending = clear_pending,
+    .set_isr_irq = set_isr,
+    .set_isr_irq_param = set_isr_param,
+    .set_isr_nmi = set_isr_nmi,
+    .set_isr_nmi_param = set_isr_nmi_param,
+    .set_isr_fault = set_isr_fault,
+    .get_current = get_current,
+    .mask_priority = mask_priority,
+    .unmask_priority = unmask_priority,
+};
+
 static const struct fwk_arch_interrupt_driver driver_invalid = {};
 
 static void test_case_setup(void)
@@ -198,6 +236,15 @@ static void test_fwk_interrupt_before_init(void)
 
     result = fwk_interrupt_get_current(&interrupt);
     assert(result == FWK_E_INIT);
+
+    result = fwk_interrupt_get_current_priority(&interrupt);
+    assert(result == FWK_E_INIT);
+
+    result = fwk_interrupt_mask_priority(1, &interrupt);
+    assert(result == FWK_E_INIT);
+
+    result = fwk_interrupt_unmask_priority(0);
+    assert(result == FWK_E_INIT);
 }
 
 static void test_fwk_interrupt_init(void)
@@ -345,6 +392,19 @@ static void test_fwk_interrupt_get_current(void)
     assert(result == FWK_SUCCESS);
 }
 
+static void test_fwk_interrupt_get_current_priority(void)
+{
+    int result;
+    unsigned int priority;
+
+    result = fwk_interrupt_get_current_priority(NULL);
+    assert(result == FWK_E_PARAM);
+
+    /* The driver does not report priority levels */
+    result = fwk_interrupt_get_current_priority(&priority);
+    assert(result == FWK_E_SUPPORT);
+}
+
 static void test_fwk_interrupt_nested_critical_section(void)
 {
     fwk_interrupt_global_disable();
@@ -366,6 +426,79 @@ static void test_fwk_interrupt_nested_critical_section(void)
     assert(global_enable_call_count == 1);
 }
 
+static void test_fwk_interrupt_mask_priority(void)
+{
+    struct fwk_arch_interrupt_driver driver_partial = driver;
+    unsigned int outer, inner;
+    int result;
+
+    /* The driver does not mask priority levels */
+    result = fwk_interrupt_mask_priority(1, &outer);
+    assert(result == FWK_E_SUPPORT);
+
+    /* The masking handlers come in pairs */
+    driver_partial.mask_priority = mask_priority;
+    result = fwk_interrupt_init(&driver_partial);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_interrupt_init(&driver_priority);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_interrupt_mask_priority(0, &outer);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_interrupt_mask_priority(3, NULL);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_interrupt_mask_priority(3, &outer);
+    assert(result == FWK_SUCCESS);
+    assert(masked_priority == 3);
+
+    result = fwk_interrupt_mask_priority(1, &inner);
+    assert(result == FWK_SUCCESS);
+    assert(masked_priority == 1);
+
+    result = fwk_interrupt_unmask_priority(inner);
+    assert(result == FWK_SUCCESS);
+    assert(masked_priority == 3);
+
+    result = fwk_interrupt_unmask_priority(outer);
+    assert(result == FWK_SUCCESS);
+    assert(masked_priority == UINT_MAX);
+}
+
+static void test_fwk_interrupt_bounded_critical_section(void)
+{
+    /* Only the critical priority level and below are masked */
+    fwk_interrupt_global_disable();
+    assert(masked_priority == FWK_INTERRUPT_CRITICAL_PRIORITY);
+    assert(global_disable_call_count == 0);
+
+    fwk_interrupt_global_disable();
+    assert(global_disable_call_count == 0);
+
+    /* Masking everything within the critical section */
+    fwk_interrupt_global_disable_all();
+    assert(global_disable_call_count == 1);
+
+    fwk_interrupt_global_enable();
+    fwk_interrupt_global_enable();
+    assert(global_enable_call_count == 0);
+    assert(masked_priority == FWK_INTERRUPT_CRITICAL_PRIORITY);
+
+    fwk_interrupt_global_enable();
+    assert(global_enable_call_count == 1);
+    assert(masked_priority == UINT_MAX);
+
+    /* Masking everything outside of a critical section */
+    fwk_interrupt_global_disable_all();
+    assert(global_disable_call_count == 2);
+    assert(masked_priority == UINT_MAX);
+
+    fwk_interrupt_global_enable();
+    assert(global_enable_call_count == 2);
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_interrupt_before_init),
     FWK_TEST_CASE(test_fwk_interrupt_init),
@@ -380,7 +513,10 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_interrupt_set_isr_param),
     FWK_TEST_CASE(test_fwk_interrupt_set_isr_fault),
     FWK_TEST_CASE(test_fwk_interrupt_get_current),
+    FWK_TEST_CASE(test_fwk_interrupt_get_current_priority),
     FWK_TEST_CASE(test_fwk_interrupt_nested_critical_section),
+    FWK_TEST_CASE(test_fwk_interrupt_mask_priority),
+    FWK_TEST_CASE(test_fwk_interrupt_bounded_critical_section),
 };
 
 struct fwk_test_suite_desc test_suite = {
@@ -0,0 +1,277 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_arch.h>
+#include <fwk_interrupt.h>
+#include <fwk_macros.h>
+#include <fwk_status.h>
+#include <fwk_test.h>
+#include <fwk_time.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define INTERRUPT_OUTER 3
+#define INTERRUPT_INNER 4
+
+static fwk_timestamp_t fake_timestamp;
+
+/* Routines registered with the driver, indexed by interrupt */
+static void (*driver_isr_param[FWK_INTERRUPT_STATS_COUNT + 1])(uintptr_t);
+static uintptr_t driver_param[FWK_INTERRUPT_STATS_COUNT + 1];
+static void (*driver_isr[FWK_INTERRUPT_STATS_COUNT + 1])(void);
+
+fwk_timestamp_t __wrap_fwk_time_profile_current(void)
+{
+    return fake_timestamp;
+}
+
+static void fire(unsigned int interrupt)
+{
+    driver_isr_param[interrupt](driver_param[interrupt]);
+}
+
+static void isr_inner(void)
+{
+    fake_timestamp += FWK_NS(300);
+}
+
+static void isr_outer(uintptr_t param)
+{
+    assert(param == 0x1234);
+
+    fake_timestamp += FWK_NS(100);
+    fire(INTERRUPT_INNER);
+    fake_timestamp += FWK_NS(100);
+}
+
+static int global_enable(void)
+{
+    return FWK_SUCCESS;
+}
+
+static int global_disable(void)
+{
+    return FWK_SUCCESS;
+}
+
+static int is_enabled(unsigned int interrupt, bool *state)
+{
+    return FWK_SUCCESS;
+}
+
+static int enable(unsigned int interrupt)
+{
+    return FWK_SUCCESS;
+}
+
+static int disable(unsigned int interrupt)
+{
+    return FWK_SUCCESS;
+}
+
+static int is_pending(unsigned int interrupt, bool *state)
+{
+    return FWK_SUCCESS;
+}
+
+static int set_pending(unsigned int interrupt)
+{
+    return FWK_SUCCESS;
+}
+
+static int clear_pending(unsigned int interrupt)
+{
+    return FWK_SUCCESS;
+}
+
+static int set_isr(unsigned int interrupt, void (*isr)(void))
+{
+    driver_isr[interrupt] = isr;
+
+    return FWK_SUCCESS;
+}
+
+static int set_isr_param(
+    unsigned int interrupt,
+    void (*isr)(uintptr_t p),
+    uintptr_t p)
+{
+    driver_isr_param[interrupt] = isr;
+    driver_param[interrupt] = p;
+
+    return FWK_SUCCESS;
+}
+
+static int set_isr_nmi(void (*isr)(void))
+{
+    return FWK_SUCCESS;
+}
+
+static int set_isr_nmi_param(void (*isr)(uintptr_t p), uintptr_t p)
+{
+    return FWK_SUCCESS;
+}
+
+static int set_isr_fault(void (*isr)(void))
+{
+    return FWK_SUCCESS;
+}
+
+static int get_current(unsigned int *interrupt)
+{
+    return FWK_E_STATE;
+}
+
+static const struct fwk_arch_interrupt_driver driver = {
+    .global_enable = global_enable,
+    .global_disable = global_disable,
+    .is_enabled = is_enabled,
+    .enable = enable,
+    .disable = disable,
+    .is_pending = is_pending,
+    .set_pending = set_pending,
+    .clear_pending = clear_pending,
+    .set_isr_irq = set_isr,
+    .set_isr_irq_param = set_isr_param,
+    .set_isr_nmi = set_isr_nmi,
+    .set_isr_nmi_param = set_isr_nmi_param,
+    .set_isr_fault = set_isr_fault,
+    .get_current = get_current,
+};
+
+static int test_suite_setup(void)
+{
+    return fwk_interrupt_init(&driver);
+}
+
+static void test_case_setup(void)
+{
+    int status;
+
+    fake_timestamp = FWK_US(1);
+
+    status = fwk_interrupt_reset_stats();
+    assert(status == FWK_SUCCESS);
+}
+
+static void test_fwk_interrupt_stats_isr(void)
+{
+    int status;
+    struct fwk_interrupt_stats stats;
+
+    status = fwk_interrupt_set_isr(INTERRUPT_INNER, isr_inner);
+    assert(status == FWK_SUCCESS);
+
+    /* The driver calls the framework, which calls the routine */
+    assert(driver_isr_param[INTERRUPT_INNER] != NULL);
+
+    fire(INTERRUPT_INNER);
+    fire(INTERRUPT_INNER);
+
+    status = fwk_interrupt_get_stats(INTERRUPT_INNER, &stats);
+    assert(status == FWK_SUCCESS);
+    assert(stats.count == 2);
+    assert(stats.total == FWK_NS(600));
+    assert(stats.max == FWK_NS(300));
+}
+
+static void test_fwk_interrupt_stats_preempted(void)
+{
+    int status;
+    struct fwk_interrupt_stats stats;
+
+    status = fwk_interrupt_set_isr(INTERRUPT_INNER, isr_inner);
+    assert(status == FWK_SUCCESS);
+
+    status =
+        fwk_interrupt_set_isr_param(INTERRUPT_OUTER, isr_outer, 0x1234);
+    assert(status == FWK_SUCCESS);
+
+    fire(INTERRUPT_OUTER);
+
+    /* The inner routine does not count in the time of the outer one */
+    status = fwk_interrupt_get_stats(INTERRUPT_OUTER, &stats);
+    assert(status == FWK_SUCCESS);
+    assert(stats.count == 1);
+    assert(stats.total == FWK_NS(200));
+    assert(stats.max == FWK_NS(200));
+
+    status = fwk_interrupt_get_stats(INTERRUPT_INNER, &stats);
+    assert(status == FWK_SUCCESS);
+    assert(stats.count == 1);
+    assert(stats.total == FWK_NS(300));
+}
+
+static void test_fwk_interrupt_stats_out_of_range(void)
+{
+    int status;
+    struct fwk_interrupt_stats stats;
+
+    /* Interrupts without statistics are registered as they are */
+    status = fwk_interrupt_set_isr(FWK_INTERRUPT_STATS_COUNT, isr_inner);
+    assert(status == FWK_SUCCESS);
+    assert(driver_isr[FWK_INTERRUPT_STATS_COUNT] == isr_inner);
+
+    status = fwk_interrupt_get_stats(FWK_INTERRUPT_STATS_COUNT, &stats);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_interrupt_get_stats(INTERRUPT_INNER, NULL);
+    assert(status == FWK_E_PARAM);
+}
+
+static void test_fwk_interrupt_stats_masked(void)
+{
+    int status;
+    fwk_duration_ns_t duration;
+
+    fwk_interrupt_global_disable();
+    fake_timestamp += FWK_NS(400);
+    fwk_interrupt_global_disable();
+    fake_timestamp += FWK_NS(100);
+    fwk_interrupt_global_enable();
+    fake_timestamp += FWK_NS(500);
+    fwk_interrupt_global_enable();
+
+    /* Interrupts are unmasked, the time is not counted */
+    fake_timestamp += FWK_US(10);
+
+    fwk_interrupt_global_disable();
+    fake_timestamp += FWK_NS(200);
+    fwk_interrupt_global_enable();
+
+    status = fwk_interrupt_get_masked_max(&duration);
+    assert(status == FWK_SUCCESS);
+    assert(duration == FWK_NS(1000));
+
+    status = fwk_interrupt_reset_stats();
+    assert(status == FWK_SUCCESS);
+
+    status = fwk_interrupt_get_masked_max(&duration);
+    assert(status == FWK_SUCCESS);
+    assert(duration == 0);
+
+    status = fwk_interrupt_get_masked_max(NULL);
+    assert(status == FWK_E_PARAM);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_interrupt_stats_isr),
+    FWK_TEST_CASE(test_fwk_interrupt_stats_preempted),
+    FWK_TEST_CASE(test_fwk_interrupt_stats_out_of_range),
+    FWK_TEST_CASE(test_fwk_interrupt_stats_masked),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_interrupt_stats",
+    .test_suite_setup = test_suite_setup,
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,213 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <internal/fwk_latency.h>
+#include <internal/fwk_module.h>
+
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_latency.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_status.h>
+#include <fwk_test.h>
+#include <fwk_time.h>
+
+#include <assert.h>
+#include <string.h>
+
+static struct fwk_module fake_module_desc = {
+    .event_count = 2,
+};
+
+static struct fwk_latency_stats fake_latency_table[2];
+
+static struct fwk_module_ctx fake_module_ctx = {
+    .desc = &fake_module_desc,
+    .latency_table = fake_latency_table,
+};
+
+static fwk_timestamp_t fake_timestamp;
+
+struct fwk_module_ctx *__wrap_fwk_module_get_ctx(fwk_id_t id)
+{
+    return &fake_module_ctx;
+}
+
+fwk_timestamp_t __wrap_fwk_time_current(void)
+{
+    return fake_timestamp;
+}
+
+fwk_timestamp_t __wrap_fwk_time_profile_current(void)
+{
+    return fake_timestamp;
+}
+
+static void test_case_setup(void)
+{
+    fake_module_desc.event_budget_us = 0;
+
+    assert(fwk_latency_reset() == FWK_SUCCESS);
+}
+
+static void handle_event(unsigned int event_idx, fwk_duration_ns_t duration)
+{
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(0, event_idx),
+        .target_id = FWK_ID_MODULE(0),
+    };
+
+    fake_timestamp = duration;
+    __fwk_latency_check_budget(&event, 0);
+}
+
+static void test_fwk_latency_record(void)
+{
+    int status;
+    struct fwk_latency_stats stats;
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(0, 1),
+        .timestamp = FWK_US(10),
+    };
+
+    /* Queued for 5us, handled in 300ns */
+    fake_timestamp = FWK_US(15) + FWK_NS(300);
+    __fwk_latency_record(&event, FWK_US(15));
+
+    /* Queued for nothing, handled in 100us */
+    fake_timestamp = FWK_US(110);
+    __fwk_latency_record(&event, FWK_US(10));
+
+    status = fwk_latency_get_stats(FWK_ID_EVENT(0, 1), &stats);
+    assert(status == FWK_SUCCESS);
+
+    assert(stats.queue.buckets[0] == 1);
+    assert(stats.queue.buckets[3] == 1);
+    assert(stats.queue.total == FWK_US(5));
+    assert(stats.queue.max == FWK_US(5));
+
+    assert(stats.handler.buckets[0] == 1);
+    assert(stats.handler.buckets[7] == 1);
+    assert(stats.handler.total == (FWK_US(100) + FWK_NS(300)));
+    assert(stats.handler.max == FWK_US(100));
+
+    status = fwk_latency_get_stats(FWK_ID_EVENT(0, 0), &stats);
+    assert(status == FWK_SUCCESS);
+    assert(stats.queue.buckets[0] == 0);
+}
+
+static void test_fwk_latency_record_saturates(void)
+{
+    struct fwk_latency_stats stats;
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(0, 0),
+        .timestamp = 0,
+    };
+
+    fake_timestamp = FWK_S(10);
+    __fwk_latency_record(&event, FWK_S(5));
+
+    assert(fwk_latency_get_stats(FWK_ID_EVENT(0, 0), &stats) == FWK_SUCCESS);
+    assert(stats.queue.buckets[FWK_EVENT_LATENCY_BUCKET_COUNT - 1] == 1);
+    assert(stats.handler.buckets[FWK_EVENT_LATENCY_BUCKET_COUNT - 1] == 1);
+}
+
+static void test_fwk_latency_get_stats_invalid(void)
+{
+    int status;
+    struct fwk_latency_stats stats;
+
+    status = fwk_latency_get_stats(FWK_ID_EVENT(0, 0), NULL);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_latency_get_stats(FWK_ID_EVENT(0, 2), &stats);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_latency_get_stats(FWK_ID_MODULE(0), &stats);
+    assert(status == FWK_E_PARAM);
+}
+
+static void test_fwk_latency_budget_met(void)
+{
+    struct fwk_latency_overrun overruns[FWK_EVENT_BUDGET_OFFENDER_COUNT];
+    unsigned int count;
+    uint32_t total;
+
+    handle_event(0, FWK_US(100));
+
+    assert(fwk_latency_get_overruns(overruns, &count, &total) == FWK_SUCCESS);
+    assert(count == 0);
+    assert(total == 0);
+}
+
+static void test_fwk_latency_budget_overruns(void)
+{
+    struct fwk_latency_overrun overruns[FWK_EVENT_BUDGET_OFFENDER_COUNT];
+    unsigned int count;
+    uint32_t total;
+
+    handle_event(0, FWK_US(150));
+    handle_event(0, FWK_US(120));
+    handle_event(1, FWK_US(300));
+
+    assert(fwk_latency_get_overruns(overruns, &count, &total) == FWK_SUCCESS);
+    assert(count == 2);
+    assert(total == 3);
+    assert(fwk_id_is_equal(overruns[0].id, FWK_ID_EVENT(0, 1)));
+    assert(overruns[0].max == FWK_US(300));
+    assert(overruns[0].count == 1);
+    assert(overruns[1].max == FWK_US(150));
+    assert(overruns[1].count == 2);
+
+    /* The least offender is replaced by a worse one only */
+    handle_event(2, FWK_US(110));
+    handle_event(3, FWK_US(200));
+
+    assert(fwk_latency_get_overruns(overruns, &count, &total) == FWK_SUCCESS);
+    assert(count == 2);
+    assert(total == 5);
+    assert(overruns[0].max == FWK_US(300));
+    assert(fwk_id_is_equal(overruns[1].id, FWK_ID_EVENT(0, 3)));
+    assert(overruns[1].max == FWK_US(200));
+    assert(fwk_id_is_equal(overruns[1].target_id, FWK_ID_MODULE(0)));
+}
+
+static void test_fwk_latency_budget_module(void)
+{
+    struct fwk_latency_overrun overruns[FWK_EVENT_BUDGET_OFFENDER_COUNT];
+    unsigned int count;
+    uint32_t total;
+
+    fake_module_desc.event_budget_us = 500;
+
+    handle_event(0, FWK_US(300));
+    handle_event(0, FWK_US(600));
+
+    assert(fwk_latency_get_overruns(overruns, &count, &total) == FWK_SUCCESS);
+    assert(count == 1);
+    assert(total == 1);
+    assert(overruns[0].max == FWK_US(600));
+
+    assert(fwk_latency_get_overruns(NULL, &count, &total) == FWK_E_PARAM);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_latency_record),
+    FWK_TEST_CASE(test_fwk_latency_record_saturates),
+    FWK_TEST_CASE(test_fwk_latency_get_stats_invalid),
+    FWK_TEST_CASE(test_fwk_latency_budget_met),
+    FWK_TEST_CASE(test_fwk_latency_budget_overruns),
+    FWK_TEST_CASE(test_fwk_latency_budget_module),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_latency",
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,243 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_io.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_test.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+static char output[512];
+static size_t output_length;
+
+int __wrap_fwk_io_putch(const struct fwk_io_stream *stream, char ch)
+{
+    assert(output_length < (sizeof(output) - 1));
+
+    output[output_length++] = ch;
+    output[output_length] = '\0';
+
+    return FWK_SUCCESS;
+}
+
+static unsigned int write_count;
+
+int __wrap_fwk_io_write(
+    const struct fwk_io_stream *restrict stream,
+    size_t *restrict written,
+    const void *restrict buffer,
+    size_t size,
+    size_t count)
+{
+    assert((output_length + (size * count)) < sizeof(output));
+
+    memcpy(&output[output_length], buffer, size * count);
+    output_length += size * count;
+    output[output_length] = '\0';
+
+    write_count++;
+
+    return FWK_SUCCESS;
+}
+
+int __wrap_fwk_io_puts(const struct fwk_io_stream *stream, const char *str)
+{
+    return FWK_SUCCESS;
+}
+
+static void test_case_setup(void)
+{
+    fwk_log_flush();
+
+    output_length = 0;
+    output[0] = '\0';
+    write_count = 0;
+}
+
+/* Return the message of the first line of output, past its timestamp */
+static const char *get_message(void)
+{
+    const char *message = strstr(output, "] ");
+
+    assert(message != NULL);
+
+    return message + 2;
+}
+
+static void test_fwk_log_binary_deferred(void)
+{
+    FWK_LOG_CRIT("[TEST] %d and %s", -42, "forty-two");
+
+    /* Nothing is formatted until the message is unbuffered */
+    assert(output_length == 0);
+
+    fwk_log_flush();
+    assert(strcmp(get_message(), "[TEST] -42 and forty-two\n") == 0);
+}
+
+static void test_fwk_log_binary_conversions(void)
+{
+    char name[] = "volatile";
+
+    FWK_LOG_CRIT(
+        "%u %x %lX %llu %hhu %c %% %s",
+        4000000000U,
+        0xABCDU,
+        0x12345678UL,
+        12345678901ULL,
+        0x1FF,
+        'z',
+        name);
+
+    /* Strings are copied when the message is logged */
+    name[0] = '\0';
+
+    fwk_log_flush();
+    assert(
+        strcmp(
+            get_message(),
+            "4000000000 abcd 12345678 12345678901 255 z % volatile\n") == 0);
+}
+
+static void test_fwk_log_binary_width_precision(void)
+{
+    FWK_LOG_CRIT(
+        "[%*d] [%-4s] [%.*s] [%08.3f]", 5, 42, "ab", 2, "xyz", 3.14159);
+
+    fwk_log_flush();
+    assert(strcmp(get_message(), "[   42] [ab  ] [xy] [0003.142]\n") == 0);
+}
+
+static void test_fwk_log_binary_newline(void)
+{
+    FWK_LOG_CRIT("first line\nsecond line");
+
+    fwk_log_flush();
+    assert(strcmp(get_message(), "first line\n") == 0);
+}
+
+static void test_fwk_log_binary_id(void)
+{
+    fwk_id_t id = FWK_ID_ELEMENT(42, 58);
+
+    FWK_LOG_CRIT("%s -> [%-14s]", FWK_ID_STR(FWK_ID_NONE), FWK_ID_STR(id));
+
+    /* Identifiers are only formatted when the message is unbuffered */
+    fwk_log_flush();
+    assert(strcmp(get_message(), "[NON] -> [[ELM 42:58]   ]\n") == 0);
+}
+
+static void test_fwk_log_unbuffer_chunk(void)
+{
+    int status;
+
+    FWK_LOG_CRIT("first");
+    FWK_LOG_CRIT("second");
+
+    do {
+        status = fwk_log_unbuffer_chunk();
+    } while (status == FWK_PENDING);
+
+    /* Both messages fit in a single chunk */
+    assert(status == FWK_SUCCESS);
+    assert(write_count == 1);
+    assert(strncmp(get_message(), "first\n", 6) == 0);
+    assert(strstr(output, "] first\n") != NULL);
+    assert(strstr(output, "] second\n") != NULL);
+}
+
+/* Count the lines of output */
+static unsigned int count_lines(void)
+{
+    unsigned int count = 0;
+
+    for (size_t i = 0; i < output_length; i++)
+        count += (output[i] == '\n');
+
+    return count;
+}
+
+static void test_fwk_log_runtime_level(void)
+{
+    unsigned int level;
+    int status;
+
+    status = fwk_log_set_level(fwk_module_id_test0, FWK_LOG_LEVEL_ERROR);
+    assert(status == FWK_SUCCESS);
+
+    status = fwk_log_get_level(fwk_module_id_test0, &level);
+    assert(status == FWK_SUCCESS);
+    assert(level == FWK_LOG_LEVEL_ERROR);
+
+    FWK_LOG_WARN("filtered");
+    FWK_LOG_ERR("logged");
+
+    fwk_log_flush();
+    assert(strcmp(get_message(), "logged\n") == 0);
+    assert(count_lines() == 1);
+
+    status = fwk_log_set_level(fwk_module_id_test0, FWK_LOG_LEVEL_TRACE);
+    assert(status == FWK_SUCCESS);
+}
+
+static void test_fwk_log_runtime_level_invalid(void)
+{
+    unsigned int level;
+    int status;
+
+    status = fwk_log_set_level(fwk_module_id_test0, FWK_LOG_LEVEL_CRIT + 1);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_log_set_level(
+        FWK_ID_MODULE(FWK_MODULE_IDX_COUNT), FWK_LOG_LEVEL_CRIT);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_log_get_level(fwk_module_id_test0, NULL);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_log_get_level(fwk_module_id_test0, &level);
+    assert(status == FWK_SUCCESS);
+    assert(level == FWK_LOG_LEVEL_TRACE);
+}
+
+static void test_fwk_log_rate_limit(void)
+{
+    /* Time does not advance, so the bucket is never refilled */
+    for (unsigned int i = 0; i < (FMW_LOG_RATE_BURST + 3); i++)
+        FWK_LOG_CRIT("storm");
+
+    /* The dropped messages are reported once the buffer is empty */
+    fwk_log_flush();
+    assert(count_lines() == (FMW_LOG_RATE_BURST + 1));
+    assert(strncmp(get_message(), "storm\n", 6) == 0);
+    assert(strstr(output, "and 3 more messages") != NULL);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_log_binary_deferred),
+    FWK_TEST_CASE(test_fwk_log_binary_conversions),
+    FWK_TEST_CASE(test_fwk_log_binary_width_precision),
+    FWK_TEST_CASE(test_fwk_log_binary_newline),
+    FWK_TEST_CASE(test_fwk_log_binary_id),
+    FWK_TEST_CASE(test_fwk_log_unbuffer_chunk),
+    FWK_TEST_CASE(test_fwk_log_runtime_level),
+    FWK_TEST_CASE(test_fwk_log_runtime_level_invalid),
+    FWK_TEST_CASE(test_fwk_log_rate_limit),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_log",
+    .test_case_setup = test_case_setup,
+
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
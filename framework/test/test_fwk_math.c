@@ -69,6 +69,27 @@ static void test_fwk_math_clz_ull(void)
     assert(fwk_math_clz(num) == 5);
 }
 
+static void test_fwk_math_ctz_ui(void)
+{
+    unsigned int num = ~0u << 5;
+
+    assert(fwk_math_ctz(num) == 5);
+}
+
+static void test_fwk_math_ctz_ul(void)
+{
+    unsigned long num = ~0ul << 5;
+
+    assert(fwk_math_ctz(num) == 5);
+}
+
+static void test_fwk_math_ctz_ull(void)
+{
+    unsigned long long num = ~0ull << 5;
+
+    assert(fwk_math_ctz(num) == 5);
+}
+
 static void test_fwk_math_log2_ui(void)
 {
     unsigned int num = UINT_MAX;
@@ -102,6 +123,9 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_math_clz_ui),
     FWK_TEST_CASE(test_fwk_math_clz_ul),
     FWK_TEST_CASE(test_fwk_math_clz_ull),
+    FWK_TEST_CASE(test_fwk_math_ctz_ui),
+    FWK_TEST_CASE(test_fwk_math_ctz_ul),
+    FWK_TEST_CASE(test_fwk_math_ctz_ull),
     FWK_TEST_CASE(test_fwk_math_log2_ui),
     FWK_TEST_CASE(test_fwk_math_log2_ul),
     FWK_TEST_CASE(test_fwk_math_log2_ull),
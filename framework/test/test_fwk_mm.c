@@ -0,0 +1,229 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <internal/fwk_mm.h>
+
+#include <fwk_arch.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_test.h>
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+static alignas(max_align_t) unsigned char reclaimable[128];
+
+static int get_reclaimable(void **base, size_t *size)
+{
+    *base = reclaimable;
+    *size = sizeof(reclaimable);
+
+    return FWK_SUCCESS;
+}
+
+static const struct fwk_arch_mm_driver mm_driver = {
+    .get_reclaimable = get_reclaimable,
+};
+
+static void test_fwk_mm_get_arena_info(void)
+{
+    int status;
+    struct fwk_mm_arena_info info;
+
+    status = fwk_mm_get_arena_info(NULL);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_mm_get_arena_info(&info);
+    assert(status == FWK_SUCCESS);
+    assert(info.size == FMW_MM_ARENA_SIZE);
+    assert(!info.locked);
+    assert(info.late_alloc_count == 0);
+}
+
+static void test_fwk_mm_arena_alloc(void)
+{
+    struct fwk_mm_arena_info before, after;
+    unsigned char *a, *b, *c;
+
+    assert(fwk_mm_get_arena_info(&before) == FWK_SUCCESS);
+
+    a = fwk_mm_alloc(1, 3);
+    b = fwk_mm_calloc(2, 8);
+    c = fwk_mm_alloc_aligned(64, 1, 64);
+
+    assert(((uintptr_t)a % alignof(max_align_t)) == 0);
+    assert(((uintptr_t)b % alignof(max_align_t)) == 0);
+    assert(((uintptr_t)c % 64) == 0);
+    assert((b >= (a + 3)) && (c >= (b + 16)));
+
+    for (unsigned int i = 0; i < 16; i++)
+        assert(b[i] == 0);
+
+    /* Arena blocks are never returned */
+    fwk_mm_free(b);
+
+    assert(fwk_mm_get_arena_info(&after) == FWK_SUCCESS);
+    assert(after.used >= (before.used + 3 + 16 + 64));
+    assert(after.used <= after.size);
+}
+
+static void test_fwk_mm_arena_realloc(void)
+{
+    unsigned char *block, *moved;
+
+    block = fwk_mm_alloc(1, 4);
+    for (unsigned int i = 0; i < 4; i++)
+        block[i] = i + 1;
+
+    moved = fwk_mm_realloc(block, 1, 4);
+    assert(moved != NULL);
+    assert(moved != block);
+    for (unsigned int i = 0; i < 4; i++)
+        assert(moved[i] == (i + 1));
+
+    fwk_mm_free(moved);
+}
+
+static void test_fwk_mm_get_usage(void)
+{
+    struct fwk_mm_usage before, after, framework;
+    void *block;
+
+    assert(fwk_mm_get_usage(FWK_ID_MODULE(0), NULL) == FWK_E_PARAM);
+    assert(fwk_mm_get_usage(FWK_ID_ELEMENT(0, 0), &before) == FWK_E_PARAM);
+    assert(
+        fwk_mm_get_usage(FWK_ID_MODULE(FWK_MODULE_IDX_COUNT), &before) ==
+        FWK_E_PARAM);
+
+    assert(fwk_mm_get_usage(FWK_ID_MODULE(0), &before) == FWK_SUCCESS);
+    assert(fwk_mm_get_usage(FWK_ID_NONE, &framework) == FWK_SUCCESS);
+
+    __fwk_mm_set_owner(FWK_ID_MODULE(0));
+    block = fwk_mm_calloc(3, 4);
+    assert(block != NULL);
+    __fwk_mm_set_owner(FWK_ID_NONE);
+
+    assert(fwk_mm_get_usage(FWK_ID_MODULE(0), &after) == FWK_SUCCESS);
+    assert(after.size == (before.size + 12));
+    assert(after.count == (before.count + 1));
+
+    /* Allocations outside of a module stage go to the framework */
+    block = fwk_mm_alloc(1, 8);
+    assert(block != NULL);
+
+    assert(fwk_mm_get_usage(FWK_ID_MODULE(0), &before) == FWK_SUCCESS);
+    assert(before.count == after.count);
+    assert(fwk_mm_get_usage(FWK_ID_NONE, &after) == FWK_SUCCESS);
+    assert(after.count == (framework.count + 1));
+}
+
+static void test_fwk_mm_get_stackheap_high_water(void)
+{
+    size_t heap_size, stack_size;
+
+    assert(
+        fwk_mm_get_stackheap_high_water(NULL, &stack_size) == FWK_E_PARAM);
+
+    /* The test environment provides no memory management driver */
+    assert(
+        fwk_mm_get_stackheap_high_water(&heap_size, &stack_size) ==
+        FWK_E_SUPPORT);
+}
+
+static void test_fwk_mm_arena_lock(void)
+{
+    struct fwk_mm_arena_info before, after;
+    void *late;
+
+    assert(fwk_mm_get_arena_info(&before) == FWK_SUCCESS);
+
+    __fwk_mm_lock();
+
+    late = fwk_mm_calloc(1, 8);
+    assert(late != NULL);
+
+    assert(fwk_mm_get_arena_info(&after) == FWK_SUCCESS);
+    assert(after.locked);
+    assert(after.used == before.used);
+    assert(after.late_alloc_count == (before.late_alloc_count + 1));
+
+    fwk_mm_free(late);
+}
+
+static bool is_reclaimed(const void *ptr)
+{
+    const unsigned char *address = ptr;
+
+    return (address >= reclaimable) &&
+        (address < (reclaimable + sizeof(reclaimable)));
+}
+
+static void test_fwk_mm_reclaim(void)
+{
+    unsigned char *a, *b, *moved, *late;
+
+    /* Nothing is reclaimed without a memory management driver */
+    assert(__fwk_mm_reclaim() == 0);
+
+    assert(__fwk_mm_init(&mm_driver) == FWK_SUCCESS);
+
+    /* The memory still holds the init-only code */
+    memset(reclaimable, 0xA5, sizeof(reclaimable));
+
+    assert(__fwk_mm_reclaim() == sizeof(reclaimable));
+
+    a = fwk_mm_alloc(1, 4);
+    b = fwk_mm_calloc(2, 8);
+    assert(is_reclaimed(a) && is_reclaimed(b));
+    assert(((uintptr_t)b % alignof(max_align_t)) == 0);
+    assert(b >= (a + 4));
+
+    for (unsigned int i = 0; i < 16; i++)
+        assert(b[i] == 0);
+
+    for (unsigned int i = 0; i < 4; i++)
+        a[i] = i + 1;
+
+    /* Reclaimed blocks are moved to the heap and never returned */
+    moved = fwk_mm_realloc(a, 1, 4);
+    assert((moved != NULL) && !is_reclaimed(moved));
+    for (unsigned int i = 0; i < 4; i++)
+        assert(moved[i] == (i + 1));
+
+    fwk_mm_free(moved);
+    fwk_mm_free(b);
+
+    /* Allocations that no longer fit fall back to the heap */
+    late = fwk_mm_alloc(1, sizeof(reclaimable));
+    assert((late != NULL) && !is_reclaimed(late));
+
+    fwk_mm_free(late);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_mm_get_arena_info),
+    FWK_TEST_CASE(test_fwk_mm_arena_alloc),
+    FWK_TEST_CASE(test_fwk_mm_arena_realloc),
+    FWK_TEST_CASE(test_fwk_mm_get_usage),
+    FWK_TEST_CASE(test_fwk_mm_get_stackheap_high_water),
+    FWK_TEST_CASE(test_fwk_mm_arena_lock),
+    FWK_TEST_CASE(test_fwk_mm_reclaim),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_mm",
+
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -97,13 +97,17 @@ static bool get_element_table0_return_val;
 static bool get_element_table1_return_val;
 static int process_event_return_val;
 static int thread_init_return_val;
+static fwk_timestamp_t fake_timestamp;
 
 static int init(fwk_id_t module_id, unsigned int element_count,
     const void *data)
 {
-    (void) module_id;
     (void) element_count;
     (void) data;
+
+    if (fwk_id_is_equal(module_id, fwk_module_id_fake1))
+        fake_timestamp += FWK_US(10);
+
     return init_return_val;
 }
 
@@ -133,6 +137,7 @@ static int start(fwk_id_t id)
 {
     (void) id;
     start_count_call++;
+    fake_timestamp += FWK_US(1);
     return start_return_val;
 }
 
@@ -194,6 +199,11 @@ void * __wrap_fwk_mm_calloc(size_t num, size_t size)
     return NULL;
 }
 
+fwk_timestamp_t __wrap_fwk_time_current(void)
+{
+    return fake_timestamp;
+}
+
 int __wrap___fwk_thread_init(size_t event_count)
 {
     (void) event_count;
@@ -279,11 +289,13 @@ static void test_case_setup(void)
 
     fake_module_config0.elements.type = FWK_MODULE_ELEMENTS_TYPE_DYNAMIC;
     fake_module_config0.elements.generator = get_element_table0;
+    fake_module_config0.elements.count = 0;
     fake_module_config0.data = &config_module0;
 
     fake_module_config1.elements.type = FWK_MODULE_ELEMENTS_TYPE_DYNAMIC;
     fake_module_config1.elements.generator = get_element_table1;
     fake_module_config1.data = &config_module1;
+    fake_module_config1.deferred_start = false;
 
     module_table[0] = &fake_module_desc0;
     module_table[1] = &fake_module_desc1;
@@ -297,6 +309,35 @@ static void test_case_setup(void)
     fwk_module_start();
 }
 
+static void test_fwk_module_get_boot_profile(void)
+{
+    int status;
+    const struct fwk_module_boot_profile *table;
+    size_t count;
+
+    /*
+     * The modules are only started by the set-up of the first test case, this
+     * test must thus come first.
+     */
+    status = fwk_module_get_boot_profile(NULL, &count);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_module_get_boot_profile(&table, &count);
+    assert(status == FWK_SUCCESS);
+    assert(count == FWK_MODULE_IDX_COUNT);
+
+    /* The module with the slowest initialization comes first */
+    assert(fwk_id_is_equal(table[0].module_id, fwk_module_id_fake1));
+    assert(table[0].phases[FWK_MODULE_BOOT_PHASE_INIT] == FWK_US(10));
+    assert(table[0].phases[FWK_MODULE_BOOT_PHASE_START] == FWK_US(2));
+    assert(table[0].total == FWK_US(12));
+
+    assert(fwk_id_is_equal(table[1].module_id, fwk_module_id_fake0));
+    assert(table[1].phases[FWK_MODULE_BOOT_PHASE_INIT] == 0);
+    assert(table[1].phases[FWK_MODULE_BOOT_PHASE_START] == FWK_US(3));
+    assert(table[1].total == FWK_US(3));
+}
+
 static void test_fwk_module_is_valid_module_id(void)
 {
     fwk_id_t id;
@@ -323,6 +364,48 @@ static void test_fwk_module_is_valid_module_id(void)
     assert(!result);
 }
 
+static void test_fwk_module_is_valid_entity_id(void)
+{
+    fake_module_config0.elements.type = FWK_MODULE_ELEMENTS_TYPE_STATIC;
+    fake_module_config0.elements.table = fake_element_desc_table0;
+    fake_module_config1.elements.type = FWK_MODULE_ELEMENTS_TYPE_STATIC;
+    fake_module_config1.elements.table = fake_element_desc_table1;
+    fwk_module_reset();
+
+    /* Valid element IDs */
+    assert(fwk_module_is_valid_entity_id(ELEM0_ID));
+    assert(fwk_module_is_valid_entity_id(ELEM1_ID));
+    assert(fwk_module_is_valid_entity_id(ELEM2_ID));
+
+    /* Element IDX non valid */
+    assert(!fwk_module_is_valid_element_id(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_FAKE0, 0x02)));
+    assert(!fwk_module_is_valid_element_id(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_FAKE1, 0x01)));
+
+    /* Valid sub-element ID */
+    assert(fwk_module_is_valid_sub_element_id(SUB_ELEM0_ID));
+    assert(fwk_module_is_valid_entity_id(SUB_ELEM0_ID));
+
+    /* Sub-element IDX non valid */
+    assert(!fwk_module_is_valid_sub_element_id(
+        FWK_ID_SUB_ELEMENT(FWK_MODULE_IDX_FAKE0, ELEM1_IDX, 0x00)));
+    assert(!fwk_module_is_valid_sub_element_id(
+        FWK_ID_SUB_ELEMENT(FWK_MODULE_IDX_FAKE0, 0x02, 0x00)));
+
+    /* Valid API IDs */
+    assert(fwk_module_is_valid_api_id(API0_ID));
+    assert(fwk_module_is_valid_api_id(API1_ID));
+
+    /* API IDX non valid */
+    assert(!fwk_module_is_valid_api_id(FWK_ID_API(FWK_MODULE_IDX_FAKE1, 0)));
+
+    /* Invalid types */
+    assert(!fwk_module_is_valid_entity_id(API0_ID));
+    assert(!fwk_module_is_valid_element_id(SUB_ELEM0_ID));
+    assert(!fwk_module_is_valid_api_id(ELEM0_ID));
+}
+
 static void test_fwk_module_is_valid_event_id(void)
 {
     fwk_id_t id;
@@ -395,10 +478,69 @@ static void test_fwk_module_is_valid_notification_id(void)
     assert(!result);
 }
 
+static void test_fwk_module_start_deferred(void)
+{
+    struct fwk_module_ctx *ctx;
+
+    fake_module_config1.deferred_start = true;
+    fwk_module_reset();
+
+    ctx = fwk_module_get_ctx(fwk_module_id_fake1);
+    ctx->state = FWK_MODULE_STATE_BOUND;
+    start_count_call = 0;
+
+    /* Only the deferred modules up to the target module are started */
+    __fwk_module_start_deferred(ELEM0_ID);
+    assert(start_count_call == 0);
+    assert(ctx->state == FWK_MODULE_STATE_BOUND);
+
+    __fwk_module_start_deferred(ELEM2_ID);
+    assert(start_count_call == 1);
+    assert(ctx->state == FWK_MODULE_STATE_STARTED);
+
+    /* A deferred module is only started once */
+    assert(!__fwk_module_start_next_deferred());
+    assert(start_count_call == 1);
+
+    /* The next deferred module is started from idle time */
+    fwk_module_reset();
+    ctx->state = FWK_MODULE_STATE_BOUND;
+
+    assert(__fwk_module_start_next_deferred());
+    assert(ctx->state == FWK_MODULE_STATE_STARTED);
+    assert(!__fwk_module_start_next_deferred());
+}
+
+static void test_fwk_module_static_element_count(void)
+{
+    fake_module_config0.elements =
+        (struct fwk_module_elements)FWK_MODULE_STATIC_ELEMENTS({
+            [0] = { .name = "FAKE ELEM 0", .data = &config_elem0 },
+            [1] = { .name = "FAKE ELEM 1", .data = &config_elem1 },
+            [2] = { .name = "FAKE ELEM 2", .data = &config_elem2 },
+            [3] = { 0 },
+        });
+
+    /* The element count is resolved at build time */
+    assert(fake_module_config0.elements.count == 3);
+
+    fwk_module_reset();
+
+    assert(fwk_module_get_element_count(fwk_module_id_fake0) == 3);
+    assert(fwk_module_is_valid_element_id(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_FAKE0, 2)));
+    assert(!fwk_module_is_valid_element_id(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_FAKE0, 3)));
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_module_get_boot_profile),
     FWK_TEST_CASE(test_fwk_module_is_valid_module_id),
+    FWK_TEST_CASE(test_fwk_module_is_valid_entity_id),
     FWK_TEST_CASE(test_fwk_module_is_valid_event_id),
     FWK_TEST_CASE(test_fwk_module_is_valid_notification_id),
+    FWK_TEST_CASE(test_fwk_module_start_deferred),
+    FWK_TEST_CASE(test_fwk_module_static_element_count),
 };
 
 struct fwk_test_suite_desc test_suite = {
@@ -0,0 +1,188 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <internal/fwk_module.h>
+
+#include <fwk_assert.h>
+#include <fwk_macros.h>
+#include <fwk_module_idx.h>
+#include <fwk_noreturn.h>
+#include <fwk_status.h>
+#include <fwk_test.h>
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define API0_IDX 0
+#define API1_IDX 1
+
+#define API0_ID FWK_ID_API(FWK_MODULE_IDX_FAKE0, API0_IDX)
+#define API1_ID FWK_ID_API(FWK_MODULE_IDX_FAKE0, API1_IDX)
+
+#define REQUESTER_COUNT 3
+
+extern struct fwk_module *module_table[FWK_MODULE_IDX_COUNT];
+extern struct fwk_module_config *module_config_table[FWK_MODULE_IDX_COUNT];
+
+static const int fake_api0;
+static const int fake_api1;
+
+static const int requester_config;
+
+static const void *bound_api0[REQUESTER_COUNT];
+static const void *bound_api1[REQUESTER_COUNT];
+
+static unsigned int process_bind_request_count_call[2];
+
+/* Context to return to once the modules have been started */
+static jmp_buf thread_run_env;
+
+static int init(fwk_id_t module_id, unsigned int element_count,
+    const void *data)
+{
+    return FWK_SUCCESS;
+}
+
+static int element_init(fwk_id_t element_id, unsigned int sub_element_count,
+    const void *data)
+{
+    return FWK_SUCCESS;
+}
+
+static int process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
+    fwk_id_t api_id, const void **api)
+{
+    unsigned int api_idx = fwk_id_get_api_idx(api_id);
+
+    process_bind_request_count_call[api_idx]++;
+    *api = (api_idx == API0_IDX) ? &fake_api0 : &fake_api1;
+
+    return FWK_SUCCESS;
+}
+
+/* Every requester element binds to both APIs of the first module */
+static int bind_requester(fwk_id_t id, unsigned int round)
+{
+    int status;
+    unsigned int element_idx;
+
+    if ((round != 0) || !fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    element_idx = fwk_id_get_element_idx(id);
+
+    status = fwk_module_bind(
+        fwk_module_id_fake0, API0_ID, &bound_api0[element_idx]);
+    assert(status == FWK_SUCCESS);
+
+    status = fwk_module_bind(
+        fwk_module_id_fake0, API1_ID, &bound_api1[element_idx]);
+    assert(status == FWK_SUCCESS);
+
+    return FWK_SUCCESS;
+}
+
+static struct fwk_module fake_module_desc0 = {
+    .name = "FAKE MODULE 0",
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = 2,
+    .init = init,
+    .process_bind_request = process_bind_request,
+    .bind_shared_api_mask = (1U << API0_IDX),
+};
+
+static struct fwk_module fake_module_desc1 = {
+    .name = "FAKE MODULE 1",
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .init = init,
+    .element_init = element_init,
+    .bind = bind_requester,
+};
+
+static struct fwk_module_config fake_module_config0 = { 0 };
+
+static struct fwk_module_config fake_module_config1 = {
+    .elements = FWK_MODULE_STATIC_ELEMENTS({
+        [0] = { .name = "REQUESTER 0", .data = &requester_config },
+        [1] = { .name = "REQUESTER 1", .data = &requester_config },
+        [2] = { .name = "REQUESTER 2", .data = &requester_config },
+        [3] = { 0 },
+    }),
+};
+
+/* Wrapped functions */
+
+void *__wrap_fwk_mm_calloc(size_t num, size_t size)
+{
+    return calloc(num, size);
+}
+
+fwk_timestamp_t __wrap_fwk_time_current(void)
+{
+    return 0;
+}
+
+int __wrap___fwk_thread_init(size_t event_count)
+{
+    return FWK_SUCCESS;
+}
+
+noreturn void __wrap___fwk_thread_run(void)
+{
+    longjmp(thread_run_env, 1);
+}
+
+static void test_fwk_module_bind_shared_api(void)
+{
+    int status;
+    unsigned int i;
+    const struct fwk_module_boot_profile *table;
+    size_t count;
+
+    module_table[FWK_MODULE_IDX_FAKE0] = &fake_module_desc0;
+    module_table[FWK_MODULE_IDX_FAKE1] = &fake_module_desc1;
+    module_config_table[FWK_MODULE_IDX_FAKE0] = &fake_module_config0;
+    module_config_table[FWK_MODULE_IDX_FAKE1] = &fake_module_config1;
+
+    fwk_module_reset();
+
+    if (setjmp(thread_run_env) == 0) {
+        fwk_module_start();
+        assert(false);
+    }
+
+    /* The shared API is only requested from the module once */
+    assert(process_bind_request_count_call[API0_IDX] == 1);
+    assert(process_bind_request_count_call[API1_IDX] == REQUESTER_COUNT);
+
+    for (i = 0; i < REQUESTER_COUNT; i++) {
+        assert(bound_api0[i] == &fake_api0);
+        assert(bound_api1[i] == &fake_api1);
+    }
+
+    status = fwk_module_get_boot_profile(&table, &count);
+    assert(status == FWK_SUCCESS);
+
+    for (i = 0; i < count; i++) {
+        if (fwk_id_is_equal(table[i].module_id, fwk_module_id_fake0))
+            break;
+    }
+    assert(i < count);
+
+    assert(table[i].bind_request_count == (2 * REQUESTER_COUNT));
+    assert(table[i].bind_cache_hit_count == (REQUESTER_COUNT - 1));
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_module_bind_shared_api),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_module_bind",
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -8,6 +8,7 @@
 #include <internal/fwk_id.h>
 #include <internal/fwk_module.h>
 #include <internal/fwk_multi_thread.h>
+#include <internal/fwk_thread_delayed_resp.h>
 
 #include <fwk_assert.h>
 #include <fwk_element.h>
@@ -546,14 +547,14 @@ static void test_put_event_to_waiting_thread_not_wakeup_event(void)
 {
     int status;
 
-    fwk_list_push_tail(&fake_module_ctx.delayed_response_list,
-                       &event[1].slist_node);
     fake_thread_module_ctx.waiting_event_processing_completion = true;
     event[0].source_id = FWK_ID_MODULE(0x2);
     event[0].target_id = FWK_ID_MODULE(0x1);
     event[0].is_response = true;
     event[0].cookie = 1;
+    event[1].source_id = FWK_ID_MODULE(0x2);
     event[1].cookie = 1;
+    __fwk_thread_add_delayed_response(event[1].source_id, &event[1]);
     fake_module_response_event.cookie = 2;
     fake_module_ctx.thread_ctx->response_event = &fake_module_response_event;
     fwk_interrupt_get_current_return_val = FWK_E_STATE;
@@ -572,14 +573,14 @@ static void test_put_event_to_waiting_thread_wakeup_event(void)
 {
     int status;
 
-    fwk_list_push_tail(&fake_module_ctx.delayed_response_list,
-                       &event[1].slist_node);
     fake_thread_module_ctx.waiting_event_processing_completion = true;
     event[0].source_id = FWK_ID_MODULE(0x2);
     event[0].target_id = FWK_ID_MODULE(0x1);
     event[0].is_response = true;
     event[0].cookie = 2;
+    event[1].source_id = FWK_ID_MODULE(0x2);
     event[1].cookie = 2;
+    __fwk_thread_add_delayed_response(event[1].source_id, &event[1]);
     fake_module_response_event.cookie = 2;
     fake_module_ctx.thread_ctx->response_event = &fake_module_response_event;
     fwk_interrupt_get_current_return_val = FWK_E_STATE;
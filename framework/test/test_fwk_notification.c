@@ -6,6 +6,7 @@
  */
 
 #include <internal/fwk_module.h>
+#include <internal/fwk_notification.h>
 #include <internal/fwk_single_thread.h>
 #include <internal/fwk_thread.h>
 
@@ -13,6 +14,7 @@
 #include <fwk_id.h>
 #include <fwk_list.h>
 #include <fwk_macros.h>
+#include <fwk_notification.h>
 #include <fwk_slist.h>
 #include <fwk_status.h>
 #include <fwk_test.h>
@@ -20,6 +22,7 @@
 #include <setjmp.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* Mock functions */
 static void * fwk_mm_calloc_val;
@@ -43,17 +46,21 @@ void *__wrap_fwk_mm_calloc(size_t num, size_t size)
 
 static struct fwk_module_ctx fake_module_ctx;
 static struct fwk_dlist fake_module_dlist_table[4];
+static struct __fwk_notification_subscribers fake_module_subscribers_table[4];
 struct fwk_module_ctx *__wrap_fwk_module_get_ctx(fwk_id_t id)
 {
     fake_module_ctx.subscription_dlist_table = fake_module_dlist_table;
+    fake_module_ctx.subscribers_table = fake_module_subscribers_table;
     return &fake_module_ctx;
 }
 
 static struct fwk_element_ctx fake_element_ctx;
 static struct fwk_dlist fake_element_dlist_table[4];
+static struct __fwk_notification_subscribers fake_element_subscribers_table[4];
 struct fwk_element_ctx *__wrap_fwk_module_get_element_ctx(fwk_id_t id)
 {
     fake_element_ctx.subscription_dlist_table = fake_element_dlist_table;
+    fake_element_ctx.subscribers_table = fake_element_subscribers_table;
     return &fake_element_ctx;
 }
 
@@ -96,6 +103,22 @@ int __wrap___fwk_thread_put_notification(struct fwk_event *event)
     return FWK_SUCCESS;
 }
 
+static struct fwk_event put_event_table[2];
+static unsigned int put_event_count;
+int __wrap_fwk_thread_put_event(struct fwk_event *event)
+{
+    assert(put_event_count < FWK_ARRAY_SIZE(put_event_table));
+
+    put_event_table[put_event_count++] = *event;
+
+    return FWK_SUCCESS;
+}
+
+bool __wrap_fwk_module_is_valid_event_id(fwk_id_t id)
+{
+    return true;
+}
+
 static struct fwk_event *get_current_event_return_val;
 const struct fwk_event *__wrap___fwk_thread_get_current_event(void)
 {
@@ -112,12 +135,22 @@ static void test_case_setup(void)
     fwk_mm_calloc_return_val = true;
     get_current_event_return_val = NULL;
     notification_event_count = 0;
+    put_event_count = 0;
 
     for (i = 0; i < FWK_ARRAY_SIZE(fake_module_dlist_table); i++)
         fwk_list_init(&fake_module_dlist_table[i]);
 
     for (i = 0; i < FWK_ARRAY_SIZE(fake_element_dlist_table); i++)
         fwk_list_init(&fake_element_dlist_table[i]);
+
+    memset(
+        fake_module_subscribers_table,
+        0,
+        sizeof(fake_module_subscribers_table));
+    memset(
+        fake_element_subscribers_table,
+        0,
+        sizeof(fake_element_subscribers_table));
 }
 
 static void test_case_teardown(void)
@@ -357,10 +390,238 @@ static void test_fwk_notification_notify(void)
     notification_event_count = 0;
 }
 
+static void test_fwk_notification_notify_compacted(void)
+{
+    int result;
+    unsigned int count;
+    struct fwk_event notification_event = {
+        .id = FWK_ID_NOTIFICATION(0x2, 0x1),
+        .source_id = FWK_ID_ELEMENT(0x2, 0x9),
+    };
+    struct __fwk_notification_subscribers *subscribers =
+        &fake_element_subscribers_table[0x1];
+
+    __fwk_notification_start();
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_ELEMENT(0x2, 0x9),
+                                        FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_ELEMENT(0x2, 0x9),
+                                        FWK_ID_ELEMENT(0x6, 0x1));
+    assert(result == FWK_SUCCESS);
+    assert(!subscribers->is_valid);
+
+    /* The first notification compacts the subscription list */
+    result = fwk_notification_notify(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 2);
+    assert(subscribers->is_valid);
+    assert(subscribers->count == 2);
+    assert(fwk_id_is_equal(subscribers->target_id_table[0],
+                           FWK_ID_MODULE(0x4)));
+    assert(fwk_id_is_equal(subscribers->target_id_table[1],
+                           FWK_ID_ELEMENT(0x6, 0x1)));
+    assert(fwk_id_is_equal(notification_event_table[0].target_id,
+                           FWK_ID_MODULE(0x4)));
+    assert(fwk_id_is_equal(notification_event_table[1].target_id,
+                           FWK_ID_ELEMENT(0x6, 0x1)));
+    notification_event_count = 0;
+
+    /* Unsubscribing invalidates the table, which is then rebuilt in place */
+    result = fwk_notification_unsubscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                          FWK_ID_ELEMENT(0x2, 0x9),
+                                          FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+    assert(!subscribers->is_valid);
+
+    result = fwk_notification_notify(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 1);
+    assert(subscribers->is_valid);
+    assert(subscribers->count == 1);
+    assert(subscribers->capacity == 2);
+    assert(notification_event_count == 1);
+    assert(fwk_id_is_equal(notification_event_table[0].target_id,
+                           FWK_ID_ELEMENT(0x6, 0x1)));
+    notification_event_count = 0;
+}
+
+static void test_fwk_notification_get_subscriber_count(void)
+{
+    int result;
+    unsigned int count;
+    struct fwk_event notification_event = {
+        .id = FWK_ID_NOTIFICATION(0x2, 0x1),
+        .source_id = FWK_ID_ELEMENT(0x2, 0x9),
+    };
+
+    result = fwk_notification_get_subscriber_count(
+        FWK_ID_NOTIFICATION(0x2, 0x1), FWK_ID_ELEMENT(0x2, 0x9), NULL);
+    assert(result == FWK_E_PARAM);
+
+    /* Notification and source from different modules */
+    result = fwk_notification_get_subscriber_count(
+        FWK_ID_NOTIFICATION(0x2, 0x1), FWK_ID_ELEMENT(0x3, 0x9), &count);
+    assert(result == FWK_E_PARAM);
+
+    count = 0xFF;
+    result = fwk_notification_get_subscriber_count(
+        FWK_ID_NOTIFICATION(0x2, 0x1), FWK_ID_ELEMENT(0x2, 0x9), &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 0);
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_ELEMENT(0x2, 0x9),
+                                        FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_ELEMENT(0x2, 0x8),
+                                        FWK_ID_MODULE(0x5));
+    assert(result == FWK_SUCCESS);
+
+    /* Before start, the subscription list is walked */
+    result = fwk_notification_get_subscriber_count(
+        FWK_ID_NOTIFICATION(0x2, 0x1), FWK_ID_ELEMENT(0x2, 0x9), &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 1);
+
+    __fwk_notification_start();
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_ELEMENT(0x2, 0x9),
+                                        FWK_ID_ELEMENT(0x6, 0x1));
+    assert(result == FWK_SUCCESS);
+
+    /* Once compacted, the subscriber table is used */
+    result = fwk_notification_notify(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    notification_event_count = 0;
+
+    result = fwk_notification_get_subscriber_count(
+        FWK_ID_NOTIFICATION(0x2, 0x1), FWK_ID_ELEMENT(0x2, 0x9), &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 2);
+}
+
+static void test_fwk_notification_notify_and_collect(void)
+{
+    int result, status;
+    unsigned int count;
+    struct fwk_event response;
+    struct fwk_event notification_event = {
+        .id = FWK_ID_NOTIFICATION(0x2, 0x1),
+        .source_id = FWK_ID_ELEMENT(0x2, 0x9),
+    };
+    const struct fwk_notification_completion_params *params =
+        (const struct fwk_notification_completion_params *)
+            put_event_table[0].params;
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_ELEMENT(0x2, 0x9),
+                                        FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_ELEMENT(0x2, 0x9),
+                                        FWK_ID_ELEMENT(0x6, 0x1));
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_notification_notify_and_collect(
+        &notification_event, FWK_ID_EVENT(0x2, 0x3), &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 2);
+    assert(notification_event_count == 2);
+    assert(notification_event_table[0].response_requested);
+    assert(put_event_count == 0);
+
+    /* The collection is kept with the subscribers of the source */
+    assert(fake_element_subscribers_table[0x1].collection.in_use);
+    assert(fake_element_subscribers_table[0x1].collection.expected_count == 2);
+
+    /* The responses to a notification are collected once at a time */
+    result = fwk_notification_notify_and_collect(
+        &notification_event, FWK_ID_EVENT(0x2, 0x3), &count);
+    assert(result == FWK_E_BUSY);
+    assert(notification_event_count == 2);
+
+    response = notification_event_table[0];
+    response.is_response = true;
+    response.source_id = response.target_id;
+    response.target_id = FWK_ID_ELEMENT(0x2, 0x9);
+
+    /* Responses to other notifications are left to their target */
+    response.id = FWK_ID_NOTIFICATION(0x2, 0x2);
+    assert(!__fwk_notification_collect_response(&response));
+    response.id = FWK_ID_NOTIFICATION(0x2, 0x1);
+
+    status = FWK_E_DEVICE;
+    memcpy(response.params, &status, sizeof(status));
+    assert(__fwk_notification_collect_response(&response));
+    assert(put_event_count == 0);
+
+    status = FWK_SUCCESS;
+    memcpy(response.params, &status, sizeof(status));
+    assert(__fwk_notification_collect_response(&response));
+
+    /* The last response completes the collection */
+    assert(put_event_count == 1);
+    assert(fwk_id_is_equal(put_event_table[0].id, FWK_ID_EVENT(0x2, 0x3)));
+    assert(fwk_id_is_equal(put_event_table[0].target_id,
+                           FWK_ID_ELEMENT(0x2, 0x9)));
+    assert(fwk_id_is_equal(params->notification_id,
+                           FWK_ID_NOTIFICATION(0x2, 0x1)));
+    assert(params->response_count == 2);
+    assert(params->status == FWK_E_DEVICE);
+
+    assert(!fake_element_subscribers_table[0x1].collection.in_use);
+    assert(!__fwk_notification_collect_response(&response));
+}
+
+static void test_fwk_notification_notify_and_collect_no_subscriber(void)
+{
+    int result;
+    unsigned int count;
+    struct fwk_event notification_event = {
+        .id = FWK_ID_NOTIFICATION(0x2, 0x1),
+        .source_id = FWK_ID_ELEMENT(0x2, 0x9),
+    };
+
+    interrupt_get_current_return_val = FWK_SUCCESS;
+    result = fwk_notification_notify_and_collect(
+        &notification_event, FWK_ID_EVENT(0x2, 0x3), &count);
+    assert(result == FWK_E_HANDLER);
+    interrupt_get_current_return_val = FWK_E_STATE;
+
+    /* The completion event must be defined by the source module */
+    result = fwk_notification_notify_and_collect(
+        &notification_event, FWK_ID_EVENT(0x3, 0x3), &count);
+    assert(result == FWK_E_PARAM);
+
+    /* Without subscribers, there is nothing to collect */
+    result = fwk_notification_notify_and_collect(
+        &notification_event, FWK_ID_EVENT(0x2, 0x3), &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 0);
+    assert(put_event_count == 0);
+    assert(!fake_element_subscribers_table[0x1].collection.in_use);
+
+    result = fwk_notification_notify_and_collect(
+        &notification_event, FWK_ID_EVENT(0x2, 0x3), &count);
+    assert(result == FWK_SUCCESS);
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_notification_subscribe),
     FWK_TEST_CASE(test_fwk_notification_unsubscribe),
-    FWK_TEST_CASE(test_fwk_notification_notify)
+    FWK_TEST_CASE(test_fwk_notification_notify),
+    FWK_TEST_CASE(test_fwk_notification_notify_compacted),
+    FWK_TEST_CASE(test_fwk_notification_get_subscriber_count),
+    FWK_TEST_CASE(test_fwk_notification_notify_and_collect),
+    FWK_TEST_CASE(test_fwk_notification_notify_and_collect_no_subscriber),
 };
 
 struct fwk_test_suite_desc test_suite = {
@@ -0,0 +1,288 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Performance tests of the hot paths of the framework. Each test case runs
+ *     a scenario of the functional tests and bounds the number of basic blocks
+ *     it executes per operation, see fwk_test_perf.h. The bounds leave a
+ *     margin of about a half over the cost measured when they were set, so
+ *     that a change making a path twice slower fails the tests.
+ */
+
+#include <internal/fwk_module.h>
+#include <internal/fwk_notification.h>
+#include <internal/fwk_single_thread.h>
+#include <internal/fwk_thread.h>
+
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_list.h>
+#include <fwk_macros.h>
+#include <fwk_notification.h>
+#include <fwk_ring.h>
+#include <fwk_status.h>
+#include <fwk_test.h>
+#include <fwk_test_perf.h>
+#include <fwk_thread.h>
+
+#include <assert.h>
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of events put by the event tests */
+#define EVENT_COUNT 64
+
+/* Number of subscribers of the notification tests */
+#define SUBSCRIBER_COUNT 16
+
+/* Size of the data pushed by the ring tests */
+#define RING_DATA_SIZE 256
+
+/* Bounds, in basic blocks per operation */
+#define PUT_EVENT_BOUND 400
+#define PROCESS_EVENT_BOUND 400
+#define NOTIFY_SUBSCRIBER_BOUND 400
+#define PROCESS_NOTIFICATION_BOUND 420
+#define RING_PUSH_BYTE_BOUND 75
+#define RING_PUSH_BLOCK_BOUND 75
+
+static jmp_buf test_context;
+static struct __fwk_thread_ctx *ctx;
+static unsigned int processed_count;
+
+/* Mock functions */
+void *__wrap_fwk_mm_calloc(size_t num, size_t size)
+{
+    return calloc(num, size);
+}
+
+static struct fwk_module fake_module_desc;
+static struct fwk_module_ctx fake_module_ctx;
+static struct fwk_dlist fake_module_dlist_table[1];
+static struct __fwk_notification_subscribers fake_module_subscribers_table[1];
+struct fwk_module_ctx *__wrap_fwk_module_get_ctx(fwk_id_t id)
+{
+    return &fake_module_ctx;
+}
+
+static struct fwk_element_ctx fake_element_ctx;
+struct fwk_element_ctx *__wrap_fwk_module_get_element_ctx(fwk_id_t id)
+{
+    return &fake_element_ctx;
+}
+
+bool __wrap_fwk_module_is_valid_entity_id(fwk_id_t id)
+{
+    return true;
+}
+
+bool __wrap_fwk_module_is_valid_event_id(fwk_id_t id)
+{
+    return true;
+}
+
+bool __wrap_fwk_module_is_valid_notification_id(fwk_id_t id)
+{
+    return true;
+}
+
+int __wrap_fwk_interrupt_global_enable(void)
+{
+    return FWK_SUCCESS;
+}
+
+int __wrap_fwk_interrupt_global_disable(void)
+{
+    return FWK_SUCCESS;
+}
+
+int __wrap_fwk_interrupt_get_current(unsigned int *interrupt)
+{
+    return FWK_E_STATE;
+}
+
+static int process_event(
+    const struct fwk_event *event,
+    struct fwk_event *response_event)
+{
+    processed_count++;
+
+    return FWK_SUCCESS;
+}
+
+/* The thread is left once it has processed all the events */
+static void idle(const void *idle_ctx)
+{
+    longjmp(test_context, FWK_SUCCESS);
+}
+
+struct fwk_thread_idle_driver fmw_thread_idle_driver(const void **idle_ctx)
+{
+    return (struct fwk_thread_idle_driver){
+        .idle = idle,
+    };
+}
+
+static void process_events(void)
+{
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+}
+
+static int test_suite_setup(void)
+{
+    ctx = __fwk_thread_get_ctx();
+
+    fake_module_desc.process_event = process_event;
+    fake_module_desc.process_notification = process_event;
+    fake_module_ctx.desc = &fake_module_desc;
+    fake_module_ctx.subscription_dlist_table = fake_module_dlist_table;
+    fake_module_ctx.subscribers_table = fake_module_subscribers_table;
+
+    return __fwk_thread_init(EVENT_COUNT);
+}
+
+static void test_case_setup(void)
+{
+    processed_count = 0;
+
+    fwk_list_init(&fake_module_dlist_table[0]);
+    memset(
+        fake_module_subscribers_table,
+        0,
+        sizeof(fake_module_subscribers_table));
+
+    __fwk_notification_reset();
+}
+
+static void test_fwk_perf_event(void)
+{
+    unsigned int i;
+    uint64_t count;
+    int status;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(0),
+        .target_id = FWK_ID_MODULE(0),
+        .id = FWK_ID_EVENT(0, 0),
+    };
+
+    fwk_test_perf_start();
+    for (i = 0; i < EVENT_COUNT; i++) {
+        status = fwk_thread_put_event(&event);
+        assert(status == FWK_SUCCESS);
+    }
+    count = fwk_test_perf_stop();
+
+    assert(fwk_test_perf_check(
+        "fwk_thread_put_event", count, EVENT_COUNT, PUT_EVENT_BOUND));
+
+    fwk_test_perf_start();
+    process_events();
+    count = fwk_test_perf_stop();
+
+    assert(processed_count == EVENT_COUNT);
+    assert(fwk_test_perf_check(
+        "event processing", count, EVENT_COUNT, PROCESS_EVENT_BOUND));
+}
+
+static void test_fwk_perf_notification(void)
+{
+    unsigned int i, subscriber_count;
+    uint64_t count;
+    int status;
+
+    struct fwk_event notification = {
+        .source_id = FWK_ID_MODULE(0),
+        .id = FWK_ID_NOTIFICATION(0, 0),
+    };
+
+    for (i = 0; i < SUBSCRIBER_COUNT; i++) {
+        status = fwk_notification_subscribe(
+            notification.id, notification.source_id, FWK_ID_ELEMENT(0, i));
+        assert(status == FWK_SUCCESS);
+    }
+
+    /* Measure the subscribers table built by the first notification */
+    __fwk_notification_start();
+    status = fwk_notification_notify(&notification, &subscriber_count);
+    assert(status == FWK_SUCCESS);
+    process_events();
+
+    processed_count = 0;
+
+    fwk_test_perf_start();
+    status = fwk_notification_notify(&notification, &subscriber_count);
+    count = fwk_test_perf_stop();
+
+    assert(status == FWK_SUCCESS);
+    assert(subscriber_count == SUBSCRIBER_COUNT);
+    assert(fwk_test_perf_check(
+        "fwk_notification_notify, per subscriber",
+        count,
+        SUBSCRIBER_COUNT,
+        NOTIFY_SUBSCRIBER_BOUND));
+
+    fwk_test_perf_start();
+    process_events();
+    count = fwk_test_perf_stop();
+
+    assert(processed_count == SUBSCRIBER_COUNT);
+    assert(fwk_test_perf_check(
+        "notification processing",
+        count,
+        SUBSCRIBER_COUNT,
+        PROCESS_NOTIFICATION_BOUND));
+}
+
+static void test_fwk_perf_ring(void)
+{
+    static char storage[2 * RING_DATA_SIZE];
+    static const char data[RING_DATA_SIZE];
+
+    struct fwk_ring ring;
+    unsigned int i;
+    uint64_t count;
+
+    fwk_ring_init(&ring, storage, sizeof(storage));
+
+    fwk_test_perf_start();
+    for (i = 0; i < RING_DATA_SIZE; i++)
+        fwk_ring_push(&ring, &data[i], 1);
+    count = fwk_test_perf_stop();
+
+    assert(fwk_ring_get_length(&ring) == RING_DATA_SIZE);
+    assert(fwk_test_perf_check(
+        "fwk_ring_push, one byte at a time",
+        count,
+        RING_DATA_SIZE,
+        RING_PUSH_BYTE_BOUND));
+
+    /* The block wraps around the end of the storage */
+    fwk_test_perf_start();
+    fwk_ring_push(&ring, data, RING_DATA_SIZE);
+    count = fwk_test_perf_stop();
+
+    assert(fwk_ring_get_length(&ring) == (2 * RING_DATA_SIZE));
+    assert(fwk_test_perf_check(
+        "fwk_ring_push, whole block", count, 1, RING_PUSH_BLOCK_BOUND));
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_perf_event),
+    FWK_TEST_CASE(test_fwk_perf_notification),
+    FWK_TEST_CASE(test_fwk_perf_ring),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_perf",
+    .test_suite_setup = test_suite_setup,
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
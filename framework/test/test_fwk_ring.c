@@ -262,6 +262,81 @@ static void test_fwk_ring_push_multiple_fragmented(void)
     assert(data_out[3] == 5);
 }
 
+static void test_fwk_ring_reserve_fragmented(void)
+{
+    size_t data_length;
+    struct fwk_ring_span spans[2];
+
+    const char data_in[3] = { 0, 1, 2 };
+    char data_out[4] = { 127, 127, 127, 127 };
+
+    fwk_ring_push(&ring, data_in, 3);
+    fwk_ring_pop(&ring, NULL, 2);
+
+    data_length = fwk_ring_reserve(&ring, 4, spans);
+    assert(data_length == 3);
+
+    assert(spans[0].size == 1);
+    assert(spans[1].size == 2);
+
+    spans[0].data[0] = 3;
+    spans[1].data[0] = 4;
+    spans[1].data[1] = 5;
+
+    assert(fwk_ring_get_length(&ring) == 1);
+
+    fwk_ring_commit(&ring, data_length);
+
+    assert(fwk_ring_get_length(&ring) == 4);
+    assert(fwk_ring_is_empty(&ring) == false);
+    assert(fwk_ring_is_full(&ring) == true);
+
+    data_length = fwk_ring_reserve(&ring, 1, spans);
+    assert(data_length == 0);
+
+    fwk_ring_pop(&ring, data_out, 4);
+
+    assert(data_out[0] == 2);
+    assert(data_out[1] == 3);
+    assert(data_out[2] == 4);
+    assert(data_out[3] == 5);
+}
+
+static void test_fwk_ring_peek_span_fragmented(void)
+{
+    size_t data_length;
+    struct fwk_ring_span spans[2];
+
+    const char data_in[6] = { 0, 1, 2, 3, 4, 5 };
+
+    fwk_ring_push(&ring, data_in, 2);
+    fwk_ring_pop(&ring, NULL, 2);
+    fwk_ring_push(&ring, data_in, 6);
+
+    data_length = fwk_ring_peek_span(&ring, 3, spans);
+    assert(data_length == 3);
+
+    assert(spans[0].size == 2);
+    assert(spans[0].data[0] == 2);
+    assert(spans[0].data[1] == 3);
+    assert(spans[1].size == 1);
+    assert(spans[1].data[0] == 4);
+
+    assert(fwk_ring_get_length(&ring) == 4);
+
+    fwk_ring_release(&ring, data_length);
+
+    assert(fwk_ring_get_length(&ring) == 1);
+    assert(fwk_ring_is_empty(&ring) == false);
+    assert(fwk_ring_is_full(&ring) == false);
+
+    fwk_ring_release(&ring, 1);
+
+    data_length = fwk_ring_peek_span(&ring, 1, spans);
+    assert(data_length == 0);
+    assert(fwk_ring_is_empty(&ring) == true);
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_ring_pop_empty),
     FWK_TEST_CASE(test_fwk_ring_pop_linear),
@@ -273,6 +348,8 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_ring_push_exceeds_capacity),
     FWK_TEST_CASE(test_fwk_ring_push_multiple_linear),
     FWK_TEST_CASE(test_fwk_ring_push_multiple_fragmented),
+    FWK_TEST_CASE(test_fwk_ring_reserve_fragmented),
+    FWK_TEST_CASE(test_fwk_ring_peek_span_fragmented),
 };
 
 struct fwk_test_suite_desc test_suite = {
@@ -0,0 +1,211 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <internal/fwk_task.h>
+
+#include <fwk_arch.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_task.h>
+#include <fwk_test.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <ucontext.h>
+
+#define TEST_STACK_SIZE 65536
+
+static ucontext_t thread_context;
+static ucontext_t task_context;
+static char task_stack[TEST_STACK_SIZE];
+
+static struct fwk_task task;
+static unsigned int step;
+static uint32_t put_cookie;
+
+static int fake_create(
+    void *stack,
+    size_t stack_size,
+    void (*entry)(void),
+    void **context)
+{
+    getcontext(&task_context);
+    task_context.uc_stack.ss_sp = stack;
+    task_context.uc_stack.ss_size = stack_size;
+    task_context.uc_link = NULL;
+    makecontext(&task_context, entry, 0);
+
+    *context = &task_context;
+
+    return FWK_SUCCESS;
+}
+
+static void fake_switch_to(void **current, void *next)
+{
+    if (*current == NULL)
+        *current = &thread_context;
+
+    swapcontext(*current, next);
+}
+
+static const struct fwk_arch_task_driver driver = {
+    .create = fake_create,
+    .switch_to = fake_switch_to,
+};
+
+int __wrap_fwk_thread_put_event(struct fwk_event *event)
+{
+    assert(event->response_requested);
+
+    event->cookie = put_cookie;
+
+    return FWK_SUCCESS;
+}
+
+static void task_yield(uintptr_t param)
+{
+    assert(param == 42);
+
+    step = 1;
+    assert(fwk_task_yield() == FWK_SUCCESS);
+    step = 2;
+}
+
+static void task_await(uintptr_t param)
+{
+    struct fwk_event event = { 0 };
+    struct fwk_event response = { 0 };
+
+    step = 1;
+    assert(fwk_task_await_response(&event, &response) == FWK_SUCCESS);
+    assert(response.is_response);
+    assert(response.params[0] == 7);
+    step = 2;
+}
+
+static void test_task_no_driver(void)
+{
+    assert(
+        fwk_task_start(
+            &task,
+            FWK_ID_MODULE(FWK_MODULE_IDX_TEST0),
+            task_yield,
+            42,
+            task_stack,
+            sizeof(task_stack)) == FWK_E_SUPPORT);
+    assert(__fwk_task_pop_ready() == NULL);
+}
+
+static void test_task_outside_task(void)
+{
+    struct fwk_event event = { 0 };
+    struct fwk_event response = { 0 };
+
+    assert(__fwk_task_init(&driver) == FWK_SUCCESS);
+
+    assert(fwk_task_yield() == FWK_E_STATE);
+    assert(fwk_task_await_response(&event, &response) == FWK_E_STATE);
+}
+
+static void test_task_yield(void)
+{
+    step = 0;
+
+    assert(__fwk_task_init(&driver) == FWK_SUCCESS);
+    assert(
+        fwk_task_start(
+            &task,
+            FWK_ID_MODULE(FWK_MODULE_IDX_TEST0),
+            task_yield,
+            42,
+            task_stack,
+            sizeof(task_stack)) == FWK_SUCCESS);
+
+    /* A task cannot be started again before it returns */
+    assert(
+        fwk_task_start(
+            &task,
+            FWK_ID_MODULE(FWK_MODULE_IDX_TEST0),
+            task_yield,
+            42,
+            task_stack,
+            sizeof(task_stack)) == FWK_E_BUSY);
+
+    assert(__fwk_task_pop_ready() == &task);
+    assert(__fwk_task_pop_ready() == NULL);
+
+    __fwk_task_resume(&task);
+    assert(step == 1);
+    assert(task.active);
+
+    assert(__fwk_task_pop_ready() == &task);
+    __fwk_task_resume(&task);
+    assert(step == 2);
+    assert(!task.active);
+    assert(__fwk_task_pop_ready() == NULL);
+}
+
+static void test_task_await_response(void)
+{
+    struct fwk_event response = {
+        .is_response = true,
+        .target_id = FWK_ID_MODULE_INIT(FWK_MODULE_IDX_TEST0),
+        .params = { 7 },
+    };
+
+    step = 0;
+    put_cookie = 10;
+
+    assert(__fwk_task_init(&driver) == FWK_SUCCESS);
+    assert(
+        fwk_task_start(
+            &task,
+            FWK_ID_MODULE(FWK_MODULE_IDX_TEST0),
+            task_await,
+            0,
+            task_stack,
+            sizeof(task_stack)) == FWK_SUCCESS);
+
+    assert(__fwk_task_pop_ready() == &task);
+    __fwk_task_resume(&task);
+    assert(step == 1);
+
+    /* The response is followed when its cookie changes */
+    __fwk_task_update_cookie(10, 11);
+
+    response.cookie = 10;
+    assert(!__fwk_task_put_response(&response));
+
+    response.cookie = 11;
+    response.target_id = FWK_ID_MODULE(FWK_MODULE_IDX_TEST1);
+    assert(!__fwk_task_put_response(&response));
+    assert(__fwk_task_pop_ready() == NULL);
+
+    response.target_id = FWK_ID_MODULE(FWK_MODULE_IDX_TEST0);
+    assert(__fwk_task_put_response(&response));
+
+    assert(__fwk_task_pop_ready() == &task);
+    __fwk_task_resume(&task);
+    assert(step == 2);
+    assert(!task.active);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_task_no_driver),
+    FWK_TEST_CASE(test_task_outside_task),
+    FWK_TEST_CASE(test_task_yield),
+    FWK_TEST_CASE(test_task_await_response),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_task",
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -8,6 +8,7 @@
 #include <internal/fwk_module.h>
 #include <internal/fwk_single_thread.h>
 #include <internal/fwk_thread.h>
+#include <internal/fwk_thread_delayed_resp.h>
 
 #include <fwk_assert.h>
 #include <fwk_id.h>
@@ -37,6 +38,15 @@ void *__wrap_fwk_mm_calloc(size_t num, size_t size)
     return NULL;
 }
 
+static bool fwk_mm_alloc_notrap_fail;
+extern void *__real_fwk_mm_alloc_notrap(size_t num, size_t size);
+void *__wrap_fwk_mm_alloc_notrap(size_t num, size_t size)
+{
+    if (fwk_mm_alloc_notrap_fail)
+        return NULL;
+    return __real_fwk_mm_alloc_notrap(num, size);
+}
+
 static struct fwk_module fake_module_desc;
 static struct fwk_module_ctx fake_module_ctx;
 struct fwk_module_ctx *__wrap_fwk_module_get_ctx(fwk_id_t id)
@@ -91,12 +101,24 @@ int __wrap_fwk_interrupt_global_disable(void)
     return FWK_SUCCESS;
 }
 
+int __wrap_fwk_interrupt_global_disable_all(void)
+{
+    return FWK_SUCCESS;
+}
+
 static int interrupt_get_current_return_val;
 int __wrap_fwk_interrupt_get_current(unsigned int *interrupt)
 {
     return interrupt_get_current_return_val;
 }
 
+static unsigned int interrupt_priority;
+int __wrap_fwk_interrupt_get_current_priority(unsigned int *priority)
+{
+    *priority = interrupt_priority;
+    return interrupt_get_current_return_val;
+}
+
 static const struct fwk_event *processed_event;
 static int process_event(const struct fwk_event *event,
                          struct fwk_event *response_event)
@@ -114,6 +136,15 @@ static int process_notification(const struct fwk_event *event,
     return FWK_SUCCESS;
 }
 
+static unsigned int idle_count;
+static void idle(const void *idle_ctx)
+{
+    assert(idle_ctx == &idle_count);
+
+    idle_count++;
+    longjmp(test_context, FWK_SUCCESS);
+}
+
 static int test_suite_setup(void)
 {
     ctx = __fwk_thread_get_ctx();
@@ -130,7 +161,9 @@ static void test_case_setup(void)
     is_valid_event_id_return_val = true;
     is_valid_notification_id_return_val = true;
     interrupt_get_current_return_val = FWK_E_STATE;
+    interrupt_priority = FWK_THREAD_ISR_EVENT_RING_LEVELS;
     fwk_mm_calloc_return_val = true;
+    fwk_mm_alloc_notrap_fail = false;
     fake_module_desc.process_event = process_event;
     fake_module_ctx.desc = &fake_module_desc;
 }
@@ -140,6 +173,7 @@ static void test_case_teardown(void)
     *ctx = (struct __fwk_thread_ctx){ };
     fwk_list_init(&ctx->free_event_queue);
     fwk_list_init(&ctx->event_queue);
+    fwk_list_init(&ctx->high_priority_event_queue);
     fwk_list_init(&ctx->isr_event_queue);
 }
 
@@ -318,6 +352,67 @@ static void test___fwk_thread_run(void)
                            FWK_ID_NOTIFICATION(0x5, 0x9)));
 }
 
+static void test___fwk_thread_run_priority(void)
+{
+    int result;
+    struct fwk_event *free_event;
+
+    struct fwk_event normal_event = {
+        .source_id = FWK_ID_MODULE(0x1),
+        .target_id = FWK_ID_MODULE(0x2),
+        .response_requested = false,
+        .id = FWK_ID_EVENT(0x2, 0x7),
+    };
+
+    struct fwk_event high_event = {
+        .source_id = FWK_ID_MODULE(0x3),
+        .target_id = FWK_ID_MODULE(0x4),
+        .response_requested = false,
+        .priority = FWK_EVENT_PRIORITY_HIGH,
+        .id = FWK_ID_EVENT(0x4, 0x8),
+    };
+
+    result = __fwk_thread_init(4);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_put_event(&normal_event);
+    assert(result == FWK_SUCCESS);
+    result = fwk_thread_put_event(&high_event);
+    assert(result == FWK_SUCCESS);
+    result = fwk_thread_put_event(&high_event);
+    assert(result == FWK_SUCCESS);
+    assert(!fwk_list_is_empty(&ctx->event_queue));
+    assert(!fwk_list_is_empty(&ctx->high_priority_event_queue));
+
+    free_event_queue_break = true;
+
+    /* The high priority event is processed first */
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(processed_event->priority == FWK_EVENT_PRIORITY_HIGH);
+    assert(ctx->priority_burst_count == 1);
+
+    /* The normal priority event is processed once the burst limit is hit */
+    ctx->priority_burst_count = FWK_THREAD_PRIORITY_BURST_MAX;
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(processed_event->priority == FWK_EVENT_PRIORITY_NORMAL);
+    assert(ctx->priority_burst_count == 0);
+    assert(fwk_list_is_empty(&ctx->event_queue));
+
+    /* The remaining high priority event */
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(processed_event->priority == FWK_EVENT_PRIORITY_HIGH);
+    assert(fwk_list_is_empty(&ctx->high_priority_event_queue));
+
+    free_event_queue_break = false;
+    do {
+        free_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->free_event_queue),
+            struct fwk_event, slist_node);
+    } while (free_event != NULL);
+}
+
 static void test_fwk_thread_put_event(void)
 {
     int result;
@@ -386,6 +481,210 @@ static void test_fwk_thread_put_event(void)
     assert(result_event->is_notification == false);
 }
 
+static void test_fwk_thread_put_event_isr_ring(void)
+{
+    int result;
+    struct fwk_event *free_event;
+    struct __fwk_isr_event_ring *ring;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(0x1),
+        .target_id = FWK_ID_MODULE(0x2),
+        .response_requested = false,
+        .id = FWK_ID_EVENT(0x2, 0x7),
+    };
+
+    result = __fwk_thread_init(2);
+    assert(result == FWK_SUCCESS);
+
+    /* An ISR of a priority level with a ring does not use the free queue */
+    interrupt_get_current_return_val = FWK_SUCCESS;
+    interrupt_priority = FWK_THREAD_ISR_EVENT_RING_LEVELS - 1;
+    ring = &ctx->isr_event_rings[interrupt_priority];
+
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+    assert(ring->tail == 1);
+    assert(fwk_list_is_empty(&ctx->isr_event_queue));
+    assert(ctx->free_event_queue.head != ctx->free_event_queue.tail);
+
+    /* An ISR of a priority level without a ring uses the ISR event queue */
+    interrupt_priority = FWK_THREAD_ISR_EVENT_RING_LEVELS;
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+    assert(!fwk_list_is_empty(&ctx->isr_event_queue));
+
+    /* The ring is drained before the ISR event queue */
+    interrupt_get_current_return_val = FWK_E_STATE;
+    free_event_queue_break = true;
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(ring->head == 1);
+    assert(processed_event->cookie == ring->events[0].cookie);
+    assert(!fwk_list_is_empty(&ctx->isr_event_queue));
+
+    free_event_queue_break = false;
+    do {
+        free_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->free_event_queue),
+            struct fwk_event, slist_node);
+    } while (free_event != NULL);
+}
+
+static void test_fwk_thread_get_queue_stats(void)
+{
+    int result;
+    struct fwk_thread_queue_stats stats;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(0x1),
+        .target_id = FWK_ID_MODULE(0x2),
+        .response_requested = false,
+        .id = FWK_ID_EVENT(0x2, 0x7),
+    };
+
+    result = fwk_thread_get_queue_stats(NULL);
+    assert(result == FWK_E_PARAM);
+
+    result = __fwk_thread_init(3);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_get_queue_stats(&stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.high_priority == 0);
+    assert(stats.normal == 2);
+    assert(stats.isr == 0);
+    assert(stats.free == 1);
+    assert(stats.free_low_water == 1);
+    assert(stats.capacity == 3);
+    assert(stats.peak_used == 2);
+    assert(stats.grown == 0);
+
+    /* Processing an event frees its structure but keeps the low-water mark */
+    free_event_queue_break = true;
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    free_event_queue_break = false;
+
+    result = fwk_thread_get_queue_stats(&stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.normal == 1);
+    assert(stats.free == 2);
+    assert(stats.free_low_water == 1);
+    assert(stats.peak_used == 2);
+}
+
+static void test_fwk_thread_event_pool_growth(void)
+{
+    int result;
+    struct fwk_thread_queue_stats stats;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(0x1),
+        .target_id = FWK_ID_MODULE(0x2),
+        .id = FWK_ID_EVENT(0x2, 0x7),
+    };
+
+    result = __fwk_thread_init(1);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+
+    /* Interrupt service routines do not grow the pool */
+    interrupt_get_current_return_val = FWK_SUCCESS;
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_E_NOMEM);
+    interrupt_get_current_return_val = FWK_E_STATE;
+
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_get_queue_stats(&stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.normal == 2);
+    assert(stats.free == 1);
+    assert(stats.capacity == (1 + FMW_EVENT_POOL_GROWTH));
+    assert(stats.peak_used == 2);
+    assert(stats.grown == FMW_EVENT_POOL_GROWTH);
+}
+
+static void test_fwk_thread_delayed_response_index(void)
+{
+    int result;
+    unsigned int i;
+    size_t count, peak_count;
+    fwk_id_t id = FWK_ID_MODULE(0x2);
+    struct fwk_event events[4] = { 0 };
+
+    /* Eight slots: cookies 1, 9 and 17 share their home slot */
+    static const uint32_t cookies[FWK_ARRAY_SIZE(events)] = { 1, 9, 2, 17 };
+
+    result = __fwk_thread_init(FWK_ARRAY_SIZE(events));
+    assert(result == FWK_SUCCESS);
+    fwk_list_init(&fake_module_ctx.delayed_response_list);
+
+    for (i = 0; i < FWK_ARRAY_SIZE(events); i++) {
+        events[i].source_id = id;
+        events[i].cookie = cookies[i];
+        __fwk_thread_add_delayed_response(id, &events[i]);
+    }
+
+    for (i = 0; i < FWK_ARRAY_SIZE(events); i++)
+        assert(__fwk_thread_search_delayed_response(id, cookies[i]) ==
+            &events[i]);
+
+    assert(__fwk_thread_search_delayed_response(id, 25) == NULL);
+    assert(__fwk_thread_search_delayed_response(FWK_ID_MODULE(0x3), 9) ==
+        NULL);
+
+    /* Removing the head of a probe sequence keeps the rest reachable */
+    __fwk_thread_remove_delayed_response(id, &events[0]);
+    assert(__fwk_thread_search_delayed_response(id, 1) == NULL);
+    assert(__fwk_thread_search_delayed_response(id, 9) == &events[1]);
+    assert(__fwk_thread_search_delayed_response(id, 2) == &events[2]);
+    assert(__fwk_thread_search_delayed_response(id, 17) == &events[3]);
+
+    result = fwk_thread_get_delayed_response_count(&count, &peak_count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 3);
+    assert(peak_count == 4);
+
+    /* Growing the index keeps the delayed responses reachable */
+    result = __fwk_thread_delayed_response_grow(2 * FWK_ARRAY_SIZE(events));
+    assert(result == FWK_SUCCESS);
+    assert(__fwk_thread_search_delayed_response(id, 9) == &events[1]);
+    assert(__fwk_thread_search_delayed_response(id, 2) == &events[2]);
+    assert(__fwk_thread_search_delayed_response(id, 17) == &events[3]);
+
+    /* A delayed response may be recorded ahead of the others */
+    __fwk_thread_add_delayed_response_head(id, &events[0]);
+    assert(fwk_list_head(&fake_module_ctx.delayed_response_list) ==
+        &events[0].slist_node);
+    assert(__fwk_thread_search_delayed_response(id, 1) == &events[0]);
+
+    result = fwk_thread_get_delayed_response_count(&count, &peak_count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 4);
+    assert(peak_count == 4);
+
+    for (i = 0; i < FWK_ARRAY_SIZE(events); i++)
+        __fwk_thread_remove_delayed_response(id, &events[i]);
+
+    assert(fwk_list_is_empty(&fake_module_ctx.delayed_response_list));
+
+    result = fwk_thread_get_delayed_response_count(&count, NULL);
+    assert(result == FWK_E_PARAM);
+    result = fwk_thread_get_delayed_response_count(&count, &peak_count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 0);
+    assert(peak_count == 4);
+}
+
 static void test___fwk_thread_put_notification(void)
 {
     int result;
@@ -433,10 +732,99 @@ static void test___fwk_thread_put_notification(void)
     assert(result_event->is_notification == true);
 }
 
+static void test___fwk_thread_run_idle(void)
+{
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(0x1),
+        .target_id = FWK_ID_MODULE(0x2),
+        .id = FWK_ID_EVENT(0x2, 0x7),
+    };
+
+    assert(__fwk_thread_init(1) == FWK_SUCCESS);
+
+    ctx->idle_driver.idle = idle;
+    ctx->idle_driver_ctx = &idle_count;
+    idle_count = 0;
+
+    /* Nothing to process, the idle driver is called */
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(idle_count == 1);
+
+    /* Work raised by an ISR keeps the thread from going idle */
+    __real___fwk_slist_push_tail(&ctx->isr_event_queue, &(event.slist_node));
+
+    free_event_queue_break = true;
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(idle_count == 1);
+    assert(processed_event == &event);
+}
+
+static void test___fwk_thread_run_isr_ring_stall(void)
+{
+    struct fwk_event *held_event;
+    struct __fwk_isr_event_ring *ring;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(0x1),
+        .target_id = FWK_ID_MODULE(0x2),
+        .id = FWK_ID_EVENT(0x2, 0x7),
+        .cookie = 0x1234,
+    };
+
+    assert(__fwk_thread_init(1) == FWK_SUCCESS);
+
+    ctx->idle_driver.idle = idle;
+    ctx->idle_driver_ctx = &idle_count;
+    idle_count = 0;
+
+    /* The only event structure is in use and the pool cannot grow */
+    held_event = FWK_LIST_GET(
+        fwk_list_pop_head(&ctx->free_event_queue),
+        struct fwk_event,
+        slist_node);
+    ctx->free_event_count--;
+    fwk_mm_alloc_notrap_fail = true;
+
+    interrupt_get_current_return_val = FWK_SUCCESS;
+    interrupt_priority = 0;
+    ring = &ctx->isr_event_rings[interrupt_priority];
+    assert(fwk_thread_put_event(&event) == FWK_SUCCESS);
+    interrupt_get_current_return_val = FWK_E_STATE;
+
+    /* The stalled ring does not keep the thread from going idle */
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(idle_count == 1);
+    assert(ctx->isr_event_ring_stalled);
+    assert(ring->head == 0);
+
+    /* Once the event structure is freed, the ring is drained */
+    *held_event = event;
+    held_event->cookie = 0;
+    held_event->slist_node = (struct fwk_slist_node){ 0 };
+    __real___fwk_slist_push_tail(&ctx->event_queue, &held_event->slist_node);
+
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(idle_count == 2);
+    assert(!ctx->isr_event_ring_stalled);
+    assert(ring->head == 1);
+    assert(processed_event->cookie == event.cookie);
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test___fwk_thread_init),
     FWK_TEST_CASE(test___fwk_thread_run),
+    FWK_TEST_CASE(test___fwk_thread_run_priority),
+    FWK_TEST_CASE(test___fwk_thread_run_idle),
     FWK_TEST_CASE(test_fwk_thread_put_event),
+    FWK_TEST_CASE(test_fwk_thread_put_event_isr_ring),
+    FWK_TEST_CASE(test___fwk_thread_run_isr_ring_stall),
+    FWK_TEST_CASE(test_fwk_thread_get_queue_stats),
+    FWK_TEST_CASE(test_fwk_thread_event_pool_growth),
+    FWK_TEST_CASE(test_fwk_thread_delayed_response_index),
     FWK_TEST_CASE(test___fwk_thread_put_notification)
 };
 
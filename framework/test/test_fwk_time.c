@@ -0,0 +1,79 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_assert.h>
+#include <fwk_macros.h>
+#include <fwk_test.h>
+#include <fwk_time.h>
+
+#include <stdint.h>
+
+#define CYCLE_FREQUENCY UINT32_C(3000000)
+
+/* Starts close to the wrap-around of the counter */
+static uint32_t cycle_counter = UINT32_MAX - 2;
+
+static uint32_t cycles(const void *ctx)
+{
+    return cycle_counter;
+}
+
+struct fwk_time_profile_driver fmw_time_profile_driver(const void **ctx)
+{
+    return (struct fwk_time_profile_driver){
+        .cycles = cycles,
+        .frequency = CYCLE_FREQUENCY,
+    };
+}
+
+static void test_fwk_time_profile_scale(void)
+{
+    fwk_timestamp_t start = fwk_time_profile_current();
+
+    cycle_counter += CYCLE_FREQUENCY / 1000;
+
+    assert(fwk_time_duration(start, fwk_time_profile_current()) == FWK_MS(1));
+}
+
+static void test_fwk_time_profile_wrap_around(void)
+{
+    fwk_timestamp_t start;
+
+    cycle_counter = UINT32_MAX - 2;
+    start = fwk_time_profile_current();
+
+    /* One cycle lasts 333.33 nanoseconds */
+    cycle_counter += 6;
+
+    assert(fwk_time_duration(start, fwk_time_profile_current()) == 2000);
+}
+
+static void test_fwk_time_profile_long_uptime(void)
+{
+    fwk_timestamp_t start = fwk_time_profile_current();
+    unsigned int i;
+
+    /* Steps shorter than the wrap-around period, for 20 minutes in total */
+    for (i = 0; i < 1200; i++) {
+        cycle_counter += CYCLE_FREQUENCY;
+        (void)fwk_time_profile_current();
+    }
+
+    assert(fwk_time_duration(start, fwk_time_profile_current()) == FWK_M(20));
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_time_profile_scale),
+    FWK_TEST_CASE(test_fwk_time_profile_wrap_around),
+    FWK_TEST_CASE(test_fwk_time_profile_long_uptime),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_time",
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
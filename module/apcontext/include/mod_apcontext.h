@@ -10,6 +10,7 @@
 #define MOD_APCONTEXT_H
 
 #include <fwk_id.h>
+#include <fwk_module_idx.h>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -21,6 +22,12 @@
  * \brief Application Processor (AP) context module.
  *
  * \details This module implements the AP context zero-initialization.
+ *
+ *      The area is zeroed by the SCP core unless a memory fill driver is
+ *      configured, in which case the driver is asked to zero the area, for
+ *      instance with a DMA engine, and may do it asynchronously. A
+ *      ::mod_apcontext_notification_id_zeroed notification is sent once the
+ *      area is zeroed.
  * \{
  */
 
@@ -36,8 +43,91 @@ struct mod_apcontext_config {
 
     /*! Identifier of the clock this module depends on */
     fwk_id_t clock_id;
+
+    /*!
+     * \brief Identifier of the memory fill driver.
+     *
+     * \details May be ::FWK_ID_NONE, in which case the area is zeroed by the
+     *      SCP core.
+     */
+    fwk_id_t fill_id;
+
+    /*! Identifier of the ::mod_apcontext_fill_api API of the driver */
+    fwk_id_t fill_api_id;
+};
+
+/*!
+ * \brief Memory fill driver API.
+ *
+ * \details API implemented by the drivers of the engines able to zero memory
+ *      on behalf of the SCP core.
+ */
+struct mod_apcontext_fill_api {
+    /*!
+     * \brief Zero an area of memory.
+     *
+     * \param id Identifier of the driver.
+     * \param base Base address of the area.
+     * \param size Size of the area in bytes.
+     *
+     * \retval ::FWK_SUCCESS The area has been zeroed.
+     * \retval ::FWK_PENDING The area is being zeroed, and the driver reports
+     *      the completion through
+     *      ::mod_apcontext_fill_response_api::fill_complete.
+     * \return One of the other standard framework status codes, in which case
+     *      the area is zeroed by the SCP core.
+     */
+    int (*zero)(fwk_id_t id, uintptr_t base, size_t size);
+};
+
+/*!
+ * \brief Memory fill driver response API.
+ *
+ * \details API used by the memory fill driver to report the completion of a
+ *      pending request. It may be called from an interrupt handler.
+ */
+struct mod_apcontext_fill_response_api {
+    /*!
+     * \brief Report the completion of a request.
+     *
+     * \param status ::FWK_SUCCESS if the area has been zeroed, one of the other
+     *      standard framework status codes otherwise, in which case the area
+     *      is zeroed by the SCP core.
+     */
+    void (*fill_complete)(int status);
 };
 
+/*!
+ * \brief API indices.
+ */
+enum mod_apcontext_api_idx {
+    /*! Memory fill driver response API */
+    MOD_APCONTEXT_API_IDX_FILL_RESPONSE,
+
+    /*! Number of defined APIs */
+    MOD_APCONTEXT_API_IDX_COUNT,
+};
+
+/*!
+ * \brief Notification indices.
+ */
+enum mod_apcontext_notification_idx {
+    /*! The AP context area has been zeroed */
+    MOD_APCONTEXT_NOTIFICATION_IDX_ZEROED,
+
+    /*! Number of defined notifications */
+    MOD_APCONTEXT_NOTIFICATION_IDX_COUNT,
+};
+
+/*!
+ * \brief Identifier of the ::MOD_APCONTEXT_NOTIFICATION_IDX_ZEROED
+ *      notification.
+ */
+static const fwk_id_t mod_apcontext_notification_id_zeroed =
+    FWK_ID_NOTIFICATION_INIT(
+        FWK_MODULE_IDX_APCONTEXT,
+        MOD_APCONTEXT_NOTIFICATION_IDX_ZEROED);
+
 /*!
  * \}
  */
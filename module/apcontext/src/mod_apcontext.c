@@ -16,15 +16,56 @@
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <string.h>
 
 #define MODULE_NAME "[APContext]"
 
+/* Event indices */
+enum apcontext_event_idx {
+    /* The memory fill driver has completed a request */
+    APCONTEXT_EVENT_IDX_FILL_COMPLETE,
+
+    /* Number of events */
+    APCONTEXT_EVENT_IDX_COUNT
+};
+
+/* Parameters of the fill completion event */
+struct apcontext_fill_complete_params {
+    /* Status of the request */
+    int status;
+};
+
+/* Module context */
+struct apcontext_ctx {
+    /* Memory fill driver API, NULL if the area is zeroed by the SCP core */
+    const struct mod_apcontext_fill_api *fill_api;
+};
+
+static struct apcontext_ctx apcontext_ctx;
+
+static void apcontext_zeroed(void)
+{
+    struct fwk_event outbound_event = {
+        .id = mod_apcontext_notification_id_zeroed,
+        .source_id = fwk_module_id_apcontext,
+    };
+    unsigned int notifications_sent;
+    int status;
+
+    FWK_LOG_INFO(MODULE_NAME " AP context area zeroed");
+
+    status = fwk_notification_notify(&outbound_event, &notifications_sent);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
 static void apcontext_zero(void)
 {
     const struct mod_apcontext_config *config;
+    int status;
 
     config = fwk_module_get_data(fwk_module_id_apcontext);
 
@@ -34,9 +75,54 @@ static void apcontext_zero(void)
         config->base,
         config->base + config->size);
 
+    if (apcontext_ctx.fill_api != NULL) {
+        status = apcontext_ctx.fill_api->zero(
+            config->fill_id, config->base, config->size);
+        if (status == FWK_PENDING)
+            return;
+
+        if (status == FWK_SUCCESS) {
+            apcontext_zeroed();
+            return;
+        }
+
+        FWK_LOG_WARN(
+            MODULE_NAME " Memory fill driver failed (%d), zeroing from SCP",
+            status);
+    }
+
     memset((void *)config->base, 0, config->size);
+
+    apcontext_zeroed();
+}
+
+/*
+ * Memory fill driver response API
+ */
+
+static void apcontext_fill_complete(int status)
+{
+    struct apcontext_fill_complete_params *params;
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(
+            FWK_MODULE_IDX_APCONTEXT, APCONTEXT_EVENT_IDX_FILL_COMPLETE),
+        .source_id = fwk_module_id_apcontext,
+        .target_id = fwk_module_id_apcontext,
+    };
+    int put_status;
+
+    params = (struct apcontext_fill_complete_params *)event.params;
+    params->status = status;
+
+    /* The driver may report from an interrupt handler */
+    put_status = fwk_thread_put_event(&event);
+    fwk_assert(put_status == FWK_SUCCESS);
 }
 
+static const struct mod_apcontext_fill_response_api fill_response_api = {
+    .fill_complete = apcontext_fill_complete,
+};
+
 /*
  * Framework handlers
  */
@@ -59,6 +145,49 @@ static int apcontext_init(fwk_id_t module_id, unsigned int element_count,
     return FWK_SUCCESS;
 }
 
+static bool apcontext_has_fill_driver(const struct mod_apcontext_config *config)
+{
+    return fwk_id_is_type(config->fill_id, FWK_ID_TYPE_MODULE) ||
+        fwk_id_is_type(config->fill_id, FWK_ID_TYPE_ELEMENT);
+}
+
+static int apcontext_bind(fwk_id_t id, unsigned int round)
+{
+    const struct mod_apcontext_config *config;
+
+    if (round != 0)
+        return FWK_SUCCESS;
+
+    config = fwk_module_get_data(fwk_module_id_apcontext);
+    if (!apcontext_has_fill_driver(config))
+        return FWK_SUCCESS;
+
+    return fwk_module_bind(
+        config->fill_id, config->fill_api_id, &apcontext_ctx.fill_api);
+}
+
+static int apcontext_process_bind_request(fwk_id_t requester_id,
+    fwk_id_t target_id, fwk_id_t api_id, const void **api)
+{
+    const struct mod_apcontext_config *config;
+
+    config = fwk_module_get_data(fwk_module_id_apcontext);
+
+    /* Only the memory fill driver may bind to the response API */
+    if (!apcontext_has_fill_driver(config) ||
+        !fwk_id_is_equal(
+            fwk_id_build_module_id(requester_id),
+            fwk_id_build_module_id(config->fill_id)))
+        return FWK_E_ACCESS;
+
+    if (fwk_id_get_api_idx(api_id) != MOD_APCONTEXT_API_IDX_FILL_RESPONSE)
+        return FWK_E_PARAM;
+
+    *api = &fill_response_api;
+
+    return FWK_SUCCESS;
+}
+
 static int apcontext_start(fwk_id_t id)
 {
     const struct mod_apcontext_config *config =
@@ -76,6 +205,30 @@ static int apcontext_start(fwk_id_t id)
         id);
 }
 
+static int apcontext_process_event(const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    const struct mod_apcontext_config *config;
+    const struct apcontext_fill_complete_params *params;
+
+    if (fwk_id_get_event_idx(event->id) != APCONTEXT_EVENT_IDX_FILL_COMPLETE)
+        return FWK_E_PARAM;
+
+    params = (const struct apcontext_fill_complete_params *)event->params;
+    if (params->status != FWK_SUCCESS) {
+        FWK_LOG_WARN(
+            MODULE_NAME " Memory fill driver failed (%d), zeroing from SCP",
+            params->status);
+
+        config = fwk_module_get_data(fwk_module_id_apcontext);
+        memset((void *)config->base, 0, config->size);
+    }
+
+    apcontext_zeroed();
+
+    return FWK_SUCCESS;
+}
+
 static int apcontext_process_notification(const struct fwk_event *event,
     struct fwk_event *resp_event)
 {
@@ -105,7 +258,13 @@ static int apcontext_process_notification(const struct fwk_event *event,
 const struct fwk_module module_apcontext = {
     .name = "APContext",
     .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_APCONTEXT_API_IDX_COUNT,
+    .event_count = APCONTEXT_EVENT_IDX_COUNT,
+    .notification_count = MOD_APCONTEXT_NOTIFICATION_IDX_COUNT,
     .init = apcontext_init,
+    .bind = apcontext_bind,
     .start = apcontext_start,
+    .process_bind_request = apcontext_process_bind_request,
+    .process_event = apcontext_process_event,
     .process_notification = apcontext_process_notification,
 };
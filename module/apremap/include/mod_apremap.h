@@ -13,6 +13,7 @@
 
 #include <fwk_macros.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*!
@@ -121,6 +122,45 @@ struct mod_apremap_rw_api {
      * \param value Doubleword value to be written
      */
     void (*mmio_ap_mem_write_64)(uint64_t addr, uint64_t value);
+
+    /*!
+     * \brief Read a block of Application Processor's memory
+     *
+     * \details The AP memory is mapped once for the whole block and only
+     *      remapped at 1MB boundaries, so this is much faster than a loop of
+     *      single accesses.
+     *
+     * \param addr Address of the AP address space
+     * \param[out] buffer Buffer receiving the data
+     * \param size Number of bytes to read
+     */
+    void (*mmio_ap_mem_read_block)(uint64_t addr, void *buffer, size_t size);
+
+    /*!
+     * \brief Write a block to Application Processor's memory
+     *
+     * \details The AP memory is mapped once for the whole block and only
+     *      remapped at 1MB boundaries.
+     *
+     * \param addr Address of the AP address space
+     * \param buffer Data to be written
+     * \param size Number of bytes to write
+     */
+    void (*mmio_ap_mem_write_block)(
+        uint64_t addr,
+        const void *buffer,
+        size_t size);
+
+    /*!
+     * \brief Copy a block between two Application Processor's addresses
+     *
+     * \details The regions must not overlap.
+     *
+     * \param dst Destination address of the AP address space
+     * \param src Source address of the AP address space
+     * \param size Number of bytes to copy
+     */
+    void (*mmio_ap_mem_copy)(uint64_t dst, uint64_t src, size_t size);
 };
 
 /*!
@@ -15,6 +15,10 @@
 #define APREMAP_ADDR_TRANS_AP_ADDR_SHIFT 20
 
 #define APREMAP_1MB_ADDR(addr) (0xCB000000 + ((uintptr_t)addr & 0xFFFFF))
+#define APREMAP_1MB_WINDOW_SIZE (1 * FWK_MIB)
+
+/* Size of the bounce buffer used to copy between two AP addresses */
+#define APREMAP_COPY_CHUNK_SIZE 256
 
 #define SYSTEM_ACCESS_PORT_0_BASE 0x60000000
 #define SYSTEM_ACCESS_PORT_1_BASE 0xA0000000
@@ -22,7 +22,10 @@
 
 #include <fmw_cmsis.h>
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 /* Module Context */
 struct apremap_ctx {
@@ -107,7 +110,7 @@ static inline bool is_addr_second_1gb_block(uint64_t addr)
  */
 static inline bool is_addr_above_2gb(uint64_t addr)
 {
-    return ((addr >= (1 * FWK_GIB)) && (addr < (2 * FWK_GIB)));
+    return (addr >= (2 * FWK_GIB));
 }
 
 /*
@@ -360,6 +363,116 @@ static void mmio_ap_mem_write(
         fwk_unexpected();
 }
 
+/*
+ * Map an AP address into the MSCP address space, programming the 1MB window
+ * if needed, and return the number of bytes that can be accessed from the
+ * mapped address before the mapping has to change.
+ *
+ * The caller must have disabled the CMN address translation.
+ */
+static uintptr_t map_ap_memory(uint64_t addr, size_t *span)
+{
+    if (is_addr_first_1gb_block(addr)) {
+        *span = (size_t)((1 * FWK_GIB) - addr);
+        return ADDR_OFFSET_SYSTEM_ACCESS_PORT_1(addr);
+    } else if (is_addr_second_1gb_block(addr)) {
+        *span = (size_t)((2 * FWK_GIB) - addr);
+        return ADDR_OFFSET_SYSTEM_ACCESS_PORT_0(addr);
+    }
+
+    enable_addr_trans(addr);
+    *span = APREMAP_1MB_WINDOW_SIZE - (size_t)(addr & 0xFFFFF);
+
+    return APREMAP_1MB_ADDR(addr);
+}
+
+/*
+ * Copy between a mapped AP region and a local buffer. The AP side is accessed
+ * with 64-bit accesses once aligned, the local buffer may have any alignment.
+ */
+static void copy_mapped(uintptr_t mapped, uint8_t *buffer, size_t size,
+                        bool write)
+{
+    uint64_t word;
+
+    while ((size > 0) && ((mapped % sizeof(uint64_t)) != 0)) {
+        if (write)
+            *(volatile uint8_t *)mapped = *buffer;
+        else
+            *buffer = *(volatile uint8_t *)mapped;
+
+        mapped++;
+        buffer++;
+        size--;
+    }
+
+    while (size >= sizeof(uint64_t)) {
+        if (write) {
+            memcpy(&word, buffer, sizeof(word));
+            *(volatile uint64_t *)mapped = word;
+        } else {
+            word = *(volatile uint64_t *)mapped;
+            memcpy(buffer, &word, sizeof(word));
+        }
+
+        mapped += sizeof(uint64_t);
+        buffer += sizeof(uint64_t);
+        size -= sizeof(uint64_t);
+    }
+
+    while (size > 0) {
+        if (write)
+            *(volatile uint8_t *)mapped = *buffer;
+        else
+            *buffer = *(volatile uint8_t *)mapped;
+
+        mapped++;
+        buffer++;
+        size--;
+    }
+}
+
+/*
+ * Common bulk transfer function. The CMN address translation is disabled and
+ * the 1MB window programmed once for the whole transfer, the window only
+ * moving when the transfer crosses a 1MB boundary.
+ */
+static void mmio_ap_mem_transfer(uint64_t addr, uint8_t *buffer, size_t size,
+                                 bool write)
+{
+    bool cmn_addr_trans_active = ctx.cmn_addr_trans_enabled;
+    bool window_active = false;
+    uintptr_t mapped;
+    size_t span;
+    size_t chunk;
+
+    if (size == 0)
+        return;
+
+    if (cmn_addr_trans_active)
+        disable_cmn_addr_trans();
+
+    while (size > 0) {
+        mapped = map_ap_memory(addr, &span);
+        window_active = window_active || is_addr_above_2gb(addr);
+
+        chunk = (size < span) ? size : span;
+        copy_mapped(mapped, buffer, chunk, write);
+
+        addr += chunk;
+        buffer += chunk;
+        size -= chunk;
+    }
+
+    __DSB();
+
+    if (window_active)
+        disable_addr_trans();
+
+    if (cmn_addr_trans_active)
+        enable_cmn_addr_trans();
+}
+
 /*
  * Module API functions
  */
@@ -416,6 +529,41 @@ static void mmio_ap_mem_write_64(uint64_t addr, uint64_t value)
     mmio_ap_mem_write(addr, &value, TYPE_UINT64);
 }
 
+static void mmio_ap_mem_read_block(uint64_t addr, void *buffer, size_t size)
+{
+    fwk_assert((buffer != NULL) || (size == 0));
+
+    mmio_ap_mem_transfer(addr, buffer, size, false);
+}
+
+static void mmio_ap_mem_write_block(
+    uint64_t addr,
+    const void *buffer,
+    size_t size)
+{
+    fwk_assert((buffer != NULL) || (size == 0));
+
+    mmio_ap_mem_transfer(addr, (uint8_t *)buffer, size, true);
+}
+
+static void mmio_ap_mem_copy(uint64_t dst, uint64_t src, size_t size)
+{
+    uint8_t chunk_buffer[APREMAP_COPY_CHUNK_SIZE];
+    size_t chunk;
+
+    /* Only one window can be mapped at a time, bounce through the stack */
+    while (size > 0) {
+        chunk = (size < sizeof(chunk_buffer)) ? size : sizeof(chunk_buffer);
+
+        mmio_ap_mem_transfer(src, chunk_buffer, chunk, false);
+        mmio_ap_mem_transfer(dst, chunk_buffer, chunk, true);
+
+        src += chunk;
+        dst += chunk;
+        size -= chunk;
+    }
+}
+
 /*
  * API to be used by a module that needs to read/write AP memory region.
  */
@@ -428,6 +576,9 @@ static struct mod_apremap_rw_api apremap_mem_api = {
     .mmio_ap_mem_write_16 = mmio_ap_mem_write_16,
     .mmio_ap_mem_write_32 = mmio_ap_mem_write_32,
     .mmio_ap_mem_write_64 = mmio_ap_mem_write_64,
+    .mmio_ap_mem_read_block = mmio_ap_mem_read_block,
+    .mmio_ap_mem_write_block = mmio_ap_mem_write_block,
+    .mmio_ap_mem_copy = mmio_ap_mem_copy,
 };
 
 /* API to enable/disable CMN Address Translation */
@@ -8,6 +8,9 @@
 #ifndef MOD_ARMV7M_MPU_H
 #define MOD_ARMV7M_MPU_H
 
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
 #include <fmw_cmsis.h>
 
 #include <stddef.h>
@@ -15,6 +18,14 @@
 /*!
  * \ingroup GroupModules
  * \addtogroup GroupMPUARMv7M MPU (ARMv7-M)
+ *
+ * \details Besides the regions loaded at initialization, the module manages
+ *      overlays: preconfigured regions which are left disabled until a module
+ *      requests them, for example to map a window cacheable for the time of a
+ *      bulk copy. As the regions with the highest numbers take precedence,
+ *      the overlays use region numbers above those of the regions they
+ *      override.
+ *
  * \{
  */
 
@@ -36,8 +47,72 @@ struct mod_armv7m_mpu_config {
      * \see http://arm-software.github.io/CMSIS_5/General/html/index.html
      */
     const ARM_MPU_Region_t *regions;
+
+    /*!
+     * \brief Number of overlays.
+     */
+    size_t overlay_count;
+
+    /*!
+     * \brief Pointer to array of overlays.
+     *
+     * \details Each overlay is an MPU region, whose number is given by its
+     *      \c RBAR field, left disabled until the overlay is enabled. The
+     *      overlays may not share their region number with any region.
+     */
+    const ARM_MPU_Region_t *overlays;
 };
 
+/*!
+ * \brief Overlay API.
+ */
+struct mod_armv7m_mpu_overlay_api {
+    /*!
+     * \brief Enable an overlay.
+     *
+     * \details The overlay is enabled as many times as it is requested, and
+     *      must be disabled as many times for its region to be disabled.
+     *
+     * \param overlay_idx Index of the overlay.
+     *
+     * \retval ::FWK_SUCCESS The overlay is enabled.
+     * \retval ::FWK_E_PARAM The overlay index is invalid.
+     */
+    int (*enable)(unsigned int overlay_idx);
+
+    /*!
+     * \brief Disable an overlay.
+     *
+     * \details When the region of the overlay is disabled, the data cache is
+     *      cleaned and invalidated for the range of the overlay, so that the
+     *      data written through a cacheable overlay reaches the memory.
+     *
+     * \param overlay_idx Index of the overlay.
+     *
+     * \retval ::FWK_SUCCESS The overlay is disabled.
+     * \retval ::FWK_E_PARAM The overlay index is invalid.
+     * \retval ::FWK_E_STATE The overlay is not enabled.
+     */
+    int (*disable)(unsigned int overlay_idx);
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_armv7m_mpu_api_idx {
+    /*! Overlay API, see ::mod_armv7m_mpu_overlay_api */
+    MOD_ARMV7M_MPU_API_IDX_OVERLAY,
+
+    /*! Number of defined APIs */
+    MOD_ARMV7M_MPU_API_IDX_COUNT,
+};
+
+/*!
+ * \brief Identifier of the overlay API.
+ */
+static const fwk_id_t mod_armv7m_mpu_api_id_overlay =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_ARMV7M_MPU, MOD_ARMV7M_MPU_API_IDX_OVERLAY);
+
 /*!
  * \}
  */
@@ -9,22 +9,124 @@
 
 #include <fwk_assert.h>
 #include <fwk_id.h>
+#include <fwk_interrupt.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_status.h>
 
 #include <fmw_cmsis.h>
 
+#include <stdint.h>
+
+static struct {
+    const struct mod_armv7m_mpu_config *config;
+
+    /* Number of requests for each overlay */
+    unsigned int *overlay_refs;
+} ctx;
+
+static uint32_t region_number(const ARM_MPU_Region_t *region)
+{
+    return (region->RBAR & MPU_RBAR_REGION_Msk) >> MPU_RBAR_REGION_Pos;
+}
+
+/*
+ * Overlay API
+ */
+
+static int armv7m_mpu_enable_overlay(unsigned int overlay_idx)
+{
+    const ARM_MPU_Region_t *overlay;
+
+    if (overlay_idx >= ctx.config->overlay_count)
+        return FWK_E_PARAM;
+
+    overlay = &ctx.config->overlays[overlay_idx];
+
+    fwk_interrupt_global_disable();
+
+    if (ctx.overlay_refs[overlay_idx]++ == 0) {
+        ARM_MPU_SetRegion(overlay->RBAR | MPU_RBAR_VALID_Msk, overlay->RASR);
+        __DSB();
+        __ISB();
+    }
+
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
+
+static int armv7m_mpu_disable_overlay(unsigned int overlay_idx)
+{
+    const ARM_MPU_Region_t *overlay;
+    int status = FWK_SUCCESS;
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    uint32_t size;
+#endif
+
+    if (overlay_idx >= ctx.config->overlay_count)
+        return FWK_E_PARAM;
+
+    overlay = &ctx.config->overlays[overlay_idx];
+
+    fwk_interrupt_global_disable();
+
+    if (ctx.overlay_refs[overlay_idx] == 0)
+        status = FWK_E_STATE;
+    else if (--ctx.overlay_refs[overlay_idx] == 0) {
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        size = UINT32_C(2)
+            << ((overlay->RASR & MPU_RASR_SIZE_Msk) >> MPU_RASR_SIZE_Pos);
+        SCB_CleanInvalidateDCache_by_Addr(
+            (uint32_t *)(overlay->RBAR & MPU_RBAR_ADDR_Msk), (int32_t)size);
+#endif
+
+        ARM_MPU_ClrRegion(region_number(overlay));
+        __DSB();
+        __ISB();
+    }
+
+    fwk_interrupt_global_enable();
+
+    return status;
+}
+
+static const struct mod_armv7m_mpu_overlay_api overlay_api = {
+    .enable = armv7m_mpu_enable_overlay,
+    .disable = armv7m_mpu_disable_overlay,
+};
+
+/*
+ * Framework handlers
+ */
+
 static int armv7m_mpu_init(
     fwk_id_t module_id,
     unsigned int element_count,
     const void *data)
 {
     const struct mod_armv7m_mpu_config *config;
+    size_t overlay_idx;
+    size_t region_idx;
 
     fwk_assert(element_count == 0);
     fwk_assert(data != NULL);
 
     config = data;
+    ctx.config = config;
+
+    for (overlay_idx = 0; overlay_idx < config->overlay_count; overlay_idx++) {
+        for (region_idx = 0; region_idx < config->region_count; region_idx++) {
+            if (region_number(&config->overlays[overlay_idx]) ==
+                region_number(&config->regions[region_idx]))
+                return FWK_E_DATA;
+        }
+    }
+
+    if (config->overlay_count != 0) {
+        ctx.overlay_refs =
+            fwk_mm_calloc(config->overlay_count, sizeof(ctx.overlay_refs[0]));
+    }
 
     ARM_MPU_Disable();
     ARM_MPU_Load(config->regions, config->region_count);
@@ -33,9 +135,25 @@ static int armv7m_mpu_init(
     return FWK_SUCCESS;
 }
 
+static int armv7m_mpu_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    if (fwk_id_get_api_idx(api_id) != MOD_ARMV7M_MPU_API_IDX_OVERLAY)
+        return FWK_E_PARAM;
+
+    *api = &overlay_api;
+
+    return FWK_SUCCESS;
+}
+
 /* Module description */
 const struct fwk_module module_armv7m_mpu = {
     .name = "ARMV7M_MPU",
     .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = MOD_ARMV7M_MPU_API_IDX_COUNT,
     .init = armv7m_mpu_init,
+    .process_bind_request = armv7m_mpu_process_bind_request,
 };
@@ -9,6 +9,7 @@
 #define MOD_BOOTLOADER_H
 
 #include <fwk_element.h>
+#include <fwk_id.h>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -23,9 +24,23 @@
  *
  * \details A service module providing support for loading firmware images.
  *
+ *      When a verifier is configured, the image is copied chunk by chunk and
+ *      every chunk is handed to the verifier once it has been copied, so that
+ *      the image is hashed in the same pass as it is copied. The firmware is
+ *      only booted if the verifier accepts the image.
+ *
+ *      The image can also be loaded in the background while the ROM firmware
+ *      brings up the rest of the hardware, see
+ *      ::mod_bootloader_api::start_load.
+ *
  * \{
  */
 
+/*!
+ * \brief Default size of the chunks the image is copied and verified in.
+ */
+#define MOD_BOOTLOADER_DEFAULT_CHUNK_SIZE (4 * 1024)
+
 /*!
  * \brief Module configuration.
  */
@@ -65,6 +80,70 @@ struct mod_bootloader_config {
      */
     uint32_t sds_struct_id;
 #endif
+
+    /*!
+     * \brief Identifier of the entity verifying the image, or ::FWK_ID_NONE
+     *      to boot the image without verification.
+     *
+     * \note When set, the image is copied before the firmware jumps to it
+     *      rather than by the final jump sequence, so the destination must not
+     *      overlap the memory used by the firmware running the bootloader.
+     */
+    fwk_id_t verify_id;
+
+    /*! Identifier of the ::mod_bootloader_verify_api of the verifier */
+    fwk_id_t verify_api_id;
+
+    /*!
+     * \brief Size of the chunks the image is copied and verified in, or zero
+     *      to use ::MOD_BOOTLOADER_DEFAULT_CHUNK_SIZE.
+     */
+    uint32_t chunk_size;
+};
+
+/*!
+ * \brief Image verification interface.
+ *
+ * \details Implemented by the platform, typically to compute a SHA-256 digest
+ *      of the image with a hash accelerator and compare it with the digest of
+ *      a trusted manifest.
+ */
+struct mod_bootloader_verify_api {
+    /*!
+     * \brief Start the verification of an image.
+     *
+     * \param size Size of the image in bytes.
+     *
+     * \retval ::FWK_SUCCESS The verification was started.
+     * \return One of the standard framework error codes.
+     */
+    int (*start)(size_t size);
+
+    /*!
+     * \brief Hash the next chunk of the image.
+     *
+     * \details The chunk is in its final location and is not modified
+     *      afterwards. The function may return before the chunk has been
+     *      hashed, for instance once a DMA transfer to a hash accelerator has
+     *      been started, in which case the bootloader copies the next chunk
+     *      while the current one is being hashed.
+     *
+     * \param chunk Base address of the chunk.
+     * \param size Size of the chunk in bytes.
+     *
+     * \retval ::FWK_SUCCESS The chunk was accepted.
+     * \return One of the standard framework error codes.
+     */
+    int (*update)(const void *chunk, size_t size);
+
+    /*!
+     * \brief Complete the verification of the image.
+     *
+     * \retval ::FWK_SUCCESS The image is genuine.
+     * \retval ::FWK_E_DATA The image digest does not match.
+     * \return One of the standard framework error codes.
+     */
+    int (*finish)(void);
 };
 
 /*!
@@ -93,6 +172,28 @@ struct mod_bootloader_api {
      *      - Part of the image lies outside of the source memory area.
      */
     int (*load_image)(void);
+
+    /*!
+     * \brief Start loading the RAM Firmware image in the background.
+     *
+     * \details The image is copied to its destination one chunk per event of
+     *      the bootloader, so the events of the other modules, e.g. the rest
+     *      of the hardware bring-up, are processed between the chunks. A later
+     *      call to ::mod_bootloader_api::load_image completes the copy and
+     *      jumps to the image.
+     *
+     * \note Only supported for the images whose source is available from the
+     *      start, i.e. not located through SDS, and which are not compressed.
+     *      The destination must not overlap the memory used by the firmware
+     *      running the bootloader.
+     *
+     * \retval ::FWK_SUCCESS The load was started.
+     * \retval ::FWK_E_SUPPORT The image can only be loaded by
+     *      ::mod_bootloader_api::load_image.
+     * \retval ::FWK_E_STATE The load has already been started.
+     * \return One of the standard framework error codes.
+     */
+    int (*start_load)(void);
 };
 
 /*!
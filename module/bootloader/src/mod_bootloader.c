@@ -7,13 +7,16 @@
 
 #include <mod_bootloader.h>
 
+#include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_noreturn.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 
 #include <fmw_cmsis.h>
 
@@ -36,6 +39,41 @@
 #    define IMAGE_FLAGS_VALID_MASK 0x1
 #endif
 
+#ifdef BUILD_HAS_MOD_LZ4
+#    include <mod_lz4.h>
+#endif
+
+enum bootloader_event_idx {
+    BOOTLOADER_EVENT_IDX_COPY,
+    BOOTLOADER_EVENT_IDX_COUNT,
+};
+
+enum bootloader_copy_state {
+    /* No copy started in the background */
+    BOOTLOADER_COPY_STATE_IDLE,
+
+    /* Chunks remain to be copied */
+    BOOTLOADER_COPY_STATE_RUNNING,
+
+    /* The copy is over, see the copy status */
+    BOOTLOADER_COPY_STATE_DONE,
+};
+
+/* Copy of the image to its destination */
+struct bootloader_copy {
+    enum bootloader_copy_state state;
+
+    /* Status of the copy once it is over */
+    int status;
+
+    const uint8_t *image_base;
+    uint32_t image_size;
+    uint32_t chunk_size;
+
+    /* Offset of the next chunk to copy */
+    uint32_t offset;
+};
+
 /* Module context */
 struct bootloader_ctx {
     const struct mod_bootloader_config *module_config;
@@ -43,15 +81,199 @@ struct bootloader_ctx {
 #ifdef BUILD_HAS_MOD_SDS
     const struct mod_sds_api *sds_api;
 #endif
+
+#ifdef BUILD_HAS_MOD_LZ4
+    const struct mod_lz4_api *lz4_api;
+#endif
+
+    /* Image verification API, NULL when the image is not verified */
+    const struct mod_bootloader_verify_api *verify_api;
+
+    struct bootloader_copy copy;
 };
 
 static struct bootloader_ctx module_ctx;
 
+/*
+ * Static functions
+ */
+
+/* Check whether an object lies within the destination of the image */
+static bool overlaps_destination(const void *object, uint32_t image_size)
+{
+    uintptr_t address = (uintptr_t)object;
+    uintptr_t destination = module_ctx.module_config->destination_base;
+
+    return (address >= destination) && ((address - destination) < image_size);
+}
+
+/*
+ * Start the copy of the image to its destination. The image is copied chunk by
+ * chunk, and every chunk is handed to the verifier, if any, once it has been
+ * copied.
+ */
+static int copy_start(const uint8_t *image_base, uint32_t image_size)
+{
+    int status = FWK_SUCCESS;
+    struct bootloader_copy *copy = &module_ctx.copy;
+
+    /* The copy must not overwrite the data or the stack of this firmware */
+    if (overlaps_destination(&module_ctx, image_size) ||
+        overlaps_destination(&status, image_size))
+        return FWK_E_SIZE;
+
+    copy->image_base = image_base;
+    copy->image_size = image_size;
+    copy->offset = 0;
+    copy->chunk_size = module_ctx.module_config->chunk_size;
+    if (copy->chunk_size == 0)
+        copy->chunk_size = MOD_BOOTLOADER_DEFAULT_CHUNK_SIZE;
+
+    if (module_ctx.verify_api != NULL)
+        status = module_ctx.verify_api->start(image_size);
+
+    return status;
+}
+
+/*
+ * Copy the next chunk of the image. Returns FWK_PENDING while chunks remain to
+ * be copied.
+ */
+static int copy_next_chunk(void)
+{
+    int status;
+    struct bootloader_copy *copy = &module_ctx.copy;
+    uint8_t *destination;
+    uint32_t copy_size;
+
+    if (copy->offset == copy->image_size) {
+        if (module_ctx.verify_api == NULL)
+            return FWK_SUCCESS;
+
+        return module_ctx.verify_api->finish();
+    }
+
+    destination = (uint8_t *)module_ctx.module_config->destination_base;
+    copy_size = FWK_MIN(copy->chunk_size, copy->image_size - copy->offset);
+
+    memcpy(
+        &destination[copy->offset], &copy->image_base[copy->offset], copy_size);
+
+    if (module_ctx.verify_api != NULL) {
+        status = module_ctx.verify_api->update(
+            &destination[copy->offset], copy_size);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    copy->offset += copy_size;
+
+    return FWK_PENDING;
+}
+
+static int copy_and_verify(const uint8_t *image_base, uint32_t image_size)
+{
+    int status;
+
+    status = copy_start(image_base, image_size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    do {
+        status = copy_next_chunk();
+    } while (status == FWK_PENDING);
+
+    return status;
+}
+
+/* Copy the chunks the background copy has not copied yet */
+static int copy_complete(void)
+{
+    struct bootloader_copy *copy = &module_ctx.copy;
+
+    while (copy->state == BOOTLOADER_COPY_STATE_RUNNING) {
+        copy->status = copy_next_chunk();
+        if (copy->status != FWK_PENDING)
+            copy->state = BOOTLOADER_COPY_STATE_DONE;
+    }
+
+    return copy->status;
+}
+
+#ifdef BUILD_HAS_MOD_LZ4
+/* Hand the image at its destination to the verifier chunk by chunk */
+static int verify_destination(uint32_t image_size)
+{
+    int status;
+    const struct mod_bootloader_verify_api *verify_api = module_ctx.verify_api;
+    const uint8_t *destination;
+    uint32_t chunk_size;
+    uint32_t update_size;
+    uint32_t offset;
+
+    destination = (const uint8_t *)module_ctx.module_config->destination_base;
+    chunk_size = module_ctx.module_config->chunk_size;
+    if (chunk_size == 0)
+        chunk_size = MOD_BOOTLOADER_DEFAULT_CHUNK_SIZE;
+
+    status = verify_api->start(image_size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (offset = 0; offset < image_size; offset += update_size) {
+        update_size = FWK_MIN(chunk_size, image_size - offset);
+
+        status = verify_api->update(&destination[offset], update_size);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return verify_api->finish();
+}
+
+/*
+ * Decompress the image to its destination. The compressed data is read once,
+ * straight from its storage.
+ */
+static int decompress_image(const uint8_t *image_base, uint32_t image_size)
+{
+    int status;
+    struct mod_lz4_image_header header;
+    size_t capacity;
+    size_t size;
+
+    memcpy(&header, image_base, sizeof(header));
+
+    /* The image must not overwrite the data or the stack of this firmware */
+    if (overlaps_destination(&module_ctx, header.size) ||
+        overlaps_destination(&status, header.size))
+        return FWK_E_SIZE;
+
+    capacity = module_ctx.module_config->destination_size;
+    if (capacity == 0)
+        capacity = header.size;
+
+    status = module_ctx.lz4_api->decompress(
+        image_base,
+        image_size,
+        (void *)module_ctx.module_config->destination_base,
+        capacity,
+        &size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (module_ctx.verify_api == NULL)
+        return FWK_SUCCESS;
+
+    return verify_destination(size);
+}
+#endif
+
 /*
  * Module API
  */
 
-static int load_image(void)
+static noreturn void boot(const uint8_t *image_base, uint32_t image_size)
 {
     extern noreturn void mod_bootloader_boot(
         uint8_t * destination,
@@ -59,10 +281,23 @@ static int load_image(void)
         size_t size,
         volatile uint32_t *vtor);
 
-#ifdef BUILD_HAS_MOD_SDS
+    fwk_interrupt_global_disable(); /* We are relocating the vector table */
+
+    FWK_LOG_INFO("[BOOTLOADER] Booting RAM firmware...");
+    FWK_LOG_FLUSH();
+
+    mod_bootloader_boot(
+        (uint8_t *)module_ctx.module_config->destination_base,
+        image_base,
+        image_size,
+        &SCB->VTOR);
+}
+
+static int load_image(void)
+{
     int status;
 
-    uint32_t image_flags;
+#ifdef BUILD_HAS_MOD_SDS
     uint32_t image_offset;
 #endif
 
@@ -80,6 +315,17 @@ static int load_image(void)
     if (module_ctx.module_config->source_size == 0)
         return FWK_E_PARAM;
 
+    if (module_ctx.copy.state != BOOTLOADER_COPY_STATE_IDLE) {
+        status = copy_complete();
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_ERR("[BOOTLOADER] Image load failed");
+            return status;
+        }
+
+        /* The image is in place, only the jump remains */
+        boot((const uint8_t *)module_ctx.module_config->destination_base, 0);
+    }
+
 #ifdef BUILD_HAS_MOD_SDS
     sds = module_ctx.module_config->sds_struct_id != 0;
 #endif
@@ -90,18 +336,13 @@ static int load_image(void)
          * Wait until Trusted Firmware writes the image metadata and sets the
          * data valid flag.
          */
-        while (true) {
-            status = module_ctx.sds_api->struct_read(
-                module_ctx.module_config->sds_struct_id,
-                BOOTLOADER_STRUCT_VALID_POS,
-                &image_flags,
-                sizeof(image_flags));
-
-            if (status != FWK_SUCCESS)
-                return status;
-            if (image_flags & IMAGE_FLAGS_VALID_MASK)
-                break;
-        }
+        status = module_ctx.sds_api->struct_wait_flags(
+            module_ctx.module_config->sds_struct_id,
+            BOOTLOADER_STRUCT_VALID_POS,
+            IMAGE_FLAGS_VALID_MASK,
+            NULL);
+        if (status != FWK_SUCCESS)
+            return status;
 
         /*
          * The image metadata from Trusted Firmware can now be read and
@@ -145,20 +386,94 @@ static int load_image(void)
             return FWK_E_SIZE;
     }
 
-    fwk_interrupt_global_disable(); /* We are relocating the vector table */
+#ifdef BUILD_HAS_MOD_LZ4
+    if (module_ctx.lz4_api->is_compressed(image_base, image_size)) {
+        status = decompress_image(image_base, image_size);
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_ERR("[BOOTLOADER] Image decompression failed");
+            return status;
+        }
 
-    FWK_LOG_INFO("[BOOTLOADER] Booting RAM firmware...");
-    FWK_LOG_FLUSH();
+        /* The image is in place, only the jump remains */
+        image_base =
+            (const uint8_t *)module_ctx.module_config->destination_base;
+        image_size = 0;
+    }
+#endif
 
-    mod_bootloader_boot(
-        (uint8_t *)module_ctx.module_config->destination_base,
-        image_base,
-        image_size,
-        &SCB->VTOR);
+    if ((module_ctx.verify_api != NULL) && (image_size != 0)) {
+        status = copy_and_verify(image_base, image_size);
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_ERR("[BOOTLOADER] Image verification failed");
+            return status;
+        }
+
+        /* The image is in place, only the jump remains */
+        image_base =
+            (const uint8_t *)module_ctx.module_config->destination_base;
+        image_size = 0;
+    }
+
+    boot(image_base, image_size);
+}
+
+static int copy_put_event(void)
+{
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_BOOTLOADER),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_BOOTLOADER),
+        .id =
+            FWK_ID_EVENT(FWK_MODULE_IDX_BOOTLOADER, BOOTLOADER_EVENT_IDX_COPY),
+    };
+
+    return fwk_thread_put_event(&event);
+}
+
+static int start_load(void)
+{
+    int status;
+    const struct mod_bootloader_config *config = module_ctx.module_config;
+
+    if (module_ctx.copy.state != BOOTLOADER_COPY_STATE_IDLE)
+        return FWK_E_STATE;
+
+    if ((config == NULL) || (config->source_base == 0) ||
+        (config->destination_base == 0) || (config->source_size == 0))
+        return FWK_E_PARAM;
+
+#ifdef BUILD_HAS_MOD_SDS
+    /* The image is only located once Trusted Firmware has written it */
+    if (config->sds_struct_id != 0)
+        return FWK_E_SUPPORT;
+#endif
+
+#ifdef BUILD_HAS_MOD_LZ4
+    if (module_ctx.lz4_api->is_compressed(
+            (const uint8_t *)config->source_base, config->source_size))
+        return FWK_E_SUPPORT;
+#endif
+
+    if ((config->destination_size > 0) &&
+        (config->source_size > config->destination_size))
+        return FWK_E_SIZE;
+
+    status = copy_start(
+        (const uint8_t *)config->source_base, config->source_size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = copy_put_event();
+    if (status != FWK_SUCCESS)
+        return status;
+
+    module_ctx.copy.state = BOOTLOADER_COPY_STATE_RUNNING;
+
+    return FWK_SUCCESS;
 }
 
 static const struct mod_bootloader_api bootloader_api = {
     .load_image = load_image,
+    .start_load = start_load,
 };
 
 /*
@@ -174,7 +489,6 @@ static int bootloader_init(fwk_id_t module_id, unsigned int element_count,
     return FWK_SUCCESS;
 }
 
-#ifdef BUILD_HAS_MOD_SDS
 static int bootloader_bind(fwk_id_t id, unsigned int call_number)
 {
     int status;
@@ -187,13 +501,32 @@ static int bootloader_bind(fwk_id_t id, unsigned int call_number)
         /* No element-level binding required */
         return FWK_SUCCESS;
 
+#ifdef BUILD_HAS_MOD_SDS
     status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SDS),
                              FWK_ID_API(FWK_MODULE_IDX_SDS, 0),
                              &module_ctx.sds_api);
+    if (status != FWK_SUCCESS)
+        return status;
+#endif
+
+#ifdef BUILD_HAS_MOD_LZ4
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LZ4),
+                             FWK_ID_API(FWK_MODULE_IDX_LZ4,
+                                        MOD_LZ4_API_IDX_DECOMPRESS),
+                             &module_ctx.lz4_api);
+    if (status != FWK_SUCCESS)
+        return status;
+#endif
+
+    if (!fwk_module_is_valid_entity_id(module_ctx.module_config->verify_id))
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(module_ctx.module_config->verify_id,
+                             module_ctx.module_config->verify_api_id,
+                             &module_ctx.verify_api);
 
     return status;
 }
-#endif
 
 static int bootloader_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
     fwk_id_t api_id, const void **api)
@@ -208,15 +541,32 @@ static int bootloader_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
     return FWK_SUCCESS;
 }
 
+static int bootloader_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    struct bootloader_copy *copy = &module_ctx.copy;
+
+    /* The copy may have been completed by the load of the image */
+    if (copy->state != BOOTLOADER_COPY_STATE_RUNNING)
+        return FWK_SUCCESS;
+
+    copy->status = copy_next_chunk();
+    if (copy->status == FWK_PENDING)
+        return copy_put_event();
+
+    copy->state = BOOTLOADER_COPY_STATE_DONE;
+
+    return FWK_SUCCESS;
+}
+
 const struct fwk_module module_bootloader = {
     .name = "Bootloader",
     .type = FWK_MODULE_TYPE_SERVICE,
     .api_count = 1,
-    .event_count = 0,
+    .event_count = BOOTLOADER_EVENT_IDX_COUNT,
     .init = bootloader_init,
     .process_bind_request = bootloader_process_bind_request,
-
-#ifdef BUILD_HAS_MOD_SDS
     .bind = bootloader_bind,
-#endif
+    .process_event = bootloader_process_event,
 };
@@ -0,0 +1,196 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Multi-chip power coordinator.
+ */
+
+#ifndef MOD_CHIP_COORD_H
+#define MOD_CHIP_COORD_H
+
+#include <fwk_id.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupChipCoord Multi-Chip Power Coordinator
+ *
+ * \brief Coordination of the DVFS and power decisions of the chips of a
+ *      multi-chip product.
+ *
+ * \details The SCP of each chip runs an instance of the coordinator. Every
+ *      period, each instance publishes an exchange record, see
+ *      ::mod_chip_coord_record, holding the power demand of its chip and the
+ *      activity of its side of the inter-chip link, and reads the records of
+ *      the other chips. The records live in memory shared between the chips,
+ *      e.g. SCP RAM mapped over the CCIX or CML link, so no message has to be
+ *      sent or acknowledged.
+ *
+ *      From the records, every instance computes the same split of the
+ *      product power budget:
+ *      - While the link is busy, the chips run a coupled workload and the
+ *        budget is shared equally, so no chip slows the others down.
+ *      - Otherwise, each chip is given its demand when the budget allows it,
+ *        and a share proportional to its demand when it does not.
+ *
+ *      The share of the local chip is then distributed between its DVFS
+ *      domains in proportion to their weighted power demand, and each domain
+ *      is limited to the highest level fitting in its share through the DVFS
+ *      level limits. Optionally, the power domain of the link is put in a
+ *      low-power state once no chip has used it for a number of periods, and
+ *      back on as soon as one does.
+ *
+ *      The records of a chip that stopped updating them are ignored after a
+ *      number of periods, and the share it would get with an equal split is
+ *      kept in reserve for it.
+ *
+ * \note The maximum level limit of the domains is owned by the coordinator,
+ *      so the domains must not also be actors of the thermal power
+ *      allocator. The minimum level limit set by the agents is preserved.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Full scale of the link activity.
+ */
+#define MOD_CHIP_COORD_ACTIVITY_SCALE 1024
+
+/*!
+ * \brief Exchange record of a chip.
+ *
+ * \details A record is only written by the chip it belongs to. Its sequence
+ *      number is odd while it is written, and the readers retry when it is
+ *      odd or changes while they read the record.
+ */
+struct mod_chip_coord_record {
+    /*! Sequence number of the record */
+    uint32_t sequence;
+
+    /*! Power demand of the chip in mW */
+    uint32_t demand_mw;
+
+    /*! Share of the power budget the chip granted itself in mW */
+    uint32_t granted_mw;
+
+    /*!
+     * \brief Activity of the link over the last period, from 0 to
+     *      ::MOD_CHIP_COORD_ACTIVITY_SCALE.
+     */
+    uint32_t link_activity;
+};
+
+/*!
+ * \brief DVFS domain configuration.
+ */
+struct mod_chip_coord_domain_config {
+    /*! Identifier of the element of the DVFS module */
+    fwk_id_t dvfs_domain_id;
+
+    /*! Weight of the domain demand when the share of the chip is distributed */
+    unsigned int weight;
+
+    /*!
+     * \brief Dynamic power coefficient in microwatts per MHz per volt squared.
+     *
+     * \details Only used for the operating points whose power is 0.
+     */
+    uint32_t power_coeff;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_chip_coord_config {
+    /*! Index of the local chip */
+    unsigned int chip_idx;
+
+    /*! Number of chips */
+    unsigned int chip_count;
+
+    /*!
+     * \brief Table of the addresses of the exchange records of the chips, as
+     *      seen by the local chip, indexed by chip.
+     */
+    const uintptr_t *record_table;
+
+    /*! Identifier of the alarm running the coordination */
+    fwk_id_t alarm_id;
+
+    /*! Coordination period in milliseconds */
+    unsigned int period_ms;
+
+    /*!
+     * \brief Number of periods without update after which the record of a chip
+     *      is ignored.
+     */
+    unsigned int stale_period_count;
+
+    /*! Power budget of the product in mW */
+    uint32_t budget_mw;
+
+    /*! Table of the DVFS domains of the local chip */
+    const struct mod_chip_coord_domain_config *domains;
+
+    /*! Number of DVFS domains */
+    size_t domain_count;
+
+    /*!
+     * \brief Identifier of the activity counters of the link, optional.
+     *
+     * \details The counters are read through the activity counter API of the
+     *      DVFS governor, see ::mod_dvfs_governor_activity_api. When not
+     *      defined, the local chip reports no link activity.
+     */
+    fwk_optional_id_t link_counter_id;
+
+    /*! Identifier of the activity counter API of the link */
+    fwk_id_t link_counter_api_id;
+
+    /*!
+     * \brief Link activity from which the chips are considered coupled, from
+     *      1 to ::MOD_CHIP_COORD_ACTIVITY_SCALE, or 0 to never couple them.
+     */
+    uint32_t link_coupled_threshold;
+
+    /*! Identifier of the power domain of the link, optional */
+    fwk_optional_id_t link_pd_id;
+
+    /*!
+     * \brief State the power domain of the link is put in once no chip has
+     *      used the link for ::mod_chip_coord_config::link_idle_period_count
+     *      periods.
+     *
+     * \warning The link must remain usable in that state, e.g. a low-power
+     *      state the hardware exits on traffic, as the link counters must
+     *      still see the traffic and the records may be reached through the
+     *      link.
+     */
+    uint32_t link_idle_state;
+
+    /*!
+     * \brief Number of periods without activity on any chip after which the
+     *      power domain of the link is put in its idle state, or 0 to keep it
+     *      on.
+     */
+    unsigned int link_idle_period_count;
+};
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_CHIP_COORD_H */
@@ -0,0 +1,700 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Multi-chip power coordinator.
+ */
+
+#include <mod_chip_coord.h>
+#include <mod_dvfs.h>
+#include <mod_dvfs_governor.h>
+#include <mod_power_domain.h>
+#include <mod_timer.h>
+
+#include <fwk_cache.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+
+#include <fmw_cmsis.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Number of attempts at reading a record being written */
+#define CHIP_COORD_READ_ATTEMPT_COUNT 4
+
+enum chip_coord_event_idx {
+    CHIP_COORD_EVENT_IDX_CONTROL,
+    CHIP_COORD_EVENT_IDX_COUNT,
+};
+
+static const fwk_id_t chip_coord_event_id_control =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_CHIP_COORD, CHIP_COORD_EVENT_IDX_CONTROL);
+
+struct chip_coord_domain_ctx {
+    /* Weighted power demand */
+    uint64_t demand;
+
+    /* Power demand, in mW */
+    uint32_t demand_mw;
+
+    /* Power at the highest operating point, in mW */
+    uint32_t max_power_mw;
+
+    /* Share of the power budget of the chip, in mW */
+    uint32_t granted_mw;
+};
+
+struct chip_coord_peer_ctx {
+    /* Last record read */
+    struct mod_chip_coord_record record;
+
+    /* A record has been read */
+    bool seen;
+
+    /* Number of periods the record has not been updated for */
+    unsigned int stale_count;
+};
+
+static struct chip_coord_ctx {
+    /* Module configuration */
+    const struct mod_chip_coord_config *config;
+
+    /* DVFS API */
+    const struct mod_dvfs_domain_api *dvfs_api;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Activity counter API of the link */
+    const struct mod_dvfs_governor_activity_api *counter_api;
+
+    /* Power domain API */
+    const struct mod_pd_restricted_api *pd_api;
+
+    /* Table of domain contexts */
+    struct chip_coord_domain_ctx *domain_ctx_table;
+
+    /* Table of peer contexts, indexed by chip */
+    struct chip_coord_peer_ctx *peer_ctx_table;
+
+    /* Sequence number of the local record */
+    uint32_t sequence;
+
+    /* Link counters at the previous period */
+    uint64_t last_active;
+    uint64_t last_total;
+
+    /* The link counters have been sampled */
+    bool sampled;
+
+    /* Number of periods the link has been idle on all chips */
+    unsigned int link_idle_count;
+
+    /* The power domain of the link is in its idle state */
+    bool link_idle;
+
+    /* A control event has been queued and not yet processed */
+    volatile bool control_pending;
+} chip_coord_ctx;
+
+/*
+ * Power model
+ */
+
+static uint32_t opp_power(
+    const struct mod_chip_coord_domain_config *domain,
+    const struct mod_dvfs_opp *opp)
+{
+    uint64_t power;
+
+    if (opp->power != 0)
+        return opp->power;
+
+    /*
+     * mW = coeff (uW/MHz/V^2) * f (kHz) / 1000 * V (mV)^2 / 10^6 / 1000
+     */
+    power = (uint64_t)domain->power_coeff * opp->frequency *
+        ((uint64_t)opp->voltage * opp->voltage);
+
+    return (uint32_t)FWK_MIN(power / 1000000000000ULL, UINT32_MAX);
+}
+
+/*
+ * Highest level whose power fits in the given budget, or the lowest level if
+ * none does. A domain without operating points has no level to limit.
+ */
+static int domain_level_for_power(
+    const struct mod_chip_coord_domain_config *domain,
+    uint32_t power_mw,
+    uint32_t *level)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = chip_coord_ctx.dvfs_api;
+    struct mod_dvfs_opp opp;
+    size_t opp_count, idx;
+    int status;
+
+    status = dvfs_api->get_opp_count(domain->dvfs_domain_id, &opp_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (opp_count == 0)
+        return FWK_E_DATA;
+
+    for (idx = 0; idx < opp_count; idx++) {
+        status = dvfs_api->get_nth_opp(domain->dvfs_domain_id, idx, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if ((idx != 0) && (opp_power(domain, &opp) > power_mw))
+            break;
+
+        *level = opp.level;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int domain_set_max_level(
+    const struct mod_chip_coord_domain_config *domain,
+    uint32_t level)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = chip_coord_ctx.dvfs_api;
+    struct mod_dvfs_level_limits limits;
+    int status;
+
+    status = dvfs_api->get_level_limits(domain->dvfs_domain_id, &limits);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Keep the minimum requested by the agents */
+    level = FWK_MAX(level, limits.minimum);
+    if (level == limits.maximum)
+        return FWK_SUCCESS;
+
+    limits.maximum = level;
+    status = dvfs_api->set_level_limits(domain->dvfs_domain_id, 0, &limits);
+
+    return (status == FWK_PENDING) ? FWK_SUCCESS : status;
+}
+
+/*
+ * The demand of a domain is the power of its current operating point. A
+ * domain held at its maximum level limit would run faster without it, so it
+ * demands the power of the next operating point.
+ */
+static int domain_update_demand(
+    const struct mod_chip_coord_domain_config *domain,
+    struct chip_coord_domain_ctx *ctx)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = chip_coord_ctx.dvfs_api;
+    struct mod_dvfs_level_limits limits;
+    struct mod_dvfs_opp opp, next_opp;
+    size_t opp_count, idx;
+    int status;
+
+    status = dvfs_api->get_opp_count(domain->dvfs_domain_id, &opp_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (opp_count == 0)
+        return FWK_E_DATA;
+
+    status = dvfs_api->get_nth_opp(domain->dvfs_domain_id, opp_count - 1, &opp);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->max_power_mw = opp_power(domain, &opp);
+
+    /* A domain whose level is not known yet demands its maximum power */
+    status = dvfs_api->get_current_opp(domain->dvfs_domain_id, &opp);
+    if (status == FWK_PENDING) {
+        ctx->demand_mw = ctx->max_power_mw;
+        ctx->demand = (uint64_t)domain->weight * ctx->demand_mw;
+
+        return FWK_SUCCESS;
+    } else if (status != FWK_SUCCESS)
+        return status;
+
+    status = dvfs_api->get_level_limits(domain->dvfs_domain_id, &limits);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (opp.level >= limits.maximum) {
+        for (idx = 0; idx < opp_count; idx++) {
+            status =
+                dvfs_api->get_nth_opp(domain->dvfs_domain_id, idx, &next_opp);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            if (next_opp.level > opp.level) {
+                opp = next_opp;
+                break;
+            }
+        }
+    }
+
+    ctx->demand_mw = opp_power(domain, &opp);
+    ctx->demand = (uint64_t)domain->weight * ctx->demand_mw;
+
+    return FWK_SUCCESS;
+}
+
+static int chip_update_demand(uint32_t *demand_mw)
+{
+    const struct mod_chip_coord_config *config = chip_coord_ctx.config;
+    uint64_t total = 0;
+    unsigned int idx;
+    int status;
+
+    for (idx = 0; idx < config->domain_count; idx++) {
+        status = domain_update_demand(
+            &config->domains[idx], &chip_coord_ctx.domain_ctx_table[idx]);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        total += chip_coord_ctx.domain_ctx_table[idx].demand_mw;
+    }
+
+    *demand_mw = (uint32_t)FWK_MIN(total, UINT32_MAX);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Share of the chip distributed between its domains, see zone_allocate() in
+ * the thermal power allocator.
+ */
+static int chip_allocate(uint32_t budget_mw)
+{
+    const struct mod_chip_coord_config *config = chip_coord_ctx.config;
+    struct chip_coord_domain_ctx *ctx;
+    uint64_t total_demand = 0;
+    uint32_t surplus = 0, extra, level;
+    unsigned int idx;
+    int status;
+
+    for (idx = 0; idx < config->domain_count; idx++)
+        total_demand += chip_coord_ctx.domain_ctx_table[idx].demand;
+
+    /* Share the budget in proportion to the demand */
+    for (idx = 0; idx < config->domain_count; idx++) {
+        ctx = &chip_coord_ctx.domain_ctx_table[idx];
+
+        if (total_demand != 0) {
+            ctx->granted_mw =
+                (uint32_t)((budget_mw * ctx->demand) / total_demand);
+        } else
+            ctx->granted_mw = budget_mw / config->domain_count;
+
+        if (ctx->granted_mw > ctx->max_power_mw) {
+            surplus += ctx->granted_mw - ctx->max_power_mw;
+            ctx->granted_mw = ctx->max_power_mw;
+        }
+    }
+
+    /* The power the saturated domains cannot use goes to the others */
+    for (idx = 0; (idx < config->domain_count) && (surplus != 0); idx++) {
+        ctx = &chip_coord_ctx.domain_ctx_table[idx];
+
+        extra = FWK_MIN(ctx->max_power_mw - ctx->granted_mw, surplus);
+        ctx->granted_mw += extra;
+        surplus -= extra;
+    }
+
+    for (idx = 0; idx < config->domain_count; idx++) {
+        status = domain_level_for_power(
+            &config->domains[idx],
+            chip_coord_ctx.domain_ctx_table[idx].granted_mw,
+            &level);
+        if (status == FWK_SUCCESS)
+            status = domain_set_max_level(&config->domains[idx], level);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Link activity
+ */
+
+static uint32_t link_sample_activity(void)
+{
+    uint64_t active, total, delta_active, delta_total;
+    int status;
+
+    if (chip_coord_ctx.counter_api == NULL)
+        return 0;
+
+    status = chip_coord_ctx.counter_api->get_counters(
+        chip_coord_ctx.config->link_counter_id, &active, &total);
+    if (status != FWK_SUCCESS)
+        return 0;
+
+    delta_active = active - chip_coord_ctx.last_active;
+    delta_total = total - chip_coord_ctx.last_total;
+    chip_coord_ctx.last_active = active;
+    chip_coord_ctx.last_total = total;
+
+    if (!chip_coord_ctx.sampled) {
+        chip_coord_ctx.sampled = true;
+        return 0;
+    }
+
+    if (delta_total == 0)
+        return 0;
+
+    return (uint32_t)(
+        (FWK_MIN(delta_active, delta_total) * MOD_CHIP_COORD_ACTIVITY_SCALE) /
+        delta_total);
+}
+
+static void link_update_state(uint32_t activity)
+{
+    const struct mod_chip_coord_config *config = chip_coord_ctx.config;
+    uint32_t state;
+    bool idle;
+    int status;
+
+    if (chip_coord_ctx.pd_api == NULL)
+        return;
+
+    if (activity != 0) {
+        chip_coord_ctx.link_idle_count = 0;
+        idle = false;
+    } else {
+        if (chip_coord_ctx.link_idle_count < config->link_idle_period_count)
+            chip_coord_ctx.link_idle_count++;
+
+        idle = (config->link_idle_period_count != 0) &&
+            (chip_coord_ctx.link_idle_count == config->link_idle_period_count);
+    }
+
+    if (idle == chip_coord_ctx.link_idle)
+        return;
+
+    state = idle ? config->link_idle_state : (uint32_t)MOD_PD_STATE_ON;
+
+    status = chip_coord_ctx.pd_api->set_state_async(
+        config->link_pd_id, false, state);
+    if (status == FWK_SUCCESS)
+        chip_coord_ctx.link_idle = idle;
+}
+
+/*
+ * Exchange records
+ */
+
+static volatile struct mod_chip_coord_record *get_record(unsigned int chip_idx)
+{
+    return (volatile struct mod_chip_coord_record *)
+        chip_coord_ctx.config->record_table[chip_idx];
+}
+
+static void record_publish(const struct mod_chip_coord_record *local)
+{
+    volatile struct mod_chip_coord_record *record =
+        get_record(chip_coord_ctx.config->chip_idx);
+
+    /* The readers retry while the sequence number is odd */
+    record->sequence = ++chip_coord_ctx.sequence;
+    fwk_cache_clean(record, sizeof(*record));
+    __DMB();
+
+    record->demand_mw = local->demand_mw;
+    record->granted_mw = local->granted_mw;
+    record->link_activity = local->link_activity;
+    __DMB();
+
+    record->sequence = ++chip_coord_ctx.sequence;
+    fwk_cache_clean(record, sizeof(*record));
+}
+
+static bool record_read(
+    unsigned int chip_idx,
+    struct mod_chip_coord_record *copy)
+{
+    volatile struct mod_chip_coord_record *record = get_record(chip_idx);
+    unsigned int attempt;
+    uint32_t sequence;
+
+    for (attempt = 0; attempt < CHIP_COORD_READ_ATTEMPT_COUNT; attempt++) {
+        fwk_cache_invalidate(record, sizeof(*record));
+
+        sequence = record->sequence;
+        if ((sequence & 1) != 0)
+            continue;
+
+        /* The sequence number must be read before the fields */
+        __DMB();
+
+        copy->demand_mw = record->demand_mw;
+        copy->granted_mw = record->granted_mw;
+        copy->link_activity = record->link_activity;
+
+        /* The fields must be read before the sequence number is read again */
+        __DMB();
+
+        fwk_cache_invalidate(record, sizeof(*record));
+        if (record->sequence == sequence) {
+            copy->sequence = sequence;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Read the records of the other chips and tell whether each one is live. A
+ * record that cannot be read consistently counts as not updated.
+ */
+static void peers_update(void)
+{
+    const struct mod_chip_coord_config *config = chip_coord_ctx.config;
+    struct chip_coord_peer_ctx *peer;
+    struct mod_chip_coord_record record;
+    unsigned int idx;
+
+    for (idx = 0; idx < config->chip_count; idx++) {
+        if (idx == config->chip_idx)
+            continue;
+
+        peer = &chip_coord_ctx.peer_ctx_table[idx];
+
+        if (record_read(idx, &record) &&
+            (!peer->seen || (record.sequence != peer->record.sequence))) {
+            peer->record = record;
+            peer->seen = true;
+            peer->stale_count = 0;
+        } else if (peer->stale_count < config->stale_period_count)
+            peer->stale_count++;
+    }
+}
+
+static bool peer_is_live(unsigned int chip_idx)
+{
+    const struct chip_coord_peer_ctx *peer =
+        &chip_coord_ctx.peer_ctx_table[chip_idx];
+
+    return peer->seen &&
+        (peer->stale_count < chip_coord_ctx.config->stale_period_count);
+}
+
+/*
+ * Share of the product budget granted to the local chip. All the chips run
+ * the same computation on the same records, so the shares add up to the
+ * budget.
+ */
+static uint32_t chip_grant(
+    const struct mod_chip_coord_record *local,
+    uint32_t *link_activity)
+{
+    const struct mod_chip_coord_config *config = chip_coord_ctx.config;
+    const struct mod_chip_coord_record *record;
+    uint32_t equal_share = config->budget_mw / config->chip_count;
+    uint64_t available = config->budget_mw;
+    uint64_t total_demand = local->demand_mw;
+    unsigned int live_count = 1;
+    unsigned int idx;
+
+    *link_activity = local->link_activity;
+
+    for (idx = 0; idx < config->chip_count; idx++) {
+        if (idx == config->chip_idx)
+            continue;
+
+        /* The share of a silent chip is kept in reserve for it */
+        if (!peer_is_live(idx)) {
+            available -= equal_share;
+            continue;
+        }
+
+        record = &chip_coord_ctx.peer_ctx_table[idx].record;
+        total_demand += record->demand_mw;
+        *link_activity = FWK_MAX(*link_activity, record->link_activity);
+        live_count++;
+    }
+
+    if ((config->link_coupled_threshold != 0) &&
+        (*link_activity >= config->link_coupled_threshold))
+        return equal_share;
+
+    /* The headroom is shared equally between the live chips */
+    if (total_demand <= available) {
+        return (uint32_t)(
+            local->demand_mw + ((available - total_demand) / live_count));
+    }
+
+    return (uint32_t)((available * local->demand_mw) / total_demand);
+}
+
+static int chip_coord_control(void)
+{
+    struct mod_chip_coord_record local = { 0 };
+    uint32_t link_activity;
+    int status;
+
+    status = chip_update_demand(&local.demand_mw);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    local.link_activity = link_sample_activity();
+
+    peers_update();
+
+    local.granted_mw = chip_grant(&local, &link_activity);
+
+    record_publish(&local);
+
+    link_update_state(link_activity);
+
+    return chip_allocate(local.granted_mw);
+}
+
+/*
+ * Periodical alarm callback
+ */
+
+static void chip_coord_alarm_callback(uintptr_t param)
+{
+    int status;
+    struct fwk_event event = {
+        .id = chip_coord_event_id_control,
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_CHIP_COORD),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_CHIP_COORD),
+    };
+
+    /* Skip the period if the previous one is still queued */
+    if (chip_coord_ctx.control_pending)
+        return;
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_SUCCESS)
+        chip_coord_ctx.control_pending = true;
+}
+
+/*
+ * Framework handlers
+ */
+
+static int chip_coord_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    const struct mod_chip_coord_config *config = data;
+
+    if ((config == NULL) || (config->chip_count == 0) ||
+        (config->chip_idx >= config->chip_count) ||
+        (config->record_table == NULL) || (config->period_ms == 0) ||
+        (config->stale_period_count == 0) || (config->domains == NULL) ||
+        (config->domain_count == 0) ||
+        (config->link_coupled_threshold > MOD_CHIP_COORD_ACTIVITY_SCALE))
+        return FWK_E_DATA;
+
+    chip_coord_ctx.config = config;
+    chip_coord_ctx.domain_ctx_table = fwk_mm_calloc(
+        config->domain_count, sizeof(chip_coord_ctx.domain_ctx_table[0]));
+    chip_coord_ctx.peer_ctx_table = fwk_mm_calloc(
+        config->chip_count, sizeof(chip_coord_ctx.peer_ctx_table[0]));
+
+    /* Resume from the sequence number left by a previous run */
+    fwk_cache_invalidate(
+        get_record(config->chip_idx), sizeof(struct mod_chip_coord_record));
+    chip_coord_ctx.sequence = get_record(config->chip_idx)->sequence & ~1U;
+
+    return FWK_SUCCESS;
+}
+
+static int chip_coord_bind(fwk_id_t id, unsigned int round)
+{
+    const struct mod_chip_coord_config *config = chip_coord_ctx.config;
+    int status;
+
+    if (round > 0)
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(
+        FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+        mod_dvfs_api_id_dvfs,
+        &chip_coord_ctx.dvfs_api);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    status = fwk_module_bind(
+        config->alarm_id, MOD_TIMER_API_ID_ALARM, &chip_coord_ctx.alarm_api);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    if (fwk_optional_id_is_defined(config->link_counter_id)) {
+        status = fwk_module_bind(
+            config->link_counter_id,
+            config->link_counter_api_id,
+            &chip_coord_ctx.counter_api);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+    }
+
+    if (fwk_optional_id_is_defined(config->link_pd_id)) {
+        status = fwk_module_bind(
+            FWK_ID_MODULE(FWK_MODULE_IDX_POWER_DOMAIN),
+            mod_pd_api_id_restricted,
+            &chip_coord_ctx.pd_api);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int chip_coord_start(fwk_id_t id)
+{
+    return chip_coord_ctx.alarm_api->start(
+        chip_coord_ctx.config->alarm_id,
+        chip_coord_ctx.config->period_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        chip_coord_alarm_callback,
+        (uintptr_t)0);
+}
+
+static int chip_coord_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    int status;
+
+    if (!fwk_id_is_equal(event->id, chip_coord_event_id_control))
+        return FWK_E_PARAM;
+
+    chip_coord_ctx.control_pending = false;
+
+    status = chip_coord_control();
+    if (status != FWK_SUCCESS)
+        FWK_LOG_WARN("[CHIP_COORD] Control failed (%d)", status);
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_chip_coord = {
+    .name = "Multi-chip power coordinator",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .event_count = CHIP_COORD_EVENT_IDX_COUNT,
+    .init = chip_coord_init,
+    .bind = chip_coord_bind,
+    .start = chip_coord_start,
+    .process_event = chip_coord_process_event,
+};
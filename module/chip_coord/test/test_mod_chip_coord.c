@@ -0,0 +1,153 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* The handlers under test are private to the module */
+#include <mod_chip_coord.c>
+
+#include <fwk_assert.h>
+#include <fwk_macros.h>
+#include <fwk_status.h>
+#include <fwk_test.h>
+
+#include <string.h>
+
+#define DOMAIN_ID FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_DVFS, 0)
+
+static const struct mod_dvfs_opp fake_opp_table[] = {
+    { .level = 1, .power = 100 },
+    { .level = 2, .power = 200 },
+    { .level = 3, .power = 300 },
+};
+
+static size_t fake_opp_count;
+static struct mod_dvfs_level_limits fake_limits;
+static unsigned int set_level_limits_count_call;
+
+static int get_current_opp(fwk_id_t domain_id, struct mod_dvfs_opp *opp)
+{
+    *opp = fake_opp_table[0];
+    return FWK_SUCCESS;
+}
+
+static int get_nth_opp(fwk_id_t domain_id, size_t n, struct mod_dvfs_opp *opp)
+{
+    if (n >= fake_opp_count)
+        return FWK_E_PARAM;
+
+    *opp = fake_opp_table[n];
+    return FWK_SUCCESS;
+}
+
+static int get_opp_count(fwk_id_t domain_id, size_t *opp_count)
+{
+    *opp_count = fake_opp_count;
+    return FWK_SUCCESS;
+}
+
+static int get_level_limits(
+    fwk_id_t domain_id,
+    struct mod_dvfs_level_limits *limits)
+{
+    *limits = fake_limits;
+    return FWK_SUCCESS;
+}
+
+static int set_level_limits(
+    fwk_id_t domain_id,
+    uintptr_t cookie,
+    const struct mod_dvfs_level_limits *limits)
+{
+    set_level_limits_count_call++;
+    fake_limits = *limits;
+    return FWK_SUCCESS;
+}
+
+static const struct mod_dvfs_domain_api fake_dvfs_api = {
+    .get_current_opp = get_current_opp,
+    .get_nth_opp = get_nth_opp,
+    .get_opp_count = get_opp_count,
+    .get_level_limits = get_level_limits,
+    .set_level_limits = set_level_limits,
+};
+
+static const struct mod_chip_coord_domain_config fake_domain_table[] = {
+    { .dvfs_domain_id = DOMAIN_ID, .weight = 1 },
+};
+
+static const struct mod_chip_coord_config fake_config = {
+    .chip_count = 1,
+    .domains = fake_domain_table,
+    .domain_count = FWK_ARRAY_SIZE(fake_domain_table),
+};
+
+static struct chip_coord_domain_ctx fake_domain_ctx_table[
+    FWK_ARRAY_SIZE(fake_domain_table)];
+
+static void test_case_setup(void)
+{
+    memset(&chip_coord_ctx, 0, sizeof(chip_coord_ctx));
+    memset(fake_domain_ctx_table, 0, sizeof(fake_domain_ctx_table));
+
+    chip_coord_ctx.config = &fake_config;
+    chip_coord_ctx.dvfs_api = &fake_dvfs_api;
+    chip_coord_ctx.domain_ctx_table = fake_domain_ctx_table;
+
+    fake_opp_count = FWK_ARRAY_SIZE(fake_opp_table);
+    fake_limits = (struct mod_dvfs_level_limits){ .minimum = 1, .maximum = 3 };
+    set_level_limits_count_call = 0;
+}
+
+static void test_chip_allocate(void)
+{
+    int status;
+    uint32_t demand_mw;
+
+    status = chip_update_demand(&demand_mw);
+    assert(status == FWK_SUCCESS);
+    assert(demand_mw == 100);
+    assert(fake_domain_ctx_table[0].max_power_mw == 300);
+
+    /* The domain is limited to the highest level fitting in the budget */
+    status = chip_allocate(250);
+    assert(status == FWK_SUCCESS);
+    assert(set_level_limits_count_call == 1);
+    assert(fake_limits.maximum == 2);
+
+    /* No level fits, the domain is limited to its lowest level */
+    status = chip_allocate(50);
+    assert(status == FWK_SUCCESS);
+    assert(fake_limits.maximum == 1);
+}
+
+static void test_chip_allocate_no_opp(void)
+{
+    int status;
+    uint32_t demand_mw;
+
+    fake_opp_count = 0;
+
+    status = chip_update_demand(&demand_mw);
+    assert(status == FWK_E_DATA);
+
+    /* A domain without operating points is left alone */
+    status = chip_allocate(250);
+    assert(status == FWK_E_DATA);
+    assert(set_level_limits_count_call == 0);
+    assert(fake_limits.maximum == 3);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_chip_allocate),
+    FWK_TEST_CASE(test_chip_allocate_no_opp),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "mod_chip_coord",
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
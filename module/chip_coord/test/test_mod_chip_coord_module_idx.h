@@ -0,0 +1,21 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TEST_MOD_CHIP_COORD_MODULE_IDX_H
+#define TEST_MOD_CHIP_COORD_MODULE_IDX_H
+
+#include <fwk_id.h>
+
+enum fwk_module_idx {
+    FWK_MODULE_IDX_TIMER,
+    FWK_MODULE_IDX_POWER_DOMAIN,
+    FWK_MODULE_IDX_DVFS,
+    FWK_MODULE_IDX_CHIP_COORD,
+    FWK_MODULE_IDX_COUNT,
+};
+
+#endif /* TEST_MOD_CHIP_COORD_MODULE_IDX_H */
@@ -12,6 +12,7 @@
 #include <fwk_id.h>
 #include <fwk_module_idx.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*!
@@ -51,6 +52,9 @@ enum mod_clock_notification_idx {
      /*! The running state of a clock is about to change */
     MOD_CLOCK_NOTIFICATION_IDX_STATE_CHANGE_PENDING,
 
+    /*! The rate of a clock changed */
+    MOD_CLOCK_NOTIFICATION_IDX_RATE_CHANGED,
+
     /*! Number of defined notifications */
     MOD_CLOCK_NOTIFICATION_IDX_COUNT
 };
@@ -73,6 +77,15 @@ static const fwk_id_t mod_clock_notification_id_state_change_pending =
     FWK_ID_NOTIFICATION_INIT(
         FWK_MODULE_IDX_CLOCK,
         MOD_CLOCK_NOTIFICATION_IDX_STATE_CHANGE_PENDING);
+
+/*!
+ * \brief Identifier for the ::MOD_CLOCK_NOTIFICATION_IDX_RATE_CHANGED
+ *     notification.
+ */
+static const fwk_id_t mod_clock_notification_id_rate_changed =
+    FWK_ID_NOTIFICATION_INIT(
+        FWK_MODULE_IDX_CLOCK,
+        MOD_CLOCK_NOTIFICATION_IDX_RATE_CHANGED);
 #endif
 
 /*!
@@ -88,6 +101,15 @@ struct clock_notification_params {
     enum mod_clock_state new_state;
 };
 
+/*!
+ * \brief Event parameters for the ::MOD_CLOCK_NOTIFICATION_IDX_RATE_CHANGED
+ *     notification.
+ */
+struct clock_rate_notification_params {
+    /*! The rate that the clock is now running at, in Hertz */
+    uint64_t new_rate;
+};
+
 /*!
  * \brief Response parameters for the
  *     ::MOD_CLOCK_NOTIFICATION_IDX_STATE_CHANGE_PENDING notification.
@@ -191,6 +213,32 @@ struct mod_clock_dev_config {
      *     to receive notifications from the power domain module.
      */
     fwk_id_t pd_source_id;
+
+    /*!
+     * \brief Reference to the clock element this clock is derived from.
+     *
+     * \details When the rate of the parent clock changes, the rates of the
+     *     clocks derived from it with a fixed ratio are updated in the same
+     *     pass, and a ::MOD_CLOCK_NOTIFICATION_IDX_RATE_CHANGED notification is
+     *     sent for every one of them whose rate changed. The cached rates of
+     *     the other clocks derived from it are dropped.
+     *
+     * \note May be ::FWK_ID_NONE for a root clock or a clock that is not part
+     *     of a modelled tree.
+     */
+    fwk_id_t parent_id;
+
+    /*!
+     * \brief Fixed ratio between the rate of the parent clock and the rate of
+     *     this clock.
+     *
+     * \details When not zero, the clock runs at the rate of its parent divided
+     *     by this value. Its rate is computed from the rate of the parent
+     *     rather than read from the driver, and cannot be set on its own.
+     *     When zero, the rate is read from and set through the driver and is
+     *     cached until the rate of an ancestor changes.
+     */
+    unsigned int parent_divider;
 };
 
 /*!
@@ -401,10 +449,16 @@ struct mod_clock_api {
      * \param round_mode The type of rounding to perform, if required, to
      *      achieve the given rate.
      *
+     * \details A request received while another request of the clock is
+     *      on-going is queued. Successive set_rate requests queued back to
+     *      back are merged and only the latest rate is applied, their callers
+     *      all receiving its result.
+     *
      * \retval ::FWK_SUCCESS The operation succeeded.
      * \retval ::FWK_PENDING The request is pending. The result for this
      *      operation will be provided via a response event.
      * \retval ::FWK_E_PARAM The clock identifier was invalid.
+     * \retval ::FWK_E_BUSY The request queue of the clock is full.
      * \retval ::FWK_E_SUPPORT Deferred handling of asynchronous drivers is not
      *      supported.
      * \return One of the standard framework error codes.
@@ -456,10 +510,15 @@ struct mod_clock_api {
      *
      * \param state One of the valid clock states.
      *
+     * \details A request received while another request of the clock is
+     *      on-going is queued, and merged with the last queued request when
+     *      it is also a set_state request.
+     *
      * \retval ::FWK_SUCCESS The operation succeeded.
      * \retval ::FWK_PENDING The request is pending. The result for this
      *      operation will be provided via a response event.
      * \retval ::FWK_E_PARAM The clock identifier was invalid.
+     * \retval ::FWK_E_BUSY The request queue of the clock is full.
      * \retval ::FWK_E_SUPPORT Deferred handling of asynchronous drivers is not
      *      supported.
      * \return One of the standard framework error codes.
@@ -586,6 +645,65 @@ static const fwk_id_t mod_clock_event_id_get_state_request =
     FWK_ID_EVENT_INIT(FWK_MODULE_IDX_CLOCK,
                       MOD_CLOCK_EVENT_IDX_GET_STATE_REQUEST);
 
+/*!
+ * \brief Rate table index.
+ *
+ * \details Clock drivers describe the rates a clock can attain with a table of
+ *      driver-specific entries in ascending rate order, each entry starting
+ *      with its rate in Hertz as a \c uint64_t. The index is built once from
+ *      the table. Lookups then compute the position of an entry directly when
+ *      the rates are evenly spaced, and bisect the table otherwise.
+ */
+struct mod_clock_rate_index {
+    /*! Rate table */
+    const void *table;
+
+    /*! Size of an entry of the table, in bytes */
+    size_t entry_size;
+
+    /*! Number of entries in the table */
+    size_t count;
+
+    /*! Difference between consecutive rates, or 0 if they are not regular */
+    uint64_t step;
+};
+
+/*!
+ * \brief Build the index of a rate table.
+ *
+ * \param[out] index Rate table index.
+ * \param table Rate table.
+ * \param entry_size Size of an entry of the table, in bytes.
+ * \param count Number of entries in the table.
+ *
+ * \retval ::FWK_SUCCESS The index was built.
+ * \retval ::FWK_E_DATA The rates of the table are not in ascending order.
+ * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+ */
+int mod_clock_rate_index_init(
+    struct mod_clock_rate_index *index,
+    const void *table,
+    size_t entry_size,
+    size_t count);
+
+/*!
+ * \brief Find the entry of a rate table attaining a rate.
+ *
+ * \param index Rate table index.
+ * \param rate Requested rate, in Hertz.
+ * \param round_mode The type of rounding to perform if no entry attains the
+ *      requested rate exactly.
+ * \param[out] entry Entry of the table.
+ *
+ * \retval ::FWK_SUCCESS The entry was found.
+ * \retval ::FWK_E_PARAM No entry attains the rate with the given rounding.
+ */
+int mod_clock_rate_index_lookup(
+    const struct mod_clock_rate_index *index,
+    uint64_t rate,
+    enum mod_clock_round_mode round_mode,
+    const void **entry);
+
 /*!
  * \}
  */
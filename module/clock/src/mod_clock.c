@@ -23,6 +23,48 @@
 #include <stddef.h>
 #include <stdint.h>
 
+/* Maximum number of requests of a clock queued behind the on-going one */
+#define CLOCK_REQUEST_QUEUE_LENGTH 4
+
+/* Request queued behind the on-going request of a clock */
+struct clock_queued_request {
+    /* Identifier of the request event, set_rate or set_state */
+    fwk_id_t event_id;
+
+    /* Target rate of a set_rate request */
+    uint64_t rate;
+
+    /* Rounding mode of a set_rate request */
+    enum mod_clock_round_mode round_mode;
+
+    /* Target state of a set_state request */
+    enum mod_clock_state state;
+
+    /* The request has been sent to the driver */
+    bool is_started;
+
+    /* The request has completed */
+    bool is_done;
+
+    /* Result of the request once completed */
+    struct mod_clock_driver_resp_params result;
+
+    /* Number of callers waiting for the result of the request */
+    unsigned int waiter_count;
+
+    /* Number of callers whose request event has been processed */
+    unsigned int processed_count;
+
+    /* Number of callers answered */
+    unsigned int answered_count;
+};
+
+/* Parameters of the request events */
+struct clock_request_params {
+    /* The request was queued behind the on-going one */
+    bool is_queued;
+};
+
 /* Device context */
 struct clock_dev_ctx {
     /* Pointer to the element configuration data */
@@ -43,8 +85,53 @@ struct clock_dev_ctx {
     /* A request is on-going */
     bool is_request_ongoing;
 
+    /*
+     * Identifier of the on-going request event, or FWK_ID_NONE when the rate
+     * is being read to refresh the cache
+     */
+    fwk_id_t request_event_id;
+
     /* Cookie for the response event */
     uint32_t cookie;
+
+    /* On-going request when started from the queue, NULL otherwise */
+    struct clock_queued_request *ongoing_request;
+
+    /*
+     * Requests queued behind the on-going one, in arrival order. A completed
+     * request stays in the queue until all its callers are answered.
+     */
+    struct clock_queued_request queue[CLOCK_REQUEST_QUEUE_LENGTH];
+
+    /* Index of the oldest queued request */
+    unsigned int queue_head;
+
+    /* Number of queued requests */
+    unsigned int queue_count;
+
+    /* Clock this clock is derived from, NULL for a root clock */
+    struct clock_dev_ctx *parent;
+
+    /* First clock derived from this clock */
+    struct clock_dev_ctx *first_child;
+
+    /* Next clock derived from the same parent */
+    struct clock_dev_ctx *next_sibling;
+
+    /* The cached rate is valid */
+    bool is_rate_cached;
+
+    /* Cached rate */
+    uint64_t rate;
+
+    /*
+     * Clock handling the power domain notifications on behalf of all the
+     * clocks of the same power domain
+     */
+    struct clock_dev_ctx *pd_leader;
+
+    /* Next clock of the same power domain */
+    struct clock_dev_ctx *pd_next;
 };
 
 /* Module context */
@@ -54,6 +141,9 @@ struct clock_ctx {
 
     /* Table of elements context */
     struct clock_dev_ctx *dev_ctx_table;
+
+    /* Number of elements */
+    unsigned int dev_count;
 };
 
 static struct clock_ctx module_ctx;
@@ -62,6 +152,395 @@ static struct clock_ctx module_ctx;
  * Utility functions
  */
 
+static fwk_id_t get_clock_id(const struct clock_dev_ctx *ctx)
+{
+    return FWK_ID_ELEMENT(
+        FWK_MODULE_IDX_CLOCK, (unsigned int)(ctx - module_ctx.dev_ctx_table));
+}
+
+/*
+ * Next clock of the subtree rooted at the given clock, in depth-first order,
+ * or NULL once the whole subtree has been visited.
+ */
+static struct clock_dev_ctx *get_next_in_subtree(
+    const struct clock_dev_ctx *root,
+    struct clock_dev_ctx *ctx)
+{
+    if (ctx->first_child != NULL)
+        return ctx->first_child;
+
+    while (ctx != root) {
+        if (ctx->next_sibling != NULL)
+            return ctx->next_sibling;
+
+        ctx = ctx->parent;
+    }
+
+    return NULL;
+}
+
+static void notify_rate_changed(struct clock_dev_ctx *ctx)
+{
+    unsigned int notifications_sent;
+    struct clock_rate_notification_params *params;
+    struct fwk_event outbound_event = {
+        .response_requested = false,
+        .id = mod_clock_notification_id_rate_changed,
+        .source_id = get_clock_id(ctx),
+    };
+
+    params = (struct clock_rate_notification_params *)outbound_event.params;
+    params->new_rate = ctx->rate;
+
+    fwk_notification_notify(&outbound_event, &notifications_sent);
+}
+
+/*
+ * Update the cached rate of a clock and propagate it to the clocks derived
+ * from it in a single walk of the subtree. Derived clocks with a fixed ratio
+ * get their new rates, the others are dropped from the cache as the change of
+ * an ancestor may have affected them.
+ */
+static void update_rate(
+    struct clock_dev_ctx *ctx,
+    bool is_cached,
+    uint64_t rate)
+{
+    struct clock_dev_ctx *node = ctx;
+    unsigned int divider;
+    bool changed;
+
+    do {
+        if (node != ctx) {
+            divider = node->config->parent_divider;
+            is_cached = (divider != 0) && node->parent->is_rate_cached;
+            rate = is_cached ? (node->parent->rate / divider) : 0;
+        }
+
+        changed = is_cached && node->is_rate_cached && (node->rate != rate);
+
+        node->is_rate_cached = is_cached;
+        node->rate = rate;
+
+        if (changed)
+            notify_rate_changed(node);
+
+        node = get_next_in_subtree(ctx, node);
+    } while (node != NULL);
+}
+
+/*
+ * Read the rate of a clock with its own rate setting from the driver. A
+ * result pending from the driver only refreshes the cache once it arrives.
+ */
+static int read_rate(struct clock_dev_ctx *ctx)
+{
+    int status;
+    uint64_t rate;
+
+    status = ctx->api->get_rate(ctx->config->driver_id, &rate);
+    if (status == FWK_PENDING) {
+        ctx->is_request_ongoing = true;
+        ctx->request_event_id = FWK_ID_NONE;
+        update_rate(ctx, false, 0);
+
+        return FWK_E_BUSY;
+    }
+
+    if (status == FWK_SUCCESS)
+        update_rate(ctx, true, rate);
+    else
+        update_rate(ctx, false, 0);
+
+    return status;
+}
+
+/*
+ * Get the rate of a clock derived with a fixed ratio, which is computed once
+ * the rate of the nearest ancestor with its own rate setting is known.
+ */
+static int refresh_derived_rate(struct clock_dev_ctx *ctx)
+{
+    struct clock_dev_ctx *ancestor = ctx->parent;
+
+    if (ctx->is_rate_cached)
+        return FWK_SUCCESS;
+
+    while (ancestor->config->parent_divider != 0)
+        ancestor = ancestor->parent;
+
+    /* Concurrency is not supported */
+    if (ancestor->is_request_ongoing)
+        return FWK_E_BUSY;
+
+    /* Caching the rate of the ancestor computes the rate of the clock */
+    return read_rate(ancestor);
+}
+
+static void process_rate_refresh_response(
+    struct clock_dev_ctx *ctx,
+    const struct mod_clock_driver_resp_params *event_params)
+{
+    ctx->is_request_ongoing = false;
+
+    if (event_params->status == FWK_SUCCESS)
+        update_rate(ctx, true, event_params->value.rate);
+}
+
+/*
+ * Update the cache once a rate has been set synchronously. The rate is read
+ * back unless it was attained exactly.
+ */
+static void cache_set_rate(
+    struct clock_dev_ctx *ctx,
+    uint64_t rate,
+    enum mod_clock_round_mode round_mode)
+{
+    if (round_mode == MOD_CLOCK_ROUND_MODE_NONE)
+        update_rate(ctx, true, rate);
+    else
+        (void)read_rate(ctx);
+}
+
+/*
+ * Request queue
+ *
+ * The set_rate and set_state requests received while a request is on-going
+ * are queued and sent to the driver in order once it completes. A request
+ * received while the last queued request is of the same type and has not been
+ * started yet is merged into it, the latest target replacing the previous one,
+ * so a burst of requests only reaches the driver once. The callers are
+ * answered through the delayed responses of their request events.
+ */
+
+static struct clock_queued_request *get_queued_request(
+    struct clock_dev_ctx *ctx,
+    unsigned int position)
+{
+    return &ctx->queue
+                [(ctx->queue_head + position) % CLOCK_REQUEST_QUEUE_LENGTH];
+}
+
+static int queue_request(
+    struct clock_dev_ctx *ctx,
+    fwk_id_t clock_id,
+    const struct clock_queued_request *new_request)
+{
+    int status;
+    struct clock_queued_request *request = NULL;
+    struct clock_request_params *params;
+    struct fwk_event request_event = {
+        .target_id = clock_id,
+        .id = new_request->event_id,
+        .response_requested = true,
+    };
+
+    if (ctx->queue_count > 0) {
+        request = get_queued_request(ctx, ctx->queue_count - 1);
+        if (request->is_started ||
+            !fwk_id_is_equal(request->event_id, new_request->event_id))
+            request = NULL;
+    }
+
+    if ((request == NULL) && (ctx->queue_count == CLOCK_REQUEST_QUEUE_LENGTH))
+        return FWK_E_BUSY;
+
+    params = (struct clock_request_params *)request_event.params;
+    params->is_queued = true;
+
+    status = fwk_thread_put_event(&request_event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (request == NULL) {
+        request = get_queued_request(ctx, ctx->queue_count++);
+        *request = *new_request;
+    } else {
+        request->rate = new_request->rate;
+        request->round_mode = new_request->round_mode;
+        request->state = new_request->state;
+    }
+
+    request->waiter_count++;
+
+    return FWK_PENDING;
+}
+
+/*
+ * Drop the completed requests at the head of the queue once all their callers
+ * have been answered.
+ */
+static void retire_queued_requests(struct clock_dev_ctx *ctx)
+{
+    struct clock_queued_request *request;
+
+    while (ctx->queue_count > 0) {
+        request = get_queued_request(ctx, 0);
+        if (!request->is_done ||
+            (request->answered_count != request->waiter_count))
+            return;
+
+        ctx->queue_head = (ctx->queue_head + 1) % CLOCK_REQUEST_QUEUE_LENGTH;
+        ctx->queue_count--;
+    }
+}
+
+/*
+ * Answer the callers of a completed request whose response has been delayed.
+ * The request events are processed in the order they were queued, so these
+ * responses are the first ones delayed by the clock.
+ */
+static void answer_queued_request(
+    struct clock_dev_ctx *ctx,
+    struct clock_queued_request *request)
+{
+    int status;
+    struct fwk_event resp_event;
+    struct mod_clock_resp_params *resp_params =
+        (struct mod_clock_resp_params *)resp_event.params;
+
+    for (; request->answered_count < request->processed_count;
+         request->answered_count++) {
+        status = fwk_thread_get_first_delayed_response(
+            get_clock_id(ctx), &resp_event);
+        if (status != FWK_SUCCESS)
+            continue;
+
+        resp_params->status = request->result.status;
+        resp_params->value = request->result.value;
+
+        (void)fwk_thread_put_event(&resp_event);
+    }
+}
+
+static void complete_queued_request(
+    struct clock_dev_ctx *ctx,
+    struct clock_queued_request *request,
+    const struct mod_clock_driver_resp_params *result)
+{
+    request->is_done = true;
+    request->result = *result;
+
+    answer_queued_request(ctx, request);
+    retire_queued_requests(ctx);
+}
+
+/*
+ * Send the queued requests to the driver in order, until one is pending.
+ */
+static void run_queued_requests(struct clock_dev_ctx *ctx)
+{
+    unsigned int position;
+    struct clock_queued_request *candidate;
+    struct clock_queued_request *request;
+    struct mod_clock_driver_resp_params result;
+    bool is_set_rate;
+    uint64_t rate;
+    enum mod_clock_round_mode round_mode;
+
+    while (!ctx->is_request_ongoing) {
+        request = NULL;
+        for (position = 0; position < ctx->queue_count; position++) {
+            candidate = get_queued_request(ctx, position);
+            if (!candidate->is_started) {
+                request = candidate;
+                break;
+            }
+        }
+
+        if (request == NULL)
+            return;
+
+        request->is_started = true;
+        is_set_rate = fwk_id_is_equal(
+            request->event_id, mod_clock_event_id_set_rate_request);
+        rate = request->rate;
+        round_mode = request->round_mode;
+
+        result = (struct mod_clock_driver_resp_params){ 0 };
+        if (is_set_rate) {
+            result.status =
+                ctx->api->set_rate(ctx->config->driver_id, rate, round_mode);
+        } else {
+            result.status =
+                ctx->api->set_state(ctx->config->driver_id, request->state);
+        }
+
+        if (result.status == FWK_PENDING) {
+            ctx->is_request_ongoing = true;
+            ctx->request_event_id = request->event_id;
+            ctx->ongoing_request = request;
+            return;
+        }
+
+        complete_queued_request(ctx, request, &result);
+
+        if (is_set_rate && (result.status == FWK_SUCCESS))
+            cache_set_rate(ctx, rate, round_mode);
+    }
+}
+
+static int process_queued_response(
+    struct clock_dev_ctx *ctx,
+    const struct mod_clock_driver_resp_params *event_params)
+{
+    struct clock_queued_request *request = ctx->ongoing_request;
+
+    ctx->is_request_ongoing = false;
+    ctx->ongoing_request = NULL;
+
+    complete_queued_request(ctx, request, event_params);
+
+    if (fwk_id_is_equal(
+            ctx->request_event_id, mod_clock_event_id_set_rate_request))
+        (void)read_rate(ctx);
+
+    run_queued_requests(ctx);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * The caller of a queued request is answered once the request completes, or
+ * straight away when the request completed before its event was processed.
+ */
+static int process_queued_request_event(
+    struct clock_dev_ctx *ctx,
+    struct fwk_event *resp_event)
+{
+    unsigned int position;
+    struct clock_queued_request *candidate;
+    struct clock_queued_request *request = NULL;
+    struct mod_clock_resp_params *resp_params;
+
+    for (position = 0; position < ctx->queue_count; position++) {
+        candidate = get_queued_request(ctx, position);
+        if (candidate->processed_count < candidate->waiter_count) {
+            request = candidate;
+            break;
+        }
+    }
+
+    if (request == NULL)
+        return FWK_E_STATE;
+
+    request->processed_count++;
+
+    if (!request->is_done) {
+        resp_event->is_delayed_response = true;
+        return FWK_SUCCESS;
+    }
+
+    resp_params = (struct mod_clock_resp_params *)resp_event->params;
+    resp_params->status = request->result.status;
+    resp_params->value = request->result.value;
+
+    request->answered_count++;
+    retire_queued_requests(ctx);
+
+    return FWK_SUCCESS;
+}
+
 static int process_response_event(const struct fwk_event *event)
 {
     int status;
@@ -74,6 +553,15 @@ static int process_response_event(const struct fwk_event *event)
 
     ctx = &module_ctx.dev_ctx_table[fwk_id_get_element_idx(event->target_id)];
 
+    if (ctx->ongoing_request != NULL)
+        return process_queued_response(ctx, event_params);
+
+    if (fwk_id_is_type(ctx->request_event_id, FWK_ID_TYPE_NONE)) {
+        process_rate_refresh_response(ctx, event_params);
+        run_queued_requests(ctx);
+        return FWK_SUCCESS;
+    }
+
     status = fwk_thread_get_delayed_response(event->target_id,
                                              ctx->cookie,
                                              &resp_event);
@@ -84,16 +572,35 @@ static int process_response_event(const struct fwk_event *event)
     resp_params->value = event_params->value;
     ctx->is_request_ongoing = false;
 
-    return fwk_thread_put_event(&resp_event);
+    status = fwk_thread_put_event(&resp_event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (fwk_id_is_equal(
+            ctx->request_event_id, mod_clock_event_id_get_rate_request) &&
+        (event_params->status == FWK_SUCCESS))
+        update_rate(ctx, true, event_params->value.rate);
+    else if (fwk_id_is_equal(
+                 ctx->request_event_id, mod_clock_event_id_set_rate_request))
+        (void)read_rate(ctx);
+
+    run_queued_requests(ctx);
+
+    return FWK_SUCCESS;
 }
 
 static int process_request_event(const struct fwk_event *event,
                                  struct fwk_event *resp_event)
 {
     struct clock_dev_ctx *ctx;
+    const struct clock_request_params *params =
+        (const struct clock_request_params *)event->params;
 
     ctx = &module_ctx.dev_ctx_table[fwk_id_get_element_idx(event->target_id)];
 
+    if (params->is_queued)
+        return process_queued_request_event(ctx, resp_event);
+
     ctx->cookie = event->cookie;
     resp_event->is_delayed_response = true;
 
@@ -119,6 +626,7 @@ static int create_async_request(
         return status;
 
     ctx->is_request_ongoing = true;
+    ctx->request_event_id = event_id;
 
      /*
       * Signal the result of the request is pending and will arrive later
@@ -180,12 +688,23 @@ static int clock_set_rate(fwk_id_t clock_id, uint64_t rate,
 {
     int status;
     struct clock_dev_ctx *ctx;
+    struct clock_queued_request request;
 
     get_ctx(clock_id, &ctx);
 
-    /* Concurrency is not supported */
-    if (ctx->is_request_ongoing)
-        return FWK_E_BUSY;
+    /* The rate of a derived clock follows the rate of its parent */
+    if (ctx->config->parent_divider != 0)
+        return FWK_E_SUPPORT;
+
+    if (ctx->is_request_ongoing) {
+        request = (struct clock_queued_request){
+            .event_id = mod_clock_event_id_set_rate_request,
+            .rate = rate,
+            .round_mode = round_mode,
+        };
+
+        return queue_request(ctx, clock_id, &request);
+    }
 
     status = ctx->api->set_rate(ctx->config->driver_id, rate, round_mode);
     if (status == FWK_PENDING)
@@ -193,8 +712,13 @@ static int clock_set_rate(fwk_id_t clock_id, uint64_t rate,
             ctx,
             clock_id,
             mod_clock_event_id_set_rate_request);
-    else
+
+    if (status != FWK_SUCCESS)
         return status;
+
+    cache_set_rate(ctx, rate, round_mode);
+
+    return FWK_SUCCESS;
 }
 
 static int clock_get_rate(fwk_id_t clock_id, uint64_t *rate)
@@ -211,14 +735,28 @@ static int clock_get_rate(fwk_id_t clock_id, uint64_t *rate)
     if (ctx->is_request_ongoing)
         return FWK_E_BUSY;
 
+    if (ctx->config->parent_divider != 0) {
+        status = refresh_derived_rate(ctx);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    if (ctx->is_rate_cached) {
+        *rate = ctx->rate;
+        return FWK_SUCCESS;
+    }
+
     status = ctx->api->get_rate(ctx->config->driver_id, rate);
     if (status == FWK_PENDING)
         return create_async_request(
             ctx,
             clock_id,
             mod_clock_event_id_get_rate_request);
-    else
-        return status;
+
+    if (status == FWK_SUCCESS)
+        update_rate(ctx, true, *rate);
+
+    return status;
 }
 
 static int clock_get_rate_from_index(fwk_id_t clock_id, unsigned int rate_index,
@@ -239,12 +777,18 @@ static int clock_set_state(fwk_id_t clock_id, enum mod_clock_state state)
 {
     int status;
     struct clock_dev_ctx *ctx;
+    struct clock_queued_request request;
 
     get_ctx(clock_id, &ctx);
 
-    /* Concurrency is not supported */
-    if (ctx->is_request_ongoing)
-        return FWK_E_BUSY;
+    if (ctx->is_request_ongoing) {
+        request = (struct clock_queued_request){
+            .event_id = mod_clock_event_id_set_state_request,
+            .state = state,
+        };
+
+        return queue_request(ctx, clock_id, &request);
+    }
 
     status = ctx->api->set_state(ctx->config->driver_id, state);
     if (status == FWK_PENDING)
@@ -324,6 +868,7 @@ static int clock_init(fwk_id_t module_id, unsigned int element_count,
         return FWK_E_PARAM;
 
     module_ctx.config = config;
+    module_ctx.dev_count = element_count;
     module_ctx.dev_ctx_table = fwk_mm_calloc(element_count,
                                              sizeof(struct clock_dev_ctx));
     return FWK_SUCCESS;
@@ -341,6 +886,73 @@ static int clock_dev_init(fwk_id_t element_id, unsigned int sub_element_count,
     return FWK_SUCCESS;
 }
 
+static int clock_post_init(fwk_id_t module_id)
+{
+    unsigned int idx, depth;
+    fwk_id_t parent_id;
+    struct clock_dev_ctx *ctx, *parent, *member;
+
+    /* Build the clock tree */
+    for (idx = 0; idx < module_ctx.dev_count; idx++) {
+        ctx = &module_ctx.dev_ctx_table[idx];
+        parent_id = ctx->config->parent_id;
+
+        if (fwk_id_is_type(parent_id, FWK_ID_TYPE_NONE)) {
+            if (ctx->config->parent_divider != 0)
+                return FWK_E_DATA;
+
+            continue;
+        }
+
+        if (!fwk_module_is_valid_element_id(parent_id) ||
+            (fwk_id_get_module_idx(parent_id) != FWK_MODULE_IDX_CLOCK) ||
+            (fwk_id_get_element_idx(parent_id) == idx))
+            return FWK_E_DATA;
+
+        parent = &module_ctx.dev_ctx_table[fwk_id_get_element_idx(parent_id)];
+        ctx->parent = parent;
+        ctx->next_sibling = parent->first_child;
+        parent->first_child = ctx;
+    }
+
+    /* Group the clocks by power domain, in element order */
+    for (idx = 0; idx < module_ctx.dev_count; idx++) {
+        ctx = &module_ctx.dev_ctx_table[idx];
+        ctx->pd_leader = ctx;
+
+        if (fwk_id_is_type(ctx->config->pd_source_id, FWK_ID_TYPE_NONE))
+            continue;
+
+        for (member = module_ctx.dev_ctx_table; member != ctx; member++) {
+            if ((member->pd_leader == member) &&
+                fwk_id_is_equal(
+                    member->config->pd_source_id, ctx->config->pd_source_id))
+                break;
+        }
+
+        if (member == ctx)
+            continue;
+
+        ctx->pd_leader = member;
+        while (member->pd_next != NULL)
+            member = member->pd_next;
+        member->pd_next = ctx;
+    }
+
+    /* A clock cannot be its own ancestor */
+    for (idx = 0; idx < module_ctx.dev_count; idx++) {
+        depth = 0;
+
+        for (parent = module_ctx.dev_ctx_table[idx].parent; parent != NULL;
+             parent = parent->parent) {
+            if (++depth >= module_ctx.dev_count)
+                return FWK_E_DATA;
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int clock_bind(fwk_id_t id, unsigned int round)
 {
     struct clock_dev_ctx *ctx;
@@ -363,7 +975,9 @@ static int clock_bind(fwk_id_t id, unsigned int round)
 static int clock_start(fwk_id_t id)
 {
     int status;
-    struct clock_dev_ctx *ctx;
+    struct clock_dev_ctx *ctx, *member;
+    bool has_transition_handler = false;
+    bool has_pending_transition_handler = false;
 
     /* Nothing to be done at the module level */
     if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
@@ -374,7 +988,18 @@ static int clock_start(fwk_id_t id)
     if (fwk_id_is_type(ctx->config->pd_source_id, FWK_ID_TYPE_NONE))
          return FWK_SUCCESS;
 
-    if ((ctx->api->process_power_transition != NULL) &&
+    /* The first clock of a power domain subscribes for all of them */
+    if (ctx->pd_leader != ctx)
+        return FWK_SUCCESS;
+
+    for (member = ctx; member != NULL; member = member->pd_next) {
+        if (member->api->process_power_transition != NULL)
+            has_transition_handler = true;
+        if (member->api->process_pending_power_transition != NULL)
+            has_pending_transition_handler = true;
+    }
+
+    if (has_transition_handler &&
         (fwk_id_is_type(
             module_ctx.config->pd_transition_notification_id,
             FWK_ID_TYPE_NOTIFICATION))) {
@@ -386,7 +1011,7 @@ static int clock_start(fwk_id_t id)
             return status;
     }
 
-    if ((ctx->api->process_pending_power_transition != NULL) &&
+    if (has_pending_transition_handler &&
         (fwk_id_is_type(
             module_ctx.config->pd_pre_transition_notification_id,
             FWK_ID_TYPE_NOTIFICATION))) {
@@ -437,6 +1062,8 @@ static int clock_process_pd_pre_transition_notification(
     struct fwk_event *resp_event)
 {
     int status;
+    unsigned int notifications_sent;
+    struct clock_dev_ctx *member;
     struct mod_pd_power_state_pre_transition_notification_params *pd_params;
     struct mod_pd_power_state_pre_transition_notification_resp_params
         *pd_resp_params;
@@ -444,7 +1071,6 @@ static int clock_process_pd_pre_transition_notification(
     struct fwk_event outbound_event = {
         .response_requested = true,
         .id = mod_clock_notification_id_state_change_pending,
-        .source_id = FWK_ID_NONE
     };
 
     pd_params = (struct mod_pd_power_state_pre_transition_notification_params *)
@@ -453,24 +1079,29 @@ static int clock_process_pd_pre_transition_notification(
         (struct mod_pd_power_state_pre_transition_notification_resp_params *)
             resp_event->params;
 
-    fwk_assert(ctx->api->process_pending_power_transition != NULL);
-    status = ctx->api->process_pending_power_transition(
-        ctx->config->driver_id,
-        pd_params->current_state,
-        pd_params->target_state);
+    ctx->transition_pending_notifications_sent = 0;
+    ctx->transition_pending_response_status = FWK_SUCCESS;
 
     /*
      * The response to the notification should initially be the overall result
-     * of the downwards propagation of the state change through the driver(s).
+     * of the downwards propagation of the state change through the driver(s)
+     * of all the clocks of the power domain.
      */
-    pd_resp_params->status = status;
-
-    if (status != FWK_SUCCESS) {
-        ctx->transition_pending_notifications_sent = 0;
-        return status;
+    for (member = ctx; member != NULL; member = member->pd_next) {
+        if (member->api->process_pending_power_transition == NULL)
+            continue;
+
+        status = member->api->process_pending_power_transition(
+            member->config->driver_id,
+            pd_params->current_state,
+            pd_params->target_state);
+        if (status != FWK_SUCCESS) {
+            pd_resp_params->status = status;
+            return status;
+        }
     }
 
-    ctx->transition_pending_response_status = FWK_SUCCESS;
+    pd_resp_params->status = FWK_SUCCESS;
     out_params =
         (struct clock_notification_params *)outbound_event.params;
 
@@ -485,13 +1116,24 @@ static int clock_process_pd_pre_transition_notification(
         ? MOD_CLOCK_STATE_RUNNING
         : MOD_CLOCK_STATE_STOPPED;
 
-    /* Notify subscribers of the pending clock state change */
-    status = fwk_notification_notify(
-        &outbound_event,
-        &(ctx->transition_pending_notifications_sent));
-    if (status != FWK_SUCCESS) {
-        pd_resp_params->status = status;
-        return status;
+    /*
+     * Notify the subscribers of the pending clock state changes, their
+     * responses are collected by this clock.
+     */
+    for (member = ctx; member != NULL; member = member->pd_next) {
+        if (member->api->process_pending_power_transition == NULL)
+            continue;
+
+        outbound_event.source_id = get_clock_id(member);
+
+        status = fwk_notification_notify(
+            &outbound_event, &notifications_sent);
+        if (status != FWK_SUCCESS) {
+            pd_resp_params->status = status;
+            return status;
+        }
+
+        ctx->transition_pending_notifications_sent += notifications_sent;
     }
 
     if (ctx->transition_pending_notifications_sent > 0) {
@@ -500,7 +1142,7 @@ static int clock_process_pd_pre_transition_notification(
         ctx->pd_pre_power_transition_notification_cookie = event->cookie;
     }
 
-    return status;
+    return FWK_SUCCESS;
 }
 
 static int clock_process_pd_transition_notification(
@@ -508,37 +1150,51 @@ static int clock_process_pd_transition_notification(
     const struct fwk_event *event)
 {
     int status;
+    int result = FWK_SUCCESS;
     unsigned int transition_notifications_sent;
+    struct clock_dev_ctx *member;
     struct mod_pd_power_state_transition_notification_params *pd_params;
     struct clock_notification_params* out_params;
     struct fwk_event outbound_event = {
         .response_requested = false,
         .id = mod_clock_notification_id_state_changed,
-        .source_id = FWK_ID_NONE
     };
 
     pd_params =
         (struct mod_pd_power_state_transition_notification_params *)event
             ->params;
 
-    fwk_assert(ctx->api->process_power_transition != NULL);
-    status = ctx->api->process_power_transition(
-        ctx->config->driver_id, pd_params->state);
-
-    if (status != FWK_SUCCESS)
-        return status;
-
-    /* Notify subscribers of the clock state change */
     out_params = (struct clock_notification_params *)outbound_event.params;
     if (pd_params->state == MOD_PD_STATE_ON)
         out_params->new_state = MOD_CLOCK_STATE_RUNNING;
     else
         out_params->new_state = MOD_CLOCK_STATE_STOPPED;
 
-    status = fwk_notification_notify(
-        &outbound_event, &(transition_notifications_sent));
+    /* Update all the clocks of the power domain in one pass */
+    for (member = ctx; member != NULL; member = member->pd_next) {
+        if (member->api->process_power_transition == NULL)
+            continue;
 
-    return status;
+        status = member->api->process_power_transition(
+            member->config->driver_id, pd_params->state);
+        if (status != FWK_SUCCESS) {
+            result = status;
+            continue;
+        }
+
+        /* The rates may not have been retained across the transition */
+        update_rate(member, false, 0);
+
+        /* Notify subscribers of the clock state change */
+        outbound_event.source_id = get_clock_id(member);
+
+        status = fwk_notification_notify(
+            &outbound_event, &transition_notifications_sent);
+        if (status != FWK_SUCCESS)
+            result = status;
+    }
+
+    return result;
 }
 
 static int clock_process_notification_response(
@@ -550,6 +1206,7 @@ static int clock_process_notification_response(
         *pd_resp_params;
     struct fwk_event pd_response_event = {
         .id = module_ctx.config->pd_pre_transition_notification_id,
+        .source_id = get_clock_id(ctx),
         .target_id = ctx->config->pd_source_id,
         .cookie = ctx->pd_pre_power_transition_notification_cookie,
         .is_notification = true,
@@ -604,8 +1261,9 @@ static int clock_process_notification(
 
     ctx = &module_ctx.dev_ctx_table[fwk_id_get_element_idx(event->target_id)];
 
+    /* The responses are collected for the whole power domain */
     if (event->is_response)
-        return clock_process_notification_response(ctx, event);
+        return clock_process_notification_response(ctx->pd_leader, event);
 
     if (fwk_id_is_equal(
             event->id, module_ctx.config->pd_transition_notification_id))
@@ -647,9 +1305,11 @@ const struct fwk_module module_clock = {
     .notification_count = MOD_CLOCK_NOTIFICATION_IDX_COUNT,
     .init = clock_init,
     .element_init = clock_dev_init,
+    .post_init = clock_post_init,
     .bind = clock_bind,
     .start = clock_start,
     .process_bind_request = clock_process_bind_request,
+    .bind_shared_api_mask = (1U << MOD_CLOCK_API_TYPE_HAL),
     .process_notification = clock_process_notification,
     .process_event = clock_process_event,
 };
@@ -0,0 +1,163 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Rate table lookups shared by the clock drivers.
+ */
+
+#include <mod_clock.h>
+
+#include <fwk_status.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static uint64_t get_entry_rate(
+    const struct mod_clock_rate_index *index,
+    size_t idx)
+{
+    return *(const uint64_t *)(
+        (const uint8_t *)index->table + (idx * index->entry_size));
+}
+
+/*
+ * Position of the last entry whose rate is not above the given rate. Returns
+ * false if the rate is below the rate of the first entry.
+ */
+static bool find_floor(
+    const struct mod_clock_rate_index *index,
+    uint64_t rate,
+    size_t *idx)
+{
+    uint64_t first = get_entry_rate(index, 0);
+    uint64_t offset;
+    size_t low, high, mid;
+
+    if (rate < first)
+        return false;
+
+    if (index->step != 0) {
+        offset = (rate - first) / index->step;
+        *idx = (offset < index->count) ? (size_t)offset : (index->count - 1);
+
+        return true;
+    }
+
+    /* The first entry is known to be at or below the rate */
+    low = 0;
+    high = index->count - 1;
+
+    while (low < high) {
+        mid = low + ((high - low + 1) / 2);
+
+        if (get_entry_rate(index, mid) <= rate)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    *idx = low;
+
+    return true;
+}
+
+int mod_clock_rate_index_init(
+    struct mod_clock_rate_index *index,
+    const void *table,
+    size_t entry_size,
+    size_t count)
+{
+    uint64_t rate, last_rate;
+    size_t idx;
+
+    if ((index == NULL) || (table == NULL) || (entry_size < sizeof(uint64_t)) ||
+        (count == 0))
+        return FWK_E_PARAM;
+
+    *index = (struct mod_clock_rate_index){
+        .table = table,
+        .entry_size = entry_size,
+        .count = count,
+    };
+
+    if (count > 1)
+        index->step = get_entry_rate(index, 1) - get_entry_rate(index, 0);
+
+    last_rate = get_entry_rate(index, 0);
+
+    for (idx = 1; idx < count; idx++) {
+        rate = get_entry_rate(index, idx);
+
+        /* The rate entries must be in ascending order */
+        if (rate < last_rate)
+            return FWK_E_DATA;
+
+        if ((rate - last_rate) != index->step)
+            index->step = 0;
+
+        last_rate = rate;
+    }
+
+    return FWK_SUCCESS;
+}
+
+int mod_clock_rate_index_lookup(
+    const struct mod_clock_rate_index *index,
+    uint64_t rate,
+    enum mod_clock_round_mode round_mode,
+    const void **entry)
+{
+    size_t floor = 0, idx;
+    bool has_floor, has_ceiling;
+
+    if ((index == NULL) || (entry == NULL) || (index->count == 0))
+        return FWK_E_PARAM;
+
+    has_floor = find_floor(index, rate, &floor);
+    has_ceiling = has_floor ? ((floor + 1) < index->count) : true;
+
+    if (has_floor && (get_entry_rate(index, floor) == rate))
+        idx = floor;
+    else {
+        switch (round_mode) {
+        case MOD_CLOCK_ROUND_MODE_DOWN:
+            if (!has_floor)
+                return FWK_E_PARAM;
+
+            idx = floor;
+            break;
+
+        case MOD_CLOCK_ROUND_MODE_UP:
+            if (!has_ceiling)
+                return FWK_E_PARAM;
+
+            idx = has_floor ? (floor + 1) : 0;
+            break;
+
+        case MOD_CLOCK_ROUND_MODE_NEAREST:
+            if (!has_floor)
+                idx = 0;
+            else if (!has_ceiling)
+                idx = floor;
+            else {
+                /* Ties round down */
+                idx = ((get_entry_rate(index, floor + 1) - rate) <
+                       (rate - get_entry_rate(index, floor))) ?
+                    (floor + 1) :
+                    floor;
+            }
+            break;
+
+        default:
+            return FWK_E_PARAM;
+        }
+    }
+
+    *entry = (const uint8_t *)index->table + (idx * index->entry_size);
+
+    return FWK_SUCCESS;
+}
@@ -39,6 +39,11 @@ int ccix_enter_system_coherency(struct cmn600_ctx *ctx, uint8_t link_id);
  */
 int ccix_enter_dvm_domain(struct cmn600_ctx *ctx, uint8_t link_id);
 
+/*
+ *  CMN600 CCIX multi-link bring-up Function
+ */
+int ccix_bring_up_links(struct cmn600_ctx *ctx, uint8_t link_mask);
+
 /*
  * CMN600 CCIX get Capabilities Function
  */
@@ -164,6 +169,8 @@ struct cxg_wait_condition_data {
     struct cmn600_ctx *ctx;
     uint8_t link_id;
     enum cxg_link_up_wait_cond cond;
+    /* Links polled together by the multi-link bring-up */
+    uint8_t link_mask;
 };
 
 /* CCIX Gateway (CXG) Request Agent (RA) defines */
@@ -228,6 +235,7 @@ struct cxg_wait_condition_data {
 #define CXG_LINK_STATUS_ACK_MASK                  UINT64_C(0x0000000000000001)
 #define CXG_LINK_STATUS_DOWN_MASK                 UINT64_C(0x0000000000000002)
 #define CXG_LINK_STATUS_DVMDOMAIN_ACK_MASK        UINT64_C(0x0000000000000004)
+#define CXG_LINK_COUNT                            3
 #define CXG_PRTCL_LINK_CTRL_TIMEOUT               UINT32_C(100)
 #define CXG_PRTCL_LINK_DVMDOMAIN_TIMEOUT          UINT32_C(100)
 
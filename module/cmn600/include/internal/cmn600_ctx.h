@@ -19,6 +19,10 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#ifdef BUILD_HAS_MOD_SDS
+#    include <mod_sds.h>
+#endif
+
 /* External nodes that require RN-SAM mapping during run-time */
 struct external_rnsam_tuple {
     unsigned int node_id;
@@ -26,10 +30,10 @@ struct external_rnsam_tuple {
 };
 
 /* Max Node Counts */
-#define MAX_HNF_COUNT 32
-#define MAX_RND_COUNT 32
+#define MAX_HNF_COUNT MOD_CMN600_DISCOVERY_MAX_NODE_COUNT
+#define MAX_RND_COUNT MOD_CMN600_DISCOVERY_MAX_NODE_COUNT
 #define MAX_RNF_COUNT 32
-#define MAX_RNI_COUNT 32
+#define MAX_RNI_COUNT MOD_CMN600_DISCOVERY_MAX_NODE_COUNT
 
 struct cmn600_ctx {
     const struct mod_cmn600_config *config;
@@ -39,6 +43,7 @@ struct cmn600_ctx {
     /* Number of HN-F (system cache) nodes in the system */
     unsigned int hnf_count;
     uint32_t hnf_offset[MAX_HNF_COUNT];
+    uint32_t hnf_xp_offset[MAX_HNF_COUNT];
     uint64_t *hnf_cache_group;
 
     /*
@@ -86,6 +91,9 @@ struct cmn600_ctx {
     struct cmn600_cxg_ha_reg *cxg_ha_reg;
     struct cmn600_cxla_reg *cxla_reg;
 
+    /* Debug/trace controller, for the PMU */
+    void *dtc_reg;
+
     /* CCIX host parameters to be sent to upper level firmware */
     struct mod_cmn600_ccix_host_node_config ccix_host_info;
 
@@ -95,6 +103,11 @@ struct cmn600_ctx {
     /* Chip information */
     const struct mod_system_info *system_info;
 
+#ifdef BUILD_HAS_MOD_SDS
+    /* SDS API, saving the discovered topology */
+    const struct mod_sds_api *sds_api;
+#endif
+
     bool initialized;
 
     /* Chip ID value */
@@ -34,6 +34,67 @@
  */
 #define MAX_HA_MMAP_ENTRIES     4
 
+/*!
+ * \brief Max number of nodes of a type recorded by the discovery.
+ */
+#define MOD_CMN600_DISCOVERY_MAX_NODE_COUNT 32
+
+/*!
+ * \brief Topology found by the discovery of the mesh, as saved in SDS.
+ *
+ * \details The node locations are offsets from the base address of the
+ *      CMN600, 0 if the node is not present.
+ */
+struct mod_cmn600_discovery_sds {
+    /*! Hash of the mesh the topology was discovered on */
+    uint32_t topology_hash;
+
+    /*! Number of HN-F nodes */
+    uint32_t hnf_count;
+
+    /*! Number of internal RN-SAM nodes */
+    uint32_t internal_rnsam_count;
+
+    /*! Number of external RN-SAM nodes */
+    uint32_t external_rnsam_count;
+
+    /*! Number of RN-D nodes */
+    uint32_t rnd_count;
+
+    /*! Number of RN-I nodes */
+    uint32_t rni_count;
+
+    /*! Number of RN-F nodes */
+    uint32_t rnf_count;
+
+    /*! Number of CCIX home agents */
+    uint32_t host_ha_count;
+
+    /*! Location of the CXLA node */
+    uint32_t cxla_offset;
+
+    /*! Location of the CXRA node */
+    uint32_t cxg_ra_offset;
+
+    /*! Location of the CXHA node */
+    uint32_t cxg_ha_offset;
+
+    /*! Location of the DTC node */
+    uint32_t dtc_offset;
+
+    /*! Locations of the HN-F nodes */
+    uint32_t hnf_offset[MOD_CMN600_DISCOVERY_MAX_NODE_COUNT];
+
+    /*! Locations of the cross points of the HN-F nodes */
+    uint32_t hnf_xp_offset[MOD_CMN600_DISCOVERY_MAX_NODE_COUNT];
+
+    /*! Logical identifiers of the RN-D nodes */
+    uint8_t rnd_ldid[MOD_CMN600_DISCOVERY_MAX_NODE_COUNT];
+
+    /*! Logical identifiers of the RN-I nodes */
+    uint8_t rni_ldid[MOD_CMN600_DISCOVERY_MAX_NODE_COUNT];
+};
+
 /*!
  * \brief Module API indices
  */
@@ -44,6 +105,9 @@ enum mod_cmn600_api_idx {
     /*! Index of the CCIX config setup API */
     MOD_CMN600_API_IDX_CCIX_CONFIG,
 
+    /*! Index of the mesh topology API, see ::cmn_core_topology_api */
+    MOD_CMN600_API_IDX_TOPOLOGY,
+
     /*! Number of APIs */
     MOD_CMN600_API_COUNT
 };
@@ -150,6 +214,18 @@ struct mod_cmn600_config {
      *      to a CAL port, node id of HN-F will be a odd number).
      */
     bool hnf_cal_mode;
+
+    /*!
+     * \brief Identifier of the SDS structure saving the discovered topology
+     *
+     * \details The structure must be at least the size of
+     *      ::mod_cmn600_discovery_sds. The topology found by the discovery of
+     *      the mesh is saved to it, and the following boots reuse it instead
+     *      of walking the mesh as long as it was discovered on the same mesh.
+     *
+     * \note May be 0, in which case the mesh is discovered on every boot.
+     */
+    uint32_t discovery_sds_structure_id;
 };
 
 /*!
@@ -300,6 +376,20 @@ struct mod_cmn600_ccix_config_api {
      * \return one of the error code otherwise.
      */
     int (*enter_dvm_domain)(uint8_t link_id);
+    /*!
+     * \brief Interface to bring up several links together
+     *
+     * \details Exchanges the protocol credits, then enters system coherency
+     *      and then the DVM domain on all the links, each step being started
+     *      on every link before waiting for the links to complete it.
+     *
+     * \param  link_mask Mask of the links to bring up, bit n standing for
+     *                   link n.
+     *
+     * \retval ::FWK_SUCCESS if the operation succeed.
+     * \return one of the error code otherwise.
+     */
+    int (*bring_up_links)(uint8_t link_mask);
 };
 
 /*!
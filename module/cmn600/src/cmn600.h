@@ -11,6 +11,8 @@
 #ifndef CMN600_H
 #define CMN600_H
 
+#include <cmn_core.h>
+
 #include <fwk_macros.h>
 
 #include <stdbool.h>
@@ -558,6 +560,9 @@ struct cmn600_hni_reg {
 #define CMN600_ROOT_NODE_OFFSET_PORT_POS 14
 #define CMN600_ROOT_NODE_OFFSET_Y_POS 20
 
+/* Offset of the DTM registers in a cross point */
+#define CMN600_DTM_OFFSET 0x2000
+
 /* Peripheral ID Revision Numbers */
 #define CMN600_PERIPH_ID_2_REV_R1_P0 ((0x00 << 4) + (0x0B))
 #define CMN600_PERIPH_ID_2_REV_R1_P1 ((0x01 << 4) + (0x0B))
@@ -570,6 +575,9 @@ struct cmn600_hni_reg {
 /* Peripheral ID Revision Numbers */
 #define CMN600_PERIPH_ID_2_MASK UINT64_C(0xFF)
 
+/* Register fields of this generation, for the shared CMN helpers */
+extern const struct cmn_core_desc cmn600_core_desc;
+
 /*
  * Retrieve the number of child nodes of a given node
  *
@@ -91,6 +91,25 @@ static bool cxg_link_wait_condition(void *data)
     }
 }
 
+/* Wait condition met once it is met by each link of the mask */
+static bool cxg_links_wait_condition(void *data)
+{
+    struct cxg_wait_condition_data link_data;
+
+    fwk_assert(data != NULL);
+
+    link_data = *(struct cxg_wait_condition_data *)data;
+
+    for (link_data.link_id = 0; link_data.link_id < CXG_LINK_COUNT;
+         link_data.link_id++) {
+        if (((link_data.link_mask & (1U << link_data.link_id)) != 0) &&
+            !cxg_link_wait_condition(&link_data))
+            return false;
+    }
+
+    return true;
+}
+
 static int enable_smp_mode(struct cmn600_ctx *ctx)
 {
     if (get_cmn600_revision(ctx->root) == CMN600_PERIPH_ID_2_REV_R2_P0) {
@@ -662,6 +681,73 @@ int ccix_enter_dvm_domain(struct cmn600_ctx *ctx, uint8_t link_id)
     return FWK_SUCCESS;
 }
 
+int ccix_bring_up_links(struct cmn600_ctx *ctx, uint8_t link_mask)
+{
+    struct cxg_wait_condition_data wait_data;
+    uint8_t link_id;
+    int status;
+
+    if ((link_mask == 0) || ((link_mask >> CXG_LINK_COUNT) != 0))
+        return FWK_E_PARAM;
+
+    wait_data.ctx = ctx;
+    wait_data.link_mask = link_mask;
+
+    /*
+     * Each phase is started on all the links before waiting for any of them,
+     * so that the links come up in parallel.
+     */
+    FWK_LOG_INFO(
+        MOD_NAME "Exchanging protocol credits for links 0x%x...", link_mask);
+    for (link_id = 0; link_id < CXG_LINK_COUNT; link_id++) {
+        if ((link_mask & (1U << link_id)) == 0)
+            continue;
+
+        ctx->cxg_ra_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL |=
+            CXG_LINK_CTRL_UP_MASK;
+        ctx->cxg_ha_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL |=
+            CXG_LINK_CTRL_UP_MASK;
+    }
+
+    FWK_LOG_INFO(
+        MOD_NAME "Entering system coherency for links 0x%x...", link_mask);
+    for (link_id = 0; link_id < CXG_LINK_COUNT; link_id++) {
+        if ((link_mask & (1U << link_id)) != 0)
+            ctx->cxg_ha_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL |=
+                CXG_LINK_CTRL_DVMDOMAIN_REQ_MASK;
+    }
+
+    wait_data.cond = CXG_LINK_STATUS_HA_DVMDOMAIN_ACK_BIT_SET;
+    status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
+                                  CXG_PRTCL_LINK_DVMDOMAIN_TIMEOUT,
+                                  cxg_links_wait_condition,
+                                  &wait_data);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_INFO(MOD_NAME "Failed");
+        return status;
+    }
+
+    FWK_LOG_INFO(MOD_NAME "Entering DVM domain for links 0x%x...", link_mask);
+    for (link_id = 0; link_id < CXG_LINK_COUNT; link_id++) {
+        if ((link_mask & (1U << link_id)) != 0)
+            ctx->cxg_ra_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL |=
+                CXG_LINK_CTRL_DVMDOMAIN_REQ_MASK;
+    }
+
+    wait_data.cond = CXG_LINK_STATUS_RA_DVMDOMAIN_ACK_BIT_SET;
+    status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
+                                  CXG_PRTCL_LINK_DVMDOMAIN_TIMEOUT,
+                                  cxg_links_wait_condition,
+                                  &wait_data);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_INFO(MOD_NAME "Failed");
+        return status;
+    }
+
+    FWK_LOG_INFO(MOD_NAME "Done");
+    return FWK_SUCCESS;
+}
+
 void ccix_capabilities_get(struct cmn600_ctx *ctx)
 {
     /* Populate maximum credit send capability */
@@ -79,11 +79,8 @@ static void process_node_hnf(struct cmn600_hnf_reg *hnf)
 
     fwk_assert(logical_id < config->snf_count);
 
-    group = logical_id /
-        (CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP * cal_mode_factor);
-    bit_pos = (CMN600_HNF_CACHE_GROUP_ENTRY_BITS_WIDTH / cal_mode_factor) *
-        (logical_id % (CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP *
-                       cal_mode_factor));
+    cmn_core_hnf_cache_group_locate(
+        &cmn600_core_desc, logical_id, cal_mode_factor, &group, &bit_pos);
 
     /*
      * If CAL mode is set, add only even numbered hnd node to
@@ -207,9 +204,14 @@ static int cmn600_discovery(void)
                             MAX_HNF_COUNT);
                         return FWK_E_DATA;
                     }
+                    ctx->hnf_xp_offset[ctx->hnf_count] = (uint32_t)xp;
                     ctx->hnf_offset[ctx->hnf_count++] = (uint32_t)node;
                     break;
 
+                case NODE_TYPE_DTC:
+                    ctx->dtc_reg = node;
+                    break;
+
                 case NODE_TYPE_RN_SAM:
                     ctx->internal_rnsam_count++;
                     break;
@@ -306,6 +308,162 @@ static int cmn600_discovery(void)
     return FWK_SUCCESS;
 }
 
+#ifdef BUILD_HAS_MOD_SDS
+/* Version of the layout of the saved topology, part of the topology hash */
+#define CMN600_DISCOVERY_SDS_VERSION 2
+
+static uint32_t hash_add(uint32_t hash, uint64_t value)
+{
+    unsigned int byte;
+
+    /* FNV-1a */
+    for (byte = 0; byte < sizeof(value); byte++) {
+        hash ^= (uint32_t)(value >> (byte * 8)) & 0xFF;
+        hash *= UINT32_C(16777619);
+    }
+
+    return hash;
+}
+
+/*
+ * Identify the mesh from its configuration and the root node registers, which
+ * are only a few reads away.
+ */
+static uint32_t cmn600_topology_hash(void)
+{
+    const struct mod_cmn600_config *config = ctx->config;
+    uint32_t hash = UINT32_C(2166136261);
+
+    hash = hash_add(hash, CMN600_DISCOVERY_SDS_VERSION);
+    hash = hash_add(hash, config->base);
+    hash = hash_add(hash, config->mesh_size_x);
+    hash = hash_add(hash, config->mesh_size_y);
+    hash = hash_add(hash, config->hnd_node_id);
+    hash = hash_add(hash, ctx->root->NODE_INFO);
+    hash = hash_add(hash, ctx->root->PERIPH_ID[1]);
+    hash = hash_add(hash, ctx->root->CHILD_INFO);
+
+    return hash;
+}
+
+static uint32_t node_to_offset(const void *node)
+{
+    return (node == NULL) ? 0 : (uint32_t)((uintptr_t)node - ctx->config->base);
+}
+
+static void *offset_to_node(uint32_t offset)
+{
+    return (offset == 0) ? NULL : (void *)(ctx->config->base + offset);
+}
+
+static int cmn600_discovery_restore(void)
+{
+    int status;
+    unsigned int idx;
+    struct mod_cmn600_discovery_sds sds;
+
+    status = ctx->sds_api->struct_read(
+        ctx->config->discovery_sds_structure_id, 0, &sds, sizeof(sds));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if ((sds.topology_hash != cmn600_topology_hash()) ||
+        (sds.hnf_count > MAX_HNF_COUNT) || (sds.rnd_count > MAX_RND_COUNT) ||
+        (sds.rni_count > MAX_RNI_COUNT) || (sds.rnf_count > MAX_RNF_COUNT))
+        return FWK_E_DATA;
+
+    ctx->hnf_count = sds.hnf_count;
+    for (idx = 0; idx < sds.hnf_count; idx++) {
+        ctx->hnf_offset[idx] = (uint32_t)(uintptr_t)offset_to_node(
+            sds.hnf_offset[idx]);
+        ctx->hnf_xp_offset[idx] = (uint32_t)(uintptr_t)offset_to_node(
+            sds.hnf_xp_offset[idx]);
+    }
+
+    ctx->internal_rnsam_count = sds.internal_rnsam_count;
+    ctx->external_rnsam_count = sds.external_rnsam_count;
+    ctx->rnd_count = sds.rnd_count;
+    memcpy(ctx->rnd_ldid, sds.rnd_ldid, sizeof(ctx->rnd_ldid));
+    ctx->rni_count = sds.rni_count;
+    memcpy(ctx->rni_ldid, sds.rni_ldid, sizeof(ctx->rni_ldid));
+    ctx->rnf_count = sds.rnf_count;
+    ctx->ccix_host_info.host_ha_count = sds.host_ha_count;
+    ctx->cxla_reg = offset_to_node(sds.cxla_offset);
+    ctx->cxg_ra_reg = offset_to_node(sds.cxg_ra_offset);
+    ctx->cxg_ha_reg = offset_to_node(sds.cxg_ha_offset);
+    ctx->dtc_reg = offset_to_node(sds.dtc_offset);
+
+    FWK_LOG_INFO(
+        MOD_NAME "Reusing discovered topology: %d HN-F, %d RN-F nodes",
+        ctx->hnf_count,
+        ctx->rnf_count);
+
+    return FWK_SUCCESS;
+}
+
+static void cmn600_discovery_save(void)
+{
+    int status;
+    unsigned int idx;
+    uint32_t structure_id = ctx->config->discovery_sds_structure_id;
+    struct mod_cmn600_discovery_sds sds = {
+        .topology_hash = cmn600_topology_hash(),
+        .hnf_count = ctx->hnf_count,
+        .internal_rnsam_count = ctx->internal_rnsam_count,
+        .external_rnsam_count = ctx->external_rnsam_count,
+        .rnd_count = ctx->rnd_count,
+        .rni_count = ctx->rni_count,
+        .rnf_count = ctx->rnf_count,
+        .host_ha_count = ctx->ccix_host_info.host_ha_count,
+        .cxla_offset = node_to_offset(ctx->cxla_reg),
+        .cxg_ra_offset = node_to_offset(ctx->cxg_ra_reg),
+        .cxg_ha_offset = node_to_offset(ctx->cxg_ha_reg),
+        .dtc_offset = node_to_offset(ctx->dtc_reg),
+    };
+
+    for (idx = 0; idx < ctx->hnf_count; idx++) {
+        sds.hnf_offset[idx] =
+            node_to_offset((void *)(uintptr_t)ctx->hnf_offset[idx]);
+        sds.hnf_xp_offset[idx] =
+            node_to_offset((void *)(uintptr_t)ctx->hnf_xp_offset[idx]);
+    }
+
+    memcpy(sds.rnd_ldid, ctx->rnd_ldid, sizeof(sds.rnd_ldid));
+    memcpy(sds.rni_ldid, ctx->rni_ldid, sizeof(sds.rni_ldid));
+
+    status = ctx->sds_api->struct_write(structure_id, 0, &sds, sizeof(sds));
+    if (status == FWK_SUCCESS)
+        status = ctx->sds_api->struct_finalize(structure_id);
+
+    if ((status != FWK_SUCCESS) && (status != FWK_E_STATE))
+        FWK_LOG_WARN(MOD_NAME "Unable to save the discovered topology");
+}
+#endif
+
+/*
+ * Discover the mesh, or reuse the topology discovered by a previous boot.
+ */
+static int cmn600_discover(void)
+{
+#ifdef BUILD_HAS_MOD_SDS
+    int status;
+
+    if (ctx->sds_api == NULL)
+        return cmn600_discovery();
+
+    if (cmn600_discovery_restore() == FWK_SUCCESS)
+        return FWK_SUCCESS;
+
+    status = cmn600_discovery();
+    if (status == FWK_SUCCESS)
+        cmn600_discovery_save();
+
+    return status;
+#else
+    return cmn600_discovery();
+#endif
+}
+
 static void cmn600_configure(void)
 {
     unsigned int xp_count;
@@ -555,7 +713,7 @@ static int cmn600_setup(void)
     int status = FWK_SUCCESS;
 
     if (!ctx->initialized) {
-        status = cmn600_discovery();
+        status = cmn600_discover();
         if (status != FWK_SUCCESS)
             return status;
         /*
@@ -697,12 +855,74 @@ static int cmn600_ccix_enter_dvm_domain(uint8_t link_id)
     return ccix_enter_dvm_domain(ctx, link_id);
 }
 
+static int cmn600_ccix_bring_up_links(uint8_t link_mask)
+{
+    return ccix_bring_up_links(ctx, link_mask);
+}
+
 static const struct mod_cmn600_ccix_config_api cmn600_ccix_config_api = {
     .get_config = cmn600_ccix_config_get,
     .set_config = cmn600_ccix_config_set,
     .exchange_protocol_credit = cmn600_ccix_exchange_protocol_credit,
     .enter_system_coherency = cmn600_ccix_enter_system_coherency,
     .enter_dvm_domain = cmn600_ccix_enter_dvm_domain,
+    .bring_up_links = cmn600_ccix_bring_up_links,
+};
+
+/* Mesh topology API */
+
+static int cmn600_topology_get_hnf_count(unsigned int *count)
+{
+    if (!ctx->initialized)
+        return FWK_E_STATE;
+
+    *count = ctx->hnf_count;
+
+    return FWK_SUCCESS;
+}
+
+static int cmn600_topology_get_hnf(
+    unsigned int hnf_idx,
+    struct cmn_core_hnf_info *info)
+{
+    void *node;
+
+    if (!ctx->initialized)
+        return FWK_E_STATE;
+
+    if (hnf_idx >= ctx->hnf_count)
+        return FWK_E_PARAM;
+
+    node = (void *)(uintptr_t)ctx->hnf_offset[hnf_idx];
+
+    /* A CMN600 cross point has a single DTM watching both device ports */
+    *info = (struct cmn_core_hnf_info){
+        .node = (uintptr_t)node,
+        .dtm = (uintptr_t)ctx->hnf_xp_offset[hnf_idx] + CMN600_DTM_OFFSET,
+        .dtm_port = get_port_number(get_node_id(node)),
+        .device = 0,
+    };
+
+    return FWK_SUCCESS;
+}
+
+static int cmn600_topology_get_dtc(uintptr_t *dtc)
+{
+    if (!ctx->initialized)
+        return FWK_E_STATE;
+
+    if (ctx->dtc_reg == NULL)
+        return FWK_E_SUPPORT;
+
+    *dtc = (uintptr_t)ctx->dtc_reg;
+
+    return FWK_SUCCESS;
+}
+
+static const struct cmn_core_topology_api cmn600_topology_api = {
+    .get_hnf_count = cmn600_topology_get_hnf_count,
+    .get_hnf = cmn600_topology_get_hnf,
+    .get_dtc = cmn600_topology_get_dtc,
 };
 
 
@@ -764,6 +984,16 @@ static int cmn600_bind(fwk_id_t id, unsigned int round)
                                  &system_info_api);
         if (status != FWK_SUCCESS)
             return FWK_E_PANIC;
+
+#ifdef BUILD_HAS_MOD_SDS
+        if (ctx->config->discovery_sds_structure_id != 0) {
+            status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SDS),
+                                     FWK_ID_API(FWK_MODULE_IDX_SDS, 0),
+                                     &ctx->sds_api);
+            if (status != FWK_SUCCESS)
+                return FWK_E_PANIC;
+        }
+#endif
     }
 
     return FWK_SUCCESS;
@@ -780,6 +1010,10 @@ static int cmn600_process_bind_request(fwk_id_t requester_id,
     case MOD_CMN600_API_IDX_CCIX_CONFIG:
         *api = &cmn600_ccix_config_api;
         break;
+
+    case MOD_CMN600_API_IDX_TOPOLOGY:
+        *api = &cmn600_topology_api;
+        break;
     }
 
     return FWK_SUCCESS;
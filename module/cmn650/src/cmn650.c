@@ -18,84 +18,60 @@
 static unsigned int encoding_bits;
 static unsigned int mask_bits;
 
+const struct cmn_core_desc cmn650_core_desc = {
+    .child_pointer_offset_mask = CMN650_CHILD_POINTER_OFFSET,
+    .child_pointer_ext_node_pointer_mask =
+        CMN650_CHILD_POINTER_EXT_NODE_POINTER,
+    .child_pointer_ext_node_pointer_pos =
+        CMN650_CHILD_POINTER_EXT_NODE_POINTER_POS,
+    .node_id_port_pos = CMN650_NODE_ID_PORT_POS,
+    .node_id_port_mask = CMN650_NODE_ID_PORT_MASK,
+    .rnsam_region_entry_type_pos = CMN650_RNSAM_REGION_ENTRY_TYPE_POS,
+    .rnsam_region_entry_size_pos = CMN650_RNSAM_REGION_ENTRY_SIZE_POS,
+    .rnsam_region_entry_base_pos = CMN650_RNSAM_REGION_ENTRY_BASE_POS,
+    .hnf_cache_group_entries_per_group =
+        CMN650_HNF_CACHE_GROUP_ENTRIES_PER_GROUP,
+    .hnf_cache_group_entry_bits_width = CMN650_HNF_CACHE_GROUP_ENTRY_BITS_WIDTH,
+};
+
 unsigned int get_node_child_count(void *node_base)
 {
-    struct node_header *node = node_base;
-    return node->CHILD_INFO & CMN650_CHILD_INFO_COUNT;
+    return cmn_core_node_child_count(node_base);
 }
 
 enum node_type get_node_type(void *node_base)
 {
-    struct node_header *node = node_base;
-    return (enum node_type)(node->NODE_INFO & CMN650_NODE_INFO_TYPE);
+    return (enum node_type)cmn_core_node_type(node_base);
 }
 
 unsigned int get_node_id(void *node_base)
 {
-    struct node_header *node = node_base;
-    return (node->NODE_INFO & CMN650_NODE_INFO_ID) >> CMN650_NODE_INFO_ID_POS;
+    return cmn_core_node_id(node_base);
 }
 
 unsigned int get_node_logical_id(void *node_base)
 {
-    struct node_header *node = node_base;
-    return (node->NODE_INFO & CMN650_NODE_INFO_LOGICAL_ID) >>
-        CMN650_NODE_INFO_LOGICAL_ID_POS;
+    return cmn_core_node_logical_id(node_base);
 }
 
 void *get_child_node(uintptr_t base, void *node_base, unsigned int child_index)
 {
-    struct node_header *node = node_base;
-    uint32_t child_pointer;
-    unsigned int offset;
-    void *child_node;
-
-    child_pointer = node->CHILD_POINTER[child_index];
-    offset = child_pointer & CMN650_CHILD_POINTER_OFFSET;
-
-    child_node = (void *)(base + offset);
-    return child_node;
+    return cmn_core_child_node(&cmn650_core_desc, base, node_base, child_index);
 }
 
 unsigned int get_child_node_id(void *node_base, unsigned int child_index)
 {
-    struct node_header *node = node_base;
-    uint32_t node_pointer;
-    unsigned int node_id;
-
-    node_pointer = (node->CHILD_POINTER[child_index] &
-                    CMN650_CHILD_POINTER_EXT_NODE_POINTER) >>
-        CMN650_CHILD_POINTER_EXT_NODE_POINTER_POS;
-
-    /*
-     * For mesh widths using 2 bits each for X,Y encoding:
-     * NodeID[1:0] = DeviceID[3:2]
-     * NodeID[2]   = DeviceID[0]
-     * NodeID[4:3] = NODE POINTER[7:6]
-     * NodeID[6:5] = NODE POINTER[9:8]
-     *
-     * For mesh widths using 3 bits each for X,Y encoding:
-     * NodeID[1:0] = DeviceID[3:2]
-     * NodeID[2]   = DeviceID[0]
-     * NodeID[5:3] = NODE POINTER[8:6]
-     * NodeID[8:6] = NODE POINTER[11:9]
-     */
-    node_id = (((node_pointer >> 6) & 0xff) << 3) |
-        ((node_pointer & 0x1) << 2) | ((node_pointer >> 2) & 0x3);
-
-    return node_id;
+    return cmn_core_child_node_id(&cmn650_core_desc, node_base, child_index);
 }
 
 bool is_child_external(void *node_base, unsigned int child_index)
 {
-    struct node_header *node = node_base;
-    return !!(node->CHILD_POINTER[child_index] & (1U << 31));
+    return cmn_core_child_is_external(node_base, child_index);
 }
 
 bool get_port_number(unsigned int child_node_id)
 {
-    return (child_node_id >> CMN650_NODE_ID_PORT_POS) &
-        CMN650_NODE_ID_PORT_MASK;
+    return cmn_core_node_id_port(&cmn650_core_desc, child_node_id);
 }
 
 unsigned int get_device_type(void *mxp_base, bool port)
@@ -123,19 +99,7 @@ bool is_device_type_rnf(void *mxp_base, uint8_t port)
 
 uint64_t sam_encode_region_size(uint64_t size)
 {
-    uint64_t blocks;
-    uint64_t result;
-
-    /* Size must be a multiple of SAM_GRANULARITY */
-    fwk_assert((size % SAM_GRANULARITY) == 0);
-
-    /* Size also must be a power of two */
-    fwk_assert((size & (size - 1)) == 0);
-
-    blocks = size / SAM_GRANULARITY;
-    result = fwk_math_log2(blocks);
-
-    return result;
+    return cmn_core_sam_encode_region_size(size);
 }
 
 void configure_region(
@@ -147,12 +111,8 @@ void configure_region(
     uint64_t value;
 
     fwk_assert(reg);
-    fwk_assert((base % size) == 0);
 
-    value = CMN650_RNSAM_REGION_ENTRY_VALID;
-    value |= node_type << CMN650_RNSAM_REGION_ENTRY_TYPE_POS;
-    value |= sam_encode_region_size(size) << CMN650_RNSAM_REGION_ENTRY_SIZE_POS;
-    value |= (base / SAM_GRANULARITY) << CMN650_RNSAM_REGION_ENTRY_BASE_POS;
+    value = cmn_core_sam_region_entry(&cmn650_core_desc, base, size, node_type);
 
     *reg = value;
 }
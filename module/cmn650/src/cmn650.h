@@ -11,6 +11,8 @@
 #ifndef CMN650_H
 #define CMN650_H
 
+#include <cmn_core.h>
+
 #include <fwk_macros.h>
 
 #include <stdbool.h>
@@ -354,6 +356,9 @@ struct cmn650_mxp_reg {
 #define CMN650_ROOT_NODE_OFFSET_PORT_POS 16
 #define CMN650_ROOT_NODE_OFFSET_Y_POS    22
 
+/* Register fields of this generation, for the shared CMN helpers */
+extern const struct cmn_core_desc cmn650_core_desc;
+
 /*
  * Retrieve the number of child nodes of a given node
  *
@@ -20,6 +20,9 @@
 
 #define MOD_NAME "[CMN650_CCIX] "
 
+/* TODO Add support to enable multiple links */
+#define CCIX_LINK_ID 0
+
 struct mod_cmn650_ccix_ctx {
     /* RAID value common to all function */
     uint8_t raid_value;
@@ -744,156 +747,152 @@ int ccix_setup(
     return status;
 }
 
-int ccix_exchange_protocol_credit(
-    struct cmn650_device_ctx *ctx,
+/* Number of gateways of a CCIX configuration, port aggregation included */
+static unsigned int get_gateway_count(
     const struct mod_cmn650_ccix_config *ccix_config)
 {
-    int linkid;
-    struct cmn650_cxg_ra_reg *cxg_ra_reg;
-    struct cmn650_cxg_ha_reg *cxg_ha_reg;
-    unsigned int cxg_ldid;
-
-    cmn650_ccix_ctx.is_prog_for_port_agg = false;
-
-    do {
-        config = ccix_config;
-        cxg_ldid = get_ldid(cmn650_ccix_ctx.is_prog_for_port_agg);
-        cxg_ra_reg = ctx->cxg_ra_reg_table[cxg_ldid].cxg_ra_reg;
-        cxg_ha_reg = ctx->cxg_ha_reg_table[cxg_ldid].cxg_ha_reg;
-
-        /* TODO Add support to enable multiple links */
-        linkid = 0;
-
-        FWK_LOG_INFO(
-            MOD_NAME "Exchanging protocol credits for link %d...", linkid);
-        /* Exchange protocol credits using link up bit */
-        cxg_ra_reg->LINK_REGS[linkid].CXG_PRTCL_LINK_CTRL |=
-            CXG_LINK_CTRL_UP_MASK;
-        cxg_ha_reg->LINK_REGS[linkid].CXG_PRTCL_LINK_CTRL |=
-            CXG_LINK_CTRL_UP_MASK;
-        FWK_LOG_INFO(
-            MOD_NAME "Exchanging protocol credits for link %d... Done", linkid);
-
-        if (config->port_aggregate &&
-            cmn650_ccix_ctx.is_prog_for_port_agg == false) {
-            cmn650_ccix_ctx.is_prog_for_port_agg = true;
-            FWK_LOG_INFO(MOD_NAME
-                         "Exchange Protocol Credit for Port Aggregation...");
-        } else
-            cmn650_ccix_ctx.is_prog_for_port_agg = false;
-    } while (config->port_aggregate && cmn650_ccix_ctx.is_prog_for_port_agg);
-
-    return FWK_SUCCESS;
+    return ccix_config->port_aggregate ? 2 : 1;
 }
 
-int ccix_enter_system_coherency(
-    struct cmn650_device_ctx *ctx,
-    const struct mod_cmn650_ccix_config *ccix_config)
+static unsigned int get_gateway_ldid(
+    const struct mod_cmn650_ccix_config *ccix_config,
+    unsigned int gateway)
 {
-    struct cxg_wait_condition_data wait_data;
-    int status;
-    int linkid;
-    struct cmn650_cxg_ha_reg *cxg_ha_reg;
-    unsigned int cxg_ldid;
-
-    cmn650_ccix_ctx.is_prog_for_port_agg = false;
-
-    do {
-        config = ccix_config;
-        cxg_ldid = get_ldid(cmn650_ccix_ctx.is_prog_for_port_agg);
-        cxg_ha_reg = ctx->cxg_ha_reg_table[cxg_ldid].cxg_ha_reg;
-
-        /* TODO Add support to enable multiple links */
-        linkid = 0;
+    return (gateway == 0) ? ccix_config->ldid :
+                            ccix_config->port_aggregate_ldid;
+}
 
-        wait_data.ctx = ctx;
-        wait_data.linkid = linkid;
+/* Wait condition met once it is met by the gateways of all configurations */
+static bool cxg_gateways_wait_condition(void *data)
+{
+    struct cxg_gateways_wait_condition_data *wait_data = data;
+    struct cmn650_device_ctx *ctx = wait_data->ctx;
+    const struct mod_cmn650_ccix_config *ccix_config;
+    unsigned int idx, gateway, cxg_ldid;
+    uint64_t val;
+
+    for (idx = 0; idx < wait_data->ccix_table_count; idx++) {
+        ccix_config = &wait_data->ccix_config_table[idx];
+
+        for (gateway = 0; gateway < get_gateway_count(ccix_config);
+             gateway++) {
+            cxg_ldid = get_gateway_ldid(ccix_config, gateway);
+
+            switch (wait_data->cond) {
+            case CXG_LINK_STATUS_HA_DVMDOMAIN_ACK_BIT_SET:
+                val = ctx->cxg_ha_reg_table[cxg_ldid]
+                          .cxg_ha_reg->LINK_REGS[CCIX_LINK_ID]
+                          .CXG_PRTCL_LINK_STATUS;
+                break;
+
+            case CXG_LINK_STATUS_RA_DVMDOMAIN_ACK_BIT_SET:
+                val = ctx->cxg_ra_reg_table[cxg_ldid]
+                          .cxg_ra_reg->LINK_REGS[CCIX_LINK_ID]
+                          .CXG_PRTCL_LINK_STATUS;
+                break;
+
+            default:
+                fwk_unexpected();
+                return false;
+            }
 
-        FWK_LOG_INFO(
-            MOD_NAME "Entering system coherency for link %d...", linkid);
-        /* Enter system coherency by setting DVMDOMAIN request bit */
-        cxg_ha_reg->LINK_REGS[linkid].CXG_PRTCL_LINK_CTRL |=
-            CXG_LINK_CTRL_DVMDOMAIN_REQ_MASK;
-
-        /* Wait till DVMDOMAIN ACK bit is set in status register */
-        wait_data.cond = CXG_LINK_STATUS_HA_DVMDOMAIN_ACK_BIT_SET;
-        status = ctx->timer_api->wait(
-            FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-            CXG_PRTCL_LINK_DVMDOMAIN_TIMEOUT,
-            cxg_link_wait_condition,
-            &wait_data);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_ERR(
-                MOD_NAME "Entering system coherency for link %d... Failed",
-                linkid);
-            return status;
+            if ((val & CXG_LINK_STATUS_DVMDOMAIN_ACK_MASK) == 0)
+                return false;
         }
-        FWK_LOG_INFO(
-            MOD_NAME "Entering system coherency for link %d... Done", linkid);
-
-        if (config->port_aggregate &&
-            cmn650_ccix_ctx.is_prog_for_port_agg == false) {
-            cmn650_ccix_ctx.is_prog_for_port_agg = true;
-            FWK_LOG_INFO(MOD_NAME
-                         "Enter system coherency for Port Aggregation...");
-        } else
-            cmn650_ccix_ctx.is_prog_for_port_agg = false;
-    } while (config->port_aggregate && cmn650_ccix_ctx.is_prog_for_port_agg);
+    }
 
-    return FWK_SUCCESS;
+    return true;
 }
 
-int ccix_enter_dvm_domain(
+int ccix_enter_smp_mode(
     struct cmn650_device_ctx *ctx,
-    const struct mod_cmn650_ccix_config *ccix_config)
+    const struct mod_cmn650_ccix_config *ccix_config_table,
+    unsigned int ccix_table_count)
 {
-    struct cxg_wait_condition_data wait_data;
+    struct cxg_gateways_wait_condition_data wait_data;
+    const struct mod_cmn650_ccix_config *ccix_config;
+    unsigned int idx, gateway, cxg_ldid;
     int status;
-    int linkid;
-    struct cmn650_cxg_ra_reg *cxg_ra_reg;
-    unsigned int cxg_ldid;
 
-    cmn650_ccix_ctx.is_prog_for_port_agg = false;
+    wait_data.ctx = ctx;
+    wait_data.ccix_config_table = ccix_config_table;
+    wait_data.ccix_table_count = ccix_table_count;
+
+    /*
+     * Each step is started on the links of all the gateways before waiting
+     * for any of them, so that the links come up in parallel.
+     */
+    FWK_LOG_INFO(MOD_NAME "Exchanging protocol credits...");
+    for (idx = 0; idx < ccix_table_count; idx++) {
+        ccix_config = &ccix_config_table[idx];
+        for (gateway = 0; gateway < get_gateway_count(ccix_config);
+             gateway++) {
+            cxg_ldid = get_gateway_ldid(ccix_config, gateway);
+
+            /* Exchange protocol credits using link up bit */
+            ctx->cxg_ra_reg_table[cxg_ldid]
+                .cxg_ra_reg->LINK_REGS[CCIX_LINK_ID]
+                .CXG_PRTCL_LINK_CTRL |= CXG_LINK_CTRL_UP_MASK;
+            ctx->cxg_ha_reg_table[cxg_ldid]
+                .cxg_ha_reg->LINK_REGS[CCIX_LINK_ID]
+                .CXG_PRTCL_LINK_CTRL |= CXG_LINK_CTRL_UP_MASK;
+        }
+    }
+    FWK_LOG_INFO(MOD_NAME "Exchanging protocol credits... Done");
+
+    FWK_LOG_INFO(MOD_NAME "Entering system coherency...");
+    for (idx = 0; idx < ccix_table_count; idx++) {
+        ccix_config = &ccix_config_table[idx];
+        for (gateway = 0; gateway < get_gateway_count(ccix_config);
+             gateway++) {
+            cxg_ldid = get_gateway_ldid(ccix_config, gateway);
+
+            /* Enter system coherency by setting DVMDOMAIN request bit */
+            ctx->cxg_ha_reg_table[cxg_ldid]
+                .cxg_ha_reg->LINK_REGS[CCIX_LINK_ID]
+                .CXG_PRTCL_LINK_CTRL |= CXG_LINK_CTRL_DVMDOMAIN_REQ_MASK;
+        }
+    }
 
-    do {
-        config = ccix_config;
-        cxg_ldid = get_ldid(cmn650_ccix_ctx.is_prog_for_port_agg);
-        cxg_ra_reg = ctx->cxg_ra_reg_table[cxg_ldid].cxg_ra_reg;
-
-        /* TODO Add support to enable multiple links */
-        linkid = 0;
-
-        wait_data.ctx = ctx;
-        wait_data.linkid = linkid;
-
-        FWK_LOG_INFO(MOD_NAME "Entering DVM domain for link %d...", linkid);
-        /* DVM domain entry by setting DVMDOMAIN request bit */
-        cxg_ra_reg->LINK_REGS[linkid].CXG_PRTCL_LINK_CTRL |=
-            CXG_LINK_CTRL_DVMDOMAIN_REQ_MASK;
-
-        /* Wait till DVMDOMAIN ACK bit is set in status register */
-        wait_data.cond = CXG_LINK_STATUS_RA_DVMDOMAIN_ACK_BIT_SET;
-        status = ctx->timer_api->wait(
-            FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-            CXG_PRTCL_LINK_DVMDOMAIN_TIMEOUT,
-            cxg_link_wait_condition,
-            &wait_data);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_ERR(
-                MOD_NAME "Entering DVM domain for link %d... Failed", linkid);
-            return status;
+    /* Wait till DVMDOMAIN ACK bit is set in all the status registers */
+    wait_data.cond = CXG_LINK_STATUS_HA_DVMDOMAIN_ACK_BIT_SET;
+    status = ctx->timer_api->wait(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
+        CXG_PRTCL_LINK_DVMDOMAIN_TIMEOUT,
+        cxg_gateways_wait_condition,
+        &wait_data);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_ERR(MOD_NAME "Entering system coherency... Failed");
+        return status;
+    }
+    FWK_LOG_INFO(MOD_NAME "Entering system coherency... Done");
+
+    FWK_LOG_INFO(MOD_NAME "Entering DVM domain...");
+    for (idx = 0; idx < ccix_table_count; idx++) {
+        ccix_config = &ccix_config_table[idx];
+        for (gateway = 0; gateway < get_gateway_count(ccix_config);
+             gateway++) {
+            cxg_ldid = get_gateway_ldid(ccix_config, gateway);
+
+            /* DVM domain entry by setting DVMDOMAIN request bit */
+            ctx->cxg_ra_reg_table[cxg_ldid]
+                .cxg_ra_reg->LINK_REGS[CCIX_LINK_ID]
+                .CXG_PRTCL_LINK_CTRL |= CXG_LINK_CTRL_DVMDOMAIN_REQ_MASK;
         }
-        FWK_LOG_INFO(
-            MOD_NAME "Entering DVM domain for link %d... Done", linkid);
+    }
 
-        if (config->port_aggregate &&
-            cmn650_ccix_ctx.is_prog_for_port_agg == false) {
-            cmn650_ccix_ctx.is_prog_for_port_agg = true;
-            FWK_LOG_INFO(MOD_NAME
-                         "Entering DVM domain for Port Aggregation...");
-        } else
-            cmn650_ccix_ctx.is_prog_for_port_agg = false;
-    } while (config->port_aggregate && cmn650_ccix_ctx.is_prog_for_port_agg);
+    /* Wait till DVMDOMAIN ACK bit is set in all the status registers */
+    wait_data.cond = CXG_LINK_STATUS_RA_DVMDOMAIN_ACK_BIT_SET;
+    status = ctx->timer_api->wait(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
+        CXG_PRTCL_LINK_DVMDOMAIN_TIMEOUT,
+        cxg_gateways_wait_condition,
+        &wait_data);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_ERR(MOD_NAME "Entering DVM domain... Failed");
+        return status;
+    }
+    FWK_LOG_INFO(MOD_NAME "Entering DVM domain... Done");
 
     return FWK_SUCCESS;
 }
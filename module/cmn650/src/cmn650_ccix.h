@@ -20,17 +20,10 @@ int ccix_setup(
     struct cmn650_device_ctx *ctx,
     const struct mod_cmn650_ccix_config *ccix_config);
 
-int ccix_exchange_protocol_credit(
+int ccix_enter_smp_mode(
     struct cmn650_device_ctx *ctx,
-    const struct mod_cmn650_ccix_config *ccix_config);
-
-int ccix_enter_system_coherency(
-    struct cmn650_device_ctx *ctx,
-    const struct mod_cmn650_ccix_config *ccix_config);
-
-int ccix_enter_dvm_domain(
-    struct cmn650_device_ctx *ctx,
-    const struct mod_cmn650_ccix_config *ccix_config);
+    const struct mod_cmn650_ccix_config *ccix_config_table,
+    unsigned int ccix_table_count);
 
 /*
  * CCIX Link UP stages
@@ -56,6 +49,17 @@ struct cxg_wait_condition_data {
     enum cxg_link_up_wait_cond cond;
 };
 
+/*
+ * Structure defining data to be passed to timer API when waiting for the
+ * gateways of several CCIX configurations together
+ */
+struct cxg_gateways_wait_condition_data {
+    struct cmn650_device_ctx *ctx;
+    const struct mod_cmn650_ccix_config *ccix_config_table;
+    unsigned int ccix_table_count;
+    enum cxg_link_up_wait_cond cond;
+};
+
 /* CCIX Gateway (CXG) Home Agent (HA) defines */
 #define CXG_HA_RAID_TO_LDID_RNF_MASK (0x80)
 
@@ -67,11 +67,8 @@ static void process_node_hnf(struct cmn650_hnf_reg *hnf)
 
     fwk_assert(logical_id < config->snf_count);
 
-    group = logical_id /
-        (CMN650_HNF_CACHE_GROUP_ENTRIES_PER_GROUP * cal_mode_factor);
-    bit_pos = (CMN650_HNF_CACHE_GROUP_ENTRY_BITS_WIDTH / cal_mode_factor) *
-        ((logical_id %
-          (CMN650_HNF_CACHE_GROUP_ENTRIES_PER_GROUP * cal_mode_factor)));
+    cmn_core_hnf_cache_group_locate(
+        &cmn650_core_desc, logical_id, cal_mode_factor, &group, &bit_pos);
 
     /*
      * If CAL mode is set, add only even numbered hnd node to
@@ -775,12 +772,8 @@ static int cmn650_ccix_setup(void)
      * Exchange protocol credits and enter system coherecy and dvm domain for
      * multichip SMP mode operation.
      */
-    for (idx = 0; idx < config->ccix_table_count; idx++) {
-        ccix_exchange_protocol_credit(ctx, &config->ccix_config_table[idx]);
-        ccix_enter_system_coherency(ctx, &config->ccix_config_table[idx]);
-        ccix_enter_dvm_domain(ctx, &config->ccix_config_table[idx]);
-    }
-    return FWK_SUCCESS;
+    return ccix_enter_smp_mode(
+        ctx, config->ccix_config_table, config->ccix_table_count);
 }
 
 static int cmn650_setup_rnsam(unsigned int node_id)
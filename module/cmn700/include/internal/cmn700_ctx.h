@@ -29,6 +29,12 @@ struct cmn700_device_ctx {
     /* Pointer to list of HN-F nodes for use in CCIX programming */
     uintptr_t *hnf_node;
 
+    /* Cross points of the HN-F nodes, for the PMU */
+    uintptr_t *hnf_xp;
+
+    /* Debug/trace controller, for the PMU */
+    void *dtc_reg;
+
     uint64_t *hnf_cache_group;
     uint64_t *sn_nodeid_group;
 
@@ -52,6 +58,19 @@ struct cmn700_device_ctx {
     unsigned int rnf_count;
     unsigned int rni_count;
 
+    /* RN-I and RN-D nodes, for the QoS regulation */
+    struct cmn700_rnid_reg **rnid_node;
+    unsigned int rnid_entry_count;
+
+    /*
+     * Image of the programmed RN-SAM registers, taken from the first RN-SAM
+     * programmed and reused for the others and for the later setups
+     */
+    uint64_t *sam_image;
+
+    /* RN-SAM unit information the image is valid for */
+    uint64_t sam_image_unit_info;
+
     /* Timer module API */
     struct mod_timer_api *timer_api;
 
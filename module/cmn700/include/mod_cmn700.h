@@ -28,6 +28,20 @@
  * @{
  */
 
+/*!
+ * \brief Module API indices
+ */
+enum mod_cmn700_api_idx {
+    /*! Index of the mesh topology API, see ::cmn_core_topology_api */
+    MOD_CMN700_API_IDX_TOPOLOGY,
+
+    /*! Index of the QoS API, see ::mod_cmn700_qos_api */
+    MOD_CMN700_API_IDX_QOS,
+
+    /*! Number of APIs */
+    MOD_CMN700_API_COUNT
+};
+
 /*!
  * \brief Memory region configuration type
  */
@@ -72,6 +86,102 @@ struct mod_cmn700_mem_region_map {
     unsigned int node_id;
 };
 
+/*!
+ * \brief Highest QoS value of a request
+ */
+#define MOD_CMN700_QOS_VALUE_MAX 0xF
+
+/*!
+ * \brief Highest latency target in cycles
+ */
+#define MOD_CMN700_QOS_LATENCY_TARGET_MAX 0xFFF
+
+/*!
+ * \brief QoS regulation of a port of an RN-I or RN-D node
+ *
+ * \details The QoS value of the requests of the port is either overridden by
+ *      a fixed value, or regulated between a minimum and a maximum so that
+ *      their average latency meets a target, or left as sent by the
+ *      requester when neither is enabled.
+ */
+struct mod_cmn700_qos_params {
+    /*! Override the QoS value of the requests with ::qos_override */
+    bool override_enabled;
+
+    /*! QoS value of the requests when overridden */
+    uint8_t qos_override;
+
+    /*!
+     * \brief Latency target in cycles, or 0 to disable the latency
+     *      regulation
+     */
+    uint16_t latency_target;
+
+    /*! Scale factor of the regulation, from 0 (2^-5) to 7 (2^-12) */
+    uint8_t latency_scale;
+
+    /*! Lowest QoS value given by the regulation */
+    uint8_t qos_min;
+
+    /*! Highest QoS value given by the regulation */
+    uint8_t qos_max;
+};
+
+/*!
+ * \brief QoS configuration of a requester port
+ */
+struct mod_cmn700_qos_config {
+    /*! Node identifier of the RN-I or RN-D node */
+    unsigned int node_id;
+
+    /*! Index of the AXI/ACE-Lite port of the node, from 0 to 2 */
+    unsigned int port;
+
+    /*! QoS regulation of the port */
+    struct mod_cmn700_qos_params params;
+};
+
+/*!
+ * \brief QoS API
+ *
+ * \details Adjusts the QoS regulation of the RN-I and RN-D ports at runtime,
+ *      e.g. from the bandwidth measured through the CMN PMU or on request of
+ *      an agent.
+ */
+struct mod_cmn700_qos_api {
+    /*!
+     * \brief Get the QoS regulation of a requester port
+     *
+     * \param node_id Node identifier of the RN-I or RN-D node.
+     * \param port Index of the port of the node.
+     * \param[out] params QoS regulation of the port.
+     *
+     * \retval ::FWK_SUCCESS The regulation was returned.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_STATE The mesh has not been discovered yet.
+     */
+    int (*get_qos)(
+        unsigned int node_id,
+        unsigned int port,
+        struct mod_cmn700_qos_params *params);
+
+    /*!
+     * \brief Set the QoS regulation of a requester port
+     *
+     * \param node_id Node identifier of the RN-I or RN-D node.
+     * \param port Index of the port of the node.
+     * \param params QoS regulation of the port.
+     *
+     * \retval ::FWK_SUCCESS The regulation was set.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_STATE The mesh has not been discovered yet.
+     */
+    int (*set_qos)(
+        unsigned int node_id,
+        unsigned int port,
+        const struct mod_cmn700_qos_params *params);
+};
+
 /*!
  * \brief CMN700 configuration data
  */
@@ -119,6 +229,17 @@ struct mod_cmn700_config {
      * a CAL port, node id of HN-F will be a odd number).
      */
     bool hnf_cal_mode;
+
+    /*!
+     * \brief Table of the QoS configurations of the requester ports, applied
+     *      when the mesh is set up
+     *
+     * \details The ports not in the table keep their reset configuration.
+     */
+    const struct mod_cmn700_qos_config *qos_table;
+
+    /*! Number of entries in the \ref qos_table */
+    size_t qos_count;
 };
 
 /*!
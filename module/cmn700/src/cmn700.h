@@ -11,6 +11,8 @@
 #ifndef CMN700_H
 #define CMN700_H
 
+#include <cmn_core.h>
+
 #include <fwk_macros.h>
 
 #include <stdbool.h>
@@ -147,6 +149,24 @@ struct cmn700_hnf_reg {
         HNF_RN_CLUSTER_PHYSID[HNF_RN_CLUSTER_MAX][HNF_RN_PHYIDS_REG_MAX];
 };
 
+#define CMN700_RNID_PORT_COUNT 3
+
+/*
+ * I/O coherent Request Node (RN-I) and RN-I with DVM support (RN-D) registers
+ */
+struct cmn700_rnid_reg {
+    FWK_R   uint64_t  NODE_INFO;
+            uint8_t   RESERVED0[0x80 - 0x8];
+    FWK_R   uint64_t  CHILD_INFO;
+            uint8_t   RESERVED1[0xA80 - 0x88];
+    struct {
+        FWK_RW  uint64_t  CONTROL;
+        FWK_RW  uint64_t  LAT_TGT;
+        FWK_RW  uint64_t  LAT_SCALE;
+        FWK_RW  uint64_t  LAT_RANGE;
+    } S_QOS[CMN700_RNID_PORT_COUNT];
+};
+
 /*
  * Configuration slave registers
  */
@@ -221,6 +241,15 @@ struct cmn700_mxp_reg {
 #define CMN700_HNF_CACHE_GROUP_ENTRIES_PER_GROUP 4
 #define CMN700_HNF_CACHE_GROUP_ENTRY_BITS_WIDTH  12
 
+#define CMN700_RNID_QOS_CONTROL_LAT_EN            UINT64_C(0x01)
+#define CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_EN   UINT64_C(0x04)
+#define CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_MASK UINT64_C(0xF0000)
+#define CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_POS  16
+#define CMN700_RNID_QOS_LAT_TGT_MASK              UINT64_C(0xFFF)
+#define CMN700_RNID_QOS_LAT_SCALE_MASK            UINT64_C(0x7)
+#define CMN700_RNID_QOS_LAT_RANGE_MIN_POS         0
+#define CMN700_RNID_QOS_LAT_RANGE_MAX_POS         8
+
 #define CMN700_PPU_PWPR_POLICY_OFF      UINT64_C(0x0000000000000000)
 #define CMN700_PPU_PWPR_POLICY_MEM_RET  UINT64_C(0x0000000000000002)
 #define CMN700_PPU_PWPR_POLICY_FUNC_RET UINT64_C(0x0000000000000007)
@@ -238,6 +267,7 @@ struct cmn700_mxp_reg {
 #define CMN700_NODE_ID_PORT_POS  2
 #define CMN700_NODE_ID_PORT_MASK 0x1
 #define CMN700_NODE_ID_Y_POS     3
+#define CMN700_NODE_ID_DEVICE_MASK 0x3
 
 #define CMN700_MXP_NODE_INFO_NUM_DEVICE_PORT_MASK UINT64_C(0xF000000000000)
 #define CMN700_MXP_NODE_INFO_NUM_DEVICE_PORT_POS  48
@@ -249,6 +279,12 @@ struct cmn700_mxp_reg {
 #define CMN700_ROOT_NODE_OFFSET_PORT_POS 16
 #define CMN700_ROOT_NODE_OFFSET_Y_POS    22
 
+/* Offset of the DTM registers in a cross point */
+#define CMN700_DTM_OFFSET 0x2000
+
+/* Register fields of this generation, for the shared CMN helpers */
+extern const struct cmn_core_desc cmn700_core_desc;
+
 /*
  * Retrieve the number of device ports connected to the cross point
  *
@@ -18,6 +18,7 @@
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
@@ -25,6 +26,7 @@
 #include <fwk_status.h>
 
 #include <inttypes.h>
+#include <stddef.h>
 
 #define MOD_NAME "[CMN700] "
 
@@ -71,11 +73,8 @@ static void process_node_hnf(struct cmn700_hnf_reg *hnf)
 
     fwk_assert(logical_id < config->snf_count);
 
-    group = logical_id /
-        (CMN700_HNF_CACHE_GROUP_ENTRIES_PER_GROUP * cal_mode_factor);
-    bit_pos = (CMN700_HNF_CACHE_GROUP_ENTRY_BITS_WIDTH / cal_mode_factor) *
-        ((logical_id %
-          (CMN700_HNF_CACHE_GROUP_ENTRIES_PER_GROUP * cal_mode_factor)));
+    cmn_core_hnf_cache_group_locate(
+        &cmn700_core_desc, logical_id, cal_mode_factor, &group, &bit_pos);
 
     /*
      * If CAL mode is set, add only even numbered hnd node to
@@ -352,6 +351,7 @@ static void cmn700_configure(void)
     hnf_entry = 0;
     irnsam_entry = 0;
     xrnsam_entry = 0;
+    ctx->rnid_entry_count = 0;
 
     /* Traverse cross points (XP) */
     xp_count = get_node_child_count(ctx->root);
@@ -389,9 +389,21 @@ static void cmn700_configure(void)
                     irnsam_entry++;
                 } else if (node_type == NODE_TYPE_HN_F) {
                     fwk_assert(hnf_entry < ctx->hnf_count);
+                    ctx->hnf_xp[hnf_entry] = (uintptr_t)(void *)xp;
                     ctx->hnf_node[hnf_entry++] = (uintptr_t)(void *)node;
 
                     process_node_hnf(node);
+                } else if (
+                    (node_type == NODE_TYPE_RN_I) ||
+                    (node_type == NODE_TYPE_RN_D)) {
+                    fwk_assert(
+                        ctx->rnid_entry_count <
+                        (ctx->rni_count + ctx->rnd_count));
+                    ctx->rnid_node[ctx->rnid_entry_count++] = node;
+                } else if (
+                    (node_type == NODE_TYPE_DTC) && (ctx->dtc_reg == NULL)) {
+                    /* The first DTC is the one of the main domain */
+                    ctx->dtc_reg = node;
                 }
             }
         }
@@ -552,6 +564,253 @@ static int cmn700_setup_sam(struct cmn700_rnsam_reg *rnsam)
     return FWK_SUCCESS;
 }
 
+/* Registers of the RN-SAM image, see cmn700_program_sam() */
+#define SAM_IMAGE_ENTRY(reg) \
+    { \
+        offsetof(struct cmn700_rnsam_reg, reg), \
+            sizeof(((struct cmn700_rnsam_reg *)0)->reg) / sizeof(uint64_t) \
+    }
+
+static const struct {
+    size_t offset;
+    unsigned int count;
+} sam_image_layout[] = {
+    SAM_IMAGE_ENTRY(NON_HASH_MEM_REGION),
+    SAM_IMAGE_ENTRY(NON_HASH_MEM_REGION_CFG2),
+    SAM_IMAGE_ENTRY(NON_HASH_TGT_NODEID),
+    SAM_IMAGE_ENTRY(SYS_CACHE_GRP_REGION),
+    SAM_IMAGE_ENTRY(SYS_CACHE_GRP_HN_COUNT),
+    SAM_IMAGE_ENTRY(SYS_CACHE_GRP_HN_NODEID),
+    SAM_IMAGE_ENTRY(SYS_CACHE_GRP_SN_NODEID),
+    SAM_IMAGE_ENTRY(SYS_CACHE_GRP_CAL_MODE),
+    SAM_IMAGE_ENTRY(HASHED_TGT_GRP_CFG2_REGION),
+};
+
+static unsigned int sam_image_size(void)
+{
+    unsigned int idx;
+    unsigned int size = 0;
+
+    for (idx = 0; idx < FWK_ARRAY_SIZE(sam_image_layout); idx++)
+        size += sam_image_layout[idx].count;
+
+    return size;
+}
+
+static void cmn700_save_sam_image(struct cmn700_rnsam_reg *rnsam)
+{
+    unsigned int idx;
+    unsigned int entry;
+    volatile uint64_t *reg;
+    uint64_t *image;
+
+    if (ctx->sam_image == NULL)
+        ctx->sam_image = fwk_mm_calloc(sam_image_size(), sizeof(uint64_t));
+
+    image = ctx->sam_image;
+    for (idx = 0; idx < FWK_ARRAY_SIZE(sam_image_layout); idx++) {
+        reg = (volatile uint64_t *)((uintptr_t)rnsam +
+                                    sam_image_layout[idx].offset);
+        for (entry = 0; entry < sam_image_layout[idx].count; entry++)
+            *image++ = reg[entry];
+    }
+
+    ctx->sam_image_unit_info = rnsam->UNIT_INFO[0];
+}
+
+/*
+ * Program an RN-SAM from the image, writing only the registers which differ
+ * from it. Returns the number of registers written.
+ */
+static unsigned int cmn700_apply_sam_image(struct cmn700_rnsam_reg *rnsam)
+{
+    unsigned int idx;
+    unsigned int entry;
+    unsigned int written = 0;
+    volatile uint64_t *reg;
+    const uint64_t *image = ctx->sam_image;
+
+    for (idx = 0; idx < FWK_ARRAY_SIZE(sam_image_layout); idx++) {
+        reg = (volatile uint64_t *)((uintptr_t)rnsam +
+                                    sam_image_layout[idx].offset);
+        for (entry = 0; entry < sam_image_layout[idx].count; entry++) {
+            if (reg[entry] != *image) {
+                reg[entry] = *image;
+                written++;
+
+                if (reg[entry] != *image) {
+                    FWK_LOG_ERR(
+                        MOD_NAME "SAM of node %d: mismatch at 0x%x",
+                        get_node_id(rnsam),
+                        (unsigned int)(sam_image_layout[idx].offset +
+                                       (entry * sizeof(uint64_t))));
+                }
+            }
+            image++;
+        }
+    }
+
+    return written;
+}
+
+/*
+ * The first RN-SAM is programmed from the memory map, and its registers then
+ * serve as the image of all the RN-SAMs of the same kind, so that the others
+ * and the later setups only rewrite the registers that differ.
+ */
+static int cmn700_program_sam(struct cmn700_rnsam_reg *rnsam)
+{
+    int status;
+    unsigned int written;
+
+    if ((ctx->sam_image == NULL) ||
+        (rnsam->UNIT_INFO[0] != ctx->sam_image_unit_info)) {
+        status = cmn700_setup_sam(rnsam);
+        if ((status == FWK_SUCCESS) && (ctx->sam_image == NULL))
+            cmn700_save_sam_image(rnsam);
+
+        return status;
+    }
+
+    written = cmn700_apply_sam_image(rnsam);
+    FWK_LOG_INFO(
+        MOD_NAME "SAM for node %d: %u registers updated",
+        get_node_id(rnsam),
+        written);
+
+    /* Enable RNSAM */
+    rnsam->STATUS = ((uint64_t)ctx->config->hnd_node_id
+                     << CMN700_RNSAM_STATUS_DEFAULT_NODEID_POS) |
+        CMN700_RNSAM_STATUS_UNSTALL;
+    __sync_synchronize();
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * QoS regulation of the RN-I and RN-D ports
+ */
+
+static struct cmn700_rnid_reg *cmn700_find_rnid(unsigned int node_id)
+{
+    unsigned int i;
+
+    for (i = 0; i < ctx->rnid_entry_count; i++) {
+        if (get_node_id(ctx->rnid_node[i]) == node_id)
+            return ctx->rnid_node[i];
+    }
+
+    return NULL;
+}
+
+static int cmn700_qos_get(
+    unsigned int node_id,
+    unsigned int port,
+    struct mod_cmn700_qos_params *params)
+{
+    struct cmn700_rnid_reg *rnid;
+    uint64_t control, range;
+
+    if (!ctx->initialized)
+        return FWK_E_STATE;
+
+    rnid = cmn700_find_rnid(node_id);
+    if ((rnid == NULL) || (port >= CMN700_RNID_PORT_COUNT) ||
+        (params == NULL))
+        return FWK_E_PARAM;
+
+    control = rnid->S_QOS[port].CONTROL;
+    range = rnid->S_QOS[port].LAT_RANGE;
+
+    *params = (struct mod_cmn700_qos_params){
+        .override_enabled =
+            (control & CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_EN) != 0,
+        .qos_override = (uint8_t)(
+            (control & CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_MASK) >>
+            CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_POS),
+        .latency_target = (control & CMN700_RNID_QOS_CONTROL_LAT_EN) ?
+            (uint16_t)(rnid->S_QOS[port].LAT_TGT &
+                       CMN700_RNID_QOS_LAT_TGT_MASK) :
+            0,
+        .latency_scale = (uint8_t)(
+            rnid->S_QOS[port].LAT_SCALE & CMN700_RNID_QOS_LAT_SCALE_MASK),
+        .qos_min = (uint8_t)(
+            (range >> CMN700_RNID_QOS_LAT_RANGE_MIN_POS) &
+            MOD_CMN700_QOS_VALUE_MAX),
+        .qos_max = (uint8_t)(
+            (range >> CMN700_RNID_QOS_LAT_RANGE_MAX_POS) &
+            MOD_CMN700_QOS_VALUE_MAX),
+    };
+
+    return FWK_SUCCESS;
+}
+
+static int cmn700_qos_set(
+    unsigned int node_id,
+    unsigned int port,
+    const struct mod_cmn700_qos_params *params)
+{
+    struct cmn700_rnid_reg *rnid;
+    uint64_t control;
+
+    if (!ctx->initialized)
+        return FWK_E_STATE;
+
+    rnid = cmn700_find_rnid(node_id);
+    if ((rnid == NULL) || (port >= CMN700_RNID_PORT_COUNT) ||
+        (params == NULL))
+        return FWK_E_PARAM;
+
+    if ((params->qos_override > MOD_CMN700_QOS_VALUE_MAX) ||
+        (params->latency_target > MOD_CMN700_QOS_LATENCY_TARGET_MAX) ||
+        (params->latency_scale > CMN700_RNID_QOS_LAT_SCALE_MASK) ||
+        (params->qos_min > params->qos_max) ||
+        (params->qos_max > MOD_CMN700_QOS_VALUE_MAX))
+        return FWK_E_PARAM;
+
+    /* Disable the regulation while its parameters change */
+    control = rnid->S_QOS[port].CONTROL &
+        ~(CMN700_RNID_QOS_CONTROL_LAT_EN |
+          CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_EN |
+          CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_MASK);
+    rnid->S_QOS[port].CONTROL = control;
+
+    rnid->S_QOS[port].LAT_TGT = params->latency_target;
+    rnid->S_QOS[port].LAT_SCALE = params->latency_scale;
+    rnid->S_QOS[port].LAT_RANGE =
+        ((uint64_t)params->qos_min << CMN700_RNID_QOS_LAT_RANGE_MIN_POS) |
+        ((uint64_t)params->qos_max << CMN700_RNID_QOS_LAT_RANGE_MAX_POS);
+
+    control |= (uint64_t)params->qos_override
+        << CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_POS;
+    if (params->override_enabled)
+        control |= CMN700_RNID_QOS_CONTROL_QOS_OVERRIDE_EN;
+    if (params->latency_target != 0)
+        control |= CMN700_RNID_QOS_CONTROL_LAT_EN;
+    rnid->S_QOS[port].CONTROL = control;
+
+    return FWK_SUCCESS;
+}
+
+static void cmn700_setup_qos(void)
+{
+    const struct mod_cmn700_qos_config *qos;
+    unsigned int i;
+    int status;
+
+    for (i = 0; i < ctx->config->qos_count; i++) {
+        qos = &ctx->config->qos_table[i];
+
+        status = cmn700_qos_set(qos->node_id, qos->port, &qos->params);
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_ERR(
+                MOD_NAME "QoS setup failed for node %d port %d",
+                qos->node_id,
+                qos->port);
+        }
+    }
+}
+
 static int cmn700_setup(void)
 {
     unsigned int rnsam_idx;
@@ -578,6 +837,12 @@ static int cmn700_setup(void)
                 ctx->external_rnsam_count, sizeof(*ctx->external_rnsam_table));
         }
 
+        /* RN-I and RN-D nodes */
+        if ((ctx->rni_count + ctx->rnd_count) != 0) {
+            ctx->rnid_node = fwk_mm_calloc(
+                ctx->rni_count + ctx->rnd_count, sizeof(*ctx->rnid_node));
+        }
+
         /* Cache groups */
         if (ctx->hnf_count != 0) {
             /*
@@ -588,6 +853,7 @@ static int cmn700_setup(void)
                 fwk_mm_calloc(ctx->hnf_count, sizeof(*ctx->hnf_node));
             if (ctx->hnf_node == NULL)
                 return FWK_E_NOMEM;
+            ctx->hnf_xp = fwk_mm_calloc(ctx->hnf_count, sizeof(*ctx->hnf_xp));
             ctx->hnf_cache_group = fwk_mm_calloc(
                 cmn700_hnf_cache_group_count(ctx->hnf_count),
                 sizeof(*ctx->hnf_cache_group));
@@ -602,15 +868,77 @@ static int cmn700_setup(void)
 
     /* Setup internal RN-SAM nodes */
     for (rnsam_idx = 0; rnsam_idx < ctx->internal_rnsam_count; rnsam_idx++)
-        cmn700_setup_sam(ctx->internal_rnsam_table[rnsam_idx]);
+        cmn700_program_sam(ctx->internal_rnsam_table[rnsam_idx]);
+
+    ctx->initialized = true;
+
+    cmn700_setup_qos();
 
     FWK_LOG_INFO(MOD_NAME "Done");
 
-    ctx->initialized = true;
+    return FWK_SUCCESS;
+}
+
+/* Mesh topology API */
+
+static int cmn700_topology_get_hnf_count(unsigned int *count)
+{
+    if (!ctx->initialized)
+        return FWK_E_STATE;
+
+    *count = ctx->hnf_count;
 
     return FWK_SUCCESS;
 }
 
+static int cmn700_topology_get_hnf(
+    unsigned int hnf_idx,
+    struct cmn_core_hnf_info *info)
+{
+    unsigned int node_id;
+
+    if (!ctx->initialized)
+        return FWK_E_STATE;
+
+    if (hnf_idx >= ctx->hnf_count)
+        return FWK_E_PARAM;
+
+    node_id = get_node_id((void *)ctx->hnf_node[hnf_idx]);
+
+    *info = (struct cmn_core_hnf_info){
+        .node = ctx->hnf_node[hnf_idx],
+        .dtm = ctx->hnf_xp[hnf_idx] + CMN700_DTM_OFFSET,
+        .dtm_port = get_port_number(node_id),
+        .device = node_id & CMN700_NODE_ID_DEVICE_MASK,
+    };
+
+    return FWK_SUCCESS;
+}
+
+static int cmn700_topology_get_dtc(uintptr_t *dtc)
+{
+    if (!ctx->initialized)
+        return FWK_E_STATE;
+
+    if (ctx->dtc_reg == NULL)
+        return FWK_E_SUPPORT;
+
+    *dtc = (uintptr_t)ctx->dtc_reg;
+
+    return FWK_SUCCESS;
+}
+
+static const struct cmn_core_topology_api cmn700_topology_api = {
+    .get_hnf_count = cmn700_topology_get_hnf_count,
+    .get_hnf = cmn700_topology_get_hnf,
+    .get_dtc = cmn700_topology_get_dtc,
+};
+
+static const struct mod_cmn700_qos_api cmn700_qos_api = {
+    .get_qos = cmn700_qos_get,
+    .set_qos = cmn700_qos_set,
+};
+
 /*
  * Framework handlers
  */
@@ -695,6 +1023,28 @@ static int cmn700_bind(fwk_id_t id, unsigned int round)
     return FWK_SUCCESS;
 }
 
+static int cmn700_process_bind_request(
+    fwk_id_t requester_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    switch (fwk_id_get_api_idx(api_id)) {
+    case MOD_CMN700_API_IDX_TOPOLOGY:
+        *api = &cmn700_topology_api;
+        break;
+
+    case MOD_CMN700_API_IDX_QOS:
+        *api = &cmn700_qos_api;
+        break;
+
+    default:
+        return FWK_E_PARAM;
+    }
+
+    return FWK_SUCCESS;
+}
+
 int cmn700_start(fwk_id_t id)
 {
     int status;
@@ -752,9 +1102,11 @@ static int cmn700_process_notification(
 const struct fwk_module module_cmn700 = {
     .name = "CMN700",
     .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = MOD_CMN700_API_COUNT,
     .init = cmn700_init,
     .element_init = cmn700_device_init,
     .bind = cmn700_bind,
+    .process_bind_request = cmn700_process_bind_request,
     .start = cmn700_start,
     .process_notification = cmn700_process_notification,
 };
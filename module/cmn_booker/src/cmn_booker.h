@@ -11,6 +11,8 @@
 #ifndef CMN_BOOKER_H
 #define CMN_BOOKER_H
 
+#include <cmn_core.h>
+
 #include <fwk_macros.h>
 
 #include <stdbool.h>
@@ -245,6 +247,9 @@ struct cmn_booker_hni_reg {
 #define CMN_BOOKER_ROOT_NODE_OFFSET_PORT_POS 16
 #define CMN_BOOKER_ROOT_NODE_OFFSET_Y_POS 22
 
+/* Register fields of this generation, for the shared CMN helpers */
+extern const struct cmn_core_desc cmn_booker_core_desc;
+
 /*
  * Retrieve the number of child nodes of a given node
  *
@@ -55,12 +55,8 @@ static void process_node_hnf(struct cmn_booker_hnf_reg *hnf)
 
     fwk_assert(logical_id < config->snf_count);
 
-    group = logical_id /
-            (CMN_BOOKER_HNF_CACHE_GROUP_ENTRIES_PER_GROUP * cal_mode_factor);
-    bit_pos = (CMN_BOOKER_HNF_CACHE_GROUP_ENTRY_BITS_WIDTH / cal_mode_factor) *
-              ((logical_id %
-                (CMN_BOOKER_HNF_CACHE_GROUP_ENTRIES_PER_GROUP *
-                 cal_mode_factor)));
+    cmn_core_hnf_cache_group_locate(
+        &cmn_booker_core_desc, logical_id, cal_mode_factor, &group, &bit_pos);
 
     /*
      * If CAL mode is set, add only even numbered hnd node to
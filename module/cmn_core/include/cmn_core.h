@@ -0,0 +1,384 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Register layout and helpers shared by the CMN interconnect drivers.
+ */
+
+#ifndef CMN_CORE_H
+#define CMN_CORE_H
+
+#include <fwk_assert.h>
+#include <fwk_macros.h>
+#include <fwk_math.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupCMNCore CMN Core
+ *
+ * \details Helpers common to every CMN generation (CMN600, CMN650, CMN700 and
+ *      CMN-Booker). The node header and the fields that do not move between
+ *      generations are accessed directly, while the fields that do are
+ *      described by a per-generation ::cmn_core_desc table.
+ *
+ *      All the helpers are inlined so that, given a constant descriptor, they
+ *      compile down to the same code as the generation-specific accessors.
+ *
+ * \{
+ */
+
+/*! Granularity of the system address map regions */
+#define CMN_CORE_SAM_GRANULARITY (64 * FWK_MIB)
+
+/*! Node information fields, common to all the node types */
+#define CMN_CORE_NODE_INFO_TYPE UINT64_C(0x000000000000FFFF)
+#define CMN_CORE_NODE_INFO_ID UINT64_C(0x00000000FFFF0000)
+#define CMN_CORE_NODE_INFO_ID_POS 16
+#define CMN_CORE_NODE_INFO_LOGICAL_ID UINT64_C(0x0000FFFF00000000)
+#define CMN_CORE_NODE_INFO_LOGICAL_ID_POS 32
+
+/*! Child information fields */
+#define CMN_CORE_CHILD_INFO_COUNT UINT64_C(0x000000000000FFFF)
+
+/*! Child pointer external flag */
+#define CMN_CORE_CHILD_POINTER_EXT UINT64_C(0x0000000080000000)
+
+/*!
+ * \brief Node header, at the base of every node of the mesh.
+ */
+struct cmn_core_node_header {
+    FWK_R uint64_t NODE_INFO;
+          uint8_t  RESERVED0[0x80 - 0x8];
+    FWK_R uint64_t CHILD_INFO;
+          uint8_t  RESERVED1[0x100 - 0x88];
+    FWK_R uint64_t CHILD_POINTER[256];
+};
+
+/*!
+ * \brief Register fields that differ between CMN generations.
+ */
+struct cmn_core_desc {
+    /*! Mask of the node offset in a child pointer */
+    uint64_t child_pointer_offset_mask;
+
+    /*! Mask of the external node pointer in a child pointer */
+    uint64_t child_pointer_ext_node_pointer_mask;
+
+    /*! Position of the external node pointer in a child pointer */
+    unsigned int child_pointer_ext_node_pointer_pos;
+
+    /*! Position of the device port in a node identifier */
+    unsigned int node_id_port_pos;
+
+    /*! Mask of the device port in a node identifier, once shifted */
+    unsigned int node_id_port_mask;
+
+    /*! Position of the node type in an RN-SAM region entry */
+    unsigned int rnsam_region_entry_type_pos;
+
+    /*! Position of the encoded size in an RN-SAM region entry */
+    unsigned int rnsam_region_entry_size_pos;
+
+    /*! Position of the base address in an RN-SAM region entry */
+    unsigned int rnsam_region_entry_base_pos;
+
+    /*! Number of HN-F node identifiers per system cache group register */
+    unsigned int hnf_cache_group_entries_per_group;
+
+    /*! Width of an HN-F node identifier in a system cache group register */
+    unsigned int hnf_cache_group_entry_bits_width;
+};
+
+/*!
+ * \brief Location of an HN-F node and of the monitor counting its events.
+ */
+struct cmn_core_hnf_info {
+    /*! Base address of the HN-F node */
+    uintptr_t node;
+
+    /*! Base address of the debug/trace monitor (DTM) watching the node */
+    uintptr_t dtm;
+
+    /*! Device port of the node on its DTM */
+    unsigned int dtm_port;
+
+    /*! Device of the node on its port */
+    unsigned int device;
+};
+
+/*!
+ * \brief Mesh topology API.
+ *
+ * \details Implemented by the CMN drivers once the mesh has been discovered,
+ *      so that other modules can reach the nodes without walking the mesh.
+ *      The functions return ::FWK_E_STATE until the mesh has been set up.
+ */
+struct cmn_core_topology_api {
+    /*!
+     * \brief Get the number of HN-F nodes in the mesh.
+     *
+     * \param[out] count Number of HN-F nodes.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_STATE The mesh has not been set up yet.
+     */
+    int (*get_hnf_count)(unsigned int *count);
+
+    /*!
+     * \brief Get the location of an HN-F node.
+     *
+     * \param hnf_idx Index of the HN-F node, in discovery order.
+     * \param[out] info Location of the node.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_PARAM The index is out of range.
+     * \retval ::FWK_E_STATE The mesh has not been set up yet.
+     */
+    int (*get_hnf)(unsigned int hnf_idx, struct cmn_core_hnf_info *info);
+
+    /*!
+     * \brief Get the base address of the debug/trace controller (DTC).
+     *
+     * \param[out] dtc Base address of the DTC node.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_STATE The mesh has not been set up yet.
+     * \retval ::FWK_E_SUPPORT The mesh has no DTC.
+     */
+    int (*get_dtc)(uintptr_t *dtc);
+};
+
+/*!
+ * \brief Retrieve the number of child nodes of a node.
+ *
+ * \param node_base Pointer to the node descriptor.
+ *
+ * \return Number of child nodes.
+ */
+static inline unsigned int cmn_core_node_child_count(void *node_base)
+{
+    struct cmn_core_node_header *node = node_base;
+
+    return node->CHILD_INFO & CMN_CORE_CHILD_INFO_COUNT;
+}
+
+/*!
+ * \brief Retrieve the type identifier of a node.
+ *
+ * \param node_base Pointer to the node descriptor.
+ *
+ * \return Node type identifier.
+ */
+static inline unsigned int cmn_core_node_type(void *node_base)
+{
+    struct cmn_core_node_header *node = node_base;
+
+    return node->NODE_INFO & CMN_CORE_NODE_INFO_TYPE;
+}
+
+/*!
+ * \brief Retrieve the physical identifier of a node.
+ *
+ * \param node_base Pointer to the node descriptor.
+ *
+ * \return Node physical identifier.
+ */
+static inline unsigned int cmn_core_node_id(void *node_base)
+{
+    struct cmn_core_node_header *node = node_base;
+
+    return (node->NODE_INFO & CMN_CORE_NODE_INFO_ID) >>
+        CMN_CORE_NODE_INFO_ID_POS;
+}
+
+/*!
+ * \brief Retrieve the logical identifier of a node.
+ *
+ * \param node_base Pointer to the node descriptor.
+ *
+ * \return Node logical identifier.
+ */
+static inline unsigned int cmn_core_node_logical_id(void *node_base)
+{
+    struct cmn_core_node_header *node = node_base;
+
+    return (node->NODE_INFO & CMN_CORE_NODE_INFO_LOGICAL_ID) >>
+        CMN_CORE_NODE_INFO_LOGICAL_ID_POS;
+}
+
+/*!
+ * \brief Retrieve a child node of a node.
+ *
+ * \param desc Generation register descriptor.
+ * \param base Base address of the CMN instance.
+ * \param node_base Pointer to the parent node descriptor.
+ * \param child_index Child index.
+ *
+ * \return Pointer to the child node descriptor.
+ */
+static inline void *cmn_core_child_node(
+    const struct cmn_core_desc *desc,
+    uintptr_t base,
+    void *node_base,
+    unsigned int child_index)
+{
+    struct cmn_core_node_header *node = node_base;
+    uint32_t child_pointer;
+
+    child_pointer = node->CHILD_POINTER[child_index];
+
+    return (void *)(base + (child_pointer & desc->child_pointer_offset_mask));
+}
+
+/*!
+ * \brief Retrieve the physical identifier of a child node from the child
+ *      pointer of its parent, without accessing the child node itself.
+ *
+ * \param desc Generation register descriptor.
+ * \param node_base Pointer to the parent node descriptor.
+ * \param child_index Child index.
+ *
+ * \return Child node physical identifier.
+ */
+static inline unsigned int cmn_core_child_node_id(
+    const struct cmn_core_desc *desc,
+    void *node_base,
+    unsigned int child_index)
+{
+    struct cmn_core_node_header *node = node_base;
+    uint32_t node_pointer;
+
+    node_pointer = (node->CHILD_POINTER[child_index] &
+                    desc->child_pointer_ext_node_pointer_mask) >>
+        desc->child_pointer_ext_node_pointer_pos;
+
+    /*
+     * NodeID[1:0] = DeviceID[3:2]
+     * NodeID[2]   = DeviceID[0]
+     * NodeID[n:3] = NODE POINTER[n+3:6]
+     */
+    return (((node_pointer >> 6) & 0xff) << 3) |
+        ((node_pointer & 0x1) << 2) | ((node_pointer >> 2) & 0x3);
+}
+
+/*!
+ * \brief Check whether a child node is external to the CMN instance.
+ *
+ * \param node_base Pointer to the parent node descriptor.
+ * \param child_index Child index.
+ *
+ * \retval true The child node is external.
+ * \retval false The child node is internal.
+ */
+static inline bool cmn_core_child_is_external(
+    void *node_base,
+    unsigned int child_index)
+{
+    struct cmn_core_node_header *node = node_base;
+
+    return (node->CHILD_POINTER[child_index] & CMN_CORE_CHILD_POINTER_EXT) != 0;
+}
+
+/*!
+ * \brief Retrieve the device port from a node identifier.
+ *
+ * \param desc Generation register descriptor.
+ * \param node_id Node physical identifier.
+ *
+ * \return Device port number.
+ */
+static inline unsigned int cmn_core_node_id_port(
+    const struct cmn_core_desc *desc,
+    unsigned int node_id)
+{
+    return (node_id >> desc->node_id_port_pos) & desc->node_id_port_mask;
+}
+
+/*!
+ * \brief Encode a region size as log2(size / ::CMN_CORE_SAM_GRANULARITY).
+ *
+ * \param size Region size.
+ *      \pre The size must be a power of two multiple of the SAM granularity.
+ *
+ * \return Encoded region size.
+ */
+static inline uint64_t cmn_core_sam_encode_region_size(uint64_t size)
+{
+    /* Size must be a multiple of the granularity and a power of two */
+    fwk_assert((size % CMN_CORE_SAM_GRANULARITY) == 0);
+    fwk_assert((size & (size - 1)) == 0);
+
+    return fwk_math_log2(size / CMN_CORE_SAM_GRANULARITY);
+}
+
+/*!
+ * \brief Build an RN-SAM region entry from its base, size and target type.
+ *
+ * \param desc Generation register descriptor.
+ * \param base Region base address.
+ *      \pre The base must be aligned on the region size.
+ * \param size Region size.
+ * \param node_type Target node type, as encoded by the generation.
+ *
+ * \return Valid region entry, right-aligned.
+ */
+static inline uint64_t cmn_core_sam_region_entry(
+    const struct cmn_core_desc *desc,
+    uint64_t base,
+    uint64_t size,
+    unsigned int node_type)
+{
+    fwk_assert((base % size) == 0);
+
+    return UINT64_C(1) |
+        ((uint64_t)node_type << desc->rnsam_region_entry_type_pos) |
+        (cmn_core_sam_encode_region_size(size)
+         << desc->rnsam_region_entry_size_pos) |
+        ((base / CMN_CORE_SAM_GRANULARITY)
+         << desc->rnsam_region_entry_base_pos);
+}
+
+/*!
+ * \brief Locate the entry of an HN-F node in the system cache group
+ *      registers, striping the HN-Fs by logical identifier.
+ *
+ * \param desc Generation register descriptor.
+ * \param logical_id HN-F logical identifier.
+ * \param cal_mode_factor 2 when pairs of HN-Fs share a CAL, 1 otherwise.
+ * \param[out] group System cache group register index.
+ * \param[out] bit_pos Position of the entry in the register.
+ */
+static inline void cmn_core_hnf_cache_group_locate(
+    const struct cmn_core_desc *desc,
+    unsigned int logical_id,
+    unsigned int cal_mode_factor,
+    unsigned int *group,
+    unsigned int *bit_pos)
+{
+    unsigned int entries = desc->hnf_cache_group_entries_per_group *
+        cal_mode_factor;
+
+    *group = logical_id / entries;
+    *bit_pos = (desc->hnf_cache_group_entry_bits_width / cal_mode_factor) *
+        (logical_id % entries);
+}
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* CMN_CORE_H */
@@ -0,0 +1,167 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     CMN PMU bandwidth and system cache sampling.
+ */
+
+#ifndef MOD_CMN_PMU_H
+#define MOD_CMN_PMU_H
+
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupCmnPmu CMN PMU
+ *
+ * \brief CMN PMU bandwidth and system cache sampling.
+ *
+ * \details The module counts the system level cache (SLC) accesses, the SLC
+ *      misses and the requests sent to the memory controllers (SN) by the
+ *      HN-F nodes of a CMN mesh. The nodes are located through the topology
+ *      API of the CMN driver, see ::cmn_core_topology_api.
+ *
+ *      Each event is counted by a local counter of the monitor (DTM) of every
+ *      HN-F, paired with a global counter of the controller (DTC) that
+ *      accumulates the local counter overflows. An HN-F whose monitor has no
+ *      local counters left is not monitored, see
+ *      ::mod_cmn_pmu_sample::hnf_count.
+ *
+ *      The counters are sampled periodically. The last sample is available
+ *      through ::mod_cmn_pmu_api and, when the firmware includes the SDS
+ *      module, is also appended to a ring of samples in a Shared Data
+ *      Structure.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Size of the transfers counted by the PMU events, in bytes.
+ */
+#define MOD_CMN_PMU_TRANSFER_SIZE 64
+
+/*!
+ * \brief Events counted over a sampling period.
+ */
+struct mod_cmn_pmu_sample {
+    /*! Index of the sample, incremented with every sample */
+    uint32_t sequence;
+
+    /*! Length of the sampling period in milliseconds */
+    uint32_t period_ms;
+
+    /*! Number of HN-F nodes monitored */
+    uint32_t hnf_count;
+
+    /*! Reserved, zero */
+    uint32_t reserved;
+
+    /*! Number of SLC accesses */
+    uint64_t slc_accesses;
+
+    /*! Number of SLC misses */
+    uint64_t slc_misses;
+
+    /*! Number of requests sent to the memory controllers */
+    uint64_t sn_requests;
+};
+
+/*!
+ * \brief Header of the Shared Data Structure ring of samples.
+ *
+ * \details The header is followed by ::mod_cmn_pmu_config::sds_slot_count
+ *      ::mod_cmn_pmu_sample slots. The sample with the sequence number N is
+ *      in the slot N % slot_count. The header is updated after the slot, so a
+ *      reader that sees the same write count before and after copying the
+ *      slots has a consistent copy.
+ */
+struct mod_cmn_pmu_sds_header {
+    /*! Number of samples written so far */
+    uint32_t write_count;
+
+    /*! Number of slots following the header */
+    uint32_t slot_count;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_cmn_pmu_config {
+    /*! Identifier of the CMN driver module */
+    fwk_id_t cmn_id;
+
+    /*! Identifier of the mesh topology API of the CMN driver */
+    fwk_id_t topology_api_id;
+
+    /*!
+     * \brief Maximum number of HN-F nodes monitored.
+     *
+     * \details The HN-F nodes found beyond this number are not monitored.
+     */
+    unsigned int hnf_count_max;
+
+    /*! Identifier of the sampling alarm */
+    fwk_id_t alarm_id;
+
+    /*! Sampling period in milliseconds */
+    uint32_t period_ms;
+
+    /*!
+     * \brief Identifier of the Shared Data Structure the samples are written
+     *      to, or zero to disable the publication.
+     */
+    uint32_t sds_structure_id;
+
+    /*!
+     * \brief Number of sample slots in the Shared Data Structure.
+     *
+     * \details Ignored when ::mod_cmn_pmu_config::sds_structure_id is zero.
+     */
+    uint32_t sds_slot_count;
+};
+
+/*!
+ * \brief Module API indices.
+ */
+enum mod_cmn_pmu_api_idx {
+    /*! Sample API */
+    MOD_CMN_PMU_API_IDX_SAMPLE,
+
+    /*! Number of APIs */
+    MOD_CMN_PMU_API_IDX_COUNT,
+};
+
+/*!
+ * \brief Sample API.
+ */
+struct mod_cmn_pmu_api {
+    /*!
+     * \brief Get the last sample.
+     *
+     * \param[out] sample Last sample.
+     *
+     * \retval ::FWK_SUCCESS The sample was returned.
+     * \retval ::FWK_E_STATE No sampling period has completed yet.
+     */
+    int (*get_sample)(struct mod_cmn_pmu_sample *sample);
+};
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_CMN_PMU_H */
@@ -0,0 +1,545 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     CMN PMU bandwidth and system cache sampling.
+ */
+
+#include <cmn_core.h>
+
+#include <mod_cmn_pmu.h>
+#include <mod_timer.h>
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef BUILD_HAS_MOD_SDS
+#    include <mod_sds.h>
+#endif
+
+#define MOD_NAME "[CMN-PMU] "
+
+/* HN-F PMU event selection, one 8-bit event identifier per event slot */
+#define CMN_PMU_HNF_EVENT_SEL 0x2000
+#define CMN_PMU_HNF_EVENT_SEL_ID_POS(SLOT) ((SLOT) * 8)
+
+/* HN-F event identifiers */
+#define CMN_PMU_HNF_EVENT_CACHE_MISS 0x01
+#define CMN_PMU_HNF_EVENT_SLC_SF_CACHE_ACCESS 0x02
+#define CMN_PMU_HNF_EVENT_MC_REQS 0x0D
+
+/* DTM registers, from the base of the DTM */
+#define CMN_PMU_DTM_CONTROL 0x100
+#define CMN_PMU_DTM_CONTROL_DTM_ENABLE UINT64_C(0x1)
+#define CMN_PMU_DTM_PMU_CONFIG 0x210
+#define CMN_PMU_DTM_PMU_CONFIG_PMU_EN UINT64_C(0x1)
+#define CMN_PMU_DTM_PMU_CONFIG_PAIRED(COUNTER) (UINT64_C(1) << (4 + (COUNTER)))
+#define CMN_PMU_DTM_PMU_CONFIG_GLOBAL_NUM_POS(COUNTER) (16 + ((COUNTER) * 4))
+#define CMN_PMU_DTM_PMU_CONFIG_INPUT_SEL_POS(COUNTER) (32 + ((COUNTER) * 8))
+#define CMN_PMU_DTM_PMEVCNT 0x220
+
+/* Local counter input selecting an event of a device */
+#define CMN_PMU_DTM_INPUT_SEL_DEV(PORT, DEVICE, SLOT) \
+    (0x10 + ((PORT) << 4) + ((DEVICE) << 2) + (SLOT))
+
+/* Number and width of the local counters of a DTM */
+#define CMN_PMU_DTM_COUNTER_COUNT 4
+#define CMN_PMU_DTM_COUNTER_BITS 16
+#define CMN_PMU_DTM_COUNTER_MASK UINT64_C(0xFFFF)
+
+/* DTC registers */
+#define CMN_PMU_DTC_CTL 0xA00
+#define CMN_PMU_DTC_CTL_DT_EN UINT64_C(0x1)
+#define CMN_PMU_DTC_PMEVCNT(COUNTER) \
+    (0x2000 + (((COUNTER) / 2) * 0x10) + (((COUNTER) % 2) * 4))
+#define CMN_PMU_DTC_PMCR 0x2100
+#define CMN_PMU_DTC_PMCR_PMU_EN UINT64_C(0x1)
+
+/* Width of the combined global and local counts */
+#define CMN_PMU_COUNT_MASK ((UINT64_C(1) << 48) - 1)
+
+/*
+ * Counted events. Each event uses the global counter and the HN-F event slot
+ * of the same index.
+ */
+enum cmn_pmu_event {
+    CMN_PMU_EVENT_SLC_ACCESS,
+    CMN_PMU_EVENT_SLC_MISS,
+    CMN_PMU_EVENT_SN_REQUEST,
+    CMN_PMU_EVENT_COUNT,
+};
+
+static const uint8_t hnf_event_id[CMN_PMU_EVENT_COUNT] = {
+    [CMN_PMU_EVENT_SLC_ACCESS] = CMN_PMU_HNF_EVENT_SLC_SF_CACHE_ACCESS,
+    [CMN_PMU_EVENT_SLC_MISS] = CMN_PMU_HNF_EVENT_CACHE_MISS,
+    [CMN_PMU_EVENT_SN_REQUEST] = CMN_PMU_HNF_EVENT_MC_REQS,
+};
+
+enum cmn_pmu_event_idx {
+    CMN_PMU_EVENT_IDX_SAMPLE,
+    CMN_PMU_EVENT_IDX_COUNT,
+};
+
+static const fwk_id_t cmn_pmu_event_id_sample =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_CMN_PMU, CMN_PMU_EVENT_IDX_SAMPLE);
+
+struct cmn_pmu_dtm_ctx {
+    /* Base address of the DTM */
+    uintptr_t base;
+
+    /* PMU configuration, without the enable bit */
+    uint64_t pmu_config;
+
+    /* Number of local counters in use */
+    unsigned int counter_count;
+
+    /* Event counted by each local counter in use */
+    uint8_t counter_event[CMN_PMU_DTM_COUNTER_COUNT];
+};
+
+static struct cmn_pmu_ctx {
+    /* Module configuration */
+    const struct mod_cmn_pmu_config *config;
+
+    /* Mesh topology API */
+    const struct cmn_core_topology_api *topology_api;
+
+    /* Sampling alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+#ifdef BUILD_HAS_MOD_SDS
+    /* SDS API */
+    const struct mod_sds_api *sds_api;
+#endif
+
+    /* Base address of the DTC */
+    uintptr_t dtc;
+
+    /* Table of the DTMs watching the monitored HN-F nodes */
+    struct cmn_pmu_dtm_ctx *dtm_table;
+    unsigned int dtm_count;
+
+    /* Number of HN-F nodes monitored */
+    unsigned int hnf_count;
+
+    /* The PMU has been programmed */
+    bool configured;
+
+    /* Counts at the previous sample */
+    uint64_t last_count[CMN_PMU_EVENT_COUNT];
+
+    /* The counts of a previous sample are available */
+    bool counted;
+
+    /* Last sample */
+    struct mod_cmn_pmu_sample sample;
+
+    /* The last sample is valid */
+    bool sampled;
+
+    /* A sampling event has been queued and not yet processed */
+    volatile bool sample_pending;
+} cmn_pmu_ctx;
+
+/*
+ * Helpers
+ */
+
+static inline volatile uint64_t *reg64(uintptr_t base, uintptr_t offset)
+{
+    return (volatile uint64_t *)(base + offset);
+}
+
+static inline volatile uint32_t *reg32(uintptr_t base, uintptr_t offset)
+{
+    return (volatile uint32_t *)(base + offset);
+}
+
+static struct cmn_pmu_dtm_ctx *get_dtm_ctx(uintptr_t base)
+{
+    struct cmn_pmu_dtm_ctx *dtm;
+    unsigned int idx;
+
+    for (idx = 0; idx < cmn_pmu_ctx.dtm_count; idx++) {
+        if (cmn_pmu_ctx.dtm_table[idx].base == base)
+            return &cmn_pmu_ctx.dtm_table[idx];
+    }
+
+    if (cmn_pmu_ctx.dtm_count == cmn_pmu_ctx.config->hnf_count_max)
+        return NULL;
+
+    dtm = &cmn_pmu_ctx.dtm_table[cmn_pmu_ctx.dtm_count++];
+    dtm->base = base;
+
+    return dtm;
+}
+
+/*
+ * Assign a local counter of the DTM of an HN-F to each event, and select the
+ * events in the HN-F.
+ */
+static bool add_hnf(const struct cmn_core_hnf_info *info)
+{
+    struct cmn_pmu_dtm_ctx *dtm;
+    uint64_t event_sel = 0;
+    unsigned int counter;
+    unsigned int event;
+
+    dtm = get_dtm_ctx(info->dtm);
+    if ((dtm == NULL) ||
+        ((dtm->counter_count + CMN_PMU_EVENT_COUNT) >
+         CMN_PMU_DTM_COUNTER_COUNT))
+        return false;
+
+    for (event = 0; event < CMN_PMU_EVENT_COUNT; event++) {
+        counter = dtm->counter_count++;
+
+        dtm->counter_event[counter] = event;
+        dtm->pmu_config |= CMN_PMU_DTM_PMU_CONFIG_PAIRED(counter) |
+            ((uint64_t)event
+             << CMN_PMU_DTM_PMU_CONFIG_GLOBAL_NUM_POS(counter)) |
+            ((uint64_t)CMN_PMU_DTM_INPUT_SEL_DEV(
+                 info->dtm_port, info->device, event)
+             << CMN_PMU_DTM_PMU_CONFIG_INPUT_SEL_POS(counter));
+
+        event_sel |= (uint64_t)hnf_event_id[event]
+            << CMN_PMU_HNF_EVENT_SEL_ID_POS(event);
+    }
+
+    *reg64(info->node, CMN_PMU_HNF_EVENT_SEL) = event_sel;
+
+    return true;
+}
+
+/*
+ * Program the PMU once the mesh has been set up by the CMN driver.
+ */
+static int cmn_pmu_configure(void)
+{
+    int status;
+    unsigned int hnf_count;
+    unsigned int hnf_idx;
+    unsigned int idx;
+    struct cmn_core_hnf_info info;
+    struct cmn_pmu_dtm_ctx *dtm;
+
+    status = cmn_pmu_ctx.topology_api->get_hnf_count(&hnf_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = cmn_pmu_ctx.topology_api->get_dtc(&cmn_pmu_ctx.dtc);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (hnf_idx = 0; hnf_idx < hnf_count; hnf_idx++) {
+        status = cmn_pmu_ctx.topology_api->get_hnf(hnf_idx, &info);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (add_hnf(&info))
+            cmn_pmu_ctx.hnf_count++;
+    }
+
+    if (cmn_pmu_ctx.hnf_count < hnf_count) {
+        FWK_LOG_WARN(
+            MOD_NAME "%u of %u HN-F nodes not monitored",
+            hnf_count - cmn_pmu_ctx.hnf_count,
+            hnf_count);
+    }
+
+    /* Start the DTMs from zero, then the DTC with its global counters */
+    for (idx = 0; idx < cmn_pmu_ctx.dtm_count; idx++) {
+        dtm = &cmn_pmu_ctx.dtm_table[idx];
+
+        *reg64(dtm->base, CMN_PMU_DTM_PMEVCNT) = 0;
+        *reg64(dtm->base, CMN_PMU_DTM_PMU_CONFIG) =
+            dtm->pmu_config | CMN_PMU_DTM_PMU_CONFIG_PMU_EN;
+        *reg64(dtm->base, CMN_PMU_DTM_CONTROL) |=
+            CMN_PMU_DTM_CONTROL_DTM_ENABLE;
+    }
+
+    for (idx = 0; idx < CMN_PMU_EVENT_COUNT; idx++)
+        *reg32(cmn_pmu_ctx.dtc, CMN_PMU_DTC_PMEVCNT(idx)) = 0;
+
+    *reg64(cmn_pmu_ctx.dtc, CMN_PMU_DTC_PMCR) |= CMN_PMU_DTC_PMCR_PMU_EN;
+    *reg64(cmn_pmu_ctx.dtc, CMN_PMU_DTC_CTL) |= CMN_PMU_DTC_CTL_DT_EN;
+
+    cmn_pmu_ctx.configured = true;
+
+    FWK_LOG_INFO(
+        MOD_NAME "Monitoring %u HN-F nodes through %u DTMs",
+        cmn_pmu_ctx.hnf_count,
+        cmn_pmu_ctx.dtm_count);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Read the count of every event: the overflows of the local counters
+ * accumulated by the global counter, plus the current local counts.
+ */
+static void read_counts(uint64_t count[CMN_PMU_EVENT_COUNT])
+{
+    const struct cmn_pmu_dtm_ctx *dtm;
+    uint64_t pmevcnt;
+    unsigned int counter;
+    unsigned int event;
+    unsigned int idx;
+
+    for (event = 0; event < CMN_PMU_EVENT_COUNT; event++) {
+        count[event] = (uint64_t)*reg32(
+                           cmn_pmu_ctx.dtc, CMN_PMU_DTC_PMEVCNT(event))
+            << CMN_PMU_DTM_COUNTER_BITS;
+    }
+
+    for (idx = 0; idx < cmn_pmu_ctx.dtm_count; idx++) {
+        dtm = &cmn_pmu_ctx.dtm_table[idx];
+
+        /* A single read returns all the local counters of the DTM */
+        pmevcnt = *reg64(dtm->base, CMN_PMU_DTM_PMEVCNT);
+
+        for (counter = 0; counter < dtm->counter_count; counter++) {
+            count[dtm->counter_event[counter]] +=
+                (pmevcnt >> (counter * CMN_PMU_DTM_COUNTER_BITS)) &
+                CMN_PMU_DTM_COUNTER_MASK;
+        }
+    }
+}
+
+#ifdef BUILD_HAS_MOD_SDS
+static void publish_sample(void)
+{
+    int status;
+    uint32_t structure_id = cmn_pmu_ctx.config->sds_structure_id;
+    uint32_t slot_count = cmn_pmu_ctx.config->sds_slot_count;
+    const struct mod_cmn_pmu_sample *sample = &cmn_pmu_ctx.sample;
+    struct mod_cmn_pmu_sds_header header = {
+        .write_count = sample->sequence + 1,
+        .slot_count = slot_count,
+    };
+
+    /* Write the slot, then the header publishing it */
+    status = cmn_pmu_ctx.sds_api->struct_write(
+        structure_id,
+        sizeof(header) + ((sample->sequence % slot_count) * sizeof(*sample)),
+        sample,
+        sizeof(*sample));
+    if (status == FWK_SUCCESS) {
+        status = cmn_pmu_ctx.sds_api->struct_write(
+            structure_id, 0, &header, sizeof(header));
+    }
+
+    /* The structure is left finalized after the first publication */
+    if (status == FWK_SUCCESS)
+        status = cmn_pmu_ctx.sds_api->struct_finalize(structure_id);
+
+    if ((status != FWK_SUCCESS) && (status != FWK_E_STATE))
+        FWK_LOG_ERR(MOD_NAME "Unable to publish the sample");
+}
+#endif
+
+static int cmn_pmu_sample(void)
+{
+    int status;
+    uint64_t count[CMN_PMU_EVENT_COUNT];
+    uint64_t delta[CMN_PMU_EVENT_COUNT];
+    unsigned int event;
+
+    if (!cmn_pmu_ctx.configured) {
+        status = cmn_pmu_configure();
+
+        /* Wait for the mesh to be set up */
+        if (status == FWK_E_STATE)
+            return FWK_SUCCESS;
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    read_counts(count);
+
+    for (event = 0; event < CMN_PMU_EVENT_COUNT; event++) {
+        delta[event] =
+            (count[event] - cmn_pmu_ctx.last_count[event]) & CMN_PMU_COUNT_MASK;
+        cmn_pmu_ctx.last_count[event] = count[event];
+    }
+
+    /* The first counts only set the reference for the next period */
+    if (!cmn_pmu_ctx.counted) {
+        cmn_pmu_ctx.counted = true;
+        return FWK_SUCCESS;
+    }
+
+    cmn_pmu_ctx.sample = (struct mod_cmn_pmu_sample){
+        .sequence =
+            cmn_pmu_ctx.sampled ? (cmn_pmu_ctx.sample.sequence + 1) : 0,
+        .period_ms = cmn_pmu_ctx.config->period_ms,
+        .hnf_count = cmn_pmu_ctx.hnf_count,
+        .slc_accesses = delta[CMN_PMU_EVENT_SLC_ACCESS],
+        .slc_misses = delta[CMN_PMU_EVENT_SLC_MISS],
+        .sn_requests = delta[CMN_PMU_EVENT_SN_REQUEST],
+    };
+    cmn_pmu_ctx.sampled = true;
+
+#ifdef BUILD_HAS_MOD_SDS
+    if (cmn_pmu_ctx.config->sds_structure_id != 0)
+        publish_sample();
+#endif
+
+    return FWK_SUCCESS;
+}
+
+static void sample_alarm_callback(uintptr_t param)
+{
+    int status;
+    struct fwk_event event = {
+        .id = cmn_pmu_event_id_sample,
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_CMN_PMU),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_CMN_PMU),
+    };
+
+    /* Skip the period if the previous sample is still queued */
+    if (cmn_pmu_ctx.sample_pending)
+        return;
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_SUCCESS)
+        cmn_pmu_ctx.sample_pending = true;
+}
+
+/*
+ * Sample API
+ */
+
+static int cmn_pmu_get_sample(struct mod_cmn_pmu_sample *sample)
+{
+    if (!cmn_pmu_ctx.sampled)
+        return FWK_E_STATE;
+
+    *sample = cmn_pmu_ctx.sample;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_cmn_pmu_api cmn_pmu_api = {
+    .get_sample = cmn_pmu_get_sample,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int cmn_pmu_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    const struct mod_cmn_pmu_config *config = data;
+
+    if ((config == NULL) || (config->period_ms == 0) ||
+        (config->hnf_count_max == 0))
+        return FWK_E_PARAM;
+
+#ifdef BUILD_HAS_MOD_SDS
+    if ((config->sds_structure_id != 0) && (config->sds_slot_count == 0))
+        return FWK_E_PARAM;
+#endif
+
+    cmn_pmu_ctx.config = config;
+    cmn_pmu_ctx.dtm_table = fwk_mm_calloc(
+        config->hnf_count_max, sizeof(cmn_pmu_ctx.dtm_table[0]));
+
+    return FWK_SUCCESS;
+}
+
+static int cmn_pmu_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if (round == 1)
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(
+        cmn_pmu_ctx.config->cmn_id,
+        cmn_pmu_ctx.config->topology_api_id,
+        &cmn_pmu_ctx.topology_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+#ifdef BUILD_HAS_MOD_SDS
+    if (cmn_pmu_ctx.config->sds_structure_id != 0) {
+        status = fwk_module_bind(
+            FWK_ID_MODULE(FWK_MODULE_IDX_SDS),
+            FWK_ID_API(FWK_MODULE_IDX_SDS, 0),
+            &cmn_pmu_ctx.sds_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+#endif
+
+    return fwk_module_bind(
+        cmn_pmu_ctx.config->alarm_id,
+        MOD_TIMER_API_ID_ALARM,
+        &cmn_pmu_ctx.alarm_api);
+}
+
+static int cmn_pmu_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    if (fwk_id_get_api_idx(api_id) != MOD_CMN_PMU_API_IDX_SAMPLE)
+        return FWK_E_PARAM;
+
+    *api = &cmn_pmu_api;
+
+    return FWK_SUCCESS;
+}
+
+static int cmn_pmu_start(fwk_id_t id)
+{
+    return cmn_pmu_ctx.alarm_api->start(
+        cmn_pmu_ctx.config->alarm_id,
+        cmn_pmu_ctx.config->period_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        sample_alarm_callback,
+        (uintptr_t)0);
+}
+
+static int cmn_pmu_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    if (!fwk_id_is_equal(event->id, cmn_pmu_event_id_sample))
+        return FWK_E_PARAM;
+
+    cmn_pmu_ctx.sample_pending = false;
+
+    return cmn_pmu_sample();
+}
+
+const struct fwk_module module_cmn_pmu = {
+    .name = "CMN PMU",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_CMN_PMU_API_IDX_COUNT,
+    .event_count = CMN_PMU_EVENT_IDX_COUNT,
+    .init = cmn_pmu_init,
+    .bind = cmn_pmu_bind,
+    .process_bind_request = cmn_pmu_process_bind_request,
+    .start = cmn_pmu_start,
+    .process_event = cmn_pmu_process_event,
+};
@@ -70,6 +70,19 @@ struct mod_css_clock_rate {
 
     /*! The clock modulator denominator setting, if implemented. */
     uint32_t clock_mod_denominator;
+
+    /*!
+     * \brief The rate can be reached by only reprogramming the dividers.
+     *
+     * \details When the group runs at a rate of the table with the same PLL
+     *      rate and clock source, the member clocks are kept on the PLL and
+     *      only their dividers, and modulators if supported, are changed. The
+     *      PLL is neither reprogrammed nor waited for to relock.
+     *
+     * \warning The member clocks must support their dividers being changed
+     *      while they run from the PLL.
+     */
+    bool divider_step;
 };
 
 /*!
@@ -14,8 +14,9 @@
 #include <fwk_module.h>
 #include <fwk_status.h>
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
-#include <stdlib.h>
 
 /* Device context */
 struct css_clock_dev_ctx {
@@ -24,6 +25,13 @@ struct css_clock_dev_ctx {
     struct mod_clock_drv_api *pll_api;
     struct mod_css_clock_direct_api *clock_api;
     const struct mod_css_clock_dev_config *config;
+    struct mod_clock_rate_index rate_index;
+
+    /*
+     * Entry of the rate the group runs at, NULL when the PLL and the clock
+     * sources may not match any entry
+     */
+    const struct mod_css_clock_rate *current_entry;
 };
 
 /* Module context */
@@ -38,34 +46,46 @@ static struct css_clock_ctx module_ctx;
  * Static helper functions
  */
 
-static int compare_rate_entry(const void *a, const void *b)
-{
-    struct mod_css_clock_rate *key = (struct mod_css_clock_rate *)a;
-    struct mod_css_clock_rate *element = (struct mod_css_clock_rate *)b;
-
-    return (key->rate - element->rate);
-}
-
 static int get_rate_entry(struct css_clock_dev_ctx *ctx, uint64_t target_rate,
-                          struct mod_css_clock_rate **entry)
+                          enum mod_clock_round_mode round_mode,
+                          const struct mod_css_clock_rate **entry)
 {
-    struct mod_css_clock_rate *current_rate_entry;
-
     if (ctx == NULL)
         return FWK_E_PARAM;
     if (entry == NULL)
         return FWK_E_PARAM;
 
-    /* Perform a binary search to find the entry matching the requested rate */
-    current_rate_entry = (struct mod_css_clock_rate *) bsearch(&target_rate,
-        ctx->config->rate_table, ctx->config->rate_count,
-        sizeof(struct mod_css_clock_rate), compare_rate_entry);
+    return mod_clock_rate_index_lookup(&ctx->rate_index, target_rate,
+                                       round_mode, (const void **)entry);
+}
 
-    if (current_rate_entry == NULL)
-        return FWK_E_PARAM;
+static int set_member_divider(struct css_clock_dev_ctx *ctx, fwk_id_t member_id,
+                              const struct mod_css_clock_rate *rate_entry)
+{
+    int status;
 
-    *entry = current_rate_entry;
-    return FWK_SUCCESS;
+    status = ctx->clock_api->set_div(member_id, rate_entry->clock_div_type,
+                                     rate_entry->clock_div);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (!ctx->config->modulation_supported)
+        return FWK_SUCCESS;
+
+    return ctx->clock_api->set_mod(member_id, rate_entry->clock_mod_numerator,
+                                   rate_entry->clock_mod_denominator);
+}
+
+/*
+ * A rate of the table can be reached without touching the PLL when the group
+ * already runs from the PLL rate and clock source it needs.
+ */
+static bool is_divider_step(struct css_clock_dev_ctx *ctx,
+                            const struct mod_css_clock_rate *rate_entry)
+{
+    return rate_entry->divider_step && (ctx->current_entry != NULL) &&
+        (ctx->current_entry->pll_rate == rate_entry->pll_rate) &&
+        (ctx->current_entry->clock_source == rate_entry->clock_source);
 }
 
 static int set_rate_indexed(struct css_clock_dev_ctx *ctx, uint64_t rate,
@@ -73,16 +93,31 @@ static int set_rate_indexed(struct css_clock_dev_ctx *ctx, uint64_t rate,
 {
     int status;
     unsigned int i;
-    struct mod_css_clock_rate *rate_entry;
+    const struct mod_css_clock_rate *rate_entry;
 
     if (ctx == NULL)
         return FWK_E_PARAM;
 
     /* Look up the divider and source settings */
-    status = get_rate_entry(ctx, rate, &rate_entry);
+    status = get_rate_entry(ctx, rate, round_mode, &rate_entry);
     if (status != FWK_SUCCESS)
         goto exit;
 
+    /* Only change the dividers of the member clocks if possible */
+    if (is_divider_step(ctx, rate_entry)) {
+        for (i = 0; i < ctx->config->member_count; i++) {
+            status = set_member_divider(ctx, ctx->config->member_table[i],
+                                        rate_entry);
+            if (status != FWK_SUCCESS)
+                goto exit;
+        }
+
+        goto exit;
+    }
+
+    /* The PLL and the sources no longer match any entry from here */
+    ctx->current_entry = NULL;
+
     /* Switch each member clock away from the PLL source */
     for (i = 0; i < ctx->config->member_count; i++) {
         status = ctx->clock_api->set_source(ctx->config->member_table[i],
@@ -90,19 +125,10 @@ static int set_rate_indexed(struct css_clock_dev_ctx *ctx, uint64_t rate,
         if (status != FWK_SUCCESS)
             goto exit;
 
-        status = ctx->clock_api->set_div(ctx->config->member_table[i],
-                                         rate_entry->clock_div_type,
-                                         rate_entry->clock_div);
+        status = set_member_divider(ctx, ctx->config->member_table[i],
+                                    rate_entry);
         if (status != FWK_SUCCESS)
             goto exit;
-
-        if (ctx->config->modulation_supported) {
-            status = ctx->clock_api->set_mod(ctx->config->member_table[i],
-                                             rate_entry->clock_mod_numerator,
-                                             rate_entry->clock_mod_denominator);
-            if (status != FWK_SUCCESS)
-                goto exit;
-        }
     }
 
     /* Change the PLL to the desired rate */
@@ -120,8 +146,11 @@ static int set_rate_indexed(struct css_clock_dev_ctx *ctx, uint64_t rate,
     }
 
 exit:
-    if (status == FWK_SUCCESS)
-        ctx->current_rate = rate;
+    if (status == FWK_SUCCESS) {
+        ctx->current_rate = rate_entry->rate;
+        ctx->current_entry = rate_entry;
+    } else
+        ctx->current_entry = NULL;
     return status;
 }
 
@@ -269,6 +298,9 @@ static int css_clock_power_state_change(
         }
     }
 
+    /* The PLL and the sources are set up again from scratch */
+    ctx->current_entry = NULL;
+
     if (next_state == MOD_PD_STATE_ON) {
         if (ctx->initialized) {
             /* Restore all clocks in the group to the last frequency */
@@ -347,9 +379,7 @@ static int css_clock_element_init(fwk_id_t element_id,
                                   unsigned int sub_element_count,
                                   const void *data)
 {
-    unsigned int i = 0;
-    uint64_t current_rate;
-    uint64_t last_rate = 0;
+    int status;
     struct css_clock_dev_ctx *ctx;
     const struct mod_css_clock_dev_config *dev_config = data;
 
@@ -358,18 +388,15 @@ static int css_clock_element_init(fwk_id_t element_id,
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(element_id);
 
-    if (dev_config->clock_type == MOD_CSS_CLOCK_TYPE_INDEXED) {
-        /* Verify that the rate entries in the lookup table are ordered */
-        while (i < dev_config->rate_count) {
-            current_rate = dev_config->rate_table[i].rate;
-
-            /* The rate entries must be in ascending order */
-            if (current_rate < last_rate)
-                return FWK_E_DATA;
-
-            last_rate = current_rate;
-            i++;
-        }
+    if ((dev_config->clock_type == MOD_CSS_CLOCK_TYPE_INDEXED) &&
+        (dev_config->rate_count != 0)) {
+        /* Index the lookup table, verifying that the rates are ordered */
+        status = mod_clock_rate_index_init(&ctx->rate_index,
+                                           dev_config->rate_table,
+                                           sizeof(dev_config->rate_table[0]),
+                                           dev_config->rate_count);
+        if (status != FWK_SUCCESS)
+            return status;
     }
 
     ctx->config = dev_config;
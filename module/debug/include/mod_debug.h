@@ -78,6 +78,10 @@ struct mod_debug_api {
     /*!
      * \brief Enable or disable the Debug functionality.
      *
+     * \details The driver is only requested to enable Debug for the first
+     *      user and to disable it for the last one. The requests of the other
+     *      users complete immediately.
+     *
      * \param id Debug device identifier.
      *
      * \param enable Targeted state for Debug, true for enabled, false
@@ -12,6 +12,7 @@
 
 #include <fwk_id.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 enum debug_state {
@@ -28,6 +29,7 @@ struct debug_dev_ctx {
     struct mod_debug_driver_api *driver_api;
     uint32_t debug_users_mask;
     enum scp_debug_user requester;
+    bool enable;
     enum debug_state state;
     uint32_t cookie;
 };
@@ -76,9 +76,23 @@ static int set_enabled(fwk_id_t id, bool enable, enum scp_debug_user user_id)
         (!enable && (!(ctx->debug_users_mask & user_mask))))
         return FWK_E_ACCESS;
 
+    /*
+     * When another user holds the element, Debug is already enabled and
+     * remains so once this user releases it, so only the users mask needs to
+     * be updated. The requests of the DAP user are always forwarded as the
+     * driver acknowledges them to the hardware.
+     */
+    if ((user_id != SCP_DEBUG_USER_DAP) &&
+        ((ctx->debug_users_mask & ~user_mask) != 0)) {
+        mark_user(id, enable, user_id);
+        return FWK_SUCCESS;
+    }
+
     status = ctx->driver_api->set_enabled(ctx->config->driver_id,
                                           enable, user_id);
     if (status == FWK_PENDING) {
+        ctx->enable = enable;
+
         if (user_id == SCP_DEBUG_USER_DAP) {
             /*
              * In case the request comes from the driver, we won't respond so
@@ -129,6 +143,12 @@ static int get_enabled(fwk_id_t id, bool *enable, enum scp_debug_user user_id)
     if (ctx->state != DEBUG_IDLE)
         return FWK_E_BUSY;
 
+    /* Debug is enabled for as long as a user holds the element */
+    if (ctx->debug_users_mask != 0) {
+        *enable = true;
+        return FWK_SUCCESS;
+    }
+
     status = ctx->driver_api->get_enabled(ctx->config->driver_id,
                                           enable, user_id);
     if (status == FWK_PENDING) {
@@ -217,7 +237,8 @@ static void request_complete(fwk_id_t id,
     ctx = &ctx_table[fwk_id_get_element_idx(id)];
 
     if (ctx->requester == SCP_DEBUG_USER_DAP) {
-        mark_user(id, response->enabled, ctx->requester);
+        if (response->status == FWK_SUCCESS)
+            mark_user(id, ctx->enable, ctx->requester);
         ctx->state = DEBUG_IDLE;
         return;
     }
@@ -393,7 +414,7 @@ static int mod_debug_process_event(const struct fwk_event *event,
          * When there is no response requested, we are processing an event
          * generated by the driver (MOD_DEBUG_EVENT_IDX_REQ_DRV)
          */
-        status = set_enabled(ctx->config->driver_id, req_params->enable,
+        status = set_enabled(event->target_id, req_params->enable,
                             req_params->user_id);
         if (status == FWK_PENDING)
             break;
@@ -406,7 +427,7 @@ static int mod_debug_process_event(const struct fwk_event *event,
         req_result = (struct mod_debug_response_params *)event->params;
 
         if (req_result->status == FWK_SUCCESS)
-            mark_user(event->target_id, req_result->enabled, ctx->requester);
+            mark_user(event->target_id, ctx->enable, ctx->requester);
 
         return respond(event);
 
@@ -9,11 +9,26 @@
 #include <cli_platform.h>
 
 #include <mod_debugger_cli.h>
+#include <mod_timer.h>
+
+#ifdef BUILD_HAS_MOD_DVFS
+#    include <mod_dvfs.h>
+#endif
+
+#ifdef BUILD_HAS_MOD_SCMI
+#    include <mod_scmi.h>
+#endif
 
 #include <fwk_assert.h>
+#include <fwk_id.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 #include <fwk_status.h>
 #include <fwk_thread.h>
+#include <fwk_time.h>
+
+#include <stdbool.h>
+#include <stdint.h>
 
 enum debugger_cli_internal_event_idx {
     DEBUGGER_CLI_INTERNAL_EVENT_IDX_ENTER_DEBUGGER,
@@ -26,6 +41,202 @@ static const fwk_id_t debugger_cli_event_id_request =
 
 static struct mod_timer_alarm_api *alarm_api;
 
+static struct mod_timer_api *timer_api;
+
+#ifdef BUILD_HAS_MOD_DVFS
+static const struct mod_dvfs_domain_api *dvfs_api;
+#endif
+
+#ifdef BUILD_HAS_MOD_SCMI
+/* Highest number of agents whose message rates are reported */
+#    define DEBUGGER_CLI_SCMI_AGENT_COUNT_MAX 16
+
+static const struct mod_scmi_telemetry_api *scmi_telemetry_api;
+
+static const struct mod_scmi_capture_api *scmi_capture_api;
+
+/* Message counts of the agents when the rates were last printed */
+static uint32_t scmi_agent_counts[DEBUGGER_CLI_SCMI_AGENT_COUNT_MAX];
+
+/* Time the rates were last printed */
+static fwk_timestamp_t scmi_rate_timestamp;
+#endif
+
+/*
+ * alarms
+ * Prints the time to the next alarm of each timer.
+ */
+static const char alarms_call[] = "alarms";
+static const char alarms_help[] =
+    "  Prints the time to the next alarm of each timer device.\n"
+    "    Usage: alarms\n";
+static int32_t alarms_f(int32_t argc, char **argv)
+{
+    fwk_id_t dev_id;
+    uint64_t remaining_ticks;
+    uint32_t frequency;
+    bool has_alarm;
+    int element_count;
+    int idx;
+
+    element_count = fwk_module_get_element_count(fwk_module_id_timer);
+
+    for (idx = 0; idx < element_count; idx++) {
+        dev_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, idx);
+
+        if ((timer_api->get_frequency(dev_id, &frequency) != FWK_SUCCESS) ||
+            (frequency == 0) ||
+            (timer_api->get_next_alarm_remaining(
+                 dev_id, &has_alarm, &remaining_ticks) != FWK_SUCCESS))
+            continue;
+
+        if (!has_alarm) {
+            cli_printf(NONE, "%s: no alarm\n", fwk_module_get_name(dev_id));
+            continue;
+        }
+
+        cli_printf(
+            NONE,
+            "%s: next alarm in %u us\n",
+            fwk_module_get_name(dev_id),
+            (unsigned int)((remaining_ticks * UINT64_C(1000000)) / frequency));
+    }
+
+    return FWK_SUCCESS;
+}
+
+#ifdef BUILD_HAS_MOD_DVFS
+/*
+ * dvfs_latency
+ * Prints the transition latencies of the DVFS domains.
+ */
+static const char dvfs_latency_call[] = "dvfslat";
+static const char dvfs_latency_help[] =
+    "  Prints the latency of the last transition of each DVFS domain, and\n"
+    "  the 95th percentile of the latency over the recent transitions.\n"
+    "    Usage: dvfslat\n";
+static int32_t dvfs_latency_f(int32_t argc, char **argv)
+{
+    struct mod_dvfs_latency_stats stats;
+    fwk_id_t domain_id;
+    int element_count;
+    int idx;
+
+    element_count = fwk_module_get_element_count(fwk_module_id_dvfs);
+
+    for (idx = 0; idx < element_count; idx++) {
+        domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, idx);
+
+        if (dvfs_api->get_latency_stats(domain_id, &stats) != FWK_SUCCESS)
+            continue;
+
+        cli_printf(
+            NONE,
+            "%s: last %u us (voltage %u us, frequency %u us), p95 %u us\n",
+            fwk_module_get_name(domain_id),
+            stats.last_us,
+            stats.last_voltage_us,
+            stats.last_frequency_us,
+            stats.p95_us);
+    }
+
+    return FWK_SUCCESS;
+}
+#endif
+
+#ifdef BUILD_HAS_MOD_SCMI
+/*
+ * scmi_rate
+ * Prints the rate of the SCMI messages received from each agent.
+ */
+static const char scmi_rate_call[] = "scmirate";
+static const char scmi_rate_help[] =
+    "  Prints the number of SCMI messages received from each agent and the\n"
+    "  rate of messages per second since the command was last run.\n"
+    "    Usage: scmirate\n";
+static int32_t scmi_rate_f(int32_t argc, char **argv)
+{
+    uint32_t counts[DEBUGGER_CLI_SCMI_AGENT_COUNT_MAX] = { 0 };
+    struct mod_scmi_telemetry_entry entry;
+    fwk_timestamp_t timestamp;
+    fwk_duration_us_t elapsed_us;
+    unsigned int entry_count;
+    unsigned int idx;
+
+    if (scmi_telemetry_api->get_entry_count(&entry_count) != FWK_SUCCESS)
+        return FWK_E_DEVICE;
+
+    for (idx = 0; idx < entry_count; idx++) {
+        if ((scmi_telemetry_api->get_entry(idx, &entry) == FWK_SUCCESS) &&
+            (entry.agent_id < DEBUGGER_CLI_SCMI_AGENT_COUNT_MAX))
+            counts[entry.agent_id] += entry.count;
+    }
+
+    timestamp = fwk_time_current();
+    elapsed_us = fwk_time_duration_us(
+        fwk_time_duration(scmi_rate_timestamp, timestamp));
+
+    for (idx = 0; idx < DEBUGGER_CLI_SCMI_AGENT_COUNT_MAX; idx++) {
+        if (counts[idx] == 0)
+            continue;
+
+        /* The counts restart from zero when the telemetry is cleared */
+        if (counts[idx] < scmi_agent_counts[idx])
+            scmi_agent_counts[idx] = 0;
+
+        cli_printf(
+            NONE,
+            "Agent %u: %u messages, %u per second\n",
+            idx,
+            counts[idx],
+            (elapsed_us == 0) ?
+                0 :
+                (unsigned int)(
+                    ((uint64_t)(counts[idx] - scmi_agent_counts[idx]) *
+                     UINT64_C(1000000)) /
+                    elapsed_us));
+
+        scmi_agent_counts[idx] = counts[idx];
+    }
+
+    scmi_rate_timestamp = timestamp;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * scmi_capture
+ * Prints the location of the SCMI message capture, or clears it.
+ */
+static const char scmi_capture_call[] = "scmicap";
+static const char scmi_capture_help[] =
+    "  Prints the address and size of the SCMI message capture, to be dumped\n"
+    "  with the debugger and replayed on the host, or clears the capture.\n"
+    "    Usage: scmicap [clear]\n";
+static int32_t scmi_capture_f(int32_t argc, char **argv)
+{
+    const struct mod_scmi_capture_header *capture;
+    size_t size;
+    int status;
+
+    if ((argc == 2) && (cli_strncmp(argv[1], "clear", 5) == 0))
+        return scmi_capture_api->reset();
+
+    status = scmi_capture_api->get_capture(&capture, &size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    cli_printf(
+        NONE,
+        "Capture at 0x%08x, %u bytes, %u messages recorded\n",
+        (unsigned int)(uintptr_t)capture,
+        (unsigned int)size,
+        (unsigned int)capture->sequence);
+
+    return FWK_SUCCESS;
+}
+#endif
+
 static void alarm_callback(uintptr_t module_idx)
 {
     int status;
@@ -55,6 +266,32 @@ static void alarm_callback(uintptr_t module_idx)
 static int debugger_cli_init(fwk_id_t module_id, unsigned int element_count,
     const void *data)
 {
+    int status;
+
+    status = cli_command_register((cli_command_st){
+        alarms_call, alarms_help, &alarms_f, false });
+    if (status != FWK_SUCCESS)
+        return status;
+
+#ifdef BUILD_HAS_MOD_DVFS
+    status = cli_command_register((cli_command_st){
+        dvfs_latency_call, dvfs_latency_help, &dvfs_latency_f, false });
+    if (status != FWK_SUCCESS)
+        return status;
+#endif
+
+#ifdef BUILD_HAS_MOD_SCMI
+    status = cli_command_register((cli_command_st){
+        scmi_rate_call, scmi_rate_help, &scmi_rate_f, false });
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = cli_command_register((cli_command_st){
+        scmi_capture_call, scmi_capture_help, &scmi_capture_f, false });
+    if (status != FWK_SUCCESS)
+        return status;
+#endif
+
     return FWK_SUCCESS;
 }
 
@@ -67,6 +304,7 @@ static int debugger_cli_element_init(fwk_id_t element_id, unsigned int unused,
 static int debugger_cli_bind(fwk_id_t id, unsigned int round)
 {
     const struct mod_debugger_cli_module_config *module_config;
+    int status;
 
     /* Only bind in the first round of calls */
     if (round > 0)
@@ -76,8 +314,42 @@ static int debugger_cli_bind(fwk_id_t id, unsigned int round)
     module_config = fwk_module_get_data(id);
 
     /* Bind to the specified alarm in order to poll the UART */
-    return fwk_module_bind(module_config->alarm_id, MOD_TIMER_API_ID_ALARM,
+    status = fwk_module_bind(module_config->alarm_id, MOD_TIMER_API_ID_ALARM,
         &alarm_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Bind to the timer of the alarm to read the next alarm of each timer */
+    status = fwk_module_bind(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER,
+            fwk_id_get_element_idx(module_config->alarm_id)),
+        MOD_TIMER_API_ID_TIMER,
+        &timer_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+#ifdef BUILD_HAS_MOD_DVFS
+    status = fwk_module_bind(fwk_module_id_dvfs, mod_dvfs_api_id_dvfs,
+        &dvfs_api);
+    if (status != FWK_SUCCESS)
+        return status;
+#endif
+
+#ifdef BUILD_HAS_MOD_SCMI
+    status = fwk_module_bind(fwk_module_id_scmi,
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_TELEMETRY),
+        &scmi_telemetry_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_module_bind(fwk_module_id_scmi,
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_CAPTURE),
+        &scmi_capture_api);
+    if (status != FWK_SUCCESS)
+        return status;
+#endif
+
+    return FWK_SUCCESS;
 }
 
 static int debugger_cli_start(fwk_id_t id)
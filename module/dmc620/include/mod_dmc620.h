@@ -15,6 +15,7 @@
 #include <fwk_macros.h>
 #include <fwk_module.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*!
@@ -606,6 +607,113 @@ struct mod_dmc620_reg {
  */
 #define DMC_ERR0CTRL0_CFI_ENABLE UINT32_C(0x00000100)
 
+/*!
+ * \brief Enable a PMU counter
+ */
+#define MOD_DMC620_PMU_CONTROL_ENABLE UINT32_C(0x00000001)
+
+/*!
+ * \brief Position of the event selection in a PMU counter control register
+ */
+#define MOD_DMC620_PMU_CONTROL_EVENT_POS 2
+
+/*!
+ * \brief Mask of the event selection in a PMU counter control register
+ */
+#define MOD_DMC620_PMU_CONTROL_EVENT UINT32_C(0x0000007C)
+
+/*!
+ * \brief Request or acknowledge a snapshot of the PMU counters
+ */
+#define MOD_DMC620_PMU_SNAPSHOT UINT32_C(0x00000001)
+
+/*!
+ * \brief PMU clkdiv2 event: cycles
+ */
+#define MOD_DMC620_PMU_EVENT_CYCLE_COUNT 0x00
+
+/*!
+ * \brief PMU clkdiv2 event: read queue depth, accumulated every cycle
+ */
+#define MOD_DMC620_PMU_EVENT_READ_DEPTH 0x0B
+
+/*!
+ * \brief PMU clkdiv2 event: write queue depth, accumulated every cycle
+ */
+#define MOD_DMC620_PMU_EVENT_WRITE_DEPTH 0x0C
+
+/*!
+ * \brief PMU clkdiv2 event: read and write commands issued to the DRAM
+ */
+#define MOD_DMC620_PMU_EVENT_RDWR 0x12
+
+/*!
+ * \brief Signature of the telemetry shared memory region ("DMCT")
+ */
+#define MOD_DMC620_TELEMETRY_SIGNATURE UINT32_C(0x54434D44)
+
+/*!
+ * \brief Revision of the telemetry shared memory region layout
+ */
+#define MOD_DMC620_TELEMETRY_REVISION 1
+
+/*!
+ * \brief Telemetry of a DMC-620 channel.
+ *
+ * \details The counts accumulate from the first sample and are never reset.
+ *      The averages cover the last sampling period only.
+ */
+struct mod_dmc620_telemetry_channel {
+    /*! Number of DMC clkdiv2 cycles elapsed */
+    uint64_t cycles;
+
+    /*! Number of read and write commands issued to the DRAM */
+    uint64_t accesses;
+
+    /*! Read queue depth accumulated every cycle */
+    uint64_t read_occupancy;
+
+    /*! Write queue depth accumulated every cycle */
+    uint64_t write_occupancy;
+
+    /*! Read and write bandwidth in MB/s */
+    uint32_t bandwidth_mbps;
+
+    /*! Average read queue depth, in hundredths of an entry */
+    uint16_t read_queue_avg;
+
+    /*! Average write queue depth, in hundredths of an entry */
+    uint16_t write_queue_avg;
+};
+
+/*!
+ * \brief Header of the telemetry shared memory region.
+ *
+ * \details The header is followed by one ::mod_dmc620_telemetry_channel per
+ *      element of the module. The sequence number is odd while the channels
+ *      are updated, so a reader that sees the same even sequence number
+ *      before and after copying the channels has a consistent copy.
+ */
+struct mod_dmc620_telemetry_header {
+    /*! Signature, ::MOD_DMC620_TELEMETRY_SIGNATURE */
+    uint32_t signature;
+
+    /*! Revision, ::MOD_DMC620_TELEMETRY_REVISION */
+    uint16_t revision;
+
+    /*! Number of channels following the header */
+    uint16_t channel_count;
+
+    /*! Sequence number, incremented before and after each update */
+    uint32_t sequence;
+
+    /*! Sampling period in milliseconds */
+    uint32_t period_ms;
+
+    /*! Channel telemetry */
+    struct mod_dmc620_telemetry_channel channel[];
+};
+
 /*!
  * \brief Element configuration.
  */
@@ -646,6 +754,100 @@ struct mod_dmc620_module_config {
     struct mod_dmc620_reg *dmc_val;
     /*! Pointer to a product-specific function that issues direct commands */
     void (*direct_ddr_cmd)(struct mod_dmc620_reg *dmc);
+
+    /*!
+     * \brief Pointer to a product-specific function that issues the direct
+     *      commands taking the DRAM out of self-refresh on a warm resume, or
+     *      NULL to always configure the channels from scratch.
+     *
+     * \details A channel whose clock stopped after it was configured is
+     *      resumed warm when its clock runs again: the settings are written
+     *      back, but the DDR PHY is not configured again and the
+     *      initialization commands are not issued.
+     *
+     * \warning The clock of a channel must only stop while its DRAM is in
+     *      self-refresh and its DDR PHY retains its configuration.
+     */
+    void (*warm_resume_ddr_cmd)(struct mod_dmc620_reg *dmc);
+
+    /*!
+     * \brief Telemetry sampling period in milliseconds, or zero to leave the
+     *      PMU counters untouched.
+     *
+     * \details The PMU counters are 32 bits wide. The period must be short
+     *      enough for the queue depth counters not to wrap twice.
+     */
+    uint32_t telemetry_period_ms;
+
+    /*!
+     * \brief Identifier of the telemetry sampling alarm.
+     *
+     * \details Ignored when ::mod_dmc620_module_config::telemetry_period_ms
+     *      is zero.
+     */
+    fwk_id_t telemetry_alarm_id;
+
+    /*!
+     * \brief Base address of the telemetry shared memory region, or zero to
+     *      keep the telemetry private to the firmware.
+     */
+    uintptr_t telemetry_region;
+
+    /*! Size of the telemetry shared memory region in bytes */
+    size_t telemetry_region_size;
+
+    /*! Number of bytes transferred by a read or write DRAM command */
+    unsigned int access_size;
+
+    /*!
+     * \brief Number of clkdiv2 cycles the data bus is busy for a read or
+     *      write DRAM command.
+     *
+     * \details Used to report the data bus activity through
+     *      ::MOD_DMC620_API_IDX_ACTIVITY.
+     */
+    unsigned int access_cycles;
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_dmc620_api_idx {
+    /*!
+     * \brief Data bus activity of a channel, for a memory frequency governor.
+     *
+     * \details Implements ::mod_dvfs_governor_activity_api. The counter
+     *      identifier is the element identifier of the channel: the active
+     *      cycles are the cycles the data bus was busy, the total cycles the
+     *      clkdiv2 cycles elapsed. Only available when the firmware includes
+     *      the DVFS governor module.
+     */
+    MOD_DMC620_API_IDX_ACTIVITY,
+
+    /*! Telemetry API, see ::mod_dmc620_telemetry_api */
+    MOD_DMC620_API_IDX_TELEMETRY,
+
+    /*! Number of APIs */
+    MOD_DMC620_API_IDX_COUNT,
+};
+
+/*!
+ * \brief Telemetry API.
+ */
+struct mod_dmc620_telemetry_api {
+    /*!
+     * \brief Get the telemetry of a channel.
+     *
+     * \param element_id Element identifier of the channel.
+     * \param[out] channel Telemetry of the channel.
+     *
+     * \retval ::FWK_SUCCESS The telemetry was returned.
+     * \retval ::FWK_E_PARAM The element identifier is not valid.
+     * \retval ::FWK_E_STATE No sampling period has completed yet.
+     */
+    int (*get_channel)(
+        fwk_id_t element_id,
+        struct mod_dmc620_telemetry_channel *channel);
 };
 
 /*!
@@ -10,27 +10,396 @@
 
 #include <mod_clock.h>
 #include <mod_dmc620.h>
+#include <mod_timer.h>
+
+#ifdef BUILD_HAS_MOD_DVFS_GOVERNOR
+#    include <mod_dvfs_governor.h>
+#endif
 
 #include <fwk_assert.h>
 #include <fwk_event.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 
 #include <fmw_cmsis.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 
+/* Maximum number of polls of the PMU snapshot acknowledge */
+#define DMC620_SNAPSHOT_WAIT_MAX 1000
+
+/* PMU clkdiv2 counters used by the telemetry */
+enum dmc620_counter {
+    DMC620_COUNTER_CYCLES,
+    DMC620_COUNTER_ACCESSES,
+    DMC620_COUNTER_READ_DEPTH,
+    DMC620_COUNTER_WRITE_DEPTH,
+    DMC620_COUNTER_COUNT,
+};
+
+static const uint8_t counter_event[DMC620_COUNTER_COUNT] = {
+    [DMC620_COUNTER_CYCLES] = MOD_DMC620_PMU_EVENT_CYCLE_COUNT,
+    [DMC620_COUNTER_ACCESSES] = MOD_DMC620_PMU_EVENT_RDWR,
+    [DMC620_COUNTER_READ_DEPTH] = MOD_DMC620_PMU_EVENT_READ_DEPTH,
+    [DMC620_COUNTER_WRITE_DEPTH] = MOD_DMC620_PMU_EVENT_WRITE_DEPTH,
+};
+
+enum dmc620_event_idx {
+    DMC620_EVENT_IDX_SAMPLE,
+    DMC620_EVENT_IDX_COUNT,
+};
+
+static const fwk_id_t dmc620_event_id_sample =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_DMC620, DMC620_EVENT_IDX_SAMPLE);
+
+struct dmc620_channel_ctx {
+    /* The counters are programmed and the controller is clocked */
+    bool running;
+
+    /* A sampling period has completed */
+    bool sampled;
+
+    /* Counter values at the last sample */
+    uint32_t last[DMC620_COUNTER_COUNT];
+
+    /* Telemetry of the channel */
+    struct mod_dmc620_telemetry_channel telemetry;
+};
+
+/* Signature of a valid resume context ("DMCR") */
+#define DMC620_RESUME_SIGNATURE UINT32_C(0x52434D44)
+
+/* Context saved when the clock of a channel stops, to resume it warm */
+struct dmc620_resume_ctx {
+    /* DMC620_RESUME_SIGNATURE when the channel can be resumed warm */
+    uint32_t signature;
+
+    /* Registers of the channel the context was saved for */
+    struct mod_dmc620_reg *dmc;
+
+    /* The channel has been configured since its clock last stopped */
+    bool is_configured;
+};
+
+struct dmc620_ctx {
+    /* Module configuration */
+    const struct mod_dmc620_module_config *config;
+
+    /* Sampling alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Telemetry shared memory region, NULL if not published */
+    struct mod_dmc620_telemetry_header *region;
+
+    /* Table of channel contexts, NULL if the telemetry is disabled */
+    struct dmc620_channel_ctx *channel_table;
+
+    /* Number of channels */
+    unsigned int channel_count;
+
+    /* A sampling event has been queued and not yet processed */
+    volatile bool sample_pending;
+
+    /* Table of the resume contexts, indexed by channel */
+    struct dmc620_resume_ctx *resume_table;
+};
+
 static struct mod_dmc_ddr_phy_api *ddr_phy_api;
 
+static struct dmc620_ctx dmc620_ctx;
+
 static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id);
+static void dmc620_write_functional_settings(
+    struct mod_dmc620_reg *dmc,
+    const struct mod_dmc620_reg *reg_val);
+static void dmc620_write_timing_settings(
+    struct mod_dmc620_reg *dmc,
+    const struct mod_dmc620_reg *reg_val);
+static void dmc620_set_ready(struct mod_dmc620_reg *dmc);
+
+/*
+ * Telemetry
+ */
+
+static struct mod_dmc620_reg *channel_dmc(unsigned int channel_idx)
+{
+    const struct mod_dmc620_element_config *element_config;
+
+    element_config = fwk_module_get_data(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_DMC620, channel_idx));
+
+    return (struct mod_dmc620_reg *)element_config->dmc;
+}
+
+static int telemetry_snapshot(
+    struct mod_dmc620_reg *dmc,
+    uint32_t value[DMC620_COUNTER_COUNT])
+{
+    unsigned int wait;
+    unsigned int counter;
+
+    dmc->PMU_SNAPSHOT_REQ = MOD_DMC620_PMU_SNAPSHOT;
+
+    for (wait = 0; (dmc->PMU_SNAPSHOT_ACK & MOD_DMC620_PMU_SNAPSHOT) == 0;
+         wait++) {
+        if (wait == DMC620_SNAPSHOT_WAIT_MAX) {
+            dmc->PMU_SNAPSHOT_REQ = 0;
+            return FWK_E_TIMEOUT;
+        }
+    }
+
+    for (counter = 0; counter < DMC620_COUNTER_COUNT; counter++)
+        value[counter] = dmc->PMC_CLKDIV2_COUNT[counter].SNAPSHOT_VALUE_31_00;
+
+    dmc->PMU_SNAPSHOT_REQ = 0;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Program the counters of a channel once the controller has been configured,
+ * counting every command regardless of its payload.
+ */
+static void telemetry_start(unsigned int channel_idx)
+{
+    struct dmc620_channel_ctx *channel;
+    struct mod_dmc620_reg *dmc;
+    struct mod_dmc620_pmu_counter *pmc;
+    unsigned int counter;
+
+    if (dmc620_ctx.channel_table == NULL)
+        return;
+
+    channel = &dmc620_ctx.channel_table[channel_idx];
+    dmc = channel_dmc(channel_idx);
+
+    for (counter = 0; counter < DMC620_COUNTER_COUNT; counter++) {
+        pmc = &dmc->PMC_CLKDIV2_COUNT[counter];
+        pmc->MASK_31_00 = 0;
+        pmc->MASK_63_32 = 0;
+        pmc->MATCH_31_00 = 0;
+        pmc->MATCH_63_32 = 0;
+        pmc->CONTROL = (((uint32_t)counter_event[counter]
+                         << MOD_DMC620_PMU_CONTROL_EVENT_POS) &
+                        MOD_DMC620_PMU_CONTROL_EVENT) |
+            MOD_DMC620_PMU_CONTROL_ENABLE;
+    }
+
+    if (telemetry_snapshot(dmc, channel->last) != FWK_SUCCESS) {
+        FWK_LOG_WARN("[DDR] DMC620 %u PMU snapshot timeout", channel_idx);
+        return;
+    }
+
+    channel->running = true;
+}
+
+/* Average of an accumulated queue depth, in hundredths of an entry */
+static uint16_t queue_average(uint32_t occupancy, uint32_t cycles)
+{
+    uint64_t average;
+
+    if (cycles == 0)
+        return 0;
+
+    average = ((uint64_t)occupancy * 100) / cycles;
+
+    return (uint16_t)FWK_MIN(average, (uint64_t)UINT16_MAX);
+}
+
+static void telemetry_sample_channel(unsigned int channel_idx)
+{
+    struct dmc620_channel_ctx *channel;
+    struct mod_dmc620_telemetry_channel *telemetry;
+    uint32_t value[DMC620_COUNTER_COUNT];
+    uint32_t delta[DMC620_COUNTER_COUNT];
+    unsigned int counter;
+    uint64_t bytes;
+
+    channel = &dmc620_ctx.channel_table[channel_idx];
+    if (!channel->running)
+        return;
+
+    if (telemetry_snapshot(channel_dmc(channel_idx), value) != FWK_SUCCESS) {
+        FWK_LOG_WARN("[DDR] DMC620 %u PMU snapshot timeout", channel_idx);
+        return;
+    }
+
+    /* The counters wrap at 32 bits */
+    for (counter = 0; counter < DMC620_COUNTER_COUNT; counter++) {
+        delta[counter] = value[counter] - channel->last[counter];
+        channel->last[counter] = value[counter];
+    }
+
+    telemetry = &channel->telemetry;
+    telemetry->cycles += delta[DMC620_COUNTER_CYCLES];
+    telemetry->accesses += delta[DMC620_COUNTER_ACCESSES];
+    telemetry->read_occupancy += delta[DMC620_COUNTER_READ_DEPTH];
+    telemetry->write_occupancy += delta[DMC620_COUNTER_WRITE_DEPTH];
+
+    /* Bytes per microsecond, i.e. MB/s */
+    bytes = (uint64_t)delta[DMC620_COUNTER_ACCESSES] *
+        dmc620_ctx.config->access_size;
+    telemetry->bandwidth_mbps = (uint32_t)(
+        bytes / ((uint64_t)dmc620_ctx.config->telemetry_period_ms * 1000));
+
+    telemetry->read_queue_avg = queue_average(
+        delta[DMC620_COUNTER_READ_DEPTH], delta[DMC620_COUNTER_CYCLES]);
+    telemetry->write_queue_avg = queue_average(
+        delta[DMC620_COUNTER_WRITE_DEPTH], delta[DMC620_COUNTER_CYCLES]);
+
+    channel->sampled = true;
+}
+
+static void telemetry_publish(void)
+{
+    struct mod_dmc620_telemetry_header *region = dmc620_ctx.region;
+    unsigned int channel_idx;
+
+    if (region == NULL)
+        return;
+
+    region->sequence++;
+    __DMB();
+
+    for (channel_idx = 0; channel_idx < dmc620_ctx.channel_count;
+         channel_idx++) {
+        region->channel[channel_idx] =
+            dmc620_ctx.channel_table[channel_idx].telemetry;
+    }
+
+    __DMB();
+    region->sequence++;
+}
+
+static void telemetry_alarm_callback(uintptr_t param)
+{
+    int status;
+    struct fwk_event event = {
+        .id = dmc620_event_id_sample,
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_DMC620),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_DMC620),
+    };
+
+    /* Skip the period if the previous sample is still queued */
+    if (dmc620_ctx.sample_pending)
+        return;
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_SUCCESS)
+        dmc620_ctx.sample_pending = true;
+}
+
+static int get_channel_ctx(
+    fwk_id_t element_id,
+    struct dmc620_channel_ctx **channel)
+{
+    if ((dmc620_ctx.channel_table == NULL) ||
+        !fwk_module_is_valid_element_id(element_id) ||
+        (fwk_id_get_module_idx(element_id) != FWK_MODULE_IDX_DMC620))
+        return FWK_E_PARAM;
+
+    *channel = &dmc620_ctx.channel_table[fwk_id_get_element_idx(element_id)];
+    if (!(*channel)->sampled)
+        return FWK_E_STATE;
+
+    return FWK_SUCCESS;
+}
+
+static int dmc620_get_channel(
+    fwk_id_t element_id,
+    struct mod_dmc620_telemetry_channel *telemetry)
+{
+    int status;
+    struct dmc620_channel_ctx *channel;
+
+    status = get_channel_ctx(element_id, &channel);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *telemetry = channel->telemetry;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_dmc620_telemetry_api telemetry_api = {
+    .get_channel = dmc620_get_channel,
+};
+
+#ifdef BUILD_HAS_MOD_DVFS_GOVERNOR
+static int dmc620_get_counters(
+    fwk_id_t counter_id,
+    uint64_t *active,
+    uint64_t *total)
+{
+    int status;
+    struct dmc620_channel_ctx *channel;
+
+    status = get_channel_ctx(counter_id, &channel);
+    if (status == FWK_E_STATE) {
+        /* Report an idle channel until the first sample */
+        *active = 0;
+        *total = 0;
+        return FWK_SUCCESS;
+    }
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *total = channel->telemetry.cycles;
+    *active = FWK_MIN(
+        channel->telemetry.accesses * dmc620_ctx.config->access_cycles,
+        *total);
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_dvfs_governor_activity_api activity_api = {
+    .get_counters = dmc620_get_counters,
+};
+#endif
 
 /* Framework API */
 static int mod_dmc620_init(fwk_id_t module_id, unsigned int element_count,
                            const void *config)
 {
+    const struct mod_dmc620_module_config *module_config = config;
+    size_t region_size;
+
+    fwk_assert(module_config != NULL);
+
+    dmc620_ctx.config = module_config;
+
+    if ((module_config->warm_resume_ddr_cmd != NULL) && (element_count != 0)) {
+        dmc620_ctx.resume_table =
+            fwk_mm_calloc(element_count, sizeof(dmc620_ctx.resume_table[0]));
+    }
+
+    if (module_config->telemetry_period_ms == 0)
+        return FWK_SUCCESS;
+
+    if ((module_config->access_size == 0) || (element_count == 0))
+        return FWK_E_PARAM;
+
+    if (module_config->telemetry_region != 0) {
+        region_size = sizeof(struct mod_dmc620_telemetry_header) +
+            (element_count * sizeof(struct mod_dmc620_telemetry_channel));
+        if (module_config->telemetry_region_size < region_size)
+            return FWK_E_NOMEM;
+
+        dmc620_ctx.region = (struct mod_dmc620_telemetry_header *)
+            module_config->telemetry_region;
+    }
+
+    dmc620_ctx.channel_count = element_count;
+    dmc620_ctx.channel_table =
+        fwk_mm_calloc(element_count, sizeof(dmc620_ctx.channel_table[0]));
+
     return FWK_SUCCESS;
 }
 
@@ -65,15 +434,63 @@ static int mod_dmc620_bind(fwk_id_t id, unsigned int round)
             return status;
     }
 
+    if (module_config->telemetry_period_ms != 0) {
+        status = fwk_module_bind(module_config->telemetry_alarm_id,
+                                 MOD_TIMER_API_ID_ALARM,
+                                 &dmc620_ctx.alarm_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int mod_dmc620_process_bind_request(fwk_id_t source_id,
+    fwk_id_t target_id, fwk_id_t api_id, const void **api)
+{
+    switch (fwk_id_get_api_idx(api_id)) {
+    case MOD_DMC620_API_IDX_TELEMETRY:
+        *api = &telemetry_api;
+        break;
+
+#ifdef BUILD_HAS_MOD_DVFS_GOVERNOR
+    case MOD_DMC620_API_IDX_ACTIVITY:
+        *api = &activity_api;
+        break;
+#endif
+
+    default:
+        return FWK_E_PARAM;
+    }
+
     return FWK_SUCCESS;
 }
 
 static int mod_dmc620_start(fwk_id_t id)
 {
     const struct mod_dmc620_element_config *element_config;
-
-    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
-        return FWK_SUCCESS;
+    struct mod_dmc620_telemetry_header *region = dmc620_ctx.region;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
+        if (dmc620_ctx.channel_table == NULL)
+            return FWK_SUCCESS;
+
+        if (region != NULL) {
+            region->signature = MOD_DMC620_TELEMETRY_SIGNATURE;
+            region->revision = MOD_DMC620_TELEMETRY_REVISION;
+            region->channel_count = dmc620_ctx.channel_count;
+            region->sequence = 0;
+            region->period_ms = dmc620_ctx.config->telemetry_period_ms;
+            telemetry_publish();
+        }
+
+        return dmc620_ctx.alarm_api->start(
+            dmc620_ctx.config->telemetry_alarm_id,
+            dmc620_ctx.config->telemetry_period_ms,
+            MOD_TIMER_ALARM_TYPE_PERIODIC,
+            telemetry_alarm_callback,
+            (uintptr_t)0);
+    }
 
     element_config = fwk_module_get_data(id);
 
@@ -84,15 +501,86 @@ static int mod_dmc620_start(fwk_id_t id)
         id);
 }
 
+/*
+ * Take the resume context of a channel, which is only valid for one resume.
+ */
+static bool take_resume_context(
+    unsigned int channel_idx,
+    struct mod_dmc620_reg *dmc)
+{
+    struct dmc620_resume_ctx *resume;
+    bool is_valid;
+
+    if (dmc620_ctx.resume_table == NULL)
+        return false;
+
+    resume = &dmc620_ctx.resume_table[channel_idx];
+    is_valid =
+        (resume->signature == DMC620_RESUME_SIGNATURE) && (resume->dmc == dmc);
+
+    resume->signature = 0;
+
+    return is_valid;
+}
+
+static void save_resume_context(unsigned int channel_idx)
+{
+    struct dmc620_resume_ctx *resume;
+
+    if (dmc620_ctx.resume_table == NULL)
+        return;
+
+    resume = &dmc620_ctx.resume_table[channel_idx];
+    if (!resume->is_configured)
+        return;
+
+    resume->dmc = channel_dmc(channel_idx);
+    resume->signature = DMC620_RESUME_SIGNATURE;
+    resume->is_configured = false;
+}
+
+/*
+ * Resume a channel whose DRAM was kept in self-refresh, without configuring
+ * the DDR PHY or initializing the DRAM again.
+ */
+static void dmc620_warm_resume(struct mod_dmc620_reg *dmc)
+{
+    const struct mod_dmc620_reg *reg_val = dmc620_ctx.config->dmc_val;
+
+    dmc620_write_functional_settings(dmc, reg_val);
+    dmc620_write_timing_settings(dmc, reg_val);
+    dmc->ERR0CTLR0 = reg_val->ERR0CTLR0;
+
+    dmc620_ctx.config->warm_resume_ddr_cmd(dmc);
+
+    dmc620_set_ready(dmc);
+}
+
 static int dmc620_notify_system_state_transition_resume(fwk_id_t id)
 {
+    int status;
+    unsigned int channel_idx;
     struct mod_dmc620_reg *dmc;
     const struct mod_dmc620_element_config *element_config;
 
     element_config = fwk_module_get_data(id);
     dmc = (struct mod_dmc620_reg *)element_config->dmc;
+    channel_idx = fwk_id_get_element_idx(id);
+
+    if (take_resume_context(channel_idx, dmc))
+        dmc620_warm_resume(dmc);
+    else {
+        status = dmc620_config(dmc, element_config->ddr_id);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    if (dmc620_ctx.resume_table != NULL)
+        dmc620_ctx.resume_table[channel_idx].is_configured = true;
 
-    return dmc620_config(dmc, element_config->ddr_id);
+    telemetry_start(channel_idx);
+
+    return FWK_SUCCESS;
 }
 
 static int mod_dmc620_process_notification(
@@ -110,6 +598,34 @@ static int mod_dmc620_process_notification(
     if (params->new_state == MOD_CLOCK_STATE_RUNNING)
         return dmc620_notify_system_state_transition_resume(event->target_id);
 
+    /* Stop sampling the channel until it is configured again */
+    if (dmc620_ctx.channel_table != NULL) {
+        dmc620_ctx.channel_table[fwk_id_get_element_idx(event->target_id)]
+            .running = false;
+    }
+
+    save_resume_context(fwk_id_get_element_idx(event->target_id));
+
+    return FWK_SUCCESS;
+}
+
+static int mod_dmc620_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    unsigned int channel_idx;
+
+    if (!fwk_id_is_equal(event->id, dmc620_event_id_sample))
+        return FWK_E_PARAM;
+
+    dmc620_ctx.sample_pending = false;
+
+    for (channel_idx = 0; channel_idx < dmc620_ctx.channel_count;
+         channel_idx++)
+        telemetry_sample_channel(channel_idx);
+
+    telemetry_publish();
+
     return FWK_SUCCESS;
 }
 
@@ -121,23 +637,16 @@ const struct fwk_module module_dmc620 = {
     .bind = mod_dmc620_bind,
     .start = mod_dmc620_start,
     .process_notification = mod_dmc620_process_notification,
-    .api_count = 0,
-    .event_count = 0,
+    .process_bind_request = mod_dmc620_process_bind_request,
+    .process_event = mod_dmc620_process_event,
+    .api_count = MOD_DMC620_API_IDX_COUNT,
+    .event_count = DMC620_EVENT_IDX_COUNT,
 };
 
-static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
+static void dmc620_write_functional_settings(
+    struct mod_dmc620_reg *dmc,
+    const struct mod_dmc620_reg *reg_val)
 {
-    int i;
-    struct mod_dmc620_reg *reg_val;
-    const struct mod_dmc620_module_config *module_config;
-
-    module_config = fwk_module_get_data(fwk_module_id_dmc620);
-    reg_val = module_config->dmc_val;
-
-    FWK_LOG_INFO("[DDR] Initialising DMC620 at 0x%x", (uintptr_t)dmc);
-
-    FWK_LOG_INFO("[DDR] Writing functional settings");
-
     dmc->ADDRESS_CONTROL_NEXT = reg_val->ADDRESS_CONTROL_NEXT;
 
     dmc->DECODE_CONTROL_NEXT = reg_val->DECODE_CONTROL_NEXT;
@@ -201,10 +710,12 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     dmc->FEATURE_CONFIG = reg_val->FEATURE_CONFIG;
     dmc->FEATURE_CONTROL_NEXT = reg_val->FEATURE_CONTROL_NEXT;
     dmc->MUX_CONTROL_NEXT = reg_val->MUX_CONTROL_NEXT;
+}
 
-    /* Timing Configuration */
-    FWK_LOG_INFO("[DDR] Writing timing settings");
-
+static void dmc620_write_timing_settings(
+    struct mod_dmc620_reg *dmc,
+    const struct mod_dmc620_reg *reg_val)
+{
     dmc->T_REFI_NEXT = reg_val->T_REFI_NEXT;
     dmc->T_RFC_NEXT = reg_val->T_RFC_NEXT;
     dmc->T_MRR_NEXT = reg_val->T_MRR_NEXT;
@@ -253,6 +764,36 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     dmc->ODT_WR_CONTROL_63_32_NEXT = reg_val->ODT_WR_CONTROL_63_32_NEXT;
     dmc->ODT_RD_CONTROL_31_00_NEXT = reg_val->ODT_RD_CONTROL_31_00_NEXT;
     dmc->ODT_RD_CONTROL_63_32_NEXT = reg_val->ODT_RD_CONTROL_63_32_NEXT;
+}
+
+static void dmc620_set_ready(struct mod_dmc620_reg *dmc)
+{
+    dmc->MEMC_CMD = MOD_DMC620_MEMC_CMD_GO;
+    dmc->MEMC_CMD = MOD_DMC620_MEMC_CMD_EXECUTE;
+
+    while ((dmc->MEMC_STATUS & MOD_DMC620_MEMC_CMD) != MOD_DMC620_MEMC_CMD_GO)
+        continue;
+}
+
+static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
+{
+    int i;
+    struct mod_dmc620_reg *reg_val;
+    const struct mod_dmc620_module_config *module_config;
+
+    module_config = fwk_module_get_data(fwk_module_id_dmc620);
+    reg_val = module_config->dmc_val;
+
+    FWK_LOG_INFO("[DDR] Initialising DMC620 at 0x%x", (uintptr_t)dmc);
+
+    FWK_LOG_INFO("[DDR] Writing functional settings");
+
+    dmc620_write_functional_settings(dmc, reg_val);
+
+    /* Timing Configuration */
+    FWK_LOG_INFO("[DDR] Writing timing settings");
+
+    dmc620_write_timing_settings(dmc, reg_val);
 
     /* Enable RAS interrupts and error detection */
     dmc->ERR0CTLR0 = reg_val->ERR0CTLR0;
@@ -273,11 +814,7 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     /* Switch to READY */
     FWK_LOG_INFO("[DDR] Setting DMC to READY mode");
 
-    dmc->MEMC_CMD = MOD_DMC620_MEMC_CMD_GO;
-    dmc->MEMC_CMD = MOD_DMC620_MEMC_CMD_EXECUTE;
-
-    while ((dmc->MEMC_STATUS & MOD_DMC620_MEMC_CMD) != MOD_DMC620_MEMC_CMD_GO)
-        continue;
+    dmc620_set_ready(dmc);
 
     FWK_LOG_INFO("[DDR] DMC init done.");
 
@@ -12,6 +12,7 @@
 #include <fwk_macros.h>
 #include <fwk_module_idx.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -44,6 +45,45 @@ struct mod_dvfs_opp {
     uint32_t power; /*!< Power draw in milliwatts (mW) */
 };
 
+/*!
+ * \brief Measured transition latencies.
+ *
+ * \details Only the successful transitions that changed the voltage or the
+ *      frequency of the domain are measured.
+ */
+struct mod_dvfs_latency_stats {
+    /*! Latency of the last transition in microseconds */
+    uint32_t last_us;
+
+    /*! Time spent setting the voltage in the last transition */
+    uint32_t last_voltage_us;
+
+    /*! Time spent setting the frequency in the last transition */
+    uint32_t last_frequency_us;
+
+    /*! 95th percentile of the latency over the recent transitions */
+    uint32_t p95_us;
+
+    /*! Number of transitions the percentile is computed over */
+    uint32_t sample_count;
+};
+
+/*!
+ * \brief Boost credits.
+ *
+ * \details See \ref mod_dvfs_domain_config::boost_credit_ms.
+ */
+struct mod_dvfs_boost_credits {
+    /*! Credits left in milliseconds */
+    uint32_t credit_ms;
+
+    /*! Capacity of the credits in milliseconds */
+    uint32_t capacity_ms;
+
+    /*! The credits ran out and the levels are limited to the sustained one */
+    bool exhausted;
+};
+
 /*!
  * \}
  */
@@ -60,6 +100,11 @@ struct mod_dvfs_domain_config {
     /*!
      * \brief Power supply identifier.
      *
+     * \details Domains with the same power supply share its voltage rail. The
+     *      rail is kept at the highest voltage required by its domains and
+     *      only one of them changes it at a time. The frequency changes of
+     *      the other domains that fit under the rail carry on meanwhile.
+     *
      * \warning This identifier must refer to an element of the \c psu module.
      */
     fwk_id_t psu_id;
@@ -94,9 +139,68 @@ struct mod_dvfs_domain_config {
     /*! Worst-case transition latency in microseconds */
     uint16_t latency;
 
+    /*!
+     * \brief Largest voltage increase applied in one step, in millivolts.
+     *
+     * \details Transitions raising the voltage by more than this are split
+     *      into steps through the intermediate operating points. The frequency
+     *      is raised after each voltage step instead of once the whole
+     *      voltage ramp has completed.
+     *
+     * \note When 0, transitions are always applied in one step.
+     */
+    uint32_t max_voltage_step;
+
+    /*!
+     * \brief Voltage resynchronization period.
+     *
+     * \details The voltage last applied to the power supply is trusted by the
+     *      set operating point requests, so the power supply is only accessed
+     *      when the voltage has to change. After this number of requests of
+     *      the domain the voltage is read back from the power supply again.
+     *
+     * \note When 0, the voltage is only read back after a failed request.
+     */
+    uint16_t voltage_resync_period;
+
     /*! Sustained operating point index */
     size_t sustained_idx;
 
+    /*!
+     * \brief Capacity of the boost credits in milliseconds.
+     *
+     * \details The operating points above the sustained one are boost
+     *      operating points. The time spent at a boost operating point
+     *      consumes the credits, and the time spent at or below the sustained
+     *      operating point refills them at the same rate, up to their
+     *      capacity. Once the credits run out, the level limits are lowered
+     *      to the sustained level, and reported through the updates API, until
+     *      \ref mod_dvfs_domain_config::boost_resume_ms have been refilled.
+     *
+     * \note When 0, the time spent at the boost operating points is not
+     *      limited.
+     */
+    uint32_t boost_credit_ms;
+
+    /*!
+     * \brief Credits in milliseconds from which the boost operating points
+     *      are allowed again once the credits have run out.
+     *
+     * \note When 0, they are allowed again once the credits are full.
+     */
+    uint32_t boost_resume_ms;
+
+    /*!
+     * \brief Identifier of the alarm accounting the boost credits.
+     *
+     * \details Only used when \ref mod_dvfs_domain_config::boost_credit_ms is
+     *      not 0.
+     *
+     * \warning This identifier must refer to an alarm of the \c timer module
+     *      other than \ref mod_dvfs_domain_config::alarm_id.
+     */
+    fwk_id_t boost_alarm_id;
+
     /*!
      * \brief Operating points.
      *
@@ -111,6 +215,16 @@ struct mod_dvfs_domain_config {
      *      is possible, otherwise it will set the highest possible.
      */
     bool approximate_level;
+
+    /*!
+     * \brief Report the measured transition latency.
+     *
+     * \details When true, \ref mod_dvfs_domain_api::get_latency returns the
+     *      95th percentile of the measured transition latencies once at least
+     *      one transition has been measured. The static \ref latency is
+     *      returned until then.
+     */
+    bool measured_latency;
 };
 
 /*!
@@ -181,6 +295,16 @@ struct mod_dvfs_domain_api {
      */
     int (*get_latency)(fwk_id_t domain_id, uint16_t *latency);
 
+    /*!
+     * \brief Get the measured transition latencies of a domain.
+     *
+     * \param domain_id Element identifier of the domain.
+     * \param [out] stats Measured transition latencies.
+     */
+    int (*get_latency_stats)(
+        fwk_id_t domain_id,
+        struct mod_dvfs_latency_stats *stats);
+
     /*!
      * \brief Set the level of a domain.
      *
@@ -211,6 +335,20 @@ struct mod_dvfs_domain_api {
         fwk_id_t domain_id,
         uintptr_t cookie,
         const struct mod_dvfs_level_limits *limits);
+
+    /*!
+     * \brief Get the boost credits of a domain.
+     *
+     * \param domain_id Element identifier of the domain.
+     * \param [out] credits Boost credits.
+     *
+     * \retval ::FWK_SUCCESS The credits were returned.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_SUPPORT The domain has no boost credits.
+     */
+    int (*get_boost_credits)(
+        fwk_id_t domain_id,
+        struct mod_dvfs_boost_credits *credits);
 };
 
 /*!
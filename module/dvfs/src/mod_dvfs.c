@@ -15,23 +15,33 @@
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_signal.h>
 #include <fwk_status.h>
 #include <fwk_thread.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /*
  * Maximum number of attempts to complete a request
  */
 #define DVFS_MAX_RETRIES 4
 
+/*
+ * Number of transitions the latency percentile is computed over
+ */
+#define DVFS_LATENCY_SAMPLE_COUNT 16
+
 enum mod_dvfs_internal_event_idx {
     /* retry request */
     MOD_DVFS_INTERNAL_EVENT_IDX_RETRY = MOD_DVFS_EVENT_IDX_COUNT,
+    /* account the boost credits */
+    MOD_DVFS_INTERNAL_EVENT_IDX_BOOST,
     MOD_DVFS_INTERNAL_EVENT_IDX_COUNT,
 };
 
@@ -39,6 +49,10 @@ enum mod_dvfs_internal_event_idx {
 static const fwk_id_t mod_dvfs_event_id_retry =
     FWK_ID_EVENT_INIT(FWK_MODULE_IDX_DVFS, MOD_DVFS_INTERNAL_EVENT_IDX_RETRY);
 
+/* Boost credits accounting event identifier */
+static const fwk_id_t mod_dvfs_event_id_boost =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_DVFS, MOD_DVFS_INTERNAL_EVENT_IDX_BOOST);
+
 enum mod_dvfs_signal_idx {
     /* set level signal */
     MOD_DVFS_SIGNAL_IDX_SET,
@@ -102,6 +116,68 @@ struct mod_dvfs_request {
     uint8_t num_retries;
 };
 
+/*!
+ * \brief Transition latency measurement.
+ */
+struct mod_dvfs_latency_ctx {
+    /* Start of the transition in progress */
+    fwk_timestamp_t start;
+
+    /* Start of the voltage or frequency phase in progress */
+    fwk_timestamp_t phase_start;
+
+    /* Time spent in the phases of the transition in progress */
+    uint32_t voltage_us;
+    uint32_t frequency_us;
+
+    /* The transition in progress has changed the voltage or the frequency */
+    bool measured;
+
+    /* Latencies of the last measured transition */
+    uint32_t last_us;
+    uint32_t last_voltage_us;
+    uint32_t last_frequency_us;
+
+    /* Latencies of the recent transitions, oldest first once wrapped */
+    uint32_t samples[DVFS_LATENCY_SAMPLE_COUNT];
+    unsigned int sample_next;
+    unsigned int sample_count;
+};
+
+/*!
+ * \brief Boost credits accounting.
+ */
+struct mod_dvfs_boost_ctx {
+    /* Credits left in microseconds at the last accounting */
+    uint32_t credit_us;
+
+    /* Time of the last accounting */
+    fwk_timestamp_t timestamp;
+
+    /* The domain has been above its sustained level since then */
+    bool boosting;
+
+    /* The credits ran out, the levels are limited to the sustained level */
+    bool exhausted;
+};
+
+/*!
+ * \brief Voltage rail context, shared by the domains of a power supply.
+ */
+struct mod_dvfs_rail_ctx {
+    /* Power supply of the rail */
+    fwk_id_t psu_id;
+
+    /* Voltage last applied to or read from the rail, 0 when unknown */
+    uint32_t voltage;
+
+    /* Domain changing the voltage of the rail, NULL when none */
+    struct mod_dvfs_domain_ctx *owner;
+
+    /* Voltage being applied by the owner */
+    uint32_t target;
+};
+
 /*!
  * \brief Domain context.
  */
@@ -129,6 +205,12 @@ struct mod_dvfs_domain_ctx {
     /* Number of operating points */
     size_t opp_count;
 
+    /*
+     * Difference between consecutive levels when the levels are evenly
+     * spaced, 0 otherwise
+     */
+    uint32_t level_step;
+
     /* Current operating point */
     struct mod_dvfs_opp current_opp;
 
@@ -149,6 +231,27 @@ struct mod_dvfs_domain_ctx {
 
     /* SET_OPP Request is pending for this domain */
     bool request_pending;
+
+    /* Voltage rail of the domain */
+    struct mod_dvfs_rail_ctx *rail;
+
+    /* SET_OPP is waiting for another domain to release the rail */
+    bool rail_waiting;
+
+    /* SET_OPP is stepping through intermediate operating points */
+    bool plan_active;
+
+    /* Final operating point of the SET_OPP stepping through the plan */
+    struct mod_dvfs_opp plan_opp;
+
+    /* Number of SET_OPP requests served with the cached voltage */
+    uint16_t voltage_cached_count;
+
+    /* Transition latency measurement */
+    struct mod_dvfs_latency_ctx latency;
+
+    /* Boost credits accounting */
+    struct mod_dvfs_boost_ctx boost;
 };
 
 static struct mod_dvfs_ctx {
@@ -160,6 +263,12 @@ static struct mod_dvfs_ctx {
 
     /* DVFS device context table */
     struct mod_dvfs_domain_ctx (*domain_ctx)[];
+
+    /* Number of voltage rails */
+    uint32_t rail_count;
+
+    /* Voltage rail context table */
+    struct mod_dvfs_rail_ctx (*rail_ctx)[];
 } dvfs_ctx;
 
 /*
@@ -185,26 +294,57 @@ static int count_opps(const struct mod_dvfs_opp *opps)
     return opp - &opps[0];
 }
 
-static const struct mod_dvfs_opp *get_opp_for_level(
+/*
+ * Index of the first operating point whose level is not lower than the given
+ * level, or opp_count if there is none. The levels are in ascending order, so
+ * the index is computed when they are evenly spaced and bisected otherwise.
+ */
+static size_t get_opp_idx_for_level(
     const struct mod_dvfs_domain_ctx *ctx,
     uint32_t level)
 {
-    size_t opp_idx;
-    const struct mod_dvfs_opp *opp;
+    const struct mod_dvfs_opp *opps = ctx->config->opps;
+    size_t low, high, mid;
+
+    if (level <= opps[0].level)
+        return 0;
+
+    if (level > opps[ctx->opp_count - 1].level)
+        return ctx->opp_count;
+
+    if (ctx->level_step != 0)
+        return (level - opps[0].level + ctx->level_step - 1) / ctx->level_step;
+
+    low = 0;
+    high = ctx->opp_count - 1;
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (opps[mid].level < level)
+            low = mid + 1;
+        else
+            high = mid;
+    }
 
-    for (opp_idx = 0; opp_idx < ctx->opp_count; opp_idx++) {
-        opp = &ctx->config->opps[opp_idx];
+    return low;
+}
 
-        if (ctx->config->approximate_level && (opp->level < level))
-            continue;
-        else if (opp->level != level)
-            continue;
+static const struct mod_dvfs_opp *get_opp_for_level(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uint32_t level)
+{
+    size_t opp_idx = get_opp_idx_for_level(ctx, level);
 
-        return opp;
+    if (opp_idx == ctx->opp_count) {
+        if (ctx->config->approximate_level)
+            return &ctx->config->opps[ctx->opp_count - 1];
+        return NULL;
     }
-    if (ctx->config->approximate_level)
-        return &ctx->config->opps[ctx->opp_count - 1];
-    return NULL;
+
+    if (!ctx->config->approximate_level &&
+        (ctx->config->opps[opp_idx].level != level))
+        return NULL;
+
+    return &ctx->config->opps[opp_idx];
 }
 
 static const struct mod_dvfs_opp *get_opp_for_voltage(
@@ -249,6 +389,15 @@ static bool are_limits_valid(
     return true;
 }
 
+static bool is_same_opp(
+    const struct mod_dvfs_opp *opp,
+    const struct mod_dvfs_opp *other)
+{
+    return (opp->level == other->level) &&
+        (opp->frequency == other->frequency) &&
+        (opp->voltage == other->voltage);
+}
+
 static const struct mod_dvfs_opp *adjust_opp_for_new_limits(
     const struct mod_dvfs_domain_ctx *ctx,
     const struct mod_dvfs_opp *opp,
@@ -268,6 +417,41 @@ static const struct mod_dvfs_opp *adjust_opp_for_new_limits(
     return get_opp_for_level(ctx, needle);
 }
 
+/*
+ * Level limits in force, the requested ones lowered to the sustained level
+ * while the boost credits are exhausted.
+ */
+static void get_effective_limits(
+    const struct mod_dvfs_domain_ctx *ctx,
+    const struct mod_dvfs_level_limits *requested,
+    struct mod_dvfs_level_limits *limits)
+{
+    uint32_t sustained_level;
+
+    *limits = *requested;
+
+    if (!ctx->boost.exhausted)
+        return;
+
+    sustained_level = ctx->config->opps[ctx->config->sustained_idx].level;
+    limits->maximum = FWK_MIN(limits->maximum, sustained_level);
+    limits->minimum = FWK_MIN(limits->minimum, limits->maximum);
+}
+
+static void notify_limits_updated(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uintptr_t cookie)
+{
+    struct mod_dvfs_level_limits limits;
+
+    if (ctx->apis.perf_updated_api == NULL)
+        return;
+
+    get_effective_limits(ctx, &ctx->level_limits, &limits);
+    ctx->apis.perf_updated_api->notify_limits_updated(
+        ctx->domain_id, cookie, limits.minimum, limits.maximum);
+}
+
 /*
  * Helper to create events to process requests asynchronously
  */
@@ -282,6 +466,7 @@ static int put_event_request(
         .target_id = ctx->domain_id,
         .id = event_id,
         .response_requested = ctx->request.response_required,
+        .priority = FWK_EVENT_PRIORITY_HIGH,
     };
 
     if (ctx->request.set_source_id)
@@ -292,6 +477,187 @@ static int put_event_request(
     return fwk_thread_put_event(&req);
 }
 
+/*
+ * Voltage rail handling
+ */
+static struct mod_dvfs_rail_ctx *dvfs_rail_get(fwk_id_t psu_id)
+{
+    struct mod_dvfs_rail_ctx *rail;
+    uint32_t idx;
+
+    for (idx = 0; idx < dvfs_ctx.rail_count; idx++) {
+        rail = &(*dvfs_ctx.rail_ctx)[idx];
+        if (fwk_id_is_equal(rail->psu_id, psu_id))
+            return rail;
+    }
+
+    rail = &(*dvfs_ctx.rail_ctx)[dvfs_ctx.rail_count++];
+    rail->psu_id = psu_id;
+
+    return rail;
+}
+
+/*
+ * Voltage the rail must provide for the request of a domain, the highest of
+ * the voltage it requests and of the voltages the other domains of the rail
+ * run at or are moving to.
+ */
+static uint32_t dvfs_rail_target(const struct mod_dvfs_domain_ctx *ctx)
+{
+    const struct mod_dvfs_domain_ctx *member;
+    uint32_t target = ctx->request.new_opp.voltage;
+    uint32_t idx;
+
+    for (idx = 0; idx < dvfs_ctx.dvfs_domain_element_count; idx++) {
+        member = &(*dvfs_ctx.domain_ctx)[idx];
+        if ((member == ctx) || (member->rail != ctx->rail))
+            continue;
+
+        target = FWK_MAX(target, member->current_opp.voltage);
+        if (member->state == DVFS_DOMAIN_SET_OPP ||
+            member->state == DVFS_DOMAIN_SET_VOLTAGE ||
+            member->state == DVFS_DOMAIN_SET_FREQUENCY ||
+            member->state == DVFS_DOMAIN_SET_OPP_DONE)
+            target = FWK_MAX(target, member->request.new_opp.voltage);
+    }
+
+    return target;
+}
+
+/*
+ * The owner of the rail has completed its request, the domains waiting for
+ * the rail start their requests again.
+ */
+static void dvfs_rail_release(
+    struct mod_dvfs_domain_ctx *ctx,
+    int req_status)
+{
+    struct mod_dvfs_rail_ctx *rail = ctx->rail;
+    struct mod_dvfs_domain_ctx *member;
+    uint32_t idx;
+    int status;
+
+    if (rail->owner != ctx)
+        return;
+
+    rail->owner = NULL;
+
+    /* The voltage left by a failed request is unknown */
+    if (req_status != FWK_SUCCESS)
+        rail->voltage = 0;
+
+    for (idx = 0; idx < dvfs_ctx.dvfs_domain_element_count; idx++) {
+        member = &(*dvfs_ctx.domain_ctx)[idx];
+        if ((member->rail != rail) || !member->rail_waiting)
+            continue;
+
+        member->rail_waiting = false;
+        status =
+            put_event_request(member, mod_dvfs_event_id_set, member->state);
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_ERR(
+                "[DVFS] %s: failed to restart request",
+                fwk_module_get_name(member->domain_id));
+        }
+    }
+}
+
+/*
+ * Transition latency measurement
+ */
+static uint32_t dvfs_latency_since(fwk_timestamp_t timestamp)
+{
+    return (uint32_t)FWK_MIN(
+        fwk_time_duration_us(fwk_time_stamp_duration(timestamp)), UINT32_MAX);
+}
+
+static void dvfs_latency_phase_start(struct mod_dvfs_domain_ctx *ctx)
+{
+    ctx->latency.phase_start = fwk_time_current();
+    ctx->latency.measured = true;
+}
+
+static void dvfs_latency_phase_end(
+    struct mod_dvfs_domain_ctx *ctx,
+    uint32_t *phase_us)
+{
+    *phase_us += dvfs_latency_since(ctx->latency.phase_start);
+}
+
+static void dvfs_latency_record(struct mod_dvfs_domain_ctx *ctx)
+{
+    struct mod_dvfs_latency_ctx *latency = &ctx->latency;
+
+    if (!latency->measured)
+        return;
+
+    latency->measured = false;
+    latency->last_us = dvfs_latency_since(latency->start);
+    latency->last_voltage_us = latency->voltage_us;
+    latency->last_frequency_us = latency->frequency_us;
+
+    latency->samples[latency->sample_next] = latency->last_us;
+    latency->sample_next = (latency->sample_next + 1) %
+        DVFS_LATENCY_SAMPLE_COUNT;
+    if (latency->sample_count < DVFS_LATENCY_SAMPLE_COUNT)
+        latency->sample_count++;
+}
+
+/*
+ * 95th percentile of the recent transition latencies, using the nearest-rank
+ * method.
+ */
+static uint32_t dvfs_latency_p95(const struct mod_dvfs_domain_ctx *ctx)
+{
+    uint32_t sorted[DVFS_LATENCY_SAMPLE_COUNT];
+    unsigned int count = ctx->latency.sample_count;
+    unsigned int i, j;
+    uint32_t sample;
+
+    if (count == 0)
+        return 0;
+
+    for (i = 0; i < count; i++) {
+        sample = ctx->latency.samples[i];
+        for (j = i; (j > 0) && (sorted[j - 1] > sample); j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = sample;
+    }
+
+    return sorted[((count * 95) + 99) / 100 - 1];
+}
+
+static int dvfs_set_voltage(struct mod_dvfs_domain_ctx *ctx)
+{
+    int status;
+
+    dvfs_latency_phase_start(ctx);
+    status =
+        ctx->apis.psu->set_voltage(ctx->config->psu_id, ctx->rail->target);
+    if (status != FWK_PENDING)
+        dvfs_latency_phase_end(ctx, &ctx->latency.voltage_us);
+
+    if (status == FWK_SUCCESS)
+        ctx->rail->voltage = ctx->rail->target;
+
+    return status;
+}
+
+static int dvfs_set_frequency(struct mod_dvfs_domain_ctx *ctx)
+{
+    int status;
+
+    dvfs_latency_phase_start(ctx);
+    status = ctx->apis.clock->set_rate(
+        ctx->config->clock_id,
+        (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
+        MOD_CLOCK_ROUND_MODE_NONE);
+    if (status != FWK_PENDING)
+        dvfs_latency_phase_end(ctx, &ctx->latency.frequency_us);
+
+    return status;
+}
+
 static int dvfs_set_level_start(
     struct mod_dvfs_domain_ctx *ctx,
     uintptr_t cookie,
@@ -301,6 +667,11 @@ static int dvfs_set_level_start(
 {
     int status;
 
+    ctx->latency.start = fwk_time_current();
+    ctx->latency.voltage_us = 0;
+    ctx->latency.frequency_us = 0;
+    ctx->latency.measured = false;
+
     ctx->request.cookie = cookie, ctx->request.new_opp = *new_opp;
     ctx->request.retry_request = retry_request;
     ctx->request.response_required = false;
@@ -320,18 +691,69 @@ static int dvfs_set_level_start(
 /*
  * Handle pending requests
  */
-static void dvfs_flush_pending_request(struct mod_dvfs_domain_ctx *ctx)
+
+/*
+ * Final operating point of the transition in progress, if any.
+ */
+static const struct mod_dvfs_opp *dvfs_inflight_opp(
+    const struct mod_dvfs_domain_ctx *ctx)
+{
+    switch (ctx->state) {
+    case DVFS_DOMAIN_SET_OPP:
+    case DVFS_DOMAIN_SET_VOLTAGE:
+    case DVFS_DOMAIN_SET_FREQUENCY:
+    case DVFS_DOMAIN_SET_OPP_DONE:
+        return ctx->plan_active ? &ctx->plan_opp : &ctx->request.new_opp;
+
+    default:
+        return NULL;
+    }
+}
+
+/*
+ * The pending request, merged with the limits set since it was made, leads
+ * to the current operating point and can be dropped.
+ */
+static bool dvfs_pending_request_is_current(struct mod_dvfs_domain_ctx *ctx)
+{
+    const struct mod_dvfs_opp *opp;
+    struct mod_dvfs_level_limits limits;
+
+    get_effective_limits(ctx, &ctx->level_limits, &limits);
+    opp = adjust_opp_for_new_limits(
+        ctx, &ctx->pending_request.new_opp, &limits);
+    if (opp == NULL)
+        return false;
+
+    ctx->pending_request.new_opp = *opp;
+
+    return is_same_opp(opp, &ctx->current_opp);
+}
+
+static int dvfs_start_pending_request(struct mod_dvfs_domain_ctx *ctx)
 {
+    int status = FWK_SUCCESS;
+
+    ctx->request.set_source_id = false;
+
     if (ctx->request_pending) {
         ctx->request_pending = false;
-        dvfs_set_level_start(
-            ctx,
-            ctx->pending_request.cookie,
-            &ctx->pending_request.new_opp,
-            ctx->pending_request.retry_request,
-            ctx->pending_request.num_retries);
+
+        if (dvfs_pending_request_is_current(ctx)) {
+            ctx->request = (struct mod_dvfs_request){ 0 };
+            ctx->state = DVFS_DOMAIN_STATE_IDLE;
+        } else {
+            status = dvfs_set_level_start(
+                ctx,
+                ctx->pending_request.cookie,
+                &ctx->pending_request.new_opp,
+                ctx->pending_request.retry_request,
+                ctx->pending_request.num_retries);
+        }
     }
     ctx->pending_request = (struct mod_dvfs_request){ 0 };
+
+    return status;
 }
 
 static void alarm_callback(uintptr_t param)
@@ -348,6 +770,7 @@ static void alarm_callback(uintptr_t param)
             .source_id = ctx->domain_id,
             .id = mod_dvfs_event_id_retry,
             .response_requested = ctx->pending_request.response_required,
+            .priority = FWK_EVENT_PRIORITY_HIGH,
         };
 
         fwk_thread_put_event(&req);
@@ -375,7 +798,7 @@ static int dvfs_handle_pending_request(struct mod_dvfs_domain_ctx *ctx)
          * If this domain does not have a timeout configured we start
          * processing the request immediately.
          */
-        dvfs_flush_pending_request(ctx);
+        dvfs_start_pending_request(ctx);
     }
     return status;
 }
@@ -386,6 +809,19 @@ static int dvfs_create_pending_level_request(
     const struct mod_dvfs_opp *new_opp,
     bool retry_request)
 {
+    const struct mod_dvfs_opp *inflight_opp = dvfs_inflight_opp(ctx);
+
+    /*
+     * The transition in progress already leads to the requested operating
+     * point, its completion also completes this request.
+     */
+    if ((inflight_opp != NULL) && is_same_opp(new_opp, inflight_opp)) {
+        ctx->request_pending = false;
+        ctx->pending_request = (struct mod_dvfs_request){ 0 };
+        ctx->request.cookie = cookie;
+        return FWK_SUCCESS;
+    }
+
     if (ctx->request_pending) {
         if ((new_opp->frequency == ctx->pending_request.new_opp.frequency) &&
             (new_opp->voltage == ctx->pending_request.new_opp.voltage))
@@ -413,6 +849,120 @@ static int dvfs_create_pending_level_request(
     return FWK_SUCCESS;
 }
 
+/*
+ * Boost credits accounting
+ */
+
+/*
+ * Credits left now, from those left at the last accounting.
+ */
+static uint32_t dvfs_boost_credit(const struct mod_dvfs_domain_ctx *ctx)
+{
+    const struct mod_dvfs_boost_ctx *boost = &ctx->boost;
+    uint32_t elapsed_us = dvfs_latency_since(boost->timestamp);
+
+    if (boost->boosting)
+        return boost->credit_us - FWK_MIN(elapsed_us, boost->credit_us);
+
+    return (uint32_t)FWK_MIN(
+        (uint64_t)boost->credit_us + elapsed_us,
+        (uint64_t)ctx->config->boost_credit_ms * 1000);
+}
+
+static void boost_alarm_callback(uintptr_t param)
+{
+    struct mod_dvfs_domain_ctx *ctx = (struct mod_dvfs_domain_ctx *)param;
+    struct fwk_event req;
+
+    req = (struct fwk_event){
+        .target_id = ctx->domain_id,
+        .source_id = ctx->domain_id,
+        .id = mod_dvfs_event_id_boost,
+    };
+
+    fwk_thread_put_event(&req);
+}
+
+/*
+ * Bring a domain exhausting its boost credits down to the sustained level,
+ * once the transition in progress, if any, has completed.
+ */
+static void dvfs_boost_clamp(struct mod_dvfs_domain_ctx *ctx)
+{
+    struct mod_dvfs_level_limits limits;
+    const struct mod_dvfs_opp *opp;
+
+    get_effective_limits(ctx, &ctx->level_limits, &limits);
+    opp = adjust_opp_for_new_limits(ctx, &ctx->current_opp, &limits);
+    if ((opp == NULL) || is_same_opp(opp, &ctx->current_opp))
+        return;
+
+    if (ctx->state != DVFS_DOMAIN_STATE_IDLE) {
+        dvfs_create_pending_level_request(ctx, 0, opp, true);
+        return;
+    }
+
+    ctx->request.set_source_id = false;
+    dvfs_set_level_start(ctx, 0, opp, true, 0);
+}
+
+/*
+ * Account the time spent since the last accounting against the boost credits,
+ * limit the domain to its sustained level when they have run out and lift the
+ * limit once enough of them have been refilled. The alarm is then set for the
+ * next of these changes.
+ */
+static void dvfs_boost_update(struct mod_dvfs_domain_ctx *ctx)
+{
+    struct mod_dvfs_boost_ctx *boost = &ctx->boost;
+    uint32_t capacity_us = ctx->config->boost_credit_ms * 1000;
+    uint32_t resume_us = ctx->config->boost_resume_ms * 1000;
+    uint32_t sustained_level;
+    uint32_t delay_us = 0;
+    bool exhausted = boost->exhausted;
+
+    if (ctx->config->boost_credit_ms == 0)
+        return;
+
+    if ((resume_us == 0) || (resume_us > capacity_us))
+        resume_us = capacity_us;
+
+    sustained_level = ctx->config->opps[ctx->config->sustained_idx].level;
+
+    boost->credit_us = dvfs_boost_credit(ctx);
+    boost->timestamp = fwk_time_current();
+    boost->boosting = ctx->current_opp.level > sustained_level;
+
+    if (boost->credit_us == 0)
+        exhausted = true;
+    else if (boost->credit_us >= resume_us)
+        exhausted = false;
+
+    if (exhausted != boost->exhausted) {
+        boost->exhausted = exhausted;
+        notify_limits_updated(ctx, 0);
+    }
+
+    if (boost->exhausted) {
+        if (boost->boosting)
+            dvfs_boost_clamp(ctx);
+        delay_us = resume_us - boost->credit_us;
+    } else if (boost->boosting)
+        delay_us = boost->credit_us;
+
+    if (delay_us == 0) {
+        ctx->apis.alarm_api->stop(ctx->config->boost_alarm_id);
+        return;
+    }
+
+    ctx->apis.alarm_api->start(
+        ctx->config->boost_alarm_id,
+        FWK_MAX((delay_us + 999) / 1000, 1U),
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        boost_alarm_callback,
+        (uintptr_t)ctx);
+}
+
 /*
  * DVFS module synchronous API functions
  */
@@ -466,20 +1016,13 @@ static int dvfs_get_level_id(
     if (ctx == NULL)
         return FWK_E_PARAM;
 
-    /*
-     * When the setup code forces platform to provide frequency array
-     * sorted, then this code can be changed to bisect search in order
-     * to speed-up.
-     */
-    for (idx = 0; idx < ctx->opp_count; idx++) {
-        const struct mod_dvfs_opp *opp = &ctx->config->opps[idx];
-        if (opp->level == level) {
-            *level_id = idx;
-            return FWK_SUCCESS;
-        }
-    }
+    idx = get_opp_idx_for_level(ctx, level);
+    if ((idx == ctx->opp_count) || (ctx->config->opps[idx].level != level))
+        return FWK_E_PARAM;
 
-    return FWK_E_PARAM;
+    *level_id = idx;
+
+    return FWK_SUCCESS;
 }
 
 static int dvfs_get_opp_count(fwk_id_t domain_id, size_t *opp_count)
@@ -511,6 +1054,33 @@ static int dvfs_get_latency(fwk_id_t domain_id, uint16_t *latency)
 
     *latency = ctx->config->latency;
 
+    if (ctx->config->measured_latency && (ctx->latency.sample_count != 0)) {
+        *latency =
+            (uint16_t)FWK_MIN(dvfs_latency_p95(ctx), (uint32_t)UINT16_MAX);
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int dvfs_get_latency_stats(
+    fwk_id_t domain_id,
+    struct mod_dvfs_latency_stats *stats)
+{
+    const struct mod_dvfs_domain_ctx *ctx;
+
+    if (stats == NULL)
+        return FWK_E_PARAM;
+
+    ctx = get_domain_ctx(domain_id);
+    if (ctx == NULL)
+        return FWK_E_PARAM;
+
+    stats->last_us = ctx->latency.last_us;
+    stats->last_voltage_us = ctx->latency.last_voltage_us;
+    stats->last_frequency_us = ctx->latency.last_frequency_us;
+    stats->p95_us = dvfs_latency_p95(ctx);
+    stats->sample_count = ctx->latency.sample_count;
+
     return FWK_SUCCESS;
 }
 
@@ -582,6 +1152,7 @@ static int dvfs_set_level(fwk_id_t domain_id, uintptr_t cookie, uint32_t level)
 {
     struct mod_dvfs_domain_ctx *ctx;
     const struct mod_dvfs_opp *new_opp;
+    struct mod_dvfs_level_limits limits;
     unsigned int interrupt;
 
     ctx = get_domain_ctx(domain_id);
@@ -596,6 +1167,12 @@ static int dvfs_set_level(fwk_id_t domain_id, uintptr_t cookie, uint32_t level)
     if (!is_opp_within_limits(new_opp, &ctx->level_limits))
         return FWK_E_RANGE;
 
+    /* Boost levels are clamped while the boost credits are exhausted */
+    get_effective_limits(ctx, &ctx->level_limits, &limits);
+    new_opp = adjust_opp_for_new_limits(ctx, new_opp, &limits);
+    if (new_opp == NULL)
+        return FWK_E_RANGE;
+
     if (ctx->state != DVFS_DOMAIN_STATE_IDLE)
         return dvfs_create_pending_level_request(ctx, cookie, new_opp, false);
 
@@ -618,6 +1195,7 @@ static int dvfs_set_level_limits(
 {
     struct mod_dvfs_domain_ctx *ctx;
     const struct mod_dvfs_opp *new_opp;
+    struct mod_dvfs_level_limits effective_limits;
     unsigned int interrupt;
 
     ctx = get_domain_ctx(domain_id);
@@ -627,17 +1205,16 @@ static int dvfs_set_level_limits(
     if (!are_limits_valid(ctx, limits))
         return FWK_E_PARAM;
 
-    new_opp = adjust_opp_for_new_limits(ctx, &ctx->current_opp, limits);
+    get_effective_limits(ctx, limits, &effective_limits);
+    new_opp =
+        adjust_opp_for_new_limits(ctx, &ctx->current_opp, &effective_limits);
     if (new_opp == NULL)
         return FWK_E_PARAM;
 
     ctx->level_limits = *limits;
 
     /* notify the HAL that the limits have been updated */
-    if (ctx->apis.perf_updated_api) {
-        ctx->apis.perf_updated_api->notify_limits_updated(
-            ctx->domain_id, cookie, limits->minimum, limits->maximum);
-    }
+    notify_limits_updated(ctx, cookie);
 
     if ((new_opp->level == ctx->current_opp.level) &&
         (new_opp->frequency == ctx->current_opp.frequency) &&
@@ -656,6 +1233,29 @@ static int dvfs_set_level_limits(
     return dvfs_set_level_start(ctx, cookie, new_opp, true, 0);
 }
 
+static int dvfs_get_boost_credits(
+    fwk_id_t domain_id,
+    struct mod_dvfs_boost_credits *credits)
+{
+    const struct mod_dvfs_domain_ctx *ctx;
+
+    if (credits == NULL)
+        return FWK_E_PARAM;
+
+    ctx = get_domain_ctx(domain_id);
+    if (ctx == NULL)
+        return FWK_E_PARAM;
+
+    if (ctx->config->boost_credit_ms == 0)
+        return FWK_E_SUPPORT;
+
+    credits->credit_ms = dvfs_boost_credit(ctx) / 1000;
+    credits->capacity_ms = ctx->config->boost_credit_ms;
+    credits->exhausted = ctx->boost.exhausted;
+
+    return FWK_SUCCESS;
+}
+
 static const struct mod_dvfs_domain_api mod_dvfs_domain_api = {
     .get_current_opp = dvfs_get_current_opp,
     .get_sustained_opp = dvfs_get_sustained_opp,
@@ -663,9 +1263,11 @@ static const struct mod_dvfs_domain_api mod_dvfs_domain_api = {
     .get_level_id = dvfs_get_level_id,
     .get_opp_count = dvfs_get_opp_count,
     .get_latency = dvfs_get_latency,
+    .get_latency_stats = dvfs_get_latency_stats,
     .set_level = dvfs_set_level,
     .get_level_limits = dvfs_get_level_limits,
     .set_level_limits = dvfs_set_level_limits,
+    .get_boost_credits = dvfs_get_boost_credits,
 };
 
 /*
@@ -724,6 +1326,11 @@ static int dvfs_complete(
 {
     int status = req_status;
 
+    dvfs_rail_release(ctx, req_status);
+
+    if ((req_status == FWK_SUCCESS) && (ctx->state != DVFS_DOMAIN_GET_OPP))
+        dvfs_latency_record(ctx);
+
     if (ctx->request.response_required) {
         /*
          * If the DVFS request requires a response we send it now, no retries
@@ -734,18 +1341,22 @@ static int dvfs_complete(
     } else if ((req_status != FWK_SUCCESS) && ctx->request.retry_request) {
         /*
          * No response required, request has failed, a retry is necessary.
+         * A newer pending request supersedes the failed one, it is applied
+         * instead with its own retries.
          */
-        if (ctx->request.num_retries++ < DVFS_MAX_RETRIES) {
+        if ((ctx->request.num_retries++ < DVFS_MAX_RETRIES) &&
+            !ctx->request_pending) {
             ctx->pending_request.retry_request = ctx->request.retry_request;
             ctx->pending_request.num_retries = ctx->request.num_retries;
-            if (!ctx->request_pending) {
-                ctx->pending_request.cookie = ctx->request.cookie;
-                ctx->pending_request.new_opp = ctx->request.new_opp;
-                ctx->request_pending = true;
-            }
+            ctx->pending_request.cookie = ctx->request.cookie;
+            ctx->pending_request.new_opp =
+                ctx->plan_active ? ctx->plan_opp : ctx->request.new_opp;
+            ctx->request_pending = true;
         }
     }
 
+    ctx->plan_active = false;
+
     /* notify the HAL that the level has been updated */
     if ((req_status == FWK_SUCCESS) && (ctx->state != DVFS_DOMAIN_GET_OPP)) {
         if (ctx->apis.perf_updated_api) {
@@ -754,6 +1365,15 @@ static int dvfs_complete(
         }
     }
 
+    if ((req_status == FWK_SUCCESS) && (ctx->state != DVFS_DOMAIN_GET_OPP))
+        dvfs_boost_update(ctx);
+
+    /* Drop a pending request that the completed transition has served */
+    if (ctx->request_pending && (req_status == FWK_SUCCESS) &&
+        dvfs_pending_request_is_current(ctx)) {
+        ctx->request_pending = false;
+    }
+
     /*
      * Now we need to start processing the pending request if any,
      * note that we do not set the state to DOMAIN_STATE_IDLE
@@ -774,22 +1394,78 @@ static int dvfs_complete(
     return status;
 }
 
+/*
+ * Replace a voltage increase larger than max_voltage_step by a step to the
+ * highest intermediate operating point within reach.
+ */
+static void dvfs_plan_step(struct mod_dvfs_domain_ctx *ctx, uint32_t voltage)
+{
+    uint32_t step = ctx->config->max_voltage_step;
+    const struct mod_dvfs_opp *opp;
+    const struct mod_dvfs_opp *next = NULL;
+    size_t idx;
+
+    if ((step == 0) || (ctx->request.new_opp.voltage <= (voltage + step)))
+        return;
+
+    for (idx = 0; idx < ctx->opp_count; idx++) {
+        opp = &ctx->config->opps[idx];
+        if ((opp->voltage > voltage) && (opp->voltage <= (voltage + step)) &&
+            (opp->level < ctx->request.new_opp.level))
+            next = opp;
+    }
+
+    if (next == NULL)
+        return;
+
+    if (!ctx->plan_active) {
+        ctx->plan_opp = ctx->request.new_opp;
+        ctx->plan_active = true;
+    }
+    ctx->request.new_opp = *next;
+}
+
+static int dvfs_set_opp_done(struct mod_dvfs_domain_ctx *ctx, int status);
+
 /*
  * The SET_OPP() request has successfully completed the first step,
- * reading the voltage.
+ * reading the voltage of the rail.
  */
 static int dvfs_handle_set_opp(
     struct mod_dvfs_domain_ctx *ctx,
     uint32_t voltage)
 {
     int status = FWK_SUCCESS;
+    struct mod_dvfs_rail_ctx *rail = ctx->rail;
+    uint32_t target;
 
-    if (ctx->request.new_opp.voltage > voltage) {
+    dvfs_plan_step(ctx, voltage);
+
+    if ((rail->owner != NULL) && (rail->owner != ctx)) {
+        /*
+         * Another domain is changing the voltage of the rail. The frequency
+         * may only change now if the rail is high enough for the request
+         * both before and after that change.
+         */
+        if (ctx->request.new_opp.voltage >
+            FWK_MIN(rail->voltage, rail->target)) {
+            ctx->rail_waiting = true;
+            return FWK_PENDING;
+        }
+        target = voltage;
+    } else {
+        target = dvfs_rail_target(ctx);
+        if (target != voltage) {
+            rail->owner = ctx;
+            rail->target = target;
+        }
+    }
+
+    if (target > voltage) {
         /*
          * Current < request, increase voltage then set frequency
          */
-        status = ctx->apis.psu->set_voltage(
-            ctx->config->psu_id, ctx->request.new_opp.voltage);
+        status = dvfs_set_voltage(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_FREQUENCY;
@@ -802,23 +1478,17 @@ static int dvfs_handle_set_opp(
         /*
          * Voltage set successsfully, continue to set the frequency
          */
-        status = ctx->apis.clock->set_rate(
-            ctx->config->clock_id,
-            (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
-            MOD_CLOCK_ROUND_MODE_NONE);
+        status = dvfs_set_frequency(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
             return status;
         }
-    } else if (ctx->request.new_opp.voltage < voltage) {
+    } else if (target < voltage) {
         /*
          * Current > request, decrease frequency then set voltage
          */
-        status = ctx->apis.clock->set_rate(
-            ctx->config->clock_id,
-            (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
-            MOD_CLOCK_ROUND_MODE_NONE);
+        status = dvfs_set_frequency(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_VOLTAGE;
@@ -831,23 +1501,19 @@ static int dvfs_handle_set_opp(
         /*
          * Clock set_rate() completed successfully, continue to set_voltage()
          */
-        status = ctx->apis.psu->set_voltage(
-            ctx->config->psu_id, ctx->request.new_opp.voltage);
+        status = dvfs_set_voltage(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
             return status;
         }
-    } else if (ctx->current_opp.frequency == 0) {
+    } else if (ctx->request.new_opp.frequency != ctx->current_opp.frequency) {
         /*
-         * At startup the voltage may be set without the frequency having
-         * been set. In this case we must set the frequency regardless of
-         * the voltage.
+         * Same voltage, only the frequency changes. This is also the case at
+         * startup, where the voltage may be set without the frequency having
+         * been set.
          */
-        status = ctx->apis.clock->set_rate(
-            ctx->config->clock_id,
-            (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
-            MOD_CLOCK_ROUND_MODE_NONE);
+        status = dvfs_set_frequency(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
@@ -855,15 +1521,62 @@ static int dvfs_handle_set_opp(
         }
     }
 
+    return dvfs_set_opp_done(ctx, status);
+}
+
+/*
+ * A step of the SET_OPP() request has completed. The request carries on to
+ * its final operating point when it was planned in several steps.
+ */
+static int dvfs_set_opp_done(struct mod_dvfs_domain_ctx *ctx, int status)
+{
+    if (status != FWK_SUCCESS)
+        return dvfs_complete(ctx, NULL, status);
+
+    ctx->current_opp = ctx->request.new_opp;
+
+    if (ctx->plan_active && (ctx->current_opp.level != ctx->plan_opp.level)) {
+        ctx->request.new_opp = ctx->plan_opp;
+        ctx->state = DVFS_DOMAIN_SET_OPP;
+        return dvfs_handle_set_opp(ctx, ctx->rail->voltage);
+    }
+
     /*
      * SET_OPP() completed, return to caller.
      */
-    if (status == FWK_SUCCESS)
-        ctx->current_opp = ctx->request.new_opp;
-
     return dvfs_complete(ctx, NULL, status);
 }
 
+/*
+ * Get the voltage of the rail a SET_OPP() request starts from. The voltage
+ * last applied is trusted, the PSU is only read when it is unknown, after a
+ * failure or once every voltage_resync_period requests. It is never read
+ * while another domain is changing it.
+ */
+static int dvfs_set_opp_get_voltage(
+    struct mod_dvfs_domain_ctx *ctx,
+    uint32_t *voltage)
+{
+    uint16_t period = ctx->config->voltage_resync_period;
+    struct mod_dvfs_rail_ctx *rail = ctx->rail;
+
+    if (rail->owner != NULL) {
+        *voltage = rail->voltage;
+        return FWK_SUCCESS;
+    }
+
+    if ((rail->voltage != 0) &&
+        ((period == 0) || (ctx->voltage_cached_count < period))) {
+        ctx->voltage_cached_count++;
+        *voltage = rail->voltage;
+        return FWK_SUCCESS;
+    }
+
+    ctx->voltage_cached_count = 0;
+
+    return ctx->apis.psu->get_voltage(ctx->config->psu_id, voltage);
+}
+
 /*
  * The current voltage has been read. This is the first step of a SET_OPP()
  * request and the only step of a GET_OPP() request. It may have been handled
@@ -881,6 +1594,9 @@ static int dvfs_handle_psu_get_voltage_resp(
     if (req_status != FWK_SUCCESS)
         return dvfs_complete(ctx, resp_event, req_status);
 
+    if (ctx->rail->owner == NULL)
+        ctx->rail->voltage = voltage;
+
     if (ctx->state == DVFS_DOMAIN_SET_OPP)
         return dvfs_handle_set_opp(ctx, voltage);
 
@@ -917,14 +1633,15 @@ static int dvfs_handle_psu_set_voltage_resp(
     struct mod_psu_driver_response *psu_response =
         (struct mod_psu_driver_response *)event->params;
 
+    dvfs_latency_phase_end(ctx, &ctx->latency.voltage_us);
+
     if (psu_response->status != FWK_SUCCESS)
         return dvfs_complete(ctx, NULL, psu_response->status);
 
+    ctx->rail->voltage = ctx->rail->target;
+
     if (ctx->state == DVFS_DOMAIN_SET_FREQUENCY) {
-        status = ctx->apis.clock->set_rate(
-            ctx->config->clock_id,
-            (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
-            MOD_CLOCK_ROUND_MODE_NONE);
+        status = dvfs_set_frequency(ctx);
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
             return status;
@@ -934,13 +1651,7 @@ static int dvfs_handle_psu_set_voltage_resp(
     } else
         status = FWK_E_DEVICE;
 
-    /*
-     * SET_OPP() completed, return to caller.
-     */
-    if (status == FWK_SUCCESS)
-        ctx->current_opp = ctx->request.new_opp;
-
-    return dvfs_complete(ctx, NULL, status);
+    return dvfs_set_opp_done(ctx, status);
 }
 
 /*
@@ -955,6 +1666,8 @@ static int dvfs_handle_clk_set_freq_resp(
     struct mod_clock_driver_resp_params *clock_response =
         (struct mod_clock_driver_resp_params *)event->params;
 
+    dvfs_latency_phase_end(ctx, &ctx->latency.frequency_us);
+
     if (clock_response->status != FWK_SUCCESS)
         return dvfs_complete(ctx, NULL, clock_response->status);
 
@@ -962,8 +1675,7 @@ static int dvfs_handle_clk_set_freq_resp(
         /*
          * Clock set_rate() completed successfully, continue to set_voltage()
          */
-        status = ctx->apis.psu->set_voltage(
-            ctx->config->psu_id, ctx->request.new_opp.voltage);
+        status = dvfs_set_voltage(ctx);
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
             return status;
@@ -974,13 +1686,7 @@ static int dvfs_handle_clk_set_freq_resp(
     } else
         status = FWK_E_DEVICE;
 
-    /*
-     * SET_OPP() completed, return to caller.
-     */
-    if (status == FWK_SUCCESS)
-        ctx->current_opp = ctx->request.new_opp;
-
-    return dvfs_complete(ctx, NULL, status);
+    return dvfs_set_opp_done(ctx, status);
 }
 
 /*
@@ -1003,14 +1709,9 @@ static int mod_dvfs_process_signal(
      * local DVFS event from dvfs_set_level()
      */
     if (fwk_id_is_equal(signal_id, mod_dvfs_signal_id_set)) {
-        if (ctx->current_opp.voltage != 0) {
-            voltage = ctx->current_opp.voltage;
-            status = FWK_SUCCESS;
-        } else {
-            status = ctx->apis.psu->get_voltage(ctx->config->psu_id, &voltage);
-            if (status == FWK_PENDING)
-                return FWK_SUCCESS;
-        }
+        status = dvfs_set_opp_get_voltage(ctx, &voltage);
+        if (status == FWK_PENDING)
+            return FWK_SUCCESS;
 
         /*
          * Handle get_voltage() synchronously
@@ -1026,16 +1727,7 @@ static int mod_dvfs_process_signal(
      * dvfs_handle_pending_request() fires
      */
     if (fwk_id_is_equal(signal_id, mod_dvfs_signal_id_retry)) {
-        ctx->request.set_source_id = false;
-        ctx->request_pending = false;
-        status = dvfs_set_level_start(
-            ctx,
-            ctx->pending_request.cookie,
-            &ctx->pending_request.new_opp,
-            ctx->pending_request.retry_request,
-            ctx->pending_request.num_retries);
-        ctx->pending_request = (struct mod_dvfs_request){ 0 };
-        return status;
+        return dvfs_start_pending_request(ctx);
     }
 
     return FWK_E_PARAM;
@@ -1080,14 +1772,9 @@ static int mod_dvfs_process_event(
      * local DVFS event from dvfs_set_level()
      */
     if (fwk_id_is_equal(event->id, mod_dvfs_event_id_set)) {
-        if (ctx->current_opp.voltage != 0) {
-            voltage = ctx->current_opp.voltage;
-            status = FWK_SUCCESS;
-        } else {
-            status = ctx->apis.psu->get_voltage(ctx->config->psu_id, &voltage);
-            if (status == FWK_PENDING)
-                return FWK_SUCCESS;
-        }
+        status = dvfs_set_opp_get_voltage(ctx, &voltage);
+        if (status == FWK_PENDING)
+            return FWK_SUCCESS;
 
         /*
          * Handle get_voltage() synchronously
@@ -1103,16 +1790,15 @@ static int mod_dvfs_process_event(
      * dvfs_handle_pending_request() fires
      */
     if (fwk_id_is_equal(event->id, mod_dvfs_event_id_retry)) {
-        ctx->request.set_source_id = false;
-        ctx->request_pending = false;
-        status = dvfs_set_level_start(
-            ctx,
-            ctx->pending_request.cookie,
-            &ctx->pending_request.new_opp,
-            ctx->pending_request.retry_request,
-            ctx->pending_request.num_retries);
-        ctx->pending_request = (struct mod_dvfs_request){ 0 };
-        return status;
+        return dvfs_start_pending_request(ctx);
+    }
+
+    /*
+     * local DVFS event from boost_alarm_callback()
+     */
+    if (fwk_id_is_equal(event->id, mod_dvfs_event_id_boost)) {
+        dvfs_boost_update(ctx);
+        return FWK_SUCCESS;
     }
 
     /*
@@ -1182,6 +1868,7 @@ static int dvfs_start(fwk_id_t id)
     status = dvfs_get_sustained_opp(id, &sustained_opp);
     if (status == FWK_SUCCESS) {
         ctx = get_domain_ctx(id);
+        ctx->boost.timestamp = fwk_time_current();
         ctx->request.set_source_id = true;
         dvfs_set_level_start(ctx, 0, &sustained_opp, true, 0);
     }
@@ -1197,6 +1884,9 @@ static int dvfs_init(
     dvfs_ctx.domain_ctx =
         fwk_mm_calloc(element_count, sizeof((*dvfs_ctx.domain_ctx)[0]));
 
+    dvfs_ctx.rail_ctx =
+        fwk_mm_calloc(element_count, sizeof((*dvfs_ctx.rail_ctx)[0]));
+
     dvfs_ctx.config = (struct mod_dvfs_config *)data;
     dvfs_ctx.dvfs_domain_element_count = element_count;
 
@@ -1209,6 +1899,8 @@ static int dvfs_element_init(
     const void *data)
 {
     struct mod_dvfs_domain_ctx *ctx = get_domain_ctx(domain_id);
+    const struct mod_dvfs_opp *opps;
+    size_t idx;
 
     fwk_assert(sub_element_count == 0);
 
@@ -1222,6 +1914,33 @@ static int dvfs_element_init(
     ctx->opp_count = count_opps(ctx->config->opps);
     fwk_assert(ctx->opp_count > 0);
 
+    /* The level lookups rely on the levels being in ascending order */
+    opps = ctx->config->opps;
+    for (idx = 1; idx < ctx->opp_count; idx++) {
+        if (opps[idx].level <= opps[idx - 1].level)
+            return FWK_E_DATA;
+    }
+
+    if (ctx->opp_count > 1) {
+        ctx->level_step = opps[1].level - opps[0].level;
+        for (idx = 2; idx < ctx->opp_count; idx++) {
+            if ((opps[idx].level - opps[idx - 1].level) != ctx->level_step) {
+                ctx->level_step = 0;
+                break;
+            }
+        }
+    }
+
+    ctx->rail = dvfs_rail_get(ctx->config->psu_id);
+
+    if (ctx->config->boost_credit_ms != 0) {
+        if ((ctx->config->sustained_idx >= ctx->opp_count) ||
+            (ctx->config->boost_credit_ms > (UINT32_MAX / 1000)))
+            return FWK_E_DATA;
+
+        ctx->boost.credit_us = ctx->config->boost_credit_ms * 1000;
+    }
+
     /* Level limits default to the minimum and maximum available */
     ctx->level_limits = (struct mod_dvfs_level_limits){
         .minimum = ctx->config->opps[0].level,
@@ -1270,6 +1989,15 @@ static int dvfs_bind_element(fwk_id_t domain_id, unsigned int round)
             return FWK_E_PANIC;
     }
 
+    if (ctx->config->boost_credit_ms > 0) {
+        status = fwk_module_bind(
+            ctx->config->boost_alarm_id,
+            MOD_TIMER_API_ID_ALARM,
+            &ctx->apis.alarm_api);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -0,0 +1,155 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Utilization-driven DVFS governor.
+ */
+
+#ifndef MOD_DVFS_GOVERNOR_H
+#define MOD_DVFS_GOVERNOR_H
+
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupDvfsGovernor DVFS Governor
+ *
+ * \brief Utilization-driven DVFS governor.
+ *
+ * \details The governor samples the activity counters of its DVFS domains,
+ *      keeps an exponentially weighted moving average of their utilization
+ *      and sets the lowest performance level providing that utilization plus
+ *      some headroom. The levels are set within the limits of the domains, so
+ *      agents may still constrain the governor through the SCMI performance
+ *      limits.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Activity counter API.
+ *
+ * \details Implemented by the platform to give access to the activity
+ *      counters of a domain, e.g. the AMU or PMU cycle counters.
+ */
+struct mod_dvfs_governor_activity_api {
+    /*!
+     * \brief Read the activity counters of a domain.
+     *
+     * \details Both counters are free-running. Only their increments between
+     *      two samples are used.
+     *
+     * \param counter_id Identifier of the counters of the domain.
+     * \param [out] active Number of cycles the domain was active.
+     * \param [out] total Number of cycles elapsed.
+     *
+     * \retval ::FWK_SUCCESS The counters were read.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_counters)(fwk_id_t counter_id, uint64_t *active, uint64_t *total);
+};
+
+/*!
+ * \brief Domain configuration.
+ */
+struct mod_dvfs_governor_domain_config {
+    /*! Identifier of the governed element of the DVFS module */
+    fwk_id_t dvfs_domain_id;
+
+    /*! Identifier of the activity counters of the domain */
+    fwk_id_t counter_id;
+
+    /*! Identifier of the activity counter API */
+    fwk_id_t counter_api_id;
+
+    /*!
+     * \brief Weight of the new samples in the utilization average.
+     *
+     * \details Each sample contributes 1 / 2^ewma_shift of the average. When
+     *      0, the average is the last sample.
+     */
+    unsigned int ewma_shift;
+
+    /*! Utilization headroom kept above the average, in percent */
+    unsigned int headroom_pct;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_dvfs_governor_config {
+    /*!
+     * \brief Identifier of the sampling alarm.
+     *
+     * \details May be ::FWK_ID_NONE if the platform calls
+     *      ::mod_dvfs_governor_api::sample itself, for instance from an
+     *      activity counter interrupt when reacting faster than the alarm
+     *      resolution is needed.
+     */
+    fwk_id_t alarm_id;
+
+    /*! Sampling period in milliseconds */
+    unsigned int sample_period_ms;
+};
+
+/*!
+ * \brief Governor API.
+ */
+struct mod_dvfs_governor_api {
+    /*!
+     * \brief Sample the activity of a domain and update its level.
+     *
+     * \param domain_id Identifier of the governor domain.
+     *
+     * \retval ::FWK_SUCCESS The domain was sampled.
+     * \retval ::FWK_E_PARAM The domain identifier is not valid.
+     * \return One of the standard framework error codes.
+     */
+    int (*sample)(fwk_id_t domain_id);
+
+    /*!
+     * \brief Get the utilization average of a domain.
+     *
+     * \param domain_id Identifier of the governor domain.
+     * \param [out] utilization Utilization, from 0 to
+     *      ::MOD_DVFS_GOVERNOR_UTILIZATION_SCALE.
+     *
+     * \retval ::FWK_SUCCESS The utilization was returned.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     */
+    int (*get_utilization)(fwk_id_t domain_id, uint32_t *utilization);
+};
+
+/*! Utilization of a fully active domain */
+#define MOD_DVFS_GOVERNOR_UTILIZATION_SCALE 1024
+
+/*!
+ * \brief API indices.
+ */
+enum mod_dvfs_governor_api_idx {
+    /*! Governor API, see ::mod_dvfs_governor_api */
+    MOD_DVFS_GOVERNOR_API_IDX_GOVERNOR,
+
+    /*! Number of defined APIs */
+    MOD_DVFS_GOVERNOR_API_IDX_COUNT,
+};
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_DVFS_GOVERNOR_H */
@@ -0,0 +1,336 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Utilization-driven DVFS governor.
+ */
+
+#include <mod_dvfs.h>
+#include <mod_dvfs_governor.h>
+#include <mod_timer.h>
+
+#include <fwk_assert.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct dvfs_governor_domain_ctx {
+    /* Domain configuration */
+    const struct mod_dvfs_governor_domain_config *config;
+
+    /* Activity counter API */
+    const struct mod_dvfs_governor_activity_api *counter_api;
+
+    /* Counter values at the previous sample */
+    uint64_t last_active;
+    uint64_t last_total;
+
+    /* The counter values of a previous sample are available */
+    bool sampled;
+
+    /* Utilization average */
+    uint32_t utilization;
+};
+
+static struct dvfs_governor_ctx {
+    /* Module configuration */
+    const struct mod_dvfs_governor_config *config;
+
+    /* Table of domain contexts */
+    struct dvfs_governor_domain_ctx *domain_ctx_table;
+
+    /* Number of domains */
+    unsigned int domain_count;
+
+    /* DVFS API */
+    const struct mod_dvfs_domain_api *dvfs_api;
+
+    /* Sampling alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+} dvfs_governor_ctx;
+
+/*
+ * Helpers
+ */
+
+static struct dvfs_governor_domain_ctx *get_domain_ctx(fwk_id_t domain_id)
+{
+    unsigned int idx = fwk_id_get_element_idx(domain_id);
+
+    if (!fwk_module_is_valid_element_id(domain_id) ||
+        (idx >= dvfs_governor_ctx.domain_count))
+        return NULL;
+
+    return &dvfs_governor_ctx.domain_ctx_table[idx];
+}
+
+/*
+ * Lowest level of the DVFS domain running at least at the given frequency
+ * and within the current limits, or the highest level within the limits.
+ */
+static int select_level(
+    fwk_id_t dvfs_domain_id,
+    uint64_t frequency,
+    uint32_t *level)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = dvfs_governor_ctx.dvfs_api;
+    struct mod_dvfs_level_limits limits;
+    struct mod_dvfs_opp opp;
+    size_t opp_count, idx;
+    bool found = false;
+    int status;
+
+    status = dvfs_api->get_level_limits(dvfs_domain_id, &limits);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = dvfs_api->get_opp_count(dvfs_domain_id, &opp_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (idx = 0; idx < opp_count; idx++) {
+        status = dvfs_api->get_nth_opp(dvfs_domain_id, idx, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if ((opp.level < limits.minimum) || (opp.level > limits.maximum))
+            continue;
+
+        *level = opp.level;
+        found = true;
+
+        if (opp.frequency >= frequency)
+            break;
+    }
+
+    return found ? FWK_SUCCESS : FWK_E_RANGE;
+}
+
+/*
+ * Governor API
+ */
+
+static int dvfs_governor_sample(fwk_id_t domain_id)
+{
+    struct dvfs_governor_domain_ctx *ctx;
+    const struct mod_dvfs_governor_domain_config *config;
+    uint64_t active, total, delta_active, delta_total;
+    uint64_t frequency;
+    uint32_t utilization, level;
+    struct mod_dvfs_opp opp;
+    int status;
+
+    ctx = get_domain_ctx(domain_id);
+    if (ctx == NULL)
+        return FWK_E_PARAM;
+
+    config = ctx->config;
+
+    status =
+        ctx->counter_api->get_counters(config->counter_id, &active, &total);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    delta_active = active - ctx->last_active;
+    delta_total = total - ctx->last_total;
+    ctx->last_active = active;
+    ctx->last_total = total;
+
+    if (!ctx->sampled) {
+        ctx->sampled = true;
+        return FWK_SUCCESS;
+    }
+
+    if (delta_total == 0)
+        return FWK_SUCCESS;
+
+    utilization = (uint32_t)(
+        (FWK_MIN(delta_active, delta_total) *
+         MOD_DVFS_GOVERNOR_UTILIZATION_SCALE) /
+        delta_total);
+
+    ctx->utilization = ctx->utilization -
+        (ctx->utilization >> config->ewma_shift) +
+        (utilization >> config->ewma_shift);
+
+    /* The utilization was measured at the current frequency */
+    status = dvfs_governor_ctx.dvfs_api->get_current_opp(
+        config->dvfs_domain_id, &opp);
+    if (status == FWK_PENDING)
+        return FWK_SUCCESS;
+    if (status != FWK_SUCCESS)
+        return status;
+
+    frequency = ((uint64_t)opp.frequency * ctx->utilization *
+                 (100 + config->headroom_pct)) /
+        (MOD_DVFS_GOVERNOR_UTILIZATION_SCALE * 100);
+
+    status = select_level(config->dvfs_domain_id, frequency, &level);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (level == opp.level)
+        return FWK_SUCCESS;
+
+    status = dvfs_governor_ctx.dvfs_api->set_level(
+        config->dvfs_domain_id, 0, level);
+
+    return (status == FWK_PENDING) ? FWK_SUCCESS : status;
+}
+
+static int dvfs_governor_get_utilization(
+    fwk_id_t domain_id,
+    uint32_t *utilization)
+{
+    const struct dvfs_governor_domain_ctx *ctx;
+
+    if (utilization == NULL)
+        return FWK_E_PARAM;
+
+    ctx = get_domain_ctx(domain_id);
+    if (ctx == NULL)
+        return FWK_E_PARAM;
+
+    *utilization = ctx->utilization;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_dvfs_governor_api dvfs_governor_api = {
+    .sample = dvfs_governor_sample,
+    .get_utilization = dvfs_governor_get_utilization,
+};
+
+static void dvfs_governor_alarm_callback(uintptr_t param)
+{
+    unsigned int idx;
+    int status;
+
+    for (idx = 0; idx < dvfs_governor_ctx.domain_count; idx++) {
+        status = dvfs_governor_sample(
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS_GOVERNOR, idx));
+        if (status != FWK_SUCCESS)
+            FWK_LOG_WARN("[DVFS-GOV] Domain %u sample failed", idx);
+    }
+}
+
+/*
+ * Framework handlers
+ */
+
+static int dvfs_governor_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    const struct mod_dvfs_governor_config *config = data;
+
+    if ((config == NULL) ||
+        (!fwk_id_is_equal(config->alarm_id, FWK_ID_NONE) &&
+         (config->sample_period_ms == 0)))
+        return FWK_E_DATA;
+
+    dvfs_governor_ctx.config = config;
+    dvfs_governor_ctx.domain_count = element_count;
+    dvfs_governor_ctx.domain_ctx_table = fwk_mm_calloc(
+        element_count, sizeof(dvfs_governor_ctx.domain_ctx_table[0]));
+
+    return FWK_SUCCESS;
+}
+
+static int dvfs_governor_domain_init(
+    fwk_id_t domain_id,
+    unsigned int sub_element_count,
+    const void *data)
+{
+    struct dvfs_governor_domain_ctx *ctx;
+    const struct mod_dvfs_governor_domain_config *config = data;
+
+    if ((config == NULL) || (config->ewma_shift >= 32))
+        return FWK_E_DATA;
+
+    ctx = &dvfs_governor_ctx.domain_ctx_table[fwk_id_get_element_idx(
+        domain_id)];
+    ctx->config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int dvfs_governor_bind(fwk_id_t id, unsigned int round)
+{
+    struct dvfs_governor_domain_ctx *ctx;
+
+    if (round != 0)
+        return FWK_SUCCESS;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        if (!fwk_id_is_equal(dvfs_governor_ctx.config->alarm_id, FWK_ID_NONE)) {
+            if (fwk_module_bind(
+                    dvfs_governor_ctx.config->alarm_id,
+                    MOD_TIMER_API_ID_ALARM,
+                    &dvfs_governor_ctx.alarm_api) != FWK_SUCCESS)
+                return FWK_E_PANIC;
+        }
+
+        return fwk_module_bind(
+            FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+            mod_dvfs_api_id_dvfs,
+            &dvfs_governor_ctx.dvfs_api);
+    }
+
+    ctx = get_domain_ctx(id);
+
+    return fwk_module_bind(
+        ctx->config->counter_id,
+        ctx->config->counter_api_id,
+        &ctx->counter_api);
+}
+
+static int dvfs_governor_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    if (fwk_id_get_api_idx(api_id) != MOD_DVFS_GOVERNOR_API_IDX_GOVERNOR)
+        return FWK_E_ACCESS;
+
+    *api = &dvfs_governor_api;
+
+    return FWK_SUCCESS;
+}
+
+static int dvfs_governor_start(fwk_id_t id)
+{
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE) ||
+        (dvfs_governor_ctx.alarm_api == NULL))
+        return FWK_SUCCESS;
+
+    return dvfs_governor_ctx.alarm_api->start(
+        dvfs_governor_ctx.config->alarm_id,
+        dvfs_governor_ctx.config->sample_period_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        dvfs_governor_alarm_callback,
+        (uintptr_t)0);
+}
+
+const struct fwk_module module_dvfs_governor = {
+    .name = "DVFS governor",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_DVFS_GOVERNOR_API_IDX_COUNT,
+    .init = dvfs_governor_init,
+    .element_init = dvfs_governor_domain_init,
+    .bind = dvfs_governor_bind,
+    .start = dvfs_governor_start,
+    .process_bind_request = dvfs_governor_process_bind_request,
+};
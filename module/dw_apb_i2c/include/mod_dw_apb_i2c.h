@@ -11,6 +11,8 @@
 #ifndef MOD_DW_APB_I2C_H
 #define MOD_DW_APB_I2C_H
 
+#include <mod_i2c.h>
+
 #include <fwk_id.h>
 #include <fwk_module_idx.h>
 
@@ -25,6 +27,11 @@
  * \defgroup GroupModuleI2CController I2C Controller
  *
  * \brief Driver for I2C device.
+ *
+ * \details The transfers that fit in the FIFOs are pushed at once and complete
+ *      with a single interrupt. The longer ones are fed to and drained from
+ *      the FIFOs by chunks, on the FIFO threshold interrupts, or handed to a
+ *      DMA hook when one is configured.
  * \{
  */
 
@@ -42,6 +49,69 @@ struct mod_dw_apb_i2c_dev_config {
     unsigned int i2c_irq;
     /*! Base address of the I2C device registers */
     uintptr_t reg;
+    /*!
+     * \brief Number of FIFO entries triggering the threshold interrupts.
+     *
+     * \details The transmit FIFO is refilled when it holds this many entries
+     *      or fewer, and the receive FIFO is drained when it holds this many
+     *      entries or more. The entries left in the transmit FIFO must cover
+     *      the interrupt latency, otherwise the controller ends the transfer
+     *      early. When zero, half the FIFO depth is used.
+     */
+    unsigned int fifo_threshold;
+    /*!
+     * \brief Minimum number of bytes for a transfer to be handed to the DMA
+     *      hook, or zero to disable the DMA hook.
+     */
+    unsigned int dma_min_byte_count;
+    /*! Identifier of the DMA hook, see ::mod_dw_apb_i2c_dma_api */
+    fwk_id_t dma_id;
+    /*! Identifier of the DMA hook API */
+    fwk_id_t dma_api_id;
+};
+
+/*!
+ * \brief DMA hook API.
+ *
+ * \details Implemented by a platform DMA driver to move the long transfers
+ *      between memory and the controller FIFOs. The controller issues its DMA
+ *      requests once the hook has been started. The end of the transfer is
+ *      still signalled by the controller interrupt.
+ */
+struct mod_dw_apb_i2c_dma_api {
+    /*!
+     * \brief Start moving a transfer.
+     *
+     * \details For every byte of the messages, in order, the DMA writes one
+     *      entry to the data command register on the transmit requests: the
+     *      data byte for a transmit message and the read command (0x100) for a
+     *      receive message. It copies the received bytes to the receive
+     *      messages on the receive requests.
+     *
+     * \param dma_id Identifier of the DMA hook.
+     * \param data_cmd Address of the data command register.
+     * \param messages Messages of the transfer.
+     * \param message_count Number of messages.
+     *
+     * \retval ::FWK_SUCCESS The transfer was started.
+     * \retval ::FWK_E_SUPPORT The transfer cannot be moved by the DMA. The
+     *      driver uses the FIFO threshold interrupts instead.
+     * \return One of the standard framework status codes.
+     */
+    int (*start)(fwk_id_t dma_id, uintptr_t data_cmd,
+        const struct mod_i2c_message *messages, unsigned int message_count);
+
+    /*!
+     * \brief Stop the transfer once the controller has ended it.
+     *
+     * \note Called from the controller interrupt handler.
+     *
+     * \param dma_id Identifier of the DMA hook.
+     *
+     * \retval ::FWK_SUCCESS All the data of the transfer has been moved.
+     * \return One of the standard framework status codes.
+     */
+    int (*stop)(fwk_id_t dma_id);
 };
 
 /*! API indices */
@@ -19,6 +19,9 @@
 #define I2C_RECEIVE_BUFFER_LENGTH        16
 #define I2C_TIMEOUT_US                   250
 
+/* Default number of FIFO entries triggering the threshold interrupts */
+#define I2C_FIFO_THRESHOLD               (I2C_TRANSMIT_BUFFER_LENGTH / 2)
+
 /*
  * I2C controller register definitions
  */
@@ -30,16 +33,23 @@ struct dw_apb_i2c_reg {
            uint8_t        RESERVED2[0x2C - 0x14];
     FWK_R  uint32_t       IC_INTR_STAT;
     FWK_RW uint32_t       IC_INTR_MASK;
-           uint8_t        RESERVED3[0x54 - 0x34];
+           uint8_t        RESERVED3[0x38 - 0x34];
+    FWK_RW uint32_t       IC_RX_TL;
+    FWK_RW uint32_t       IC_TX_TL;
+           uint8_t        RESERVED4[0x54 - 0x40];
     FWK_R  uint32_t       IC_CLR_TX_ABRT;
-           uint8_t        RESERVED4[0x60 - 0x58];
+           uint8_t        RESERVED5[0x60 - 0x58];
     FWK_R  uint32_t       IC_CLR_STOP_DET;
-           uint8_t        RESERVED5[0x6C - 0x64];
+           uint8_t        RESERVED6[0x6C - 0x64];
     FWK_RW uint32_t       IC_ENABLE;
     FWK_R  uint32_t       IC_STATUS;
-           uint8_t        RESERVED6[0x9C - 0x74];
+           uint8_t        RESERVED7[0x88 - 0x74];
+    FWK_RW uint32_t       IC_DMA_CR;
+    FWK_RW uint32_t       IC_DMA_TDLR;
+    FWK_RW uint32_t       IC_DMA_RDLR;
+           uint8_t        RESERVED8[0x9C - 0x94];
     FWK_R  uint32_t       IC_ENABLE_STATUS;
-           uint8_t        RESERVED7[0x100 - 0xA0];
+           uint8_t        RESERVED9[0x100 - 0xA0];
 };
 
 #define IC_TAR_ADDRESS                  UINT32_C(0x000003FF)
@@ -50,6 +60,7 @@ struct dw_apb_i2c_reg {
 
 #define IC_STATUS_MST_ACTIVITY_MASK     UINT32_C(0x00000020)
 #define IC_STATUS_TFNF_MASK             UINT32_C(0x00000002)
+#define IC_STATUS_RFNE_MASK             UINT32_C(0x00000008)
 
 #define IC_DATA_CMD_CMD_MASK            UINT32_C(0x00000100)
 #define IC_DATA_CMD_DATA_MASK           UINT32_C(0x000000FF)
@@ -61,7 +72,16 @@ struct dw_apb_i2c_reg {
  */
 #define IC_DATA_CMD_READ                0x100
 
+#define IC_DMA_CR_RDMAE                 UINT32_C(0x00000001)
+#define IC_DMA_CR_TDMAE                 UINT32_C(0x00000002)
+
 /* IRQ Masks */
+#define IC_INTR_RX_FULL_POS             2
+#define IC_INTR_RX_FULL_MASK            (UINT32_C(1) << IC_INTR_RX_FULL_POS)
+
+#define IC_INTR_TX_EMPTY_POS            4
+#define IC_INTR_TX_EMPTY_MASK           (UINT32_C(1) << IC_INTR_TX_EMPTY_POS)
+
 #define IC_INTR_TX_ABRT_POS             6
 #define IC_INTR_TX_ABRT_MASK            (UINT32_C(1) << IC_INTR_TX_ABRT_POS)
 
@@ -19,15 +19,37 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+/* Position in the bytes of a transfer */
+struct dw_apb_i2c_cursor {
+    unsigned int msg;
+    unsigned int byte;
+};
+
 struct dw_apb_i2c_ctx {
     const struct mod_dw_apb_i2c_dev_config *config;
     const struct mod_i2c_driver_response_api *i2c_api;
     const struct mod_timer_api *timer_api;
+    const struct mod_dw_apb_i2c_dma_api *dma_api;
     fwk_id_t i2c_id;
     struct dw_apb_i2c_reg *i2c_reg;
-    bool read_on_going;
-    uint8_t byte_count;
-    uint8_t *data;
+    unsigned int fifo_threshold;
+
+    /* Transfer in progress */
+    const struct mod_i2c_message *messages;
+    unsigned int message_count;
+    bool dma_on_going;
+
+    /* Next command to push to the transmit FIFO */
+    struct dw_apb_i2c_cursor command;
+
+    /* Next byte to read from the receive FIFO */
+    struct dw_apb_i2c_cursor receive;
+
+    /* Number of read commands pushed whose data has not been read yet */
+    unsigned int read_outstanding;
+
+    /* Storage for the message of the transmit and receive requests */
+    struct mod_i2c_message request_message;
 };
 
 static struct dw_apb_i2c_ctx *ctx_table;
@@ -89,6 +111,11 @@ static int enable_i2c(struct dw_apb_i2c_ctx *ctx, uint8_t slave_address)
     /* Program the slave address */
     i2c_reg->IC_TAR = (slave_address & IC_TAR_ADDRESS);
 
+    /* Program the FIFO thresholds */
+    i2c_reg->IC_TX_TL = ctx->fifo_threshold;
+    i2c_reg->IC_RX_TL = ctx->fifo_threshold - 1;
+    i2c_reg->IC_DMA_CR = 0;
+
     /* Enable STOP detected interrupt and TX aborted interrupt */
     i2c_reg->IC_INTR_MASK = (IC_INTR_STOP_DET_MASK | IC_INTR_TX_ABRT_MASK);
 
@@ -98,35 +125,214 @@ static int enable_i2c(struct dw_apb_i2c_ctx *ctx, uint8_t slave_address)
     return FWK_SUCCESS;
 }
 
+/* Move a cursor to the next byte, skipping the transmit messages if asked */
+static void advance_cursor(
+    struct dw_apb_i2c_ctx *ctx,
+    struct dw_apb_i2c_cursor *cursor,
+    bool read_only)
+{
+    if (++cursor->byte < ctx->messages[cursor->msg].byte_count)
+        return;
+
+    cursor->byte = 0;
+    cursor->msg++;
+
+    while (read_only && (cursor->msg < ctx->message_count) &&
+           !ctx->messages[cursor->msg].read)
+        cursor->msg++;
+}
+
+/* Push commands to the transmit FIFO as long as it has room */
+static void push_commands(struct dw_apb_i2c_ctx *ctx)
+{
+    const struct mod_i2c_message *message;
+    struct dw_apb_i2c_reg *i2c_reg = ctx->i2c_reg;
+
+    while (ctx->command.msg < ctx->message_count) {
+        if ((i2c_reg->IC_STATUS & IC_STATUS_TFNF_MASK) == 0)
+            return;
+
+        message = &ctx->messages[ctx->command.msg];
+        if (message->read) {
+            /* Do not request more data than the receive FIFO can hold */
+            if (ctx->read_outstanding == I2C_RECEIVE_BUFFER_LENGTH)
+                return;
+
+            i2c_reg->IC_DATA_CMD = IC_DATA_CMD_READ;
+            ctx->read_outstanding++;
+        } else
+            i2c_reg->IC_DATA_CMD = message->data[ctx->command.byte];
+
+        advance_cursor(ctx, &ctx->command, false);
+    }
+}
+
+/* Read the received data from the receive FIFO */
+static void pull_data(struct dw_apb_i2c_ctx *ctx)
+{
+    const struct mod_i2c_message *message;
+    struct dw_apb_i2c_reg *i2c_reg = ctx->i2c_reg;
+
+    while ((ctx->read_outstanding > 0) &&
+           ((i2c_reg->IC_STATUS & IC_STATUS_RFNE_MASK) != 0)) {
+        message = &ctx->messages[ctx->receive.msg];
+        message->data[ctx->receive.byte] =
+            (uint8_t)(i2c_reg->IC_DATA_CMD & IC_DATA_CMD_DATA_MASK);
+        ctx->read_outstanding--;
+
+        advance_cursor(ctx, &ctx->receive, true);
+    }
+}
+
+/*
+ * Unmask the threshold interrupts the transfer in progress still needs. The
+ * transmit FIFO interrupt is left masked while the next command is a read
+ * that has to wait for the receive FIFO to be drained.
+ */
+static void update_interrupt_mask(struct dw_apb_i2c_ctx *ctx)
+{
+    uint32_t mask = IC_INTR_STOP_DET_MASK | IC_INTR_TX_ABRT_MASK;
+
+    if ((ctx->command.msg < ctx->message_count) &&
+        !(ctx->messages[ctx->command.msg].read &&
+          (ctx->read_outstanding == I2C_RECEIVE_BUFFER_LENGTH)))
+        mask |= IC_INTR_TX_EMPTY_MASK;
+
+    if (ctx->read_outstanding >= ctx->fifo_threshold)
+        mask |= IC_INTR_RX_FULL_MASK;
+
+    ctx->i2c_reg->IC_INTR_MASK = mask;
+}
+
+static int start_dma(struct dw_apb_i2c_ctx *ctx)
+{
+    int status;
+    struct dw_apb_i2c_reg *i2c_reg = ctx->i2c_reg;
+
+    status = ctx->dma_api->start(ctx->config->dma_id,
+        (uintptr_t)&i2c_reg->IC_DATA_CMD, ctx->messages, ctx->message_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->dma_on_going = true;
+
+    i2c_reg->IC_DMA_TDLR = ctx->fifo_threshold;
+    i2c_reg->IC_DMA_RDLR = ctx->fifo_threshold - 1;
+    i2c_reg->IC_DMA_CR = IC_DMA_CR_TDMAE | IC_DMA_CR_RDMAE;
+
+    return FWK_SUCCESS;
+}
+
+static int start_transfer(struct dw_apb_i2c_ctx *ctx,
+                          uint8_t slave_address,
+                          const struct mod_i2c_message *messages,
+                          unsigned int message_count)
+{
+    int status;
+    unsigned int msg;
+    unsigned int byte_count = 0;
+
+    for (msg = 0; msg < message_count; msg++)
+        byte_count += messages[msg].byte_count;
+
+    ctx->messages = messages;
+    ctx->message_count = message_count;
+    ctx->dma_on_going = false;
+    ctx->command = (struct dw_apb_i2c_cursor) { 0 };
+    ctx->receive = (struct dw_apb_i2c_cursor) { 0 };
+    ctx->read_outstanding = 0;
+
+    while ((ctx->receive.msg < message_count) &&
+           !messages[ctx->receive.msg].read)
+        ctx->receive.msg++;
+
+    status = enable_i2c(ctx, slave_address);
+    if (status != FWK_SUCCESS)
+        return FWK_E_DEVICE;
+
+    if ((ctx->dma_api != NULL) &&
+        (byte_count >= ctx->config->dma_min_byte_count)) {
+        status = start_dma(ctx);
+        if (status == FWK_SUCCESS)
+            return FWK_PENDING;
+        if (status != FWK_E_SUPPORT)
+            return FWK_E_DEVICE;
+    }
+
+    /* The program of the I2C controller cannot be interrupted. */
+    fwk_interrupt_global_disable();
+
+    push_commands(ctx);
+    update_interrupt_mask(ctx);
+
+    fwk_interrupt_global_enable();
+
+    /*
+     * The commands that fit have been pushed to the I2C FIFO. The FIFO
+     * threshold interrupts, if any is needed, will push the remaining ones
+     * and drain the received data. An interrupt will signal the completion of
+     * the transfer. The i2c_isr() interrupt handler will be invoked to notify
+     * the caller.
+     */
+    return FWK_PENDING;
+}
+
 /*
  * An IRQ is triggered if the transaction has been completed successfully or
- * if the transaction has been aborted.
+ * if the transaction has been aborted. When the transfer does not fit in the
+ * FIFOs, IRQs are also triggered when the FIFOs reach their threshold.
  */
 static void i2c_isr(uintptr_t data)
 {
-    unsigned int i;
+    int status;
     int i2c_status = FWK_E_DEVICE;
+    uint32_t intr_stat;
     struct dw_apb_i2c_reg *i2c_reg;
     struct dw_apb_i2c_ctx *ctx = (struct dw_apb_i2c_ctx *)data;
 
     i2c_reg = ctx->i2c_reg;
+    intr_stat = i2c_reg->IC_INTR_STAT;
+
+    if ((intr_stat & (IC_INTR_STOP_DET_MASK | IC_INTR_TX_ABRT_MASK)) == 0) {
+        /* A FIFO has reached its threshold */
+        pull_data(ctx);
+        push_commands(ctx);
+        update_interrupt_mask(ctx);
+
+        return;
+    }
 
     /* The transaction has completed successfully */
-    if (i2c_reg->IC_INTR_STAT & IC_INTR_STOP_DET_MASK) {
+    if (intr_stat & IC_INTR_STOP_DET_MASK) {
         i2c_reg->IC_CLR_STOP_DET;
         i2c_status = FWK_SUCCESS;
-        if (ctx->read_on_going) {
-            ctx->read_on_going = false;
-            /* Read the data from the device buffer */
-            for (i = 0; i < ctx->byte_count; i++)
-                ctx->data[i] =
-                    (uint8_t)(i2c_reg->IC_DATA_CMD & IC_DATA_CMD_DATA_MASK);
+
+        if (!ctx->dma_on_going) {
+            pull_data(ctx);
+
+            /* The transmit FIFO ran dry before the end of the transfer */
+            if ((ctx->command.msg < ctx->message_count) ||
+                (ctx->read_outstanding != 0))
+                i2c_status = FWK_E_DEVICE;
         }
     }
 
     /* The transaction has been aborted */
-    if (i2c_reg->IC_INTR_STAT & IC_INTR_TX_ABRT_MASK)
+    if (intr_stat & IC_INTR_TX_ABRT_MASK) {
         i2c_reg->IC_CLR_TX_ABRT;
+        i2c_status = FWK_E_DEVICE;
+    }
+
+    if (ctx->dma_on_going) {
+        i2c_reg->IC_DMA_CR = 0;
+        ctx->dma_on_going = false;
+
+        status = ctx->dma_api->stop(ctx->config->dma_id);
+        if (status != FWK_SUCCESS)
+            i2c_status = FWK_E_DEVICE;
+    }
+
+    i2c_reg->IC_INTR_MASK = 0;
 
     ctx->i2c_api->transaction_completed(ctx->i2c_id, i2c_status);
 }
@@ -137,86 +343,72 @@ static void i2c_isr(uintptr_t data)
 static int transmit_as_master(fwk_id_t dev_id,
                               struct mod_i2c_request *transmit_request)
 {
-    int status;
-    unsigned int sent_bytes;
     struct dw_apb_i2c_ctx *ctx;
 
-
-    if (transmit_request->transmit_byte_count > I2C_TRANSMIT_BUFFER_LENGTH)
-        return FWK_E_SUPPORT;
-
     if (transmit_request->slave_address == 0)
         return FWK_E_PARAM;
 
     ctx = ctx_table + fwk_id_get_element_idx(dev_id);
 
-    status = enable_i2c(ctx, transmit_request->slave_address);
-    if (status != FWK_SUCCESS)
-        return FWK_E_DEVICE;
+    ctx->request_message = (struct mod_i2c_message) {
+        .data = transmit_request->transmit_data,
+        .byte_count = transmit_request->transmit_byte_count,
+        .read = false,
+    };
 
-    /* The program of the I2C controller cannot be interrupted. */
-    fwk_interrupt_global_disable();
-
-    for (sent_bytes = 0; sent_bytes < transmit_request->transmit_byte_count;
-        sent_bytes++)
-        ctx->i2c_reg->IC_DATA_CMD = transmit_request->transmit_data[sent_bytes];
-
-    fwk_interrupt_global_enable();
-
-    /*
-     * The data has been pushed to the I2C FIFO for transmission to the
-     * target device. An interrupt will signal the completion of the
-     * transfer. The i2c_isr() interrupt handler will be invoked to notify
-     * the caller.
-     */
-    return FWK_PENDING;
+    return start_transfer(ctx, transmit_request->slave_address,
+                          &ctx->request_message, 1);
 }
 
 static int receive_as_master(fwk_id_t dev_id,
                              struct mod_i2c_request *receive_request)
 {
-    int status;
-    unsigned int i;
     struct dw_apb_i2c_ctx *ctx;
 
-
-    if (receive_request->receive_byte_count > I2C_RECEIVE_BUFFER_LENGTH)
-        return FWK_E_SUPPORT;
-
     if (receive_request->slave_address == 0)
         return FWK_E_PARAM;
 
     ctx = ctx_table + fwk_id_get_element_idx(dev_id);
 
-    ctx->byte_count = receive_request->receive_byte_count;
-    ctx->data = receive_request->receive_data;
-    ctx->read_on_going = true;
+    ctx->request_message = (struct mod_i2c_message) {
+        .data = receive_request->receive_data,
+        .byte_count = receive_request->receive_byte_count,
+        .read = true,
+    };
 
-    status = enable_i2c(ctx, receive_request->slave_address);
-    if (status != FWK_SUCCESS)
-        return FWK_E_DEVICE;
-
-    /* The program of the I2C controller cannot be interrupted. */
-    fwk_interrupt_global_disable();
+    return start_transfer(ctx, receive_request->slave_address,
+                          &ctx->request_message, 1);
+}
 
-    /* Program the I2C controller with the expected reply length in bytes. */
-    for (i = 0; i < receive_request->receive_byte_count; i++)
-        ctx->i2c_reg->IC_DATA_CMD = IC_DATA_CMD_READ;
+static int transfer_as_master(fwk_id_t dev_id,
+                              uint8_t slave_address,
+                              const struct mod_i2c_message *messages,
+                              unsigned int message_count)
+{
+    unsigned int msg;
+    struct dw_apb_i2c_ctx *ctx;
 
-    fwk_interrupt_global_enable();
+    if (slave_address == 0)
+        return FWK_E_PARAM;
 
     /*
-     * The command has been sent to the I2C for requesting data from
-     * the target device. An interrupt will signal the completion of the
-     * transfer. The i2c_isr() interrupt handler will be invoked to notify
-     * the caller.
+     * The controller only separates two messages with a repeated START when
+     * the direction changes.
      */
-    return FWK_PENDING;
+    for (msg = 1; msg < message_count; msg++) {
+        if (messages[msg].read == messages[msg - 1].read)
+            return FWK_E_SUPPORT;
+    }
+
+    ctx = ctx_table + fwk_id_get_element_idx(dev_id);
+
+    return start_transfer(ctx, slave_address, messages, message_count);
 }
 
 static const struct mod_i2c_driver_api driver_api = {
     .transmit_as_master = transmit_as_master,
-    .receive_as_master = receive_as_master
+    .receive_as_master = receive_as_master,
+    .transfer_as_master = transfer_as_master,
 };
 
 /*
@@ -235,15 +427,21 @@ static int dw_apb_i2c_element_init(fwk_id_t element_id,
                                        unsigned int sub_element_count,
                                        const void *data)
 {
+    struct dw_apb_i2c_ctx *ctx;
     struct mod_dw_apb_i2c_dev_config *config =
         (struct mod_dw_apb_i2c_dev_config *)data;
 
     if (config->reg == 0)
         return FWK_E_DATA;
 
-    ctx_table[fwk_id_get_element_idx(element_id)].config = config;
-    ctx_table[fwk_id_get_element_idx(element_id)].i2c_reg =
-        (struct dw_apb_i2c_reg *)config->reg;
+    if (config->fifo_threshold >= I2C_TRANSMIT_BUFFER_LENGTH)
+        return FWK_E_DATA;
+
+    ctx = ctx_table + fwk_id_get_element_idx(element_id);
+    ctx->config = config;
+    ctx->i2c_reg = (struct dw_apb_i2c_reg *)config->reg;
+    ctx->fifo_threshold = (config->fifo_threshold != 0) ?
+        config->fifo_threshold : I2C_FIFO_THRESHOLD;
 
     return FWK_SUCCESS;
 }
@@ -265,6 +463,13 @@ static int dw_apb_i2c_bind(fwk_id_t id, unsigned int round)
     if (status != FWK_SUCCESS)
         return status;
 
+    if (config->dma_min_byte_count != 0) {
+        status = fwk_module_bind(config->dma_id, config->dma_api_id,
+            &ctx->dma_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     return fwk_module_bind(ctx->i2c_id, mod_i2c_api_id_driver_response,
         &ctx->i2c_api);
 }
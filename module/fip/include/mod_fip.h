@@ -28,6 +28,11 @@
  * \details This module provides a table of descriptors that each describe a
  *      block of firmware image entry in the underlying storage.
  *
+ *      The ToC is parsed once, on the first lookup, and the location of every
+ *      known entry is kept in RAM. Later lookups in the same FIP are answered
+ *      without reading the ToC again, so the FIP must not change while the
+ *      firmware is running.
+ *
  * \{
  */
 
@@ -46,6 +51,8 @@ enum mod_fip_toc_entry_type {
     MOD_FIP_TOC_ENTRY_MCP_BL2,
     /*! TF-A runtime firmware BL31 */
     MOD_FIP_TOC_ENTRY_TFA_BL31,
+    /*! Number of FIP TOC entry types */
+    MOD_FIP_TOC_ENTRY_COUNT,
 };
 /*!
  * \}
@@ -17,8 +17,41 @@
 #include <fwk_status.h>
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <string.h>
 
+/* Location of a FIP entry, as read from the ToC */
+struct fip_entry_cache {
+    /* Whether the entry is present in the ToC */
+    bool found;
+
+    /* Offset of the entry data from the ToC base */
+    uint64_t offset_address;
+
+    /* Size of the entry data */
+    uint64_t size;
+
+    /* Entry flags */
+    uint64_t flags;
+};
+
+/* Module context */
+struct fip_ctx {
+    /* Whether the cache describes the FIP below */
+    bool cached;
+
+    /* Base address of the cached FIP ToC */
+    uintptr_t base;
+
+    /* Size of the media of the cached FIP ToC */
+    size_t limit;
+
+    /* Location of every entry type, indexed by mod_fip_toc_entry_type */
+    struct fip_entry_cache entries[MOD_FIP_TOC_ENTRY_COUNT];
+};
+
+static struct fip_ctx fip_ctx;
+
 /*
  * Static helpers
  */
@@ -62,19 +95,19 @@ static bool validate_fip_toc(const struct fip_toc *const toc)
 }
 
 /*
- * Module API functions
+ * Walk the ToC once and record the location of the first entry of every known
+ * type.
  */
-static int fip_get_entry(
-    enum mod_fip_toc_entry_type type,
-    struct mod_fip_entry_data *const entry_data,
-    uintptr_t base,
-    size_t limit)
+static int parse_fip_toc(uintptr_t base, size_t limit)
 {
-    uintptr_t address;
-    struct fip_uuid target_uuid;
-    struct fip_toc_entry *toc_entry;
     int status;
-    struct fip_toc *toc = (void *)base;
+    unsigned int type;
+    struct fip_uuid uuids[MOD_FIP_TOC_ENTRY_COUNT];
+    struct fip_entry_cache *cache;
+    const struct fip_toc_entry *toc_entry;
+    const struct fip_toc *toc = (const void *)base;
+
+    fip_ctx.cached = false;
 
     if (!validate_fip_toc(toc)) {
         /*
@@ -88,34 +121,78 @@ static int fip_get_entry(
         return FWK_E_PARAM;
     }
 
-    toc_entry = toc->entry;
+    for (type = 0; type < MOD_FIP_TOC_ENTRY_COUNT; type++) {
+        status = fip_entry_type_to_uuid(type, &uuids[type]);
+        if (status != FWK_SUCCESS)
+            return status;
 
-    status = fip_entry_type_to_uuid(type, &target_uuid);
-    if (status != FWK_SUCCESS)
-        return status;
+        fip_ctx.entries[type].found = false;
+    }
 
-    /*
-     * Traverse all FIP ToC entries until the desired entry is found or ToC
-     * End Marker is reached
-     */
-    while (!uuid_cmp(&toc_entry->uuid, &target_uuid)) {
-        if (uuid_is_null(&toc_entry->uuid))
-            return FWK_E_RANGE;
-        toc_entry++;
+    /* Traverse all FIP ToC entries until the ToC End Marker is reached */
+    for (toc_entry = toc->entry; !uuid_is_null(&toc_entry->uuid);
+         toc_entry++) {
+        if ((uintptr_t)(toc_entry + 1) - base > limit)
+            return FWK_E_DATA;
+
+        for (type = 0; type < MOD_FIP_TOC_ENTRY_COUNT; type++) {
+            cache = &fip_ctx.entries[type];
+            if (cache->found || !uuid_cmp(&toc_entry->uuid, &uuids[type]))
+                continue;
+
+            cache->found = true;
+            cache->offset_address = toc_entry->offset_address;
+            cache->size = toc_entry->size;
+            cache->flags = toc_entry->flags;
+        }
     }
 
+    fip_ctx.base = base;
+    fip_ctx.limit = limit;
+    fip_ctx.cached = true;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Module API functions
+ */
+static int fip_get_entry(
+    enum mod_fip_toc_entry_type type,
+    struct mod_fip_entry_data *const entry_data,
+    uintptr_t base,
+    size_t limit)
+{
+    uintptr_t address;
+    const struct fip_entry_cache *cache;
+    int status;
+
+    if ((unsigned int)type >= MOD_FIP_TOC_ENTRY_COUNT)
+        return FWK_E_PARAM;
+
+    if (!fip_ctx.cached || (fip_ctx.base != base) ||
+        (fip_ctx.limit != limit)) {
+        status = parse_fip_toc(base, limit);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    cache = &fip_ctx.entries[type];
+    if (!cache->found)
+        return FWK_E_RANGE;
+
     /* Sanity checks of the retrieved entry data */
     if (__builtin_add_overflow(
-            (uintptr_t)toc, (uintptr_t)toc_entry->offset_address, &address)) {
+            base, (uintptr_t)cache->offset_address, &address)) {
         return FWK_E_DATA;
     }
 
-    if ((uintptr_t)toc_entry->offset_address + toc_entry->size > limit)
+    if ((uintptr_t)cache->offset_address + cache->size > limit)
         return FWK_E_SIZE;
 
     entry_data->base = (void *)address;
-    entry_data->size = toc_entry->size;
-    entry_data->flags = toc_entry->flags;
+    entry_data->size = cache->size;
+    entry_data->flags = cache->flags;
     return FWK_SUCCESS;
 }
 
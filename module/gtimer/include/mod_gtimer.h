@@ -53,6 +53,11 @@ struct mod_gtimer_dev_config {
  *
  * \details This function is intended to be used by a firmware to register a
  *      generic timer as the driver for the framework time component.
+ *      The high half of the counter is only sampled again when the low half
+ *      may have just wrapped around, and the timestamps are converted to
+ *      nanoseconds without any division.
+ *
+ * \note The driver context is shared, only one device may be registered.
  *
  * \param[out] ctx Pointer to storage for the context passed to the driver.
  * \param[in] cfg Generic timer configuration.
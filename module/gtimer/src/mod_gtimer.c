@@ -42,22 +42,37 @@ static struct mod_gtimer_ctx {
     struct dev_ctx *table; /* Device context table */
 } mod_gtimer_ctx;
 
+/* Framework time driver context */
+static struct mod_gtimer_time_ctx {
+    /* Timer registers of the device */
+    const struct cntbase_reg *hw_timer;
+
+    /* Integral part of the number of nanoseconds per tick */
+    uint64_t ns_per_tick;
+
+    /* Fractional part of the number of nanoseconds per tick, in 1/2^32 */
+    uint32_t ns_per_tick_frac;
+} mod_gtimer_time_ctx;
+
 static uint64_t mod_gtimer_get_counter(const struct cntbase_reg *hw_timer)
 {
     uint32_t counter_low;
     uint32_t counter_high;
 
     /*
-     * To avoid race conditions where the high half of the counter increments
-     * after it has been sampled but before the low half is sampled, the values
-     * are resampled until the high half has stabilized. This assumes that the
-     * loop is faster than the high half incrementation.
+     * The high half of the counter may increment after it has been sampled
+     * but before the low half is sampled, in which case the low half has just
+     * wrapped around. When the low half is in the upper half of its range, it
+     * cannot have wrapped around since the high half was sampled and the
+     * sample is consistent. Otherwise the high half is sampled again, and as
+     * the low half is far from wrapping around again, this second sample is
+     * consistent with it. This assumes that less than 2^31 ticks elapse
+     * between the samples.
      */
-
-    do {
+    counter_high = hw_timer->PCTH;
+    counter_low = hw_timer->PCTL;
+    if ((counter_low & UINT32_C(0x80000000)) == 0)
         counter_high = hw_timer->PCTH;
-        counter_low = hw_timer->PCTL;
-    } while (counter_high != hw_timer->PCTH);
 
     return ((uint64_t)counter_high << 32) | counter_low;
 }
@@ -298,24 +313,34 @@ const struct fwk_module module_gtimer = {
 
 static fwk_timestamp_t mod_gtimer_timestamp(const void *ctx)
 {
-    fwk_timestamp_t timestamp;
-
-    const struct mod_gtimer_dev_config *cfg = ctx;
-    const struct cntbase_reg *hw_timer = (const void *)cfg->hw_timer;
-
-    uint32_t frequency = cfg->frequency;
-    uint64_t counter = mod_gtimer_get_counter(hw_timer);
+    const struct mod_gtimer_time_ctx *time_ctx = ctx;
+    uint64_t counter = mod_gtimer_get_counter(time_ctx->hw_timer);
 
-    timestamp = (FWK_S(1) / frequency) * counter;
-
-    return timestamp;
+    /*
+     * Convert the ticks with the fixed-point number of nanoseconds per tick,
+     * the fractional part being applied to each half of the counter so that
+     * the products fit in 64 bits.
+     */
+    return (counter * time_ctx->ns_per_tick) +
+        ((counter >> 32) * time_ctx->ns_per_tick_frac) +
+        (((counter & UINT32_MAX) * time_ctx->ns_per_tick_frac) >> 32);
 }
 
 struct fwk_time_driver mod_gtimer_driver(
     const void **ctx,
     const struct mod_gtimer_dev_config *cfg)
 {
-    *ctx = cfg;
+    struct mod_gtimer_time_ctx *time_ctx = &mod_gtimer_time_ctx;
+
+    fwk_assert(cfg->frequency >= GTIMER_FREQUENCY_MIN_HZ);
+
+    /* Calibrate the conversion once, so that timestamps need no division */
+    time_ctx->hw_timer = (const struct cntbase_reg *)cfg->hw_timer;
+    time_ctx->ns_per_tick = FWK_S(1) / cfg->frequency;
+    time_ctx->ns_per_tick_frac =
+        (uint32_t)(((FWK_S(1) % cfg->frequency) << 32) / cfg->frequency);
+
+    *ctx = time_ctx;
 
     return (struct fwk_time_driver){
         .timestamp = mod_gtimer_timestamp,
@@ -45,8 +45,59 @@ struct mod_i2c_dev_config {
 
     /*! Identifier of the driver API. */
     fwk_id_t api_id;
+
+    /*!
+     * \brief Maximum number of requests queued on the device, including the
+     *      requests in progress.
+     *
+     * \details When zero, ::MOD_I2C_DEFAULT_QUEUE_LENGTH is used.
+     */
+    unsigned int queue_length;
 };
 
+/*! Default maximum number of requests queued on an I2C device */
+#define MOD_I2C_DEFAULT_QUEUE_LENGTH 8
+
+/*!
+ * \brief Maximum number of messages in a transfer.
+ *
+ * \details Bounds both the scatter-gather requests and the number of
+ *      messages of queued requests merged into a single transfer.
+ */
+#define MOD_I2C_TRANSFER_MESSAGE_MAX 8
+
+/*!
+ * \brief Message of an I2C transfer.
+ */
+struct mod_i2c_message {
+    /*! Pointer to the data to transmit or to the buffer to receive into */
+    uint8_t *data;
+
+    /*! Number of data bytes to transmit or receive */
+    uint8_t byte_count;
+
+    /*! \c true to receive data from the slave, \c false to transmit */
+    bool read;
+};
+
+/*!
+ * \brief Scatter-gather transfer request parameters.
+ */
+struct mod_i2c_transfer_request {
+    /*! Messages of the transfer */
+    struct mod_i2c_message *messages;
+
+    /*! Number of messages */
+    uint8_t message_count;
+
+    /*! Address of the slave on the I2C bus */
+    uint8_t slave_address;
+};
+
+static_assert(sizeof(struct mod_i2c_transfer_request) <=
+    FWK_EVENT_PARAMETERS_SIZE,
+    "An I2C transfer request should fit in the params field of an event\n");
+
 /*!
  * \brief Parameters of the event.
  */
@@ -133,6 +184,34 @@ struct mod_i2c_driver_api {
      */
     int (*receive_as_master)(
         fwk_id_t dev_id, struct mod_i2c_request *receive_request);
+
+    /*!
+     * \brief Request a sequence of messages to a selected slave as a single
+     *      transaction, with a repeated START between the messages and a
+     *      single STOP at the end.
+     *
+     * \details This function is optional and may be NULL. When provided, the
+     *      I2C HAL module uses it for the scatter-gather requests and to merge
+     *      queued requests to the same slave. The completion is reported as
+     *      for the other requests. The message array stays valid until then.
+     *
+     * \param dev_id Identifier of the I2C device
+     * \param slave_address Address of the slave on the I2C bus
+     * \param messages Messages of the transaction
+     * \param message_count Number of messages
+     *
+     * \retval ::FWK_PENDING The request was submitted.
+     * \retval ::FWK_SUCCESS The request was successfully completed.
+     * \retval ::FWK_E_SUPPORT The driver cannot perform this sequence as a
+     *      single transaction. The I2C HAL module then performs the messages
+     *      one at a time.
+     * \return One of the standard framework status codes.
+     */
+    int (*transfer_as_master)(
+        fwk_id_t dev_id,
+        uint8_t slave_address,
+        const struct mod_i2c_message *messages,
+        unsigned int message_count);
 };
 
 /*!
@@ -215,6 +294,30 @@ struct mod_i2c_api {
     int (*transmit_then_receive_as_master)(fwk_id_t dev_id,
         uint8_t slave_address, uint8_t *transmit_data, uint8_t *receive_data,
         uint8_t transmit_byte_count, uint8_t receive_byte_count);
+
+    /*!
+     * \brief Request a scatter-gather transfer of messages as Master to/from
+     *      a selected slave.
+     *
+     * \details The messages are performed in order, as a single transaction
+     *      with repeated STARTs when the driver supports it, and one at a time
+     *      otherwise. The message array and the data buffers must stay
+     *      allocated and unmodified until the transfer is completed or
+     *      aborted. When the transfer has finished a response event is sent to
+     *      the client.
+     *
+     * \param dev_id Identifier of the I2C device
+     * \param slave_address Address of the slave on the I2C bus
+     * \param messages Messages of the transfer
+     * \param message_count Number of messages, at most
+     *      ::MOD_I2C_TRANSFER_MESSAGE_MAX
+     *
+     * \retval ::FWK_PENDING The request was submitted.
+     * \retval ::FWK_E_PARAM One or more parameters were invalid.
+     * \return One of the standard framework status codes.
+     */
+    int (*transfer_as_master)(fwk_id_t dev_id, uint8_t slave_address,
+        struct mod_i2c_message *messages, uint8_t message_count);
 };
 
 /*!
@@ -264,6 +367,7 @@ enum mod_i2c_event_idx {
     MOD_I2C_EVENT_IDX_REQUEST_TRANSMIT,
     MOD_I2C_EVENT_IDX_REQUEST_RECEIVE,
     MOD_I2C_EVENT_IDX_REQUEST_TRANSMIT_THEN_RECEIVE,
+    MOD_I2C_EVENT_IDX_REQUEST_TRANSFER,
     MOD_I2C_EVENT_IDX_COUNT,
 };
 
@@ -279,6 +383,10 @@ static const fwk_id_t mod_i2c_event_id_request_rx = FWK_ID_EVENT_INIT(
 static const fwk_id_t mod_i2c_event_id_request_tx_rx = FWK_ID_EVENT_INIT(
     FWK_MODULE_IDX_I2C, MOD_I2C_EVENT_IDX_REQUEST_TRANSMIT_THEN_RECEIVE);
 
+/*! Scatter-gather transfer request event identifier */
+static const fwk_id_t mod_i2c_event_id_request_transfer = FWK_ID_EVENT_INIT(
+    FWK_MODULE_IDX_I2C, MOD_I2C_EVENT_IDX_REQUEST_TRANSFER);
+
 /*!
  * \}
  */
@@ -20,25 +20,55 @@
 
 enum mod_i2c_dev_state {
     MOD_I2C_DEV_IDLE,
-    MOD_I2C_DEV_TX,
-    MOD_I2C_DEV_RX,
-    MOD_I2C_DEV_TX_RX,
-    MOD_I2C_DEV_RELOAD,
+    MOD_I2C_DEV_TRANSFER,
+    MOD_I2C_DEV_MESSAGE,
     MOD_I2C_DEV_PANIC,
 };
 
+/* Request waiting in the queue of an I2C device */
+struct mod_i2c_queue_entry {
+    /* Cookie of the request event, identifies the delayed response */
+    uint32_t cookie;
+
+    /* Address of the slave on the I2C bus */
+    uint8_t slave_address;
+
+    /* Number of messages of the request */
+    uint8_t message_count;
+
+    /* Messages of the request */
+    struct mod_i2c_message *messages;
+
+    /* Storage for the messages of the transmit and receive requests */
+    struct mod_i2c_message request_messages[2];
+};
+
 struct mod_i2c_dev_ctx {
     const struct mod_i2c_dev_config *config;
     const struct mod_i2c_driver_api *driver_api;
     struct mod_i2c_request request;
     enum mod_i2c_dev_state state;
+
+    /* Ring of queued requests, starting with the ones in progress */
+    struct mod_i2c_queue_entry *queue;
+    unsigned int queue_length;
+    unsigned int queue_head;
+    unsigned int queue_count;
+
+    /* Number of queued requests covered by the transfer in progress */
+    unsigned int transfer_request_count;
+
+    /* Message in progress when the messages are performed one at a time */
+    unsigned int message_idx;
+
+    /* Messages of the transfer in progress */
+    struct mod_i2c_message messages[MOD_I2C_TRANSFER_MESSAGE_MAX];
 };
 
 static struct mod_i2c_dev_ctx *ctx_table;
 
 enum mod_i2c_internal_event_idx {
     MOD_I2C_EVENT_IDX_REQUEST_COMPLETED = MOD_I2C_EVENT_IDX_COUNT,
-    MOD_I2C_EVENT_IDX_RELOAD,
     MOD_I2C_EVENT_IDX_TOTAL_COUNT,
 };
 
@@ -46,10 +76,6 @@ enum mod_i2c_internal_event_idx {
 static const fwk_id_t mod_i2c_event_id_request_completed = FWK_ID_EVENT_INIT(
     FWK_MODULE_IDX_I2C, MOD_I2C_EVENT_IDX_REQUEST_COMPLETED);
 
-/*! Reload event identifier */
-static const fwk_id_t mod_i2c_event_id_reload = FWK_ID_EVENT_INIT(
-    FWK_MODULE_IDX_I2C, MOD_I2C_EVENT_IDX_RELOAD);
-
 /*
  * Static helpers
  */
@@ -168,10 +194,55 @@ static int transmit_then_receive_as_master(fwk_id_t dev_id,
     return create_i2c_request(dev_id, &request);
 }
 
+static int transfer_as_master(fwk_id_t dev_id,
+                              uint8_t slave_address,
+                              struct mod_i2c_message *messages,
+                              uint8_t message_count)
+{
+    int status;
+    unsigned int i;
+    struct fwk_event event;
+    struct mod_i2c_transfer_request *event_param =
+        (struct mod_i2c_transfer_request *)event.params;
+
+    /* The slave address should be on 7 bits */
+    if (!fwk_expect(slave_address < 0x80))
+        return FWK_E_PARAM;
+
+    if (!fwk_expect((messages != NULL) && (message_count != 0) &&
+                    (message_count <= MOD_I2C_TRANSFER_MESSAGE_MAX)))
+        return FWK_E_PARAM;
+
+    for (i = 0; i < message_count; i++) {
+        if (!fwk_expect((messages[i].data != NULL) &&
+                        (messages[i].byte_count != 0)))
+            return FWK_E_PARAM;
+    }
+
+    event = (struct fwk_event) {
+        .target_id = dev_id,
+        .id = mod_i2c_event_id_request_transfer,
+        .response_requested = true,
+    };
+
+    *event_param = (struct mod_i2c_transfer_request) {
+        .messages = messages,
+        .message_count = message_count,
+        .slave_address = slave_address,
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_SUCCESS)
+        return FWK_PENDING;
+
+    return status;
+}
+
 static struct mod_i2c_api i2c_api = {
     .transmit_as_master = transmit_as_master,
     .receive_as_master = receive_as_master,
     .transmit_then_receive_as_master = transmit_then_receive_as_master,
+    .transfer_as_master = transfer_as_master,
 };
 
 /*
@@ -221,6 +292,10 @@ static int mod_i2c_dev_init(fwk_id_t element_id,
     ctx = ctx_table + fwk_id_get_element_idx(element_id);
     ctx->config = (struct mod_i2c_dev_config *)data;
 
+    ctx->queue_length = (ctx->config->queue_length != 0) ?
+        ctx->config->queue_length : MOD_I2C_DEFAULT_QUEUE_LENGTH;
+    ctx->queue = fwk_mm_calloc(ctx->queue_length, sizeof(ctx->queue[0]));
+
     return FWK_SUCCESS;
 }
 
@@ -275,127 +350,282 @@ static int mod_i2c_process_bind_request(fwk_id_t source_id,
     return FWK_SUCCESS;
 }
 
-static int respond_to_caller(
+static struct mod_i2c_queue_entry *get_queue_entry(
+    struct mod_i2c_dev_ctx *ctx,
+    unsigned int idx)
+{
+    return &ctx->queue[(ctx->queue_head + idx) % ctx->queue_length];
+}
+
+static int queue_request(
+    struct mod_i2c_dev_ctx *ctx,
+    const struct fwk_event *event)
+{
+    struct mod_i2c_queue_entry *entry;
+    const struct mod_i2c_request *request;
+    const struct mod_i2c_transfer_request *transfer;
+
+    if (ctx->queue_count == ctx->queue_length)
+        return FWK_E_BUSY;
+
+    entry = get_queue_entry(ctx, ctx->queue_count);
+    entry->cookie = event->cookie;
+
+    if (fwk_id_get_event_idx(event->id) == MOD_I2C_EVENT_IDX_REQUEST_TRANSFER) {
+        transfer = (const struct mod_i2c_transfer_request *)event->params;
+
+        entry->slave_address = transfer->slave_address;
+        entry->messages = transfer->messages;
+        entry->message_count = transfer->message_count;
+    } else {
+        request = (const struct mod_i2c_request *)event->params;
+
+        entry->slave_address = request->slave_address;
+        entry->messages = entry->request_messages;
+        entry->message_count = 0;
+
+        if (request->transmit_byte_count > 0) {
+            entry->messages[entry->message_count++] = (struct mod_i2c_message) {
+                .data = request->transmit_data,
+                .byte_count = request->transmit_byte_count,
+                .read = false,
+            };
+        }
+
+        if (request->receive_byte_count > 0) {
+            entry->messages[entry->message_count++] = (struct mod_i2c_message) {
+                .data = request->receive_data,
+                .byte_count = request->receive_byte_count,
+                .read = true,
+            };
+        }
+
+        if (entry->message_count == 0)
+            return FWK_E_PARAM;
+    }
+
+    ctx->queue_count++;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Respond to the requests covered by the transfer that has just completed and
+ * remove them from the queue. The response to the request being processed, if
+ * any, is not delayed yet and is given through 'resp_event'.
+ */
+static int complete_requests(
     fwk_id_t dev_id,
     struct mod_i2c_dev_ctx *ctx,
-    int drv_status)
+    int drv_status,
+    struct fwk_event *resp_event)
 {
     int status;
     struct fwk_event resp;
-    struct mod_i2c_event_param *param =
-        (struct mod_i2c_event_param *)resp.params;
+    struct mod_i2c_queue_entry *entry;
+    struct mod_i2c_event_param *param;
 
-    status = fwk_thread_get_first_delayed_response(dev_id, &resp);
-    if (status != FWK_SUCCESS)
-        return status;
+    drv_status = (drv_status == FWK_SUCCESS) ? FWK_SUCCESS : FWK_E_DEVICE;
+
+    for (; ctx->transfer_request_count > 0; ctx->transfer_request_count--) {
+        entry = get_queue_entry(ctx, 0);
+        ctx->queue_head = (ctx->queue_head + 1) % ctx->queue_length;
+        ctx->queue_count--;
+
+        if ((resp_event != NULL) && (entry->cookie == resp_event->cookie)) {
+            param = (struct mod_i2c_event_param *)resp_event->params;
+            param->status = drv_status;
+            resp_event->is_delayed_response = false;
+            continue;
+        }
+
+        status = fwk_thread_get_delayed_response(dev_id, entry->cookie, &resp);
+        if (status != FWK_SUCCESS)
+            return status;
 
-    param->status = (drv_status == FWK_SUCCESS) ? FWK_SUCCESS : FWK_E_DEVICE;
+        param = (struct mod_i2c_event_param *)resp.params;
+        param->status = drv_status;
 
-    return fwk_thread_put_event(&resp);
+        status = fwk_thread_put_event(&resp);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
 }
 
-static int process_request(struct mod_i2c_dev_ctx *ctx, fwk_id_t event_id)
+/*
+ * Perform the messages of the request at the head of the queue one at a time,
+ * from the current message, with the transmit and receive driver functions.
+ */
+static int process_messages(struct mod_i2c_dev_ctx *ctx)
 {
-    int drv_status = FWK_E_PARAM;
+    int drv_status;
+    const struct mod_i2c_queue_entry *entry = get_queue_entry(ctx, 0);
+    const struct mod_i2c_message *message;
     const struct mod_i2c_driver_api *driver_api = ctx->driver_api;
     fwk_id_t driver_id = ctx->config->driver_id;
 
-    switch (fwk_id_get_event_idx(event_id)) {
-    case MOD_I2C_EVENT_IDX_REQUEST_TRANSMIT:
-        ctx->state = MOD_I2C_DEV_TX;
-        drv_status = driver_api->transmit_as_master(driver_id, &ctx->request);
-        break;
+    ctx->state = MOD_I2C_DEV_MESSAGE;
+    ctx->transfer_request_count = 1;
 
-    case MOD_I2C_EVENT_IDX_REQUEST_TRANSMIT_THEN_RECEIVE:
-        ctx->state = MOD_I2C_DEV_TX_RX;
-        drv_status = driver_api->transmit_as_master(driver_id, &ctx->request);
+    for (; ctx->message_idx < entry->message_count; ctx->message_idx++) {
+        message = &entry->messages[ctx->message_idx];
+
+        ctx->request = (struct mod_i2c_request) {
+            .slave_address = entry->slave_address,
+        };
+
+        if (message->read) {
+            ctx->request.receive_data = message->data;
+            ctx->request.receive_byte_count = message->byte_count;
+            drv_status = driver_api->receive_as_master(driver_id,
+                                                       &ctx->request);
+        } else {
+            ctx->request.transmit_data = message->data;
+            ctx->request.transmit_byte_count = message->byte_count;
+            drv_status = driver_api->transmit_as_master(driver_id,
+                                                        &ctx->request);
+        }
 
         if (drv_status != FWK_SUCCESS) {
-            /* The request has failed or been acknowledged */
-            break;
+            /* The message has failed or is in progress */
+            return drv_status;
         }
-        /* fall through */
+    }
 
-    case MOD_I2C_EVENT_IDX_REQUEST_RECEIVE:
-        ctx->state = MOD_I2C_DEV_RX;
-        drv_status = driver_api->receive_as_master(driver_id, &ctx->request);
-        break;
+    return FWK_SUCCESS;
+}
+
+/*
+ * Gather the messages of the consecutive queued requests to the same slave as
+ * the request at the head of the queue, as long as they fit in a transfer.
+ */
+static unsigned int merge_requests(
+    struct mod_i2c_dev_ctx *ctx,
+    unsigned int *message_count)
+{
+    unsigned int request_count;
+    const struct mod_i2c_queue_entry *head = get_queue_entry(ctx, 0);
+    const struct mod_i2c_queue_entry *entry;
+
+    *message_count = 0;
+
+    for (request_count = 0; request_count < ctx->queue_count;
+         request_count++) {
+        entry = get_queue_entry(ctx, request_count);
+
+        if ((entry->slave_address != head->slave_address) ||
+            ((*message_count + entry->message_count) >
+             MOD_I2C_TRANSFER_MESSAGE_MAX))
+            break;
+
+        memcpy(&ctx->messages[*message_count], entry->messages,
+               entry->message_count * sizeof(ctx->messages[0]));
+        *message_count += entry->message_count;
     }
 
-    return drv_status;
+    return request_count;
 }
 
-static int reload(fwk_id_t dev_id, struct mod_i2c_dev_ctx *ctx)
+static int start_transfer(struct mod_i2c_dev_ctx *ctx)
 {
-    int status;
-    bool is_empty;
-    struct fwk_event event;
+    int drv_status;
+    unsigned int request_count, message_count;
+    const struct mod_i2c_driver_api *driver_api = ctx->driver_api;
 
-    status = fwk_thread_is_delayed_response_list_empty(dev_id, &is_empty);
-    if (status != FWK_SUCCESS)
-        return status;
+    ctx->message_idx = 0;
 
-    if (is_empty)
-        ctx->state = MOD_I2C_DEV_IDLE;
-    else {
-        ctx->state = MOD_I2C_DEV_RELOAD;
-        event = (struct fwk_event) {
-            .target_id = dev_id,
-            .id = mod_i2c_event_id_reload,
-        };
-        status = fwk_thread_put_event(&event);
-   }
+    if (driver_api->transfer_as_master == NULL)
+        return process_messages(ctx);
+
+    ctx->state = MOD_I2C_DEV_TRANSFER;
+
+    request_count = merge_requests(ctx, &message_count);
 
-   return status;
+    for (;;) {
+        drv_status = driver_api->transfer_as_master(ctx->config->driver_id,
+            get_queue_entry(ctx, 0)->slave_address, ctx->messages,
+            message_count);
+        if (drv_status != FWK_E_SUPPORT) {
+            ctx->transfer_request_count = request_count;
+            return drv_status;
+        }
+
+        if (request_count == 1)
+            break;
+
+        /* Retry with the request at the head of the queue alone */
+        request_count = 1;
+        message_count = get_queue_entry(ctx, 0)->message_count;
+    }
+
+    /* The driver cannot perform the request as a single transfer */
+    return process_messages(ctx);
 }
 
-static int process_next_request(fwk_id_t dev_id, struct mod_i2c_dev_ctx *ctx)
+/*
+ * Start the transfers of the queued requests until one of them is in progress
+ * or the queue is empty.
+ */
+static int process_queue(
+    fwk_id_t dev_id,
+    struct mod_i2c_dev_ctx *ctx,
+    struct fwk_event *resp_event)
 {
     int status, drv_status;
-    bool is_empty;
-    struct fwk_event delayed_response;
-    struct mod_i2c_request *request;
-    struct mod_i2c_event_param *event_param;
 
-    status = fwk_thread_is_delayed_response_list_empty(dev_id, &is_empty);
-    if (status != FWK_SUCCESS)
-        return status;
+    while (ctx->queue_count > 0) {
+        drv_status = start_transfer(ctx);
+        if (drv_status == FWK_PENDING)
+            return FWK_SUCCESS;
 
-    if (is_empty) {
-        ctx->state = MOD_I2C_DEV_IDLE;
-        return FWK_SUCCESS;
+        /* The transfer has succeeded or failed, respond now */
+        status = complete_requests(dev_id, ctx, drv_status, resp_event);
+        if (status != FWK_SUCCESS)
+            return status;
     }
 
-    status = fwk_thread_get_first_delayed_response(
-        dev_id, &delayed_response);
-    if (status != FWK_SUCCESS)
-        return status;
+    ctx->state = MOD_I2C_DEV_IDLE;
+
+    return FWK_SUCCESS;
+}
+
+static int process_completion(
+    fwk_id_t dev_id,
+    struct mod_i2c_dev_ctx *ctx,
+    int drv_status)
+{
+    int status;
 
-    request = (struct mod_i2c_request *)delayed_response.params;
-    ctx->request = *request;
+    if ((ctx->state != MOD_I2C_DEV_TRANSFER) &&
+        (ctx->state != MOD_I2C_DEV_MESSAGE))
+        return FWK_E_STATE;
 
-    drv_status = process_request(ctx, delayed_response.id);
-    if (drv_status != FWK_PENDING) {
-        event_param = (struct mod_i2c_event_param *)delayed_response.params;
-        event_param->status = drv_status;
+    if ((ctx->state == MOD_I2C_DEV_MESSAGE) && (drv_status == FWK_SUCCESS)) {
+        /* The message succeeded, proceed with the next one */
+        ctx->message_idx++;
 
-        status = fwk_thread_put_event(&delayed_response);
-        if (status == FWK_SUCCESS)
-            status = reload(dev_id, ctx);
+        drv_status = process_messages(ctx);
+        if (drv_status == FWK_PENDING)
+            return FWK_SUCCESS;
     }
 
-    return status;
+    status = complete_requests(dev_id, ctx, drv_status, NULL);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return process_queue(dev_id, ctx, NULL);
 }
 
 static int mod_i2c_process_event(const struct fwk_event *event,
                                  struct fwk_event *resp_event)
 {
     fwk_id_t dev_id;
-    int status, drv_status;
+    int status;
     bool is_request;
     struct mod_i2c_dev_ctx *ctx;
-    struct mod_i2c_request *request;
-    struct mod_i2c_event_param *event_param, *resp_param;
+    struct mod_i2c_event_param *event_param;
 
     dev_id = event->target_id;
     get_ctx(dev_id, &ctx);
@@ -403,78 +633,33 @@ static int mod_i2c_process_event(const struct fwk_event *event,
     is_request = fwk_id_get_event_idx(event->id) < MOD_I2C_EVENT_IDX_COUNT;
 
     if (is_request) {
+        event_param = (struct mod_i2c_event_param *)resp_event->params;
+
         if (ctx->state == MOD_I2C_DEV_PANIC) {
-            event_param = (struct mod_i2c_event_param *)resp_event->params;
             event_param->status = FWK_E_PANIC;
 
-            return FWK_SUCCESS;
-        } else if (ctx->state != MOD_I2C_DEV_IDLE) {
-            resp_event->is_delayed_response = true;
-
             return FWK_SUCCESS;
         }
 
-        request = (struct mod_i2c_request *)event->params;
-        ctx->request = *request;
-
-        drv_status = process_request(ctx, event->id);
+        status = queue_request(ctx, event);
+        if (status != FWK_SUCCESS) {
+            event_param->status = status;
 
-        if (drv_status == FWK_PENDING)
-            resp_event->is_delayed_response = true;
-        else {
-            /* The request has succeeded or failed, respond now */
-            resp_param = (struct mod_i2c_event_param *)resp_event->params;
-
-            resp_param->status = (drv_status == FWK_SUCCESS) ?
-                                 FWK_SUCCESS : FWK_E_DEVICE;
-            ctx->state = MOD_I2C_DEV_IDLE;
+            return FWK_SUCCESS;
         }
 
-        return FWK_SUCCESS;
-    }
-
-    switch (fwk_id_get_event_idx(event->id)) {
-    case MOD_I2C_EVENT_IDX_REQUEST_COMPLETED:
-        event_param = (struct mod_i2c_event_param *)event->params;
-
-        if ((ctx->state == MOD_I2C_DEV_TX) || (ctx->state == MOD_I2C_DEV_RX)) {
-            status = respond_to_caller(dev_id, ctx, event_param->status);
-            if (status == FWK_SUCCESS)
-                status = process_next_request(dev_id, ctx);
-
-        } else if (ctx->state == MOD_I2C_DEV_TX_RX) {
-            drv_status = event_param->status;
+        resp_event->is_delayed_response = true;
 
-            if (drv_status == FWK_SUCCESS) {
-                /* The TX request succeeded, proceed with the RX */
-                ctx->state = MOD_I2C_DEV_RX;
-
-                drv_status = ctx->driver_api->receive_as_master(
-                    ctx->config->driver_id,
-                    &ctx->request);
-
-                if (drv_status == FWK_PENDING) {
-                    status = FWK_SUCCESS;
-                    break;
-                }
-            }
-
-            status = respond_to_caller(dev_id, ctx, drv_status);
-            if (status == FWK_SUCCESS)
-                status = process_next_request(dev_id, ctx);
-        } else
-            status = FWK_E_STATE;
-
-        break;
-
-    case MOD_I2C_EVENT_IDX_RELOAD:
-        status = process_next_request(dev_id, ctx);
-        break;
+        if (ctx->state != MOD_I2C_DEV_IDLE)
+            return FWK_SUCCESS;
 
-    default:
+        status = process_queue(dev_id, ctx, resp_event);
+    } else if (fwk_id_get_event_idx(event->id) ==
+               MOD_I2C_EVENT_IDX_REQUEST_COMPLETED) {
+        event_param = (struct mod_i2c_event_param *)event->params;
+        status = process_completion(dev_id, ctx, event_param->status);
+    } else
         status = FWK_E_PANIC;
-        break;
-    }
 
     if (status != FWK_SUCCESS)
         ctx->state = MOD_I2C_DEV_PANIC;
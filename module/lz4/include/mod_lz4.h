@@ -0,0 +1,113 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     LZ4 decompression of firmware images.
+ */
+
+#ifndef MOD_LZ4_H
+#define MOD_LZ4_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupLZ4 LZ4 Decompression
+ *
+ * \brief Decompression of LZ4 compressed firmware images.
+ *
+ * \details A compressed image is made of a ::mod_lz4_image_header followed by
+ *      a single LZ4 block, as produced by tools/compress_image.py. The block
+ *      is decoded in a single forward pass over the compressed data, so every
+ *      byte of the image is only read once from its storage.
+ *
+ * \{
+ */
+
+/*! Magic number of a compressed image ("SLZ4") */
+#define MOD_LZ4_IMAGE_MAGIC UINT32_C(0x345A4C53)
+
+/*!
+ * \brief Header of a compressed image.
+ */
+struct mod_lz4_image_header {
+    /*! Magic number, ::MOD_LZ4_IMAGE_MAGIC */
+    uint32_t magic;
+
+    /*! Size of the decompressed image in bytes */
+    uint32_t size;
+
+    /*! Size of the LZ4 block following the header in bytes */
+    uint32_t compressed_size;
+
+    /*! Reserved, zero */
+    uint32_t reserved;
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_lz4_api_idx {
+    /*! Decompression API */
+    MOD_LZ4_API_IDX_DECOMPRESS,
+
+    /*! Number of APIs */
+    MOD_LZ4_API_IDX_COUNT,
+};
+
+/*!
+ * \brief Decompression API.
+ */
+struct mod_lz4_api {
+    /*!
+     * \brief Check whether an image is compressed.
+     *
+     * \param image Base address of the image.
+     * \param size Size of the storage holding the image in bytes.
+     *
+     * \retval true The image starts with a valid compressed image header.
+     * \retval false The image is not compressed.
+     */
+    bool (*is_compressed)(const void *image, size_t size);
+
+    /*!
+     * \brief Decompress an image.
+     *
+     * \param image Base address of the compressed image.
+     * \param size Size of the storage holding the image in bytes.
+     * \param destination Base address the image is decompressed to.
+     * \param capacity Size of the destination in bytes.
+     * \param[out] decompressed_size Size of the decompressed image in bytes.
+     *
+     * \retval ::FWK_SUCCESS The image was decompressed.
+     * \retval ::FWK_E_PARAM The image is not compressed.
+     * \retval ::FWK_E_SIZE The image does not fit in its storage or in the
+     *      destination.
+     * \retval ::FWK_E_DATA The compressed data is corrupted.
+     */
+    int (*decompress)(
+        const void *image,
+        size_t size,
+        void *destination,
+        size_t capacity,
+        size_t *decompressed_size);
+};
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_LZ4_H */
@@ -0,0 +1,208 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     LZ4 decompression of firmware images.
+ */
+
+#include <mod_lz4.h>
+
+#include <fwk_id.h>
+#include <fwk_module.h>
+#include <fwk_status.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Length of a match is encoded minus this value */
+#define LZ4_MIN_MATCH 4
+
+/* Nibble value meaning that the length continues in the following bytes */
+#define LZ4_LENGTH_EXTENDED 15
+
+/*
+ * Read a length encoded as a nibble of the token followed, when the nibble is
+ * saturated, by bytes that are added to it until one is not 255.
+ */
+static int read_length(
+    const uint8_t **src,
+    const uint8_t *src_end,
+    size_t *length)
+{
+    uint8_t byte;
+
+    if (*length != LZ4_LENGTH_EXTENDED)
+        return FWK_SUCCESS;
+
+    do {
+        if (*src >= src_end)
+            return FWK_E_DATA;
+
+        byte = *(*src)++;
+        *length += byte;
+    } while (byte == UINT8_MAX);
+
+    return FWK_SUCCESS;
+}
+
+static int decompress_block(
+    const uint8_t *src,
+    size_t src_size,
+    uint8_t *dst,
+    size_t dst_capacity,
+    size_t *dst_size)
+{
+    int status;
+    const uint8_t *src_end = src + src_size;
+    uint8_t *dst_base = dst;
+    uint8_t *dst_end = dst + dst_capacity;
+    const uint8_t *match;
+    uint8_t token;
+    size_t length;
+    size_t offset;
+
+    while (src < src_end) {
+        token = *src++;
+
+        /* Literals */
+        length = token >> 4;
+        status = read_length(&src, src_end, &length);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (length > (size_t)(src_end - src))
+            return FWK_E_DATA;
+        if (length > (size_t)(dst_end - dst))
+            return FWK_E_SIZE;
+
+        memcpy(dst, src, length);
+        src += length;
+        dst += length;
+
+        /* The last sequence of the block has no match */
+        if (src == src_end)
+            break;
+
+        /* Match */
+        if ((src_end - src) < 2)
+            return FWK_E_DATA;
+
+        offset = (size_t)src[0] | ((size_t)src[1] << 8);
+        src += 2;
+        if ((offset == 0) || (offset > (size_t)(dst - dst_base)))
+            return FWK_E_DATA;
+
+        length = token & 0xF;
+        status = read_length(&src, src_end, &length);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        length += LZ4_MIN_MATCH;
+        if (length > (size_t)(dst_end - dst))
+            return FWK_E_SIZE;
+
+        /* The match may overlap the bytes it produces, copy byte by byte */
+        match = dst - offset;
+        while (length-- > 0)
+            *dst++ = *match++;
+    }
+
+    *dst_size = (size_t)(dst - dst_base);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Module API
+ */
+
+static bool lz4_is_compressed(const void *image, size_t size)
+{
+    struct mod_lz4_image_header header;
+
+    if ((image == NULL) || (size < sizeof(header)))
+        return false;
+
+    memcpy(&header, image, sizeof(header));
+
+    return header.magic == MOD_LZ4_IMAGE_MAGIC;
+}
+
+static int lz4_decompress(
+    const void *image,
+    size_t size,
+    void *destination,
+    size_t capacity,
+    size_t *decompressed_size)
+{
+    int status;
+    struct mod_lz4_image_header header;
+    size_t block_size;
+
+    if ((destination == NULL) || (decompressed_size == NULL))
+        return FWK_E_PARAM;
+
+    if (!lz4_is_compressed(image, size))
+        return FWK_E_PARAM;
+
+    memcpy(&header, image, sizeof(header));
+
+    if (header.compressed_size > (size - sizeof(header)))
+        return FWK_E_SIZE;
+    if (header.size > capacity)
+        return FWK_E_SIZE;
+
+    status = decompress_block(
+        (const uint8_t *)image + sizeof(header),
+        header.compressed_size,
+        destination,
+        header.size,
+        &block_size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (block_size != header.size)
+        return FWK_E_DATA;
+
+    *decompressed_size = block_size;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_lz4_api lz4_api = {
+    .is_compressed = lz4_is_compressed,
+    .decompress = lz4_decompress,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int lz4_init(fwk_id_t module_id, unsigned int element_count,
+                    const void *data)
+{
+    return FWK_SUCCESS;
+}
+
+static int lz4_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
+                                    fwk_id_t api_id, const void **api)
+{
+    *api = &lz4_api;
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_lz4 = {
+    .name = "LZ4",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_LZ4_API_IDX_COUNT,
+    .init = lz4_init,
+    .process_bind_request = lz4_process_bind_request,
+};
+
+const struct fwk_module_config config_lz4 = { 0 };
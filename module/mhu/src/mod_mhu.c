@@ -13,6 +13,7 @@
 #include <mod_mhu.h>
 #include <mod_smt.h>
 
+#include <fwk_attributes.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_mm.h>
@@ -31,11 +32,6 @@
  */
 #define MHU_SLOT_COUNT_MAX 31
 
-struct mhu_smt_channel {
-    fwk_id_t id;
-    struct mod_smt_driver_input_api *api;
-};
-
 /* MHU device context */
 struct mhu_device_ctx {
     /* Pointer to the device configuration */
@@ -47,8 +43,11 @@ struct mhu_device_ctx {
     /* Mask of slots that are bound to an SMT channel */
     uint32_t bound_slots;
 
-    /* Table of SMT channels bound to the device */
-    struct mhu_smt_channel *smt_channel_table;
+    /* Table of SMT channels bound to the slots, indexed by slot */
+    fwk_id_t *smt_channel_table;
+
+    /* SMT driver input API */
+    const struct mod_smt_driver_input_api *smt_api;
 };
 
 /* MHU context */
@@ -62,15 +61,14 @@ struct mhu_ctx {
 
 static struct mhu_ctx mhu_ctx;
 
-static void mhu_isr(void)
+static FWK_HOT void mhu_isr(void)
 {
     int status;
     unsigned int interrupt;
     unsigned int device_idx;
     struct mhu_device_ctx *device_ctx;
     struct mhu_reg *reg;
-    unsigned int slot;
-    struct mhu_smt_channel *smt_channel;
+    uint32_t stat;
 
     status = fwk_interrupt_get_current(&interrupt);
     if (status != FWK_SUCCESS)
@@ -87,21 +85,21 @@ static void mhu_isr(void)
 
     reg = (struct mhu_reg *)device_ctx->config->in;
 
-    /* Loop over all the slots */
-    while (reg->STAT != 0) {
-        slot = __builtin_ctz(reg->STAT);
-
-        /*
-         * If the slot is bound to an SMT channel, signal the message to the
-         * SMT channel.
-         */
-        if (device_ctx->bound_slots & (1 << slot)) {
-            smt_channel = &device_ctx->smt_channel_table[slot];
-            smt_channel->api->signal_message(smt_channel->id);
-        }
+    /*
+     * Acknowledge every pending slot at once before handling them, so that a
+     * doorbell rung while the messages are handled raises the interrupt again.
+     */
+    stat = reg->STAT;
+    if (stat == 0)
+        return;
 
-        /* Acknowledge the interrupt */
-        reg->CLEAR = 1 << slot;
+    reg->CLEAR = stat;
+
+    /* Signal the messages of the slots bound to an SMT channel together */
+    stat &= device_ctx->bound_slots;
+    if (stat != 0) {
+        device_ctx->smt_api->signal_messages(
+            device_ctx->smt_channel_table, stat);
     }
 }
 
@@ -172,7 +170,6 @@ static int mhu_bind(fwk_id_t id, unsigned int round)
     int status;
     struct mhu_device_ctx *device_ctx;
     unsigned int slot;
-    struct mhu_smt_channel *smt_channel;
 
     if ((round == 1) && fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
         device_ctx = &mhu_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
@@ -181,11 +178,9 @@ static int mhu_bind(fwk_id_t id, unsigned int round)
             if (!(device_ctx->bound_slots & (1 << slot)))
                 continue;
 
-            smt_channel = &device_ctx->smt_channel_table[slot];
-
-            status = fwk_module_bind(smt_channel->id,
+            status = fwk_module_bind(device_ctx->smt_channel_table[slot],
                 FWK_ID_API(FWK_MODULE_IDX_SMT, MOD_SMT_API_IDX_DRIVER_INPUT),
-                &smt_channel->api);
+                &device_ctx->smt_api);
             if (status != FWK_SUCCESS)
                 return status;
         }
@@ -209,7 +204,7 @@ static int mhu_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
     if (device_ctx->bound_slots & (1 << slot))
         return FWK_E_ACCESS;
 
-    device_ctx->smt_channel_table[slot].id = source_id;
+    device_ctx->smt_channel_table[slot] = source_id;
     device_ctx->bound_slots |= 1 << slot;
 
     *api = &mhu_mod_smt_driver_api;
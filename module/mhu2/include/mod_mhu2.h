@@ -11,6 +11,7 @@
 #ifndef MOD_MHU2_H
 #define MOD_MHU2_H
 
+#include <fwk_id.h>
 #include <fwk_macros.h>
 
 #include <stdint.h>
@@ -22,15 +23,47 @@
 
 /*!
  * \defgroup GroupMHUv2 Message Handling Unit (MHU) v2 Driver
+ *
+ * \details Besides ringing the doorbells of the SMT channels, a channel can
+ *      carry small SCMI messages directly in a range of channel windows, see
+ *      ::mod_mhu2_channel_config::msg_window_count. The channel then acts as
+ *      the SCMI transport of the service and forwards the messages that do not
+ *      fit in the windows to an SMT channel.
+ *
+ *      With `N` windows in the range, a message is laid out as follows, in
+ *      both directions:
+ *      - Window 0 holds the SCMI message header.
+ *      - Windows 1 to `N - 2` hold the payload, one 32-bit word per window.
+ *      - Window `N - 1` holds the length of the message in bytes, header
+ *        included, and is written last.
+ *
+ *      Only the last window raises the receive interrupt. The receiver clears
+ *      all the windows once it has read the message, and an agent only sends
+ *      its next request once it has read the response to the previous one.
+ *
  * \{
  */
 
+/*!
+ * \brief Maximum number of channel windows carrying register messages.
+ */
+#define MOD_MHU2_MSG_WINDOW_COUNT_MAX 16
+
 /*!
  * \brief MHU v2 api indicies
  */
 enum mod_mhu2_api_idx {
     /*! SMT driver API */
     MOD_MHU2_API_IDX_SMT_DRIVER,
+    /*! Doorbell batching API */
+    MOD_MHU2_API_IDX_DOORBELL,
+    /*! SCMI transport API, see ::mod_scmi_to_transport_api */
+    MOD_MHU2_API_IDX_SCMI_TRANSPORT,
+    /*!
+     * Signal API of the SMT channel carrying the larger messages, see
+     * ::mod_smt_from_transport_api
+     */
+    MOD_MHU2_API_IDX_SMT_SIGNAL,
     /*! Number of APIs */
     MOD_MHU2_API_IDX_COUNT,
 };
@@ -54,6 +87,78 @@ struct mod_mhu2_channel_config {
 
     /*! Channel number */
     unsigned int channel;
+
+    /*!
+     * \brief Identifier of the alarm keeping the receiver awake between
+     *      doorbells (optional).
+     *
+     * \details When defined, the access request is held after a doorbell is
+     *      rung, and only dropped once no doorbell has been rung for
+     *      ::mod_mhu2_channel_config::idle_timeout_ms milliseconds. Following
+     *      doorbells then skip the receiver wake-up handshake.
+     */
+    fwk_optional_id_t idle_alarm_id;
+
+    /*! Time the receiver is kept awake after the last doorbell, in ms */
+    unsigned int idle_timeout_ms;
+
+    /*!
+     * \brief Number of channel windows carrying register messages, from 3 to
+     *      ::MOD_MHU2_MSG_WINDOW_COUNT_MAX, or 0 when the channel does not
+     *      carry messages.
+     */
+    unsigned int msg_window_count;
+
+    /*! Index of the first channel window carrying register messages */
+    unsigned int msg_channel;
+
+    /*!
+     * \brief Identifier of the SMT channel carrying the messages that do not
+     *      fit in the channel windows.
+     *
+     * \details Only used when ::mod_mhu2_channel_config::msg_window_count is
+     *      not 0. The \c signal_api_id of the SMT channel must be the
+     *      ::MOD_MHU2_API_IDX_SMT_SIGNAL API of this module.
+     */
+    fwk_id_t smt_channel_id;
+};
+
+/*!
+ * \brief Doorbell batching API.
+ *
+ * \details Doorbells rung on the slots of a channel while the channel is held
+ *      are not signalled immediately. They are signalled together, with a
+ *      single access request and a single write, once the last holder has
+ *      released the channel.
+ *
+ * \note The functions must not be called from an interrupt handler.
+ */
+struct mod_mhu2_doorbell_api {
+    /*!
+     * \brief Start batching the doorbells of a channel.
+     *
+     * \details Holds may be nested.
+     *
+     * \param channel_id Channel identifier.
+     *
+     * \retval ::FWK_SUCCESS The channel is held.
+     * \retval ::FWK_E_PARAM The channel identifier is not valid.
+     */
+    int (*hold)(fwk_id_t channel_id);
+
+    /*!
+     * \brief Stop batching the doorbells of a channel.
+     *
+     * \details When the last holder releases the channel, the doorbells rung
+     *      since the channel was first held are signalled to the receiver.
+     *
+     * \param channel_id Channel identifier.
+     *
+     * \retval ::FWK_SUCCESS The channel is released.
+     * \retval ::FWK_E_PARAM The channel identifier is not valid.
+     * \retval ::FWK_E_STATE The channel is not held.
+     */
+    int (*release)(fwk_id_t channel_id);
 };
 
 /*!
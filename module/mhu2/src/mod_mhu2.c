@@ -11,9 +11,16 @@
 #include <mhu2.h>
 
 #include <mod_mhu2.h>
+#include <mod_scmi.h>
+#include <mod_scmi_std.h>
 #include <mod_smt.h>
 
+#ifdef BUILD_HAS_MOD_TIMER
+#    include <mod_timer.h>
+#endif
+
 #include <fwk_assert.h>
+#include <fwk_attributes.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_mm.h>
@@ -24,12 +31,15 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #define MHU_SLOT_COUNT_MAX 32
 
-struct mhu2_smt_channel {
-    fwk_id_t id;
-    const struct mod_smt_driver_input_api *api;
+/* Path of the message being processed on a channel carrying messages */
+enum mhu2_msg_path {
+    MHU2_MSG_PATH_NONE,
+    MHU2_MSG_PATH_REGS,
+    MHU2_MSG_PATH_SMT,
 };
 
 /* MHU channel context */
@@ -50,8 +60,57 @@ struct mhu2_channel_ctx {
     /* Mask of slots that are bound to an SMT channel */
     uint32_t bound_slots;
 
-    /* Table of SMT channels bound to the channel */
-    struct mhu2_smt_channel *smt_channel_table;
+    /* Table of SMT channels bound to the slots, indexed by slot */
+    fwk_id_t *smt_channel_table;
+
+    /* SMT driver input API */
+    const struct mod_smt_driver_input_api *smt_api;
+
+    /* Number of holders of the channel */
+    unsigned int hold_count;
+
+    /* Mask of slots whose doorbell is pending until the channel is released */
+    uint32_t pending_slots;
+
+    /* Whether the access request to the receiver is held */
+    bool awake;
+
+    /* Whether a doorbell was rung during the current idle period */
+    bool rung;
+
+    /* Pointers to the first channel windows carrying register messages */
+    struct mhu2_send_channel_reg *msg_send;
+    struct mhu2_recv_channel_reg *msg_recv;
+
+    /* SCMI service the channel is the transport of */
+    fwk_id_t scmi_service_id;
+
+    /* SCMI API to signal the incoming messages */
+    const struct mod_scmi_from_transport_api *scmi_api;
+
+    /* Transport API of the SMT channel carrying the larger messages */
+    const struct mod_scmi_to_transport_api *smt_transport_api;
+
+    /* Path of the message being processed */
+    enum mhu2_msg_path msg_path;
+
+    /* Whether a register message waits for the current message */
+    bool msg_pending;
+
+    /* Whether an SMT message, or error, waits for the current message */
+    bool smt_pending;
+    bool smt_pending_error;
+
+    /* Register message being processed */
+    uint32_t msg_header;
+    size_t msg_payload_size;
+    uint32_t msg_in[MOD_MHU2_MSG_WINDOW_COUNT_MAX];
+    uint32_t msg_out[MOD_MHU2_MSG_WINDOW_COUNT_MAX];
+
+#ifdef BUILD_HAS_MOD_TIMER
+    /* Alarm API, NULL when the access request is dropped after each doorbell */
+    const struct mod_timer_alarm_api *alarm_api;
+#endif
 };
 
 /* MHU v2 context */
@@ -63,29 +122,174 @@ static struct mhu2_ctx {
     unsigned int channel_count;
 } ctx;
 
-static void mhu2_isr(uintptr_t ctx_param)
+/*
+ * Register messages
+ */
+
+static size_t mhu2_msg_capacity(const struct mhu2_channel_ctx *channel_ctx)
+{
+    return (channel_ctx->config->msg_window_count - 2) * sizeof(uint32_t);
+}
+
+/*
+ * Read the register message signalled by the last window and hand it over to
+ * the SCMI service. Called from the interrupt handler with no message being
+ * processed.
+ */
+static void mhu2_msg_receive(struct mhu2_channel_ctx *channel_ctx)
+{
+    struct mhu2_recv_channel_reg *window = channel_ctx->msg_recv;
+    unsigned int last = channel_ctx->config->msg_window_count - 1;
+    uint32_t length;
+    unsigned int i;
+
+    length = window[last].STAT;
+    channel_ctx->msg_header = window[0].STAT;
+    for (i = 1; i < last; i++)
+        channel_ctx->msg_in[i - 1] = window[i].STAT;
+
+    /* Free the windows for the next message, the trigger window last */
+    for (i = 0; i <= last; i++)
+        window[i].STAT_CLEAR = UINT32_MAX;
+
+    channel_ctx->msg_path = MHU2_MSG_PATH_REGS;
+
+    if ((length < sizeof(uint32_t)) ||
+        ((length - sizeof(uint32_t)) > mhu2_msg_capacity(channel_ctx))) {
+        channel_ctx->msg_payload_size = 0;
+        channel_ctx->scmi_api->signal_error(channel_ctx->scmi_service_id);
+        return;
+    }
+
+    channel_ctx->msg_payload_size = length - sizeof(uint32_t);
+    channel_ctx->scmi_api->signal_message(channel_ctx->scmi_service_id);
+}
+
+static FWK_HOT void mhu2_isr(uintptr_t ctx_param)
 {
     struct mhu2_channel_ctx *channel_ctx = (struct mhu2_channel_ctx *)ctx_param;
-    unsigned int slot;
-    struct mhu2_smt_channel *smt_channel;
+    struct mhu2_recv_channel_reg *trigger;
+    uint32_t stat;
 
     fwk_assert(channel_ctx != NULL);
 
-    while (channel_ctx->recv_channel->STAT != 0) {
-        slot = __builtin_ctz(channel_ctx->recv_channel->STAT);
+    if (channel_ctx->msg_recv != NULL) {
+        trigger =
+            &channel_ctx->msg_recv[channel_ctx->config->msg_window_count - 1];
+
+        if ((trigger->STAT != 0) &&
+            (channel_ctx->msg_path != MHU2_MSG_PATH_NONE)) {
+            /* Received once the message being processed is answered */
+            trigger->MASK_SET = UINT32_MAX;
+            channel_ctx->msg_pending = true;
+        } else if (trigger->STAT != 0)
+            mhu2_msg_receive(channel_ctx);
+    }
 
-        /*
-         * If the slot is bound to an SMT channel, signal the message to the
-         * SMT channel.
-         */
-        if (channel_ctx->bound_slots & (1 << slot)) {
-            smt_channel = &channel_ctx->smt_channel_table[slot];
-            smt_channel->api->signal_message(smt_channel->id);
-        }
+    /*
+     * Acknowledge every pending slot at once before handling them, so that a
+     * doorbell rung while the messages are handled raises the interrupt again.
+     */
+    stat = channel_ctx->recv_channel->STAT;
+    if (stat == 0)
+        return;
+
+    channel_ctx->recv_channel->STAT_CLEAR = stat;
+
+    /* Signal the messages of the slots bound to an SMT channel together */
+    stat &= channel_ctx->bound_slots;
+    if (stat != 0) {
+        channel_ctx->smt_api->signal_messages(
+            channel_ctx->smt_channel_table, stat);
+    }
+}
+
+/*
+ * Doorbells
+ */
+
+#ifdef BUILD_HAS_MOD_TIMER
+static void mhu2_idle_alarm_callback(uintptr_t param)
+{
+    struct mhu2_channel_ctx *channel_ctx = (struct mhu2_channel_ctx *)param;
+
+    fwk_interrupt_global_disable();
+
+    if (channel_ctx->rung) {
+        /* Keep the receiver awake for another period */
+        channel_ctx->rung = false;
+    } else if (channel_ctx->awake) {
+        /* Signal that the receiver is no longer needed */
+        channel_ctx->send->ACCESS_REQUEST = 0;
+        channel_ctx->awake = false;
 
-        /* Acknowledge the interrupt */
-        channel_ctx->recv_channel->STAT_CLEAR = 1 << slot;
+        channel_ctx->alarm_api->stop(channel_ctx->config->idle_alarm_id);
     }
+
+    fwk_interrupt_global_enable();
+}
+#endif
+
+/*
+ * Turn on the receiver before writing to the channel windows, and return
+ * whether it is kept on afterwards. Interrupts must be disabled by the caller.
+ */
+static bool mhu2_wake(struct mhu2_channel_ctx *channel_ctx)
+{
+    struct mhu2_send_reg *send = channel_ctx->send;
+    bool keep_awake = false;
+
+    if (channel_ctx->awake)
+        return true;
+
+    /* Turn on receiver */
+    send->ACCESS_REQUEST = 1;
+    while (send->ACCESS_READY != 1)
+        continue;
+
+#ifdef BUILD_HAS_MOD_TIMER
+    /* The request is held until the idle alarm finds the channel idle */
+    if (channel_ctx->alarm_api != NULL) {
+        keep_awake =
+            channel_ctx->alarm_api->start(
+                channel_ctx->config->idle_alarm_id,
+                channel_ctx->config->idle_timeout_ms,
+                MOD_TIMER_ALARM_TYPE_PERIODIC,
+                mhu2_idle_alarm_callback,
+                (uintptr_t)channel_ctx) == FWK_SUCCESS;
+    }
+#endif
+
+    return keep_awake;
+}
+
+/*
+ * Release the receiver once the channel windows have been written, unless it
+ * is kept on. Interrupts must be disabled by the caller.
+ */
+static void mhu2_sleep(struct mhu2_channel_ctx *channel_ctx, bool keep_awake)
+{
+    channel_ctx->awake = keep_awake;
+    channel_ctx->rung = keep_awake;
+
+    if (!keep_awake) {
+        /* Signal that the receiver is no longer needed */
+        channel_ctx->send->ACCESS_REQUEST = 0;
+    }
+}
+
+/*
+ * Signal the doorbells of a set of slots to the receiver. Interrupts must be
+ * disabled by the caller.
+ */
+static void mhu2_ring(struct mhu2_channel_ctx *channel_ctx, uint32_t slots)
+{
+    bool keep_awake = mhu2_wake(channel_ctx);
+
+    /* Ring all the doorbells with a single write */
+    channel_ctx->send_channel->STAT_SET = slots;
+
+    mhu2_sleep(channel_ctx, keep_awake);
 }
 
 /*
@@ -96,21 +300,19 @@ static int raise_interrupt(fwk_id_t slot_id)
 {
     unsigned int slot;
     struct mhu2_channel_ctx *channel_ctx;
-    struct mhu2_send_reg *send;
 
     channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(slot_id)];
     slot = fwk_id_get_sub_element_idx(slot_id);
-    send = channel_ctx->send;
 
-    /* Turn on receiver */
-    send->ACCESS_REQUEST = 1;
-    while (send->ACCESS_READY != 1)
-        continue;
+    fwk_interrupt_global_disable();
 
-    channel_ctx->send_channel->STAT_SET |= (1 << slot);
+    if (channel_ctx->hold_count > 0) {
+        /* The doorbell is rung when the channel is released */
+        channel_ctx->pending_slots |= UINT32_C(1) << slot;
+    } else
+        mhu2_ring(channel_ctx, UINT32_C(1) << slot);
 
-    /* Signal that the receiver is no longer needed */
-    send->ACCESS_REQUEST = 0;
+    fwk_interrupt_global_enable();
 
     return FWK_SUCCESS;
 }
@@ -119,6 +321,333 @@ static const struct mod_smt_driver_api mhu2_mod_smt_driver_api = {
     .raise_interrupt = raise_interrupt,
 };
 
+/*
+ * Doorbell batching API
+ */
+
+static struct mhu2_channel_ctx *get_channel_ctx(fwk_id_t channel_id)
+{
+    if (!fwk_module_is_valid_element_id(channel_id))
+        return NULL;
+
+    return &ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+}
+
+static int mhu2_hold(fwk_id_t channel_id)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_channel_ctx(channel_id);
+
+    if (channel_ctx == NULL)
+        return FWK_E_PARAM;
+
+    fwk_interrupt_global_disable();
+    channel_ctx->hold_count++;
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
+
+static int mhu2_release(fwk_id_t channel_id)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_channel_ctx(channel_id);
+    int status = FWK_SUCCESS;
+
+    if (channel_ctx == NULL)
+        return FWK_E_PARAM;
+
+    fwk_interrupt_global_disable();
+
+    if (channel_ctx->hold_count == 0)
+        status = FWK_E_STATE;
+    else if ((--channel_ctx->hold_count == 0) &&
+             (channel_ctx->pending_slots != 0)) {
+        mhu2_ring(channel_ctx, channel_ctx->pending_slots);
+        channel_ctx->pending_slots = 0;
+    }
+
+    fwk_interrupt_global_enable();
+
+    return status;
+}
+
+static const struct mod_mhu2_doorbell_api mhu2_doorbell_api = {
+    .hold = mhu2_hold,
+    .release = mhu2_release,
+};
+
+/*
+ * SCMI transport API
+ */
+
+static struct mhu2_channel_ctx *get_msg_channel_ctx(fwk_id_t channel_id)
+{
+    return &ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+}
+
+static bool mhu2_msg_is_regs(const struct mhu2_channel_ctx *channel_ctx)
+{
+    return channel_ctx->msg_path == MHU2_MSG_PATH_REGS;
+}
+
+/*
+ * Hand over the message that waited for the one just answered, if any.
+ */
+static void mhu2_msg_complete(struct mhu2_channel_ctx *channel_ctx)
+{
+    struct mhu2_recv_channel_reg *trigger;
+    bool smt_pending;
+    bool smt_error;
+
+    fwk_interrupt_global_disable();
+
+    channel_ctx->msg_path = MHU2_MSG_PATH_NONE;
+
+    smt_pending = channel_ctx->smt_pending;
+    smt_error = channel_ctx->smt_pending_error;
+
+    if (smt_pending) {
+        channel_ctx->smt_pending = false;
+        channel_ctx->msg_path = MHU2_MSG_PATH_SMT;
+    } else if (channel_ctx->msg_pending) {
+        /* The interrupt is raised again for the waiting register message */
+        channel_ctx->msg_pending = false;
+        trigger =
+            &channel_ctx->msg_recv[channel_ctx->config->msg_window_count - 1];
+        trigger->MASK_CLEAR = UINT32_MAX;
+    }
+
+    fwk_interrupt_global_enable();
+
+    if (!smt_pending)
+        return;
+
+    if (smt_error)
+        channel_ctx->scmi_api->signal_error(channel_ctx->scmi_service_id);
+    else
+        channel_ctx->scmi_api->signal_message(channel_ctx->scmi_service_id);
+}
+
+static int mhu2_get_secure(fwk_id_t channel_id, bool *secure)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_msg_channel_ctx(channel_id);
+
+    return channel_ctx->smt_transport_api->get_secure(
+        channel_ctx->config->smt_channel_id, secure);
+}
+
+static int mhu2_get_max_payload_size(fwk_id_t channel_id, size_t *size)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_msg_channel_ctx(channel_id);
+
+    if (!mhu2_msg_is_regs(channel_ctx)) {
+        return channel_ctx->smt_transport_api->get_max_payload_size(
+            channel_ctx->config->smt_channel_id, size);
+    }
+
+    if (size == NULL)
+        return FWK_E_PARAM;
+
+    *size = mhu2_msg_capacity(channel_ctx);
+
+    return FWK_SUCCESS;
+}
+
+static int mhu2_get_message_header(fwk_id_t channel_id, uint32_t *header)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_msg_channel_ctx(channel_id);
+
+    if (!mhu2_msg_is_regs(channel_ctx)) {
+        return channel_ctx->smt_transport_api->get_message_header(
+            channel_ctx->config->smt_channel_id, header);
+    }
+
+    if (header == NULL)
+        return FWK_E_PARAM;
+
+    *header = channel_ctx->msg_header;
+
+    return FWK_SUCCESS;
+}
+
+static int mhu2_get_payload(
+    fwk_id_t channel_id,
+    const void **payload,
+    size_t *size)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_msg_channel_ctx(channel_id);
+
+    if (!mhu2_msg_is_regs(channel_ctx)) {
+        return channel_ctx->smt_transport_api->get_payload(
+            channel_ctx->config->smt_channel_id, payload, size);
+    }
+
+    if (payload == NULL)
+        return FWK_E_PARAM;
+
+    *payload = channel_ctx->msg_in;
+    if (size != NULL)
+        *size = channel_ctx->msg_payload_size;
+
+    return FWK_SUCCESS;
+}
+
+static int mhu2_write_payload(
+    fwk_id_t channel_id,
+    size_t offset,
+    const void *payload,
+    size_t size)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_msg_channel_ctx(channel_id);
+
+    if (!mhu2_msg_is_regs(channel_ctx)) {
+        return channel_ctx->smt_transport_api->write_payload(
+            channel_ctx->config->smt_channel_id, offset, payload, size);
+    }
+
+    if ((payload == NULL) || (offset > mhu2_msg_capacity(channel_ctx)) ||
+        (size > (mhu2_msg_capacity(channel_ctx) - offset)))
+        return FWK_E_PARAM;
+
+    memcpy((uint8_t *)channel_ctx->msg_out + offset, payload, size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Write the response to a register message to the channel windows.
+ */
+static int mhu2_msg_respond(
+    struct mhu2_channel_ctx *channel_ctx,
+    const void *payload,
+    size_t size)
+{
+    static const int32_t protocol_error = SCMI_PROTOCOL_ERROR;
+    struct mhu2_send_channel_reg *window = channel_ctx->msg_send;
+    unsigned int last = channel_ctx->config->msg_window_count - 1;
+    unsigned int word_count;
+    bool keep_awake;
+    int status = FWK_SUCCESS;
+    unsigned int i;
+
+    if (size > mhu2_msg_capacity(channel_ctx)) {
+        /* Do not leave the agent waiting for a response that cannot fit */
+        payload = &protocol_error;
+        size = sizeof(protocol_error);
+        status = FWK_E_PARAM;
+    }
+
+    if ((payload != NULL) && (payload != channel_ctx->msg_out))
+        memcpy(channel_ctx->msg_out, payload, size);
+
+    word_count = (size + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    memset(
+        (uint8_t *)channel_ctx->msg_out + size,
+        0,
+        (word_count * sizeof(uint32_t)) - size);
+
+    fwk_interrupt_global_disable();
+
+    keep_awake = mhu2_wake(channel_ctx);
+
+    /* The length is written last as it raises the interrupt of the agent */
+    window[0].STAT_SET = channel_ctx->msg_header;
+    for (i = 0; i < word_count; i++)
+        window[i + 1].STAT_SET = channel_ctx->msg_out[i];
+    window[last].STAT_SET = sizeof(uint32_t) + size;
+
+    mhu2_sleep(channel_ctx, keep_awake);
+
+    fwk_interrupt_global_enable();
+
+    return status;
+}
+
+static int mhu2_respond(fwk_id_t channel_id, const void *payload, size_t size)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_msg_channel_ctx(channel_id);
+    enum mhu2_msg_path path = channel_ctx->msg_path;
+    int status;
+
+    if (path == MHU2_MSG_PATH_REGS)
+        status = mhu2_msg_respond(channel_ctx, payload, size);
+    else {
+        status = channel_ctx->smt_transport_api->respond(
+            channel_ctx->config->smt_channel_id, payload, size);
+    }
+
+    if (path != MHU2_MSG_PATH_NONE)
+        mhu2_msg_complete(channel_ctx);
+
+    return status;
+}
+
+static int mhu2_transmit(
+    fwk_id_t channel_id,
+    uint32_t message_header,
+    const void *payload,
+    size_t size)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_msg_channel_ctx(channel_id);
+
+    /* Notifications and delayed responses always go through the SMT channel */
+    return channel_ctx->smt_transport_api->transmit(
+        channel_ctx->config->smt_channel_id, message_header, payload, size);
+}
+
+static const struct mod_scmi_to_transport_api mhu2_scmi_transport_api = {
+    .get_secure = mhu2_get_secure,
+    .get_max_payload_size = mhu2_get_max_payload_size,
+    .get_message_header = mhu2_get_message_header,
+    .get_payload = mhu2_get_payload,
+    .write_payload = mhu2_write_payload,
+    .respond = mhu2_respond,
+    .transmit = mhu2_transmit,
+};
+
+/*
+ * SMT signal API
+ */
+
+static int mhu2_smt_signal(fwk_id_t channel_id, bool error)
+{
+    struct mhu2_channel_ctx *channel_ctx = get_msg_channel_ctx(channel_id);
+    const struct mod_scmi_from_transport_api *scmi_api = channel_ctx->scmi_api;
+
+    fwk_interrupt_global_disable();
+
+    if (channel_ctx->msg_path != MHU2_MSG_PATH_NONE) {
+        /* Signalled once the message being processed is answered */
+        channel_ctx->smt_pending = true;
+        channel_ctx->smt_pending_error = error;
+        fwk_interrupt_global_enable();
+        return FWK_SUCCESS;
+    }
+
+    channel_ctx->msg_path = MHU2_MSG_PATH_SMT;
+
+    fwk_interrupt_global_enable();
+
+    if (error)
+        return scmi_api->signal_error(channel_ctx->scmi_service_id);
+
+    return scmi_api->signal_message(channel_ctx->scmi_service_id);
+}
+
+static int mhu2_smt_signal_error(fwk_id_t channel_id)
+{
+    return mhu2_smt_signal(channel_id, true);
+}
+
+static int mhu2_smt_signal_message(fwk_id_t channel_id)
+{
+    return mhu2_smt_signal(channel_id, false);
+}
+
+static const struct mod_smt_from_transport_api mhu2_smt_signal_api = {
+    .signal_error = mhu2_smt_signal_error,
+    .signal_message = mhu2_smt_signal_message,
+};
+
 /*
  * Framework handlers
  */
@@ -171,6 +700,23 @@ static int mhu2_channel_init(fwk_id_t channel_id,
     channel_ctx->smt_channel_table =
         fwk_mm_calloc(slot_count, sizeof(channel_ctx->smt_channel_table[0]));
 
+    if (config->msg_window_count == 0)
+        return FWK_SUCCESS;
+
+    if ((config->msg_window_count < 3) ||
+        (config->msg_window_count > MOD_MHU2_MSG_WINDOW_COUNT_MAX) ||
+        (config->msg_channel + config->msg_window_count >
+         channel_ctx->send->MSG_NO_CAP) ||
+        ((config->channel >= config->msg_channel) &&
+         (config->channel < config->msg_channel + config->msg_window_count))) {
+        /* The message windows must fit and not overlap the doorbells */
+        fwk_unexpected();
+        return FWK_E_DATA;
+    }
+
+    channel_ctx->msg_send = &channel_ctx->send->channel[config->msg_channel];
+    channel_ctx->msg_recv = &recv_reg->channel[config->msg_channel];
+
     return FWK_SUCCESS;
 }
 
@@ -179,21 +725,64 @@ static int mhu2_bind(fwk_id_t id, unsigned int round)
     int status;
     struct mhu2_channel_ctx *channel_ctx;
     unsigned int slot;
-    struct mhu2_smt_channel *smt_channel;
+
+#ifdef BUILD_HAS_MOD_TIMER
+    if ((round == 0) && fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
+        channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
+
+        if (fwk_optional_id_is_defined(channel_ctx->config->idle_alarm_id)) {
+            status = fwk_module_bind(
+                channel_ctx->config->idle_alarm_id,
+                MOD_TIMER_API_ID_ALARM,
+                &channel_ctx->alarm_api);
+            if (status != FWK_SUCCESS) {
+                /* Unable to bind to the idle alarm */
+                fwk_unexpected();
+                return status;
+            }
+        }
+    }
+#endif
+
+    if ((round == 0) && fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
+        channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
+
+        if (channel_ctx->msg_recv != NULL) {
+            status = fwk_module_bind(
+                channel_ctx->config->smt_channel_id,
+                FWK_ID_API(FWK_MODULE_IDX_SMT, MOD_SMT_API_IDX_SCMI_TRANSPORT),
+                &channel_ctx->smt_transport_api);
+            if (status != FWK_SUCCESS) {
+                /* Unable to bind to the SMT channel of the larger messages */
+                fwk_unexpected();
+                return status;
+            }
+        }
+    }
 
     if ((round == 1) && fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
         channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
 
+        if (channel_ctx->msg_recv != NULL) {
+            status = fwk_module_bind(
+                channel_ctx->scmi_service_id,
+                FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_TRANSPORT),
+                &channel_ctx->scmi_api);
+            if (status != FWK_SUCCESS) {
+                /* Unable to bind back to the SCMI service */
+                fwk_unexpected();
+                return status;
+            }
+        }
+
         for (slot = 0; slot < MHU_SLOT_COUNT_MAX; slot++) {
             if (!(channel_ctx->bound_slots & (UINT32_C(1) << slot)))
                 continue;
 
-            smt_channel = &channel_ctx->smt_channel_table[slot];
-
-            status = fwk_module_bind(smt_channel->id,
+            status = fwk_module_bind(channel_ctx->smt_channel_table[slot],
                                      FWK_ID_API(FWK_MODULE_IDX_SMT,
                                                 MOD_SMT_API_IDX_DRIVER_INPUT),
-                                     &smt_channel->api);
+                                     &channel_ctx->smt_api);
             if (status != FWK_SUCCESS) {
                 /* Unable to bind back to SMT channel */
                 fwk_unexpected();
@@ -211,8 +800,39 @@ static int mhu2_process_bind_request(fwk_id_t source_id,
                                     const void **api)
 {
     struct mhu2_channel_ctx *channel_ctx;
+    unsigned int api_idx = fwk_id_get_api_idx(api_id);
     unsigned int slot;
 
+    if (api_idx == MOD_MHU2_API_IDX_DOORBELL) {
+        /* Doorbells are batched per channel, without any binding state */
+        *api = &mhu2_doorbell_api;
+        return FWK_SUCCESS;
+    }
+
+    if ((api_idx == MOD_MHU2_API_IDX_SCMI_TRANSPORT) ||
+        (api_idx == MOD_MHU2_API_IDX_SMT_SIGNAL)) {
+        if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT)) {
+            /* Only a channel carries messages */
+            fwk_unexpected();
+            return FWK_E_ACCESS;
+        }
+
+        channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(target_id)];
+        if (channel_ctx->msg_recv == NULL) {
+            /* The channel is not configured to carry messages */
+            fwk_unexpected();
+            return FWK_E_ACCESS;
+        }
+
+        if (api_idx == MOD_MHU2_API_IDX_SCMI_TRANSPORT) {
+            channel_ctx->scmi_service_id = source_id;
+            *api = &mhu2_scmi_transport_api;
+        } else
+            *api = &mhu2_smt_signal_api;
+
+        return FWK_SUCCESS;
+    }
+
     if (!fwk_id_is_type(target_id, FWK_ID_TYPE_SUB_ELEMENT)) {
         /*
          * Something tried to bind to the module or an element. Only binding to
@@ -231,7 +851,7 @@ static int mhu2_process_bind_request(fwk_id_t source_id,
         return FWK_E_ACCESS;
     }
 
-    channel_ctx->smt_channel_table[slot].id = source_id;
+    channel_ctx->smt_channel_table[slot] = source_id;
     channel_ctx->bound_slots |= 1 << slot;
 
     *api = &mhu2_mod_smt_driver_api;
@@ -243,13 +863,21 @@ static int mhu2_start(fwk_id_t id)
 {
     int status;
     struct mhu2_channel_ctx *channel_ctx;
+    unsigned int window;
 
     if (fwk_id_get_type(id) == FWK_ID_TYPE_MODULE)
         return FWK_SUCCESS;
 
     channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
 
-    if (channel_ctx->bound_slots != 0) {
+    if (channel_ctx->msg_recv != NULL) {
+        /* Only the last window raises the interrupt for register messages */
+        for (window = 0; window < channel_ctx->config->msg_window_count - 1;
+             window++)
+            channel_ctx->msg_recv[window].MASK_SET = UINT32_MAX;
+    }
+
+    if ((channel_ctx->bound_slots != 0) || (channel_ctx->msg_recv != NULL)) {
         status = fwk_interrupt_set_isr_param(channel_ctx->config->irq,
                                              &mhu2_isr,
                                              (uintptr_t)channel_ctx);
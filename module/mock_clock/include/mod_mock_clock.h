@@ -22,6 +22,12 @@
  *      alongside the `clock` interface on systems that do not provide a real
  *      clock driver.
  *
+ *      In addition to the standard synchronous mode of operation, mock clocks
+ *      support an emulated form of asynchronous operation, in which the rate
+ *      and state requests complete after a latency drawn from a distribution
+ *      configured per element. To enable it, see the documentation for
+ *      ::mod_mock_clock_element_cfg::async_alarm_id.
+ *
  * \warning When using this module to mock a pre-existing driver
  *      for any reason, this driver must be forced to bind to the
  *      ::MOD_MOCK_CLOCK_API_TYPE_RESPONSE_DRIVER API through its module
@@ -53,6 +59,64 @@ struct mod_mock_clock_element_cfg {
 
     /*! The default rate value if the clock device is running at startup. */
     uint32_t default_rate;
+
+    /*!
+     * \brief Alarm entity identifier used for asynchronous driver emulation.
+     *
+     * \details This identifies the entity of a timer alarm, which must
+     *      implement ::mod_timer_alarm_api.
+     *
+     * \note This field is optional. When it is not defined, asynchronous
+     *      driver emulation is not enabled.
+     */
+    fwk_optional_id_t async_alarm_id;
+
+    /*! Alarm API identifier used for asynchronous driver emulation. */
+    fwk_id_t async_alarm_api_id;
+
+    /*!
+     * \brief Driver response entity identifier used for asynchronous driver
+     *      emulation.
+     *
+     * \details This identifies the element of the clock HAL driven by this
+     *      element, which must implement the
+     *      mod_clock::mod_clock_driver_response_api interface.
+     */
+    fwk_id_t async_response_id;
+
+    /*!
+     * \brief Driver response API identifier used for asynchronous driver
+     *      emulation.
+     */
+    fwk_id_t async_response_api_id;
+
+    /*!
+     * \brief Shortest latency of the asynchronous requests, in milliseconds.
+     *
+     * \details The latency of each request is drawn uniformly between the
+     *      shortest and the longest latency, unless the request takes the slow
+     *      path.
+     */
+    unsigned int async_latency_min_ms;
+
+    /*!
+     * \brief Longest latency of the asynchronous requests, in milliseconds.
+     *
+     * \note When 0, every asynchronous request completes after 1 millisecond.
+     */
+    unsigned int async_latency_max_ms;
+
+    /*!
+     * \brief Average number of asynchronous requests for one to take the slow
+     *      path, or 0 if none does.
+     */
+    unsigned int async_slow_ratio;
+
+    /*!
+     * \brief Latency of the asynchronous requests taking the slow path, in
+     *      milliseconds.
+     */
+    unsigned int async_slow_latency_ms;
 };
 
 /*!
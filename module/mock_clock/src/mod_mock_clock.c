@@ -7,6 +7,7 @@
 
 #include <mod_clock.h>
 #include <mod_mock_clock.h>
+#include <mod_timer.h>
 
 #include <fwk_assert.h>
 #include <fwk_id.h>
@@ -19,6 +20,24 @@
 #include <stddef.h>
 #include <stdint.h>
 
+enum mod_mock_clock_request {
+    MOD_MOCK_CLOCK_REQUEST_NONE,
+
+    MOD_MOCK_CLOCK_REQUEST_SET_RATE,
+    MOD_MOCK_CLOCK_REQUEST_GET_RATE,
+    MOD_MOCK_CLOCK_REQUEST_SET_STATE,
+    MOD_MOCK_CLOCK_REQUEST_GET_STATE,
+};
+
+struct mod_mock_clock_operation {
+    enum mod_mock_clock_request request;
+
+    union {
+        unsigned int rate_index;
+        enum mod_clock_state state;
+    };
+};
+
 static struct mod_mock_clock_element_ctx {
     const struct mod_mock_clock_element_cfg *config;
     unsigned int current_rate_index;
@@ -29,6 +48,17 @@ static struct mod_mock_clock_element_ctx {
      * in any specific state.
      */
     bool rate_initialized;
+
+    /* Asynchronous request in progress */
+    struct mod_mock_clock_operation op;
+
+    /* State of the generator of the request latencies */
+    uint32_t seed;
+
+    struct {
+        const struct mod_timer_alarm_api *alarm;
+        const struct mod_clock_driver_response_api *hal;
+    } apis;
 } * elements_ctx;
 
 static struct mod_mock_clock_element_ctx *mod_mock_clock_get_ctx(
@@ -60,6 +90,111 @@ static int get_rate_entry(
     return FWK_E_PARAM;
 }
 
+/*
+ * Asynchronous driver emulation
+ */
+
+/*
+ * Draw the latency of an asynchronous request from the distribution of the
+ * element, using a xorshift generator so that the runs are reproducible.
+ */
+static unsigned int mod_mock_clock_get_latency(
+    struct mod_mock_clock_element_ctx *ctx)
+{
+    static const unsigned int DEFAULT_LATENCY = 1 /* ms */;
+
+    const struct mod_mock_clock_element_cfg *cfg = ctx->config;
+    uint32_t random = ctx->seed;
+
+    if (cfg->async_latency_max_ms == 0)
+        return DEFAULT_LATENCY;
+
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    ctx->seed = random;
+
+    if ((cfg->async_slow_ratio != 0) &&
+        ((random % cfg->async_slow_ratio) == 0))
+        return cfg->async_slow_latency_ms;
+
+    return cfg->async_latency_min_ms +
+        ((random >> 8) %
+         (cfg->async_latency_max_ms - cfg->async_latency_min_ms + 1));
+}
+
+static void mod_mock_clock_alarm_callback(uintptr_t element_idx)
+{
+    struct mod_mock_clock_element_ctx *ctx = &elements_ctx[element_idx];
+    struct mod_clock_driver_resp_params response = {
+        .status = FWK_SUCCESS,
+    };
+
+    switch (ctx->op.request) {
+    case MOD_MOCK_CLOCK_REQUEST_SET_RATE:
+        ctx->current_rate_index = ctx->op.rate_index;
+        ctx->rate_initialized = true;
+        response.value.rate =
+            ctx->config->rate_table[ctx->current_rate_index].rate;
+
+        break;
+
+    case MOD_MOCK_CLOCK_REQUEST_GET_RATE:
+        response.value.rate =
+            ctx->config->rate_table[ctx->current_rate_index].rate;
+
+        break;
+
+    case MOD_MOCK_CLOCK_REQUEST_SET_STATE:
+        ctx->state = ctx->op.state;
+        response.value.state = ctx->state;
+
+        break;
+
+    case MOD_MOCK_CLOCK_REQUEST_GET_STATE:
+        response.value.state = ctx->state;
+
+        break;
+
+    default:
+        fwk_unreachable();
+    }
+
+    ctx->op.request = MOD_MOCK_CLOCK_REQUEST_NONE;
+
+    ctx->apis.hal->request_complete(ctx->config->async_response_id, &response);
+}
+
+/*
+ * Start the emulation of an asynchronous request. The request takes effect,
+ * and its response is sent, once its latency has elapsed.
+ */
+static int mod_mock_clock_trigger(
+    fwk_id_t clock_id,
+    struct mod_mock_clock_operation op)
+{
+    struct mod_mock_clock_element_ctx *ctx;
+    int status;
+
+    ctx = mod_mock_clock_get_ctx(clock_id);
+
+    if (ctx->op.request != MOD_MOCK_CLOCK_REQUEST_NONE)
+        return FWK_E_BUSY;
+
+    status = ctx->apis.alarm->start(
+        ctx->config->async_alarm_id,
+        mod_mock_clock_get_latency(ctx),
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        mod_mock_clock_alarm_callback,
+        fwk_id_get_element_idx(clock_id));
+    if (status != FWK_SUCCESS)
+        return FWK_E_HANDLER;
+
+    ctx->op = op;
+
+    return FWK_PENDING;
+}
+
 /*
  * Mock clock driver functions
  */
@@ -87,6 +222,15 @@ static int mod_mock_clock_set_rate(
     if (status != FWK_SUCCESS)
         return FWK_E_PARAM;
 
+    if (ctx->apis.alarm != NULL) {
+        return mod_mock_clock_trigger(
+            clock_id,
+            (struct mod_mock_clock_operation){
+                .request = MOD_MOCK_CLOCK_REQUEST_SET_RATE,
+                .rate_index = rate_entry - ctx->config->rate_table,
+            });
+    }
+
     ctx->current_rate_index = rate_entry - ctx->config->rate_table;
 
     ctx->rate_initialized = true;
@@ -103,6 +247,14 @@ static int mod_mock_clock_get_rate(fwk_id_t clock_id, uint64_t *rate)
     if (!ctx->rate_initialized)
         return FWK_E_STATE;
 
+    if (ctx->apis.alarm != NULL) {
+        return mod_mock_clock_trigger(
+            clock_id,
+            (struct mod_mock_clock_operation){
+                .request = MOD_MOCK_CLOCK_REQUEST_GET_RATE,
+            });
+    }
+
     *rate = ctx->config->rate_table[ctx->current_rate_index].rate;
 
     return FWK_SUCCESS;
@@ -133,6 +285,15 @@ static int mod_mock_clock_set_state(
 
     ctx = mod_mock_clock_get_ctx(clock_id);
 
+    if (ctx->apis.alarm != NULL) {
+        return mod_mock_clock_trigger(
+            clock_id,
+            (struct mod_mock_clock_operation){
+                .request = MOD_MOCK_CLOCK_REQUEST_SET_STATE,
+                .state = state,
+            });
+    }
+
     ctx->state = state;
 
     return FWK_SUCCESS;
@@ -146,6 +307,14 @@ static int mod_mock_clock_get_state(
 
     ctx = mod_mock_clock_get_ctx(clock_id);
 
+    if (ctx->apis.alarm != NULL) {
+        return mod_mock_clock_trigger(
+            clock_id,
+            (struct mod_mock_clock_operation){
+                .request = MOD_MOCK_CLOCK_REQUEST_GET_STATE,
+            });
+    }
+
     *state = ctx->state;
 
     return FWK_SUCCESS;
@@ -217,6 +386,9 @@ static int mod_mock_clock_element_init(
 
     fwk_check(sub_element_count == 0);
 
+    if (cfg->async_latency_min_ms > cfg->async_latency_max_ms)
+        return FWK_E_DATA;
+
     ctx = mod_mock_clock_get_ctx(element_id);
 
     /* Verify that the rate entries in the lookup table are ordered */
@@ -238,10 +410,35 @@ static int mod_mock_clock_element_init(
     }
 
     ctx->config = cfg;
+    ctx->seed = 0x9E3779B9U * (fwk_id_get_element_idx(element_id) + 1);
 
     return FWK_SUCCESS;
 }
 
+static int mod_mock_clock_bind(fwk_id_t id, unsigned int round)
+{
+    const struct mod_mock_clock_element_cfg *cfg;
+    struct mod_mock_clock_element_ctx *ctx;
+    int status;
+
+    if ((round > 0) || !fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    cfg = fwk_module_get_data(id);
+    if (!fwk_optional_id_is_defined(cfg->async_alarm_id))
+        return FWK_SUCCESS;
+
+    ctx = mod_mock_clock_get_ctx(id);
+
+    status = fwk_module_bind(
+        cfg->async_alarm_id, cfg->async_alarm_api_id, &ctx->apis.alarm);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_module_bind(
+        cfg->async_response_id, cfg->async_response_api_id, &ctx->apis.hal);
+}
+
 static int mod_mock_clock_process_bind_request(
     fwk_id_t source_id,
     fwk_id_t target_id,
@@ -273,6 +470,7 @@ const struct fwk_module module_mock_clock = {
 
     .init = mod_mock_clock_init,
     .element_init = mod_mock_clock_element_init,
+    .bind = mod_mock_clock_bind,
 
     .api_count = MOD_MOCK_CLOCK_API_COUNT,
     .process_bind_request = mod_mock_clock_process_bind_request,
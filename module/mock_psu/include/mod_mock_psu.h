@@ -29,7 +29,10 @@
  *      devices of this kind.
  *
  *      To enable the asynchronous operation mode, see the documentation for
- *      ::mod_mock_psu_element_cfg::async_alarm_id.
+ *      ::mod_mock_psu_element_cfg::async_alarm_id. The latency of the
+ *      asynchronous requests follows a distribution configured per element,
+ *      which lets the users of the supplies be exercised under realistic and
+ *      slow-path timings.
  *
  * \{
  */
@@ -84,6 +87,34 @@ struct mod_mock_psu_element_cfg {
      */
     fwk_id_t async_response_api_id;
 
+    /*!
+     * \brief Shortest latency of the asynchronous requests, in milliseconds.
+     *
+     * \details The latency of each request is drawn uniformly between the
+     *      shortest and the longest latency, unless the request takes the slow
+     *      path.
+     */
+    unsigned int async_latency_min_ms;
+
+    /*!
+     * \brief Longest latency of the asynchronous requests, in milliseconds.
+     *
+     * \note When 0, every asynchronous request completes after 1 millisecond.
+     */
+    unsigned int async_latency_max_ms;
+
+    /*!
+     * \brief Average number of asynchronous requests for one to take the slow
+     *      path, or 0 if none does.
+     */
+    unsigned int async_slow_ratio;
+
+    /*!
+     * \brief Latency of the asynchronous requests taking the slow path, in
+     *      milliseconds.
+     */
+    unsigned int async_slow_latency_ms;
+
     /*!
      * \brief Default state of the mock device's supply (enabled or disabled).
      */
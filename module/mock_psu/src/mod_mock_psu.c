@@ -47,6 +47,9 @@ static struct mod_mock_psu_ctx {
 
         struct mod_mock_psu_operation op;
 
+        /* State of the generator of the request latencies */
+        uint32_t seed;
+
         struct {
             const struct mod_timer_alarm_api *alarm;
             const struct mod_psu_driver_response_api *hal;
@@ -80,6 +83,35 @@ static int mod_mock_psu_get_cfg_ctx(
     return FWK_SUCCESS;
 }
 
+/*
+ * Draw the latency of an asynchronous request from the distribution of the
+ * element, using a xorshift generator so that the runs are reproducible.
+ */
+static unsigned int mod_mock_psu_get_latency(
+    const struct mod_mock_psu_element_cfg *cfg,
+    struct mod_mock_psu_element_ctx *ctx)
+{
+    static const unsigned int DEFAULT_LATENCY = 1 /* ms */;
+
+    uint32_t random = ctx->seed;
+
+    if (cfg->async_latency_max_ms == 0)
+        return DEFAULT_LATENCY;
+
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    ctx->seed = random;
+
+    if ((cfg->async_slow_ratio != 0) &&
+        ((random % cfg->async_slow_ratio) == 0))
+        return cfg->async_slow_latency_ms;
+
+    return cfg->async_latency_min_ms +
+        ((random >> 8) %
+         (cfg->async_latency_max_ms - cfg->async_latency_min_ms + 1));
+}
+
 static void mod_mock_psu_alarm_callback(uintptr_t element_idx)
 {
     int status;
@@ -133,8 +165,6 @@ static int mod_mock_psu_trigger(
     fwk_id_t element_id,
     struct mod_mock_psu_operation op)
 {
-    static const unsigned int ASYNC_DELAY = 1 /* ms */;
-
     int status;
 
     const struct mod_mock_psu_element_cfg *cfg;
@@ -146,7 +176,7 @@ static int mod_mock_psu_trigger(
 
     status = ctx->apis.alarm->start(
         cfg->async_alarm_id,
-        ASYNC_DELAY,
+        mod_mock_psu_get_latency(cfg, ctx),
         MOD_TIMER_ALARM_TYPE_ONCE,
         mod_mock_psu_alarm_callback,
         fwk_id_get_element_idx(element_id));
@@ -318,6 +348,9 @@ static int mod_mock_psu_element_init(
 
     fwk_check(sub_element_count == 0);
 
+    if (cfg->async_latency_min_ms > cfg->async_latency_max_ms)
+        return FWK_E_DATA;
+
     ctx = mod_mock_psu_get_ctx(element_id);
 
     *ctx = (struct mod_mock_psu_element_ctx) {
@@ -329,6 +362,8 @@ static int mod_mock_psu_element_init(
         .op = {
             .request = MOD_MOCK_PSU_REQUEST_NONE,
         },
+
+        .seed = 0x9E3779B9U * (fwk_id_get_element_idx(element_id) + 1),
     };
 
     return FWK_SUCCESS;
@@ -22,7 +22,8 @@
  *
  *      This mock driver implements the Sensor HAL driver API and always defers
  *      the 'get_value' request. An example of the execution flow is shown in
- *      `Deferred Response Architecture`.
+ *      `Deferred Response Architecture`. The latency of the readings follows
+ *      a distribution configured per element.
  *
  * \{
  */
@@ -37,6 +38,31 @@ struct mod_mock_sensor_dev_config {
 
     /*! Identifier of the alarm assigned to this element */
     fwk_id_t alarm_id;
+
+    /*!
+     * \brief Shortest latency of the readings, in milliseconds.
+     *
+     * \details The latency of each reading is drawn uniformly between the
+     *      shortest and the longest latency, unless the reading takes the slow
+     *      path.
+     */
+    unsigned int latency_min_ms;
+
+    /*!
+     * \brief Longest latency of the readings, in milliseconds.
+     *
+     * \note When 0, every reading completes after 10 milliseconds.
+     */
+    unsigned int latency_max_ms;
+
+    /*!
+     * \brief Average number of readings for one to take the slow path, or 0 if
+     *      none does.
+     */
+    unsigned int slow_ratio;
+
+    /*! Latency of the readings taking the slow path, in milliseconds */
+    unsigned int slow_latency_ms;
 };
 
 /*!
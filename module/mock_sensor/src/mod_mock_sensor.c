@@ -11,6 +11,7 @@
 
 #include <fwk_assert.h>
 #include <fwk_id.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_status.h>
 
@@ -21,6 +22,34 @@
 static struct mod_timer_alarm_api *alarm_api;
 static struct mod_sensor_driver_response_api *driver_response_api;
 
+/* State of the generators of the reading latencies, indexed by element */
+static uint32_t *seed_table;
+
+/*
+ * Draw the latency of a reading from the distribution of the element, using a
+ * xorshift generator so that the runs are reproducible.
+ */
+static unsigned int get_latency(
+    const struct mod_mock_sensor_dev_config *config,
+    unsigned int element_idx)
+{
+    uint32_t random = seed_table[element_idx];
+
+    if (config->latency_max_ms == 0)
+        return MOCK_SENSOR_ALARM_DELAY_MS;
+
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    seed_table[element_idx] = random;
+
+    if ((config->slow_ratio != 0) && ((random % config->slow_ratio) == 0))
+        return config->slow_latency_ms;
+
+    return config->latency_min_ms +
+        ((random >> 8) % (config->latency_max_ms - config->latency_min_ms + 1));
+}
+
 static void mock_sensor_callback(uintptr_t param)
 {
     struct mod_sensor_driver_resp_params response;
@@ -48,7 +77,7 @@ static int get_value(fwk_id_t id, uint64_t *value)
 
     sensor_hal_idx = fwk_id_get_element_idx(config->sensor_hal_id);
     status = alarm_api->start(config->alarm_id,
-                              MOCK_SENSOR_ALARM_DELAY_MS,
+                              get_latency(config, fwk_id_get_element_idx(id)),
                               MOD_TIMER_ALARM_TYPE_ONCE,
                               mock_sensor_callback,
                               (uintptr_t)sensor_hal_idx);
@@ -84,6 +113,8 @@ static int mock_sensor_init(fwk_id_t module_id,
                             unsigned int element_count,
                             const void *data)
 {
+    seed_table = fwk_mm_calloc(element_count, sizeof(seed_table[0]));
+
     return FWK_SUCCESS;
 }
 
@@ -91,6 +122,14 @@ static int mock_sensor_element_init(fwk_id_t element_id,
                                     unsigned int unused,
                                     const void *data)
 {
+    const struct mod_mock_sensor_dev_config *config = data;
+    unsigned int element_idx = fwk_id_get_element_idx(element_id);
+
+    if (config->latency_min_ms > config->latency_max_ms)
+        return FWK_E_DATA;
+
+    seed_table[element_idx] = 0x9E3779B9U * (element_idx + 1);
+
     return FWK_SUCCESS;
 }
 
@@ -105,12 +105,25 @@ static int msys_rom_bind(fwk_id_t id, unsigned int round)
 
 static int msys_rom_start(fwk_id_t id)
 {
+    int status;
     struct fwk_event event = {
         .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_MSYS_ROM),
         .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_MSYS_ROM),
         .id = FWK_ID_EVENT(FWK_MODULE_IDX_MSYS_ROM, ROM_EVENT_RUN),
     };
 
+    /*
+     * Load the RAM firmware image while the system is brought up. The load is
+     * completed by msys_deferred_setup(), or done from scratch there when it
+     * cannot be started now.
+     */
+    status = ctx.bootloader_api->start_load();
+    if ((status != FWK_SUCCESS) && (status != FWK_E_SUPPORT)) {
+        FWK_LOG_WARN(
+            "[MSYS-ROM] RAM firmware image not loaded in the background: %s",
+            fwk_status_str(status));
+    }
+
     return fwk_thread_put_event(&event);
 }
 
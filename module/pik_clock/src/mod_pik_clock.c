@@ -17,8 +17,8 @@
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
 
+#include <stddef.h>
 #include <stdint.h>
-#include <stdlib.h>
 
 /*
  * Masks for single-source clock divider control.
@@ -103,6 +103,7 @@ struct pik_clock_dev_ctx {
     uint8_t current_source;
     enum mod_clock_state current_state;
     const struct mod_pik_clock_dev_config *config;
+    struct mod_clock_rate_index rate_index;
 };
 
 /* Module context */
@@ -118,34 +119,17 @@ static struct pik_clock_ctx module_ctx;
  * Static helper functions
  */
 
-static int compare_rate_entry(const void *a, const void *b)
-{
-    struct mod_pik_clock_rate *key = (struct mod_pik_clock_rate *)a;
-    struct mod_pik_clock_rate *element = (struct mod_pik_clock_rate *)b;
-
-    return (key->rate - element->rate);
-}
-
 static int get_rate_entry(struct pik_clock_dev_ctx *ctx, uint64_t target_rate,
-                          struct mod_pik_clock_rate **entry)
+                          enum mod_clock_round_mode round_mode,
+                          const struct mod_pik_clock_rate **entry)
 {
-    struct mod_pik_clock_rate *current_rate_entry;
-
     if (ctx == NULL)
         return FWK_E_PARAM;
     if (entry == NULL)
         return FWK_E_PARAM;
 
-    /* Perform a binary search to find the entry matching the requested rate */
-    current_rate_entry = (struct mod_pik_clock_rate *) bsearch(&target_rate,
-        ctx->config->rate_table, ctx->config->rate_count,
-        sizeof(struct mod_pik_clock_rate), compare_rate_entry);
-
-    if (current_rate_entry == NULL)
-        return FWK_E_PARAM;
-
-    *entry = current_rate_entry;
-    return FWK_SUCCESS;
+    return mod_clock_rate_index_lookup(&ctx->rate_index, target_rate,
+                                       round_mode, (const void **)entry);
 }
 
 static int ssclock_set_div(struct pik_clock_dev_ctx *ctx, uint32_t divider,
@@ -287,12 +271,12 @@ static int do_pik_clock_set_rate(fwk_id_t dev_id, uint64_t rate,
 {
     int status;
     struct pik_clock_dev_ctx *ctx;
-    struct mod_pik_clock_rate *rate_entry;
+    const struct mod_pik_clock_rate *rate_entry;
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
 
     /* Look up the divider and source settings */
-    status = get_rate_entry(ctx, rate, &rate_entry);
+    status = get_rate_entry(ctx, rate, round_mode, &rate_entry);
     if (status != FWK_SUCCESS)
         return status;
 
@@ -328,7 +312,7 @@ static int do_pik_clock_set_rate(fwk_id_t dev_id, uint64_t rate,
 
 exit:
     if (status == FWK_SUCCESS)
-        ctx->current_rate = rate;
+        ctx->current_rate = rate_entry->rate;
     return status;
 }
 
@@ -395,7 +379,7 @@ static int pik_clock_set_state(
 {
     int status;
     struct pik_clock_dev_ctx *ctx;
-    struct mod_pik_clock_rate *rate_entry;
+    const struct mod_pik_clock_rate *rate_entry;
 
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
@@ -424,7 +408,8 @@ static int pik_clock_set_state(
         return status;
     } else {
         /* Look up the divider and source settings */
-        status = get_rate_entry(ctx, ctx->current_rate, &rate_entry);
+        status = get_rate_entry(ctx, ctx->current_rate,
+                                MOD_CLOCK_ROUND_MODE_NONE, &rate_entry);
         if (status != FWK_SUCCESS)
             return status;
 
@@ -637,9 +622,7 @@ static int pik_clock_element_init(fwk_id_t element_id,
                                   unsigned int sub_element_count,
                                   const void *data)
 {
-    unsigned int i = 0;
-    uint64_t current_rate;
-    uint64_t last_rate = 0;
+    int status;
     struct pik_clock_dev_ctx *ctx;
     const struct mod_pik_clock_dev_config *dev_config = data;
 
@@ -648,16 +631,14 @@ static int pik_clock_element_init(fwk_id_t element_id,
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(element_id);
 
-    /* Verify that the rate entries in the device's lookup table are ordered */
-    while (i < dev_config->rate_count) {
-        current_rate = dev_config->rate_table[i].rate;
-
-        /* The rate entries must be in ascending order */
-        if (current_rate < last_rate)
-            return FWK_E_DATA;
-
-        last_rate = current_rate;
-        i++;
+    /* Index the device's lookup table, verifying that the rates are ordered */
+    if (dev_config->rate_count != 0) {
+        status = mod_clock_rate_index_init(&ctx->rate_index,
+                                           dev_config->rate_table,
+                                           sizeof(dev_config->rate_table[0]),
+                                           dev_config->rate_count);
+        if (status != FWK_SUCCESS)
+            return status;
     }
 
     ctx->config = dev_config;
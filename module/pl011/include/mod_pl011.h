@@ -11,6 +11,7 @@
 
 #include <fwk_id.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*!
@@ -23,6 +24,13 @@
  *
  * \brief Device driver module for the Primecell® PL011 UART.
  *
+ * \details Characters are written synchronously, waiting for room in the
+ *      transmit FIFO, unless the element has a transmit buffer. In that case,
+ *      once the element has started, characters that do not fit in the FIFO
+ *      are queued in the buffer and sent from the transmit interrupt. The
+ *      buffer is drained synchronously when the stream is flushed, or when it
+ *      is full.
+ *
  * \{
  */
 
@@ -45,6 +53,19 @@ struct mod_pl011_element_cfg {
      */
     uint64_t clock_rate_hz;
 
+    /*!
+     * \brief Size of the transmit buffer in bytes, or zero to transmit
+     *      synchronously.
+     */
+    size_t tx_buffer_size;
+
+    /*!
+     * \brief Interrupt number of the device.
+     *
+     * \note Only used when ::mod_pl011_element_cfg::tx_buffer_size is not zero.
+     */
+    unsigned int irq;
+
 #ifdef BUILD_HAS_MOD_CLOCK
     /*!
      * \brief Identifier of the clock that this device depends on.
@@ -12,11 +12,13 @@
 #include <fwk_assert.h>
 #include <fwk_attributes.h>
 #include <fwk_event.h>
+#include <fwk_interrupt.h>
 #include <fwk_log.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
+#include <fwk_ring.h>
 #include <fwk_status.h>
 
 #include <stdbool.h>
@@ -43,6 +45,12 @@ struct mod_pl011_element_ctx {
 
     /* Whether the device has an open file stream */
     bool open;
+
+    /* Whether characters are sent from the transmit interrupt */
+    bool tx_async;
+
+    /* Characters waiting for room in the transmit FIFO */
+    struct fwk_ring tx_ring;
 };
 
 static struct mod_pl011_ctx {
@@ -78,6 +86,15 @@ static int mod_pl011_init_ctx(struct mod_pl011_ctx *ctx)
             .open = false,
         };
 
+        if (cfg->tx_buffer_size > 0) {
+            char *storage = fwk_mm_alloc(cfg->tx_buffer_size, sizeof(char));
+            if (!fwk_expect(storage != NULL))
+                return FWK_E_NOMEM;
+
+            fwk_ring_init(&ctx->elements[i].tx_ring, storage,
+                cfg->tx_buffer_size);
+        }
+
 #ifdef BUILD_HAS_MOD_POWER_DOMAIN
         ctx->elements[i].powered = fwk_id_is_equal(cfg->pd_id, FWK_ID_NONE);
 #endif
@@ -153,10 +170,81 @@ static void mod_pl011_enable(fwk_id_t id)
 
     reg->ECR = PL011_ECR_CLR;
     reg->LCR_H = PL011_LCR_H_WLEN_8BITS | PL011_LCR_H_FEN;
+    reg->IMSC = 0;
     reg->CR = PL011_CR_UARTEN | PL011_CR_RXE | PL011_CR_TXE;
 }
 
-static void mod_pl011_putch(fwk_id_t id, char ch)
+/* Move characters from the transmit buffer to the FIFO until it is full */
+static void mod_pl011_fill_fifo(
+    struct pl011_reg *reg,
+    struct mod_pl011_element_ctx *ctx)
+{
+    char ch;
+
+    while (!(reg->FR & PL011_FR_TXFF) &&
+           (fwk_ring_pop(&ctx->tx_ring, &ch, sizeof(ch)) == sizeof(ch)))
+        reg->DR = ch;
+}
+
+static void mod_pl011_isr(uintptr_t param)
+{
+    fwk_id_t id = FWK_ID_ELEMENT(FWK_MODULE_IDX_PL011, param);
+    const struct mod_pl011_element_cfg *cfg = fwk_module_get_data(id);
+    struct mod_pl011_element_ctx *ctx = &mod_pl011_ctx.elements[param];
+
+    struct pl011_reg *reg = (void *)cfg->reg_base;
+
+    reg->ICR = PL011_ICR_TXIC;
+
+    mod_pl011_fill_fifo(reg, ctx);
+
+    /*
+     * The interrupt is raised when the FIFO level drops below the threshold,
+     * so there is nothing left to wait for once the buffer is empty.
+     */
+    if (fwk_ring_is_empty(&ctx->tx_ring))
+        reg->IMSC &= ~PL011_IMSC_TXIM;
+}
+
+/*
+ * Send a character. When transmitting asynchronously, a character that does
+ * not fit in the FIFO is queued for the transmit interrupt, and the caller must
+ * have disabled interrupts.
+ */
+static void mod_pl011_tx(
+    struct pl011_reg *reg,
+    struct mod_pl011_element_ctx *ctx,
+    char ch)
+{
+    if (ctx->tx_async &&
+        (!fwk_ring_is_empty(&ctx->tx_ring) || (reg->FR & PL011_FR_TXFF))) {
+        /* Make room synchronously rather than dropping characters */
+        while (fwk_ring_is_full(&ctx->tx_ring)) {
+            while (reg->FR & PL011_FR_TXFF)
+                continue;
+
+            mod_pl011_fill_fifo(reg, ctx);
+        }
+
+        fwk_ring_push(&ctx->tx_ring, &ch, sizeof(ch));
+
+        reg->IMSC |= PL011_IMSC_TXIM;
+
+        return;
+    }
+
+    while (reg->FR & PL011_FR_TXFF)
+        continue;
+
+    reg->DR = ch;
+}
+
+/* Send a span of characters, prepending a carriage return to new lines */
+static void mod_pl011_write(
+    fwk_id_t id,
+    const char *buffer,
+    size_t size,
+    bool crlf)
 {
     const struct mod_pl011_element_cfg *cfg = fwk_module_get_data(id);
     struct mod_pl011_element_ctx *ctx =
@@ -167,10 +255,18 @@ static void mod_pl011_putch(fwk_id_t id, char ch)
     fwk_assert(ctx->powered);
     fwk_assert(ctx->clocked);
 
-    while (reg->FR & PL011_FR_TXFF)
-        continue;
+    if (ctx->tx_async)
+        fwk_interrupt_global_disable();
 
-    reg->DR = ch;
+    for (size_t i = 0; i < size; i++) {
+        if (crlf && (buffer[i] == '\n'))
+            mod_pl011_tx(reg, ctx, '\r');
+
+        mod_pl011_tx(reg, ctx, buffer[i]);
+    }
+
+    if (ctx->tx_async)
+        fwk_interrupt_global_enable();
 }
 
 static bool mod_pl011_getch(fwk_id_t id, char *ch)
@@ -203,6 +299,21 @@ static void mod_pl011_flush(fwk_id_t id)
     fwk_assert(ctx->powered);
     fwk_assert(ctx->clocked);
 
+    if (ctx->tx_async) {
+        fwk_interrupt_global_disable();
+
+        while (!fwk_ring_is_empty(&ctx->tx_ring)) {
+            while (reg->FR & PL011_FR_TXFF)
+                continue;
+
+            mod_pl011_fill_fifo(reg, ctx);
+        }
+
+        reg->IMSC &= ~PL011_IMSC_TXIM;
+
+        fwk_interrupt_global_enable();
+    }
+
     while (reg->FR & PL011_FR_BUSY)
         continue;
 }
@@ -237,6 +348,19 @@ static int mod_pl011_start(fwk_id_t id)
 
     cfg = fwk_module_get_data(id);
 
+    if (cfg->tx_buffer_size > 0) {
+        status = fwk_interrupt_set_isr_param(
+            cfg->irq, mod_pl011_isr, fwk_id_get_element_idx(id));
+        if (status != FWK_SUCCESS)
+            return FWK_E_HANDLER;
+
+        status = fwk_interrupt_enable(cfg->irq);
+        if (status != FWK_SUCCESS)
+            return FWK_E_HANDLER;
+
+        mod_pl011_ctx.elements[fwk_id_get_element_idx(id)].tx_async = true;
+    }
+
 #ifdef BUILD_HAS_MOD_POWER_DOMAIN
     /*
      * Subscribe to power domain pre-state change notifications when a power
@@ -289,6 +413,8 @@ static int mod_pl011_powering_down(fwk_id_t id)
         &mod_pl011_ctx.elements[fwk_id_get_element_idx(id)];
     const struct mod_pl011_element_cfg *cfg = fwk_module_get_data(id);
 
+    mod_pl011_flush(id); /* Send what is left while the device is on */
+
     ctx->powered = false; /* This device has gone offline */
 
     /* We don't care about the pre-transition power on notification */
@@ -595,10 +721,42 @@ static int mod_pl011_io_putch(const struct fwk_io_stream *stream, char ch)
     if (!ctx->powered || !ctx->clocked)
         return FWK_E_PWRSTATE;
 
-    if ((ch == '\n') && !(stream->mode & FWK_IO_MODE_BINARY))
-        mod_pl011_putch(stream->id, '\r'); /* Prepend carriage return */
+    mod_pl011_write(
+        stream->id, &ch, sizeof(ch), !(stream->mode & FWK_IO_MODE_BINARY));
+
+    return FWK_SUCCESS;
+}
 
-    mod_pl011_putch(stream->id, ch);
+static int mod_pl011_io_write(
+    const struct fwk_io_stream *stream,
+    const char *buffer,
+    size_t size)
+{
+    const struct mod_pl011_element_ctx *ctx =
+        &mod_pl011_ctx.elements[fwk_id_get_element_idx(stream->id)];
+
+    fwk_assert(ctx->open);
+
+    if (!ctx->powered || !ctx->clocked)
+        return FWK_E_PWRSTATE;
+
+    mod_pl011_write(
+        stream->id, buffer, size, !(stream->mode & FWK_IO_MODE_BINARY));
+
+    return FWK_SUCCESS;
+}
+
+static int mod_pl011_io_flush(const struct fwk_io_stream *stream)
+{
+    const struct mod_pl011_element_ctx *ctx =
+        &mod_pl011_ctx.elements[fwk_id_get_element_idx(stream->id)];
+
+    fwk_assert(ctx->open);
+
+    if (!ctx->powered || !ctx->clocked)
+        return FWK_E_PWRSTATE;
+
+    mod_pl011_flush(stream->id);
 
     return FWK_SUCCESS;
 }
@@ -635,6 +793,8 @@ const struct fwk_module module_pl011 = {
             .open = mod_pl011_io_open,
             .getch = mod_pl011_io_getch,
             .putch = mod_pl011_io_putch,
+            .write = mod_pl011_io_write,
+            .flush = mod_pl011_io_flush,
             .close = mod_pl011_close,
         },
 };
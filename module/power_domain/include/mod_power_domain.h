@@ -39,6 +39,11 @@
  */
 #define MOD_PD_STATE_COUNT_MAX 16
 
+/*!
+ * Maximum number of power domains in a set state batch request.
+ */
+#define MOD_PD_SET_STATE_BATCH_MAX 64
+
 /*!
  * \brief Types of power domain.
  */
@@ -103,6 +108,16 @@ struct mod_power_domain_config {
 
     /*! Number of identifiers in the "authorized_id_table" table. */
     size_t authorized_id_table_size;
+
+    /*!
+     * \brief Flag indicating statistics in use
+     *
+     * \details When set, the power state residency, the number of entries
+     *      into each power state and the latency of the requested transitions
+     *      of the power domains with 'stats_collected' set are published in
+     *      the power domain statistics region of the statistics module.
+     */
+    bool stats_enabled;
 };
 
 /*!
@@ -177,6 +192,19 @@ struct mod_power_domain_element_config {
 
     /*! Disable power domain transition notifications */
     bool disable_state_transition_notifications;
+
+    /*! Flag indicating that statistics are collected for this domain */
+    bool stats_collected;
+
+    /*!
+     * \brief Flag indicating that the state of the domain may change without
+     *      the module being involved, e.g. under hardware control.
+     *
+     * \details The state of such a domain is read from its driver when it is
+     *      queried. The state of the other domains is the one tracked by the
+     *      module.
+     */
+    bool externally_controlled;
 };
 
 /*!
@@ -388,8 +416,11 @@ struct mod_pd_driver_api {
      * \param system_shutdown Type of system shutdown.
      *
      * \retval ::FWK_SUCCESS The operation succeeded.
-     * \retval ::FWK_PENDING The operation was acknowledged. Please note that at
-     *      present there is no dedicated driver input api for this case.
+     * \retval ::FWK_PENDING The operation was acknowledged. The driver reports
+     *      the completion of the shutdown through
+     *      ::mod_pd_driver_input_api::report_power_state_transition. The power
+     *      domain module carries on with the shutdown of the other power
+     *      domains in the meantime, except for the parent of the power domain.
      * \retval ::FWK_E_ACCESS Invalid access, the framework has rejected the
      *      call to the API.
      */
@@ -534,6 +565,43 @@ struct mod_pd_restricted_api {
      */
     int (*set_state_async)(fwk_id_t pd_id, bool resp_requested, uint32_t state);
 
+    /*!
+     * \brief Request an asynchronous power state transition of a set of
+     *      power domains.
+     *
+     * \details The power domains are processed as part of a single request:
+     *      their power state pre-transition notifications are sent together
+     *      and the driver calls are issued back-to-back. When requested, a
+     *      single response carrying a ::pd_set_state_response is sent once
+     *      all the power domains have completed their transition, with the
+     *      status of the first failure if any.
+     *
+     * \warning Successful completion of this function does not indicate
+     *      completion of the transitions, but instead that a request has been
+     *      submitted.
+     *
+     * \param pd_mask Mask of the power domains whose state has to be set. Bit
+     *      \c n stands for the power domain of element index \c n, which must
+     *      be lower than ::MOD_PD_SET_STATE_BATCH_MAX.
+     *
+     * \param resp_requested True if the caller wants to be notified with an
+     *      event response at the end of the request processing.
+     *
+     * \param state State each power domain has to be put into and possibly
+     *      the state(s) its ancestor(s) has(have) to be put into.
+     *
+     * \retval ::FWK_SUCCESS The power state transitions were submitted.
+     * \retval ::FWK_E_ACCESS Invalid access, the framework has rejected the
+     *      call to the API.
+     * \retval ::FWK_E_PARAM One or more parameters were invalid.
+     * \note The response status is ::FWK_E_BUSY if another batch is still
+     *      waiting for its response.
+     */
+    int (*set_state_batch)(
+        uint64_t pd_mask,
+        bool resp_requested,
+        uint32_t state);
+
     /*!
      * \brief Get the state of a given power domain.
      *
@@ -541,10 +609,11 @@ struct mod_pd_restricted_api {
      *      retrieved.
      * \param[out] state The power domain state.
      *
+     * \details The state is the one tracked by the module, or the one read
+     *      from the driver for the domains flagged as externally controlled.
+     *      No event is exchanged with the module.
+     *
      * \retval ::FWK_SUCCESS The power state was returned.
-     * \retval ::FWK_E_ACCESS Invalid access, the framework has rejected the
-     *      call to the API.
-     * \retval ::FWK_E_HANDLER The function is not called from a thread.
      * \retval ::FWK_E_PARAM An invalid parameter was encountered:
      *      - The `pd_id` parameter was not a valid system entity identifier.
      *      - The `state` parameter was a null pointer value.
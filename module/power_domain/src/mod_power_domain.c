@@ -9,6 +9,9 @@
  */
 
 #include <mod_power_domain.h>
+#ifdef BUILD_HAS_STATISTICS
+#    include <mod_stats.h>
+#endif
 
 #include <fwk_assert.h>
 #include <fwk_event.h>
@@ -22,6 +25,7 @@
 #include <fwk_notification.h>
 #include <fwk_status.h>
 #include <fwk_thread.h>
+#include <fwk_time.h>
 
 #include <inttypes.h>
 #include <stdbool.h>
@@ -36,14 +40,17 @@ struct response_ctx {
     /* Pending response flag. */
     bool pending;
 
+    /* The response is owed to the set state batch request in progress. */
+    bool batch;
+
     /* Cookie of the event to respond to. */
     uint32_t cookie;
 };
 
 /* Context for the power state transition notification */
 struct power_state_transition_notification_ctx {
-    /* Number of pending notification responses */
-    unsigned int pending_responses;
+    /* Waiting for the responses to the notification */
+    bool pending;
 
     /*
      * Power state the power domain has transitioned to.
@@ -56,16 +63,15 @@ struct power_state_transition_notification_ctx {
 
 /* Context for the power state pre-transition notification */
 struct power_state_pre_transition_notification_ctx {
-    /* Number of pending notification responses */
-    unsigned int pending_responses;
+    /* Waiting for the responses to the notification */
+    bool pending;
 
     /* Target power state */
     unsigned int state;
 
     /*
-     * Status of the responses received so far. Either FWK_SUCCESS if all the
-     * responses received so far have indicated success, or FWK_E_DEVICE
-     * otherwise.
+     * Status of the responses. Either FWK_SUCCESS if all the responses have
+     * indicated success, or FWK_E_DEVICE otherwise.
      */
     int response_status;
 
@@ -157,6 +163,20 @@ struct pd_ctx {
     /* Context for the power state pre-transition notification */
     struct power_state_pre_transition_notification_ctx
         power_state_pre_transition_notification_ctx;
+
+#ifdef BUILD_HAS_STATISTICS
+    /*
+     * Time at which the requested state changed, zero when no transition
+     * latency is being measured.
+     */
+    fwk_timestamp_t request_timestamp;
+#endif
+
+    /* The driver has yet to report the completion of the shutdown */
+    bool shutdown_pending;
+
+    /* Time at which the shutdown of the power domain started */
+    fwk_timestamp_t shutdown_timestamp;
 };
 
 struct system_suspend_ctx {
@@ -182,14 +202,41 @@ struct system_shutdown_ctx {
     /* Flag indicating if a system shutdown is ongoing */
     bool ongoing;
 
-    /* Total count of notifications sent for system shutdown */
-    unsigned int notifications_count;
+    /* Waiting for the responses to the pre-shutdown notification */
+    bool notification_pending;
 
     /* Type of system shutdown */
     enum mod_pd_system_shutdown system_shutdown;
 
     /* Cookie of the event to respond to */
     uint32_t cookie;
+
+    /* Index of the next power domain to shut down */
+    unsigned int next_pd_idx;
+
+    /* Number of power domains whose driver has deferred the shutdown */
+    unsigned int pending_count;
+
+    /* Time at which the system shutdown was requested */
+    fwk_timestamp_t start_timestamp;
+
+    /* Time at which all the pre-shutdown notifications were acknowledged */
+    fwk_timestamp_t quiesce_timestamp;
+};
+
+/* Context of the set state batch request waiting for its response */
+struct set_state_batch_ctx {
+    /* Number of power domains yet to complete their transition */
+    unsigned int pending_responses;
+
+    /* First error reported by the power domains of the batch */
+    int status;
+
+    /* Composite state requested by the batch */
+    uint32_t composite_state;
+
+    /* Cookie of the event to respond to */
+    uint32_t cookie;
 };
 
 struct mod_pd_ctx {
@@ -210,6 +257,14 @@ struct mod_pd_ctx {
 
     /* System shutdown context */
     struct system_shutdown_ctx system_shutdown;
+
+    /* Set state batch context */
+    struct set_state_batch_ctx set_state_batch;
+
+#ifdef BUILD_HAS_STATISTICS
+    /* Statistics module API */
+    const struct mod_stats_api *stats_api;
+#endif
 };
 
 /*
@@ -222,6 +277,10 @@ enum pd_event_idx {
     PD_EVENT_IDX_REPORT_POWER_STATE_TRANSITION,
     PD_EVENT_IDX_SYSTEM_SUSPEND,
     PD_EVENT_IDX_SYSTEM_SHUTDOWN,
+    PD_EVENT_IDX_SET_STATE_BATCH,
+    PD_EVENT_IDX_PRE_TRANSITION_NOTIFIED,
+    PD_EVENT_IDX_TRANSITION_NOTIFIED,
+    PD_EVENT_IDX_PRE_SHUTDOWN_NOTIFIED,
     PD_EVENT_COUNT
 };
 
@@ -244,6 +303,18 @@ struct pd_set_state_request {
     uint32_t composite_state;
 };
 
+/*
+ * PD_EVENT_IDX_SET_STATE_BATCH
+ * Parameters of the set state batch request event
+ */
+struct pd_set_state_batch_request {
+    /* Mask of the element indices of the power domains to set */
+    uint64_t pd_mask;
+
+    /* Composite state each power domain of the mask has to be put into */
+    uint32_t composite_state;
+};
+
 /*
  * MOD_PD_PUBLIC_EVENT_IDX_GET_STATE
  * Parameters of the get state request event
@@ -615,10 +686,10 @@ static bool check_power_state_pre_transition_notification(struct pd_ctx *pd,
  */
 static bool initiate_power_state_pre_transition_notification(struct pd_ctx *pd)
 {
-    unsigned int state;
+    int status;
+    unsigned int state, subscriber_count, count;
     struct fwk_event notification_event = {
         .id = mod_pd_notification_id_power_state_pre_transition,
-        .response_requested = true,
         .source_id = FWK_ID_NONE
     };
     struct mod_pd_power_state_pre_transition_notification_params *params;
@@ -634,25 +705,41 @@ static bool initiate_power_state_pre_transition_notification(struct pd_ctx *pd)
      * If still waiting for some responses on the previous power state
      * pre-transition notification, wait for them before to issue the next one.
      */
-    if (pd->power_state_pre_transition_notification_ctx.pending_responses != 0)
+    if (pd->power_state_pre_transition_notification_ctx.pending)
         return true;
 
+    pd->power_state_pre_transition_notification_ctx.state = state;
+    pd->power_state_pre_transition_notification_ctx.response_status =
+        FWK_SUCCESS;
+    pd->power_state_pre_transition_notification_ctx.valid = true;
+
+    /*
+     * Without subscribers there are no responses to wait for, the transition
+     * can be initiated straight away.
+     */
+    status = fwk_notification_get_subscriber_count(
+        mod_pd_notification_id_power_state_pre_transition,
+        pd->id,
+        &subscriber_count);
+    if ((status == FWK_SUCCESS) && (subscriber_count == 0))
+        return false;
+
     params = (struct mod_pd_power_state_pre_transition_notification_params *)
         notification_event.params;
     params->current_state = pd->current_state;
     params->target_state = state;
 
     notification_event.source_id = pd->id;
-    fwk_notification_notify(&notification_event,
-        &pd->power_state_pre_transition_notification_ctx.pending_responses);
+    status = fwk_notification_notify_and_collect(
+        &notification_event,
+        FWK_ID_EVENT(
+            FWK_MODULE_IDX_POWER_DOMAIN, PD_EVENT_IDX_PRE_TRANSITION_NOTIFIED),
+        &count);
 
-    pd->power_state_pre_transition_notification_ctx.state = state;
-    pd->power_state_pre_transition_notification_ctx.response_status =
-        FWK_SUCCESS;
-    pd->power_state_pre_transition_notification_ctx.valid = true;
+    pd->power_state_pre_transition_notification_ctx.pending =
+        (status == FWK_SUCCESS) && (count != 0);
 
-    return (pd->power_state_pre_transition_notification_ctx.pending_responses
-            != 0);
+    return pd->power_state_pre_transition_notification_ctx.pending;
 }
 
 /*
@@ -715,6 +802,116 @@ static int initiate_power_state_transition(struct pd_ctx *pd)
  * \param pd Description of the power domain in charge of the response
  * \param resp_status Response status
  */
+#ifdef BUILD_HAS_STATISTICS
+/*
+ * Record a power state transition in the statistics of a power domain. The
+ * latency is only recorded when the requested state has been reached.
+ *
+ * \param pd Description of the power domain
+ * \param state New power state of the power domain
+ */
+static void stats_update(struct pd_ctx *pd, unsigned int state)
+{
+    fwk_duration_ns_t latency;
+
+    if ((mod_pd_ctx.stats_api == NULL) || !pd->config->stats_collected)
+        return;
+
+    mod_pd_ctx.stats_api->update_domain(
+        fwk_module_id_power_domain, pd->id, state);
+
+    if ((state != pd->requested_state) || (pd->request_timestamp == 0))
+        return;
+
+    latency = fwk_time_stamp_duration(pd->request_timestamp);
+    pd->request_timestamp = 0;
+
+    mod_pd_ctx.stats_api->update_domain_latency(
+        fwk_module_id_power_domain,
+        pd->id,
+        (uint32_t)FWK_MIN(fwk_time_duration_us(latency), UINT32_MAX));
+}
+
+/*
+ * Number of power states tracked in the statistics of a power domain, from
+ * MOD_PD_STATE_OFF up to its deepest valid state.
+ */
+static int stats_level_count(const struct pd_ctx *pd)
+{
+    int level_count = MOD_PD_STATE_COUNT_MAX;
+
+    while ((level_count > 1) &&
+           ((pd->valid_state_mask & (1U << (level_count - 1))) == 0))
+        level_count--;
+
+    return level_count;
+}
+
+static int stats_start(void)
+{
+    int status;
+    int stats_domains = 0;
+    unsigned int pd_idx;
+    struct pd_ctx *pd;
+
+    for (pd_idx = 0; pd_idx < mod_pd_ctx.pd_count; pd_idx++) {
+        if (mod_pd_ctx.pd_ctx_table[pd_idx].config->stats_collected)
+            stats_domains++;
+    }
+
+    status = mod_pd_ctx.stats_api->init_stats(
+        fwk_module_id_power_domain, (int)mod_pd_ctx.pd_count, stats_domains);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (pd_idx = 0; pd_idx < mod_pd_ctx.pd_count; pd_idx++) {
+        pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
+        if (!pd->config->stats_collected)
+            continue;
+
+        status = mod_pd_ctx.stats_api->add_domain(
+            fwk_module_id_power_domain, pd->id, stats_level_count(pd));
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = mod_pd_ctx.stats_api->add_domain_latency(
+            fwk_module_id_power_domain, pd->id);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return mod_pd_ctx.stats_api->start_stats(fwk_module_id_power_domain);
+}
+#endif
+
+static void respond_batch(int resp_status)
+{
+    int status;
+    struct fwk_event resp_event;
+    struct set_state_batch_ctx *batch = &mod_pd_ctx.set_state_batch;
+    struct pd_set_state_response *resp_params =
+        (struct pd_set_state_response *)(&resp_event.params);
+
+    if (batch->pending_responses == 0)
+        return;
+
+    if ((resp_status != FWK_SUCCESS) && (batch->status == FWK_SUCCESS))
+        batch->status = resp_status;
+
+    if (--batch->pending_responses != 0)
+        return;
+
+    status = fwk_thread_get_delayed_response(
+        fwk_module_id_power_domain, batch->cookie, &resp_event);
+    if (status != FWK_SUCCESS)
+        return;
+
+    resp_params->composite_state = batch->composite_state;
+    resp_params->status = batch->status;
+
+    fwk_thread_put_event(&resp_event);
+}
+
 static void respond(struct pd_ctx *pd, int resp_status)
 {
     int status;
@@ -727,6 +924,14 @@ static void respond(struct pd_ctx *pd, int resp_status)
     if (!pd->response.pending)
         return;
 
+    if (pd->response.batch) {
+        pd->response.pending = false;
+        pd->response.batch = false;
+        respond_batch(resp_status);
+
+        return;
+    }
+
     status = fwk_thread_get_delayed_response(
         pd->id, pd->response.cookie, &resp_event);
     pd->response.pending = false;
@@ -741,21 +946,23 @@ static void respond(struct pd_ctx *pd, int resp_status)
 }
 
 /*
- * Process a 'set state' request
+ * Request a composite state for a power domain and initiate the transitions
+ * that can be initiated straight away.
  *
- * \param lowest_pd  Description of the target of the 'set state' request
- * \param req_params Parameters of the 'set state' request
- * \param [out] Response event
+ * \param lowest_pd Description of the target of the request
+ * \param composite_state Composite state requested
+ * \param [out] pd_in_charge Power domain in charge of the response to the
+ *      request, NULL if the request has been completed
+ *
+ * \retval ::FWK_SUCCESS The request was accepted.
+ * \return One of the other error codes of the power state transition.
  */
-static void process_set_state_request(
+static int set_composite_state(
     struct pd_ctx *lowest_pd,
-    const struct fwk_event *event,
-    struct fwk_event *resp_event)
+    uint32_t composite_state,
+    struct pd_ctx **pd_in_charge)
 {
     int status;
-    struct pd_set_state_request *req_params;
-    struct pd_set_state_response *resp_params;
-    uint32_t composite_state;
     bool up, first_power_state_transition_initiated, composite_state_operation;
     enum mod_pd_level lowest_level, highest_level, level;
     unsigned int nb_pds, pd_index, state;
@@ -763,15 +970,12 @@ static void process_set_state_request(
     const struct pd_ctx *parent;
     const uint32_t *state_mask_table = NULL;
 
-    req_params = (struct pd_set_state_request *)event->params;
-    resp_params = (struct pd_set_state_response *)resp_event->params;
     pd_in_charge_of_response = NULL;
     first_power_state_transition_initiated = false;
 
     /* A set state request cancels the completion of system suspend. */
     mod_pd_ctx.system_suspend.last_core_off_ongoing = false;
 
-    composite_state = req_params->composite_state;
     up = is_upwards_transition_propagation(lowest_pd, composite_state);
 
     /*
@@ -834,6 +1038,9 @@ static void process_set_state_request(
          */
         pd->requested_state = state;
         pd->power_state_pre_transition_notification_ctx.valid = false;
+#ifdef BUILD_HAS_STATISTICS
+        pd->request_timestamp = fwk_time_current();
+#endif
         respond(pd, FWK_E_OVERWRITTEN);
 
         if (pd->state_requested_to_driver == state)
@@ -888,6 +1095,36 @@ static void process_set_state_request(
         first_power_state_transition_initiated = true;
     }
 
+    *pd_in_charge = pd_in_charge_of_response;
+
+    return status;
+}
+
+/*
+ * Process a 'set state' request
+ *
+ * \param lowest_pd  Description of the target of the 'set state' request
+ * \param req_params Parameters of the 'set state' request
+ * \param [out] Response event
+ */
+static void process_set_state_request(
+    struct pd_ctx *lowest_pd,
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    int status;
+    struct pd_set_state_request *req_params;
+    struct pd_set_state_response *resp_params;
+    uint32_t composite_state;
+    struct pd_ctx *pd_in_charge_of_response;
+
+    req_params = (struct pd_set_state_request *)event->params;
+    resp_params = (struct pd_set_state_response *)resp_event->params;
+
+    composite_state = req_params->composite_state;
+    status = set_composite_state(
+        lowest_pd, composite_state, &pd_in_charge_of_response);
+
     if (!event->response_requested)
         return;
 
@@ -902,6 +1139,81 @@ static void process_set_state_request(
     }
 }
 
+/*
+ * Process a 'set state batch' request
+ *
+ * All the power domains of the batch are processed as part of the same
+ * event: their pre-transition notifications are sent together and the driver
+ * calls that need not wait for them are issued back-to-back. The response is
+ * sent once all the power domains of the batch have completed their
+ * transition.
+ *
+ * \param event 'set state batch' request event
+ * \param [out] Response event
+ */
+static void process_set_state_batch_request(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    int status, pd_status;
+    const struct pd_set_state_batch_request *req_params;
+    struct pd_set_state_response *resp_params;
+    struct set_state_batch_ctx *batch = &mod_pd_ctx.set_state_batch;
+    struct pd_ctx *pd, *pd_in_charge_of_response;
+    unsigned int pd_idx, pending_responses;
+
+    req_params = (struct pd_set_state_batch_request *)event->params;
+    resp_params = (struct pd_set_state_response *)resp_event->params;
+
+    /* Only one batch at a time may be waiting for its response */
+    if (event->response_requested && (batch->pending_responses != 0)) {
+        resp_params->status = FWK_E_BUSY;
+        resp_params->composite_state = req_params->composite_state;
+
+        return;
+    }
+
+    status = FWK_SUCCESS;
+    pending_responses = 0;
+
+    for (pd_idx = 0; pd_idx < mod_pd_ctx.pd_count; pd_idx++) {
+        if ((req_params->pd_mask & (UINT64_C(1) << pd_idx)) == 0)
+            continue;
+
+        pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
+
+        pd_status = set_composite_state(
+            pd, req_params->composite_state, &pd_in_charge_of_response);
+        if ((pd_status != FWK_SUCCESS) && (status == FWK_SUCCESS))
+            status = pd_status;
+
+        if (!event->response_requested || (pd_in_charge_of_response == NULL))
+            continue;
+
+        /* Ancestors shared by several domains of the batch respond once */
+        if (pd_in_charge_of_response->response.pending)
+            continue;
+
+        pd_in_charge_of_response->response.pending = true;
+        pd_in_charge_of_response->response.batch = true;
+        pending_responses++;
+    }
+
+    if (!event->response_requested)
+        return;
+
+    if (pending_responses != 0) {
+        batch->pending_responses = pending_responses;
+        batch->status = status;
+        batch->composite_state = req_params->composite_state;
+        batch->cookie = resp_event->cookie;
+        resp_event->is_delayed_response = true;
+    } else {
+        resp_params->status = status;
+        resp_params->composite_state = req_params->composite_state;
+    }
+}
+
 /*
  * Complete a system suspend
  *
@@ -965,6 +1277,26 @@ static int complete_system_suspend(struct pd_ctx *target_pd)
     return resp_params->status;
 }
 
+/*
+ * Get the current state of a power domain. The state tracked by the module is
+ * returned, except for the domains controlled outside of the module whose
+ * state is read from their driver.
+ */
+static unsigned int get_current_state(const struct pd_ctx *pd)
+{
+    int status;
+    unsigned int state;
+
+    if (!pd->config->externally_controlled)
+        return pd->current_state;
+
+    status = pd->driver_api->get_state(pd->driver_id, &state);
+    if (status != FWK_SUCCESS)
+        return pd->current_state;
+
+    return state;
+}
+
 /*
  * Process a 'get composite state' request.
  *
@@ -984,7 +1316,7 @@ static void process_get_state_request(struct pd_ctx *pd,
     int table_size, cs_idx = 0;
 
     if (!pd->cs_support)
-        resp_params->state = pd->current_state;
+        resp_params->state = get_current_state(pd);
     else {
         state_mask_table = pd->composite_state_mask_table;
         table_size = pd->composite_state_mask_table_size;
@@ -996,7 +1328,7 @@ static void process_get_state_request(struct pd_ctx *pd,
          */
         do {
             shift = number_of_bits_to_shift(state_mask_table[cs_idx]);
-            composite_state |= pd->current_state << shift;
+            composite_state |= get_current_state(pd) << shift;
             pd = pd->parent;
             cs_idx++;
             level++;
@@ -1104,61 +1436,245 @@ static void process_power_state_transition_report_shallower_state(
     }
 }
 
+static uint32_t shutdown_elapsed_us(fwk_timestamp_t start,
+                                    fwk_timestamp_t end)
+{
+    return (uint32_t)FWK_MIN(
+        fwk_time_duration_us(fwk_time_duration(start, end)), UINT32_MAX);
+}
+
 /*
- * Process a power state transition report
- *
- * \param pd Description of the target of the power state transition report
- * \param report_params Parameters of the power state transition report
+ * Check whether a child of a power domain has yet to complete its shutdown
  */
-static void process_power_state_transition_report(struct pd_ctx *pd,
-    const struct pd_power_state_transition_report *report_params)
+static bool is_child_shutdown_pending(const struct pd_ctx *pd)
 {
-    unsigned int new_state = report_params->state;
-    unsigned int previous_state;
-    struct fwk_event notification_event = {
-        .id = mod_pd_notification_id_power_state_transition,
-        .response_requested = true,
-        .source_id = FWK_ID_NONE
-    };
-    struct mod_pd_power_state_transition_notification_params *params;
+    const struct pd_ctx *child = NULL;
+    struct fwk_slist *c_node = NULL;
 
-    if (new_state == pd->requested_state)
-        respond(pd, FWK_SUCCESS);
+    FWK_LIST_FOR_EACH(
+        &pd->children_list, c_node, struct pd_ctx, child_node, child)
+    {
+        if (child->shutdown_pending)
+            return true;
+    }
 
-    previous_state = pd->current_state;
-    pd->current_state = new_state;
+    return false;
+}
 
-    if (pd->power_state_transition_notification_ctx.pending_responses == 0 &&
-        pd->config->disable_state_transition_notifications == false) {
-        params = (struct mod_pd_power_state_transition_notification_params *)
-            notification_event.params;
-        params->state = new_state;
-        pd->power_state_transition_notification_ctx.state = new_state;
-        fwk_notification_notify(&notification_event,
-            &pd->power_state_transition_notification_ctx.pending_responses);
-    }
+static int shutdown_pd(struct pd_ctx *pd)
+{
+    struct mod_pd_driver_api *api = pd->driver_api;
 
-    if ((mod_pd_ctx.system_suspend.last_core_off_ongoing) &&
-        (pd == mod_pd_ctx.system_suspend.last_core_pd)) {
-        mod_pd_ctx.system_suspend.last_core_off_ongoing = false;
-        complete_system_suspend(pd);
+    FWK_LOG_INFO("[PD] Shutting down %s", fwk_module_get_name(pd->id));
 
-        return;
-    }
+    pd->shutdown_timestamp = fwk_time_current();
 
-    if (pd->parent == NULL) {
-        /* this is the top pd (SYSTOP) */
-        if (mod_pd_ctx.system_suspend.state != MOD_PD_STATE_ON) {
-            /* has gone down, invalidate the system suspend ongoing */
-            mod_pd_ctx.system_suspend.suspend_ongoing = false;
-        }
+    if (api->shutdown != NULL) {
+        return api->shutdown(
+            pd->driver_id, mod_pd_ctx.system_shutdown.system_shutdown);
     }
 
-    /*
-     * If notifications are pending, the transition report is delayed until all
-     * the state change notifications responses have arrived.
+    if ((api->deny != NULL) && api->deny(pd->driver_id, MOD_PD_STATE_OFF))
+        return FWK_E_DEVICE;
+
+    return api->set_state(pd->driver_id, MOD_PD_STATE_OFF);
+}
+
+static void complete_pd_shutdown(struct pd_ctx *pd, int status)
+{
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_ERR(
+            "[PD] Shutdown of %s returned %s (%d)",
+            fwk_module_get_name(pd->id),
+            fwk_status_str(status),
+            status);
+    } else {
+        FWK_LOG_INFO(
+            "[PD] %s shutdown in %" PRIu32 " us",
+            fwk_module_get_name(pd->id),
+            shutdown_elapsed_us(pd->shutdown_timestamp, fwk_time_current()));
+    }
+
+    pd->requested_state =
+        pd->state_requested_to_driver =
+        pd->current_state = MOD_PD_STATE_OFF;
+}
+
+/*
+ * Shut down the power domains in the order of the power domain table.
+ *
+ * A driver deferring the shutdown of its power domain does not hold back the
+ * power domains that follow, so independent parts of the system are shut down
+ * in parallel. Only the parent of the power domain waits, until all its
+ * children are off.
+ *
+ * Returns true once all the power domains have been shut down.
+ */
+static bool continue_shutdown(void)
+{
+    struct system_shutdown_ctx *ctx = &mod_pd_ctx.system_shutdown;
+    struct pd_ctx *pd;
+    int status;
+
+    for (; ctx->next_pd_idx < mod_pd_ctx.pd_count; ctx->next_pd_idx++) {
+        pd = &mod_pd_ctx.pd_ctx_table[ctx->next_pd_idx];
+
+        if (is_child_shutdown_pending(pd))
+            return false;
+
+        status = shutdown_pd(pd);
+        if (status == FWK_PENDING) {
+            pd->shutdown_pending = true;
+            ctx->pending_count++;
+
+            continue;
+        }
+
+        complete_pd_shutdown(pd, status);
+    }
+
+    return (ctx->pending_count == 0);
+}
+
+static void respond_shutdown(struct fwk_event *resp)
+{
+    struct system_shutdown_ctx *ctx = &mod_pd_ctx.system_shutdown;
+    struct fwk_event delayed_resp;
+    struct pd_response *resp_params;
+    int status;
+
+    FWK_LOG_INFO(
+        "[PD] Shutdown stages: quiesce %" PRIu32 " us, power off %" PRIu32
+        " us",
+        shutdown_elapsed_us(ctx->start_timestamp, ctx->quiesce_timestamp),
+        shutdown_elapsed_us(ctx->quiesce_timestamp, fwk_time_current()));
+
+    /*
+     * At this time, the system is already down or will be down soon.
+     * Regardless, we tentatively send the response event to the caller, should
+     * the system fail to complete the shutdown process, the agent may want to
+     * be notified.
      */
-    if (pd->power_state_transition_notification_ctx.pending_responses > 0) {
+    if (resp != NULL) {
+        resp_params = (struct pd_response *)resp->params;
+        resp_params->status = FWK_E_PANIC;
+
+        return;
+    }
+
+    status = fwk_thread_get_delayed_response(
+        fwk_module_id_power_domain, ctx->cookie, &delayed_resp);
+    fwk_assert(status == FWK_SUCCESS);
+
+    delayed_resp.source_id = fwk_module_id_power_domain;
+
+    resp_params = (struct pd_response *)delayed_resp.params;
+    resp_params->status = FWK_E_PANIC;
+
+    status = fwk_thread_put_event(&delayed_resp);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
+/*
+ * Process the report of a driver completing a deferred shutdown
+ */
+static void process_shutdown_report(struct pd_ctx *pd, unsigned int state)
+{
+    pd->shutdown_pending = false;
+    mod_pd_ctx.system_shutdown.pending_count--;
+
+    complete_pd_shutdown(
+        pd, (state == MOD_PD_STATE_OFF) ? FWK_SUCCESS : FWK_E_DEVICE);
+
+    if (continue_shutdown())
+        respond_shutdown(NULL);
+}
+
+/*
+ * Send a power state transition notification for the current power state of a
+ * power domain.
+ *
+ * \param pd Description of the power domain that transitioned
+ */
+static void notify_power_state_transition(struct pd_ctx *pd)
+{
+    int status;
+    unsigned int count;
+    struct fwk_event notification_event = {
+        .id = mod_pd_notification_id_power_state_transition,
+        .source_id = pd->id
+    };
+    struct mod_pd_power_state_transition_notification_params *params;
+
+    params = (struct mod_pd_power_state_transition_notification_params *)
+        notification_event.params;
+    params->state = pd->current_state;
+
+    pd->power_state_transition_notification_ctx.state = pd->current_state;
+
+    status = fwk_notification_notify_and_collect(
+        &notification_event,
+        FWK_ID_EVENT(
+            FWK_MODULE_IDX_POWER_DOMAIN, PD_EVENT_IDX_TRANSITION_NOTIFIED),
+        &count);
+
+    pd->power_state_transition_notification_ctx.pending =
+        (status == FWK_SUCCESS) && (count != 0);
+}
+
+/*
+ * Process a power state transition report
+ *
+ * \param pd Description of the target of the power state transition report
+ * \param report_params Parameters of the power state transition report
+ */
+static void process_power_state_transition_report(struct pd_ctx *pd,
+    const struct pd_power_state_transition_report *report_params)
+{
+    unsigned int new_state = report_params->state;
+    unsigned int previous_state;
+
+    if (pd->shutdown_pending) {
+        process_shutdown_report(pd, new_state);
+
+        return;
+    }
+
+    if (new_state == pd->requested_state)
+        respond(pd, FWK_SUCCESS);
+
+#ifdef BUILD_HAS_STATISTICS
+    stats_update(pd, new_state);
+#endif
+
+    previous_state = pd->current_state;
+    pd->current_state = new_state;
+
+    if (!pd->power_state_transition_notification_ctx.pending &&
+        pd->config->disable_state_transition_notifications == false)
+        notify_power_state_transition(pd);
+
+    if ((mod_pd_ctx.system_suspend.last_core_off_ongoing) &&
+        (pd == mod_pd_ctx.system_suspend.last_core_pd)) {
+        mod_pd_ctx.system_suspend.last_core_off_ongoing = false;
+        complete_system_suspend(pd);
+
+        return;
+    }
+
+    if (pd->parent == NULL) {
+        /* this is the top pd (SYSTOP) */
+        if (mod_pd_ctx.system_suspend.state != MOD_PD_STATE_ON) {
+            /* has gone down, invalidate the system suspend ongoing */
+            mod_pd_ctx.system_suspend.suspend_ongoing = false;
+        }
+    }
+
+    /*
+     * If notifications are pending, the transition report is delayed until all
+     * the state change notifications responses have arrived.
+     */
+    if (pd->power_state_transition_notification_ctx.pending) {
          /*
           * Save previous state which will be used once all the notifications
           * have arrived to continue for deeper or shallower state for the next
@@ -1238,104 +1754,30 @@ static void process_system_suspend_request(
     resp_params->status = status;
 }
 
-void perform_shutdown(
-    enum mod_pd_system_shutdown system_shutdown,
-    struct fwk_event *resp)
-{
-    struct pd_ctx *pd;
-    unsigned int pd_idx;
-    fwk_id_t pd_id;
-    int status;
-    struct fwk_event delayed_resp;
-    struct pd_response *resp_params;
-    struct mod_pd_driver_api *api;
-
-    for (pd_idx = 0; pd_idx < mod_pd_ctx.pd_count; pd_idx++) {
-        pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
-        pd_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN, pd_idx);
-        api = pd->driver_api;
-
-        FWK_LOG_INFO("[PD] Shutting down %s", fwk_module_get_name(pd_id));
-
-        if (api->shutdown != NULL) {
-            status = pd->driver_api->shutdown(pd->driver_id, system_shutdown);
-            if (status == FWK_PENDING) {
-                /*
-                 * Only drivers implementing shutdown API can defer request for
-                 * now.
-                 */
-                return;
-            }
-        } else {
-            if ((api->deny != NULL) &&
-                api->deny(pd->driver_id, MOD_PD_STATE_OFF))
-                status = FWK_E_DEVICE;
-            else
-                status = api->set_state(pd->driver_id, MOD_PD_STATE_OFF);
-        }
-
-        if (status != FWK_SUCCESS)
-            FWK_LOG_ERR(
-                "[PD] Shutdown of %s returned %s (%d)",
-                fwk_module_get_name(pd_id),
-                fwk_status_str(status),
-                status);
-        else
-            FWK_LOG_INFO("[PD] %s shutdown", fwk_module_get_name(pd_id));
-
-        pd->requested_state =
-            pd->state_requested_to_driver =
-            pd->current_state = MOD_PD_STATE_OFF;
-    }
-
-    /*
-     * At this time, the system is already down or will be down soon.
-     * Regardless, we tentatively send the response event to the caller, should
-     * the system fail to complete the shutdown process, the agent may want to
-     * be notified.
-     */
-    if (resp == NULL) {
-        status = fwk_thread_get_delayed_response(fwk_module_id_power_domain,
-            mod_pd_ctx.system_shutdown.cookie, &delayed_resp);
-        fwk_assert(status == FWK_SUCCESS);
-
-        delayed_resp.source_id = fwk_module_id_power_domain;
-
-        resp_params = (struct pd_response *)delayed_resp.params;
-        resp_params->status = FWK_E_PANIC;
-
-        status = fwk_thread_put_event(&delayed_resp);
-    } else {
-        resp_params = (struct pd_response *)resp->params;
-        resp_params->status = FWK_E_PANIC;
-
-        status = fwk_thread_put_event(resp);
-    }
-
-    fwk_assert(status == FWK_SUCCESS);
-
-    return;
-}
-
 static bool check_and_notify_system_shutdown(
     enum mod_pd_system_shutdown system_shutdown)
 {
+    int status;
+    unsigned int count;
     struct mod_pd_pre_shutdown_notif_params *params;
-
     struct fwk_event notification = {
         .id = mod_pd_notification_id_pre_shutdown,
         .source_id = fwk_module_id_power_domain,
-        .response_requested = true
     };
 
     params = (struct mod_pd_pre_shutdown_notif_params *)notification.params;
     params->system_shutdown = system_shutdown;
 
-    fwk_notification_notify(
+    status = fwk_notification_notify_and_collect(
         &notification,
-        &mod_pd_ctx.system_shutdown.notifications_count);
+        FWK_ID_EVENT(
+            FWK_MODULE_IDX_POWER_DOMAIN, PD_EVENT_IDX_PRE_SHUTDOWN_NOTIFIED),
+        &count);
+
+    mod_pd_ctx.system_shutdown.notification_pending =
+        (status == FWK_SUCCESS) && (count != 0);
 
-    return (mod_pd_ctx.system_shutdown.notifications_count != 0);
+    return mod_pd_ctx.system_shutdown.notification_pending;
 }
 
 /*
@@ -1350,15 +1792,26 @@ static void process_system_shutdown_request(
     const struct pd_system_shutdown_request *req_params =
         (struct pd_system_shutdown_request *)event->params;
     struct pd_response *resp_params = (struct pd_response *)resp->params;
+    struct system_shutdown_ctx *ctx = &mod_pd_ctx.system_shutdown;
+
+    if (ctx->ongoing) {
+        resp_params->status = FWK_E_BUSY;
+
+        return;
+    }
 
     system_shutdown = req_params->system_shutdown;
 
+    ctx->ongoing = true;
+    ctx->system_shutdown = system_shutdown;
+    ctx->cookie = event->cookie;
+    ctx->next_pd_idx = 0;
+    ctx->pending_count = 0;
+    ctx->start_timestamp = fwk_time_current();
+    ctx->quiesce_timestamp = ctx->start_timestamp;
+
     /* Check and send pre-shutdown notifications */
     if (check_and_notify_system_shutdown(system_shutdown)) {
-        mod_pd_ctx.system_shutdown.ongoing = true;
-        mod_pd_ctx.system_shutdown.system_shutdown = system_shutdown;
-
-        mod_pd_ctx.system_shutdown.cookie = event->cookie;
         resp->is_delayed_response = true;
 
         /*
@@ -1368,9 +1821,17 @@ static void process_system_shutdown_request(
         return;
     }
 
-    perform_shutdown(system_shutdown, resp);
+    if (!continue_shutdown()) {
+        /*
+         * The shutdown procedure will be completed once all the drivers which
+         * deferred the shutdown have reported it.
+         */
+        resp->is_delayed_response = true;
 
-    resp_params->status = FWK_E_PANIC;
+        return;
+    }
+
+    respond_shutdown(resp);
 }
 
 /*
@@ -1484,35 +1945,64 @@ static int pd_set_state_async(
     return fwk_thread_put_event(&req);
 }
 
-static int pd_get_state(fwk_id_t pd_id, unsigned int *state)
+static int pd_set_state_batch(
+    uint64_t pd_mask,
+    bool response_requested,
+    uint32_t state)
 {
-    int status;
+    struct pd_ctx *pd;
+    unsigned int pd_idx;
     struct fwk_event req;
-    struct fwk_event resp;
-    struct pd_get_state_request *req_params =
-        (struct pd_get_state_request *)(&req.params);
-    struct pd_get_state_response *resp_params =
-        (struct pd_get_state_response *)(&resp.params);
+    struct pd_set_state_batch_request *req_params =
+        (struct pd_set_state_batch_request *)(&req.params);
 
-    if (state == NULL)
+    if (pd_mask == 0)
         return FWK_E_PARAM;
 
+    for (pd_idx = 0; pd_idx < MOD_PD_SET_STATE_BATCH_MAX; pd_idx++) {
+        if ((pd_mask & (UINT64_C(1) << pd_idx)) == 0)
+            continue;
+
+        if (pd_idx >= mod_pd_ctx.pd_count)
+            return FWK_E_PARAM;
+
+        pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
+
+        if (pd->cs_support) {
+            if (!is_valid_composite_state(pd, state))
+                return FWK_E_PARAM;
+        } else {
+            if (!is_valid_state(pd, state))
+                return FWK_E_PARAM;
+        }
+    }
+
     req = (struct fwk_event) {
         .id = FWK_ID_EVENT(FWK_MODULE_IDX_POWER_DOMAIN,
-                           MOD_PD_PUBLIC_EVENT_IDX_GET_STATE),
-        .target_id = pd_id,
+                           PD_EVENT_IDX_SET_STATE_BATCH),
+        .target_id = fwk_module_id_power_domain,
+        .response_requested = response_requested,
     };
 
-    req_params->composite = false;
+    req_params->pd_mask = pd_mask;
+    req_params->composite_state = state;
 
-    status = fwk_thread_put_event_and_wait(&req, &resp);
-    if (status != FWK_SUCCESS)
-        return status;
+    return fwk_thread_put_event(&req);
+}
+
+static int pd_get_state(fwk_id_t pd_id, unsigned int *state)
+{
+    const struct pd_ctx *pd;
+
+    if (state == NULL)
+        return FWK_E_PARAM;
+
+    if (!fwk_module_is_valid_element_id(pd_id))
+        return FWK_E_PARAM;
 
-    if (resp_params->status != FWK_SUCCESS)
-        return resp_params->status;
+    pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(pd_id)];
 
-    *state = resp_params->state;
+    *state = get_current_state(pd);
 
     return FWK_SUCCESS;
 }
@@ -1654,6 +2144,7 @@ static const struct mod_pd_restricted_api pd_restricted_api = {
 
     .set_state = pd_set_state,
     .set_state_async = pd_set_state_async,
+    .set_state_batch = pd_set_state_batch,
     .get_state = pd_get_state,
     .reset = pd_reset,
     .system_suspend = pd_system_suspend,
@@ -1765,8 +2256,17 @@ static int pd_bind(fwk_id_t id, unsigned int round)
     if (round != 0)
         return FWK_SUCCESS;
 
-    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+#ifdef BUILD_HAS_STATISTICS
+        if (mod_pd_ctx.config->stats_enabled) {
+            return fwk_module_bind(
+                fwk_module_id_statistics,
+                mod_stats_api_id_stats,
+                &mod_pd_ctx.stats_api);
+        }
+#endif
         return FWK_SUCCESS;
+    }
 
     pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(id)];
     config = pd->config;
@@ -1799,6 +2299,17 @@ static int pd_start(fwk_id_t id)
     if (fwk_module_is_valid_element_id(id))
         return FWK_SUCCESS;
 
+#ifdef BUILD_HAS_STATISTICS
+    if (mod_pd_ctx.stats_api != NULL) {
+        status = stats_start();
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_ERR("[PD] Statistics not available: %s",
+                        fwk_status_str(status));
+            mod_pd_ctx.stats_api = NULL;
+        }
+    }
+#endif
+
     for (index = mod_pd_ctx.pd_count - 1; index >= 0; index--) {
         pd = &mod_pd_ctx.pd_ctx_table[index];
         pd->requested_state = MOD_PD_STATE_OFF;
@@ -1885,100 +2396,45 @@ static int pd_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
     return FWK_SUCCESS;
 }
 
-static int pd_process_event(const struct fwk_event *event,
-                            struct fwk_event *resp)
-{
-    struct pd_ctx *pd = NULL;
-
-    if (fwk_id_is_type(event->target_id, FWK_ID_TYPE_ELEMENT))
-        pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(event->target_id)];
-
-    switch (fwk_id_get_event_idx(event->id)) {
-    case MOD_PD_PUBLIC_EVENT_IDX_SET_STATE:
-        fwk_assert(pd != NULL);
-
-        process_set_state_request(pd, event, resp);
-
-        return FWK_SUCCESS;
-
-    case MOD_PD_PUBLIC_EVENT_IDX_GET_STATE:
-        fwk_assert(pd != NULL);
-
-        process_get_state_request(pd,
-            (struct pd_get_state_request *)event->params,
-            (struct pd_get_state_response *)resp->params);
-
-        return FWK_SUCCESS;
-
-    case PD_EVENT_IDX_RESET:
-        fwk_assert(pd != NULL);
-
-        process_reset_request(pd, (struct pd_response *)resp->params);
-
-        return FWK_SUCCESS;
-
-    case PD_EVENT_IDX_REPORT_POWER_STATE_TRANSITION:
-        fwk_assert(pd != NULL);
-
-        process_power_state_transition_report(pd,
-            (struct pd_power_state_transition_report *)event->params);
-
-        return FWK_SUCCESS;
-
-    case PD_EVENT_IDX_SYSTEM_SUSPEND:
-        process_system_suspend_request(
-            (struct pd_system_suspend_request *)event->params,
-            (struct pd_response *)resp->params);
-
-        return FWK_SUCCESS;
-
-    case PD_EVENT_IDX_SYSTEM_SHUTDOWN:
-        process_system_shutdown_request(event, resp);
-
-        return FWK_SUCCESS;
+/*
+ * The completion events below are sent by the framework once all the
+ * responses to a notification sent with fwk_notification_notify_and_collect()
+ * have been received.
+ */
 
-    default:
-        FWK_LOG_ERR(
-            "[PD] Invalid power state request: %s.", FWK_ID_STR(event->id));
+static int process_pre_shutdown_notification_completion(void)
+{
+    struct system_shutdown_ctx *ctx = &mod_pd_ctx.system_shutdown;
 
+    if (!ctx->ongoing || !ctx->notification_pending)
         return FWK_E_PARAM;
-    }
-}
 
-static int process_pre_shutdown_notification_response(void)
-{
-    if (mod_pd_ctx.system_shutdown.ongoing) {
-        mod_pd_ctx.system_shutdown.notifications_count--;
+    /* All notifications for system shutdown have been received */
+    ctx->notification_pending = false;
+    ctx->quiesce_timestamp = fwk_time_current();
 
-        if (mod_pd_ctx.system_shutdown.notifications_count == 0) {
-            /* All notifications for system shutdown have been received */
-            perform_shutdown(mod_pd_ctx.system_shutdown.system_shutdown, NULL);
-        }
-        return FWK_SUCCESS;
-    } else {
-        return FWK_E_PARAM;
-    }
+    if (continue_shutdown())
+        respond_shutdown(NULL);
+
+    return FWK_SUCCESS;
 }
 
-static int process_power_state_pre_transition_notification_response(
+static int process_power_state_pre_transition_notification_completion(
     struct pd_ctx *pd,
-    struct mod_pd_power_state_pre_transition_notification_resp_params *params)
+    const struct fwk_notification_completion_params *params)
 {
-    if (pd->power_state_pre_transition_notification_ctx.pending_responses
-        == 0) {
+    if (!pd->power_state_pre_transition_notification_ctx.pending) {
         fwk_unexpected();
         return FWK_E_PANIC;
     }
 
+    pd->power_state_pre_transition_notification_ctx.pending = false;
+
     if (params->status != FWK_SUCCESS) {
         pd->power_state_pre_transition_notification_ctx.response_status =
             FWK_E_DEVICE;
     }
 
-    pd->power_state_pre_transition_notification_ctx.pending_responses--;
-    if (pd->power_state_pre_transition_notification_ctx.pending_responses != 0)
-        return FWK_SUCCESS;
-
     if (pd->power_state_pre_transition_notification_ctx.valid == true) {
         /*
          * All the notification responses have been received, the requested
@@ -2005,20 +2461,15 @@ static int process_power_state_pre_transition_notification_response(
 
     return FWK_SUCCESS;
 }
-static int process_power_state_transition_notification_response(
+static int process_power_state_transition_notification_completion(
     struct pd_ctx *pd)
 {
-    struct fwk_event notification_event = { 0 };
-    struct mod_pd_power_state_transition_notification_params *params;
-
-    if (pd->power_state_transition_notification_ctx.pending_responses == 0) {
+    if (!pd->power_state_transition_notification_ctx.pending) {
         fwk_unexpected();
         return FWK_E_PANIC;
     }
 
-    pd->power_state_transition_notification_ctx.pending_responses--;
-    if (pd->power_state_transition_notification_ctx.pending_responses != 0)
-        return FWK_SUCCESS;
+    pd->power_state_transition_notification_ctx.pending = false;
 
     if (pd->power_state_transition_notification_ctx.state ==
         pd->current_state) {
@@ -2044,49 +2495,88 @@ static int process_power_state_transition_notification_response(
      * While receiving the responses, the power state of the power domain
      * has changed. Send a notification for the current power state.
      */
-    notification_event.id = mod_pd_notification_id_power_state_transition;
-    notification_event.response_requested = true;
-    notification_event.source_id = FWK_ID_NONE;
-
-    params = (struct mod_pd_power_state_transition_notification_params *)
-        notification_event.params;
-    params->state = pd->current_state;
-
-    pd->power_state_transition_notification_ctx.state = pd->current_state;
-    fwk_notification_notify(&notification_event,
-        &pd->power_state_transition_notification_ctx.pending_responses);
+    notify_power_state_transition(pd);
 
     return FWK_SUCCESS;
 }
 
-static int pd_process_notification(const struct fwk_event *event,
-                                   struct fwk_event *resp)
+static int pd_process_event(const struct fwk_event *event,
+                            struct fwk_event *resp)
 {
-    struct pd_ctx *pd;
+    struct pd_ctx *pd = NULL;
 
-    /* Only responses are expected. */
-    if (!event->is_response) {
-        fwk_unexpected();
-        return FWK_E_SUPPORT;
-    }
+    if (fwk_id_is_type(event->target_id, FWK_ID_TYPE_ELEMENT))
+        pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(event->target_id)];
 
-    if (fwk_id_is_equal(event->id, mod_pd_notification_id_pre_shutdown))
-        return process_pre_shutdown_notification_response();
+    switch (fwk_id_get_event_idx(event->id)) {
+    case MOD_PD_PUBLIC_EVENT_IDX_SET_STATE:
+        fwk_assert(pd != NULL);
 
-    if (!fwk_module_is_valid_element_id(event->target_id)) {
-        fwk_unexpected();
-        return FWK_E_PARAM;
-    }
+        process_set_state_request(pd, event, resp);
 
-    pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(event->target_id)];
+        return FWK_SUCCESS;
 
-    if (fwk_id_is_equal(event->id,
-                        mod_pd_notification_id_power_state_transition))
-        return process_power_state_transition_notification_response(pd);
+    case MOD_PD_PUBLIC_EVENT_IDX_GET_STATE:
+        fwk_assert(pd != NULL);
 
-    return process_power_state_pre_transition_notification_response(pd,
-        (struct mod_pd_power_state_pre_transition_notification_resp_params *)
-        event->params);
+        process_get_state_request(pd,
+            (struct pd_get_state_request *)event->params,
+            (struct pd_get_state_response *)resp->params);
+
+        return FWK_SUCCESS;
+
+    case PD_EVENT_IDX_RESET:
+        fwk_assert(pd != NULL);
+
+        process_reset_request(pd, (struct pd_response *)resp->params);
+
+        return FWK_SUCCESS;
+
+    case PD_EVENT_IDX_REPORT_POWER_STATE_TRANSITION:
+        fwk_assert(pd != NULL);
+
+        process_power_state_transition_report(pd,
+            (struct pd_power_state_transition_report *)event->params);
+
+        return FWK_SUCCESS;
+
+    case PD_EVENT_IDX_SYSTEM_SUSPEND:
+        process_system_suspend_request(
+            (struct pd_system_suspend_request *)event->params,
+            (struct pd_response *)resp->params);
+
+        return FWK_SUCCESS;
+
+    case PD_EVENT_IDX_SYSTEM_SHUTDOWN:
+        process_system_shutdown_request(event, resp);
+
+        return FWK_SUCCESS;
+
+    case PD_EVENT_IDX_SET_STATE_BATCH:
+        process_set_state_batch_request(event, resp);
+
+        return FWK_SUCCESS;
+
+    case PD_EVENT_IDX_PRE_TRANSITION_NOTIFIED:
+        fwk_assert(pd != NULL);
+
+        return process_power_state_pre_transition_notification_completion(pd,
+            (struct fwk_notification_completion_params *)event->params);
+
+    case PD_EVENT_IDX_TRANSITION_NOTIFIED:
+        fwk_assert(pd != NULL);
+
+        return process_power_state_transition_notification_completion(pd);
+
+    case PD_EVENT_IDX_PRE_SHUTDOWN_NOTIFIED:
+        return process_pre_shutdown_notification_completion();
+
+    default:
+        FWK_LOG_ERR(
+            "[PD] Invalid power state request: %s.", FWK_ID_STR(event->id));
+
+        return FWK_E_PARAM;
+    }
 }
 
 /* Module definition */
@@ -2104,6 +2594,6 @@ const struct fwk_module module_power_domain = {
     .bind = pd_bind,
     .start = pd_start,
     .process_bind_request = pd_process_bind_request,
+    .bind_shared_api_mask = (1U << MOD_PD_API_IDX_PUBLIC),
     .process_event = pd_process_event,
-    .process_notification = pd_process_notification
 };
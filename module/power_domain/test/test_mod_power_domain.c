@@ -0,0 +1,228 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* The handlers under test are private to the module */
+#include <mod_power_domain.c>
+
+#include <fwk_assert.h>
+#include <fwk_macros.h>
+#include <fwk_notification.h>
+#include <fwk_status.h>
+#include <fwk_test.h>
+
+#include <string.h>
+
+#define PD_ID FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN, 0)
+
+#define PRE_TRANSITION_NOTIFIED_ID \
+    FWK_ID_EVENT( \
+        FWK_MODULE_IDX_POWER_DOMAIN, PD_EVENT_IDX_PRE_TRANSITION_NOTIFIED)
+
+#define TRANSITION_NOTIFIED_ID \
+    FWK_ID_EVENT( \
+        FWK_MODULE_IDX_POWER_DOMAIN, PD_EVENT_IDX_TRANSITION_NOTIFIED)
+
+static unsigned int fake_subscriber_count;
+static unsigned int notify_and_collect_count_call;
+static struct fwk_event notify_and_collect_event;
+static fwk_id_t notify_and_collect_completion_event_id;
+
+static unsigned int set_state_count_call;
+static unsigned int set_state_state;
+
+/* Wrapped functions */
+
+int __wrap_fwk_notification_notify_and_collect(
+    struct fwk_event *notification_event,
+    fwk_id_t completion_event_id,
+    unsigned int *count)
+{
+    notify_and_collect_count_call++;
+    notify_and_collect_event = *notification_event;
+    notify_and_collect_completion_event_id = completion_event_id;
+
+    *count = fake_subscriber_count;
+
+    return FWK_SUCCESS;
+}
+
+int __wrap_fwk_notification_get_subscriber_count(
+    fwk_id_t notification_id,
+    fwk_id_t source_id,
+    unsigned int *count)
+{
+    *count = fake_subscriber_count;
+
+    return FWK_SUCCESS;
+}
+
+const char *__wrap_fwk_module_get_name(fwk_id_t id)
+{
+    return "PD";
+}
+
+static int set_state(fwk_id_t dev_id, unsigned int state)
+{
+    set_state_count_call++;
+    set_state_state = state;
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_pd_driver_api fake_driver_api = {
+    .set_state = set_state,
+};
+
+static const struct mod_power_domain_element_config fake_pd_config = {
+    .disable_state_transition_notifications = false,
+};
+
+static struct pd_ctx fake_pd_ctx_table[1];
+
+static void test_case_setup(void)
+{
+    struct pd_ctx *pd = &fake_pd_ctx_table[0];
+
+    memset(&mod_pd_ctx, 0, sizeof(mod_pd_ctx));
+    memset(fake_pd_ctx_table, 0, sizeof(fake_pd_ctx_table));
+
+    mod_pd_ctx.pd_ctx_table = fake_pd_ctx_table;
+    mod_pd_ctx.pd_count = FWK_ARRAY_SIZE(fake_pd_ctx_table);
+
+    pd->id = PD_ID;
+    pd->config = &fake_pd_config;
+    pd->driver_api = &fake_driver_api;
+    pd->current_state = MOD_PD_STATE_OFF;
+    pd->state_requested_to_driver = MOD_PD_STATE_OFF;
+    pd->requested_state = MOD_PD_STATE_ON;
+    fwk_list_init(&pd->children_list);
+
+    fake_subscriber_count = 2;
+    notify_and_collect_count_call = 0;
+    set_state_count_call = 0;
+}
+
+static int put_completion(
+    fwk_id_t completion_event_id,
+    fwk_id_t notification_id,
+    int status)
+{
+    struct fwk_event resp = { 0 };
+    struct fwk_event completion = {
+        .id = completion_event_id,
+        .source_id = PD_ID,
+        .target_id = PD_ID,
+    };
+    struct fwk_notification_completion_params *params =
+        (struct fwk_notification_completion_params *)completion.params;
+
+    params->notification_id = notification_id;
+    params->response_count = fake_subscriber_count;
+    params->status = status;
+
+    return pd_process_event(&completion, &resp);
+}
+
+static void test_pre_transition_notification_completion(void)
+{
+    int status;
+    struct pd_ctx *pd = &fake_pd_ctx_table[0];
+
+    /* The transition waits for the subscribers */
+    assert(initiate_power_state_pre_transition_notification(pd));
+    assert(notify_and_collect_count_call == 1);
+    assert(fwk_id_is_equal(notify_and_collect_event.source_id, PD_ID));
+    assert(fwk_id_is_equal(
+        notify_and_collect_completion_event_id, PRE_TRANSITION_NOTIFIED_ID));
+    assert(pd->power_state_pre_transition_notification_ctx.pending);
+    assert(set_state_count_call == 0);
+
+    /* No notification for another state is sent while waiting */
+    pd->requested_state = MOD_PD_STATE_OFF;
+    assert(initiate_power_state_pre_transition_notification(pd));
+    assert(notify_and_collect_count_call == 1);
+    pd->requested_state = MOD_PD_STATE_ON;
+
+    /* All the subscribers agreed, the transition is initiated */
+    status = put_completion(
+        PRE_TRANSITION_NOTIFIED_ID,
+        mod_pd_notification_id_power_state_pre_transition,
+        FWK_SUCCESS);
+    assert(status == FWK_SUCCESS);
+    assert(!pd->power_state_pre_transition_notification_ctx.pending);
+    assert(set_state_count_call == 1);
+    assert(set_state_state == MOD_PD_STATE_ON);
+}
+
+static void test_pre_transition_notification_completion_denied(void)
+{
+    int status;
+    struct pd_ctx *pd = &fake_pd_ctx_table[0];
+
+    assert(initiate_power_state_pre_transition_notification(pd));
+
+    /* A subscriber disagreed, the transition is not initiated */
+    status = put_completion(
+        PRE_TRANSITION_NOTIFIED_ID,
+        mod_pd_notification_id_power_state_pre_transition,
+        FWK_E_STATE);
+    assert(status == FWK_SUCCESS);
+    assert(pd->power_state_pre_transition_notification_ctx.response_status ==
+           FWK_E_DEVICE);
+    assert(set_state_count_call == 0);
+
+    /* Nothing is waited for without subscribers */
+    fake_subscriber_count = 0;
+    pd->power_state_pre_transition_notification_ctx.valid = false;
+    assert(!initiate_power_state_pre_transition_notification(pd));
+    assert(notify_and_collect_count_call == 1);
+}
+
+static void test_transition_notification_completion(void)
+{
+    int status;
+    struct pd_ctx *pd = &fake_pd_ctx_table[0];
+
+    notify_power_state_transition(pd);
+    assert(notify_and_collect_count_call == 1);
+    assert(fwk_id_is_equal(
+        notify_and_collect_completion_event_id, TRANSITION_NOTIFIED_ID));
+    assert(pd->power_state_transition_notification_ctx.pending);
+
+    /* The state changed while waiting, the new state is notified */
+    pd->current_state = MOD_PD_STATE_ON;
+    status = put_completion(
+        TRANSITION_NOTIFIED_ID,
+        mod_pd_notification_id_power_state_transition,
+        FWK_SUCCESS);
+    assert(status == FWK_SUCCESS);
+    assert(notify_and_collect_count_call == 2);
+    assert(pd->power_state_transition_notification_ctx.pending);
+    assert(pd->power_state_transition_notification_ctx.state ==
+           MOD_PD_STATE_ON);
+
+    /* A completion that is not waited for is unexpected */
+    pd->power_state_transition_notification_ctx.pending = false;
+    status = put_completion(
+        TRANSITION_NOTIFIED_ID,
+        mod_pd_notification_id_power_state_transition,
+        FWK_SUCCESS);
+    assert(status == FWK_E_PANIC);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_pre_transition_notification_completion),
+    FWK_TEST_CASE(test_pre_transition_notification_completion_denied),
+    FWK_TEST_CASE(test_transition_notification_completion),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "mod_power_domain",
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
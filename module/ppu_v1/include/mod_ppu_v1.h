@@ -39,6 +39,8 @@ enum mod_ppu_v1_api_idx {
     MOD_PPU_V1_API_IDX_ISR,
     /*! System boot API */
     MOD_PPU_V1_API_IDX_BOOT,
+    /*! Idle statistics API */
+    MOD_PPU_V1_API_IDX_IDLE_STATS,
     /*! Number of exposed interfaces */
     MOD_PPU_V1_API_IDX_COUNT,
 };
@@ -89,6 +91,42 @@ struct mod_ppu_v1_config {
     fwk_id_t pd_source_id;
 };
 
+/*!
+ * \brief Retention mode a core is demoted to when idle.
+ */
+enum mod_ppu_v1_retention_mode {
+    /*! Full retention, the logic and the RAMs of the core are retained */
+    MOD_PPU_V1_RETENTION_FULL,
+
+    /*! Functional retention, the core is clock gated */
+    MOD_PPU_V1_RETENTION_FUNCTIONAL,
+};
+
+/*!
+ * \brief Idle state predictor configuration.
+ *
+ * \details While a core is in the SLEEP state, its PPU powers it off
+ *      dynamically each time it goes idle. The predictor measures how long
+ *      each idle period of the core lasts and keeps a moving average of these
+ *      residencies. When the average is below the break-even time of the OFF
+ *      mode, the next idle period of the core is spent in retention instead,
+ *      sparing the power down and the warm boot of the core.
+ *
+ * \warning A core kept in retention resumes from the power down request of
+ *      its firmware instead of warm booting. Only enable the predictor for
+ *      cores whose firmware supports a power down request not being honoured.
+ */
+struct mod_ppu_v1_idle_predictor_config {
+    /*!
+     * \brief Shortest idle period for which the OFF mode saves energy over
+     *      retention, in microseconds.
+     */
+    uint32_t break_even_us;
+
+    /*! Retention mode used for the idle periods predicted to be short */
+    enum mod_ppu_v1_retention_mode retention_mode;
+};
+
 /*!
  * \brief Configuration data of a power domain of the PPU_V1 driver module.
  */
@@ -136,6 +174,39 @@ struct mod_ppu_v1_pd_config {
 
     /*! Timer descriptor */
     struct mod_ppu_v1_timer_config *timer_config;
+
+    /*!
+     * \brief Idle state predictor.
+     *
+     * \note Only used for core power domains. May be NULL, in which case the
+     *      core always goes OFF when idle. Ignored when
+     *      ::mod_ppu_v1_pd_config::autonomous_idle is set, as the predictor
+     *      needs to see the idle periods of the core.
+     */
+    const struct mod_ppu_v1_idle_predictor_config *idle_predictor;
+
+    /*!
+     * \brief Leave the idle transitions of the core to its PPU.
+     *
+     * \details The PPU of a core in the ON or SLEEP state powers the core off
+     *      and on as it goes idle and wakes up, following the dynamic policy
+     *      set when the state was requested. By default the driver is
+     *      interrupted on each of these transitions to report them to the
+     *      power domain module. When this flag is set, the interrupts are left
+     *      masked and the power domain module only sees the states that are
+     *      requested for the core, taking the driver out of the idle path of
+     *      the core. The cluster of the core is still powered off and on
+     *      through its own PPU interrupt.
+     *
+     * \note Only used for core power domains.
+     *
+     * \warning The power domain element of a core with this flag set must
+     *      have ::mod_power_domain_element_config::externally_controlled set,
+     *      so that the state of the core is read from its PPU when it is
+     *      queried rather than taken from the state tracked by the power
+     *      domain module, which misses the idle transitions.
+     */
+    bool autonomous_idle;
 };
 
 /*!
@@ -180,6 +251,57 @@ struct ppu_v1_boot_api {
     int (*power_mode_on)(fwk_id_t pd_id);
 };
 
+/*!
+ * \brief Idle statistics of a core power domain.
+ */
+struct mod_ppu_v1_idle_stats {
+    /*! Number of idle periods */
+    uint32_t idle_count;
+
+    /*! Number of idle periods spent in retention rather than OFF */
+    uint32_t retention_count;
+
+    /*! Number of idle periods spent OFF but shorter than the break-even time */
+    uint32_t off_mispredictions;
+
+    /*!
+     * Number of idle periods spent in retention but longer than the
+     * break-even time
+     */
+    uint32_t retention_mispredictions;
+
+    /*! Predicted residency of the next idle period in microseconds */
+    uint32_t predicted_residency_us;
+};
+
+/*!
+ * \brief PPU_V1 module idle statistics API
+ */
+struct ppu_v1_idle_stats_api {
+    /*!
+     * \brief Get the idle statistics of a core power domain
+     *
+     * \param pd_id Identifier of the core power domain
+     * \param[out] stats Idle statistics of the core
+     *
+     * \retval ::FWK_SUCCESS Operation successful.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_SUPPORT The core has no idle state predictor.
+     */
+    int (*get_idle_stats)(fwk_id_t pd_id, struct mod_ppu_v1_idle_stats *stats);
+
+    /*!
+     * \brief Reset the idle statistics of a core power domain
+     *
+     * \param pd_id Identifier of the core power domain
+     *
+     * \retval ::FWK_SUCCESS Operation successful.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_SUPPORT The core has no idle state predictor.
+     */
+    int (*reset_idle_stats)(fwk_id_t pd_id);
+};
+
 /*!
  * \}
  */
@@ -18,6 +18,7 @@
 #endif
 
 #include <fwk_assert.h>
+#include <fwk_attributes.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
@@ -28,12 +29,32 @@
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
 #include <fwk_status.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #define CORE_PER_CLUSTER_COUNT_MAX 8
 
+/* Idle state predictor context of a core power domain */
+struct ppu_v1_idle_ctx {
+    /* Predictor configuration */
+    const struct mod_ppu_v1_idle_predictor_config *config;
+
+    /* At least one idle period has been measured */
+    bool has_prediction;
+
+    /* Minimum power mode of the dynamic policy of the core */
+    enum ppu_v1_mode mode;
+
+    /* Time at which the core went idle, zero if the core is not idle */
+    fwk_timestamp_t idle_timestamp;
+
+    /* Idle statistics, including the predicted residency */
+    struct mod_ppu_v1_idle_stats stats;
+};
+
 /* Power domain context */
 struct ppu_v1_pd_ctx {
     /* Power domain configuration data */
@@ -57,6 +78,9 @@ struct ppu_v1_pd_ctx {
     /* Timer context */
     struct ppu_v1_timer_ctx *timer_ctx;
 
+    /* Idle state predictor context (used only for core power domains) */
+    struct ppu_v1_idle_ctx *idle_ctx;
+
     /* Context data specific to the type of power domain */
     void *data;
 };
@@ -203,6 +227,95 @@ static const struct mod_pd_driver_api pd_driver = {
 /*
  * Functions specific to core power domains
  */
+
+/*
+ * Enable the dynamic transitions of a core, with OFF as the minimum power mode
+ * unless the next idle period of the core is predicted to be too short for it.
+ */
+static void core_dynamic_enable(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    struct ppu_v1_idle_ctx *idle_ctx = pd_ctx->idle_ctx;
+    enum ppu_v1_mode mode = PPU_V1_MODE_OFF;
+
+    if (idle_ctx != NULL) {
+        if (idle_ctx->has_prediction &&
+            (idle_ctx->stats.predicted_residency_us <
+             idle_ctx->config->break_even_us)) {
+            mode = (idle_ctx->config->retention_mode ==
+                    MOD_PPU_V1_RETENTION_FUNCTIONAL) ?
+                PPU_V1_MODE_FUNC_RET :
+                PPU_V1_MODE_FULL_RET;
+        }
+
+        idle_ctx->mode = mode;
+    }
+
+    ppu_v1_dynamic_enable(pd_ctx->ppu, mode);
+}
+
+/*
+ * Unmask the interrupt signalling that the core reached the minimum power mode
+ * of its dynamic policy. A core left to its PPU never raises it, nor the
+ * interrupt of its wake-up that it arms.
+ */
+static void core_idle_interrupt_unmask(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    if (!pd_ctx->config->autonomous_idle) {
+        ppu_v1_interrupt_unmask(
+            pd_ctx->ppu, PPU_V1_IMR_DYN_POLICY_MIN_IRQ_MASK);
+    }
+}
+
+static void core_idle_enter(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    struct ppu_v1_idle_ctx *idle_ctx = pd_ctx->idle_ctx;
+
+    if (idle_ctx == NULL)
+        return;
+
+    idle_ctx->idle_timestamp = fwk_time_current();
+
+    idle_ctx->stats.idle_count++;
+    if (idle_ctx->mode != PPU_V1_MODE_OFF)
+        idle_ctx->stats.retention_count++;
+}
+
+/*
+ * Account for the idle period the core is leaving and update the predicted
+ * residency, an average of the past residencies giving a weight of one quarter
+ * to the last one.
+ */
+static void core_idle_exit(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    struct ppu_v1_idle_ctx *idle_ctx = pd_ctx->idle_ctx;
+    struct mod_ppu_v1_idle_stats *stats;
+    uint32_t residency_us;
+
+    if ((idle_ctx == NULL) || (idle_ctx->idle_timestamp == 0))
+        return;
+
+    stats = &idle_ctx->stats;
+
+    residency_us = (uint32_t)FWK_MIN(
+        fwk_time_duration_us(fwk_time_stamp_duration(idle_ctx->idle_timestamp)),
+        UINT32_MAX);
+    idle_ctx->idle_timestamp = 0;
+
+    if (residency_us < idle_ctx->config->break_even_us) {
+        if (idle_ctx->mode == PPU_V1_MODE_OFF)
+            stats->off_mispredictions++;
+    } else if (idle_ctx->mode != PPU_V1_MODE_OFF)
+        stats->retention_mispredictions++;
+
+    if (idle_ctx->has_prediction) {
+        stats->predicted_residency_us = stats->predicted_residency_us -
+            (stats->predicted_residency_us / 4) + (residency_us / 4);
+    } else {
+        stats->predicted_residency_us = residency_us;
+        idle_ctx->has_prediction = true;
+    }
+}
+
 static int ppu_v1_core_pd_init(struct ppu_v1_pd_ctx *pd_ctx)
 {
     int status;
@@ -216,8 +329,8 @@ static int ppu_v1_core_pd_init(struct ppu_v1_pd_ctx *pd_ctx)
         return status;
 
     if (state == MOD_PD_STATE_ON) {
-        ppu_v1_interrupt_unmask(ppu, PPU_V1_IMR_DYN_POLICY_MIN_IRQ_MASK);
-        ppu_v1_dynamic_enable(ppu, PPU_V1_MODE_OFF);
+        core_idle_interrupt_unmask(pd_ctx);
+        core_dynamic_enable(pd_ctx);
     }
 
     return FWK_SUCCESS;
@@ -232,6 +345,8 @@ static int ppu_v1_core_pd_set_state(fwk_id_t core_pd_id, unsigned int state)
     pd_ctx = ppu_v1_ctx.pd_ctx_table + fwk_id_get_element_idx(core_pd_id);
     ppu = pd_ctx->ppu;
 
+    core_idle_exit(pd_ctx);
+
     switch (state) {
     case MOD_PD_STATE_OFF:
         ppu_v1_set_input_edge_sensitivity(ppu,
@@ -247,12 +362,12 @@ static int ppu_v1_core_pd_set_state(fwk_id_t core_pd_id, unsigned int state)
         break;
 
     case MOD_PD_STATE_ON:
-        ppu_v1_interrupt_unmask(ppu, PPU_V1_IMR_DYN_POLICY_MIN_IRQ_MASK);
+        core_idle_interrupt_unmask(pd_ctx);
         ppu_v1_set_input_edge_sensitivity(ppu,
                                           PPU_V1_MODE_ON,
                                           PPU_V1_EDGE_SENSITIVITY_MASKED);
         ppu_v1_set_power_mode(ppu, PPU_V1_MODE_ON, pd_ctx->timer_ctx);
-        ppu_v1_dynamic_enable(ppu, PPU_V1_MODE_OFF);
+        core_dynamic_enable(pd_ctx);
         status = pd_ctx->pd_driver_input_api->report_power_state_transition(
             pd_ctx->bound_id, MOD_PD_STATE_ON);
         fwk_assert(status == FWK_SUCCESS);
@@ -267,7 +382,7 @@ static int ppu_v1_core_pd_set_state(fwk_id_t core_pd_id, unsigned int state)
          * this is an OFF to SLEEP transition.
          */
         if (!ppu_v1_is_dynamic_enabled(ppu)) {
-            ppu_v1_dynamic_enable(ppu, PPU_V1_MODE_OFF);
+            core_dynamic_enable(pd_ctx);
             ppu_v1_set_input_edge_sensitivity(ppu,
                                               PPU_V1_MODE_ON,
                                               PPU_V1_EDGE_SENSITIVITY_MASKED);
@@ -313,10 +428,13 @@ static int ppu_v1_core_pd_prepare_for_system_suspend(fwk_id_t core_pd_id)
     return FWK_SUCCESS;
 }
 
+static void cluster_on(struct ppu_v1_pd_ctx *pd_ctx);
+
 static void core_pd_ppu_interrupt_handler(struct ppu_v1_pd_ctx *pd_ctx)
 {
     int status;
     struct ppu_v1_reg *ppu;
+    struct ppu_v1_pd_ctx *cluster_pd_ctx;
 
     ppu = pd_ctx->ppu;
 
@@ -328,6 +446,31 @@ static void core_pd_ppu_interrupt_handler(struct ppu_v1_pd_ctx *pd_ctx)
                                           PPU_V1_EDGE_SENSITIVITY_MASKED);
         ppu_v1_interrupt_unmask(ppu, PPU_V1_IMR_DYN_POLICY_MIN_IRQ_MASK);
 
+        /* Pick the minimum power mode of the next idle period */
+        if (pd_ctx->idle_ctx != NULL) {
+            core_idle_exit(pd_ctx);
+            core_dynamic_enable(pd_ctx);
+        }
+
+        /*
+         * A core waking up from SLEEP cannot run until its cluster is ON. If
+         * the cluster is OFF waiting for a core to wake it up, power it on now
+         * rather than waiting for the cluster interrupt to be serviced. The
+         * cluster interrupt then finds the cluster ON with an active core and
+         * leaves it as it is. The cluster transition is reported before the
+         * core one so that the power domain module sees them in order.
+         */
+        cluster_pd_ctx = pd_ctx->parent_pd_ctx;
+        if ((cluster_pd_ctx != NULL) &&
+            (ppu_v1_get_power_mode(cluster_pd_ctx->ppu) == PPU_V1_MODE_OFF) &&
+            (ppu_v1_get_input_edge_sensitivity(
+                 cluster_pd_ctx->ppu, PPU_V1_MODE_ON) ==
+             PPU_V1_EDGE_SENSITIVITY_RISING_EDGE)) {
+            cluster_on(cluster_pd_ctx);
+            ppu_v1_set_input_edge_sensitivity(cluster_pd_ctx->ppu,
+                PPU_V1_MODE_ON, PPU_V1_EDGE_SENSITIVITY_FALLING_EDGE);
+        }
+
         status = pd_ctx->pd_driver_input_api->report_power_state_transition(
             pd_ctx->bound_id, MOD_PD_STATE_ON);
         fwk_assert(status == FWK_SUCCESS);
@@ -337,6 +480,8 @@ static void core_pd_ppu_interrupt_handler(struct ppu_v1_pd_ctx *pd_ctx)
         ppu_v1_ack_interrupt(ppu, PPU_V1_ISR_DYN_POLICY_MIN_IRQ);
         ppu_v1_interrupt_mask(ppu, PPU_V1_IMR_DYN_POLICY_MIN_IRQ_MASK);
 
+        core_idle_enter(pd_ctx);
+
         status = pd_ctx->pd_driver_input_api->report_power_state_transition(
             pd_ctx->bound_id, MOD_PD_STATE_SLEEP);
         fwk_assert(status == FWK_SUCCESS);
@@ -601,14 +746,59 @@ static const struct mod_pd_driver_api cluster_pd_driver = {
     .shutdown = ppu_v1_pd_shutdown,
 };
 
-static void ppu_interrupt_handler(uintptr_t pd_ctx_param)
+static bool core_pd_ppu_interrupt_is_pending(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    return ppu_v1_is_power_active_edge_interrupt(pd_ctx->ppu, PPU_V1_MODE_ON) ||
+        ppu_v1_is_dyn_policy_min_interrupt(pd_ctx->ppu);
+}
+
+/*
+ * Service the interrupt of a core PPU, then the pending interrupts of the
+ * other cores of its cluster. When several cores of a cluster transition at
+ * once, their interrupts are serviced in a single interrupt entry.
+ */
+static void cluster_cores_ppu_interrupt_handler(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    struct ppu_v1_cluster_pd_ctx *cluster_pd_ctx;
+    struct ppu_v1_pd_ctx *core_pd_ctx;
+    unsigned int core_idx;
+    bool enabled;
+
+    core_pd_ppu_interrupt_handler(pd_ctx);
+
+    if (pd_ctx->parent_pd_ctx == NULL)
+        return;
+
+    cluster_pd_ctx = pd_ctx->parent_pd_ctx->data;
+
+    for (core_idx = 0; core_idx < cluster_pd_ctx->core_count; core_idx++) {
+        core_pd_ctx = cluster_pd_ctx->core_pd_ctx_table[core_idx];
+
+        if ((core_pd_ctx == pd_ctx) ||
+            !core_pd_ppu_interrupt_is_pending(core_pd_ctx))
+            continue;
+
+        /* Leave the cores whose interrupt has not been enabled yet alone */
+        if ((fwk_interrupt_is_enabled(
+                 core_pd_ctx->config->ppu.irq, &enabled) == FWK_SUCCESS) &&
+            !enabled)
+            continue;
+
+        core_pd_ppu_interrupt_handler(core_pd_ctx);
+
+        /* The interrupt has been serviced, do not enter the handler again */
+        fwk_interrupt_clear_pending(core_pd_ctx->config->ppu.irq);
+    }
+}
+
+static FWK_HOT void ppu_interrupt_handler(uintptr_t pd_ctx_param)
 {
     struct ppu_v1_pd_ctx *pd_ctx = (struct ppu_v1_pd_ctx *)pd_ctx_param;
 
     fwk_assert(pd_ctx != NULL);
 
     if (pd_ctx->config->pd_type == MOD_PD_TYPE_CORE)
-        core_pd_ppu_interrupt_handler(pd_ctx);
+        cluster_cores_ppu_interrupt_handler(pd_ctx);
     else
         cluster_pd_ppu_interrupt_handler(pd_ctx);
 }
@@ -645,6 +835,62 @@ static const struct ppu_v1_boot_api boot_api = {
     .power_mode_on = ppu_power_mode_on,
 };
 
+static int get_idle_ctx(fwk_id_t pd_id, struct ppu_v1_idle_ctx **idle_ctx)
+{
+    struct ppu_v1_pd_ctx *pd_ctx;
+
+    if (!fwk_module_is_valid_element_id(pd_id))
+        return FWK_E_PARAM;
+
+    pd_ctx = ppu_v1_ctx.pd_ctx_table + fwk_id_get_element_idx(pd_id);
+    if (pd_ctx->idle_ctx == NULL)
+        return FWK_E_SUPPORT;
+
+    *idle_ctx = pd_ctx->idle_ctx;
+
+    return FWK_SUCCESS;
+}
+
+static int ppu_get_idle_stats(fwk_id_t pd_id,
+                              struct mod_ppu_v1_idle_stats *stats)
+{
+    int status;
+    struct ppu_v1_idle_ctx *idle_ctx;
+
+    if (stats == NULL)
+        return FWK_E_PARAM;
+
+    status = get_idle_ctx(pd_id, &idle_ctx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *stats = idle_ctx->stats;
+
+    return FWK_SUCCESS;
+}
+
+static int ppu_reset_idle_stats(fwk_id_t pd_id)
+{
+    int status;
+    struct ppu_v1_idle_ctx *idle_ctx;
+
+    status = get_idle_ctx(pd_id, &idle_ctx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* The predicted residency is kept, only the counters are reset */
+    idle_ctx->stats = (struct mod_ppu_v1_idle_stats){
+        .predicted_residency_us = idle_ctx->stats.predicted_residency_us,
+    };
+
+    return FWK_SUCCESS;
+}
+
+static const struct ppu_v1_idle_stats_api idle_stats_api = {
+    .get_idle_stats = ppu_get_idle_stats,
+    .reset_idle_stats = ppu_reset_idle_stats,
+};
+
 /*
  * Framework handlers
  */
@@ -682,6 +928,13 @@ static int ppu_v1_pd_init(fwk_id_t pd_id, unsigned int unused, const void *data)
     if (config->pd_type == MOD_PD_TYPE_CLUSTER) {
         pd_ctx->data = fwk_mm_calloc(1, sizeof(struct ppu_v1_cluster_pd_ctx));
     }
+
+    if ((config->pd_type == MOD_PD_TYPE_CORE) &&
+        (config->idle_predictor != NULL) && !config->autonomous_idle) {
+        pd_ctx->idle_ctx = fwk_mm_calloc(1, sizeof(struct ppu_v1_idle_ctx));
+        pd_ctx->idle_ctx->config = config->idle_predictor;
+        pd_ctx->idle_ctx->mode = PPU_V1_MODE_OFF;
+    }
 #ifdef BUILD_HAS_MOD_TIMER
     if (config->timer_config == NULL) {
         pd_ctx->timer_ctx = NULL;
@@ -826,6 +1079,7 @@ static int ppu_v1_process_bind_request(fwk_id_t source_id,
                                        const void **api)
 {
     struct ppu_v1_pd_ctx *pd_ctx;
+    const struct mod_power_domain_element_config *bound_config;
     unsigned int api_idx;
     bool is_power_domain_module = false;
     bool is_system_power_module = false;
@@ -845,6 +1099,11 @@ static int ppu_v1_process_bind_request(fwk_id_t source_id,
         return FWK_SUCCESS;
     }
 
+    if (api_idx == MOD_PPU_V1_API_IDX_IDLE_STATS) {
+        *api = &idle_stats_api;
+        return FWK_SUCCESS;
+    }
+
     if (api_idx != MOD_PPU_V1_API_IDX_POWER_DOMAIN_DRIVER)
         return FWK_E_SUPPORT;
 
@@ -872,6 +1131,18 @@ static int ppu_v1_process_bind_request(fwk_id_t source_id,
     switch (pd_ctx->config->pd_type) {
     case MOD_PD_TYPE_CORE:
         if (is_power_domain_module) {
+            /*
+             * The power domain module does not see the idle transitions of
+             * a core idling autonomously and must read its state from the
+             * PPU.
+             */
+            bound_config = fwk_module_get_data(source_id);
+            if (pd_ctx->config->autonomous_idle &&
+                !bound_config->externally_controlled) {
+                fwk_unexpected();
+                return FWK_E_PARAM;
+            }
+
             *api = &core_pd_driver;
             pd_ctx->bound_id = source_id;
             return FWK_SUCCESS;
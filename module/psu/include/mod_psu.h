@@ -33,6 +33,20 @@
  *      response API](::mod_psu_driver_response_api), which allows power supply
  *      units to pend requests and respond on-demand.
  *
+ *      A power supply unit may also be given a ramp model, see
+ *      ::mod_psu_element_cfg::slew_rate_mv_per_ms. The voltage changes and the
+ *      enabling of the supply then only complete once the output has had the
+ *      time to ramp and to settle, as timed by an alarm, rather than when the
+ *      driver has accepted the request.
+ *
+ *      The module caches the last voltage and enabled state set or read for
+ *      every device, and answers the ::mod_psu_device_api::get_voltage and
+ *      ::mod_psu_device_api::get_enabled calls from this cache once it holds
+ *      them. Only the firmware itself is expected to change the state of the
+ *      power supplies. When the firmware includes notifications, a
+ *      ::mod_psu_notification_id_state_changed notification is sent whenever
+ *      a request changes the voltage or the enabled state of a device.
+ *
  * \{
  */
 
@@ -109,6 +123,49 @@ enum mod_psu_event_idx {
     MOD_PSU_EVENT_IDX_COUNT,
 };
 
+/*!
+ * \brief Notification indices.
+ */
+enum mod_psu_notification_idx {
+    /*!
+     * \brief The voltage or the enabled state of a device has changed.
+     *
+     * \note This notification uses the ::mod_psu_notification_params
+     *      structure as its parameters. Its source is the device.
+     */
+    MOD_PSU_NOTIFICATION_IDX_STATE_CHANGED,
+
+    /*!
+     * \brief Number of defined notifications.
+     */
+    MOD_PSU_NOTIFICATION_IDX_COUNT,
+};
+
+/*!
+ * \brief State changed notification parameters.
+ */
+struct mod_psu_notification_params {
+    /*!
+     * \brief Voltage of the device in millivolts (mV), zero if not known.
+     */
+    uint32_t voltage;
+
+    /*!
+     * \brief `true` if the device is enabled, `false` if it is disabled or
+     *      its state is not known.
+     */
+    bool enabled;
+};
+
+/*!
+ * \brief Identifier of the ::MOD_PSU_NOTIFICATION_IDX_STATE_CHANGED
+ *      notification.
+ */
+static const fwk_id_t mod_psu_notification_id_state_changed =
+    FWK_ID_NOTIFICATION_INIT(
+        FWK_MODULE_IDX_PSU,
+        MOD_PSU_NOTIFICATION_IDX_STATE_CHANGED);
+
 /*!
  * \brief Device API.
  *
@@ -420,6 +477,35 @@ struct mod_psu_element_cfg {
      *      ::mod_psu_driver_api.
      */
     fwk_id_t driver_api_id;
+
+    /*!
+     * \brief Slew rate of the output voltage, in millivolts per millisecond.
+     *
+     * \details When either the slew rate or the settling time is not zero, a
+     *      voltage change completes once the output has ramped from the last
+     *      known voltage to the new one, at this rate, and has settled. When
+     *      the last voltage is not known, the ramp is timed from 0 mV. When
+     *      the slew rate is zero, the output is assumed to change instantly.
+     *
+     *      Leave both fields to zero for drivers that complete the requests
+     *      once the output is stable themselves.
+     */
+    uint32_t slew_rate_mv_per_ms;
+
+    /*!
+     * \brief Time for the output to settle at the end of a ramp, in
+     *      microseconds.
+     */
+    uint32_t settle_time_us;
+
+    /*!
+     * \brief Identifier of the alarm timing the ramps.
+     *
+     * \details Only used when the device has a ramp model, see
+     *      ::mod_psu_element_cfg::slew_rate_mv_per_ms. The firmware must then
+     *      include the timer module.
+     */
+    fwk_id_t alarm_id;
 };
 
 /*!
@@ -7,6 +7,10 @@
 
 #include <mod_psu.h>
 
+#ifdef BUILD_HAS_MOD_TIMER
+#    include <mod_timer.h>
+#endif
+
 #include <fwk_assert.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
@@ -16,17 +20,31 @@
 #include <fwk_status.h>
 #include <fwk_thread.h>
 
+#ifdef BUILD_HAS_NOTIFICATION
+#    include <fwk_notification.h>
+#endif
+
 #include <string.h>
 
 enum mod_psu_state {
     MOD_PSU_STATE_IDLE,
     MOD_PSU_STATE_BUSY,
+    MOD_PSU_STATE_SETTLING,
 };
 
 struct mod_psu_operation {
     enum mod_psu_state state;
 
     unsigned int cookie;
+
+    /* Time to wait for the output to settle once the driver has completed */
+    uint32_t ramp_ms;
+
+    /* Voltage requested, for voltage changes */
+    uint32_t voltage;
+
+    /* State requested, for enabled state changes */
+    bool enabled;
 };
 
 enum mod_psu_impl_event_idx {
@@ -42,10 +60,26 @@ static struct mod_psu_ctx {
     struct mod_psu_element_ctx {
         const struct mod_psu_driver_api *driver;
 
+#ifdef BUILD_HAS_MOD_TIMER
+        const struct mod_timer_alarm_api *alarm_api;
+#endif
+
         struct mod_psu_operation op;
+
+        /* Last voltage set or read, zero if unknown */
+        uint32_t voltage;
+        bool voltage_cached;
+
+        /* Last enabled state set or read */
+        bool enabled;
+        bool enabled_cached;
     } *elements;
 } mod_psu_ctx;
 
+static void mod_psu_respond(
+    fwk_id_t element_id,
+    struct mod_psu_driver_response response);
+
 static struct mod_psu_element_ctx *mod_psu_get_element_ctx(fwk_id_t element_id)
 {
     unsigned int element_idx = fwk_id_get_element_idx(element_id);
@@ -70,6 +104,148 @@ static int mod_psu_get_cfg_ctx(
     return FWK_SUCCESS;
 }
 
+static void mod_psu_notify_state_changed(
+    fwk_id_t element_id,
+    const struct mod_psu_element_ctx *ctx)
+{
+#ifdef BUILD_HAS_NOTIFICATION
+    unsigned int notifications_sent;
+    struct mod_psu_notification_params *params;
+    struct fwk_event notification = {
+        .id = mod_psu_notification_id_state_changed,
+        .source_id = element_id,
+    };
+
+    params = (struct mod_psu_notification_params *)notification.params;
+    params->voltage = ctx->voltage;
+    params->enabled = ctx->enabled;
+
+    (void)fwk_notification_notify(&notification, &notifications_sent);
+#endif
+}
+
+/*
+ * Cache the voltage of a device. A voltage set, rather than read, that changes
+ * the voltage is notified.
+ */
+static void mod_psu_cache_voltage(
+    fwk_id_t element_id,
+    struct mod_psu_element_ctx *ctx,
+    uint32_t voltage,
+    bool set)
+{
+    bool changed = !ctx->voltage_cached || (ctx->voltage != voltage);
+
+    ctx->voltage = voltage;
+    ctx->voltage_cached = true;
+
+    if (set && changed)
+        mod_psu_notify_state_changed(element_id, ctx);
+}
+
+/*
+ * Cache the enabled state of a device. A state set, rather than read, that
+ * changes the state is notified.
+ */
+static void mod_psu_cache_enabled(
+    fwk_id_t element_id,
+    struct mod_psu_element_ctx *ctx,
+    bool enabled,
+    bool set)
+{
+    bool changed = !ctx->enabled_cached || (ctx->enabled != enabled);
+
+    ctx->enabled = enabled;
+    ctx->enabled_cached = true;
+
+    if (set && changed)
+        mod_psu_notify_state_changed(element_id, ctx);
+}
+
+static bool mod_psu_has_ramp(const struct mod_psu_element_cfg *cfg)
+{
+    return (cfg->slew_rate_mv_per_ms != 0) || (cfg->settle_time_us != 0);
+}
+
+/*
+ * Time, in milliseconds, for the output to ramp between two voltages and to
+ * settle.
+ */
+static uint32_t mod_psu_ramp_time(
+    const struct mod_psu_element_cfg *cfg,
+    uint32_t from,
+    uint32_t to)
+{
+    uint32_t delta = (to > from) ? (to - from) : (from - to);
+    uint64_t time_us = cfg->settle_time_us;
+
+    if (!mod_psu_has_ramp(cfg))
+        return 0;
+
+    if (cfg->slew_rate_mv_per_ms != 0) {
+        time_us += (((uint64_t)delta * 1000) + cfg->slew_rate_mv_per_ms - 1) /
+            cfg->slew_rate_mv_per_ms;
+    }
+
+    return (uint32_t)((time_us + 999) / 1000);
+}
+
+/*
+ * Queue the request event whose delayed response completes an operation of
+ * the driver and, if 'ramp_ms' is not zero, of the ramp that follows.
+ */
+static int mod_psu_pend(
+    fwk_id_t element_id,
+    struct mod_psu_element_ctx *ctx,
+    fwk_id_t event_id,
+    uint32_t ramp_ms)
+{
+    int status;
+    struct fwk_event request = {
+        .id = event_id,
+        .target_id = element_id,
+
+        .response_requested = true,
+    };
+
+    status = fwk_thread_put_event(&request);
+    if (status != FWK_SUCCESS)
+        return FWK_E_STATE;
+
+    ctx->op.state = MOD_PSU_STATE_BUSY;
+    ctx->op.ramp_ms = ramp_ms;
+
+    return FWK_PENDING;
+}
+
+/*
+ * Pend a set operation until the driver has completed it and, for the devices
+ * with a ramp model, until the output has settled. An operation the driver has
+ * completed synchronously is completed by a driver response straight away, so
+ * that the settling is handled in one place.
+ */
+static int mod_psu_pend_set(
+    fwk_id_t element_id,
+    struct mod_psu_element_ctx *ctx,
+    int status,
+    fwk_id_t event_id,
+    uint32_t ramp_ms)
+{
+    if ((status == FWK_SUCCESS) && (ramp_ms != 0)) {
+        status = mod_psu_pend(element_id, ctx, event_id, ramp_ms);
+        if (status == FWK_PENDING) {
+            mod_psu_respond(element_id, (struct mod_psu_driver_response){
+                .status = FWK_SUCCESS,
+            });
+        }
+    } else if (status == FWK_PENDING)
+        status = mod_psu_pend(element_id, ctx, event_id, ramp_ms);
+    else if (status != FWK_SUCCESS)
+        status = FWK_E_HANDLER;
+
+    return status;
+}
+
 static int mod_psu_get_enabled(fwk_id_t element_id, bool *enabled)
 {
     int status;
@@ -81,6 +257,13 @@ static int mod_psu_get_enabled(fwk_id_t element_id, bool *enabled)
     if (status != FWK_SUCCESS)
         goto exit;
 
+    /* The cache holds the state of the last completed request */
+    if (ctx->enabled_cached) {
+        *enabled = ctx->enabled;
+
+        goto exit;
+    }
+
     if (ctx->op.state != MOD_PSU_STATE_IDLE) {
         status = FWK_E_BUSY;
 
@@ -88,22 +271,12 @@ static int mod_psu_get_enabled(fwk_id_t element_id, bool *enabled)
     }
 
     status = ctx->driver->get_enabled(cfg->driver_id, enabled);
-    if (status == FWK_PENDING) {
-        struct fwk_event request = {
-            .id = mod_psu_event_id_get_enabled,
-            .target_id = element_id,
-
-            .response_requested = true,
-        };
-
-        status = fwk_thread_put_event(&request);
-        if (status == FWK_SUCCESS) {
-            ctx->op.state = MOD_PSU_STATE_BUSY;
-
-            status = FWK_PENDING;
-        } else
-            status = FWK_E_STATE;
-    } else if (status != FWK_SUCCESS)
+    if (status == FWK_PENDING)
+        status =
+            mod_psu_pend(element_id, ctx, mod_psu_event_id_get_enabled, 0);
+    else if (status == FWK_SUCCESS)
+        mod_psu_cache_enabled(element_id, ctx, *enabled, false);
+    else
         status = FWK_E_HANDLER;
 
 exit:
@@ -113,6 +286,7 @@ exit:
 static int mod_psu_set_enabled(fwk_id_t element_id, bool enabled)
 {
     int status;
+    uint32_t ramp_ms;
 
     const struct mod_psu_element_cfg *cfg;
     struct mod_psu_element_ctx *ctx;
@@ -127,24 +301,14 @@ static int mod_psu_set_enabled(fwk_id_t element_id, bool enabled)
         goto exit;
     }
 
-    status = ctx->driver->set_enabled(cfg->driver_id, enabled);
-    if (status == FWK_PENDING) {
-        struct fwk_event request = {
-            .id = mod_psu_event_id_set_enabled,
-            .target_id = element_id,
-
-            .response_requested = true,
-        };
-
-        status = fwk_thread_put_event(&request);
-        if (status == FWK_SUCCESS) {
-            ctx->op.state = MOD_PSU_STATE_BUSY;
+    ramp_ms = enabled ? mod_psu_ramp_time(cfg, 0, ctx->voltage) : 0;
+    ctx->op.enabled = enabled;
 
-            status = FWK_PENDING;
-        } else
-            status = FWK_E_STATE;
-    } else if (status != FWK_SUCCESS)
-        status = FWK_E_HANDLER;
+    status = ctx->driver->set_enabled(cfg->driver_id, enabled);
+    status = mod_psu_pend_set(
+        element_id, ctx, status, mod_psu_event_id_set_enabled, ramp_ms);
+    if (status == FWK_SUCCESS)
+        mod_psu_cache_enabled(element_id, ctx, enabled, true);
 
 exit:
     return status;
@@ -161,6 +325,13 @@ static int mod_psu_get_voltage(fwk_id_t element_id, uint32_t *voltage)
     if (status != FWK_SUCCESS)
         goto exit;
 
+    /* The cache holds the voltage of the last completed request */
+    if (ctx->voltage_cached) {
+        *voltage = ctx->voltage;
+
+        goto exit;
+    }
+
     if (ctx->op.state != MOD_PSU_STATE_IDLE) {
         status = FWK_E_BUSY;
 
@@ -168,22 +339,12 @@ static int mod_psu_get_voltage(fwk_id_t element_id, uint32_t *voltage)
     }
 
     status = ctx->driver->get_voltage(cfg->driver_id, voltage);
-    if (status == FWK_PENDING) {
-        struct fwk_event request = {
-            .id = mod_psu_event_id_get_voltage,
-            .target_id = element_id,
-
-            .response_requested = true,
-        };
-
-        status = fwk_thread_put_event(&request);
-        if (status == FWK_SUCCESS) {
-            ctx->op.state = MOD_PSU_STATE_BUSY;
-
-            status = FWK_PENDING;
-        } else
-            status = FWK_E_STATE;
-    } else if (status != FWK_SUCCESS)
+    if (status == FWK_PENDING)
+        status =
+            mod_psu_pend(element_id, ctx, mod_psu_event_id_get_voltage, 0);
+    else if (status == FWK_SUCCESS)
+        mod_psu_cache_voltage(element_id, ctx, *voltage, false);
+    else
         status = FWK_E_HANDLER;
 
 exit:
@@ -193,6 +354,7 @@ exit:
 static int mod_psu_set_voltage(fwk_id_t element_id, uint32_t voltage)
 {
     int status;
+    uint32_t ramp_ms;
 
     const struct mod_psu_element_cfg *cfg;
     struct mod_psu_element_ctx *ctx;
@@ -207,24 +369,14 @@ static int mod_psu_set_voltage(fwk_id_t element_id, uint32_t voltage)
         goto exit;
     }
 
-    status = ctx->driver->set_voltage(cfg->driver_id, voltage);
-    if (status == FWK_PENDING) {
-        struct fwk_event request = {
-            .id = mod_psu_event_id_set_voltage,
-            .target_id = element_id,
-
-            .response_requested = true,
-        };
-
-        status = fwk_thread_put_event(&request);
-        if (status == FWK_SUCCESS) {
-            ctx->op.state = MOD_PSU_STATE_BUSY;
+    ramp_ms = mod_psu_ramp_time(cfg, ctx->voltage, voltage);
+    ctx->op.voltage = voltage;
 
-            status = FWK_PENDING;
-        } else
-            status = FWK_E_STATE;
-    } else if (status != FWK_SUCCESS)
-        status = FWK_E_HANDLER;
+    status = ctx->driver->set_voltage(cfg->driver_id, voltage);
+    status = mod_psu_pend_set(
+        element_id, ctx, status, mod_psu_event_id_set_voltage, ramp_ms);
+    if (status == FWK_SUCCESS)
+        mod_psu_cache_voltage(element_id, ctx, voltage, true);
 
 exit:
     return status;
@@ -270,6 +422,43 @@ static const struct mod_psu_driver_response_api mod_psu_driver_response_api = {
     .respond = mod_psu_respond,
 };
 
+#ifdef BUILD_HAS_MOD_TIMER
+static void mod_psu_alarm_callback(uintptr_t param)
+{
+    mod_psu_respond(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_PSU, param),
+        (struct mod_psu_driver_response){
+            .status = FWK_SUCCESS,
+        });
+}
+#endif
+
+/* Wait for the output to settle once the driver has completed the request */
+static int mod_psu_start_settling(
+    fwk_id_t element_id,
+    const struct mod_psu_element_cfg *cfg,
+    struct mod_psu_element_ctx *ctx)
+{
+#ifdef BUILD_HAS_MOD_TIMER
+    int status;
+
+    status = ctx->alarm_api->start(
+        cfg->alarm_id,
+        ctx->op.ramp_ms,
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        mod_psu_alarm_callback,
+        (uintptr_t)fwk_id_get_element_idx(element_id));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->op.state = MOD_PSU_STATE_SETTLING;
+
+    return FWK_SUCCESS;
+#else
+    return FWK_E_SUPPORT;
+#endif
+}
+
 static int mod_psu_init(
     fwk_id_t module_id,
     unsigned int element_count,
@@ -289,9 +478,18 @@ static int mod_psu_element_init(
     const void *data)
 {
     struct mod_psu_element_ctx *ctx;
+    const struct mod_psu_element_cfg *cfg = data;
 
     fwk_check(sub_element_count == 0);
 
+#ifndef BUILD_HAS_MOD_TIMER
+    /* The ramps are timed with an alarm */
+    if (mod_psu_has_ramp(cfg))
+        return FWK_E_DATA;
+#else
+    (void)cfg;
+#endif
+
     ctx = mod_psu_get_element_ctx(element_id);
 
     *ctx = (struct mod_psu_element_ctx){
@@ -325,7 +523,16 @@ static int mod_psu_bind_element(fwk_id_t element_id, unsigned int round)
         (ctx->driver->set_voltage == NULL) ||
         (ctx->driver->get_voltage == NULL)) {
         status = FWK_E_PANIC;
+
+        goto exit;
+    }
+
+#ifdef BUILD_HAS_MOD_TIMER
+    if (mod_psu_has_ramp(cfg)) {
+        status = fwk_module_bind(
+            cfg->alarm_id, MOD_TIMER_API_ID_ALARM, &ctx->alarm_api);
     }
+#endif
 
 exit:
     return status;
@@ -368,6 +575,7 @@ static int mod_psu_process_event(
     struct fwk_event *resp_event)
 {
     int status = FWK_SUCCESS;
+    int op_status;
 
     struct fwk_event hal_event;
 
@@ -398,6 +606,18 @@ static int mod_psu_process_event(
         break;
 
     case MOD_PSU_IMPL_EVENT_IDX_RESPONSE:
+        op_status = params->status;
+
+        if ((ctx->op.state == MOD_PSU_STATE_BUSY) &&
+            (ctx->op.ramp_ms != 0) && (op_status == FWK_SUCCESS)) {
+            /* The driver has completed, wait for the output to settle */
+            status = mod_psu_start_settling(event->target_id, cfg, ctx);
+            if (status == FWK_SUCCESS)
+                break;
+
+            op_status = FWK_E_HANDLER;
+        }
+
         ctx->op.state = MOD_PSU_STATE_IDLE;
 
         status = fwk_thread_get_delayed_response(
@@ -408,17 +628,41 @@ static int mod_psu_process_event(
             return status;
 
         *hal_params = (struct mod_psu_response){
-            .status = params->status,
+            .status = op_status,
         };
 
         switch (fwk_id_get_event_idx(hal_event.id)) {
         case MOD_PSU_EVENT_IDX_GET_ENABLED:
             hal_params->enabled = params->enabled;
+            if (op_status == FWK_SUCCESS) {
+                mod_psu_cache_enabled(
+                    event->target_id, ctx, params->enabled, false);
+            }
 
             break;
 
         case MOD_PSU_EVENT_IDX_GET_VOLTAGE:
             hal_params->voltage = params->voltage;
+            if (op_status == FWK_SUCCESS) {
+                mod_psu_cache_voltage(
+                    event->target_id, ctx, params->voltage, false);
+            }
+
+            break;
+
+        case MOD_PSU_EVENT_IDX_SET_ENABLED:
+            if (op_status == FWK_SUCCESS) {
+                mod_psu_cache_enabled(
+                    event->target_id, ctx, ctx->op.enabled, true);
+            }
+
+            break;
+
+        case MOD_PSU_EVENT_IDX_SET_VOLTAGE:
+            if (op_status == FWK_SUCCESS) {
+                mod_psu_cache_voltage(
+                    event->target_id, ctx, ctx->op.voltage, true);
+            }
 
             break;
 
@@ -451,4 +695,8 @@ const struct fwk_module module_psu = {
 
     .event_count = MOD_PSU_IMPL_EVENT_IDX_COUNT,
     .process_event = mod_psu_process_event,
+
+#ifdef BUILD_HAS_NOTIFICATION
+    .notification_count = MOD_PSU_NOTIFICATION_IDX_COUNT,
+#endif
 };
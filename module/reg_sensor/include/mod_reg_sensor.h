@@ -21,6 +21,9 @@
  * \defgroup GroupModuleRegSensor Register Sensor Driver
  *
  * \brief Driver for simple, register-based sensors.
+ *
+ * \details The registers of consecutive elements can be grouped in banks,
+ *      read in a single pass through ::mod_sensor_driver_api::get_values.
  * \{
  */
 
@@ -33,6 +36,36 @@ struct mod_reg_sensor_dev_config {
     struct mod_sensor_info *info;
 };
 
+/*!
+ * \brief Bank configuration.
+ *
+ * \details Where the hardware has a latch or freeze bit for the registers of
+ *      the bank, it is set while the bank is read so that the values of all
+ *      the registers are sampled at the same time.
+ */
+struct mod_reg_sensor_bank_config {
+    /*! Index of the first element of the bank */
+    unsigned int first_element_idx;
+
+    /*! Number of elements of the bank, consecutive from the first one */
+    unsigned int element_count;
+
+    /*! Address of the latch register, or 0 if the bank has none */
+    uintptr_t latch_reg;
+
+    /*! Bits set in the latch register while the bank is read */
+    uint32_t latch_mask;
+};
+
+/*! \brief Module configuration, optional */
+struct mod_reg_sensor_config {
+    /*! Table of the banks */
+    const struct mod_reg_sensor_bank_config *banks;
+
+    /*! Number of banks */
+    unsigned int bank_count;
+};
+
 /*!
  * \}
  */
@@ -18,6 +18,26 @@
 #include <stdint.h>
 
 static struct mod_reg_sensor_dev_config **config_table;
+static unsigned int config_count;
+static const struct mod_reg_sensor_config *module_config;
+
+static const struct mod_reg_sensor_bank_config *get_bank(unsigned int idx)
+{
+    const struct mod_reg_sensor_bank_config *bank;
+    unsigned int i;
+
+    if (module_config == NULL)
+        return NULL;
+
+    for (i = 0; i < module_config->bank_count; i++) {
+        bank = &module_config->banks[i];
+        if ((idx >= bank->first_element_idx) &&
+            ((idx - bank->first_element_idx) < bank->element_count))
+            return bank;
+    }
+
+    return NULL;
+}
 
 /*
  * Module API
@@ -53,8 +73,45 @@ static int get_info(fwk_id_t id, struct mod_sensor_info *info)
     return FWK_SUCCESS;
 }
 
+/*
+ * Read the registers of consecutive elements in a single pass. When the first
+ * element belongs to a bank with a latch, the latch is held for the whole pass
+ * and the elements must all belong to that bank.
+ */
+static int get_values(fwk_id_t id, unsigned int count, uint64_t *values)
+{
+    const struct mod_reg_sensor_bank_config *bank;
+    volatile uint32_t *latch = NULL;
+    unsigned int first, i;
+
+    first = fwk_id_get_element_idx(id);
+
+    if ((values == NULL) || (count == 0) || (first >= config_count) ||
+        (count > (config_count - first)))
+        return FWK_E_PARAM;
+
+    bank = get_bank(first);
+    if ((bank != NULL) && (bank->latch_reg != 0)) {
+        if (count > (bank->element_count -
+                     (first - bank->first_element_idx)))
+            return FWK_E_RANGE;
+
+        latch = (volatile uint32_t *)bank->latch_reg;
+        *latch |= bank->latch_mask;
+    }
+
+    for (i = 0; i < count; i++)
+        values[i] = *(volatile uint64_t *)config_table[first + i]->reg;
+
+    if (latch != NULL)
+        *latch &= ~bank->latch_mask;
+
+    return FWK_SUCCESS;
+}
+
 static const struct mod_sensor_driver_api reg_sensor_api = {
     .get_value = get_value,
+    .get_values = get_values,
     .get_info = get_info,
 };
 
@@ -63,9 +120,24 @@ static const struct mod_sensor_driver_api reg_sensor_api = {
  */
 static int reg_sensor_init(fwk_id_t module_id,
                            unsigned int element_count,
-                           const void *unused)
+                           const void *data)
 {
+    const struct mod_reg_sensor_config *config = data;
+    unsigned int i;
+
+    if (config != NULL) {
+        for (i = 0; i < config->bank_count; i++) {
+            if ((config->banks[i].element_count == 0) ||
+                (config->banks[i].first_element_idx >= element_count) ||
+                (config->banks[i].element_count >
+                 (element_count - config->banks[i].first_element_idx)))
+                return FWK_E_DATA;
+        }
+    }
+
     config_table = fwk_mm_alloc(element_count, sizeof(*config_table));
+    config_count = element_count;
+    module_config = config;
 
     return FWK_SUCCESS;
 }
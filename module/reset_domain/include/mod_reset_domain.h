@@ -103,6 +103,17 @@ struct mod_reset_domain_config {
      *     for the status of an auto reset operation on a reset domain.
      */
     fwk_id_t notification_id;
+
+    /*!
+     * \brief Identifier of the timer device holding the lines of a group
+     *     reset.
+     *
+     * \details The lines of a group reset are held asserted for the longest
+     *     latency of the domains of the group, see
+     *     ::mod_reset_domain_api::set_reset_state_group. May be left unset if
+     *     no group reset needs a hold time.
+     */
+    fwk_id_t timer_id;
 };
 
 /*!
@@ -145,6 +156,34 @@ struct mod_reset_domain_api {
                            enum mod_reset_domain_mode mode,
                            uint32_t reset_state,
                            uintptr_t cookie);
+
+    /*!
+     * \brief Reset a group of domains together.
+     *
+     * \details The reset lines of all the domains are asserted, held for the
+     *     longest latency of the domains, and deasserted together. A single
+     *     ::mod_reset_domain_notification_id_group_reset notification is sent
+     *     for the whole group once the lines are deasserted.
+     *
+     *     Every domain of the group must support the explicit assert and
+     *     deassert modes, and must have a known latency.
+     *
+     * \param domain_mask Mask of the domains of the group, bit \c n standing
+     *     for the element of index \c n.
+     * \param reset_state Reset domain state as defined in SCMIv2 specification.
+     * \param cookie Context-specific value, passed to the drivers and in the
+     *     notification. The SCMI reset domain protocol reports it as the
+     *     identifier of the agent that caused the reset.
+     *
+     * \retval ::FWK_SUCCESS The domains were reset.
+     * \retval ::FWK_E_PARAM The mask is empty or holds an unknown domain.
+     * \retval ::FWK_E_SUPPORT A domain does not support group resets, or the
+     *     lines must be held and no timer is configured.
+     * \return One of the other FWK_E_* error codes if a driver failed.
+     */
+    int (*set_reset_state_group)(uint32_t domain_mask,
+                                 uint32_t reset_state,
+                                 uintptr_t cookie);
 };
 
 /*!
@@ -179,6 +218,11 @@ enum mod_reset_domain_notification_idx {
      */
     MOD_RESET_DOMAIN_NOTIFICATION_AUTORESET,
 
+    /*!
+     * \brief Group reset notification index.
+     */
+    MOD_RESET_DOMAIN_NOTIFICATION_GROUP_RESET,
+
     /*!
      * \brief Number of notifications available.
      */
@@ -208,6 +252,35 @@ struct mod_reset_domain_notification_event_params {
     uintptr_t cookie;
 };
 
+/*!
+ * \brief Identifier of the group reset notification.
+ */
+static const fwk_id_t mod_reset_domain_notification_id_group_reset =
+    FWK_ID_NOTIFICATION_INIT(FWK_MODULE_IDX_RESET_DOMAIN,
+                             MOD_RESET_DOMAIN_NOTIFICATION_GROUP_RESET);
+
+/*!
+ * \brief Reset domain group reset notification event parameters.
+ */
+struct mod_reset_domain_group_notification_event_params {
+    /*!
+     * \brief Mask of the domains that were reset, bit \c n standing for the
+     *     domain of index \c n.
+     */
+    uint32_t domain_mask;
+
+    /*!
+     * \brief Reset state as defined in SCMIv2 specification.
+     */
+    uint32_t reset_state;
+
+    /*!
+     * \brief Context-specific value which is passed in the
+     *     set_reset_state_group call.
+     */
+    uintptr_t cookie;
+};
+
 /*!
  * \brief Reset domain auto reset event parameters.
  */
@@ -12,8 +12,21 @@
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
+#include <fwk_status.h>
 #include <mod_reset_domain.h>
 
+#ifdef BUILD_HAS_MOD_TIMER
+#    include <mod_timer.h>
+#endif
+
+#include <stdint.h>
+
+/* Latency of a domain whose reset time is unknown */
+#define RESET_DOMAIN_LATENCY_UNKNOWN 0xFFFFFFFF
+
+/* Number of domains a group reset can address, one per bit of its mask */
+#define RESET_DOMAIN_GROUP_MAX 32
+
 /*
  * Module and devices contexts for Reset Domain
  */
@@ -29,6 +42,9 @@ struct mod_rd_ctx {
     const struct mod_reset_domain_config *config;
     struct rd_dev_ctx *dev_ctx_table;
     unsigned int dev_count;
+#ifdef BUILD_HAS_MOD_TIMER
+    const struct mod_timer_api *timer_api;
+#endif
 };
 
 /*
@@ -53,9 +69,129 @@ static int set_reset_state(fwk_id_t reset_dev_id,
                                                   mode, reset_state, cookie);
 }
 
+/*
+ * Set the reset lines of the domains of a group to the given mode, stopping at
+ * the first failure. The mask of the domains that were set is returned.
+ */
+static int set_group_mode(uint32_t domain_mask,
+                          enum mod_reset_domain_mode mode,
+                          uint32_t reset_state,
+                          uintptr_t cookie,
+                          uint32_t *done_mask)
+{
+    int status;
+    unsigned int i;
+    struct rd_dev_ctx *reset_ctx;
+
+    *done_mask = 0;
+
+    for (i = 0; i < RESET_DOMAIN_GROUP_MAX; i++) {
+        if ((domain_mask & (UINT32_C(1) << i)) == 0)
+            continue;
+
+        reset_ctx = &module_reset_ctx.dev_ctx_table[i];
+
+        status = reset_ctx->driver_api->set_reset_state(
+            reset_ctx->config->driver_id, mode, reset_state, cookie);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        *done_mask |= UINT32_C(1) << i;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int hold_group(unsigned int hold_us)
+{
+    if (hold_us == 0)
+        return FWK_SUCCESS;
+
+#ifdef BUILD_HAS_MOD_TIMER
+    if (module_reset_ctx.timer_api != NULL) {
+        return module_reset_ctx.timer_api->delay(
+            module_reset_ctx.config->timer_id, hold_us);
+    }
+#endif
+
+    return FWK_E_SUPPORT;
+}
+
+static int set_reset_state_group(uint32_t domain_mask,
+                                 uint32_t reset_state,
+                                 uintptr_t cookie)
+{
+    int status, deassert_status;
+    unsigned int i;
+    unsigned int hold_us = 0;
+    uint32_t asserted_mask, deasserted_mask;
+    const struct mod_reset_domain_dev_config *config;
+    const enum mod_reset_domain_mode explicit_modes =
+        MOD_RESET_DOMAIN_MODE_EXPLICIT_ASSERT |
+        MOD_RESET_DOMAIN_MODE_EXPLICIT_DEASSERT;
+    unsigned int notification_count;
+    struct fwk_event notification_event = {
+        .id = mod_reset_domain_notification_id_group_reset,
+        .source_id = fwk_module_id_reset_domain,
+    };
+    struct mod_reset_domain_group_notification_event_params *params =
+        (struct mod_reset_domain_group_notification_event_params *)
+        notification_event.params;
+
+    if ((domain_mask == 0) ||
+        ((module_reset_ctx.dev_count < RESET_DOMAIN_GROUP_MAX) &&
+         ((domain_mask >> module_reset_ctx.dev_count) != 0)))
+        return FWK_E_PARAM;
+
+    /* Check the whole group before any line is touched */
+    for (i = 0; i < RESET_DOMAIN_GROUP_MAX; i++) {
+        if ((domain_mask & (UINT32_C(1) << i)) == 0)
+            continue;
+
+        config = module_reset_ctx.dev_ctx_table[i].config;
+
+        if (((config->modes & explicit_modes) != explicit_modes) ||
+            (config->latency == RESET_DOMAIN_LATENCY_UNKNOWN))
+            return FWK_E_SUPPORT;
+
+        if (config->latency > hold_us)
+            hold_us = config->latency;
+    }
+
+#ifdef BUILD_HAS_MOD_TIMER
+    if ((hold_us != 0) && (module_reset_ctx.timer_api == NULL))
+        return FWK_E_SUPPORT;
+#else
+    if (hold_us != 0)
+        return FWK_E_SUPPORT;
+#endif
+
+    status = set_group_mode(domain_mask, MOD_RESET_DOMAIN_MODE_EXPLICIT_ASSERT,
+                            reset_state, cookie, &asserted_mask);
+    if (status == FWK_SUCCESS)
+        status = hold_group(hold_us);
+
+    /* Release the lines that were asserted, even if the reset failed */
+    deassert_status = set_group_mode(asserted_mask,
+                                     MOD_RESET_DOMAIN_MODE_EXPLICIT_DEASSERT,
+                                     reset_state, cookie, &deasserted_mask);
+    if (status == FWK_SUCCESS)
+        status = deassert_status;
+
+    if (status != FWK_SUCCESS)
+        return status;
+
+    params->domain_mask = domain_mask;
+    params->reset_state = reset_state;
+    params->cookie = cookie;
+
+    return fwk_notification_notify(&notification_event, &notification_count);
+}
+
 /* HAL API */
-static const struct mod_reset_domain_drv_api reset_api = {
+static const struct mod_reset_domain_api reset_api = {
     .set_reset_state = set_reset_state,
+    .set_reset_state_group = set_reset_state_group,
 };
 
 static int reset_issued_notify(fwk_id_t dev_id,
@@ -146,8 +282,17 @@ static int rd_bind(fwk_id_t id, unsigned int round)
     if (round != 0)
         return FWK_SUCCESS;
 
-    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
+#ifdef BUILD_HAS_MOD_TIMER
+        /* The timer is optional, it only holds the lines of group resets */
+        if ((module_reset_ctx.config != NULL) &&
+            fwk_module_is_valid_element_id(module_reset_ctx.config->timer_id))
+            return fwk_module_bind(module_reset_ctx.config->timer_id,
+                                   MOD_TIMER_API_ID_TIMER,
+                                   &module_reset_ctx.timer_api);
+#endif
         return FWK_SUCCESS;
+    }
 
     reset_ctx = module_reset_ctx.dev_ctx_table + fwk_id_get_element_idx(id);
 
@@ -20,8 +20,54 @@
 #include <fwk_status.h>
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <string.h>
 
+/* Number of standard SCMI protocols, from BASE to RESET_DOMAIN */
+#define RES_PERMS_PROTOCOL_COUNT \
+    (MOD_SCMI_PROTOCOL_ID_RESET_DOMAIN - MOD_SCMI_PROTOCOL_ID_BASE + 1)
+
+/* Number of message IDs covered by the permission summaries */
+#define RES_PERMS_MESSAGE_COUNT 32
+
+/*
+ * Per-protocol description of the resource permissions table.
+ */
+struct res_perms_protocol_table {
+    /* Resource permissions table, NULL if not managed */
+    mod_res_perms_t *perms;
+
+    /* First message ID managed in the table */
+    uint32_t message_first;
+
+    /* Number of messages managed in the table */
+    uint32_t message_count;
+
+    /* Number of resources for the protocol */
+    uint32_t resource_count;
+
+    /* Number of table elements per message */
+    uint32_t resource_size;
+};
+
+/*
+ * Permissions of an agent for a standard protocol, flattened at init so that
+ * the checks on the message path are bit tests indexed by the message ID.
+ */
+struct res_perms_summary {
+    /* Messages denied at the protocol or message level */
+    uint32_t message_denied;
+
+    /* Messages denied for all their resources */
+    uint32_t resource_denied;
+
+    /* Messages managed in the resource permissions table */
+    uint32_t resource_managed;
+
+    /* Managed messages with at least one resource denied */
+    uint32_t resource_restricted;
+};
+
 struct res_perms_ctx {
     /*! platform config data */
     struct mod_res_resource_perms_config *config;
@@ -75,6 +121,15 @@ struct res_perms_ctx {
      * device permissions for an agent is not supported.
      */
     struct mod_res_device *domain_devices;
+
+    /*! Resource permissions tables, indexed by standard protocol. */
+    struct res_perms_protocol_table protocol_tables[RES_PERMS_PROTOCOL_COUNT];
+
+    /*!
+     * Flattened permissions, indexed by agent and standard protocol. NULL if
+     * there is no permissions management.
+     */
+    struct res_perms_summary (*summaries)[RES_PERMS_PROTOCOL_COUNT];
 };
 
 struct res_perms_backup {
@@ -429,6 +484,272 @@ static int mod_res_resource_id_to_index(
     return FWK_SUCCESS;
 }
 
+/*
+ * Permission summaries
+ *
+ * The protocol and message permissions only come from the platform config
+ * and are folded into bitmaps once at init. The resource permissions may be
+ * changed at run-time, so only the messages which have at least one resource
+ * denied are tracked and the per-resource bit is read from the table itself.
+ */
+static bool res_perms_is_std_protocol(uint32_t protocol_id)
+{
+    return (protocol_id >= MOD_SCMI_PROTOCOL_ID_BASE) &&
+        (protocol_id <= MOD_SCMI_PROTOCOL_ID_RESET_DOMAIN);
+}
+
+static void res_perms_init_protocol_table(
+    uint32_t protocol_id,
+    mod_res_perms_t *perms,
+    uint32_t message_first,
+    uint32_t message_last,
+    uint32_t resource_count)
+{
+    struct res_perms_protocol_table *table;
+
+    table =
+        &res_perms_ctx.protocol_tables[protocol_id - MOD_SCMI_PROTOCOL_ID_BASE];
+    table->perms = perms;
+    table->message_first = message_first;
+    table->message_count = message_last - message_first + 1;
+    table->resource_count = resource_count;
+    table->resource_size = MOD_RES_PERMS_RESOURCE_ELEMENT(resource_count) + 1;
+}
+
+static void res_perms_init_protocol_tables(void)
+{
+    struct mod_res_agent_permission *perms = res_perms_ctx.agent_permissions;
+
+    res_perms_init_protocol_table(
+        MOD_SCMI_PROTOCOL_ID_POWER_DOMAIN,
+        perms->scmi_pd_perms,
+        MOD_SCMI_PD_POWER_DOMAIN_ATTRIBUTES,
+        MOD_SCMI_PD_POWER_STATE_NOTIFY,
+        res_perms_ctx.pd_count);
+
+    res_perms_init_protocol_table(
+        MOD_SCMI_PROTOCOL_ID_PERF,
+        perms->scmi_perf_perms,
+        MOD_SCMI_PERF_DOMAIN_ATTRIBUTES,
+        MOD_SCMI_PERF_DESCRIBE_FAST_CHANNEL,
+        res_perms_ctx.perf_count);
+
+    res_perms_init_protocol_table(
+        MOD_SCMI_PROTOCOL_ID_CLOCK,
+        perms->scmi_clock_perms,
+        MOD_SCMI_CLOCK_ATTRIBUTES,
+        MOD_SCMI_CLOCK_CONFIG_SET,
+        res_perms_ctx.clock_count);
+
+    res_perms_init_protocol_table(
+        MOD_SCMI_PROTOCOL_ID_SENSOR,
+        perms->scmi_sensor_perms,
+        MOD_SCMI_SENSOR_DESCRIPTION_GET,
+        MOD_SCMI_SENSOR_READING_GET,
+        res_perms_ctx.sensor_count);
+
+#ifdef BUILD_HAS_SCMI_RESET
+    res_perms_init_protocol_table(
+        MOD_SCMI_PROTOCOL_ID_RESET_DOMAIN,
+        perms->scmi_reset_domain_perms,
+        MOD_SCMI_RESET_DOMAIN_ATTRIBUTES,
+        MOD_SCMI_RESET_NOTIFY,
+        res_perms_ctx.reset_domain_count);
+#endif
+}
+
+/*
+ * Get the first element of the resource permissions of an agent for a
+ * message managed in the table.
+ */
+static mod_res_perms_t *res_perms_get_message_perms(
+    const struct res_perms_protocol_table *table,
+    uint32_t agent_idx,
+    uint32_t message_id)
+{
+    return &table->perms
+                [(agent_idx * table->message_count * table->resource_size) +
+                 ((message_id - table->message_first) * table->resource_size)];
+}
+
+static bool res_perms_message_is_restricted(
+    const struct res_perms_protocol_table *table,
+    uint32_t agent_idx,
+    uint32_t message_id)
+{
+    const mod_res_perms_t *perms;
+    uint32_t i;
+
+    perms = res_perms_get_message_perms(table, agent_idx, message_id);
+    for (i = 0; i < table->resource_size; i++) {
+        if (perms[i] != 0)
+            return true;
+    }
+
+    return false;
+}
+
+static void res_perms_update_message_summary(
+    uint32_t agent_idx,
+    uint32_t protocol_id,
+    uint32_t message_id)
+{
+    uint32_t protocol_idx = protocol_id - MOD_SCMI_PROTOCOL_ID_BASE;
+    const struct res_perms_protocol_table *table;
+    struct res_perms_summary *summary;
+
+    table = &res_perms_ctx.protocol_tables[protocol_idx];
+    summary = &res_perms_ctx.summaries[agent_idx][protocol_idx];
+
+    if ((summary->resource_managed & (1U << message_id)) == 0)
+        return;
+
+    if (res_perms_message_is_restricted(table, agent_idx, message_id))
+        summary->resource_restricted |= (1U << message_id);
+    else
+        summary->resource_restricted &= ~(1U << message_id);
+}
+
+static void res_perms_build_summary(uint32_t agent_idx, uint32_t protocol_idx)
+{
+    const struct mod_res_agent_permission *perms;
+    const struct res_perms_protocol_table *table;
+    struct res_perms_summary *summary;
+    uint32_t protocol_id = protocol_idx + MOD_SCMI_PROTOCOL_ID_BASE;
+    uint32_t message_id;
+    uint32_t bit;
+    int32_t message_idx;
+    int status;
+
+    perms = res_perms_ctx.agent_permissions;
+    table = &res_perms_ctx.protocol_tables[protocol_idx];
+    summary = &res_perms_ctx.summaries[agent_idx][protocol_idx];
+    *summary = (struct res_perms_summary){ 0 };
+
+    /* Agent:Protocol access denied */
+    if ((perms->agent_protocol_permissions != NULL) &&
+        ((protocol_idx >= res_perms_ctx.protocol_count) ||
+         (perms->agent_protocol_permissions[agent_idx].protocols &
+          (1 << protocol_idx))))
+        summary->message_denied = UINT32_MAX;
+
+    for (message_id = 0; message_id < RES_PERMS_MESSAGE_COUNT; message_id++) {
+        bit = 1U << message_id;
+
+        status =
+            mod_res_message_id_to_index(protocol_id, message_id, &message_idx);
+        if (status != FWK_SUCCESS) {
+            /* Unknown messages are only checked if messages are managed */
+            if (perms->agent_msg_permissions != NULL)
+                summary->message_denied |= bit;
+            summary->resource_denied |= bit;
+            continue;
+        }
+
+        if (message_idx < 0)
+            continue;
+
+        /* Agent:Protocol:message access denied */
+        if ((perms->agent_msg_permissions != NULL) &&
+            (perms->agent_msg_permissions[agent_idx].messages[protocol_idx] &
+             (1 << message_idx)))
+            summary->message_denied |= bit;
+
+        if ((protocol_id == MOD_SCMI_PROTOCOL_ID_BASE) ||
+            (protocol_id == MOD_SCMI_PROTOCOL_ID_SYS_POWER)) {
+            /* No per-resource management for these protocols */
+            summary->resource_denied |= bit;
+            continue;
+        }
+
+#ifndef BUILD_HAS_SCMI_RESET
+        if (protocol_id == MOD_SCMI_PROTOCOL_ID_RESET_DOMAIN) {
+            summary->resource_denied |= bit;
+            continue;
+        }
+#endif
+
+        if (table->perms == NULL)
+            continue;
+
+        summary->resource_managed |= bit;
+        if (res_perms_message_is_restricted(table, agent_idx, message_id))
+            summary->resource_restricted |= bit;
+    }
+
+    summary->resource_denied |= summary->message_denied;
+}
+
+static void res_perms_build_agent_summaries(uint32_t agent_idx)
+{
+    uint32_t protocol_idx;
+
+    for (protocol_idx = 0; protocol_idx < RES_PERMS_PROTOCOL_COUNT;
+         protocol_idx++)
+        res_perms_build_summary(agent_idx, protocol_idx);
+}
+
+/*
+ * Get the permission summary of an agent for a standard protocol. Returns
+ * NULL if the check has to go through the tables, eg. for platform-specific
+ * agent mappings.
+ */
+static const struct res_perms_summary *res_perms_get_summary(
+    uint32_t agent_id,
+    uint32_t protocol_id,
+    uint32_t message_id,
+    uint32_t *agent_idx)
+{
+    int status;
+
+    if ((res_perms_ctx.summaries == NULL) ||
+        !res_perms_is_std_protocol(protocol_id) ||
+        (message_id >= RES_PERMS_MESSAGE_COUNT))
+        return NULL;
+
+    status = mod_res_agent_id_to_index(agent_id, agent_idx);
+    if ((status != FWK_SUCCESS) || (*agent_idx >= res_perms_ctx.agent_count))
+        return NULL;
+
+    return &res_perms_ctx
+                .summaries[*agent_idx][protocol_id - MOD_SCMI_PROTOCOL_ID_BASE];
+}
+
+static enum mod_res_perms_permissions res_perms_summary_resource_permissions(
+    const struct res_perms_summary *summary,
+    uint32_t agent_idx,
+    uint32_t protocol_id,
+    uint32_t message_id,
+    uint32_t resource_id)
+{
+    const struct res_perms_protocol_table *table;
+    mod_res_perms_t perms;
+    uint32_t bit = 1U << message_id;
+
+    if (summary->resource_denied & bit)
+        return MOD_RES_PERMS_ACCESS_DENIED;
+
+    if ((summary->resource_managed & bit) == 0)
+        return MOD_RES_PERMS_ACCESS_ALLOWED;
+
+    table =
+        &res_perms_ctx.protocol_tables[protocol_id - MOD_SCMI_PROTOCOL_ID_BASE];
+    if (resource_id >= table->resource_count)
+        return MOD_RES_PERMS_ACCESS_DENIED;
+
+    if ((summary->resource_restricted & bit) == 0)
+        return MOD_RES_PERMS_ACCESS_ALLOWED;
+
+    perms = res_perms_get_message_perms(table, agent_idx, message_id)
+        [MOD_RES_PERMS_RESOURCE_ELEMENT(resource_id)];
+
+    /* Agent:Protocol:message:resource access denied */
+    if (perms & (1 << (MOD_RES_PERMS_RESOURCE_BIT(resource_id))))
+        return MOD_RES_PERMS_ACCESS_DENIED;
+
+    return MOD_RES_PERMS_ACCESS_ALLOWED;
+}
+
 /*
  * Check whether an agent has access to a protocol.
  *
@@ -509,6 +830,7 @@ static enum mod_res_perms_permissions agent_message_permissions(
     uint32_t protocol_id,
     uint32_t message_id)
 {
+    const struct res_perms_summary *summary;
     enum mod_res_perms_permissions protocol_perms;
     uint32_t agent_idx;
     uint32_t protocol_idx;
@@ -525,6 +847,15 @@ static enum mod_res_perms_permissions agent_message_permissions(
         return mod_res_plat_agent_message_permissions(
             agent_id, protocol_id, message_id);
 
+    summary = res_perms_get_summary(agent_id, protocol_id, message_id,
+        &agent_idx);
+    if (summary != NULL) {
+        if (summary->message_denied & (1U << message_id))
+            return MOD_RES_PERMS_ACCESS_DENIED;
+
+        return MOD_RES_PERMS_ACCESS_ALLOWED;
+    }
+
     /* Agent:Protocol access denied */
     protocol_perms = agent_protocol_permissions(agent_id, protocol_id);
     if (protocol_perms == MOD_RES_PERMS_ACCESS_DENIED)
@@ -582,6 +913,7 @@ static enum mod_res_perms_permissions agent_resource_permissions(
     uint32_t message_id,
     uint32_t resource_id)
 {
+    const struct res_perms_summary *summary;
     enum mod_res_perms_permissions message_perms;
     uint32_t agent_idx;
     int32_t message_idx;
@@ -598,6 +930,12 @@ static enum mod_res_perms_permissions agent_resource_permissions(
         return mod_res_plat_agent_resource_permissions(
             agent_id, protocol_id, message_id, resource_id);
 
+    summary = res_perms_get_summary(agent_id, protocol_id, message_id,
+        &agent_idx);
+    if (summary != NULL)
+        return res_perms_summary_resource_permissions(
+            summary, agent_idx, protocol_id, message_id, resource_id);
+
     /* Agent:Protocol:command access denied */
     message_perms =
         agent_message_permissions(agent_id, protocol_id, message_id);
@@ -696,6 +1034,7 @@ static int set_agent_resource_message_perms(
 {
     int status;
     int32_t resource_idx;
+    uint32_t agent_idx;
     mod_res_perms_t permissions;
 
     status = mod_res_resource_id_to_index(
@@ -716,6 +1055,11 @@ static int set_agent_resource_message_perms(
 
     perms[resource_idx] = permissions;
 
+    status = mod_res_agent_id_to_index(agent_id, &agent_idx);
+    if ((res_perms_ctx.summaries != NULL) && (status == FWK_SUCCESS) &&
+        (agent_idx < res_perms_ctx.agent_count))
+        res_perms_update_message_summary(agent_idx, protocol_id, message_idx);
+
     return FWK_SUCCESS;
 }
 
@@ -1214,6 +1558,9 @@ static void mod_res_agent_copy_config(
 
 static int mod_res_agent_reset_config(uint32_t agent_id, uint32_t flags)
 {
+    uint32_t agent_idx;
+    int status;
+
     /* No device permissons */
     if ((res_perms_ctx.device_count == 0) ||
         (res_perms_ctx.domain_devices == NULL))
@@ -1267,6 +1614,11 @@ static int mod_res_agent_reset_config(uint32_t agent_id, uint32_t flags)
     }
 #endif
 
+    status = mod_res_agent_id_to_index(agent_id, &agent_idx);
+    if ((res_perms_ctx.summaries != NULL) && (status == FWK_SUCCESS) &&
+        (agent_idx < res_perms_ctx.agent_count))
+        res_perms_build_agent_summaries(agent_idx);
+
     return FWK_SUCCESS;
 }
 
@@ -1305,6 +1657,7 @@ static int mod_res_perms_resources_init(
     const void *data)
 {
     struct mod_res_resource_perms_config *config;
+    uint32_t agent_idx;
 
     config = (struct mod_res_resource_perms_config *)data;
     if (config->agent_permissions != 0x0) {
@@ -1322,6 +1675,17 @@ static int mod_res_perms_resources_init(
 #endif
         res_perms_ctx.domain_devices =
             (struct mod_res_device *)config->domain_devices;
+
+        res_perms_init_protocol_tables();
+
+        if (res_perms_ctx.agent_count != 0) {
+            res_perms_ctx.summaries = fwk_mm_calloc(
+                res_perms_ctx.agent_count, sizeof(*res_perms_ctx.summaries));
+
+            for (agent_idx = 0; agent_idx < res_perms_ctx.agent_count;
+                 agent_idx++)
+                res_perms_build_agent_summaries(agent_idx);
+        }
     }
     res_perms_ctx.config = config;
     return FWK_SUCCESS;
@@ -15,7 +15,9 @@
 #include <mod_scmi_header.h>
 
 #include <fwk_id.h>
+#include <fwk_time.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -46,6 +48,11 @@ struct scmi_service_ctx {
     int (*transmit)(fwk_id_t transport_id, uint32_t message_header,
         const void *payload, size_t size);
 
+#ifndef BUILD_HAS_RESOURCE_PERMISSIONS
+    /* The agent of the service is a PSCI agent */
+    bool is_psci_agent;
+#endif
+
     /* SCMI message token, used by the agent to identify individual messages */
     uint16_t scmi_token;
 
@@ -57,6 +64,24 @@ struct scmi_service_ctx {
 
     /* SCMI type of the message currently being processed */
     enum mod_scmi_message_type scmi_message_type;
+
+    /* A message signaled by the transport is waiting to be scheduled */
+    bool pending;
+
+    /* Time at which the pending message was signaled */
+    fwk_timestamp_t pending_timestamp;
+
+    /* Telemetry entry of the message being processed, if any */
+    struct mod_scmi_telemetry_entry *telemetry_entry;
+
+    /* Time at which the message being processed was signaled */
+    fwk_timestamp_t message_timestamp;
+
+    /* Capture record of the message being processed, if any */
+    struct mod_scmi_capture_record *capture_record;
+
+    /* Sequence number of the capture record of the message being processed */
+    uint32_t capture_sequence;
 };
 
 #endif /* MOD_INTERNAL_SCMI_H */
@@ -16,6 +16,7 @@
 
 #include <fwk_id.h>
 #include <fwk_module_idx.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 #include <stddef.h>
@@ -40,6 +41,8 @@ enum mod_scmi_api_idx {
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
     MOD_SCMI_API_IDX_NOTIFICATION,
 #endif
+    MOD_SCMI_API_IDX_TELEMETRY,
+    MOD_SCMI_API_IDX_CAPTURE,
     MOD_SCMI_API_IDX_COUNT,
 };
 
@@ -61,6 +64,43 @@ struct mod_scmi_agent {
      *       in the system will be provided with a truncated version of it.
      */
     const char *name;
+
+    /*!
+     *  \brief Scheduling weight of the agent.
+     *
+     *  \details When messages from several agents are pending, each agent is
+     *       serviced in proportion to its weight. A weight of zero is treated
+     *       as a weight of one.
+     */
+    unsigned int weight;
+
+    /*!
+     *  \brief Scheduling deadline of the messages of the agent, in
+     *       microseconds.
+     *
+     *  \details A message pending for longer than the deadline of its agent is
+     *       serviced before the messages whose deadline has not expired,
+     *       regardless of the weights. Zero disables the deadline.
+     */
+    fwk_duration_us_t deadline;
+};
+
+/*!
+ * \brief Message handled in the fast lane.
+ *
+ * \details A message in the fast lane is handled as soon as the transport
+ *      signals it, in a framework signal, instead of waiting for its turn in
+ *      the message scheduler and the framework event queue.
+ */
+struct mod_scmi_fast_message {
+    /*! Identifier of the agent sending the message */
+    unsigned int agent_id;
+
+    /*! Identifier of the protocol of the message */
+    uint8_t protocol_id;
+
+    /*! Identifier of the message */
+    uint8_t message_id;
 };
 
 /*!
@@ -123,6 +163,62 @@ struct mod_scmi_config {
      *       if it exceeds this limit.
      */
     const char *sub_vendor_identifier;
+
+    /*!
+     *  \brief Number of entries of the message telemetry table.
+     *
+     *  \details Each entry aggregates the statistics of one message of one
+     *       protocol for one agent, see ::mod_scmi_telemetry_entry. Entries are
+     *       allocated as the messages are first received, and messages
+     *       received once the table is full are not accounted for. Only the
+     *       messages of the supported protocols with an identifier below 0x20
+     *       are accounted for. Zero disables the telemetry.
+     */
+    unsigned int telemetry_entry_count;
+
+    /*!
+     *  \brief Table of the messages handled in the fast lane. This pointer may
+     *       be equal to NULL when the table is empty.
+     *
+     *  \details Only the messages whose handler completes quickly and without
+     *       waiting for another entity should be listed, e.g. the
+     *       POWER_STATE_SET messages of the PSCI agent for the core power
+     *       domains. Signals being processed before any event, a slow
+     *       handler delays every other message.
+     */
+    const struct mod_scmi_fast_message *fast_message_table;
+
+    /*! Number of entries of the fast message table */
+    unsigned int fast_message_count;
+
+    /*!
+     *  \brief Number of records of the message capture, a power of two.
+     *
+     *  \details Every message received is recorded in the capture, see
+     *       ::mod_scmi_capture_header, overwriting the oldest record once the
+     *       capture is full. Zero disables the capture.
+     */
+    unsigned int capture_record_count;
+
+    /*!
+     *  \brief Number of bytes of the payload of a message kept in its
+     *       record, a multiple of four.
+     *
+     *  \details Longer payloads are truncated. Only the messages whose payload
+     *       was kept whole can be replayed, the hash of the payload being
+     *       recorded for the others. Zero only keeps the hash.
+     */
+    size_t capture_payload_size;
+
+    /*!
+     *  \brief Address of the message capture, or zero to allocate it from the
+     *       heap.
+     *
+     *  \details The capture may be placed in memory the platform exports, e.g.
+     *       in a region reported through SDS. The region must hold
+     *       ::mod_scmi_capture_size() bytes.
+     */
+    uintptr_t capture_address;
 };
 
 /*!
@@ -472,6 +568,31 @@ struct mod_scmi_notification_api {
         unsigned int scmi_response_message_id,
         void *payload_p2a,
         size_t payload_size);
+
+    /*!
+     * \brief Notify a single agent if it requested a specific notification.
+     *
+     * \param protocol_id Identifier of the protocol.
+     * \param operation_id Identifier of the operation.
+     * \param scmi_response_message_id SCMI message identifier that is sent as
+     *     as a part of the notification.
+     * \param agent_idx Index of the agent within specified protocol context.
+     * \param payload_p2a Notification message payload from platform to
+     *     agent.
+     * \param payload_size Size of the message.
+     *
+     * \retval ::FWK_SUCCESS The agent was notified, or it did not request the
+     *     notification.
+     * \retval One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*scmi_notification_notify_agent)(
+        unsigned int protocol_id,
+        unsigned int operation_id,
+        unsigned int scmi_response_message_id,
+        unsigned int agent_idx,
+        void *payload_p2a,
+        size_t payload_size);
 };
 #endif
 
@@ -583,6 +704,242 @@ struct mod_scmi_from_protocol_api {
      */
     void (*notify)(fwk_id_t service_id, int protocol_id, int message_id,
         const void *payload, size_t size);
+
+    /*!
+     * \brief Get the token of the message being processed on a service.
+     *
+     * \details The token identifies the command a delayed response is sent
+     *      for. It must be retrieved before the command is responded to.
+     *
+     * \param service_id Service identifier.
+     * \param[out] token Token of the message.
+     *
+     * \retval ::FWK_SUCCESS The token was returned.
+     * \retval ::FWK_E_PARAM The token parameter was NULL.
+     */
+    int (*get_token)(fwk_id_t service_id, uint16_t *token);
+
+    /*!
+     * \brief Send a delayed response to the agent on behalf of an SCMI service.
+     *
+     * \details The delayed response is sent on the P2A service linked to the
+     *      A2P service the command was received on.
+     *
+     * \param service_id Service identifier.
+     * \param protocol_id Protocol identifier.
+     * \param message_id Message identifier of the command.
+     * \param token Token of the command, see
+     *      ::mod_scmi_from_protocol_api::get_token.
+     * \param payload Payload data to write.
+     * \param size Size of the payload in bytes.
+     */
+    void (*respond_delayed)(fwk_id_t service_id, int protocol_id,
+        int message_id, uint16_t token, const void *payload, size_t size);
+};
+
+/*!
+ * \brief Number of buckets of the response time histogram of a message.
+ *
+ * \details Bucket `0` counts the response times below one microsecond. Bucket
+ *      `n` counts the response times from 2^(n - 1) up to, but excluding, 2^n
+ *      microseconds, with the last bucket also counting every longer response
+ *      time.
+ */
+#define MOD_SCMI_TELEMETRY_BUCKET_COUNT 12
+
+/*!
+ * \brief Telemetry of a message of a protocol received from an agent.
+ *
+ * \details The response time of a message is measured from the signal of the
+ *      transport to the response of the protocol. The queuing time is measured
+ *      from the signal of the transport to the dispatch of the message to its
+ *      protocol.
+ */
+struct mod_scmi_telemetry_entry {
+    /*! Identifier of the agent */
+    uint8_t agent_id;
+
+    /*! SCMI identifier of the protocol */
+    uint8_t protocol_id;
+
+    /*! SCMI identifier of the message */
+    uint16_t message_id;
+
+    /*! Number of messages received */
+    uint32_t count;
+
+    /*! Number of messages responded to */
+    uint32_t response_count;
+
+    /*! Shortest response time in microseconds */
+    uint32_t min_response_time;
+
+    /*! Longest response time in microseconds */
+    uint32_t max_response_time;
+
+    /*! Longest queuing time in microseconds */
+    uint32_t max_queue_time;
+
+    /*! Sum of the response times in microseconds */
+    uint64_t total_response_time;
+
+    /*! Response time histogram */
+    uint32_t histogram[MOD_SCMI_TELEMETRY_BUCKET_COUNT];
+};
+
+/*!
+ * \brief SCMI message telemetry API.
+ *
+ * \details Interface used by the modules that report the message telemetry.
+ */
+struct mod_scmi_telemetry_api {
+    /*!
+     * \brief Get the number of entries in use in the telemetry table.
+     *
+     * \param[out] count Number of entries.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_PARAM The `count` parameter was a null pointer value.
+     */
+    int (*get_entry_count)(unsigned int *count);
+
+    /*!
+     * \brief Get an entry of the telemetry table.
+     *
+     * \param index Index of the entry.
+     * \param[out] entry Copy of the entry.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered:
+     *      - The `index` parameter was not the index of an entry in use.
+     *      - The `entry` parameter was a null pointer value.
+     */
+    int (*get_entry)(
+        unsigned int index,
+        struct mod_scmi_telemetry_entry *entry);
+
+    /*!
+     * \brief Clear the telemetry table.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     */
+    int (*reset)(void);
+};
+
+/*! Signature of the message capture - 0x50414353 ('SCAP') */
+#define MOD_SCMI_CAPTURE_SIGNATURE UINT32_C(0x50414353)
+
+/*! The platform responded to the message of a capture record */
+#define MOD_SCMI_CAPTURE_FLAG_RESPONDED (UINT8_C(1) << 0)
+
+/*!
+ * \brief Header of the message capture.
+ *
+ * \details The header is followed by mod_scmi_capture_header::record_count
+ *      records of mod_scmi_capture_header::record_size bytes each. The record
+ *      of the message with the sequence number N is at the index
+ *      N % mod_scmi_capture_header::record_count. A record is written before
+ *      the new sequence number is published, and its response fields are
+ *      updated in place once the platform has responded.
+ *
+ *      The capture holds no pointer, so it can be copied from the memory of
+ *      the platform, e.g. with a debugger, and replayed on the host, see
+ *      ::GroupModuleHostScmiAgent.
+ */
+struct mod_scmi_capture_header {
+    /*! Signature - MOD_SCMI_CAPTURE_SIGNATURE. */
+    uint32_t signature;
+
+    /*! Number of messages recorded since the last reset, modulo 2^32. */
+    uint32_t sequence;
+
+    /*! Number of records following the header, a power of two. */
+    uint32_t record_count;
+
+    /*! Size of a record in bytes, its payload included. */
+    uint32_t record_size;
+};
+
+/*!
+ * \brief Record of a message of the message capture.
+ *
+ * \details The record is followed by the first
+ *      ::mod_scmi_config::capture_payload_size bytes of the payload of the
+ *      message.
+ */
+struct mod_scmi_capture_record {
+    /*! Time the transport signaled the message at, in nanoseconds. */
+    uint64_t timestamp;
+
+    /*! Header of the message. */
+    uint32_t message_header;
+
+    /*! Identifier of the agent. */
+    uint8_t agent_id;
+
+    /*! Flags, see MOD_SCMI_CAPTURE_FLAG_RESPONDED. */
+    uint8_t flags;
+
+    /*! Size of the payload of the message in bytes. */
+    uint16_t payload_size;
+
+    /*! FNV-1a hash of the whole payload of the message. */
+    uint32_t payload_hash;
+
+    /*! Status of the response, the first word of its payload. */
+    int32_t status;
+
+    /*! Time from the signal of the transport to the response in nanoseconds. */
+    uint32_t latency;
+
+    /*! Reserved, zero. */
+    uint32_t reserved;
+};
+
+/*!
+ * \brief Get the size of a message capture.
+ *
+ * \param record_count Number of records.
+ * \param payload_size Number of bytes of payload kept in each record.
+ *
+ * \return Size of the capture in bytes, its header included.
+ */
+static inline size_t mod_scmi_capture_size(
+    unsigned int record_count,
+    size_t payload_size)
+{
+    return sizeof(struct mod_scmi_capture_header) +
+        (record_count *
+         (sizeof(struct mod_scmi_capture_record) + payload_size));
+}
+
+/*!
+ * \brief SCMI message capture API.
+ *
+ * \details Interface used by the modules that export the message capture.
+ */
+struct mod_scmi_capture_api {
+    /*!
+     * \brief Get the message capture.
+     *
+     * \param[out] capture Message capture.
+     * \param[out] size Size of the capture in bytes, its header included.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_PARAM One of the parameters was a null pointer value.
+     * \retval ::FWK_E_SUPPORT The capture is disabled.
+     */
+    int (*get_capture)(
+        const struct mod_scmi_capture_header **capture,
+        size_t *size);
+
+    /*!
+     * \brief Clear the message capture.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_SUPPORT The capture is disabled.
+     */
+    int (*reset)(void);
 };
 
 /*!
@@ -177,6 +177,7 @@ enum scmi_sensor_command_id {
     MOD_SCMI_SENSOR_TRIP_POINT_NOTIFY = 0x004,
     MOD_SCMI_SENSOR_TRIP_POINT_CONFIG = 0x005,
     MOD_SCMI_SENSOR_READING_GET = 0x006,
+    MOD_SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY = 0x00B,
     MOD_SCMI_SENSOR_COMMAND_COUNT,
 };
 
@@ -221,6 +222,25 @@ enum scmi_voltd_command_id {
     MOD_SCMI_VOLTD_COMMAND_COUNT,
 };
 
+/*!
+ * \brief SCMI Powercap Protocol
+ */
+#define MOD_SCMI_PROTOCOL_ID_POWERCAP UINT32_C(0x18)
+
+/*!
+ * \brief SCMI Powercap Protocol Message IDs
+ */
+enum scmi_powercap_command_id {
+    MOD_SCMI_POWERCAP_DOMAIN_ATTRIBUTES = 0x003,
+    MOD_SCMI_POWERCAP_CAP_GET = 0x004,
+    MOD_SCMI_POWERCAP_CAP_SET = 0x005,
+    MOD_SCMI_POWERCAP_PAI_GET = 0x006,
+    MOD_SCMI_POWERCAP_PAI_SET = 0x007,
+    MOD_SCMI_POWERCAP_DOMAIN_NAME_GET = 0x008,
+    MOD_SCMI_POWERCAP_MEASUREMENTS_GET = 0x009,
+    MOD_SCMI_POWERCAP_COMMAND_COUNT,
+};
+
 /*!
  * \}
  */
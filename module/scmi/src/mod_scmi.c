@@ -19,16 +19,21 @@
 #include <mod_scmi_header.h>
 
 #include <fwk_assert.h>
+#include <fwk_attributes.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_log.h>
 #include <fwk_macros.h>
+#include <fwk_math.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
+#include <fwk_signal.h>
 #include <fwk_status.h>
 #include <fwk_thread.h>
+#include <fwk_time.h>
 
 #ifdef BUILD_HAS_MULTITHREADING
 #    include <fwk_multi_thread.h>
@@ -37,12 +42,27 @@
 #include <inttypes.h>
 #include <string.h>
 
+enum scmi_signal_idx {
+    /* Message of the fast lane signalled by the transport */
+    SCMI_SIGNAL_IDX_FAST_MESSAGE,
+    SCMI_SIGNAL_IDX_COUNT,
+};
+
+/* Fast lane message signal identifier */
+static const fwk_id_t scmi_signal_id_fast_message =
+    FWK_ID_SIGNAL_INIT(FWK_MODULE_IDX_SCMI, SCMI_SIGNAL_IDX_FAST_MESSAGE);
+
 struct scmi_protocol {
     /* SCMI protocol message handler */
     mod_scmi_message_handler_t *message_handler;
 
     /* SCMI protocol framework identifier */
     fwk_id_t id;
+
+#ifndef BUILD_HAS_RESOURCE_PERMISSIONS
+    /* The protocol is in the list of protocols disabled for PSCI agents */
+    bool psci_denied;
+#endif
 };
 
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
@@ -51,6 +71,9 @@ struct scmi_protocol {
 #    define MOD_SCMI_PROTOCOL_MAX_OPERATION_ID 0x20
 #    define MOD_SCMI_PROTOCOL_OPERATION_IDX_INVALID 0xFF
 
+/* Number of agents tracked by a word of a subscriber bitmap */
+#    define SCMI_NOTIFICATION_BITMAP_WORD_BITS 32
+
 struct scmi_notification_subscribers {
     unsigned int agent_count;
     unsigned int element_count;
@@ -59,9 +82,7 @@ struct scmi_notification_subscribers {
     uint8_t operation_id_to_idx[MOD_SCMI_PROTOCOL_MAX_OPERATION_ID];
 
     /*
-     * Table of protocol operations for which SCMI notification is requested
-     * An agent which is requesting a SCMI notification is identified using its
-     * service_id and associated context as below.
+     * Bitmaps of the agents which requested a SCMI notification.
      *
      * Usually, a notification is requested for
      * 1. A specific operation on the protocol.
@@ -74,16 +95,43 @@ struct scmi_notification_subscribers {
      * 2. element maps to a performance domain.
      * 3. And an agent maps to either a PSCI agent or an OSPM agent
      *
-     * Thus, a service_id of a requesting agent can be indexed using above
-     * information using a simple 3-dimentional array as below
+     * Each operation and element pair has a bitmap of bitmap_word_count words
+     * in which bit N is set if agent N requested the notification:
      *
-     *   agent_service_ids[operation_idx][element_idx][agent_idx]
+     *   agent_bitmaps[operation_idx][element_idx][word_idx]
+     *
+     * Most agents subscribe to few elements, so a bit per subscription keeps
+     * the table small and lets the notifiers skip the other agents.
+     */
+    uint32_t *agent_bitmaps;
+
+    /* Number of words of a subscriber bitmap */
+    unsigned int bitmap_word_count;
+
+    /*
+     * Table of the service identifiers through which the agents requested
+     * notifications, indexed by agent.
      */
     fwk_id_t *agent_service_ids;
 };
 
 #endif
 
+/*
+ * List of the protocols an agent may discover, as returned by
+ * BASE_DISCOVER_LIST_PROTOCOLS.
+ */
+struct scmi_protocol_list {
+    /* The list reflects the current protocols and permissions of the agent */
+    bool valid;
+
+    /* Number of protocols in the list */
+    unsigned int count;
+
+    /* Table of protocol identifiers */
+    uint8_t *protocols;
+};
+
 struct scmi_ctx {
     /* SCMI module configuration data */
     struct mod_scmi_config *config;
@@ -103,6 +151,44 @@ struct scmi_ctx {
     /* Table of service contexts */
     struct scmi_service_ctx *service_ctx_table;
 
+    /* Number of services */
+    unsigned int service_count;
+
+    /*
+     * Virtual time of each agent, advanced every time one of its messages is
+     * scheduled by an amount inversely proportional to the agent weight.
+     */
+    uint32_t *agent_vtime;
+
+    /* Virtual time of the agent of the last scheduled message */
+    uint32_t vtime;
+
+    /* A scheduled message is being processed by its service */
+    bool message_in_flight;
+
+    /* Table of message telemetry entries */
+    struct mod_scmi_telemetry_entry *telemetry_table;
+
+    /* Number of entries in use in the telemetry table */
+    unsigned int telemetry_entry_count;
+
+    /*
+     * Index of the telemetry entries, by agent identifier, protocol table
+     * index and message identifier. Each element holds the index of the
+     * entry in the telemetry table plus one, or zero if the message has no
+     * entry yet.
+     */
+    uint16_t *telemetry_index;
+
+    /* Number of protocol table entries covered by the telemetry index */
+    unsigned int telemetry_protocol_count;
+
+    /* Message capture, NULL when the capture is disabled */
+    struct mod_scmi_capture_header *capture;
+
+    /* Table of discoverable protocol lists, indexed by agent identifier */
+    struct scmi_protocol_list *protocol_list_table;
+
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
     /* SCMI Resource Permissions API */
     const struct mod_res_permissions_api *res_perms_api;
@@ -122,6 +208,12 @@ struct scmi_ctx {
 #define PROTOCOL_TABLE_BASE_PROTOCOL_IDX 1
 #define PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT 2
 
+/* Number of message identifiers of a protocol covered by the telemetry */
+#define SCMI_TELEMETRY_MESSAGE_ID_COUNT 0x20
+
+/* Virtual time consumed by a message of an agent of weight one */
+#define SCHEDULER_VTIME_QUANTUM UINT32_C(0x10000)
+
 static int scmi_base_protocol_version_handler(
     fwk_id_t service_id, const uint32_t *payload);
 static int scmi_base_protocol_attributes_handler(
@@ -211,7 +303,7 @@ static struct scmi_ctx scmi_ctx;
  * and a 10-bit token.
  */
 static uint32_t scmi_message_header(uint8_t message_id,
-    uint8_t message_type, uint8_t protocol_id, uint8_t token)
+    uint8_t message_type, uint8_t protocol_id, uint16_t token)
 {
     return ((((message_id) << SCMI_MESSAGE_HEADER_MESSAGE_ID_POS) &
         SCMI_MESSAGE_HEADER_MESSAGE_ID_MASK) |
@@ -220,7 +312,7 @@ static uint32_t scmi_message_header(uint8_t message_id,
     (((protocol_id) << SCMI_MESSAGE_HEADER_PROTOCOL_ID_POS) &
         SCMI_MESSAGE_HEADER_PROTOCOL_ID_MASK) |
     (((token) << SCMI_MESSAGE_HEADER_TOKEN_POS) &
-        SCMI_MESSAGE_HEADER_TOKEN_POS));
+        SCMI_MESSAGE_HEADER_TOKEN_MASK));
 }
 
 static uint16_t read_message_id(uint32_t message_header)
@@ -280,15 +372,429 @@ static int signal_error(fwk_id_t service_id)
                         sizeof(int32_t));
 }
 
-static int signal_message(fwk_id_t service_id)
+/*
+ * Message telemetry
+ */
+static uint32_t telemetry_duration_us(
+    fwk_timestamp_t start,
+    fwk_timestamp_t end)
+{
+    fwk_duration_us_t duration;
+
+    duration = (end > start) ? fwk_time_duration_us(end - start) : 0;
+
+    return (uint32_t)FWK_MIN(duration, (fwk_duration_us_t)UINT32_MAX);
+}
+
+/*
+ * Find the telemetry entry of a message, allocating it on first use. NULL is
+ * returned when the telemetry is disabled, the table is full or the message
+ * is not covered by the telemetry.
+ */
+static struct mod_scmi_telemetry_entry *telemetry_get_entry(
+    unsigned int agent_id,
+    unsigned int protocol_id,
+    unsigned int message_id)
+{
+    struct mod_scmi_telemetry_entry *entry;
+    unsigned int protocol_idx, slot;
+    uint16_t *index;
+
+    if (scmi_ctx.telemetry_index == NULL)
+        return NULL;
+
+    /* The messages of the unsupported protocols are not accounted for */
+    protocol_idx = scmi_ctx.scmi_protocol_id_to_idx[protocol_id];
+    if ((protocol_idx == 0) ||
+        (protocol_idx >= scmi_ctx.telemetry_protocol_count) ||
+        (agent_id > scmi_ctx.config->agent_count) ||
+        (message_id >= SCMI_TELEMETRY_MESSAGE_ID_COUNT))
+        return NULL;
+
+    slot = (agent_id * scmi_ctx.telemetry_protocol_count) + protocol_idx;
+    index = &scmi_ctx.telemetry_index
+                 [(slot * SCMI_TELEMETRY_MESSAGE_ID_COUNT) + message_id];
+    if (*index != 0)
+        return &scmi_ctx.telemetry_table[*index - 1];
+
+    if (scmi_ctx.telemetry_entry_count >=
+        scmi_ctx.config->telemetry_entry_count)
+        return NULL;
+
+    entry = &scmi_ctx.telemetry_table[scmi_ctx.telemetry_entry_count++];
+    *index = (uint16_t)scmi_ctx.telemetry_entry_count;
+    *entry = (struct mod_scmi_telemetry_entry){
+        .agent_id = (uint8_t)agent_id,
+        .protocol_id = (uint8_t)protocol_id,
+        .message_id = (uint16_t)message_id,
+        .min_response_time = UINT32_MAX,
+    };
+
+    return entry;
+}
+
+static void telemetry_record_dispatch(struct scmi_service_ctx *ctx)
+{
+    struct mod_scmi_telemetry_entry *entry;
+    uint32_t queue_time;
+
+    entry = telemetry_get_entry(
+        ctx->config->scmi_agent_id,
+        ctx->scmi_protocol_id,
+        ctx->scmi_message_id);
+
+    ctx->telemetry_entry = entry;
+    if (entry == NULL)
+        return;
+
+    queue_time =
+        telemetry_duration_us(ctx->message_timestamp, fwk_time_current());
+
+    entry->count++;
+    entry->max_queue_time = FWK_MAX(entry->max_queue_time, queue_time);
+}
+
+static void telemetry_record_response(struct scmi_service_ctx *ctx)
+{
+    struct mod_scmi_telemetry_entry *entry = ctx->telemetry_entry;
+    uint32_t response_time;
+    unsigned int bucket = 0;
+
+    if (entry == NULL)
+        return;
+
+    ctx->telemetry_entry = NULL;
+
+    response_time =
+        telemetry_duration_us(ctx->message_timestamp, fwk_time_current());
+
+    if (response_time > 0) {
+        bucket = FWK_MIN(
+            (unsigned int)fwk_math_log2(response_time) + 1,
+            MOD_SCMI_TELEMETRY_BUCKET_COUNT - 1u);
+    }
+
+    entry->response_count++;
+    entry->min_response_time = FWK_MIN(entry->min_response_time, response_time);
+    entry->max_response_time = FWK_MAX(entry->max_response_time, response_time);
+    entry->total_response_time += response_time;
+    entry->histogram[bucket]++;
+}
+
+/*
+ * Message capture
+ */
+static uint32_t capture_hash(const void *payload, size_t size)
+{
+    const uint8_t *data = payload;
+    uint32_t hash = UINT32_C(2166136261);
+    size_t idx;
+
+    for (idx = 0; idx < size; idx++) {
+        hash ^= data[idx];
+        hash *= UINT32_C(16777619);
+    }
+
+    return hash;
+}
+
+static struct mod_scmi_capture_record *capture_get_record(uint32_t sequence)
+{
+    struct mod_scmi_capture_header *capture = scmi_ctx.capture;
+    uint32_t record_idx = sequence & (capture->record_count - 1);
+
+    return (struct mod_scmi_capture_record *)(
+        (uintptr_t)(capture + 1) + (record_idx * capture->record_size));
+}
+
+static void capture_record_message(
+    struct scmi_service_ctx *ctx,
+    uint32_t message_header,
+    const void *payload,
+    size_t payload_size)
+{
+    struct mod_scmi_capture_header *capture = scmi_ctx.capture;
+    struct mod_scmi_capture_record *record;
+    uint32_t payload_hash;
+    size_t kept_size;
+
+    ctx->capture_record = NULL;
+
+    if (capture == NULL)
+        return;
+
+    payload_hash = capture_hash(payload, payload_size);
+    kept_size = FWK_MIN(payload_size, scmi_ctx.config->capture_payload_size);
+
+    fwk_interrupt_global_disable();
+
+    ctx->capture_sequence = capture->sequence;
+    record = capture_get_record(ctx->capture_sequence);
+
+    *record = (struct mod_scmi_capture_record){
+        .timestamp = ctx->message_timestamp,
+        .message_header = message_header,
+        .agent_id = (uint8_t)ctx->config->scmi_agent_id,
+        .payload_size = (uint16_t)payload_size,
+        .payload_hash = payload_hash,
+    };
+    memcpy(record + 1, payload, kept_size);
+
+    /* The record is complete before it is published */
+    capture->sequence++;
+
+    fwk_interrupt_global_enable();
+
+    ctx->capture_record = record;
+}
+
+static void capture_record_response(
+    struct scmi_service_ctx *ctx,
+    const void *payload,
+    size_t size)
+{
+    struct mod_scmi_capture_record *record = ctx->capture_record;
+    fwk_duration_ns_t latency;
+    int32_t status = SCMI_SUCCESS;
+
+    if (record == NULL)
+        return;
+
+    ctx->capture_record = NULL;
+
+    latency = fwk_time_duration(ctx->message_timestamp, fwk_time_current());
+
+    if ((payload != NULL) && (size >= sizeof(status)))
+        memcpy(&status, payload, sizeof(status));
+
+    fwk_interrupt_global_disable();
+
+    /* The record is left alone if a more recent message took its place */
+    if ((scmi_ctx.capture->sequence - ctx->capture_sequence) <=
+        scmi_ctx.capture->record_count) {
+        record->status = status;
+        record->latency =
+            (uint32_t)FWK_MIN(latency, (fwk_duration_ns_t)UINT32_MAX);
+        record->flags |= MOD_SCMI_CAPTURE_FLAG_RESPONDED;
+    }
+
+    fwk_interrupt_global_enable();
+}
+
+/*
+ * Message scheduler
+ *
+ * Transports only mark their service as pending. A single message is handed
+ * to the services at a time, the next one being chosen when the previous one
+ * has been processed:
+ * - Messages whose agent deadline has expired come first, earliest deadline
+ *   first.
+ * - Otherwise, the message of the agent with the lowest virtual time is chosen.
+ *   As the virtual time of an agent advances more slowly the higher its
+ *   weight, agents are serviced in proportion to their weights.
+ */
+static bool vtime_before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+static const struct mod_scmi_agent *get_service_agent(
+    const struct scmi_service_ctx *ctx)
+{
+    return &scmi_ctx.config->agent_table[ctx->config->scmi_agent_id];
+}
+
+static struct scmi_service_ctx *scheduler_select(unsigned int *service_idx)
+{
+    const struct mod_scmi_agent *agent;
+    struct scmi_service_ctx *ctx, *selected = NULL;
+    fwk_timestamp_t now, expiry, selected_expiry = 0;
+    bool selected_expired = false;
+    uint32_t vtime, selected_vtime = 0;
+    unsigned int idx;
+
+    now = fwk_time_current();
+
+    for (idx = 0; idx < scmi_ctx.service_count; idx++) {
+        ctx = &scmi_ctx.service_ctx_table[idx];
+        if (!ctx->pending)
+            continue;
+
+        agent = get_service_agent(ctx);
+
+        if (agent->deadline != 0) {
+            expiry = ctx->pending_timestamp + FWK_US(agent->deadline);
+
+            if (now >= expiry) {
+                if (!selected_expired || (expiry < selected_expiry)) {
+                    selected = ctx;
+                    selected_expired = true;
+                    selected_expiry = expiry;
+                    *service_idx = idx;
+                }
+
+                continue;
+            }
+        }
+
+        if (selected_expired)
+            continue;
+
+        vtime = scmi_ctx.agent_vtime[ctx->config->scmi_agent_id];
+        if ((selected == NULL) || vtime_before(vtime, selected_vtime)) {
+            selected = ctx;
+            selected_vtime = vtime;
+            *service_idx = idx;
+        }
+    }
+
+    return selected;
+}
+
+/*
+ * Hand the next pending message to its service, unless a message is already
+ * being processed.
+ */
+static void scheduler_dispatch(void)
 {
-    struct fwk_event event = (struct fwk_event) {
+    const struct mod_scmi_agent *agent;
+    struct scmi_service_ctx *ctx;
+    unsigned int service_idx = 0;
+    unsigned int agent_id;
+    uint32_t increment;
+    int status;
+
+    fwk_interrupt_global_disable();
+
+    if (scmi_ctx.message_in_flight) {
+        fwk_interrupt_global_enable();
+
+        return;
+    }
+
+    ctx = scheduler_select(&service_idx);
+    if (ctx == NULL) {
+        fwk_interrupt_global_enable();
+
+        return;
+    }
+
+    agent_id = ctx->config->scmi_agent_id;
+    agent = get_service_agent(ctx);
+    increment = SCHEDULER_VTIME_QUANTUM / FWK_MAX(agent->weight, 1u);
+
+    scmi_ctx.vtime = scmi_ctx.agent_vtime[agent_id];
+    scmi_ctx.agent_vtime[agent_id] += FWK_MAX(increment, UINT32_C(1));
+
+    ctx->pending = false;
+    ctx->message_timestamp = ctx->pending_timestamp;
+    scmi_ctx.message_in_flight = true;
+
+    fwk_interrupt_global_enable();
+
+    struct fwk_event event = (struct fwk_event){
         .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI, 0),
         .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
-        .target_id = service_id,
+        .target_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI, service_idx),
     };
 
-    return fwk_thread_put_event(&event);
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_ERR(
+            "[SCMI] %s: Unable to schedule message (%s)",
+            fwk_module_get_name(event.target_id),
+            fwk_status_str(status));
+
+        /*
+         * Leave the message pending, and its agent uncharged, so that it is
+         * dispatched again on the next scheduling pass.
+         */
+        fwk_interrupt_global_disable();
+        ctx->pending = true;
+        scmi_ctx.agent_vtime[agent_id] -= FWK_MAX(increment, UINT32_C(1));
+        scmi_ctx.message_in_flight = false;
+        fwk_interrupt_global_enable();
+    }
+}
+
+static void scheduler_complete(void)
+{
+    scmi_ctx.message_in_flight = false;
+
+    scheduler_dispatch();
+}
+
+/*
+ * Message fast lane
+ *
+ * The messages of the fast message table bypass the scheduler: they are
+ * handled in a framework signal, processed ahead of any pending event.
+ */
+static bool is_fast_message(struct scmi_service_ctx *ctx)
+{
+    const struct mod_scmi_fast_message *message;
+    uint32_t message_header;
+    unsigned int idx;
+    int status;
+
+    if (scmi_ctx.config->fast_message_count == 0)
+        return false;
+
+    status = ctx->transport_api->get_message_header(
+        ctx->transport_id, &message_header);
+    if (status != FWK_SUCCESS)
+        return false;
+
+    for (idx = 0; idx < scmi_ctx.config->fast_message_count; idx++) {
+        message = &scmi_ctx.config->fast_message_table[idx];
+
+        if ((message->agent_id == ctx->config->scmi_agent_id) &&
+            (message->protocol_id == read_protocol_id(message_header)) &&
+            (message->message_id == read_message_id(message_header)))
+            return true;
+    }
+
+    return false;
+}
+
+static int signal_message(fwk_id_t service_id)
+{
+    struct scmi_service_ctx *ctx;
+    uint32_t *agent_vtime;
+    int status;
+
+    ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
+
+    if (is_fast_message(ctx)) {
+        ctx->message_timestamp = fwk_time_current();
+
+        status = fwk_thread_put_signal(
+            service_id, service_id, scmi_signal_id_fast_message);
+        if (status == FWK_SUCCESS)
+            return FWK_SUCCESS;
+
+        /* The signal queue is full, the scheduler takes the message */
+    }
+
+    agent_vtime = &scmi_ctx.agent_vtime[ctx->config->scmi_agent_id];
+
+    fwk_interrupt_global_disable();
+
+    /*
+     * An agent that has been idle does not accumulate credit: it resumes from
+     * the virtual time of the last scheduled message.
+     */
+    if (vtime_before(*agent_vtime, scmi_ctx.vtime))
+        *agent_vtime = scmi_ctx.vtime;
+
+    ctx->pending = true;
+    ctx->pending_timestamp = fwk_time_current();
+
+    fwk_interrupt_global_enable();
+
+    scheduler_dispatch();
+
+    return FWK_SUCCESS;
 }
 
 static const struct mod_scmi_from_transport_api mod_scmi_from_transport_api = {
@@ -365,7 +871,7 @@ static int write_payload(fwk_id_t service_id, size_t offset,
 static void respond(fwk_id_t service_id, const void *payload, size_t size)
 {
     int status;
-    const struct scmi_service_ctx *ctx;
+    struct scmi_service_ctx *ctx;
     const char *service_name;
     const char *message_type_name;
 
@@ -414,13 +920,15 @@ static void respond(fwk_id_t service_id, const void *payload, size_t size)
             ctx->scmi_message_id,
             fwk_status_str(status));
     }
+
+    telemetry_record_response(ctx);
+    capture_record_response(ctx, payload, size);
 }
 
-static void scmi_notify(fwk_id_t id, int protocol_id, int message_id,
+static void scmi_transmit_p2a(fwk_id_t id, uint32_t message_header,
     const void *payload, size_t size)
 {
     const struct scmi_service_ctx *ctx, *p2a_ctx;
-    uint32_t message_header;
 
     /*
      * The ID is the identifier of the service channel which
@@ -442,13 +950,41 @@ static void scmi_notify(fwk_id_t id, int protocol_id, int message_id,
     if ((p2a_ctx == NULL) || (p2a_ctx->transmit == NULL))
         return; /* No notification service configured */
 
-    message_header = scmi_message_header(message_id,
-        MOD_SCMI_MESSAGE_TYPE_NOTIFICATION,
-        protocol_id, 0);
-
     p2a_ctx->transmit(p2a_ctx->transport_id, message_header, payload, size);
 }
 
+static void scmi_notify(fwk_id_t id, int protocol_id, int message_id,
+    const void *payload, size_t size)
+{
+    scmi_transmit_p2a(id,
+        scmi_message_header(message_id,
+            MOD_SCMI_MESSAGE_TYPE_NOTIFICATION, protocol_id, 0),
+        payload, size);
+}
+
+static int get_token(fwk_id_t service_id, uint16_t *token)
+{
+    const struct scmi_service_ctx *ctx;
+
+    if (token == NULL)
+        return FWK_E_PARAM;
+
+    ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
+
+    *token = ctx->scmi_token;
+
+    return FWK_SUCCESS;
+}
+
+static void respond_delayed(fwk_id_t service_id, int protocol_id,
+    int message_id, uint16_t token, const void *payload, size_t size)
+{
+    scmi_transmit_p2a(service_id,
+        scmi_message_header(message_id,
+            MOD_SCMI_MESSAGE_TYPE_DELAYED_RESPONSE, protocol_id, token),
+        payload, size);
+}
+
 static const struct mod_scmi_from_protocol_api mod_scmi_from_protocol_api = {
     .get_agent_count = get_agent_count,
     .get_agent_id = get_agent_id,
@@ -457,6 +993,100 @@ static const struct mod_scmi_from_protocol_api mod_scmi_from_protocol_api = {
     .write_payload = write_payload,
     .respond = respond,
     .notify = scmi_notify,
+    .get_token = get_token,
+    .respond_delayed = respond_delayed,
+};
+
+static int telemetry_get_entry_count(unsigned int *count)
+{
+    if (count == NULL)
+        return FWK_E_PARAM;
+
+    *count = scmi_ctx.telemetry_entry_count;
+
+    return FWK_SUCCESS;
+}
+
+static int telemetry_get_entry_copy(
+    unsigned int index,
+    struct mod_scmi_telemetry_entry *entry)
+{
+    if ((entry == NULL) || (index >= scmi_ctx.telemetry_entry_count))
+        return FWK_E_PARAM;
+
+    fwk_interrupt_global_disable();
+    *entry = scmi_ctx.telemetry_table[index];
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
+
+static int telemetry_reset(void)
+{
+    unsigned int idx;
+
+    /* The messages being processed are no longer accounted for */
+    for (idx = 0; idx < scmi_ctx.service_count; idx++)
+        scmi_ctx.service_ctx_table[idx].telemetry_entry = NULL;
+
+    scmi_ctx.telemetry_entry_count = 0;
+
+    if (scmi_ctx.telemetry_index != NULL) {
+        memset(
+            scmi_ctx.telemetry_index,
+            0,
+            (scmi_ctx.config->agent_count + 1) *
+                scmi_ctx.telemetry_protocol_count *
+                SCMI_TELEMETRY_MESSAGE_ID_COUNT *
+                sizeof(scmi_ctx.telemetry_index[0]));
+    }
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_scmi_telemetry_api mod_scmi_telemetry_api = {
+    .get_entry_count = telemetry_get_entry_count,
+    .get_entry = telemetry_get_entry_copy,
+    .reset = telemetry_reset,
+};
+
+static int capture_get_capture(
+    const struct mod_scmi_capture_header **capture,
+    size_t *size)
+{
+    if ((capture == NULL) || (size == NULL))
+        return FWK_E_PARAM;
+
+    if (scmi_ctx.capture == NULL)
+        return FWK_E_SUPPORT;
+
+    *capture = scmi_ctx.capture;
+    *size = mod_scmi_capture_size(
+        scmi_ctx.config->capture_record_count,
+        scmi_ctx.config->capture_payload_size);
+
+    return FWK_SUCCESS;
+}
+
+static int capture_reset(void)
+{
+    unsigned int idx;
+
+    if (scmi_ctx.capture == NULL)
+        return FWK_E_SUPPORT;
+
+    /* The messages being processed are no longer recorded */
+    for (idx = 0; idx < scmi_ctx.service_count; idx++)
+        scmi_ctx.service_ctx_table[idx].capture_record = NULL;
+
+    scmi_ctx.capture->sequence = 0;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_scmi_capture_api mod_scmi_capture_api = {
+    .get_capture = capture_get_capture,
+    .reset = capture_reset,
 };
 
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
@@ -481,19 +1111,23 @@ static int scmi_notification_init(
     unsigned int element_count,
     unsigned int operation_count)
 {
-    int i;
-    int total_count;
+    unsigned int i;
     struct scmi_notification_subscribers *subscribers =
         notification_subscribers(protocol_id);
 
     subscribers->agent_count = agent_count;
     subscribers->element_count = element_count;
     subscribers->operation_count = operation_count;
+    subscribers->bitmap_word_count =
+        (agent_count + SCMI_NOTIFICATION_BITMAP_WORD_BITS - 1) /
+        SCMI_NOTIFICATION_BITMAP_WORD_BITS;
 
-    total_count = operation_count * element_count * agent_count;
+    subscribers->agent_bitmaps = fwk_mm_calloc(
+        operation_count * element_count * subscribers->bitmap_word_count,
+        sizeof(subscribers->agent_bitmaps[0]));
 
     subscribers->agent_service_ids =
-        fwk_mm_calloc(total_count, sizeof(fwk_id_t));
+        fwk_mm_calloc(agent_count, sizeof(subscribers->agent_service_ids[0]));
 
     /*
      * Mark all operations_idx as invalid. This will be updated
@@ -504,33 +1138,25 @@ static int scmi_notification_init(
         MOD_SCMI_PROTOCOL_OPERATION_IDX_INVALID,
         MOD_SCMI_PROTOCOL_MAX_OPERATION_ID);
 
-    for (i = 0; i < total_count; i++) {
+    for (i = 0; i < agent_count; i++) {
         subscribers->agent_service_ids[i] = FWK_ID_NONE;
     }
 
     return FWK_SUCCESS;
 }
 
-static int scmi_notification_service_idx(
-    unsigned int agent_idx,
+/*
+ * Get the bitmap of the agents which requested the notification of an
+ * operation for an element.
+ */
+static uint32_t *scmi_notification_bitmap(
+    const struct scmi_notification_subscribers *subscribers,
     unsigned int element_idx,
-    unsigned int operation_idx,
-    unsigned int agent_count,
-    unsigned int element_count)
+    unsigned int operation_idx)
 {
-    /*
-     * The index is from a 3-dimentional array
-     * [operation_idx][element_idx][agent_idx]
-     * The calculation of service_id offset in above array is as below
-     * 1. Get the offset of the service_id in the 3rd array .
-     *    +
-     * 2. Get the offset of the 3rd array within the 2nd array.
-     *    +
-     * 3. Get the offset of the 2nd array within the first array.
-     */
-    return (
-        agent_idx + element_idx * agent_count +
-        operation_idx * element_count * agent_count);
+    return &subscribers->agent_bitmaps
+                [(operation_idx * subscribers->element_count + element_idx) *
+                 subscribers->bitmap_word_count];
 }
 
 static int scmi_notification_add_subscriber(
@@ -540,9 +1166,9 @@ static int scmi_notification_add_subscriber(
     fwk_id_t service_id)
 {
     int status;
-    unsigned int operation_idx = 0;
-    unsigned int service_id_idx;
+    unsigned int operation_idx;
     unsigned int agent_idx;
+    uint32_t *bitmap;
 
     struct scmi_notification_subscribers *subscribers =
         notification_subscribers(protocol_id);
@@ -552,6 +1178,9 @@ static int scmi_notification_add_subscriber(
         return status;
 
     fwk_assert(operation_id < MOD_SCMI_PROTOCOL_MAX_OPERATION_ID);
+    fwk_assert(agent_idx < subscribers->agent_count);
+    fwk_assert(element_idx < subscribers->element_count);
+
     /*
      * Initialize only if the entry is
      * invalid (MOD_SCMI_PROTOCOL_OPERATION_IDX_INVALID)
@@ -563,14 +1192,13 @@ static int scmi_notification_add_subscriber(
         subscribers->operation_id_to_idx[operation_id] = operation_idx;
     }
 
-    service_id_idx = scmi_notification_service_idx(
-        agent_idx,
-        element_idx,
-        operation_idx,
-        subscribers->agent_count,
-        subscribers->element_count);
+    operation_idx = subscribers->operation_id_to_idx[operation_id];
 
-    subscribers->agent_service_ids[service_id_idx] = service_id;
+    bitmap = scmi_notification_bitmap(subscribers, element_idx, operation_idx);
+    bitmap[agent_idx / SCMI_NOTIFICATION_BITMAP_WORD_BITS] |=
+        UINT32_C(1) << (agent_idx % SCMI_NOTIFICATION_BITMAP_WORD_BITS);
+
+    subscribers->agent_service_ids[agent_idx] = service_id;
 
     return FWK_SUCCESS;
 }
@@ -581,28 +1209,63 @@ static int scmi_notification_remove_subscriber(
     unsigned int element_idx,
     unsigned int operation_id)
 {
-    unsigned int operation_idx = 0;
-    unsigned int service_id_idx;
+    unsigned int operation_idx;
+    uint32_t *bitmap;
 
     struct scmi_notification_subscribers *subscribers =
         notification_subscribers(protocol_id);
 
     fwk_assert(operation_id < MOD_SCMI_PROTOCOL_MAX_OPERATION_ID);
+    fwk_assert(agent_idx < subscribers->agent_count);
+    fwk_assert(element_idx < subscribers->element_count);
 
     operation_idx = subscribers->operation_id_to_idx[operation_id];
 
-    service_id_idx = scmi_notification_service_idx(
-        agent_idx,
-        element_idx,
-        operation_idx,
-        subscribers->agent_count,
-        subscribers->element_count);
+    /* No agent has subscribed to the operation yet */
+    if (operation_idx == MOD_SCMI_PROTOCOL_OPERATION_IDX_INVALID)
+        return FWK_SUCCESS;
 
-    subscribers->agent_service_ids[service_id_idx] = FWK_ID_NONE;
+    bitmap = scmi_notification_bitmap(subscribers, element_idx, operation_idx);
+    bitmap[agent_idx / SCMI_NOTIFICATION_BITMAP_WORD_BITS] &=
+        ~(UINT32_C(1) << (agent_idx % SCMI_NOTIFICATION_BITMAP_WORD_BITS));
 
     return FWK_SUCCESS;
 }
 
+/*
+ * Notify an agent of all the elements for which it requested a notification
+ * of an operation.
+ */
+static void scmi_notification_notify_subscriptions(
+    unsigned int protocol_id,
+    const struct scmi_notification_subscribers *subscribers,
+    unsigned int operation_idx,
+    unsigned int scmi_response_id,
+    unsigned int agent_idx,
+    void *payload_p2a,
+    size_t payload_size)
+{
+    unsigned int i;
+    const uint32_t *bitmap;
+    uint32_t mask;
+
+    mask = UINT32_C(1) << (agent_idx % SCMI_NOTIFICATION_BITMAP_WORD_BITS);
+
+    for (i = 0; i < subscribers->element_count; i++) {
+        bitmap = scmi_notification_bitmap(subscribers, i, operation_idx);
+
+        if ((bitmap[agent_idx / SCMI_NOTIFICATION_BITMAP_WORD_BITS] & mask) !=
+            0) {
+            scmi_notify(
+                subscribers->agent_service_ids[agent_idx],
+                protocol_id,
+                scmi_response_id,
+                payload_p2a,
+                payload_size);
+        }
+    }
+}
+
 static int scmi_notification_notify(
     unsigned int protocol_id,
     unsigned int operation_id,
@@ -612,8 +1275,9 @@ static int scmi_notification_notify(
 {
     unsigned int i, j;
     unsigned int operation_idx;
-    fwk_id_t service_id;
-    unsigned int service_id_idx;
+    unsigned int agent_idx;
+    const uint32_t *bitmap;
+    uint32_t word;
 
     struct scmi_notification_subscribers *subscribers =
         notification_subscribers(protocol_id);
@@ -632,20 +1296,22 @@ static int scmi_notification_notify(
     }
 
     for (i = 0; i < subscribers->element_count; i++) {
-        /* Skip agent 0, platform agent */
-        for (j = 1; j < subscribers->agent_count; j++) {
-            service_id_idx = scmi_notification_service_idx(
-                j,
-                i,
-                operation_idx,
-                subscribers->agent_count,
-                subscribers->element_count);
-
-            service_id = subscribers->agent_service_ids[service_id_idx];
-
-            if (!fwk_id_is_equal(service_id, FWK_ID_NONE)) {
+        bitmap = scmi_notification_bitmap(subscribers, i, operation_idx);
+
+        for (j = 0; j < subscribers->bitmap_word_count; j++) {
+            word = bitmap[j];
+
+            /* Skip agent 0, platform agent */
+            if (j == 0)
+                word &= ~(UINT32_C(1) << MOD_SCMI_PLATFORM_ID);
+
+            while (word != 0) {
+                agent_idx = j * SCMI_NOTIFICATION_BITMAP_WORD_BITS +
+                    fwk_math_ctz((unsigned int)word);
+                word &= word - 1;
+
                 scmi_notify(
-                    service_id,
+                    subscribers->agent_service_ids[agent_idx],
                     protocol_id,
                     scmi_response_id,
                     payload_p2a,
@@ -657,11 +1323,48 @@ static int scmi_notification_notify(
     return FWK_SUCCESS;
 }
 
+static int scmi_notification_notify_agent(
+    unsigned int protocol_id,
+    unsigned int operation_id,
+    unsigned int scmi_response_id,
+    unsigned int agent_idx,
+    void *payload_p2a,
+    size_t payload_size)
+{
+    unsigned int operation_idx;
+
+    struct scmi_notification_subscribers *subscribers =
+        notification_subscribers(protocol_id);
+
+    fwk_assert(operation_id < MOD_SCMI_PROTOCOL_MAX_OPERATION_ID);
+    operation_idx = subscribers->operation_id_to_idx[operation_id];
+
+    /* See scmi_notification_notify() */
+    if (operation_idx == MOD_SCMI_PROTOCOL_OPERATION_IDX_INVALID)
+        return FWK_SUCCESS;
+
+    if ((agent_idx == MOD_SCMI_PLATFORM_ID) ||
+        (agent_idx >= subscribers->agent_count))
+        return FWK_E_PARAM;
+
+    scmi_notification_notify_subscriptions(
+        protocol_id,
+        subscribers,
+        operation_idx,
+        scmi_response_id,
+        agent_idx,
+        payload_p2a,
+        payload_size);
+
+    return FWK_SUCCESS;
+}
+
 static struct mod_scmi_notification_api mod_scmi_notification_api = {
     .scmi_notification_init = scmi_notification_init,
     .scmi_notification_add_subscriber = scmi_notification_add_subscriber,
     .scmi_notification_remove_subscriber = scmi_notification_remove_subscriber,
     .scmi_notification_notify = scmi_notification_notify,
+    .scmi_notification_notify_agent = scmi_notification_notify_agent,
 };
 #endif
 
@@ -848,85 +1551,38 @@ static int scmi_base_discover_implementation_version_handler(
 /*
  * BASE_DISCOVER_LIST_PROTOCOLS
  */
-static int scmi_base_discover_list_protocols_handler(fwk_id_t service_id,
-                                                     const uint32_t *payload)
+static void scmi_base_build_protocol_list(
+    unsigned int agent_id,
+    struct scmi_protocol_list *list)
 {
-    int status;
-    const struct scmi_base_discover_list_protocols_a2p *parameters;
-    struct scmi_base_discover_list_protocols_p2a return_values = {
-        .status = SCMI_GENERIC_ERROR,
-        .num_protocols = 0,
-    };
-    unsigned int skip;
-    size_t max_payload_size;
-    size_t payload_size;
-    size_t entry_count;
-    size_t protocol_count, protocol_count_max;
-    size_t avail_protocol_count = 0;
+    size_t protocol_count_max;
     unsigned int index;
     uint8_t protocol_id;
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
     enum mod_res_perms_permissions perms;
 #else
     unsigned int dis_protocol_list_psci_index;
-    unsigned int protocol_count_psci;
     enum scmi_agent_type agent_type;
 #endif
-    unsigned int agent_id;
-
-    status = get_agent_id(service_id, &agent_id);
-    if (status != FWK_SUCCESS)
-        goto error;
-
-#ifndef BUILD_HAS_RESOURCE_PERMISSIONS
-    status = get_agent_type(agent_id, &agent_type);
-    if (status != FWK_SUCCESS)
-        goto error;
-#endif
-
-    status = get_max_payload_size(service_id, &max_payload_size);
-    if (status != FWK_SUCCESS)
-        goto error;
-
-    if (max_payload_size <
-        (sizeof(struct scmi_base_discover_list_protocols_p2a)
-         + sizeof(return_values.protocols[0]))) {
-        status = FWK_E_SIZE;
-        goto error;
-    }
-
-    entry_count = max_payload_size -
-                  sizeof(struct scmi_base_discover_list_protocols_p2a);
-
-    parameters = (const struct scmi_base_discover_list_protocols_a2p *)payload;
-    skip = parameters->skip;
 
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
-    protocol_count_max = (scmi_ctx.protocol_count < (skip + entry_count)) ?
-                         scmi_ctx.protocol_count : (skip + entry_count);
+    protocol_count_max = scmi_ctx.protocol_count;
 #else
+    agent_type = scmi_ctx.config->agent_table[agent_id].type;
 
     if (agent_type == SCMI_AGENT_TYPE_PSCI) {
         fwk_assert(
             scmi_ctx.protocol_count > scmi_ctx.config->dis_protocol_count_psci);
 
-        protocol_count_psci =
+        protocol_count_max =
             scmi_ctx.protocol_count - scmi_ctx.config->dis_protocol_count_psci;
-
-        protocol_count_max = (protocol_count_psci < (skip + entry_count)) ?
-            protocol_count_psci :
-            (skip + entry_count);
     } else
-        protocol_count_max = (scmi_ctx.protocol_count < (skip + entry_count)) ?
-            scmi_ctx.protocol_count :
-            (skip + entry_count);
+        protocol_count_max = scmi_ctx.protocol_count;
 #endif
 
-    for (index = 0,
-        protocol_count = 0,
-        payload_size = sizeof(struct scmi_base_discover_list_protocols_p2a);
+    for (index = 0, list->count = 0;
          (index < FWK_ARRAY_SIZE(scmi_ctx.scmi_protocol_id_to_idx)) &&
-         (protocol_count < protocol_count_max);
+         (list->count < protocol_count_max);
          index++) {
         if ((scmi_ctx.scmi_protocol_id_to_idx[index] == 0) ||
             (index == MOD_SCMI_PROTOCOL_ID_BASE))
@@ -983,23 +1639,81 @@ static int scmi_base_discover_list_protocols_handler(fwk_id_t service_id,
         }
 #endif
 
-        protocol_count++;
-        if (protocol_count <= skip)
-            continue;
+        list->protocols[list->count++] = protocol_id;
+    }
 
-        status = write_payload(service_id, payload_size, &protocol_id,
-                               sizeof(protocol_id));
-        if (status != FWK_SUCCESS)
-            goto error;
-        payload_size += sizeof(protocol_id);
-        avail_protocol_count++;
+    list->valid = true;
+}
+
+#ifdef BUILD_HAS_RESOURCE_PERMISSIONS
+static void scmi_base_invalidate_protocol_list(unsigned int agent_id)
+{
+    scmi_ctx.protocol_list_table[agent_id].valid = false;
+}
+#endif
+
+static int scmi_base_discover_list_protocols_handler(fwk_id_t service_id,
+                                                     const uint32_t *payload)
+{
+    int status;
+    const struct scmi_base_discover_list_protocols_a2p *parameters;
+    struct scmi_base_discover_list_protocols_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+        .num_protocols = 0,
+    };
+    struct scmi_protocol_list *list;
+    unsigned int skip;
+    size_t max_payload_size;
+    size_t payload_size;
+    size_t entry_count;
+    size_t avail_protocol_count;
+    unsigned int agent_id;
+
+    status = get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS)
+        goto error;
+
+    status = get_max_payload_size(service_id, &max_payload_size);
+    if (status != FWK_SUCCESS)
+        goto error;
+
+    if (max_payload_size <
+        (sizeof(struct scmi_base_discover_list_protocols_p2a)
+         + sizeof(return_values.protocols[0]))) {
+        status = FWK_E_SIZE;
+        goto error;
     }
 
-    if (skip > protocol_count) {
+    entry_count = max_payload_size -
+                  sizeof(struct scmi_base_discover_list_protocols_p2a);
+
+    parameters = (const struct scmi_base_discover_list_protocols_a2p *)payload;
+    skip = parameters->skip;
+
+    /*
+     * The list only depends on the bound protocols and the agent permissions,
+     * it is built on the first request and kept until the permissions change.
+     */
+    list = &scmi_ctx.protocol_list_table[agent_id];
+    if (!list->valid)
+        scmi_base_build_protocol_list(agent_id, list);
+
+    if (skip > list->count) {
         return_values.status = SCMI_INVALID_PARAMETERS;
         goto error;
     }
 
+    avail_protocol_count = FWK_MIN(list->count - skip, entry_count);
+    payload_size = sizeof(struct scmi_base_discover_list_protocols_p2a);
+
+    if (avail_protocol_count != 0) {
+        status = write_payload(service_id, payload_size,
+                               &list->protocols[skip], avail_protocol_count);
+        if (status != FWK_SUCCESS)
+            goto error;
+        payload_size += avail_protocol_count;
+    }
+
     return_values.status = SCMI_SUCCESS;
     return_values.num_protocols = avail_protocol_count;
 
@@ -1170,6 +1884,8 @@ static int scmi_base_set_protocol_permissions(
         parameters->command_id,
         parameters->flags);
 
+    scmi_base_invalidate_protocol_list(parameters->agent_id);
+
     switch (status) {
     case FWK_SUCCESS:
         return_values.status = SCMI_SUCCESS;
@@ -1226,6 +1942,8 @@ static int scmi_base_reset_agent_config(
     status = scmi_ctx.res_perms_api->agent_reset_config(
         parameters->agent_id, parameters->flags);
 
+    scmi_base_invalidate_protocol_list(parameters->agent_id);
+
     switch (status) {
     case FWK_SUCCESS:
         return_values.status = SCMI_SUCCESS;
@@ -1357,6 +2075,66 @@ static int scmi_init(fwk_id_t module_id, unsigned int service_count,
 
     scmi_ctx.service_ctx_table = fwk_mm_calloc(
         service_count, sizeof(scmi_ctx.service_ctx_table[0]));
+    scmi_ctx.service_count = service_count;
+
+    scmi_ctx.agent_vtime = fwk_mm_calloc(
+        config->agent_count + 1, sizeof(scmi_ctx.agent_vtime[0]));
+
+    scmi_ctx.protocol_list_table = fwk_mm_calloc(
+        config->agent_count + 1, sizeof(scmi_ctx.protocol_list_table[0]));
+    for (agent_idx = MOD_SCMI_PLATFORM_ID + 1;
+         agent_idx <= config->agent_count;
+         agent_idx++) {
+        scmi_ctx.protocol_list_table[agent_idx].protocols = fwk_mm_calloc(
+            config->protocol_count_max, sizeof(uint8_t));
+    }
+
+    if (config->telemetry_entry_count != 0) {
+        if (config->telemetry_entry_count > UINT16_MAX)
+            return FWK_E_PARAM;
+
+        scmi_ctx.telemetry_table = fwk_mm_calloc(
+            config->telemetry_entry_count,
+            sizeof(scmi_ctx.telemetry_table[0]));
+
+        scmi_ctx.telemetry_protocol_count =
+            config->protocol_count_max + PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT;
+        scmi_ctx.telemetry_index = fwk_mm_calloc(
+            (config->agent_count + 1) * scmi_ctx.telemetry_protocol_count *
+                SCMI_TELEMETRY_MESSAGE_ID_COUNT,
+            sizeof(scmi_ctx.telemetry_index[0]));
+    }
+
+    if ((config->fast_message_count != 0) &&
+        (config->fast_message_table == NULL))
+        return FWK_E_PARAM;
+
+    if (config->capture_record_count != 0) {
+        if (((config->capture_record_count &
+              (config->capture_record_count - 1)) != 0) ||
+            ((config->capture_payload_size % sizeof(uint32_t)) != 0) ||
+            (config->capture_payload_size > UINT16_MAX))
+            return FWK_E_PARAM;
+
+        if (config->capture_address == 0) {
+            scmi_ctx.capture = fwk_mm_alloc(
+                1,
+                mod_scmi_capture_size(
+                    config->capture_record_count,
+                    config->capture_payload_size));
+        } else {
+            scmi_ctx.capture =
+                (struct mod_scmi_capture_header *)config->capture_address;
+        }
+
+        *scmi_ctx.capture = (struct mod_scmi_capture_header){
+            .signature = MOD_SCMI_CAPTURE_SIGNATURE,
+            .record_count = config->capture_record_count,
+            .record_size = (uint32_t)(
+                sizeof(struct mod_scmi_capture_record) +
+                config->capture_payload_size),
+        };
+    }
 
     scmi_ctx.protocol_table[PROTOCOL_TABLE_BASE_PROTOCOL_IDX].message_handler =
         scmi_base_message_handler;
@@ -1382,6 +2160,12 @@ static int scmi_service_init(fwk_id_t service_id, unsigned int unused,
     ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
     ctx->config = config;
 
+#ifndef BUILD_HAS_RESOURCE_PERMISSIONS
+    ctx->is_psci_agent =
+        (scmi_ctx.config->agent_table[config->scmi_agent_id].type ==
+         SCMI_AGENT_TYPE_PSCI);
+#endif
+
 #ifdef BUILD_HAS_MULTITHREADING
     return fwk_thread_create(service_id);
 #else
@@ -1398,6 +2182,10 @@ static int scmi_bind(fwk_id_t id, unsigned int round)
     struct scmi_protocol *protocol;
     struct mod_scmi_to_protocol_api *protocol_api = NULL;
     uint8_t scmi_protocol_id;
+#ifndef BUILD_HAS_RESOURCE_PERMISSIONS
+    unsigned int index;
+    uint32_t denied_protocol_id;
+#endif
 
     if (round == 0) {
         if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
@@ -1453,6 +2241,23 @@ static int scmi_bind(fwk_id_t id, unsigned int round)
         protocol->message_handler = protocol_api->message_handler;
     }
 
+#ifndef BUILD_HAS_RESOURCE_PERMISSIONS
+    /*
+     * Resolve the protocols disabled for PSCI agents once rather than
+     * searching the list for every message.
+     */
+    for (index = 0; index < scmi_ctx.config->dis_protocol_count_psci;
+         index++) {
+        denied_protocol_id = scmi_ctx.config->dis_protocol_list_psci[index];
+        if (denied_protocol_id > MOD_SCMI_PROTOCOL_ID_MAX)
+            continue;
+
+        protocol_idx = scmi_ctx.scmi_protocol_id_to_idx[denied_protocol_id];
+        if (protocol_idx != 0)
+            scmi_ctx.protocol_table[protocol_idx].psci_denied = true;
+    }
+#endif
+
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
     status = fwk_module_bind(
         FWK_ID_MODULE(FWK_MODULE_IDX_RESOURCE_PERMS),
@@ -1506,6 +2311,20 @@ static int scmi_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
         break;
 #endif
 
+    case MOD_SCMI_API_IDX_TELEMETRY:
+        if (!fwk_id_is_type(target_id, FWK_ID_TYPE_MODULE))
+            return FWK_E_SUPPORT;
+
+        *api = &mod_scmi_telemetry_api;
+        break;
+
+    case MOD_SCMI_API_IDX_CAPTURE:
+        if (!fwk_id_is_type(target_id, FWK_ID_TYPE_MODULE))
+            return FWK_E_SUPPORT;
+
+        *api = &mod_scmi_capture_api;
+        break;
+
     default:
         return FWK_E_SUPPORT;
     };
@@ -1513,8 +2332,7 @@ static int scmi_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
     return FWK_SUCCESS;
 }
 
-static int scmi_process_event(const struct fwk_event *event,
-                              struct fwk_event *resp)
+static FWK_HOT int scmi_process_message(const struct fwk_event *event)
 {
     int status;
     struct scmi_service_ctx *ctx;
@@ -1524,11 +2342,6 @@ static int scmi_process_event(const struct fwk_event *event,
     const void *payload;
     size_t payload_size;
     unsigned int protocol_idx;
-#ifndef BUILD_HAS_RESOURCE_PERMISSIONS
-    enum scmi_agent_type agent_type;
-    unsigned int agent_id;
-    unsigned int dis_protocol_list_psci_index;
-#endif
     struct scmi_protocol *protocol;
     const char *service_name;
     const char *message_type_name;
@@ -1538,7 +2351,6 @@ static int scmi_process_event(const struct fwk_event *event,
     transport_id = ctx->transport_id;
 
     service_name = fwk_module_get_name(event->target_id);
-    message_type_name = message_type_to_str(ctx->scmi_message_type);
 
     status = transport_api->get_message_header(transport_id, &message_header);
     if (status != FWK_SUCCESS) {
@@ -1557,6 +2369,11 @@ static int scmi_process_event(const struct fwk_event *event,
     ctx->scmi_message_type = read_message_type(message_header);
     ctx->scmi_token = read_token(message_header);
 
+    message_type_name = message_type_to_str(ctx->scmi_message_type);
+
+    telemetry_record_dispatch(ctx);
+    capture_record_message(ctx, message_header, payload, payload_size);
+
     FWK_LOG_TRACE(
         "[SCMI] %s: %s [%" PRIu16 " (0x%x:0x%x)] was received",
         service_name,
@@ -1578,50 +2395,31 @@ static int scmi_process_event(const struct fwk_event *event,
             ctx->scmi_message_id);
         ctx->respond(transport_id, &(int32_t) { SCMI_NOT_SUPPORTED },
                      sizeof(int32_t));
+        capture_record_response(
+            ctx, &(int32_t){ SCMI_NOT_SUPPORTED }, sizeof(int32_t));
         return FWK_SUCCESS;
     }
 
-#ifndef BUILD_HAS_RESOURCE_PERMISSIONS
-    status = get_agent_id(event->target_id, &agent_id);
-    if (status != FWK_SUCCESS) {
-        FWK_LOG_ERR("[SCMI] %s: Unable to get agent id", service_name);
-        return status;
-    }
-
-    status = get_agent_type(agent_id, &agent_type);
-    if (status != FWK_SUCCESS) {
-        FWK_LOG_ERR("[SCMI] %s: Unable to get agent type", service_name);
-        return status;
-    }
+    protocol = &scmi_ctx.protocol_table[protocol_idx];
 
-    if (agent_type == SCMI_AGENT_TYPE_PSCI) {
-        /*
-         * check if the current protocol is within the disabled protocols
-         * list for PSCI agent.
-         */
-        for (dis_protocol_list_psci_index = 0; dis_protocol_list_psci_index <
-             scmi_ctx.config->dis_protocol_count_psci;
-             dis_protocol_list_psci_index++) {
-            if (ctx->scmi_protocol_id ==
-                scmi_ctx.config
-                    ->dis_protocol_list_psci[dis_protocol_list_psci_index]) {
-                FWK_LOG_ERR(
-                    "[SCMI] %s: %s [%" PRIu16
-                    "(0x%x:0x%x)] requested a denied protocol",
-                    service_name,
-                    message_type_name,
-                    ctx->scmi_token,
-                    ctx->scmi_protocol_id,
-                    ctx->scmi_message_id);
-                ctx->respond(
-                    transport_id, &(int32_t){ SCMI_DENIED }, sizeof(int32_t));
-                return FWK_SUCCESS;
-            }
-        }
+#ifndef BUILD_HAS_RESOURCE_PERMISSIONS
+    if (ctx->is_psci_agent && protocol->psci_denied) {
+        FWK_LOG_ERR(
+            "[SCMI] %s: %s [%" PRIu16
+            "(0x%x:0x%x)] requested a denied protocol",
+            service_name,
+            message_type_name,
+            ctx->scmi_token,
+            ctx->scmi_protocol_id,
+            ctx->scmi_message_id);
+        ctx->respond(
+            transport_id, &(int32_t){ SCMI_DENIED }, sizeof(int32_t));
+        capture_record_response(
+            ctx, &(int32_t){ SCMI_DENIED }, sizeof(int32_t));
+        return FWK_SUCCESS;
     }
 #endif
 
-    protocol = &scmi_ctx.protocol_table[protocol_idx];
     status = protocol->message_handler(protocol->id, event->target_id,
         payload, payload_size, ctx->scmi_message_id);
 
@@ -1641,6 +2439,37 @@ static int scmi_process_event(const struct fwk_event *event,
     return FWK_SUCCESS;
 }
 
+static FWK_HOT int scmi_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp)
+{
+    int status;
+
+    status = scmi_process_message(event);
+
+    /* Hand the next pending message, if any, to its service */
+    scheduler_complete();
+
+    return status;
+}
+
+static int scmi_process_signal(
+    const fwk_id_t target_id,
+    const fwk_id_t signal_id)
+{
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI, 0),
+        .source_id = target_id,
+        .target_id = target_id,
+    };
+
+    if (!fwk_id_is_equal(signal_id, scmi_signal_id_fast_message))
+        return FWK_E_PARAM;
+
+    /* The scheduler is not involved, there is nothing to complete */
+    return scmi_process_message(&event);
+}
+
 static int scmi_start(fwk_id_t id)
 {
 #ifdef BUILD_HAS_NOTIFICATION
@@ -1721,6 +2550,7 @@ const struct fwk_module module_scmi = {
     .start = scmi_start,
     .process_bind_request = scmi_process_bind_request,
     .process_event = scmi_process_event,
+    .process_signal = scmi_process_signal,
     #ifdef BUILD_HAS_NOTIFICATION
     .process_notification = scmi_process_notification,
     #endif
@@ -0,0 +1,258 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2018-2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI Agent Support.
+ */
+
+#ifndef MOD_SCMI_AGENT_H
+#define MOD_SCMI_AGENT_H
+
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupScmiAgent SCMI Agent
+ *
+ * \brief Sends SCMI messages to a platform on behalf of the firmware.
+ *
+ * \details Each element of the module is an agent owning one transport
+ *      channel. Messages are queued on the agent and sent in turn as soon as
+ *      the channel is free, without blocking the caller: the response to each
+ *      message is delivered to the requester as a
+ *      ::mod_scmi_agent_event_id_response event. Several messages may be
+ *      queued at once, and the agents run concurrently, so that as many
+ *      messages are outstanding as there are agents.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Maximum number of 32-bit words of a response payload delivered to
+ *      the requester.
+ *
+ * \details The first word is the SCMI status of the response. The words
+ *      beyond the maximum are dropped.
+ */
+#define MOD_SCMI_AGENT_RESPONSE_PAYLOAD_MAX 3
+
+/*!
+ * \brief Number of distinct tokens, after which the tokens wrap around.
+ */
+#define MOD_SCMI_AGENT_TOKEN_COUNT 1024
+
+/*!
+ * \brief SCMI message.
+ */
+struct mod_scmi_agent_message {
+    /*! Identifier of the protocol of the message */
+    uint8_t protocol_id;
+
+    /*! Identifier of the message within its protocol */
+    uint8_t message_id;
+
+    /*!
+     * \brief Payload of the message.
+     *
+     * \details May be NULL if the payload is empty. The payload is read when
+     *      the message is sent, so it must remain valid until the response to
+     *      the message is received.
+     */
+    const void *payload;
+
+    /*! Size of the payload in bytes */
+    size_t payload_size;
+};
+
+/*!
+ * \brief Agent configuration.
+ */
+struct mod_scmi_agent_config {
+    /*! Identifier of the transport channel of the agent */
+    fwk_id_t transport_id;
+
+    /*! Identifier of the ::mod_scmi_agent_transport_api API of the channel */
+    fwk_id_t transport_api_id;
+
+    /*!
+     * \brief Number of messages which may be queued on the agent.
+     *
+     * \details May be 0, in which case a single message may be queued.
+     */
+    unsigned int queue_depth;
+};
+
+/*!
+ * \brief Parameters of the response event.
+ *
+ * \details The token of the message is held in the \c cookie field of the
+ *      event.
+ */
+struct mod_scmi_agent_response_params {
+    /*!
+     * \brief Status of the transaction.
+     *
+     * \details ::FWK_SUCCESS if the response has been received, in which case
+     *      the SCMI status of the response is the first word of the payload.
+     *      One of the standard framework error codes otherwise.
+     */
+    int status;
+
+    /*! First words of the payload of the response */
+    uint32_t payload[MOD_SCMI_AGENT_RESPONSE_PAYLOAD_MAX];
+};
+
+/*!
+ * \brief SCMI agent API.
+ */
+struct mod_scmi_agent_api {
+    /*!
+     * \brief Queue a batch of messages on an agent.
+     *
+     * \details The messages are sent in order, each one as soon as the
+     *      response to the previous one has been received, and the response
+     *      to each of them is delivered to the requester as a
+     *      ::mod_scmi_agent_event_id_response event. The messages are given
+     *      consecutive tokens, modulo ::MOD_SCMI_AGENT_TOKEN_COUNT.
+     *
+     * \param agent_id Agent identifier.
+     * \param requester_id Identifier of the entity the responses are sent to.
+     * \param messages Table of the messages.
+     * \param count Number of messages in the table.
+     * \param[out] token Token of the first message. May be NULL.
+     *
+     * \retval ::FWK_SUCCESS The messages have been queued.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_BUSY There is not enough room left in the queue of the
+     *      agent for the batch, none of the messages has been queued.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*send)(
+        fwk_id_t agent_id,
+        fwk_id_t requester_id,
+        const struct mod_scmi_agent_message *messages,
+        unsigned int count,
+        unsigned int *token);
+};
+
+/*!
+ * \brief Transport API.
+ *
+ * \details Interface implemented by the transport channels of the agents.
+ */
+struct mod_scmi_agent_transport_api {
+    /*!
+     * \brief Check if a channel is free to use or not.
+     *
+     * \param channel_id Channel identifier.
+     *
+     * \retval true The channel is free and a message can be sent.
+     * \retval false The channel is busy.
+     */
+    bool (*is_channel_free)(fwk_id_t channel_id);
+
+    /*!
+     * \brief Send an SCMI message to the platform.
+     *
+     * \param channel_id Channel identifier.
+     * \param message Message to send.
+     * \param token Token of the message.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*send)(
+        fwk_id_t channel_id,
+        const struct mod_scmi_agent_message *message,
+        unsigned int token);
+
+    /*!
+     * \brief Get the SCMI message header of the response from a channel.
+     *
+     * \param channel_id Channel identifier.
+     * \param[out] message_header The SCMI message header.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*get_message_header)(fwk_id_t channel_id, uint32_t *message_header);
+
+    /*!
+     * \brief Get the SCMI payload of the response from a channel.
+     *
+     * \param channel_id Channel identifier.
+     * \param[out] payload The pointer to the payload.
+     * \param[out] size The payload size. May be NULL, in which case the
+     *      parameter should be ignored.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*get_payload)(fwk_id_t channel_id, const void **payload, size_t *size);
+
+    /*!
+     * \brief Release a channel.
+     *
+     * \param channel_id Channel identifier.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*put_channel)(fwk_id_t channel_id);
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_scmi_agent_api_idx {
+    /*! SCMI agent API, see ::mod_scmi_agent_api */
+    MOD_SCMI_AGENT_API_IDX_AGENT,
+
+    /*! Number of defined APIs */
+    MOD_SCMI_AGENT_API_IDX_COUNT,
+};
+
+/*!
+ * \brief Event indices.
+ */
+enum mod_scmi_agent_event_idx {
+    /*! Response to a message, see ::mod_scmi_agent_response_params */
+    MOD_SCMI_AGENT_EVENT_IDX_RESPONSE,
+
+    /*! Number of defined public events */
+    MOD_SCMI_AGENT_EVENT_IDX_COUNT,
+};
+
+/*!
+ * \brief Identifier of the ::MOD_SCMI_AGENT_EVENT_IDX_RESPONSE event.
+ */
+static const fwk_id_t mod_scmi_agent_event_id_response = FWK_ID_EVENT_INIT(
+    FWK_MODULE_IDX_SCMI_AGENT,
+    MOD_SCMI_AGENT_EVENT_IDX_RESPONSE);
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SCMI_AGENT_H */
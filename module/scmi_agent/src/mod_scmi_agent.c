@@ -0,0 +1,369 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2018-2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI Agent Support.
+ */
+
+#include <mod_scmi_agent.h>
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Position of the token in the SCMI message header */
+#define SCMI_AGENT_HEADER_TOKEN_POS 18
+
+/* Event indices */
+enum scmi_agent_event_idx {
+    /* Send the next message or check for the response to the current one */
+    SCMI_AGENT_EVENT_IDX_PROCESS = MOD_SCMI_AGENT_EVENT_IDX_COUNT,
+
+    /* Number of events */
+    SCMI_AGENT_EVENT_IDX_COUNT
+};
+
+/* Message queued on an agent */
+struct scmi_agent_request {
+    /* Identifier of the entity the response is sent to */
+    fwk_id_t requester_id;
+
+    /* Message */
+    struct mod_scmi_agent_message message;
+
+    /* Token of the message */
+    unsigned int token;
+};
+
+/* SCMI agent context */
+struct scmi_agent_ctx {
+    /* Pointer to agent configuration data */
+    const struct mod_scmi_agent_config *config;
+
+    /* Transport API */
+    const struct mod_scmi_agent_transport_api *transport_api;
+
+    /* Queue of the messages, the first one being sent when in flight */
+    struct scmi_agent_request *queue;
+
+    /* Number of entries of the queue */
+    unsigned int queue_depth;
+
+    /* Index of the first message of the queue */
+    unsigned int head;
+
+    /* Number of messages in the queue */
+    unsigned int count;
+
+    /* The first message of the queue has been sent */
+    bool in_flight;
+
+    /* A process event is pending for the agent */
+    bool process_pending;
+
+    /* Token of the next message queued */
+    unsigned int next_token;
+};
+
+/* Module context */
+struct mod_scmi_agent_module_ctx {
+    /* Pointer to agent context table */
+    struct scmi_agent_ctx *agent_ctx_table;
+};
+
+static struct mod_scmi_agent_module_ctx ctx;
+
+static int scmi_agent_schedule(fwk_id_t agent_id, struct scmi_agent_ctx *agent)
+{
+    int status;
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(
+            FWK_MODULE_IDX_SCMI_AGENT, SCMI_AGENT_EVENT_IDX_PROCESS),
+        .source_id = agent_id,
+        .target_id = agent_id,
+    };
+
+    if (agent->process_pending)
+        return FWK_SUCCESS;
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_SUCCESS)
+        agent->process_pending = true;
+
+    return status;
+}
+
+static int scmi_agent_respond(
+    const struct scmi_agent_request *request,
+    fwk_id_t agent_id,
+    int transaction_status,
+    const void *payload,
+    size_t size)
+{
+    struct mod_scmi_agent_response_params *params;
+    struct fwk_event event = {
+        .id = mod_scmi_agent_event_id_response,
+        .source_id = agent_id,
+        .target_id = request->requester_id,
+        .cookie = request->token,
+    };
+
+    params = (struct mod_scmi_agent_response_params *)event.params;
+    params->status = transaction_status;
+    if (payload != NULL) {
+        size = FWK_MIN(size, sizeof(params->payload));
+        memcpy(params->payload, payload, size);
+    }
+
+    return fwk_thread_put_event(&event);
+}
+
+/*
+ * Collect the response to the message in flight. Returns false if the
+ * platform has not responded yet.
+ */
+static bool scmi_agent_complete(
+    fwk_id_t agent_id,
+    struct scmi_agent_ctx *agent)
+{
+    const struct scmi_agent_request *request = &agent->queue[agent->head];
+    fwk_id_t transport_id = agent->config->transport_id;
+    const void *payload = NULL;
+    uint32_t header;
+    size_t size = 0;
+    int transaction_status;
+    int status;
+
+    if (!agent->transport_api->is_channel_free(transport_id))
+        return false;
+
+    transaction_status =
+        agent->transport_api->get_message_header(transport_id, &header);
+    if (transaction_status == FWK_SUCCESS) {
+        if (((header >> SCMI_AGENT_HEADER_TOKEN_POS) %
+             MOD_SCMI_AGENT_TOKEN_COUNT) != request->token) {
+            FWK_LOG_ERR(
+                "[SCMI AGENT] Unexpected token in the response to %u",
+                request->token);
+            transaction_status = FWK_E_DEVICE;
+        } else {
+            transaction_status = agent->transport_api->get_payload(
+                transport_id, &payload, &size);
+        }
+    }
+
+    status = scmi_agent_respond(
+        request, agent_id, transaction_status, payload, size);
+    fwk_assert(status == FWK_SUCCESS);
+
+    status = agent->transport_api->put_channel(transport_id);
+    fwk_assert(status == FWK_SUCCESS);
+
+    agent->in_flight = false;
+    agent->head = (agent->head + 1) % agent->queue_depth;
+    agent->count--;
+
+    return true;
+}
+
+/*
+ * Send the first message of the queue. Returns false if the channel is not
+ * free yet.
+ */
+static bool scmi_agent_issue(fwk_id_t agent_id, struct scmi_agent_ctx *agent)
+{
+    const struct scmi_agent_request *request = &agent->queue[agent->head];
+    fwk_id_t transport_id = agent->config->transport_id;
+    int status;
+
+    if (!agent->transport_api->is_channel_free(transport_id))
+        return false;
+
+    status = agent->transport_api->send(
+        transport_id, &request->message, request->token);
+    if (status == FWK_SUCCESS) {
+        agent->in_flight = true;
+        return true;
+    }
+
+    agent->transport_api->put_channel(transport_id);
+
+    status = scmi_agent_respond(request, agent_id, status, NULL, 0);
+    fwk_assert(status == FWK_SUCCESS);
+
+    agent->head = (agent->head + 1) % agent->queue_depth;
+    agent->count--;
+
+    return true;
+}
+
+/*
+ * SCMI Agent API interface
+ */
+static int agent_send(
+    fwk_id_t agent_id,
+    fwk_id_t requester_id,
+    const struct mod_scmi_agent_message *messages,
+    unsigned int count,
+    unsigned int *token)
+{
+    struct scmi_agent_ctx *agent;
+    struct scmi_agent_request *request;
+    unsigned int i;
+
+    if ((fwk_id_get_module_idx(agent_id) != FWK_MODULE_IDX_SCMI_AGENT) ||
+        !fwk_module_is_valid_element_id(agent_id) || (messages == NULL) ||
+        (count == 0))
+        return FWK_E_PARAM;
+
+    agent = &ctx.agent_ctx_table[fwk_id_get_element_idx(agent_id)];
+
+    if (count > (agent->queue_depth - agent->count))
+        return FWK_E_BUSY;
+
+    if (token != NULL)
+        *token = agent->next_token;
+
+    for (i = 0; i < count; i++) {
+        request = &agent->queue
+                       [(agent->head + agent->count + i) % agent->queue_depth];
+        request->requester_id = requester_id;
+        request->message = messages[i];
+        request->token = agent->next_token;
+
+        agent->next_token =
+            (agent->next_token + 1) % MOD_SCMI_AGENT_TOKEN_COUNT;
+    }
+
+    agent->count += count;
+
+    return scmi_agent_schedule(agent_id, agent);
+}
+
+static const struct mod_scmi_agent_api scmi_agent_api = {
+    .send = agent_send,
+};
+
+/*
+ * Functions fulfilling the framework's module interface
+ */
+
+static int scmi_agent_init(
+    fwk_id_t module_id,
+    unsigned int agent_count,
+    const void *unused)
+{
+    ctx.agent_ctx_table =
+        fwk_mm_calloc(agent_count, sizeof(ctx.agent_ctx_table[0]));
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_agent_element_init(
+    fwk_id_t agent_id,
+    unsigned int unused,
+    const void *data)
+{
+    struct scmi_agent_ctx *agent;
+    const struct mod_scmi_agent_config *config = data;
+
+    if (config == NULL)
+        return FWK_E_PARAM;
+
+    agent = &ctx.agent_ctx_table[fwk_id_get_element_idx(agent_id)];
+    agent->config = config;
+    agent->queue_depth = FWK_MAX(config->queue_depth, 1u);
+    agent->queue = fwk_mm_calloc(agent->queue_depth, sizeof(agent->queue[0]));
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_agent_bind(fwk_id_t id, unsigned int round)
+{
+    struct scmi_agent_ctx *agent;
+
+    if ((round != 0) || fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+        return FWK_SUCCESS;
+
+    agent = &ctx.agent_ctx_table[fwk_id_get_element_idx(id)];
+
+    return fwk_module_bind(
+        agent->config->transport_id,
+        agent->config->transport_api_id,
+        &agent->transport_api);
+}
+
+static int scmi_agent_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    if (fwk_id_get_api_idx(api_id) != MOD_SCMI_AGENT_API_IDX_AGENT)
+        return FWK_E_PARAM;
+
+    *api = &scmi_agent_api;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_agent_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp)
+{
+    struct scmi_agent_ctx *agent;
+    bool progress;
+
+    if (fwk_id_get_event_idx(event->id) != SCMI_AGENT_EVENT_IDX_PROCESS)
+        return FWK_E_PARAM;
+
+    agent = &ctx.agent_ctx_table[fwk_id_get_element_idx(event->target_id)];
+    agent->process_pending = false;
+
+    /*
+     * Move the queue forward as far as possible, then come back once the
+     * other pending events have been processed rather than wait for the
+     * platform here.
+     */
+    while (agent->count != 0) {
+        if (agent->in_flight)
+            progress = scmi_agent_complete(event->target_id, agent);
+        else
+            progress = scmi_agent_issue(event->target_id, agent);
+
+        if (!progress)
+            break;
+    }
+
+    if (agent->count == 0)
+        return FWK_SUCCESS;
+
+    return scmi_agent_schedule(event->target_id, agent);
+}
+
+const struct fwk_module module_scmi_agent = {
+    .name = "SCMI AGENT",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_SCMI_AGENT_API_IDX_COUNT,
+    .event_count = SCMI_AGENT_EVENT_IDX_COUNT,
+    .init = scmi_agent_init,
+    .element_init = scmi_agent_element_init,
+    .bind = scmi_agent_bind,
+    .process_bind_request = scmi_agent_process_bind_request,
+    .process_event = scmi_agent_process_event,
+};
@@ -37,14 +37,6 @@ enum scmi_clock_event_idx {
     SCMI_CLOCK_EVENT_IDX_COUNT,
 };
 
-/*
- * Container for the data when 'set_rate' operation is requested
- */
-struct event_set_rate_request_data {
-    uint32_t rate[2];
-    enum mod_clock_round_mode round_mode;
-};
-
 /*
  * Container for the data when 'set_state' operation is requested
  */
@@ -56,7 +48,6 @@ struct event_set_state_request_data {
  * Container for the data when 'set_' operation is requested
  */
 union event_request_data {
-    struct event_set_rate_request_data set_rate_data;
     struct event_set_state_request_data set_state_data;
 };
 
@@ -161,7 +152,7 @@ struct scmi_clock_rate_get_p2a {
 #define SCMI_CLOCK_RATE_SET_FLAGS_MASK \
     (SCMI_CLOCK_RATE_SET_ASYNC_MASK | \
      SCMI_CLOCK_RATE_SET_NO_DELAYED_RESPONSE_MASK | \
-     SCMI_CLOCK_RATE_SET_ROUND_UP_POS | SCMI_CLOCK_RATE_SET_ROUND_AUTO_POS)
+     SCMI_CLOCK_RATE_SET_ROUND_UP_MASK | SCMI_CLOCK_RATE_SET_ROUND_AUTO_MASK)
 
 struct scmi_clock_rate_set_a2p {
     uint32_t flags;
@@ -173,6 +164,12 @@ struct scmi_clock_rate_set_p2a {
     int32_t status;
 };
 
+struct scmi_clock_rate_set_complete_p2a {
+    int32_t status;
+    uint32_t clock_id;
+    uint32_t rate[2];
+};
+
 /*
  * Clock Config Set
  */
@@ -18,6 +18,7 @@
 #include <fwk_attributes.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
+#include <fwk_list.h>
 #include <fwk_log.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
@@ -33,6 +34,42 @@
 #    include <mod_resource_perms.h>
 #endif
 
+/*
+ * Clock rate set request waiting for, or taking part in, a rate change.
+ *
+ * Requests are kept in event payload buffers. The request whose rate is
+ * applied is the payload of the set rate event.
+ */
+struct scmi_clock_rate_request {
+    /* Linked list node */
+    struct fwk_slist_node node;
+
+    /* Service identifier of the requester */
+    fwk_id_t service_id;
+
+    /* Identifier of the clock in the agent's view */
+    uint32_t clock_id;
+
+    /* Requested rate */
+    uint64_t rate;
+
+    /* Requested rounding mode */
+    enum mod_clock_round_mode round_mode;
+
+    /* The requester has already been responded to */
+    bool async;
+
+    /* A delayed response is sent on completion */
+    bool delayed_response;
+
+    /* Token of the command, for the delayed response */
+    uint16_t token;
+};
+
+static_assert(
+    sizeof(struct scmi_clock_rate_request) <= FWK_EVENT_PAYLOAD_SIZE,
+    "Clock rate set request does not fit in an event payload");
+
 struct clock_operations {
     /*
      * Service identifier currently requesting operation from this clock.
@@ -54,8 +91,27 @@ struct clock_operations {
      * Request type for this operation.
      */
     enum scmi_clock_request_type request;
+
+    /*
+     * Rate set requests received while the clock was busy, in order of
+     * arrival.
+     */
+    struct fwk_slist rate_queue;
+
+    /*
+     * Rate set requests answered when the ongoing rate change completes.
+     */
+    struct fwk_slist rate_batch;
+
+    /*
+     * Request of the batch whose rate is being applied.
+     */
+    struct scmi_clock_rate_request *rate_request;
 };
 
+/* Number of clock devices tracked by a word of an agent's enable bitmap */
+#define SCMI_CLOCK_BITMAP_WORD_BITS 32
+
 struct scmi_clock_ctx {
     /*! SCMI Clock Module Configuration */
     const struct mod_scmi_clock_config *config;
@@ -78,9 +134,24 @@ struct scmi_clock_ctx {
     /* Number of clock devices */
     int clock_devices;
 
+    /* Table of clock reference counts, indexed by clock device */
+    unsigned int *clock_ref_count;
+
+    /*
+     * Table of the bitmaps of the clock devices each agent has enabled,
+     * indexed by agent then by word
+     */
+    uint32_t *agent_clock_enabled;
+
+    /* Number of words of an agent's enable bitmap */
+    unsigned int clock_bitmap_word_count;
+
     /* Pointer to a table of clock operations */
     struct clock_operations *clock_ops;
 
+    /* Number of asynchronous clock rate changes pending */
+    unsigned int async_rate_request_count;
+
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
     /* SCMI Resource Permissions API */
     const struct mod_res_permissions_api *res_perms_api;
@@ -215,69 +286,19 @@ static int get_clock_device_entry(
 }
 
 /*
- * Given a service identifier and a clock index, retrieve the state
- * for that agent:clock
- */
-static int get_agent_clock_state(
-    uint8_t *state,
-    fwk_id_t service_id,
-    unsigned int clock_idx,
-    uint8_t *agent_clock_state)
-{
-    unsigned int agent_id;
-    const struct mod_scmi_clock_agent *agent_entry;
-    int idx;
-    int status;
-
-    status = get_agent_entry(service_id, &agent_entry);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    if (clock_idx >= agent_entry->device_count)
-        return FWK_E_RANGE;
-
-    status = scmi_clock_ctx.scmi_api->get_agent_id(service_id, &agent_id);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    idx = (agent_id * scmi_clock_ctx.clock_devices) + clock_idx;
-
-    *state = agent_clock_state[idx];
-
-    return FWK_SUCCESS;
-}
-
-/*
- * Given a service identifier and a clock index, set the state
- * for that agent:clock
+ * Given an agent and a clock device index, retrieve the bit of the clock
+ * within the agent's enable bitmap
  */
-static int set_agent_clock_state(
-    uint8_t *agent_clock_state,
-    uint8_t state,
-    fwk_id_t service_id,
-    unsigned int clock_idx)
+static uint32_t *get_agent_clock_word(
+    unsigned int agent_id,
+    unsigned int clock_dev_idx,
+    uint32_t *mask)
 {
-    unsigned int agent_id;
-    const struct mod_scmi_clock_agent *agent_entry;
-    int idx;
-    int status;
-
-    status = get_agent_entry(service_id, &agent_entry);
-    if (status != FWK_SUCCESS)
-        return status;
+    *mask = UINT32_C(1) << (clock_dev_idx % SCMI_CLOCK_BITMAP_WORD_BITS);
 
-    if (clock_idx >= agent_entry->device_count)
-        return FWK_E_RANGE;
-
-    status = scmi_clock_ctx.scmi_api->get_agent_id(service_id, &agent_id);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    idx = (agent_id * scmi_clock_ctx.clock_devices) + clock_idx;
-
-    agent_clock_state[idx] = state;
-
-    return FWK_SUCCESS;
+    return &scmi_clock_ctx.agent_clock_enabled
+                [(agent_id * scmi_clock_ctx.clock_bitmap_word_count) +
+                 (clock_dev_idx / SCMI_CLOCK_BITMAP_WORD_BITS)];
 }
 
 /*
@@ -408,18 +429,23 @@ static void request_response(int response_status,
 /*
  * Helper for the 'set_' responses
  */
-static void set_request_respond(fwk_id_t service_id, int status)
+static int32_t set_request_status(int status)
 {
-    struct scmi_clock_generic_p2a return_values = { 0 };
-
     if (status == FWK_E_RANGE || status == FWK_E_PARAM)
-        return_values.status = SCMI_INVALID_PARAMETERS;
+        return SCMI_INVALID_PARAMETERS;
     else if (status == FWK_E_SUPPORT)
-        return_values.status = SCMI_NOT_SUPPORTED;
+        return SCMI_NOT_SUPPORTED;
     else if (status != FWK_SUCCESS)
-        return_values.status = SCMI_GENERIC_ERROR;
+        return SCMI_GENERIC_ERROR;
     else
-        return_values.status = SCMI_SUCCESS;
+        return SCMI_SUCCESS;
+}
+
+static void set_request_respond(fwk_id_t service_id, int status)
+{
+    struct scmi_clock_generic_p2a return_values = {
+        .status = set_request_status(status)
+    };
 
     scmi_clock_ctx.scmi_api->respond(service_id,
                                      &return_values,
@@ -446,94 +472,71 @@ FWK_WEAK int mod_scmi_clock_config_set_policy(
     fwk_id_t service_id,
     uint32_t clock_dev_id)
 {
-    /* Pointer to a table of clock reference counts */
-    static uint8_t *clock_count = NULL;
-    /* Pointer to a table of agent:clock states */
-    static uint8_t *agent_clock_state = NULL;
-
     const struct mod_scmi_clock_agent *agent;
-
-    unsigned int agent_id, clock_id, idx;
+    unsigned int agent_id, clock_dev_idx;
+    unsigned int *ref_count;
+    uint32_t *enabled_word;
+    uint32_t enabled_mask;
     int status = FWK_SUCCESS;
-    uint8_t clock_state;
 
     *policy_status = MOD_SCMI_CLOCK_SKIP_MESSAGE_HANDLER;
 
-    if (agent_clock_state == NULL) {
-        /* Allocate table of agent:clock states */
-        agent_clock_state = fwk_mm_calloc(
-            (unsigned int)scmi_clock_ctx.config->agent_count *
-                (unsigned int)scmi_clock_ctx.clock_devices,
-            sizeof(uint8_t));
-
-        /* Allocate table of clock reference counts */
-        clock_count = fwk_mm_calloc(
-            (unsigned int)scmi_clock_ctx.clock_devices, sizeof(uint32_t));
-
-        /* Set all clocks as running if required */
-        for (agent_id = 0;
-             agent_id < (unsigned int)scmi_clock_ctx.config->agent_count;
-             agent_id++) {
-            agent = &scmi_clock_ctx.agent_table[agent_id];
-            for (clock_id = 0; clock_id < (unsigned int)agent->device_count;
-                 clock_id++) {
-                if (agent->device_table[clock_id].starts_enabled) {
-                    idx = (agent_id * scmi_clock_ctx.clock_devices) + clock_id;
-                    agent_clock_state[idx] = MOD_CLOCK_STATE_RUNNING;
-
-                    clock_count[clock_id]++;
-                }
-            }
-        }
-    }
+    status = scmi_clock_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (agent_id >= scmi_clock_ctx.config->agent_count)
+        return FWK_E_PARAM;
+
+    agent = &scmi_clock_ctx.agent_table[agent_id];
+    if (clock_dev_id >= agent->device_count)
+        return FWK_E_RANGE;
 
     /*
-     * clock state is the last state this agent successfully set
+     * The reference count is kept per clock device, so that the agents
+     * sharing a clock share its count.
+     */
+    clock_dev_idx =
+        fwk_id_get_element_idx(agent->device_table[clock_dev_id].element_id);
+    ref_count = &scmi_clock_ctx.clock_ref_count[clock_dev_idx];
+
+    /*
+     * The enable bit is the last state this agent successfully set
      * for this clock.
      */
-    status = get_agent_clock_state(
-        &clock_state, service_id, clock_dev_id, agent_clock_state);
-    if (status != FWK_SUCCESS)
-        return status;
+    enabled_word =
+        get_agent_clock_word(agent_id, clock_dev_idx, &enabled_mask);
 
     switch (*state) {
     case MOD_CLOCK_STATE_RUNNING:
         /* The agent has already requested to set state to RUNNING */
-        if (clock_state == MOD_CLOCK_STATE_RUNNING) {
+        if ((*enabled_word & enabled_mask) != 0) {
             status = FWK_SUCCESS;
             break;
         }
 
-        /* set the clock state for this agent to RUNNING */
-        if (policy_commit == MOD_SCMI_CLOCK_POST_MESSAGE_HANDLER) {
-            set_agent_clock_state(
-                agent_clock_state,
-                MOD_CLOCK_STATE_RUNNING,
-                service_id,
-                clock_dev_id);
-        }
-
         /*
-         * Only allow the clock to be stopped if clock_count == 0
+         * Only allow the clock to be started if the reference count is 0
          * before being updated for this call.
          *
          * This is the first agent to set the clock RUNNING.
          */
-        if (clock_count[clock_dev_id] != 0)
+        if (*ref_count != 0)
             status = FWK_E_STATE;
-        if (policy_commit == MOD_SCMI_CLOCK_POST_MESSAGE_HANDLER)
-            clock_count[clock_dev_id]++;
+        if (policy_commit == MOD_SCMI_CLOCK_POST_MESSAGE_HANDLER) {
+            *enabled_word |= enabled_mask;
+            (*ref_count)++;
+        }
         break;
 
     case MOD_CLOCK_STATE_STOPPED:
         /* The agent has already requested to set state to STOPPED */
-        if (clock_state == MOD_CLOCK_STATE_STOPPED) {
+        if ((*enabled_word & enabled_mask) == 0) {
             status = FWK_SUCCESS;
             break;
         }
         /* error to try and stop a stopped clock */
-        if (clock_count[clock_dev_id] == 0) {
-            scmi_clock_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+        if (*ref_count == 0) {
             FWK_LOG_WARN(
                 "[SCMI-CLK] Invalid STOP request agent:"
                 " %d clock_id: %d state:%d\n",
@@ -543,25 +546,18 @@ FWK_WEAK int mod_scmi_clock_config_set_policy(
             return FWK_E_STATE;
         }
 
-        /* set the clock state for this agent to STOPPED */
-        if (policy_commit == MOD_SCMI_CLOCK_POST_MESSAGE_HANDLER) {
-            set_agent_clock_state(
-                agent_clock_state,
-                MOD_CLOCK_STATE_STOPPED,
-                service_id,
-                clock_dev_id);
-        }
-
         /*
-         * Only allow the clock to be stopped if ref_clk_count == 0
+         * Only allow the clock to be stopped if the reference count is 0
          * after being updated for this call.
          *
          * This is the last agent to set the clock STOPPED.
          */
-        if (clock_count[clock_dev_id] != 1)
+        if (*ref_count != 1)
             status = FWK_E_STATE;
-        if (policy_commit == MOD_SCMI_CLOCK_POST_MESSAGE_HANDLER)
-            clock_count[clock_dev_id]--;
+        if (policy_commit == MOD_SCMI_CLOCK_POST_MESSAGE_HANDLER) {
+            *enabled_word &= ~enabled_mask;
+            (*ref_count)--;
+        }
         break;
 
     default:
@@ -679,17 +675,8 @@ static int create_event_request(
         break;
 
     case SCMI_CLOCK_REQUEST_SET_RATE:
-        {
-        struct event_set_rate_request_data *rate_data =
-            (struct event_set_rate_request_data *)data;
-
-        request_data.set_rate_data.rate[0] = rate_data->rate[0];
-        request_data.set_rate_data.rate[1] = rate_data->rate[1];
-        request_data.set_rate_data.round_mode = rate_data->round_mode;
-
-        params->request_data = request_data;
-        }
-
+        /* The event holds its own reference to the rate set request */
+        event.payload = data;
         event.id = mod_scmi_clock_event_id_set_rate;
         break;
 
@@ -721,6 +708,158 @@ static int create_event_request(
     return FWK_SUCCESS;
 }
 
+/*
+ * Helpers for the clock rate set queue
+ */
+static int rate_request_submit(
+    fwk_id_t clock_dev_id,
+    fwk_id_t service_id,
+    uint32_t clock_id,
+    uint64_t rate,
+    enum mod_clock_round_mode round_mode,
+    bool async,
+    bool delayed_response)
+{
+    int status;
+    struct clock_operations *ops =
+        &scmi_clock_ctx.clock_ops[fwk_id_get_element_idx(clock_dev_id)];
+    struct scmi_clock_rate_request *request;
+    uint16_t token = 0;
+
+    if (async && (scmi_clock_ctx.async_rate_request_count >=
+                  scmi_clock_ctx.max_pending_transactions))
+        return FWK_E_BUSY;
+
+    if (delayed_response) {
+        status = scmi_clock_ctx.scmi_api->get_token(service_id, &token);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    request = fwk_event_payload_alloc();
+    if (request == NULL)
+        return FWK_E_BUSY;
+
+    request->node = (struct fwk_slist_node){ 0 };
+    request->service_id = service_id;
+    request->clock_id = clock_id;
+    request->rate = rate;
+    request->round_mode = round_mode;
+    request->async = async;
+    request->delayed_response = delayed_response;
+    request->token = token;
+
+    if (async)
+        scmi_clock_ctx.async_rate_request_count++;
+
+    fwk_list_push_tail(&ops->rate_queue, &request->node);
+
+    return FWK_SUCCESS;
+}
+
+static void rate_request_respond(
+    struct scmi_clock_rate_request *request,
+    const struct scmi_clock_rate_request *applied,
+    int status)
+{
+    struct scmi_clock_rate_set_complete_p2a return_values;
+
+    if (!request->async) {
+        set_request_respond(request->service_id, status);
+        return;
+    }
+
+    scmi_clock_ctx.async_rate_request_count--;
+
+    if (!request->delayed_response)
+        return;
+
+    return_values = (struct scmi_clock_rate_set_complete_p2a) {
+        .status = set_request_status(status),
+        .clock_id = request->clock_id,
+        .rate[0] = (uint32_t)applied->rate,
+        .rate[1] = (uint32_t)(applied->rate >> 32),
+    };
+
+    scmi_clock_ctx.scmi_api->respond_delayed(
+        request->service_id,
+        MOD_SCMI_PROTOCOL_ID_CLOCK,
+        MOD_SCMI_CLOCK_RATE_SET,
+        request->token,
+        &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+            sizeof(return_values) : sizeof(return_values.status));
+}
+
+/*
+ * Answer all the requests that took part in the rate change of a clock.
+ */
+static void rate_batch_complete(unsigned int clock_dev_idx, int status)
+{
+    struct clock_operations *ops = &scmi_clock_ctx.clock_ops[clock_dev_idx];
+    struct scmi_clock_rate_request *request;
+
+    while (!fwk_list_is_empty(&ops->rate_batch)) {
+        request = FWK_LIST_GET(fwk_list_pop_head(&ops->rate_batch),
+            struct scmi_clock_rate_request, node);
+
+        rate_request_respond(request, ops->rate_request, status);
+
+        fwk_event_payload_release(request);
+    }
+
+    ops->rate_request = NULL;
+}
+
+/*
+ * Start a rate change for the requests queued on a clock, if it is available.
+ *
+ * The request at the head of the queue is coalesced with the requests of the
+ * same agent and rounding mode queued right after it: only the rate of the
+ * latest of them is applied and all of them are answered with its outcome.
+ * The requests of the other agents are applied in turn, each with its own
+ * outcome.
+ */
+static void rate_queue_run(unsigned int clock_dev_idx)
+{
+    int status;
+    struct clock_operations *ops = &scmi_clock_ctx.clock_ops[clock_dev_idx];
+    struct fwk_slist_node *node;
+    struct scmi_clock_rate_request *request;
+    struct scmi_clock_rate_request *next;
+
+    while (clock_ops_is_available(clock_dev_idx) &&
+           !fwk_list_is_empty(&ops->rate_queue)) {
+        node = fwk_list_pop_head(&ops->rate_queue);
+        fwk_list_push_tail(&ops->rate_batch, node);
+        request = FWK_LIST_GET(node, struct scmi_clock_rate_request, node);
+
+        while ((node = fwk_list_head(&ops->rate_queue)) != NULL) {
+            next = FWK_LIST_GET(node, struct scmi_clock_rate_request, node);
+            if (!fwk_id_is_equal(next->service_id, request->service_id) ||
+                (next->round_mode != request->round_mode))
+                break;
+
+            fwk_list_push_tail(
+                &ops->rate_batch, fwk_list_pop_head(&ops->rate_queue));
+            request = next;
+        }
+
+        ops->rate_request = request;
+
+        status = create_event_request(
+            fwk_id_build_element_id(fwk_module_id_clock, clock_dev_idx),
+            request->service_id,
+            SCMI_CLOCK_REQUEST_SET_RATE,
+            request,
+            request->clock_id);
+        if (status == FWK_SUCCESS)
+            return;
+
+        rate_batch_complete(clock_dev_idx, status);
+    }
+}
+
 /*
  * Protocol Version
  */
@@ -899,7 +1038,7 @@ exit:
 }
 
 /*
- * Clock Rate Set (Synchronous Only)
+ * Clock Rate Set
  */
 static int scmi_clock_rate_set_handler(fwk_id_t service_id,
     const uint32_t *payload)
@@ -910,6 +1049,7 @@ static int scmi_clock_rate_set_handler(fwk_id_t service_id,
     bool round_auto;
     bool round_up;
     bool asynchronous;
+    bool delayed_response;
     size_t response_size;
     unsigned int agent_id;
     uint64_t rate;
@@ -924,6 +1064,8 @@ static int scmi_clock_rate_set_handler(fwk_id_t service_id,
     round_up = parameters->flags & SCMI_CLOCK_RATE_SET_ROUND_UP_MASK;
     round_auto = parameters->flags & SCMI_CLOCK_RATE_SET_ROUND_AUTO_MASK;
     asynchronous = parameters->flags & SCMI_CLOCK_RATE_SET_ASYNC_MASK;
+    delayed_response = asynchronous &&
+        !(parameters->flags & SCMI_CLOCK_RATE_SET_NO_DELAYED_RESPONSE_MASK);
 
     if ((parameters->flags & ~SCMI_CLOCK_RATE_SET_FLAGS_MASK) != 0) {
         return_values.status = SCMI_INVALID_PARAMETERS;
@@ -939,8 +1081,7 @@ static int scmi_clock_rate_set_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    if (asynchronous) {
-        /* Support for async clock set commands not yet implemented */
+    if (asynchronous && (scmi_clock_ctx.max_pending_transactions == 0)) {
         return_values.status = SCMI_NOT_SUPPORTED;
         goto exit;
     }
@@ -975,27 +1116,34 @@ static int scmi_clock_rate_set_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    struct event_set_rate_request_data data = {
-        .rate[0] = (uint32_t)rate,
-        .rate[1] = (uint32_t)(rate >> 32),
-        .round_mode = round_mode,
-    };
-
-    status = create_event_request(
+    /*
+     * The request is queued on the clock and applied once the clock is
+     * available. Synchronous requests are responded to on completion.
+     */
+    status = rate_request_submit(
         clock_device->element_id,
         service_id,
-        SCMI_CLOCK_REQUEST_SET_RATE,
-        &data,
-        parameters->clock_id);
+        parameters->clock_id,
+        rate,
+        round_mode,
+        asynchronous,
+        delayed_response);
     if (status == FWK_E_BUSY) {
         return_values.status = SCMI_BUSY;
-        status = FWK_SUCCESS;
         goto exit;
     }
 
     if (status != FWK_SUCCESS)
         goto exit;
 
+    if (asynchronous) {
+        return_values.status = SCMI_SUCCESS;
+        scmi_clock_ctx.scmi_api->respond(
+            service_id, &return_values, sizeof(return_values));
+    }
+
+    rate_queue_run(fwk_id_get_element_idx(clock_device->element_id));
+
     return FWK_SUCCESS;
 
 exit:
@@ -1308,6 +1456,11 @@ static int scmi_clock_init(fwk_id_t module_id, unsigned int element_count,
                            const void *data)
 {
     int clock_devices;
+    unsigned int agent_id, clock_id, clock_dev_idx;
+    const struct mod_scmi_clock_agent *agent;
+    const struct mod_scmi_clock_device *device;
+    uint32_t *enabled_word;
+    uint32_t enabled_mask;
     const struct mod_scmi_clock_config *config =
         (const struct mod_scmi_clock_config *)data;
 
@@ -1330,8 +1483,47 @@ static int scmi_clock_init(fwk_id_t module_id, unsigned int element_count,
         sizeof(struct clock_operations));
 
     /* Initialize table */
-    for (unsigned int i = 0; i < (unsigned int)clock_devices; i++)
+    for (unsigned int i = 0; i < (unsigned int)clock_devices; i++) {
         scmi_clock_ctx.clock_ops[i].service_id = FWK_ID_NONE;
+        fwk_list_init(&scmi_clock_ctx.clock_ops[i].rate_queue);
+        fwk_list_init(&scmi_clock_ctx.clock_ops[i].rate_batch);
+    }
+
+    /* Allocate the clock reference counts and the agent enable bitmaps */
+    scmi_clock_ctx.clock_ref_count = fwk_mm_calloc(
+        (unsigned int)clock_devices, sizeof(scmi_clock_ctx.clock_ref_count[0]));
+
+    scmi_clock_ctx.clock_bitmap_word_count =
+        ((unsigned int)clock_devices + SCMI_CLOCK_BITMAP_WORD_BITS - 1) /
+        SCMI_CLOCK_BITMAP_WORD_BITS;
+    scmi_clock_ctx.agent_clock_enabled = fwk_mm_calloc(
+        config->agent_count * scmi_clock_ctx.clock_bitmap_word_count,
+        sizeof(scmi_clock_ctx.agent_clock_enabled[0]));
+
+    /* Set all clocks as running if required */
+    for (agent_id = 0; agent_id < config->agent_count; agent_id++) {
+        agent = &config->agent_table[agent_id];
+        for (clock_id = 0; clock_id < agent->device_count; clock_id++) {
+            device = &agent->device_table[clock_id];
+            if (!device->starts_enabled)
+                continue;
+
+            clock_dev_idx = fwk_id_get_element_idx(device->element_id);
+            enabled_word =
+                get_agent_clock_word(agent_id, clock_dev_idx, &enabled_mask);
+            if ((*enabled_word & enabled_mask) == 0) {
+                *enabled_word |= enabled_mask;
+                scmi_clock_ctx.clock_ref_count[clock_dev_idx]++;
+            }
+        }
+    }
+
+    /*
+     * Each agent has at most one synchronous rate change pending, on top of
+     * the asynchronous ones.
+     */
+    fwk_event_payload_reserve(
+        config->agent_count + config->max_pending_transactions);
 
     return FWK_SUCCESS;
 }
@@ -1380,7 +1572,7 @@ static int process_request_event(const struct fwk_event *event)
     int status;
     enum mod_clock_state clock_state;
     uint64_t rate;
-    struct event_set_rate_request_data set_rate_data;
+    const struct scmi_clock_rate_request *rate_request;
     struct event_set_state_request_data set_state_data;
     fwk_id_t service_id;
 
@@ -1411,18 +1603,15 @@ static int process_request_event(const struct fwk_event *event)
         break;
 
     case SCMI_CLOCK_EVENT_IDX_SET_RATE:
-        set_rate_data = params->request_data.set_rate_data;
-
-        rate = (uint64_t)set_rate_data.rate[0] +
-               (((uint64_t)set_rate_data.rate[1]) << 32);
+        rate_request = event->payload;
 
         status =
             scmi_clock_ctx.clock_api->set_rate(params->clock_dev_id,
-                                               rate,
-                                               set_rate_data.round_mode);
+                                               rate_request->rate,
+                                               rate_request->round_mode);
         if (status != FWK_PENDING) {
             /* Request completed */
-            set_request_respond(service_id, status);
+            rate_batch_complete(clock_dev_idx, status);
             status = FWK_SUCCESS;
         }
         break;
@@ -1447,8 +1636,10 @@ static int process_request_event(const struct fwk_event *event)
     if (status == FWK_PENDING)
         return FWK_SUCCESS;
 
-    if (status == FWK_SUCCESS)
+    if (status == FWK_SUCCESS) {
         clock_ops_set_available(clock_dev_idx);
+        rate_queue_run(clock_dev_idx);
+    }
 
     return status;
 }
@@ -1465,7 +1656,10 @@ static int process_response_event(const struct fwk_event *event)
     clock_dev_idx = fwk_id_get_element_idx(event->source_id);
     service_id = clock_ops_get_service(clock_dev_idx);
 
-    if (params->status != FWK_SUCCESS)
+    if (fwk_id_get_event_idx(event->id) ==
+        MOD_CLOCK_EVENT_IDX_SET_RATE_REQUEST)
+        rate_batch_complete(clock_dev_idx, params->status);
+    else if (params->status != FWK_SUCCESS)
         request_response(params->status, service_id);
     else {
         switch (fwk_id_get_event_idx(event->id)) {
@@ -1484,7 +1678,6 @@ static int process_response_event(const struct fwk_event *event)
 
             break;
 
-        case MOD_CLOCK_EVENT_IDX_SET_RATE_REQUEST:
         case MOD_CLOCK_EVENT_IDX_SET_STATE_REQUEST:
             set_request_respond(service_id, FWK_SUCCESS);
             clock_ops_update_state(clock_dev_idx, FWK_SUCCESS);
@@ -1496,6 +1689,7 @@ static int process_response_event(const struct fwk_event *event)
         }
     }
     clock_ops_set_available(clock_dev_idx);
+    rate_queue_run(clock_dev_idx);
 
     return FWK_SUCCESS;
 }
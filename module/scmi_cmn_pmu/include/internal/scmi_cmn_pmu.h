@@ -0,0 +1,40 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI CMN PMU Protocol Support.
+ */
+
+#ifndef INTERNAL_SCMI_CMN_PMU_H
+#define INTERNAL_SCMI_CMN_PMU_H
+
+#include <stdint.h>
+
+/*
+ * CMN PMU Sample Get
+ */
+
+struct scmi_cmn_pmu_sample_get_p2a {
+    int32_t status;
+    uint32_t sequence;
+    uint32_t period_ms;
+    uint32_t hnf_count;
+    uint32_t slc_accesses_low;
+    uint32_t slc_accesses_high;
+    uint32_t slc_misses_low;
+    uint32_t slc_misses_high;
+    uint32_t sn_requests_low;
+    uint32_t sn_requests_high;
+
+    /* HN-F and memory controller bandwidth, in MB/s */
+    uint32_t hnf_bandwidth;
+    uint32_t sn_bandwidth;
+
+    /* System level cache hit rate, in hundredths of a percent */
+    uint32_t slc_hit_rate;
+};
+
+#endif /* INTERNAL_SCMI_CMN_PMU_H */
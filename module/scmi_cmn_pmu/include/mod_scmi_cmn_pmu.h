@@ -0,0 +1,51 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI CMN PMU Protocol Support.
+ */
+
+#ifndef MOD_SCMI_CMN_PMU_H
+#define MOD_SCMI_CMN_PMU_H
+
+#include <stdint.h>
+
+/*!
+ * \ingroup GroupModules Modules
+ * \defgroup GroupSCMI_CMN_PMU SCMI CMN PMU Protocol
+ *
+ * \details Vendor protocol reporting the last sample of the CMN PMU module,
+ *      see ::mod_cmn_pmu_sample, along with the bandwidth and the system
+ *      level cache hit rate derived from it.
+ *
+ *      The PROTOCOL_ATTRIBUTES command returns the size in bytes of the
+ *      transfers counted by the events.
+ *
+ * \{
+ */
+
+/*!
+ * \brief SCMI CMN PMU protocol
+ */
+#define MOD_SCMI_PROTOCOL_ID_CMN_PMU UINT32_C(0x92)
+
+/*!
+ * \brief SCMI CMN PMU protocol version
+ */
+#define MOD_SCMI_PROTOCOL_VERSION_CMN_PMU UINT32_C(0x10000)
+
+/*!
+ * \brief Identifiers of the SCMI CMN PMU Protocol commands
+ */
+enum mod_scmi_cmn_pmu_command_id {
+    MOD_SCMI_CMN_PMU_SAMPLE_GET = 0x3,
+};
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SCMI_CMN_PMU_H */
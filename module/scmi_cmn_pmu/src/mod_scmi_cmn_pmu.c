@@ -0,0 +1,301 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI CMN PMU Protocol Support.
+ */
+
+#include <internal/scmi_cmn_pmu.h>
+
+#include <mod_cmn_pmu.h>
+#include <mod_scmi.h>
+#include <mod_scmi_cmn_pmu.h>
+
+#include <fwk_assert.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct scmi_cmn_pmu_ctx {
+    /* SCMI module API */
+    const struct mod_scmi_from_protocol_api *scmi_api;
+
+    /* CMN PMU sample API */
+    const struct mod_cmn_pmu_api *cmn_pmu_api;
+};
+
+static int scmi_cmn_pmu_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_cmn_pmu_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_cmn_pmu_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_cmn_pmu_sample_get_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+
+/*
+ * Internal variables.
+ */
+static struct scmi_cmn_pmu_ctx scmi_cmn_pmu_ctx;
+
+static int (*const handler_table[])(fwk_id_t, const uint32_t *) = {
+    [MOD_SCMI_PROTOCOL_VERSION] = scmi_cmn_pmu_protocol_version_handler,
+    [MOD_SCMI_PROTOCOL_ATTRIBUTES] = scmi_cmn_pmu_protocol_attributes_handler,
+    [MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
+        scmi_cmn_pmu_protocol_message_attributes_handler,
+    [MOD_SCMI_CMN_PMU_SAMPLE_GET] = scmi_cmn_pmu_sample_get_handler,
+};
+
+static const unsigned int payload_size_table[] = {
+    [MOD_SCMI_PROTOCOL_VERSION] = 0,
+    [MOD_SCMI_PROTOCOL_ATTRIBUTES] = 0,
+    [MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
+        sizeof(struct scmi_protocol_message_attributes_a2p),
+    [MOD_SCMI_CMN_PMU_SAMPLE_GET] = 0,
+};
+
+/*
+ * Static, Helper Functions
+ */
+
+/* Bandwidth in MB/s of a number of transfers over a period */
+static uint32_t bandwidth(uint64_t count, uint32_t period_ms)
+{
+    return (uint32_t)((count * MOD_CMN_PMU_TRANSFER_SIZE) /
+                      ((uint64_t)period_ms * 1000));
+}
+
+static void encode_sample(
+    const struct mod_cmn_pmu_sample *sample,
+    struct scmi_cmn_pmu_sample_get_p2a *encoded)
+{
+    uint64_t hits;
+
+    *encoded = (struct scmi_cmn_pmu_sample_get_p2a){
+        .status = SCMI_SUCCESS,
+        .sequence = sample->sequence,
+        .period_ms = sample->period_ms,
+        .hnf_count = sample->hnf_count,
+        .slc_accesses_low = (uint32_t)sample->slc_accesses,
+        .slc_accesses_high = (uint32_t)(sample->slc_accesses >> 32),
+        .slc_misses_low = (uint32_t)sample->slc_misses,
+        .slc_misses_high = (uint32_t)(sample->slc_misses >> 32),
+        .sn_requests_low = (uint32_t)sample->sn_requests,
+        .sn_requests_high = (uint32_t)(sample->sn_requests >> 32),
+        .hnf_bandwidth = bandwidth(sample->slc_accesses, sample->period_ms),
+        .sn_bandwidth = bandwidth(sample->sn_requests, sample->period_ms),
+    };
+
+    if (sample->slc_accesses != 0) {
+        hits = sample->slc_accesses -
+            FWK_MIN(sample->slc_misses, sample->slc_accesses);
+        encoded->slc_hit_rate =
+            (uint32_t)((hits * 10000) / sample->slc_accesses);
+    }
+}
+
+/*
+ * Protocol Version
+ */
+static int scmi_cmn_pmu_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_version_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .version = MOD_SCMI_PROTOCOL_VERSION_CMN_PMU,
+    };
+
+    scmi_cmn_pmu_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Protocol Attributes
+ */
+static int scmi_cmn_pmu_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = MOD_CMN_PMU_TRANSFER_SIZE,
+    };
+
+    scmi_cmn_pmu_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Protocol Message Attributes
+ */
+static int scmi_cmn_pmu_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload)
+{
+    size_t response_size;
+    const struct scmi_protocol_message_attributes_a2p *parameters;
+    unsigned int message_id;
+    struct scmi_protocol_message_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = 0,
+    };
+
+    parameters = (const struct scmi_protocol_message_attributes_a2p *)
+        payload;
+    message_id = parameters->message_id;
+
+    if ((message_id >= FWK_ARRAY_SIZE(handler_table)) ||
+        (handler_table[message_id] == NULL))
+        return_values.status = SCMI_NOT_FOUND;
+
+    response_size = (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status);
+
+    scmi_cmn_pmu_ctx.scmi_api->respond(
+        service_id, &return_values, response_size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * CMN PMU Sample Get
+ */
+static int scmi_cmn_pmu_sample_get_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    int status;
+    struct mod_cmn_pmu_sample sample;
+    struct scmi_cmn_pmu_sample_get_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+
+    status = scmi_cmn_pmu_ctx.cmn_pmu_api->get_sample(&sample);
+    if (status == FWK_SUCCESS) {
+        encode_sample(&sample, &return_values);
+    } else if (status == FWK_E_STATE) {
+        /* No sampling period has completed yet */
+        return_values.status = SCMI_BUSY;
+        status = FWK_SUCCESS;
+    }
+
+    scmi_cmn_pmu_ctx.scmi_api->respond(
+        service_id,
+        &return_values,
+        (return_values.status == SCMI_SUCCESS) ? sizeof(return_values) :
+                                                 sizeof(return_values.status));
+
+    return status;
+}
+
+/*
+ * SCMI module -> SCMI CMN PMU module interface
+ */
+static int scmi_cmn_pmu_get_scmi_protocol_id(fwk_id_t protocol_id,
+    uint8_t *scmi_protocol_id)
+{
+    *scmi_protocol_id = MOD_SCMI_PROTOCOL_ID_CMN_PMU;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_cmn_pmu_message_handler(
+    fwk_id_t protocol_id,
+    fwk_id_t service_id,
+    const uint32_t *payload,
+    size_t payload_size,
+    unsigned int message_id)
+{
+    int32_t return_value;
+
+    static_assert(FWK_ARRAY_SIZE(handler_table) ==
+        FWK_ARRAY_SIZE(payload_size_table),
+        "[SCMI] CMN PMU protocol table sizes not consistent");
+    fwk_assert(payload != NULL);
+
+    if ((message_id >= FWK_ARRAY_SIZE(handler_table)) ||
+        (handler_table[message_id] == NULL)) {
+        return_value = SCMI_NOT_FOUND;
+        goto error;
+    }
+
+    if (payload_size != payload_size_table[message_id]) {
+        return_value = SCMI_PROTOCOL_ERROR;
+        goto error;
+    }
+
+    return handler_table[message_id](service_id, payload);
+
+error:
+    scmi_cmn_pmu_ctx.scmi_api->respond(
+        service_id,
+        &return_value,
+        sizeof(return_value));
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_scmi_to_protocol_api scmi_cmn_pmu_mod_scmi_to_protocol_api = {
+    .get_scmi_protocol_id = scmi_cmn_pmu_get_scmi_protocol_id,
+    .message_handler = scmi_cmn_pmu_message_handler,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int scmi_cmn_pmu_init(fwk_id_t module_id, unsigned int element_count,
+                             const void *data)
+{
+    return FWK_SUCCESS;
+}
+
+static int scmi_cmn_pmu_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if (round == 1)
+        return FWK_SUCCESS;
+
+    /* Bind to the SCMI module, storing an API pointer for later use. */
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_PROTOCOL),
+        &scmi_cmn_pmu_ctx.scmi_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_CMN_PMU),
+        FWK_ID_API(FWK_MODULE_IDX_CMN_PMU, MOD_CMN_PMU_API_IDX_SAMPLE),
+        &scmi_cmn_pmu_ctx.cmn_pmu_api);
+}
+
+static int scmi_cmn_pmu_process_bind_request(fwk_id_t source_id,
+    fwk_id_t target_id, fwk_id_t api_id, const void **api)
+{
+    /* Only accept binding requests from the SCMI module. */
+    if (!fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI)))
+        return FWK_E_ACCESS;
+
+    *api = &scmi_cmn_pmu_mod_scmi_to_protocol_api;
+
+    return FWK_SUCCESS;
+}
+
+/* SCMI CMN PMU Protocol Definition */
+const struct fwk_module module_scmi_cmn_pmu = {
+    .name = "SCMI CMN PMU Protocol",
+    .api_count = 1,
+    .type = FWK_MODULE_TYPE_PROTOCOL,
+    .init = scmi_cmn_pmu_init,
+    .bind = scmi_cmn_pmu_bind,
+    .process_bind_request = scmi_cmn_pmu_process_bind_request,
+};
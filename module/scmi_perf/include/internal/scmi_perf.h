@@ -213,6 +213,15 @@ struct scmi_perf_level_set_p2a {
     int32_t status;
 };
 
+/*
+ * PERFORMANCE_LEVEL_SET_BATCH (platform-specific)
+ */
+
+struct scmi_perf_level_set_batch_a2p {
+    uint32_t count;
+    struct scmi_perf_level_set_a2p entries[];
+};
+
 /*
  * PERFORMANCE_LEVEL_GET
  */
@@ -284,6 +293,14 @@ struct scmi_perf_describe_fc_a2p {
     uint32_t message_id;
 };
 
+#define SCMI_PERF_FC_ATTRIBUTES_DOORBELL_POS       0
+#define SCMI_PERF_FC_ATTRIBUTES_DOORBELL_WIDTH_POS 1
+
+#define SCMI_PERF_FC_ATTRIBUTES_DOORBELL_MASK \
+    (UINT32_C(0x1) << SCMI_PERF_FC_ATTRIBUTES_DOORBELL_POS)
+#define SCMI_PERF_FC_ATTRIBUTES_DOORBELL_WIDTH_MASK \
+    (UINT32_C(0x3) << SCMI_PERF_FC_ATTRIBUTES_DOORBELL_WIDTH_POS)
+
 struct scmi_perf_describe_fc_p2a {
     int32_t status;
     uint32_t attributes;
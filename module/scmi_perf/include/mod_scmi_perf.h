@@ -41,6 +41,23 @@ enum mod_scmi_perf_permissions {
     MOD_SCMI_PERF_PERMS_SET_LIMITS = (1 << 1),
 };
 
+/*!
+ * \brief Identifier of the platform-specific message setting the performance
+ *      level of several domains at once.
+ *
+ * \details The payload is the number of (domain, level) pairs followed by the
+ *      pairs, each laid out as the payload of PERFORMANCE_LEVEL_SET. The
+ *      message is answered with a status only, and the permissions of the
+ *      agent to set the level of every domain are checked before any level is
+ *      requested. The levels are then requested in order, back to back, and
+ *      the processing stops at the first request that fails, whose status is
+ *      returned.
+ *
+ * \note The identifier lies above the range of the messages defined by the
+ *      specification so as not to clash with its future versions.
+ */
+#define MOD_SCMI_PERF_LEVEL_SET_BATCH 0x080
+
 /*!
  * \brief Fast channels address index
  */
@@ -75,6 +92,56 @@ enum mod_scmi_perf_fast_channel_memory_offset {
         sizeof(struct mod_scmi_perf_fast_channel_limit) * 2
 };
 
+/*!
+ * \brief Fast channel doorbell register width.
+ */
+enum mod_scmi_perf_fast_channel_doorbell_width {
+    /*! 8-bit doorbell register */
+    MOD_SCMI_PERF_FAST_CHANNEL_DOORBELL_WIDTH_8,
+
+    /*! 16-bit doorbell register */
+    MOD_SCMI_PERF_FAST_CHANNEL_DOORBELL_WIDTH_16,
+
+    /*! 32-bit doorbell register */
+    MOD_SCMI_PERF_FAST_CHANNEL_DOORBELL_WIDTH_32,
+
+    /*! 64-bit doorbell register */
+    MOD_SCMI_PERF_FAST_CHANNEL_DOORBELL_WIDTH_64,
+};
+
+/*!
+ * \brief Fast channel doorbell.
+ *
+ * \details The agents ring the doorbell after writing a new performance level
+ *      or new limits to the set fast channels of a domain. The domain is then
+ *      no longer polled and the channels are only read when the doorbell
+ *      interrupt is raised.
+ */
+struct mod_scmi_perf_fast_channel_doorbell {
+    /*! Interrupt raised when the doorbell is rung */
+    unsigned int irq;
+
+    /*! Address of the doorbell register as seen by the agents */
+    uint64_t addr_ap;
+
+    /*! Bits the agents set to ring the doorbell */
+    uint64_t set_mask;
+
+    /*! Bits the agents must preserve when ringing the doorbell */
+    uint64_t preserve_mask;
+
+    /*! Width of the doorbell register */
+    enum mod_scmi_perf_fast_channel_doorbell_width width;
+
+    /*!
+     * \brief Address of the register clearing the doorbell
+     *
+     * \details The set mask is written to this register once the doorbell has
+     *      been handled. May be 0x0 if the doorbell does not need clearing.
+     */
+    uintptr_t clear_addr_scp;
+};
+
 /*!
  * \brief Performance domain configuration data.
  */
@@ -98,9 +165,21 @@ struct mod_scmi_perf_domain_config {
 
     /*!
      * \brief Rate limit in microsecs
+     *
+     * \details Interval at which the set fast channels of the domain are
+     *      polled. When 0, the rate limit of the module configuration is
+     *      used.
      */
     uint32_t fast_channels_rate_limit;
 
+    /*!
+     * \brief Fast channel doorbell
+     *
+     * \note May be NULL, in which case the set fast channels of the domain
+     *      are polled.
+     */
+    const struct mod_scmi_perf_fast_channel_doorbell *fast_channels_doorbell;
+
     /*! Flag indicating that statistics are collected for this domain */
     bool stats_collected;
 };
@@ -126,6 +205,49 @@ struct mod_scmi_perf_config {
 
     /*! Flag indicating statistics in use */
     bool stats_enabled;
+
+    /*!
+     * \brief Notification coalescing alarm ID
+     *
+     * \details The alarm closes the notification coalescing window. Only
+     *      used when \ref notification_window_ms is not zero.
+     */
+    fwk_id_t notification_alarm_id;
+
+    /*!
+     * \brief Notification coalescing window in milliseconds
+     *
+     * \details When not zero, the level and limits changes of a domain that
+     *      happen within the window are merged and only the latest value is
+     *      notified when the window closes. When zero, every change is
+     *      notified as soon as it happens.
+     */
+    uint32_t notification_window_ms;
+
+    /*!
+     * \brief Table of the agents notified without coalescing
+     *
+     * \details These agents receive every level and limits change as soon as
+     *      it happens, even when coalescing is enabled. This may be NULL if
+     *      all the agents are subject to coalescing.
+     */
+    const unsigned int *immediate_agent_table;
+
+    /*! Number of entries in \ref immediate_agent_table */
+    unsigned int immediate_agent_count;
+
+    /*!
+     * \brief Table of the agents whose levels are set by the SCP governor
+     *
+     * \details The level requests of these agents are acknowledged but not
+     *      applied, the DVFS governor module sets the levels instead. Their
+     *      limits requests are still applied and constrain the governor. This
+     *      may be NULL if no agent opts in.
+     */
+    const unsigned int *governed_agent_table;
+
+    /*! Number of entries in \ref governed_agent_table */
+    unsigned int governed_agent_count;
 };
 
 /*!
@@ -24,6 +24,7 @@
 #include <fwk_assert.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
@@ -33,6 +34,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #define MOD_SCMI_PERF_NOTIFICATION_COUNT 2
@@ -128,6 +130,71 @@ struct perf_operations {
     fwk_id_t service_id;
 };
 
+#ifdef BUILD_HAS_FAST_CHANNELS
+struct scmi_perf_fast_channel_ctx {
+    /* Interval in microseconds at which the set channels are read */
+    uint32_t rate_limit;
+
+    /* Number of polling alarm periods between two polls, 0 if not polled */
+    uint32_t poll_period;
+
+    /* Number of polling alarm periods until the next poll */
+    uint32_t poll_countdown;
+
+    /* Last level applied from the level set channel */
+    uint32_t last_level;
+
+    /* Last limits applied from the limits set channel */
+    struct mod_scmi_perf_fast_channel_limit last_limits;
+};
+#endif
+
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+struct scmi_perf_pending_notification {
+    /* A level change is waiting to be notified */
+    bool level_pending;
+
+    /* A limits change is waiting to be notified */
+    bool limits_pending;
+
+    /* Latest level change of the domain */
+    struct scmi_perf_level_changed level_changed;
+
+    /* Latest limits change of the domain */
+    struct scmi_perf_limits_changed limits_changed;
+};
+#endif
+
+/*
+ * Limits arbitration state of a domain.
+ */
+struct scmi_perf_limits_ctx {
+    /*
+     * Limits requested by each agent, indexed by agent. The platform entry
+     * holds the limits written to the fast channel of the domain. An entry
+     * whose maximum is 0 holds no request.
+     */
+    struct mod_dvfs_level_limits *requests;
+
+    /* Aggregated limits last applied to the DVFS domain */
+    struct mod_dvfs_level_limits applied;
+
+    /* Maximum level set by the limiters outside of the protocol */
+    uint32_t external_maximum;
+};
+
+/*
+ * Performance level descriptors of a domain, serialized in the format of the
+ * PERFORMANCE_DESCRIBE_LEVELS response.
+ */
+struct scmi_perf_level_table {
+    /* Table of level descriptors */
+    struct scmi_perf_level *levels;
+
+    /* Number of level descriptors */
+    size_t level_count;
+};
+
 struct scmi_perf_ctx {
     /* SCMI Performance Module Configuration */
     const struct mod_scmi_perf_config *config;
@@ -149,12 +216,34 @@ struct scmi_perf_ctx {
     /* Pointer to a table of operations */
     struct perf_operations *perf_ops_table;
 
-#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
-    /* Number of active agents */
+    /* Table of level descriptors, indexed by domain */
+    struct scmi_perf_level_table *level_table;
+
+    /* Number of agents, including the platform */
     int agent_count;
 
+    /* Table of limits arbitration contexts, indexed by domain */
+    struct scmi_perf_limits_ctx *limits_table;
+
+    /*
+     * Table of the last levels reported by DVFS, indexed by domain. 0 until
+     * the first transition of the domain has completed.
+     */
+    uint32_t *current_level_table;
+
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+
     /* SCMI notification API */
     const struct mod_scmi_notification_api *scmi_notification_api;
+
+    /* Alarm API for notification coalescing */
+    const struct mod_timer_alarm_api *notification_alarm_api;
+
+    /* Table of the notifications waiting for the window to close */
+    struct scmi_perf_pending_notification *pending_notification_table;
+
+    /* The notification coalescing window is open */
+    volatile bool notification_window_open;
 #endif
 #ifdef BUILD_HAS_FAST_CHANNELS
     /* Alarm API for fast channels */
@@ -165,6 +254,9 @@ struct scmi_perf_ctx {
 
     /* Fast Channels Polling Rate Limit */
     uint32_t fast_channels_rate_limit;
+
+    /* Table of fast channel contexts, indexed by domain */
+    struct scmi_perf_fast_channel_ctx *fast_channel_table;
 #endif
 
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
@@ -179,6 +271,9 @@ static struct scmi_perf_ctx scmi_perf_ctx;
 enum scmi_perf_event_idx {
     SCMI_PERF_EVENT_IDX_LEVEL_GET_REQUEST,
     SCMI_PERF_EVENT_IDX_LIMITS_GET_REQUEST,
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+    SCMI_PERF_EVENT_IDX_NOTIFICATION_FLUSH,
+#endif
     SCMI_PERF_EVENT_IDX_COUNT,
 };
 
@@ -194,6 +289,12 @@ static const fwk_id_t scmi_perf_get_limits =
     FWK_ID_EVENT_INIT(FWK_MODULE_IDX_SCMI_PERF,
                       SCMI_PERF_EVENT_IDX_LIMITS_GET_REQUEST);
 
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+static const fwk_id_t scmi_perf_notification_flush =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_SCMI_PERF,
+                      SCMI_PERF_EVENT_IDX_NOTIFICATION_FLUSH);
+#endif
+
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
 
 /*
@@ -217,6 +318,36 @@ static int get_perf_domain_id(const uint32_t *payload, unsigned int *domain_id)
     return FWK_SUCCESS;
 }
 
+/*
+ * The agent must be allowed to set the level of every domain of a batch.
+ */
+static int scmi_perf_batch_permissions_handler(
+    unsigned int agent_id,
+    const uint32_t *payload)
+{
+    const struct scmi_perf_level_set_batch_a2p *parameters =
+        (const struct scmi_perf_level_set_batch_a2p *)payload;
+    enum mod_res_perms_permissions perms;
+    uint32_t domain_id;
+    unsigned int i;
+
+    for (i = 0; i < parameters->count; i++) {
+        domain_id = parameters->entries[i].domain_id;
+        if (domain_id >= scmi_perf_ctx.domain_count)
+            return FWK_E_PARAM;
+
+        perms = scmi_perf_ctx.res_perms_api->agent_has_resource_permission(
+            agent_id,
+            MOD_SCMI_PROTOCOL_ID_PERF,
+            MOD_SCMI_PERF_LEVEL_SET,
+            domain_id);
+        if (perms != MOD_RES_PERMS_ACCESS_ALLOWED)
+            return FWK_E_ACCESS;
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int scmi_perf_permissions_handler(
     fwk_id_t service_id,
     const uint32_t *payload,
@@ -230,6 +361,9 @@ static int scmi_perf_permissions_handler(
     if (status != FWK_SUCCESS)
         return FWK_E_ACCESS;
 
+    if (message_id == MOD_SCMI_PERF_LEVEL_SET_BATCH)
+        return scmi_perf_batch_permissions_handler(agent_id, payload);
+
     if (message_id < 3) {
         perms = scmi_perf_ctx.res_perms_api->agent_has_protocol_permission(
             agent_id, MOD_SCMI_PROTOCOL_ID_PERF);
@@ -305,8 +439,9 @@ static int scmi_perf_protocol_message_attributes_handler(fwk_id_t service_id,
     parameters = (const struct scmi_protocol_message_attributes_a2p *)
                  payload;
 
-    if ((parameters->message_id < FWK_ARRAY_SIZE(handler_table)) &&
-        (handler_table[parameters->message_id] != NULL)) {
+    if (((parameters->message_id < FWK_ARRAY_SIZE(handler_table)) &&
+         (handler_table[parameters->message_id] != NULL)) ||
+        (parameters->message_id == MOD_SCMI_PERF_LEVEL_SET_BATCH)) {
         return_values = (struct scmi_protocol_message_attributes_p2a) {
             .status = SCMI_SUCCESS,
         };
@@ -416,13 +551,9 @@ static int scmi_perf_describe_levels_handler(fwk_id_t service_id,
     int status;
     size_t max_payload_size;
     const struct scmi_perf_describe_levels_a2p *parameters;
-    fwk_id_t domain_id;
-    struct scmi_perf_level perf_level;
-    unsigned int num_levels, level_index, level_index_max;
+    const struct scmi_perf_level_table *level_table;
+    unsigned int num_levels, level_index;
     size_t payload_size;
-    size_t opp_count;
-    struct mod_dvfs_opp opp;
-    uint16_t latency;
     struct scmi_perf_describe_levels_p2a return_values = {
         .status = SCMI_GENERIC_ERROR,
     };
@@ -448,15 +579,11 @@ static int scmi_perf_describe_levels_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    /* Get the number of operating points for the domain */
-    domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, parameters->domain_id);
-    status = scmi_perf_ctx.dvfs_api->get_opp_count(domain_id, &opp_count);
-    if (status != FWK_SUCCESS)
-        goto exit;
+    level_table = &scmi_perf_ctx.level_table[parameters->domain_id];
 
     /* Validate level index */
     level_index = parameters->level_index;
-    if (level_index >= opp_count) {
+    if (level_index >= level_table->level_count) {
         return_values.status = SCMI_INVALID_PARAMETERS;
 
         goto exit;
@@ -465,41 +592,23 @@ static int scmi_perf_describe_levels_handler(fwk_id_t service_id,
     /* Identify the maximum number of performance levels we can send at once */
     num_levels =
         (SCMI_PERF_LEVELS_MAX(max_payload_size) <
-            (opp_count - level_index)) ?
+            (level_table->level_count - level_index)) ?
         SCMI_PERF_LEVELS_MAX(max_payload_size) :
-            (opp_count - level_index);
-    level_index_max = (level_index + num_levels - 1);
+            (level_table->level_count - level_index);
 
-    status = scmi_perf_ctx.dvfs_api->get_latency(domain_id, &latency);
+    /* Copy the serialized level descriptors into the returned payload */
+    status = scmi_perf_ctx.scmi_api->write_payload(service_id, payload_size,
+        &level_table->levels[level_index],
+        num_levels * sizeof(level_table->levels[0]));
     if (status != FWK_SUCCESS)
         goto exit;
 
-    /* Copy DVFS data into returned data structure */
-    for (; level_index <= level_index_max; level_index++,
-         payload_size += sizeof(perf_level)) {
-
-        status = scmi_perf_ctx.dvfs_api->get_nth_opp(
-            domain_id, level_index, &opp);
-        if (status != FWK_SUCCESS)
-            goto exit;
-
-        if (opp.power != 0)
-            perf_level.power_cost = opp.power;
-        else
-            perf_level.power_cost = opp.voltage;
-        perf_level.performance_level = opp.level;
-        perf_level.attributes = latency;
-
-        status = scmi_perf_ctx.scmi_api->write_payload(service_id, payload_size,
-            &perf_level, sizeof(perf_level));
-        if (status != FWK_SUCCESS)
-            goto exit;
-    }
+    payload_size += num_levels * sizeof(level_table->levels[0]);
 
     return_values = (struct scmi_perf_describe_levels_p2a) {
         .status = SCMI_SUCCESS,
         .num_levels = SCMI_PERF_NUM_LEVELS(num_levels,
-            (opp_count - level_index_max - 1))
+            (level_table->level_count - level_index - num_levels))
     };
 
     status = scmi_perf_ctx.scmi_api->write_payload(service_id, 0,
@@ -515,6 +624,79 @@ exit:
     return status;
 }
 
+/*
+ * Limits arbitration
+ *
+ * The limits requested by the agents are kept per domain, and the domain is
+ * limited to their intersection: the highest of the minimums and the lowest of
+ * the maximums. The maximum prevails over the minimum should the requests not
+ * intersect. The maximum is further clamped by the last maximum set on the
+ * DVFS domain outside of the protocol, such as by a thermal or power limiter.
+ * DVFS is only requested to change the limits of the domain when the result
+ * differs from the limits last applied.
+ */
+static int scmi_perf_arbitrate_limits(
+    unsigned int domain_idx,
+    unsigned int agent_id,
+    uint32_t range_min,
+    uint32_t range_max)
+{
+    int status;
+    unsigned int i;
+    fwk_id_t domain_id;
+    struct scmi_perf_limits_ctx *ctx;
+    struct mod_dvfs_level_limits request, current;
+    struct mod_dvfs_level_limits limits = {
+        .minimum = 0,
+        .maximum = UINT32_MAX,
+    };
+
+    if ((agent_id >= (unsigned int)scmi_perf_ctx.agent_count) ||
+        (range_max == 0))
+        return FWK_E_PARAM;
+
+    domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx);
+    ctx = &scmi_perf_ctx.limits_table[domain_idx];
+
+    status = scmi_perf_ctx.dvfs_api->get_level_limits(domain_id, &current);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if ((current.minimum != ctx->applied.minimum) ||
+        (current.maximum != ctx->applied.maximum))
+        ctx->external_maximum = current.maximum;
+
+    request = ctx->requests[agent_id];
+    ctx->requests[agent_id].minimum = range_min;
+    ctx->requests[agent_id].maximum = range_max;
+
+    for (i = 0; i < (unsigned int)scmi_perf_ctx.agent_count; i++) {
+        if (ctx->requests[i].maximum == 0)
+            continue;
+
+        limits.minimum = FWK_MAX(limits.minimum, ctx->requests[i].minimum);
+        limits.maximum = FWK_MIN(limits.maximum, ctx->requests[i].maximum);
+    }
+
+    limits.maximum = FWK_MIN(limits.maximum, ctx->external_maximum);
+    limits.minimum = FWK_MIN(limits.minimum, limits.maximum);
+
+    if ((limits.minimum == current.minimum) &&
+        (limits.maximum == current.maximum)) {
+        ctx->applied = limits;
+        return FWK_SUCCESS;
+    }
+
+    status = scmi_perf_ctx.dvfs_api->set_level_limits(
+        domain_id, agent_id, &limits);
+    if ((status == FWK_SUCCESS) || (status == FWK_PENDING))
+        ctx->applied = limits;
+    else
+        ctx->requests[agent_id] = request;
+
+    return status;
+}
+
 static int scmi_perf_limits_set_handler(fwk_id_t service_id,
                                         const uint32_t *payload)
 {
@@ -561,11 +743,8 @@ static int scmi_perf_limits_set_handler(fwk_id_t service_id,
         return_values.status = SCMI_SUCCESS;
         goto exit;
     }
-    status = scmi_perf_ctx.dvfs_api->set_level_limits(
-        domain_id,
-        agent_id,
-        &((struct mod_dvfs_level_limits){ .minimum = range_min,
-                                          .maximum = range_max }));
+    status = scmi_perf_arbitrate_limits(
+        parameters->domain_id, agent_id, range_min, range_max);
 
     /*
      * Return immediately to the caller, fire-and-forget.
@@ -643,18 +822,70 @@ exit:
     return status;
 }
 
+static bool scmi_perf_is_governed_agent(unsigned int agent_id)
+{
+    unsigned int i;
+
+    for (i = 0; i < scmi_perf_ctx.config->governed_agent_count; i++) {
+        if (scmi_perf_ctx.config->governed_agent_table[i] == agent_id)
+            return true;
+    }
+
+    return false;
+}
+
+/*
+ * Request a performance level on behalf of an agent, and return the SCMI
+ * status of the request through scmi_status.
+ */
+static int scmi_perf_request_level(
+    unsigned int agent_id,
+    uint32_t domain_idx,
+    uint32_t perf_level,
+    int32_t *scmi_status)
+{
+    int status;
+    fwk_id_t domain_id;
+    enum mod_scmi_perf_policy_status policy_status;
+
+    *scmi_status = SCMI_GENERIC_ERROR;
+
+    /*
+     * Note that the policy handler may change the performance level
+     */
+    domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx);
+
+    status = scmi_perf_level_set_policy(&policy_status, &perf_level, agent_id,
+        domain_id);
+
+    if (status != FWK_SUCCESS)
+        return status;
+    if (policy_status == MOD_SCMI_PERF_SKIP_MESSAGE_HANDLER) {
+        *scmi_status = SCMI_SUCCESS;
+        return FWK_SUCCESS;
+    }
+    status = scmi_perf_ctx.dvfs_api->set_level(domain_id, agent_id, perf_level);
+
+    /*
+     * Return immediately to the caller, fire-and-forget.
+     */
+    if ((status == FWK_SUCCESS) || (status == FWK_PENDING))
+        *scmi_status = SCMI_SUCCESS;
+    else if (status == FWK_E_RANGE)
+        *scmi_status = SCMI_OUT_OF_RANGE;
+
+    return status;
+}
+
 static int scmi_perf_level_set_handler(fwk_id_t service_id,
                                        const uint32_t *payload)
 {
     int status;
     unsigned int agent_id;
     const struct scmi_perf_level_set_a2p *parameters;
-    fwk_id_t domain_id;
     struct scmi_perf_level_set_p2a return_values = {
         .status = SCMI_GENERIC_ERROR,
     };
-    uint32_t perf_level;
-    enum mod_scmi_perf_policy_status policy_status;
     parameters = (const struct scmi_perf_level_set_a2p *)payload;
 
     if (parameters->domain_id >= scmi_perf_ctx.domain_count) {
@@ -668,37 +899,87 @@ static int scmi_perf_level_set_handler(fwk_id_t service_id,
     if (status != FWK_SUCCESS)
         goto exit;
 
-    /*
-     * Note that the policy handler may change the performance level
-     */
-    domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, parameters->domain_id);
-    perf_level = parameters->performance_level;
+    /* The level of the agents that opted in is set by the governor */
+    if (scmi_perf_is_governed_agent(agent_id)) {
+        return_values.status = SCMI_SUCCESS;
+        goto exit;
+    }
 
-    status = scmi_perf_level_set_policy(&policy_status, &perf_level, agent_id,
-        domain_id);
+    status = scmi_perf_request_level(agent_id, parameters->domain_id,
+        parameters->performance_level, &return_values.status);
 
-    if (status != FWK_SUCCESS) {
-        return_values.status = SCMI_GENERIC_ERROR;
-        goto exit;
+exit:
+    scmi_perf_ctx.scmi_api->respond(service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+
+    return status;
+}
+
+static bool scmi_perf_level_set_batch_size_is_valid(
+    const uint32_t *payload,
+    size_t payload_size)
+{
+    const struct scmi_perf_level_set_batch_a2p *parameters =
+        (const struct scmi_perf_level_set_batch_a2p *)payload;
+    size_t entries_size;
+
+    if (payload_size < sizeof(*parameters))
+        return false;
+
+    entries_size = payload_size - sizeof(*parameters);
+
+    return (entries_size % sizeof(parameters->entries[0]) == 0) &&
+        (parameters->count == entries_size / sizeof(parameters->entries[0]));
+}
+
+static int scmi_perf_level_set_batch_handler(fwk_id_t service_id,
+                                             const uint32_t *payload)
+{
+    int status;
+    unsigned int agent_id;
+    unsigned int i;
+    const struct scmi_perf_level_set_batch_a2p *parameters;
+    struct scmi_perf_level_set_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+    parameters = (const struct scmi_perf_level_set_batch_a2p *)payload;
+
+    for (i = 0; i < parameters->count; i++) {
+        if (parameters->entries[i].domain_id >= scmi_perf_ctx.domain_count) {
+            status = FWK_SUCCESS;
+            return_values.status = SCMI_NOT_FOUND;
+
+            goto exit;
+        }
     }
-    if (policy_status == MOD_SCMI_PERF_SKIP_MESSAGE_HANDLER) {
-        return_values.status = SCMI_SUCCESS;
+
+    status = scmi_perf_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    return_values.status = SCMI_SUCCESS;
+
+    /* The level of the agents that opted in is set by the governor */
+    if (scmi_perf_is_governed_agent(agent_id))
         goto exit;
-    }
-    status = scmi_perf_ctx.dvfs_api->set_level(domain_id, agent_id, perf_level);
 
     /*
-     * Return immediately to the caller, fire-and-forget.
+     * Issue the requests back to back, so the domains sharing a rail see them
+     * together.
      */
-    if ((status == FWK_SUCCESS) || (status == FWK_PENDING))
-        return_values.status = SCMI_SUCCESS;
-    else if (status == FWK_E_RANGE)
-        return_values.status = SCMI_OUT_OF_RANGE;
+    for (i = 0; i < parameters->count; i++) {
+        status = scmi_perf_request_level(agent_id,
+            parameters->entries[i].domain_id,
+            parameters->entries[i].performance_level,
+            &return_values.status);
+        if (return_values.status != SCMI_SUCCESS)
+            break;
+    }
 
 exit:
     scmi_perf_ctx.scmi_api->respond(service_id, &return_values,
-        (return_values.status == SCMI_SUCCESS) ?
-        sizeof(return_values) : sizeof(return_values.status));
+        sizeof(return_values));
 
     return status;
 }
@@ -723,6 +1004,19 @@ static int scmi_perf_level_get_handler(fwk_id_t service_id,
         goto exit;
     }
 
+    /*
+     * The level last reported by DVFS is the current level of the domain, so
+     * the request is answered right away once a transition has completed.
+     */
+    return_values.performance_level =
+        scmi_perf_ctx.current_level_table[parameters->domain_id];
+    if (return_values.performance_level != 0) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_SUCCESS;
+
+        goto exit;
+    }
+
     /* Check if there is already a request pending for this domain */
     if (!fwk_id_is_equal(
             scmi_perf_ctx.perf_ops_table[parameters->domain_id].service_id,
@@ -881,14 +1175,11 @@ exit:
 
 #ifdef BUILD_HAS_FAST_CHANNELS
 
-/*
- * Note that the Fast Channel doorbell is not supported in this
- * implementation.
- */
 static int scmi_perf_describe_fast_channels(fwk_id_t service_id,
                                             const uint32_t *payload)
 {
     const struct mod_scmi_perf_domain_config *domain;
+    const struct mod_scmi_perf_fast_channel_doorbell *doorbell;
     const struct scmi_perf_describe_fc_a2p *parameters;
     struct scmi_perf_describe_fc_p2a return_values = {
         .status = SCMI_GENERIC_ERROR,
@@ -954,14 +1245,35 @@ static int scmi_perf_describe_fast_channels(fwk_id_t service_id,
         goto exit;
     }
     return_values.status = SCMI_SUCCESS;
-    return_values.attributes = 0; /* Doorbell not supported */
-    return_values.rate_limit = scmi_perf_ctx.fast_channels_rate_limit;
+    return_values.attributes = 0;
+    return_values.rate_limit =
+        scmi_perf_ctx.fast_channel_table[parameters->domain_id].rate_limit;
     return_values.chan_addr_low =
         (uint32_t)(domain->fast_channels_addr_ap[chan_index] & ~0UL);
     return_values.chan_addr_high =
         (domain->fast_channels_addr_ap[chan_index] >> 32);
     return_values.chan_size = chan_size;
 
+    /* Only the set channels are signalled with the doorbell */
+    doorbell = domain->fast_channels_doorbell;
+    if ((doorbell != NULL) &&
+        ((chan_index == MOD_SCMI_PERF_FAST_CHANNEL_LEVEL_SET) ||
+         (chan_index == MOD_SCMI_PERF_FAST_CHANNEL_LIMIT_SET))) {
+        return_values.attributes = SCMI_PERF_FC_ATTRIBUTES_DOORBELL_MASK |
+            (((uint32_t)doorbell->width
+              << SCMI_PERF_FC_ATTRIBUTES_DOORBELL_WIDTH_POS) &
+             SCMI_PERF_FC_ATTRIBUTES_DOORBELL_WIDTH_MASK);
+        return_values.doorbell_addr_low = (uint32_t)doorbell->addr_ap;
+        return_values.doorbell_addr_high = (uint32_t)(doorbell->addr_ap >> 32);
+        return_values.doorbell_set_mask_low = (uint32_t)doorbell->set_mask;
+        return_values.doorbell_set_mask_high =
+            (uint32_t)(doorbell->set_mask >> 32);
+        return_values.doorbell_preserve_mask_low =
+            (uint32_t)doorbell->preserve_mask;
+        return_values.doorbell_preserve_mask_high =
+            (uint32_t)(doorbell->preserve_mask >> 32);
+    }
+
 exit:
     scmi_perf_ctx.scmi_api->respond(service_id, &return_values,
         (return_values.status == SCMI_SUCCESS) ?
@@ -972,43 +1284,117 @@ exit:
 
 /*
  * Fast Channel Polling
+ *
+ * The set channels of a domain are read either periodically or when the agents
+ * ring the doorbell of the domain. DVFS is only requested to change the level
+ * or the limits of the domain when the value written by the agents differs
+ * from the one last applied from the channel.
  */
-static void fast_channel_callback(uintptr_t param)
+static void fast_channel_update_domain(unsigned int domain_idx)
 {
     const struct mod_scmi_perf_domain_config *domain;
+    struct scmi_perf_fast_channel_ctx *fc;
     struct mod_scmi_perf_fast_channel_limit *set_limit;
+    struct mod_scmi_perf_fast_channel_limit limits;
     uint32_t *set_level;
-    unsigned int i;
+    uint32_t level;
 
-    for (i = 0; i < scmi_perf_ctx.domain_count; i++) {
-        domain = &(*scmi_perf_ctx.config->domains)[i];
-        if (domain->fast_channels_addr_scp != 0x0) {
-            set_limit = (struct mod_scmi_perf_fast_channel_limit
-                             *)((uintptr_t)domain->fast_channels_addr_scp
-                                    [MOD_SCMI_PERF_FAST_CHANNEL_LIMIT_SET]);
-            set_level =
-                (uint32_t *)((uintptr_t)domain->fast_channels_addr_scp
+    domain = &(*scmi_perf_ctx.config->domains)[domain_idx];
+    fc = &scmi_perf_ctx.fast_channel_table[domain_idx];
+
+    set_limit = (struct mod_scmi_perf_fast_channel_limit
+                     *)((uintptr_t)domain->fast_channels_addr_scp
+                            [MOD_SCMI_PERF_FAST_CHANNEL_LIMIT_SET]);
+    set_level = (uint32_t *)((uintptr_t)domain->fast_channels_addr_scp
                                  [MOD_SCMI_PERF_FAST_CHANNEL_LEVEL_SET]);
-            /*
-             * Check for set_level
-             */
-            if (set_level != 0x0 && *set_level != 0) {
-                scmi_perf_ctx.dvfs_api->set_level(
-                    FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, i), 0, *set_level);
-            }
-            if (set_limit != 0) {
-                if ((set_limit->range_max == 0) && (set_limit->range_min == 0))
-                    continue;
-                scmi_perf_ctx.dvfs_api->set_level_limits(
-                    FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, i),
-                    0,
-                    &((struct mod_dvfs_level_limits){
-                        .minimum = set_limit->range_min,
-                        .maximum = set_limit->range_max,
-                    }));
-            }
+
+    /*
+     * Check for set_level
+     */
+    if (set_level != 0x0) {
+        level = *set_level;
+        if ((level != 0) && (level != fc->last_level)) {
+            fc->last_level = level;
+            scmi_perf_ctx.dvfs_api->set_level(
+                FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx), 0, level);
         }
     }
+
+    if (set_limit != 0) {
+        limits = *set_limit;
+        if ((limits.range_max == 0) && (limits.range_min == 0))
+            return;
+        if ((limits.range_max == fc->last_limits.range_max) &&
+            (limits.range_min == fc->last_limits.range_min))
+            return;
+
+        fc->last_limits = limits;
+        scmi_perf_arbitrate_limits(
+            domain_idx,
+            MOD_SCMI_PLATFORM_ID,
+            limits.range_min,
+            limits.range_max);
+    }
+}
+
+static void fast_channel_callback(uintptr_t param)
+{
+    struct scmi_perf_fast_channel_ctx *fc;
+    unsigned int i;
+
+    for (i = 0; i < scmi_perf_ctx.domain_count; i++) {
+        fc = &scmi_perf_ctx.fast_channel_table[i];
+        if (fc->poll_period == 0)
+            continue;
+
+        if (--fc->poll_countdown != 0)
+            continue;
+
+        fc->poll_countdown = fc->poll_period;
+        fast_channel_update_domain(i);
+    }
+}
+
+static void fast_channel_doorbell_clear(
+    const struct mod_scmi_perf_fast_channel_doorbell *doorbell)
+{
+    if (doorbell->clear_addr_scp == 0x0)
+        return;
+
+    switch (doorbell->width) {
+    case MOD_SCMI_PERF_FAST_CHANNEL_DOORBELL_WIDTH_8:
+        *(volatile uint8_t *)doorbell->clear_addr_scp =
+            (uint8_t)doorbell->set_mask;
+        break;
+
+    case MOD_SCMI_PERF_FAST_CHANNEL_DOORBELL_WIDTH_16:
+        *(volatile uint16_t *)doorbell->clear_addr_scp =
+            (uint16_t)doorbell->set_mask;
+        break;
+
+    case MOD_SCMI_PERF_FAST_CHANNEL_DOORBELL_WIDTH_32:
+        *(volatile uint32_t *)doorbell->clear_addr_scp =
+            (uint32_t)doorbell->set_mask;
+        break;
+
+    default:
+        *(volatile uint64_t *)doorbell->clear_addr_scp = doorbell->set_mask;
+        break;
+    }
+}
+
+static void fast_channel_doorbell_isr(uintptr_t param)
+{
+    const struct mod_scmi_perf_domain_config *domain;
+    unsigned int domain_idx = (unsigned int)param;
+
+    domain = &(*scmi_perf_ctx.config->domains)[domain_idx];
+
+    /* Clear first so that a doorbell rung while reading is not lost */
+    fast_channel_doorbell_clear(domain->fast_channels_doorbell);
+    fwk_interrupt_clear_pending(domain->fast_channels_doorbell->irq);
+
+    fast_channel_update_domain(domain_idx);
 }
 
 #endif
@@ -1055,6 +1441,7 @@ static int scmi_perf_message_handler(fwk_id_t protocol_id, fwk_id_t service_id,
     const uint32_t *payload, size_t payload_size, unsigned int message_id)
 {
     int32_t return_value;
+    int (*handler)(fwk_id_t, const uint32_t *);
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
     int status;
 #endif
@@ -1064,15 +1451,22 @@ static int scmi_perf_message_handler(fwk_id_t protocol_id, fwk_id_t service_id,
         "[SCMI] Performance management protocol table sizes not consistent");
     fwk_assert(payload != NULL);
 
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
+    if (message_id == MOD_SCMI_PERF_LEVEL_SET_BATCH) {
+        /* The size of a batch depends on its number of entries */
+        if (!scmi_perf_level_set_batch_size_is_valid(payload, payload_size)) {
+            return_value = SCMI_PROTOCOL_ERROR;
+            goto error;
+        }
+
+        handler = scmi_perf_level_set_batch_handler;
+    } else if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
         return_value = SCMI_NOT_FOUND;
         goto error;
-    }
-
-    if (payload_size != payload_size_table[message_id]) {
+    } else if (payload_size != payload_size_table[message_id]) {
         return_value = SCMI_PROTOCOL_ERROR;
         goto error;
-    }
+    } else
+        handler = handler_table[message_id];
 
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
     status = scmi_perf_permissions_handler(service_id, payload, message_id);
@@ -1085,7 +1479,7 @@ static int scmi_perf_message_handler(fwk_id_t protocol_id, fwk_id_t service_id,
     }
 #endif
 
-    return handler_table[message_id](service_id, payload);
+    return handler(service_id, payload);
 
 error:
     scmi_perf_ctx.scmi_api->respond(service_id, &return_value,
@@ -1126,6 +1520,167 @@ static void scmi_perf_respond(
     scmi_perf_ctx.perf_ops_table[idx].service_id = FWK_ID_NONE;
 }
 
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+/*
+ * Notification coalescing
+ */
+static bool scmi_perf_coalescing_enabled(void)
+{
+    return scmi_perf_ctx.config->notification_window_ms != 0;
+}
+
+static bool scmi_perf_is_immediate_agent(unsigned int agent_id)
+{
+    unsigned int i;
+
+    for (i = 0; i < scmi_perf_ctx.config->immediate_agent_count; i++) {
+        if (scmi_perf_ctx.config->immediate_agent_table[i] == agent_id)
+            return true;
+    }
+
+    return false;
+}
+
+/*
+ * Notify the agents that are either notified immediately or subject to
+ * coalescing, depending on 'immediate'.
+ */
+static void scmi_perf_notify_agents(
+    bool immediate,
+    unsigned int operation_id,
+    unsigned int scmi_response_message_id,
+    void *payload_p2a,
+    size_t payload_size)
+{
+    unsigned int agent_id;
+
+    /* Agent 0 is the platform */
+    for (agent_id = 1; agent_id < (unsigned int)scmi_perf_ctx.agent_count;
+         agent_id++) {
+        if (scmi_perf_is_immediate_agent(agent_id) != immediate)
+            continue;
+
+        scmi_perf_ctx.scmi_notification_api->scmi_notification_notify_agent(
+            MOD_SCMI_PROTOCOL_ID_PERF,
+            operation_id,
+            scmi_response_message_id,
+            agent_id,
+            payload_p2a,
+            payload_size);
+    }
+}
+
+static void scmi_perf_flush_notifications(void)
+{
+    struct scmi_perf_pending_notification *pending;
+    unsigned int i;
+
+    scmi_perf_ctx.notification_window_open = false;
+
+    for (i = 0; i < scmi_perf_ctx.domain_count; i++) {
+        pending = &scmi_perf_ctx.pending_notification_table[i];
+
+        if (pending->limits_pending) {
+            pending->limits_pending = false;
+            scmi_perf_notify_agents(
+                false,
+                MOD_SCMI_PERF_NOTIFY_LIMITS,
+                SCMI_PERF_LIMITS_CHANGED,
+                &pending->limits_changed,
+                sizeof(pending->limits_changed));
+        }
+
+        if (pending->level_pending) {
+            pending->level_pending = false;
+            scmi_perf_notify_agents(
+                false,
+                MOD_SCMI_PERF_NOTIFY_LEVEL,
+                SCMI_PERF_LEVEL_CHANGED,
+                &pending->level_changed,
+                sizeof(pending->level_changed));
+        }
+    }
+}
+
+/*
+ * The coalescing window alarm runs in interrupt context, defer the flush to
+ * the module's event handler.
+ */
+static void scmi_perf_notification_window_callback(uintptr_t param)
+{
+    struct fwk_event event = {
+        .source_id = fwk_module_id_scmi_perf,
+        .target_id = fwk_module_id_scmi_perf,
+        .id = scmi_perf_notification_flush,
+    };
+
+    fwk_thread_put_event(&event);
+}
+
+static void scmi_perf_open_notification_window(void)
+{
+    int status;
+
+    if (scmi_perf_ctx.notification_window_open)
+        return;
+
+    status = scmi_perf_ctx.notification_alarm_api->start(
+        scmi_perf_ctx.config->notification_alarm_id,
+        scmi_perf_ctx.config->notification_window_ms,
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        scmi_perf_notification_window_callback,
+        (uintptr_t)0);
+    if (status == FWK_SUCCESS)
+        scmi_perf_ctx.notification_window_open = true;
+    else {
+        /* Do not hold back notifications that no alarm will release */
+        scmi_perf_flush_notifications();
+    }
+}
+#endif
+
+/*
+ * Publish the limits of a domain in its limits get fast channel, if any.
+ */
+static void scmi_perf_publish_limits(
+    unsigned int idx,
+    uint32_t range_min,
+    uint32_t range_max)
+{
+    const struct mod_scmi_perf_domain_config *domain;
+    struct mod_scmi_perf_fast_channel_limit *get_limit;
+
+    domain = &(*scmi_perf_ctx.config->domains)[idx];
+    if (domain->fast_channels_addr_scp == 0x0)
+        return;
+
+    get_limit = (struct mod_scmi_perf_fast_channel_limit
+                     *)((uintptr_t)domain->fast_channels_addr_scp
+                            [MOD_SCMI_PERF_FAST_CHANNEL_LIMIT_GET]);
+    if (get_limit != 0x0) { /* note: get_limit may not be defined */
+        get_limit->range_max = range_max;
+        get_limit->range_min = range_min;
+    }
+}
+
+/*
+ * Publish the level of a domain in its level get fast channel, if any.
+ */
+static void scmi_perf_publish_level(unsigned int idx, uint32_t level)
+{
+    const struct mod_scmi_perf_domain_config *domain;
+    uint32_t *get_level;
+
+    domain = &(*scmi_perf_ctx.config->domains)[idx];
+    if (domain->fast_channels_addr_scp == 0x0)
+        return;
+
+    get_level = (uint32_t *)((uintptr_t)domain->fast_channels_addr_scp
+                                 [MOD_SCMI_PERF_FAST_CHANNEL_LEVEL_GET]);
+    if (get_level != 0x0) /* note: get_level may not be defined */
+        *get_level = level;
+}
+
 /*
  * A domain limits range has been updated. Depending on the system
  * configuration we may send an SCMI notification to the agents which
@@ -1140,23 +1695,13 @@ static void scmi_perf_notify_limits_updated(
 {
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
     struct scmi_perf_limits_changed limits_changed;
+    struct scmi_perf_pending_notification *pending;
 #endif
     int idx;
-    const struct mod_scmi_perf_domain_config *domain;
-    struct mod_scmi_perf_fast_channel_limit *get_limit;
 
     idx = fwk_id_get_element_idx(domain_id);
 
-    domain = &(*scmi_perf_ctx.config->domains)[idx];
-    if (domain->fast_channels_addr_scp != 0x0) {
-        get_limit = (struct mod_scmi_perf_fast_channel_limit
-                         *)((uintptr_t)domain->fast_channels_addr_scp
-                                [MOD_SCMI_PERF_FAST_CHANNEL_LIMIT_GET]);
-        if (get_limit != 0x0) { /* note: get_limit may not be defined */
-            get_limit->range_max = range_max;
-            get_limit->range_min = range_min;
-        }
-    }
+    scmi_perf_publish_limits(idx, range_min, range_max);
 
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
     limits_changed.agent_id = (uint32_t)cookie;
@@ -1164,12 +1709,28 @@ static void scmi_perf_notify_limits_updated(
     limits_changed.range_min = range_min;
     limits_changed.range_max = range_max;
 
-    scmi_perf_ctx.scmi_notification_api->scmi_notification_notify(
-        MOD_SCMI_PROTOCOL_ID_PERF,
+    if (!scmi_perf_coalescing_enabled()) {
+        scmi_perf_ctx.scmi_notification_api->scmi_notification_notify(
+            MOD_SCMI_PROTOCOL_ID_PERF,
+            MOD_SCMI_PERF_NOTIFY_LIMITS,
+            SCMI_PERF_LIMITS_CHANGED,
+            &limits_changed,
+            sizeof(limits_changed));
+        return;
+    }
+
+    scmi_perf_notify_agents(
+        true,
         MOD_SCMI_PERF_NOTIFY_LIMITS,
         SCMI_PERF_LIMITS_CHANGED,
         &limits_changed,
         sizeof(limits_changed));
+
+    pending = &scmi_perf_ctx.pending_notification_table[idx];
+    pending->limits_changed = limits_changed;
+    pending->limits_pending = true;
+
+    scmi_perf_open_notification_window();
 #endif
 }
 
@@ -1186,10 +1747,9 @@ static void scmi_perf_notify_level_updated(
 {
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
     struct scmi_perf_level_changed level_changed;
+    struct scmi_perf_pending_notification *pending;
 #endif
     int idx;
-    const struct mod_scmi_perf_domain_config *domain;
-    uint32_t *get_level;
 #ifdef BUILD_HAS_STATISTICS
     size_t level_id;
     int status;
@@ -1204,25 +1764,36 @@ static void scmi_perf_notify_level_updated(
             FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_PERF, idx), level_id);
 #endif
 
-    domain = &(*scmi_perf_ctx.config->domains)[idx];
-    if (domain->fast_channels_addr_scp != 0x0) {
-        get_level = (uint32_t *)((uintptr_t)domain->fast_channels_addr_scp
-                                     [MOD_SCMI_PERF_FAST_CHANNEL_LEVEL_GET]);
-        if (get_level != 0x0) /* note: get_level may not be defined */
-            *get_level = level;
-    }
+    scmi_perf_ctx.current_level_table[idx] = level;
+    scmi_perf_publish_level(idx, level);
 
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
     level_changed.agent_id = (uint32_t)cookie;
     level_changed.domain_id = idx;
     level_changed.performance_level = level;
 
-    scmi_perf_ctx.scmi_notification_api->scmi_notification_notify(
-        MOD_SCMI_PROTOCOL_ID_PERF,
+    if (!scmi_perf_coalescing_enabled()) {
+        scmi_perf_ctx.scmi_notification_api->scmi_notification_notify(
+            MOD_SCMI_PROTOCOL_ID_PERF,
+            MOD_SCMI_PERF_NOTIFY_LEVEL,
+            SCMI_PERF_LEVEL_CHANGED,
+            &level_changed,
+            sizeof(level_changed));
+        return;
+    }
+
+    scmi_perf_notify_agents(
+        true,
         MOD_SCMI_PERF_NOTIFY_LEVEL,
         SCMI_PERF_LEVEL_CHANGED,
         &level_changed,
         sizeof(level_changed));
+
+    pending = &scmi_perf_ctx.pending_notification_table[idx];
+    pending->level_changed = level_changed;
+    pending->level_pending = true;
+
+    scmi_perf_open_notification_window();
 #endif
 }
 
@@ -1252,10 +1823,14 @@ static int scmi_perf_init(fwk_id_t module_id, unsigned int element_count,
 
     scmi_perf_ctx.perf_ops_table = fwk_mm_calloc(return_val,
         sizeof(struct perf_operations));
+    scmi_perf_ctx.current_level_table = fwk_mm_calloc(return_val,
+        sizeof(scmi_perf_ctx.current_level_table[0]));
 
     scmi_perf_ctx.config = config;
     scmi_perf_ctx.domain_count = return_val;
 #ifdef BUILD_HAS_FAST_CHANNELS
+    scmi_perf_ctx.fast_channel_table = fwk_mm_calloc(return_val,
+        sizeof(struct scmi_perf_fast_channel_ctx));
     scmi_perf_ctx.fast_channels_alarm_id = config->fast_channels_alarm_id;
     if (config->fast_channels_rate_limit < SCMI_PERF_FC_MIN_RATE_LIMIT)
         scmi_perf_ctx.fast_channels_rate_limit = SCMI_PERF_FC_MIN_RATE_LIMIT;
@@ -1268,6 +1843,17 @@ static int scmi_perf_init(fwk_id_t module_id, unsigned int element_count,
     for (i = 0; i < return_val; i++)
         scmi_perf_ctx.perf_ops_table[i].service_id = FWK_ID_NONE;
 
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+    if (config->notification_window_ms != 0) {
+        if ((config->immediate_agent_count != 0) &&
+            (config->immediate_agent_table == NULL))
+            return FWK_E_PARAM;
+
+        scmi_perf_ctx.pending_notification_table = fwk_mm_calloc(return_val,
+            sizeof(struct scmi_perf_pending_notification));
+    }
+#endif
+
 
     return FWK_SUCCESS;
 }
@@ -1277,13 +1863,6 @@ static int scmi_init_notifications(int domains)
 {
     int status;
 
-    status = scmi_perf_ctx.scmi_api->get_agent_count(
-        &scmi_perf_ctx.agent_count);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    fwk_assert(scmi_perf_ctx.agent_count != 0);
-
     status = scmi_perf_ctx.scmi_notification_api->scmi_notification_init(
         MOD_SCMI_PROTOCOL_ID_PERF,
         scmi_perf_ctx.agent_count,
@@ -1314,6 +1893,13 @@ static int scmi_perf_bind(fwk_id_t id, unsigned int round)
         &scmi_perf_ctx.scmi_notification_api);
     if (status != FWK_SUCCESS)
         return status;
+
+    if (scmi_perf_ctx.config->notification_window_ms != 0) {
+        status = fwk_module_bind(scmi_perf_ctx.config->notification_alarm_id,
+            MOD_TIMER_API_ID_ALARM, &scmi_perf_ctx.notification_alarm_api);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+    }
 #endif
 
 #ifdef BUILD_HAS_FAST_CHANNELS
@@ -1422,34 +2008,92 @@ static int scmi_perf_stats_start(void)
 }
 #endif
 
+/*
+ * The operating points of the DVFS domains do not change once the system has
+ * started, their descriptors are serialized once and copied as they are into
+ * the PERFORMANCE_DESCRIBE_LEVELS responses.
+ */
+static int scmi_perf_build_level_table(unsigned int domain_idx)
+{
+    struct scmi_perf_level_table *level_table;
+    struct mod_dvfs_opp opp;
+    fwk_id_t domain_id;
+    uint16_t latency;
+    size_t level_index;
+    int status;
+
+    level_table = &scmi_perf_ctx.level_table[domain_idx];
+    domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx);
+
+    status = scmi_perf_ctx.dvfs_api->get_opp_count(
+        domain_id, &level_table->level_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = scmi_perf_ctx.dvfs_api->get_latency(domain_id, &latency);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (level_table->level_count == 0)
+        return FWK_SUCCESS;
+
+    level_table->levels = fwk_mm_alloc(
+        level_table->level_count, sizeof(level_table->levels[0]));
+
+    for (level_index = 0; level_index < level_table->level_count;
+         level_index++) {
+        status = scmi_perf_ctx.dvfs_api->get_nth_opp(
+            domain_id, level_index, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        level_table->levels[level_index] = (struct scmi_perf_level) {
+            .performance_level = opp.level,
+            .power_cost = (opp.power != 0) ? opp.power : opp.voltage,
+            .attributes = latency,
+        };
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int scmi_perf_start(fwk_id_t id)
 {
     int status = FWK_SUCCESS;
+    unsigned int domain_idx;
+    struct mod_dvfs_level_limits limits;
 
 #ifdef BUILD_HAS_FAST_CHANNELS
 
     const struct mod_scmi_perf_domain_config *domain;
+    struct scmi_perf_fast_channel_ctx *fc;
     unsigned int i, j;
     void *fc_elem;
-    uint32_t fc_interval_msecs;
+    uint32_t fc_interval_msecs = 0;
 
     /*
-     * Set up the Fast Channel polling if required
+     * The polling alarm runs at the shortest interval of the polled domains,
+     * each domain is then polled every whole number of alarm periods that
+     * fits in its own interval.
      */
-    if (!fwk_id_is_equal(scmi_perf_ctx.config->fast_channels_alarm_id,
-        FWK_ID_NONE)) {
-        if (scmi_perf_ctx.config->fast_channels_rate_limit <
-            SCMI_PERF_FC_MIN_RATE_LIMIT)
-            fc_interval_msecs = (uint32_t)SCMI_PERF_FC_MIN_RATE_LIMIT / 1000;
+    for (i = 0; i < scmi_perf_ctx.domain_count; i++) {
+        domain = &(*scmi_perf_ctx.config->domains)[i];
+        fc = &scmi_perf_ctx.fast_channel_table[i];
+
+        if (domain->fast_channels_rate_limit == 0)
+            fc->rate_limit = scmi_perf_ctx.fast_channels_rate_limit;
         else
-            fc_interval_msecs = (uint32_t)
-            scmi_perf_ctx.config->fast_channels_rate_limit / 1000;
-        status = scmi_perf_ctx.fc_alarm_api->start(
-            scmi_perf_ctx.config->fast_channels_alarm_id,
-            fc_interval_msecs, MOD_TIMER_ALARM_TYPE_PERIODIC,
-            fast_channel_callback, (uintptr_t)0);
-        if (status != FWK_SUCCESS)
-            return status;
+            fc->rate_limit = FWK_MAX(
+                domain->fast_channels_rate_limit,
+                (uint32_t)SCMI_PERF_FC_MIN_RATE_LIMIT);
+
+        if ((domain->fast_channels_addr_scp == 0x0) ||
+            (domain->fast_channels_doorbell != NULL))
+            continue;
+
+        if ((fc_interval_msecs == 0) ||
+            ((fc->rate_limit / 1000) < fc_interval_msecs))
+            fc_interval_msecs = fc->rate_limit / 1000;
     }
 
     for (i = 0; i < scmi_perf_ctx.domain_count; i++) {
@@ -1460,10 +2104,79 @@ static int scmi_perf_start(fwk_id_t id)
                 if (fc_elem != 0x0)
                     memset(fc_elem, 0, fast_channel_elem_size[j]);
             }
+
+            if (domain->fast_channels_doorbell != NULL) {
+                status = fwk_interrupt_set_isr_param(
+                    domain->fast_channels_doorbell->irq,
+                    fast_channel_doorbell_isr,
+                    (uintptr_t)i);
+                if (status != FWK_SUCCESS)
+                    return status;
+
+                status =
+                    fwk_interrupt_enable(domain->fast_channels_doorbell->irq);
+                if (status != FWK_SUCCESS)
+                    return status;
+            } else if (fc_interval_msecs != 0) {
+                fc = &scmi_perf_ctx.fast_channel_table[i];
+                fc->poll_period = FWK_MAX(
+                    (fc->rate_limit / 1000) / fc_interval_msecs, 1U);
+                fc->poll_countdown = fc->poll_period;
+            }
         }
     }
+
+    /*
+     * Set up the Fast Channel polling if required
+     */
+    if (!fwk_id_is_equal(scmi_perf_ctx.config->fast_channels_alarm_id,
+        FWK_ID_NONE) && (fc_interval_msecs != 0)) {
+        status = scmi_perf_ctx.fc_alarm_api->start(
+            scmi_perf_ctx.config->fast_channels_alarm_id,
+            fc_interval_msecs, MOD_TIMER_ALARM_TYPE_PERIODIC,
+            fast_channel_callback, (uintptr_t)0);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
 #endif
 
+    scmi_perf_ctx.level_table = fwk_mm_calloc(
+        scmi_perf_ctx.domain_count, sizeof(scmi_perf_ctx.level_table[0]));
+
+    status = scmi_perf_ctx.scmi_api->get_agent_count(
+        &scmi_perf_ctx.agent_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    fwk_assert(scmi_perf_ctx.agent_count != 0);
+
+    scmi_perf_ctx.limits_table = fwk_mm_calloc(
+        scmi_perf_ctx.domain_count, sizeof(scmi_perf_ctx.limits_table[0]));
+
+    for (domain_idx = 0; domain_idx < scmi_perf_ctx.domain_count;
+         domain_idx++) {
+        status = scmi_perf_build_level_table(domain_idx);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        scmi_perf_ctx.limits_table[domain_idx].requests = fwk_mm_calloc(
+            (unsigned int)scmi_perf_ctx.agent_count,
+            sizeof(struct mod_dvfs_level_limits));
+        scmi_perf_ctx.limits_table[domain_idx].external_maximum = UINT32_MAX;
+
+        /*
+         * The limits only reach the fast channel when they change, so the
+         * initial ones are published here. The level is published once the
+         * initial transition of the domain has completed.
+         */
+        status = scmi_perf_ctx.dvfs_api->get_level_limits(
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx), &limits);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        scmi_perf_publish_limits(domain_idx, limits.minimum, limits.maximum);
+    }
+
 #ifdef BUILD_HAS_STATISTICS
     status = scmi_perf_stats_start();
     if (status != FWK_SUCCESS)
@@ -1586,6 +2299,14 @@ static int process_response_event(const struct fwk_event *event)
 static int scmi_perf_process_event(const struct fwk_event *event,
                                     struct fwk_event *resp_event)
 {
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+    /* The notification coalescing window has closed */
+    if (fwk_id_is_equal(event->id, scmi_perf_notification_flush)) {
+        scmi_perf_flush_notifications();
+        return FWK_SUCCESS;
+    }
+#endif
+
     /* Request events from SCMI */
     if (fwk_id_get_module_idx(event->source_id) ==
         fwk_id_get_module_idx(fwk_module_id_scmi))
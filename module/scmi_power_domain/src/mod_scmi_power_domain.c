@@ -16,6 +16,9 @@
 #endif
 #include <mod_scmi.h>
 #include <mod_scmi_power_domain.h>
+#ifdef BUILD_HAS_STATISTICS
+#    include <mod_stats.h>
+#endif
 
 #ifdef BUILD_HAS_MOD_DEBUG
 #    include <mod_debug.h>
@@ -39,6 +42,28 @@
 
 #define MOD_SCMI_PD_NOTIFICATION_COUNT 2
 
+/* Maximum number of requests waiting for an operation on a power domain */
+#define MOD_SCMI_PD_PENDING_REQUEST_MAX 4
+
+#ifdef BUILD_HAS_MOD_DEBUG
+struct scmi_pd_request {
+    /* Service identifier of the requester */
+    fwk_id_t service_id;
+
+    /* Agent identifier of the requester */
+    unsigned int agent_id;
+
+    /* Request is a power state get */
+    bool get;
+
+    /* Requested SCMI power state (set only) */
+    uint32_t power_state;
+
+    /* Requested power domain state (set only) */
+    unsigned int pd_power_state;
+};
+#endif
+
 struct scmi_pd_operations {
     /*
      * Service identifier currently requesting operation.
@@ -48,6 +73,26 @@ struct scmi_pd_operations {
 
     /* Track agent requesting the pd operation */
     unsigned int agent_id;
+
+#ifdef BUILD_HAS_MOD_DEBUG
+    /*
+     * Ring of requests received while an operation is in progress. May be
+     * NULL for domains that never have an operation in progress.
+     */
+    struct scmi_pd_request *pending;
+
+    /* Index of the oldest request in the ring */
+    unsigned int pending_head;
+
+    /* Number of requests in the ring */
+    unsigned int pending_count;
+
+    /* Power domain state of the latest set operation */
+    unsigned int pd_power_state;
+
+    /* The latest set operation has completed successfully */
+    bool pd_power_state_applied;
+#endif
 };
 
 struct scmi_pd_ctx {
@@ -76,6 +121,11 @@ struct scmi_pd_ctx {
     /* Pointer to a table of scmi_pd operations */
     struct scmi_pd_operations *ops;
 
+#ifdef BUILD_HAS_STATISTICS
+    /* Statistics module API */
+    const struct mod_stats_api *stats_api;
+#endif
+
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
     /* SCMI Resource Permissions API */
     const struct mod_res_permissions_api *res_perms_api;
@@ -233,6 +283,40 @@ static void ops_set_idle(fwk_id_t pd_id)
 
     scmi_pd_ctx.ops[pd_idx].service_id = FWK_ID_NONE;
 }
+
+static int ops_enqueue(fwk_id_t pd_id, const struct scmi_pd_request *request)
+{
+    struct scmi_pd_operations *ops =
+        &scmi_pd_ctx.ops[fwk_id_get_element_idx(pd_id)];
+    unsigned int idx;
+
+    if ((ops->pending == NULL) ||
+        (ops->pending_count == MOD_SCMI_PD_PENDING_REQUEST_MAX))
+        return FWK_E_BUSY;
+
+    idx = (ops->pending_head + ops->pending_count) %
+        MOD_SCMI_PD_PENDING_REQUEST_MAX;
+    ops->pending[idx] = *request;
+    ops->pending_count++;
+
+    return FWK_SUCCESS;
+}
+
+static bool ops_dequeue(fwk_id_t pd_id, struct scmi_pd_request *request)
+{
+    struct scmi_pd_operations *ops =
+        &scmi_pd_ctx.ops[fwk_id_get_element_idx(pd_id)];
+
+    if (ops->pending_count == 0)
+        return false;
+
+    *request = ops->pending[ops->pending_head];
+    ops->pending_head =
+        (ops->pending_head + 1) % MOD_SCMI_PD_PENDING_REQUEST_MAX;
+    ops->pending_count--;
+
+    return true;
+}
 #endif
 
 /*
@@ -295,6 +379,15 @@ static int scmi_pd_protocol_attributes_handler(fwk_id_t service_id,
 
     return_values.attributes = scmi_pd_ctx.domain_count;
 
+#ifdef BUILD_HAS_STATISTICS
+    /* The region stays zero when the power domain statistics are disabled */
+    scmi_pd_ctx.stats_api->get_statistics_desc(
+        fwk_module_id_scmi_power_domain,
+        &return_values.statistics_address_low,
+        &return_values.statistics_address_high,
+        &return_values.statistics_len);
+#endif
+
     scmi_pd_ctx.scmi_api->respond(service_id,
                                   &return_values, sizeof(return_values));
 
@@ -460,12 +553,122 @@ static void scmi_pd_power_state_notify(
 #endif
 }
 
+#ifdef BUILD_HAS_MOD_DEBUG
+/*
+ * Start an operation on a debug power domain. The requester is answered once
+ * the debug module has completed the operation.
+ */
+static int scmi_pd_debug_request_start(fwk_id_t pd_id,
+                                       const struct scmi_pd_request *request)
+{
+    int status;
+    struct scmi_pd_operations *ops =
+        &scmi_pd_ctx.ops[fwk_id_get_element_idx(pd_id)];
+    struct fwk_event event = {
+        .target_id = fwk_module_id_scmi_power_domain,
+        .id = request->get ? mod_scmi_pd_event_id_dbg_enable_get :
+                             mod_scmi_pd_event_id_dbg_enable_set,
+    };
+    struct event_request_params *event_params =
+        (struct event_request_params *)event.params;
+
+    event_params->pd_power_state = request->pd_power_state;
+    event_params->pd_id = pd_id;
+
+    if (!request->get) {
+        if (!scmi_pd_ctx.debug_pd_state_notification_enabled) {
+            status = fwk_notification_subscribe(
+                mod_pd_notification_id_power_state_transition,
+                pd_id,
+                fwk_module_id_scmi_power_domain);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            scmi_pd_ctx.debug_pd_state_notification_enabled = true;
+        }
+
+        scmi_pd_power_state_notify(
+            MOD_SCMI_PD_POWER_STATE_CHANGE_REQUESTED_NOTIFY,
+            SCMI_POWER_STATE_CHANGE_REQUESTED,
+            fwk_id_get_element_idx(pd_id),
+            request->agent_id,
+            request->power_state);
+
+        ops_set_agent_id(pd_id, request->agent_id);
+    }
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (!request->get) {
+        ops->pd_power_state = request->pd_power_state;
+        ops->pd_power_state_applied = false;
+    }
+
+    ops_set_busy(pd_id, request->service_id);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Start an operation on a debug power domain, or queue it behind the one in
+ * progress. Returns FWK_E_BUSY when the queue of the domain is full.
+ */
+static int scmi_pd_debug_request_submit(fwk_id_t pd_id,
+                                        const struct scmi_pd_request *request)
+{
+    if (ops_is_busy(pd_id))
+        return ops_enqueue(pd_id, request);
+
+    return scmi_pd_debug_request_start(pd_id, request);
+}
+
+/*
+ * Complete the operation in progress on a debug power domain and start the
+ * queued requests in order. A queued set to the state just applied is
+ * answered straight away rather than repeating the operation.
+ */
+static void scmi_pd_debug_request_complete(fwk_id_t pd_id, bool state_applied)
+{
+    struct scmi_pd_operations *ops =
+        &scmi_pd_ctx.ops[fwk_id_get_element_idx(pd_id)];
+    struct scmi_pd_request request;
+    struct scmi_pd_power_state_set_p2a retval;
+
+    ops_set_idle(pd_id);
+
+    if (state_applied)
+        ops->pd_power_state_applied = true;
+
+    while (ops_dequeue(pd_id, &request)) {
+        if (!request.get && ops->pd_power_state_applied &&
+            (request.pd_power_state == ops->pd_power_state)) {
+            retval.status = SCMI_SUCCESS;
+        } else if (scmi_pd_debug_request_start(pd_id, &request) ==
+            FWK_SUCCESS) {
+            return;
+        } else
+            retval.status = SCMI_GENERIC_ERROR;
+
+        scmi_pd_ctx.scmi_api->respond(
+            request.service_id, &retval, sizeof(retval.status));
+    }
+
+    /* The domain state may change once nothing is queued against it */
+    ops->pd_power_state_applied = false;
+}
+#endif
+
 static int scmi_pd_power_state_set_handler(fwk_id_t service_id,
                                            const uint32_t *payload)
 {
     int status;
     const struct scmi_pd_power_state_set_a2p *parameters;
     bool is_sync;
+#ifdef BUILD_HAS_MOD_DEBUG
+    struct scmi_pd_request request;
+#endif
     unsigned int agent_id;
     enum scmi_agent_type agent_type;
     unsigned int domain_idx;
@@ -572,48 +775,22 @@ static int scmi_pd_power_state_set_handler(fwk_id_t service_id,
             goto exit;
         }
 
-        if (ops_is_busy(pd_id)) {
-            status = FWK_E_BUSY;
-
-            break;
-        }
-
-        struct fwk_event event = {
-            .target_id = fwk_module_id_scmi_power_domain,
-            .id = mod_scmi_pd_event_id_dbg_enable_set,
+        request = (struct scmi_pd_request){
+            .service_id = service_id,
+            .agent_id = agent_id,
+            .power_state = power_state,
+            .pd_power_state = pd_power_state,
         };
 
-        struct event_request_params *event_params =
-            (struct event_request_params *)event.params;
-        event_params->pd_power_state = pd_power_state;
-        event_params->pd_id = pd_id;
-
-        scmi_pd_power_state_notify(
-            MOD_SCMI_PD_POWER_STATE_CHANGE_REQUESTED_NOTIFY,
-            SCMI_POWER_STATE_CHANGE_REQUESTED,
-            domain_idx,
-            agent_id,
-            power_state);
-
-        ops_set_agent_id(pd_id, agent_id);
-
-        status = fwk_thread_put_event(&event);
+        status = scmi_pd_debug_request_submit(pd_id, &request);
+        if (status == FWK_E_BUSY) {
+            status = FWK_SUCCESS;
+            return_values.status = SCMI_BUSY;
+            goto exit;
+        }
         if (status != FWK_SUCCESS)
             break;
 
-        if (scmi_pd_ctx.debug_pd_state_notification_enabled == false) {
-            status = fwk_notification_subscribe(
-                mod_pd_notification_id_power_state_transition,
-                pd_id,
-                fwk_module_id_scmi_power_domain);
-            if (status != FWK_SUCCESS)
-                break;
-            else
-                scmi_pd_ctx.debug_pd_state_notification_enabled = true;
-        }
-
-        ops_set_busy(pd_id, service_id);
-
         return FWK_SUCCESS;
     #endif
 
@@ -692,8 +869,7 @@ static int scmi_pd_power_state_get_handler(fwk_id_t service_id,
     unsigned int pd_power_state;
     unsigned int power_state;
 #ifdef BUILD_HAS_MOD_DEBUG
-    struct fwk_event event;
-    struct event_request_params *event_params;
+    struct scmi_pd_request request;
     #endif
 
     parameters = (const struct scmi_pd_power_state_get_a2p *)payload;
@@ -722,21 +898,20 @@ static int scmi_pd_power_state_get_handler(fwk_id_t service_id,
 
     case MOD_PD_TYPE_DEVICE_DEBUG:
 #ifdef BUILD_HAS_MOD_DEBUG
-        event = (struct fwk_event){
-            .target_id = fwk_module_id_scmi_power_domain,
-            .id = mod_scmi_pd_event_id_dbg_enable_get,
+        request = (struct scmi_pd_request){
+            .service_id = service_id,
+            .get = true,
         };
 
-        event_params = (struct event_request_params *)event.params;
-
-        event_params->pd_id = pd_id;
-
-        status = fwk_thread_put_event(&event);
+        status = scmi_pd_debug_request_submit(pd_id, &request);
+        if (status == FWK_E_BUSY) {
+            status = FWK_SUCCESS;
+            return_values.status = SCMI_BUSY;
+            goto exit;
+        }
         if (status != FWK_SUCCESS)
             break;
 
-        ops_set_busy(pd_id, service_id);
-
         return FWK_SUCCESS;
     #endif
     case MOD_PD_TYPE_DEVICE:
@@ -1074,6 +1249,18 @@ static int scmi_pd_init(fwk_id_t module_id, unsigned int element_count,
     for (unsigned int i = 0; i < scmi_pd_ctx.domain_count; i++)
         scmi_pd_ctx.ops[i].service_id = FWK_ID_NONE;
 
+#ifdef BUILD_HAS_MOD_DEBUG
+    /* Only the debug domain has operations that complete asynchronously */
+    if (fwk_module_is_valid_element_id(scmi_pd_ctx.debug_pd_id) &&
+        (fwk_id_get_element_idx(scmi_pd_ctx.debug_pd_id) <
+         scmi_pd_ctx.domain_count)) {
+        scmi_pd_ctx.ops[fwk_id_get_element_idx(scmi_pd_ctx.debug_pd_id)]
+            .pending = fwk_mm_calloc(
+                MOD_SCMI_PD_PENDING_REQUEST_MAX,
+                sizeof(struct scmi_pd_request));
+    }
+#endif
+
     return FWK_SUCCESS;
 }
 
@@ -1139,6 +1326,13 @@ static int scmi_pd_bind(fwk_id_t id, unsigned int round)
         return status;
 #endif
 
+#ifdef BUILD_HAS_STATISTICS
+    status = fwk_module_bind(fwk_module_id_statistics,
+        mod_stats_api_id_stats, &scmi_pd_ctx.stats_api);
+    if (status != FWK_SUCCESS)
+        return status;
+#endif
+
     return fwk_module_bind(fwk_module_id_power_domain, mod_pd_api_id_restricted,
         &scmi_pd_ctx.pd_api);
 }
@@ -1219,7 +1413,8 @@ static int process_request_event(const struct fwk_event *event)
             state_get ? (void *)&retval_get : (void *)&retval_set,
             state_get ? sizeof(retval_get) : sizeof(retval_set));
 
-        ops_set_idle(params->pd_id);
+        scmi_pd_debug_request_complete(
+            params->pd_id, !state_get && (status == FWK_SUCCESS));
     }
 
     return status;
@@ -1261,7 +1456,8 @@ static int process_response_event(const struct fwk_event *event, bool get)
         get ? (void *)&retval_get : (void *)&retval_set,
         get ? sizeof(retval_get) : sizeof(retval_set));
 
-    ops_set_idle(service_id);
+    scmi_pd_debug_request_complete(
+        scmi_pd_ctx.debug_pd_id, !get && (params->status == FWK_SUCCESS));
 
     return FWK_SUCCESS;
 }
@@ -0,0 +1,137 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI Powercap Protocol Support
+ */
+
+#ifndef INTERNAL_SCMI_POWERCAP_H
+#define INTERNAL_SCMI_POWERCAP_H
+
+#include <stdint.h>
+
+#define SCMI_PROTOCOL_VERSION_POWERCAP UINT32_C(0x10000)
+
+/*
+ * Protocol Attributes
+ */
+
+#define SCMI_POWERCAP_PROTOCOL_ATTRIBUTES_DOMAIN_COUNT_MASK UINT32_C(0xFFFF)
+
+/*
+ * Powercap Domain Attributes
+ */
+
+struct scmi_powercap_domain_attributes_a2p {
+    uint32_t domain_id;
+};
+
+#define SCMI_POWERCAP_NAME_LENGTH_MAX 16
+
+/* If set, the cap of the domain can be configured */
+#define SCMI_POWERCAP_ATTRIBUTES_CAP_CONFIG_MASK (UINT32_C(0x1) << 28)
+
+/* If set, the power of the domain can be measured */
+#define SCMI_POWERCAP_ATTRIBUTES_MONITORING_MASK (UINT32_C(0x1) << 27)
+
+/* If set, the power averaging interval of the domain can be configured */
+#define SCMI_POWERCAP_ATTRIBUTES_PAI_CONFIG_MASK (UINT32_C(0x1) << 26)
+
+/* Power unit of the domain */
+#define SCMI_POWERCAP_ATTRIBUTES_POWER_UNIT_POS 24
+#define SCMI_POWERCAP_ATTRIBUTES_POWER_UNIT_MILLIWATTS \
+    (UINT32_C(0x1) << SCMI_POWERCAP_ATTRIBUTES_POWER_UNIT_POS)
+
+/* Parent identifier of the domains which have no parent */
+#define SCMI_POWERCAP_PARENT_ID_NONE UINT32_C(0xFFFFFFFF)
+
+struct scmi_powercap_domain_attributes_p2a {
+    int32_t status;
+    uint32_t attributes;
+    char name[SCMI_POWERCAP_NAME_LENGTH_MAX];
+    uint32_t min_pai;
+    uint32_t max_pai;
+    uint32_t pai_step;
+    uint32_t min_power_cap;
+    uint32_t max_power_cap;
+    uint32_t power_cap_step;
+    uint32_t sustainable_power;
+    uint32_t accuracy;
+    uint32_t parent_id;
+};
+
+/*
+ * Powercap Cap Get
+ */
+
+struct scmi_powercap_cap_get_a2p {
+    uint32_t domain_id;
+};
+
+struct scmi_powercap_cap_get_p2a {
+    int32_t status;
+    uint32_t power_cap;
+};
+
+/*
+ * Powercap Cap Set
+ */
+
+/* If set, the cap is set asynchronously */
+#define SCMI_POWERCAP_CAP_SET_ASYNC_MASK (UINT32_C(0x1) << 1)
+
+struct scmi_powercap_cap_set_a2p {
+    uint32_t domain_id;
+    uint32_t flags;
+    uint32_t power_cap;
+};
+
+struct scmi_powercap_cap_set_p2a {
+    int32_t status;
+};
+
+/*
+ * Powercap PAI Get
+ */
+
+struct scmi_powercap_pai_get_a2p {
+    uint32_t domain_id;
+};
+
+struct scmi_powercap_pai_get_p2a {
+    int32_t status;
+    uint32_t pai;
+};
+
+/*
+ * Powercap PAI Set
+ */
+
+struct scmi_powercap_pai_set_a2p {
+    uint32_t domain_id;
+    uint32_t flags;
+    uint32_t pai;
+};
+
+struct scmi_powercap_pai_set_p2a {
+    int32_t status;
+};
+
+/*
+ * Powercap Measurements Get
+ */
+
+struct scmi_powercap_measurements_get_a2p {
+    uint32_t domain_id;
+};
+
+struct scmi_powercap_measurements_get_p2a {
+    int32_t status;
+    uint32_t power;
+    uint32_t pai;
+};
+
+#endif /* INTERNAL_SCMI_POWERCAP_H */
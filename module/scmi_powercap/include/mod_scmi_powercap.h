@@ -0,0 +1,116 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI Powercap Protocol Support.
+ */
+
+#ifndef MOD_SCMI_POWERCAP_H
+#define MOD_SCMI_POWERCAP_H
+
+#include <fwk_id.h>
+
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupSCMI_POWERCAP SCMI Powercap Protocol
+ *
+ * \brief SCMI Powercap protocol.
+ *
+ * \details Each element is a powercap domain made of a DVFS domain. The agents
+ *      set the power cap of the domain and the averaging interval of its
+ *      power, and read the average power back.
+ *
+ *      Every period, the average power of the domain is updated with the
+ *      reading of its power sensor, and an integral controller turns the
+ *      distance between the cap and the average power into a power budget.
+ *      The DVFS domain is then limited to the highest level whose power, as
+ *      given by the \c power field of its operating points, fits in the
+ *      budget. Domains without a power sensor are limited to the highest
+ *      level whose power fits in the cap, the average power being that of
+ *      the current level.
+ *
+ *      A domain whose cap is its maximum cap is not capped.
+ *
+ * \note The maximum level limit of the DVFS domain is owned by the domain
+ *      while it is capped. The minimum level limit set by the agents is
+ *      preserved. A DVFS domain should not be both capped and managed by
+ *      another limiter, such as a thermal zone.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Powercap domain configuration.
+ *
+ * \details Powers are given in milliwatts and intervals in microseconds.
+ */
+struct mod_scmi_powercap_domain_config {
+    /*! Identifier of the element of the DVFS module */
+    fwk_id_t dvfs_domain_id;
+
+    /*!
+     * \brief Identifier of the power sensor, in milliwatts.
+     *
+     * \details May be ::FWK_ID_NONE, in which case the power of the domain is
+     *      estimated from its operating points.
+     */
+    fwk_id_t sensor_id;
+
+    /*! Identifier of the alarm running the control loop */
+    fwk_id_t alarm_id;
+
+    /*! Control loop period in milliseconds */
+    unsigned int period_ms;
+
+    /*! Minimum power cap */
+    uint32_t min_power_cap;
+
+    /*! Maximum power cap, which is also the initial cap */
+    uint32_t max_power_cap;
+
+    /*! Step between two power caps. 0 if any cap in range may be set */
+    uint32_t power_cap_step;
+
+    /*! Power the domain can sustain, reported to the agents */
+    uint32_t sustainable_power;
+
+    /*! Minimum power averaging interval */
+    uint32_t min_pai;
+
+    /*! Maximum power averaging interval, which is also the initial one */
+    uint32_t max_pai;
+
+    /*!
+     * \brief Step between two power averaging intervals. 0 if any interval in
+     *      range may be set.
+     */
+    uint32_t pai_step;
+
+    /*!
+     * \brief Integral gain of the controller, in thousandths.
+     *
+     * \details The power budget moves by this fraction of the distance between
+     *      the cap and the average power every period. Only used for the
+     *      domains with a power sensor.
+     */
+    uint32_t k_i;
+};
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SCMI_POWERCAP_H */
@@ -0,0 +1,822 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI Powercap Protocol Support.
+ */
+
+#include <internal/scmi_powercap.h>
+
+#include <mod_dvfs.h>
+#include <mod_scmi.h>
+#include <mod_scmi_powercap.h>
+#include <mod_sensor.h>
+#include <mod_timer.h>
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Fractional bits of the average power */
+#define POWER_AVERAGE_SHIFT 10
+
+enum scmi_powercap_event_idx {
+    SCMI_POWERCAP_EVENT_IDX_CONTROL,
+    SCMI_POWERCAP_EVENT_IDX_COUNT,
+};
+
+static const fwk_id_t scmi_powercap_event_id_control = FWK_ID_EVENT_INIT(
+    FWK_MODULE_IDX_SCMI_POWERCAP,
+    SCMI_POWERCAP_EVENT_IDX_CONTROL);
+
+struct scmi_powercap_domain_ctx {
+    /* Domain configuration */
+    const struct mod_scmi_powercap_domain_config *config;
+
+    /* Sensor API, NULL if the domain has no power sensor */
+    const struct mod_sensor_api *sensor_api;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Power cap, in mW */
+    uint32_t power_cap;
+
+    /* Power averaging interval, in microseconds */
+    uint32_t pai;
+
+    /* Average power, in mW with POWER_AVERAGE_SHIFT fractional bits */
+    int64_t average;
+
+    /* The average power holds at least one sample */
+    bool average_valid;
+
+    /* Power the level of the domain is chosen for, in mW */
+    uint32_t budget;
+
+    /* The DVFS domain is limited by the cap */
+    bool limited;
+};
+
+static struct scmi_powercap_ctx {
+    /* Table of domain contexts */
+    struct scmi_powercap_domain_ctx *domain_ctx_table;
+
+    /* Number of domains */
+    unsigned int domain_count;
+
+    /* SCMI module API */
+    const struct mod_scmi_from_protocol_api *scmi_api;
+
+    /* DVFS API */
+    const struct mod_dvfs_domain_api *dvfs_api;
+} scmi_powercap_ctx;
+
+static int scmi_powercap_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_powercap_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_powercap_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_powercap_domain_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_powercap_cap_get_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_powercap_cap_set_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_powercap_pai_get_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_powercap_pai_set_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_powercap_measurements_get_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+
+static int (*const handler_table[])(fwk_id_t, const uint32_t *) = {
+    [MOD_SCMI_PROTOCOL_VERSION] = scmi_powercap_protocol_version_handler,
+    [MOD_SCMI_PROTOCOL_ATTRIBUTES] = scmi_powercap_protocol_attributes_handler,
+    [MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
+        scmi_powercap_protocol_message_attributes_handler,
+    [MOD_SCMI_POWERCAP_DOMAIN_ATTRIBUTES] =
+        scmi_powercap_domain_attributes_handler,
+    [MOD_SCMI_POWERCAP_CAP_GET] = scmi_powercap_cap_get_handler,
+    [MOD_SCMI_POWERCAP_CAP_SET] = scmi_powercap_cap_set_handler,
+    [MOD_SCMI_POWERCAP_PAI_GET] = scmi_powercap_pai_get_handler,
+    [MOD_SCMI_POWERCAP_PAI_SET] = scmi_powercap_pai_set_handler,
+    [MOD_SCMI_POWERCAP_MEASUREMENTS_GET] =
+        scmi_powercap_measurements_get_handler,
+};
+
+static const unsigned int payload_size_table[] = {
+    [MOD_SCMI_PROTOCOL_VERSION] = 0,
+    [MOD_SCMI_PROTOCOL_ATTRIBUTES] = 0,
+    [MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
+        sizeof(struct scmi_protocol_message_attributes_a2p),
+    [MOD_SCMI_POWERCAP_DOMAIN_ATTRIBUTES] =
+        sizeof(struct scmi_powercap_domain_attributes_a2p),
+    [MOD_SCMI_POWERCAP_CAP_GET] = sizeof(struct scmi_powercap_cap_get_a2p),
+    [MOD_SCMI_POWERCAP_CAP_SET] = sizeof(struct scmi_powercap_cap_set_a2p),
+    [MOD_SCMI_POWERCAP_PAI_GET] = sizeof(struct scmi_powercap_pai_get_a2p),
+    [MOD_SCMI_POWERCAP_PAI_SET] = sizeof(struct scmi_powercap_pai_set_a2p),
+    [MOD_SCMI_POWERCAP_MEASUREMENTS_GET] =
+        sizeof(struct scmi_powercap_measurements_get_a2p),
+};
+
+/*
+ * Static, Helper Functions
+ */
+
+/*
+ * Every SCMI Powercap message but the generic ones starts with the domain
+ * identifier.
+ */
+static struct scmi_powercap_domain_ctx *get_domain_ctx(const uint32_t *payload)
+{
+    uint32_t domain_id = payload[0];
+
+    if (domain_id >= scmi_powercap_ctx.domain_count)
+        return NULL;
+
+    return &scmi_powercap_ctx.domain_ctx_table[domain_id];
+}
+
+static bool is_in_range(uint32_t value, uint32_t min, uint32_t max,
+    uint32_t step)
+{
+    if ((value < min) || (value > max))
+        return false;
+
+    return (step == 0) || (((value - min) % step) == 0);
+}
+
+/*
+ * Highest level whose power fits in the given budget, or the lowest level if
+ * none does, and the power of the highest level.
+ */
+static int domain_level_for_power(
+    const struct scmi_powercap_domain_ctx *ctx,
+    uint32_t power,
+    uint32_t *level,
+    uint32_t *max_power)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = scmi_powercap_ctx.dvfs_api;
+    fwk_id_t dvfs_domain_id = ctx->config->dvfs_domain_id;
+    struct mod_dvfs_opp opp;
+    size_t opp_count, idx;
+    int status;
+
+    status = dvfs_api->get_opp_count(dvfs_domain_id, &opp_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (idx = 0; idx < opp_count; idx++) {
+        status = dvfs_api->get_nth_opp(dvfs_domain_id, idx, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if ((idx == 0) || (opp.power <= power))
+            *level = opp.level;
+    }
+
+    *max_power = opp.power;
+
+    return FWK_SUCCESS;
+}
+
+static int domain_set_max_level(
+    const struct scmi_powercap_domain_ctx *ctx,
+    uint32_t level)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = scmi_powercap_ctx.dvfs_api;
+    fwk_id_t dvfs_domain_id = ctx->config->dvfs_domain_id;
+    struct mod_dvfs_level_limits limits;
+    int status;
+
+    status = dvfs_api->get_level_limits(dvfs_domain_id, &limits);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Keep the minimum requested by the agents */
+    level = FWK_MAX(level, limits.minimum);
+    if (level == limits.maximum)
+        return FWK_SUCCESS;
+
+    limits.maximum = level;
+    status = dvfs_api->set_level_limits(dvfs_domain_id, 0, &limits);
+
+    return (status == FWK_PENDING) ? FWK_SUCCESS : status;
+}
+
+/* Limit the DVFS domain to the power budget, lifting the limit if uncapped */
+static int domain_apply(struct scmi_powercap_domain_ctx *ctx)
+{
+    uint32_t level, max_power;
+    bool capped;
+    int status;
+
+    capped = (ctx->power_cap < ctx->config->max_power_cap);
+    if (!capped && !ctx->limited)
+        return FWK_SUCCESS;
+
+    status = domain_level_for_power(
+        ctx, capped ? ctx->budget : UINT32_MAX, &level, &max_power);
+    if (status == FWK_SUCCESS)
+        status = domain_set_max_level(ctx, level);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->limited = capped;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Control loop
+ */
+
+static void domain_update_average(
+    struct scmi_powercap_domain_ctx *ctx,
+    uint32_t power)
+{
+    int64_t sample = (int64_t)power << POWER_AVERAGE_SHIFT;
+    int64_t period_us = (int64_t)ctx->config->period_ms * 1000;
+
+    if (!ctx->average_valid || (period_us >= (int64_t)ctx->pai)) {
+        ctx->average = sample;
+        ctx->average_valid = true;
+        return;
+    }
+
+    /* Exponential average whose time constant is the averaging interval */
+    ctx->average += ((sample - ctx->average) * period_us) / ctx->pai;
+}
+
+static int domain_control(struct scmi_powercap_domain_ctx *ctx, uint32_t power)
+{
+    const struct mod_scmi_powercap_domain_config *config = ctx->config;
+    uint32_t level, max_power;
+    int64_t budget;
+    int status;
+
+    domain_update_average(ctx, power);
+
+    if ((ctx->power_cap >= config->max_power_cap) || (ctx->sensor_api == NULL))
+        return domain_apply(ctx);
+
+    /*
+     * Correct the budget for the error of the power model, without letting it
+     * grow past the power of the highest level when the load is light.
+     */
+    status = domain_level_for_power(ctx, 0, &level, &max_power);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    budget = (int64_t)ctx->budget +
+        (((int64_t)config->k_i *
+          ((int64_t)ctx->power_cap -
+           (ctx->average >> POWER_AVERAGE_SHIFT))) /
+         1000);
+    budget = FWK_MAX(FWK_MIN(budget, (int64_t)max_power), (int64_t)0);
+    ctx->budget = (uint32_t)budget;
+
+    return domain_apply(ctx);
+}
+
+/*
+ * Protocol Version
+ */
+static int scmi_powercap_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_version_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .version = SCMI_PROTOCOL_VERSION_POWERCAP,
+    };
+
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Protocol Attributes
+ */
+static int scmi_powercap_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = scmi_powercap_ctx.domain_count &
+            SCMI_POWERCAP_PROTOCOL_ATTRIBUTES_DOMAIN_COUNT_MASK,
+    };
+
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Protocol Message Attributes
+ */
+static int scmi_powercap_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload)
+{
+    const struct scmi_protocol_message_attributes_a2p *parameters;
+    unsigned int message_id;
+    struct scmi_protocol_message_attributes_p2a return_values = {
+        .status = SCMI_NOT_FOUND,
+    };
+    size_t return_values_size = sizeof(return_values.status);
+
+    parameters = (const struct scmi_protocol_message_attributes_a2p *)payload;
+    message_id = parameters->message_id;
+
+    if ((message_id < FWK_ARRAY_SIZE(handler_table)) &&
+        (handler_table[message_id] != NULL)) {
+        return_values.status = SCMI_SUCCESS;
+        return_values_size = sizeof(return_values);
+    }
+
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_values, return_values_size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Powercap Domain Attributes
+ */
+static int scmi_powercap_domain_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    const struct mod_scmi_powercap_domain_config *config;
+    struct scmi_powercap_domain_ctx *ctx;
+    struct scmi_powercap_domain_attributes_p2a return_values = {
+        .status = SCMI_NOT_FOUND,
+    };
+    size_t return_values_size = sizeof(return_values.status);
+    uint32_t domain_id = payload[0];
+
+    ctx = get_domain_ctx(payload);
+    if (ctx == NULL)
+        goto exit;
+
+    config = ctx->config;
+
+    return_values.attributes = SCMI_POWERCAP_ATTRIBUTES_CAP_CONFIG_MASK |
+        SCMI_POWERCAP_ATTRIBUTES_MONITORING_MASK |
+        SCMI_POWERCAP_ATTRIBUTES_POWER_UNIT_MILLIWATTS;
+    if (config->min_pai != config->max_pai)
+        return_values.attributes |= SCMI_POWERCAP_ATTRIBUTES_PAI_CONFIG_MASK;
+
+    strncpy(
+        return_values.name,
+        fwk_module_get_name(
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_POWERCAP, domain_id)),
+        sizeof(return_values.name) - 1);
+
+    return_values.min_pai = config->min_pai;
+    return_values.max_pai = config->max_pai;
+    return_values.pai_step = config->pai_step;
+    return_values.min_power_cap = config->min_power_cap;
+    return_values.max_power_cap = config->max_power_cap;
+    return_values.power_cap_step = config->power_cap_step;
+    return_values.sustainable_power = config->sustainable_power;
+    return_values.parent_id = SCMI_POWERCAP_PARENT_ID_NONE;
+
+    return_values.status = SCMI_SUCCESS;
+    return_values_size = sizeof(return_values);
+
+exit:
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_values, return_values_size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Powercap Cap Get
+ */
+static int scmi_powercap_cap_get_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_powercap_domain_ctx *ctx;
+    struct scmi_powercap_cap_get_p2a return_values = {
+        .status = SCMI_NOT_FOUND,
+    };
+    size_t return_values_size = sizeof(return_values.status);
+
+    ctx = get_domain_ctx(payload);
+    if (ctx != NULL) {
+        return_values.power_cap = ctx->power_cap;
+        return_values.status = SCMI_SUCCESS;
+        return_values_size = sizeof(return_values);
+    }
+
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_values, return_values_size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Powercap Cap Set
+ */
+static int scmi_powercap_cap_set_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    const struct scmi_powercap_cap_set_a2p *parameters;
+    const struct mod_scmi_powercap_domain_config *config;
+    struct scmi_powercap_domain_ctx *ctx;
+    struct scmi_powercap_cap_set_p2a return_values = {
+        .status = SCMI_NOT_FOUND,
+    };
+    int status = FWK_SUCCESS;
+
+    parameters = (const struct scmi_powercap_cap_set_a2p *)payload;
+
+    ctx = get_domain_ctx(payload);
+    if (ctx == NULL)
+        goto exit;
+
+    config = ctx->config;
+
+    if ((parameters->flags & SCMI_POWERCAP_CAP_SET_ASYNC_MASK) != 0) {
+        return_values.status = SCMI_NOT_SUPPORTED;
+        goto exit;
+    }
+
+    if (!is_in_range(
+            parameters->power_cap,
+            config->min_power_cap,
+            config->max_power_cap,
+            config->power_cap_step)) {
+        return_values.status = SCMI_OUT_OF_RANGE;
+        goto exit;
+    }
+
+    /* The control loop corrects the budget from the cap */
+    ctx->power_cap = parameters->power_cap;
+    ctx->budget = parameters->power_cap;
+
+    status = domain_apply(ctx);
+    return_values.status =
+        (status == FWK_SUCCESS) ? SCMI_SUCCESS : SCMI_GENERIC_ERROR;
+
+exit:
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return status;
+}
+
+/*
+ * Powercap PAI Get
+ */
+static int scmi_powercap_pai_get_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_powercap_domain_ctx *ctx;
+    struct scmi_powercap_pai_get_p2a return_values = {
+        .status = SCMI_NOT_FOUND,
+    };
+    size_t return_values_size = sizeof(return_values.status);
+
+    ctx = get_domain_ctx(payload);
+    if (ctx != NULL) {
+        return_values.pai = ctx->pai;
+        return_values.status = SCMI_SUCCESS;
+        return_values_size = sizeof(return_values);
+    }
+
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_values, return_values_size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Powercap PAI Set
+ */
+static int scmi_powercap_pai_set_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    const struct scmi_powercap_pai_set_a2p *parameters;
+    const struct mod_scmi_powercap_domain_config *config;
+    struct scmi_powercap_domain_ctx *ctx;
+    struct scmi_powercap_pai_set_p2a return_values = {
+        .status = SCMI_NOT_FOUND,
+    };
+
+    parameters = (const struct scmi_powercap_pai_set_a2p *)payload;
+
+    ctx = get_domain_ctx(payload);
+    if (ctx == NULL)
+        goto exit;
+
+    config = ctx->config;
+
+    if (!is_in_range(
+            parameters->pai, config->min_pai, config->max_pai,
+            config->pai_step)) {
+        return_values.status = SCMI_OUT_OF_RANGE;
+        goto exit;
+    }
+
+    ctx->pai = parameters->pai;
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Powercap Measurements Get
+ */
+static int scmi_powercap_measurements_get_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_powercap_domain_ctx *ctx;
+    struct scmi_powercap_measurements_get_p2a return_values = {
+        .status = SCMI_NOT_FOUND,
+    };
+    size_t return_values_size = sizeof(return_values.status);
+
+    ctx = get_domain_ctx(payload);
+    if (ctx != NULL) {
+        return_values.power =
+            (uint32_t)(FWK_MAX(ctx->average, (int64_t)0) >>
+                       POWER_AVERAGE_SHIFT);
+        return_values.pai = ctx->pai;
+        return_values.status = SCMI_SUCCESS;
+        return_values_size = sizeof(return_values);
+    }
+
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_values, return_values_size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * SCMI module -> SCMI Powercap module interface
+ */
+static int scmi_powercap_get_scmi_protocol_id(fwk_id_t protocol_id,
+    uint8_t *scmi_protocol_id)
+{
+    *scmi_protocol_id = MOD_SCMI_PROTOCOL_ID_POWERCAP;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_powercap_message_handler(
+    fwk_id_t protocol_id,
+    fwk_id_t service_id,
+    const uint32_t *payload,
+    size_t payload_size,
+    unsigned int message_id)
+{
+    int32_t return_value;
+
+    static_assert(FWK_ARRAY_SIZE(handler_table) ==
+        FWK_ARRAY_SIZE(payload_size_table),
+        "[SCMI] Powercap protocol table sizes not consistent");
+    fwk_assert(payload != NULL);
+
+    if ((message_id >= FWK_ARRAY_SIZE(handler_table)) ||
+        (handler_table[message_id] == NULL)) {
+        return_value = SCMI_NOT_FOUND;
+        goto error;
+    }
+
+    if (payload_size != payload_size_table[message_id]) {
+        return_value = SCMI_PROTOCOL_ERROR;
+        goto error;
+    }
+
+    return handler_table[message_id](service_id, payload);
+
+error:
+    scmi_powercap_ctx.scmi_api->respond(
+        service_id, &return_value, sizeof(return_value));
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_scmi_to_protocol_api scmi_powercap_mod_scmi_to_protocol_api =
+    {
+        .get_scmi_protocol_id = scmi_powercap_get_scmi_protocol_id,
+        .message_handler = scmi_powercap_message_handler,
+    };
+
+/*
+ * Periodical alarm callback
+ */
+
+static void scmi_powercap_alarm_callback(uintptr_t param)
+{
+    int status;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_POWERCAP),
+        .target_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_POWERCAP, param),
+        .id = scmi_powercap_event_id_control,
+    };
+
+    status = fwk_thread_put_event(&event);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
+/*
+ * Framework handlers
+ */
+
+static int scmi_powercap_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    scmi_powercap_ctx.domain_ctx_table = fwk_mm_calloc(
+        element_count, sizeof(scmi_powercap_ctx.domain_ctx_table[0]));
+    scmi_powercap_ctx.domain_count = element_count;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_powercap_domain_init(
+    fwk_id_t domain_id,
+    unsigned int sub_element_count,
+    const void *data)
+{
+    const struct mod_scmi_powercap_domain_config *config = data;
+    struct scmi_powercap_domain_ctx *ctx;
+
+    if ((config == NULL) || (config->period_ms == 0) ||
+        (config->min_power_cap > config->max_power_cap) ||
+        (config->min_pai == 0) || (config->min_pai > config->max_pai))
+        return FWK_E_DATA;
+
+    ctx = &scmi_powercap_ctx.domain_ctx_table[fwk_id_get_element_idx(
+        domain_id)];
+    ctx->config = config;
+    ctx->power_cap = config->max_power_cap;
+    ctx->budget = config->max_power_cap;
+    ctx->pai = config->max_pai;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_powercap_bind(fwk_id_t id, unsigned int round)
+{
+    struct scmi_powercap_domain_ctx *ctx;
+    int status;
+
+    if (round > 0)
+        return FWK_SUCCESS;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        status = fwk_module_bind(
+            FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+            FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_PROTOCOL),
+            &scmi_powercap_ctx.scmi_api);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+
+        return fwk_module_bind(
+            FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+            mod_dvfs_api_id_dvfs,
+            &scmi_powercap_ctx.dvfs_api);
+    }
+
+    ctx = &scmi_powercap_ctx.domain_ctx_table[fwk_id_get_element_idx(id)];
+
+    status = fwk_module_bind(
+        ctx->config->alarm_id, MOD_TIMER_API_ID_ALARM, &ctx->alarm_api);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    if (fwk_id_is_type(ctx->config->sensor_id, FWK_ID_TYPE_NONE))
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(
+        ctx->config->sensor_id, mod_sensor_api_id_sensor, &ctx->sensor_api);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_powercap_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    if (!fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI)))
+        return FWK_E_ACCESS;
+
+    *api = &scmi_powercap_mod_scmi_to_protocol_api;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_powercap_start(fwk_id_t id)
+{
+    struct scmi_powercap_domain_ctx *ctx;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+        return FWK_SUCCESS;
+
+    ctx = &scmi_powercap_ctx.domain_ctx_table[fwk_id_get_element_idx(id)];
+
+    return ctx->alarm_api->start(
+        ctx->config->alarm_id,
+        ctx->config->period_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        scmi_powercap_alarm_callback,
+        (uintptr_t)fwk_id_get_element_idx(id));
+}
+
+static int scmi_powercap_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    const struct mod_sensor_event_params *params;
+    struct scmi_powercap_domain_ctx *ctx;
+    struct mod_dvfs_opp opp;
+    uint64_t power;
+    int status;
+
+    ctx = &scmi_powercap_ctx.domain_ctx_table[fwk_id_get_element_idx(
+        event->target_id)];
+
+    if (fwk_id_is_equal(event->id, scmi_powercap_event_id_control)) {
+        /* Event from the alarm callback */
+        if (ctx->sensor_api != NULL) {
+            status = ctx->sensor_api->get_value(
+                ctx->config->sensor_id, &power);
+            if (status == FWK_PENDING)
+                return FWK_SUCCESS;
+        } else {
+            /* Estimate the power from the level of the domain */
+            status = scmi_powercap_ctx.dvfs_api->get_current_opp(
+                ctx->config->dvfs_domain_id, &opp);
+            if (status == FWK_PENDING)
+                return FWK_SUCCESS;
+            power = opp.power;
+        }
+    } else if (fwk_id_is_equal(event->id, mod_sensor_event_id_read_request)) {
+        /* Response event from the sensor HAL */
+        params = (const struct mod_sensor_event_params *)event->params;
+        status = params->status;
+        power = params->value;
+    } else
+        return FWK_E_PARAM;
+
+    if (status == FWK_SUCCESS) {
+        status = domain_control(
+            ctx, (uint32_t)FWK_MIN(power, (uint64_t)UINT32_MAX));
+    }
+
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_WARN(
+            "[SCMI POWERCAP] %s: control failed (%d)",
+            fwk_module_get_name(event->target_id),
+            status);
+    }
+
+    return FWK_SUCCESS;
+}
+
+/* SCMI Powercap Protocol Definition */
+const struct fwk_module module_scmi_powercap = {
+    .name = "SCMI Powercap Protocol",
+    .type = FWK_MODULE_TYPE_PROTOCOL,
+    .api_count = 1,
+    .event_count = SCMI_POWERCAP_EVENT_IDX_COUNT,
+    .init = scmi_powercap_init,
+    .element_init = scmi_powercap_domain_init,
+    .bind = scmi_powercap_bind,
+    .process_bind_request = scmi_powercap_process_bind_request,
+    .start = scmi_powercap_start,
+    .process_event = scmi_powercap_process_event,
+};
@@ -693,12 +693,37 @@ static int scmi_reset_process_bind_request(fwk_id_t source_id,
 }
 
 #if defined(BUILD_HAS_SCMI_NOTIFICATIONS) && defined(BUILD_HAS_NOTIFICATION)
+/*
+ * The agents are notified of each domain of a group reset, the SCMI protocol
+ * having no notion of groups.
+ */
+static int scmi_reset_process_group_notification(const struct fwk_event *event)
+{
+    uint32_t domain_id;
+    const struct mod_reset_domain_group_notification_event_params *params =
+        (const struct mod_reset_domain_group_notification_event_params *)
+        event->params;
+
+    for (domain_id = 0; domain_id < scmi_rd_ctx.plat_reset_domain_count;
+         domain_id++) {
+        if ((params->domain_mask & (UINT32_C(1) << domain_id)) != 0)
+            scmi_reset_issued_notify(domain_id, params->reset_state,
+                                     params->cookie);
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int scmi_reset_process_notification(const struct fwk_event *event,
     struct fwk_event *resp_event)
 {
     struct mod_reset_domain_notification_event_params* params =
         (struct mod_reset_domain_notification_event_params*)event->params;
 
+    if (fwk_id_is_equal(mod_reset_domain_notification_id_group_reset,
+                        event->id))
+        return scmi_reset_process_group_notification(event);
+
     if (!fwk_id_is_equal(scmi_rd_ctx.notification_id,
                          event->id))
         return FWK_E_SUPPORT;
@@ -723,6 +748,13 @@ static int scmi_reset_start(fwk_id_t id)
     if (status != FWK_SUCCESS)
         return status;
 
+    status = fwk_notification_subscribe(
+        mod_reset_domain_notification_id_group_reset,
+        FWK_ID_MODULE(FWK_MODULE_IDX_RESET_DOMAIN),
+        id);
+    if (status != FWK_SUCCESS)
+        return status;
+
     return fwk_notification_subscribe(
         scmi_rd_ctx.notification_id,
         FWK_ID_MODULE(FWK_MODULE_IDX_RESET_DOMAIN),
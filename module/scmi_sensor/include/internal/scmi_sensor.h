@@ -29,6 +29,23 @@
  * PROTOCOL_ATTRIBUTES
  */
 
+#define SCMI_SENSOR_PROTOCOL_ATTRIBUTES_MAX_PENDING_POS   16
+#define SCMI_SENSOR_PROTOCOL_ATTRIBUTES_SENSOR_COUNT_POS  0
+
+#define SCMI_SENSOR_PROTOCOL_ATTRIBUTES_MAX_PENDING_MASK \
+    (UINT32_C(0xFF) << SCMI_SENSOR_PROTOCOL_ATTRIBUTES_MAX_PENDING_POS)
+#define SCMI_SENSOR_PROTOCOL_ATTRIBUTES_SENSOR_COUNT_MASK \
+    (UINT32_C(0xFFFF) << SCMI_SENSOR_PROTOCOL_ATTRIBUTES_SENSOR_COUNT_POS)
+
+#define SCMI_SENSOR_PROTOCOL_ATTRIBUTES(MAX_PENDING, SENSOR_COUNT) \
+    ( \
+        (((MAX_PENDING) << SCMI_SENSOR_PROTOCOL_ATTRIBUTES_MAX_PENDING_POS) & \
+            SCMI_SENSOR_PROTOCOL_ATTRIBUTES_MAX_PENDING_MASK) | \
+        (((SENSOR_COUNT) << \
+            SCMI_SENSOR_PROTOCOL_ATTRIBUTES_SENSOR_COUNT_POS) & \
+            SCMI_SENSOR_PROTOCOL_ATTRIBUTES_SENSOR_COUNT_MASK) \
+    )
+
 struct scmi_sensor_protocol_attributes_p2a {
     int32_t status;
     uint32_t attributes;
@@ -52,6 +69,28 @@ struct scmi_sensor_trip_point_notify_p2a {
     int32_t status;
 };
 
+/*
+ * SENSOR_CONTINUOUS_UPDATE_NOTIFY
+ */
+
+#define SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY_ENABLE_MASK (UINT32_C(0x1) << 0)
+
+struct scmi_sensor_continuous_update_notify_a2p {
+    uint32_t sensor_id;
+    uint32_t notify_enable;
+};
+
+struct scmi_sensor_continuous_update_notify_p2a {
+    int32_t status;
+};
+
+struct scmi_sensor_update_p2a {
+    uint32_t agent_id;
+    uint32_t sensor_id;
+    uint32_t sensor_value_low;
+    uint32_t sensor_value_high;
+};
+
 struct scmi_sensor_trip_point_config_a2p {
     uint32_t sensor_id;
     uint32_t flags;
@@ -74,6 +113,13 @@ struct scmi_sensor_protocol_reading_get_p2a {
     uint32_t sensor_value_high;
 };
 
+struct scmi_sensor_protocol_reading_complete_p2a {
+    int32_t status;
+    uint32_t sensor_id;
+    uint32_t sensor_value_low;
+    uint32_t sensor_value_high;
+};
+
 /*
  * SENSOR TRIP POINT EVENT
  */
@@ -229,7 +275,10 @@ enum scmi_sensor_event_idx {
 };
 
 /* SCMI sensor notifications indices */
-enum scmi_sensor_notification_id { SCMI_SENSOR_TRIP_POINT_EVENT = 0x0 };
+enum scmi_sensor_notification_id {
+    SCMI_SENSOR_TRIP_POINT_EVENT = 0x0,
+    SCMI_SENSOR_UPDATE = 0x1,
+};
 
 /*!
  * \}
@@ -31,7 +31,8 @@
  * \brief Sensor trip point event notification API.
  *
  * \details API used by the sensor module to notify the agents through the scmi
- *      interface when a sensor trip point is triggered.
+ *      interface when a sensor trip point is triggered or a new sample of a
+ *      sensor is available.
  */
 struct mod_sensor_trip_point_api {
     /*!
@@ -45,6 +46,14 @@ struct mod_sensor_trip_point_api {
         fwk_id_t sensor_id,
         uint32_t state,
         uint32_t trip_point_idx);
+
+    /*!
+     * \brief Inform the HAL that a new sample of a sensor is available.
+     *
+     * \param sensor_id Specific sensor Id.
+     * \param value Sample value.
+     */
+    void (*notify_sensor_update)(fwk_id_t sensor_id, uint64_t value);
 };
 
 /*!
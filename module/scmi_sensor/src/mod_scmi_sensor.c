@@ -20,6 +20,7 @@
 #include <fwk_assert.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
+#include <fwk_list.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
@@ -31,14 +32,34 @@
 #include <stdint.h>
 #include <string.h>
 
-#define MOD_SCMI_SENSOR_NOTIFICATION_COUNT 1
+#define MOD_SCMI_SENSOR_NOTIFICATION_COUNT 2
+
+/* Maximum number of asynchronous readings pending across all the agents */
+#define MOD_SCMI_SENSOR_MAX_PENDING_ASYNC_READS 16
+
+/*
+ * Agent command waiting for the value of a sensor.
+ */
+struct sensor_reader {
+    /* Linked list node */
+    struct fwk_slist_node node;
+
+    /* Service identifier of the requester */
+    fwk_id_t service_id;
+
+    /* The command was asynchronous and is answered by a delayed response */
+    bool async;
+
+    /* Token of the command, for the delayed response */
+    uint16_t token;
+};
 
 struct sensor_operations {
     /*
-     * Service identifier currently requesting operation from this sensor.
-     * A 'none' value means that there is no pending request.
+     * Readers attached to the reading in progress on this sensor. An empty
+     * list means that there is no pending reading.
      */
-    fwk_id_t service_id;
+    struct fwk_slist readers;
 };
 
 struct scmi_sensor_ctx {
@@ -54,6 +75,18 @@ struct scmi_sensor_ctx {
     /* Pointer to a table of sensor operations */
     struct sensor_operations *sensor_ops_table;
 
+    /* Free sensor readers */
+    struct fwk_slist reader_free_list;
+
+    /* Number of asynchronous readings pending */
+    unsigned int async_read_count;
+
+    /*
+     * Table of sensor descriptors, serialized in the format of the
+     * SENSOR_DESCRIPTION_GET response and indexed by sensor
+     */
+    struct scmi_sensor_desc *desc_table;
+
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
     /* SCMI Resource Permissions API */
     const struct mod_res_permissions_api *res_perms_api;
@@ -86,6 +119,11 @@ static int scmi_sensor_trip_point_config_handler(
 #endif
 static int scmi_sensor_reading_get_handler(fwk_id_t service_id,
     const uint32_t *payload);
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+static int scmi_sensor_continuous_update_notify_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+#endif
 
 struct scmi_sensor_event_parameters {
     fwk_id_t sensor_id;
@@ -110,7 +148,11 @@ static int (*handler_table[])(fwk_id_t, const uint32_t *) = {
     [MOD_SCMI_SENSOR_TRIP_POINT_NOTIFY] = scmi_sensor_trip_point_notify_handler,
     [MOD_SCMI_SENSOR_TRIP_POINT_CONFIG] = scmi_sensor_trip_point_config_handler,
 #endif
-    [MOD_SCMI_SENSOR_READING_GET] = scmi_sensor_reading_get_handler
+    [MOD_SCMI_SENSOR_READING_GET] = scmi_sensor_reading_get_handler,
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+    [MOD_SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY] =
+        scmi_sensor_continuous_update_notify_handler,
+#endif
 };
 
 static unsigned int payload_size_table[] = {
@@ -128,35 +170,60 @@ static unsigned int payload_size_table[] = {
 #endif
     [MOD_SCMI_SENSOR_READING_GET] =
         sizeof(struct scmi_sensor_protocol_reading_get_a2p),
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+    [MOD_SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY] =
+        sizeof(struct scmi_sensor_continuous_update_notify_a2p),
+#endif
 };
 
 /*
  * Static helper for responding to SCMI.
+ *
+ * All the readers attached to the reading of the sensor are answered with the
+ * same value.
  */
 static void scmi_sensor_respond(
     struct scmi_sensor_protocol_reading_get_p2a *return_values,
     fwk_id_t sensor_id)
 {
     unsigned int sensor_idx;
-    fwk_id_t service_id;
+    struct sensor_reader *reader;
+    struct sensor_operations *ops;
+    struct scmi_sensor_protocol_reading_complete_p2a complete;
 
-    /*
-     * The service identifier used for the response is retrieved from the
-     * sensor operations table.
-     */
     sensor_idx = fwk_id_get_element_idx(sensor_id);
-    service_id = scmi_sensor_ctx.sensor_ops_table[sensor_idx].service_id;
+    ops = &scmi_sensor_ctx.sensor_ops_table[sensor_idx];
 
-    scmi_sensor_ctx.scmi_api->respond(service_id,
-        return_values,
-        (return_values->status == SCMI_SUCCESS) ?
-        sizeof(*return_values) : sizeof(return_values->status));
+    complete = (struct scmi_sensor_protocol_reading_complete_p2a) {
+        .status = return_values->status,
+        .sensor_id = sensor_idx,
+        .sensor_value_low = return_values->sensor_value_low,
+        .sensor_value_high = return_values->sensor_value_high,
+    };
 
-    /*
-     * Set the service identifier to 'none' to indicate the sensor is
-     * available again.
-     */
-    scmi_sensor_ctx.sensor_ops_table[sensor_idx].service_id = FWK_ID_NONE;
+    while (!fwk_list_is_empty(&ops->readers)) {
+        reader = FWK_LIST_GET(fwk_list_pop_head(&ops->readers),
+            struct sensor_reader, node);
+
+        if (reader->async) {
+            scmi_sensor_ctx.scmi_api->respond_delayed(reader->service_id,
+                MOD_SCMI_PROTOCOL_ID_SENSOR,
+                MOD_SCMI_SENSOR_READING_GET,
+                reader->token,
+                &complete,
+                (complete.status == SCMI_SUCCESS) ?
+                sizeof(complete) : sizeof(complete.status));
+
+            scmi_sensor_ctx.async_read_count--;
+        } else {
+            scmi_sensor_ctx.scmi_api->respond(reader->service_id,
+                return_values,
+                (return_values->status == SCMI_SUCCESS) ?
+                sizeof(*return_values) : sizeof(return_values->status));
+        }
+
+        fwk_list_push_tail(&scmi_sensor_ctx.reader_free_list, &reader->node);
+    }
 }
 
 /*
@@ -181,7 +248,9 @@ static int scmi_sensor_protocol_attributes_handler(fwk_id_t service_id,
 {
     struct scmi_sensor_protocol_attributes_p2a return_values = {
         .status = SCMI_SUCCESS,
-        .attributes = scmi_sensor_ctx.sensor_count,
+        .attributes = SCMI_SENSOR_PROTOCOL_ATTRIBUTES(
+            MOD_SCMI_SENSOR_MAX_PENDING_ASYNC_READS,
+            scmi_sensor_ctx.sensor_count),
         .sensor_reg_len = 0, /* Unsupported */
     };
 
@@ -225,13 +294,10 @@ static int scmi_sensor_protocol_desc_get_handler(fwk_id_t service_id,
     size_t max_payload_size;
     const struct scmi_sensor_protocol_description_get_a2p *parameters =
                (const struct scmi_sensor_protocol_description_get_a2p *)payload;
-    struct scmi_sensor_desc desc = { 0 };
-    unsigned int num_descs, desc_index, desc_index_max;
-    struct mod_sensor_scmi_info sensor_info;
+    unsigned int num_descs, desc_index;
     struct scmi_sensor_protocol_description_get_p2a return_values = {
         .status = SCMI_GENERIC_ERROR,
     };
-    fwk_id_t sensor_id;
 
     payload_size = sizeof(return_values);
 
@@ -246,8 +312,6 @@ static int scmi_sensor_protocol_desc_get_handler(fwk_id_t service_id,
         goto exit_unexpected;
     }
 
-    parameters =
-        (const struct scmi_sensor_protocol_description_get_a2p *)payload;
     desc_index = parameters->desc_index;
 
     if (desc_index >= scmi_sensor_ctx.sensor_count) {
@@ -257,91 +321,22 @@ static int scmi_sensor_protocol_desc_get_handler(fwk_id_t service_id,
 
     num_descs = FWK_MIN(SCMI_SENSOR_DESCS_MAX(max_payload_size),
         (scmi_sensor_ctx.sensor_count - desc_index));
-    desc_index_max = (desc_index + num_descs - 1);
-
-    for (; desc_index <= desc_index_max; ++desc_index,
-         payload_size += sizeof(desc)) {
-
-        desc = (struct scmi_sensor_desc) {
-            .sensor_id = desc_index,
-            .sensor_attributes_low = 0, /* None supported */
-        };
-
-        sensor_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, desc_index);
-        if (!fwk_module_is_valid_element_id(sensor_id)) {
-            /* domain_idx did not map to a sensor device */
-            return_values.status = SCMI_NOT_FOUND;
-            goto exit_unexpected;
-        }
-
-        status = scmi_sensor_ctx.sensor_api->get_info(sensor_id, &sensor_info);
-        if (status != FWK_SUCCESS) {
-            /* Unable to get sensor info */
-            goto exit_unexpected;
-        }
-
-        if (sensor_info.hal_info.type >= MOD_SENSOR_TYPE_COUNT) {
-            /* Invalid sensor type */
-            goto exit_unexpected;
-        }
-
-        if ((sensor_info.hal_info.unit_multiplier <
-             SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UNIT_MULTIPLIER_MIN) ||
-            (sensor_info.hal_info.unit_multiplier >
-             SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UNIT_MULTIPLIER_MAX)) {
-            /* Sensor unit multiplier out of range */
-            goto exit_unexpected;
-        }
 
-        if ((sensor_info.hal_info.update_interval_multiplier <
-             SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UPDATE_MULTIPLIER_MIN) ||
-            (sensor_info.hal_info.update_interval_multiplier >
-             SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UPDATE_MULTIPLIER_MAX)) {
-            /* Sensor update interval multiplier is out of range */
-            goto exit_unexpected;
-        }
-
-        if (sensor_info.hal_info.update_interval >=
-            SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UPDATE_INTERVAL_MASK) {
-            /* Update interval is too big to fit in its mask */
-            goto exit_unexpected;
-        }
-        if (sensor_info.trip_point.count >=
-            SCMI_SENSOR_DESC_ATTRS_LOW_SENSOR_NUM_TRIP_POINTS_MASK) {
-            /* Number of trip points is too big to fit in its mask */
-            goto exit_unexpected;
-        }
-
-        desc.sensor_attributes_low = SCMI_SENSOR_DESC_ATTRIBUTES_LOW(
-            0, /* Asyncronous reading not-supported */
-            (uint32_t)sensor_info.trip_point.count);
-
-        desc.sensor_attributes_high = SCMI_SENSOR_DESC_ATTRIBUTES_HIGH(
-            sensor_info.hal_info.type,
-            sensor_info.hal_info.unit_multiplier,
-            (uint32_t)sensor_info.hal_info.update_interval_multiplier,
-            (uint32_t)sensor_info.hal_info.update_interval);
-
-        /*
-         * Copy sensor name into description struct. Copy n-1 chars to ensure a
-         * NULL terminator at the end. (struct has been zeroed out)
-         */
-        strncpy(desc.sensor_name,
-                fwk_module_get_name(sensor_id),
-                sizeof(desc.sensor_name) - 1);
-
-        status = scmi_sensor_ctx.scmi_api->write_payload(service_id,
-            payload_size, &desc, sizeof(struct scmi_sensor_desc));
-        if (status != FWK_SUCCESS) {
-            /* Failed to write sensor description into message payload */
-            goto exit_unexpected;
-        }
+    /* The descriptors were serialized when the module started */
+    status = scmi_sensor_ctx.scmi_api->write_payload(service_id,
+        payload_size, &scmi_sensor_ctx.desc_table[desc_index],
+        num_descs * sizeof(scmi_sensor_ctx.desc_table[0]));
+    if (status != FWK_SUCCESS) {
+        /* Failed to write sensor descriptions into message payload */
+        goto exit_unexpected;
     }
 
+    payload_size += num_descs * sizeof(scmi_sensor_ctx.desc_table[0]);
+
     return_values = (struct scmi_sensor_protocol_description_get_p2a) {
         .status = SCMI_SUCCESS,
         .num_sensor_flags = SCMI_SENSOR_NUM_SENSOR_FLAGS(num_descs,
-            (scmi_sensor_ctx.sensor_count - desc_index_max - 1))
+            (scmi_sensor_ctx.sensor_count - desc_index - num_descs))
     };
 
     status = scmi_sensor_ctx.scmi_api->write_payload(service_id, 0,
@@ -491,8 +486,13 @@ static int scmi_sensor_reading_get_handler(fwk_id_t service_id,
     const struct scmi_sensor_protocol_reading_get_a2p *parameters;
     struct scmi_sensor_protocol_reading_get_p2a return_values;
     struct scmi_sensor_event_parameters *params;
+    struct sensor_operations *ops;
+    struct sensor_reader *reader;
     unsigned int sensor_idx;
     uint32_t flags;
+    bool async;
+    bool reading_pending;
+    uint16_t token = 0;
     int status;
 
     parameters = (const struct scmi_sensor_protocol_reading_get_a2p *)payload;
@@ -512,44 +512,73 @@ static int scmi_sensor_reading_get_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    /* Reject asynchronous read requests for now */
-    if (flags & SCMI_SENSOR_PROTOCOL_READING_GET_ASYNC_FLAG_MASK) {
-        return_values.status = SCMI_NOT_SUPPORTED;
-        status = FWK_SUCCESS;
-        goto exit;
+    async = (flags & SCMI_SENSOR_PROTOCOL_READING_GET_ASYNC_FLAG_MASK) != 0;
+    if (async) {
+        if (scmi_sensor_ctx.async_read_count >=
+            MOD_SCMI_SENSOR_MAX_PENDING_ASYNC_READS) {
+            return_values.status = SCMI_BUSY;
+            status = FWK_SUCCESS;
+            goto exit;
+        }
+
+        status = scmi_sensor_ctx.scmi_api->get_token(service_id, &token);
+        if (status != FWK_SUCCESS)
+            goto exit;
     }
 
     sensor_idx = parameters->sensor_id;
+    ops = &scmi_sensor_ctx.sensor_ops_table[sensor_idx];
 
-    /* Check if there is already a request pending for this sensor */
-    if (!fwk_id_is_equal(
-            scmi_sensor_ctx.sensor_ops_table[sensor_idx].service_id,
-            FWK_ID_NONE)){
+    reader = FWK_LIST_GET(fwk_list_pop_head(&scmi_sensor_ctx.reader_free_list),
+        struct sensor_reader, node);
+    if (reader == NULL) {
         return_values.status = SCMI_BUSY;
         status = FWK_SUCCESS;
-
         goto exit;
     }
 
-    /* The get_value request is processed within the event being generated */
-    struct fwk_event event = {
-        .target_id = fwk_module_id_scmi_sensor,
-        .id = mod_scmi_sensor_event_id_get_request,
-    };
+    /*
+     * If a reading is already in progress on this sensor, the reader is
+     * answered with its value and no other reading is started.
+     */
+    reading_pending = !fwk_list_is_empty(&ops->readers);
 
-    params = (struct scmi_sensor_event_parameters *)event.params;
-    params->sensor_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR,
-                                       sensor_idx);
+    if (!reading_pending) {
+        /*
+         * The get_value request is processed within the event being
+         * generated
+         */
+        struct fwk_event event = {
+            .target_id = fwk_module_id_scmi_sensor,
+            .id = mod_scmi_sensor_event_id_get_request,
+        };
 
-    status = fwk_thread_put_event(&event);
-    if (status != FWK_SUCCESS) {
-        return_values.status = SCMI_GENERIC_ERROR;
+        params = (struct scmi_sensor_event_parameters *)event.params;
+        params->sensor_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR,
+                                           sensor_idx);
 
-        goto exit;
+        status = fwk_thread_put_event(&event);
+        if (status != FWK_SUCCESS) {
+            fwk_list_push_tail(&scmi_sensor_ctx.reader_free_list,
+                &reader->node);
+            return_values.status = SCMI_GENERIC_ERROR;
+
+            goto exit;
+        }
     }
 
-    /* Store service identifier to indicate there is a pending request */
-    scmi_sensor_ctx.sensor_ops_table[sensor_idx].service_id = service_id;
+    reader->service_id = service_id;
+    reader->async = async;
+    reader->token = token;
+    fwk_list_push_tail(&ops->readers, &reader->node);
+
+    if (async) {
+        scmi_sensor_ctx.async_read_count++;
+
+        return_values.status = SCMI_SUCCESS;
+        scmi_sensor_ctx.scmi_api->respond(service_id, &return_values,
+            sizeof(return_values.status));
+    }
 
     return FWK_SUCCESS;
 
@@ -561,6 +590,87 @@ exit:
     return status;
 }
 
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+/*
+ * Sensor Continuous Update Notify
+ */
+static int scmi_sensor_continuous_update_notify_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    unsigned int agent_id;
+    int status;
+    struct mod_sensor_scmi_info sensor_info;
+    const struct scmi_sensor_continuous_update_notify_a2p *parameters;
+    struct scmi_sensor_continuous_update_notify_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+
+    parameters =
+        (const struct scmi_sensor_continuous_update_notify_a2p *)payload;
+
+    if (parameters->sensor_id >= scmi_sensor_ctx.sensor_count) {
+        /* Sensor does not exist */
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
+
+    if ((parameters->notify_enable &
+         ~SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY_ENABLE_MASK) != 0) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_INVALID_PARAMETERS;
+        goto exit;
+    }
+
+    status = scmi_sensor_ctx.sensor_api->get_info(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, parameters->sensor_id),
+        &sensor_info);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    /* Only the sensors sampled by the platform provide continuous updates */
+    if (sensor_info.sampling_period_ms == 0) {
+        return_values.status = SCMI_NOT_SUPPORTED;
+        goto exit;
+    }
+
+    status = scmi_sensor_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    if (parameters->notify_enable &
+        SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY_ENABLE_MASK) {
+        status = scmi_sensor_ctx.scmi_notification_api
+                     ->scmi_notification_add_subscriber(
+                         MOD_SCMI_PROTOCOL_ID_SENSOR,
+                         parameters->sensor_id,
+                         MOD_SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY,
+                         service_id);
+    } else {
+        status = scmi_sensor_ctx.scmi_notification_api
+                     ->scmi_notification_remove_subscriber(
+                         MOD_SCMI_PROTOCOL_ID_SENSOR,
+                         agent_id,
+                         parameters->sensor_id,
+                         MOD_SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY);
+    }
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_sensor_ctx.scmi_api->respond(
+        service_id,
+        &return_values,
+        (return_values.status == SCMI_SUCCESS) ? sizeof(return_values) :
+                                                 sizeof(return_values.status));
+
+    return status;
+}
+#endif
+
 /*
  * SCMI module -> SCMI sensor module interface
  */
@@ -615,6 +725,10 @@ static int scmi_sensor_permissions_handler(
     if (sensor_id >= scmi_sensor_ctx.sensor_count)
         return FWK_E_PARAM;
 
+    /* Continuous updates stream the readings of the sensor */
+    if (message_id == MOD_SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY)
+        message_id = MOD_SCMI_SENSOR_READING_GET;
+
     perms = scmi_sensor_ctx.res_perms_api->agent_has_resource_permission(
         agent_id, MOD_SCMI_PROTOCOL_ID_SENSOR, message_id, sensor_id);
 
@@ -641,7 +755,8 @@ static int scmi_sensor_message_handler(fwk_id_t protocol_id,
         "[SCMI] Sensor management protocol table sizes not consistent");
     fwk_assert(payload != NULL);
 
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
+    if ((message_id >= FWK_ARRAY_SIZE(handler_table)) ||
+        (handler_table[message_id] == NULL)) {
         return_value = SCMI_NOT_FOUND;
         goto error;
     }
@@ -699,8 +814,28 @@ static void scmi_sensor_notify_trip_point(
         sizeof(trip_point_event));
 #endif
 }
+static void scmi_sensor_notify_update(fwk_id_t sensor_id, uint64_t value)
+{
+#ifdef BUILD_HAS_SCMI_NOTIFICATIONS
+    struct scmi_sensor_update_p2a update_event = {
+        .agent_id = 0x0,
+        .sensor_id = fwk_id_get_element_idx(sensor_id),
+        .sensor_value_low = (uint32_t)value,
+        .sensor_value_high = (uint32_t)(value >> 32),
+    };
+
+    scmi_sensor_ctx.scmi_notification_api->scmi_notification_notify(
+        MOD_SCMI_PROTOCOL_ID_SENSOR,
+        MOD_SCMI_SENSOR_CONTINUOUS_UPDATE_NOTIFY,
+        SCMI_SENSOR_UPDATE,
+        &update_event,
+        sizeof(update_event));
+#endif
+}
+
 static struct mod_sensor_trip_point_api sensor_trip_point_api = {
-    .notify_sensor_trip_point = scmi_sensor_notify_trip_point
+    .notify_sensor_trip_point = scmi_sensor_notify_trip_point,
+    .notify_sensor_update = scmi_sensor_notify_update,
 };
 
 /*
@@ -731,9 +866,11 @@ static int scmi_sensor_init(fwk_id_t module_id,
         fwk_mm_calloc(scmi_sensor_ctx.sensor_count,
         sizeof(struct sensor_operations));
 
-    /* Initialize the service identifier for each sensor to 'available' */
+    /* Initialize each sensor with no pending reading */
     for (unsigned int i = 0; i < scmi_sensor_ctx.sensor_count; i++)
-        scmi_sensor_ctx.sensor_ops_table[i].service_id = FWK_ID_NONE;
+        fwk_list_init(&scmi_sensor_ctx.sensor_ops_table[i].readers);
+
+    fwk_list_init(&scmi_sensor_ctx.reader_free_list);
 
     return FWK_SUCCESS;
 }
@@ -807,9 +944,129 @@ static int scmi_sensor_bind(fwk_id_t id, unsigned int round)
     return FWK_SUCCESS;
 }
 
+static int scmi_init_readers(void)
+{
+    int status;
+    int agent_count;
+    unsigned int reader_count;
+    struct sensor_reader *readers;
+
+    status = scmi_sensor_ctx.scmi_api->get_agent_count(&agent_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /*
+     * Each agent has at most one synchronous reading pending, on top of the
+     * asynchronous ones.
+     */
+    reader_count =
+        (unsigned int)agent_count + MOD_SCMI_SENSOR_MAX_PENDING_ASYNC_READS;
+    readers = fwk_mm_calloc(reader_count, sizeof(struct sensor_reader));
+
+    for (unsigned int i = 0; i < reader_count; i++)
+        fwk_list_push_tail(&scmi_sensor_ctx.reader_free_list, &readers[i].node);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Serialize the descriptor of a sensor in the format of the
+ * SENSOR_DESCRIPTION_GET response.
+ */
+static int scmi_sensor_build_desc(unsigned int desc_index)
+{
+    int status;
+    struct scmi_sensor_desc *desc;
+    struct mod_sensor_scmi_info sensor_info;
+    fwk_id_t sensor_id;
+
+    desc = &scmi_sensor_ctx.desc_table[desc_index];
+
+    sensor_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, desc_index);
+    if (!fwk_module_is_valid_element_id(sensor_id)) {
+        /* domain_idx did not map to a sensor device */
+        return FWK_E_PARAM;
+    }
+
+    status = scmi_sensor_ctx.sensor_api->get_info(sensor_id, &sensor_info);
+    if (status != FWK_SUCCESS) {
+        /* Unable to get sensor info */
+        return status;
+    }
+
+    if (sensor_info.hal_info.type >= MOD_SENSOR_TYPE_COUNT) {
+        /* Invalid sensor type */
+        return FWK_E_DATA;
+    }
+
+    if ((sensor_info.hal_info.unit_multiplier <
+         SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UNIT_MULTIPLIER_MIN) ||
+        (sensor_info.hal_info.unit_multiplier >
+         SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UNIT_MULTIPLIER_MAX)) {
+        /* Sensor unit multiplier out of range */
+        return FWK_E_DATA;
+    }
+
+    if ((sensor_info.hal_info.update_interval_multiplier <
+         SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UPDATE_MULTIPLIER_MIN) ||
+        (sensor_info.hal_info.update_interval_multiplier >
+         SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UPDATE_MULTIPLIER_MAX)) {
+        /* Sensor update interval multiplier is out of range */
+        return FWK_E_DATA;
+    }
+
+    if (sensor_info.hal_info.update_interval >=
+        SCMI_SENSOR_DESC_ATTRS_HIGH_SENSOR_UPDATE_INTERVAL_MASK) {
+        /* Update interval is too big to fit in its mask */
+        return FWK_E_DATA;
+    }
+    if (sensor_info.trip_point.count >=
+        SCMI_SENSOR_DESC_ATTRS_LOW_SENSOR_NUM_TRIP_POINTS_MASK) {
+        /* Number of trip points is too big to fit in its mask */
+        return FWK_E_DATA;
+    }
+
+    desc->sensor_id = desc_index;
+
+    desc->sensor_attributes_low = SCMI_SENSOR_DESC_ATTRIBUTES_LOW(
+        1, /* Asynchronous reading supported */
+        (uint32_t)sensor_info.trip_point.count);
+
+    desc->sensor_attributes_high = SCMI_SENSOR_DESC_ATTRIBUTES_HIGH(
+        sensor_info.hal_info.type,
+        sensor_info.hal_info.unit_multiplier,
+        (uint32_t)sensor_info.hal_info.update_interval_multiplier,
+        (uint32_t)sensor_info.hal_info.update_interval);
+
+    /*
+     * Copy sensor name into description struct. Copy n-1 chars to ensure a
+     * NULL terminator at the end. (table has been zeroed out)
+     */
+    strncpy(desc->sensor_name,
+            fwk_module_get_name(sensor_id),
+            sizeof(desc->sensor_name) - 1);
+
+    return FWK_SUCCESS;
+}
+
 static int scmi_sensor_start(fwk_id_t id)
 {
-    int status = FWK_SUCCESS;
+    int status;
+    unsigned int desc_index;
+
+    status = scmi_init_readers();
+    if (status != FWK_SUCCESS)
+        return status;
+
+    scmi_sensor_ctx.desc_table = fwk_mm_calloc(
+        scmi_sensor_ctx.sensor_count, sizeof(scmi_sensor_ctx.desc_table[0]));
+
+    for (desc_index = 0; desc_index < scmi_sensor_ctx.sensor_count;
+         desc_index++) {
+        status = scmi_sensor_build_desc(desc_index);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
 
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
     status = scmi_init_notifications(scmi_sensor_ctx.sensor_count);
@@ -0,0 +1,70 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI Message Telemetry Protocol Support.
+ */
+
+#ifndef INTERNAL_SCMI_TELEMETRY_H
+#define INTERNAL_SCMI_TELEMETRY_H
+
+#include <mod_scmi.h>
+
+#include <stdint.h>
+
+/*
+ * Telemetry Describe
+ */
+
+struct scmi_telemetry_describe_a2p {
+    uint32_t entry_index;
+};
+
+#define SCMI_TELEMETRY_ENTRY_AGENT_ID_POS 0
+#define SCMI_TELEMETRY_ENTRY_PROTOCOL_ID_POS 8
+#define SCMI_TELEMETRY_ENTRY_MESSAGE_ID_POS 16
+
+struct scmi_telemetry_entry {
+    uint32_t identifiers;
+    uint32_t count;
+    uint32_t response_count;
+    uint32_t min_response_time;
+    uint32_t max_response_time;
+    uint32_t max_queue_time;
+    uint32_t total_response_time_low;
+    uint32_t total_response_time_high;
+    uint32_t histogram[MOD_SCMI_TELEMETRY_BUCKET_COUNT];
+};
+
+struct scmi_telemetry_describe_p2a {
+    int32_t status;
+    uint32_t num_entries;
+    struct scmi_telemetry_entry entries[];
+};
+
+#define SCMI_TELEMETRY_NUM_ENTRIES_REMAINING_POS 16
+#define SCMI_TELEMETRY_NUM_ENTRIES_RETURNED_POS 0
+
+#define SCMI_TELEMETRY_NUM_ENTRIES_REMAINING_MASK \
+    (UINT32_C(0xFFFF) << SCMI_TELEMETRY_NUM_ENTRIES_REMAINING_POS)
+#define SCMI_TELEMETRY_NUM_ENTRIES_RETURNED_MASK \
+    (UINT32_C(0xFFF) << SCMI_TELEMETRY_NUM_ENTRIES_RETURNED_POS)
+
+#define SCMI_TELEMETRY_NUM_ENTRIES(RETURNED, REMAINING) \
+    ((((RETURNED) << SCMI_TELEMETRY_NUM_ENTRIES_RETURNED_POS) & \
+      SCMI_TELEMETRY_NUM_ENTRIES_RETURNED_MASK) | \
+     (((REMAINING) << SCMI_TELEMETRY_NUM_ENTRIES_REMAINING_POS) & \
+      SCMI_TELEMETRY_NUM_ENTRIES_REMAINING_MASK))
+
+/*
+ * Telemetry Reset
+ */
+
+struct scmi_telemetry_reset_p2a {
+    int32_t status;
+};
+
+#endif /* INTERNAL_SCMI_TELEMETRY_H */
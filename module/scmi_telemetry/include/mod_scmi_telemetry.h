@@ -0,0 +1,87 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI Message Telemetry Protocol Support.
+ */
+
+#ifndef MOD_SCMI_TELEMETRY_H
+#define MOD_SCMI_TELEMETRY_H
+
+#include <mod_scmi.h>
+
+#include <fwk_id.h>
+
+#include <stdint.h>
+
+/*!
+ * \ingroup GroupModules Modules
+ * \defgroup GroupSCMI_TELEMETRY SCMI Message Telemetry Protocol
+ *
+ * \details Vendor protocol reporting the message telemetry collected by the
+ *      SCMI module, see ::mod_scmi_telemetry_entry. When the firmware includes
+ *      the SDS and timer modules, the telemetry can also be published
+ *      periodically to a Shared Data Structure.
+ *
+ * \{
+ */
+
+/*!
+ * \brief SCMI Message Telemetry protocol
+ */
+#define MOD_SCMI_PROTOCOL_ID_TELEMETRY UINT32_C(0x91)
+
+/*!
+ * \brief SCMI Message Telemetry protocol version
+ */
+#define MOD_SCMI_PROTOCOL_VERSION_TELEMETRY UINT32_C(0x10000)
+
+/*!
+ * \brief Identifiers of the SCMI Message Telemetry Protocol commands
+ */
+enum mod_scmi_telemetry_command_id {
+    MOD_SCMI_TELEMETRY_DESCRIBE = 0x3,
+    MOD_SCMI_TELEMETRY_RESET = 0x4,
+};
+
+/*!
+ * \brief Header of the telemetry Shared Data Structure.
+ *
+ * \details The header is followed by the ::mod_scmi_telemetry_entry entries
+ *      that fit in the structure.
+ */
+struct mod_scmi_telemetry_sds {
+    /*! Number of entries following the header */
+    uint32_t entry_count;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_scmi_telemetry_config {
+    /*!
+     * \brief Identifier of the Shared Data Structure the telemetry is
+     *      published to, or zero to disable the publication.
+     */
+    uint32_t sds_structure_id;
+
+    /*!
+     * \brief Identifier of the alarm used to publish the telemetry.
+     *
+     * \details Ignored when ::mod_scmi_telemetry_config::sds_structure_id is
+     *      zero.
+     */
+    fwk_id_t alarm_id;
+
+    /*! Publication period in milliseconds */
+    uint32_t sds_period_ms;
+};
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SCMI_TELEMETRY_H */
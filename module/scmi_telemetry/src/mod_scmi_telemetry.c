@@ -0,0 +1,547 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI Message Telemetry Protocol Support.
+ */
+
+#include <internal/scmi_telemetry.h>
+
+#include <mod_scmi.h>
+#include <mod_scmi_telemetry.h>
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(BUILD_HAS_MOD_SDS) && defined(BUILD_HAS_MOD_TIMER)
+#    include <mod_sds.h>
+#    include <mod_timer.h>
+
+#    define SCMI_TELEMETRY_SDS
+#endif
+
+#ifdef SCMI_TELEMETRY_SDS
+enum scmi_telemetry_event_idx {
+    SCMI_TELEMETRY_EVENT_IDX_PUBLISH,
+    SCMI_TELEMETRY_EVENT_IDX_COUNT,
+};
+
+static const fwk_id_t scmi_telemetry_event_id_publish = FWK_ID_EVENT_INIT(
+    FWK_MODULE_IDX_SCMI_TELEMETRY,
+    SCMI_TELEMETRY_EVENT_IDX_PUBLISH);
+#endif
+
+struct scmi_telemetry_ctx {
+    /* Module Configuration */
+    const struct mod_scmi_telemetry_config *config;
+
+    /* SCMI module API */
+    const struct mod_scmi_from_protocol_api *scmi_api;
+
+    /* SCMI telemetry API */
+    const struct mod_scmi_telemetry_api *telemetry_api;
+
+#ifdef SCMI_TELEMETRY_SDS
+    /* SDS API */
+    const struct mod_sds_api *sds_api;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* A publication event has been queued and not yet processed */
+    volatile bool publish_pending;
+#endif
+};
+
+static int scmi_telemetry_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_telemetry_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_telemetry_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_telemetry_describe_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_telemetry_reset_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+
+/*
+ * Internal variables.
+ */
+static struct scmi_telemetry_ctx scmi_telemetry_ctx;
+
+static int (*const handler_table[])(fwk_id_t, const uint32_t *) = {
+    [MOD_SCMI_PROTOCOL_VERSION] = scmi_telemetry_protocol_version_handler,
+    [MOD_SCMI_PROTOCOL_ATTRIBUTES] = scmi_telemetry_protocol_attributes_handler,
+    [MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
+        scmi_telemetry_protocol_message_attributes_handler,
+    [MOD_SCMI_TELEMETRY_DESCRIBE] = scmi_telemetry_describe_handler,
+    [MOD_SCMI_TELEMETRY_RESET] = scmi_telemetry_reset_handler,
+};
+
+static const unsigned int payload_size_table[] = {
+    [MOD_SCMI_PROTOCOL_VERSION] = 0,
+    [MOD_SCMI_PROTOCOL_ATTRIBUTES] = 0,
+    [MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
+        sizeof(struct scmi_protocol_message_attributes_a2p),
+    [MOD_SCMI_TELEMETRY_DESCRIBE] =
+        sizeof(struct scmi_telemetry_describe_a2p),
+    [MOD_SCMI_TELEMETRY_RESET] = 0,
+};
+
+/*
+ * Static, Helper Functions
+ */
+static void encode_entry(
+    const struct mod_scmi_telemetry_entry *entry,
+    struct scmi_telemetry_entry *encoded)
+{
+    unsigned int bucket;
+
+    *encoded = (struct scmi_telemetry_entry){
+        .identifiers =
+            ((uint32_t)entry->agent_id << SCMI_TELEMETRY_ENTRY_AGENT_ID_POS) |
+            ((uint32_t)entry->protocol_id
+             << SCMI_TELEMETRY_ENTRY_PROTOCOL_ID_POS) |
+            ((uint32_t)entry->message_id
+             << SCMI_TELEMETRY_ENTRY_MESSAGE_ID_POS),
+        .count = entry->count,
+        .response_count = entry->response_count,
+        .min_response_time =
+            (entry->response_count == 0) ? 0 : entry->min_response_time,
+        .max_response_time = entry->max_response_time,
+        .max_queue_time = entry->max_queue_time,
+        .total_response_time_low = (uint32_t)entry->total_response_time,
+        .total_response_time_high =
+            (uint32_t)(entry->total_response_time >> 32),
+    };
+
+    for (bucket = 0; bucket < MOD_SCMI_TELEMETRY_BUCKET_COUNT; bucket++)
+        encoded->histogram[bucket] = entry->histogram[bucket];
+}
+
+/*
+ * Protocol Version
+ */
+static int scmi_telemetry_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_version_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .version = MOD_SCMI_PROTOCOL_VERSION_TELEMETRY,
+    };
+
+    scmi_telemetry_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Protocol Attributes
+ */
+static int scmi_telemetry_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    int status;
+    unsigned int entry_count;
+    struct scmi_protocol_attributes_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+
+    status = scmi_telemetry_ctx.telemetry_api->get_entry_count(&entry_count);
+    if (status == FWK_SUCCESS) {
+        return_values.status = SCMI_SUCCESS;
+        return_values.attributes = entry_count;
+    }
+
+    scmi_telemetry_ctx.scmi_api->respond(
+        service_id,
+        &return_values,
+        (return_values.status == SCMI_SUCCESS) ? sizeof(return_values) :
+                                                 sizeof(return_values.status));
+
+    return status;
+}
+
+/*
+ * Protocol Message Attributes
+ */
+static int scmi_telemetry_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload)
+{
+    size_t response_size;
+    const struct scmi_protocol_message_attributes_a2p *parameters;
+    unsigned int message_id;
+    struct scmi_protocol_message_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = 0,
+    };
+
+    parameters = (const struct scmi_protocol_message_attributes_a2p *)
+        payload;
+    message_id = parameters->message_id;
+
+    if ((message_id >= FWK_ARRAY_SIZE(handler_table)) ||
+        (handler_table[message_id] == NULL))
+        return_values.status = SCMI_NOT_FOUND;
+
+    response_size = (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status);
+
+    scmi_telemetry_ctx.scmi_api->respond(
+        service_id, &return_values, response_size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Telemetry Describe
+ */
+static int scmi_telemetry_describe_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    int status;
+    size_t max_payload_size;
+    size_t payload_size;
+    const struct scmi_telemetry_describe_a2p *parameters;
+    struct mod_scmi_telemetry_entry entry;
+    struct scmi_telemetry_entry encoded;
+    unsigned int entry_count, entry_index, entry_index_max;
+    unsigned int num_entries;
+    struct scmi_telemetry_describe_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+
+    payload_size = sizeof(return_values);
+
+    parameters = (const struct scmi_telemetry_describe_a2p *)payload;
+    entry_index = parameters->entry_index;
+
+    status = scmi_telemetry_ctx.scmi_api->get_max_payload_size(
+        service_id, &max_payload_size);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    if (max_payload_size < (sizeof(return_values) + sizeof(encoded))) {
+        status = FWK_E_SIZE;
+        goto exit;
+    }
+
+    status = scmi_telemetry_ctx.telemetry_api->get_entry_count(&entry_count);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    if ((entry_index >= entry_count) && (entry_index != 0)) {
+        return_values.status = SCMI_INVALID_PARAMETERS;
+        goto exit;
+    }
+
+    /* Identify the maximum number of entries we can send at once */
+    num_entries = FWK_MIN(
+        (unsigned int)(
+            (max_payload_size - sizeof(return_values)) / sizeof(encoded)),
+        entry_count - entry_index);
+    entry_index_max = entry_index + num_entries;
+
+    for (; entry_index < entry_index_max; entry_index++,
+         payload_size += sizeof(encoded)) {
+        status = scmi_telemetry_ctx.telemetry_api->get_entry(
+            entry_index, &entry);
+        if (status != FWK_SUCCESS)
+            goto exit;
+
+        encode_entry(&entry, &encoded);
+
+        status = scmi_telemetry_ctx.scmi_api->write_payload(
+            service_id, payload_size, &encoded, sizeof(encoded));
+        if (status != FWK_SUCCESS)
+            goto exit;
+    }
+
+    return_values = (struct scmi_telemetry_describe_p2a){
+        .status = SCMI_SUCCESS,
+        .num_entries = SCMI_TELEMETRY_NUM_ENTRIES(
+            num_entries, entry_count - entry_index_max),
+    };
+
+    status = scmi_telemetry_ctx.scmi_api->write_payload(
+        service_id, 0, &return_values, sizeof(return_values));
+
+exit:
+    scmi_telemetry_ctx.scmi_api->respond(service_id,
+        (return_values.status == SCMI_SUCCESS) ?
+            NULL : &return_values.status,
+        (return_values.status == SCMI_SUCCESS) ?
+            payload_size : sizeof(return_values.status));
+
+    return status;
+}
+
+/*
+ * Telemetry Reset
+ */
+static int scmi_telemetry_reset_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    int status;
+    struct scmi_telemetry_reset_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+
+    status = scmi_telemetry_ctx.telemetry_api->reset();
+    if (status == FWK_SUCCESS)
+        return_values.status = SCMI_SUCCESS;
+
+    scmi_telemetry_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return status;
+}
+
+/*
+ * SCMI module -> SCMI Message Telemetry module interface
+ */
+static int scmi_telemetry_get_scmi_protocol_id(fwk_id_t protocol_id,
+    uint8_t *scmi_protocol_id)
+{
+    *scmi_protocol_id = MOD_SCMI_PROTOCOL_ID_TELEMETRY;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_telemetry_message_handler(
+    fwk_id_t protocol_id,
+    fwk_id_t service_id,
+    const uint32_t *payload,
+    size_t payload_size,
+    unsigned int message_id)
+{
+    int32_t return_value;
+
+    static_assert(FWK_ARRAY_SIZE(handler_table) ==
+        FWK_ARRAY_SIZE(payload_size_table),
+        "[SCMI] Message telemetry protocol table sizes not consistent");
+    fwk_assert(payload != NULL);
+
+    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
+        return_value = SCMI_NOT_FOUND;
+        goto error;
+    }
+
+    if (payload_size != payload_size_table[message_id]) {
+        return_value = SCMI_PROTOCOL_ERROR;
+        goto error;
+    }
+
+    return handler_table[message_id](service_id, payload);
+
+error:
+    scmi_telemetry_ctx.scmi_api->respond(
+        service_id,
+        &return_value,
+        sizeof(return_value));
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_scmi_to_protocol_api
+    scmi_telemetry_mod_scmi_to_protocol_api = {
+        .get_scmi_protocol_id = scmi_telemetry_get_scmi_protocol_id,
+        .message_handler = scmi_telemetry_message_handler,
+    };
+
+/*
+ * Shared Data Structure publication
+ */
+#ifdef SCMI_TELEMETRY_SDS
+static void publish_alarm_callback(uintptr_t param)
+{
+    int status;
+    struct fwk_event event = {
+        .id = scmi_telemetry_event_id_publish,
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_TELEMETRY),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_TELEMETRY),
+    };
+
+    /* Skip the period if the previous publication is still queued */
+    if (scmi_telemetry_ctx.publish_pending)
+        return;
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_SUCCESS)
+        scmi_telemetry_ctx.publish_pending = true;
+}
+
+static int publish_sds(void)
+{
+    int status;
+    uint32_t structure_id = scmi_telemetry_ctx.config->sds_structure_id;
+    struct mod_scmi_telemetry_sds header = { 0 };
+    struct mod_scmi_telemetry_entry entry;
+    unsigned int entry_count;
+    unsigned int offset;
+
+    status = scmi_telemetry_ctx.telemetry_api->get_entry_count(&entry_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Write the entries that fit in the structure, then the header */
+    offset = sizeof(header);
+    for (; header.entry_count < entry_count; header.entry_count++) {
+        status = scmi_telemetry_ctx.telemetry_api->get_entry(
+            header.entry_count, &entry);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = scmi_telemetry_ctx.sds_api->struct_write(
+            structure_id, offset, &entry, sizeof(entry));
+        if (status == FWK_E_RANGE)
+            break;
+        if (status != FWK_SUCCESS)
+            return status;
+
+        offset += sizeof(entry);
+    }
+
+    status = scmi_telemetry_ctx.sds_api->struct_write(
+        structure_id, 0, &header, sizeof(header));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* The structure is left finalized after the first publication */
+    status = scmi_telemetry_ctx.sds_api->struct_finalize(structure_id);
+
+    return (status == FWK_E_STATE) ? FWK_SUCCESS : status;
+}
+#endif
+
+/*
+ * Framework handlers
+ */
+
+static int scmi_telemetry_init(fwk_id_t module_id, unsigned int element_count,
+                               const void *data)
+{
+    const struct mod_scmi_telemetry_config *config = data;
+
+    if (config == NULL)
+        return FWK_E_PARAM;
+
+#ifdef SCMI_TELEMETRY_SDS
+    if ((config->sds_structure_id != 0) && (config->sds_period_ms == 0))
+        return FWK_E_PARAM;
+#endif
+
+    scmi_telemetry_ctx.config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_telemetry_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if (round == 1)
+        return FWK_SUCCESS;
+
+    /* Bind to the SCMI module, storing an API pointer for later use. */
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_PROTOCOL),
+        &scmi_telemetry_ctx.scmi_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_TELEMETRY),
+        &scmi_telemetry_ctx.telemetry_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+#ifdef SCMI_TELEMETRY_SDS
+    if (scmi_telemetry_ctx.config->sds_structure_id == 0)
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SDS),
+        FWK_ID_API(FWK_MODULE_IDX_SDS, 0),
+        &scmi_telemetry_ctx.sds_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_module_bind(scmi_telemetry_ctx.config->alarm_id,
+        MOD_TIMER_API_ID_ALARM, &scmi_telemetry_ctx.alarm_api);
+#else
+    return FWK_SUCCESS;
+#endif
+}
+
+static int scmi_telemetry_process_bind_request(fwk_id_t source_id,
+    fwk_id_t target_id, fwk_id_t api_id, const void **api)
+{
+    /* Only accept binding requests from the SCMI module. */
+    if (!fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI)))
+        return FWK_E_ACCESS;
+
+    *api = &scmi_telemetry_mod_scmi_to_protocol_api;
+
+    return FWK_SUCCESS;
+}
+
+#ifdef SCMI_TELEMETRY_SDS
+static int scmi_telemetry_start(fwk_id_t id)
+{
+    if (scmi_telemetry_ctx.config->sds_structure_id == 0)
+        return FWK_SUCCESS;
+
+    return scmi_telemetry_ctx.alarm_api->start(
+        scmi_telemetry_ctx.config->alarm_id,
+        scmi_telemetry_ctx.config->sds_period_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        publish_alarm_callback,
+        (uintptr_t)0);
+}
+
+static int scmi_telemetry_process_event(const struct fwk_event *event,
+                                        struct fwk_event *resp_event)
+{
+    int status;
+
+    if (!fwk_id_is_equal(event->id, scmi_telemetry_event_id_publish))
+        return FWK_E_PARAM;
+
+    scmi_telemetry_ctx.publish_pending = false;
+
+    status = publish_sds();
+    if (status != FWK_SUCCESS)
+        FWK_LOG_ERR("[SCMI-TELEMETRY] Unable to publish the telemetry");
+
+    return status;
+}
+#endif
+
+/* SCMI Message Telemetry Protocol Definition */
+const struct fwk_module module_scmi_telemetry = {
+    .name = "SCMI Message Telemetry Protocol",
+    .api_count = 1,
+    .type = FWK_MODULE_TYPE_PROTOCOL,
+    .init = scmi_telemetry_init,
+    .bind = scmi_telemetry_bind,
+    .process_bind_request = scmi_telemetry_process_bind_request,
+#ifdef SCMI_TELEMETRY_SDS
+    .event_count = SCMI_TELEMETRY_EVENT_IDX_COUNT,
+    .start = scmi_telemetry_start,
+    .process_event = scmi_telemetry_process_event,
+#endif
+};
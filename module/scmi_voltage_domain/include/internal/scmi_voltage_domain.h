@@ -13,7 +13,7 @@
 
 #include <mod_voltage_domain.h>
 
-#define SCMI_PROTOCOL_VERSION_VOLTD UINT32_C(0x10000)
+#define SCMI_PROTOCOL_VERSION_VOLTD UINT32_C(0x20000)
 
 /*
  * Generic p2a
@@ -42,6 +42,12 @@ struct scmi_voltd_attributes_a2p {
 
 #define SCMI_VOLTD_NAME_LENGTH_MAX 16
 
+/* If set, the level of the domain can be set asynchronously */
+#define SCMI_VOLTD_ATTRIBUTES_ASYNC_LEVEL_SET_POS 31
+
+#define SCMI_VOLTD_ATTRIBUTES_ASYNC_LEVEL_SET_MASK \
+    (UINT32_C(0x1) << SCMI_VOLTD_ATTRIBUTES_ASYNC_LEVEL_SET_POS)
+
 struct scmi_voltd_attributes_p2a {
     int32_t status;
     uint32_t attributes;
@@ -65,6 +71,13 @@ struct scmi_voltd_level_get_p2a {
  * Set voltage level of a domain
  */
 
+/* If set, set the new voltage level asynchronously */
+#define SCMI_VOLTD_LEVEL_SET_ASYNC_POS 0
+
+#define SCMI_VOLTD_LEVEL_SET_ASYNC_MASK \
+    (UINT32_C(0x1) << SCMI_VOLTD_LEVEL_SET_ASYNC_POS)
+#define SCMI_VOLTD_LEVEL_SET_FLAGS_MASK SCMI_VOLTD_LEVEL_SET_ASYNC_MASK
+
 struct scmi_voltd_level_set_a2p {
     uint32_t domain_id;
     uint32_t flags;
@@ -75,6 +88,28 @@ struct scmi_voltd_level_set_p2a {
     int32_t status;
 };
 
+struct scmi_voltd_level_set_complete_p2a {
+    int32_t status;
+    uint32_t domain_id;
+    int32_t voltage_level;
+};
+
+/*
+ * Voltage domain event indexes
+ */
+enum scmi_voltd_event_idx {
+    SCMI_VOLTD_EVENT_IDX_SET_LEVEL,
+    SCMI_VOLTD_EVENT_IDX_COUNT,
+};
+
+/*
+ * Parameters of the set level event
+ */
+struct scmi_voltd_set_level_event_params {
+    /* Index of the voltage domain device */
+    unsigned int voltd_dev_idx;
+};
+
 /*
  * Voltage Domain Config Set
  */
@@ -97,6 +97,15 @@ struct mod_scmi_voltd_agent {
  * \brief Module configuration.
  */
 struct mod_scmi_voltd_config {
+    /*!
+     * \brief Maximum supported number of pending, asynchronous voltage level
+     *      changes.
+     *
+     * \details Asynchronous VOLTAGE_LEVEL_SET commands are refused when this
+     *      is 0.
+     */
+    uint8_t max_pending_transactions;
+
     /*!
      * \brief Pointer to the table of agent descriptors, used to provide
      *      per-agent views of voltage domain in the system.
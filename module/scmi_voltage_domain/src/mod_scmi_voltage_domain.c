@@ -16,7 +16,9 @@
 
 #include <fwk_assert.h>
 #include <fwk_attributes.h>
+#include <fwk_event.h>
 #include <fwk_id.h>
+#include <fwk_list.h>
 #include <fwk_log.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
@@ -32,12 +34,43 @@
 #    include <mod_resource_perms.h>
 #endif
 
+struct scmi_voltd_level_request {
+    /* Linked list node */
+    struct fwk_slist_node node;
+
+    /* Service identifier of the requester */
+    fwk_id_t service_id;
+
+    /* Identifier of the domain in the agent's view */
+    uint32_t domain_id;
+
+    /* Requested level, in microvolts */
+    int32_t level;
+
+    /* The requester has already been responded to */
+    bool async;
+
+    /* Token of the command, for the delayed response */
+    uint16_t token;
+};
+
 struct voltd_operations {
     /*
-     * Service identifier currently requesting operation from this voltage
-     * domain. A 'none' value indicates that there is no pending request.
+     * Level set requests received while the domain was busy, in order of
+     * arrival.
      */
-    fwk_id_t service_id;
+    struct fwk_slist level_queue;
+
+    /*
+     * Level set requests answered when the ongoing level change completes.
+     */
+    struct fwk_slist level_batch;
+
+    /*
+     * Request of the batch whose level is being applied. A NULL value
+     * indicates that there is no pending request.
+     */
+    struct scmi_voltd_level_request *level_request;
 };
 
 struct scmi_voltd_ctx {
@@ -62,6 +95,12 @@ struct scmi_voltd_ctx {
     /* Pointer to a table of domain operations */
     struct voltd_operations *voltd_ops;
 
+    /* Free level set requests */
+    struct fwk_slist level_request_free_list;
+
+    /* Number of asynchronous level changes pending */
+    unsigned int async_level_request_count;
+
 #ifdef BUILD_HAS_RESOURCE_PERMISSIONS
     /* SCMI Resource Permissions API */
     const struct mod_res_permissions_api *res_perms_api;
@@ -108,6 +147,10 @@ static int (*const handler_table[])(fwk_id_t, const uint32_t *) = {
     [MOD_SCMI_VOLTD_DESCRIBE_LEVELS] = scmi_voltd_describe_levels_handler,
 };
 
+static const fwk_id_t scmi_voltd_event_id_set_level =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_SCMI_VOLTAGE_DOMAIN,
+                      SCMI_VOLTD_EVENT_IDX_SET_LEVEL);
+
 static const unsigned int payload_size_table[] = {
     [MOD_SCMI_PROTOCOL_VERSION] = 0,
     [MOD_SCMI_PROTOCOL_ATTRIBUTES] = 0,
@@ -305,6 +348,9 @@ static int scmi_voltd_domain_attributes_handler(fwk_id_t service_id,
     strncpy(outmsg.name, fwk_module_get_name(device->element_id),
             sizeof(outmsg.name));
 
+    if (scmi_voltd_ctx.config->max_pending_transactions != 0)
+        outmsg.attributes = SCMI_VOLTD_ATTRIBUTES_ASYNC_LEVEL_SET_MASK;
+
     outmsg.status = SCMI_SUCCESS;
     outmsg_size = sizeof(outmsg);
 
@@ -384,6 +430,164 @@ exit:
     return FWK_SUCCESS;
 }
 
+/*
+ * Helpers for the voltage level set queue
+ */
+static int32_t level_set_status(int status)
+{
+    if (status == FWK_E_RANGE || status == FWK_E_PARAM)
+        return SCMI_INVALID_PARAMETERS;
+    else if (status == FWK_E_SUPPORT)
+        return SCMI_NOT_SUPPORTED;
+    else if (status == FWK_E_BUSY)
+        return SCMI_BUSY;
+    else if (status != FWK_SUCCESS)
+        return SCMI_GENERIC_ERROR;
+    else
+        return SCMI_SUCCESS;
+}
+
+static int level_request_submit(
+    unsigned int voltd_dev_idx,
+    fwk_id_t service_id,
+    uint32_t domain_id,
+    int32_t level,
+    bool async)
+{
+    int status;
+    struct voltd_operations *ops = &scmi_voltd_ctx.voltd_ops[voltd_dev_idx];
+    struct scmi_voltd_level_request *request;
+    uint16_t token = 0;
+
+    if (async && (scmi_voltd_ctx.async_level_request_count >=
+                  scmi_voltd_ctx.config->max_pending_transactions))
+        return FWK_E_BUSY;
+
+    if (async) {
+        status = scmi_voltd_ctx.scmi_api->get_token(service_id, &token);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    request = FWK_LIST_GET(
+        fwk_list_pop_head(&scmi_voltd_ctx.level_request_free_list),
+        struct scmi_voltd_level_request,
+        node);
+    if (request == NULL)
+        return FWK_E_BUSY;
+
+    request->service_id = service_id;
+    request->domain_id = domain_id;
+    request->level = level;
+    request->async = async;
+    request->token = token;
+
+    if (async)
+        scmi_voltd_ctx.async_level_request_count++;
+
+    fwk_list_push_tail(&ops->level_queue, &request->node);
+
+    return FWK_SUCCESS;
+}
+
+static void level_request_respond(
+    const struct scmi_voltd_level_request *request,
+    int32_t level,
+    int status)
+{
+    struct scmi_voltd_level_set_p2a outmsg;
+    struct scmi_voltd_level_set_complete_p2a complete_outmsg;
+
+    if (!request->async) {
+        outmsg.status = level_set_status(status);
+        scmi_voltd_ctx.scmi_api->respond(
+            request->service_id, &outmsg, sizeof(outmsg.status));
+        return;
+    }
+
+    scmi_voltd_ctx.async_level_request_count--;
+
+    complete_outmsg = (struct scmi_voltd_level_set_complete_p2a) {
+        .status = level_set_status(status),
+        .domain_id = request->domain_id,
+        .voltage_level = level,
+    };
+
+    scmi_voltd_ctx.scmi_api->respond_delayed(
+        request->service_id,
+        MOD_SCMI_PROTOCOL_ID_VOLTAGE_DOMAIN,
+        MOD_SCMI_VOLTD_LEVEL_SET,
+        request->token,
+        &complete_outmsg,
+        (complete_outmsg.status == SCMI_SUCCESS) ?
+            sizeof(complete_outmsg) : sizeof(complete_outmsg.status));
+}
+
+/*
+ * Answer all the requests that took part in the level change of a domain.
+ */
+static void level_batch_complete(unsigned int voltd_dev_idx, int status)
+{
+    struct voltd_operations *ops = &scmi_voltd_ctx.voltd_ops[voltd_dev_idx];
+    struct scmi_voltd_level_request *request;
+    int32_t level = ops->level_request->level;
+
+    while (!fwk_list_is_empty(&ops->level_batch)) {
+        request = FWK_LIST_GET(fwk_list_pop_head(&ops->level_batch),
+            struct scmi_voltd_level_request, node);
+
+        level_request_respond(request, level, status);
+
+        fwk_list_push_tail(&scmi_voltd_ctx.level_request_free_list,
+            &request->node);
+    }
+
+    ops->level_request = NULL;
+}
+
+/*
+ * Start a level change for the requests queued on a domain, if it is
+ * available.
+ *
+ * The queued requests are coalesced: only the level of the latest request is
+ * applied and all of them are answered with its outcome. The level is set
+ * from an event of the module so that a driver completing it asynchronously
+ * answers this module rather than the SCMI service the command came from.
+ */
+static void level_queue_run(unsigned int voltd_dev_idx)
+{
+    int status;
+    struct voltd_operations *ops = &scmi_voltd_ctx.voltd_ops[voltd_dev_idx];
+    struct fwk_slist_node *node;
+    struct scmi_voltd_level_request *request = NULL;
+    struct fwk_event event;
+    struct scmi_voltd_set_level_event_params *params =
+        (struct scmi_voltd_set_level_event_params *)event.params;
+
+    if (ops->level_request != NULL)
+        return;
+
+    while ((node = fwk_list_pop_head(&ops->level_queue)) != NULL) {
+        fwk_list_push_tail(&ops->level_batch, node);
+        request = FWK_LIST_GET(node, struct scmi_voltd_level_request, node);
+    }
+
+    if (request == NULL)
+        return;
+
+    ops->level_request = request;
+
+    event = (struct fwk_event) {
+        .target_id = fwk_module_id_scmi_voltage_domain,
+        .id = scmi_voltd_event_id_set_level,
+    };
+    params->voltd_dev_idx = voltd_dev_idx;
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS)
+        level_batch_complete(voltd_dev_idx, status);
+}
+
 /*
  * Voltage domain voltage level
  */
@@ -426,7 +630,7 @@ static int scmi_voltd_level_set_handler(fwk_id_t service_id,
     const uint32_t *payload)
 {
     int status = 0;
-    const struct mod_scmi_voltd_agent *agent = NULL;
+    bool asynchronous;
     const struct mod_scmi_voltd_device *device = NULL;
     const struct scmi_voltd_level_set_a2p *inmsg = NULL;
     struct scmi_voltd_level_set_p2a outmsg = {
@@ -435,6 +639,12 @@ static int scmi_voltd_level_set_handler(fwk_id_t service_id,
     size_t outmsg_size = sizeof(outmsg.status);
 
     inmsg = (const struct scmi_voltd_level_set_a2p*)payload;
+    asynchronous = inmsg->flags & SCMI_VOLTD_LEVEL_SET_ASYNC_MASK;
+
+    if ((inmsg->flags & ~SCMI_VOLTD_LEVEL_SET_FLAGS_MASK) != 0) {
+        outmsg.status = SCMI_INVALID_PARAMETERS;
+        goto exit;
+    }
 
     status = get_device(service_id, inmsg->domain_id, &device, NULL);
     if (status != FWK_SUCCESS) {
@@ -442,12 +652,38 @@ static int scmi_voltd_level_set_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    status = scmi_voltd_ctx.voltd_api->set_level(device->element_id,
-                                                 inmsg->voltage_level);
+    if (asynchronous &&
+        (scmi_voltd_ctx.config->max_pending_transactions == 0)) {
+        outmsg.status = SCMI_NOT_SUPPORTED;
+        goto exit;
+    }
+
+    /*
+     * The request is queued on the domain and applied once the domain is
+     * available. Synchronous requests are responded to on completion.
+     */
+    status = level_request_submit(
+        fwk_id_get_element_idx(device->element_id),
+        service_id,
+        inmsg->domain_id,
+        inmsg->voltage_level,
+        asynchronous);
+    if (status == FWK_E_BUSY) {
+        outmsg.status = SCMI_BUSY;
+        goto exit;
+    }
+
     if (status != FWK_SUCCESS)
         goto exit;
 
-    outmsg.status = SCMI_SUCCESS;
+    if (asynchronous) {
+        outmsg.status = SCMI_SUCCESS;
+        scmi_voltd_ctx.scmi_api->respond(service_id, &outmsg, outmsg_size);
+    }
+
+    level_queue_run(fwk_id_get_element_idx(device->element_id));
+
+    return FWK_SUCCESS;
 
 exit:
     scmi_voltd_ctx.scmi_api->respond(service_id, &outmsg, outmsg_size);
@@ -638,6 +874,8 @@ static int scmi_voltd_init(fwk_id_t module_id, unsigned int element_count,
                            const void *data)
 {
     int voltd_devices;
+    unsigned int request_count;
+    struct scmi_voltd_level_request *requests;
     const struct mod_scmi_voltd_config *config =
         (const struct mod_scmi_voltd_config *)data;
 
@@ -655,6 +893,25 @@ static int scmi_voltd_init(fwk_id_t module_id, unsigned int element_count,
     scmi_voltd_ctx.voltd_ops = fwk_mm_calloc((unsigned int)voltd_devices,
                                              sizeof(struct voltd_operations));
 
+    for (unsigned int i = 0; i < (unsigned int)voltd_devices; i++) {
+        fwk_list_init(&scmi_voltd_ctx.voltd_ops[i].level_queue);
+        fwk_list_init(&scmi_voltd_ctx.voltd_ops[i].level_batch);
+    }
+
+    /*
+     * Each agent has at most one synchronous level change pending, on top of
+     * the asynchronous ones.
+     */
+    request_count = config->agent_count + config->max_pending_transactions;
+    requests = fwk_mm_calloc(
+        request_count, sizeof(struct scmi_voltd_level_request));
+
+    fwk_list_init(&scmi_voltd_ctx.level_request_free_list);
+    for (unsigned int i = 0; i < request_count; i++) {
+        fwk_list_push_tail(
+            &scmi_voltd_ctx.level_request_free_list, &requests[i].node);
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -697,12 +954,68 @@ static int scmi_voltd_process_bind_request(fwk_id_t source_id,
     return FWK_SUCCESS;
 }
 
+static int process_set_level_event(const struct fwk_event *event)
+{
+    int status;
+    const struct scmi_voltd_set_level_event_params *params =
+        (const struct scmi_voltd_set_level_event_params *)event->params;
+    unsigned int voltd_dev_idx = params->voltd_dev_idx;
+    struct voltd_operations *ops = &scmi_voltd_ctx.voltd_ops[voltd_dev_idx];
+
+    status = scmi_voltd_ctx.voltd_api->set_level(
+        fwk_id_build_element_id(fwk_module_id_voltage_domain, voltd_dev_idx),
+        ops->level_request->level);
+    if (status == FWK_PENDING)
+        return FWK_SUCCESS;
+
+    /* Request completed */
+    level_batch_complete(voltd_dev_idx, status);
+    level_queue_run(voltd_dev_idx);
+
+    return FWK_SUCCESS;
+}
+
+static int process_response_event(const struct fwk_event *event)
+{
+    const struct mod_voltd_resp_params *params =
+        (const struct mod_voltd_resp_params *)event->params;
+    unsigned int voltd_dev_idx = fwk_id_get_element_idx(event->source_id);
+
+    if (!fwk_id_is_equal(event->id, mod_voltd_event_id_set_level_request))
+        return FWK_E_PARAM;
+
+    if (scmi_voltd_ctx.voltd_ops[voltd_dev_idx].level_request == NULL)
+        return FWK_E_STATE;
+
+    level_batch_complete(voltd_dev_idx, params->status);
+    level_queue_run(voltd_dev_idx);
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_voltd_process_event(const struct fwk_event *event,
+                                    struct fwk_event *resp_event)
+{
+    if (fwk_id_is_equal(event->id, scmi_voltd_event_id_set_level))
+        return process_set_level_event(event);
+
+    if (fwk_id_get_module_idx(event->source_id) ==
+        fwk_id_get_module_idx(fwk_module_id_voltage_domain)) {
+        /* Responses from the voltage domain HAL */
+        return process_response_event(event);
+    }
+
+    return FWK_E_PARAM;
+}
+
 /* SCMI Voltage Domain Management Protocol Definition */
 const struct fwk_module module_scmi_voltage_domain = {
     .name = "SCMI Voltage Domain Management Protocol",
     .api_count = 1,
+    .event_count = SCMI_VOLTD_EVENT_IDX_COUNT,
     .type = FWK_MODULE_TYPE_PROTOCOL,
     .init = scmi_voltd_init,
     .bind = scmi_voltd_bind,
     .process_bind_request = scmi_voltd_process_bind_request,
+    .process_event = scmi_voltd_process_event,
 };
@@ -10,6 +10,7 @@
 
 #include <fwk_element.h>
 #include <fwk_id.h>
+#include <fwk_module.h>
 #include <fwk_module_idx.h>
 
 #include <stdbool.h>
@@ -54,6 +55,25 @@
 /*! Mask for the major version field. */
 #define MOD_SDS_ID_VERSION_MAJOR_MASK 0xFF000000
 
+/*!
+ * \brief Position of the change counter in the second word of a structure
+ *      header.
+ *
+ * \details The counter is incremented, modulo 256, every time the structure
+ *      is written or finalized, once the change is visible. Application
+ *      processor firmware can compare it with the value it last saw instead
+ *      of comparing the content of the structure.
+ */
+#define MOD_SDS_HEADER_CHANGE_COUNT_POS 24
+
+/*! Mask of the change counter in the second word of a structure header. */
+#define MOD_SDS_HEADER_CHANGE_COUNT_MASK 0xFF000000
+
+/*!
+ * \brief Default number of structures held in the structure index.
+ */
+#define MOD_SDS_DEFAULT_INDEX_LENGTH 16
+
 /*!
  * \brief Element descriptor that describes an SDS region that will be
  *      automatically created during module initialization.
@@ -103,6 +123,27 @@ struct mod_sds_structure_desc {
     bool finalize;
 };
 
+/*!
+ * \brief Doorbell rung when a watched structure changes.
+ *
+ * \details Application processor firmware waiting for a structure to change,
+ *      e.g. for a ready flag to be set, can wait for the doorbell interrupt
+ *      instead of polling the structure.
+ */
+struct mod_sds_doorbell {
+    /*! Address of the register ringing the doorbell, e.g. a MHU set register */
+    uintptr_t set_addr;
+
+    /*! Value written to the register to ring the doorbell */
+    uint32_t set_mask;
+
+    /*! Table of the identifiers of the watched structures */
+    const uint32_t *structure_ids;
+
+    /*! Number of watched structures, or zero to watch all the structures */
+    unsigned int structure_count;
+};
+
 /*!
  * \brief Module configuration.
  */
@@ -121,6 +162,88 @@ struct mod_sds_config {
     /*! Identifier of the clock that this module depends on */
     fwk_id_t clock_id;
 #endif
+
+    /*!
+     * \brief Identifier of the structure the boot profile of the modules is
+     *      published in, or zero if it is not published.
+     *
+     * \details Once the firmware has booted, the structure is filled with a
+     *      ::mod_sds_boot_profile header followed by one
+     *      ::mod_sds_boot_profile_entry per module, from the module that took
+     *      the most time to boot to the one that took the least, and then
+     *      finalized. Only the entries that fit in the structure are written.
+     *
+     * \note This is only used when the firmware enables the boot profiler of
+     *      the framework (see ::FWK_BOOT_PROFILE).
+     */
+    uint32_t boot_profile_structure_id;
+
+    /*!
+     * \brief Identifier of the structure the usage of the event pool is
+     *      published in, or zero if it is not published.
+     *
+     * \details Once the firmware has booted, the structure is filled with a
+     *      ::mod_sds_event_pool and finalized. The peak usage it reports is
+     *      the size to give the event pool in the next build of the firmware
+     *      (see ::fwk_thread_queue_stats).
+     */
+    uint32_t event_pool_structure_id;
+
+    /*!
+     * \brief Number of structures held in the structure index, or zero to use
+     *      ::MOD_SDS_DEFAULT_INDEX_LENGTH.
+     *
+     * \details The module keeps the location of the structures in an index so
+     *      that reads and writes do not need to walk the SDS Memory Regions.
+     *      Structures beyond the capacity of the index are still accessible,
+     *      but are looked up by walking the regions.
+     */
+    unsigned int index_length;
+
+    /*!
+     * \brief Doorbell rung when a watched structure is written or finalized,
+     *      or NULL if no doorbell is rung.
+     */
+    const struct mod_sds_doorbell *doorbell;
+};
+
+/*!
+ * \brief Header of the boot profile structure.
+ */
+struct mod_sds_boot_profile {
+    /*! Number of entries following the header */
+    uint32_t entry_count;
+};
+
+/*!
+ * \brief Entry of the boot profile structure.
+ */
+struct mod_sds_boot_profile_entry {
+    /*! Module index */
+    uint32_t module_idx;
+
+    /*! Time spent by the module in all the pre-runtime phases, in us */
+    uint32_t total_us;
+
+    /*!
+     * Time spent by the module in each pre-runtime phase, in us, indexed by
+     * ::fwk_module_boot_phase.
+     */
+    uint32_t phases_us[FWK_MODULE_BOOT_PHASE_COUNT];
+};
+
+/*!
+ * \brief Event pool usage structure.
+ */
+struct mod_sds_event_pool {
+    /*! Number of event structures in the pool */
+    uint32_t capacity;
+
+    /*! Highest number of event structures in use at the same time */
+    uint32_t peak_used;
+
+    /*! Number of event structures added to the pool from the heap */
+    uint32_t grown;
 };
 
 /*!
@@ -226,6 +349,56 @@ struct mod_sds_api {
      * \retval ::FWK_E_STATE The structure has already been finalized.
      */
     int (*struct_finalize)(uint32_t structure_id);
+
+    /*!
+     * \brief Wait until at least one flag of a 32-bit field of a Shared Data
+     *      Structure is set.
+     *
+     * \details The structure is looked up once and the field is then polled
+     *      in place, which is cheaper than polling it with
+     *      ::mod_sds_api::struct_read.
+     *
+     * \param structure_id The identifier of the Shared Data Structure.
+     *
+     * \param offset The offset, in bytes, of the field within the Shared Data
+     *      Structure. The offset must be aligned on 4 bytes.
+     *
+     * \param mask Mask of the flags to wait for.
+     *
+     * \param[out] value Value of the field once a flag is set. Can be NULL.
+     *
+     * \retval ::FWK_SUCCESS At least one of the flags is set.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered:
+     *      - The `mask` parameter was zero.
+     *      - An invalid structure identifier was provided.
+     *      - The field extends outside of the structure bounds.
+     * \retval ::FWK_E_ALIGN The offset is not aligned on 4 bytes.
+     */
+    int (*struct_wait_flags)(uint32_t structure_id, unsigned int offset,
+                             uint32_t mask, uint32_t *value);
+
+    /*!
+     * \brief Get the address and the size of a Shared Data Structure.
+     *
+     * \details The structure is looked up once and can then be accessed in
+     *      place, which suits structures that are written often, such as
+     *      rings. The caller must not access memory beyond the size of the
+     *      structure, and maintains the data cache for the accesses it makes
+     *      through the framework cache maintenance functions.
+     *
+     * \param structure_id The identifier of the Shared Data Structure.
+     *
+     * \param[out] address Address of the first byte of the structure.
+     *
+     * \param[out] size Size, in bytes, of the structure.
+     *
+     * \retval ::FWK_SUCCESS The address and the size were returned.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered:
+     *      - The `address` or `size` parameter was a null pointer value.
+     *      - An invalid structure identifier was provided.
+     */
+    int (*struct_get_address)(uint32_t structure_id, volatile void **address,
+                              size_t *size);
 };
 
 /*!
@@ -12,6 +12,7 @@
 #endif
 
 #include <fwk_assert.h>
+#include <fwk_cache.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_macros.h>
@@ -20,8 +21,13 @@
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
+#include <fwk_time.h>
+
+#include <fmw_cmsis.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /* Arbitrary, 16 bit value that indicates a valid SDS Memory Region */
@@ -44,6 +50,20 @@
 #define MIN_REGION_SIZE (sizeof(struct region_descriptor) + \
                          MIN_ALIGNED_STRUCT_SIZE)
 
+/* Module events */
+enum sds_event_idx {
+#ifdef FWK_BOOT_PROFILE
+    /* Publish the boot profile once the firmware has booted */
+    SDS_EVENT_IDX_PUBLISH_BOOT_PROFILE,
+#endif
+
+    /* Publish the usage of the event pool once the firmware has booted */
+    SDS_EVENT_IDX_PUBLISH_EVENT_POOL,
+
+    /* Number of defined events */
+    SDS_EVENT_IDX_COUNT
+};
+
 /* Header containing Shared Data Structure metadata */
 struct structure_header {
     /*
@@ -67,8 +87,11 @@ struct structure_header {
      */
     uint32_t size : 23;
 
-    /* Reserved */
-    uint32_t reserved : 8;
+    /*
+     * Number of times the structure has been written or finalized, modulo
+     * 256, see MOD_SDS_HEADER_CHANGE_COUNT_POS.
+     */
+    uint32_t change_count : 8;
 };
 
 /* Region Descriptor describing the SDS Memory Region */
@@ -102,6 +125,18 @@ struct region_descriptor {
     uint32_t region_size;
 };
 
+/* Entry of the structure index */
+struct index_entry {
+    /* Identifier of the structure */
+    uint32_t id;
+
+    /* Structure Header in the SDS Memory Region */
+    volatile struct structure_header *header;
+
+    /* Region Descriptor of the region holding the structure */
+    volatile struct region_descriptor *region_desc;
+};
+
 /* Module context structure*/
 struct sds_ctx {
     struct {
@@ -111,6 +146,18 @@ struct sds_ctx {
         /* Pointer to the next free memory address in the SDS Memory Region. */
         volatile char *free_mem_base;
     } *regions;
+
+    /* Index of the structures, in no particular order */
+    struct index_entry *index;
+
+    /* Number of entries in the index */
+    unsigned int index_count;
+
+    /* Capacity of the index */
+    unsigned int index_length;
+
+    /* Doorbell rung when a watched structure changes, NULL if none */
+    const struct mod_sds_doorbell *doorbell;
 };
 
 /* Module context */
@@ -165,7 +212,45 @@ static bool validate_structure_access(uint32_t structure_size, uint32_t offset,
 }
 
 /*
- * Search the SDS Memory Region(s) for a given structure ID and return a
+ * The location of the structures is kept in an index so that they can be
+ * accessed without walking the SDS Memory Regions. The index is only a cache:
+ * an entry whose header no longer matches is dropped and the regions are
+ * walked again.
+ */
+static void index_add(uint32_t structure_id,
+                      volatile struct structure_header *header,
+                      volatile struct region_descriptor *region_desc)
+{
+    struct index_entry *entry;
+
+    if (ctx.index_count >= ctx.index_length)
+        return;
+
+    entry = &ctx.index[ctx.index_count++];
+    entry->id = structure_id;
+    entry->header = header;
+    entry->region_desc = region_desc;
+}
+
+static struct index_entry *index_find(uint32_t structure_id)
+{
+    unsigned int entry_idx;
+
+    for (entry_idx = 0; entry_idx < ctx.index_count; entry_idx++) {
+        if (ctx.index[entry_idx].id == structure_id)
+            return &ctx.index[entry_idx];
+    }
+
+    return NULL;
+}
+
+static void index_remove(struct index_entry *entry)
+{
+    *entry = ctx.index[--ctx.index_count];
+}
+
+/*
+ * Walk the SDS Memory Region(s) for a given structure ID and return a
  * copy of the Structure Header that holds its information. Optionally, a
  * char pointer pointer may be provided to retrieve a pointer to the base
  * address of the structure content.
@@ -181,9 +266,9 @@ static bool validate_structure_access(uint32_t structure_size, uint32_t offset,
  *
  * If a structure with the given ID is not present then FWK_E_PARAM is returned.
  */
-static int get_structure_info(uint32_t structure_id,
-                              struct structure_header *header,
-                              volatile char **structure_base)
+static int find_structure(uint32_t structure_id,
+                          struct structure_header *header,
+                          volatile char **structure_base)
 {
    volatile struct structure_header *current_header;
    size_t offset, region_size, struct_count, region_idx, struct_idx;
@@ -209,6 +294,8 @@ static int get_structure_info(uint32_t structure_id,
                return FWK_E_DATA;
 
            if (current_header->id == structure_id) {
+               index_add(structure_id, current_header, region_desc);
+
                if (structure_base != NULL) {
                    *structure_base = ((volatile char *)current_header
                                       + sizeof(struct structure_header));
@@ -228,6 +315,38 @@ static int get_structure_info(uint32_t structure_id,
    return FWK_E_PARAM;
 }
 
+/*
+ * Return a copy of the Structure Header of a given structure ID and,
+ * optionally, a pointer to the base address of the structure content.
+ *
+ * The structure is looked up in the index first and the SDS Memory Regions
+ * are only walked when it is not found there, see find_structure().
+ */
+static int get_structure_info(uint32_t structure_id,
+                              struct structure_header *header,
+                              volatile char **structure_base)
+{
+    struct index_entry *entry;
+
+    entry = index_find(structure_id);
+    if (entry != NULL) {
+        if ((entry->header->id == structure_id) &&
+            header_is_valid(entry->region_desc, entry->header)) {
+            if (structure_base != NULL) {
+                *structure_base = ((volatile char *)entry->header
+                                   + sizeof(struct structure_header));
+            }
+
+            *header = *entry->header;
+            return FWK_SUCCESS;
+        }
+
+        index_remove(entry);
+    }
+
+    return find_structure(structure_id, header, structure_base);
+}
+
 /*
  * Search the SDS Memory Region to determine if a structure with the given ID
  * is present.
@@ -283,17 +402,22 @@ static int struct_alloc(const struct mod_sds_structure_desc *struct_desc)
     header->id = struct_desc->id;
     header->size = padded_size;
     header->valid = false;
+    header->change_count = 0;
     *free_mem_base += sizeof(*header);
     *free_mem_size -= sizeof(*header);
 
+    index_add(struct_desc->id, header, region_desc);
+
     /* Zero the memory reserved for the structure, avoiding the header */
     for (unsigned int i = 0; i < padded_size; i++)
         (*free_mem_base)[i] = 0u;
     *free_mem_base += padded_size;
     *free_mem_size -= padded_size;
+    fwk_cache_clean(header, sizeof(*header) + padded_size);
 
     /* Increment the structure count within the region descriptor */
     region_desc->structure_count++;
+    fwk_cache_clean(region_desc, sizeof(*region_desc));
 
 exit:
     return status;
@@ -325,6 +449,10 @@ static int reinitialize_memory_region(
     volatile struct region_descriptor *region_desc;
 
     region_desc = (volatile struct region_descriptor *)(region_config->base);
+
+    /* The region was written by a previous firmware image */
+    fwk_cache_invalidate(region_desc, region_config->size);
+
     if (region_desc->signature != REGION_SIGNATURE)
         return FWK_E_DATA;
 
@@ -340,6 +468,8 @@ static int reinitialize_memory_region(
         if (!header_is_valid(region_desc, header))
             return FWK_E_DATA; /* Unexpected invalid header */
 
+        index_add(header->id, header, region_desc);
+
         mem_used += header->size;
         mem_used += sizeof(struct structure_header);
         if (mem_used > region_desc->region_size)
@@ -358,6 +488,7 @@ static int reinitialize_memory_region(
      *   - region_desc->region_size is the old size from the ROM image;
      */
     region_desc->region_size = region_config->size;
+    fwk_cache_clean(region_desc, sizeof(*region_desc));
     ctx.regions[region_idx].free_mem_size = region_config->size - mem_used;
     ctx.regions[region_idx].free_mem_base =
         (volatile char *)region_config->base + mem_used;
@@ -382,6 +513,7 @@ static int create_memory_region(const struct mod_sds_region_desc* region_config,
     region_desc->version_major = SUPPORTED_VERSION_MAJOR;
     region_desc->version_minor = SUPPORTED_VERSION_MINOR;
     region_desc->region_size = region_config->size;
+    fwk_cache_clean(region_desc, sizeof(*region_desc));
 
     ctx.regions[region_idx].free_mem_size = region_config->size
         - sizeof(struct region_descriptor);
@@ -393,6 +525,44 @@ static int create_memory_region(const struct mod_sds_region_desc* region_config,
     return FWK_SUCCESS;
 }
 
+static bool is_watched(uint32_t structure_id)
+{
+    const struct mod_sds_doorbell *doorbell = ctx.doorbell;
+    unsigned int i;
+
+    if (doorbell->structure_count == 0)
+        return true;
+
+    for (i = 0; i < doorbell->structure_count; i++) {
+        if (doorbell->structure_ids[i] == structure_id)
+            return true;
+    }
+
+    return false;
+}
+
+/*
+ * Count a change of a structure in its header, once the change itself is
+ * visible, and ring the doorbell if the structure is watched.
+ */
+static void signal_change(uint32_t structure_id, volatile char *structure_base)
+{
+    volatile struct structure_header *header_mem;
+
+    header_mem = (volatile struct structure_header *)(
+        structure_base - sizeof(struct structure_header));
+    header_mem->change_count++;
+    fwk_cache_clean(header_mem, sizeof(*header_mem));
+
+    if ((ctx.doorbell == NULL) || !is_watched(structure_id))
+        return;
+
+    /* The change must be visible before the doorbell is rung */
+    __DMB();
+
+    *(volatile uint32_t *)ctx.doorbell->set_addr = ctx.doorbell->set_mask;
+}
+
 static int struct_write(uint32_t structure_id, unsigned int offset,
                         const void *data, size_t size)
 {
@@ -414,6 +584,9 @@ static int struct_write(uint32_t structure_id, unsigned int offset,
 
     for (unsigned int i = 0; i < size; i++)
         structure_base[offset + i] = ((const char*)data)[i];
+    fwk_cache_clean(structure_base + offset, size);
+
+    signal_change(structure_id, structure_base);
 
     return FWK_SUCCESS;
 }
@@ -434,6 +607,9 @@ static int struct_finalize(uint32_t structure_id)
     header_mem = (volatile struct structure_header *)(
         structure_base - sizeof(header));
     header_mem->valid = true;
+    fwk_cache_clean(header_mem, sizeof(*header_mem));
+
+    signal_change(structure_id, structure_base);
 
     return FWK_SUCCESS;
 }
@@ -463,6 +639,96 @@ static int struct_init(const struct mod_sds_structure_desc *struct_desc)
     return status;
 }
 
+#ifdef FWK_BOOT_PROFILE
+static int publish_boot_profile(uint32_t structure_id)
+{
+    int status;
+    const struct fwk_module_boot_profile *profile;
+    size_t profile_count;
+    volatile char *structure_base;
+    struct structure_header header;
+    struct mod_sds_boot_profile profile_header;
+    struct mod_sds_boot_profile_entry entry;
+    unsigned int offset;
+
+    status = fwk_module_get_boot_profile(&profile, &profile_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = get_structure_info(structure_id, &header, &structure_base);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (header.size < sizeof(profile_header))
+        return FWK_E_RANGE;
+
+    profile_header.entry_count = (uint32_t)FWK_MIN(
+        profile_count,
+        (header.size - sizeof(profile_header)) / sizeof(entry));
+
+    status = struct_write(
+        structure_id, 0, &profile_header, sizeof(profile_header));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    offset = sizeof(profile_header);
+    for (uint32_t i = 0; i < profile_header.entry_count; i++) {
+        entry.module_idx = fwk_id_get_module_idx(profile[i].module_id);
+        entry.total_us = (uint32_t)fwk_time_duration_us(profile[i].total);
+
+        for (unsigned int phase = 0; phase < FWK_MODULE_BOOT_PHASE_COUNT;
+             phase++) {
+            entry.phases_us[phase] =
+                (uint32_t)fwk_time_duration_us(profile[i].phases[phase]);
+        }
+
+        status = struct_write(structure_id, offset, &entry, sizeof(entry));
+        if (status != FWK_SUCCESS)
+            return status;
+
+        offset += sizeof(entry);
+    }
+
+    return struct_finalize(structure_id);
+}
+#endif
+
+static int publish_event_pool(uint32_t structure_id)
+{
+    int status;
+    struct fwk_thread_queue_stats stats;
+    struct mod_sds_event_pool event_pool;
+
+    status = fwk_thread_get_queue_stats(&stats);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    event_pool.capacity = (uint32_t)stats.capacity;
+    event_pool.peak_used = (uint32_t)stats.peak_used;
+    event_pool.grown = (uint32_t)stats.grown;
+
+    status = struct_write(structure_id, 0, &event_pool, sizeof(event_pool));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return struct_finalize(structure_id);
+}
+
+static int put_publish_event(enum sds_event_idx event_idx)
+{
+    /*
+     * The event is only processed once every module has started, when the
+     * boot is complete.
+     */
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SDS, event_idx),
+        .source_id = fwk_module_id_sds,
+        .target_id = fwk_module_id_sds,
+    };
+
+    return fwk_thread_put_event(&event);
+}
+
 static int init_sds(void)
 {
     const struct mod_sds_config *config;
@@ -472,6 +738,7 @@ static int init_sds(void)
     const struct mod_sds_structure_desc *struct_desc;
     unsigned int region_idx;
     const struct mod_sds_region_desc *region_config;
+    unsigned int index_count;
     unsigned int notification_count;
     struct fwk_event notification_event = {
         .id = mod_sds_notification_id_initialized,
@@ -480,14 +747,21 @@ static int init_sds(void)
 
     config = fwk_module_get_data(fwk_module_id_sds);
 
+    /* The index is rebuilt from the contents of the regions */
+    ctx.index_count = 0;
+
     for (region_idx = 0; region_idx < config->region_count; region_idx++) {
         region_config = &(config->regions[region_idx]);
         /*
          * Either reinitialize the memory region,
          * or create it for the first time
          */
+        index_count = ctx.index_count;
         status = reinitialize_memory_region(region_config, region_idx);
         if (status != FWK_SUCCESS) {
+            /* Drop the structures indexed before the region was rejected */
+            ctx.index_count = index_count;
+
             status = create_memory_region(region_config, region_idx);
             if (status != FWK_SUCCESS)
                 return status;
@@ -504,6 +778,20 @@ static int init_sds(void)
             return status;
     }
 
+#ifdef FWK_BOOT_PROFILE
+    if (config->boot_profile_structure_id != 0) {
+        status = put_publish_event(SDS_EVENT_IDX_PUBLISH_BOOT_PROFILE);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+#endif
+
+    if (config->event_pool_structure_id != 0) {
+        status = put_publish_event(SDS_EVENT_IDX_PUBLISH_EVENT_POOL);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     return fwk_notification_notify(&notification_event, &notification_count);
 }
 
@@ -546,6 +834,7 @@ static int sds_struct_read(uint32_t structure_id, unsigned int offset,
     if (status != FWK_SUCCESS)
         return status;
 
+    fwk_cache_invalidate(structure_base + offset, size);
     for (unsigned int i = 0; i < size; i++)
         ((char*)data)[i] = structure_base[offset + i];
 
@@ -557,10 +846,67 @@ static int sds_struct_finalize(uint32_t structure_id)
     return struct_finalize(structure_id);
 }
 
+static int sds_struct_wait_flags(uint32_t structure_id, unsigned int offset,
+                                 uint32_t mask, uint32_t *value)
+{
+    int status;
+    volatile char *structure_base;
+    volatile uint32_t *field;
+    struct structure_header header;
+    uint32_t field_value;
+
+    if (mask == 0)
+        return FWK_E_PARAM;
+
+    if ((offset % sizeof(uint32_t)) != 0)
+        return FWK_E_ALIGN;
+
+    status = get_structure_info(structure_id, &header, &structure_base);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = validate_structure_access(header.size, offset, sizeof(*field));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    field = (volatile uint32_t *)(structure_base + offset);
+    do {
+        fwk_cache_invalidate(field, sizeof(*field));
+        field_value = *field;
+    } while ((field_value & mask) == 0);
+
+    if (value != NULL)
+        *value = field_value;
+
+    return FWK_SUCCESS;
+}
+
+static int sds_struct_get_address(uint32_t structure_id,
+                                  volatile void **address, size_t *size)
+{
+    int status;
+    volatile char *structure_base;
+    struct structure_header header;
+
+    if ((address == NULL) || (size == NULL))
+        return FWK_E_PARAM;
+
+    status = get_structure_info(structure_id, &header, &structure_base);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *address = structure_base;
+    *size = header.size;
+
+    return FWK_SUCCESS;
+}
+
 static const struct mod_sds_api module_api = {
     .struct_write = sds_struct_write,
     .struct_read = sds_struct_read,
     .struct_finalize = sds_struct_finalize,
+    .struct_wait_flags = sds_struct_wait_flags,
+    .struct_get_address = sds_struct_get_address,
 };
 
 /*
@@ -593,6 +939,20 @@ static int sds_init(fwk_id_t module_id, unsigned int element_count,
     if (ctx.regions == NULL)
         return FWK_E_NOMEM;
 
+    if ((config->doorbell != NULL) &&
+        ((config->doorbell->set_addr == 0) ||
+         ((config->doorbell->structure_count != 0) &&
+          (config->doorbell->structure_ids == NULL))))
+        return FWK_E_PARAM;
+
+    ctx.doorbell = config->doorbell;
+
+    ctx.index_length = (config->index_length != 0) ?
+        config->index_length : MOD_SDS_DEFAULT_INDEX_LENGTH;
+    ctx.index = fwk_mm_alloc(ctx.index_length, sizeof(ctx.index[0]));
+    if (ctx.index == NULL)
+        return FWK_E_NOMEM;
+
     return FWK_SUCCESS;
 }
 
@@ -635,6 +995,28 @@ static int sds_start(fwk_id_t id)
     return init_sds();
 }
 
+static int sds_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    const struct mod_sds_config *config;
+
+    config = fwk_module_get_data(fwk_module_id_sds);
+
+    switch (fwk_id_get_event_idx(event->id)) {
+#ifdef FWK_BOOT_PROFILE
+    case SDS_EVENT_IDX_PUBLISH_BOOT_PROFILE:
+        return publish_boot_profile(config->boot_profile_structure_id);
+#endif
+
+    case SDS_EVENT_IDX_PUBLISH_EVENT_POOL:
+        return publish_event_pool(config->event_pool_structure_id);
+
+    default:
+        return FWK_E_PARAM;
+    }
+}
+
 #ifdef BUILD_HAS_MOD_CLOCK
 static int sds_process_notification(
     const struct fwk_event *event,
@@ -659,12 +1041,13 @@ const struct fwk_module module_sds = {
     .name = "Shared Data Storage",
     .type = FWK_MODULE_TYPE_SERVICE,
     .api_count = 1,
-    .event_count = 0,
+    .event_count = SDS_EVENT_IDX_COUNT,
     .notification_count = MOD_SDS_NOTIFICATION_IDX_COUNT,
     .init = sds_init,
     .element_init = sds_element_init,
     .process_bind_request = sds_process_bind_request,
     .start = sds_start,
+    .process_event = sds_process_event,
 #ifdef BUILD_HAS_MOD_CLOCK
     .process_notification = sds_process_notification
 #endif
@@ -0,0 +1,90 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Log ring in a Shared Data Structure.
+ */
+
+#ifndef MOD_SDS_LOG_H
+#define MOD_SDS_LOG_H
+
+#include <fwk_id.h>
+
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupSdsLog SDS Log
+ *
+ * \brief Log ring in a Shared Data Structure.
+ *
+ * \details The module is a stream adapter that copies every character written
+ *      to it into a ring held in a Shared Data Structure, and forwards it to
+ *      another stream, such as a UART. Using the module as the log drain
+ *      (`FMW_LOG_DRAIN_ID`) makes the firmware logs readable by the
+ *      application processor without a UART.
+ *
+ *      The structure starts with a ::mod_sds_log_header followed by the ring.
+ *      The character with the sequence number N is at the offset
+ *      N % mod_sds_log_header::size of the ring. The firmware is the only
+ *      writer: it writes the characters before it publishes the new sequence
+ *      number. A reader copies the characters between its last sequence
+ *      number and the current one, then reads the sequence number again: the
+ *      characters whose sequence number is lower than the new sequence number
+ *      minus the size of the ring may have been overwritten while they were
+ *      copied.
+ *
+ *      Characters written before the module has started are only forwarded.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Header of the log ring.
+ */
+struct mod_sds_log_header {
+    /*! Number of characters written to the ring since boot, modulo 2^32 */
+    uint32_t sequence;
+
+    /*! Size of the ring in bytes, a power of two */
+    uint32_t size;
+};
+
+/*!
+ * \brief Module configuration.
+ *
+ * \note The configuration must be static as the stream may be opened by the
+ *      framework before the module is initialized.
+ */
+struct mod_sds_log_config {
+    /*!
+     * \brief Identifier of the Shared Data Structure holding the ring.
+     *
+     * \details The ring fills the largest power of two number of bytes that
+     *      fits in the structure after the header.
+     */
+    uint32_t structure_id;
+
+    /*!
+     * \brief Identifier of the stream the characters are forwarded to, or
+     *      ::FWK_ID_NONE.
+     */
+    fwk_id_t forward_id;
+};
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SDS_LOG_H */
@@ -0,0 +1,263 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Log ring in a Shared Data Structure.
+ */
+
+#include <mod_sds.h>
+#include <mod_sds_log.h>
+
+#include <fwk_assert.h>
+#include <fwk_cache.h>
+#include <fwk_id.h>
+#include <fwk_interrupt.h>
+#include <fwk_io.h>
+#include <fwk_math.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+
+#include <fmw_cmsis.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct sds_log_ctx {
+    /* Module configuration */
+    const struct mod_sds_log_config *config;
+
+    /* Whether the stream is open */
+    bool open;
+
+    /* Stream the characters are forwarded to */
+    struct fwk_io_stream forward;
+
+    /* SDS API */
+    const struct mod_sds_api *sds_api;
+
+    /* Header of the ring, NULL until the module has started */
+    volatile struct mod_sds_log_header *header;
+
+    /* Ring storage */
+    volatile char *ring;
+
+    /* Size of the ring in bytes, a power of two */
+    uint32_t size;
+
+    /* Number of characters written to the ring */
+    uint32_t sequence;
+};
+
+static struct sds_log_ctx sds_log_ctx;
+
+/*
+ * Static helpers
+ */
+
+static void sds_log_push(const char *buffer, size_t size)
+{
+    uint32_t sequence;
+    uint32_t mask = sds_log_ctx.size - 1;
+    size_t start;
+
+    if (sds_log_ctx.header == NULL)
+        return;
+
+    fwk_interrupt_global_disable();
+
+    sequence = sds_log_ctx.sequence;
+
+    /* Only the end of a span larger than the ring is kept */
+    if (size > sds_log_ctx.size) {
+        sequence += (uint32_t)(size - sds_log_ctx.size);
+        buffer += size - sds_log_ctx.size;
+        size = sds_log_ctx.size;
+    }
+
+    for (size_t i = 0; i < size; i++)
+        sds_log_ctx.ring[(sequence + i) & mask] = buffer[i];
+
+    /* The span may wrap around the end of the ring */
+    start = sequence & mask;
+    if ((start + size) > sds_log_ctx.size) {
+        fwk_cache_clean(
+            sds_log_ctx.ring + start, sds_log_ctx.size - start);
+        fwk_cache_clean(
+            sds_log_ctx.ring, start + size - sds_log_ctx.size);
+    } else
+        fwk_cache_clean(sds_log_ctx.ring + start, size);
+
+    sequence += (uint32_t)size;
+    sds_log_ctx.sequence = sequence;
+
+    /* The characters must be visible before the new sequence number */
+    __DMB();
+
+    sds_log_ctx.header->sequence = sequence;
+    fwk_cache_clean(sds_log_ctx.header, sizeof(*sds_log_ctx.header));
+
+    fwk_interrupt_global_enable();
+}
+
+static bool sds_log_is_forwarding(void)
+{
+    return sds_log_ctx.forward.adapter != NULL;
+}
+
+/*
+ * Stream adapter
+ */
+
+static int sds_log_io_open(const struct fwk_io_stream *stream)
+{
+    int status;
+
+    if (!fwk_id_is_type(stream->id, FWK_ID_TYPE_MODULE))
+        return FWK_E_SUPPORT;
+
+    if (sds_log_ctx.open) /* Refuse to open the module twice */
+        return FWK_E_BUSY;
+
+    sds_log_ctx.config = fwk_module_get_data(stream->id);
+
+    if (!fwk_id_is_equal(sds_log_ctx.config->forward_id, FWK_ID_NONE)) {
+        status = fwk_io_open(
+            &sds_log_ctx.forward, sds_log_ctx.config->forward_id, stream->mode);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    sds_log_ctx.open = true;
+
+    return FWK_SUCCESS;
+}
+
+static int sds_log_io_putch(const struct fwk_io_stream *stream, char ch)
+{
+    sds_log_push(&ch, sizeof(ch));
+
+    if (!sds_log_is_forwarding())
+        return FWK_SUCCESS;
+
+    return fwk_io_putch(&sds_log_ctx.forward, ch);
+}
+
+static int sds_log_io_write(
+    const struct fwk_io_stream *stream,
+    const char *buffer,
+    size_t size)
+{
+    sds_log_push(buffer, size);
+
+    if (!sds_log_is_forwarding())
+        return FWK_SUCCESS;
+
+    return fwk_io_write(&sds_log_ctx.forward, NULL, buffer, sizeof(char), size);
+}
+
+static int sds_log_io_flush(const struct fwk_io_stream *stream)
+{
+    if (!sds_log_is_forwarding())
+        return FWK_SUCCESS;
+
+    return fwk_io_flush(&sds_log_ctx.forward);
+}
+
+static int sds_log_io_close(const struct fwk_io_stream *stream)
+{
+    int status = FWK_SUCCESS;
+
+    if (sds_log_is_forwarding())
+        status = fwk_io_close(&sds_log_ctx.forward);
+
+    sds_log_ctx.open = false;
+
+    return status;
+}
+
+/*
+ * Framework handlers
+ */
+
+static int sds_log_init(fwk_id_t module_id, unsigned int element_count,
+                        const void *data)
+{
+    if (data == NULL)
+        return FWK_E_PARAM;
+
+    sds_log_ctx.config = data;
+
+    return FWK_SUCCESS;
+}
+
+static int sds_log_bind(fwk_id_t id, unsigned int round)
+{
+    if (round > 0)
+        return FWK_SUCCESS;
+
+    return fwk_module_bind(fwk_module_id_sds,
+                           FWK_ID_API(FWK_MODULE_IDX_SDS, 0),
+                           &sds_log_ctx.sds_api);
+}
+
+static int sds_log_start(fwk_id_t id)
+{
+    int status;
+    volatile void *address;
+    size_t size;
+
+    status = sds_log_ctx.sds_api->struct_get_address(
+        sds_log_ctx.config->structure_id, &address, &size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (size <= sizeof(struct mod_sds_log_header))
+        return FWK_E_SIZE;
+
+    size -= sizeof(struct mod_sds_log_header);
+    if (size > UINT32_MAX)
+        size = UINT32_MAX;
+
+    sds_log_ctx.size = fwk_math_pow2(fwk_math_log2((uint32_t)size));
+    sds_log_ctx.ring =
+        (volatile char *)address + sizeof(struct mod_sds_log_header);
+
+    *(volatile struct mod_sds_log_header *)address =
+        (struct mod_sds_log_header){
+            .sequence = 0,
+            .size = sds_log_ctx.size,
+        };
+    fwk_cache_clean(address, sizeof(struct mod_sds_log_header));
+
+    status = sds_log_ctx.sds_api->struct_finalize(
+        sds_log_ctx.config->structure_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Start copying the characters to the ring */
+    sds_log_ctx.header = address;
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_sds_log = {
+    .name = "SDS Log",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .init = sds_log_init,
+    .bind = sds_log_bind,
+    .start = sds_log_start,
+
+    .adapter =
+        (struct fwk_io_adapter){
+            .open = sds_log_io_open,
+            .putch = sds_log_io_putch,
+            .write = sds_log_io_write,
+            .flush = sds_log_io_flush,
+            .close = sds_log_io_close,
+        },
+};
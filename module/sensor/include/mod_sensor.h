@@ -130,6 +130,28 @@ enum mod_sensor_type {
 struct mod_sensor_trip_point_info {
     /*! Sensor trip point count */
     uint32_t count;
+
+    /*!
+     * \brief Trip point hysteresis.
+     *
+     * \details A trip point crossed upwards is only considered crossed
+     *      downwards once the sensor value is at least this much below its
+     *      threshold, in the unit of the sensor values.
+     */
+    uint64_t hysteresis;
+
+    /*!
+     * \brief Minimum interval between trip point notifications in
+     *      microseconds.
+     *
+     * \details Crossings happening within the interval are merged: once the
+     *      interval has elapsed, only the trip points whose state differs from
+     *      the last notified one are notified. May be 0 to notify every
+     *      crossing.
+     *
+     * \note Requires a framework time driver.
+     */
+    uint32_t min_notify_interval_us;
 };
 
 /*!
@@ -186,6 +208,30 @@ struct mod_sensor_scmi_info {
 
     /*! Sensor trip information */
     struct mod_sensor_trip_point_info trip_point;
+
+    /*!
+     * \brief Sampling period in milliseconds.
+     *
+     * \details Zero when the sensor is not sampled periodically.
+     */
+    uint32_t sampling_period_ms;
+};
+
+/*!
+ * \brief Statistics over the latest samples of a sensor.
+ */
+struct mod_sensor_statistics {
+    /*! Lowest sample value */
+    uint64_t min;
+
+    /*! Highest sample value */
+    uint64_t max;
+
+    /*! Average of the sample values, rounded down */
+    uint64_t avg;
+
+    /*! Number of samples the statistics were computed over */
+    unsigned int sample_count;
 };
 
 /*!
@@ -235,6 +281,36 @@ struct mod_sensor_dev_config {
 
     /*! Sensor trip information */
     struct mod_sensor_trip_point_info trip_point;
+
+    /*!
+     * \brief Maximum age of a cached reading in microseconds.
+     *
+     * \details A reading at most this old is returned without querying the
+     *      driver. When 0, the driver is queried for every reading.
+     *
+     * \note Caching requires a framework time driver.
+     */
+    uint32_t max_age_us;
+
+    /*!
+     * \brief Sampling period in milliseconds.
+     *
+     * \details When not zero, the sensor is read periodically by the sampling
+     *      engine of the module and each sample is forwarded to
+     *      ::mod_sensor_trip_point_api::notify_sensor_update. The period is
+     *      rounded down to a multiple of the sampling tick, which is the
+     *      greatest common divisor of the periods of all the sensors.
+     *
+     * \note Requires ::mod_sensor_config::sampling_alarm_id.
+     */
+    uint32_t sampling_period_ms;
+
+    /*!
+     * \brief Number of samples kept in the sensor history.
+     *
+     * \details May be 0 if no statistics are needed for the sensor.
+     */
+    unsigned int history_length;
 };
 
 /*!
@@ -248,6 +324,15 @@ struct mod_sensor_config {
 
     /*! Trip point API identifier */
     fwk_id_t trip_point_api_id;
+
+    /*!
+     * \brief Sampling alarm identifier.
+     *
+     * \details A single periodic alarm wakes up the sampling engine for all
+     *      the sensors with a sampling period. Only used when at least one
+     *      sensor is sampled.
+     */
+    fwk_id_t sampling_alarm_id;
 };
 
 /*!
@@ -269,6 +354,21 @@ struct mod_sensor_driver_api {
      */
     int (*get_value)(fwk_id_t id, uint64_t *value);
 
+    /*!
+     * \brief Get the values of consecutive sensors in a single pass, optional.
+     *
+     * \details The values must be read synchronously, and be as consistent
+     *      with each other as the hardware allows.
+     *
+     * \param id Identifier of the first sensor device.
+     * \param count Number of sensor devices, consecutive from the first one.
+     * \param[out] values Table of \p count sensor values.
+     *
+     * \retval ::FWK_SUCCESS The values were read successfully.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_values)(fwk_id_t id, unsigned int count, uint64_t *values);
+
     /*!
      * \brief Get sensor information.
      *
@@ -288,21 +388,44 @@ struct mod_sensor_api {
     /*!
      * \brief Read sensor value.
      *
-     * \details Read current sensor value.
+     * \details Read current sensor value. A cached value is returned if it
+     *      is not older than ::mod_sensor_dev_config::max_age_us. If a reading
+     *      is already in progress, the caller waits for its result.
      *
      * \param id Specific sensor device id.
      * \param[out] value The sensor value.
      *
      * \retval ::FWK_SUCCESS Operation succeeded.
      * \retval ::FWK_E_DEVICE Driver error.
-     * \retval ::FWK_E_BUSY At least one reading of the sensor value is already
-     *      on-going.
      * \retval ::FWK_PENDING The request is pending. The requested value will be
      *      provided via a response event.
      * \return One of the standard framework error codes.
      */
     int (*get_value)(fwk_id_t id, uint64_t *value);
 
+    /*!
+     * \brief Read the values of consecutive sensors.
+     *
+     * \details When the sensors are consecutive devices of a driver
+     *      implementing ::mod_sensor_driver_api::get_values, they are read in a
+     *      single pass of the driver, otherwise one after the other. The
+     *      cached values are returned when they are all fresh, and the cache
+     *      is updated with the values read.
+     *
+     * \param id Identifier of the first sensor.
+     * \param count Number of sensors, consecutive from the first one.
+     * \param[out] values Table of \p count sensor values.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_BUSY The driver of one of the sensors completes its
+     *      readings asynchronously and its reading is in progress. Its value
+     *      is cached when the reading completes.
+     * \retval ::FWK_E_DEVICE Driver error.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_values)(fwk_id_t id, unsigned int count, uint64_t *values);
+
     /*!
      * \brief Get sensor information.
      *
@@ -350,6 +473,24 @@ struct mod_sensor_api {
         fwk_id_t id,
         uint32_t trip_point_idx,
         struct mod_sensor_trip_point_params *params);
+
+    /*!
+     * \brief Get statistics over the sensor history.
+     *
+     * \param id Specific sensor device id.
+     * \param window Number of latest samples to use. 0 to use the whole
+     *      history.
+     * \param[out] stats Statistics over the samples.
+     *
+     * \retval ::FWK_SUCCESS Operation succeeded.
+     * \retval ::FWK_E_PARAM The stats parameter was NULL.
+     * \retval ::FWK_E_STATE No sample is available yet.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_statistics)(
+        fwk_id_t id,
+        unsigned int window,
+        struct mod_sensor_statistics *stats);
 };
 
 /*!
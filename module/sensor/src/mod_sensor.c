@@ -9,6 +9,7 @@
 
 #include <mod_scmi_sensor.h>
 #include <mod_sensor.h>
+#include <mod_timer.h>
 
 #include <fwk_assert.h>
 #include <fwk_event.h>
@@ -18,6 +19,7 @@
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
 #include <fwk_thread.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 #include <stddef.h>
@@ -40,62 +42,276 @@ static int get_ctx_if_valid_call(fwk_id_t id,
     return FWK_SUCCESS;
 }
 
-#ifdef BUILD_HAS_SCMI_SENSOR_EVENTS
-static bool trip_point_evaluate(
-    struct sensor_trip_point_ctx *ctx,
+static uint64_t trip_point_threshold(
+    const struct mod_sensor_trip_point_params *params)
+{
+    return ((uint64_t)params->high_value << 32) | params->low_value;
+}
+
+/*
+ * Get the number of thresholds below a value.
+ */
+static unsigned int trip_point_band(
+    const struct sensor_dev_ctx *ctx,
     uint64_t value)
 {
-    uint64_t threshold;
-    bool new_above_threshold, trigger = false;
+    unsigned int low = 0, high = ctx->threshold_count, mid;
+
+    while (low < high) {
+        mid = low + (high - low) / 2;
+
+        if (ctx->thresholds[mid].value < value)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+/*
+ * Rebuild the sorted thresholds after a trip point has been configured.
+ */
+static void trip_point_sort(struct sensor_dev_ctx *ctx)
+{
+    struct sensor_trip_point_threshold threshold;
+    unsigned int i, pos;
+
+    ctx->threshold_count = 0;
+
+    for (i = 0; i < ctx->config->trip_point.count; i++) {
+        if (ctx->trip_point_ctx[i].params.mode ==
+            MOD_SENSOR_TRIP_POINT_MODE_DISABLED)
+            continue;
+
+        threshold = (struct sensor_trip_point_threshold) {
+            .value = trip_point_threshold(&ctx->trip_point_ctx[i].params),
+            .trip_point_idx = i,
+        };
 
-    threshold = (((uint64_t)ctx->params.high_value << 32) & ~0U) |
-        (((uint64_t)ctx->params.low_value) & ~0U);
-    new_above_threshold = value > threshold;
+        for (pos = ctx->threshold_count;
+             (pos > 0) && (ctx->thresholds[pos - 1].value > threshold.value);
+             pos--)
+            ctx->thresholds[pos] = ctx->thresholds[pos - 1];
+
+        ctx->thresholds[pos] = threshold;
+        ctx->threshold_count++;
+    }
+
+    /* Only crossings from the latest reading onwards are notified */
+    ctx->band = trip_point_band(ctx, ctx->last_value);
+    ctx->notified_band = ctx->band;
+}
+
+#ifdef BUILD_HAS_SCMI_SENSOR_EVENTS
+static void trip_point_notify(
+    fwk_id_t id,
+    const struct sensor_dev_ctx *ctx,
+    unsigned int pos,
+    bool above_threshold)
+{
+    uint32_t trip_point_idx = ctx->thresholds[pos].trip_point_idx;
 
-    switch (ctx->params.mode) {
+    switch (ctx->trip_point_ctx[trip_point_idx].params.mode) {
     case MOD_SENSOR_TRIP_POINT_MODE_POSITIVE:
-        if (!ctx->above_threshold && value > threshold)
-            trigger = true;
+        if (!above_threshold)
+            return;
         break;
 
     case MOD_SENSOR_TRIP_POINT_MODE_NEGATIVE:
-        if (ctx->above_threshold && (value <= threshold))
-            trigger = true;
+        if (above_threshold)
+            return;
         break;
 
     case MOD_SENSOR_TRIP_POINT_MODE_TRANSITION:
-        if ((!ctx->above_threshold && value > threshold) ||
-            (ctx->above_threshold && value <= threshold))
-            trigger = true;
         break;
 
     default:
-        break;
+        return;
     }
-    ctx->above_threshold = new_above_threshold;
-    return trigger;
+
+    sensor_mod_ctx.sensor_trip_point_api->notify_sensor_trip_point(
+        id, above_threshold, trip_point_idx);
 }
-#endif
 
-#ifdef BUILD_HAS_SCMI_SENSOR_EVENTS
 static void trip_point_process(fwk_id_t id, uint64_t value)
 {
     struct sensor_dev_ctx *ctx;
-    unsigned int i;
+    uint64_t hysteresis;
+    unsigned int band, pos;
+    uint32_t interval_us;
+    fwk_timestamp_t now;
 
     fwk_check(!fwk_id_is_equal(id, FWK_ID_NONE));
     ctx = ctx_table + fwk_id_get_element_idx(id);
 
-    for (i = 0; i < ctx->config->trip_point.count; i++) {
-        if (trip_point_evaluate(&(ctx->trip_point_ctx[i]), value)) {
-            /* Handle trip point event*/
-            if (sensor_mod_ctx.sensor_trip_point_api != NULL)
-                sensor_mod_ctx.sensor_trip_point_api->notify_sensor_trip_point(
-                    id, ctx->trip_point_ctx->above_threshold, i);
+    if (ctx->threshold_count == 0)
+        return;
+
+    band = trip_point_band(ctx, value);
+    if (band < ctx->band) {
+        /* The value must clear the hysteresis to cross thresholds downwards */
+        hysteresis = ctx->config->trip_point.hysteresis;
+        if (hysteresis > 0) {
+            band = trip_point_band(ctx,
+                (value > (UINT64_MAX - hysteresis)) ?
+                    UINT64_MAX : value + hysteresis);
+            if (band > ctx->band)
+                band = ctx->band;
         }
     }
+    ctx->band = band;
+
+    if ((ctx->band == ctx->notified_band) ||
+        (sensor_mod_ctx.sensor_trip_point_api == NULL))
+        return;
+
+    interval_us = ctx->config->trip_point.min_notify_interval_us;
+    now = fwk_time_current();
+    if ((interval_us > 0) && (ctx->notify_timestamp != 0) &&
+        (now >= ctx->notify_timestamp) &&
+        (fwk_time_duration_us(now - ctx->notify_timestamp) < interval_us))
+        return;
+
+    for (pos = ctx->notified_band; pos < ctx->band; pos++)
+        trip_point_notify(id, ctx, pos, true);
+
+    for (pos = ctx->notified_band; pos > ctx->band; pos--)
+        trip_point_notify(id, ctx, pos - 1, false);
+
+    ctx->notified_band = ctx->band;
+    ctx->notify_timestamp = now;
+}
+#endif
+
+/*
+ * Reading cache
+ */
+static void reading_store(
+    struct sensor_dev_ctx *ctx,
+    uint64_t value,
+    int status)
+{
+    ctx->last_value = value;
+    ctx->last_status = status;
+    ctx->last_timestamp = fwk_time_current();
+}
+
+static bool reading_is_fresh(const struct sensor_dev_ctx *ctx)
+{
+    fwk_timestamp_t now;
+
+    if ((ctx->config->max_age_us == 0) || (ctx->last_status != FWK_SUCCESS))
+        return false;
+
+    /* Either no reading completed yet or there is no time source */
+    if (ctx->last_timestamp == 0)
+        return false;
+
+    now = fwk_time_current();
+    if (now < ctx->last_timestamp)
+        return false;
+
+    return fwk_time_duration_us(now - ctx->last_timestamp) <=
+        ctx->config->max_age_us;
+}
+
+/*
+ * Periodic sampling
+ */
+static void sample_record(
+    fwk_id_t id,
+    struct sensor_dev_ctx *ctx,
+    uint64_t value)
+{
+    unsigned int history_length = ctx->config->history_length;
+
+    if (history_length > 0) {
+        ctx->history[ctx->history_head] = value;
+        ctx->history_head = (ctx->history_head + 1) % history_length;
+        if (ctx->history_count < history_length)
+            ctx->history_count++;
+    }
+
+    if ((sensor_mod_ctx.sensor_trip_point_api != NULL) &&
+        (sensor_mod_ctx.sensor_trip_point_api->notify_sensor_update != NULL))
+        sensor_mod_ctx.sensor_trip_point_api->notify_sensor_update(id, value);
 }
+
+static void sample_start(fwk_id_t id, struct sensor_dev_ctx *ctx)
+{
+    int status;
+    uint64_t value;
+
+    /* The reading in progress provides the sample */
+    if (ctx->read_busy) {
+        ctx->sample_pending = true;
+        return;
+    }
+
+    status = ctx->driver_api->get_value(ctx->config->driver_id, &value);
+    if (status == FWK_SUCCESS) {
+        reading_store(ctx, value, FWK_SUCCESS);
+#ifdef BUILD_HAS_SCMI_SENSOR_EVENTS
+        trip_point_process(id, value);
 #endif
+        sample_record(id, ctx, value);
+    } else if (status == FWK_PENDING) {
+        ctx->read_busy = true;
+        ctx->sample_pending = true;
+    }
+}
+
+/*
+ * Sample all the sensors that are due. The sensors share the sampling tick so
+ * that a single wakeup serves all the sensors due at the same time.
+ */
+static void sample_due_sensors(void)
+{
+    struct sensor_dev_ctx *ctx;
+    unsigned int i;
+
+    for (i = 0; i < sensor_mod_ctx.dev_count; i++) {
+        ctx = &ctx_table[i];
+
+        if (ctx->config->sampling_period_ms == 0)
+            continue;
+
+        if (--ctx->sampling_countdown > 0)
+            continue;
+
+        ctx->sampling_countdown =
+            ctx->config->sampling_period_ms / sensor_mod_ctx.sampling_tick_ms;
+
+        sample_start(FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, i), ctx);
+    }
+}
+
+static void sampling_alarm_callback(uintptr_t param)
+{
+    int status;
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_SENSOR),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_SENSOR),
+        .id = mod_sensor_event_id_sample,
+    };
+
+    status = fwk_thread_put_event(&event);
+    fwk_check(status == FWK_SUCCESS);
+}
+
+static uint32_t sampling_gcd(uint32_t a, uint32_t b)
+{
+    uint32_t remainder;
+
+    while (b != 0) {
+        remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+
+    return a;
+}
 
 /*
  * Module API
@@ -110,39 +326,139 @@ static int get_value(fwk_id_t id, uint64_t *value)
     if (status != FWK_SUCCESS)
         return status;
 
-    /* Concurrent readings are not supported */
-    if (ctx->read_busy)
-        return FWK_E_BUSY;
+    if (reading_is_fresh(ctx)) {
+        *value = ctx->last_value;
 
-    status = ctx->driver_api->get_value(ctx->config->driver_id, value);
-    if (status == FWK_PENDING) {
-        req = (struct fwk_event) {
-            .target_id = id,
-            .id = mod_sensor_event_id_read_request,
-            .response_requested = true,
-        };
+        return FWK_SUCCESS;
+    }
 
-        status = fwk_thread_put_event(&req);
+    /*
+     * Concurrent readers do not start another reading, they wait for the
+     * one in progress.
+     */
+    if (!ctx->read_busy) {
+        status = ctx->driver_api->get_value(ctx->config->driver_id, value);
         if (status == FWK_SUCCESS) {
-            ctx->read_busy = true;
-
-             /*
-              * We return FWK_PENDING here to indicate to the caller that the
-              * result of the request is pending and will arrive later through
-              * an event.
-              */
-            return FWK_PENDING;
-        } else
-            return status;
-    } else if (status == FWK_SUCCESS) {
+            reading_store(ctx, *value, FWK_SUCCESS);
+#ifdef BUILD_HAS_SCMI_SENSOR_EVENTS
+            trip_point_process(id, *value);
+#endif
+            return FWK_SUCCESS;
+        } else if (status != FWK_PENDING)
+            return FWK_E_DEVICE;
+    }
+
+    req = (struct fwk_event) {
+        .target_id = id,
+        .id = mod_sensor_event_id_read_request,
+        .response_requested = true,
+    };
+
+    status = fwk_thread_put_event(&req);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->read_busy = true;
+
+    /*
+     * We return FWK_PENDING here to indicate to the caller that the result of
+     * the request is pending and will arrive later through an event.
+     */
+    return FWK_PENDING;
+}
+
+/*
+ * Check whether consecutive sensors are consecutive devices of a driver able to
+ * read them in a single pass.
+ */
+static bool bank_is_batched(
+    const struct sensor_dev_ctx *ctx,
+    unsigned int count)
+{
+    fwk_id_t driver_id = ctx->config->driver_id;
+    fwk_id_t id;
+    unsigned int i;
+
+    if ((ctx->driver_api->get_values == NULL) ||
+        !fwk_id_is_type(driver_id, FWK_ID_TYPE_ELEMENT))
+        return false;
+
+    for (i = 1; i < count; i++) {
+        id = ctx[i].config->driver_id;
+
+        if ((ctx[i].driver_api != ctx->driver_api) ||
+            !fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT) ||
+            (fwk_id_get_module_idx(id) != fwk_id_get_module_idx(driver_id)) ||
+            (fwk_id_get_element_idx(id) !=
+             (fwk_id_get_element_idx(driver_id) + i)))
+            return false;
+    }
+
+    return true;
+}
+
+static void bank_store(unsigned int idx, uint64_t value)
+{
+    reading_store(&ctx_table[idx], value, FWK_SUCCESS);
 #ifdef BUILD_HAS_SCMI_SENSOR_EVENTS
-        trip_point_process(id, *value);
+    trip_point_process(FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, idx), value);
 #endif
+}
+
+static int get_values(fwk_id_t id, unsigned int count, uint64_t *values)
+{
+    int status;
+    struct sensor_dev_ctx *ctx;
+    unsigned int first, i;
+
+    status = get_ctx_if_valid_call(id, values, &ctx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    first = fwk_id_get_element_idx(id);
+    if ((count == 0) || (first >= sensor_mod_ctx.dev_count) ||
+        (count > (sensor_mod_ctx.dev_count - first)))
+        return FWK_E_PARAM;
+
+    for (i = 0; (i < count) && reading_is_fresh(&ctx[i]); i++)
+        values[i] = ctx[i].last_value;
+
+    if (i == count)
+        return FWK_SUCCESS;
+
+    if (bank_is_batched(ctx, count)) {
+        status = ctx->driver_api->get_values(
+            ctx->config->driver_id, count, values);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        for (i = 0; i < count; i++)
+            bank_store(first + i, values[i]);
+
         return FWK_SUCCESS;
     }
 
-    else
-        return FWK_E_DEVICE;
+    for (; i < count; i++) {
+        if (reading_is_fresh(&ctx[i])) {
+            values[i] = ctx[i].last_value;
+            continue;
+        }
+
+        if (ctx[i].read_busy)
+            return FWK_E_BUSY;
+
+        status = ctx[i].driver_api->get_value(
+            ctx[i].config->driver_id, &values[i]);
+        if (status == FWK_PENDING) {
+            ctx[i].read_busy = true;
+            return FWK_E_BUSY;
+        } else if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        bank_store(first + i, values[i]);
+    }
+
+    return FWK_SUCCESS;
 }
 
 static int get_info(fwk_id_t id, struct mod_sensor_scmi_info *info)
@@ -158,6 +474,7 @@ static int get_info(fwk_id_t id, struct mod_sensor_scmi_info *info)
     if (!fwk_expect(status == FWK_SUCCESS))
         return FWK_E_DEVICE;
     info->trip_point = ctx->config->trip_point;
+    info->sampling_period_ms = ctx->config->sampling_period_ms;
 
     return FWK_SUCCESS;
 }
@@ -198,17 +515,68 @@ static int sensor_set_trip_point(
 
     ctx->trip_point_ctx[trip_point_idx].params = *params;
 
-    /* Clear the trip point flag */
-    ctx->trip_point_ctx[trip_point_idx].above_threshold = false;
+    trip_point_sort(ctx);
+    return FWK_SUCCESS;
+}
+
+static int sensor_get_statistics(
+    fwk_id_t id,
+    unsigned int window,
+    struct mod_sensor_statistics *stats)
+{
+    int status;
+    struct sensor_dev_ctx *ctx;
+    unsigned int history_length, count, idx, i;
+    uint64_t value, quotient = 0, remainder = 0;
+
+    status = get_ctx_if_valid_call(id, stats, &ctx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (ctx->history_count == 0)
+        return FWK_E_STATE;
+
+    history_length = ctx->config->history_length;
+    count = ((window == 0) || (window > ctx->history_count)) ?
+        ctx->history_count : window;
+    idx = (ctx->history_head + history_length - count) % history_length;
+
+    stats->min = UINT64_MAX;
+    stats->max = 0;
+
+    for (i = 0; i < count; i++) {
+        value = ctx->history[idx];
+        idx = (idx + 1) % history_length;
+
+        if (value < stats->min)
+            stats->min = value;
+        if (value > stats->max)
+            stats->max = value;
+
+        /* Average without overflowing the sum of the values */
+        quotient += value / count;
+        remainder += value % count;
+        if (remainder >= count) {
+            quotient++;
+            remainder -= count;
+        }
+    }
+
+    stats->avg = quotient;
+    stats->sample_count = count;
+
     return FWK_SUCCESS;
 }
 
 static struct mod_sensor_api sensor_api = { .get_value = get_value,
+                                            .get_values = get_values,
                                             .get_info = get_info,
                                             .get_trip_point =
                                                 sensor_get_trip_point,
                                             .set_trip_point =
-                                                sensor_set_trip_point };
+                                                sensor_set_trip_point,
+                                            .get_statistics =
+                                                sensor_get_statistics };
 
 /*
  * Driver response API.
@@ -264,6 +632,7 @@ static int sensor_init(
     config = (struct mod_sensor_config *)data;
 
     sensor_mod_ctx.config = config;
+    sensor_mod_ctx.dev_count = element_count;
     return FWK_SUCCESS;
 }
 
@@ -284,8 +653,22 @@ static int sensor_dev_init(fwk_id_t element_id,
     if (config->trip_point.count > 0) {
         ctx->trip_point_ctx = fwk_mm_calloc(
             config->trip_point.count, sizeof(struct sensor_trip_point_ctx));
+        ctx->thresholds = fwk_mm_calloc(
+            config->trip_point.count,
+            sizeof(struct sensor_trip_point_threshold));
     } else
         ctx->trip_point_ctx = NULL;
+
+    if (config->sampling_period_ms > 0) {
+        sensor_mod_ctx.sampling_tick_ms = sampling_gcd(
+            sensor_mod_ctx.sampling_tick_ms, config->sampling_period_ms);
+    }
+
+    if (config->history_length > 0) {
+        ctx->history =
+            fwk_mm_calloc(config->history_length, sizeof(ctx->history[0]));
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -302,6 +685,18 @@ static int sensor_bind(fwk_id_t id, unsigned int round)
         return FWK_SUCCESS;
     }
     if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        if (sensor_mod_ctx.sampling_tick_ms > 0) {
+            if (sensor_mod_ctx.config == NULL)
+                return FWK_E_DATA;
+
+            status = fwk_module_bind(
+                sensor_mod_ctx.config->sampling_alarm_id,
+                MOD_TIMER_API_ID_ALARM,
+                &sensor_mod_ctx.alarm_api);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+
         if (sensor_mod_ctx.config == NULL)
             return FWK_SUCCESS;
 
@@ -331,6 +726,27 @@ static int sensor_bind(fwk_id_t id, unsigned int round)
     return FWK_SUCCESS;
 }
 
+static int sensor_start(fwk_id_t id)
+{
+    unsigned int i;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE) ||
+        (sensor_mod_ctx.sampling_tick_ms == 0))
+        return FWK_SUCCESS;
+
+    for (i = 0; i < sensor_mod_ctx.dev_count; i++) {
+        /* Take the first sample of every sensor on the first tick */
+        ctx_table[i].sampling_countdown = 1;
+    }
+
+    return sensor_mod_ctx.alarm_api->start(
+        sensor_mod_ctx.config->sampling_alarm_id,
+        sensor_mod_ctx.sampling_tick_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        sampling_alarm_callback,
+        (uintptr_t)0);
+}
+
 static int sensor_process_bind_request(fwk_id_t source_id,
                                        fwk_id_t target_id,
                                        fwk_id_t api_id,
@@ -372,12 +788,21 @@ static int sensor_process_event(const struct fwk_event *event,
                                 struct fwk_event *resp_event)
 {
     int status;
+    bool is_empty;
     struct sensor_dev_ctx *ctx;
     struct fwk_event read_req_event;
     struct mod_sensor_event_params *event_params =
         (struct mod_sensor_event_params *)(event->params);
     struct mod_sensor_event_params *resp_params =
         (struct mod_sensor_event_params *)(read_req_event.params);
+    struct mod_sensor_event_params *req_resp_params =
+        (struct mod_sensor_event_params *)(resp_event->params);
+
+    if (fwk_id_is_equal(event->id, mod_sensor_event_id_sample)) {
+        sample_due_sensors();
+
+        return FWK_SUCCESS;
+    }
 
     if (!fwk_module_is_valid_element_id(event->target_id))
         return FWK_E_PARAM;
@@ -387,22 +812,46 @@ static int sensor_process_event(const struct fwk_event *event,
     switch (fwk_id_get_event_idx(event->id)) {
 
     case SENSOR_EVENT_IDX_READ_REQUEST:
-        ctx->cookie = event->cookie;
+        if (!ctx->read_busy) {
+            /* The reading completed before the request was processed */
+            req_resp_params->status = ctx->last_status;
+            req_resp_params->value = ctx->last_value;
+
+            return FWK_SUCCESS;
+        }
+
         resp_event->is_delayed_response = true;
 
         return FWK_SUCCESS;
 
     case SENSOR_EVENT_IDX_READ_COMPLETE:
         ctx->read_busy = false;
+        reading_store(ctx, event_params->value, event_params->status);
 
-        status = fwk_thread_get_delayed_response(event->target_id,
-                                                 ctx->cookie,
-                                                 &read_req_event);
-        if (status != FWK_SUCCESS)
-            return status;
+        if (ctx->sample_pending) {
+            ctx->sample_pending = false;
+            if (event_params->status == FWK_SUCCESS)
+                sample_record(event->target_id, ctx, event_params->value);
+        }
+
+        /* All the readers waiting for the reading share its result */
+        for (;;) {
+            status = fwk_thread_is_delayed_response_list_empty(
+                event->target_id, &is_empty);
+            if ((status != FWK_SUCCESS) || is_empty)
+                return status;
 
-        *resp_params = *event_params;
-        return fwk_thread_put_event(&read_req_event);
+            status = fwk_thread_get_first_delayed_response(
+                event->target_id, &read_req_event);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            *resp_params = *event_params;
+
+            status = fwk_thread_put_event(&read_req_event);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
 
     default:
         return FWK_E_PARAM;
@@ -417,6 +866,8 @@ const struct fwk_module module_sensor = {
     .init = sensor_init,
     .element_init = sensor_dev_init,
     .bind = sensor_bind,
+    .start = sensor_start,
     .process_bind_request = sensor_process_bind_request,
+    .bind_shared_api_mask = (1U << MOD_SENSOR_API_IDX_SENSOR),
     .process_event = sensor_process_event,
 };
@@ -11,6 +11,7 @@
 #include <mod_sensor.h>
 
 #include <fwk_id.h>
+#include <fwk_time.h>
 
 #include <stdint.h>
 
@@ -23,7 +24,11 @@
  */
 struct sensor_trip_point_ctx {
     struct mod_sensor_trip_point_params params;
-    bool above_threshold;
+};
+
+struct sensor_trip_point_threshold {
+    uint64_t value;
+    uint32_t trip_point_idx;
 };
 
 /*
@@ -35,13 +40,47 @@ struct sensor_dev_ctx {
     struct mod_sensor_driver_api *driver_api;
 
     struct sensor_trip_point_ctx *trip_point_ctx;
-    uint32_t cookie;
+
+    /*
+     * Thresholds of the enabled trip points in ascending order. The band is
+     * the number of thresholds the sensor value is above.
+     */
+    struct sensor_trip_point_threshold *thresholds;
+    unsigned int threshold_count;
+    unsigned int band;
+
+    /* Band last reported to the agents and when it was reported */
+    unsigned int notified_band;
+    fwk_timestamp_t notify_timestamp;
+
+    /* Last reading and the time at which it completed */
+    uint64_t last_value;
+    int last_status;
+    fwk_timestamp_t last_timestamp;
+
     bool read_busy;
+
+    /* Sampling ticks left before the next sample */
+    unsigned int sampling_countdown;
+
+    /* The reading in progress provides the next sample */
+    bool sample_pending;
+
+    /* Ring of the latest samples */
+    uint64_t *history;
+    unsigned int history_head;
+    unsigned int history_count;
 };
 
 struct sensor_mod_ctx {
     struct mod_sensor_config *config;
     struct mod_sensor_trip_point_api *sensor_trip_point_api;
+
+    unsigned int dev_count;
+
+    /* Period of the sampling alarm, zero when no sensor is sampled */
+    uint32_t sampling_tick_ms;
+    const struct mod_timer_alarm_api *alarm_api;
 };
 
 /*
@@ -50,6 +89,7 @@ struct sensor_mod_ctx {
 enum mod_sensor_event_idx {
     SENSOR_EVENT_IDX_READ_REQUEST = MOD_SENSOR_EVENT_IDX_READ_REQUEST,
     SENSOR_EVENT_IDX_READ_COMPLETE,
+    SENSOR_EVENT_IDX_SAMPLE,
     SENSOR_EVENT_IDX_COUNT
 };
 
@@ -60,6 +100,10 @@ static const fwk_id_t mod_sensor_event_id_read_complete =
     FWK_ID_EVENT_INIT(FWK_MODULE_IDX_SENSOR,
                       SENSOR_EVENT_IDX_READ_COMPLETE);
 
+static const fwk_id_t mod_sensor_event_id_sample =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_SENSOR,
+                      SENSOR_EVENT_IDX_SAMPLE);
+
 /*!
  * \endcond
  */
@@ -10,6 +10,7 @@
 
 #include <fwk_id.h>
 #include <fwk_module_idx.h>
+#include <fwk_thread.h>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -32,6 +33,19 @@
 /*! The mailbox for this channel requires initialization */
 #define MOD_SMT_POLICY_INIT_MAILBOX ((uint32_t)(1 << 1))
 
+/*!
+ * \brief The payload of this channel is accessed in place.
+ *
+ * \details Requests are read from, and responses are written to, the shared
+ *      mailbox rather than a private copy. The message header and length are
+ *      still captured and validated when the message is received, but the
+ *      payload may be modified by the agent while the message is processed.
+ *      Writing the response overwrites the request, so the services bound to
+ *      the channel must consume the request parameters before they write any
+ *      part of the response.
+ */
+#define MOD_SMT_POLICY_ZERO_COPY    ((uint32_t)(1 << 2))
+
 /*!
  * \}
  */
@@ -74,7 +88,13 @@ struct mod_smt_channel_config {
     /*! Identifier of the driver API to bind to */
     fwk_id_t driver_api_id;
 
-    /*! Identifier of the power domain that this channel depends on */
+    /*!
+     * \brief Identifier of the power domain that this channel depends on.
+     *
+     * \details May be ::FWK_ID_NONE for a channel that does not depend on a
+     *      power domain, in which case the channel is ready once the module
+     *      has started.
+     */
     fwk_id_t pd_source_id;
 
     /*! Identifier of the API to bind to signal message/error for Non SCMI
@@ -82,8 +102,83 @@ struct mod_smt_channel_config {
      * SCMI messages
      */
     fwk_id_t signal_api_id;
+
+    /*!
+     * \brief Duration in microseconds the mailbox of a slave channel is polled
+     *      for after each response, or 0 to only rely on the doorbell.
+     *
+     * \details While the window is open, the idle driver of the module, see
+     *      ::mod_smt_idle_driver(), checks the mailbox instead of letting the
+     *      processor sleep, so a message sent shortly after the previous
+     *      response is handled without waiting for the doorbell interrupt.
+     *      Polling requires a framework time driver.
+     */
+    uint32_t poll_window_us;
+};
+
+/*!
+ * \brief Polling statistics of a channel.
+ */
+struct mod_smt_poll_stats {
+    /*! Number of messages picked up by polling the mailbox */
+    uint64_t poll_hit_count;
+
+    /*! Number of messages picked up through the doorbell interrupt */
+    uint64_t doorbell_count;
+
+    /*! Number of polling windows that closed without a message */
+    uint64_t window_miss_count;
+};
+
+/*!
+ * \brief Polling API.
+ */
+struct mod_smt_poll_api {
+    /*!
+     * \brief Get the polling statistics of a channel.
+     *
+     * \param channel_id Channel identifier.
+     * \param[out] stats Polling statistics of the channel.
+     *
+     * \retval ::FWK_SUCCESS The statistics were returned.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     */
+    int (*get_stats)(fwk_id_t channel_id, struct mod_smt_poll_stats *stats);
+};
+
+/*!
+ * \brief Configuration of the idle driver of the module.
+ */
+struct mod_smt_idle_config {
+    /*!
+     * \brief Idle driver used while no mailbox is polled. Its idle function
+     *      may be NULL to keep polling for new events.
+     */
+    struct fwk_thread_idle_driver driver;
+
+    /*! Context of the idle driver */
+    const void *driver_ctx;
 };
 
+/*!
+ * \brief Get a framework idle driver polling the mailboxes of the channels
+ *      in their polling window.
+ *
+ * \details While a window is open, each call checks the mailboxes once and
+ *      returns without sleeping, so pending interrupts are still taken
+ *      between the checks. Once all the windows are closed, the driver of
+ *      \p config is used. The function is intended to be called by the
+ *      firmware implementation of ::fmw_thread_idle_driver().
+ *
+ * \param[out] ctx Context to give to the framework.
+ * \param config Idle driver configuration.
+ *
+ * \return Framework idle driver.
+ */
+struct fwk_thread_idle_driver mod_smt_idle_driver(
+    const void **ctx,
+    const struct mod_smt_idle_config *config);
+
 /*!
  * \brief Driver API
  */
@@ -117,6 +212,21 @@ struct mod_smt_driver_input_api {
      *      errors.
      */
     int (*signal_message)(fwk_id_t channel_id);
+
+    /*!
+     * \brief Signal incoming messages in several mailboxes
+     *
+     * \details Drivers use this function to hand all the doorbells found in a
+     *      single interrupt over at once.
+     *
+     * \param channel_ids Table of channel identifiers indexed by bit position
+     * \param mask Mask of the channels with an incoming message
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \return One of the standard error codes for implementation-defined
+     *      errors, for the first channel whose message could not be handled.
+     */
+    int (*signal_messages)(const fwk_id_t *channel_ids, uint32_t mask);
 };
 
 /*!
@@ -274,9 +384,14 @@ enum mod_smt_api_idx {
     MOD_SMT_API_IDX_DRIVER_INPUT,
     MOD_SMT_API_IDX_SCMI_TRANSPORT,
     MOD_SMT_API_IDX_TO_TRANSPORT,
+    MOD_SMT_API_IDX_POLL,
     MOD_SMT_API_IDX_COUNT,
 };
 
+/*! Identifier of the polling API */
+static const fwk_id_t mod_smt_api_id_poll =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_SMT, MOD_SMT_API_IDX_POLL);
+
 /*!
  * \brief SMT notification indices.
  */
@@ -12,6 +12,8 @@
 #include <mod_smt.h>
 
 #include <fwk_assert.h>
+#include <fwk_attributes.h>
+#include <fwk_cache.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
@@ -21,6 +23,7 @@
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
 #include <fwk_status.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 #include <string.h>
@@ -32,9 +35,15 @@ struct smt_channel_ctx {
     /* Channel configuration data */
     struct mod_smt_channel_config *config;
 
-    /* Channel read and write cache memory areas */
+    /*
+     * Channel read and write cache memory areas. Only the mailbox header is
+     * cached for zero-copy channels.
+     */
     struct mod_smt_memory *in, *out;
 
+    /* Flag indicating the payload is accessed in the shared mailbox */
+    bool zero_copy;
+
     /* Message processing in progrees flag */
     volatile bool locked;
 
@@ -61,6 +70,15 @@ struct smt_channel_ctx {
 
     /* Flag indicating the mailbox is ready */
     bool smt_mailbox_ready;
+
+    /* End of the polling window, 0 when the window is closed */
+    fwk_timestamp_t poll_deadline;
+
+    /* Number of doorbells still to come for messages picked up by polling */
+    volatile unsigned int polled_doorbell_count;
+
+    /* Polling statistics */
+    struct mod_smt_poll_stats poll_stats;
 };
 
 struct smt_ctx {
@@ -69,10 +87,19 @@ struct smt_ctx {
 
     /* Number of channels */
     unsigned int channel_count;
+
+    /* Number of channels with an open polling window */
+    unsigned int poll_window_count;
 };
 
 static struct smt_ctx smt_ctx;
 
+static inline struct mod_smt_memory *smt_get_mailbox(
+    const struct smt_channel_ctx *channel_ctx)
+{
+    return (struct mod_smt_memory *)channel_ctx->config->mailbox_address;
+}
+
 /*
  * SCMI Transport API
  */
@@ -147,7 +174,10 @@ static int smt_get_payload(fwk_id_t channel_id,
     if (!channel_ctx->locked)
         return FWK_E_ACCESS;
 
-    *payload = channel_ctx->in->payload;
+    if (channel_ctx->zero_copy)
+        *payload = smt_get_mailbox(channel_ctx)->payload;
+    else
+        *payload = channel_ctx->in->payload;
 
     if (size != NULL) {
         *size = channel_ctx->in->length -
@@ -163,6 +193,7 @@ static int smt_write_payload(fwk_id_t channel_id,
                              size_t size)
 {
     struct smt_channel_ctx *channel_ctx;
+    uint8_t *destination;
 
     channel_ctx =
         &smt_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
@@ -178,11 +209,35 @@ static int smt_write_payload(fwk_id_t channel_id,
     if (!channel_ctx->locked)
         return FWK_E_ACCESS;
 
-    memcpy(((uint8_t*)channel_ctx->out->payload) + offset, payload, size);
+    if (channel_ctx->zero_copy)
+        destination = (uint8_t *)smt_get_mailbox(channel_ctx)->payload;
+    else
+        destination = (uint8_t *)channel_ctx->out->payload;
+
+    memcpy(destination + offset, payload, size);
 
     return FWK_SUCCESS;
 }
 
+static void smt_open_poll_window(struct smt_channel_ctx *channel_ctx)
+{
+    fwk_timestamp_t now;
+
+    if (channel_ctx->config->poll_window_us == 0)
+        return;
+
+    /* There is no time reference to close the window */
+    now = fwk_time_current();
+    if (now == 0)
+        return;
+
+    if (channel_ctx->poll_deadline == 0)
+        smt_ctx.poll_window_count++;
+
+    channel_ctx->poll_deadline =
+        now + FWK_US(channel_ctx->config->poll_window_us);
+}
+
 static int smt_respond(fwk_id_t channel_id, const void *payload, size_t size)
 {
     struct smt_channel_ctx *channel_ctx;
@@ -195,10 +250,19 @@ static int smt_respond(fwk_id_t channel_id, const void *payload, size_t size)
     /* Copy the header from the write buffer */
     *memory = *channel_ctx->out;
 
-    /* Copy the payload from either the write buffer or the payload parameter */
-    memcpy(memory->payload,
-           (payload == NULL ? channel_ctx->out->payload : payload),
-           size);
+    /*
+     * Copy the payload from either the write buffer or the payload parameter.
+     * The response of a zero-copy channel is already in the mailbox unless it
+     * is given as a parameter.
+     */
+    if (payload == NULL) {
+        if (!channel_ctx->zero_copy)
+            memcpy(memory->payload, channel_ctx->out->payload, size);
+    } else if (payload != memory->payload)
+        memmove(memory->payload, payload, size);
+
+    /* The payload must reach the memory before the mailbox is freed */
+    fwk_cache_clean(memory->payload, size);
 
     /*
      * NOTE: Disable interrupts for a brief period to ensure interrupts are not
@@ -216,9 +280,14 @@ static int smt_respond(fwk_id_t channel_id, const void *payload, size_t size)
 
     fwk_interrupt_global_enable();
 
+    fwk_cache_clean(memory, sizeof(*memory));
+
     if (memory->flags & MOD_SMT_MAILBOX_FLAGS_IENABLED_MASK)
         channel_ctx->driver_api->raise_interrupt(channel_ctx->driver_id);
 
+    /* The agent is likely to send its next message shortly */
+    smt_open_poll_window(channel_ctx);
+
     return FWK_SUCCESS;
 }
 
@@ -237,6 +306,8 @@ static int smt_transmit(fwk_id_t channel_id, uint32_t message_header,
     memory = ((struct mod_smt_memory *)
         channel_ctx->config->mailbox_address);
 
+    fwk_cache_invalidate(memory, sizeof(*memory));
+
     /*
      * If the agent has not yet read the previous message we
      * abandon this transmission. We don't want to poll on the BUSY/FREE
@@ -256,9 +327,11 @@ static int smt_transmit(fwk_id_t channel_id, uint32_t message_header,
 
     /* Copy the payload */
     memcpy(memory->payload, payload, size);
+    fwk_cache_clean(memory->payload, size);
 
     memory->length = sizeof(memory->message_header) + size;
     memory->status &= ~MOD_SMT_MAILBOX_STATUS_FREE_MASK;
+    fwk_cache_clean(memory, sizeof(*memory));
 
     /* Notify the agent */
     channel_ctx->driver_api->raise_interrupt(channel_ctx->driver_id);
@@ -291,7 +364,7 @@ static const struct mod_smt_to_transport_api smt_mod_smt_to_transport_api = {
 /*
  * Driver handler API
  */
-static int smt_slave_handler(struct smt_channel_ctx *channel_ctx)
+static FWK_HOT int smt_slave_handler(struct smt_channel_ctx *channel_ctx)
 {
     struct mod_smt_memory *memory, *in, *out;
     size_t payload_size;
@@ -305,6 +378,9 @@ static int smt_slave_handler(struct smt_channel_ctx *channel_ctx)
     in = channel_ctx->in;
     out = channel_ctx->out;
 
+    /* Read the message as written by the agent */
+    fwk_cache_invalidate(memory, channel_ctx->config->mailbox_size);
+
     /* Check we have ownership of the mailbox */
     if (memory->status & MOD_SMT_MAILBOX_STATUS_FREE_MASK) {
         FWK_LOG_ERR(
@@ -348,9 +424,14 @@ static int smt_slave_handler(struct smt_channel_ctx *channel_ctx)
         return status;
     }
 
-    /* Copy payload from shared memory to read buffer */
-    payload_size = in->length - sizeof(in->message_header);
-    memcpy(in->payload, memory->payload, payload_size);
+    /*
+     * Copy payload from shared memory to read buffer. Zero-copy channels read
+     * it in place, bounded by the length captured above.
+     */
+    if (!channel_ctx->zero_copy) {
+        payload_size = in->length - sizeof(in->message_header);
+        memcpy(in->payload, memory->payload, payload_size);
+    }
 
     /* Let subscribed service handle the message */
     if (channel_ctx->is_scmi_channel)
@@ -366,6 +447,36 @@ static int smt_slave_handler(struct smt_channel_ctx *channel_ctx)
     return FWK_SUCCESS;
 }
 
+static bool smt_is_mailbox_free(const struct smt_channel_ctx *channel_ctx)
+{
+    struct mod_smt_memory *memory = smt_get_mailbox(channel_ctx);
+
+    fwk_cache_invalidate(&memory->status, sizeof(memory->status));
+
+    return (memory->status & MOD_SMT_MAILBOX_STATUS_FREE_MASK) != 0;
+}
+
+static int smt_slave_doorbell(struct smt_channel_ctx *channel_ctx)
+{
+    int status;
+
+    /*
+     * The doorbell of a message already picked up by polling finds the message
+     * being processed, or already answered.
+     */
+    if ((channel_ctx->polled_doorbell_count > 0) &&
+        (channel_ctx->locked || smt_is_mailbox_free(channel_ctx))) {
+        channel_ctx->polled_doorbell_count--;
+        return FWK_SUCCESS;
+    }
+
+    status = smt_slave_handler(channel_ctx);
+    if ((status == FWK_SUCCESS) && (channel_ctx->config->poll_window_us != 0))
+        channel_ctx->poll_stats.doorbell_count++;
+
+    return status;
+}
+
 static int smt_signal_message(fwk_id_t channel_id)
 {
     struct smt_channel_ctx *channel_ctx;
@@ -386,7 +497,7 @@ static int smt_signal_message(fwk_id_t channel_id)
         fwk_unexpected();
         break;
     case MOD_SMT_CHANNEL_TYPE_SLAVE:
-        return smt_slave_handler(channel_ctx);
+        return smt_slave_doorbell(channel_ctx);
         break;
     default:
         /* Invalid config */
@@ -397,8 +508,130 @@ static int smt_signal_message(fwk_id_t channel_id)
     return FWK_SUCCESS;
 }
 
+static int smt_signal_messages(const fwk_id_t *channel_ids, uint32_t mask)
+{
+    int status = FWK_SUCCESS;
+    int channel_status;
+    unsigned int idx;
+
+    while (mask != 0) {
+        idx = __builtin_ctz(mask);
+        mask &= mask - 1;
+
+        channel_status = smt_signal_message(channel_ids[idx]);
+        if ((channel_status != FWK_SUCCESS) && (status == FWK_SUCCESS))
+            status = channel_status;
+    }
+
+    return status;
+}
+
 static const struct mod_smt_driver_input_api driver_input_api = {
     .signal_message = smt_signal_message,
+    .signal_messages = smt_signal_messages,
+};
+
+/*
+ * Polling
+ */
+
+static void smt_poll_channel(struct smt_channel_ctx *channel_ctx)
+{
+    /*
+     * The doorbell interrupt of the message may be taken at any time, so the
+     * message is picked up and accounted with interrupts disabled to ensure
+     * it is only dispatched once, and its doorbell is then recognized.
+     */
+    fwk_interrupt_global_disable();
+
+    if (!channel_ctx->locked && channel_ctx->smt_mailbox_ready &&
+        !smt_is_mailbox_free(channel_ctx) &&
+        (smt_slave_handler(channel_ctx) == FWK_SUCCESS)) {
+        channel_ctx->poll_stats.poll_hit_count++;
+        channel_ctx->polled_doorbell_count++;
+    }
+
+    fwk_interrupt_global_enable();
+}
+
+/*
+ * Check the mailboxes of the channels in their polling window once, closing
+ * the windows that have elapsed. Returns whether a window is still open.
+ */
+static bool smt_poll_channels(void)
+{
+    struct smt_channel_ctx *channel_ctx;
+    fwk_timestamp_t now;
+    unsigned int idx;
+
+    if (smt_ctx.poll_window_count == 0)
+        return false;
+
+    now = fwk_time_current();
+
+    for (idx = 0; idx < smt_ctx.channel_count; idx++) {
+        channel_ctx = &smt_ctx.channel_ctx_table[idx];
+        if (channel_ctx->poll_deadline == 0)
+            continue;
+
+        if (now >= channel_ctx->poll_deadline) {
+            channel_ctx->poll_deadline = 0;
+            channel_ctx->poll_stats.window_miss_count++;
+            smt_ctx.poll_window_count--;
+            continue;
+        }
+
+        smt_poll_channel(channel_ctx);
+
+        /* The window closes once the message is picked up */
+        if (channel_ctx->locked) {
+            channel_ctx->poll_deadline = 0;
+            smt_ctx.poll_window_count--;
+        }
+    }
+
+    return smt_ctx.poll_window_count > 0;
+}
+
+static void smt_idle(const void *ctx)
+{
+    const struct mod_smt_idle_config *config = ctx;
+
+    if (smt_poll_channels())
+        return;
+
+    if (config->driver.idle != NULL)
+        config->driver.idle(config->driver_ctx);
+}
+
+struct fwk_thread_idle_driver mod_smt_idle_driver(
+    const void **ctx,
+    const struct mod_smt_idle_config *config)
+{
+    fwk_assert(config != NULL);
+
+    *ctx = config;
+
+    return (struct fwk_thread_idle_driver){
+        .idle = smt_idle,
+    };
+}
+
+static int smt_get_poll_stats(
+    fwk_id_t channel_id,
+    struct mod_smt_poll_stats *stats)
+{
+    if ((stats == NULL) || !fwk_module_is_valid_element_id(channel_id))
+        return FWK_E_PARAM;
+
+    *stats = smt_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)]
+                 .poll_stats;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_smt_poll_api poll_api = {
+    .get_stats = smt_get_poll_stats,
 };
 
 /*
@@ -432,12 +665,25 @@ static int smt_channel_init(fwk_id_t channel_id, unsigned int unused,
     }
 
     channel_ctx->id = channel_id;
-    channel_ctx->in = fwk_mm_alloc(1, channel_ctx->config->mailbox_size);
-    channel_ctx->out = fwk_mm_alloc(1, channel_ctx->config->mailbox_size);
+    channel_ctx->zero_copy =
+        (channel_ctx->config->policies & MOD_SMT_POLICY_ZERO_COPY) != 0;
+
+    if (channel_ctx->zero_copy) {
+        channel_ctx->in = fwk_mm_alloc(1, sizeof(struct mod_smt_memory));
+        channel_ctx->out = fwk_mm_alloc(1, sizeof(struct mod_smt_memory));
+    } else {
+        channel_ctx->in = fwk_mm_alloc(1, channel_ctx->config->mailbox_size);
+        channel_ctx->out = fwk_mm_alloc(1, channel_ctx->config->mailbox_size);
+    }
 
     channel_ctx->max_payload_size = channel_ctx->config->mailbox_size -
         sizeof(struct mod_smt_memory);
 
+    /* Only the messages received by the platform are polled for */
+    if ((channel_ctx->config->poll_window_us != 0) &&
+        (channel_ctx->config->type != MOD_SMT_CHANNEL_TYPE_SLAVE))
+        return FWK_E_DATA;
+
     return FWK_SUCCESS;
 }
 
@@ -538,6 +784,11 @@ static int smt_process_bind_request(fwk_id_t source_id,
         channel_ctx->service_id = source_id;
         break;
 
+    case MOD_SMT_API_IDX_POLL:
+        /* Polling API */
+        *api = &poll_api;
+        break;
+
     default:
         /* Invalid API */
         fwk_unexpected();
@@ -547,6 +798,34 @@ static int smt_process_bind_request(fwk_id_t source_id,
     return FWK_SUCCESS;
 }
 
+static int smt_init_mailbox(struct smt_channel_ctx *channel_ctx)
+{
+    unsigned int notifications_sent;
+
+    if (!(channel_ctx->config->policies & MOD_SMT_POLICY_INIT_MAILBOX))
+        return FWK_SUCCESS;
+
+    /* Initialize mailbox */
+    *((struct mod_smt_memory *)channel_ctx->config->mailbox_address) =
+        (struct mod_smt_memory) {
+        .status = (1 << MOD_SMT_MAILBOX_STATUS_FREE_POS)
+    };
+    fwk_cache_clean(
+        (void *)channel_ctx->config->mailbox_address,
+        sizeof(struct mod_smt_memory));
+
+    /* Notify that this mailbox is initialized */
+    struct fwk_event smt_channels_initialized_notification = {
+        .id = mod_smt_notification_id_initialized,
+        .source_id = channel_ctx->id
+    };
+
+    channel_ctx->smt_mailbox_ready = true;
+
+    return fwk_notification_notify(&smt_channels_initialized_notification,
+        &notifications_sent);
+}
+
 static int smt_start(fwk_id_t id)
 {
     struct smt_channel_ctx *ctx;
@@ -556,21 +835,28 @@ static int smt_start(fwk_id_t id)
 
     ctx = &smt_ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
 
+    /* A channel without a power domain is ready straight away */
+    if (fwk_id_is_type(ctx->config->pd_source_id, FWK_ID_TYPE_NONE))
+        return smt_init_mailbox(ctx);
+
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
     /* Register for power domain state transition notifications */
     return fwk_notification_subscribe(
         mod_pd_notification_id_power_state_transition,
         ctx->config->pd_source_id,
         id);
+#else
+    return FWK_E_DATA;
+#endif
 }
 
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
 static int smt_process_notification(
     const struct fwk_event *event,
     struct fwk_event *resp_event)
 {
     struct mod_pd_power_state_transition_notification_params *params;
     struct smt_channel_ctx *channel_ctx;
-    unsigned int notifications_sent;
-    int status;
 
     assert(fwk_id_is_equal(event->id,
         mod_pd_notification_id_power_state_transition));
@@ -589,29 +875,9 @@ static int smt_process_notification(
         return FWK_SUCCESS;
     }
 
-    if (channel_ctx->config->policies & MOD_SMT_POLICY_INIT_MAILBOX) {
-        /* Initialize mailbox */
-        *((struct mod_smt_memory *)channel_ctx->config->mailbox_address) =
-            (struct mod_smt_memory) {
-            .status = (1 << MOD_SMT_MAILBOX_STATUS_FREE_POS)
-        };
-
-        /* Notify that this mailbox is initialized */
-        struct fwk_event smt_channels_initialized_notification = {
-            .id = mod_smt_notification_id_initialized,
-            .source_id = FWK_ID_NONE
-        };
-
-        channel_ctx->smt_mailbox_ready = true;
-
-        status = fwk_notification_notify(&smt_channels_initialized_notification,
-            &notifications_sent);
-        if (status != FWK_SUCCESS)
-            return status;
-    }
-
-    return FWK_SUCCESS;
+    return smt_init_mailbox(channel_ctx);
 }
+#endif
 
 const struct fwk_module module_smt = {
     .name = "smt",
@@ -623,5 +889,7 @@ const struct fwk_module module_smt = {
     .bind = smt_bind,
     .start = smt_start,
     .process_bind_request = smt_process_bind_request,
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
     .process_notification = smt_process_notification,
+#endif
 };
@@ -0,0 +1,65 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef INTERNAL_SMT_RING_H
+#define INTERNAL_SMT_RING_H
+
+#include <stdint.h>
+
+/*
+ * Shared memory layout of a ring channel.
+ *
+ * The mailbox starts with a header followed by slot_count slots of slot_size
+ * bytes each. The agent writes a request in the slot at index
+ * (producer % slot_count), sets the slot status to busy and increments the
+ * producer index. The platform processes the requests in order, writes each
+ * response into the slot of its request, sets the slot status to free and
+ * increments the consumer index.
+ *
+ * Both indexes are free-running: the number of outstanding requests is
+ * (producer - consumer), which never exceeds slot_count.
+ */
+struct mod_smt_ring_memory {
+    /* Number of requests posted by the agent */
+    uint32_t producer;
+
+    /* Number of requests completed by the platform */
+    uint32_t consumer;
+
+    /* Number of slots in the ring, written by the platform */
+    uint32_t slot_count;
+
+    /* Size of each slot in bytes, written by the platform */
+    uint32_t slot_size;
+
+    uint32_t flags;
+    uint32_t reserved[3];
+};
+
+struct mod_smt_ring_slot {
+    uint32_t status;
+    uint32_t length; /* message_header + payload */
+    uint32_t message_header;
+    uint32_t payload[];
+};
+
+#define MOD_SMT_RING_SLOT_STATUS_FREE_POS 0
+#define MOD_SMT_RING_SLOT_STATUS_FREE_MASK \
+    (UINT32_C(0x1) << MOD_SMT_RING_SLOT_STATUS_FREE_POS)
+
+#define MOD_SMT_RING_SLOT_STATUS_ERROR_POS 1
+#define MOD_SMT_RING_SLOT_STATUS_ERROR_MASK \
+    (UINT32_C(0x1) << MOD_SMT_RING_SLOT_STATUS_ERROR_POS)
+
+#define MOD_SMT_RING_FLAGS_IENABLED_POS 0
+#define MOD_SMT_RING_FLAGS_IENABLED_MASK \
+    (UINT32_C(0x1) << MOD_SMT_RING_FLAGS_IENABLED_POS)
+
+#define MOD_SMT_RING_MIN_SLOT_SIZE \
+    (sizeof(struct mod_smt_ring_slot) + sizeof(uint32_t))
+
+#endif /* INTERNAL_SMT_RING_H */
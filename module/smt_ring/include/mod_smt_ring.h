@@ -0,0 +1,129 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MOD_SMT_RING_H
+#define MOD_SMT_RING_H
+
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupSmtRing Shared Memory Ring Transport
+ *
+ * \brief SCMI transport using a ring of message slots in shared memory.
+ *
+ * \details Unlike the SMT transport, which owns a single message per channel,
+ *      a ring channel lets an agent post up to `slot_count` requests without
+ *      waiting for the earlier ones to be answered. Each request is answered
+ *      in its own slot, so agents only wait for their own responses.
+ *
+ *      Requests are handed to the SCMI service one at a time and in the order
+ *      they were posted. As soon as a response is written, the next pending
+ *      request is dispatched without waiting for another doorbell.
+ *
+ * \{
+ */
+
+/*!
+ * \name Channel policies
+ *
+ * \details These policies define attributes that affect how the channel is
+ *      treated by the ring transport.
+ *
+ * \{
+ */
+
+/*! No policies */
+#define MOD_SMT_RING_POLICY_NONE         ((uint32_t)0)
+
+/*! This channel is secure */
+#define MOD_SMT_RING_POLICY_SECURE       ((uint32_t)(1 << 0))
+
+/*! The mailbox for this channel requires initialization */
+#define MOD_SMT_RING_POLICY_INIT_MAILBOX ((uint32_t)(1 << 1))
+
+/*!
+ * \}
+ */
+
+/*!
+ * \brief Channel config.
+ */
+struct mod_smt_ring_channel_config {
+    /*! Channel policies */
+    uint32_t policies;
+
+    /*! Shared mailbox address */
+    uintptr_t mailbox_address;
+
+    /*! Shared mailbox size in bytes */
+    size_t mailbox_size;
+
+    /*! Number of message slots in the mailbox */
+    unsigned int slot_count;
+
+    /*! Identifier of the driver */
+    fwk_id_t driver_id;
+
+    /*! Identifier of the driver API to bind to */
+    fwk_id_t driver_api_id;
+
+    /*! Identifier of the power domain that this channel depends on */
+    fwk_id_t pd_source_id;
+};
+
+/*!
+ * \brief Type of the interfaces exposed by the ring transport module.
+ */
+enum mod_smt_ring_api_idx {
+    /*! Driver input API, see ::mod_smt_driver_input_api */
+    MOD_SMT_RING_API_IDX_DRIVER_INPUT,
+
+    /*! SCMI transport API, see ::mod_scmi_to_transport_api */
+    MOD_SMT_RING_API_IDX_SCMI_TRANSPORT,
+
+    /*! Number of defined APIs */
+    MOD_SMT_RING_API_IDX_COUNT,
+};
+
+/*!
+ * \brief Ring transport notification indices.
+ */
+enum mod_smt_ring_notification_idx {
+    /*! The ring channel has been initialized */
+    MOD_SMT_RING_NOTIFICATION_IDX_INITIALIZED,
+
+    /*! Number of defined notifications */
+    MOD_SMT_RING_NOTIFICATION_IDX_COUNT
+};
+
+/*!
+ * \brief Identifier for the MOD_SMT_RING_NOTIFICATION_IDX_INITIALIZED
+ *     notification.
+ */
+static const fwk_id_t mod_smt_ring_notification_id_initialized =
+    FWK_ID_NOTIFICATION_INIT(
+        FWK_MODULE_IDX_SMT_RING,
+        MOD_SMT_RING_NOTIFICATION_IDX_INITIALIZED);
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SMT_RING_H */
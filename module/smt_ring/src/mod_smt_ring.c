@@ -0,0 +1,632 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Shared memory ring transport.
+ */
+
+#include <internal/smt_ring.h>
+
+#include <mod_power_domain.h>
+#include <mod_scmi.h>
+#include <mod_smt.h>
+#include <mod_smt_ring.h>
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_interrupt.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_notification.h>
+#include <fwk_status.h>
+
+#include <stdbool.h>
+#include <string.h>
+
+struct smt_ring_channel_ctx {
+    /* Channel identifier */
+    fwk_id_t id;
+
+    /* Channel configuration data */
+    const struct mod_smt_ring_channel_config *config;
+
+    /* Shared mailbox */
+    struct mod_smt_ring_memory *memory;
+
+    /* Size of each slot in bytes */
+    size_t slot_size;
+
+    /* Maximum payload size of a slot */
+    size_t max_payload_size;
+
+    /* Read and write cache memory areas of the message being processed */
+    struct mod_smt_ring_slot *in, *out;
+
+    /* Number of requests handed to the service, free-running */
+    uint32_t dispatch_index;
+
+    /* Message processing in progress flag */
+    volatile bool locked;
+
+    /* Flag indicating the pending requests are being dispatched */
+    bool dispatching;
+
+    /* Flag indicating the mailbox is ready */
+    bool mailbox_ready;
+
+    /* Driver entity identifier */
+    fwk_id_t driver_id;
+
+    /* Driver API */
+    const struct mod_smt_driver_api *driver_api;
+
+    /* SCMI service bound to the channel */
+    fwk_id_t service_id;
+
+    /* SCMI API to signal incoming messages or errors */
+    const struct mod_scmi_from_transport_api *scmi_api;
+};
+
+struct smt_ring_ctx {
+    /* Table of channel contexts */
+    struct smt_ring_channel_ctx *channel_ctx_table;
+
+    /* Number of channels */
+    unsigned int channel_count;
+};
+
+static struct smt_ring_ctx smt_ring_ctx;
+
+static struct smt_ring_channel_ctx *get_channel_ctx(fwk_id_t channel_id)
+{
+    return &smt_ring_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+}
+
+static struct mod_smt_ring_slot *get_slot(
+    const struct smt_ring_channel_ctx *channel_ctx,
+    uint32_t index)
+{
+    uintptr_t slots = (uintptr_t)(channel_ctx->memory + 1);
+
+    index %= channel_ctx->config->slot_count;
+
+    return (struct mod_smt_ring_slot *)(
+        slots + (index * channel_ctx->slot_size));
+}
+
+/*
+ * Hand the next pending request to the SCMI service.
+ */
+static int dispatch_slot(struct smt_ring_channel_ctx *channel_ctx)
+{
+    struct mod_smt_ring_slot *slot, *in, *out;
+
+    slot = get_slot(channel_ctx, channel_ctx->dispatch_index);
+    in = channel_ctx->in;
+    out = channel_ctx->out;
+
+    /* Mirror the slot header in read and write buffers */
+    *in = *slot;
+    *out = *slot;
+
+    /* Ensure error bit is not set */
+    out->status &= ~MOD_SMT_RING_SLOT_STATUS_ERROR_MASK;
+
+    /*
+     * Verify:
+     * 1. The length is at least as large as the message header
+     * 2. The length, minus the size of the message header, is less than or
+     *         equal to the maximum payload size
+     *
+     * Note: the payload size is permitted to be of size zero.
+     */
+    if ((in->length < sizeof(in->message_header)) ||
+        ((in->length - sizeof(in->message_header)) >
+         channel_ctx->max_payload_size)) {
+        out->status |= MOD_SMT_RING_SLOT_STATUS_ERROR_MASK;
+
+        return channel_ctx->scmi_api->signal_error(channel_ctx->service_id);
+    }
+
+    /* Copy payload from shared memory to read buffer */
+    memcpy(
+        in->payload,
+        slot->payload,
+        in->length - sizeof(in->message_header));
+
+    if (channel_ctx->scmi_api->signal_message(channel_ctx->service_id) !=
+        FWK_SUCCESS)
+        return FWK_E_HANDLER;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Dispatch the pending requests of a channel until one of them is waiting for
+ * its response. Requests answered synchronously, like malformed ones, are
+ * completed within the loop rather than through recursion.
+ */
+static int dispatch_pending(struct smt_ring_channel_ctx *channel_ctx)
+{
+    struct mod_smt_ring_memory *memory = channel_ctx->memory;
+    uint32_t outstanding;
+    bool pending;
+    int status;
+
+    fwk_interrupt_global_disable();
+
+    if (channel_ctx->dispatching) {
+        fwk_interrupt_global_enable();
+
+        return FWK_SUCCESS;
+    }
+
+    channel_ctx->dispatching = true;
+
+    for (;;) {
+        outstanding = memory->producer - channel_ctx->dispatch_index;
+        pending = !channel_ctx->locked && (outstanding != 0);
+
+        /*
+         * The flag is cleared with interrupts disabled so that a doorbell
+         * raised after the last check is never ignored.
+         */
+        if (!pending) {
+            channel_ctx->dispatching = false;
+            fwk_interrupt_global_enable();
+
+            return FWK_SUCCESS;
+        }
+
+        channel_ctx->locked = true;
+
+        fwk_interrupt_global_enable();
+
+        if (outstanding > channel_ctx->config->slot_count) {
+            FWK_LOG_ERR(
+                "[SMT_RING] Producer index overrun on channel %u",
+                fwk_id_get_element_idx(channel_ctx->id));
+
+            /* Resynchronize with the agent, dropping the corrupt requests */
+            channel_ctx->dispatch_index = memory->producer;
+            memory->consumer = memory->producer;
+            status = FWK_E_STATE;
+        } else
+            status = dispatch_slot(channel_ctx);
+
+        fwk_interrupt_global_disable();
+
+        if (status != FWK_SUCCESS) {
+            if (status == FWK_E_STATE)
+                channel_ctx->locked = false;
+
+            channel_ctx->dispatching = false;
+            fwk_interrupt_global_enable();
+
+            return status;
+        }
+    }
+}
+
+/*
+ * SCMI Transport API
+ */
+static int smt_ring_get_secure(fwk_id_t channel_id, bool *secure)
+{
+    if (secure == NULL) {
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    *secure = (get_channel_ctx(channel_id)->config->policies &
+               MOD_SMT_RING_POLICY_SECURE) != 0;
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_get_max_payload_size(fwk_id_t channel_id, size_t *size)
+{
+    if (size == NULL) {
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    *size = get_channel_ctx(channel_id)->max_payload_size;
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_get_message_header(fwk_id_t channel_id, uint32_t *header)
+{
+    struct smt_ring_channel_ctx *channel_ctx;
+
+    if (header == NULL) {
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    channel_ctx = get_channel_ctx(channel_id);
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    *header = channel_ctx->in->message_header;
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_get_payload(
+    fwk_id_t channel_id,
+    const void **payload,
+    size_t *size)
+{
+    struct smt_ring_channel_ctx *channel_ctx;
+
+    if (payload == NULL) {
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    channel_ctx = get_channel_ctx(channel_id);
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    *payload = channel_ctx->in->payload;
+
+    if (size != NULL) {
+        *size =
+            channel_ctx->in->length - sizeof(channel_ctx->in->message_header);
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_write_payload(
+    fwk_id_t channel_id,
+    size_t offset,
+    const void *payload,
+    size_t size)
+{
+    struct smt_ring_channel_ctx *channel_ctx = get_channel_ctx(channel_id);
+
+    if ((payload == NULL) || (offset > channel_ctx->max_payload_size) ||
+        (size > channel_ctx->max_payload_size) ||
+        ((offset + size) > channel_ctx->max_payload_size)) {
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    memcpy(((uint8_t *)channel_ctx->out->payload) + offset, payload, size);
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_respond(
+    fwk_id_t channel_id,
+    const void *payload,
+    size_t size)
+{
+    struct smt_ring_channel_ctx *channel_ctx = get_channel_ctx(channel_id);
+    struct mod_smt_ring_memory *memory = channel_ctx->memory;
+    struct mod_smt_ring_slot *slot;
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    if (size > channel_ctx->max_payload_size) {
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    slot = get_slot(channel_ctx, channel_ctx->dispatch_index);
+
+    /* Copy the payload from either the write buffer or the payload parameter */
+    memcpy(
+        slot->payload,
+        (payload == NULL ? channel_ctx->out->payload : payload),
+        size);
+
+    slot->message_header = channel_ctx->out->message_header;
+    slot->length = sizeof(slot->message_header) + size;
+
+    /*
+     * NOTE: Disable interrupts for a brief period to ensure the doorbell of a
+     * new request is not handled in between unlocking the context and
+     * completing the slot.
+     */
+    fwk_interrupt_global_disable();
+
+    channel_ctx->locked = false;
+    channel_ctx->dispatch_index++;
+
+    slot->status =
+        channel_ctx->out->status | MOD_SMT_RING_SLOT_STATUS_FREE_MASK;
+    memory->consumer = channel_ctx->dispatch_index;
+
+    fwk_interrupt_global_enable();
+
+    if (memory->flags & MOD_SMT_RING_FLAGS_IENABLED_MASK)
+        channel_ctx->driver_api->raise_interrupt(channel_ctx->driver_id);
+
+    /* Move on to the requests posted while this one was processed */
+    dispatch_pending(channel_ctx);
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_transmit(
+    fwk_id_t channel_id,
+    uint32_t message_header,
+    const void *payload,
+    size_t size)
+{
+    /* Platform to agent messages are not supported by ring channels */
+    return FWK_E_SUPPORT;
+}
+
+static const struct mod_scmi_to_transport_api smt_ring_scmi_to_transport_api = {
+    .get_secure = smt_ring_get_secure,
+    .get_max_payload_size = smt_ring_get_max_payload_size,
+    .get_message_header = smt_ring_get_message_header,
+    .get_payload = smt_ring_get_payload,
+    .write_payload = smt_ring_write_payload,
+    .respond = smt_ring_respond,
+    .transmit = smt_ring_transmit,
+};
+
+/*
+ * Driver handler API
+ */
+static int smt_ring_signal_message(fwk_id_t channel_id)
+{
+    struct smt_ring_channel_ctx *channel_ctx = get_channel_ctx(channel_id);
+
+    if (!channel_ctx->mailbox_ready) {
+        /* Discard any message in the mailbox when not ready */
+        FWK_LOG_ERR("[SMT_RING] Message not valid");
+
+        return FWK_SUCCESS;
+    }
+
+    /*
+     * Requests posted while another one is processed are dispatched when the
+     * latter is answered.
+     */
+    return dispatch_pending(channel_ctx);
+}
+
+static const struct mod_smt_driver_input_api driver_input_api = {
+    .signal_message = smt_ring_signal_message,
+};
+
+/*
+ * Framework API
+ */
+static int smt_ring_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    smt_ring_ctx.channel_ctx_table =
+        fwk_mm_calloc(element_count, sizeof(smt_ring_ctx.channel_ctx_table[0]));
+    smt_ring_ctx.channel_count = element_count;
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_channel_init(
+    fwk_id_t channel_id,
+    unsigned int unused,
+    const void *data)
+{
+    struct smt_ring_channel_ctx *channel_ctx = get_channel_ctx(channel_id);
+    const struct mod_smt_ring_channel_config *config = data;
+    size_t slot_size;
+
+    /* Validate channel config */
+    if ((config == NULL) || (config->mailbox_address == 0) ||
+        (config->slot_count == 0) ||
+        (config->mailbox_size < sizeof(struct mod_smt_ring_memory))) {
+        fwk_unexpected();
+        return FWK_E_DATA;
+    }
+
+    /* Keep the slots word-aligned */
+    slot_size =
+        (config->mailbox_size - sizeof(struct mod_smt_ring_memory)) /
+        config->slot_count;
+    slot_size &= ~(sizeof(uint32_t) - 1);
+
+    if (slot_size < MOD_SMT_RING_MIN_SLOT_SIZE) {
+        fwk_unexpected();
+        return FWK_E_DATA;
+    }
+
+    channel_ctx->id = channel_id;
+    channel_ctx->config = config;
+    channel_ctx->memory = (struct mod_smt_ring_memory *)config->mailbox_address;
+    channel_ctx->slot_size = slot_size;
+    channel_ctx->max_payload_size =
+        slot_size - sizeof(struct mod_smt_ring_slot);
+    channel_ctx->in = fwk_mm_alloc(1, slot_size);
+    channel_ctx->out = fwk_mm_alloc(1, slot_size);
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_bind(fwk_id_t id, unsigned int round)
+{
+    struct smt_ring_channel_ctx *channel_ctx;
+    int status;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    channel_ctx = get_channel_ctx(id);
+
+    if (round == 0) {
+        status = fwk_module_bind(
+            channel_ctx->config->driver_id,
+            channel_ctx->config->driver_api_id,
+            &channel_ctx->driver_api);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        channel_ctx->driver_id = channel_ctx->config->driver_id;
+    } else {
+        status = fwk_module_bind(
+            channel_ctx->service_id,
+            FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_TRANSPORT),
+            &channel_ctx->scmi_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    struct smt_ring_channel_ctx *channel_ctx;
+
+    /* Only bind to a channel (not the whole module) */
+    if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT)) {
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    channel_ctx = get_channel_ctx(target_id);
+
+    switch (fwk_id_get_api_idx(api_id)) {
+    case MOD_SMT_RING_API_IDX_DRIVER_INPUT:
+        /*
+         * Only the driver we bound to, or one of its sub-elements, may bind
+         * back to us. See the SMT module for why the indices are compared.
+         */
+        if ((fwk_id_get_module_idx(channel_ctx->driver_id) !=
+             fwk_id_get_module_idx(source_id)) ||
+            (fwk_id_get_element_idx(channel_ctx->driver_id) !=
+             fwk_id_get_element_idx(source_id))) {
+            fwk_unexpected();
+            return FWK_E_ACCESS;
+        }
+
+        *api = &driver_input_api;
+        break;
+
+    case MOD_SMT_RING_API_IDX_SCMI_TRANSPORT:
+        *api = &smt_ring_scmi_to_transport_api;
+        channel_ctx->service_id = source_id;
+        break;
+
+    default:
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int smt_ring_start(fwk_id_t id)
+{
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    /* Register for power domain state transition notifications */
+    return fwk_notification_subscribe(
+        mod_pd_notification_id_power_state_transition,
+        get_channel_ctx(id)->config->pd_source_id,
+        id);
+}
+
+static void init_mailbox(struct smt_ring_channel_ctx *channel_ctx)
+{
+    struct mod_smt_ring_memory *memory = channel_ctx->memory;
+    unsigned int i;
+
+    *memory = (struct mod_smt_ring_memory){
+        .slot_count = channel_ctx->config->slot_count,
+        .slot_size = (uint32_t)channel_ctx->slot_size,
+    };
+
+    for (i = 0; i < channel_ctx->config->slot_count; i++) {
+        *get_slot(channel_ctx, i) = (struct mod_smt_ring_slot){
+            .status = MOD_SMT_RING_SLOT_STATUS_FREE_MASK,
+        };
+    }
+}
+
+static int smt_ring_process_notification(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    const struct mod_pd_power_state_transition_notification_params *params;
+    struct smt_ring_channel_ctx *channel_ctx;
+    unsigned int notifications_sent;
+
+    fwk_assert(fwk_id_is_equal(
+        event->id, mod_pd_notification_id_power_state_transition));
+    fwk_assert(fwk_id_is_type(event->target_id, FWK_ID_TYPE_ELEMENT));
+
+    params = (const struct mod_pd_power_state_transition_notification_params *)
+                 event->params;
+    channel_ctx = get_channel_ctx(event->target_id);
+
+    if (params->state != MOD_PD_STATE_ON) {
+        if (params->state == MOD_PD_STATE_OFF)
+            channel_ctx->mailbox_ready = false;
+
+        return FWK_SUCCESS;
+    }
+
+    channel_ctx->locked = false;
+
+    if (!(channel_ctx->config->policies & MOD_SMT_RING_POLICY_INIT_MAILBOX)) {
+        /* Resume after the last request completed by a previous firmware */
+        channel_ctx->dispatch_index = channel_ctx->memory->consumer;
+        channel_ctx->mailbox_ready = true;
+
+        return FWK_SUCCESS;
+    }
+
+    init_mailbox(channel_ctx);
+    channel_ctx->dispatch_index = 0;
+    channel_ctx->mailbox_ready = true;
+
+    /* Notify that this mailbox is initialized */
+    struct fwk_event initialized_notification = {
+        .id = mod_smt_ring_notification_id_initialized,
+        .source_id = FWK_ID_NONE,
+    };
+
+    return fwk_notification_notify(
+        &initialized_notification, &notifications_sent);
+}
+
+const struct fwk_module module_smt_ring = {
+    .name = "smt_ring",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_SMT_RING_API_IDX_COUNT,
+    .notification_count = MOD_SMT_RING_NOTIFICATION_IDX_COUNT,
+    .init = smt_ring_init,
+    .element_init = smt_ring_channel_init,
+    .bind = smt_ring_bind,
+    .start = smt_ring_start,
+    .process_bind_request = smt_ring_process_bind_request,
+    .process_notification = smt_ring_process_notification,
+};
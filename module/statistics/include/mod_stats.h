@@ -13,6 +13,7 @@
 #include <fwk_macros.h>
 #include <fwk_module_idx.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /*!
@@ -40,8 +41,34 @@ struct FWK_PACKED mod_stats_config_info {
     /*! Size in bytes of the shared memory region for statistics */
     uint32_t stats_region_size;
 
-    /*! Alarm used for period updates */
+    /*! Alarm used for period updates, or FWK_ID_NONE to only update the
+     * residencies on level changes and on explicit refreshes, see
+     * mod_stats_api::refresh_stats() */
     fwk_id_t alarm_id;
+
+    /*! Update a private copy of the statistics and publish it to the shared
+     * memory region on every periodic update, instead of updating the shared
+     * memory region directly. */
+    bool snapshot_mode;
+
+    /*! Maximum number of metrics in the metrics catalog, or zero when the
+     * catalog is not needed. See mod_stats_metrics_api. When the framework
+     * keeps interrupt statistics, see FWK_INTERRUPT_STATS, the module adds
+     * three metrics of its own to the catalog: the number of interrupts
+     * serviced, the longest interrupt service routine and the longest time
+     * interrupts were masked, updated periodically. */
+    uint16_t metric_count_max;
+
+    /*! SCP address of the telemetry offload ring, or zero to aggregate the
+     * metrics in the catalog. When the ring is configured, the values given
+     * to mod_stats_metrics_api are not aggregated by the SCP but written as
+     * raw samples to the ring, see mod_stats_offload_header, for another
+     * processor to aggregate them. The catalog then only describes the
+     * metrics. */
+    uintptr_t offload_ring_addr;
+
+    /*! Size in bytes of the telemetry offload ring, including its header */
+    uint32_t offload_ring_size;
 };
 
 /*!
@@ -58,6 +85,10 @@ struct mod_stats_map {
      * offset calculation, since it can be modified by OSPM */
     uint32_t *se_curr_level;
 
+    /*! Array of pointers to the transition latency statistics of each
+     * domain, NULL when they are not collected for the domain. */
+    struct mod_stats_latency_stats **se_latency;
+
     /*! An array of pointers to the domain statistics table. Every domain
      * has its own table when statistics collection is set for it. */
     struct mod_stats_domain_stats_data *se_stats[];
@@ -149,7 +180,13 @@ struct mod_stats_desc_header {
     uint16_t domain_count;
 
     /*! Empty space just for memory alignment as per SCMI specification. */
-    uint16_t reserved[3];
+    uint16_t reserved;
+
+    /*! Sequence number of the statistics updates. It is odd while the
+     * statistics are being updated, so a reader has a consistent copy of the
+     * statistics when it reads the same even number before and after
+     * copying them. */
+    uint32_t sequence;
 
     /*! For each domain this array provides 4B offset from start addr of the
      * statistics memory region to the particular performance or power domain
@@ -193,7 +230,9 @@ struct FWK_PACKED mod_stats_domain_stats_data {
     uint32_t extended_stats_offset;
 
     /*! Holds time stamp when the last performance or power level has been
-     * changed. Value is in microseconds.*/
+     * changed, or when the residency of the current level was last brought
+     * up to date. The time elapsed since then is not yet accounted in the
+     * residency of the current level. Value is in microseconds.*/
     uint64_t ts_last_change_us;
 
     /*! Beginning of the statistics region with information for each
@@ -201,6 +240,179 @@ struct FWK_PACKED mod_stats_domain_stats_data {
     struct mod_stats_level_stats level[];
 };
 
+/*!
+ * \brief Transition latency statistics of a performance or power domain
+ *
+ * \details Extended statistics of a domain. When present, they are located
+ *      'extended_stats_offset' bytes from the start of the statistics data of
+ *      the domain.
+ */
+struct FWK_PACKED mod_stats_latency_stats {
+    /*! Number of transitions whose latency has been measured. */
+    uint64_t transition_count;
+
+    /*! Cumulative latency of the measured transitions. Value is in
+     * microseconds. */
+    uint64_t total_latency_us;
+
+    /*! Latency of the last measured transition. Value is in microseconds. */
+    uint32_t last_latency_us;
+
+    /*! Highest latency measured. Value is in microseconds. */
+    uint32_t max_latency_us;
+};
+
+/*! Maximum length of a metric name, including the terminating NUL */
+#define MOD_STATS_METRIC_NAME_LEN 16
+
+/*!
+ * \brief Type of a metric of the metrics catalog.
+ */
+enum mod_stats_metric_type {
+    /*! Monotonic count of events, e.g. transfers or errors */
+    MOD_STATS_METRIC_COUNTER,
+
+    /*! Instantaneous value, e.g. a queue depth or a temperature */
+    MOD_STATS_METRIC_GAUGE,
+
+    /*! Distribution of sampled values, e.g. latencies */
+    MOD_STATS_METRIC_HISTOGRAM,
+};
+
+/*!
+ * \brief Description of a metric to add to the metrics catalog.
+ */
+struct mod_stats_metric_info {
+    /*! Name of the metric, truncated to MOD_STATS_METRIC_NAME_LEN - 1 */
+    const char *name;
+
+    /*! Type of the metric */
+    enum mod_stats_metric_type type;
+
+    /*! Number of buckets of a histogram, ignored for the other types */
+    unsigned int bucket_count;
+
+    /*! Lowest value of the first bucket of a histogram */
+    uint64_t bucket_base;
+
+    /*! Width of the buckets of a histogram */
+    uint64_t bucket_width;
+};
+
+/*!
+ * \brief Header of the metrics catalog in shared memory.
+ *
+ * \details The catalog is self-describing: every metric carries its name,
+ *      owner and type. It is updated with the same sequence number protocol
+ *      as the performance and power statistics.
+ */
+struct mod_stats_catalog_header {
+    /*! Signature - 0x4D545243 ('MTRC'). */
+    uint32_t signature;
+
+    /*! Revision of the catalog layout. */
+    uint16_t revision;
+
+    /*! Number of metrics in the catalog. */
+    uint16_t metric_count;
+
+    /*! Sequence number of the catalog updates, odd during an update. */
+    uint32_t sequence;
+
+    /*! Reserved, zero. */
+    uint32_t reserved;
+
+    /*! For each metric, the offset from the start of the catalog header to
+     * the metric. */
+    uint32_t metric_offset[];
+};
+
+/*!
+ * \brief Metric of the metrics catalog in shared memory.
+ */
+struct FWK_PACKED mod_stats_metric {
+    /*! Name of the metric, NUL-terminated. */
+    char name[MOD_STATS_METRIC_NAME_LEN];
+
+    /*! Identifier of the entity owning the metric, as a framework
+     * identifier value. */
+    uint32_t owner;
+
+    /*! Type of the metric, see mod_stats_metric_type. */
+    uint16_t type;
+
+    /*! Number of buckets following the metric, for a histogram. */
+    uint16_t bucket_count;
+
+    /*! Total of a counter, last value of a gauge or number of samples of a
+     * histogram. */
+    uint64_t value;
+
+    /*! Highest value of a gauge or highest sample of a histogram. */
+    uint64_t max;
+
+    /*! Sum of the samples of a histogram. */
+    uint64_t sum;
+
+    /*! Lowest value of the first bucket of a histogram. */
+    uint64_t bucket_base;
+
+    /*! Width of the buckets of a histogram. */
+    uint64_t bucket_width;
+
+    /*! Number of samples in each bucket of a histogram. Bucket i holds the
+     * samples from bucket_base + i * bucket_width included to
+     * bucket_base + (i + 1) * bucket_width excluded. The first and the last
+     * buckets also hold the samples below and above the histogram range. */
+    uint64_t bucket[];
+};
+
+/*! Signature of the telemetry offload ring - 0x4C504D53 ('SMPL') */
+#define MOD_STATS_OFFLOAD_SIGNATURE UINT32_C(0x4C504D53)
+
+/*!
+ * \brief Header of the telemetry offload ring in shared memory.
+ *
+ * \details The header is followed by mod_stats_offload_header::slot_count
+ *      samples. The sample with the sequence number N is in the slot
+ *      N % mod_stats_offload_header::slot_count. The SCP is the only writer:
+ *      it writes a sample before it publishes the new sequence number. A
+ *      reader copies the samples between its last sequence number and the
+ *      current one, then reads the sequence number again: the samples whose
+ *      sequence number is lower than the new sequence number minus the number
+ *      of slots may have been overwritten while they were copied.
+ */
+struct mod_stats_offload_header {
+    /*! Signature - MOD_STATS_OFFLOAD_SIGNATURE. */
+    uint32_t signature;
+
+    /*! Number of samples written to the ring since boot, modulo 2^32. */
+    uint32_t sequence;
+
+    /*! Number of sample slots following the header, a power of two. */
+    uint32_t slot_count;
+
+    /*! Reserved, zero. */
+    uint32_t reserved;
+};
+
+/*!
+ * \brief Raw sample of the telemetry offload ring.
+ */
+struct mod_stats_offload_sample {
+    /*! Index of the metric in the catalog. */
+    uint16_t metric_idx;
+
+    /*! Type of the metric, see mod_stats_metric_type. */
+    uint16_t type;
+
+    /*! Reserved, zero. */
+    uint32_t reserved;
+
+    /*! Increment of a counter, value of a gauge or sample of a histogram. */
+    uint64_t value;
+};
+
 /*!
  * \}
  */
@@ -246,6 +458,16 @@ struct mod_stats_api {
         fwk_id_t domain_id,
         int level_count);
 
+    /*!
+     * \brief Add transition latency statistics to a domain.
+     *
+     * \note The domain must have been added with add_domain() beforehand.
+     *
+     * \param module_id Element identifier of the module.
+     * \param domain_id Element identifier of the domain.
+     */
+    int (*add_domain_latency)(fwk_id_t module_id, fwk_id_t domain_id);
+
     /*!
      * \brief Update the domain statistics with new level ID set.
      *
@@ -258,6 +480,20 @@ struct mod_stats_api {
         fwk_id_t domain_id,
         uint32_t level_id);
 
+    /*!
+     * \brief Update the domain statistics with the latency of a completed
+     *      transition.
+     *
+     * \param module_id Element identifier of the module.
+     * \param domain_id Element identifier of the domain.
+     * \param latency_us Time between the request of the transition and its
+     *      completion, in microseconds.
+     */
+    int (*update_domain_latency)(
+        fwk_id_t module_id,
+        fwk_id_t domain_id,
+        uint32_t latency_us);
+
     /*!
      * \brief Get low and high addresses of statistics in AP address space
      *          with length of the memory region
@@ -272,6 +508,93 @@ struct mod_stats_api {
         uint32_t *addr_low,
         uint32_t *addr_high,
         uint32_t *len);
+
+    /*!
+     * \brief Bring the residency of the current level of every domain of
+     *      the module up to date, and publish the statistics in snapshot
+     *      mode.
+     *
+     * \details Needed when the statistics are not updated periodically, for
+     *      instance before an agent is told to read them.
+     *
+     * \param module_id Element identifier of the module.
+     */
+    int (*refresh_stats)(fwk_id_t module_id);
+};
+
+/*!
+ * \brief Metrics API.
+ *
+ * \details Lets any module publish counters, gauges and histograms in the
+ *      metrics catalog. The metrics are added once, usually while the module
+ *      starts, and updated through the index returned.
+ */
+struct mod_stats_metrics_api {
+    /*!
+     * \brief Add a metric to the catalog.
+     *
+     * \param owner_id Identifier of the entity owning the metric.
+     * \param info Description of the metric.
+     * \param [out] metric_idx Index of the metric.
+     *
+     * \retval ::FWK_SUCCESS The metric was added.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_NOMEM The catalog or the shared memory region is full.
+     * \retval ::FWK_E_SUPPORT The catalog is not configured.
+     */
+    int (*add_metric)(
+        fwk_id_t owner_id,
+        const struct mod_stats_metric_info *info,
+        unsigned int *metric_idx);
+
+    /*!
+     * \brief Increment a counter.
+     *
+     * \param metric_idx Index of the counter.
+     * \param increment Value added to the counter.
+     *
+     * \retval ::FWK_SUCCESS The counter was incremented.
+     * \retval ::FWK_E_PARAM The index is not the index of a counter.
+     */
+    int (*counter_add)(unsigned int metric_idx, uint64_t increment);
+
+    /*!
+     * \brief Set the value of a gauge.
+     *
+     * \param metric_idx Index of the gauge.
+     * \param value New value of the gauge.
+     *
+     * \retval ::FWK_SUCCESS The gauge was set.
+     * \retval ::FWK_E_PARAM The index is not the index of a gauge.
+     */
+    int (*gauge_set)(unsigned int metric_idx, uint64_t value);
+
+    /*!
+     * \brief Record a sample in a histogram.
+     *
+     * \param metric_idx Index of the histogram.
+     * \param value Sampled value.
+     *
+     * \retval ::FWK_SUCCESS The sample was recorded.
+     * \retval ::FWK_E_PARAM The index is not the index of a histogram.
+     */
+    int (*histogram_record)(unsigned int metric_idx, uint64_t value);
+
+    /*!
+     * \brief Get low and high addresses of the metrics catalog in AP address
+     *      space with length of the memory region
+     *
+     * \param [out] addr_low lower 32 bits of the catalog address
+     * \param [out] addr_high higher 32 bits of the catalog address
+     * \param [out] len length of the catalog memory region
+     *
+     * \retval ::FWK_SUCCESS The description was returned.
+     * \retval ::FWK_E_SUPPORT The catalog is not configured.
+     */
+    int (*get_catalog_desc)(
+        uint32_t *addr_low,
+        uint32_t *addr_high,
+        uint32_t *len);
 };
 /*!
  * \}
@@ -286,13 +609,20 @@ struct mod_stats_api {
  */
 enum mod_stats_api_idx {
     MOD_STATS_API_IDX_STATS, /*!< API index for mod_stats_api_id_stats() */
+    MOD_STATS_API_IDX_METRICS, /*!< API index for mod_stats_api_id_metrics */
     MOD_STATS_API_IDX_COUNT /*!< Number of defined APIs */
 };
 
+#ifdef BUILD_HAS_MOD_STATISTICS
 /*! Module API identifier */
 static const fwk_id_t mod_stats_api_id_stats =
     FWK_ID_API_INIT(FWK_MODULE_IDX_STATISTICS, MOD_STATS_API_IDX_STATS);
 
+/*! Metrics API identifier */
+static const fwk_id_t mod_stats_api_id_metrics =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_STATISTICS, MOD_STATS_API_IDX_METRICS);
+#endif
+
 /*!
  * \}
  */
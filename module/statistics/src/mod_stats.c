@@ -9,23 +9,66 @@
 #include <mod_timer.h>
 
 #include <fwk_assert.h>
-#include <fwk_log.h>
+#include <fwk_cache.h>
+#include <fwk_event.h>
 #include <fwk_interrupt.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_math.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 #include <fwk_time.h>
 
+#include <fmw_cmsis.h>
+
+#include <stdbool.h>
 #include <string.h>
 
 /* 'PERF' = 0x50455246 in SCP little-endian */
 #define STATS_SIGN_PERF 0x50455246
 /* 'POWR' = 0x504F5752 in SCP little-endian */
 #define STATS_SIGN_POWR 0x504F5752
+/* 'MTRC' = 0x4D545243 in SCP little-endian */
+#define STATS_SIGN_MTRC 0x4D545243
+
+#define STATS_CATALOG_REVISION 1
 
 #define STATS_UPDATE_PERIOD_MS  100
 
+enum mod_stats_event_idx {
+    MOD_STATS_EVENT_IDX_UPDATE,
+    MOD_STATS_EVENT_IDX_COUNT
+};
+
+static const fwk_id_t mod_stats_event_id_update =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_STATISTICS, MOD_STATS_EVENT_IDX_UPDATE);
+
+/* Interrupt metrics published when the framework keeps interrupt statistics */
+enum stats_irq_metric {
+    STATS_IRQ_METRIC_COUNT_TOTAL,
+    STATS_IRQ_METRIC_ISR_MAX,
+    STATS_IRQ_METRIC_MASKED_MAX,
+    STATS_IRQ_METRIC_COUNT
+};
+
+static const struct mod_stats_metric_info stats_irq_metric_info[] = {
+    [STATS_IRQ_METRIC_COUNT_TOTAL] = {
+        .name = "irq_count",
+        .type = MOD_STATS_METRIC_GAUGE,
+    },
+    [STATS_IRQ_METRIC_ISR_MAX] = {
+        .name = "irq_isr_max_ns",
+        .type = MOD_STATS_METRIC_GAUGE,
+    },
+    [STATS_IRQ_METRIC_MASKED_MAX] = {
+        .name = "irq_masked_ns",
+        .type = MOD_STATS_METRIC_GAUGE,
+    },
+};
+
 struct mod_stats_ctx {
     /* Platform specific memory configuration data */
     const struct mod_stats_config_info *config;
@@ -33,6 +76,10 @@ struct mod_stats_ctx {
     /* Offset of the available memory in the statistics region */
     uint32_t avail_mem_offset;
 
+    /* Address of the statistics updated by the SCP: the shared memory region,
+     * or its private copy in snapshot mode */
+    uintptr_t region_base;
+
     /* Context of performance statistics */
     struct mod_stats_info *perf_stats;
 
@@ -41,10 +88,48 @@ struct mod_stats_ctx {
 
     /* Alarm API for periodic shared memory updates */
     const struct mod_timer_alarm_api *alarm_api;
+
+    /* A periodic update event has been queued and not yet processed */
+    volatile bool update_pending;
+
+    /* Metrics catalog header, NULL when the catalog is not configured */
+    struct mod_stats_catalog_header *catalog;
+
+    /* Offset of the metrics catalog header in the statistics region */
+    uint32_t catalog_offset;
+
+    /* Size of the metrics catalog, from its header to its last metric */
+    uint32_t catalog_size;
+
+    /* Table of the metrics of the catalog */
+    struct mod_stats_metric **metric_table;
+
+    /* The interrupt metrics were added to the catalog */
+    bool irq_metrics;
+
+    /* Indices of the interrupt metrics in the catalog */
+    unsigned int irq_metric_idx[STATS_IRQ_METRIC_COUNT];
+
+    /* Header of the telemetry offload ring, NULL when it is not configured */
+    volatile struct mod_stats_offload_header *offload_header;
+
+    /* Sample slots of the telemetry offload ring */
+    volatile struct mod_stats_offload_sample *offload_ring;
+
+    /* Number of samples written to the telemetry offload ring */
+    uint32_t offload_sequence;
 };
 
 static struct mod_stats_ctx stats_ctx;
 
+/* Write the statistics of the shared memory region back to memory */
+static void stats_clean(void)
+{
+    fwk_cache_clean(
+        (const void *)stats_ctx.config->scp_stats_addr,
+        stats_ctx.avail_mem_offset);
+}
+
 static struct mod_stats_info *get_module_stats_info(fwk_id_t module_id)
 {
     if (fwk_id_get_module_idx(module_id) ==
@@ -55,6 +140,13 @@ static struct mod_stats_info *get_module_stats_info(fwk_id_t module_id)
         fwk_id_get_module_idx(fwk_module_id_scmi_power_domain))
         return stats_ctx.power_stats;
 
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
+    /* Power domain statistics are shared with the SCMI power domains */
+    if (fwk_id_get_module_idx(module_id) ==
+        fwk_id_get_module_idx(fwk_module_id_power_domain))
+        return stats_ctx.power_stats;
+#endif
+
     return NULL;
 }
 
@@ -77,6 +169,15 @@ static int set_module_stats_info(fwk_id_t module_id,
         ret = FWK_SUCCESS;
     }
 
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
+    if (fwk_id_get_module_idx(module_id) ==
+        fwk_id_get_module_idx(fwk_module_id_power_domain)) {
+        stats_ctx.power_stats = stats;
+        stats->type_signature = STATS_SIGN_POWR;
+        ret = FWK_SUCCESS;
+    }
+#endif
+
     return ret;
 }
 
@@ -120,18 +221,17 @@ static int allocate_domain_stats(fwk_id_t module_id,
     }
 
     se_map = stats->context->se_stats_map;
-    se_map->se_level_count[idx] = level_count;
-    se_map->se_curr_level[idx] = 0;
+    se_map->se_level_count[stats_id] = level_count;
+    se_map->se_curr_level[stats_id] = 0;
 
     /* Offset from the beginning of statistics header used by AP */
     stats_offset = stats_ctx.avail_mem_offset - stats->desc_header_offset;
     desc_header->domain_offset[idx] = stats_offset;
 
     /* Address used in SCP to get domain statistics in the shared region */
-    scp_stats_addr = stats_ctx.config->scp_stats_addr +
-                     stats_ctx.avail_mem_offset;
-    se_map->se_stats[idx] = (struct mod_stats_domain_stats_data *)
-                            scp_stats_addr;
+    scp_stats_addr = stats_ctx.region_base + stats_ctx.avail_mem_offset;
+    se_map->se_stats[stats_id] = (struct mod_stats_domain_stats_data *)
+                                 scp_stats_addr;
 
     /* Shrink the free space in the shared region */
     stats_ctx.avail_mem_offset += stats_size;
@@ -158,7 +258,7 @@ static int _allocate_header(struct mod_stats_info *stats, int domain_count)
 
     stats->desc_header_offset = stats_ctx.avail_mem_offset;
     stats->desc_header = (struct mod_stats_desc_header *)
-                         (stats_ctx.config->scp_stats_addr +
+                         (stats_ctx.region_base +
                           stats_ctx.avail_mem_offset);
 
     stats->used_mem_size += stats->desc_header_size;
@@ -201,10 +301,97 @@ _allocate_stats_context(int domain_count, int used_domains)
 
     se_map->se_level_count = fwk_mm_calloc(used_domains, sizeof(int));
     se_map->se_curr_level = fwk_mm_calloc(used_domains, sizeof(uint32_t));
+    se_map->se_latency = fwk_mm_calloc(
+        used_domains, sizeof(struct mod_stats_latency_stats *));
 
     return stats;
 }
 
+/*
+ * The statistics of a module are updated between stats_write_begin() and
+ * stats_write_end(). All the updates are made from the framework thread, so
+ * they never interleave. In snapshot mode the updates go to the private copy,
+ * which is published with the same protocol by stats_publish().
+ */
+static void stats_write_begin(uint32_t *sequence)
+{
+    if (stats_ctx.config->snapshot_mode)
+        return;
+
+    (*sequence)++;
+    __DMB();
+    fwk_cache_clean(sequence, sizeof(*sequence));
+}
+
+static void stats_write_end(uint32_t *sequence)
+{
+    if (stats_ctx.config->snapshot_mode)
+        return;
+
+    stats_clean();
+    __DMB();
+    (*sequence)++;
+    fwk_cache_clean(sequence, sizeof(*sequence));
+}
+
+/*
+ * Move the sequence number of every module to its next value, in the private
+ * copy and in the shared memory region.
+ */
+static void stats_publish_sequence(void)
+{
+    struct mod_stats_info *const stats_table[] = {
+        stats_ctx.perf_stats,
+        stats_ctx.power_stats,
+    };
+    struct mod_stats_desc_header *shared_header;
+    struct mod_stats_catalog_header *shared_catalog;
+    struct mod_stats_info *stats;
+    unsigned int i;
+
+    for (i = 0; i < FWK_ARRAY_SIZE(stats_table); i++) {
+        stats = stats_table[i];
+        if ((stats == NULL) || (stats->desc_header == NULL))
+            continue;
+
+        shared_header = (struct mod_stats_desc_header *)
+                        (stats_ctx.config->scp_stats_addr +
+                         stats->desc_header_offset);
+
+        stats->desc_header->sequence++;
+        shared_header->sequence = stats->desc_header->sequence;
+    }
+
+    if (stats_ctx.catalog != NULL) {
+        shared_catalog = (struct mod_stats_catalog_header *)
+                         (stats_ctx.config->scp_stats_addr +
+                          stats_ctx.catalog_offset);
+
+        stats_ctx.catalog->sequence++;
+        shared_catalog->sequence = stats_ctx.catalog->sequence;
+    }
+}
+
+/*
+ * Copy the private copy of the statistics to the shared memory region. The
+ * sequence numbers are odd during the copy, including in the copied headers.
+ */
+static void stats_publish(void)
+{
+    stats_publish_sequence();
+    stats_clean();
+    __DMB();
+
+    memcpy((void *)stats_ctx.config->scp_stats_addr,
+           (const void *)stats_ctx.region_base,
+           stats_ctx.avail_mem_offset);
+    stats_clean();
+
+    __DMB();
+    stats_publish_sequence();
+    stats_clean();
+}
+
 static int stats_init_module(fwk_id_t module_id,
     int domain_count,
     int used_domains)
@@ -241,6 +428,8 @@ static int stats_start_module(fwk_id_t module_id)
     if (stats->mode == STATS_SETUP) {
         if (stats->context->last_stats_id == stats->context->se_used_num) {
             stats->mode = STATS_INITIALIZED;
+            if (stats_ctx.config->snapshot_mode)
+                stats_publish();
             return FWK_SUCCESS;
         } else {
             stats->mode = STATS_NOT_SUPPORTED;
@@ -308,6 +497,51 @@ static int stats_add_domain(fwk_id_t module_id,
     return FWK_SUCCESS;
 }
 
+static int stats_add_domain_latency(fwk_id_t module_id, fwk_id_t domain_id)
+{
+    struct mod_stats_domain_stats_data *domain_stats;
+    struct mod_stats_latency_stats *latency_stats;
+    struct mod_stats_info *stats;
+    uint32_t stats_size;
+    int stats_id;
+
+    stats = get_module_stats_info(module_id);
+    if (!stats)
+        return FWK_E_PARAM;
+
+    if (stats->mode != STATS_SETUP)
+        return FWK_E_STATE;
+
+    domain_stats = get_domain_section_data(module_id, domain_id);
+    if (domain_stats == NULL)
+        return FWK_E_PARAM;
+
+    stats_size = sizeof(struct mod_stats_latency_stats);
+
+    if (stats_size > (stats_ctx.config->stats_region_size -
+        stats_ctx.avail_mem_offset)) {
+        FWK_LOG_ERR("[STATS]: Error, size of statistics region too small\n");
+        stats->mode = STATS_INTERNAL_ERROR;
+        return FWK_E_NOMEM;
+    }
+
+    latency_stats = (struct mod_stats_latency_stats *)
+                    (stats_ctx.region_base +
+                     stats_ctx.avail_mem_offset);
+
+    /* Offset from the beginning of the domain statistics used by AP */
+    domain_stats->extended_stats_offset =
+        (uint32_t)((uintptr_t)latency_stats - (uintptr_t)domain_stats);
+
+    stats_id = stats->context->se_index_map[fwk_id_get_element_idx(domain_id)];
+    stats->context->se_stats_map->se_latency[stats_id] = latency_stats;
+
+    stats_ctx.avail_mem_offset += stats_size;
+    stats->used_mem_size += stats_size;
+
+    return FWK_SUCCESS;
+}
+
 /* This is only temporary, it will be swapped with system ts func */
 static uint64_t _get_curret_ts_us(void)
 {
@@ -354,7 +588,7 @@ stats_update_domain(fwk_id_t module_id, fwk_id_t domain_id, uint32_t level_id)
 
     ts_now_us = _get_curret_ts_us();
 
-    fwk_interrupt_global_disable();
+    stats_write_begin(&stats->desc_header->sequence);
 
     /* Update old performance level statistics */
     old_level_id = se_map->se_curr_level[stats_id];
@@ -369,11 +603,49 @@ stats_update_domain(fwk_id_t module_id, fwk_id_t domain_id, uint32_t level_id)
     domain_stats->curr_level_id = level_id;
     se_map->se_curr_level[stats_id] = level_id;
 
-    fwk_interrupt_global_enable();
+    stats_write_end(&stats->desc_header->sequence);
 
     return FWK_SUCCESS;
 }
 
+static int stats_update_domain_latency(fwk_id_t module_id,
+    fwk_id_t domain_id,
+    uint32_t latency_us)
+{
+    struct mod_stats_latency_stats *latency_stats;
+    struct mod_stats_info *stats;
+    int stats_id;
+
+    stats = get_module_stats_info(module_id);
+    if (!stats)
+        return FWK_E_PARAM;
+
+    if (stats->mode != STATS_INITIALIZED)
+        return FWK_E_SUPPORT;
+
+    if (get_domain_section_data(module_id, domain_id) == NULL)
+        return FWK_E_PARAM;
+
+    stats_id = stats->context->se_index_map[fwk_id_get_element_idx(domain_id)];
+    latency_stats = stats->context->se_stats_map->se_latency[stats_id];
+    if (latency_stats == NULL)
+        return FWK_E_PARAM;
+
+    stats_write_begin(&stats->desc_header->sequence);
+
+    latency_stats->transition_count++;
+    latency_stats->total_latency_us += latency_us;
+    latency_stats->last_latency_us = latency_us;
+    if (latency_us > latency_stats->max_latency_us)
+        latency_stats->max_latency_us = latency_us;
+
+    stats_write_end(&stats->desc_header->sequence);
+
+    return FWK_SUCCESS;
+}
+
+static int stats_refresh(fwk_id_t module_id);
+
 static int
 get_statistics_desc(fwk_id_t module_id,
     uint32_t *addr_low,
@@ -397,17 +669,10 @@ get_statistics_desc(fwk_id_t module_id,
     *addr_high = (uint32_t)(ap_stats_addr >> 32);
     *len = stats->used_mem_size;
 
-    return FWK_SUCCESS;
+    /* Bring the residencies up to date for the agent querying them */
+    return stats_refresh(module_id);
 }
 
-static const struct mod_stats_api mod_stats_api = {
-    .init_stats = stats_init_module,
-    .start_stats = stats_start_module,
-    .add_domain = stats_add_domain,
-    .update_domain = stats_update_domain,
-    .get_statistics_desc = get_statistics_desc,
-};
-
 static void update_all_domains_current_level(fwk_id_t module_id)
 {
     struct mod_stats_domain_stats_data *domain_stats;
@@ -426,6 +691,10 @@ static void update_all_domains_current_level(fwk_id_t module_id)
     if (stats->mode != STATS_INITIALIZED)
         return;
 
+    ts_now_us = _get_curret_ts_us();
+
+    stats_write_begin(&stats->desc_header->sequence);
+
     for (i = 0; i < stats->context->se_total_num; i++) {
         domain_id = FWK_ID_ELEMENT(fwk_id_get_module_idx(module_id), i);
         domain_stats = get_domain_section_data(module_id, domain_id);
@@ -435,10 +704,6 @@ static void update_all_domains_current_level(fwk_id_t module_id)
         se_map = stats->context->se_stats_map;
         stats_id = stats->context->se_index_map[i];
 
-        fwk_interrupt_global_disable();
-
-        ts_now_us = _get_curret_ts_us();
-
         /* Update current operation level statistics */
         delta_t = ts_now_us - domain_stats->ts_last_change_us;
 
@@ -446,19 +711,402 @@ static void update_all_domains_current_level(fwk_id_t module_id)
         level_stats = &domain_stats->level[curr_level_id];
         level_stats->total_residency_us += delta_t;
         domain_stats->ts_last_change_us = ts_now_us;
+    }
+
+    stats_write_end(&stats->desc_header->sequence);
+}
+
+static int stats_refresh(fwk_id_t module_id)
+{
+    struct mod_stats_info *stats;
+
+    stats = get_module_stats_info(module_id);
+    if (!stats)
+        return FWK_E_PARAM;
+
+    if (stats->mode != STATS_INITIALIZED)
+        return FWK_E_SUPPORT;
+
+    update_all_domains_current_level(module_id);
+
+    if (stats_ctx.config->snapshot_mode)
+        stats_publish();
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_stats_api mod_stats_api = {
+    .init_stats = stats_init_module,
+    .start_stats = stats_start_module,
+    .add_domain = stats_add_domain,
+    .add_domain_latency = stats_add_domain_latency,
+    .update_domain = stats_update_domain,
+    .update_domain_latency = stats_update_domain_latency,
+    .get_statistics_desc = get_statistics_desc,
+    .refresh_stats = stats_refresh,
+};
+
+/*
+ * Metrics catalog
+ */
+
+static int catalog_init(void)
+{
+    struct mod_stats_catalog_header *catalog;
+    uint32_t size;
+
+    size = sizeof(struct mod_stats_catalog_header);
+    size += stats_ctx.config->metric_count_max * sizeof(uint32_t);
+
+    if (size > (stats_ctx.config->stats_region_size -
+        stats_ctx.avail_mem_offset)) {
+        FWK_LOG_ERR("[STATS]: Error, size of statistics region too small\n");
+        return FWK_E_NOMEM;
+    }
+
+    catalog = (struct mod_stats_catalog_header *)
+              (stats_ctx.region_base + stats_ctx.avail_mem_offset);
+    catalog->signature = STATS_SIGN_MTRC;
+    catalog->revision = STATS_CATALOG_REVISION;
+
+    stats_ctx.catalog = catalog;
+    stats_ctx.catalog_offset = stats_ctx.avail_mem_offset;
+    stats_ctx.catalog_size = size;
+    stats_ctx.avail_mem_offset += size;
+
+    stats_ctx.metric_table = fwk_mm_calloc(
+        stats_ctx.config->metric_count_max, sizeof(struct mod_stats_metric *));
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_stats_metric *get_metric(unsigned int metric_idx,
+    enum mod_stats_metric_type type)
+{
+    struct mod_stats_metric *metric;
+
+    if ((stats_ctx.catalog == NULL) ||
+        (metric_idx >= stats_ctx.catalog->metric_count))
+        return NULL;
+
+    metric = stats_ctx.metric_table[metric_idx];
+    if (metric->type != type)
+        return NULL;
+
+    return metric;
+}
+
+static int metrics_add_metric(fwk_id_t owner_id,
+    const struct mod_stats_metric_info *info,
+    unsigned int *metric_idx)
+{
+    struct mod_stats_catalog_header *catalog = stats_ctx.catalog;
+    struct mod_stats_metric *metric;
+    unsigned int bucket_count = 0;
+    unsigned int idx;
+    uint32_t offset;
+    uint32_t size;
+
+    if (catalog == NULL)
+        return FWK_E_SUPPORT;
+
+    if ((info == NULL) || (info->name == NULL) || (metric_idx == NULL))
+        return FWK_E_PARAM;
+
+    switch (info->type) {
+    case MOD_STATS_METRIC_COUNTER:
+    case MOD_STATS_METRIC_GAUGE:
+        break;
+
+    case MOD_STATS_METRIC_HISTOGRAM:
+        if ((info->bucket_count == 0) || (info->bucket_count > UINT16_MAX) ||
+            (info->bucket_width == 0))
+            return FWK_E_PARAM;
+        bucket_count = info->bucket_count;
+        break;
+
+    default:
+        return FWK_E_PARAM;
+    }
+
+    idx = catalog->metric_count;
+    if (idx >= stats_ctx.config->metric_count_max)
+        return FWK_E_NOMEM;
+
+    /* Keep the 64-bit fields of the metric naturally aligned */
+    offset = FWK_ALIGN_NEXT(stats_ctx.avail_mem_offset, sizeof(uint64_t));
+    size = sizeof(struct mod_stats_metric);
+    size += bucket_count * sizeof(uint64_t);
+
+    if ((offset > stats_ctx.config->stats_region_size) ||
+        (size > (stats_ctx.config->stats_region_size - offset))) {
+        FWK_LOG_ERR("[STATS]: Error, size of statistics region too small\n");
+        return FWK_E_NOMEM;
+    }
+
+    /* The region is zeroed at initialization */
+    metric = (struct mod_stats_metric *)(stats_ctx.region_base + offset);
+    strncpy(metric->name, info->name, sizeof(metric->name) - 1);
+    metric->owner = owner_id.value;
+    metric->type = (uint16_t)info->type;
+    metric->bucket_count = (uint16_t)bucket_count;
+    metric->bucket_base = info->bucket_base;
+    metric->bucket_width = info->bucket_width;
+
+    stats_ctx.avail_mem_offset = offset + size;
+    stats_ctx.catalog_size = stats_ctx.avail_mem_offset -
+                             stats_ctx.catalog_offset;
+    stats_ctx.metric_table[idx] = metric;
+
+    stats_write_begin(&catalog->sequence);
+    catalog->metric_offset[idx] = offset - stats_ctx.catalog_offset;
+    catalog->metric_count = idx + 1;
+    stats_write_end(&catalog->sequence);
+
+    *metric_idx = idx;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Telemetry offload ring
+ */
 
-        fwk_interrupt_global_enable();
+static int offload_init(void)
+{
+    volatile struct mod_stats_offload_header *header;
+    uint32_t slot_count;
+
+    if (stats_ctx.config->offload_ring_size <
+        (sizeof(*header) + sizeof(struct mod_stats_offload_sample))) {
+        FWK_LOG_ERR("[STATS]: Error, telemetry offload ring too small\n");
+        return FWK_E_NOMEM;
     }
 
+    slot_count = (stats_ctx.config->offload_ring_size - sizeof(*header)) /
+        sizeof(struct mod_stats_offload_sample);
+    slot_count = UINT32_C(1) << fwk_math_log2(slot_count);
+
+    header = (volatile struct mod_stats_offload_header *)
+                 stats_ctx.config->offload_ring_addr;
+    header->sequence = 0;
+    header->slot_count = slot_count;
+    header->reserved = 0;
+
+    /* The signature tells the reader the ring is ready */
+    __DMB();
+    header->signature = MOD_STATS_OFFLOAD_SIGNATURE;
+    fwk_cache_clean((const void *)header, sizeof(*header));
+
+    stats_ctx.offload_header = header;
+    stats_ctx.offload_ring =
+        (volatile struct mod_stats_offload_sample *)(header + 1);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Write a raw sample to the telemetry offload ring. Like the other updates of
+ * the metrics, the samples are only written from the framework thread.
+ */
+static void offload_push(unsigned int metric_idx,
+    enum mod_stats_metric_type type,
+    uint64_t value)
+{
+    volatile struct mod_stats_offload_sample *sample;
+    uint32_t mask = stats_ctx.offload_header->slot_count - 1;
+
+    sample = &stats_ctx.offload_ring[stats_ctx.offload_sequence & mask];
+    sample->metric_idx = (uint16_t)metric_idx;
+    sample->type = (uint16_t)type;
+    sample->reserved = 0;
+    sample->value = value;
+    fwk_cache_clean((const void *)sample, sizeof(*sample));
+
+    stats_ctx.offload_sequence++;
+
+    /* The sample must be visible before the new sequence number */
+    __DMB();
+
+    stats_ctx.offload_header->sequence = stats_ctx.offload_sequence;
+    fwk_cache_clean(
+        (const void *)stats_ctx.offload_header,
+        sizeof(*stats_ctx.offload_header));
+}
+
+static int metrics_counter_add(unsigned int metric_idx, uint64_t increment)
+{
+    struct mod_stats_metric *metric;
+
+    metric = get_metric(metric_idx, MOD_STATS_METRIC_COUNTER);
+    if (metric == NULL)
+        return FWK_E_PARAM;
+
+    if (stats_ctx.offload_header != NULL) {
+        offload_push(metric_idx, MOD_STATS_METRIC_COUNTER, increment);
+        return FWK_SUCCESS;
+    }
+
+    stats_write_begin(&stats_ctx.catalog->sequence);
+    metric->value += increment;
+    stats_write_end(&stats_ctx.catalog->sequence);
+
+    return FWK_SUCCESS;
+}
+
+static int metrics_gauge_set(unsigned int metric_idx, uint64_t value)
+{
+    struct mod_stats_metric *metric;
+
+    metric = get_metric(metric_idx, MOD_STATS_METRIC_GAUGE);
+    if (metric == NULL)
+        return FWK_E_PARAM;
+
+    if (stats_ctx.offload_header != NULL) {
+        offload_push(metric_idx, MOD_STATS_METRIC_GAUGE, value);
+        return FWK_SUCCESS;
+    }
+
+    stats_write_begin(&stats_ctx.catalog->sequence);
+    metric->value = value;
+    if (value > metric->max)
+        metric->max = value;
+    stats_write_end(&stats_ctx.catalog->sequence);
+
+    return FWK_SUCCESS;
+}
+
+static int metrics_histogram_record(unsigned int metric_idx, uint64_t value)
+{
+    struct mod_stats_metric *metric;
+    uint64_t bucket = 0;
+
+    metric = get_metric(metric_idx, MOD_STATS_METRIC_HISTOGRAM);
+    if (metric == NULL)
+        return FWK_E_PARAM;
+
+    if (stats_ctx.offload_header != NULL) {
+        offload_push(metric_idx, MOD_STATS_METRIC_HISTOGRAM, value);
+        return FWK_SUCCESS;
+    }
+
+    if (value > metric->bucket_base)
+        bucket = (value - metric->bucket_base) / metric->bucket_width;
+    if (bucket >= metric->bucket_count)
+        bucket = metric->bucket_count - 1;
+
+    stats_write_begin(&stats_ctx.catalog->sequence);
+    metric->value++;
+    metric->sum += value;
+    if (value > metric->max)
+        metric->max = value;
+    metric->bucket[bucket]++;
+    stats_write_end(&stats_ctx.catalog->sequence);
+
+    return FWK_SUCCESS;
+}
+
+static int metrics_get_catalog_desc(uint32_t *addr_low,
+    uint32_t *addr_high,
+    uint32_t *len)
+{
+    uint64_t ap_catalog_addr;
+
+    if (stats_ctx.catalog == NULL)
+        return FWK_E_SUPPORT;
+
+    ap_catalog_addr = stats_ctx.config->ap_stats_addr;
+    ap_catalog_addr += stats_ctx.catalog_offset;
+
+    *addr_low = (uint32_t)(ap_catalog_addr & ~0UL);
+    *addr_high = (uint32_t)(ap_catalog_addr >> 32);
+    *len = stats_ctx.catalog_size;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_stats_metrics_api mod_stats_metrics_api = {
+    .add_metric = metrics_add_metric,
+    .counter_add = metrics_counter_add,
+    .gauge_set = metrics_gauge_set,
+    .histogram_record = metrics_histogram_record,
+    .get_catalog_desc = metrics_get_catalog_desc,
+};
+
+/*
+ * The interrupt metrics summarize the statistics the framework keeps for each
+ * interrupt, when it keeps them.
+ */
+static int irq_metrics_add(void)
+{
+    fwk_duration_ns_t masked_max;
+    unsigned int i;
+    int status;
+
+    if ((stats_ctx.catalog == NULL) ||
+        (fwk_interrupt_get_masked_max(&masked_max) != FWK_SUCCESS))
+        return FWK_SUCCESS;
+
+    for (i = 0; i < STATS_IRQ_METRIC_COUNT; i++) {
+        status = metrics_add_metric(fwk_module_id_statistics,
+            &stats_irq_metric_info[i], &stats_ctx.irq_metric_idx[i]);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    stats_ctx.irq_metrics = true;
+
+    return FWK_SUCCESS;
+}
+
+static void irq_metrics_update(void)
+{
+    struct fwk_interrupt_stats stats;
+    fwk_duration_ns_t masked_max = 0;
+    fwk_duration_ns_t isr_max = 0;
+    uint64_t count = 0;
+    unsigned int interrupt;
+
+    if (!stats_ctx.irq_metrics)
+        return;
+
+    for (interrupt = 0;
+         fwk_interrupt_get_stats(interrupt, &stats) == FWK_SUCCESS;
+         interrupt++) {
+        count += stats.count;
+        isr_max = FWK_MAX(isr_max, stats.max);
+    }
+
+    fwk_interrupt_get_masked_max(&masked_max);
+
+    metrics_gauge_set(
+        stats_ctx.irq_metric_idx[STATS_IRQ_METRIC_COUNT_TOTAL], count);
+    metrics_gauge_set(
+        stats_ctx.irq_metric_idx[STATS_IRQ_METRIC_ISR_MAX], isr_max);
+    metrics_gauge_set(
+        stats_ctx.irq_metric_idx[STATS_IRQ_METRIC_MASKED_MAX], masked_max);
 }
 
 static void periodic_update_callback(uintptr_t param)
 {
-    /* Update current level stats in all tracked domains in the perf module */
-    update_all_domains_current_level(fwk_module_id_scmi_perf);
+    int status;
+    struct fwk_event event = {
+        .id = mod_stats_event_id_update,
+        .source_id = fwk_module_id_statistics,
+        .target_id = fwk_module_id_statistics,
+    };
+
+    /*
+     * The update is deferred to the framework thread, where all the other
+     * updates are made. Skip the period if the previous update is still
+     * queued.
+     */
+    if (stats_ctx.update_pending)
+        return;
 
-    /* Update current level stats in all tracked domains in the power module */
-    update_all_domains_current_level(fwk_module_id_scmi_power_domain);
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_SUCCESS)
+        stats_ctx.update_pending = true;
 }
 
 static int register_module_stats(fwk_id_t module_id)
@@ -470,6 +1118,7 @@ static int stats_init(fwk_id_t module_id, unsigned int element_count,
     const void *data)
 {
     const struct mod_stats_config_info *config = data;
+    int status;
 
     if (config == NULL || config->stats_region_size == 0) {
         FWK_LOG_INFO("STATS: statistics are not configured\n");
@@ -483,10 +1132,28 @@ static int stats_init(fwk_id_t module_id, unsigned int element_count,
 
     /* Make sure that there is no stale data */
     memset((void *)config->scp_stats_addr, 0, config->stats_region_size);
+    fwk_cache_clean(
+        (const void *)config->scp_stats_addr, config->stats_region_size);
 
     stats_ctx.config = config;
     stats_ctx.avail_mem_offset = 0;
 
+    if (config->snapshot_mode) {
+        stats_ctx.region_base =
+            (uintptr_t)fwk_mm_calloc(1, config->stats_region_size);
+    } else
+        stats_ctx.region_base = config->scp_stats_addr;
+
+    if (config->metric_count_max == 0)
+        return FWK_SUCCESS;
+
+    status = catalog_init();
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (config->offload_ring_addr != 0)
+        return offload_init();
+
     return FWK_SUCCESS;
 }
 
@@ -499,25 +1166,29 @@ static int stats_element_init(fwk_id_t domain_id,
 
 static int stats_post_init(fwk_id_t module_id)
 {
-    return FWK_SUCCESS;
+    return irq_metrics_add();
 }
 
 static int stats_start(fwk_id_t id)
 {
     int status;
 
-    if (!fwk_id_is_equal(stats_ctx.config->alarm_id, FWK_ID_NONE)) {
-        status = stats_ctx.alarm_api->start(stats_ctx.config->alarm_id,
-            STATS_UPDATE_PERIOD_MS, MOD_TIMER_ALARM_TYPE_PERIODIC,
-            periodic_update_callback, (uintptr_t)0);
-
-        if (status != FWK_SUCCESS)
-            return status;
-    } else {
-        FWK_LOG_ERR("[STATS]: failed to start period updates\n");
-        return FWK_E_SUPPORT;
+    /*
+     * Without an alarm the residencies are only brought up to date on level
+     * changes and on explicit refreshes, the residency of the current level
+     * of a domain excluding the time since its 'ts_last_change_us'.
+     */
+    if (fwk_id_is_equal(stats_ctx.config->alarm_id, FWK_ID_NONE)) {
+        FWK_LOG_INFO("[STATS]: no periodic updates\n");
+        return FWK_SUCCESS;
     }
 
+    status = stats_ctx.alarm_api->start(stats_ctx.config->alarm_id,
+        STATS_UPDATE_PERIOD_MS, MOD_TIMER_ALARM_TYPE_PERIODIC,
+        periodic_update_callback, (uintptr_t)0);
+    if (status != FWK_SUCCESS)
+        return status;
+
     return FWK_SUCCESS;
 }
 
@@ -547,6 +1218,12 @@ static int process_bind_request(fwk_id_t source_id,
     if (!fwk_id_is_equal(target_id, fwk_module_id_statistics))
         return FWK_E_PARAM;
 
+    /* Any module may publish metrics */
+    if (fwk_id_is_equal(api_id, mod_stats_api_id_metrics)) {
+        *api = &mod_stats_metrics_api;
+        return FWK_SUCCESS;
+    }
+
     *api = &mod_stats_api;
 
     /* Request from SCMI Performance domain statistics */
@@ -559,9 +1236,38 @@ static int process_bind_request(fwk_id_t source_id,
         fwk_id_get_module_idx(fwk_module_id_scmi_power_domain))
         return register_module_stats(fwk_module_id_scmi_power_domain);
 
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
+    /* Request from Power domain statistics */
+    if (fwk_id_get_module_idx(source_id) ==
+        fwk_id_get_module_idx(fwk_module_id_power_domain))
+        return register_module_stats(fwk_module_id_power_domain);
+#endif
+
     return FWK_E_PARAM;
 }
 
+static int stats_process_event(const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    if (!fwk_id_is_equal(event->id, mod_stats_event_id_update))
+        return FWK_E_PARAM;
+
+    stats_ctx.update_pending = false;
+
+    /* Update current level stats in all tracked domains in the perf module */
+    update_all_domains_current_level(fwk_module_id_scmi_perf);
+
+    /* Update current level stats in all tracked domains in the power module */
+    update_all_domains_current_level(fwk_module_id_scmi_power_domain);
+
+    irq_metrics_update();
+
+    if (stats_ctx.config->snapshot_mode)
+        stats_publish();
+
+    return FWK_SUCCESS;
+}
+
 const struct fwk_module module_statistics = {
     .name = "STATS",
     .type = FWK_MODULE_TYPE_SERVICE,
@@ -571,5 +1277,7 @@ const struct fwk_module module_statistics = {
     .start = stats_start,
     .bind = stats_bind,
     .process_bind_request = process_bind_request,
+    .process_event = stats_process_event,
     .api_count = MOD_STATS_API_IDX_COUNT,
+    .event_count = MOD_STATS_EVENT_IDX_COUNT,
 };
@@ -0,0 +1,167 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MOD_STATS_AGGREGATOR_H
+#define MOD_STATS_AGGREGATOR_H
+
+#include <mod_stats.h>
+
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupStatsAggregator Statistics Aggregator
+ *
+ * \brief Aggregation of the metrics offloaded by another processor.
+ *
+ * \details The module reads the raw samples the statistics module of another
+ *      processor writes to its telemetry offload ring, see
+ *      ::mod_stats_offload_header, and aggregates them. Typically, the SCP
+ *      offloads its metrics and the MCP aggregates them, which keeps the
+ *      aggregation off the critical path of the SCP.
+ *
+ *      The ring is drained periodically when an alarm is configured, and
+ *      whenever the aggregates are read. The samples overwritten in the ring
+ *      before they were drained are counted as lost.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Number of buckets of the histogram of a metric.
+ *
+ * \details Bucket 0 holds the samples of value 0, and bucket i the samples
+ *      from 2^(i - 1) included to 2^i excluded. The last bucket also holds the
+ *      samples above its range.
+ */
+#define MOD_STATS_AGGREGATOR_BUCKET_COUNT 32
+
+/*!
+ * \brief Aggregate of the samples of a metric.
+ */
+struct mod_stats_aggregator_metric {
+    /*! Type of the metric, valid once a sample has been aggregated */
+    enum mod_stats_metric_type type;
+
+    /*! Number of samples aggregated */
+    uint64_t count;
+
+    /*! Sum of the samples, the total of a counter */
+    uint64_t sum;
+
+    /*! Lowest sample */
+    uint64_t min;
+
+    /*! Highest sample */
+    uint64_t max;
+
+    /*! Last sample, the current value of a gauge */
+    uint64_t last;
+
+    /*! Number of samples in each bucket of a histogram */
+    uint32_t bucket[MOD_STATS_AGGREGATOR_BUCKET_COUNT];
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_stats_aggregator_config {
+    /*!
+     * \brief Address of the telemetry offload ring, as seen by this
+     *      processor.
+     */
+    uintptr_t ring_addr;
+
+    /*!
+     * \brief Number of metrics aggregated. The samples of the metrics with a
+     *      higher index are counted as lost.
+     */
+    unsigned int metric_count;
+
+    /*!
+     * \brief Identifier of the alarm used to drain the ring, or
+     *      ::FWK_ID_NONE to only drain it when the aggregates are read.
+     *
+     * \note The alarm is only used when the firmware includes the timer
+     *      module.
+     */
+    fwk_id_t alarm_id;
+
+    /*! Period of the drains in milliseconds */
+    uint32_t period_ms;
+};
+
+/*!
+ * \brief Aggregates API.
+ */
+struct mod_stats_aggregator_api {
+    /*!
+     * \brief Get the aggregate of the samples of a metric.
+     *
+     * \param metric_idx Index of the metric in the catalog of the processor
+     *      offloading it.
+     * \param[out] metric Aggregate of the samples of the metric.
+     *
+     * \retval ::FWK_SUCCESS The aggregate was returned.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     */
+    int (*get_metric)(
+        unsigned int metric_idx,
+        struct mod_stats_aggregator_metric *metric);
+
+    /*!
+     * \brief Get the number of samples lost since the last reset.
+     *
+     * \param[out] count Number of samples lost.
+     *
+     * \retval ::FWK_SUCCESS The count was returned.
+     * \retval ::FWK_E_PARAM The `count` parameter was a null pointer value.
+     */
+    int (*get_lost_count)(uint64_t *count);
+
+    /*!
+     * \brief Clear the aggregates and the count of lost samples.
+     *
+     * \details The samples in the ring are dropped.
+     *
+     * \retval ::FWK_SUCCESS The aggregates were cleared.
+     */
+    int (*reset)(void);
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_stats_aggregator_api_idx {
+    /*! Aggregates API */
+    MOD_STATS_AGGREGATOR_API_IDX_AGGREGATES,
+
+    /*! Number of defined APIs */
+    MOD_STATS_AGGREGATOR_API_IDX_COUNT
+};
+
+/*! Aggregates API identifier */
+static const fwk_id_t mod_stats_aggregator_api_id_aggregates = FWK_ID_API_INIT(
+    FWK_MODULE_IDX_STATS_AGGREGATOR,
+    MOD_STATS_AGGREGATOR_API_IDX_AGGREGATES);
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_STATS_AGGREGATOR_H */
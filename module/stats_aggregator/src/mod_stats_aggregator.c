@@ -0,0 +1,364 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Aggregation of the metrics offloaded by another processor.
+ */
+
+#include <mod_stats.h>
+#include <mod_stats_aggregator.h>
+
+#include <fwk_cache.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_math.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+
+#include <fmw_cmsis.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef BUILD_HAS_MOD_TIMER
+#    include <mod_timer.h>
+
+enum stats_aggregator_event_idx {
+    STATS_AGGREGATOR_EVENT_IDX_DRAIN,
+    STATS_AGGREGATOR_EVENT_IDX_COUNT,
+};
+
+static const fwk_id_t stats_aggregator_event_id_drain = FWK_ID_EVENT_INIT(
+    FWK_MODULE_IDX_STATS_AGGREGATOR,
+    STATS_AGGREGATOR_EVENT_IDX_DRAIN);
+#endif
+
+struct stats_aggregator_ctx {
+    /* Module configuration */
+    const struct mod_stats_aggregator_config *config;
+
+    /* Header of the telemetry offload ring */
+    volatile struct mod_stats_offload_header *header;
+
+    /* Sample slots of the telemetry offload ring */
+    volatile struct mod_stats_offload_sample *ring;
+
+    /* Sequence number of the next sample to aggregate */
+    uint32_t sequence;
+
+    /* The samples in the ring are to be dropped at the next drain */
+    bool drop_pending;
+
+    /* Number of samples lost */
+    uint64_t lost_count;
+
+    /* Table of the aggregates, indexed by metric */
+    struct mod_stats_aggregator_metric *metric_table;
+
+#ifdef BUILD_HAS_MOD_TIMER
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* A drain event has been queued and not yet processed */
+    volatile bool drain_pending;
+#endif
+};
+
+static struct stats_aggregator_ctx stats_aggregator_ctx;
+
+/*
+ * Static helpers
+ */
+
+static unsigned int get_bucket(uint64_t value)
+{
+    unsigned int bucket;
+
+    if (value == 0)
+        return 0;
+
+    bucket = (unsigned int)fwk_math_log2(value) + 1;
+
+    return FWK_MIN(bucket, MOD_STATS_AGGREGATOR_BUCKET_COUNT - 1U);
+}
+
+static void aggregate(const struct mod_stats_offload_sample *sample)
+{
+    struct mod_stats_aggregator_metric *metric;
+
+    if (sample->metric_idx >= stats_aggregator_ctx.config->metric_count) {
+        stats_aggregator_ctx.lost_count++;
+        return;
+    }
+
+    metric = &stats_aggregator_ctx.metric_table[sample->metric_idx];
+
+    if ((metric->count == 0) || (sample->value < metric->min))
+        metric->min = sample->value;
+    if (sample->value > metric->max)
+        metric->max = sample->value;
+
+    metric->type = (enum mod_stats_metric_type)sample->type;
+    metric->count++;
+    metric->sum += sample->value;
+    metric->last = sample->value;
+
+    if (metric->type == MOD_STATS_METRIC_HISTOGRAM)
+        metric->bucket[get_bucket(sample->value)]++;
+}
+
+static uint32_t read_sequence(void)
+{
+    fwk_cache_invalidate(
+        stats_aggregator_ctx.header, sizeof(*stats_aggregator_ctx.header));
+
+    return stats_aggregator_ctx.header->sequence;
+}
+
+/*
+ * Aggregate the samples written to the ring since the last drain. Each sample
+ * is only aggregated if the sequence number read after copying it shows the
+ * writer has not overwritten it in the meantime.
+ */
+static void drain(void)
+{
+    volatile struct mod_stats_offload_header *header =
+        stats_aggregator_ctx.header;
+    volatile struct mod_stats_offload_sample *slot;
+    struct mod_stats_offload_sample sample;
+    uint32_t slot_count;
+    uint32_t sequence;
+    uint32_t mask;
+
+    sequence = read_sequence();
+    if (header->signature != MOD_STATS_OFFLOAD_SIGNATURE)
+        return;
+
+    slot_count = header->slot_count;
+    mask = slot_count - 1;
+
+    if (stats_aggregator_ctx.drop_pending) {
+        stats_aggregator_ctx.sequence = sequence;
+        stats_aggregator_ctx.drop_pending = false;
+        return;
+    }
+
+    while (stats_aggregator_ctx.sequence != sequence) {
+        if ((sequence - stats_aggregator_ctx.sequence) > slot_count) {
+            stats_aggregator_ctx.lost_count +=
+                sequence - stats_aggregator_ctx.sequence - slot_count;
+            stats_aggregator_ctx.sequence = sequence - slot_count;
+        }
+
+        slot = &stats_aggregator_ctx.ring[stats_aggregator_ctx.sequence & mask];
+        fwk_cache_invalidate(slot, sizeof(*slot));
+        sample = *slot;
+
+        /* The sample must be copied before the sequence number is read */
+        __DMB();
+
+        sequence = read_sequence();
+        if ((sequence - stats_aggregator_ctx.sequence) > slot_count)
+            continue;
+
+        aggregate(&sample);
+        stats_aggregator_ctx.sequence++;
+    }
+}
+
+/*
+ * Aggregates API
+ */
+
+static int stats_aggregator_get_metric(
+    unsigned int metric_idx,
+    struct mod_stats_aggregator_metric *metric)
+{
+    if ((metric == NULL) ||
+        (metric_idx >= stats_aggregator_ctx.config->metric_count))
+        return FWK_E_PARAM;
+
+    drain();
+
+    *metric = stats_aggregator_ctx.metric_table[metric_idx];
+
+    return FWK_SUCCESS;
+}
+
+static int stats_aggregator_get_lost_count(uint64_t *count)
+{
+    if (count == NULL)
+        return FWK_E_PARAM;
+
+    drain();
+
+    *count = stats_aggregator_ctx.lost_count;
+
+    return FWK_SUCCESS;
+}
+
+static int stats_aggregator_reset(void)
+{
+    memset(
+        stats_aggregator_ctx.metric_table,
+        0,
+        stats_aggregator_ctx.config->metric_count *
+            sizeof(struct mod_stats_aggregator_metric));
+
+    stats_aggregator_ctx.lost_count = 0;
+    stats_aggregator_ctx.drop_pending = true;
+
+    drain();
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_stats_aggregator_api stats_aggregator_api = {
+    .get_metric = stats_aggregator_get_metric,
+    .get_lost_count = stats_aggregator_get_lost_count,
+    .reset = stats_aggregator_reset,
+};
+
+/*
+ * Periodic drain
+ */
+
+#ifdef BUILD_HAS_MOD_TIMER
+static void drain_alarm_callback(uintptr_t param)
+{
+    int status;
+    struct fwk_event event = {
+        .id = stats_aggregator_event_id_drain,
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_STATS_AGGREGATOR),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_STATS_AGGREGATOR),
+    };
+
+    /* Skip the period if the previous drain is still queued */
+    if (stats_aggregator_ctx.drain_pending)
+        return;
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_SUCCESS)
+        stats_aggregator_ctx.drain_pending = true;
+}
+#endif
+
+/*
+ * Framework handlers
+ */
+
+static int stats_aggregator_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    const struct mod_stats_aggregator_config *config = data;
+
+    if ((config == NULL) || (config->ring_addr == 0) ||
+        (config->metric_count == 0))
+        return FWK_E_PARAM;
+
+#ifdef BUILD_HAS_MOD_TIMER
+    if (!fwk_id_is_equal(config->alarm_id, FWK_ID_NONE) &&
+        (config->period_ms == 0))
+        return FWK_E_PARAM;
+#endif
+
+    stats_aggregator_ctx.config = config;
+    stats_aggregator_ctx.header =
+        (volatile struct mod_stats_offload_header *)config->ring_addr;
+    stats_aggregator_ctx.ring = (volatile struct mod_stats_offload_sample *)(
+        stats_aggregator_ctx.header + 1);
+    stats_aggregator_ctx.metric_table = fwk_mm_calloc(
+        config->metric_count, sizeof(struct mod_stats_aggregator_metric));
+
+    return FWK_SUCCESS;
+}
+
+static int stats_aggregator_bind(fwk_id_t id, unsigned int round)
+{
+#ifdef BUILD_HAS_MOD_TIMER
+    if ((round == 1) ||
+        fwk_id_is_equal(stats_aggregator_ctx.config->alarm_id, FWK_ID_NONE))
+        return FWK_SUCCESS;
+
+    return fwk_module_bind(
+        stats_aggregator_ctx.config->alarm_id,
+        MOD_TIMER_API_ID_ALARM,
+        &stats_aggregator_ctx.alarm_api);
+#else
+    return FWK_SUCCESS;
+#endif
+}
+
+static int stats_aggregator_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    if (!fwk_id_is_equal(api_id, mod_stats_aggregator_api_id_aggregates))
+        return FWK_E_PARAM;
+
+    *api = &stats_aggregator_api;
+
+    return FWK_SUCCESS;
+}
+
+static int stats_aggregator_start(fwk_id_t id)
+{
+    drain();
+
+#ifdef BUILD_HAS_MOD_TIMER
+    if (fwk_id_is_equal(stats_aggregator_ctx.config->alarm_id, FWK_ID_NONE))
+        return FWK_SUCCESS;
+
+    return stats_aggregator_ctx.alarm_api->start(
+        stats_aggregator_ctx.config->alarm_id,
+        stats_aggregator_ctx.config->period_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        drain_alarm_callback,
+        (uintptr_t)0);
+#else
+    return FWK_SUCCESS;
+#endif
+}
+
+#ifdef BUILD_HAS_MOD_TIMER
+static int stats_aggregator_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    if (!fwk_id_is_equal(event->id, stats_aggregator_event_id_drain))
+        return FWK_E_PARAM;
+
+    stats_aggregator_ctx.drain_pending = false;
+
+    drain();
+
+    return FWK_SUCCESS;
+}
+#endif
+
+const struct fwk_module module_stats_aggregator = {
+    .name = "Statistics Aggregator",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_STATS_AGGREGATOR_API_IDX_COUNT,
+    .init = stats_aggregator_init,
+    .bind = stats_aggregator_bind,
+    .process_bind_request = stats_aggregator_process_bind_request,
+    .start = stats_aggregator_start,
+#ifdef BUILD_HAS_MOD_TIMER
+    .event_count = STATS_AGGREGATOR_EVENT_IDX_COUNT,
+    .process_event = stats_aggregator_process_event,
+#endif
+};
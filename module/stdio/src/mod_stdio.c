@@ -124,6 +124,20 @@ static int mod_stdio_putc(const struct fwk_io_stream *stream, char ch)
     return FWK_SUCCESS;
 }
 
+static int mod_stdio_write(
+    const struct fwk_io_stream *stream,
+    const char *buffer,
+    size_t size)
+{
+    struct mod_stdio_element_ctx *ctx =
+        &mod_stdio_ctx.elements[fwk_id_get_element_idx(stream->id)];
+
+    if (fwrite(buffer, sizeof(char), size, ctx->stream) != size)
+        return FWK_E_OS;
+
+    return FWK_SUCCESS;
+}
+
 static int mod_stdio_close(const struct fwk_io_stream *stream)
 {
     int status = FWK_SUCCESS;
@@ -155,6 +169,7 @@ const struct fwk_module module_stdio = {
         .open = mod_stdio_open,
         .getch = mod_stdio_getc,
         .putch = mod_stdio_putc,
+        .write = mod_stdio_write,
         .close = mod_stdio_close,
     },
 };
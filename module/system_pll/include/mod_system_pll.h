@@ -9,9 +9,11 @@
 #define MOD_SYSTEM_PLL_H
 
 #include <fwk_element.h>
+#include <fwk_id.h>
 #include <fwk_macros.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /*!
@@ -82,6 +84,38 @@ struct mod_system_pll_dev_config {
      * event.
      */
     const bool defer_initialization;
+
+    /*!
+     * Table of the rates the PLL is commonly set to, such as the operating
+     * points of a DVFS domain. The programming words of these rates are
+     * computed during initialization rather than on every change of rate. May
+     * be NULL.
+     */
+    const uint64_t *rate_table;
+
+    /*! Number of entries in \ref rate_table. */
+    const size_t rate_count;
+
+    /*!
+     * Identifier of the clock HAL element of the PLL.
+     *
+     * \details If set, rate changes requested through the clock driver API
+     *      return ::FWK_PENDING once the PLL is programmed, and their
+     *      completion is signalled to the clock HAL through its driver
+     *      response API when the PLL lock interrupt fires. If left unset, the
+     *      driver waits for the PLL to lock.
+     *
+     * \note Only used if \ref status_reg is set.
+     */
+    const fwk_id_t clock_id;
+
+    /*!
+     * Interrupt raised while the PLL is locked, enabled only while the
+     * driver waits for the lock.
+     *
+     * \note Only used if \ref clock_id is set.
+     */
+    const unsigned int lock_irq;
 };
 
 /*!
@@ -10,11 +10,14 @@
 #include <mod_system_pll.h>
 
 #include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 #include <fwk_status.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -24,6 +27,21 @@ struct system_pll_dev_ctx {
     uint64_t current_rate;
     enum mod_clock_state current_state;
     const struct mod_system_pll_dev_config *config;
+
+    /* Half cycle periods of the rates of the configured rate table */
+    unsigned int *half_cycle_table;
+
+    /* Rate changes complete through the lock interrupt */
+    bool is_async;
+
+    /* The driver waits for the lock interrupt */
+    bool is_lock_pending;
+
+    /* Rate being locked on */
+    uint64_t pending_rate;
+
+    /* Clock HAL driver response API */
+    const struct mod_clock_driver_response_api *driver_response_api;
 };
 
 /* Module context */
@@ -80,25 +98,81 @@ static unsigned int freq_to_half_cycle_ps(unsigned int freq_hz)
 }
 
 /*
- * Clock driver API functions
+ * Get the half cycle period of a rate, from the table computed during
+ * initialization if the rate is one of the configured rates.
  */
+static unsigned int get_half_cycle_ps(
+    const struct system_pll_dev_ctx *ctx,
+    uint64_t rate)
+{
+    size_t i;
 
-static int system_pll_set_rate(fwk_id_t dev_id, uint64_t rate,
-                               enum mod_clock_round_mode round_mode)
+    for (i = 0; i < ctx->config->rate_count; i++) {
+        if (ctx->config->rate_table[i] == rate)
+            return ctx->half_cycle_table[i];
+    }
+
+    return freq_to_half_cycle_ps(rate);
+}
+
+static void wait_lock(const struct system_pll_dev_ctx *ctx)
+{
+    if (ctx->config->status_reg == NULL)
+        return;
+
+    /* Wait until the PLL has locked */
+    while ((*ctx->config->status_reg & ctx->config->lock_flag_mask) == 0)
+        continue;
+}
+
+static void lock_complete(struct system_pll_dev_ctx *ctx, int status)
+{
+    struct mod_clock_driver_resp_params response = {
+        .status = status,
+    };
+
+    ctx->is_lock_pending = false;
+
+    if (status == FWK_SUCCESS)
+        ctx->current_rate = ctx->pending_rate;
+
+    response.value.rate = ctx->current_rate;
+
+    ctx->driver_response_api->request_complete(ctx->config->clock_id,
+                                               &response);
+}
+
+static void lock_isr(uintptr_t param)
+{
+    struct system_pll_dev_ctx *ctx = (struct system_pll_dev_ctx *)param;
+
+    if ((*ctx->config->status_reg & ctx->config->lock_flag_mask) == 0)
+        return;
+
+    fwk_interrupt_disable(ctx->config->lock_irq);
+
+    if (ctx->is_lock_pending)
+        lock_complete(ctx, FWK_SUCCESS);
+}
+
+/*
+ * Program the PLL, returning the rate it is set to. The caller is in charge of
+ * waiting for the PLL to lock.
+ */
+static int program_rate(struct system_pll_dev_ctx *ctx, uint64_t rate,
+                        enum mod_clock_round_mode round_mode,
+                        uint64_t *programmed_rate)
 {
     uint64_t rounded_rate;
     uint64_t rounded_rate_alt;
     unsigned int picoseconds;
-    struct system_pll_dev_ctx *ctx;
-
-    if (!fwk_module_is_valid_element_id(dev_id))
-    return FWK_E_PARAM;
-
-    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
 
     if (ctx->current_state == MOD_CLOCK_STATE_STOPPED)
         return FWK_E_PWRSTATE;
 
+    if (ctx->is_lock_pending)
+        return FWK_E_BUSY;
+
     /* If the given rate is not attainable as-is then round as requested */
     if ((rate % ctx->config->min_step) > 0) {
         switch (round_mode) {
@@ -129,24 +203,74 @@ static int system_pll_set_rate(fwk_id_t dev_id, uint64_t rate,
     if (rounded_rate > ctx->config->max_rate)
         return FWK_E_RANGE;
 
-    picoseconds = freq_to_half_cycle_ps(rounded_rate);
+    picoseconds = get_half_cycle_ps(ctx, rounded_rate);
 
     if (picoseconds == 0)
         return FWK_E_RANGE;
 
     *ctx->config->control_reg = picoseconds;
+    *programmed_rate = rounded_rate;
 
-    if (ctx->config->status_reg != NULL) {
-        /* Wait until the PLL has locked */
-        while ((*ctx->config->status_reg & ctx->config->lock_flag_mask) == 0)
-            continue;
-    }
+    return FWK_SUCCESS;
+}
+
+/*
+ * Set the rate of the PLL and wait for it to lock, as needed while the PLL is
+ * being initialized or powered on.
+ */
+static int set_rate_sync(struct system_pll_dev_ctx *ctx, uint64_t rate)
+{
+    int status;
+    uint64_t programmed_rate;
+
+    status = program_rate(ctx, rate, MOD_CLOCK_ROUND_MODE_NONE,
+                          &programmed_rate);
+    if (status != FWK_SUCCESS)
+        return status;
 
-    ctx->current_rate = rounded_rate;
+    wait_lock(ctx);
+    ctx->current_rate = programmed_rate;
 
     return FWK_SUCCESS;
 }
 
+/*
+ * Clock driver API functions
+ */
+
+static int system_pll_set_rate(fwk_id_t dev_id, uint64_t rate,
+                               enum mod_clock_round_mode round_mode)
+{
+    int status;
+    uint64_t programmed_rate;
+    struct system_pll_dev_ctx *ctx;
+
+    if (!fwk_module_is_valid_element_id(dev_id))
+    return FWK_E_PARAM;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
+
+    status = program_rate(ctx, rate, round_mode, &programmed_rate);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (!ctx->is_async) {
+        wait_lock(ctx);
+        ctx->current_rate = programmed_rate;
+
+        return FWK_SUCCESS;
+    }
+
+    /* The lock interrupt completes the request */
+    ctx->pending_rate = programmed_rate;
+    ctx->is_lock_pending = true;
+
+    fwk_interrupt_clear_pending(ctx->config->lock_irq);
+    fwk_interrupt_enable(ctx->config->lock_irq);
+
+    return FWK_PENDING;
+}
+
 static int system_pll_get_rate(fwk_id_t dev_id, uint64_t *rate)
 {
     struct system_pll_dev_ctx *ctx;
@@ -236,7 +360,7 @@ static int system_pll_power_state_change(
         rate = ctx->config->initial_rate;
     }
 
-    return system_pll_set_rate(dev_id, rate, MOD_CLOCK_ROUND_MODE_NONE);
+    return set_rate_sync(ctx, rate);
 }
 
 static int system_pll_power_state_pending_change(
@@ -251,6 +375,12 @@ static int system_pll_power_state_pending_change(
     if (next_state == MOD_PD_STATE_OFF) {
         /* Just mark the PLL as stopped */
         ctx->current_state = MOD_CLOCK_STATE_STOPPED;
+
+        /* The PLL will not lock, fail the pending rate change */
+        if (ctx->is_lock_pending) {
+            fwk_interrupt_disable(ctx->config->lock_irq);
+            lock_complete(ctx, FWK_E_PWRSTATE);
+        }
     }
 
     return FWK_SUCCESS;
@@ -287,6 +417,7 @@ static int system_pll_init(fwk_id_t module_id, unsigned int element_count,
 static int system_pll_element_init(fwk_id_t element_id, unsigned int unused,
                                   const void *data)
 {
+    size_t i;
     struct system_pll_dev_ctx *ctx;
     const struct mod_system_pll_dev_config *dev_config = data;
 
@@ -297,13 +428,65 @@ static int system_pll_element_init(fwk_id_t element_id, unsigned int unused,
 
     ctx->config = dev_config;
 
+    if (ctx->config->rate_count != 0) {
+        if (ctx->config->rate_table == NULL)
+            return FWK_E_PARAM;
+
+        ctx->half_cycle_table = fwk_mm_calloc(ctx->config->rate_count,
+                                              sizeof(unsigned int));
+
+        for (i = 0; i < ctx->config->rate_count; i++) {
+            ctx->half_cycle_table[i] =
+                freq_to_half_cycle_ps(ctx->config->rate_table[i]);
+        }
+    }
+
+    ctx->is_async = (ctx->config->status_reg != NULL) &&
+        fwk_id_is_type(ctx->config->clock_id, FWK_ID_TYPE_ELEMENT);
+
     if (ctx->config->defer_initialization)
         return FWK_SUCCESS;
 
     ctx->initialized = true;
     ctx->current_state = MOD_CLOCK_STATE_RUNNING;
-    return system_pll_set_rate(element_id, ctx->config->initial_rate,
-                                MOD_CLOCK_ROUND_MODE_NONE);
+    return set_rate_sync(ctx, ctx->config->initial_rate);
+}
+
+static int system_pll_bind(fwk_id_t id, unsigned int round)
+{
+    struct system_pll_dev_ctx *ctx;
+
+    if ((round != 0) || !fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(id);
+
+    if (!ctx->is_async)
+        return FWK_SUCCESS;
+
+    return fwk_module_bind(ctx->config->clock_id,
+                           FWK_ID_API(FWK_MODULE_IDX_CLOCK,
+                                      MOD_CLOCK_API_TYPE_DRIVER_RESPONSE),
+                           &ctx->driver_response_api);
+}
+
+static int system_pll_start(fwk_id_t id)
+{
+    struct system_pll_dev_ctx *ctx;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(id);
+
+    if (!ctx->is_async)
+        return FWK_SUCCESS;
+
+    /* The interrupt is only enabled while a rate change waits for the lock */
+    fwk_interrupt_disable(ctx->config->lock_irq);
+
+    return fwk_interrupt_set_isr_param(ctx->config->lock_irq, lock_isr,
+                                       (uintptr_t)ctx);
 }
 
 static int system_pll_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
@@ -320,5 +503,7 @@ const struct fwk_module module_system_pll = {
     .event_count = 0,
     .init = system_pll_init,
     .element_init = system_pll_element_init,
+    .bind = system_pll_bind,
+    .start = system_pll_start,
     .process_bind_request = system_pll_process_bind_request,
 };
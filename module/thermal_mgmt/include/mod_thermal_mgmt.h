@@ -0,0 +1,130 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Thermal power allocator.
+ */
+
+#ifndef MOD_THERMAL_MGMT_H
+#define MOD_THERMAL_MGMT_H
+
+#include <fwk_id.h>
+
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupThermalMgmt Thermal Power Allocator
+ *
+ * \brief Thermal power allocator.
+ *
+ * \details Each element is a thermal zone made of a temperature sensor and of
+ *      the DVFS domains heating it, called actors. Every period, a PID
+ *      controller turns the distance between the zone temperature and its
+ *      control temperature into a power budget. The budget is shared between
+ *      the actors in proportion to their weighted power demand, and each
+ *      actor is limited to the highest level fitting in its share through
+ *      the DVFS level limits.
+ *
+ *      The power of an operating point is its \c power field when set, and
+ *      is otherwise derived from its voltage and frequency using the dynamic
+ *      power coefficient of the actor.
+ *
+ * \note The maximum level limit of the actors is owned by the allocator while
+ *      the zone is above its switch-on temperature. The minimum level limit
+ *      set by the agents is preserved.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Actor configuration.
+ */
+struct mod_thermal_mgmt_actor_config {
+    /*! Identifier of the element of the DVFS module */
+    fwk_id_t dvfs_domain_id;
+
+    /*! Weight of the actor demand when the budget is shared */
+    unsigned int weight;
+
+    /*!
+     * \brief Dynamic power coefficient in microwatts per MHz per volt squared.
+     *
+     * \details Only used for the operating points whose power is 0.
+     */
+    uint32_t power_coeff;
+};
+
+/*!
+ * \brief Thermal zone configuration.
+ */
+struct mod_thermal_mgmt_zone_config {
+    /*! Identifier of the temperature sensor, in millidegrees Celsius */
+    fwk_id_t sensor_id;
+
+    /*! Identifier of the alarm running the control loop */
+    fwk_id_t alarm_id;
+
+    /*! Control loop period in milliseconds */
+    unsigned int period_ms;
+
+    /*! Temperature the zone is regulated to, in millidegrees Celsius */
+    uint32_t control_temp_mdc;
+
+    /*!
+     * \brief Temperature under which the actors are not limited, in
+     *      millidegrees Celsius.
+     */
+    uint32_t switch_on_temp_mdc;
+
+    /*! Power the zone can dissipate at the control temperature, in mW */
+    uint32_t sustainable_power_mw;
+
+    /*!
+     * \brief Proportional gain below the control temperature.
+     *
+     * \details The gains are given in milliwatts per degree Celsius.
+     */
+    int32_t k_p_undershoot;
+
+    /*! Proportional gain above the control temperature */
+    int32_t k_p_overshoot;
+
+    /*! Integral gain */
+    int32_t k_i;
+
+    /*! Derivative gain, per period */
+    int32_t k_d;
+
+    /*!
+     * \brief Temperature error under which the error is integrated, in
+     *      millidegrees Celsius.
+     */
+    int32_t integral_cutoff_mdc;
+
+    /*! Bound of the integrated error, in millidegrees Celsius */
+    int32_t integral_max_mdc;
+
+    /*! Table of actors */
+    const struct mod_thermal_mgmt_actor_config *actors;
+
+    /*! Number of entries in \ref actors */
+    unsigned int actor_count;
+};
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_THERMAL_MGMT_H */
@@ -0,0 +1,469 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Thermal power allocator.
+ */
+
+#include <mod_dvfs.h>
+#include <mod_sensor.h>
+#include <mod_thermal_mgmt.h>
+#include <mod_timer.h>
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+enum mod_thermal_mgmt_event_idx {
+    MOD_THERMAL_MGMT_EVENT_IDX_CONTROL,
+    MOD_THERMAL_MGMT_EVENT_IDX_COUNT,
+};
+
+static const fwk_id_t mod_thermal_mgmt_event_id_control = FWK_ID_EVENT_INIT(
+    FWK_MODULE_IDX_THERMAL_MGMT,
+    MOD_THERMAL_MGMT_EVENT_IDX_CONTROL);
+
+struct thermal_actor_ctx {
+    /* Weighted power demand */
+    uint64_t demand;
+
+    /* Power at the highest operating point, in mW */
+    uint32_t max_power_mw;
+
+    /* Share of the power budget, in mW */
+    uint32_t granted_mw;
+};
+
+struct thermal_zone_ctx {
+    /* Zone configuration */
+    const struct mod_thermal_mgmt_zone_config *config;
+
+    /* Sensor API */
+    const struct mod_sensor_api *sensor_api;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Table of actor contexts */
+    struct thermal_actor_ctx *actor_ctx_table;
+
+    /* Integrated temperature error */
+    int32_t integral_mdc;
+
+    /* Temperature error of the previous period */
+    int32_t prev_error_mdc;
+
+    /* The actors are limited by the allocator */
+    bool limited;
+};
+
+static struct thermal_mgmt_ctx {
+    /* Table of zone contexts */
+    struct thermal_zone_ctx *zone_ctx_table;
+
+    /* DVFS API */
+    const struct mod_dvfs_domain_api *dvfs_api;
+} thermal_mgmt_ctx;
+
+/*
+ * Power model
+ */
+
+static uint32_t opp_power(
+    const struct mod_thermal_mgmt_actor_config *actor,
+    const struct mod_dvfs_opp *opp)
+{
+    uint64_t power;
+
+    if (opp->power != 0)
+        return opp->power;
+
+    /*
+     * mW = coeff (uW/MHz/V^2) * f (kHz) / 1000 * V (mV)^2 / 10^6 / 1000
+     */
+    power = (uint64_t)actor->power_coeff * opp->frequency *
+        ((uint64_t)opp->voltage * opp->voltage);
+
+    return (uint32_t)FWK_MIN(power / 1000000000000ULL, UINT32_MAX);
+}
+
+/*
+ * Highest level whose power fits in the given budget, or the lowest level if
+ * none does.
+ */
+static int actor_level_for_power(
+    const struct mod_thermal_mgmt_actor_config *actor,
+    uint32_t power_mw,
+    uint32_t *level)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = thermal_mgmt_ctx.dvfs_api;
+    struct mod_dvfs_opp opp;
+    size_t opp_count, idx;
+    int status;
+
+    status = dvfs_api->get_opp_count(actor->dvfs_domain_id, &opp_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (idx = 0; idx < opp_count; idx++) {
+        status = dvfs_api->get_nth_opp(actor->dvfs_domain_id, idx, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if ((idx != 0) && (opp_power(actor, &opp) > power_mw))
+            break;
+
+        *level = opp.level;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int actor_set_max_level(
+    const struct mod_thermal_mgmt_actor_config *actor,
+    uint32_t level)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = thermal_mgmt_ctx.dvfs_api;
+    struct mod_dvfs_level_limits limits;
+    int status;
+
+    status = dvfs_api->get_level_limits(actor->dvfs_domain_id, &limits);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Keep the minimum requested by the agents */
+    level = FWK_MAX(level, limits.minimum);
+    if (level == limits.maximum)
+        return FWK_SUCCESS;
+
+    limits.maximum = level;
+    status = dvfs_api->set_level_limits(actor->dvfs_domain_id, 0, &limits);
+
+    return (status == FWK_PENDING) ? FWK_SUCCESS : status;
+}
+
+/*
+ * Power budget distribution
+ */
+
+static int zone_release(struct thermal_zone_ctx *ctx)
+{
+    const struct mod_thermal_mgmt_actor_config *actor;
+    unsigned int idx;
+    uint32_t level;
+    int status;
+
+    for (idx = 0; idx < ctx->config->actor_count; idx++) {
+        actor = &ctx->config->actors[idx];
+
+        status = actor_level_for_power(actor, UINT32_MAX, &level);
+        if (status == FWK_SUCCESS)
+            status = actor_set_max_level(actor, level);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    ctx->limited = false;
+
+    return FWK_SUCCESS;
+}
+
+static int zone_update_demand(struct thermal_zone_ctx *ctx, uint64_t *total)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = thermal_mgmt_ctx.dvfs_api;
+    const struct mod_thermal_mgmt_actor_config *actor;
+    struct thermal_actor_ctx *actor_ctx;
+    struct mod_dvfs_opp opp;
+    size_t opp_count;
+    unsigned int idx;
+    int status;
+
+    *total = 0;
+
+    for (idx = 0; idx < ctx->config->actor_count; idx++) {
+        actor = &ctx->config->actors[idx];
+        actor_ctx = &ctx->actor_ctx_table[idx];
+
+        status = dvfs_api->get_opp_count(actor->dvfs_domain_id, &opp_count);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = dvfs_api->get_nth_opp(
+            actor->dvfs_domain_id, opp_count - 1, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        actor_ctx->max_power_mw = opp_power(actor, &opp);
+
+        /* An actor whose level is not known yet demands its maximum power */
+        status = dvfs_api->get_current_opp(actor->dvfs_domain_id, &opp);
+        if ((status != FWK_SUCCESS) && (status != FWK_PENDING))
+            return status;
+
+        actor_ctx->demand = (uint64_t)actor->weight *
+            ((status == FWK_SUCCESS) ? opp_power(actor, &opp) :
+                                       actor_ctx->max_power_mw);
+        *total += actor_ctx->demand;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int zone_allocate(struct thermal_zone_ctx *ctx, uint32_t budget_mw)
+{
+    const struct mod_thermal_mgmt_actor_config *actor;
+    struct thermal_actor_ctx *actor_ctx;
+    unsigned int count = ctx->config->actor_count;
+    uint64_t total_demand;
+    uint32_t surplus = 0, extra, level;
+    unsigned int idx;
+    int status;
+
+    status = zone_update_demand(ctx, &total_demand);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Share the budget in proportion to the demand */
+    for (idx = 0; idx < count; idx++) {
+        actor_ctx = &ctx->actor_ctx_table[idx];
+
+        if (total_demand != 0) {
+            actor_ctx->granted_mw =
+                (uint32_t)((budget_mw * actor_ctx->demand) / total_demand);
+        } else
+            actor_ctx->granted_mw = budget_mw / count;
+
+        if (actor_ctx->granted_mw > actor_ctx->max_power_mw) {
+            surplus += actor_ctx->granted_mw - actor_ctx->max_power_mw;
+            actor_ctx->granted_mw = actor_ctx->max_power_mw;
+        }
+    }
+
+    /* The power the saturated actors cannot use goes to the others */
+    for (idx = 0; (idx < count) && (surplus != 0); idx++) {
+        actor_ctx = &ctx->actor_ctx_table[idx];
+
+        extra = FWK_MIN(
+            actor_ctx->max_power_mw - actor_ctx->granted_mw, surplus);
+        actor_ctx->granted_mw += extra;
+        surplus -= extra;
+    }
+
+    for (idx = 0; idx < count; idx++) {
+        actor = &ctx->config->actors[idx];
+
+        status = actor_level_for_power(
+            actor, ctx->actor_ctx_table[idx].granted_mw, &level);
+        if (status == FWK_SUCCESS)
+            status = actor_set_max_level(actor, level);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    ctx->limited = true;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * PID controller
+ */
+
+static int zone_control(struct thermal_zone_ctx *ctx, uint64_t temperature)
+{
+    const struct mod_thermal_mgmt_zone_config *config = ctx->config;
+    int32_t error, k_p;
+    int64_t budget;
+
+    if (temperature < config->switch_on_temp_mdc) {
+        ctx->integral_mdc = 0;
+        ctx->prev_error_mdc = 0;
+
+        return ctx->limited ? zone_release(ctx) : FWK_SUCCESS;
+    }
+
+    error = (int32_t)config->control_temp_mdc -
+        (int32_t)FWK_MIN(temperature, (uint64_t)INT32_MAX);
+
+    k_p = (error < 0) ? config->k_p_overshoot : config->k_p_undershoot;
+
+    if (error < config->integral_cutoff_mdc) {
+        ctx->integral_mdc = FWK_MAX(
+            FWK_MIN(ctx->integral_mdc + error, config->integral_max_mdc),
+            -config->integral_max_mdc);
+    }
+
+    budget = (int64_t)config->sustainable_power_mw +
+        (((int64_t)k_p * error) / 1000) +
+        (((int64_t)config->k_i * ctx->integral_mdc) / 1000) +
+        (((int64_t)config->k_d * (error - ctx->prev_error_mdc)) / 1000);
+    ctx->prev_error_mdc = error;
+
+    budget = FWK_MAX(FWK_MIN(budget, (int64_t)UINT32_MAX), (int64_t)0);
+
+    return zone_allocate(ctx, (uint32_t)budget);
+}
+
+/*
+ * Periodical alarm callback
+ */
+
+static void thermal_mgmt_alarm_callback(uintptr_t param)
+{
+    int status;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_THERMAL_MGMT),
+        .target_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_THERMAL_MGMT, param),
+        .id = mod_thermal_mgmt_event_id_control,
+    };
+
+    status = fwk_thread_put_event(&event);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
+/*
+ * Framework handlers
+ */
+
+static int thermal_mgmt_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    thermal_mgmt_ctx.zone_ctx_table = fwk_mm_calloc(
+        element_count, sizeof(thermal_mgmt_ctx.zone_ctx_table[0]));
+
+    return FWK_SUCCESS;
+}
+
+static int thermal_mgmt_zone_init(
+    fwk_id_t zone_id,
+    unsigned int sub_element_count,
+    const void *data)
+{
+    const struct mod_thermal_mgmt_zone_config *config = data;
+    struct thermal_zone_ctx *ctx;
+
+    if ((config == NULL) || (config->period_ms == 0) ||
+        (config->actors == NULL) || (config->actor_count == 0) ||
+        (config->integral_max_mdc < 0))
+        return FWK_E_DATA;
+
+    ctx = &thermal_mgmt_ctx.zone_ctx_table[fwk_id_get_element_idx(zone_id)];
+    ctx->config = config;
+    ctx->actor_ctx_table =
+        fwk_mm_calloc(config->actor_count, sizeof(ctx->actor_ctx_table[0]));
+
+    return FWK_SUCCESS;
+}
+
+static int thermal_mgmt_bind(fwk_id_t id, unsigned int round)
+{
+    struct thermal_zone_ctx *ctx;
+    int status;
+
+    if (round > 0)
+        return FWK_SUCCESS;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        return fwk_module_bind(
+            FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+            mod_dvfs_api_id_dvfs,
+            &thermal_mgmt_ctx.dvfs_api);
+    }
+
+    ctx = &thermal_mgmt_ctx.zone_ctx_table[fwk_id_get_element_idx(id)];
+
+    status = fwk_module_bind(
+        ctx->config->alarm_id, MOD_TIMER_API_ID_ALARM, &ctx->alarm_api);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    status = fwk_module_bind(
+        ctx->config->sensor_id, mod_sensor_api_id_sensor, &ctx->sensor_api);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
+}
+
+static int thermal_mgmt_start(fwk_id_t id)
+{
+    struct thermal_zone_ctx *ctx;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+        return FWK_SUCCESS;
+
+    ctx = &thermal_mgmt_ctx.zone_ctx_table[fwk_id_get_element_idx(id)];
+
+    return ctx->alarm_api->start(
+        ctx->config->alarm_id,
+        ctx->config->period_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        thermal_mgmt_alarm_callback,
+        (uintptr_t)fwk_id_get_element_idx(id));
+}
+
+static int thermal_mgmt_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    const struct mod_sensor_event_params *params;
+    struct thermal_zone_ctx *ctx;
+    uint64_t temperature;
+    int status;
+
+    ctx = &thermal_mgmt_ctx.zone_ctx_table[fwk_id_get_element_idx(
+        event->target_id)];
+
+    if (fwk_id_is_equal(event->id, mod_thermal_mgmt_event_id_control)) {
+        /* Event from the alarm callback */
+        status =
+            ctx->sensor_api->get_value(ctx->config->sensor_id, &temperature);
+        if (status == FWK_PENDING)
+            return FWK_SUCCESS;
+    } else if (fwk_id_is_equal(event->id, mod_sensor_event_id_read_request)) {
+        /* Response event from the sensor HAL */
+        params = (const struct mod_sensor_event_params *)event->params;
+        status = params->status;
+        temperature = params->value;
+    } else
+        return FWK_E_PARAM;
+
+    if (status == FWK_SUCCESS)
+        status = zone_control(ctx, temperature);
+
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_WARN(
+            "[THERMAL] %s: control failed (%d)",
+            fwk_module_get_name(event->target_id),
+            status);
+    }
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_thermal_mgmt = {
+    .name = "Thermal power allocator",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .event_count = MOD_THERMAL_MGMT_EVENT_IDX_COUNT,
+    .init = thermal_mgmt_init,
+    .element_init = thermal_mgmt_zone_init,
+    .bind = thermal_mgmt_bind,
+    .start = thermal_mgmt_start,
+    .process_event = thermal_mgmt_process_event,
+};
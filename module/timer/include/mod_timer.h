@@ -13,6 +13,7 @@
 
 #include <fwk_id.h>
 #include <fwk_module_idx.h>
+#include <fwk_thread.h>
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -264,7 +265,8 @@ struct mod_timer_alarm_api {
      *     the new configuration.
      *
      * \warning \p callback will be called from within an interrupt service
-     *      routine.
+     *      routine, unless the alarm has been deferred, see
+     *      ::mod_timer_alarm_api::set_deferred.
      *
      * \param alarm_id Sub-element identifier of the alarm.
      * \param milliseconds The time delay, given in milliseconds, until the
@@ -307,8 +309,139 @@ struct mod_timer_alarm_api {
      * \retval ::FWK_E_INIT The component has not been initialized.
      */
     int (*stop)(fwk_id_t alarm_id);
+
+    /*!
+     * \brief Allow an alarm to trigger late to share a wake-up.
+     *
+     * \details The alarm may trigger up to \p microseconds after it is due,
+     *     together with other alarms due within that window, instead of
+     *     waking up the system on its own. The slack applies to the following
+     *     starts of the alarm as well. It is 0 by default.
+     *
+     * \param alarm_id Sub-element identifier of the alarm.
+     * \param microseconds Maximum delay of the alarm, in microseconds.
+     *
+     * \pre \p alarm_id must be a valid sub-element alarm identifier that has
+     *     previously been bound to.
+     *
+     * \retval ::FWK_SUCCESS The slack was set.
+     * \retval ::FWK_E_ACCESS The function was called from an interrupt handler
+     *      OR could not attain call context.
+     * \return One of the standard framework error codes.
+     */
+    int (*set_slack)(fwk_id_t alarm_id, unsigned int microseconds);
+
+    /*!
+     * \brief Run the callback of an alarm outside of interrupt context.
+     *
+     * \details The callback of a deferred alarm is run by the framework, as a
+     *     signal or an event targeting the timer, instead of by the timer
+     *     interrupt handler. This shortens the time spent in the handler when
+     *     the callback does more than posting an event, at the cost of the
+     *     latency of the framework queue. The callback is not run if the alarm
+     *     is stopped or started again in the meantime. This setting applies to
+     *     the following starts of the alarm as well. Alarms are not deferred
+     *     by default.
+     *
+     * \param alarm_id Sub-element identifier of the alarm.
+     * \param deferred Whether the callback is run outside of interrupt
+     *     context.
+     *
+     * \pre \p alarm_id must be a valid sub-element alarm identifier that has
+     *     previously been bound to.
+     *
+     * \retval ::FWK_SUCCESS The setting was applied.
+     * \retval ::FWK_E_ACCESS The function was called from an interrupt handler
+     *      OR could not attain call context.
+     * \return One of the standard framework error codes.
+     */
+    int (*set_deferred)(fwk_id_t alarm_id, bool deferred);
+
+    /*!
+     * \brief Get the periods a periodic alarm did not trigger for.
+     *
+     * \details A periodic alarm is scheduled from the time it was due, not
+     *     from the time it triggered. When it triggers more than a period late,
+     *     the periods that have fully elapsed are skipped and counted as
+     *     overruns.
+     *
+     * \note This function may be called from the alarm callback, in which case
+     *     \p missed gives the periods skipped before the current trigger.
+     *
+     * \param alarm_id Sub-element identifier of the alarm.
+     * \param[out] missed Periods skipped before the latest trigger. May be
+     *     NULL.
+     * \param[out] total Periods skipped since the alarm was started. May be
+     *     NULL.
+     *
+     * \pre \p alarm_id must be a valid sub-element alarm identifier that has
+     *     previously been bound to.
+     *
+     * \retval ::FWK_SUCCESS The overruns were returned.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_overruns)(fwk_id_t alarm_id,
+                        unsigned int *missed,
+                        unsigned int *total);
 };
 
+/*!
+ * \brief Low-power state the idle governor may choose from.
+ */
+struct mod_timer_idle_state {
+    /*! Time, in microseconds, taken to enter the state */
+    uint32_t entry_latency_us;
+
+    /*! Time, in microseconds, taken to leave the state on a wake-up */
+    uint32_t exit_latency_us;
+
+    /*!
+     * \brief Enter the state.
+     *
+     * \details Called with interrupts globally disabled. The function must
+     *      return once an interrupt is pending, as the \c WFI instruction does.
+     */
+    void (*enter)(void);
+};
+
+/*!
+ * \brief Idle governor configuration.
+ */
+struct mod_timer_idle_config {
+    /*! Element identifier of the timer device raising the alarms */
+    fwk_id_t timer_id;
+
+    /*!
+     * \brief Table of low-power states, ordered from the shallowest to the
+     *      deepest.
+     *
+     * \details The first state is entered whenever no deeper state can be
+     *      left before the next alarm is due, and should therefore have the
+     *      lowest latencies.
+     */
+    const struct mod_timer_idle_state *states;
+
+    /*! Number of states in ::mod_timer_idle_config::states */
+    unsigned int state_count;
+};
+
+/*!
+ * \brief Get a framework idle driver governed by the alarms of a timer.
+ *
+ * \details The driver enters the deepest state of \p config whose entry and
+ *      exit latencies fit before the next alarm of the timer is due. It is
+ *      intended to be returned by the firmware implementation of
+ *      ::fmw_thread_idle_driver().
+ *
+ * \param[out] ctx Context to give to the framework.
+ * \param config Idle governor configuration.
+ *
+ * \return Framework idle driver.
+ */
+struct fwk_thread_idle_driver mod_timer_idle_driver(
+    const void **ctx,
+    const struct mod_timer_idle_config *config);
+
 /*!
  * \}
  */
@@ -11,21 +11,38 @@
 #include <mod_timer.h>
 
 #include <fwk_assert.h>
-#include <fwk_dlist.h>
+#include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
-#include <fwk_list.h>
 #include <fwk_log.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_signal.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 
+#include <limits.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
+/* Internal event and signal indices */
+enum mod_timer_internal_idx {
+    /* Run the deferred alarm callbacks of a device */
+    MOD_TIMER_INTERNAL_IDX_DEFERRED,
+    MOD_TIMER_INTERNAL_IDX_COUNT,
+};
+
+/* Deferred callbacks signal identifier */
+static const fwk_id_t mod_timer_signal_id_deferred =
+    FWK_ID_SIGNAL_INIT(FWK_MODULE_IDX_TIMER, MOD_TIMER_INTERNAL_IDX_DEFERRED);
+
+/* Deferred callbacks event identifier, when no signal can be queued */
+static const fwk_id_t mod_timer_event_id_deferred =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_TIMER, MOD_TIMER_INTERNAL_IDX_DEFERRED);
+
 /* Timer device context (element) */
 struct dev_ctx {
     /* Pointer to the device's configuration */
@@ -36,18 +53,36 @@ struct dev_ctx {
     fwk_id_t driver_dev_id;
     /* Storage for all alarms */
     struct alarm_ctx *alarm_pool;
-    /* Queue of active alarms */
-    struct fwk_dlist alarms_active;
+    /* Number of alarms in the pool */
+    unsigned int alarm_count;
+    /* Queue of active alarms, as a binary min-heap ordered by deadline */
+    struct alarm_ctx **alarms_active;
+    /* Number of alarms in the active queue */
+    unsigned int alarms_active_count;
+    /* Insertion counter, ordering the alarms due at the same time */
+    uint32_t alarms_sequence;
+    /* Flag indicating if the deferred callbacks are about to be run */
+    bool deferred_requested;
 };
 
 /* Alarm item context (sub-element) */
 struct alarm_ctx {
-    /* List node */
-    struct fwk_dlist_node node;
+    /* Position in the active queue */
+    unsigned int queue_idx;
+    /* Insertion order in the active queue */
+    uint32_t sequence;
     /* Time between starting this alarm and it triggering */
     uint32_t microseconds;
-    /* Timestamp of the time this alarm will trigger */
+    /* Timestamp of the time this alarm is due */
     uint64_t timestamp;
+    /* Number of ticks this alarm may trigger late */
+    uint64_t slack;
+    /* Timestamp of the time this alarm must have triggered by */
+    uint64_t deadline;
+    /* Periods skipped before the latest trigger of this periodic alarm */
+    unsigned int missed;
+    /* Periods skipped since this periodic alarm was started */
+    unsigned int overruns;
     /* Pointer to the callback function */
     void (*callback)(uintptr_t param);
     /* Parameter of the callback function */
@@ -60,6 +95,10 @@ struct alarm_ctx {
     bool bound;
     /* Flag indicating if this alarm is started */
     bool started;
+    /* Flag indicating if the callback is run outside of interrupt context */
+    bool deferred;
+    /* Flag indicating if a deferred callback is waiting to be run */
+    bool callback_pending;
 };
 
 /* Table of timer device context structures */
@@ -146,43 +185,111 @@ static void _configure_timer_with_next_alarm(struct dev_ctx *ctx)
 
     fwk_assert(ctx != NULL);
 
-    alarm_head = (struct alarm_ctx *)fwk_list_head(&ctx->alarms_active);
-    if (alarm_head != NULL) {
+    if (ctx->alarms_active_count != 0) {
+        /*
+         * The earliest deadline is the latest time that satisfies all the
+         * alarms, the ones already due by then trigger together.
+         */
+        alarm_head = ctx->alarms_active[0];
         /* Configure timer device */
-        ctx->driver->set_timer(ctx->driver_dev_id, alarm_head->timestamp);
+        ctx->driver->set_timer(ctx->driver_dev_id, alarm_head->deadline);
         ctx->driver->enable(ctx->driver_dev_id);
     }
 }
 
+/*
+ * Alarms with the same deadline trigger in the order they were queued.
+ */
+static bool _alarm_is_due_before(const struct alarm_ctx *alarm,
+                                 const struct alarm_ctx *other)
+{
+    if (alarm->deadline != other->deadline)
+        return alarm->deadline < other->deadline;
+
+    return (int32_t)(alarm->sequence - other->sequence) < 0;
+}
+
+static void _place_alarm_ctx(struct dev_ctx *ctx,
+                             struct alarm_ctx *alarm,
+                             unsigned int idx)
+{
+    ctx->alarms_active[idx] = alarm;
+    alarm->queue_idx = idx;
+}
+
+static void _sift_up_alarm_ctx(struct dev_ctx *ctx, unsigned int idx)
+{
+    struct alarm_ctx *alarm = ctx->alarms_active[idx];
+    unsigned int parent;
+
+    while (idx > 0) {
+        parent = (idx - 1) / 2;
+        if (!_alarm_is_due_before(alarm, ctx->alarms_active[parent]))
+            break;
+
+        _place_alarm_ctx(ctx, ctx->alarms_active[parent], idx);
+        idx = parent;
+    }
+
+    _place_alarm_ctx(ctx, alarm, idx);
+}
+
+static void _sift_down_alarm_ctx(struct dev_ctx *ctx, unsigned int idx)
+{
+    struct alarm_ctx *alarm = ctx->alarms_active[idx];
+    unsigned int child;
+
+    while ((child = (2 * idx) + 1) < ctx->alarms_active_count) {
+        if (((child + 1) < ctx->alarms_active_count) &&
+            _alarm_is_due_before(ctx->alarms_active[child + 1],
+                                 ctx->alarms_active[child]))
+            child++;
+
+        if (!_alarm_is_due_before(ctx->alarms_active[child], alarm))
+            break;
+
+        _place_alarm_ctx(ctx, ctx->alarms_active[child], idx);
+        idx = child;
+    }
+
+    _place_alarm_ctx(ctx, alarm, idx);
+}
+
 static void _insert_alarm_ctx_into_active_queue(struct dev_ctx *ctx,
                                                 struct alarm_ctx *alarm_new)
 {
-    struct fwk_dlist_node *alarm_node;
-    struct alarm_ctx *alarm;
-
     fwk_assert(ctx != NULL);
     fwk_assert(alarm_new != NULL);
+    fwk_assert(!alarm_new->activated);
 
-    /*
-     * Search though the active queue to find the correct place to insert the
-     * new alarm item
-     */
-    alarm_node = fwk_list_head(&ctx->alarms_active);
-    alarm = FWK_LIST_GET(alarm_node, struct alarm_ctx, node);
-
-    while ((alarm_node != NULL) && (alarm_new->timestamp > alarm->timestamp)) {
-        alarm_node = fwk_list_next(&ctx->alarms_active, alarm_node);
-        alarm = FWK_LIST_GET(alarm_node, struct alarm_ctx, node);
-    }
+    alarm_new->sequence = ctx->alarms_sequence++;
+    alarm_new->deadline = alarm_new->timestamp + alarm_new->slack;
 
-    /* Insert alarm_new just BEFORE the alarm that was found */
-    fwk_list_insert(&ctx->alarms_active,
-                    &(alarm_new->node),
-                    alarm_node);
+    ctx->alarms_active[ctx->alarms_active_count] = alarm_new;
+    _sift_up_alarm_ctx(ctx, ctx->alarms_active_count++);
 
     alarm_new->activated = true;
 }
 
+static void _remove_alarm_ctx_from_active_queue(struct dev_ctx *ctx,
+                                                struct alarm_ctx *alarm)
+{
+    unsigned int idx = alarm->queue_idx;
+    struct alarm_ctx *last;
+
+    fwk_assert(alarm->activated);
+
+    last = ctx->alarms_active[--ctx->alarms_active_count];
+    if (last != alarm) {
+        /* Fill the hole with the last alarm and restore the heap order */
+        _place_alarm_ctx(ctx, last, idx);
+        _sift_up_alarm_ctx(ctx, idx);
+        _sift_down_alarm_ctx(ctx, last->queue_idx);
+    }
+
+    alarm->activated = false;
+}
+
 
 /*
  * Functions fulfilling the timer API
@@ -304,8 +411,6 @@ static int get_next_alarm_remaining(fwk_id_t dev_id,
 {
     int status = FWK_E_PARAM;
     const struct dev_ctx *ctx;
-    const struct alarm_ctx *alarm_ctx;
-    const struct fwk_dlist_node *alarm_ctx_node;
 
     if (has_alarm == NULL)
         return FWK_E_PARAM;
@@ -321,13 +426,11 @@ static int get_next_alarm_remaining(fwk_id_t dev_id,
      */
     ctx->driver->disable(ctx->driver_dev_id);
 
-    *has_alarm = !fwk_list_is_empty(&ctx->alarms_active);
+    *has_alarm = (ctx->alarms_active_count != 0);
 
     if (*has_alarm) {
-        alarm_ctx_node = fwk_list_head(&ctx->alarms_active);
-        alarm_ctx = FWK_LIST_GET(alarm_ctx_node, struct alarm_ctx, node);
-
-        status = _remaining(ctx, alarm_ctx->timestamp, remaining_ticks);
+        status = _remaining(
+            ctx, ctx->alarms_active[0]->deadline, remaining_ticks);
     }
 
     ctx->driver->enable(ctx->driver_dev_id);
@@ -393,6 +496,7 @@ static int alarm_stop(fwk_id_t alarm_id)
     }
 
     alarm->started = false;
+    alarm->callback_pending = false;
 
     if (!alarm->activated)
         return FWK_SUCCESS;
@@ -408,8 +512,7 @@ static int alarm_stop(fwk_id_t alarm_id)
      */
     fwk_interrupt_clear_pending(ctx->config->timer_irq);
 
-    fwk_list_remove(&ctx->alarms_active, (struct fwk_dlist_node *)alarm);
-    alarm->activated = false;
+    _remove_alarm_ctx_from_active_queue(ctx, alarm);
 
     _configure_timer_with_next_alarm(ctx);
 
@@ -455,6 +558,8 @@ static int alarm_start(fwk_id_t alarm_id,
     alarm->periodic =
         (type == MOD_TIMER_ALARM_TYPE_PERIODIC ? true : false);
     alarm->microseconds = milliseconds * 1000;
+    alarm->missed = 0;
+    alarm->overruns = 0;
     status = _timestamp_from_now(ctx,
                                  alarm->microseconds,
                                  &alarm->timestamp);
@@ -471,17 +576,173 @@ static int alarm_start(fwk_id_t alarm_id,
     return FWK_SUCCESS;
 }
 
+static int alarm_set_slack(fwk_id_t alarm_id, unsigned int microseconds)
+{
+    int status;
+    struct dev_ctx *ctx;
+    struct alarm_ctx *alarm;
+    unsigned int interrupt;
+    uint64_t slack;
+
+    fwk_assert(fwk_module_is_valid_sub_element_id(alarm_id));
+
+    status = fwk_interrupt_get_current(&interrupt);
+    if (status != FWK_E_STATE)
+        return FWK_E_ACCESS;
+
+    ctx = ctx_table + fwk_id_get_element_idx(alarm_id);
+    alarm = &ctx->alarm_pool[fwk_id_get_sub_element_idx(alarm_id)];
+
+    status = _time_to_timestamp(ctx, microseconds, &slack);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Disable timer interrupts to work with the active queue */
+    ctx->driver->disable(ctx->driver_dev_id);
+
+    alarm->slack = slack;
+
+    /* Requeue an active alarm at its new deadline */
+    if (alarm->activated) {
+        _remove_alarm_ctx_from_active_queue(ctx, alarm);
+        _insert_alarm_ctx_into_active_queue(ctx, alarm);
+    }
+
+    _configure_timer_with_next_alarm(ctx);
+
+    return FWK_SUCCESS;
+}
+
+static int alarm_get_overruns(fwk_id_t alarm_id,
+                              unsigned int *missed,
+                              unsigned int *total)
+{
+    struct dev_ctx *ctx;
+    struct alarm_ctx *alarm;
+
+    fwk_assert(fwk_module_is_valid_sub_element_id(alarm_id));
+
+    ctx = ctx_table + fwk_id_get_element_idx(alarm_id);
+    alarm = &ctx->alarm_pool[fwk_id_get_sub_element_idx(alarm_id)];
+
+    if (missed != NULL)
+        *missed = alarm->missed;
+    if (total != NULL)
+        *total = alarm->overruns;
+
+    return FWK_SUCCESS;
+}
+
+static int alarm_set_deferred(fwk_id_t alarm_id, bool deferred)
+{
+    int status;
+    struct dev_ctx *ctx;
+    struct alarm_ctx *alarm;
+    unsigned int interrupt;
+
+    fwk_assert(fwk_module_is_valid_sub_element_id(alarm_id));
+
+    status = fwk_interrupt_get_current(&interrupt);
+    if (status != FWK_E_STATE)
+        return FWK_E_ACCESS;
+
+    ctx = ctx_table + fwk_id_get_element_idx(alarm_id);
+    alarm = &ctx->alarm_pool[fwk_id_get_sub_element_idx(alarm_id)];
+
+    /* Disable timer interrupts to work with the alarm */
+    ctx->driver->disable(ctx->driver_dev_id);
+
+    alarm->deferred = deferred;
+
+    _configure_timer_with_next_alarm(ctx);
+
+    return FWK_SUCCESS;
+}
+
 static const struct mod_timer_alarm_api alarm_api = {
     .start = alarm_start,
     .stop = alarm_stop,
+    .set_slack = alarm_set_slack,
+    .get_overruns = alarm_get_overruns,
+    .set_deferred = alarm_set_deferred,
 };
 
+/*
+ * Deferred alarm callbacks
+ */
+
+/*
+ * Ask the framework to run the deferred callbacks of a device. A signal is
+ * used when one can be queued, so that the callbacks run ahead of the pending
+ * events.
+ */
+static bool _request_deferred_callbacks(struct dev_ctx *ctx)
+{
+    int status;
+    fwk_id_t dev_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, (unsigned int)(ctx - ctx_table));
+    struct fwk_event event = {
+        .id = mod_timer_event_id_deferred,
+        .source_id = dev_id,
+        .target_id = dev_id,
+    };
+
+    if (ctx->deferred_requested)
+        return true;
+
+    status =
+        fwk_thread_put_signal(dev_id, dev_id, mod_timer_signal_id_deferred);
+    if ((status == FWK_E_SUPPORT) || (status == FWK_E_BUSY))
+        status = fwk_thread_put_event(&event);
+
+    ctx->deferred_requested = (status == FWK_SUCCESS);
+
+    return ctx->deferred_requested;
+}
+
+static void _run_deferred_callbacks(struct dev_ctx *ctx)
+{
+    struct alarm_ctx *alarm;
+    void (*callback)(uintptr_t param);
+    uintptr_t param = 0;
+    bool pending;
+    unsigned int idx;
+
+    /* A callback deferred from now on needs another request */
+    ctx->driver->disable(ctx->driver_dev_id);
+    ctx->deferred_requested = false;
+    _configure_timer_with_next_alarm(ctx);
+
+    for (idx = 0; idx < ctx->alarm_count; idx++) {
+        alarm = &ctx->alarm_pool[idx];
+        callback = NULL;
+
+        /* Disable timer interrupts to work with the alarm */
+        ctx->driver->disable(ctx->driver_dev_id);
+
+        pending = alarm->callback_pending;
+        if (pending) {
+            alarm->callback_pending = false;
+            callback = alarm->callback;
+            param = alarm->param;
+        }
+
+        _configure_timer_with_next_alarm(ctx);
+
+        if (pending)
+            callback(param);
+    }
+}
+
 static void timer_isr(uintptr_t ctx_ptr)
 {
     int status;
     struct alarm_ctx *alarm;
     struct dev_ctx *ctx = (struct dev_ctx *)ctx_ptr;
-    uint64_t timestamp = 0;
+    uint64_t period = 0;
+    uint64_t missed;
+    uint64_t counter = 0;
+    bool refreshed = false;
 
     fwk_assert(ctx != NULL);
 
@@ -489,36 +750,144 @@ static void timer_isr(uintptr_t ctx_ptr)
     ctx->driver->disable(ctx->driver_dev_id);
     fwk_interrupt_clear_pending(ctx->config->timer_irq);
 
-    alarm = (struct alarm_ctx *)fwk_list_pop_head(&ctx->alarms_active);
-
-    if (alarm == NULL) {
+    if (ctx->alarms_active_count == 0) {
         /* Timer interrupt triggered without any alarm in the active queue */
         fwk_unexpected();
         return;
     }
 
-    alarm->activated = false;
+    status = ctx->driver->get_counter(ctx->driver_dev_id, &counter);
+    if (status != FWK_SUCCESS)
+        counter = ctx->alarms_active[0]->deadline;
 
-    /* Execute the callback function */
-    alarm->callback(alarm->param);
+    /* The timer fired before the earliest alarm was due, wait for it */
+    if (counter < ctx->alarms_active[0]->timestamp) {
+        _configure_timer_with_next_alarm(ctx);
+        return;
+    }
 
-    if (alarm->periodic && alarm->started) {
-        /* Put this alarm back into the active queue */
-        status = _time_to_timestamp(ctx, alarm->microseconds, &timestamp);
+    /*
+     * Trigger every alarm that is already due, including the earliest one.
+     * The counter is read again once they have all triggered so that the
+     * alarms that became due in the meantime are handled in the same entry.
+     * It is only read again once, so that an alarm with a period shorter than
+     * its callback cannot hold the handler forever.
+     */
+    do {
+        alarm = ctx->alarms_active[0];
+        _remove_alarm_ctx_from_active_queue(ctx, alarm);
+
+        if (alarm->periodic) {
+            status = _time_to_timestamp(ctx, alarm->microseconds, &period);
+            if (status != FWK_SUCCESS)
+                period = 0;
+
+            /* Periods that fully elapsed before the alarm triggered */
+            alarm->missed = 0;
+            if ((period != 0) && (counter > alarm->timestamp)) {
+                missed = (counter - alarm->timestamp) / period;
+                alarm->missed = (unsigned int)FWK_MIN(missed, UINT_MAX);
+            }
+
+            if (alarm->overruns > (UINT_MAX - alarm->missed))
+                alarm->overruns = UINT_MAX;
+            else
+                alarm->overruns += alarm->missed;
+        }
+
+        /* Execute the callback function, or leave it to the framework */
+        if (!alarm->deferred || !_request_deferred_callbacks(ctx))
+            alarm->callback(alarm->param);
+        else
+            alarm->callback_pending = true;
+
+        /* The callback may have restarted the alarm, which queued it already */
+        if (alarm->periodic && alarm->started && !alarm->activated) {
+            /*
+             * Put this alarm back into the active queue, one period after the
+             * time it was due so that the latency does not accumulate.
+             */
+            if (period != 0) {
+                alarm->timestamp += ((uint64_t)alarm->missed + 1) * period;
+                _insert_alarm_ctx_into_active_queue(ctx, alarm);
+            } else {
+                FWK_LOG_ERR(
+                    "[Timer] Error: Periodic alarm could not be added "
+                    "back into queue.");
+            }
+        }
 
-        if (status == FWK_SUCCESS) {
-            alarm->timestamp += timestamp;
-            _insert_alarm_ctx_into_active_queue(ctx, alarm);
-        } else {
-            FWK_LOG_ERR(
-                "[Timer] Error: Periodic alarm could not be added "
-                "back into queue.");
+        if (!refreshed && (ctx->alarms_active_count != 0) &&
+            (ctx->alarms_active[0]->timestamp > counter)) {
+            refreshed = true;
+
+            status = ctx->driver->get_counter(ctx->driver_dev_id, &counter);
+            if (status != FWK_SUCCESS)
+                break;
         }
-    }
+    } while ((ctx->alarms_active_count != 0) &&
+             (ctx->alarms_active[0]->timestamp <= counter));
 
     _configure_timer_with_next_alarm(ctx);
 }
 
+/*
+ * Idle governor
+ */
+
+static void timer_idle(const void *ctx)
+{
+    const struct mod_timer_idle_config *config = ctx;
+    const struct mod_timer_idle_state *state;
+    uint64_t remaining_us = UINT64_MAX;
+    uint64_t remaining_ticks;
+    uint32_t frequency;
+    bool has_alarm;
+    int status;
+    unsigned int i;
+
+    status = get_next_alarm_remaining(
+        config->timer_id, &has_alarm, &remaining_ticks);
+    if (has_alarm) {
+        if (status == FWK_SUCCESS)
+            status = get_frequency(config->timer_id, &frequency);
+
+        if ((status != FWK_SUCCESS) || (frequency == 0))
+            remaining_us = 0;
+        else {
+            remaining_us = ((remaining_ticks / frequency) * 1000000) +
+                (((remaining_ticks % frequency) * 1000000) / frequency);
+        }
+    }
+
+    /* Pick the deepest state that can be left before the alarm is due */
+    state = &config->states[0];
+    for (i = 1; i < config->state_count; i++) {
+        if (((uint64_t)config->states[i].entry_latency_us +
+             config->states[i].exit_latency_us) > remaining_us)
+            break;
+
+        state = &config->states[i];
+    }
+
+    state->enter();
+}
+
+struct fwk_thread_idle_driver mod_timer_idle_driver(
+    const void **ctx,
+    const struct mod_timer_idle_config *config)
+{
+    fwk_assert(config != NULL);
+    fwk_assert(config->states != NULL);
+    fwk_assert(config->state_count > 0);
+
+    *ctx = config;
+
+    return (struct fwk_thread_idle_driver){
+        .idle = timer_idle,
+    };
+}
+
 /*
  * Functions fulfilling the framework's module interface
  */
@@ -542,8 +911,13 @@ static int timer_device_init(fwk_id_t element_id, unsigned int alarm_count,
     ctx = ctx_table + fwk_id_get_element_idx(element_id);
     ctx->config = data;
 
-    if (alarm_count > 0)
+    ctx->alarm_count = alarm_count;
+
+    if (alarm_count > 0) {
         ctx->alarm_pool = fwk_mm_calloc(alarm_count, sizeof(struct alarm_ctx));
+        ctx->alarms_active =
+            fwk_mm_calloc(alarm_count, sizeof(ctx->alarms_active[0]));
+    }
 
     return FWK_SUCCESS;
 }
@@ -633,8 +1007,6 @@ static int timer_start(fwk_id_t id)
 
     ctx = ctx_table + fwk_id_get_element_idx(id);
 
-    fwk_list_init(&ctx->alarms_active);
-
     fwk_interrupt_set_isr_param(ctx->config->timer_irq,
                                 timer_isr,
                                 (uintptr_t)ctx);
@@ -643,14 +1015,42 @@ static int timer_start(fwk_id_t id)
     return FWK_SUCCESS;
 }
 
+static int timer_process_signal(fwk_id_t target_id, fwk_id_t signal_id)
+{
+    if (!fwk_id_is_equal(signal_id, mod_timer_signal_id_deferred) ||
+        !fwk_module_is_valid_element_id(target_id))
+        return FWK_E_PARAM;
+
+    _run_deferred_callbacks(ctx_table + fwk_id_get_element_idx(target_id));
+
+    return FWK_SUCCESS;
+}
+
+static int timer_process_event(const struct fwk_event *event,
+                               struct fwk_event *resp_event)
+{
+    if (!fwk_id_is_equal(event->id, mod_timer_event_id_deferred) ||
+        !fwk_module_is_valid_element_id(event->target_id))
+        return FWK_E_PARAM;
+
+    _run_deferred_callbacks(ctx_table + fwk_id_get_element_idx(
+        event->target_id));
+
+    return FWK_SUCCESS;
+}
+
 /* Module descriptor */
 const struct fwk_module module_timer = {
     .name = "Timer HAL",
     .api_count = MOD_TIMER_API_COUNT,
+    .event_count = MOD_TIMER_INTERNAL_IDX_COUNT,
     .type = FWK_MODULE_TYPE_HAL,
     .init = timer_init,
     .element_init = timer_device_init,
     .bind = timer_bind,
     .process_bind_request = timer_process_bind_request,
+    .bind_shared_api_mask = (1U << MOD_TIMER_API_IDX_TIMER),
     .start = timer_start,
+    .process_event = timer_process_event,
+    .process_signal = timer_process_signal,
 };
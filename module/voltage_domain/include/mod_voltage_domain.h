@@ -50,6 +50,9 @@ enum mod_voltd_api_type {
     /*! Voltage Domaon (voltd) HAL */
     MOD_VOLTD_API_TYPE_HAL,
 
+    /*! Driver response API, see ::mod_voltd_driver_response_api */
+    MOD_VOLTD_API_TYPE_DRIVER_RESPONSE,
+
     /*! Number of defined APIs */
     MOD_VOLTD_API_COUNT,
 };
@@ -133,8 +136,9 @@ struct mod_voltd_drv_api {
      *
      * \param level_uv The desired voltage in microvolt.
      *
-     * \retval FWK_PENDING The request is pending. The driver will provide the
-     *      requested value later through the driver response API.
+     * \retval FWK_PENDING The request is pending. The driver will signal its
+     *      completion later through the driver response API, see
+     *      ::mod_voltd_driver_response_api.
      * \retval FWK_SUCCESS The operation succeeded.
      * \return One of the standard framework error codes.
      */
@@ -221,9 +225,16 @@ struct mod_voltd_api {
      *
      * \param rate The desired voltage level in microvolts (uV).
      *
+     * \details The change of level of a domain whose driver completes it
+     *      asynchronously, such as a regulator behind an I2C PMIC, is deferred
+     *      and the caller is answered through a response event, see
+     *      ::mod_voltd_event_id_set_level_request. A domain handles one
+     *      deferred change at a time.
+     *
      * \retval FWK_SUCCESS The operation succeeded.
      * \retval FWK_PENDING The request is pending. The result for this operation
      *      will be provided via a response event.
+     * \retval FWK_E_BUSY A change of level of the domain is already pending.
      * \retval FWK_E_PARAM The voltage domain identifier was invalid.
      * \retval FWK_E_SUPPORT Deferred handling of asynchronous drivers is not
      *      supported.
@@ -314,6 +325,52 @@ struct mod_voltd_api {
                                 int *level_uv);
 };
 
+/*!
+ * \brief Voltage domain driver response API.
+ *
+ * \details API used by the driver when an asynchronous request is completed.
+ */
+struct mod_voltd_driver_response_api {
+    /*!
+     * \brief Signal the completion of a change of voltage level.
+     *
+     * \param voltd_id Voltage domain device identifier.
+     *
+     * \param status Status of the change of level.
+     */
+    void (*set_level_complete)(fwk_id_t voltd_id, int status);
+};
+
+/*!
+ * \brief Event response parameters.
+ */
+struct mod_voltd_resp_params {
+    /*! Status of the requested operation */
+    int status;
+
+    /*! Voltage level requested, in microvolts */
+    int level_uv;
+};
+
+/*!
+ * \brief Define the event identifiers for deferred responses.
+ */
+enum mod_voltd_event_idx {
+    MOD_VOLTD_EVENT_IDX_SET_LEVEL_REQUEST,
+
+    MOD_VOLTD_EVENT_IDX_COUNT
+};
+
+/*!
+ * \brief Request event identifiers.
+ *
+ * \details These identifiers are used by the clients that expect to receive a
+ *      response event from this module when a request is deferred.
+ */
+static const fwk_id_t mod_voltd_event_id_set_level_request =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_VOLTAGE_DOMAIN,
+                      MOD_VOLTD_EVENT_IDX_SET_LEVEL_REQUEST);
+
 /*!
  * @}
  */
@@ -5,13 +5,17 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <voltage_domain.h>
+
 #include <mod_voltage_domain.h>
 
 #include <fwk_assert.h>
+#include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 
 #include <stdbool.h>
 #include <stddef.h>
@@ -24,6 +28,15 @@ struct voltd_dev_ctx {
 
     /* Driver API */
     struct mod_voltd_drv_api *api;
+
+    /* A change of level is pending on the driver */
+    bool is_request_ongoing;
+
+    /* Level of the pending change, in microvolts */
+    int level_uv;
+
+    /* Cookie for the response event */
+    uint32_t cookie;
 };
 
 /* Module context */
@@ -46,12 +59,69 @@ static void get_ctx(fwk_id_t voltd_id, struct voltd_dev_ctx **ctx)
     *ctx = &module_ctx.dev_ctx_table[fwk_id_get_element_idx(voltd_id)];
 }
 
+static int create_async_request(
+    struct voltd_dev_ctx *ctx,
+    fwk_id_t voltd_id,
+    int level_uv)
+{
+    int status;
+    struct fwk_event request_event;
+
+    request_event = (struct fwk_event) {
+        .target_id = voltd_id,
+        .id = mod_voltd_event_id_set_level_request,
+        .response_requested = true,
+    };
+
+    status = fwk_thread_put_event(&request_event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->is_request_ongoing = true;
+    ctx->level_uv = level_uv;
+
+    /*
+     * Signal the result of the request is pending and will arrive later
+     * through an event.
+     */
+    return FWK_PENDING;
+}
+
+/*
+ * Driver response API.
+ */
+
+static void voltd_set_level_complete(fwk_id_t voltd_id, int status)
+{
+    struct fwk_event event;
+    struct voltd_dev_ctx *ctx;
+    struct mod_voltd_resp_params *event_params =
+        (struct mod_voltd_resp_params *)event.params;
+
+    get_ctx(voltd_id, &ctx);
+
+    event = (struct fwk_event) {
+        .id = mod_voltd_event_id_response,
+        .source_id = ctx->config->driver_id,
+        .target_id = voltd_id,
+    };
+
+    event_params->status = status;
+
+    fwk_check(fwk_thread_put_event(&event) == FWK_SUCCESS);
+}
+
+static const struct mod_voltd_driver_response_api voltd_driver_response_api = {
+    .set_level_complete = voltd_set_level_complete,
+};
+
 /*
  * Module API functions
  */
 
 static int voltd_set_level(fwk_id_t voltd_id, int level_uv)
 {
+    int status;
     struct voltd_dev_ctx *ctx;
 
     get_ctx(voltd_id, &ctx);
@@ -59,7 +129,15 @@ static int voltd_set_level(fwk_id_t voltd_id, int level_uv)
     if (!ctx->api->set_level)
         return FWK_E_SUPPORT;
 
-    return ctx->api->set_level(ctx->config->driver_id, level_uv);
+    /* Concurrency is not supported */
+    if (ctx->is_request_ongoing)
+        return FWK_E_BUSY;
+
+    status = ctx->api->set_level(ctx->config->driver_id, level_uv);
+    if (status == FWK_PENDING)
+        return create_async_request(ctx, voltd_id, level_uv);
+
+    return status;
 }
 
 static int voltd_get_level(fwk_id_t voltd_id, int *level_uv)
@@ -194,11 +272,23 @@ static int voltd_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
                                       fwk_id_t api_id, const void **api)
 {
     enum mod_voltd_api_type api_type = fwk_id_get_api_idx(api_id);
+    struct voltd_dev_ctx *ctx;
 
     switch (api_type) {
     case MOD_VOLTD_API_TYPE_HAL:
         *api = &voltd_api;
         break;
+    case MOD_VOLTD_API_TYPE_DRIVER_RESPONSE:
+        if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT))
+            return FWK_E_PARAM;
+
+        ctx = &module_ctx.dev_ctx_table[fwk_id_get_element_idx(target_id)];
+
+        if (!fwk_id_is_equal(source_id, ctx->config->driver_id))
+            return FWK_E_ACCESS;
+
+        *api = &voltd_driver_response_api;
+        break;
     default:
         return FWK_E_ACCESS;
     }
@@ -206,12 +296,73 @@ static int voltd_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
     return FWK_SUCCESS;
 }
 
+static int process_request_event(const struct fwk_event *event,
+                                 struct fwk_event *resp_event)
+{
+    struct voltd_dev_ctx *ctx;
+
+    get_ctx(event->target_id, &ctx);
+
+    ctx->cookie = event->cookie;
+    resp_event->is_delayed_response = true;
+
+    return FWK_SUCCESS;
+}
+
+static int process_response_event(const struct fwk_event *event)
+{
+    int status;
+    struct fwk_event resp_event;
+    struct voltd_dev_ctx *ctx;
+    const struct mod_voltd_resp_params *event_params =
+        (const struct mod_voltd_resp_params *)event->params;
+    struct mod_voltd_resp_params *resp_params =
+        (struct mod_voltd_resp_params *)resp_event.params;
+
+    get_ctx(event->target_id, &ctx);
+
+    if (!ctx->is_request_ongoing)
+        return FWK_E_STATE;
+
+    status = fwk_thread_get_delayed_response(event->target_id,
+                                             ctx->cookie,
+                                             &resp_event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    resp_params->status = event_params->status;
+    resp_params->level_uv = ctx->level_uv;
+    ctx->is_request_ongoing = false;
+
+    return fwk_thread_put_event(&resp_event);
+}
+
+static int voltd_process_event(const struct fwk_event *event,
+                               struct fwk_event *resp_event)
+{
+    if (!fwk_module_is_valid_element_id(event->target_id))
+        return FWK_E_PARAM;
+
+    switch (fwk_id_get_event_idx(event->id)) {
+    case MOD_VOLTD_EVENT_IDX_SET_LEVEL_REQUEST:
+        return process_request_event(event, resp_event);
+
+    case VOLTD_EVENT_IDX_RESPONSE:
+        return process_response_event(event);
+
+    default:
+        return FWK_E_PARAM;
+    }
+}
+
 const struct fwk_module module_voltage_domain = {
     .name = "Voltage Domain (VOLTD) HAL",
     .type = FWK_MODULE_TYPE_HAL,
     .api_count = MOD_VOLTD_API_COUNT,
+    .event_count = VOLTD_EVENT_IDX_COUNT,
     .init = voltd_init,
     .element_init = voltd_dev_init,
     .bind = voltd_bind,
     .process_bind_request = voltd_process_bind_request,
+    .process_event = voltd_process_event,
 };
@@ -0,0 +1,31 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef VOLTAGE_DOMAIN_H
+#define VOLTAGE_DOMAIN_H
+
+#include <mod_voltage_domain.h>
+
+#include <fwk_id.h>
+
+/*
+ * Voltage domain event indexes.
+ */
+enum voltd_event_idx {
+    VOLTD_EVENT_IDX_RESPONSE = MOD_VOLTD_EVENT_IDX_COUNT,
+    VOLTD_EVENT_IDX_COUNT
+};
+
+/*
+ * Event identifiers.
+ */
+
+/* Identifier of the driver response event */
+static const fwk_id_t mod_voltd_event_id_response =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_VOLTAGE_DOMAIN, VOLTD_EVENT_IDX_RESPONSE);
+
+#endif /* VOLTAGE_DOMAIN_H */
@@ -0,0 +1,47 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <mod_host_bench.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+
+/* Highest number of subscribers to the fan-out notification */
+#define CONFIG_HOST_BENCH_SUBSCRIBER_COUNT 64
+
+static const struct mod_host_bench_config config_host_bench_data = {
+    .iterations = 10000,
+    .event_batch = 128,
+    .delayed_response_max = 128,
+};
+
+static const struct fwk_element *config_host_bench_get_element_table(
+    fwk_id_t module_id)
+{
+    struct fwk_element *element_table;
+    unsigned int i;
+
+    element_table = fwk_mm_calloc(
+        CONFIG_HOST_BENCH_SUBSCRIBER_COUNT + 1, sizeof(struct fwk_element));
+
+    for (i = 0; i < CONFIG_HOST_BENCH_SUBSCRIBER_COUNT; i++) {
+        element_table[i] = (struct fwk_element){
+            .name = "Subscriber",
+            .data = &config_host_bench_data,
+        };
+    }
+
+    return element_table;
+}
+
+const struct fwk_module_config config_host_bench = {
+    .data = &config_host_bench_data,
+    .elements =
+        FWK_MODULE_DYNAMIC_ELEMENTS(config_host_bench_get_element_table),
+};
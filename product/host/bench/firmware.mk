@@ -0,0 +1,21 @@
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# The order of the modules in the BS_FIRMWARE_MODULES list is the order in which
+# the modules are initialized, bound, started during the pre-runtime phase.
+#
+
+BS_FIRMWARE_CPU := host
+BS_FIRMWARE_HAS_MULTITHREADING := no
+BS_FIRMWARE_HAS_NOTIFICATION := yes
+
+BS_FIRMWARE_MODULES := stdio host_bench
+
+BS_FIRMWARE_SOURCES := config_stdio.c
+BS_FIRMWARE_SOURCES += config_time.c
+BS_FIRMWARE_SOURCES += config_host_bench.c
+
+include $(BS_DIR)/firmware.mk
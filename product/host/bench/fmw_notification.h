@@ -0,0 +1,20 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Benchmark firmware notification configuration.
+ */
+
+#ifndef FMW_NOTIFICATION_H
+#define FMW_NOTIFICATION_H
+
+/*
+ * Also sizes the event pool, which must hold a notification per subscriber
+ * and the events whose response is delayed.
+ */
+#define FMW_NOTIFICATION_MAX 256
+
+#endif /* FMW_NOTIFICATION_H */
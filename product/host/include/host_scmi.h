@@ -0,0 +1,60 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Definitions for the SCMI load firmware.
+ */
+
+#ifndef HOST_SCMI_H
+#define HOST_SCMI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Number of emulated agents, each with its own SMT channel */
+#define HOST_SCMI_AGENT_COUNT 4
+
+/* SCMI agent identifiers, 0 being the platform */
+#define HOST_SCMI_AGENT_ID(idx) ((idx) + 1)
+
+/* Size of the SMT mailboxes */
+#define HOST_SCMI_MAILBOX_SIZE 128
+
+/* Number of records of the SCMI message capture, 0 disables the capture */
+#ifndef HOST_SCMI_CAPTURE_RECORD_COUNT
+#    define HOST_SCMI_CAPTURE_RECORD_COUNT 0
+#endif
+
+/* Payload bytes kept in a capture record, enough for all the messages sent */
+#define HOST_SCMI_CAPTURE_PAYLOAD_SIZE 32
+
+/* Mailboxes of the SMT channels, indexed by agent */
+extern uint64_t host_scmi_mailbox_table[HOST_SCMI_AGENT_COUNT]
+                                       [HOST_SCMI_MAILBOX_SIZE /
+                                        sizeof(uint64_t)];
+
+/* Clock indices */
+enum host_clock_idx {
+    HOST_CLOCK_IDX_CPU,
+    HOST_CLOCK_IDX_GPU,
+    HOST_CLOCK_IDX_PERIPH,
+    HOST_CLOCK_IDX_COUNT
+};
+
+/* DVFS domain indices, also the SCMI performance domain identifiers */
+enum host_dvfs_idx {
+    HOST_DVFS_IDX_CPU,
+    HOST_DVFS_IDX_GPU,
+    HOST_DVFS_IDX_COUNT
+};
+
+/* Sensor indices */
+enum host_sensor_idx {
+    HOST_SENSOR_IDX_SOC_TEMP,
+    HOST_SENSOR_IDX_COUNT
+};
+
+#endif /* HOST_SCMI_H */
@@ -0,0 +1,87 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MOD_HOST_BENCH_H
+#define MOD_HOST_BENCH_H
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupModuleHostBench Framework Benchmarks
+ *
+ * \brief Measures the cost of framework operations on the host.
+ *
+ * \details Once started, this module measures in turn:
+ *      - the cost of ::fwk_thread_put_event() and of the dispatch of the
+ *        events put, for a batch of events put in a row;
+ *      - the round trip of an event put with ::fwk_thread_put_event() to an
+ *        element of this module, until its response is processed;
+ *      - the cost of ::fwk_notification_notify() and of the delivery of the
+ *        notification, against the number of subscribers;
+ *      - the cost of ::fwk_thread_get_delayed_response(), against the number
+ *        of outstanding delayed responses;
+ *      - the cost of pushing data to and popping it from a ::fwk_ring.
+ *
+ *      Each result is written to the standard output as a line holding a JSON
+ *      object, for example:
+ *
+ *      {"benchmark": "fwk_ring", "parameter": 16, "iterations": 10000,
+ *       "ns_per_op": 25}
+ *
+ *      where the parameter is the batch size, number of subscribers, number
+ *      of outstanding delayed responses or size of the data respectively. The
+ *      firmware then exits.
+ *
+ *      The elements of the module are the subscribers of the notification
+ *      whose fan-out is measured. Their configuration data is not used.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_host_bench_config {
+    /*! Number of times each operation is measured */
+    unsigned int iterations;
+
+    /*! Number of events put in a row to measure the event throughput */
+    unsigned int event_batch;
+
+    /*!
+     * \brief Highest number of outstanding delayed responses to measure the
+     *      lookups with.
+     *
+     * \details Each outstanding delayed response holds an event of the
+     *      framework event pool.
+     */
+    unsigned int delayed_response_max;
+};
+
+/*!
+ * \brief Notification indices.
+ */
+enum mod_host_bench_notification_idx {
+    /*! Notification sent to measure the notification fan-out */
+    MOD_HOST_BENCH_NOTIFICATION_IDX_FAN_OUT,
+
+    /*! Number of defined notifications */
+    MOD_HOST_BENCH_NOTIFICATION_IDX_COUNT,
+};
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_HOST_BENCH_H */
@@ -0,0 +1,545 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Framework benchmarks.
+ */
+
+#include <mod_host_bench.h>
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_io.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_multi_thread.h>
+#include <fwk_notification.h>
+#include <fwk_ring.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+#include <fwk_time.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Size of the ring buffer storage */
+#define HOST_BENCH_RING_SIZE 1024
+
+enum host_bench_event_idx {
+    /* Run the next step of the current benchmark */
+    HOST_BENCH_EVENT_IDX_RUN,
+
+    /* Event put to measure the event throughput */
+    HOST_BENCH_EVENT_IDX_NOP,
+
+    /* Event put to measure the event round trip */
+    HOST_BENCH_EVENT_IDX_ECHO,
+
+    /* Event whose response is delayed */
+    HOST_BENCH_EVENT_IDX_DELAY,
+
+    HOST_BENCH_EVENT_IDX_COUNT,
+};
+
+enum host_bench_phase {
+    HOST_BENCH_PHASE_PUT_EVENT,
+    HOST_BENCH_PHASE_ROUND_TRIP,
+    HOST_BENCH_PHASE_FAN_OUT,
+    HOST_BENCH_PHASE_DELAYED_RESPONSE,
+    HOST_BENCH_PHASE_RING,
+    HOST_BENCH_PHASE_DONE,
+};
+
+struct host_bench_ctx {
+    /* Module configuration */
+    const struct mod_host_bench_config *config;
+
+    /* Number of subscribers available to the fan-out benchmark */
+    unsigned int subscriber_max;
+
+    /* Number of elements subscribed to the fan-out notification */
+    unsigned int subscriber_count;
+
+    /* Benchmark being run */
+    enum host_bench_phase phase;
+
+    /* Number of measurements taken for the current parameter */
+    unsigned int iteration;
+
+    /*
+     * Parameter of the current measurement: number of subscribers or number
+     * of outstanding delayed responses.
+     */
+    unsigned int parameter;
+
+    /* Number of events or notifications received in the current measurement */
+    unsigned int received;
+
+    /* Start time of the current measurement */
+    fwk_timestamp_t start;
+
+    /* Time spent in the calls measured */
+    fwk_duration_ns_t call_total;
+
+    /* Time until the completion of the measurements */
+    fwk_duration_ns_t completion_total;
+
+    /* Cookies of the events whose response is delayed */
+    uint32_t *cookie_table;
+
+    /* Number of entries in the cookie table */
+    unsigned int cookie_count;
+};
+
+static struct host_bench_ctx host_bench_ctx;
+
+/*
+ * Static helpers
+ */
+
+static void host_bench_report(
+    const char *name,
+    unsigned int parameter,
+    fwk_duration_ns_t total)
+{
+    unsigned int iterations = host_bench_ctx.config->iterations;
+
+    fwk_io_printf(
+        fwk_io_stdout,
+        "{\"benchmark\": \"%s\", \"parameter\": %u, \"iterations\": %u, "
+        "\"ns_per_op\": %" PRIu64 "}\n",
+        name,
+        parameter,
+        iterations,
+        (uint64_t)(total / iterations));
+}
+
+static int host_bench_put_event(enum host_bench_event_idx idx)
+{
+    struct fwk_event event = {
+        .source_id = fwk_module_id_host_bench,
+        .target_id = fwk_module_id_host_bench,
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_HOST_BENCH, idx),
+        .response_requested = (idx == HOST_BENCH_EVENT_IDX_DELAY),
+    };
+
+    return fwk_thread_put_event(&event);
+}
+
+static int host_bench_next_step(void)
+{
+    return host_bench_put_event(HOST_BENCH_EVENT_IDX_RUN);
+}
+
+/* Move to the next benchmark once all the measurements of one are taken */
+static int host_bench_next_phase(void)
+{
+    host_bench_ctx.phase++;
+    host_bench_ctx.iteration = 0;
+    host_bench_ctx.parameter = 1;
+    host_bench_ctx.call_total = 0;
+    host_bench_ctx.completion_total = 0;
+
+    return host_bench_next_step();
+}
+
+/*
+ * Benchmarks
+ */
+
+/* Put a batch of events and measure until they have all been processed */
+static int host_bench_put_event_step(void)
+{
+    const struct mod_host_bench_config *config = host_bench_ctx.config;
+    unsigned int i;
+    int status;
+
+    if (host_bench_ctx.iteration == config->iterations) {
+        host_bench_report(
+            "fwk_thread_put_event",
+            config->event_batch,
+            host_bench_ctx.call_total / config->event_batch);
+        host_bench_report(
+            "fwk_thread_dispatch",
+            config->event_batch,
+            host_bench_ctx.completion_total / config->event_batch);
+
+        return host_bench_next_phase();
+    }
+
+    host_bench_ctx.received = 0;
+    host_bench_ctx.start = fwk_time_current();
+
+    for (i = 0; i < config->event_batch; i++) {
+        status = host_bench_put_event(HOST_BENCH_EVENT_IDX_NOP);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    host_bench_ctx.call_total +=
+        fwk_time_duration(host_bench_ctx.start, fwk_time_current());
+
+    return FWK_SUCCESS;
+}
+
+static int host_bench_nop(void)
+{
+    host_bench_ctx.received++;
+    if (host_bench_ctx.received < host_bench_ctx.config->event_batch)
+        return FWK_SUCCESS;
+
+    host_bench_ctx.completion_total +=
+        fwk_time_duration(host_bench_ctx.start, fwk_time_current());
+    host_bench_ctx.iteration++;
+
+    return host_bench_next_step();
+}
+
+/* Send an event to an element and measure until its response is received */
+static int host_bench_round_trip_step(void)
+{
+    struct fwk_event event;
+
+    if (host_bench_ctx.iteration == host_bench_ctx.config->iterations) {
+        host_bench_report(
+            "event_round_trip", 0, host_bench_ctx.completion_total);
+
+        return host_bench_next_phase();
+    }
+
+    event = (struct fwk_event){
+        .source_id = fwk_module_id_host_bench,
+        .target_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_HOST_BENCH, 0),
+        .id = FWK_ID_EVENT(
+            FWK_MODULE_IDX_HOST_BENCH, HOST_BENCH_EVENT_IDX_ECHO),
+        .response_requested = true,
+    };
+
+    host_bench_ctx.start = fwk_time_current();
+
+    return fwk_thread_put_event(&event);
+}
+
+static int host_bench_echo_response(void)
+{
+    host_bench_ctx.completion_total +=
+        fwk_time_duration(host_bench_ctx.start, fwk_time_current());
+    host_bench_ctx.iteration++;
+
+    return host_bench_next_step();
+}
+
+/* Notify a growing number of subscribers and measure until they all got it */
+static int host_bench_fan_out_step(void)
+{
+    struct fwk_event notification;
+    fwk_id_t notification_id = FWK_ID_NOTIFICATION(
+        FWK_MODULE_IDX_HOST_BENCH, MOD_HOST_BENCH_NOTIFICATION_IDX_FAN_OUT);
+    unsigned int count;
+    int status;
+
+    if (host_bench_ctx.iteration == host_bench_ctx.config->iterations) {
+        host_bench_report(
+            "fwk_notification_notify",
+            host_bench_ctx.parameter,
+            host_bench_ctx.call_total);
+        host_bench_report(
+            "fwk_notification_delivery",
+            host_bench_ctx.parameter,
+            host_bench_ctx.completion_total);
+
+        if (host_bench_ctx.parameter == host_bench_ctx.subscriber_max)
+            return host_bench_next_phase();
+
+        host_bench_ctx.parameter *= 2;
+        if (host_bench_ctx.parameter > host_bench_ctx.subscriber_max)
+            host_bench_ctx.parameter = host_bench_ctx.subscriber_max;
+
+        host_bench_ctx.iteration = 0;
+        host_bench_ctx.call_total = 0;
+        host_bench_ctx.completion_total = 0;
+    }
+
+    /* Subscribe the elements missing for the current number of subscribers */
+    while (host_bench_ctx.subscriber_count < host_bench_ctx.parameter) {
+        status = fwk_notification_subscribe(
+            notification_id,
+            fwk_module_id_host_bench,
+            FWK_ID_ELEMENT(
+                FWK_MODULE_IDX_HOST_BENCH, host_bench_ctx.subscriber_count));
+        if (status != FWK_SUCCESS)
+            return status;
+
+        host_bench_ctx.subscriber_count++;
+    }
+
+    notification = (struct fwk_event){
+        .source_id = fwk_module_id_host_bench,
+        .id = notification_id,
+    };
+
+    host_bench_ctx.received = 0;
+    host_bench_ctx.start = fwk_time_current();
+
+    status = fwk_notification_notify(&notification, &count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    host_bench_ctx.call_total +=
+        fwk_time_duration(host_bench_ctx.start, fwk_time_current());
+
+    fwk_assert(count == host_bench_ctx.parameter);
+
+    return FWK_SUCCESS;
+}
+
+static int host_bench_fan_out_notification(void)
+{
+    host_bench_ctx.received++;
+    if (host_bench_ctx.received < host_bench_ctx.parameter)
+        return FWK_SUCCESS;
+
+    host_bench_ctx.completion_total +=
+        fwk_time_duration(host_bench_ctx.start, fwk_time_current());
+    host_bench_ctx.iteration++;
+
+    return host_bench_next_step();
+}
+
+/* Respond to all the outstanding delayed responses */
+static int host_bench_respond(void)
+{
+    struct fwk_event response;
+    unsigned int i;
+    int status;
+
+    for (i = 0; i < host_bench_ctx.cookie_count; i++) {
+        status = fwk_thread_get_delayed_response(
+            fwk_module_id_host_bench,
+            host_bench_ctx.cookie_table[i],
+            &response);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = fwk_thread_put_event(&response);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    host_bench_ctx.cookie_count = 0;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Delay the responses to a growing number of events and measure the lookup of
+ * the delayed responses.
+ */
+static int host_bench_delayed_response_step(void)
+{
+    const struct mod_host_bench_config *config = host_bench_ctx.config;
+    struct fwk_event response;
+    fwk_timestamp_t start;
+    unsigned int i;
+    int status;
+
+    /* Put the events whose response is delayed first */
+    if (host_bench_ctx.cookie_count < host_bench_ctx.parameter) {
+        for (i = host_bench_ctx.cookie_count; i < host_bench_ctx.parameter;
+             i++) {
+            status = host_bench_put_event(HOST_BENCH_EVENT_IDX_DELAY);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+
+        return FWK_SUCCESS;
+    }
+
+    start = fwk_time_current();
+
+    for (i = 0; i < config->iterations; i++) {
+        status = fwk_thread_get_delayed_response(
+            fwk_module_id_host_bench,
+            host_bench_ctx.cookie_table[i % host_bench_ctx.cookie_count],
+            &response);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    host_bench_report(
+        "fwk_thread_get_delayed_response",
+        host_bench_ctx.parameter,
+        fwk_time_duration(start, fwk_time_current()));
+
+    if (host_bench_ctx.parameter == config->delayed_response_max) {
+        status = host_bench_respond();
+        if (status != FWK_SUCCESS)
+            return status;
+
+        return host_bench_next_phase();
+    }
+
+    host_bench_ctx.parameter *= 2;
+    if (host_bench_ctx.parameter > config->delayed_response_max)
+        host_bench_ctx.parameter = config->delayed_response_max;
+
+    return host_bench_next_step();
+}
+
+static int host_bench_delay(uint32_t cookie)
+{
+    host_bench_ctx.cookie_table[host_bench_ctx.cookie_count++] = cookie;
+    if (host_bench_ctx.cookie_count < host_bench_ctx.parameter)
+        return FWK_SUCCESS;
+
+    return host_bench_next_step();
+}
+
+/* Push data to a ring buffer and pop it back, for growing sizes of data */
+static int host_bench_ring_step(void)
+{
+    static char storage[HOST_BENCH_RING_SIZE];
+    static char buffer[HOST_BENCH_RING_SIZE / 4];
+    struct fwk_ring ring;
+    fwk_timestamp_t start;
+    size_t size;
+    unsigned int i;
+
+    fwk_ring_init(&ring, storage, sizeof(storage));
+
+    for (size = 1; size <= sizeof(buffer); size *= 16) {
+        start = fwk_time_current();
+
+        for (i = 0; i < host_bench_ctx.config->iterations; i++) {
+            fwk_ring_push(&ring, buffer, size);
+            fwk_ring_pop(&ring, buffer, size);
+        }
+
+        host_bench_report(
+            "fwk_ring",
+            (unsigned int)size,
+            fwk_time_duration(start, fwk_time_current()));
+    }
+
+    return host_bench_next_phase();
+}
+
+static int host_bench_run(void)
+{
+    switch (host_bench_ctx.phase) {
+    case HOST_BENCH_PHASE_PUT_EVENT:
+        return host_bench_put_event_step();
+
+    case HOST_BENCH_PHASE_ROUND_TRIP:
+        return host_bench_round_trip_step();
+
+    case HOST_BENCH_PHASE_FAN_OUT:
+        return host_bench_fan_out_step();
+
+    case HOST_BENCH_PHASE_DELAYED_RESPONSE:
+        return host_bench_delayed_response_step();
+
+    case HOST_BENCH_PHASE_RING:
+        return host_bench_ring_step();
+
+    default:
+        exit(EXIT_SUCCESS);
+    }
+}
+
+/*
+ * Framework handlers
+ */
+
+static int host_bench_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    const struct mod_host_bench_config *config = data;
+
+    if ((config == NULL) || (config->iterations == 0) ||
+        (config->event_batch == 0) || (config->delayed_response_max == 0) ||
+        (element_count == 0))
+        return FWK_E_PARAM;
+
+    host_bench_ctx.config = config;
+    host_bench_ctx.subscriber_max = element_count;
+    host_bench_ctx.parameter = 1;
+    host_bench_ctx.cookie_table =
+        fwk_mm_calloc(config->delayed_response_max, sizeof(uint32_t));
+
+    return FWK_SUCCESS;
+}
+
+static int host_bench_element_init(
+    fwk_id_t element_id,
+    unsigned int sub_element_count,
+    const void *data)
+{
+    return FWK_SUCCESS;
+}
+
+static int host_bench_start(fwk_id_t id)
+{
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+        return FWK_SUCCESS;
+
+    return host_bench_next_step();
+}
+
+static int host_bench_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    if (event->is_response) {
+        /* The responses to the delayed events need no processing */
+        if (fwk_id_get_event_idx(event->id) != HOST_BENCH_EVENT_IDX_ECHO)
+            return FWK_SUCCESS;
+
+        return host_bench_echo_response();
+    }
+
+    switch (fwk_id_get_event_idx(event->id)) {
+    case HOST_BENCH_EVENT_IDX_RUN:
+        return host_bench_run();
+
+    case HOST_BENCH_EVENT_IDX_NOP:
+        return host_bench_nop();
+
+    case HOST_BENCH_EVENT_IDX_ECHO:
+        return FWK_SUCCESS;
+
+    case HOST_BENCH_EVENT_IDX_DELAY:
+        resp_event->is_delayed_response = true;
+        return host_bench_delay(event->cookie);
+
+    default:
+        return FWK_E_PARAM;
+    }
+}
+
+static int host_bench_process_notification(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    return host_bench_fan_out_notification();
+}
+
+const struct fwk_module module_host_bench = {
+    .name = "Host Bench",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .event_count = HOST_BENCH_EVENT_IDX_COUNT,
+    .notification_count = MOD_HOST_BENCH_NOTIFICATION_IDX_COUNT,
+    .init = host_bench_init,
+    .element_init = host_bench_element_init,
+    .start = host_bench_start,
+    .process_event = host_bench_process_event,
+    .process_notification = host_bench_process_notification,
+};
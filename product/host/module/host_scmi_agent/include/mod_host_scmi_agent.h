@@ -0,0 +1,220 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MOD_HOST_SCMI_AGENT_H
+#define MOD_HOST_SCMI_AGENT_H
+
+#include <fwk_id.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupModuleHostScmiAgent SCMI Load Generator
+ *
+ * \brief Emulates SCMI agents sending messages through SMT mailboxes held in
+ *      the memory of the host process.
+ *
+ * \details Each element of the module is an agent owning one SMT channel. The
+ *      module is the driver of the channels: it writes the messages in the
+ *      mailboxes and signals them to the SMT module, which rings the module
+ *      back through ::mod_smt_driver_api::raise_interrupt once the response
+ *      is in the mailbox.
+ *
+ *      Once started, every agent sends the configured number of messages, one
+ *      at a time, picking each message at random from the message table
+ *      according to the weights of its entries. The agents run concurrently,
+ *      so the latency of a message includes the time it waits behind the
+ *      messages of the other agents. An agent sends its next message as soon
+ *      as it gets the response, or after an interval timed by an alarm of the
+ *      \c timer module when ::mod_host_scmi_agent_config::interval_ms is set.
+ *
+ *      When all agents are done, the latency distribution of every message of
+ *      the table is written to the standard output as a line holding a JSON
+ *      object, for example:
+ *
+ *      {"message": "clock_rate_get", "count": 21807, "errors": 0,
+ *       "min_ns": 930, "mean_ns": 1213, "p50_ns": 1279, "p90_ns": 1535,
+ *       "p99_ns": 1535, "max_ns": 91386}
+ *
+ *      where the percentiles are the upper bounds of the histogram buckets
+ *      they fall in, each power of two being split in four buckets. Only the
+ *      count and errors are reported when the firmware runs on virtual time,
+ *      see ::mod_host_scmi_agent_config::virtual_time. A last line gives the
+ *      sustained throughput:
+ *
+ *      {"agents": 4, "messages": 100000, "duration_ns": 36414305,
+ *       "messages_per_second": 2746173}
+ *
+ *      The firmware then exits, after writing the message capture of the
+ *      SCMI module to ::mod_host_scmi_agent_config::capture_file if set.
+ *
+ *      When ::mod_host_scmi_agent_config::replay_file is set, the agents
+ *      replay a message capture of the SCMI module instead, see
+ *      ::mod_scmi_capture_header, typically dumped from the memory of a
+ *      platform with a debugger. Every agent sends the recorded messages of
+ *      the SCMI agent it stands for, see
+ *      ::mod_host_scmi_agent_dev_config::scmi_agent_id, in their recorded
+ *      order, each no earlier than it was received by the platform relative
+ *      to the first message of the capture. The messages whose payload was
+ *      not recorded whole are skipped. The outcome of every message replayed
+ *      is written to the standard output next to the recorded one, for
+ *      example:
+ *
+ *      {"record": 0, "agent": 1, "protocol": 19, "message": 7, "status": 0,
+ *       "latency_ns": 1279, "captured_status": 0, "captured_latency_ns": 2350}
+ *
+ *      where the recorded status is null if the platform had not responded
+ *      yet, and the latency is null when the firmware runs on virtual time.
+ *      A last line sums up the replay:
+ *
+ *      {"records": 256, "replayed": 250, "skipped": 6,
+ *       "status_mismatches": 0, "duration_ns": 412000000}
+ *
+ * \{
+ */
+
+/*!
+ * \brief Message sent by the agents.
+ */
+struct mod_host_scmi_agent_message {
+    /*! Name of the message in the report */
+    const char *name;
+
+    /*! Identifier of the protocol of the message */
+    uint8_t protocol_id;
+
+    /*! Identifier of the message within its protocol */
+    uint8_t message_id;
+
+    /*! Payload of the message, may be NULL if the payload is empty */
+    const uint32_t *payload;
+
+    /*! Size of the payload in bytes */
+    size_t payload_size;
+
+    /*!
+     * \brief Relative frequency of the message.
+     *
+     * \details A message is picked with a probability of its weight over the
+     *      sum of the weights of the table.
+     */
+    unsigned int weight;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_host_scmi_agent_config {
+    /*!
+     * \brief Table of the messages sent by the agents. This pointer may be
+     *      equal to NULL when a capture is replayed.
+     */
+    const struct mod_host_scmi_agent_message *message_table;
+
+    /*! Number of entries in the message table */
+    unsigned int message_count;
+
+    /*! Number of messages sent by each agent */
+    unsigned int message_total;
+
+    /*!
+     * \brief Delay between a response and the next message of an agent, in
+     *      milliseconds.
+     *
+     * \details An agent that never waits keeps the firmware busy, so this must
+     *      be set when the firmware runs on virtual time for the time to move
+     *      forward. It may be 0, in which case the next message is sent at
+     *      once.
+     */
+    unsigned int interval_ms;
+
+    /*!
+     * \brief Path of the message capture to replay, or NULL to send the
+     *      messages of the message table.
+     *
+     * \details The capture must have been recorded by a platform of the same
+     *      endianness. The message table and the number of messages are
+     *      ignored when a capture is replayed. The firmware exits with an
+     *      error when the capture cannot be read or is malformed.
+     */
+    const char *replay_file;
+
+    /*!
+     * \brief Path of the file the message capture of the SCMI module is
+     *      written to once the agents are done, or NULL.
+     *
+     * \details The capture must be enabled in the configuration of the SCMI
+     *      module, see ::mod_scmi_config::capture_record_count. The file can
+     *      then be replayed, see ::mod_host_scmi_agent_config::replay_file.
+     */
+    const char *capture_file;
+
+    /*!
+     * \brief The firmware runs on virtual time.
+     *
+     * \details Virtual time only moves forward while the firmware is idle, so
+     *      the messages are processed in no time and their latency is not
+     *      reported.
+     */
+    bool virtual_time;
+};
+
+/*!
+ * \brief Agent configuration.
+ */
+struct mod_host_scmi_agent_dev_config {
+    /*! Identifier of the SMT channel of the agent */
+    fwk_id_t channel_id;
+
+    /*! Address of the mailbox of the channel */
+    uintptr_t mailbox_address;
+
+    /*! Size of the mailbox of the channel */
+    size_t mailbox_size;
+
+    /*!
+     * \brief Identifier of the alarm timing the messages of the agent.
+     *
+     * \note Only used if ::mod_host_scmi_agent_config::interval_ms is not 0
+     *      or a capture is replayed.
+     */
+    fwk_id_t alarm_id;
+
+    /*!
+     * \brief SCMI identifier of the agent, selecting the messages it sends
+     *      when a capture is replayed.
+     */
+    unsigned int scmi_agent_id;
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_host_scmi_agent_api_idx {
+    /*! SMT driver API, see ::mod_smt_driver_api */
+    MOD_HOST_SCMI_AGENT_API_IDX_SMT_DRIVER,
+
+    /*! Number of defined APIs */
+    MOD_HOST_SCMI_AGENT_API_IDX_COUNT,
+};
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_HOST_SCMI_AGENT_H */
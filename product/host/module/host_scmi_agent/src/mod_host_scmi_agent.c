@@ -0,0 +1,864 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI load generator.
+ */
+
+#include <internal/smt.h>
+
+#include <mod_host_scmi_agent.h>
+#include <mod_scmi.h>
+#include <mod_scmi_header.h>
+#include <mod_scmi_std.h>
+#include <mod_smt.h>
+#include <mod_timer.h>
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_io.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+#include <fwk_time.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The latency histograms split every power of two in four buckets of equal
+ * width, latencies below 4 ns having a bucket each.
+ */
+#define HOST_SCMI_AGENT_SUB_BUCKET_BITS 2
+#define HOST_SCMI_AGENT_SUB_BUCKET_COUNT (1U << HOST_SCMI_AGENT_SUB_BUCKET_BITS)
+
+/* Number of buckets of the latency histograms, covering up to 2^41 ns */
+#define HOST_SCMI_AGENT_BUCKET_COUNT (40 * HOST_SCMI_AGENT_SUB_BUCKET_COUNT)
+
+/* Largest capture replayed, in records and in payload bytes kept per record */
+#define HOST_SCMI_AGENT_RECORD_COUNT_MAX (1U << 20)
+#define HOST_SCMI_AGENT_RECORD_PAYLOAD_MAX 4096U
+
+enum host_scmi_agent_event_idx {
+    /* Send the next message of an agent */
+    HOST_SCMI_AGENT_EVENT_IDX_SEND,
+
+    HOST_SCMI_AGENT_EVENT_IDX_COUNT,
+};
+
+/* Latency distribution of a message */
+struct host_scmi_agent_stats {
+    /* Number of responses received */
+    unsigned int count;
+
+    /* Number of responses with an error status */
+    unsigned int errors;
+
+    /* Shortest latency */
+    fwk_duration_ns_t min;
+
+    /* Longest latency */
+    fwk_duration_ns_t max;
+
+    /* Sum of the latencies */
+    fwk_duration_ns_t total;
+
+    /* Number of latencies falling in each bucket */
+    unsigned int histogram[HOST_SCMI_AGENT_BUCKET_COUNT];
+};
+
+/* Outcome of the replay of a record of the capture */
+struct host_scmi_agent_result {
+    /* The message of the record was sent and responded to */
+    bool replayed;
+
+    /* Status of the response */
+    int32_t status;
+
+    /* Latency of the response */
+    fwk_duration_ns_t latency;
+};
+
+struct host_scmi_agent_dev_ctx {
+    /* Agent configuration */
+    const struct mod_host_scmi_agent_dev_config *config;
+
+    /* Mailbox of the channel of the agent */
+    struct mod_smt_memory *mailbox;
+
+    /* SMT driver input API */
+    const struct mod_smt_driver_input_api *smt_api;
+
+    /* Alarm API, if the messages are timed */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* State of the pseudo-random generator picking the messages */
+    uint32_t seed;
+
+    /* Number of messages sent */
+    unsigned int sent;
+
+    /* Index in the message table of the message in flight */
+    unsigned int message_idx;
+
+    /* Time the message in flight was sent at */
+    fwk_timestamp_t start;
+
+    /* Index of the record in flight or to send next, if replaying */
+    uint32_t record_idx;
+};
+
+struct host_scmi_agent_ctx {
+    /* Module configuration */
+    const struct mod_host_scmi_agent_config *config;
+
+    /* Table of agent contexts */
+    struct host_scmi_agent_dev_ctx *dev_ctx_table;
+
+    /* Number of agents */
+    unsigned int agent_count;
+
+    /* Number of agents that sent all their messages */
+    unsigned int agent_done;
+
+    /* Sum of the weights of the message table */
+    unsigned int weight_total;
+
+    /* Latency distribution of each message of the message table */
+    struct host_scmi_agent_stats *stats_table;
+
+    /* Time the agents started at */
+    fwk_timestamp_t start;
+
+    /* Capture replayed by the agents, NULL when the message table is used */
+    struct mod_scmi_capture_header *capture;
+
+    /* Sequence number of the oldest record of the capture */
+    uint32_t first_sequence;
+
+    /* Number of records of the capture */
+    uint32_t record_total;
+
+    /* Outcome of the replay of each record of the capture */
+    struct host_scmi_agent_result *result_table;
+
+    /* SCMI message capture API, bound when the capture is dumped */
+    const struct mod_scmi_capture_api *capture_api;
+};
+
+static struct host_scmi_agent_ctx host_scmi_agent_ctx;
+
+/*
+ * Static helpers
+ */
+
+static unsigned int host_scmi_agent_bucket(fwk_duration_ns_t latency)
+{
+    unsigned int msb;
+    unsigned int bucket;
+
+    if (latency < HOST_SCMI_AGENT_SUB_BUCKET_COUNT)
+        return (unsigned int)latency;
+
+    msb = 63 - __builtin_clzll(latency);
+    bucket = ((msb - HOST_SCMI_AGENT_SUB_BUCKET_BITS + 1) *
+              HOST_SCMI_AGENT_SUB_BUCKET_COUNT) +
+        ((latency >> (msb - HOST_SCMI_AGENT_SUB_BUCKET_BITS)) &
+         (HOST_SCMI_AGENT_SUB_BUCKET_COUNT - 1));
+
+    return (bucket < HOST_SCMI_AGENT_BUCKET_COUNT) ?
+        bucket :
+        HOST_SCMI_AGENT_BUCKET_COUNT - 1;
+}
+
+static uint64_t host_scmi_agent_bucket_bound(unsigned int bucket)
+{
+    unsigned int shift;
+    uint64_t lower;
+
+    if (bucket < HOST_SCMI_AGENT_SUB_BUCKET_COUNT)
+        return bucket;
+
+    shift = (bucket / HOST_SCMI_AGENT_SUB_BUCKET_COUNT) - 1;
+    lower = (uint64_t)(HOST_SCMI_AGENT_SUB_BUCKET_COUNT +
+                       (bucket % HOST_SCMI_AGENT_SUB_BUCKET_COUNT))
+        << shift;
+
+    return lower + (UINT64_C(1) << shift) - 1;
+}
+
+/* Upper bound of the bucket holding the given percentile of a distribution */
+static uint64_t host_scmi_agent_percentile(
+    const struct host_scmi_agent_stats *stats,
+    unsigned int percentile)
+{
+    uint64_t rank = ((uint64_t)stats->count * percentile + 99) / 100;
+    uint64_t seen = 0;
+    uint64_t bound;
+    unsigned int bucket;
+
+    for (bucket = 0; bucket < (HOST_SCMI_AGENT_BUCKET_COUNT - 1); bucket++) {
+        seen += stats->histogram[bucket];
+        if (seen >= rank)
+            break;
+    }
+
+    bound = host_scmi_agent_bucket_bound(bucket);
+
+    return (bound > stats->max) ? stats->max : bound;
+}
+
+static void host_scmi_agent_report(void)
+{
+    const struct mod_host_scmi_agent_config *config =
+        host_scmi_agent_ctx.config;
+    const struct host_scmi_agent_stats *stats;
+    fwk_duration_ns_t duration;
+    uint64_t messages = 0;
+    unsigned int idx;
+
+    duration =
+        fwk_time_duration(host_scmi_agent_ctx.start, fwk_time_current());
+
+    for (idx = 0; idx < config->message_count; idx++) {
+        stats = &host_scmi_agent_ctx.stats_table[idx];
+        messages += stats->count;
+
+        if (stats->count == 0)
+            continue;
+
+        if (config->virtual_time) {
+            fwk_io_printf(
+                fwk_io_stdout,
+                "{\"message\": \"%s\", \"count\": %u, \"errors\": %u}\n",
+                config->message_table[idx].name,
+                stats->count,
+                stats->errors);
+            continue;
+        }
+
+        fwk_io_printf(
+            fwk_io_stdout,
+            "{\"message\": \"%s\", \"count\": %u, \"errors\": %u, "
+            "\"min_ns\": %" PRIu64 ", \"mean_ns\": %" PRIu64 ", "
+            "\"p50_ns\": %" PRIu64 ", \"p90_ns\": %" PRIu64 ", "
+            "\"p99_ns\": %" PRIu64 ", \"max_ns\": %" PRIu64 "}\n",
+            config->message_table[idx].name,
+            stats->count,
+            stats->errors,
+            (uint64_t)stats->min,
+            (uint64_t)(stats->total / stats->count),
+            host_scmi_agent_percentile(stats, 50),
+            host_scmi_agent_percentile(stats, 90),
+            host_scmi_agent_percentile(stats, 99),
+            (uint64_t)stats->max);
+    }
+
+    fwk_io_printf(
+        fwk_io_stdout,
+        "{\"agents\": %u, \"messages\": %" PRIu64 ", "
+        "\"duration_ns\": %" PRIu64 ", \"messages_per_second\": %" PRIu64
+        "}\n",
+        host_scmi_agent_ctx.agent_count,
+        messages,
+        (uint64_t)duration,
+        (duration == 0) ? 0 : (messages * UINT64_C(1000000000)) / duration);
+}
+
+static const struct mod_scmi_capture_record *host_scmi_agent_record(
+    uint32_t record_idx)
+{
+    const struct mod_scmi_capture_header *capture = host_scmi_agent_ctx.capture;
+    uint32_t sequence = host_scmi_agent_ctx.first_sequence + record_idx;
+
+    return (const struct mod_scmi_capture_record *)(
+        (uintptr_t)(capture + 1) +
+        ((sequence & (capture->record_count - 1)) * capture->record_size));
+}
+
+static void host_scmi_agent_replay_report(void)
+{
+    const struct host_scmi_agent_result *result;
+    const struct mod_scmi_capture_record *record;
+    unsigned int replayed = 0;
+    unsigned int mismatches = 0;
+    uint32_t idx;
+
+    for (idx = 0; idx < host_scmi_agent_ctx.record_total; idx++) {
+        result = &host_scmi_agent_ctx.result_table[idx];
+        if (!result->replayed)
+            continue;
+
+        record = host_scmi_agent_record(idx);
+        replayed++;
+
+        fwk_io_printf(
+            fwk_io_stdout,
+            "{\"record\": %" PRIu32 ", \"agent\": %u, \"protocol\": %u, "
+            "\"message\": %u, \"status\": %" PRId32 ", \"latency_ns\": ",
+            idx,
+            (unsigned int)record->agent_id,
+            (unsigned int)((record->message_header &
+                            SCMI_MESSAGE_HEADER_PROTOCOL_ID_MASK) >>
+                           SCMI_MESSAGE_HEADER_PROTOCOL_ID_POS),
+            (unsigned int)((record->message_header &
+                            SCMI_MESSAGE_HEADER_MESSAGE_ID_MASK) >>
+                           SCMI_MESSAGE_HEADER_MESSAGE_ID_POS),
+            result->status);
+
+        if (host_scmi_agent_ctx.config->virtual_time) {
+            fwk_io_printf(fwk_io_stdout, "null, ");
+        } else {
+            fwk_io_printf(
+                fwk_io_stdout, "%" PRIu64 ", ", (uint64_t)result->latency);
+        }
+
+        if (!(record->flags & MOD_SCMI_CAPTURE_FLAG_RESPONDED)) {
+            fwk_io_printf(
+                fwk_io_stdout,
+                "\"captured_status\": null, \"captured_latency_ns\": null}\n");
+            continue;
+        }
+
+        if (record->status != result->status)
+            mismatches++;
+
+        fwk_io_printf(
+            fwk_io_stdout,
+            "\"captured_status\": %" PRId32
+            ", \"captured_latency_ns\": %" PRIu32 "}\n",
+            record->status,
+            record->latency);
+    }
+
+    fwk_io_printf(
+        fwk_io_stdout,
+        "{\"records\": %" PRIu32 ", \"replayed\": %u, \"skipped\": %" PRIu32
+        ", \"status_mismatches\": %u, \"duration_ns\": %" PRIu64 "}\n",
+        host_scmi_agent_ctx.record_total,
+        replayed,
+        host_scmi_agent_ctx.record_total - replayed,
+        mismatches,
+        (uint64_t)fwk_time_duration(
+            host_scmi_agent_ctx.start, fwk_time_current()));
+}
+
+static int host_scmi_agent_load_capture(const char *path)
+{
+    struct mod_scmi_capture_header header;
+    struct mod_scmi_capture_header *capture = NULL;
+    long file_size;
+    size_t size;
+    FILE *file;
+
+    file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(
+            stderr,
+            "[HOST SCMI] Cannot open the capture %s: %s\n",
+            path,
+            strerror(errno));
+
+        return FWK_E_PARAM;
+    }
+
+    if ((fseek(file, 0, SEEK_END) != 0) || ((file_size = ftell(file)) < 0) ||
+        (fseek(file, 0, SEEK_SET) != 0) ||
+        (fread(&header, sizeof(header), 1, file) != 1))
+        goto error;
+
+    /* The header must be checked before its sizes are used */
+    if ((header.signature != MOD_SCMI_CAPTURE_SIGNATURE) ||
+        (header.sequence == 0) || (header.record_count == 0) ||
+        (header.record_count > HOST_SCMI_AGENT_RECORD_COUNT_MAX) ||
+        ((header.record_count & (header.record_count - 1)) != 0) ||
+        (header.record_size < sizeof(struct mod_scmi_capture_record)) ||
+        (header.record_size > (sizeof(struct mod_scmi_capture_record) +
+                               HOST_SCMI_AGENT_RECORD_PAYLOAD_MAX)))
+        goto error;
+
+    size = mod_scmi_capture_size(
+        header.record_count,
+        header.record_size - sizeof(struct mod_scmi_capture_record));
+    if ((unsigned long)file_size != size)
+        goto error;
+
+    capture = fwk_mm_alloc(1, size);
+    *capture = header;
+
+    if (fread(capture + 1, size - sizeof(header), 1, file) != 1)
+        goto error;
+
+    fclose(file);
+
+    host_scmi_agent_ctx.capture = capture;
+    host_scmi_agent_ctx.record_total =
+        FWK_MIN(header.sequence, header.record_count);
+    host_scmi_agent_ctx.first_sequence =
+        header.sequence - host_scmi_agent_ctx.record_total;
+    host_scmi_agent_ctx.result_table = fwk_mm_calloc(
+        host_scmi_agent_ctx.record_total,
+        sizeof(struct host_scmi_agent_result));
+
+    return FWK_SUCCESS;
+
+error:
+    fclose(file);
+    fwk_mm_free(capture);
+    fprintf(stderr, "[HOST SCMI] Invalid capture %s\n", path);
+
+    return FWK_E_DATA;
+}
+
+/* Write the message capture of the SCMI module to a file */
+static int host_scmi_agent_dump_capture(const char *path)
+{
+    const struct mod_scmi_capture_header *capture;
+    size_t size;
+    FILE *file;
+    int status;
+
+    status = host_scmi_agent_ctx.capture_api->get_capture(&capture, &size);
+    if (status != FWK_SUCCESS) {
+        fprintf(stderr, "[HOST SCMI] The SCMI capture is disabled\n");
+
+        return status;
+    }
+
+    file = fopen(path, "wb");
+    if (file == NULL)
+        goto error;
+
+    if (fwrite(capture, size, 1, file) != 1) {
+        fclose(file);
+        goto error;
+    }
+
+    if (fclose(file) != 0)
+        goto error;
+
+    return FWK_SUCCESS;
+
+error:
+    fprintf(
+        stderr,
+        "[HOST SCMI] Cannot write the capture %s: %s\n",
+        path,
+        strerror(errno));
+
+    return FWK_E_DEVICE;
+}
+
+/* Pick the next message of an agent according to the weights of the table */
+static unsigned int host_scmi_agent_pick(struct host_scmi_agent_dev_ctx *ctx)
+{
+    const struct mod_host_scmi_agent_config *config =
+        host_scmi_agent_ctx.config;
+    unsigned int draw;
+    unsigned int idx;
+
+    /* xorshift32 */
+    ctx->seed ^= ctx->seed << 13;
+    ctx->seed ^= ctx->seed >> 17;
+    ctx->seed ^= ctx->seed << 5;
+
+    draw = ctx->seed % host_scmi_agent_ctx.weight_total;
+
+    for (idx = 0; draw >= config->message_table[idx].weight; idx++)
+        draw -= config->message_table[idx].weight;
+
+    return idx;
+}
+
+static int host_scmi_agent_put_send(fwk_id_t agent_id)
+{
+    struct fwk_event event = {
+        .source_id = agent_id,
+        .target_id = agent_id,
+        .id = FWK_ID_EVENT(
+            FWK_MODULE_IDX_HOST_SCMI_AGENT, HOST_SCMI_AGENT_EVENT_IDX_SEND),
+    };
+
+    return fwk_thread_put_event(&event);
+}
+
+static int host_scmi_agent_write(
+    struct host_scmi_agent_dev_ctx *ctx,
+    uint32_t message_header,
+    const void *payload,
+    size_t payload_size)
+{
+    struct mod_smt_memory *mailbox = ctx->mailbox;
+
+    /* The platform must have freed the mailbox before it can be written */
+    if (!(mailbox->status & MOD_SMT_MAILBOX_STATUS_FREE_MASK))
+        return FWK_E_STATE;
+
+    mailbox->message_header = message_header;
+    mailbox->length = sizeof(mailbox->message_header) + payload_size;
+    mailbox->flags = MOD_SMT_MAILBOX_FLAGS_IENABLED_MASK;
+
+    if (payload_size != 0)
+        memcpy(mailbox->payload, payload, payload_size);
+
+    mailbox->status &= ~MOD_SMT_MAILBOX_STATUS_FREE_MASK;
+
+    ctx->start = fwk_time_current();
+
+    return ctx->smt_api->signal_message(ctx->config->channel_id);
+}
+
+static int host_scmi_agent_send(struct host_scmi_agent_dev_ctx *ctx)
+{
+    const struct mod_host_scmi_agent_message *message;
+    const struct mod_scmi_capture_record *record;
+
+    if (host_scmi_agent_ctx.capture != NULL) {
+        record = host_scmi_agent_record(ctx->record_idx);
+
+        return host_scmi_agent_write(
+            ctx, record->message_header, record + 1, record->payload_size);
+    }
+
+    ctx->message_idx = host_scmi_agent_pick(ctx);
+    message = &host_scmi_agent_ctx.config->message_table[ctx->message_idx];
+
+    return host_scmi_agent_write(
+        ctx,
+        ((uint32_t)message->message_id << SCMI_MESSAGE_HEADER_MESSAGE_ID_POS) |
+            ((uint32_t)message->protocol_id
+             << SCMI_MESSAGE_HEADER_PROTOCOL_ID_POS) |
+            (((uint32_t)ctx->sent << SCMI_MESSAGE_HEADER_TOKEN_POS) &
+             SCMI_MESSAGE_HEADER_TOKEN_MASK),
+        message->payload,
+        message->payload_size);
+}
+
+static void host_scmi_agent_alarm_callback(uintptr_t element_idx)
+{
+    int status;
+
+    status = host_scmi_agent_put_send(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_HOST_SCMI_AGENT, element_idx));
+    fwk_check(status == FWK_SUCCESS);
+}
+
+static int host_scmi_agent_done(void)
+{
+    const char *capture_file = host_scmi_agent_ctx.config->capture_file;
+
+    if (++host_scmi_agent_ctx.agent_done == host_scmi_agent_ctx.agent_count) {
+        if ((capture_file != NULL) &&
+            (host_scmi_agent_dump_capture(capture_file) != FWK_SUCCESS))
+            exit(EXIT_FAILURE);
+
+        if (host_scmi_agent_ctx.capture != NULL)
+            host_scmi_agent_replay_report();
+        else
+            host_scmi_agent_report();
+
+        exit(EXIT_SUCCESS);
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Send the next record of the capture of the SCMI agent the agent stands for,
+ * once as much time has elapsed since the start of the replay as had elapsed
+ * between the first message of the capture and this record.
+ */
+static int host_scmi_agent_replay_next(fwk_id_t agent_id)
+{
+    struct host_scmi_agent_dev_ctx *ctx;
+    const struct mod_scmi_capture_record *first;
+    const struct mod_scmi_capture_record *record = NULL;
+    size_t kept_size;
+    size_t max_size;
+    fwk_timestamp_t due;
+    fwk_timestamp_t now;
+
+    ctx = &host_scmi_agent_ctx.dev_ctx_table[fwk_id_get_element_idx(agent_id)];
+
+    kept_size = host_scmi_agent_ctx.capture->record_size - sizeof(*record);
+    max_size = ctx->config->mailbox_size - sizeof(struct mod_smt_memory);
+
+    for (; ctx->record_idx < host_scmi_agent_ctx.record_total;
+         ctx->record_idx++) {
+        record = host_scmi_agent_record(ctx->record_idx);
+
+        /* The messages whose payload is incomplete are skipped */
+        if ((record->agent_id == ctx->config->scmi_agent_id) &&
+            (record->payload_size <= FWK_MIN(kept_size, max_size)))
+            break;
+    }
+
+    if (ctx->record_idx == host_scmi_agent_ctx.record_total)
+        return host_scmi_agent_done();
+
+    first = host_scmi_agent_record(0);
+
+    due = host_scmi_agent_ctx.start;
+    if (record->timestamp > first->timestamp)
+        due += record->timestamp - first->timestamp;
+
+    now = fwk_time_current();
+    if (due <= now)
+        return host_scmi_agent_put_send(agent_id);
+
+    return ctx->alarm_api->start(
+        ctx->config->alarm_id,
+        (unsigned int)((due - now + UINT64_C(999999)) / UINT64_C(1000000)),
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        host_scmi_agent_alarm_callback,
+        fwk_id_get_element_idx(agent_id));
+}
+
+/*
+ * SMT driver API
+ */
+
+static int host_scmi_agent_raise_interrupt(fwk_id_t agent_id)
+{
+    struct host_scmi_agent_dev_ctx *ctx;
+    struct host_scmi_agent_stats *stats;
+    struct host_scmi_agent_result *result;
+    fwk_duration_ns_t latency;
+
+    ctx = &host_scmi_agent_ctx.dev_ctx_table[fwk_id_get_element_idx(agent_id)];
+    latency = fwk_time_duration(ctx->start, fwk_time_current());
+
+    if (host_scmi_agent_ctx.capture != NULL) {
+        result = &host_scmi_agent_ctx.result_table[ctx->record_idx++];
+        result->replayed = true;
+        result->latency = latency;
+        result->status =
+            (ctx->mailbox->length > sizeof(ctx->mailbox->message_header)) ?
+            (int32_t)ctx->mailbox->payload[0] :
+            SCMI_PROTOCOL_ERROR;
+
+        return host_scmi_agent_replay_next(agent_id);
+    }
+
+    stats = &host_scmi_agent_ctx.stats_table[ctx->message_idx];
+    stats->count++;
+    stats->total += latency;
+    stats->min = ((stats->count == 1) || (latency < stats->min)) ?
+        latency :
+        stats->min;
+    stats->max = (latency > stats->max) ? latency : stats->max;
+
+    stats->histogram[host_scmi_agent_bucket(latency)]++;
+
+    if ((ctx->mailbox->status & MOD_SMT_MAILBOX_STATUS_ERROR_MASK) ||
+        (ctx->mailbox->length <= sizeof(ctx->mailbox->message_header)) ||
+        ((int32_t)ctx->mailbox->payload[0] != SCMI_SUCCESS))
+        stats->errors++;
+
+    /*
+     * The response is signalled from within the SMT module, the next message
+     * is sent from an event rather than from this call.
+     */
+    if (++ctx->sent < host_scmi_agent_ctx.config->message_total) {
+        if (host_scmi_agent_ctx.config->interval_ms == 0)
+            return host_scmi_agent_put_send(agent_id);
+
+        return ctx->alarm_api->start(
+            ctx->config->alarm_id,
+            host_scmi_agent_ctx.config->interval_ms,
+            MOD_TIMER_ALARM_TYPE_ONCE,
+            host_scmi_agent_alarm_callback,
+            fwk_id_get_element_idx(agent_id));
+    }
+
+    return host_scmi_agent_done();
+}
+
+static const struct mod_smt_driver_api host_scmi_agent_smt_driver_api = {
+    .raise_interrupt = host_scmi_agent_raise_interrupt,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int host_scmi_agent_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    const struct mod_host_scmi_agent_config *config = data;
+    unsigned int idx;
+    int status;
+
+    if ((config == NULL) || (element_count == 0))
+        return FWK_E_PARAM;
+
+    if (config->replay_file != NULL) {
+        /* The firmware has nothing to do without its capture */
+        status = host_scmi_agent_load_capture(config->replay_file);
+        if (status != FWK_SUCCESS)
+            exit(EXIT_FAILURE);
+    } else {
+        if ((config->message_table == NULL) || (config->message_count == 0) ||
+            (config->message_total == 0))
+            return FWK_E_PARAM;
+
+        for (idx = 0; idx < config->message_count; idx++) {
+            host_scmi_agent_ctx.weight_total +=
+                config->message_table[idx].weight;
+        }
+
+        if (host_scmi_agent_ctx.weight_total == 0)
+            return FWK_E_PARAM;
+    }
+
+    host_scmi_agent_ctx.config = config;
+    host_scmi_agent_ctx.agent_count = element_count;
+    host_scmi_agent_ctx.dev_ctx_table =
+        fwk_mm_calloc(element_count, sizeof(struct host_scmi_agent_dev_ctx));
+    if (config->message_count != 0) {
+        host_scmi_agent_ctx.stats_table = fwk_mm_calloc(
+            config->message_count, sizeof(struct host_scmi_agent_stats));
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int host_scmi_agent_element_init(
+    fwk_id_t element_id,
+    unsigned int sub_element_count,
+    const void *data)
+{
+    const struct mod_host_scmi_agent_dev_config *config = data;
+    const struct mod_host_scmi_agent_message *message_table;
+    struct host_scmi_agent_dev_ctx *ctx;
+    unsigned int element_idx = fwk_id_get_element_idx(element_id);
+    unsigned int idx;
+
+    if ((config->mailbox_address == 0) ||
+        (config->mailbox_size < sizeof(struct mod_smt_memory)))
+        return FWK_E_DATA;
+
+    /* Every message and every response must fit in the mailbox */
+    message_table = host_scmi_agent_ctx.config->message_table;
+    for (idx = 0; idx < host_scmi_agent_ctx.config->message_count; idx++) {
+        if (message_table[idx].payload_size >
+            (config->mailbox_size - sizeof(struct mod_smt_memory)))
+            return FWK_E_DATA;
+    }
+
+    ctx = &host_scmi_agent_ctx.dev_ctx_table[element_idx];
+    ctx->config = config;
+    ctx->mailbox = (struct mod_smt_memory *)config->mailbox_address;
+    ctx->seed = 2463534242UL + element_idx;
+
+    return FWK_SUCCESS;
+}
+
+static int host_scmi_agent_bind(fwk_id_t id, unsigned int round)
+{
+    struct host_scmi_agent_dev_ctx *ctx;
+    int status;
+
+    if (round == 0)
+        return FWK_SUCCESS;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        if (host_scmi_agent_ctx.config->capture_file == NULL)
+            return FWK_SUCCESS;
+
+        return fwk_module_bind(
+            FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+            FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_CAPTURE),
+            &host_scmi_agent_ctx.capture_api);
+    }
+
+    /* The SMT module only accepts the binding once it has bound to us */
+
+    ctx = &host_scmi_agent_ctx.dev_ctx_table[fwk_id_get_element_idx(id)];
+
+    status = fwk_module_bind(
+        ctx->config->channel_id,
+        FWK_ID_API(FWK_MODULE_IDX_SMT, MOD_SMT_API_IDX_DRIVER_INPUT),
+        &ctx->smt_api);
+    if ((status != FWK_SUCCESS) ||
+        ((host_scmi_agent_ctx.config->interval_ms == 0) &&
+         (host_scmi_agent_ctx.capture == NULL)))
+        return status;
+
+    return fwk_module_bind(
+        ctx->config->alarm_id, MOD_TIMER_API_ID_ALARM, &ctx->alarm_api);
+}
+
+static int host_scmi_agent_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    if (!fwk_id_is_equal(
+            api_id,
+            FWK_ID_API(
+                FWK_MODULE_IDX_HOST_SCMI_AGENT,
+                MOD_HOST_SCMI_AGENT_API_IDX_SMT_DRIVER)))
+        return FWK_E_ACCESS;
+
+    *api = &host_scmi_agent_smt_driver_api;
+
+    return FWK_SUCCESS;
+}
+
+static int host_scmi_agent_start(fwk_id_t id)
+{
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        host_scmi_agent_ctx.start = fwk_time_current();
+
+        return FWK_SUCCESS;
+    }
+
+    if (host_scmi_agent_ctx.capture != NULL)
+        return host_scmi_agent_replay_next(id);
+
+    return host_scmi_agent_put_send(id);
+}
+
+static int host_scmi_agent_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    struct host_scmi_agent_dev_ctx *ctx;
+
+    if (fwk_id_get_event_idx(event->id) != HOST_SCMI_AGENT_EVENT_IDX_SEND)
+        return FWK_E_PARAM;
+
+    ctx = &host_scmi_agent_ctx
+               .dev_ctx_table[fwk_id_get_element_idx(event->target_id)];
+
+    return host_scmi_agent_send(ctx);
+}
+
+const struct fwk_module module_host_scmi_agent = {
+    .name = "Host SCMI Agent",
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = MOD_HOST_SCMI_AGENT_API_IDX_COUNT,
+    .event_count = HOST_SCMI_AGENT_EVENT_IDX_COUNT,
+    .init = host_scmi_agent_init,
+    .element_init = host_scmi_agent_element_init,
+    .bind = host_scmi_agent_bind,
+    .process_bind_request = host_scmi_agent_process_bind_request,
+    .start = host_scmi_agent_start,
+    .process_event = host_scmi_agent_process_event,
+};
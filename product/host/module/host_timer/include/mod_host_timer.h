@@ -0,0 +1,93 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MOD_HOST_TIMER_H
+#define MOD_HOST_TIMER_H
+
+#include <fwk_thread.h>
+#include <fwk_time.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * \{
+ */
+
+/*!
+ * \defgroup GroupModuleHostTimer Virtual-Time Timer
+ *
+ * \brief Timer driver counting virtual time on the host.
+ *
+ * \details The counter of the timers only moves forward when the firmware is
+ *      idle, and then jumps straight to the earliest deadline programmed in
+ *      the timers, raising their interrupts. The firmware therefore takes no
+ *      time at all to process its events, and a scenario running on virtual
+ *      time gives the same timings on every run however long the delays it
+ *      waits for, without ever sleeping.
+ *
+ *      The timers all share a counter of the nanoseconds elapsed since the
+ *      start of the firmware. The driver is to be registered as the framework
+ *      time driver with ::mod_host_timer_driver() and as the framework idle
+ *      driver with ::mod_host_timer_idle_driver(), the elements of the module
+ *      being used as drivers of the \c timer module.
+ *
+ *      Once the firmware is idle with no deadline programmed, nothing can ever
+ *      wake it up again, so the idle driver ends the firmware.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Frequency of the virtual counter, in Hertz.
+ */
+#define MOD_HOST_TIMER_FREQUENCY UINT32_C(1000000000)
+
+/*!
+ * \brief Timer configuration.
+ */
+struct mod_host_timer_dev_config {
+    /*! Interrupt raised when the counter reaches the deadline of the timer */
+    unsigned int timer_irq;
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_host_timer_api_idx {
+    /*! Timer driver API, see ::mod_timer_driver_api */
+    MOD_HOST_TIMER_API_IDX_DRIVER,
+
+    /*! Number of defined APIs */
+    MOD_HOST_TIMER_API_IDX_COUNT,
+};
+
+/*!
+ * \brief Get the framework time driver reading the virtual counter.
+ *
+ * \param[out] ctx Pointer to storage for the context passed to the driver.
+ *
+ * \return Framework time driver.
+ */
+struct fwk_time_driver mod_host_timer_driver(const void **ctx);
+
+/*!
+ * \brief Get the framework idle driver moving the virtual counter forward.
+ *
+ * \param[out] ctx Pointer to storage for the context passed to the driver.
+ *
+ * \return Framework idle driver.
+ */
+struct fwk_thread_idle_driver mod_host_timer_idle_driver(const void **ctx);
+
+/*!
+ * \}
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_HOST_TIMER_H */
@@ -0,0 +1,241 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Virtual-time timer driver.
+ */
+
+#include <mod_host_timer.h>
+#include <mod_timer.h>
+
+#include <fwk_id.h>
+#include <fwk_interrupt.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+#include <fwk_thread.h>
+#include <fwk_time.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+struct host_timer_dev_ctx {
+    /* Timer configuration */
+    const struct mod_host_timer_dev_config *config;
+
+    /* Counter value the interrupt of the timer is raised at */
+    uint64_t deadline;
+
+    /* Whether the interrupt of the timer is enabled */
+    bool enabled;
+};
+
+struct host_timer_ctx {
+    /* Virtual counter, in nanoseconds */
+    uint64_t counter;
+
+    /* Table of timer contexts */
+    struct host_timer_dev_ctx *dev_ctx_table;
+
+    /* Number of timers */
+    unsigned int dev_count;
+};
+
+/* The counter is read by the framework before the module is initialized */
+static struct host_timer_ctx host_timer_ctx;
+
+static struct host_timer_dev_ctx *host_timer_get_ctx(fwk_id_t dev_id)
+{
+    return &host_timer_ctx.dev_ctx_table[fwk_id_get_element_idx(dev_id)];
+}
+
+/* Raise the interrupt of a timer if its deadline is reached */
+static void host_timer_check(struct host_timer_dev_ctx *ctx)
+{
+    if (ctx->enabled && (ctx->deadline <= host_timer_ctx.counter))
+        fwk_interrupt_set_pending(ctx->config->timer_irq);
+}
+
+/*
+ * Timer driver API
+ */
+
+static int host_timer_enable(fwk_id_t dev_id)
+{
+    struct host_timer_dev_ctx *ctx = host_timer_get_ctx(dev_id);
+
+    ctx->enabled = true;
+    host_timer_check(ctx);
+
+    return FWK_SUCCESS;
+}
+
+static int host_timer_disable(fwk_id_t dev_id)
+{
+    host_timer_get_ctx(dev_id)->enabled = false;
+
+    return FWK_SUCCESS;
+}
+
+static int host_timer_set_timer(fwk_id_t dev_id, uint64_t timestamp)
+{
+    struct host_timer_dev_ctx *ctx = host_timer_get_ctx(dev_id);
+
+    ctx->deadline = timestamp;
+    host_timer_check(ctx);
+
+    return FWK_SUCCESS;
+}
+
+static int host_timer_get_timer(fwk_id_t dev_id, uint64_t *timestamp)
+{
+    *timestamp = host_timer_get_ctx(dev_id)->deadline;
+
+    return FWK_SUCCESS;
+}
+
+static int host_timer_get_counter(fwk_id_t dev_id, uint64_t *value)
+{
+    *value = host_timer_ctx.counter;
+
+    return FWK_SUCCESS;
+}
+
+static int host_timer_get_frequency(fwk_id_t dev_id, uint32_t *value)
+{
+    *value = MOD_HOST_TIMER_FREQUENCY;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_timer_driver_api host_timer_driver_api = {
+    .name = "Host Timer",
+    .enable = host_timer_enable,
+    .disable = host_timer_disable,
+    .set_timer = host_timer_set_timer,
+    .get_timer = host_timer_get_timer,
+    .get_counter = host_timer_get_counter,
+    .get_frequency = host_timer_get_frequency,
+};
+
+/*
+ * Framework time and idle drivers
+ */
+
+static fwk_timestamp_t host_timer_timestamp(const void *ctx)
+{
+    return (fwk_timestamp_t)host_timer_ctx.counter;
+}
+
+struct fwk_time_driver mod_host_timer_driver(const void **ctx)
+{
+    *ctx = NULL;
+
+    return (struct fwk_time_driver){
+        .timestamp = host_timer_timestamp,
+    };
+}
+
+static void host_timer_idle(const void *ctx)
+{
+    struct host_timer_dev_ctx *dev_ctx;
+    uint64_t deadline = UINT64_MAX;
+    bool armed = false;
+    unsigned int idx;
+
+    for (idx = 0; idx < host_timer_ctx.dev_count; idx++) {
+        dev_ctx = &host_timer_ctx.dev_ctx_table[idx];
+
+        if (dev_ctx->enabled && (dev_ctx->deadline <= deadline)) {
+            deadline = dev_ctx->deadline;
+            armed = true;
+        }
+    }
+
+    /* Nothing is left to wake the firmware up, the scenario is over */
+    if (!armed)
+        exit(EXIT_SUCCESS);
+
+    if (deadline > host_timer_ctx.counter)
+        host_timer_ctx.counter = deadline;
+
+    /*
+     * The interrupts are globally disabled while the firmware is idle, they
+     * are handled as soon as the idle driver returns.
+     */
+    for (idx = 0; idx < host_timer_ctx.dev_count; idx++)
+        host_timer_check(&host_timer_ctx.dev_ctx_table[idx]);
+}
+
+struct fwk_thread_idle_driver mod_host_timer_idle_driver(const void **ctx)
+{
+    *ctx = NULL;
+
+    return (struct fwk_thread_idle_driver){
+        .idle = host_timer_idle,
+    };
+}
+
+/*
+ * Framework handlers
+ */
+
+static int host_timer_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    if (element_count == 0)
+        return FWK_E_PARAM;
+
+    host_timer_ctx.dev_ctx_table =
+        fwk_mm_calloc(element_count, sizeof(struct host_timer_dev_ctx));
+    host_timer_ctx.dev_count = element_count;
+
+    return FWK_SUCCESS;
+}
+
+static int host_timer_element_init(
+    fwk_id_t element_id,
+    unsigned int sub_element_count,
+    const void *data)
+{
+    if (data == NULL)
+        return FWK_E_PARAM;
+
+    host_timer_get_ctx(element_id)->config = data;
+
+    return FWK_SUCCESS;
+}
+
+static int host_timer_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    /* The timer HAL binds to the driver of each of its devices */
+    if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT))
+        return FWK_E_ACCESS;
+
+    if (fwk_id_get_api_idx(api_id) != MOD_HOST_TIMER_API_IDX_DRIVER)
+        return FWK_E_PARAM;
+
+    *api = &host_timer_driver_api;
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_host_timer = {
+    .name = "Host Timer",
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = MOD_HOST_TIMER_API_IDX_COUNT,
+    .init = host_timer_init,
+    .element_init = host_timer_element_init,
+    .process_bind_request = host_timer_process_bind_request,
+};
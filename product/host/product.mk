@@ -6,4 +6,4 @@
 #
 
 BS_PRODUCT_NAME := Host
-BS_FIRMWARE_LIST := fw
+BS_FIRMWARE_LIST := fw bench scmi_load scmi_sim scmi_replay
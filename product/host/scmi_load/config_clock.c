@@ -0,0 +1,117 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "host_scmi.h"
+
+#include <mod_clock.h>
+#include <mod_mock_clock.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+/*
+ * Mock clock driver config
+ */
+static const struct mod_mock_clock_rate cpu_rate_table[] = {
+    { .rate = 500 * FWK_MHZ },
+    { .rate = 1000 * FWK_MHZ },
+    { .rate = 1500 * FWK_MHZ },
+    { .rate = 2000 * FWK_MHZ },
+};
+
+static const struct mod_mock_clock_rate gpu_rate_table[] = {
+    { .rate = 300 * FWK_MHZ },
+    { .rate = 600 * FWK_MHZ },
+    { .rate = 900 * FWK_MHZ },
+};
+
+static const struct mod_mock_clock_rate periph_rate_table[] = {
+    { .rate = 100 * FWK_MHZ },
+    { .rate = 200 * FWK_MHZ },
+};
+
+static const struct fwk_element mock_clock_element_table[] = {
+    [HOST_CLOCK_IDX_CPU] = {
+        .name = "CPU",
+        .data = &(const struct mod_mock_clock_element_cfg){
+            .rate_table = cpu_rate_table,
+            .rate_count = FWK_ARRAY_SIZE(cpu_rate_table),
+            .default_rate = 1000 * FWK_MHZ,
+        },
+    },
+    [HOST_CLOCK_IDX_GPU] = {
+        .name = "GPU",
+        .data = &(const struct mod_mock_clock_element_cfg){
+            .rate_table = gpu_rate_table,
+            .rate_count = FWK_ARRAY_SIZE(gpu_rate_table),
+            .default_rate = 600 * FWK_MHZ,
+        },
+    },
+    [HOST_CLOCK_IDX_PERIPH] = {
+        .name = "PERIPH",
+        .data = &(const struct mod_mock_clock_element_cfg){
+            .rate_table = periph_rate_table,
+            .rate_count = FWK_ARRAY_SIZE(periph_rate_table),
+            .default_rate = 100 * FWK_MHZ,
+        },
+    },
+    [HOST_CLOCK_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *mock_clock_get_element_table(
+    fwk_id_t module_id)
+{
+    return mock_clock_element_table;
+}
+
+const struct fwk_module_config config_mock_clock = {
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(mock_clock_get_element_table),
+};
+
+/*
+ * Clock HAL config
+ */
+#define HOST_CLOCK_DEV_CONFIG(IDX) \
+    (&(const struct mod_clock_dev_config){ \
+        .driver_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_MOCK_CLOCK, IDX), \
+        .api_id = FWK_ID_API_INIT( \
+            FWK_MODULE_IDX_MOCK_CLOCK, MOD_MOCK_CLOCK_API_TYPE_DRIVER), \
+        .pd_source_id = FWK_ID_NONE_INIT, \
+        .parent_id = FWK_ID_NONE_INIT, \
+    })
+
+static const struct fwk_element clock_element_table[] = {
+    [HOST_CLOCK_IDX_CPU] = {
+        .name = "CPU",
+        .data = HOST_CLOCK_DEV_CONFIG(HOST_CLOCK_IDX_CPU),
+    },
+    [HOST_CLOCK_IDX_GPU] = {
+        .name = "GPU",
+        .data = HOST_CLOCK_DEV_CONFIG(HOST_CLOCK_IDX_GPU),
+    },
+    [HOST_CLOCK_IDX_PERIPH] = {
+        .name = "PERIPH",
+        .data = HOST_CLOCK_DEV_CONFIG(HOST_CLOCK_IDX_PERIPH),
+    },
+    [HOST_CLOCK_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *clock_get_element_table(fwk_id_t module_id)
+{
+    return clock_element_table;
+}
+
+const struct fwk_module_config config_clock = {
+    .data = &(const struct mod_clock_config){
+        .pd_transition_notification_id = FWK_ID_NONE_INIT,
+        .pd_pre_transition_notification_id = FWK_ID_NONE_INIT,
+    },
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(clock_get_element_table),
+};
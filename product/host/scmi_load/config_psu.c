@@ -0,0 +1,82 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "host_scmi.h"
+
+#include <mod_mock_psu.h>
+#include <mod_psu.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+/*
+ * Mock PSU driver config, one supply per DVFS domain
+ */
+#define HOST_MOCK_PSU_CONFIG(VOLTAGE) \
+    (&(const struct mod_mock_psu_element_cfg){ \
+        .async_alarm_id = FWK_ID_NONE_INIT, \
+        .async_alarm_api_id = FWK_ID_NONE_INIT, \
+        .async_response_id = FWK_ID_NONE_INIT, \
+        .async_response_api_id = FWK_ID_NONE_INIT, \
+        .default_enabled = true, \
+        .default_voltage = (VOLTAGE), \
+    })
+
+static const struct fwk_element mock_psu_element_table[] = {
+    [HOST_DVFS_IDX_CPU] = {
+        .name = "CPU",
+        .data = HOST_MOCK_PSU_CONFIG(800),
+    },
+    [HOST_DVFS_IDX_GPU] = {
+        .name = "GPU",
+        .data = HOST_MOCK_PSU_CONFIG(750),
+    },
+    [HOST_DVFS_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *mock_psu_get_element_table(
+    fwk_id_t module_id)
+{
+    return mock_psu_element_table;
+}
+
+const struct fwk_module_config config_mock_psu = {
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(mock_psu_get_element_table),
+};
+
+/*
+ * PSU HAL config
+ */
+#define HOST_PSU_CONFIG(IDX) \
+    (&(const struct mod_psu_element_cfg){ \
+        .driver_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_MOCK_PSU, IDX), \
+        .driver_api_id = FWK_ID_API_INIT( \
+            FWK_MODULE_IDX_MOCK_PSU, MOD_MOCK_PSU_API_IDX_DRIVER), \
+    })
+
+static const struct fwk_element psu_element_table[] = {
+    [HOST_DVFS_IDX_CPU] = {
+        .name = "CPU",
+        .data = HOST_PSU_CONFIG(HOST_DVFS_IDX_CPU),
+    },
+    [HOST_DVFS_IDX_GPU] = {
+        .name = "GPU",
+        .data = HOST_PSU_CONFIG(HOST_DVFS_IDX_GPU),
+    },
+    [HOST_DVFS_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *psu_get_element_table(fwk_id_t module_id)
+{
+    return psu_element_table;
+}
+
+const struct fwk_module_config config_psu = {
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(psu_get_element_table),
+};
@@ -0,0 +1,70 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "host_scmi.h"
+
+#include <mod_scmi.h>
+#include <mod_smt.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+static const struct fwk_element *scmi_get_element_table(fwk_id_t module_id)
+{
+    struct fwk_element *element_table;
+    struct mod_scmi_service_config *config_table;
+    unsigned int idx;
+
+    element_table =
+        fwk_mm_calloc(HOST_SCMI_AGENT_COUNT + 1, sizeof(struct fwk_element));
+    config_table = fwk_mm_calloc(
+        HOST_SCMI_AGENT_COUNT, sizeof(struct mod_scmi_service_config));
+
+    for (idx = 0; idx < HOST_SCMI_AGENT_COUNT; idx++) {
+        /* The SMT channels are ready as soon as they start */
+        config_table[idx] = (struct mod_scmi_service_config){
+            .transport_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SMT, idx),
+            .transport_api_id =
+                FWK_ID_API(FWK_MODULE_IDX_SMT, MOD_SMT_API_IDX_SCMI_TRANSPORT),
+            .transport_notification_init_id = FWK_ID_NONE,
+            .scmi_agent_id = HOST_SCMI_AGENT_ID(idx),
+            .scmi_p2a_id = FWK_ID_NONE,
+        };
+
+        element_table[idx] = (struct fwk_element){
+            .name = "OSPM",
+            .data = &config_table[idx],
+        };
+    }
+
+    return element_table;
+}
+
+static const struct mod_scmi_agent agent_table[HOST_SCMI_AGENT_COUNT + 1] = {
+    [HOST_SCMI_AGENT_ID(0)] = { .type = SCMI_AGENT_TYPE_OSPM, .name = "OSPM0" },
+    [HOST_SCMI_AGENT_ID(1)] = { .type = SCMI_AGENT_TYPE_OSPM, .name = "OSPM1" },
+    [HOST_SCMI_AGENT_ID(2)] = { .type = SCMI_AGENT_TYPE_OSPM, .name = "OSPM2" },
+    [HOST_SCMI_AGENT_ID(3)] = { .type = SCMI_AGENT_TYPE_OSPM, .name = "OSPM3" },
+};
+
+const struct fwk_module_config config_scmi = {
+    .data =
+        &(struct mod_scmi_config){
+            .protocol_count_max = 4,
+            .agent_count = HOST_SCMI_AGENT_COUNT,
+            .agent_table = agent_table,
+            .vendor_identifier = "arm",
+            .sub_vendor_identifier = "arm",
+            .capture_record_count = HOST_SCMI_CAPTURE_RECORD_COUNT,
+            .capture_payload_size = HOST_SCMI_CAPTURE_PAYLOAD_SIZE,
+        },
+
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(scmi_get_element_table),
+};
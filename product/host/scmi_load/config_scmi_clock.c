@@ -0,0 +1,46 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "host_scmi.h"
+
+#include <mod_scmi_clock.h>
+
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+/* The clocks of the DVFS domains are managed through the perf protocol */
+static const struct mod_scmi_clock_device agent_device_table[] = {
+    {
+        .element_id =
+            FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_CLOCK, HOST_CLOCK_IDX_PERIPH),
+        .starts_enabled = true,
+    },
+};
+
+#define HOST_SCMI_CLOCK_AGENT \
+    { \
+        .device_table = agent_device_table, \
+        .device_count = FWK_ARRAY_SIZE(agent_device_table), \
+    }
+
+static const struct mod_scmi_clock_agent
+    agent_table[HOST_SCMI_AGENT_COUNT + 1] = {
+    [HOST_SCMI_AGENT_ID(0)] = HOST_SCMI_CLOCK_AGENT,
+    [HOST_SCMI_AGENT_ID(1)] = HOST_SCMI_CLOCK_AGENT,
+    [HOST_SCMI_AGENT_ID(2)] = HOST_SCMI_CLOCK_AGENT,
+    [HOST_SCMI_AGENT_ID(3)] = HOST_SCMI_CLOCK_AGENT,
+};
+
+const struct fwk_module_config config_scmi_clock = {
+    .data = &((struct mod_scmi_clock_config) {
+        .max_pending_transactions = 0,
+        .agent_table = agent_table,
+        .agent_count = FWK_ARRAY_SIZE(agent_table),
+    }),
+};
@@ -0,0 +1,26 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "host_scmi.h"
+
+#include <mod_scmi_perf.h>
+
+#include <fwk_id.h>
+#include <fwk_module.h>
+
+static const struct mod_scmi_perf_domain_config domains[] = {
+    [HOST_DVFS_IDX_CPU] = { 0 },
+    [HOST_DVFS_IDX_GPU] = { 0 },
+};
+
+const struct fwk_module_config config_scmi_perf = {
+    .data = &((struct mod_scmi_perf_config){
+        .domains = &domains,
+        .fast_channels_alarm_id = FWK_ID_NONE_INIT,
+        .notification_alarm_id = FWK_ID_NONE_INIT,
+    }),
+};
@@ -0,0 +1,75 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "host_scmi.h"
+
+#include <mod_reg_sensor.h>
+#include <mod_sensor.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+#include <stdint.h>
+
+/* Register emulated in the memory of the process, in degrees Celsius */
+static uint64_t soc_temp_reg = 45;
+
+/*
+ * Register Sensor driver config
+ */
+static struct mod_sensor_info info_soc_temperature = {
+    .type = MOD_SENSOR_TYPE_DEGREES_C,
+    .update_interval = 0,
+    .update_interval_multiplier = 0,
+    .unit_multiplier = 0,
+};
+
+static const struct fwk_element reg_sensor_element_table[] = {
+    [HOST_SENSOR_IDX_SOC_TEMP] = {
+        .name = "Soc Temperature",
+        .data = &((struct mod_reg_sensor_dev_config) {
+            .reg = (uintptr_t)&soc_temp_reg,
+            .info = &info_soc_temperature,
+        }),
+    },
+    [HOST_SENSOR_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *reg_sensor_get_element_table(fwk_id_t id)
+{
+    return reg_sensor_element_table;
+}
+
+const struct fwk_module_config config_reg_sensor = {
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(reg_sensor_get_element_table),
+};
+
+/*
+ * Sensor module config
+ */
+static const struct fwk_element sensor_element_table[] = {
+    [HOST_SENSOR_IDX_SOC_TEMP] = {
+        .name = "Soc Temperature",
+        .data = &((const struct mod_sensor_dev_config) {
+            .driver_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_REG_SENSOR,
+                                             HOST_SENSOR_IDX_SOC_TEMP),
+            .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_REG_SENSOR, 0),
+        }),
+    },
+    [HOST_SENSOR_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *sensor_get_element_table(fwk_id_t module_id)
+{
+    return sensor_element_table;
+}
+
+const struct fwk_module_config config_sensor = {
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(sensor_get_element_table),
+};
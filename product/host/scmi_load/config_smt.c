@@ -0,0 +1,60 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "host_scmi.h"
+
+#include <mod_host_scmi_agent.h>
+#include <mod_smt.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+#include <stdint.h>
+
+uint64_t host_scmi_mailbox_table[HOST_SCMI_AGENT_COUNT]
+                                [HOST_SCMI_MAILBOX_SIZE / sizeof(uint64_t)];
+
+static const struct fwk_element *smt_get_element_table(fwk_id_t module_id)
+{
+    struct fwk_element *element_table;
+    struct mod_smt_channel_config *config_table;
+    unsigned int idx;
+
+    element_table =
+        fwk_mm_calloc(HOST_SCMI_AGENT_COUNT + 1, sizeof(struct fwk_element));
+    config_table = fwk_mm_calloc(
+        HOST_SCMI_AGENT_COUNT, sizeof(struct mod_smt_channel_config));
+
+    for (idx = 0; idx < HOST_SCMI_AGENT_COUNT; idx++) {
+        /* The channels are not part of any power domain */
+        config_table[idx] = (struct mod_smt_channel_config){
+            .type = MOD_SMT_CHANNEL_TYPE_SLAVE,
+            .policies = MOD_SMT_POLICY_INIT_MAILBOX,
+            .mailbox_address = (uintptr_t)host_scmi_mailbox_table[idx],
+            .mailbox_size = HOST_SCMI_MAILBOX_SIZE,
+            .driver_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_HOST_SCMI_AGENT, idx),
+            .driver_api_id = FWK_ID_API(
+                FWK_MODULE_IDX_HOST_SCMI_AGENT,
+                MOD_HOST_SCMI_AGENT_API_IDX_SMT_DRIVER),
+            .pd_source_id = FWK_ID_NONE,
+        };
+
+        element_table[idx] = (struct fwk_element){
+            .name = "",
+            .data = &config_table[idx],
+        };
+    }
+
+    return element_table;
+}
+
+const struct fwk_module_config config_smt = {
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(smt_get_element_table),
+};
@@ -0,0 +1,14 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_module.h>
+
+/*
+ * The timer HAL is only present for the modules referring to its alarm API.
+ * There is no timer on the host, none of them is configured to use an alarm.
+ */
+const struct fwk_module_config config_timer = { 0 };
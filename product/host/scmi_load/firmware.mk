@@ -0,0 +1,53 @@
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# The order of the modules in the BS_FIRMWARE_MODULES list is the order in which
+# the modules are initialized, bound, started during the pre-runtime phase.
+#
+
+BS_FIRMWARE_CPU := host
+BS_FIRMWARE_HAS_MULTITHREADING := no
+BS_FIRMWARE_HAS_NOTIFICATION := yes
+BS_FIRMWARE_HAS_SCMI_NOTIFICATIONS := no
+BS_FIRMWARE_HAS_FAST_CHANNELS := no
+BS_FIRMWARE_HAS_RESOURCE_PERMISSIONS := no
+BS_FIRMWARE_HAS_STATISTICS := no
+
+BS_FIRMWARE_MODULE_HEADERS_ONLY := \
+    power_domain
+
+BS_FIRMWARE_MODULES := \
+    stdio \
+    timer \
+    mock_clock \
+    clock \
+    mock_psu \
+    psu \
+    dvfs \
+    reg_sensor \
+    sensor \
+    host_scmi_agent \
+    smt \
+    scmi \
+    scmi_perf \
+    scmi_clock \
+    scmi_sensor
+
+BS_FIRMWARE_SOURCES := \
+    config_stdio.c \
+    config_time.c \
+    config_timer.c \
+    config_clock.c \
+    config_psu.c \
+    config_dvfs.c \
+    config_sensor.c \
+    config_host_scmi_agent.c \
+    config_smt.c \
+    config_scmi.c \
+    config_scmi_perf.c \
+    config_scmi_clock.c
+
+include $(BS_DIR)/firmware.mk
@@ -0,0 +1,59 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config_timer.h"
+#include "host_scmi.h"
+
+#include <mod_host_scmi_agent.h>
+#include <mod_timer.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+static const struct fwk_element *host_scmi_agent_get_element_table(
+    fwk_id_t module_id)
+{
+    struct fwk_element *element_table;
+    struct mod_host_scmi_agent_dev_config *config_table;
+    unsigned int idx;
+
+    element_table =
+        fwk_mm_calloc(HOST_SCMI_AGENT_COUNT + 1, sizeof(struct fwk_element));
+    config_table = fwk_mm_calloc(
+        HOST_SCMI_AGENT_COUNT, sizeof(struct mod_host_scmi_agent_dev_config));
+
+    for (idx = 0; idx < HOST_SCMI_AGENT_COUNT; idx++) {
+        config_table[idx] = (struct mod_host_scmi_agent_dev_config){
+            .channel_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SMT, idx),
+            .mailbox_address = (uintptr_t)host_scmi_mailbox_table[idx],
+            .mailbox_size = HOST_SCMI_MAILBOX_SIZE,
+            .alarm_id = FWK_ID_SUB_ELEMENT(
+                FWK_MODULE_IDX_TIMER, 0, HOST_SIM_ALARM_IDX_AGENT + idx),
+            .scmi_agent_id = HOST_SCMI_AGENT_ID(idx),
+        };
+
+        element_table[idx] = (struct fwk_element){
+            .name = "Agent",
+            .data = &config_table[idx],
+        };
+    }
+
+    return element_table;
+}
+
+/* The capture is read from the working directory of the firmware */
+const struct fwk_module_config config_host_scmi_agent = {
+    .data = &((struct mod_host_scmi_agent_config){
+        .replay_file = "scmi_capture.bin",
+        .virtual_time = true,
+    }),
+    .elements =
+        FWK_MODULE_DYNAMIC_ELEMENTS(host_scmi_agent_get_element_table),
+};
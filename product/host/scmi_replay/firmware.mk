@@ -0,0 +1,65 @@
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# The order of the modules in the BS_FIRMWARE_MODULES list is the order in which
+# the modules are initialized, bound, started during the pre-runtime phase.
+#
+# This firmware replays the capture of the SCMI messages received by a
+# platform, see the SCMI module, read from the scmi_capture.bin file of its
+# working directory, as written by the scmi_sim firmware for instance. It
+# shares the configuration of the scmi_sim firmware, running on virtual time,
+# except for the files of its own directory.
+#
+
+BS_FIRMWARE_CPU := host
+BS_FIRMWARE_HAS_MULTITHREADING := no
+BS_FIRMWARE_HAS_NOTIFICATION := yes
+BS_FIRMWARE_HAS_SCMI_NOTIFICATIONS := no
+BS_FIRMWARE_HAS_FAST_CHANNELS := no
+BS_FIRMWARE_HAS_RESOURCE_PERMISSIONS := no
+BS_FIRMWARE_HAS_STATISTICS := no
+
+BS_FIRMWARE_MODULE_HEADERS_ONLY := \
+    power_domain
+
+BS_FIRMWARE_MODULES := \
+    stdio \
+    host_timer \
+    timer \
+    mock_clock \
+    clock \
+    mock_psu \
+    psu \
+    dvfs \
+    reg_sensor \
+    sensor \
+    host_scmi_agent \
+    smt \
+    scmi \
+    scmi_perf \
+    scmi_clock \
+    scmi_sensor
+
+BS_FIRMWARE_SOURCES := \
+    config_stdio.c \
+    config_timer.c \
+    config_clock.c \
+    config_psu.c \
+    config_dvfs.c \
+    config_sensor.c \
+    config_host_scmi_agent.c \
+    config_smt.c \
+    config_scmi.c \
+    config_scmi_perf.c \
+    config_scmi_clock.c
+
+INCLUDES += $(PRODUCT_DIR)/scmi_sim
+
+include $(BS_DIR)/firmware.mk
+
+# Searched last, the files of this firmware taking precedence
+vpath %.c $(PRODUCT_DIR)/scmi_sim
+vpath %.c $(PRODUCT_DIR)/scmi_load
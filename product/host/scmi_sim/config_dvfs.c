@@ -0,0 +1,79 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config_timer.h"
+#include "host_scmi.h"
+
+#include <mod_dvfs.h>
+#include <mod_scmi_perf.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+/* The performance levels are the frequencies in MHz */
+static struct mod_dvfs_opp operating_points_cpu[] = {
+    { .level = 500, .frequency = 500 * FWK_KHZ, .voltage = 700 },
+    { .level = 1000, .frequency = 1000 * FWK_KHZ, .voltage = 800 },
+    { .level = 1500, .frequency = 1500 * FWK_KHZ, .voltage = 900 },
+    { .level = 2000, .frequency = 2000 * FWK_KHZ, .voltage = 1000 },
+    { 0 }
+};
+
+static struct mod_dvfs_opp operating_points_gpu[] = {
+    { .level = 300, .frequency = 300 * FWK_KHZ, .voltage = 650 },
+    { .level = 600, .frequency = 600 * FWK_KHZ, .voltage = 750 },
+    { .level = 900, .frequency = 900 * FWK_KHZ, .voltage = 850 },
+    { 0 }
+};
+
+/* Failed requests are retried after a millisecond of virtual time */
+#define HOST_DVFS_CONFIG(IDX, CLOCK_IDX, ALARM_IDX, OPPS) \
+    (&(const struct mod_dvfs_domain_config){ \
+        .psu_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_PSU, IDX), \
+        .clock_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_CLOCK, CLOCK_IDX), \
+        .alarm_id = \
+            FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, (ALARM_IDX)), \
+        .notification_id = FWK_ID_MODULE_INIT(FWK_MODULE_IDX_SCMI_PERF), \
+        .updates_api_id = FWK_ID_API_INIT( \
+            FWK_MODULE_IDX_SCMI_PERF, MOD_SCMI_PERF_DVFS_UPDATE_API), \
+        .retry_ms = 1, \
+        .latency = 100, \
+        .sustained_idx = 1, \
+        .opps = (OPPS), \
+    })
+
+static const struct fwk_element element_table[] = {
+    [HOST_DVFS_IDX_CPU] = {
+        .name = "CPU",
+        .data = HOST_DVFS_CONFIG(
+            HOST_DVFS_IDX_CPU,
+            HOST_CLOCK_IDX_CPU,
+            HOST_SIM_ALARM_IDX_DVFS_CPU,
+            operating_points_cpu),
+    },
+    [HOST_DVFS_IDX_GPU] = {
+        .name = "GPU",
+        .data = HOST_DVFS_CONFIG(
+            HOST_DVFS_IDX_GPU,
+            HOST_CLOCK_IDX_GPU,
+            HOST_SIM_ALARM_IDX_DVFS_GPU,
+            operating_points_gpu),
+    },
+    [HOST_DVFS_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *dvfs_get_element_table(fwk_id_t module_id)
+{
+    return element_table;
+}
+
+const struct fwk_module_config config_dvfs = {
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(dvfs_get_element_table),
+};
@@ -0,0 +1,123 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config_timer.h"
+#include "host_scmi.h"
+
+#include <mod_host_scmi_agent.h>
+#include <mod_scmi_perf.h>
+#include <mod_scmi_std.h>
+#include <mod_timer.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+#include <stdint.h>
+
+#define HOST_SCMI_MESSAGE(NAME, PROTOCOL, MESSAGE, PAYLOAD, WEIGHT) \
+    { \
+        .name = (NAME), \
+        .protocol_id = (PROTOCOL), \
+        .message_id = (MESSAGE), \
+        .payload = (PAYLOAD), \
+        .payload_size = sizeof(PAYLOAD), \
+        .weight = (WEIGHT), \
+    }
+
+/* Payloads, see the SCMI specification for their layout */
+static const uint32_t perf_domain_cpu[] = { HOST_DVFS_IDX_CPU };
+static const uint32_t perf_level_set_cpu_low[] = { HOST_DVFS_IDX_CPU, 500 };
+static const uint32_t perf_level_set_cpu_high[] = { HOST_DVFS_IDX_CPU, 2000 };
+static const uint32_t perf_level_set_gpu_low[] = { HOST_DVFS_IDX_GPU, 300 };
+static const uint32_t perf_level_set_gpu_high[] = { HOST_DVFS_IDX_GPU, 900 };
+static const uint32_t perf_level_set_batch[] = {
+    2, HOST_DVFS_IDX_CPU, 1000, HOST_DVFS_IDX_GPU, 600,
+};
+static const uint32_t clock_periph[] = { 0 };
+static const uint32_t clock_rate_set_periph[] = { 0, 0, 200 * FWK_MHZ, 0 };
+static const uint32_t sensor_reading_get[] = { HOST_SENSOR_IDX_SOC_TEMP, 0 };
+
+/*
+ * Mix dominated by the requests an OS issues at runtime, the performance level
+ * changes moving between the lowest and the highest operating points so that
+ * each of them waits for the supply to settle.
+ */
+static const struct mod_host_scmi_agent_message message_table[] = {
+    {
+        .name = "base_protocol_version",
+        .protocol_id = MOD_SCMI_PROTOCOL_ID_BASE,
+        .message_id = MOD_SCMI_PROTOCOL_VERSION,
+        .weight = 2,
+    },
+    HOST_SCMI_MESSAGE("perf_level_get", MOD_SCMI_PROTOCOL_ID_PERF,
+        MOD_SCMI_PERF_LEVEL_GET, perf_domain_cpu, 20),
+    HOST_SCMI_MESSAGE("perf_level_set_cpu_low", MOD_SCMI_PROTOCOL_ID_PERF,
+        MOD_SCMI_PERF_LEVEL_SET, perf_level_set_cpu_low, 5),
+    HOST_SCMI_MESSAGE("perf_level_set_cpu_high", MOD_SCMI_PROTOCOL_ID_PERF,
+        MOD_SCMI_PERF_LEVEL_SET, perf_level_set_cpu_high, 5),
+    HOST_SCMI_MESSAGE("perf_level_set_gpu_low", MOD_SCMI_PROTOCOL_ID_PERF,
+        MOD_SCMI_PERF_LEVEL_SET, perf_level_set_gpu_low, 5),
+    HOST_SCMI_MESSAGE("perf_level_set_gpu_high", MOD_SCMI_PROTOCOL_ID_PERF,
+        MOD_SCMI_PERF_LEVEL_SET, perf_level_set_gpu_high, 5),
+    HOST_SCMI_MESSAGE("perf_level_set_batch", MOD_SCMI_PROTOCOL_ID_PERF,
+        MOD_SCMI_PERF_LEVEL_SET_BATCH, perf_level_set_batch, 5),
+    HOST_SCMI_MESSAGE("clock_rate_get", MOD_SCMI_PROTOCOL_ID_CLOCK,
+        MOD_SCMI_CLOCK_RATE_GET, clock_periph, 20),
+    HOST_SCMI_MESSAGE("clock_rate_set", MOD_SCMI_PROTOCOL_ID_CLOCK,
+        MOD_SCMI_CLOCK_RATE_SET, clock_rate_set_periph, 5),
+    HOST_SCMI_MESSAGE("clock_attributes", MOD_SCMI_PROTOCOL_ID_CLOCK,
+        MOD_SCMI_CLOCK_ATTRIBUTES, clock_periph, 5),
+    HOST_SCMI_MESSAGE("sensor_reading_get", MOD_SCMI_PROTOCOL_ID_SENSOR,
+        MOD_SCMI_SENSOR_READING_GET, sensor_reading_get, 20),
+};
+
+static const struct fwk_element *host_scmi_agent_get_element_table(
+    fwk_id_t module_id)
+{
+    struct fwk_element *element_table;
+    struct mod_host_scmi_agent_dev_config *config_table;
+    unsigned int idx;
+
+    element_table =
+        fwk_mm_calloc(HOST_SCMI_AGENT_COUNT + 1, sizeof(struct fwk_element));
+    config_table = fwk_mm_calloc(
+        HOST_SCMI_AGENT_COUNT, sizeof(struct mod_host_scmi_agent_dev_config));
+
+    for (idx = 0; idx < HOST_SCMI_AGENT_COUNT; idx++) {
+        config_table[idx] = (struct mod_host_scmi_agent_dev_config){
+            .channel_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SMT, idx),
+            .mailbox_address = (uintptr_t)host_scmi_mailbox_table[idx],
+            .mailbox_size = HOST_SCMI_MAILBOX_SIZE,
+            .alarm_id = FWK_ID_SUB_ELEMENT(
+                FWK_MODULE_IDX_TIMER, 0, HOST_SIM_ALARM_IDX_AGENT + idx),
+        };
+
+        element_table[idx] = (struct fwk_element){
+            .name = "Agent",
+            .data = &config_table[idx],
+        };
+    }
+
+    return element_table;
+}
+
+const struct fwk_module_config config_host_scmi_agent = {
+    .data = &((struct mod_host_scmi_agent_config){
+        .message_table = message_table,
+        .message_count = FWK_ARRAY_SIZE(message_table),
+        .message_total = 25000,
+        .interval_ms = 1,
+        .virtual_time = true,
+        .capture_file = "scmi_capture.bin",
+    }),
+    .elements =
+        FWK_MODULE_DYNAMIC_ELEMENTS(host_scmi_agent_get_element_table),
+};
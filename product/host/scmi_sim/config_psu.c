@@ -0,0 +1,97 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config_timer.h"
+#include "host_scmi.h"
+
+#include <mod_mock_psu.h>
+#include <mod_psu.h>
+#include <mod_timer.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+/*
+ * Mock PSU driver config, one supply per DVFS domain. The supplies respond
+ * asynchronously through an alarm of the virtual-time timer, so that every
+ * voltage change takes some time to settle. Most requests take from 1 to 4
+ * milliseconds, and one in 32 takes the 20 milliseconds of a slow regulator
+ * transaction.
+ */
+#define HOST_MOCK_PSU_CONFIG(IDX, ALARM_IDX, VOLTAGE) \
+    (&(const struct mod_mock_psu_element_cfg){ \
+        .async_alarm_id = \
+            FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, (ALARM_IDX)), \
+        .async_alarm_api_id = \
+            FWK_ID_API_INIT(FWK_MODULE_IDX_TIMER, MOD_TIMER_API_IDX_ALARM), \
+        .async_response_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_PSU, IDX), \
+        .async_response_api_id = FWK_ID_API_INIT( \
+            FWK_MODULE_IDX_PSU, MOD_PSU_API_IDX_DRIVER_RESPONSE), \
+        .async_latency_min_ms = 1, \
+        .async_latency_max_ms = 4, \
+        .async_slow_ratio = 32, \
+        .async_slow_latency_ms = 20, \
+        .default_enabled = true, \
+        .default_voltage = (VOLTAGE), \
+    })
+
+static const struct fwk_element mock_psu_element_table[] = {
+    [HOST_DVFS_IDX_CPU] = {
+        .name = "CPU",
+        .data = HOST_MOCK_PSU_CONFIG(
+            HOST_DVFS_IDX_CPU, HOST_SIM_ALARM_IDX_PSU_CPU, 800),
+    },
+    [HOST_DVFS_IDX_GPU] = {
+        .name = "GPU",
+        .data = HOST_MOCK_PSU_CONFIG(
+            HOST_DVFS_IDX_GPU, HOST_SIM_ALARM_IDX_PSU_GPU, 750),
+    },
+    [HOST_DVFS_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *mock_psu_get_element_table(
+    fwk_id_t module_id)
+{
+    return mock_psu_element_table;
+}
+
+const struct fwk_module_config config_mock_psu = {
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(mock_psu_get_element_table),
+};
+
+/*
+ * PSU HAL config
+ */
+#define HOST_PSU_CONFIG(IDX) \
+    (&(const struct mod_psu_element_cfg){ \
+        .driver_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_MOCK_PSU, IDX), \
+        .driver_api_id = FWK_ID_API_INIT( \
+            FWK_MODULE_IDX_MOCK_PSU, MOD_MOCK_PSU_API_IDX_DRIVER), \
+    })
+
+static const struct fwk_element psu_element_table[] = {
+    [HOST_DVFS_IDX_CPU] = {
+        .name = "CPU",
+        .data = HOST_PSU_CONFIG(HOST_DVFS_IDX_CPU),
+    },
+    [HOST_DVFS_IDX_GPU] = {
+        .name = "GPU",
+        .data = HOST_PSU_CONFIG(HOST_DVFS_IDX_GPU),
+    },
+    [HOST_DVFS_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *psu_get_element_table(fwk_id_t module_id)
+{
+    return psu_element_table;
+}
+
+const struct fwk_module_config config_psu = {
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(psu_get_element_table),
+};
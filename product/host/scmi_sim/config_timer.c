@@ -0,0 +1,64 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config_timer.h"
+
+#include <mod_host_timer.h>
+#include <mod_timer.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_thread.h>
+#include <fwk_time.h>
+
+/*
+ * Virtual-time timer driver config
+ */
+static const struct fwk_element host_timer_element_table[] = {
+    [0] = {
+        .name = "VIRTUAL",
+        .data = &((const struct mod_host_timer_dev_config){
+            .timer_irq = HOST_SIM_TIMER_IRQ,
+        }),
+    },
+    [1] = { 0 },
+};
+
+const struct fwk_module_config config_host_timer = {
+    .elements = FWK_MODULE_STATIC_ELEMENTS_PTR(host_timer_element_table),
+};
+
+struct fwk_time_driver fmw_time_driver(const void **ctx)
+{
+    return mod_host_timer_driver(ctx);
+}
+
+struct fwk_thread_idle_driver fmw_thread_idle_driver(const void **ctx)
+{
+    return mod_host_timer_idle_driver(ctx);
+}
+
+/*
+ * Timer HAL config
+ */
+static const struct fwk_element timer_element_table[] = {
+    [0] = {
+        .name = "VIRTUAL",
+        .data = &((const struct mod_timer_dev_config){
+            .id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_HOST_TIMER, 0),
+            .timer_irq = HOST_SIM_TIMER_IRQ,
+        }),
+        .sub_element_count = HOST_SIM_ALARM_IDX_COUNT,
+    },
+    [1] = { 0 },
+};
+
+const struct fwk_module_config config_timer = {
+    .elements = FWK_MODULE_STATIC_ELEMENTS_PTR(timer_element_table),
+};
@@ -0,0 +1,26 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CONFIG_TIMER_H
+#define CONFIG_TIMER_H
+
+#include "host_scmi.h"
+
+/* Interrupt of the virtual-time timer */
+#define HOST_SIM_TIMER_IRQ 0
+
+/* Alarms of the virtual-time timer, the agents having one each */
+enum host_sim_alarm_idx {
+    HOST_SIM_ALARM_IDX_PSU_CPU,
+    HOST_SIM_ALARM_IDX_PSU_GPU,
+    HOST_SIM_ALARM_IDX_DVFS_CPU,
+    HOST_SIM_ALARM_IDX_DVFS_GPU,
+    HOST_SIM_ALARM_IDX_AGENT,
+    HOST_SIM_ALARM_IDX_COUNT = HOST_SIM_ALARM_IDX_AGENT + HOST_SCMI_AGENT_COUNT
+};
+
+#endif /* CONFIG_TIMER_H */
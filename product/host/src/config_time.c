@@ -0,0 +1,26 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_time.h>
+
+#include <time.h>
+
+static fwk_timestamp_t config_time_timestamp(const void *ctx)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return FWK_S((fwk_timestamp_t)now.tv_sec) + (fwk_timestamp_t)now.tv_nsec;
+}
+
+struct fwk_time_driver fmw_time_driver(const void **ctx)
+{
+    return (struct fwk_time_driver){
+        .timestamp = config_time_timestamp,
+    };
+}
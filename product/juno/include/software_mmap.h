@@ -98,4 +98,9 @@
                                        SCMI_PAYLOAD_SIZE)
 #define SCMI_PERF_STATS_SIZE          (0x1000)
 
+/* Energy meter page */
+#define ENERGY_METER_BASE             (SCMI_PERF_STATS_BASE + \
+                                       SCMI_PERF_STATS_SIZE)
+#define ENERGY_METER_SIZE             (0x100)
+
 #endif /* SOFTWARE_MMAP_H */
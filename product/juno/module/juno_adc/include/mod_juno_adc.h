@@ -21,6 +21,14 @@
 /*!
  * \ingroup GroupJunoModule
  * \defgroup GroupADC ADC Sensor Driver
+ *
+ * \details Besides the instantaneous readings of the ADC, the driver can meter
+ *      the energy of each rail: the power channels are sampled on a fixed
+ *      period and the energy is integrated in 64-bit accumulators, read
+ *      through the ::ADC_TYPE_ENERGY_METER sensors and published in a page of
+ *      shared memory, see ::mod_juno_adc_energy_page. The agents get the
+ *      energy of any window from two readings, without polling the power.
+ *
  * \{
  */
 
@@ -30,6 +38,8 @@
 enum juno_adc_sensor_type {
     /*! Voltage type ADC */
     ADC_TYPE_VOLT = 0,
+    /*! Energy integrated by the SCP from the power samples, in nJ */
+    ADC_TYPE_ENERGY_METER,
     /*! Current type ADC */
     ADC_TYPE_CURRENT,
     /*! Power type ADC */
@@ -70,6 +80,47 @@ struct mod_juno_adc_dev_config {
     struct mod_sensor_info *info;
 };
 
+/*!
+ * \brief Module configuration.
+ *
+ * \details The configuration is optional, the energy meter being disabled
+ *      without it.
+ */
+struct mod_juno_adc_config {
+    /*! Identifier of the alarm sampling the power channels */
+    fwk_id_t alarm_id;
+
+    /*! Sampling period of the power channels in milliseconds */
+    unsigned int period_ms;
+
+    /*!
+     * \brief Address of the page the energy meter is published in, or zero
+     *      to not publish it.
+     */
+    uintptr_t energy_page_address;
+};
+
+/*!
+ * \brief Page of shared memory the energy meter is published in.
+ *
+ * \details The page is updated every sampling period. Its sequence number is
+ *      odd while it is written, and the readers retry when it is odd or
+ *      changes while they read the page.
+ */
+struct mod_juno_adc_energy_page {
+    /*! Sequence number of the page */
+    uint32_t sequence;
+
+    /*! Sampling period in microseconds */
+    uint32_t period_us;
+
+    /*! Time of the last sample in nanoseconds */
+    uint64_t timestamp;
+
+    /*! Energy of each rail since the meter was started in nJ */
+    uint64_t energy[ADC_DEV_TYPE_COUNT];
+};
+
 /*!
  * \brief Juno ADC API indices.
  */
@@ -13,16 +13,145 @@
 
 #include <mod_juno_adc.h>
 #include <mod_sensor.h>
+#include <mod_timer.h>
 
 #include <fwk_assert.h>
 #include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
+#include <fwk_time.h>
 
+#include <fmw_cmsis.h>
+
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+/* Energy meter state */
+struct juno_adc_meter_ctx {
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Page the energy meter is published in, if any */
+    volatile struct mod_juno_adc_energy_page *page;
+
+    /* The power channels have been sampled at least once */
+    bool sampled;
+
+    /* Time of the last sample */
+    fwk_timestamp_t timestamp;
+
+    /* Last power sample of each rail in uW */
+    uint64_t power[ADC_DEV_TYPE_COUNT];
+
+    /* Energy of each rail in nJ */
+    uint64_t energy[ADC_DEV_TYPE_COUNT];
+
+    /* Energy of each rail below one nJ, in pJ */
+    uint32_t energy_remainder[ADC_DEV_TYPE_COUNT];
+};
+
+static const struct mod_juno_adc_config *juno_adc_config;
+
+static struct juno_adc_meter_ctx meter_ctx;
+
+/*
+ * Read the power of a rail in uW.
+ */
+static uint64_t read_power(enum juno_adc_dev_type dev_type)
+{
+    uint32_t adc_value;
+    uint64_t adc_quantity;
+
+    adc_value = V2M_SYS_REGS->ADC_POWER[dev_type] &
+                JUNO_ADC_SYS_REG_POWER_MASK;
+
+    adc_quantity = ((uint64_t)adc_value) * JUNO_ADC_WATTS_MULTIPLIER;
+
+    if ((dev_type == ADC_DEV_BIG) || (dev_type == ADC_DEV_GPU))
+        adc_quantity /= ADC_POWER_CONST1;
+    else
+        adc_quantity /= ADC_POWER_CONST2;
+
+    return adc_quantity;
+}
+
+/*
+ * Energy meter.
+ *
+ * Every period, the energy of each rail is integrated from the power samples
+ * with the trapezoidal rule, over the time actually elapsed since the previous
+ * sample.
+ */
+static void meter_publish(void)
+{
+    volatile struct mod_juno_adc_energy_page *page = meter_ctx.page;
+    unsigned int dev_type;
+
+    if (page == NULL)
+        return;
+
+    page->sequence++;
+    __DMB();
+
+    page->timestamp = meter_ctx.timestamp;
+    for (dev_type = 0; dev_type < ADC_DEV_TYPE_COUNT; dev_type++)
+        page->energy[dev_type] = meter_ctx.energy[dev_type];
+
+    __DMB();
+    page->sequence++;
+}
+
+static void meter_sample(uintptr_t param)
+{
+    fwk_timestamp_t timestamp;
+    uint64_t elapsed_us;
+    uint64_t power;
+    uint64_t energy_pj;
+    unsigned int dev_type;
+
+    timestamp = fwk_time_current();
+    elapsed_us = fwk_time_duration_us(
+        fwk_time_duration(meter_ctx.timestamp, timestamp));
+
+    for (dev_type = 0; dev_type < ADC_DEV_TYPE_COUNT; dev_type++) {
+        power = read_power((enum juno_adc_dev_type)dev_type);
+
+        if (meter_ctx.sampled) {
+            /* uW * us = pJ */
+            energy_pj = (((meter_ctx.power[dev_type] + power) / 2) *
+                         elapsed_us) +
+                meter_ctx.energy_remainder[dev_type];
+
+            meter_ctx.energy[dev_type] += energy_pj / 1000;
+            meter_ctx.energy_remainder[dev_type] =
+                (uint32_t)(energy_pj % 1000);
+        }
+
+        meter_ctx.power[dev_type] = power;
+    }
+
+    meter_ctx.timestamp = timestamp;
+    meter_ctx.sampled = true;
+
+    meter_publish();
+}
+
+static int get_energy(enum juno_adc_dev_type dev_type, uint64_t *value)
+{
+    if (juno_adc_config == NULL)
+        return FWK_E_SUPPORT;
+
+    /* The accumulators are updated from the alarm */
+    fwk_interrupt_global_disable();
+    *value = meter_ctx.energy[dev_type];
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
+
 /*
  * ADC driver API functions.
  */
@@ -61,17 +190,7 @@ static int get_value(fwk_id_t id, uint64_t *value)
         return FWK_SUCCESS;
 
     case ADC_TYPE_POWER:
-        adc_value = V2M_SYS_REGS->ADC_POWER[dev_type] &
-                    JUNO_ADC_SYS_REG_POWER_MASK;
-
-        adc_quantity = ((uint64_t)adc_value) * JUNO_ADC_WATTS_MULTIPLIER;
-
-        if ((dev_type == ADC_DEV_BIG) || (dev_type == ADC_DEV_GPU))
-            adc_quantity /= ADC_POWER_CONST1;
-        else
-            adc_quantity /= ADC_POWER_CONST2;
-
-        *value = adc_quantity;
+        *value = read_power(dev_type);
 
         return FWK_SUCCESS;
 
@@ -88,6 +207,9 @@ static int get_value(fwk_id_t id, uint64_t *value)
 
         return FWK_SUCCESS;
 
+    case ADC_TYPE_ENERGY_METER:
+        return get_energy(dev_type, value);
+
     default:
         return FWK_E_PARAM;
     }
@@ -119,9 +241,21 @@ static int juno_adc_init(fwk_id_t module_id,
                          unsigned int element_count,
                          const void *data)
 {
+    const struct mod_juno_adc_config *config = data;
+
     if (!fwk_expect(element_count > 0))
         return FWK_E_DATA;
 
+    if (config != NULL) {
+        if (config->period_ms == 0)
+            return FWK_E_DATA;
+
+        meter_ctx.page =
+            (volatile struct mod_juno_adc_energy_page *)
+                config->energy_page_address;
+        juno_adc_config = config;
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -132,6 +266,18 @@ static int juno_adc_element_init(fwk_id_t element_id,
     return FWK_SUCCESS;
 }
 
+static int juno_adc_bind(fwk_id_t id, unsigned int round)
+{
+    if ((round > 0) || !fwk_id_is_type(id, FWK_ID_TYPE_MODULE) ||
+        (juno_adc_config == NULL))
+        return FWK_SUCCESS;
+
+    return fwk_module_bind(
+        juno_adc_config->alarm_id,
+        MOD_TIMER_API_ID_ALARM,
+        &meter_ctx.alarm_api);
+}
+
 static int juno_adc_process_bind_request(fwk_id_t source_id,
                                          fwk_id_t target_id,
                                          fwk_id_t api_id,
@@ -152,11 +298,36 @@ static int juno_adc_process_bind_request(fwk_id_t source_id,
     return FWK_SUCCESS;
 }
 
+static int juno_adc_start(fwk_id_t id)
+{
+    volatile struct mod_juno_adc_energy_page *page = meter_ctx.page;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE) || (juno_adc_config == NULL))
+        return FWK_SUCCESS;
+
+    if (page != NULL) {
+        page->sequence = 0;
+        page->period_us = juno_adc_config->period_ms * 1000;
+    }
+
+    /* The first sample only sets the starting point of the integration */
+    meter_sample(0);
+
+    return meter_ctx.alarm_api->start(
+        juno_adc_config->alarm_id,
+        juno_adc_config->period_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        meter_sample,
+        0);
+}
+
 const struct fwk_module module_juno_adc = {
     .name = "Juno ADC Driver",
     .type = FWK_MODULE_TYPE_DRIVER,
     .api_count = MOD_JUNO_ADC_API_IDX_COUNT,
     .init = juno_adc_init,
     .element_init = juno_adc_element_init,
+    .bind = juno_adc_bind,
+    .start = juno_adc_start,
     .process_bind_request = juno_adc_process_bind_request
 };
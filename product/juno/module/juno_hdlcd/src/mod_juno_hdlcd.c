@@ -22,6 +22,7 @@
 #include <fwk_status.h>
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -35,6 +36,12 @@
  * This implies that both HDLCDs will have the same frequency when using the
  * PLL. Due to this constraint, the module assumes that the HDLCD clocks have
  * the same rate limits.
+ *
+ * On RTL, programming the PLL reference clock takes an I2C transaction. The
+ * requests received while a transaction is on-going are not rejected but
+ * coalesced: the requests for the rate being programmed complete along with
+ * it, and the last request for another rate is programmed once the
+ * transaction completes, superseding the requests for any intermediate rate.
  */
 
 struct juno_hdlcd_dev_ctx {
@@ -42,6 +49,12 @@ struct juno_hdlcd_dev_ctx {
     const struct mod_clock_driver_response_api *driver_response_api;
     const struct mod_juno_hdlcd_drv_api *driver_api;
     int index;
+
+    /* PLL rate requested by the clock */
+    uint32_t pll_rate;
+
+    /* The request of the clock waits for the PLL to be programmed */
+    bool pending;
 };
 
 struct juno_hdlcd_ctx {
@@ -54,6 +67,15 @@ struct juno_hdlcd_ctx {
      * Identifier of the clock for which the async request is on-going.
      */
     fwk_id_t request_clock_id;
+
+    /*
+     * Identifier of the clock whose rate is programmed once the on-going
+     * request completes.
+     */
+    fwk_id_t next_clock_id;
+
+    /* Number of HDLCD clocks */
+    unsigned int hdlcd_count;
 };
 
 static struct juno_hdlcd_dev_ctx *ctx_table;
@@ -125,6 +147,64 @@ static void enable_pll(fwk_id_t clock_id, struct juno_hdlcd_dev_ctx *ctx)
     *ctx->config->scc_control &= ~SCC_HDLCD_CONTROL_PXLCLK_SEL;
 }
 
+/*
+ * Complete the requests of the clocks waiting for the given PLL rate.
+ */
+static void complete_requests(uint32_t pll_rate, int status)
+{
+    unsigned int i;
+    struct juno_hdlcd_dev_ctx *ctx;
+    struct mod_clock_driver_resp_params response_param = {
+        .status = status,
+    };
+
+    for (i = 0; i < module_ctx.hdlcd_count; i++) {
+        ctx = &ctx_table[i];
+        if (!ctx->pending || (ctx->pll_rate != pll_rate))
+            continue;
+
+        ctx->pending = false;
+        ctx->driver_response_api->request_complete(ctx->config->clock_hal_id,
+            &response_param);
+    }
+}
+
+/*
+ * Start programming the PLL with the rate requested by a clock.
+ */
+static int program_pll(fwk_id_t clock_id, struct juno_hdlcd_dev_ctx *ctx)
+{
+    int status;
+
+    FWK_LOG_INFO(
+        "[HDLCD%u] Entry index:%d",
+        fwk_id_get_element_idx(clock_id),
+        ctx->index);
+
+    /* Hold PLL in reset during the configuration process */
+    SCC->PLL[PLL_IDX_HDLCD].REG0 = (PLL_REG0_PLL_RESET | PLL_REG0_HARD_BYPASS);
+
+    module_ctx.current_pll_rate = ctx->pll_rate;
+    if (platform == JUNO_IDX_PLATFORM_RTL) {
+        /* CLK_HDLCD_REFCLK is an external I2C based oscillator. */
+        status = ctx->driver_api->set_rate_from_index(ctx->config->driver_id,
+            ctx->index);
+        if ((status != FWK_PENDING) && (status != FWK_SUCCESS)) {
+            FWK_LOG_ERR("[HDLCD] Failed to set board clock");
+            return FWK_E_DEVICE;
+        }
+        if (status == FWK_PENDING) {
+            module_ctx.request_clock_id = clock_id;
+            ctx->pending = true;
+        }
+        return status;
+    }
+
+    enable_pll(clock_id, ctx);
+
+    return FWK_SUCCESS;
+}
+
 /*
  * HDLCD Driver Response API
  */
@@ -132,19 +212,44 @@ static void enable_pll(fwk_id_t clock_id, struct juno_hdlcd_dev_ctx *ctx)
 void juno_hdlcd_request_complete(fwk_id_t dev_id,
     struct mod_clock_driver_resp_params *response_param)
 {
+    int status;
+    uint32_t pll_rate;
+    fwk_id_t clock_id;
     struct juno_hdlcd_dev_ctx *ctx;
 
     fwk_assert(response_param != NULL);
 
-    ctx = ctx_table + fwk_id_get_element_idx(module_ctx.request_clock_id);
+    pll_rate = module_ctx.current_pll_rate;
+    clock_id = module_ctx.request_clock_id;
+    module_ctx.request_clock_id = FWK_ID_NONE;
 
-    if (response_param->status == FWK_SUCCESS)
-        enable_pll(module_ctx.request_clock_id, ctx);
+    if (fwk_id_is_equal(module_ctx.next_clock_id, FWK_ID_NONE)) {
+        if (response_param->status == FWK_SUCCESS) {
+            ctx = ctx_table + fwk_id_get_element_idx(clock_id);
+            enable_pll(clock_id, ctx);
+        }
 
-    ctx->driver_response_api->request_complete(ctx->config->clock_hal_id,
-        response_param);
+        complete_requests(pll_rate, response_param->status);
 
-    module_ctx.request_clock_id = FWK_ID_NONE;
+        return;
+    }
+
+    /*
+     * A request for another rate was received in the meantime: the rate
+     * programmed is superseded and the PLL is left in reset until the new rate
+     * is programmed.
+     */
+    complete_requests(pll_rate,
+        (response_param->status == FWK_SUCCESS) ?
+        FWK_E_BUSY : response_param->status);
+
+    clock_id = module_ctx.next_clock_id;
+    ctx = ctx_table + fwk_id_get_element_idx(clock_id);
+    module_ctx.next_clock_id = FWK_ID_NONE;
+
+    status = program_pll(clock_id, ctx);
+    if (status != FWK_PENDING)
+        complete_requests(ctx->pll_rate, status);
 }
 
 static const struct mod_clock_driver_response_api hdlcd_driver_response_api = {
@@ -158,7 +263,9 @@ static int juno_hdlcd_set_rate(fwk_id_t clock_id, uint64_t rate,
     enum mod_clock_round_mode round_mode)
 {
     int status;
+    int index;
     struct juno_hdlcd_dev_ctx *ctx;
+    struct juno_hdlcd_dev_ctx *next_ctx;
     uint32_t clock_rate;
     uint32_t rounded_rate;
 
@@ -176,11 +283,6 @@ static int juno_hdlcd_set_rate(fwk_id_t clock_id, uint64_t rate,
         (rounded_rate > ctx->config->max_rate))
         return FWK_E_RANGE;
 
-    if (platform == JUNO_IDX_PLATFORM_RTL) {
-        if (!fwk_id_is_equal(module_ctx.request_clock_id, FWK_ID_NONE))
-            return FWK_E_BUSY;
-    }
-
     /*
      * Clock rate is always twice the pixel clock rate. This is because Juno has
      * an implicit "divide by 2" stage.
@@ -206,7 +308,8 @@ static int juno_hdlcd_set_rate(fwk_id_t clock_id, uint64_t rate,
     /*
      * Check if we can re-use the current PLL frequency.
      */
-    if (clock_rate == module_ctx.current_pll_rate) {
+    if ((clock_rate == module_ctx.current_pll_rate) &&
+        fwk_id_is_equal(module_ctx.request_clock_id, FWK_ID_NONE)) {
         /* Switch HDLCD controller to use PLL clock source */
         *ctx->config->scc_control &= ~SCC_HDLCD_CONTROL_PXLCLK_SEL;
         *ctx->config->scc_control |= SCC_HDLCD_CONTROL_PXLCLK_SEL_PLL;
@@ -224,36 +327,36 @@ static int juno_hdlcd_set_rate(fwk_id_t clock_id, uint64_t rate,
      * PLL is already using it
      */
     /* Find entry on the look-up table */
-    ctx->index = (clock_rate - PXL_CLK_IN_RATE) / (500 * FWK_KHZ);
-    if ((ctx->index < 0) ||
-        ((unsigned int)ctx->index >= ctx->config->lookup_table_count))
+    index = (clock_rate - PXL_CLK_IN_RATE) / (500 * FWK_KHZ);
+    if ((index < 0) ||
+        ((unsigned int)index >= ctx->config->lookup_table_count))
         return FWK_E_RANGE;
 
-    FWK_LOG_INFO(
-        "[HDLCD%u] Entry index:%d",
-        fwk_id_get_element_idx(clock_id),
-        ctx->index);
+    ctx->index = index;
+    ctx->pll_rate = clock_rate;
 
-    /* Hold PLL in reset during the configuration process */
-    SCC->PLL[PLL_IDX_HDLCD].REG0 = (PLL_REG0_PLL_RESET | PLL_REG0_HARD_BYPASS);
+    if (fwk_id_is_equal(module_ctx.request_clock_id, FWK_ID_NONE))
+        return program_pll(clock_id, ctx);
 
-    module_ctx.current_pll_rate = clock_rate;
-    if (platform == JUNO_IDX_PLATFORM_RTL) {
-        /* CLK_HDLCD_REFCLK is an external I2C based oscillator. */
-        status = ctx->driver_api->set_rate_from_index(ctx->config->driver_id,
-            ctx->index);
-        if ((status != FWK_PENDING) && (status != FWK_SUCCESS)) {
-            FWK_LOG_ERR("[HDLCD] Failed to set board clock");
-            return FWK_E_DEVICE;
+    /*
+     * An I2C transaction is on-going: wait for it when it programs the rate
+     * requested, otherwise program the rate once it completes. In both cases,
+     * the request supersedes the one waiting for another rate, if any.
+     */
+    ctx->pending = true;
+
+    if (!fwk_id_is_equal(module_ctx.next_clock_id, FWK_ID_NONE)) {
+        next_ctx = ctx_table + fwk_id_get_element_idx(module_ctx.next_clock_id);
+        if (next_ctx->pll_rate != clock_rate) {
+            complete_requests(next_ctx->pll_rate, FWK_E_BUSY);
+            module_ctx.next_clock_id = FWK_ID_NONE;
         }
-        if (status == FWK_PENDING)
-            module_ctx.request_clock_id = clock_id;
-        return status;
     }
 
-    enable_pll(clock_id, ctx);
+    if (clock_rate != module_ctx.current_pll_rate)
+        module_ctx.next_clock_id = clock_id;
 
-    return FWK_SUCCESS;
+    return FWK_PENDING;
 }
 
 static int juno_hdlcd_get_rate(fwk_id_t clock_id, uint64_t *rate)
@@ -331,6 +434,7 @@ static int juno_hdlcd_init(fwk_id_t module_id,
                            const void *data)
 {
     ctx_table = fwk_mm_calloc(element_count, sizeof(*ctx_table));
+    module_ctx.hdlcd_count = element_count;
 
     return FWK_SUCCESS;
 }
@@ -432,6 +536,7 @@ static int juno_hdlcd_start(fwk_id_t id)
     module_ctx.current_pll_rate = ((uint64_t)(PXL_REF_CLK_RATE) * nf) /
                                   (nr * od);
     module_ctx.request_clock_id = FWK_ID_NONE;
+    module_ctx.next_clock_id = FWK_ID_NONE;
 
     return FWK_SUCCESS;
 }
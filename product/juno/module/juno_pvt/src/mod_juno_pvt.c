@@ -31,6 +31,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /* Location Identifier */
 #define PVTGROUP_GROUP_INFO_LOC                 UINT32_C(0x00000001)
@@ -80,6 +81,12 @@ struct pvt_ctx {
 /*
  * Sensors are grouped in elements and each sensor is represented by a
  * sub-element.
+ *
+ * The sensors of a group are sampled together: a reading of any of them
+ * triggers a conversion of the whole group, completed by a single interrupt.
+ * The readings of all the sensors of the group are then reported to the
+ * sensor HAL, which caches them, and the requests received for the group in
+ * the meantime are completed by the same conversion.
  */
 
 /* Group (element) context */
@@ -92,8 +99,20 @@ struct pvt_dev_ctx {
     /* Pointer to the table of sensor context */
     struct pvt_sub_dev_ctx *sensor_ctx_table;
 
-    /* Identifier of the sensor (sub-element) being processed */
-    fwk_id_t sensor_read_id;
+    /* Number of sensors (sub-elements) in the group */
+    unsigned int sensor_count;
+
+    /* Sample window for the conversion of the whole group */
+    unsigned int sample_window;
+
+    /* A conversion of the group is in progress */
+    bool sampling;
+
+    /* Mask of the sensors (sub-elements) with a reading requested */
+    uint32_t read_mask;
+
+    /* Mask of the sensors whose data was valid at the end of the conversion */
+    uint32_t data_valid;
 
     /* Sensor Driver Input API */
     const struct mod_sensor_driver_response_api *driver_response_api;
@@ -119,6 +138,9 @@ struct pvt_sub_dev_ctx {
     /* Last raw reading from the sensor */
     uint32_t last_reading;
 
+    /* Raw reading latched at the end of the conversion */
+    uint32_t osc_counter;
+
     /* Sample Window for measurement */
     unsigned int sample_window;
 
@@ -267,43 +289,76 @@ static int process_osc_calibration(struct pvt_sub_dev_ctx *sensor_ctx,
 
 static void pvt_interrupt_handler(uintptr_t param)
 {
-    struct mod_juno_pvt_dev_config *sensor_cfg;
-    uint32_t osc_counter = 0, sensor_value;
-    int freq_khz;
-    uint64_t value = 0;
-    int status = FWK_E_PARAM;
+    int status;
     struct fwk_event event;
     struct pvt_dev_ctx *group_ctx;
-    struct pvt_sub_dev_ctx *sensor_ctx;
-    struct mod_sensor_driver_resp_params *isr_params =
-        (struct mod_sensor_driver_resp_params *)event.params;
-    uint8_t sub_elt_idx;
+    struct mod_juno_pvt_dev_config *sensor_cfg;
+    const struct juno_group_desc *group;
+    unsigned int sub_elt_idx;
+    uint32_t data_valid;
 
     group_ctx = (struct pvt_dev_ctx *)param;
-    sub_elt_idx = fwk_id_get_sub_element_idx(group_ctx->sensor_read_id);
+    group = group_ctx->sensor_cfg_table[0].group;
+
+    group->regs->IRQ_CLEAR = IRQ_MASK_ALL;
+
+    /* Latch the data of the whole group, converted in the event handler */
+    data_valid = group->regs->SENSOR_DATA_VALID;
+    group_ctx->data_valid = 0;
+
+    for (sub_elt_idx = 0; sub_elt_idx < group_ctx->sensor_count;
+         sub_elt_idx++) {
+        sensor_cfg = &group_ctx->sensor_cfg_table[sub_elt_idx];
+        if ((data_valid & (1 << sensor_cfg->index)) == 0)
+            continue;
+
+        group_ctx->sensor_ctx_table[sub_elt_idx].osc_counter =
+            group->regs->SENSOR_DATA[sensor_cfg->index] & SAMPLE_VALUE_MASK;
+        group_ctx->data_valid |= (1 << sub_elt_idx);
+    }
+
+    event = (struct fwk_event) {
+        .target_id = fwk_id_build_element_id(
+            fwk_module_id_juno_pvt,
+            (unsigned int)(group_ctx - dev_ctx)),
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_JUNO_PVT),
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_JUNO_PVT,
+                           JUNO_PVT_EVENT_IDX_DATA_READY),
+    };
+
+    status = fwk_thread_put_event(&event);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
+/*
+ * Convert the reading of a sensor at the end of the conversion of its group.
+ */
+static int convert_reading(struct pvt_dev_ctx *group_ctx,
+                           unsigned int sub_elt_idx,
+                           uint64_t *value)
+{
+    struct mod_juno_pvt_dev_config *sensor_cfg;
+    struct pvt_sub_dev_ctx *sensor_ctx;
+    uint32_t osc_counter, sensor_value;
+    int freq_khz;
+
     sensor_cfg = &group_ctx->sensor_cfg_table[sub_elt_idx];
     sensor_ctx = &group_ctx->sensor_ctx_table[sub_elt_idx];
 
-    sensor_cfg->group->regs->IRQ_CLEAR = IRQ_MASK_ALL;
-
-    if ((sensor_cfg->group->regs->SENSOR_DATA_VALID &
-        (1 << sensor_cfg->index))) {
-        osc_counter = sensor_cfg->group->regs->SENSOR_DATA[sensor_cfg->index] &
-            SAMPLE_VALUE_MASK;
-    } else {
+    if ((group_ctx->data_valid & (1 << sub_elt_idx)) == 0) {
         /* Return the last raw reading */
-        value = (uint64_t)sensor_ctx->last_reading;
-        status = FWK_SUCCESS;
+        *value = (uint64_t)sensor_ctx->last_reading;
 
-        goto exit;
+        return FWK_SUCCESS;
     }
 
+    osc_counter = sensor_ctx->osc_counter;
     sensor_ctx->last_reading = osc_counter;
 
-    if (!fwk_expect(sensor_ctx->sample_window != 0))
-        goto exit;
+    if (!fwk_expect(group_ctx->sample_window != 0))
+        return FWK_E_PARAM;
 
-    freq_khz = (osc_counter * REFCLK_KHZ) / sensor_ctx->sample_window;
+    freq_khz = (osc_counter * REFCLK_KHZ) / group_ctx->sample_window;
 
     fwk_assert(sensor_ctx->slope_m != 0);
 
@@ -316,50 +371,75 @@ static void pvt_interrupt_handler(uintptr_t param)
             (mod_ctx.board_rev == JUNO_IDX_REVISION_R2))
             sensor_value -= R1_TEMP_OFFSET;
 
-        value = (uint64_t)sensor_value;
-        status = FWK_SUCCESS;
+        *value = (uint64_t)sensor_value;
     } else if (sensor_cfg->type == JUNO_PVT_TYPE_VOLT) {
         /* Convert to millivolts */
         sensor_value /= 1000;
 
-        value = (uint64_t)sensor_value;
-        status = FWK_SUCCESS;
+        *value = (uint64_t)sensor_value;
     } else
-        status = FWK_E_PARAM;
+        return FWK_E_PARAM;
 
-exit:
-    event = (struct fwk_event) {
-        .target_id = fwk_id_build_element_id(
-            fwk_module_id_juno_pvt,
-            fwk_id_get_element_idx(group_ctx->sensor_read_id)),
-        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_JUNO_PVT),
-        .id = FWK_ID_EVENT(FWK_MODULE_IDX_JUNO_PVT,
-                           JUNO_PVT_EVENT_IDX_DATA_READY),
-    };
+    return FWK_SUCCESS;
+}
+
+/*
+ * End the conversion of a group and respond to the Power Domain notification
+ * delayed in the meantime, if any.
+ */
+static int end_sampling(fwk_id_t group_id, struct pvt_dev_ctx *group_ctx)
+{
+    int status;
+    struct fwk_event resp_notif;
+    struct mod_pd_power_state_pre_transition_notification_resp_params
+        *pd_resp_params =
+        (struct mod_pd_power_state_pre_transition_notification_resp_params *)
+            resp_notif.params;
 
-    isr_params->status = status;
-    isr_params->value = value;
+    group_ctx->sampling = false;
+    group_ctx->read_mask = 0;
 
-    status = fwk_thread_put_event(&event);
-    fwk_assert(status == FWK_SUCCESS);
+    if (!group_ctx->pd_notification_delayed)
+        return FWK_SUCCESS;
+
+    group_ctx->pd_notification_delayed = false;
+    status = fwk_thread_get_delayed_response(group_id,
+                                             group_ctx->cookie,
+                                             &resp_notif);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    pd_resp_params->status = FWK_SUCCESS;
+
+    status = fwk_thread_put_event(&resp_notif);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
 }
 
-static int respond(struct pvt_dev_ctx *group_ctx)
+static int respond(fwk_id_t group_id, struct pvt_dev_ctx *group_ctx)
 {
-    struct pvt_sub_dev_ctx *sensor_ctx;
+    int status;
+    unsigned int sub_elt_idx;
 
     /* The request to initiate the reading failed, respond back */
     struct mod_sensor_driver_resp_params resp_params = {0};
     resp_params.status = FWK_E_STATE;
 
-    sensor_ctx = &group_ctx->sensor_ctx_table[
-        fwk_id_get_sub_element_idx(group_ctx->sensor_read_id)];
+    for (sub_elt_idx = 0; sub_elt_idx < group_ctx->sensor_count;
+         sub_elt_idx++) {
+        if ((group_ctx->read_mask & (1 << sub_elt_idx)) == 0)
+            continue;
 
-    group_ctx->driver_response_api->reading_complete(
-        sensor_ctx->sensor_hal_id,
-        &resp_params);
+        group_ctx->driver_response_api->reading_complete(
+            group_ctx->sensor_ctx_table[sub_elt_idx].sensor_hal_id,
+            &resp_params);
+    }
 
-    group_ctx->sensor_read_id = FWK_ID_NONE;
+    status = end_sampling(group_id, group_ctx);
+    if (status != FWK_SUCCESS)
+        return status;
 
     return FWK_E_STATE;
 }
@@ -390,7 +470,7 @@ static int get_value(fwk_id_t id, uint64_t *value)
     uint8_t elt_idx;
     struct pvt_dev_ctx *group_ctx;
     struct fwk_event read_req;
-    int status;
+    int status = FWK_SUCCESS;
 
     if (mod_ctx.driver_is_disabled)
         return FWK_E_DEVICE;
@@ -401,10 +481,8 @@ static int get_value(fwk_id_t id, uint64_t *value)
     if (!group_ctx->pd_state_on)
         return FWK_E_PWRSTATE;
 
-    if (fwk_id_is_equal(group_ctx->sensor_read_id, FWK_ID_NONE)) {
-        /* No other sensors within the group are being read, mark this one */
-        group_ctx->sensor_read_id = id;
-
+    if (!group_ctx->sampling) {
+        /* No conversion of the group is in progress, start one */
         read_req = (struct fwk_event) {
             .target_id = fwk_id_build_element_id(fwk_module_id_juno_pvt,
                                                  elt_idx),
@@ -413,15 +491,17 @@ static int get_value(fwk_id_t id, uint64_t *value)
         };
 
         status = fwk_thread_put_event(&read_req);
-    } else {
-        /* At least one sensor is being read, the sensor group is busy */
-        status = FWK_E_BUSY;
+        if (status == FWK_SUCCESS)
+            group_ctx->sampling = true;
     }
 
-    if (status == FWK_SUCCESS)
-        return FWK_PENDING;
+    /* The conversion in progress, if any, completes the request */
+    if (status != FWK_SUCCESS)
+        return status;
 
-    return status;
+    group_ctx->read_mask |= (1 << fwk_id_get_sub_element_idx(id));
+
+    return FWK_PENDING;
 }
 
 static const struct mod_sensor_driver_api pvt_sensor_api = {
@@ -480,7 +560,11 @@ static int juno_pvt_element_init(fwk_id_t element_id,
         fwk_mm_calloc(sub_element_count, sizeof(struct pvt_sub_dev_ctx));
 
     group_ctx->sensor_cfg_table = (struct mod_juno_pvt_dev_config *)data;
-    group_ctx->sensor_read_id = FWK_ID_NONE;
+    group_ctx->sensor_count = sub_element_count;
+
+    /* The read mask holds a bit per sensor */
+    if (sub_element_count > 32)
+        return FWK_E_PARAM;
 
     return FWK_SUCCESS;
 }
@@ -637,6 +721,14 @@ static int pvt_start(fwk_id_t id)
 
         if (status != FWK_SUCCESS)
             goto error;
+
+        /*
+         * The group is converted with a single sample window. The smallest
+         * window of its sensors fits the full scale reading of all of them.
+         */
+        if ((group_ctx->sample_window == 0) ||
+            (sensor_ctx->sample_window < group_ctx->sample_window))
+            group_ctx->sample_window = sensor_ctx->sample_window;
     }
 
     sensor_cfg = group_ctx->sensor_cfg_table;
@@ -712,42 +804,33 @@ static int pvt_process_event(const struct fwk_event *event,
     const struct juno_group_desc *group;
     struct pvt_dev_ctx *group_ctx;
     struct pvt_sub_dev_ctx *sensor_ctx;
-    struct mod_sensor_driver_resp_params *isr_params =
-        (struct mod_sensor_driver_resp_params *)event->params;
-    struct fwk_event resp_notif;
+    struct mod_sensor_driver_resp_params resp_params;
     uint8_t elt_idx = fwk_id_get_element_idx(event->target_id);
     unsigned int sub_elt_idx;
     unsigned int sensor_count;
-    struct mod_pd_power_state_pre_transition_notification_resp_params
-        *pd_resp_params =
-        (struct mod_pd_power_state_pre_transition_notification_resp_params *)
-            resp_notif.params;
+    uint32_t sensor_enable = 0;
 
     fwk_assert(fwk_module_is_valid_element_id(event->target_id));
 
     group_ctx = &dev_ctx[elt_idx];
-    sub_elt_idx = fwk_id_get_sub_element_idx(group_ctx->sensor_read_id);
-    sensor_ctx = &group_ctx->sensor_ctx_table[sub_elt_idx];
 
     switch (fwk_id_get_event_idx(event->id)) {
 
     case JUNO_PVT_EVENT_IDX_READ_REQUEST:
-        sensor_cfg = &group_ctx->sensor_cfg_table[sub_elt_idx];
-
-        group = sensor_cfg->group;
+        group = group_ctx->sensor_cfg_table[0].group;
 
         if ((group->regs->GROUP_INFO & PVTGROUP_GROUP_INFO_LOC) !=
             PVTGROUP_GROUP_INFO_LOC_GROUP_LITE)
-            return respond(group_ctx);
+            return respond(event->target_id, group_ctx);
 
         sensor_count = (group->regs->GROUP_INFO &
                         PVTGROUP_SENSOR_COUNT_MASK) >> 1;
 
         if (sensor_count < group->sensor_count)
-            return respond(group_ctx);
+            return respond(event->target_id, group_ctx);
 
         /*
-         * Configure the group before reading a sensor within it.
+         * Configure the group before reading the sensors within it.
          * This must be performed each time because the configuration is lost
          * if the power domain that the group resides in powers off.
          */
@@ -758,55 +841,58 @@ static int pvt_process_event(const struct fwk_event *event,
 
         status = fwk_interrupt_clear_pending(group->irq);
         if (status != FWK_SUCCESS)
-            return respond(group_ctx);
+            return respond(event->target_id, group_ctx);
 
         status = fwk_interrupt_set_isr_param(group->irq,
                                              &pvt_interrupt_handler,
                                              (uintptr_t)group_ctx);
         if (status != FWK_SUCCESS)
-            return respond(group_ctx);
+            return respond(event->target_id, group_ctx);
 
         status = fwk_interrupt_enable(group->irq);
         if (status != FWK_SUCCESS)
-            return respond(group_ctx);
+            return respond(event->target_id, group_ctx);
 
-        /* Initiate measurement for group/sensor */
-        group->regs->SENSOR_ENABLE = (1 << sensor_cfg->index);
+        /* Initiate measurement for all the sensors of the group */
+        for (sub_elt_idx = 0; sub_elt_idx < group_ctx->sensor_count;
+             sub_elt_idx++) {
+            sensor_cfg = &group_ctx->sensor_cfg_table[sub_elt_idx];
+            sensor_enable |= (1 << sensor_cfg->index);
+        }
+
+        group->regs->SENSOR_ENABLE = sensor_enable;
         group->regs->SAMPLE_WINDOW =
-            sensor_ctx->sample_window & SAMPLE_WINDOW_MASK;
+            group_ctx->sample_window & SAMPLE_WINDOW_MASK;
         group->regs->MEASUREMENT_ENABLE = PVTGROUP_MEASUREMENT_ENABLE;
 
         return FWK_SUCCESS;
 
     case JUNO_PVT_EVENT_IDX_DATA_READY:
-        if (fwk_id_get_element_idx(group_ctx->sensor_read_id) ==
-            fwk_id_get_element_idx(event->target_id)) {
-            /* Set the sensor group available */
-            group_ctx->sensor_read_id = FWK_ID_NONE;
-
-            group_ctx->driver_response_api->reading_complete(
-                sensor_ctx->sensor_hal_id,
-                isr_params);
+        if (!group_ctx->sampling)
+            return FWK_E_PARAM;
 
-            /* Respond to the Power Domain notification */
-            if (group_ctx->pd_notification_delayed) {
-                group_ctx->pd_notification_delayed = false;
-                status = fwk_thread_get_delayed_response(event->target_id,
-                                                         group_ctx->cookie,
-                                                         &resp_notif);
-                if (status != FWK_SUCCESS)
-                    return FWK_E_PANIC;
+        /*
+         * Report the readings of all the sensors of the group, requested or
+         * not, so that the sensor HAL caches them.
+         */
+        for (sub_elt_idx = 0; sub_elt_idx < group_ctx->sensor_count;
+             sub_elt_idx++) {
+            sensor_ctx = &group_ctx->sensor_ctx_table[sub_elt_idx];
 
-                pd_resp_params->status = FWK_SUCCESS;
+            /* The sensor is not bound to the sensor HAL */
+            if (fwk_id_is_type(sensor_ctx->sensor_hal_id, FWK_ID_TYPE_NONE))
+                continue;
 
-                status = fwk_thread_put_event(&resp_notif);
-                if (status != FWK_SUCCESS)
-                    return FWK_E_PANIC;
-            }
+            resp_params.value = 0;
+            resp_params.status =
+                convert_reading(group_ctx, sub_elt_idx, &resp_params.value);
 
-            return FWK_SUCCESS;
+            group_ctx->driver_response_api->reading_complete(
+                sensor_ctx->sensor_hal_id,
+                &resp_params);
         }
-        /* Fall-through */
+
+        return end_sampling(event->target_id, group_ctx);
 
     default:
         return FWK_E_PARAM;
@@ -845,7 +931,7 @@ static int pvt_process_notification(const struct fwk_event *event,
         if (pre_state_params->target_state == MOD_PD_STATE_OFF)
             group_ctx->pd_state_on = false;
 
-        if (!fwk_id_is_equal(group_ctx->sensor_read_id, FWK_ID_NONE)) {
+        if (group_ctx->sampling) {
             /* Read request ongoing, delay the response */
             group_ctx->cookie = event->cookie;
             group_ctx->pd_notification_delayed = true;
@@ -5,6 +5,9 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include "juno_alarm_idx.h"
+#include "software_mmap.h"
+
 #include <config_sensor.h>
 
 #include <mod_juno_adc.h>
@@ -13,6 +16,7 @@
 #include <fwk_element.h>
 #include <fwk_id.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 
 static const struct fwk_element adc_juno_element_table[] = {
     [ADC_TYPE_VOLT] = {
@@ -25,6 +29,16 @@ static const struct fwk_element adc_juno_element_table[] = {
             }),
         }),
     },
+    [ADC_TYPE_ENERGY_METER] = {
+        .name = "",
+        .sub_element_count = ADC_DEV_TYPE_COUNT,
+        .data = &((struct mod_juno_adc_dev_config) {
+            .info = &((struct mod_sensor_info) {
+                .type = MOD_SENSOR_TYPE_JOULES,
+                .unit_multiplier = -9,
+            }),
+        }),
+    },
 
     #if USE_FULL_SET_SENSORS
     [ADC_TYPE_CURRENT] = {
@@ -68,5 +82,12 @@ static const struct fwk_element *get_adc_juno_element_table(fwk_id_t id)
 }
 
 struct fwk_module_config config_juno_adc = {
+    .data = &((struct mod_juno_adc_config) {
+        .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER,
+                                            JUNO_ALARM_ELEMENT_IDX,
+                                            JUNO_ADC_ALARM_IDX),
+        .period_ms = 10,
+        .energy_page_address = ENERGY_METER_BASE,
+    }),
     .elements = FWK_MODULE_DYNAMIC_ELEMENTS(get_adc_juno_element_table),
 };
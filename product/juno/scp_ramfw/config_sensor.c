@@ -123,6 +123,48 @@ static const struct fwk_element sensor_element_table_r0[] = {
         }),
     },
 
+    /* Energy metered by the SCP */
+    [MOD_JUNO_SENSOR_NJ_SYS_IDX] = {
+        .name = "SCP_ENRG_SYS",
+        .data = &((struct mod_sensor_dev_config) {
+            .driver_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_JUNO_ADC,
+                                                 ADC_TYPE_ENERGY_METER,
+                                                 ADC_DEV_SYS),
+            .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_JUNO_ADC,
+                                             MOD_JUNO_ADC_API_IDX_DRIVER),
+        }),
+    },
+    [MOD_JUNO_SENSOR_NJ_BIG_IDX] = {
+        .name = "SCP_ENRG_BIG",
+        .data = &((struct mod_sensor_dev_config) {
+            .driver_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_JUNO_ADC,
+                                                 ADC_TYPE_ENERGY_METER,
+                                                 ADC_DEV_BIG),
+            .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_JUNO_ADC,
+                                             MOD_JUNO_ADC_API_IDX_DRIVER),
+        }),
+    },
+    [MOD_JUNO_SENSOR_NJ_LITTLE_IDX] = {
+        .name = "SCP_ENRG_LITTLE",
+        .data = &((struct mod_sensor_dev_config) {
+            .driver_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_JUNO_ADC,
+                                                 ADC_TYPE_ENERGY_METER,
+                                                 ADC_DEV_LITTLE),
+            .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_JUNO_ADC,
+                                             MOD_JUNO_ADC_API_IDX_DRIVER),
+        }),
+    },
+    [MOD_JUNO_SENSOR_NJ_GPU_IDX] = {
+        .name = "SCP_ENRG_GPU",
+        .data = &((struct mod_sensor_dev_config) {
+            .driver_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_JUNO_ADC,
+                                                 ADC_TYPE_ENERGY_METER,
+                                                 ADC_DEV_GPU),
+            .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_JUNO_ADC,
+                                             MOD_JUNO_ADC_API_IDX_DRIVER),
+        }),
+    },
+
 #if USE_FULL_SET_SENSORS
     [MOD_JUNO_SENSOR_AMPS_SYS_IDX] = {
         .name = "BRD_CURR_SYS",
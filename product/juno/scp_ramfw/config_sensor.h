@@ -30,6 +30,10 @@ enum mod_juno_sensor_element_idx {
     MOD_JUNO_SENSOR_VOLT_BIG_IDX,
     MOD_JUNO_SENSOR_VOLT_LITTLE_IDX,
     MOD_JUNO_SENSOR_VOLT_GPU_IDX,
+    MOD_JUNO_SENSOR_NJ_SYS_IDX,
+    MOD_JUNO_SENSOR_NJ_BIG_IDX,
+    MOD_JUNO_SENSOR_NJ_LITTLE_IDX,
+    MOD_JUNO_SENSOR_NJ_GPU_IDX,
 
     #if USE_FULL_SET_SENSORS
     MOD_JUNO_SENSOR_AMPS_SYS_IDX,
@@ -28,6 +28,7 @@ static const struct fwk_element agent_table[] = {
                 .transport_api_id = FWK_ID_API_INIT(
                     FWK_MODULE_IDX_MORELLO_SMT,
                     MOD_SMT_API_IDX_SCMI_AGENT_TRANSPORT),
+                .queue_depth = MCP_MORELLO_SCMI_AGENT_QUEUE_DEPTH,
             }),
         },
     [MCP_MORELLO_SCMI_AGENT_IDX_COUNT] = { 0 }
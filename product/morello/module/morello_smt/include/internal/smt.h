@@ -59,6 +59,6 @@ struct FWK_PACKED mod_smt_memory {
      (((PROTOCOL_ID) << SCMI_MESSAGE_HEADER_PROTOCOL_ID_POS) & \
       SCMI_MESSAGE_HEADER_PROTOCOL_ID_MASK) | \
      (((TOKEN) << SCMI_MESSAGE_HEADER_TOKEN_POS) & \
-      SCMI_MESSAGE_HEADER_TOKEN_POS))
+      SCMI_MESSAGE_HEADER_TOKEN_MASK))
 
 #endif /* INTERNAL_SMT_H */
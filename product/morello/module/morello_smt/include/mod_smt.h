@@ -78,23 +78,6 @@ struct mod_smt_channel_config {
     fwk_id_t pd_source_id;
 };
 
-/*!
- * \brief SMT command configuration (used by SCMI agent).
- */
-struct mod_smt_command_config {
-    /*! SCMI protocol ID of the command */
-    unsigned int protocol_id;
-
-    /*! SCMI message ID of the command */
-    unsigned int message_id;
-
-    /*! Pointer to SCMI payload data */
-    void *payload;
-
-    /*! SCMI payload size in bytes */
-    size_t size;
-};
-
 /*!
  * \brief Driver API
  */
@@ -235,60 +218,6 @@ struct mod_scmi_to_transport_api {
     int (*respond)(fwk_id_t channel_id, const void *payload, size_t size);
 };
 
-/*!
- * \brief SCMI Agent to Transport API
- *
- * \details Interface used for SCMI Agent -> SMT communication.
- */
-struct mod_scmi_agent_to_transport_api {
-    /*!
-     * \brief Check if a channel is free to use or not.
-     *
-     * \param channel_id Channel identifier
-     *
-     * \retval true The channel is free and the mailbox can be written to.
-     * \return false The channel is busy and the mailbox cannot be written.
-     */
-    bool (*is_channel_free)(fwk_id_t channel_id);
-
-    /*!
-     * \brief Send an SCMI message to platform
-     *
-     * \param channel_id Channel identifier
-     * \param cmd Pointer to SMT command configuration
-     *
-     * \retval ::FWK_SUCCESS The operation succeeded.
-     * \return One of the standard error codes for implementation-defined
-     *      errors.
-     */
-    int (*send)(fwk_id_t channel_id, struct mod_smt_command_config *cmd);
-
-    /*!
-     * \brief Get the SCMI payload from a channel.
-     *
-     * \param channel_id Channel identifier.
-     * \param[out] payload The pointer to the payload.
-     * \param[out] size The payload size. May be NULL, in which case the
-     *      parameter should be ignored.
-     *
-     * \retval ::FWK_SUCCESS The operation succeeded.
-     * \return One of the standard error codes for implementation-defined
-     *      errors.
-     */
-    int (*get_payload)(fwk_id_t channel_id, const void **payload, size_t *size);
-
-    /*!
-     * \brief Release the SMT channel
-     *
-     * \param channel_id Channel identifier
-     *
-     * \retval ::FWK_SUCCESS The operation succeeded.
-     * \return One of the standard error codes for implementation-defined
-     *      errors.
-     */
-    int (*put_channel)(fwk_id_t channel_id);
-};
-
 /*!
  * \brief Type of the interfaces exposed by the power domain module.
  */
@@ -8,10 +8,30 @@
 #ifndef N1SDP_MCP_SCMI_H
 #define N1SDP_MCP_SCMI_H
 
+#include <stdint.h>
+
 /* SCMI agent identifiers */
 enum mcp_n1sdp_scmi_agent_idx {
     MCP_N1SDP_SCMI_AGENT_IDX_MANAGEMENT,
     MCP_N1SDP_SCMI_AGENT_IDX_COUNT,
 };
 
+/* Number of messages which may be queued on an SCMI agent */
+#define MCP_N1SDP_SCMI_AGENT_QUEUE_DEPTH 4
+
+/* Management protocol identifier */
+#define SCMI_PROTOCOL_ID_MANAGEMENT UINT32_C(0x89)
+
+/* Management protocol version */
+#define SCMI_PROTOCOL_VERSION_MANAGEMENT UINT32_C(0x10000)
+
+/* Management protocol message identifiers */
+enum scmi_management_message_id {
+    SCMI_MANAGEMENT_PROTOCOL_VERSION_GET = 0x0,
+    SCMI_MANAGEMENT_PROTOCOL_ATTRIBUTES_GET = 0x1,
+    SCMI_MANAGEMENT_MESSAGE_ATTRIBUTES_GET = 0x2,
+    SCMI_MANAGEMENT_CLOCK_STATUS_GET = 0x3,
+    SCMI_MANAGEMENT_CHIPID_INFO_GET = 0x4,
+};
+
 #endif /* N1SDP_MCP_SCMI_H */
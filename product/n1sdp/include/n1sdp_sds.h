@@ -25,6 +25,9 @@ enum n1sdp_sds_struct_id {
     N1SDP_SDS_CPU_FLAGS =            7 | (1 << MOD_SDS_ID_VERSION_MAJOR_POS),
     N1SDP_SDS_PLATFORM_INFO =        8 | (1 << MOD_SDS_ID_VERSION_MAJOR_POS),
     N1SDP_SDS_BL33_INFO =            9 | (1 << MOD_SDS_ID_VERSION_MAJOR_POS),
+    N1SDP_SDS_DDR_TRAINING =         10 | (1 << MOD_SDS_ID_VERSION_MAJOR_POS),
+    N1SDP_SDS_PCIE_TOPOLOGY =        11 | (1 << MOD_SDS_ID_VERSION_MAJOR_POS),
+    N1SDP_SDS_CCIX_TOPOLOGY =        12 | (1 << MOD_SDS_ID_VERSION_MAJOR_POS),
 };
 
 enum n1sdp_sds_region_idx {
@@ -47,6 +50,8 @@ enum n1sdp_sds_region_idx {
 #define N1SDP_SDS_CPU_FLAGS_SIZE             256
 #define N1SDP_SDS_PLATFORM_INFO_SIZE         4
 #define N1SDP_SDS_BL33_INFO_SIZE             12
+#define N1SDP_SDS_DDR_TRAINING_SIZE          1168
+#define N1SDP_SDS_PCIE_TOPOLOGY_SIZE         400
 
 /*
  * Field masks and offsets for the N1SDP_SDS_AP_CPU_INFO structure.
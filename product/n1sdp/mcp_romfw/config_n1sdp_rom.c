@@ -17,6 +17,7 @@ const struct fwk_module_config config_n1sdp_rom = {
         .fip_base_address = MCP_QSPI_FLASH_BASE_ADDR,
         .fip_nvm_size = MCP_QSPI_FLASH_SIZE,
         .ramfw_base = MCP_RAM0_BASE,
+        .ramfw_size = MCP_RAM0_SIZE,
         .image_type = MOD_FIP_TOC_ENTRY_MCP_BL2,
     })
 };
@@ -29,10 +29,19 @@
  * \brief Driver support for N1SDP C2C.
  *
  * \details This module provides support for SCP to SCP I2C communication.
+ *      Every command sent by the master chip carries a tag that the slave chip
+ *      echoes in its response, so that a late response to an earlier command
+ *      is never taken for the response to the current one.
  *
  * \{
  */
 
+/*!
+ * \brief Maximum number of power domains whose state is queried by a single
+ *      ::N1SDP_C2C_CMD_POWER_DOMAIN_GET_STATE_BATCH command.
+ */
+#define N1SDP_C2C_PD_BATCH_MAX 5
+
 /*!
  * \brief N1SDP C2C Handshake commands
  */
@@ -55,6 +64,7 @@ enum n1sdp_c2c_cmd {
     N1SDP_C2C_CMD_POWER_DOMAIN_OFF,
     N1SDP_C2C_CMD_POWER_DOMAIN_GET_STATE,
     N1SDP_C2C_CMD_SHUTDOWN_OR_REBOOT,
+    N1SDP_C2C_CMD_POWER_DOMAIN_GET_STATE_BATCH,
 };
 
 /*!
@@ -144,6 +154,24 @@ struct n1sdp_c2c_pd_api {
     int (*shutdown_reboot)(
         enum n1sdp_c2c_cmd cmd,
         enum mod_pd_system_shutdown type);
+    /*!
+     * \brief API to get the power states of several power domains in remote
+     *      chip.
+     *
+     * \details The states are queried ::N1SDP_C2C_PD_BATCH_MAX power domains
+     *      at a time, with one I2C command and response per batch.
+     *
+     * \param pd_ids The target power domain IDs.
+     * \param count Number of power domains.
+     * \param[out] states Current power states, in the order of pd_ids.
+     *
+     * \retval ::FWK_SUCCESS If operation succeeds.
+     * \return One of the possible error return codes.
+     */
+    int (*get_states)(
+        const uint8_t *pd_ids,
+        unsigned int count,
+        unsigned int *states);
 };
 
 /*!
@@ -50,6 +50,22 @@
 #define N1SDP_C2C_SUCCESS          0
 #define N1SDP_C2C_ERROR            1
 
+/*
+ * Packet layout. The first byte holds the command (master to slave) or the
+ * status (slave to master) and the last byte the tag of the command.
+ */
+#define N1SDP_C2C_CMD_IDX          0
+#define N1SDP_C2C_STATUS_IDX       0
+#define N1SDP_C2C_TAG_IDX          (N1SDP_C2C_DATA_SIZE - 1)
+
+/* Batched power domain state query layout, after the command or status */
+#define N1SDP_C2C_BATCH_COUNT_IDX  1
+#define N1SDP_C2C_BATCH_DATA_IDX   2
+
+static_assert((N1SDP_C2C_BATCH_DATA_IDX + N1SDP_C2C_PD_BATCH_MAX) <=
+              N1SDP_C2C_TAG_IDX,
+              "N1SDP_C2C_PD_BATCH_MAX too large for the C2C packet");
+
 #define CORE_COUNT_PER_CHIP        4
 
 #define C2C_MASTER_RETRY_DELAY_US  UINT32_C(10000)
@@ -80,6 +96,7 @@ static const char * const cmd_str[] = {
     [N1SDP_C2C_CMD_POWER_DOMAIN_OFF] = "Power domain OFF",
     [N1SDP_C2C_CMD_POWER_DOMAIN_GET_STATE] = "Get power state",
     [N1SDP_C2C_CMD_SHUTDOWN_OR_REBOOT] = "Shutdown/Reboot",
+    [N1SDP_C2C_CMD_POWER_DOMAIN_GET_STATE_BATCH] = "Get power states",
 };
 
 /* Module context */
@@ -129,6 +146,9 @@ struct n1sdp_c2c_ctx {
     /* Storage for slave DDR size in GB */
     uint8_t slave_ddr_size_gb;
 
+    /* Tag of the last command sent in master mode */
+    uint8_t tag;
+
     /* Storage for transmit data in master mode */
     uint8_t master_tx_data[N1SDP_C2C_DATA_SIZE];
 
@@ -153,7 +173,13 @@ static int n1sdp_c2c_master_tx_command(uint8_t cmd)
 
     FWK_LOG_INFO("[C2C] %s in slave...", cmd_str[cmd]);
 
-    n1sdp_c2c_ctx.master_tx_data[0] = cmd;
+    /* Tag zero is skipped so that an all-zero packet never matches */
+    n1sdp_c2c_ctx.tag++;
+    if (n1sdp_c2c_ctx.tag == 0)
+        n1sdp_c2c_ctx.tag = 1;
+
+    n1sdp_c2c_ctx.master_tx_data[N1SDP_C2C_CMD_IDX] = cmd;
+    n1sdp_c2c_ctx.master_tx_data[N1SDP_C2C_TAG_IDX] = n1sdp_c2c_ctx.tag;
     status = n1sdp_c2c_ctx.master_api->write(
         n1sdp_c2c_ctx.config->i2c_id,
         n1sdp_c2c_ctx.config->slave_addr,
@@ -181,11 +207,48 @@ static int n1sdp_c2c_master_rx_response(void)
         FWK_LOG_INFO("[C2C] Error %d!", status);
         return status;
     }
+
+    if (n1sdp_c2c_ctx.master_rx_data[N1SDP_C2C_TAG_IDX] !=
+        n1sdp_c2c_ctx.tag) {
+        FWK_LOG_INFO("[C2C] Stale response discarded");
+        return FWK_E_BUSY;
+    }
     FWK_LOG_INFO("[C2C] Received");
 
     return FWK_SUCCESS;
 }
 
+/*
+ * Wait for the response to the last command, reading it up to 'attempts'
+ * times, and return the status reported by the slave.
+ */
+static int n1sdp_c2c_master_get_result(unsigned int attempts)
+{
+    int status;
+
+    fwk_assert(attempts != 0);
+
+    for (;;) {
+        status = n1sdp_c2c_master_rx_response();
+        if ((status == FWK_SUCCESS) || (--attempts == 0))
+            break;
+
+        n1sdp_c2c_ctx.timer_api->delay(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
+                                       C2C_MASTER_RETRY_DELAY_US);
+    }
+
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (n1sdp_c2c_ctx.master_rx_data[N1SDP_C2C_STATUS_IDX] !=
+        N1SDP_C2C_SUCCESS) {
+        FWK_LOG_INFO("[C2C] Command failed in slave!");
+        return FWK_E_STATE;
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int n1sdp_c2c_check_remote(void)
 {
     int status;
@@ -237,127 +300,36 @@ static int n1sdp_c2c_multichip_run_command(uint8_t cmd, bool run_in_slave)
     case N1SDP_C2C_CMD_PCIE_POWER_ON:
         status = n1sdp_c2c_ctx.pcie_init_api->power_on(
             n1sdp_c2c_ctx.config->ccix_id);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_PCIE_PHY_INIT:
         status = n1sdp_c2c_ctx.pcie_init_api->phy_init(
             n1sdp_c2c_ctx.config->ccix_id);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_PCIE_CTRL_INIT:
         status = n1sdp_c2c_ctx.pcie_init_api->controller_init(
             n1sdp_c2c_ctx.config->ccix_id, false);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_PCIE_LINK_TRAIN:
         status = n1sdp_c2c_ctx.pcie_init_api->link_training(
             n1sdp_c2c_ctx.config->ccix_id, false);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_PCIE_RC_SETUP:
         status = n1sdp_c2c_ctx.pcie_init_api->rc_setup(
             n1sdp_c2c_ctx.config->ccix_id);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_PCIE_VC1_CONFIG:
         status = n1sdp_c2c_ctx.pcie_init_api->vc1_setup(
             n1sdp_c2c_ctx.config->ccix_id, CCIX_VC1_TC);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_PCIE_CCIX_CONFIG:
         status = n1sdp_c2c_ctx.ccix_config_api->enable_opt_tlp(
             CCIX_OPT_TLP_EN);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_CMN600_SET_CONFIG:
@@ -377,106 +349,30 @@ static int n1sdp_c2c_multichip_run_command(uint8_t cmd, bool run_in_slave)
         remote_config.ccix_max_packet_size = CCIX_PROP_MAX_PACK_SIZE_512;
 
         status = n1sdp_c2c_ctx.cmn600_api->set_config(&remote_config);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_CMN600_XCHANGE_CREDITS:
         status = n1sdp_c2c_ctx.cmn600_api->exchange_protocol_credit(
             CMN600_CCIX_LINK_ID);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_CMN600_ENTER_SYS_COHERENCY:
         status = n1sdp_c2c_ctx.cmn600_api->enter_system_coherency(
             CMN600_CCIX_LINK_ID);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_CMN600_ENTER_DVM_DOMAIN:
         status = n1sdp_c2c_ctx.cmn600_api->enter_dvm_domain(
             CMN600_CCIX_LINK_ID);
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     case N1SDP_C2C_CMD_GET_SLV_DDR_SIZE:
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-            n1sdp_c2c_ctx.slave_ddr_size_gb = n1sdp_c2c_ctx.master_rx_data[1];
-            FWK_LOG_INFO(
-                "[C2C] Slave DDR Size: %d GB", n1sdp_c2c_ctx.slave_ddr_size_gb);
-        }
+        status = FWK_SUCCESS;
         break;
 
     case N1SDP_C2C_CMD_TIMER_SYNC:
         status = n1sdp_c2c_ctx.tsync_api->master_sync(
             FWK_ID_ELEMENT(FWK_MODULE_IDX_N1SDP_TIMER_SYNC, 0));
-        if (status != FWK_SUCCESS) {
-            FWK_LOG_INFO("[C2C] Error!");
-            return status;
-        }
-        if (run_in_slave) {
-            status = n1sdp_c2c_master_rx_response();
-            if (status != FWK_SUCCESS)
-                return status;
-            if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
-                FWK_LOG_INFO("[C2C] Command failed in slave!");
-                return FWK_E_STATE;
-            }
-        }
         break;
 
     default:
@@ -484,6 +380,28 @@ static int n1sdp_c2c_multichip_run_command(uint8_t cmd, bool run_in_slave)
         return FWK_E_DEVICE;
     }
 
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_INFO("[C2C] Error!");
+        return status;
+    }
+
+    if (!run_in_slave)
+        return FWK_SUCCESS;
+
+    /*
+     * The command ran in both chips at the same time, only collect the
+     * response of the slave once the master side is done.
+     */
+    status = n1sdp_c2c_master_get_result(1);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (cmd == N1SDP_C2C_CMD_GET_SLV_DDR_SIZE) {
+        n1sdp_c2c_ctx.slave_ddr_size_gb = n1sdp_c2c_ctx.master_rx_data[1];
+        FWK_LOG_INFO(
+            "[C2C] Slave DDR Size: %d GB", n1sdp_c2c_ctx.slave_ddr_size_gb);
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -584,6 +502,7 @@ static int n1sdp_c2c_process_command(void)
     uint8_t rx_data[N1SDP_C2C_DATA_SIZE];
     uint32_t ddr_size_gb = 0;
     unsigned int state = 0;
+    unsigned int pd_idx;
     struct mod_cmn600_ccix_remote_node_config remote_config;
 
     memcpy(rx_data, n1sdp_c2c_ctx.slave_rx_data, N1SDP_C2C_DATA_SIZE);
@@ -773,6 +692,37 @@ static int n1sdp_c2c_process_command(void)
         n1sdp_c2c_ctx.slave_tx_data[1] = (uint8_t)state;
         break;
 
+    case N1SDP_C2C_CMD_POWER_DOMAIN_GET_STATE_BATCH:
+        /*
+         * rx_data[0] - Contains the C2C command
+         * rx_data[1] - Contains the number of power domains
+         * rx_data[2..] - Contain the target power domain IDs
+         *
+         * The states are returned at the same offsets in the response.
+         */
+        if ((rx_data[N1SDP_C2C_BATCH_COUNT_IDX] == 0) ||
+            (rx_data[N1SDP_C2C_BATCH_COUNT_IDX] > N1SDP_C2C_PD_BATCH_MAX)) {
+            status = FWK_E_PARAM;
+            goto error;
+        }
+
+        n1sdp_c2c_ctx.slave_tx_data[N1SDP_C2C_BATCH_COUNT_IDX] =
+            rx_data[N1SDP_C2C_BATCH_COUNT_IDX];
+
+        for (pd_idx = 0; pd_idx < rx_data[N1SDP_C2C_BATCH_COUNT_IDX];
+             pd_idx++) {
+            status = n1sdp_c2c_ctx.pd_api->get_state(
+                FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN,
+                               rx_data[N1SDP_C2C_BATCH_DATA_IDX + pd_idx]),
+                &state);
+            if (status != FWK_SUCCESS)
+                goto error;
+
+            n1sdp_c2c_ctx.slave_tx_data[N1SDP_C2C_BATCH_DATA_IDX + pd_idx] =
+                (uint8_t)state;
+        }
+        break;
+
     case N1SDP_C2C_CMD_TIMER_SYNC:
         status = n1sdp_c2c_ctx.tsync_api->slave_sync(
             FWK_ID_ELEMENT(FWK_MODULE_IDX_N1SDP_TIMER_SYNC, 0));
@@ -815,9 +765,12 @@ static int n1sdp_c2c_process_command(void)
 
 error:
     if (status == FWK_SUCCESS)
-        n1sdp_c2c_ctx.slave_tx_data[0] = N1SDP_C2C_SUCCESS;
+        n1sdp_c2c_ctx.slave_tx_data[N1SDP_C2C_STATUS_IDX] = N1SDP_C2C_SUCCESS;
     else
-        n1sdp_c2c_ctx.slave_tx_data[0] = N1SDP_C2C_ERROR;
+        n1sdp_c2c_ctx.slave_tx_data[N1SDP_C2C_STATUS_IDX] = N1SDP_C2C_ERROR;
+
+    /* Echo the tag so that the master can match the response */
+    n1sdp_c2c_ctx.slave_tx_data[N1SDP_C2C_TAG_IDX] = rx_data[N1SDP_C2C_TAG_IDX];
 
     status = n1sdp_c2c_ctx.slave_api->write(
         n1sdp_c2c_ctx.config->i2c_id,
@@ -864,7 +817,6 @@ static int n1sdp_c2c_pd_set_state(enum n1sdp_c2c_cmd cmd, uint8_t pd_id,
     uint8_t pd_type)
 {
     int status;
-    uint8_t retries;
 
     n1sdp_c2c_ctx.master_tx_data[1] = pd_id;
     n1sdp_c2c_ctx.master_tx_data[2] = pd_type;
@@ -876,33 +828,17 @@ static int n1sdp_c2c_pd_set_state(enum n1sdp_c2c_cmd cmd, uint8_t pd_id,
      * PD command in slave will take some time to complete so master
      * has to retry waiting for response from slave.
      */
-    retries = C2C_MASTER_RETRIES;
-    do {
-        status = n1sdp_c2c_master_rx_response();
-        if (status == FWK_SUCCESS)
-            break;
-
-        retries--;
-        n1sdp_c2c_ctx.timer_api->delay(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                       C2C_MASTER_RETRY_DELAY_US);
-    } while (retries != 0);
-
-    if ((retries == 0) && (status != FWK_SUCCESS))
-        return status;
-
-    if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
+    status = n1sdp_c2c_master_get_result(C2C_MASTER_RETRIES);
+    if (status != FWK_SUCCESS)
         FWK_LOG_INFO("[C2C] PD request failed!");
-        return FWK_E_STATE;
-    }
 
-    return FWK_SUCCESS;
+    return status;
 }
 
 static int n1sdp_c2c_pd_get_state(enum n1sdp_c2c_cmd cmd, uint8_t pd_id,
     unsigned int *state)
 {
     int status;
-    uint8_t retries;
 
     fwk_assert(state != NULL);
 
@@ -915,34 +851,63 @@ static int n1sdp_c2c_pd_get_state(enum n1sdp_c2c_cmd cmd, uint8_t pd_id,
      * PD command in slave will take some time to complete so master
      * has to retry waiting for response from slave.
      */
-    retries = C2C_MASTER_RETRIES;
-    do {
-        status = n1sdp_c2c_master_rx_response();
-        if (status == FWK_SUCCESS)
-            break;
-        retries--;
-
-        n1sdp_c2c_ctx.timer_api->delay(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                       C2C_MASTER_RETRY_DELAY_US);
-    } while (retries != 0);
-
-    if ((retries == 0) && (status != FWK_SUCCESS))
-        return status;
-
-    /*
-     * master_rx_data[0] contains return status code
-     * master_rx_data[1] contains the current PD state in target
-     */
-    if (n1sdp_c2c_ctx.master_rx_data[0] != N1SDP_C2C_SUCCESS) {
+    status = n1sdp_c2c_master_get_result(C2C_MASTER_RETRIES);
+    if (status != FWK_SUCCESS) {
         FWK_LOG_INFO("[C2C] PD request failed!");
-        return FWK_E_STATE;
+        return status;
     }
 
+    /* master_rx_data[1] contains the current PD state in target */
     *state = n1sdp_c2c_ctx.master_rx_data[1];
 
     return FWK_SUCCESS;
 }
 
+static int n1sdp_c2c_pd_get_states(const uint8_t *pd_ids, unsigned int count,
+    unsigned int *states)
+{
+    int status;
+    unsigned int batch_count;
+    unsigned int pd_idx;
+
+    fwk_assert((pd_ids != NULL) && (states != NULL));
+
+    while (count != 0) {
+        batch_count = FWK_MIN(count, (unsigned int)N1SDP_C2C_PD_BATCH_MAX);
+
+        n1sdp_c2c_ctx.master_tx_data[N1SDP_C2C_BATCH_COUNT_IDX] =
+            (uint8_t)batch_count;
+        memcpy(&n1sdp_c2c_ctx.master_tx_data[N1SDP_C2C_BATCH_DATA_IDX],
+               pd_ids, batch_count);
+
+        status = n1sdp_c2c_master_tx_command(
+            (uint8_t)N1SDP_C2C_CMD_POWER_DOMAIN_GET_STATE_BATCH);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = n1sdp_c2c_master_get_result(C2C_MASTER_RETRIES);
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_INFO("[C2C] PD request failed!");
+            return status;
+        }
+
+        if (n1sdp_c2c_ctx.master_rx_data[N1SDP_C2C_BATCH_COUNT_IDX] !=
+            batch_count)
+            return FWK_E_DEVICE;
+
+        for (pd_idx = 0; pd_idx < batch_count; pd_idx++) {
+            states[pd_idx] =
+                n1sdp_c2c_ctx.master_rx_data[N1SDP_C2C_BATCH_DATA_IDX + pd_idx];
+        }
+
+        pd_ids += batch_count;
+        states += batch_count;
+        count -= batch_count;
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int n1sdp_c2c_pd_shutdown_reboot(enum n1sdp_c2c_cmd cmd,
                                         enum mod_pd_system_shutdown type)
 {
@@ -959,6 +924,7 @@ static const struct n1sdp_c2c_pd_api pd_api = {
     .set_state = n1sdp_c2c_pd_set_state,
     .get_state = n1sdp_c2c_pd_get_state,
     .shutdown_reboot = n1sdp_c2c_pd_shutdown_reboot,
+    .get_states = n1sdp_c2c_pd_get_states,
 };
 
 /*
@@ -18,6 +18,7 @@
 #include <fwk_assert.h>
 #include <fwk_id.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
@@ -31,6 +32,17 @@
 #define NUM_DATA_PATTERNS   5
 #define DCI_FIFO_SIZE       20
 
+/* Data slice register helpers */
+#define SLICE_REG_STRIDE            256
+#define PER_CS_TRAINING_INDEX_REG   9
+#define PER_CS_TRAINING_INDEX_MASK  0x00030000
+#define PER_CS_TRAINING_INDEX_POS   16
+#define MANUAL_UPDATE_REG           2310
+
+/* Number of 32-bit words in a DFI beat, the last one holding 16 bits */
+#define DCI_WORDS_PER_BEAT  5
+#define DCI_LAST_WORD_MASK  0x0000FFFF
+
 struct wrdq_eye {
     uint16_t min;
     uint8_t min_found;
@@ -1113,6 +1125,183 @@ static int n1sdp_phy_obs_regs(fwk_id_t element_id,
     return n1sdp_read_eye_phy_obs_regs(element_id, info);
 }
 
+/*
+ * Training results caching
+ */
+
+/* Data slice registers holding the training results of the selected rank */
+static const uint16_t training_reg_idx[] = {
+    /* Write DQ slave delays, two bits per register */
+    82, 83, 84, 85,
+    /* Read DQS gate slave delay and latency adjust, x8 then x4 devices */
+    112, 116,
+    /* Read pointer updates, x8 then x4 devices */
+    129, 133,
+};
+
+static_assert((NUM_SLICES * FWK_ARRAY_SIZE(training_reg_idx)) ==
+                  DDR_PHY_TRAINING_REG_COUNT,
+              "Training register count mismatch");
+
+static inline volatile uint32_t *slice_reg(uint32_t phy_addr,
+    uint32_t slice, uint32_t reg_idx)
+{
+    return (volatile uint32_t *)(phy_addr +
+                                 (4 * (reg_idx + (slice * SLICE_REG_STRIDE))));
+}
+
+static void select_training_rank(uint32_t phy_addr, uint32_t rank)
+{
+    volatile uint32_t *reg;
+    uint32_t slice;
+
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        reg = slice_reg(phy_addr, slice, PER_CS_TRAINING_INDEX_REG);
+        *reg = (*reg & ~PER_CS_TRAINING_INDEX_MASK) |
+               (rank << PER_CS_TRAINING_INDEX_POS);
+    }
+}
+
+/*
+ * Copy the training results of every rank from the PHY registers to saved_regs
+ * when it is not NULL, then from restored_regs to the PHY registers when it is
+ * not NULL. The results of a rank start at rank * DDR_PHY_TRAINING_REG_COUNT.
+ */
+static void transfer_training(uint32_t phy_addr, struct dimm_info *info,
+    uint32_t *saved_regs, const uint32_t *restored_regs)
+{
+    uint32_t orig_training_idx_vals[NUM_SLICES];
+    volatile uint32_t *reg;
+    uint32_t rank;
+    uint32_t slice;
+    uint32_t i;
+    uint32_t n;
+
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        orig_training_idx_vals[slice] =
+            *slice_reg(phy_addr, slice, PER_CS_TRAINING_INDEX_REG);
+    }
+
+    for (rank = 0; rank < info->number_of_ranks; rank++) {
+        select_training_rank(phy_addr, rank);
+
+        n = rank * DDR_PHY_TRAINING_REG_COUNT;
+        for (slice = 0; slice < NUM_SLICES; slice++) {
+            for (i = 0; i < FWK_ARRAY_SIZE(training_reg_idx); i++, n++) {
+                reg = slice_reg(phy_addr, slice, training_reg_idx[i]);
+                if (saved_regs != NULL)
+                    saved_regs[n] = *reg;
+                if (restored_regs != NULL)
+                    *reg = restored_regs[n];
+            }
+        }
+    }
+
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        *slice_reg(phy_addr, slice, PER_CS_TRAINING_INDEX_REG) =
+            orig_training_idx_vals[slice];
+    }
+
+    if (restored_regs != NULL) {
+        /* Apply the new slave delays */
+        delay_ms(1);
+        *(volatile uint32_t *)(phy_addr + (4 * MANUAL_UPDATE_REG)) |= 1;
+    }
+}
+
+/*
+ * Write the data patterns to every rank and read them back.
+ */
+static int check_training(fwk_id_t element_id, struct dimm_info *info)
+{
+    struct mod_dmc620_reg *dmc;
+    uint32_t rank;
+    uint32_t pattern;
+    uint32_t mask;
+    uint32_t i;
+    int status;
+
+    switch (fwk_id_get_element_idx(element_id)) {
+    case 0:
+        dmc = (struct mod_dmc620_reg *)SCP_DMC0;
+        break;
+    case 1:
+        dmc = (struct mod_dmc620_reg *)SCP_DMC1;
+        break;
+    default:
+        return FWK_E_PARAM;
+    }
+
+    for (rank = 0; rank < info->number_of_ranks; rank++) {
+        for (pattern = 0; pattern < NUM_DATA_PATTERNS; pattern++) {
+            status = dci_write_dram(dmc, wr_data_all[pattern], DCI_FIFO_SIZE,
+                                    rank, 0);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            status = dci_read_dram(dmc, rd_data, DCI_FIFO_SIZE, rank, 0);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            for (i = 0; i < DCI_FIFO_SIZE; i++) {
+                mask = ((i % DCI_WORDS_PER_BEAT) == (DCI_WORDS_PER_BEAT - 1)) ?
+                       DCI_LAST_WORD_MASK : UINT32_MAX;
+                if (((rd_data[i] ^ wr_data_all[pattern][i]) & mask) != 0)
+                    return FWK_E_DEVICE;
+            }
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_ddr_phy_save_training(fwk_id_t element_id,
+    struct dimm_info *info, uint32_t *regs)
+{
+    const struct mod_n1sdp_ddr_phy_element_config *element_config;
+
+    fwk_assert((info != NULL) && (regs != NULL));
+
+    if (info->number_of_ranks > DDR_PHY_TRAINING_RANK_MAX)
+        return FWK_E_SUPPORT;
+
+    element_config = fwk_module_get_data(element_id);
+    transfer_training((uint32_t)element_config->ddr, info, regs, NULL);
+
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_ddr_phy_restore_training(fwk_id_t element_id,
+    struct dimm_info *info, const uint32_t *regs)
+{
+    static uint32_t
+        previous_regs[DDR_PHY_TRAINING_RANK_MAX * DDR_PHY_TRAINING_REG_COUNT];
+    const struct mod_n1sdp_ddr_phy_element_config *element_config;
+    uint32_t phy_addr;
+    int status;
+
+    fwk_assert((info != NULL) && (regs != NULL));
+
+    if (info->number_of_ranks > DDR_PHY_TRAINING_RANK_MAX)
+        return FWK_E_SUPPORT;
+
+    element_config = fwk_module_get_data(element_id);
+    phy_addr = (uint32_t)element_config->ddr;
+
+    FWK_LOG_INFO(
+        "[DDR-PHY] Restoring training results at 0x%" PRIX32, phy_addr);
+
+    transfer_training(phy_addr, info, previous_regs, regs);
+
+    status = check_training(element_id, info);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_INFO("[DDR-PHY] Restored training results check FAIL");
+        transfer_training(phy_addr, info, NULL, previous_regs);
+    }
+
+    return status;
+}
+
 static struct mod_dmc_ddr_phy_api n1sdp_ddr_phy_api = {
     .configure = n1sdp_ddr_phy_config,
     .post_training_configure = n1sdp_ddr_phy_post_training_configure,
@@ -1120,6 +1309,8 @@ static struct mod_dmc_ddr_phy_api n1sdp_ddr_phy_api = {
     .wrlvl_phy_obs_regs = n1sdp_wrlvl_phy_obs_regs,
     .read_gate_phy_obs_regs = n1sdp_read_gate_phy_obs_regs,
     .phy_obs_regs = n1sdp_phy_obs_regs,
+    .save_training = n1sdp_ddr_phy_save_training,
+    .restore_training = n1sdp_ddr_phy_restore_training,
 };
 
 /*
@@ -656,6 +656,19 @@ struct mod_dmc620_reg {
  */
 #define DDR_ADDR_DATA_SLICES_POS           12
 
+/*!
+ * \brief Number of PHY registers holding the training results of a rank
+ */
+#define DDR_PHY_TRAINING_REG_COUNT         72
+/*!
+ * \brief Maximum number of ranks whose training results are cached
+ */
+#define DDR_PHY_TRAINING_RANK_MAX          2
+/*!
+ * \brief Maximum number of DMCs whose training results are cached
+ */
+#define MOD_DMC620_TRAINING_DMC_MAX        2
+
 /*!
  * \brief Element configuration.
  */
@@ -770,6 +783,67 @@ struct mod_dmc_ddr_phy_api {
     int (*phy_obs_regs)(fwk_id_t element_id,
                         uint32_t rank,
                         struct dimm_info *info);
+
+    /*!
+     * \brief Save the training results of a DDR physical device
+     *
+     * \param element_id Element identifier corresponding to the device.
+     * \param info Pointer to the DIMM information structure.
+     * \param[out] regs Training results, ::DDR_PHY_TRAINING_REG_COUNT
+     *      registers per rank.
+     *
+     * \retval ::FWK_SUCCESS if the operation succeed.
+     * \return one of the error code otherwise.
+     */
+    int (*save_training)(fwk_id_t element_id,
+                         struct dimm_info *info,
+                         uint32_t *regs);
+
+    /*!
+     * \brief Restore saved training results to a DDR physical device
+     *
+     * \details The DMC must be in the CONFIG state. The restored settings are
+     *      checked with a write and read back of data patterns to every rank.
+     *
+     * \param element_id Element identifier corresponding to the device.
+     * \param info Pointer to the DIMM information structure.
+     * \param regs Training results, ::DDR_PHY_TRAINING_REG_COUNT registers
+     *      per rank.
+     *
+     * \retval ::FWK_SUCCESS if the operation succeed.
+     * \retval ::FWK_E_DEVICE if the data patterns were not read back, in
+     *      which case the device must be trained again.
+     * \return one of the error code otherwise.
+     */
+    int (*restore_training)(fwk_id_t element_id,
+                            struct dimm_info *info,
+                            const uint32_t *regs);
+};
+
+/*!
+ * \brief Cached training results, kept in a Shared Data Structure.
+ *
+ * \details The structure survives warm resets. Its content is reused only
+ *      when the signature matches the DIMMs found at boot and the temperature
+ *      is still within the configured tolerance, otherwise the DIMMs are
+ *      trained again and the cache is refreshed.
+ */
+struct mod_dmc620_training_sds {
+    /*! Hash of the DIMM SPD data, the DDR speed and the cache layout */
+    uint32_t signature;
+
+    /*! Temperature at the time of the training, in sensor units */
+    int32_t temperature;
+
+    /*! Mask of the DMCs whose training results are valid */
+    uint32_t valid_mask;
+
+    /*! Reserved, zero */
+    uint32_t reserved;
+
+    /*! PHY training results of each DMC */
+    uint32_t phy_regs[MOD_DMC620_TRAINING_DMC_MAX]
+                     [DDR_PHY_TRAINING_RANK_MAX * DDR_PHY_TRAINING_REG_COUNT];
 };
 
 /*!
@@ -808,6 +882,23 @@ struct mod_dmc620_module_config {
     fwk_id_t ddr_api_id;
     /*! DDR operating frequency */
     uint16_t ddr_speed;
+    /*!
+     * Identifier of the Shared Data Structure caching the training results,
+     * see ::mod_dmc620_training_sds, or zero to train on every boot.
+     */
+    uint32_t training_sds_structure_id;
+    /*!
+     * Identifier of the temperature sensor whose value is part of the cache
+     * signature, or ::FWK_ID_NONE to ignore the temperature.
+     */
+    fwk_id_t temp_sensor_id;
+    /*! API identifier of the temperature sensor driver */
+    fwk_id_t temp_sensor_api_id;
+    /*!
+     * Largest temperature difference, in sensor units, from the training
+     * temperature for which the cached training results are reused.
+     */
+    uint32_t training_temp_tolerance;
 };
 
 /*!
@@ -465,6 +465,26 @@ void dimm_spd_mem_info(void)
     dimm_device_data((uint8_t *)&ddr4_dimm1, 1);
 }
 
+uint32_t dimm_spd_signature(uint32_t hash)
+{
+    const uint8_t *spd[] = {
+        (const uint8_t *)&ddr4_dimm0,
+        (const uint8_t *)&ddr4_dimm1,
+    };
+    unsigned int dimm;
+    unsigned int i;
+
+    /* FNV-1a over the SPD data of both DIMMs */
+    for (dimm = 0; dimm < FWK_ARRAY_SIZE(spd); dimm++) {
+        for (i = 0; i < sizeof(struct ddr4_spd); i++) {
+            hash ^= spd[dimm][i];
+            hash *= UINT32_C(16777619);
+        }
+    }
+
+    return hash;
+}
+
 int dimm_spd_address_control(uint32_t *temp_reg, struct dimm_info *ddr)
 {
     int status;
@@ -372,6 +372,15 @@ int dimm_spd_init_check(struct mod_n1sdp_i2c_master_api_polled *i2c_api,
  */
 void dimm_spd_mem_info(void);
 
+/*
+ * Brief - Function to compute a signature of the DIMM SPD data
+ *
+ * param - hash - Value the signature is accumulated into
+ *
+ * retval - Signature of the SPD data of both DIMMs
+ */
+uint32_t dimm_spd_signature(uint32_t hash);
+
 /*
  * Brief - Function to calculate DMC-620 ADDRESS_CONTROL register value
  *
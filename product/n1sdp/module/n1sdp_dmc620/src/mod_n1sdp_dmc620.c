@@ -16,6 +16,8 @@
 #include <mod_clock.h>
 #include <mod_n1sdp_dmc620.h>
 #include <mod_n1sdp_i2c.h>
+#include <mod_sds.h>
+#include <mod_sensor.h>
 #include <mod_timer.h>
 
 #include <fwk_assert.h>
@@ -32,15 +34,29 @@
 #include <inttypes.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdlib.h>
 
 /* DMC-620 register specific definitions */
 #define DDR_TRAIN_TWO_RANKS          0
 
+/* Version of the layout of the cached training results */
+#define DDR_TRAINING_CACHE_VERSION   1
+
 static struct mod_dmc_ddr_phy_api *ddr_phy_api;
 static struct mod_timer_api *timer_api;
 static struct mod_n1sdp_i2c_master_api_polled *i2c_api;
+static struct mod_sds_api *sds_api;
+static const struct mod_sensor_driver_api *temp_sensor_api;
 static struct dimm_info ddr_info;
 
+/* Cached training results state */
+static bool training_cache_enabled;
+static uint32_t training_signature;
+static int32_t training_temperature;
+static uint32_t training_valid_mask;
+static uint32_t
+    training_regs[DDR_PHY_TRAINING_RANK_MAX * DDR_PHY_TRAINING_REG_COUNT];
+
 /*
  * DMC-620 interrupt handling functions
  */
@@ -810,6 +826,192 @@ static int enable_dimm_refresh(struct mod_dmc620_reg *dmc)
     return ddr_poll_training_status(dmc);
 }
 
+/*
+ * DDR training results caching
+ */
+
+static int training_cache_read(unsigned int offset, void *data, size_t size)
+{
+    const struct mod_dmc620_module_config *module_config;
+
+    module_config = fwk_module_get_data(fwk_module_id_n1sdp_dmc620);
+
+    return sds_api->struct_read(module_config->training_sds_structure_id,
+                                offset, data, size);
+}
+
+static int training_cache_write(unsigned int offset, const void *data,
+    size_t size)
+{
+    const struct mod_dmc620_module_config *module_config;
+
+    module_config = fwk_module_get_data(fwk_module_id_n1sdp_dmc620);
+
+    return sds_api->struct_write(module_config->training_sds_structure_id,
+                                 offset, data, size);
+}
+
+static int read_temperature(int32_t *temperature)
+{
+    int status;
+    uint64_t value;
+    const struct mod_dmc620_module_config *module_config;
+
+    if (temp_sensor_api == NULL) {
+        *temperature = 0;
+        return FWK_SUCCESS;
+    }
+
+    module_config = fwk_module_get_data(fwk_module_id_n1sdp_dmc620);
+
+    status = temp_sensor_api->get_value(module_config->temp_sensor_id, &value);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *temperature = (int32_t)value;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Check the cached training results against the DIMMs found at boot. Called
+ * once, before the first DMC is configured.
+ */
+static void training_cache_check(void)
+{
+    int status;
+    uint32_t signature;
+    int32_t temperature;
+    uint32_t valid_mask;
+    const struct mod_dmc620_module_config *module_config;
+
+    training_cache_enabled = false;
+    training_valid_mask = 0;
+
+    if (sds_api == NULL)
+        return;
+
+    module_config = fwk_module_get_data(fwk_module_id_n1sdp_dmc620);
+
+    training_signature = dimm_spd_signature(
+        ((uint32_t)DDR_TRAINING_CACHE_VERSION << 16) ^ ddr_info.speed);
+
+    status = read_temperature(&training_temperature);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_INFO("[DDR] Temperature unavailable, training cache unused");
+        return;
+    }
+
+    training_cache_enabled = true;
+
+    status = training_cache_read(
+        offsetof(struct mod_dmc620_training_sds, signature),
+        &signature, sizeof(signature));
+    if (status == FWK_SUCCESS) {
+        status = training_cache_read(
+            offsetof(struct mod_dmc620_training_sds, temperature),
+            &temperature, sizeof(temperature));
+    }
+    if (status == FWK_SUCCESS) {
+        status = training_cache_read(
+            offsetof(struct mod_dmc620_training_sds, valid_mask),
+            &valid_mask, sizeof(valid_mask));
+    }
+    if ((status != FWK_SUCCESS) || (valid_mask == 0))
+        return;
+
+    if (signature != training_signature) {
+        FWK_LOG_INFO("[DDR] DIMMs changed, cached training results dropped");
+        return;
+    }
+
+    if ((uint32_t)abs(temperature - training_temperature) >
+        module_config->training_temp_tolerance) {
+        FWK_LOG_INFO(
+            "[DDR] Temperature drift, cached training results dropped");
+        return;
+    }
+
+    /* Keep the reference temperature of the cached results */
+    training_temperature = temperature;
+    training_valid_mask = valid_mask;
+}
+
+static int training_cache_restore(int dmc_id, fwk_id_t ddr_id)
+{
+    int status;
+
+    if ((training_valid_mask & (UINT32_C(1) << dmc_id)) == 0)
+        return FWK_E_DATA;
+
+    status = training_cache_read(
+        offsetof(struct mod_dmc620_training_sds, phy_regs) +
+            (dmc_id * sizeof(training_regs)),
+        training_regs, sizeof(training_regs));
+    if (status == FWK_SUCCESS)
+        status = ddr_phy_api->restore_training(ddr_id, &ddr_info,
+                                               training_regs);
+
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_INFO("[DDR] Cached training results rejected, retraining");
+        training_valid_mask &= ~(UINT32_C(1) << dmc_id);
+    }
+
+    return status;
+}
+
+static void training_cache_save(int dmc_id, fwk_id_t ddr_id)
+{
+    int status;
+    uint32_t valid_mask;
+
+    if (!training_cache_enabled || (dmc_id >= MOD_DMC620_TRAINING_DMC_MAX))
+        return;
+
+    status = ddr_phy_api->save_training(ddr_id, &ddr_info, training_regs);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    /* Invalidate a stale cache before writing the new signature */
+    if (training_valid_mask == 0) {
+        valid_mask = 0;
+        status = training_cache_write(
+            offsetof(struct mod_dmc620_training_sds, valid_mask),
+            &valid_mask, sizeof(valid_mask));
+        if (status == FWK_SUCCESS) {
+            status = training_cache_write(
+                offsetof(struct mod_dmc620_training_sds, signature),
+                &training_signature, sizeof(training_signature));
+        }
+        if (status == FWK_SUCCESS) {
+            status = training_cache_write(
+                offsetof(struct mod_dmc620_training_sds, temperature),
+                &training_temperature, sizeof(training_temperature));
+        }
+        if (status != FWK_SUCCESS)
+            goto exit;
+    }
+
+    /* Write the results, then mark them valid */
+    status = training_cache_write(
+        offsetof(struct mod_dmc620_training_sds, phy_regs) +
+            (dmc_id * sizeof(training_regs)),
+        training_regs, sizeof(training_regs));
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    valid_mask = training_valid_mask | (UINT32_C(1) << dmc_id);
+    status = training_cache_write(
+        offsetof(struct mod_dmc620_training_sds, valid_mask),
+        &valid_mask, sizeof(valid_mask));
+    if (status == FWK_SUCCESS)
+        training_valid_mask = valid_mask;
+
+exit:
+    if (status != FWK_SUCCESS)
+        FWK_LOG_INFO("[DDR] Unable to cache the training results: %d", status);
+}
+
 static int dmc620_pre_init(void)
 {
     int status;
@@ -827,6 +1029,8 @@ static int dmc620_pre_init(void)
 
     dimm_spd_mem_info();
 
+    training_cache_check();
+
     return FWK_SUCCESS;
 }
 
@@ -1132,13 +1336,19 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     if (status != FWK_SUCCESS)
         return status;
 
-    status = ddr_training(dmc, ddr_id, &ddr_info);
-    if (status != FWK_SUCCESS)
-        return status;
+    /* Train only if there are no valid cached training results */
+    status = training_cache_restore(dmc_id, ddr_id);
+    if (status != FWK_SUCCESS) {
+        status = ddr_training(dmc, ddr_id, &ddr_info);
+        if (status != FWK_SUCCESS)
+            return status;
 
-    status = ddr_phy_api->post_training_configure(ddr_id, &ddr_info);
-    if (status != FWK_SUCCESS)
-        return status;
+        status = ddr_phy_api->post_training_configure(ddr_id, &ddr_info);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        training_cache_save(dmc_id, ddr_id);
+    }
 
     FWK_LOG_INFO("[DDR] Enable DIMM refresh...");
     status = enable_dimm_refresh(dmc);
@@ -1240,6 +1450,22 @@ static int mod_dmc620_bind(fwk_id_t id, unsigned int round)
     if (status != FWK_SUCCESS)
         return status;
 
+    if (module_config->training_sds_structure_id != 0) {
+        status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SDS),
+                                 FWK_ID_API(FWK_MODULE_IDX_SDS, 0),
+                                 &sds_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    if (!fwk_id_is_equal(module_config->temp_sensor_id, FWK_ID_NONE)) {
+        status = fwk_module_bind(module_config->temp_sensor_id,
+                                 module_config->temp_sensor_api_id,
+                                 &temp_sensor_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -9,6 +9,7 @@
  */
 
 #include "config_clock.h"
+#include "n1sdp_mcp_scmi.h"
 
 #include <mod_clock.h>
 #include <mod_n1sdp_mcp_system.h>
@@ -27,11 +28,38 @@
 #include <inttypes.h>
 #include <stdint.h>
 
+/* Queries sent to SCP at boot, in the order they are sent */
+enum n1sdp_mcp_system_query {
+    N1SDP_MCP_SYSTEM_QUERY_VERSION,
+    N1SDP_MCP_SYSTEM_QUERY_CLOCK_STATUS,
+    N1SDP_MCP_SYSTEM_QUERY_CHIPID_INFO,
+    N1SDP_MCP_SYSTEM_QUERY_COUNT,
+};
+
+static const struct mod_scmi_agent_message
+    n1sdp_mcp_system_queries[N1SDP_MCP_SYSTEM_QUERY_COUNT] = {
+    [N1SDP_MCP_SYSTEM_QUERY_VERSION] = {
+        .protocol_id = SCMI_PROTOCOL_ID_MANAGEMENT,
+        .message_id = SCMI_MANAGEMENT_PROTOCOL_VERSION_GET,
+    },
+    [N1SDP_MCP_SYSTEM_QUERY_CLOCK_STATUS] = {
+        .protocol_id = SCMI_PROTOCOL_ID_MANAGEMENT,
+        .message_id = SCMI_MANAGEMENT_CLOCK_STATUS_GET,
+    },
+    [N1SDP_MCP_SYSTEM_QUERY_CHIPID_INFO] = {
+        .protocol_id = SCMI_PROTOCOL_ID_MANAGEMENT,
+        .message_id = SCMI_MANAGEMENT_CHIPID_INFO_GET,
+    },
+};
+
 /* Module context */
 struct n1sdp_mcp_system_ctx {
     /* SCMI agent API pointer */
     const struct mod_scmi_agent_api *scmi_api;
 
+    /* Token of the first query sent to SCP */
+    unsigned int query_token;
+
     /* PIK clock API - MCP core clock */
     const struct mod_clock_drv_api *pik_coreclk_api;
 
@@ -58,7 +86,8 @@ static int n1sdp_mcp_system_bind(fwk_id_t id, unsigned int round)
 
     if (round == 0) {
         status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_AGENT),
-                                 FWK_ID_API(FWK_MODULE_IDX_SCMI_AGENT, 0),
+                                 FWK_ID_API(FWK_MODULE_IDX_SCMI_AGENT,
+                                            MOD_SCMI_AGENT_API_IDX_AGENT),
                                  &n1sdp_mcp_system_ctx.scmi_api);
         if (status != FWK_SUCCESS)
             return status;
@@ -93,46 +122,92 @@ static int n1sdp_mcp_system_start(fwk_id_t id)
     return fwk_thread_put_event(&event);
 }
 
-static int n1sdp_mcp_system_process_event(const struct fwk_event *event,
-                                         struct fwk_event *resp)
+static int n1sdp_mcp_system_configure_pik_clocks(void)
 {
     int status;
-    uint32_t clock_status = 0;
-    uint8_t mc_mode = 0;
-    uint8_t chipid = 0;
-
-    status = n1sdp_mcp_system_ctx.scmi_api->get_clock_status(
-                 FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_AGENT, 0), &clock_status);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    FWK_LOG_INFO("[MCP SYSTEM] SCP clock status: 0x%" PRIu32, clock_status);
 
     status = n1sdp_mcp_system_ctx.pik_coreclk_api->process_power_transition(
                  FWK_ID_ELEMENT(FWK_MODULE_IDX_PIK_CLOCK,
                                 CLOCK_PIK_IDX_MCP_CORECLK),
                  MOD_PD_STATE_ON);
     if (status != FWK_SUCCESS)
-        return FWK_SUCCESS;
+        return status;
 
     status = n1sdp_mcp_system_ctx.pik_coreclk_api->process_power_transition(
                  FWK_ID_ELEMENT(FWK_MODULE_IDX_PIK_CLOCK,
                                 CLOCK_PIK_IDX_MCP_AXICLK),
                  MOD_PD_STATE_ON);
     if (status != FWK_SUCCESS)
-        return FWK_SUCCESS;
+        return status;
 
     FWK_LOG_INFO("[MCP SYSTEM] MCP PIK clocks configured");
 
-    status = n1sdp_mcp_system_ctx.scmi_api->get_chipid_info(
-                 FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_AGENT, 0),
-                 &mc_mode, &chipid);
-    if (status != FWK_SUCCESS)
-        return status;
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_mcp_system_process_response(const struct fwk_event *event)
+{
+    const struct mod_scmi_agent_response_params *params;
+    unsigned int query;
 
-    FWK_LOG_INFO("[MCP SYSTEM] MC Mode: 0x%x CHIPID: 0x%x", mc_mode, chipid);
+    params = (const struct mod_scmi_agent_response_params *)event->params;
+    query = (event->cookie - n1sdp_mcp_system_ctx.query_token) %
+        MOD_SCMI_AGENT_TOKEN_COUNT;
 
-    return status;
+    if (params->status != FWK_SUCCESS)
+        return params->status;
+
+    if (params->payload[0] != 0) {
+        FWK_LOG_ERR("[MCP SYSTEM] SCMI query %u failed: %" PRId32,
+                    query, (int32_t)params->payload[0]);
+        return FWK_E_DEVICE;
+    }
+
+    switch (query) {
+    case N1SDP_MCP_SYSTEM_QUERY_VERSION:
+        FWK_LOG_INFO(
+            "[MCP SYSTEM] Found management protocol version: 0x%" PRIx32,
+            params->payload[1]);
+        break;
+
+    case N1SDP_MCP_SYSTEM_QUERY_CLOCK_STATUS:
+        FWK_LOG_INFO("[MCP SYSTEM] SCP clock status: 0x%" PRIx32,
+                     params->payload[1]);
+
+        if (n1sdp_mcp_system_configure_pik_clocks() != FWK_SUCCESS)
+            FWK_LOG_ERR("[MCP SYSTEM] MCP PIK clocks not configured");
+        break;
+
+    case N1SDP_MCP_SYSTEM_QUERY_CHIPID_INFO:
+        FWK_LOG_INFO("[MCP SYSTEM] MC Mode: 0x%x CHIPID: 0x%x",
+                     (uint8_t)params->payload[1],
+                     (uint8_t)params->payload[2]);
+        break;
+
+    default:
+        return FWK_E_PARAM;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_mcp_system_process_event(const struct fwk_event *event,
+                                         struct fwk_event *resp)
+{
+    if (fwk_id_is_equal(event->id, mod_scmi_agent_event_id_response))
+        return n1sdp_mcp_system_process_response(event);
+
+    /*
+     * Send all the queries at once rather than wait for the response to each
+     * of them in turn.
+     */
+    return n1sdp_mcp_system_ctx.scmi_api->send(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_AGENT,
+                       MCP_N1SDP_SCMI_AGENT_IDX_MANAGEMENT),
+        event->target_id,
+        n1sdp_mcp_system_queries,
+        N1SDP_MCP_SYSTEM_QUERY_COUNT,
+        &n1sdp_mcp_system_ctx.query_token);
 }
 
 const struct fwk_module module_n1sdp_mcp_system = {
@@ -63,6 +63,76 @@ struct n1sdp_pcie_dev_config {
 
     /*! Identifier to indicate if the PCIe controller is CCIX capable */
     bool ccix_capable;
+
+    /*!
+     * \brief Identifier of the timer alarm polling the link training.
+     *
+     * \details The root port is brought up without blocking the other root
+     *      ports once the interconnect clock is running: its link training is
+     *      polled with this alarm, and the bus behind it is enumerated once the
+     *      link is up.
+     */
+    fwk_id_t alarm_id;
+
+    /*!
+     * Identifier of the Shared Data Structure caching the topology of the
+     * bus behind the root port, see ::n1sdp_pcie_topology_sds, or zero to
+     * enumerate the bus on every boot.
+     */
+    uint32_t topology_sds_structure_id;
+};
+
+/*! Largest number of functions in a cached bus topology */
+#define N1SDP_PCIE_TOPOLOGY_ENTRY_MAX 32
+
+/*!
+ * \brief Function found by the bus enumeration.
+ */
+struct n1sdp_pcie_topology_entry {
+    /*! Offset of the configuration space of the function in the ECAM space */
+    uint32_t bdf_addr;
+
+    /*! Vendor and device identifiers read from the function */
+    uint32_t id;
+
+    /*! Secondary bus number if the function is a bridge, zero otherwise */
+    uint8_t sec_bnum;
+
+    /*! Subordinate bus number if the function is a bridge, zero otherwise */
+    uint8_t sub_bnum;
+
+    /*! Reserved, zero */
+    uint16_t reserved;
+};
+
+/*!
+ * \brief Topology of the bus behind a root port, kept in a Shared Data
+ *      Structure.
+ *
+ * \details The structure survives warm resets. On the next boot, each
+ *      function it lists is checked with a single configuration read and the
+ *      bridges are given their bus numbers back, instead of probing every
+ *      bus, device and function. The bus is enumerated again, and the cache
+ *      refreshed, when a function is missing or has different identifiers.
+ */
+struct n1sdp_pcie_topology_sds {
+    /*! Hash of the cache layout version and of the topology */
+    uint32_t signature;
+
+    /*!
+     * Number of functions found, the topology is not cached when it is larger
+     * than ::N1SDP_PCIE_TOPOLOGY_ENTRY_MAX.
+     */
+    uint32_t count;
+
+    /*! Subordinate bus number of the root port */
+    uint32_t sub_bnum;
+
+    /*! Reserved, zero */
+    uint32_t reserved;
+
+    /*! Functions found, in the order they were enumerated */
+    struct n1sdp_pcie_topology_entry entries[N1SDP_PCIE_TOPOLOGY_ENTRY_MAX];
 };
 
 /*!
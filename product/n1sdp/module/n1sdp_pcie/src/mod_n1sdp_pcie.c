@@ -17,8 +17,10 @@
 #include <mod_clock.h>
 #include <mod_n1sdp_c2c_i2c.h>
 #include <mod_n1sdp_pcie.h>
+#include <mod_sds.h>
 #include <mod_timer.h>
 
+#include <fwk_assert.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_log.h>
@@ -28,13 +30,51 @@
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 
 #include <inttypes.h>
 #include <string.h>
 
-void pcie_bus_enumeration(struct n1sdp_pcie_dev_config *config);
+void pcie_bus_enumeration(struct n1sdp_pcie_dev_config *config,
+                          struct n1sdp_pcie_topology_sds *topology);
+bool pcie_bus_restore(struct n1sdp_pcie_dev_config *config,
+                      const struct n1sdp_pcie_topology_sds *topology);
 void pcie_init_bdf_table(struct n1sdp_pcie_dev_config *config);
 
+/* Version of the layout of the cached bus topology */
+#define PCIE_TOPOLOGY_CACHE_VERSION 1
+
+/* Interval between two polls of a root port being brought up, in ms */
+#define PCIE_BRINGUP_POLL_INTERVAL_MS 1
+
+/*
+ * Module events
+ */
+enum n1sdp_pcie_event_idx {
+    /* Poll the root port being brought up */
+    N1SDP_PCIE_EVENT_IDX_POLL,
+
+    /* Number of events */
+    N1SDP_PCIE_EVENT_IDX_COUNT
+};
+
+/*
+ * Stages of the bring-up of a root port which are polled
+ */
+enum n1sdp_pcie_bringup_stage {
+    /* No bring-up in progress */
+    N1SDP_PCIE_BRINGUP_IDLE,
+
+    /* Waiting for the link to be up */
+    N1SDP_PCIE_BRINGUP_LINK_TRAINING,
+
+    /* Waiting for the link to be up at GEN4 speed */
+    N1SDP_PCIE_BRINGUP_LINK_RETRAINING,
+
+    /* Waiting for the downstream links to be up before the enumeration */
+    N1SDP_PCIE_BRINGUP_DOWNSTREAM_TRAINING,
+};
+
 /*
  * Device context
  */
@@ -77,6 +117,18 @@ struct n1sdp_pcie_dev_ctx {
      * Accessible in EP mode.
      */
     uintptr_t ep_axi_config_apb;
+
+    /* Timer alarm API polling the bring-up of the root port */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Stage of the bring-up of the root port */
+    enum n1sdp_pcie_bringup_stage bringup_stage;
+
+    /* Number of polls since the start of the bring-up stage */
+    unsigned int poll_count;
+
+    /* Speed the link is trained to */
+    enum pcie_gen gen_speed;
 };
 
 /*
@@ -89,6 +141,12 @@ struct n1sdp_pcie_ctx {
     /* C2C API to check if slave chip is connected */
     struct n1sdp_c2c_slave_info_api *c2c_api;
 
+    /* SDS API to cache the bus topologies, NULL if they are not cached */
+    struct mod_sds_api *sds_api;
+
+    /* Bus topology being cached or restored */
+    struct n1sdp_pcie_topology_sds topology;
+
     /* Table of PCIe device contexts */
     struct n1sdp_pcie_dev_ctx *device_ctx_table;
 
@@ -100,6 +158,87 @@ struct n1sdp_pcie_ctx pcie_ctx;
 
 static const char * const pcie_type[2] = {"PCIe", "CCIX"};
 
+/*
+ * Bus topology caching
+ */
+static uint32_t n1sdp_pcie_topology_signature(
+    const struct n1sdp_pcie_dev_config *config,
+    const struct n1sdp_pcie_topology_sds *topology)
+{
+    const uint8_t *data = (const uint8_t *)topology->entries;
+    size_t size = topology->count * sizeof(topology->entries[0]);
+    uint32_t hash;
+    size_t i;
+
+    hash = ((uint32_t)PCIE_TOPOLOGY_CACHE_VERSION << 16) ^
+        config->global_config_base ^ (topology->sub_bnum << 8) ^
+        topology->count;
+
+    /* FNV-1a over the functions found */
+    for (i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= UINT32_C(16777619);
+    }
+
+    return hash;
+}
+
+/*
+ * Enumerate the bus behind a root port. The bus topology cached by a previous
+ * boot is checked and restored if it is still valid, otherwise the bus is
+ * enumerated and its topology is cached for the next boot.
+ */
+static void n1sdp_pcie_enumerate(unsigned int did)
+{
+    struct n1sdp_pcie_dev_config *config;
+    struct n1sdp_pcie_topology_sds *topology = &pcie_ctx.topology;
+    uint32_t structure_id;
+    int status;
+
+    config = pcie_ctx.device_ctx_table[did].config;
+    structure_id = config->topology_sds_structure_id;
+
+    if (pcie_ctx.sds_api == NULL) {
+        pcie_bus_enumeration(config, NULL);
+        return;
+    }
+
+    status = pcie_ctx.sds_api->struct_read(
+        structure_id, 0, topology, sizeof(*topology));
+    if ((status == FWK_SUCCESS) &&
+        (topology->count <= N1SDP_PCIE_TOPOLOGY_ENTRY_MAX) &&
+        (topology->signature ==
+         n1sdp_pcie_topology_signature(config, topology))) {
+        if (pcie_bus_restore(config, topology)) {
+            FWK_LOG_INFO(
+                "[%s] Restored cached bus topology, %" PRIu32 " functions",
+                pcie_type[did],
+                topology->count);
+            return;
+        }
+
+        FWK_LOG_INFO(
+            "[%s] Bus topology changed, enumerating", pcie_type[did]);
+    }
+
+    memset(topology, 0, sizeof(*topology));
+    pcie_bus_enumeration(config, topology);
+
+    if (topology->count > N1SDP_PCIE_TOPOLOGY_ENTRY_MAX)
+        FWK_LOG_INFO("[%s] Bus topology too large to cache", pcie_type[did]);
+
+    topology->signature = n1sdp_pcie_topology_signature(config, topology);
+
+    status = pcie_ctx.sds_api->struct_write(
+        structure_id, 0, topology, sizeof(*topology));
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_INFO(
+            "[%s] Unable to cache the bus topology: %d",
+            pcie_type[did],
+            status);
+    }
+}
+
 /*
  * CCIX configuration API
  */
@@ -145,6 +284,16 @@ static const struct n1sdp_pcie_ccix_config_api pcie_ccix_config_api = {
 /*
  * PCIe initialization APIs
  */
+static enum pcie_gen n1sdp_pcie_get_gen_speed(
+    struct n1sdp_pcie_dev_ctx *dev_ctx)
+{
+    if ((n1sdp_get_chipid() != 0x0) || !dev_ctx->config->ccix_capable ||
+        pcie_ctx.c2c_api->is_slave_alive())
+        return PCIE_GEN_3;
+
+    return PCIE_GEN_4;
+}
+
 static int n1sdp_pcie_power_on(fwk_id_t id)
 {
     struct pcie_wait_condition_data wait_data;
@@ -206,11 +355,7 @@ static int n1sdp_pcie_phy_init(fwk_id_t id)
     if (dev_ctx == NULL)
         return FWK_E_PARAM;
 
-    if ((n1sdp_get_chipid() != 0x0) || !dev_ctx->config->ccix_capable ||
-        pcie_ctx.c2c_api->is_slave_alive())
-        gen_speed = PCIE_GEN_3;
-    else
-        gen_speed = PCIE_GEN_4;
+    gen_speed = n1sdp_pcie_get_gen_speed(dev_ctx);
 
     lane_count = LAN_COUNT_IN_X_16;
 
@@ -244,11 +389,7 @@ static int n1sdp_pcie_controller_init(fwk_id_t id, bool ep_mode)
     if (dev_ctx == NULL)
         return FWK_E_PARAM;
 
-    if ((n1sdp_get_chipid() != 0x0) || !dev_ctx->config->ccix_capable ||
-        pcie_ctx.c2c_api->is_slave_alive())
-        gen_speed = PCIE_GEN_3;
-    else
-        gen_speed = PCIE_GEN_4;
+    gen_speed = n1sdp_pcie_get_gen_speed(dev_ctx);
 
     lane_count = LAN_COUNT_IN_X_16;
 
@@ -275,78 +416,63 @@ static int n1sdp_pcie_controller_init(fwk_id_t id, bool ep_mode)
     return FWK_SUCCESS;
 }
 
-static int n1sdp_pcie_link_training(fwk_id_t id, bool ep_mode)
+static int n1sdp_pcie_link_training_setup(
+    unsigned int did,
+    enum pcie_gen gen_speed,
+    bool ep_mode)
 {
     struct n1sdp_pcie_dev_ctx *dev_ctx;
-    enum pcie_gen gen_speed;
-    uint8_t neg_config;
-    uint32_t reg_val;
     int status;
-    unsigned int did;
-    enum pcie_lane_count lane_count;
-    uint32_t down_stream_tx_preset = 0;
-    uint32_t up_stream_tx_preset  = 0;
+    uint32_t tx_preset;
 
-    did = fwk_id_get_element_idx(id);
     dev_ctx = &pcie_ctx.device_ctx_table[did];
-    if (dev_ctx == NULL)
-        return FWK_E_PARAM;
 
-    if ((n1sdp_get_chipid() != 0x0) || !dev_ctx->config->ccix_capable ||
-        pcie_ctx.c2c_api->is_slave_alive()) {
-        gen_speed = PCIE_GEN_3;
-        down_stream_tx_preset = PCIE_RC_TX_PRESET_VALUE;
-        up_stream_tx_preset = PCIE_RC_TX_PRESET_VALUE;
-    } else {
-        gen_speed = PCIE_GEN_4;
-        down_stream_tx_preset = CCIX_RC_TX_PRESET_VALUE;
-        up_stream_tx_preset = CCIX_RC_TX_PRESET_VALUE;
-    }
+    if (gen_speed < PCIE_GEN_3 || ep_mode)
+        return FWK_SUCCESS;
 
-    lane_count = LAN_COUNT_IN_X_16;
+    if (gen_speed == PCIE_GEN_4)
+        tx_preset = CCIX_RC_TX_PRESET_VALUE;
+    else
+        tx_preset = PCIE_RC_TX_PRESET_VALUE;
 
-    if (gen_speed >= PCIE_GEN_3 && !ep_mode) {
+    FWK_LOG_INFO(
+        "[%s] Setting TX Preset for GEN%d...",
+        pcie_type[did],
+        PCIE_GEN_3 + 1);
+    status = pcie_set_gen_tx_preset(dev_ctx->rp_ep_config_apb,
+                                    tx_preset,
+                                    tx_preset,
+                                    PCIE_GEN_3);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_INFO("[%s] Error!", pcie_type[did]);
+        return status;
+    }
+    if (gen_speed == PCIE_GEN_4) {
         FWK_LOG_INFO(
             "[%s] Setting TX Preset for GEN%d...",
             pcie_type[did],
-            PCIE_GEN_3 + 1);
+            PCIE_GEN_4 + 1);
         status = pcie_set_gen_tx_preset(dev_ctx->rp_ep_config_apb,
-                                        down_stream_tx_preset,
-                                        up_stream_tx_preset,
-                                        PCIE_GEN_3);
+                                        tx_preset,
+                                        tx_preset,
+                                        PCIE_GEN_4);
         if (status != FWK_SUCCESS) {
             FWK_LOG_INFO("[%s] Error!", pcie_type[did]);
             return status;
         }
-        if (gen_speed == PCIE_GEN_4) {
-            FWK_LOG_INFO(
-                "[%s] Setting TX Preset for GEN%d...",
-                pcie_type[did],
-                PCIE_GEN_4 + 1);
-            status = pcie_set_gen_tx_preset(dev_ctx->rp_ep_config_apb,
-                                            down_stream_tx_preset,
-                                            up_stream_tx_preset,
-                                            PCIE_GEN_4);
-            if (status != FWK_SUCCESS) {
-                FWK_LOG_INFO("[%s] Error!", pcie_type[did]);
-                return status;
-            }
-        }
-        FWK_LOG_INFO("[%s] Done", pcie_type[did]);
     }
+    FWK_LOG_INFO("[%s] Done", pcie_type[did]);
+
+    return FWK_SUCCESS;
+}
+
+static void n1sdp_pcie_link_training_report(unsigned int did)
+{
+    struct n1sdp_pcie_dev_ctx *dev_ctx;
+    uint8_t neg_config;
+
+    dev_ctx = &pcie_ctx.device_ctx_table[did];
 
-    /* Link training */
-    FWK_LOG_INFO("[%s] Starting link training...", pcie_type[did]);
-    status = pcie_init(dev_ctx->ctrl_apb,
-                       pcie_ctx.timer_api,
-                       PCIE_INIT_STAGE_LINK_TRNG,
-                       gen_speed,
-                       lane_count);
-    if (status != FWK_SUCCESS) {
-        FWK_LOG_INFO("[%s] Timeout!", pcie_type[did]);
-        pcie_init_bdf_table(dev_ctx->config);
-        return status;
-    }
     FWK_LOG_INFO("[%s] Done", pcie_type[did]);
 
     neg_config = (dev_ctx->ctrl_apb->RP_CONFIG_OUT &
@@ -361,16 +487,84 @@ static int n1sdp_pcie_link_training(fwk_id_t id, bool ep_mode)
         "[%s] Negotiated link width: x%d",
         pcie_type[did],
         fwk_math_pow2(neg_config));
+}
+
+static void n1sdp_pcie_link_retraining_setup(unsigned int did)
+{
+    struct n1sdp_pcie_dev_ctx *dev_ctx;
+    uint32_t reg_val;
+
+    dev_ctx = &pcie_ctx.device_ctx_table[did];
+
+    FWK_LOG_INFO("[%s] Re-training link to GEN4 speed...", pcie_type[did]);
+    /* Set GEN4 as target speed */
+    pcie_rp_ep_config_read_word(dev_ctx->rp_ep_config_apb,
+                                PCIE_LINK_CTRL_STATUS_2_OFFSET, &reg_val);
+    reg_val &= ~PCIE_LINK_CTRL_2_TARGET_SPEED_MASK;
+    reg_val |= PCIE_LINK_CTRL_2_TARGET_SPEED_GEN4;
+    pcie_rp_ep_config_write_word(dev_ctx->rp_ep_config_apb,
+                                 PCIE_LINK_CTRL_STATUS_2_OFFSET, reg_val);
+}
+
+static void n1sdp_pcie_link_retraining_report(unsigned int did)
+{
+    struct n1sdp_pcie_dev_ctx *dev_ctx;
+    uint8_t neg_config;
+    uint32_t reg_val;
+
+    dev_ctx = &pcie_ctx.device_ctx_table[did];
+
+    FWK_LOG_INFO("[%s] Done", pcie_type[did]);
+
+    pcie_rp_ep_config_read_word(dev_ctx->rp_ep_config_apb,
+                                PCIE_LINK_CTRL_STATUS_OFFSET, &reg_val);
+    neg_config = (reg_val >> PCIE_LINK_CTRL_NEG_SPEED_POS) &
+                 PCIE_LINK_CTRL_NEG_SPEED_MASK;
+    FWK_LOG_INFO(
+        "[%s] Re-negotiated speed: GEN%d", pcie_type[did], neg_config);
+
+    neg_config = (reg_val >> PCIE_LINK_CTRL_NEG_WIDTH_POS) &
+                 PCIE_LINK_CTRL_NEG_WIDTH_MASK;
+    FWK_LOG_INFO(
+        "[%s] Re-negotiated link width: x%d", pcie_type[did], neg_config);
+}
+
+static int n1sdp_pcie_link_training(fwk_id_t id, bool ep_mode)
+{
+    struct n1sdp_pcie_dev_ctx *dev_ctx;
+    enum pcie_gen gen_speed;
+    int status;
+    unsigned int did;
+    enum pcie_lane_count lane_count;
+
+    did = fwk_id_get_element_idx(id);
+    dev_ctx = &pcie_ctx.device_ctx_table[did];
+    if (dev_ctx == NULL)
+        return FWK_E_PARAM;
+
+    gen_speed = n1sdp_pcie_get_gen_speed(dev_ctx);
+    lane_count = LAN_COUNT_IN_X_16;
+
+    status = n1sdp_pcie_link_training_setup(did, gen_speed, ep_mode);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Link training */
+    FWK_LOG_INFO("[%s] Starting link training...", pcie_type[did]);
+    status = pcie_init(dev_ctx->ctrl_apb,
+                       pcie_ctx.timer_api,
+                       PCIE_INIT_STAGE_LINK_TRNG,
+                       gen_speed,
+                       lane_count);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_INFO("[%s] Timeout!", pcie_type[did]);
+        pcie_init_bdf_table(dev_ctx->config);
+        return status;
+    }
+    n1sdp_pcie_link_training_report(did);
 
     if (gen_speed == PCIE_GEN_4) {
-        FWK_LOG_INFO("[%s] Re-training link to GEN4 speed...", pcie_type[did]);
-        /* Set GEN4 as target speed */
-        pcie_rp_ep_config_read_word(dev_ctx->rp_ep_config_apb,
-                                    PCIE_LINK_CTRL_STATUS_2_OFFSET, &reg_val);
-        reg_val &= ~PCIE_LINK_CTRL_2_TARGET_SPEED_MASK;
-        reg_val |= PCIE_LINK_CTRL_2_TARGET_SPEED_GEN4;
-        pcie_rp_ep_config_write_word(dev_ctx->rp_ep_config_apb,
-                                     PCIE_LINK_CTRL_STATUS_2_OFFSET, reg_val);
+        n1sdp_pcie_link_retraining_setup(did);
 
         /* Start link retraining */
         status = pcie_link_retrain(dev_ctx->ctrl_apb,
@@ -380,35 +574,19 @@ static int n1sdp_pcie_link_training(fwk_id_t id, bool ep_mode)
             FWK_LOG_INFO("[%s] TIMEOUT", pcie_type[did]);
             return FWK_SUCCESS;
         }
-        FWK_LOG_INFO("[%s] Done", pcie_type[did]);
-
-        pcie_rp_ep_config_read_word(dev_ctx->rp_ep_config_apb,
-                                    PCIE_LINK_CTRL_STATUS_OFFSET, &reg_val);
-        neg_config = (reg_val >> PCIE_LINK_CTRL_NEG_SPEED_POS) &
-                     PCIE_LINK_CTRL_NEG_SPEED_MASK;
-        FWK_LOG_INFO(
-            "[%s] Re-negotiated speed: GEN%d", pcie_type[did], neg_config);
-
-        neg_config = (reg_val >> PCIE_LINK_CTRL_NEG_WIDTH_POS) &
-                     PCIE_LINK_CTRL_NEG_WIDTH_MASK;
-        FWK_LOG_INFO(
-            "[%s] Re-negotiated link width: x%d", pcie_type[did], neg_config);
+        n1sdp_pcie_link_retraining_report(did);
     }
 
     return FWK_SUCCESS;
 }
 
-static int n1sdp_pcie_rc_setup(fwk_id_t id)
+static int n1sdp_pcie_rc_configure(unsigned int did)
 {
     struct n1sdp_pcie_dev_ctx *dev_ctx;
     uint32_t ecam_base_addr;
     int status;
-    unsigned int did;
 
-    did = fwk_id_get_element_idx(id);
     dev_ctx = &pcie_ctx.device_ctx_table[did];
-    if (dev_ctx == NULL)
-        return FWK_E_PARAM;
 
     FWK_LOG_INFO("[%s] Setup Type0 configuration...", pcie_type[did]);
     if (dev_ctx->config->ccix_capable)
@@ -532,6 +710,24 @@ static int n1sdp_pcie_rc_setup(fwk_id_t id)
     else
         FWK_LOG_INFO("[%s] Done", pcie_type[did]);
 
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_pcie_rc_setup(fwk_id_t id)
+{
+    struct n1sdp_pcie_dev_ctx *dev_ctx;
+    int status;
+    unsigned int did;
+
+    did = fwk_id_get_element_idx(id);
+    dev_ctx = &pcie_ctx.device_ctx_table[did];
+    if (dev_ctx == NULL)
+        return FWK_E_PARAM;
+
+    status = n1sdp_pcie_rc_configure(did);
+    if (status != FWK_SUCCESS)
+        return status;
+
     /*
      * Wait until devices connected in downstream ports
      * finish link training before doing bus enumeration
@@ -539,7 +735,7 @@ static int n1sdp_pcie_rc_setup(fwk_id_t id)
     pcie_ctx.timer_api->delay(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
                                  PCIE_LINK_TRAINING_TIMEOUT);
 
-    pcie_bus_enumeration(dev_ctx->config);
+    n1sdp_pcie_enumerate(did);
 
     return FWK_SUCCESS;
 }
@@ -603,14 +799,64 @@ static const struct n1sdp_pcie_init_api pcie_init_api = {
 /*
  * Module functions
  */
-static int n1sdp_pcie_setup(fwk_id_t id)
+
+/*
+ * The root ports are brought up concurrently: the link training, the link
+ * re-training and the wait for the downstream links are polled with an alarm
+ * of the root port, so that the root ports train their links at the same time
+ * and the bus behind each root port is enumerated as soon as it is ready. The
+ * other stages are only a few hundred microseconds long and are waited for.
+ */
+static void n1sdp_pcie_alarm_callback(uintptr_t param)
+{
+    int status;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_PCIE),
+        .target_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_N1SDP_PCIE, param),
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_N1SDP_PCIE,
+                           N1SDP_PCIE_EVENT_IDX_POLL),
+    };
+
+    status = fwk_thread_put_event(&event);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
+static int n1sdp_pcie_bringup_wait(
+    unsigned int did,
+    enum n1sdp_pcie_bringup_stage stage)
+{
+    struct n1sdp_pcie_dev_ctx *dev_ctx = &pcie_ctx.device_ctx_table[did];
+
+    if (stage != dev_ctx->bringup_stage) {
+        dev_ctx->bringup_stage = stage;
+        dev_ctx->poll_count = 0;
+    }
+
+    return dev_ctx->alarm_api->start(
+        dev_ctx->config->alarm_id,
+        PCIE_BRINGUP_POLL_INTERVAL_MS,
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        n1sdp_pcie_alarm_callback,
+        did);
+}
+
+static bool n1sdp_pcie_bringup_timed_out(
+    struct n1sdp_pcie_dev_ctx *dev_ctx,
+    uint32_t timeout_us)
+{
+    return (dev_ctx->poll_count * PCIE_BRINGUP_POLL_INTERVAL_MS * 1000) >=
+        timeout_us;
+}
+
+static int n1sdp_pcie_bringup_start(fwk_id_t id)
 {
     struct n1sdp_pcie_dev_ctx *dev_ctx;
     int status;
+    unsigned int did;
 
-    dev_ctx = &pcie_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
-    if (dev_ctx == NULL)
-        return FWK_E_PARAM;
+    did = fwk_id_get_element_idx(id);
+    dev_ctx = &pcie_ctx.device_ctx_table[did];
 
     /* PCIe controller power ON */
     status = n1sdp_pcie_power_on(id);
@@ -628,16 +874,95 @@ static int n1sdp_pcie_setup(fwk_id_t id)
         return status;
 
     /* Link training */
-    status = n1sdp_pcie_link_training(id, false);
+    dev_ctx->gen_speed = n1sdp_pcie_get_gen_speed(dev_ctx);
+    status = n1sdp_pcie_link_training_setup(did, dev_ctx->gen_speed, false);
     if (status != FWK_SUCCESS)
         return dev_ctx->config->ccix_capable ? FWK_SUCCESS : status;
 
+    FWK_LOG_INFO("[%s] Starting link training...", pcie_type[did]);
+    pcie_link_training_start(dev_ctx->ctrl_apb);
+
+    return n1sdp_pcie_bringup_wait(did, N1SDP_PCIE_BRINGUP_LINK_TRAINING);
+}
+
+static int n1sdp_pcie_bringup_poll(fwk_id_t id)
+{
+    struct n1sdp_pcie_dev_ctx *dev_ctx;
+    struct pcie_wait_condition_data wait_data;
+    int status;
+    unsigned int did;
+
+    did = fwk_id_get_element_idx(id);
+    dev_ctx = &pcie_ctx.device_ctx_table[did];
+    dev_ctx->poll_count++;
+
+    wait_data.ctrl_apb = dev_ctx->ctrl_apb;
+
+    switch (dev_ctx->bringup_stage) {
+    case N1SDP_PCIE_BRINGUP_LINK_TRAINING:
+        wait_data.stage = PCIE_INIT_STAGE_LINK_TRNG;
+        if (!pcie_wait_condition(&wait_data)) {
+            if (!n1sdp_pcie_bringup_timed_out(
+                    dev_ctx, PCIE_LINK_TRAINING_TIMEOUT))
+                return n1sdp_pcie_bringup_wait(did, dev_ctx->bringup_stage);
+
+            FWK_LOG_INFO("[%s] Timeout!", pcie_type[did]);
+            pcie_init_bdf_table(dev_ctx->config);
+            dev_ctx->bringup_stage = N1SDP_PCIE_BRINGUP_IDLE;
+
+            return dev_ctx->config->ccix_capable ? FWK_SUCCESS : FWK_E_TIMEOUT;
+        }
+        n1sdp_pcie_link_training_report(did);
+
+        if (dev_ctx->gen_speed == PCIE_GEN_4) {
+            n1sdp_pcie_link_retraining_setup(did);
+            pcie_link_retrain_start(dev_ctx->rp_ep_config_apb);
+
+            return n1sdp_pcie_bringup_wait(
+                did, N1SDP_PCIE_BRINGUP_LINK_RETRAINING);
+        }
+
+        break;
+
+    case N1SDP_PCIE_BRINGUP_LINK_RETRAINING:
+        wait_data.stage = PCIE_INIT_STAGE_LINK_RE_TRNG;
+        if (pcie_wait_condition(&wait_data))
+            n1sdp_pcie_link_retraining_report(did);
+        else if (!n1sdp_pcie_bringup_timed_out(
+                     dev_ctx, PCIE_LINK_RE_TRAINING_TIMEOUT))
+            return n1sdp_pcie_bringup_wait(did, dev_ctx->bringup_stage);
+        else
+            FWK_LOG_INFO("[%s] TIMEOUT", pcie_type[did]);
+
+        break;
+
+    case N1SDP_PCIE_BRINGUP_DOWNSTREAM_TRAINING:
+        /*
+         * Wait until devices connected in downstream ports
+         * finish link training before doing bus enumeration
+         */
+        if (!n1sdp_pcie_bringup_timed_out(dev_ctx, PCIE_LINK_TRAINING_TIMEOUT))
+            return n1sdp_pcie_bringup_wait(did, dev_ctx->bringup_stage);
+
+        dev_ctx->bringup_stage = N1SDP_PCIE_BRINGUP_IDLE;
+
+        n1sdp_pcie_enumerate(did);
+
+        return FWK_SUCCESS;
+
+    default:
+        return FWK_E_STATE;
+    }
+
     /* Root Complex setup */
-    status = n1sdp_pcie_rc_setup(id);
-    if (status != FWK_SUCCESS)
+    status = n1sdp_pcie_rc_configure(did);
+    if (status != FWK_SUCCESS) {
+        dev_ctx->bringup_stage = N1SDP_PCIE_BRINGUP_IDLE;
         return status;
+    }
 
-    return FWK_SUCCESS;
+    return n1sdp_pcie_bringup_wait(
+        did, N1SDP_PCIE_BRINGUP_DOWNSTREAM_TRAINING);
 }
 
 /*
@@ -691,6 +1016,7 @@ static int n1sdp_pcie_element_init(fwk_id_t element_id, unsigned int unused,
 
 static int n1sdp_pcie_bind(fwk_id_t id, unsigned int round)
 {
+    struct n1sdp_pcie_dev_ctx *dev_ctx;
     int status;
 
     if (round == 0) {
@@ -705,6 +1031,24 @@ static int n1sdp_pcie_bind(fwk_id_t id, unsigned int round)
             &pcie_ctx.c2c_api);
         if (status != FWK_SUCCESS)
             return status;
+
+        if (fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
+            dev_ctx = &pcie_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
+
+            status = fwk_module_bind(dev_ctx->config->alarm_id,
+                FWK_ID_API(FWK_MODULE_IDX_TIMER, MOD_TIMER_API_IDX_ALARM),
+                &dev_ctx->alarm_api);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            if (dev_ctx->config->topology_sds_structure_id != 0) {
+                status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SDS),
+                    FWK_ID_API(FWK_MODULE_IDX_SDS, 0),
+                    &pcie_ctx.sds_api);
+                if (status != FWK_SUCCESS)
+                    return status;
+            }
+        }
     }
     return FWK_SUCCESS;
 }
@@ -772,17 +1116,31 @@ static int n1sdp_pcie_process_notification(const struct fwk_event *event,
             return FWK_SUCCESS;
     }
 
-    return n1sdp_pcie_setup(event->target_id);
+    return n1sdp_pcie_bringup_start(event->target_id);
+}
+
+static int n1sdp_pcie_process_event(const struct fwk_event *event,
+                                    struct fwk_event *resp)
+{
+    switch (fwk_id_get_event_idx(event->id)) {
+    case N1SDP_PCIE_EVENT_IDX_POLL:
+        return n1sdp_pcie_bringup_poll(event->target_id);
+
+    default:
+        return FWK_E_PARAM;
+    }
 }
 
 const struct fwk_module module_n1sdp_pcie = {
     .name = "N1SDP PCIe",
     .type = FWK_MODULE_TYPE_DRIVER,
     .api_count = N1SDP_PCIE_API_COUNT,
+    .event_count = N1SDP_PCIE_EVENT_IDX_COUNT,
     .init = n1sdp_pcie_init,
     .element_init = n1sdp_pcie_element_init,
     .bind = n1sdp_pcie_bind,
     .start = n1sdp_pcie_start,
     .process_bind_request = n1sdp_pcie_process_bind_request,
     .process_notification = n1sdp_pcie_process_notification,
+    .process_event = n1sdp_pcie_process_event,
 };
@@ -350,7 +350,7 @@ int pcie_init(struct pcie_ctrl_apb_reg *ctrl_apb,
 
     /* PCIe link training request */
     case PCIE_INIT_STAGE_LINK_TRNG:
-        ctrl_apb->RP_CONFIG_IN |= RP_CONFIG_IN_LINK_TRNG_EN_MASK;
+        pcie_link_training_start(ctrl_apb);
         status = timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
                                  PCIE_LINK_TRAINING_TIMEOUT,
                                  pcie_wait_condition,
@@ -366,25 +366,39 @@ int pcie_init(struct pcie_ctrl_apb_reg *ctrl_apb,
     return FWK_SUCCESS;
 }
 
+void pcie_link_training_start(struct pcie_ctrl_apb_reg *ctrl_apb)
+{
+    fwk_assert(ctrl_apb != NULL);
+
+    ctrl_apb->RP_CONFIG_IN |= RP_CONFIG_IN_LINK_TRNG_EN_MASK;
+}
+
+void pcie_link_retrain_start(uint32_t rp_ep_config_base)
+{
+    uint32_t reg_val = 0;
+
+    fwk_assert(rp_ep_config_base != 0x0);
+
+    pcie_rp_ep_config_read_word(rp_ep_config_base,
+                                PCIE_LINK_CTRL_STATUS_OFFSET, &reg_val);
+    reg_val |= PCIE_LINK_CTRL_LINK_RETRAIN_MASK;
+    pcie_rp_ep_config_write_word(rp_ep_config_base,
+                                 PCIE_LINK_CTRL_STATUS_OFFSET, reg_val);
+}
+
 int pcie_link_retrain(struct pcie_ctrl_apb_reg *ctrl_apb,
                       uint32_t rp_ep_config_base,
                       struct mod_timer_api *timer_api)
 {
-    uint32_t reg_val = 0;
     struct pcie_wait_condition_data wait_data;
 
     fwk_assert(ctrl_apb != NULL);
-    fwk_assert(rp_ep_config_base != 0x0);
     fwk_assert(timer_api != NULL);
 
     wait_data.ctrl_apb = ctrl_apb;
     wait_data.stage = PCIE_INIT_STAGE_LINK_RE_TRNG;
 
-    pcie_rp_ep_config_read_word(rp_ep_config_base,
-                                PCIE_LINK_CTRL_STATUS_OFFSET, &reg_val);
-    reg_val |= PCIE_LINK_CTRL_LINK_RETRAIN_MASK;
-    pcie_rp_ep_config_write_word(rp_ep_config_base,
-                                 PCIE_LINK_CTRL_STATUS_OFFSET, reg_val);
+    pcie_link_retrain_start(rp_ep_config_base);
 
     return timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
                            PCIE_LINK_RE_TRAINING_TIMEOUT,
@@ -65,8 +65,9 @@
 /*
  * PCIe timeout values for PHY, controller & link training.
  * Timeout values specified in microseconds.
- * Note: Execution will block for the specified timeout. If the timeout
- * is too long switch to alarm API instead of blocking.
+ * Note: Execution will block for the specified timeout, except for the link
+ * training and re-training of the root ports brought up by the module, which
+ * are polled with an alarm.
  */
 #define PCIE_PHY_PLL_LOCK_TIMEOUT UINT32_C(500)
 #define PCIE_CTRL_RC_RESET_TIMEOUT     UINT32_C(100)
@@ -532,6 +533,23 @@ int pcie_init(struct pcie_ctrl_apb_reg *ctrl_apb,
               enum pcie_gen gen,
               enum pcie_lane_count lane_count);
 
+/*
+ * Brief - Function to start the link training without waiting for it to
+ *         complete. The link is up once pcie_wait_condition() returns true
+ *         for the PCIE_INIT_STAGE_LINK_TRNG stage.
+ *
+ * param - ctrl_apb - Pointer to APB controller register space
+ */
+void pcie_link_training_start(struct pcie_ctrl_apb_reg *ctrl_apb);
+
+/*
+ * Brief - Function to start the re-training of the PCIe link without waiting
+ *         for it to complete. The link is up once pcie_wait_condition()
+ *         returns true for the PCIE_INIT_STAGE_LINK_RE_TRNG stage.
+ *
+ * param - rp_ep_config_base - Root port configuration space base address
+ */
+void pcie_link_retrain_start(uint32_t rp_ep_config_base);
 
 /*
  * Brief - Function to re-train PCIe link to GEN4 speed.
@@ -77,6 +77,9 @@ struct bdf_table {
 uint32_t *bdf_table_ptr;
 uint32_t bdf_count;
 
+/* Topology recorded during bus enumeration, if it is to be cached */
+static struct n1sdp_pcie_topology_sds *topology_rec;
+
 /*!
  * \brief Performs a "checked" 32-bit load from @src@.
  *
@@ -115,6 +118,33 @@ void pcie_init_bdf_table(struct n1sdp_pcie_dev_config *config)
     table->bdf_count = 0;
 }
 
+/*
+ * Record a function found by the bus enumeration in the topology. Returns the
+ * entry of the function, or NULL if the topology is not recorded or full.
+ */
+static struct n1sdp_pcie_topology_entry *pcie_topology_record(
+    uint32_t bdf_addr,
+    uint32_t id)
+{
+    struct n1sdp_pcie_topology_entry *entry;
+
+    if (topology_rec == NULL)
+        return NULL;
+
+    /* The count keeps going past the end to flag an oversized topology */
+    if (topology_rec->count++ >= N1SDP_PCIE_TOPOLOGY_ENTRY_MAX)
+        return NULL;
+
+    entry = &topology_rec->entries[topology_rec->count - 1];
+    entry->bdf_addr = bdf_addr;
+    entry->id = id;
+    entry->sec_bnum = 0;
+    entry->sub_bnum = 0;
+    entry->reserved = 0;
+
+    return entry;
+}
+
 static uint8_t pcie_bus_scan(uint32_t ecam_addr,
                              uint8_t pri_bnum,
                              uint8_t sec_bnum)
@@ -125,6 +155,7 @@ static uint8_t pcie_bus_scan(uint32_t ecam_addr,
     uint32_t config_addr;
     uint8_t header_type;
     uint8_t sub_bnum = pri_bnum;
+    struct n1sdp_pcie_topology_entry *entry;
 
     /* Loop over all devices on pri_bnum bus */
     for (dev_num = 0; dev_num < DEVICES_PER_BUS_MAX; dev_num++) {
@@ -154,6 +185,7 @@ static uint8_t pcie_bus_scan(uint32_t ecam_addr,
             /* Valid device is identified so fill the BDF table */
             bdf_count++;
             *bdf_table_ptr++ = bdf_addr;
+            entry = pcie_topology_record(bdf_addr, vid);
 
             /* If function 0 of any device has invalid VID break the loop */
             if ((vid & 0xFFFF) == 0xFFFF) {
@@ -193,6 +225,10 @@ static uint8_t pcie_bus_scan(uint32_t ecam_addr,
                  */
                 *(uint8_t *)(config_addr +
                     PCIE_SUBORDINATE_BUS_NUM_OFFSET) = sub_bnum;
+                if (entry != NULL) {
+                    entry->sec_bnum = sec_bnum;
+                    entry->sub_bnum = sub_bnum;
+                }
                 sec_bnum = sub_bnum + 1;
             } else {
                 /*
@@ -207,12 +243,15 @@ static uint8_t pcie_bus_scan(uint32_t ecam_addr,
     return sub_bnum;
 }
 
-void pcie_bus_enumeration(struct n1sdp_pcie_dev_config *config)
+/*
+ * Initialize the BDF table and the bus numbers of the root port before the
+ * bus behind it is enumerated. Returns the BDF table.
+ */
+static struct bdf_table *pcie_enumeration_begin(
+    struct n1sdp_pcie_dev_config *config,
+    uint8_t *pri_bnum,
+    uint8_t *sec_bnum)
 {
-    fwk_assert(config != NULL);
-
-    uint32_t ecam_base_addr = config->axi_slave_base32;
-    uint8_t pri_bnum, sec_bnum, sub_bnum;
     struct bdf_table *table;
 
     /* Set BDF table pointer based on the root complex */
@@ -230,11 +269,11 @@ void pcie_bus_enumeration(struct n1sdp_pcie_dev_config *config)
 
     /* Start with bus number 1 as bus 0 is root bus internal to the device */
     if (config->ccix_capable) {
-        pri_bnum = CCIX_PRIMARY_BUS_NUM_START;
-        sec_bnum = CCIX_SECONDARY_BUS_NUM_START;
+        *pri_bnum = CCIX_PRIMARY_BUS_NUM_START;
+        *sec_bnum = CCIX_SECONDARY_BUS_NUM_START;
     } else {
-        pri_bnum = PCIE_PRIMARY_BUS_NUM_START;
-        sec_bnum = PCIE_SECONDARY_BUS_NUM_START;
+        *pri_bnum = PCIE_PRIMARY_BUS_NUM_START;
+        *sec_bnum = PCIE_SECONDARY_BUS_NUM_START;
     }
 
     /*
@@ -242,14 +281,24 @@ void pcie_bus_enumeration(struct n1sdp_pcie_dev_config *config)
      * Let sub-ordinate bus number be maximum bus number initially.
      */
     *(volatile uint8_t *)(config->global_config_base +
-                 PCIE_PRIMARY_BUS_NUM_OFFSET) = pri_bnum - 1;
+                 PCIE_PRIMARY_BUS_NUM_OFFSET) = *pri_bnum - 1;
     *(volatile uint8_t *)(config->global_config_base +
-                 PCIE_SECONDARY_BUS_NUM_OFFSET) = pri_bnum;
+                 PCIE_SECONDARY_BUS_NUM_OFFSET) = *pri_bnum;
     *(volatile uint8_t *)(config->global_config_base +
                  PCIE_SUBORDINATE_BUS_NUM_OFFSET) = PCIE_BUS_NUM_MAX;
 
-    sub_bnum = pcie_bus_scan(ecam_base_addr, pri_bnum, sec_bnum);
+    return table;
+}
 
+/*
+ * Set the subordinate bus number of the root port and publish the BDF table
+ * once the bus behind the root port has been enumerated.
+ */
+static void pcie_enumeration_end(
+    struct n1sdp_pcie_dev_config *config,
+    struct bdf_table *table,
+    uint8_t sub_bnum)
+{
     /*
      * Update subordinate bus number with maximum bus number identified
      * from bus scan for this bus hierarchy.
@@ -269,6 +318,75 @@ void pcie_bus_enumeration(struct n1sdp_pcie_dev_config *config)
     table->bdf_count = bdf_count;
 }
 
+void pcie_bus_enumeration(struct n1sdp_pcie_dev_config *config,
+                          struct n1sdp_pcie_topology_sds *topology)
+{
+    fwk_assert(config != NULL);
+
+    uint8_t pri_bnum, sec_bnum, sub_bnum;
+    struct bdf_table *table;
+
+    table = pcie_enumeration_begin(config, &pri_bnum, &sec_bnum);
+
+    topology_rec = topology;
+    if (topology != NULL)
+        topology->count = 0;
+
+    sub_bnum = pcie_bus_scan(config->axi_slave_base32, pri_bnum, sec_bnum);
+
+    topology_rec = NULL;
+    if (topology != NULL)
+        topology->sub_bnum = sub_bnum;
+
+    pcie_enumeration_end(config, table, sub_bnum);
+}
+
+bool pcie_bus_restore(struct n1sdp_pcie_dev_config *config,
+                      const struct n1sdp_pcie_topology_sds *topology)
+{
+    fwk_assert(config != NULL);
+    fwk_assert(topology != NULL);
+    fwk_assert(topology->count <= N1SDP_PCIE_TOPOLOGY_ENTRY_MAX);
+
+    const struct n1sdp_pcie_topology_entry *entry;
+    uint8_t pri_bnum, sec_bnum;
+    uint32_t config_addr;
+    uint32_t vid;
+    struct bdf_table *table;
+    unsigned int i;
+
+    table = pcie_enumeration_begin(config, &pri_bnum, &sec_bnum);
+
+    /*
+     * The functions are listed in the order they were enumerated, so a bridge
+     * is given its bus numbers before the functions behind it are checked.
+     */
+    for (i = 0; i < topology->count; i++) {
+        entry = &topology->entries[i];
+        config_addr = config->axi_slave_base32 + entry->bdf_addr;
+
+        if (!checked_read_u32(&vid, (uint32_t *)config_addr) ||
+            (vid != entry->id))
+            return false;
+
+        bdf_count++;
+        *bdf_table_ptr++ = entry->bdf_addr;
+
+        if (entry->sec_bnum != 0) {
+            *(uint8_t *)(config_addr + PCIE_PRIMARY_BUS_NUM_OFFSET) =
+                entry->bdf_addr >> BDF_ADDR_SHIFT_BUS;
+            *(uint8_t *)(config_addr + PCIE_SECONDARY_BUS_NUM_OFFSET) =
+                entry->sec_bnum;
+            *(uint8_t *)(config_addr + PCIE_SUBORDINATE_BUS_NUM_OFFSET) =
+                entry->sub_bnum;
+        }
+    }
+
+    pcie_enumeration_end(config, table, topology->sub_bnum);
+
+    return true;
+}
+
 /*!
  * \brief Callee context at exception
  */
@@ -20,6 +20,12 @@
 
 /*!
  * \defgroup GroupModuleN1SDPRemotePD N1SDP Remote PD Management Driver
+ *
+ * \details The power states of the remote power domains are mirrored in the
+ *      master chip. They are updated on every transition requested through
+ *      this driver and only queried from the slave chip when unknown, that is
+ *      at first use and after a failed transition.
+ *
  * \{
  */
 
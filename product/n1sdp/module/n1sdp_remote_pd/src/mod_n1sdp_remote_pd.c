@@ -17,11 +17,13 @@
 #include <fwk_assert.h>
 #include <fwk_id.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -35,6 +37,12 @@ struct n1sdp_remote_pd_device_ctx {
 
     /* Power module driver input API */
     struct mod_pd_driver_input_api *pd_driver_input_api;
+
+    /* Last known power state of the remote power domain */
+    unsigned int state;
+
+    /* Whether the last known power state is still valid */
+    bool state_valid;
 };
 
 /* N1SDP remote PD driver module context */
@@ -54,12 +62,62 @@ struct n1sdp_remote_pd_ctx {
 
 static struct n1sdp_remote_pd_ctx remote_pd_ctx;
 
+/*
+ * Helper functions
+ */
+
+/*
+ * The remote power domains only change state through this driver, so the
+ * states are mirrored locally and the slave chip is only queried to resync
+ * the mirror. All the power domains whose state is unknown are resynced
+ * together, N1SDP_C2C_PD_BATCH_MAX at a time.
+ */
+static int remote_pd_resync(void)
+{
+    int status;
+    unsigned int element_id;
+    unsigned int count;
+    unsigned int idx;
+    uint8_t pd_ids[N1SDP_C2C_PD_BATCH_MAX];
+    unsigned int states[N1SDP_C2C_PD_BATCH_MAX];
+    struct n1sdp_remote_pd_device_ctx *dev_ctx;
+
+    /* The last element is logical systop and is not mirrored */
+    element_id = 0;
+    while (element_id < (remote_pd_ctx.pd_count - 1)) {
+        count = 0;
+        while ((count < FWK_ARRAY_SIZE(pd_ids)) &&
+               (element_id < (remote_pd_ctx.pd_count - 1))) {
+            if (!remote_pd_ctx.dev_ctx_table[element_id].state_valid)
+                pd_ids[count++] = (uint8_t)element_id;
+            element_id++;
+        }
+
+        if (count == 0)
+            continue;
+
+        status = remote_pd_ctx.c2c_pd_api->get_states(pd_ids, count, states);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        for (idx = 0; idx < count; idx++) {
+            dev_ctx = &remote_pd_ctx.dev_ctx_table[pd_ids[idx]];
+            dev_ctx->state = states[idx];
+            dev_ctx->state_valid = true;
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
 /*
  * Remote PD API
  */
 static int remote_pd_get_state(fwk_id_t pd_id, unsigned int *state)
 {
+    int status;
     unsigned int element_id;
+    struct n1sdp_remote_pd_device_ctx *dev_ctx;
 
     element_id = fwk_id_get_element_idx(pd_id);
     fwk_assert(element_id < remote_pd_ctx.pd_count);
@@ -73,9 +131,17 @@ static int remote_pd_get_state(fwk_id_t pd_id, unsigned int *state)
         return FWK_SUCCESS;
     }
 
-    return remote_pd_ctx.c2c_pd_api->get_state(
-        N1SDP_C2C_CMD_POWER_DOMAIN_GET_STATE, (uint8_t)element_id,
-        state);
+    dev_ctx = &remote_pd_ctx.dev_ctx_table[element_id];
+
+    if (!dev_ctx->state_valid) {
+        status = remote_pd_resync();
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    *state = dev_ctx->state;
+
+    return FWK_SUCCESS;
 }
 
 static int remote_pd_set_state(fwk_id_t pd_id, unsigned int state)
@@ -104,8 +170,14 @@ static int remote_pd_set_state(fwk_id_t pd_id, unsigned int state)
         status = remote_pd_ctx.c2c_pd_api->set_state(
             N1SDP_C2C_CMD_POWER_DOMAIN_OFF, (uint8_t)element_id,
             (uint8_t)dev_ctx->config->pd_type);
-        if (status != FWK_SUCCESS)
+        if (status != FWK_SUCCESS) {
+            /* The state is unknown after a failed transition */
+            dev_ctx->state_valid = false;
             return status;
+        }
+
+        dev_ctx->state = MOD_PD_STATE_OFF;
+        dev_ctx->state_valid = true;
 
         status = dev_ctx->pd_driver_input_api->report_power_state_transition(
             dev_ctx->bound_id, MOD_PD_STATE_OFF);
@@ -116,8 +188,14 @@ static int remote_pd_set_state(fwk_id_t pd_id, unsigned int state)
         status = remote_pd_ctx.c2c_pd_api->set_state(
             N1SDP_C2C_CMD_POWER_DOMAIN_ON, (uint8_t)element_id,
             (uint8_t)dev_ctx->config->pd_type);
-        if (status != FWK_SUCCESS)
+        if (status != FWK_SUCCESS) {
+            /* The state is unknown after a failed transition */
+            dev_ctx->state_valid = false;
             return status;
+        }
+
+        dev_ctx->state = MOD_PD_STATE_ON;
+        dev_ctx->state_valid = true;
 
         status = dev_ctx->pd_driver_input_api->report_power_state_transition(
             dev_ctx->bound_id, MOD_PD_STATE_ON);
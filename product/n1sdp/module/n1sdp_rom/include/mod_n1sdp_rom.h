@@ -39,6 +39,12 @@ struct n1sdp_rom_config {
     /*! Base address of the RAM to which SCP BL2 will be copied to */
     const uintptr_t ramfw_base;
 
+    /*!
+     * Size of the RAM to which SCP BL2 will be copied to. A compressed image
+     * larger than this size is rejected.
+     */
+    size_t ramfw_size;
+
     /*! Type of RAM Firmware to load */
     enum mod_fip_toc_entry_type image_type;
 };
@@ -8,6 +8,10 @@
 #include <mod_fip.h>
 #include <mod_n1sdp_rom.h>
 
+#ifdef BUILD_HAS_MOD_LZ4
+#    include <mod_lz4.h>
+#endif
+
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
@@ -32,6 +36,11 @@ struct mod_n1sdp_rom_ctx {
 
     /* Pointer to FIP API */
     struct mod_fip_api *fip_api;
+
+#ifdef BUILD_HAS_MOD_LZ4
+    /* Pointer to LZ4 API */
+    const struct mod_lz4_api *lz4_api;
+#endif
 };
 
 enum rom_event {
@@ -92,6 +101,15 @@ static int n1sdp_rom_bind(fwk_id_t id, unsigned int round)
             &n1sdp_rom_ctx.fip_api);
         if (status != FWK_SUCCESS)
             return FWK_E_PANIC;
+
+#ifdef BUILD_HAS_MOD_LZ4
+        status = fwk_module_bind(
+            FWK_ID_MODULE(FWK_MODULE_IDX_LZ4),
+            FWK_ID_API(FWK_MODULE_IDX_LZ4, MOD_LZ4_API_IDX_DECOMPRESS),
+            &n1sdp_rom_ctx.lz4_api);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+#endif
     }
 
     return FWK_SUCCESS;
@@ -117,6 +135,44 @@ static const char *get_image_type_str(enum mod_fip_toc_entry_type type)
     return "???";
 }
 
+/* Copy the image to RAM, decompressing it on the way if it is compressed */
+static int load_ramfw(const struct mod_fip_entry_data *entry,
+    const char *image_type)
+{
+#ifdef BUILD_HAS_MOD_LZ4
+    int status;
+    size_t size;
+
+    if (n1sdp_rom_ctx.lz4_api->is_compressed(entry->base, entry->size)) {
+        FWK_LOG_INFO(
+            "[ROM] Decompressing %s_BL2 to ITCRAM...!\n", image_type);
+
+        status = n1sdp_rom_ctx.lz4_api->decompress(
+            entry->base,
+            entry->size,
+            (void *)n1sdp_rom_ctx.rom_config->ramfw_base,
+            n1sdp_rom_ctx.rom_config->ramfw_size,
+            &size);
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_INFO("[ROM] Failed to decompress %s_BL2, error: %d\n",
+                image_type, status);
+            return status;
+        }
+
+        FWK_LOG_INFO("[ROM]   decompressed size: %u\n", (unsigned int)size);
+
+        return FWK_SUCCESS;
+    }
+#endif
+
+    FWK_LOG_INFO("[ROM] Copying %s_BL2 to ITCRAM...!\n", image_type);
+
+    memcpy(
+        (void *)n1sdp_rom_ctx.rom_config->ramfw_base, entry->base, entry->size);
+
+    return FWK_SUCCESS;
+}
+
 static int n1sdp_rom_process_event(const struct fwk_event *event,
     struct fwk_event *resp)
 {
@@ -140,10 +196,10 @@ static int n1sdp_rom_process_event(const struct fwk_event *event,
     FWK_LOG_INFO("[ROM]   size   : %u\n", entry.size);
     FWK_LOG_INFO("[ROM]   flags  : 0x%08" PRIX32 "%08" PRIX32"\n",
         (uint32_t)(entry.flags >> 32),  (uint32_t)entry.flags);
-    FWK_LOG_INFO("[ROM] Copying %s_BL2 to ITCRAM...!\n", image_type);
 
-    memcpy(
-        (void *)n1sdp_rom_ctx.rom_config->ramfw_base, entry.base, entry.size);
+    status = load_ramfw(&entry, image_type);
+    if (status != FWK_SUCCESS)
+        return status;
     FWK_LOG_INFO("[ROM] Done!");
 
     FWK_LOG_INFO("[ROM] Jumping to %s_BL2\n", image_type);
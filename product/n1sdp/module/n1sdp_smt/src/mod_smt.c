@@ -7,6 +7,7 @@
 
 #include <internal/smt.h>
 
+#include <mod_scmi_agent.h>
 #include <mod_smt.h>
 
 #include <fwk_assert.h>
@@ -226,7 +227,10 @@ static bool smt_is_channel_free(fwk_id_t channel_id)
     return ((memory->status & MOD_SMT_MAILBOX_STATUS_FREE_MASK) != 0);
 }
 
-static int smt_send(fwk_id_t channel_id, struct mod_smt_command_config *cmd)
+static int smt_send(
+    fwk_id_t channel_id,
+    const struct mod_scmi_agent_message *message,
+    unsigned int token)
 {
     struct smt_channel_ctx *channel_ctx;
     struct mod_smt_memory *memory;
@@ -234,13 +238,13 @@ static int smt_send(fwk_id_t channel_id, struct mod_smt_command_config *cmd)
     channel_ctx =
         &smt_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
 
-    if (((cmd->size != 0) && (cmd->payload == NULL)) ||
-        (cmd->size > channel_ctx->max_payload_size)) {
+    if (((message->payload_size != 0) && (message->payload == NULL)) ||
+        (message->payload_size > channel_ctx->max_payload_size)) {
         fwk_unexpected();
         return FWK_E_PARAM;
     }
 
-    memory = ((struct mod_smt_memory*)channel_ctx->config->mailbox_address);
+    memory = ((struct mod_smt_memory *)channel_ctx->config->mailbox_address);
 
     if (!smt_is_channel_free(channel_id))
         return FWK_E_ACCESS;
@@ -248,12 +252,12 @@ static int smt_send(fwk_id_t channel_id, struct mod_smt_command_config *cmd)
     memory->status &= ~MOD_SMT_MAILBOX_STATUS_FREE_MASK;
     channel_ctx->locked = true;
 
-    /* Copy the payload from the payload parameter */
-    if (cmd->payload != NULL)
-        memcpy(memory->payload, cmd->payload, cmd->size);
-    memory->message_header = SCMI_MESSAGE_HEADER(cmd->message_id,
-                                                 cmd->protocol_id, 0);
-    memory->length = sizeof(memory->message_header) + cmd->size;
+    /* Copy the payload from the message */
+    if (message->payload != NULL)
+        memcpy(memory->payload, message->payload, message->payload_size);
+    memory->message_header = SCMI_MESSAGE_HEADER(
+        message->message_id, message->protocol_id, token);
+    memory->length = sizeof(memory->message_header) + message->payload_size;
     memory->flags = MOD_SMT_MAILBOX_FLAGS_IENABLED_MASK;
 
     channel_ctx->driver_api->raise_interrupt(channel_ctx->driver_id);
@@ -261,6 +265,61 @@ static int smt_send(fwk_id_t channel_id, struct mod_smt_command_config *cmd)
     return FWK_SUCCESS;
 }
 
+/*
+ * The response is read from the mailbox rather than from the read buffer, as
+ * the platform may have released the channel before the interrupt mirroring
+ * the mailbox in the read buffer has been handled.
+ */
+static int smt_agent_get_message_header(fwk_id_t channel_id, uint32_t *header)
+{
+    struct smt_channel_ctx *channel_ctx;
+    struct mod_smt_memory *memory;
+
+    if (header == NULL) {
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    channel_ctx =
+        &smt_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+    memory = (struct mod_smt_memory *)channel_ctx->config->mailbox_address;
+
+    if (!channel_ctx->locked || !smt_is_channel_free(channel_id))
+        return FWK_E_ACCESS;
+
+    *header = memory->message_header;
+
+    return FWK_SUCCESS;
+}
+
+static int smt_agent_get_payload(
+    fwk_id_t channel_id,
+    const void **payload,
+    size_t *size)
+{
+    struct smt_channel_ctx *channel_ctx;
+    struct mod_smt_memory *memory;
+
+    if (payload == NULL) {
+        fwk_unexpected();
+        return FWK_E_PARAM;
+    }
+
+    channel_ctx =
+        &smt_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+    memory = (struct mod_smt_memory *)channel_ctx->config->mailbox_address;
+
+    if (!channel_ctx->locked || !smt_is_channel_free(channel_id))
+        return FWK_E_ACCESS;
+
+    *payload = memory->payload;
+
+    if (size != NULL)
+        *size = memory->length - sizeof(memory->message_header);
+
+    return FWK_SUCCESS;
+}
+
 static int smt_put_channel(fwk_id_t channel_id)
 {
     struct smt_channel_ctx *channel_ctx;
@@ -276,13 +335,14 @@ static int smt_put_channel(fwk_id_t channel_id)
     return FWK_SUCCESS;
 }
 
-static const struct mod_scmi_agent_to_transport_api
-    smt_mod_scmi_agent_to_transport_api = {
-    .is_channel_free = smt_is_channel_free,
-    .send = smt_send,
-    .get_payload = smt_get_payload,
-    .put_channel = smt_put_channel,
-};
+static const struct mod_scmi_agent_transport_api
+    smt_mod_scmi_agent_transport_api = {
+        .is_channel_free = smt_is_channel_free,
+        .send = smt_send,
+        .get_message_header = smt_agent_get_message_header,
+        .get_payload = smt_agent_get_payload,
+        .put_channel = smt_put_channel,
+    };
 
 /*
  * Driver handler API
@@ -453,7 +513,7 @@ static int smt_process_bind_request(fwk_id_t source_id,
 
     case MOD_SMT_API_IDX_SCMI_AGENT_TRANSPORT:
         /* SCMI agent transport API */
-        *api = &smt_mod_scmi_agent_to_transport_api;
+        *api = &smt_mod_scmi_agent_transport_api;
         channel_ctx->scmi_service_id = source_id;
         break;
 
@@ -37,6 +37,26 @@ enum mod_n1sdp_timer_sync_api_idx {
     N1SDP_TIMER_SYNC_API_COUNT,
 };
 
+/*!
+ * \brief Estimate of the remote counter relative to the local counter.
+ */
+struct mod_n1sdp_tsync_estimate {
+    /*! Local counter value when the counters were last sampled */
+    uint64_t local;
+
+    /*! Remote counter value minus local counter value at that time */
+    int64_t offset;
+
+    /*!
+     * \brief Drift of the remote counter relative to the local counter in
+     *      parts per billion.
+     *
+     * \details Positive when the remote counter runs faster than the local
+     *      one.
+     */
+    int32_t drift_ppb;
+};
+
 /*!
  * \brief N1SDP Timer Synchronization API
  */
@@ -59,6 +79,38 @@ struct n1sdp_timer_sync_api {
      * \return One of the possible error return codes.
      */
     int (*slave_sync)(fwk_id_t id);
+
+    /*!
+     * \brief Get the latest estimate of the remote counter.
+     *
+     * \details The counters are sampled periodically by the master once it
+     *      has synchronized them, see ::mod_n1sdp_tsync_config::alarm_id.
+     *
+     * \param id Identifier of the timer sync module.
+     * \param[out] estimate Estimate of the remote counter.
+     *
+     * \retval ::FWK_SUCCESS If operation succeeds.
+     * \retval ::FWK_E_PARAM The estimate pointer is NULL.
+     * \retval ::FWK_E_STATE The counters have not been sampled yet.
+     */
+    int (*get_estimate)(fwk_id_t id, struct mod_n1sdp_tsync_estimate *estimate);
+
+    /*!
+     * \brief Convert a remote counter value to the local counter.
+     *
+     * \details The conversion removes the estimated offset of the remote
+     *      counter, corrected for the drift accumulated since the counters
+     *      were last sampled.
+     *
+     * \param id Identifier of the timer sync module.
+     * \param remote Remote counter value.
+     * \param[out] local Local counter value at the same time.
+     *
+     * \retval ::FWK_SUCCESS If operation succeeds.
+     * \retval ::FWK_E_PARAM The local pointer is NULL.
+     * \retval ::FWK_E_STATE The counters have not been sampled yet.
+     */
+    int (*remote_to_local)(fwk_id_t id, uint64_t remote, uint64_t *local);
 };
 
 /*!
@@ -91,6 +143,21 @@ struct mod_n1sdp_tsync_config {
 
     /*! Offset to access target counter remotely */
     uint64_t remote_offset;
+
+    /*!
+     * \brief Identifier of the alarm sampling the counters.
+     *
+     * \details Once the master has synchronized the counters, it samples both
+     *      of them periodically with this alarm to estimate the offset and the
+     *      drift of the remote counter. When the offset exceeds the offset
+     *      threshold, it synchronizes the counters again.
+     *
+     * \note May be ::FWK_ID_NONE to disable the periodic sampling.
+     */
+    fwk_id_t alarm_id;
+
+    /*! Period of the sampling of the counters in milliseconds */
+    unsigned int sample_period_ms;
 };
 
 /*!
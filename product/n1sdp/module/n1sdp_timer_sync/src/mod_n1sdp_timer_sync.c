@@ -17,15 +17,18 @@
 #include <mod_timer.h>
 
 #include <fwk_assert.h>
+#include <fwk_event.h>
 #include <fwk_interrupt.h>
 #include <fwk_log.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #define COUNTER_DELTA_MAX      0x100
 #define INT_STATUS_TIMEOUT     UINT32_C(1000)
@@ -38,6 +41,20 @@
 #define CNTCONTROL_CR_EN        UINT32_C(0x00000001)
 #define CNTCONTROL_CR_FCREQ     UINT32_C(0x00000100)
 
+#define PPB                     INT64_C(1000000000)
+
+/* Weight of a new drift measurement in the estimate, as a power of 2 */
+#define DRIFT_FILTER_SHIFT      3
+
+/* Event indices */
+enum tsync_event_idx {
+    /* Sample the local and remote counters */
+    TSYNC_EVENT_IDX_SAMPLE,
+
+    /* Number of events */
+    TSYNC_EVENT_IDX_COUNT
+};
+
 /* N1SDP timer synchronization device context */
 struct tsync_device_ctx {
     /* Pointer to the device configuration */
@@ -51,6 +68,18 @@ struct tsync_device_ctx {
 
     /* Storage to hold remote counter address */
     uint32_t remote_cnt_addr;
+
+    /* Alarm API sampling the counters */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* The counters have been sampled at least once since they were synced */
+    bool sampled;
+
+    /* The drift has been measured at least once */
+    bool drift_measured;
+
+    /* Latest estimate of the remote counter */
+    struct mod_n1sdp_tsync_estimate estimate;
 };
 
 /* N1SDP timer synchronization module context */
@@ -103,6 +132,97 @@ bool is_timer_synced(struct tsync_device_ctx *ctx)
     return (((low_r - low) < COUNTER_DELTA_MAX));
 }
 
+static uint64_t read_counter(uintptr_t addr)
+{
+    uint32_t low;
+    uint32_t high;
+
+    do {
+        high = *(volatile uint32_t *)(addr + CNTCTL_CVH_OFFSET);
+        low = *(volatile uint32_t *)(addr + CNTCTL_CVL_OFFSET);
+    } while (high != *(volatile uint32_t *)(addr + CNTCTL_CVH_OFFSET));
+
+    return ((uint64_t)high << 32) | low;
+}
+
+/*
+ * Sample both counters and update the estimate of the remote counter. The
+ * remote counter is read through the AP memory window, so the local counter
+ * is read on both sides of it and the remote value is assumed to have been
+ * sampled half-way.
+ */
+static void sample_counters(struct tsync_device_ctx *ctx)
+{
+    struct mod_n1sdp_tsync_estimate *estimate = &ctx->estimate;
+    uint64_t before;
+    uint64_t after;
+    uint64_t local;
+    uint64_t remote;
+    int64_t offset;
+    int64_t drift_ppb;
+
+    tsync_ctx.ap_mem_api->enable_ap_memory_access(ctx->remote_cnt_addr);
+
+    before = read_counter(ctx->local_cnt_addr);
+    remote = read_counter(SCP_AP_1MB_WINDOW_BASE +
+        (ctx->local_cnt_addr & SCP_AP_1MB_WINDOW_ADDR_MASK));
+    after = read_counter(ctx->local_cnt_addr);
+
+    tsync_ctx.ap_mem_api->disable_ap_memory_access();
+
+    local = before + ((after - before) / 2);
+    offset = (int64_t)(remote - local);
+
+    if (ctx->sampled && (local > estimate->local)) {
+        drift_ppb = ((offset - estimate->offset) * PPB) /
+            (int64_t)(local - estimate->local);
+        drift_ppb = FWK_MAX(FWK_MIN(drift_ppb, (int64_t)INT32_MAX),
+                            (int64_t)INT32_MIN);
+
+        /* Smooth out the jitter of the samples */
+        if (ctx->drift_measured) {
+            drift_ppb = estimate->drift_ppb +
+                ((drift_ppb - estimate->drift_ppb) / (1 << DRIFT_FILTER_SHIFT));
+        }
+
+        estimate->drift_ppb = (int32_t)drift_ppb;
+        ctx->drift_measured = true;
+    }
+
+    estimate->local = local;
+    estimate->offset = offset;
+    ctx->sampled = true;
+
+    /*
+     * Synchronize the counters again once they have drifted apart beyond the
+     * uncertainty of the sample, the next samples measuring the drift from the
+     * new offset.
+     */
+    if ((uint64_t)((offset < 0) ? -offset : offset) >
+        (ctx->config->off_threshold + ((after - before) / 2))) {
+        FWK_LOG_INFO(
+            "[N1SDP_TIMER_SYNC] Resync, offset: %ld", (long)offset);
+
+        ctx->reg->MST_GCNT_SYNC_CTRL =
+            MST_GCNT_SYNC_CTRL_EN_MASK | MST_GCNT_SYNC_CTRL_EN_IMM_MASK;
+        ctx->sampled = false;
+    }
+}
+
+static void sample_alarm_callback(uintptr_t param)
+{
+    int status;
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_N1SDP_TIMER_SYNC,
+                           TSYNC_EVENT_IDX_SAMPLE),
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_TIMER_SYNC),
+        .target_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_N1SDP_TIMER_SYNC, param),
+    };
+
+    status = fwk_thread_put_event(&event);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
 void n1sdp_timer_reset_counter(struct tsync_device_ctx *ctx)
 {
     *(volatile uint32_t *)(ctx->local_cnt_addr + CNTCTL_CR_OFFSET) = 0;
@@ -138,12 +258,28 @@ static int n1sdp_sync_master_timer(fwk_id_t id)
             FWK_LOG_INFO("[N1SDP_TIMER_SYNC] Retries: %u", retries);
     } while (retries != 0);
 
-    if ((retries == 0) && (!is_timer_synced(device_ctx)))
+    if ((retries == 0) && (!is_timer_synced(device_ctx))) {
         FWK_LOG_INFO("[N1SDP_TIMER_SYNC] Timeout!");
-    else
-        FWK_LOG_INFO("[N1SDP_TIMER_SYNC] Synced");
 
-    return FWK_SUCCESS;
+        return FWK_SUCCESS;
+    }
+
+    FWK_LOG_INFO("[N1SDP_TIMER_SYNC] Synced");
+
+    /* Keep track of the remote counter in the background */
+    device_ctx->sampled = false;
+    device_ctx->drift_measured = false;
+    if (device_ctx->alarm_api == NULL)
+        return FWK_SUCCESS;
+
+    sample_counters(device_ctx);
+
+    return device_ctx->alarm_api->start(
+        device_ctx->config->alarm_id,
+        device_ctx->config->sample_period_ms,
+        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        sample_alarm_callback,
+        fwk_id_get_element_idx(id));
 }
 
 static int n1sdp_sync_slave_timer(fwk_id_t id)
@@ -169,9 +305,58 @@ static int n1sdp_sync_slave_timer(fwk_id_t id)
     return FWK_SUCCESS;
 }
 
+static int n1sdp_tsync_get_estimate(
+    fwk_id_t id,
+    struct mod_n1sdp_tsync_estimate *estimate)
+{
+    struct tsync_device_ctx *device_ctx;
+
+    if (estimate == NULL)
+        return FWK_E_PARAM;
+
+    device_ctx = &tsync_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
+    if (!device_ctx->sampled)
+        return FWK_E_STATE;
+
+    *estimate = device_ctx->estimate;
+
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_tsync_remote_to_local(
+    fwk_id_t id,
+    uint64_t remote,
+    uint64_t *local)
+{
+    struct tsync_device_ctx *device_ctx;
+    const struct mod_n1sdp_tsync_estimate *estimate;
+    int64_t elapsed;
+    int64_t offset;
+
+    if (local == NULL)
+        return FWK_E_PARAM;
+
+    device_ctx = &tsync_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
+    if (!device_ctx->sampled)
+        return FWK_E_STATE;
+
+    estimate = &device_ctx->estimate;
+
+    /* Offset extrapolated to the time of the remote value */
+    elapsed = (int64_t)(remote - estimate->offset - estimate->local);
+    offset = estimate->offset + ((elapsed / PPB) * estimate->drift_ppb) +
+        (((elapsed % PPB) * estimate->drift_ppb) / PPB);
+
+    *local = remote - (uint64_t)offset;
+
+    return FWK_SUCCESS;
+}
+
 const struct n1sdp_timer_sync_api n1sdp_tsync_api = {
     .master_sync = n1sdp_sync_master_timer,
     .slave_sync = n1sdp_sync_slave_timer,
+    .get_estimate = n1sdp_tsync_get_estimate,
+    .remote_to_local = n1sdp_tsync_remote_to_local,
 };
 
 /*
@@ -216,22 +401,49 @@ static int n1sdp_timer_sync_device_init(fwk_id_t device_id,
 static int n1sdp_timer_sync_bind(fwk_id_t id, unsigned int round)
 {
     int status;
+    struct tsync_device_ctx *device_ctx;
 
-    if ((round == 0) && fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
-        status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_SYSTEM),
-            FWK_ID_API(FWK_MODULE_IDX_N1SDP_SYSTEM,
-                       MOD_N1SDP_SYSTEM_API_IDX_AP_MEMORY_ACCESS),
-            &tsync_ctx.ap_mem_api);
-        if (status != FWK_SUCCESS)
-            return status;
-
-        status = fwk_module_bind(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-            FWK_ID_API(FWK_MODULE_IDX_TIMER, MOD_TIMER_API_IDX_TIMER),
-            &tsync_ctx.timer_api);
-        if (status != FWK_SUCCESS)
-            return status;
+    if (round != 0)
+        return FWK_SUCCESS;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
+        device_ctx = &tsync_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
+        if (fwk_id_is_type(device_ctx->config->alarm_id, FWK_ID_TYPE_NONE))
+            return FWK_SUCCESS;
+
+        return fwk_module_bind(device_ctx->config->alarm_id,
+            MOD_TIMER_API_ID_ALARM, &device_ctx->alarm_api);
     }
 
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_SYSTEM),
+        FWK_ID_API(FWK_MODULE_IDX_N1SDP_SYSTEM,
+                   MOD_N1SDP_SYSTEM_API_IDX_AP_MEMORY_ACCESS),
+        &tsync_ctx.ap_mem_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_module_bind(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
+        FWK_ID_API(FWK_MODULE_IDX_TIMER, MOD_TIMER_API_IDX_TIMER),
+        &tsync_ctx.timer_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_timer_sync_process_event(const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    struct tsync_device_ctx *device_ctx;
+
+    if (fwk_id_get_event_idx(event->id) != TSYNC_EVENT_IDX_SAMPLE)
+        return FWK_E_PARAM;
+
+    device_ctx = &tsync_ctx.device_ctx_table[
+        fwk_id_get_element_idx(event->target_id)];
+
+    sample_counters(device_ctx);
+
     return FWK_SUCCESS;
 }
 
@@ -247,8 +459,10 @@ const struct fwk_module module_n1sdp_timer_sync = {
     .name = "N1SDP Timer Sync",
     .type = FWK_MODULE_TYPE_DRIVER,
     .api_count = N1SDP_TIMER_SYNC_API_COUNT,
+    .event_count = TSYNC_EVENT_IDX_COUNT,
     .init = n1sdp_timer_sync_init,
     .element_init = n1sdp_timer_sync_device_init,
     .bind = n1sdp_timer_sync_bind,
     .process_bind_request = n1sdp_timer_sync_process_bind_request,
+    .process_event = n1sdp_timer_sync_process_event,
 };
@@ -7,9 +7,11 @@
 
 #include "config_clock.h"
 #include "n1sdp_scp_mmap.h"
+#include "n1sdp_sds.h"
 
 #include <mod_n1sdp_dmc620.h>
 
+#include <fwk_assert.h>
 #include <fwk_element.h>
 #include <fwk_id.h>
 #include <fwk_module.h>
@@ -43,6 +45,10 @@ static const struct fwk_element *dmc620_get_element_table(fwk_id_t module_id)
     return dmc620_element_table;
 }
 
+static_assert(sizeof(struct mod_dmc620_training_sds) <=
+                  N1SDP_SDS_DDR_TRAINING_SIZE,
+              "DDR training SDS structure too small");
+
 /* Configuration of the DMC620 module. */
 const struct fwk_module_config config_n1sdp_dmc620 = {
     .data =
@@ -50,6 +56,12 @@ const struct fwk_module_config config_n1sdp_dmc620 = {
             .ddr_module_id = FWK_ID_MODULE_INIT(FWK_MODULE_IDX_N1SDP_DDR_PHY),
             .ddr_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_N1SDP_DDR_PHY, 0),
             .ddr_speed = DDR_CLOCK_MHZ,
+            .training_sds_structure_id = N1SDP_SDS_DDR_TRAINING,
+            /*
+             * The temperature sensors are sampled only once the system is
+             * running, after the DDR has been initialized.
+             */
+            .temp_sensor_id = FWK_ID_NONE_INIT,
         },
 
     .elements = FWK_MODULE_DYNAMIC_ELEMENTS(dmc620_get_element_table),
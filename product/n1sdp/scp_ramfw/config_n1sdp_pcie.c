@@ -6,12 +6,15 @@
  */
 
 #include "n1sdp_scp_mmap.h"
+#include "n1sdp_sds.h"
 
 #include <mod_n1sdp_pcie.h>
 
+#include <fwk_assert.h>
 #include <fwk_element.h>
 #include <fwk_id.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 
 #include <stdbool.h>
 
@@ -25,6 +28,8 @@ static const struct fwk_element n1sdp_pcie_element_table[] = {
             .axi_slave_base32 = PCIE_AXI_SLAVE_SCP_BASE,
             .axi_slave_base64 = PCIE_AXI64_SLAVE_AP_BASE,
             .ccix_capable = false,
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 2),
+            .topology_sds_structure_id = N1SDP_SDS_PCIE_TOPOLOGY,
         }),
     },
     [1] = {
@@ -36,11 +41,17 @@ static const struct fwk_element n1sdp_pcie_element_table[] = {
             .axi_slave_base32 = CCIX_AXI_SLAVE_SCP_BASE,
             .axi_slave_base64 = CCIX_AXI64_SLAVE_AP_BASE,
             .ccix_capable = true,
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 3),
+            .topology_sds_structure_id = N1SDP_SDS_CCIX_TOPOLOGY,
         }),
     },
     [2] = { 0 }, /* Termination description. */
 };
 
+static_assert(sizeof(struct n1sdp_pcie_topology_sds) <=
+                  N1SDP_SDS_PCIE_TOPOLOGY_SIZE,
+              "PCIe topology SDS structure too small");
+
 static const struct fwk_element *n1sdp_pcie_get_element_table
     (fwk_id_t module_id)
 {
@@ -13,6 +13,7 @@
 #include <fwk_id.h>
 #include <fwk_macros.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 
 #include <fmw_cmsis.h>
 
@@ -29,6 +30,8 @@ static const struct fwk_element n1sdp_tsync_element_table[] = {
             .target_cnt_base = 0x2A430000,
             .local_offset = SCP_SYS1_BASE,
             .remote_offset = (4UL * FWK_TIB),
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 4),
+            .sample_period_ms = 1000,
         })
     },
     [1] = { 0 },
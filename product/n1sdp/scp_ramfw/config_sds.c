@@ -108,6 +108,30 @@ static struct fwk_element sds_element_table[] = {
             .finalize = true,
         }),
     },
+    {
+        .name = "DDR Training",
+        .data = &((struct mod_sds_structure_desc) {
+            .id = N1SDP_SDS_DDR_TRAINING,
+            .size = N1SDP_SDS_DDR_TRAINING_SIZE,
+            .region_id = N1SDP_SDS_REGION_SECURE,
+        }),
+    },
+    {
+        .name = "PCIe Topology",
+        .data = &((struct mod_sds_structure_desc) {
+            .id = N1SDP_SDS_PCIE_TOPOLOGY,
+            .size = N1SDP_SDS_PCIE_TOPOLOGY_SIZE,
+            .region_id = N1SDP_SDS_REGION_SECURE,
+        }),
+    },
+    {
+        .name = "CCIX Topology",
+        .data = &((struct mod_sds_structure_desc) {
+            .id = N1SDP_SDS_CCIX_TOPOLOGY,
+            .size = N1SDP_SDS_PCIE_TOPOLOGY_SIZE,
+            .region_id = N1SDP_SDS_REGION_SECURE,
+        }),
+    },
 #ifdef BUILD_MODE_DEBUG
     {
         .name = "Boot Counters",
@@ -135,7 +159,9 @@ static_assert(SCP_SDS_SECURE_SIZE >
                     N1SDP_SDS_CPU_INFO_SIZE +
                     N1SDP_SDS_FIRMWARE_VERSION_SIZE +
                     N1SDP_SDS_RESET_SYNDROME_SIZE +
-                    N1SDP_SDS_FEATURE_AVAILABILITY_SIZE,
+                    N1SDP_SDS_FEATURE_AVAILABILITY_SIZE +
+                    N1SDP_SDS_DDR_TRAINING_SIZE +
+                    (2 * N1SDP_SDS_PCIE_TOPOLOGY_SIZE),
             "SDS structures too large for SDS S-RAM.\n");
 
 #ifdef BUILD_MODE_DEBUG
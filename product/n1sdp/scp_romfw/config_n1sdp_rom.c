@@ -17,6 +17,7 @@ const struct fwk_module_config config_n1sdp_rom = {
         .fip_base_address = SCP_QSPI_FLASH_BASE_ADDR,
         .fip_nvm_size = SCP_QSPI_FLASH_SIZE,
         .ramfw_base = SCP_RAM0_BASE,
+        .ramfw_size = SCP_RAM0_SIZE,
         .image_type = MOD_FIP_TOC_ENTRY_SCP_BL2,
     })
 };
@@ -32,6 +32,16 @@
 struct mod_arch_timer_dev_config {
     /*! Identifier of the clock that this device depends on */
     fwk_id_t clock_id;
+
+    /*!
+     * \brief Minimum number of ticks between programming a compare and its
+     *      expiry.
+     *
+     * \details Deadlines closer than this are postponed to it. When 0, the
+     *      deadlines are programmed as they are without reading the counter,
+     *      a deadline already passed firing immediately.
+     */
+    uint32_t min_delta;
 };
 
 /*!
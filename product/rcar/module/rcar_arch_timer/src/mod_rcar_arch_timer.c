@@ -28,7 +28,6 @@
 #define CNTBASE_P_CTL_ENABLE UINT32_C(0x00000001)
 #define CNTBASE_P_CTL_IMASK UINT32_C(0x00000002)
 #define CNTBASE_P_CTL_ISTATUS UINT32_C(0x00000004)
-#define GTIMER_MIN_TIMESTAMP 2000
 
 /* Device content */
 struct dev_ctx {
@@ -86,13 +85,18 @@ static int get_counter(fwk_id_t dev_id, uint64_t *value)
 static int set_timer(fwk_id_t dev_id, uint64_t timestamp)
 {
     uint64_t counter;
-    int status;
-
-    status = get_counter(dev_id, &counter);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    timestamp = FWK_MAX(counter + GTIMER_MIN_TIMESTAMP, timestamp);
+    uint32_t min_delta = mod_arch_timer_ctx.table->config->min_delta;
+
+    /*
+     * The compare fires as soon as the counter reaches it, including when it
+     * is programmed in the past, so the deadline is programmed as it is. The
+     * counter is only read when the deadline must be at least the minimum
+     * delta away.
+     */
+    if (min_delta != 0) {
+        counter = mod_arch_timer_get_counter();
+        timestamp = FWK_MAX(counter + min_delta, timestamp);
+    }
 
     write_cntp_cval_el0(timestamp);
 
@@ -30,6 +30,15 @@
  *      MFISMB device that consists
  *      of a single receive interrupt line and a pair of register sets, one for
  *      each direction of communication.
+ *
+ *      Each device has its own receive interrupt, serviced independently of
+ *      the other devices, so that the SMT channels bound to different devices
+ *      do not contend with each other.
+ *
+ *      Only the SMT channels of the slots rung are signaled. A device with a
+ *      single slot is rung for that slot. The agent of a device with several
+ *      slots, up to 15, sets the bit of each slot it rings in the event code
+ *      (EIC) of the doorbell.
  */
 struct mod_rcar_mfismh_device_config {
     /*! IRQ number of the receive interrupt line */
@@ -38,7 +47,13 @@ struct mod_rcar_mfismh_device_config {
     /*! Base address of the registers of the incoming MFISMHU */
     uintptr_t in;
 
-    /*! Base address of the registers of the outgoing MFISMHU */
+    /*!
+     * \brief Base address of the registers of the outgoing MFISMHU.
+     *
+     * \details May be 0 if the device does not ring the agent. Otherwise the
+     *      doorbells rung while the agent has not acknowledged the previous
+     *      one are coalesced with it.
+     */
     uintptr_t out;
 };
 
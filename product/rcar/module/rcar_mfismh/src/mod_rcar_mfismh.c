@@ -20,6 +20,7 @@
 #include <fwk_status.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 /*
  * Maximum number of slots per MFISMH device. The maximum number of slots is 31
@@ -30,6 +31,9 @@
  */
 #define MFISMH_SLOT_COUNT_MAX 31
 
+/* Number of slots that can be identified in the event code of a doorbell */
+#define MFISMH_EIC_SLOT_COUNT_MAX 15
+
 struct mfismh_reg *mfis_regs;
 
 struct mfismh_smt_channel {
@@ -63,49 +67,47 @@ struct mfismh_ctx {
 
 static struct mfismh_ctx mfismh_ctx;
 
-static void mfismh_isr(void)
+static void mfismh_isr(uintptr_t param)
 {
-    int status;
-    unsigned int interrupt;
-    unsigned int device_idx;
-    struct mfismh_device_ctx *device_ctx;
+    struct mfismh_device_ctx *device_ctx = (struct mfismh_device_ctx *)param;
     unsigned int slot;
+    uint32_t pending_slots;
     struct mfismh_reg *reg;
     struct mfismh_smt_channel *smt_channel;
 
-    status = fwk_interrupt_get_current(&interrupt);
-    if (status != FWK_SUCCESS)
-        return;
+    reg = (struct mfismh_reg *)&mfis_regs[MFIS_IRQ2NO(device_ctx->config->irq)];
 
-    if (!IS_MFIS_IRQ(interrupt))
+    /* Spurious interrupt, no doorbell is rung */
+    if (reg->CCR.eir == 0)
         return;
 
-    for (device_idx = 0; device_idx < mfismh_ctx.device_count; device_idx++) {
-        device_ctx = &mfismh_ctx.device_ctx_table[device_idx];
-        if (device_ctx->config->irq == interrupt)
-            break;
-    }
-
-    if (device_idx >= mfismh_ctx.device_count)
-        return;
-
-    reg = (struct mfismh_reg *)&mfis_regs[MFIS_IRQ2NO(interrupt)];
-
-    /* Acknowledge the interrupt */
-    reg->CCR.eir = 0;
-
-    /* Loop over all the slots */ /* For prototyping, slot number is 0 only. */
-    {
-        slot = 0;
-
-        /*
-         * If the slot is bound to an SMT channel, signal the message to the
-         * SMT channel.
-         */
-        if (device_ctx->bound_slots & (1 << slot)) {
-            smt_channel = &device_ctx->smt_channel_table[slot];
-            smt_channel->api->signal_message(smt_channel->id);
-        }
+    /*
+     * A device with a single slot is rung for that slot. The agent of a
+     * device with several slots identifies the slots it rang in the event
+     * code.
+     */
+    if (device_ctx->slot_count == 1)
+        pending_slots = 1;
+    else
+        pending_slots = reg->CCR.eic;
+
+    /*
+     * Acknowledge the interrupt once for all the slots. A doorbell rung from
+     * now on raises the interrupt again.
+     */
+    reg->CCR2CA = 0;
+
+    /*
+     * Signal the message to the SMT channels bound to the slots rung.
+     */
+    pending_slots &= device_ctx->bound_slots;
+
+    for (slot = 0; pending_slots != 0; slot++, pending_slots >>= 1) {
+        if (!(pending_slots & 1))
+            continue;
+
+        smt_channel = &device_ctx->smt_channel_table[slot];
+        smt_channel->api->signal_message(smt_channel->id);
     }
 }
 
@@ -114,7 +116,26 @@ static void mfismh_isr(void)
  */
 static int raise_interrupt(fwk_id_t slot_id)
 {
-    /* This function is unsupported. */
+    struct mfismh_device_ctx *device_ctx;
+    struct mfismh_reg *reg;
+
+    device_ctx = &mfismh_ctx.device_ctx_table[fwk_id_get_element_idx(slot_id)];
+
+    /* The device has no outgoing doorbell */
+    if (device_ctx->config->out == 0)
+        return FWK_SUCCESS;
+
+    reg = (struct mfismh_reg *)device_ctx->config->out;
+
+    /*
+     * A doorbell that the agent has not acknowledged yet covers the new
+     * message as well, so the notifications of a burst ring it only once.
+     */
+    if (reg->CCR.eir != 0)
+        return FWK_SUCCESS;
+
+    reg->CCR.eir = 1;
+
     return FWK_SUCCESS;
 }
 
@@ -152,6 +173,9 @@ static int mfismh_device_init(
         (struct mod_rcar_mfismh_device_config *)data;
     struct mfismh_device_ctx *device_ctx;
 
+    if (slot_count > MFISMH_EIC_SLOT_COUNT_MAX)
+        return FWK_E_PARAM;
+
     device_ctx =
         &mfismh_ctx.device_ctx_table[fwk_id_get_element_idx(device_id)];
 
@@ -235,7 +259,11 @@ static int mfismh_start(fwk_id_t id)
     device_ctx = &mfismh_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
 
     if (device_ctx->bound_slots != 0) {
-        status = fwk_interrupt_set_isr(device_ctx->config->irq, &mfismh_isr);
+        if (!IS_MFIS_IRQ(device_ctx->config->irq))
+            return FWK_E_PARAM;
+
+        status = fwk_interrupt_set_isr_param(
+            device_ctx->config->irq, &mfismh_isr, (uintptr_t)device_ctx);
         if (status != FWK_SUCCESS)
             return status;
         status = fwk_interrupt_enable(device_ctx->config->irq);
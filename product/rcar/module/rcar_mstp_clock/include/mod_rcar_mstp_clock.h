@@ -15,6 +15,8 @@
 #include <mod_rcar_clock.h>
 
 #include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
 
 #include <stdint.h>
 
@@ -42,6 +44,50 @@ struct mod_rcar_mstp_clock_dev_config {
     const bool defer_initialization;
 };
 
+/*!
+ * \brief Batched MSTP clock gating API.
+ */
+struct mod_rcar_mstp_clock_batch_api {
+    /*!
+     * \brief Set the running state of a set of clocks.
+     *
+     * \details The clocks are grouped by module stop control register. Each
+     *     register is written once with the bits of all its clocks, and when
+     *     starting the clocks its status is then polled once for all of them.
+     *
+     * \param clock_ids Table of the clock device identifiers.
+     *
+     * \param count Number of clocks in the table.
+     *
+     * \param state One of the valid clock states.
+     *
+     * \retval FWK_SUCCESS The operation succeeded.
+     * \retval FWK_E_PARAM An invalid parameter was encountered.
+     * \retval FWK_E_TIMEOUT A module did not start in time. The state of the
+     *     clocks is not updated.
+     */
+    int (*set_state)(
+        const fwk_id_t *clock_ids,
+        unsigned int count,
+        enum mod_clock_state state);
+};
+
+/*!
+ * \brief APIs provided by the driver.
+ */
+enum mod_rcar_mstp_clock_api_type {
+    /*! Batched MSTP clock gating API */
+    MOD_RCAR_MSTP_CLOCK_API_TYPE_BATCH = MOD_RCAR_CLOCK_API_COUNT,
+    MOD_RCAR_MSTP_CLOCK_API_COUNT,
+};
+
+/*!
+ * \brief Batched MSTP clock gating API identifier.
+ */
+static const fwk_id_t mod_rcar_mstp_clock_api_id_batch = FWK_ID_API_INIT(
+    FWK_MODULE_IDX_RCAR_MSTP_CLOCK,
+    MOD_RCAR_MSTP_CLOCK_API_TYPE_BATCH);
+
 /*!
  * @cond
  */
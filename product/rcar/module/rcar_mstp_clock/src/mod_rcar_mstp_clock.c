@@ -16,40 +16,60 @@
 
 #include <fwk_assert.h>
 #include <fwk_element.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
+/* Number of module stop control registers */
+#define MSTP_REG_COUNT FWK_ARRAY_SIZE(smstpcr)
+
 static struct rcar_mstp_clock_ctx module_ctx;
 
 /*
  * Static helper functions
  */
-static int mstp_clock_set_state(
-    fwk_id_t dev_id,
+
+/*
+ * Start or stop the clocks of the given bits of each module stop control
+ * register. Each register is written once, and the status of the registers
+ * is polled once all of them have been written so that the modules start in
+ * parallel.
+ */
+static int mstp_clock_apply(
+    const uint32_t masks[MSTP_REG_COUNT],
     enum mod_clock_state target_state)
 {
-    struct rcar_mstp_clock_dev_ctx *ctx;
+    unsigned int reg;
     uint32_t value;
     int i;
 
-    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
+    for (reg = 0; reg < MSTP_REG_COUNT; reg++) {
+        if (masks[reg] == 0)
+            continue;
 
-    value = mmio_read_32(CPG_BASE + smstpcr[ctx->config->control_reg]);
-    if (MOD_CLOCK_STATE_RUNNING == target_state)
-        value &= ~(BIT(ctx->config->bit));
-    else
-        value |= BIT(ctx->config->bit);
+        value = mmio_read_32(CPG_BASE + smstpcr[reg]);
+        if (MOD_CLOCK_STATE_RUNNING == target_state)
+            value &= ~masks[reg];
+        else
+            value |= masks[reg];
 
-    mmio_write_32((CPG_BASE + smstpcr[ctx->config->control_reg]), value);
+        mmio_write_32((CPG_BASE + smstpcr[reg]), value);
+    }
+
+    if (MOD_CLOCK_STATE_RUNNING != target_state)
+        return FWK_SUCCESS;
+
+    for (reg = 0; reg < MSTP_REG_COUNT; reg++) {
+        if (masks[reg] == 0)
+            continue;
 
-    if (MOD_CLOCK_STATE_RUNNING == target_state) {
         for (i = 1000; i > 0; --i) {
-            if (!(mmio_read_32(CPG_BASE + mstpsr[ctx->config->control_reg]) &
-                  BIT(ctx->config->bit)))
+            if (!(mmio_read_32(CPG_BASE + mstpsr[reg]) & masks[reg]))
                 break;
         }
 
@@ -57,10 +77,68 @@ static int mstp_clock_set_state(
             return FWK_E_TIMEOUT;
     }
 
+    return FWK_SUCCESS;
+}
+
+static int mstp_clock_set_state(
+    fwk_id_t dev_id,
+    enum mod_clock_state target_state)
+{
+    struct rcar_mstp_clock_dev_ctx *ctx;
+    uint32_t masks[MSTP_REG_COUNT] = { 0 };
+    int status;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
+
+    masks[ctx->config->control_reg] = BIT(ctx->config->bit);
+
+    status = mstp_clock_apply(masks, target_state);
+    if (status != FWK_SUCCESS)
+        return status;
+
     ctx->current_state = target_state;
     return FWK_SUCCESS;
 }
 
+static int mstp_clock_set_state_batch(
+    const fwk_id_t *dev_ids,
+    unsigned int count,
+    enum mod_clock_state target_state)
+{
+    struct rcar_mstp_clock_dev_ctx *ctx;
+    uint32_t masks[MSTP_REG_COUNT] = { 0 };
+    unsigned int i;
+    int status;
+
+    if ((dev_ids == NULL) && (count != 0))
+        return FWK_E_PARAM;
+
+    if ((target_state != MOD_CLOCK_STATE_RUNNING) &&
+        (target_state != MOD_CLOCK_STATE_STOPPED))
+        return FWK_E_PARAM;
+
+    for (i = 0; i < count; i++) {
+        if ((fwk_id_get_module_idx(dev_ids[i]) !=
+             FWK_MODULE_IDX_RCAR_MSTP_CLOCK) ||
+            !fwk_module_is_valid_element_id(dev_ids[i]))
+            return FWK_E_PARAM;
+
+        ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_ids[i]);
+        masks[ctx->config->control_reg] |= BIT(ctx->config->bit);
+    }
+
+    status = mstp_clock_apply(masks, target_state);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (i = 0; i < count; i++) {
+        ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_ids[i]);
+        ctx->current_state = target_state;
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int mstp_clock_get_state(fwk_id_t dev_id, enum mod_clock_state *state)
 {
     struct rcar_mstp_clock_dev_ctx *ctx;
@@ -71,8 +149,8 @@ static int mstp_clock_get_state(fwk_id_t dev_id, enum mod_clock_state *state)
 }
 
 static void mstp_clock_hw_initial_set_state(
-    fwk_id_t element_id,
-    struct rcar_mstp_clock_dev_ctx *ctx)
+    struct rcar_mstp_clock_dev_ctx *ctx,
+    uint32_t masks[MSTP_REG_COUNT])
 {
     /* Maintain clock supply at startup. */
     if (module_ctx.mstp_init->smstpcr_init[ctx->config->control_reg] &
@@ -83,7 +161,7 @@ static void mstp_clock_hw_initial_set_state(
 
     /* If true, the driver will provide a default clock supply. */
     if (ctx->config->defer_initialization)
-        mstp_clock_set_state(element_id, MOD_CLOCK_STATE_RUNNING);
+        masks[ctx->config->control_reg] |= BIT(ctx->config->bit);
 }
 
 static int mstp_clock_resume(void)
@@ -91,13 +169,28 @@ static int mstp_clock_resume(void)
     fwk_id_t element_id =
         FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_CLOCK, CLK_ID_MSTP_START);
     uint32_t mstp_id;
+    uint32_t masks[MSTP_REG_COUNT] = { 0 };
     struct rcar_mstp_clock_dev_ctx *ctx;
+    int status;
 
     for (mstp_id = CLK_ID_MSTP_START; mstp_id < CLK_ID_MSTP_END; mstp_id++) {
         element_id.element.element_idx = mstp_id;
         ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(element_id);
-        mstp_clock_hw_initial_set_state(element_id, ctx);
+        mstp_clock_hw_initial_set_state(ctx, masks);
     }
+
+    /* Start the clocks supplied by default, a register at a time */
+    status = mstp_clock_apply(masks, MOD_CLOCK_STATE_RUNNING);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (mstp_id = CLK_ID_MSTP_START; mstp_id < CLK_ID_MSTP_END; mstp_id++) {
+        element_id.element.element_idx = mstp_id;
+        ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(element_id);
+        if (ctx->config->defer_initialization)
+            ctx->current_state = MOD_CLOCK_STATE_RUNNING;
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -137,6 +230,10 @@ static const struct mod_rcar_clock_drv_api api_clock = {
     .get_range = mstp_clock_get_range,
 };
 
+static const struct mod_rcar_mstp_clock_batch_api api_batch = {
+    .set_state = mstp_clock_set_state_batch,
+};
+
 /*
  * Framework handler functions
  */
@@ -189,7 +286,10 @@ static int mstp_clock_process_bind_request(
     fwk_id_t api_id,
     const void **api)
 {
-    *api = &api_clock;
+    if (fwk_id_get_api_idx(api_id) == MOD_RCAR_MSTP_CLOCK_API_TYPE_BATCH)
+        *api = &api_batch;
+    else
+        *api = &api_clock;
     return FWK_SUCCESS;
 }
 
@@ -208,7 +308,7 @@ static int mstp_clock_start(fwk_id_t id)
 const struct fwk_module module_rcar_mstp_clock = {
     .name = "MSTP Clock Driver",
     .type = FWK_MODULE_TYPE_DRIVER,
-    .api_count = MOD_RCAR_CLOCK_API_COUNT,
+    .api_count = MOD_RCAR_MSTP_CLOCK_API_COUNT,
     .event_count = 0,
     .init = mstp_clock_init,
     .element_init = mstp_clock_element_init,
@@ -42,6 +42,12 @@ struct rcar_sysc_pd_ctx {
     struct mod_pd_driver_input_api *pd_driver_input_api;
     /* Power Domain current state*/
     unsigned int current_state;
+
+    /* Power state being transitioned to, when a transition is pending */
+    unsigned int requested_state;
+
+    /* Whether a transition is waiting for the SYSC interrupt */
+    bool transition_pending;
 };
 
 /* Module context */
@@ -51,12 +57,34 @@ struct rcar_sysc_ctx {
 
     /* Log API */
     struct mod_log_api *log_api;
+
+    /* Module configuration data, NULL when not provided */
+    const struct mod_rcar_pd_sysc_module_config *config;
+
+    /* Number of power domains */
+    unsigned int pd_count;
 };
 
 /*!
  * @endcond
  */
 
+/*!
+ * \brief Module configuration data.
+ */
+struct mod_rcar_pd_sysc_module_config {
+    /*!
+     * \brief SYSC interrupt number.
+     *
+     * \details When set, power domain transitions complete on the SYSC
+     *      interrupt and are reported through
+     *      ::mod_pd_driver_input_api::report_power_state_transition. When
+     *      ::FWK_INTERRUPT_NONE, or when no module configuration is provided,
+     *      the driver polls the SYSC for completion.
+     */
+    unsigned int irq;
+};
+
 /*!
  * \brief Configuration data of a power domain of the SYSC module.
  */
@@ -13,12 +13,15 @@
 
 #include <fwk_assert.h>
 #include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_log.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_status.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /*
@@ -26,6 +29,63 @@
  */
 static struct rcar_sysc_ctx rcar_sysc_ctx;
 
+/*
+ * Helper functions
+ */
+static bool sysc_irq_is_used(void)
+{
+    return (rcar_sysc_ctx.config != NULL) &&
+        (rcar_sysc_ctx.config->irq != FWK_INTERRUPT_NONE);
+}
+
+/*
+ * Start a transition and return without waiting for its completion. The
+ * transition is reported by the SYSC interrupt handler.
+ */
+static int pd_set_state_async(
+    struct rcar_sysc_pd_ctx *pd_ctx,
+    unsigned int state)
+{
+    int ret;
+
+    if ((state != MOD_PD_STATE_ON) && (state != MOD_PD_STATE_OFF)) {
+        FWK_LOG_ERR("[PD] Requested power state (%i) is not supported.", state);
+        return FWK_E_PARAM;
+    }
+
+    if (pd_ctx->transition_pending)
+        return FWK_E_BUSY;
+
+    pd_ctx->requested_state = state;
+    pd_ctx->transition_pending = true;
+
+    ret = rcar_sysc_power_start(pd_ctx, state == MOD_PD_STATE_ON, true);
+    if (ret != FWK_SUCCESS)
+        pd_ctx->transition_pending = false;
+
+    return ret;
+}
+
+static void sysc_isr(void)
+{
+    struct rcar_sysc_pd_ctx *pd_ctx;
+    unsigned int pd_idx;
+
+    for (pd_idx = 0; pd_idx < rcar_sysc_ctx.pd_count; pd_idx++) {
+        pd_ctx = &rcar_sysc_ctx.pd_ctx_table[pd_idx];
+
+        if (!pd_ctx->transition_pending || !rcar_sysc_power_done(pd_ctx))
+            continue;
+
+        rcar_sysc_power_finish(
+            pd_ctx, pd_ctx->requested_state == MOD_PD_STATE_ON);
+        pd_ctx->transition_pending = false;
+
+        pd_ctx->pd_driver_input_api->report_power_state_transition(
+            pd_ctx->bound_id, pd_ctx->requested_state);
+    }
+}
+
 /*
  * Power domain driver interface
  */
@@ -39,6 +99,9 @@ static int pd_set_state(fwk_id_t pd_id, unsigned int state)
     if (pd_ctx->config->always_on)
         return FWK_E_SUPPORT;
 
+    if (sysc_irq_is_used())
+        return pd_set_state_async(pd_ctx, state);
+
     switch (state) {
     case MOD_PD_STATE_ON:
         ret = rcar_sysc_power(pd_ctx, true);
@@ -88,13 +151,16 @@ static const struct mod_pd_driver_api pd_driver = {
 static int rcar_sysc_mod_init(
     fwk_id_t module_id,
     unsigned int pd_count,
-    const void *unused)
+    const void *data)
 {
     rcar_sysc_ctx.pd_ctx_table =
         fwk_mm_calloc(pd_count, sizeof(struct rcar_sysc_pd_ctx));
     if (rcar_sysc_ctx.pd_ctx_table == NULL)
         return FWK_E_NOMEM;
 
+    rcar_sysc_ctx.pd_count = pd_count;
+    rcar_sysc_ctx.config = data;
+
     return FWK_SUCCESS;
 }
 
@@ -211,6 +277,20 @@ static int rcar_sysc_process_bind_request(
     return FWK_SUCCESS;
 }
 
+static int rcar_sysc_start(fwk_id_t id)
+{
+    int status;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE) || !sysc_irq_is_used())
+        return FWK_SUCCESS;
+
+    status = fwk_interrupt_set_isr(rcar_sysc_ctx.config->irq, sysc_isr);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_interrupt_enable(rcar_sysc_ctx.config->irq);
+}
+
 const struct fwk_module module_rcar_pd_sysc = {
     .name = "RCAR_PD_SYSC",
     .type = FWK_MODULE_TYPE_DRIVER,
@@ -218,5 +298,6 @@ const struct fwk_module module_rcar_pd_sysc = {
     .init = rcar_sysc_mod_init,
     .element_init = rcar_sysc_pd_init,
     .bind = rcar_sysc_bind,
+    .start = rcar_sysc_start,
     .process_bind_request = rcar_sysc_process_bind_request,
 };
@@ -50,7 +50,7 @@ static int rcar_sysc_pwr_on_off(struct rcar_sysc_pd_ctx *pd_ctx, bool on)
     return 0;
 }
 
-int rcar_sysc_power(struct rcar_sysc_pd_ctx *pd_ctx, bool on)
+int rcar_sysc_power_start(struct rcar_sysc_pd_ctx *pd_ctx, bool on, bool irq)
 {
     unsigned int isr_mask = BIT_SHIFT(pd_ctx->config->isr_bit);
     unsigned int chan_mask = BIT_SHIFT(pd_ctx->config->chan_bit);
@@ -61,7 +61,11 @@ int rcar_sysc_power(struct rcar_sysc_pd_ctx *pd_ctx, bool on)
 
     syscimr = mmio_read_32(SYSC_BASE_ADDR + SYSCIMR);
     syscier = mmio_read_32(SYSC_BASE_ADDR + SYSCIER);
-    mmio_write_32((SYSC_BASE_ADDR + SYSCIMR), (syscimr | isr_mask));
+    if (irq)
+        syscimr &= ~isr_mask;
+    else
+        syscimr |= isr_mask;
+    mmio_write_32((SYSC_BASE_ADDR + SYSCIMR), syscimr);
     mmio_write_32((SYSC_BASE_ADDR + SYSCIER), (syscier | isr_mask));
     mmio_write_32((SYSC_BASE_ADDR + SYSCISCR), isr_mask);
 
@@ -69,7 +73,7 @@ int rcar_sysc_power(struct rcar_sysc_pd_ctx *pd_ctx, bool on)
     for (k = 0; k < PWRER_RETRIES; k++) {
         ret = rcar_sysc_pwr_on_off(pd_ctx, on);
         if (ret)
-            return ret;
+            break;
 
         status = mmio_read_32(
             SYSC_BASE_ADDR + pd_ctx->config->chan_offs + PWRER_OFFS);
@@ -81,11 +85,50 @@ int rcar_sysc_power(struct rcar_sysc_pd_ctx *pd_ctx, bool on)
     }
 
     if (k == PWRER_RETRIES)
-        return FWK_E_BUSY;
+        ret = FWK_E_BUSY;
+
+    if (ret && irq) {
+        /* No completion will be signalled, mask the interrupt again */
+        mmio_write_32((SYSC_BASE_ADDR + SYSCIMR), (syscimr | isr_mask));
+    }
+
+    return ret;
+}
+
+bool rcar_sysc_power_done(struct rcar_sysc_pd_ctx *pd_ctx)
+{
+    unsigned int isr_mask = BIT_SHIFT(pd_ctx->config->isr_bit);
+
+    return (mmio_read_32(SYSC_BASE_ADDR + SYSCISR) & isr_mask) != 0;
+}
+
+void rcar_sysc_power_finish(struct rcar_sysc_pd_ctx *pd_ctx, bool on)
+{
+    unsigned int isr_mask = BIT_SHIFT(pd_ctx->config->isr_bit);
+    uint32_t syscimr;
+
+    syscimr = mmio_read_32(SYSC_BASE_ADDR + SYSCIMR);
+    mmio_write_32((SYSC_BASE_ADDR + SYSCIMR), (syscimr | isr_mask));
+    mmio_write_32((SYSC_BASE_ADDR + SYSCISCR), isr_mask);
+
+    if (on)
+        pd_ctx->current_state = MOD_PD_STATE_ON;
+    else
+        pd_ctx->current_state = MOD_PD_STATE_OFF;
+}
+
+int rcar_sysc_power(struct rcar_sysc_pd_ctx *pd_ctx, bool on)
+{
+    int ret;
+    int k;
+
+    ret = rcar_sysc_power_start(pd_ctx, on, false);
+    if (ret)
+        return ret;
 
     /* Wait until the power shutoff or resume request has completed * */
     for (k = 0; k < SYSCISR_RETRIES; k++) {
-        if (mmio_read_32(SYSC_BASE_ADDR + SYSCISR) & isr_mask)
+        if (rcar_sysc_power_done(pd_ctx))
             break;
         udelay(SYSCISR_DELAY_US);
     }
@@ -94,12 +137,7 @@ int rcar_sysc_power(struct rcar_sysc_pd_ctx *pd_ctx, bool on)
         ret = FWK_E_BUSY;
     }
 
-    mmio_write_32((SYSC_BASE_ADDR + SYSCISCR), isr_mask);
-
-    if (on)
-        pd_ctx->current_state = MOD_PD_STATE_ON;
-    else
-        pd_ctx->current_state = MOD_PD_STATE_OFF;
+    rcar_sysc_power_finish(pd_ctx, on);
 
     return ret;
 }
@@ -61,6 +61,9 @@
  * Interface
  */
 int rcar_sysc_power(struct rcar_sysc_pd_ctx *pd_ctx, bool on);
+int rcar_sysc_power_start(struct rcar_sysc_pd_ctx *pd_ctx, bool on, bool irq);
+bool rcar_sysc_power_done(struct rcar_sysc_pd_ctx *pd_ctx);
+void rcar_sysc_power_finish(struct rcar_sysc_pd_ctx *pd_ctx, bool on);
 int rcar_sysc_power_get(struct rcar_sysc_pd_ctx *pd_ctx, unsigned int *statee);
 
 /*!
@@ -10,6 +10,9 @@ BS_FIRMWARE_HAS_MULTITHREADING := yes
 BS_FIRMWARE_HAS_NOTIFICATION := yes
 BS_FIRMWARE_HAS_FAST_CHANNELS := yes
 
+BS_FIRMWARE_MODULE_HEADERS_ONLY := \
+    cmn_core
+
 BS_FIRMWARE_MODULES := \
     armv7m_mpu \
     apremap \
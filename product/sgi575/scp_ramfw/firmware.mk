@@ -14,7 +14,8 @@ BS_FIRMWARE_HAS_NOTIFICATION := yes
 BS_FIRMWARE_HAS_RESOURCE_PERMISSIONS := yes
 BS_FIRMWARE_USE_NEWLIB_NANO_SPECS := no
 
-BS_FIRMWARE_MODULE_HEADERS_ONLY :=
+BS_FIRMWARE_MODULE_HEADERS_ONLY := \
+    cmn_core
 
 BS_FIRMWARE_MODULES := \
     armv7m_mpu \
@@ -198,6 +198,8 @@
 
 #define CONFIG_SCB_USE_4BYTE_MODE
 
+#define CONFIG_SCB_USE_QUAD_IO_XIP
+
 #define CONFIG_SCB_SMMU_PAGE_TABLE_BASE_ADDR UINT32_C(0xA4040000)
 
 #define CONFIG_SOC_NORTH_SMMU_REG_BASE UINT32_C(0x78280000)
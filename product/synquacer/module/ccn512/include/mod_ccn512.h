@@ -96,6 +96,19 @@ typedef struct {
      */
 } ccn512_reg_t;
 
+/*!
+ * \brief Number of QoS regulated ports.
+ *
+ * \details Each crosspoint has two device ports. The port of device `d` of
+ *      crosspoint `n` has the index `2 * n + d`.
+ */
+#define MOD_CCN512_QOS_PORT_COUNT 36
+
+/*!
+ * \brief Highest QoS priority of a port.
+ */
+#define MOD_CCN512_QOS_PRIORITY_MAX 0xF
+
 /*!
  * \brief APIs to configure ccn512.
  */
@@ -107,6 +120,35 @@ struct mod_ccn512_api {
      *
      */
     void (*ccn512_exit)(void);
+
+    /*!
+     * \brief Get the QoS priority of a port.
+     *
+     * \param port Index of the port.
+     * \param[out] priority QoS priority of the port.
+     *
+     * \retval ::FWK_SUCCESS The priority was returned.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_SUPPORT The QoS of the port is not regulated.
+     */
+    int (*get_qos_priority)(unsigned int port, unsigned int *priority);
+
+    /*!
+     * \brief Set the QoS priority of a port.
+     *
+     * \details Only the ports whose QoS is regulated since boot can be
+     *      reprogrammed, as the regulation must not be enabled while the port
+     *      has transactions in flight.
+     *
+     * \param port Index of the port.
+     * \param priority QoS priority of the port, up to
+     *      ::MOD_CCN512_QOS_PRIORITY_MAX.
+     *
+     * \retval ::FWK_SUCCESS The priority was set.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     * \retval ::FWK_E_SUPPORT The QoS of the port is not regulated.
+     */
+    int (*set_qos_priority)(unsigned int port, unsigned int priority);
 };
 
 /*!
@@ -30,6 +30,10 @@
 #define SNF_MP_ID_DMC0 0x8ULL
 #define SNF_MP_ID_DMC1 0x1AULL
 
+#define QOS_CONTROL_ENABLE UINT64_C(0x4)
+#define QOS_CONTROL_PRIORITY_POS 16
+#define QOS_CONTROL_PRIORITY_MASK (UINT64_C(0xF) << QOS_CONTROL_PRIORITY_POS)
+
 static void ccn512_qos_init(ccn512_reg_t *ccn512)
 {
     /*
@@ -164,8 +168,72 @@ static int ccn512_config(ccn512_reg_t *ccn512)
     return FWK_SUCCESS;
 }
 
+static volatile uint64_t *get_qos_control(unsigned int port)
+{
+    const struct mod_ccn512_module_config *module_config;
+    ccn5xx_xp_reg_t *xp;
+
+    module_config = fwk_module_get_data(fwk_module_id_ccn512);
+    fwk_assert(module_config != NULL);
+
+    /* The crosspoints are contiguous in the memory map */
+    xp = &module_config->reg_base->XP_ID_0 + (port / 2);
+
+    return ((port % 2) == 0) ? &xp->DEV0_QOS_CONTROL : &xp->DEV1_QOS_CONTROL;
+}
+
+static int ccn512_get_qos_priority(unsigned int port, unsigned int *priority)
+{
+    uint64_t control;
+
+    if ((port >= MOD_CCN512_QOS_PORT_COUNT) || (priority == NULL))
+        return FWK_E_PARAM;
+
+    control = *get_qos_control(port);
+    if ((control & QOS_CONTROL_ENABLE) == 0)
+        return FWK_E_SUPPORT;
+
+    *priority = (unsigned int)((control & QOS_CONTROL_PRIORITY_MASK) >>
+                               QOS_CONTROL_PRIORITY_POS);
+
+    return FWK_SUCCESS;
+}
+
+static int ccn512_set_qos_priority(unsigned int port, unsigned int priority)
+{
+    volatile uint64_t *qos_control;
+    uint64_t control;
+
+    if ((port >= MOD_CCN512_QOS_PORT_COUNT) ||
+        (priority > MOD_CCN512_QOS_PRIORITY_MAX))
+        return FWK_E_PARAM;
+
+    qos_control = get_qos_control(port);
+
+    /*
+     * The regulation of the ports is only enabled at boot, see
+     * ccn512_qos_init(), so only the priority of the regulated ports is
+     * changed.
+     */
+    control = *qos_control;
+    if ((control & QOS_CONTROL_ENABLE) == 0)
+        return FWK_E_SUPPORT;
+
+    *qos_control = (control & ~QOS_CONTROL_PRIORITY_MASK) |
+        ((uint64_t)priority << QOS_CONTROL_PRIORITY_POS);
+
+    /* Wait for write operations to finish. */
+    __DMB();
+
+    FWK_LOG_INFO("[CCN512] Port %u QoS priority set to %u.", port, priority);
+
+    return FWK_SUCCESS;
+}
+
 static struct mod_ccn512_api module_api = {
     .ccn512_exit = fw_ccn512_exit,
+    .get_qos_priority = ccn512_get_qos_priority,
+    .set_qos_priority = ccn512_set_qos_priority,
 };
 
 /* Framework API */
@@ -26,6 +26,8 @@ typedef enum {
     HSSPI_EN_STARTUP_COMMAND_READ_4B = 0x13, /* 4-BYTE READ */
     HSSPI_EN_STARTUP_COMMAND_DOFR_4B = 0x3C, /* 4-BYTE DUAL OUTPUT FAST READ */
     HSSPI_EN_STARTUP_COMMAND_QOFR_4B = 0x6C, /* 4-BYTE QUAD OUTPUT FAST READ */
+    HSSPI_EN_STARTUP_COMMAND_QIOFR = 0xEB, /* QUAD I/O FAST READ */
+    HSSPI_EN_STARTUP_COMMAND_QIOFR_4B = 0xEC, /* 4-BYTE QUAD I/O FAST READ */
     HSSPI_EN_STARTUP_COMMAND_WEN = 0x06, /* WRITE ENABLE */
     HSSPI_EN_STARTUP_COMMAND_ENTER_4B = 0xB7, /* ENTER 4-BYTE MODE */
 } HSSPI_EN_STARTUP_COMMAND_t;
@@ -43,6 +45,7 @@ typedef void (*HSSPI_FUNC_INIT)(volatile REG_ST_HSSPI_t *, volatile void *);
 typedef struct {
     HSSPI_EN_JEDEC_MID_t MID;
     HSSPI_FUNC_INIT FUNC;
+    int XIP_MODE_BITS;
 } HSSPI_ST_INIT_t;
 
 void hsspi_command_switch(
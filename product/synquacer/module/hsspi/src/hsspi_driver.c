@@ -226,6 +226,97 @@ static void hsspi_quad_output_fast_read(volatile REG_ST_HSSPI_t *reg_hsspi)
 #endif /* CONFIG_SCB_USE_4BYTE_MODE */
 }
 
+#ifdef CONFIG_SCB_USE_QUAD_IO_XIP
+/* Mode bits of the continuous read in progress, -1 if there is none */
+static int m_nXipModeBits = -1;
+
+/*
+ * Quad I/O Fast Read: the address, the mode bits and the dummy cycles are all
+ * transferred on four lines. When the flash is in continuous read mode the
+ * command is left out, which saves 8 cycles on every access.
+ */
+static void hsspi_quad_io_fast_read(
+    volatile REG_ST_HSSPI_t *reg_hsspi,
+    int mode_bits,
+    int with_command)
+{
+    uint16_t awcCommandList[8];
+    int nIndex = 0;
+
+    if (with_command) {
+        /* COMMAND */
+        awcCommandList[nIndex++] = MAKE_CSDC(0x00, 0, HSSPI_EN_TRP_SINGLE, 0);
+    }
+#    ifdef CONFIG_SCB_USE_4BYTE_MODE
+    /* ADDR[31:24] */
+    awcCommandList[nIndex++] = MAKE_CSDC(0x03, 0, HSSPI_EN_TRP_QUAD, 1);
+#    endif /* CONFIG_SCB_USE_4BYTE_MODE */
+    /* ADDR[23:16] */
+    awcCommandList[nIndex++] = MAKE_CSDC(0x02, 0, HSSPI_EN_TRP_QUAD, 1);
+    /* ADDR[15:08] */
+    awcCommandList[nIndex++] = MAKE_CSDC(0x01, 0, HSSPI_EN_TRP_QUAD, 1);
+    /* ADDR[07:00] */
+    awcCommandList[nIndex++] = MAKE_CSDC(0x00, 0, HSSPI_EN_TRP_QUAD, 1);
+    /* MODE BITS */
+    awcCommandList[nIndex++] = MAKE_CSDC(mode_bits, 0, HSSPI_EN_TRP_QUAD, 0);
+    /* DUMMY CYCLE x2, twice */
+    awcCommandList[nIndex++] = MAKE_CSDC(0x04, 0, HSSPI_EN_TRP_QUAD, 1);
+    awcCommandList[nIndex++] = MAKE_CSDC(0x04, 0, HSSPI_EN_TRP_QUAD, 1);
+
+    while (nIndex < 8) {
+        /* EndOfList */
+        awcCommandList[nIndex++] = MAKE_CSDC(0x07, 0, HSSPI_EN_TRP_MBM, 1);
+    }
+
+#    ifdef CONFIG_SCB_USE_4BYTE_MODE
+    hsspi_read_command_sequence(
+        reg_hsspi,
+        awcCommandList,
+        with_command ? HSSPI_EN_STARTUP_COMMAND_QIOFR_4B : -1);
+#    else /* CONFIG_SCB_USE_4BYTE_MODE */
+    hsspi_read_command_sequence(
+        reg_hsspi,
+        awcCommandList,
+        with_command ? HSSPI_EN_STARTUP_COMMAND_QIOFR : -1);
+#    endif /* CONFIG_SCB_USE_4BYTE_MODE */
+}
+
+/*
+ * Put the flash in continuous read mode: a first read carries the command and
+ * the mode bits requesting the mode, the following ones carry neither the
+ * command nor any change of mode.
+ */
+static void hsspi_enter_xip(
+    volatile REG_ST_HSSPI_t *reg_hsspi,
+    volatile void *mem_hsspi,
+    int mode_bits)
+{
+    hsspi_quad_io_fast_read(reg_hsspi, mode_bits, 1);
+    (void)MEM_HSSPI_BYTE(mem_hsspi)[0];
+
+    hsspi_quad_io_fast_read(reg_hsspi, mode_bits, 0);
+    m_nXipModeBits = mode_bits;
+}
+
+/*
+ * Take the flash out of continuous read mode with a last read whose mode bits
+ * do not request the mode, so that it accepts commands again.
+ */
+static void hsspi_exit_xip(
+    volatile REG_ST_HSSPI_t *reg_hsspi,
+    volatile void *mem_hsspi)
+{
+    if (m_nXipModeBits < 0)
+        return;
+
+    hsspi_quad_io_fast_read(reg_hsspi, 0x00, 0);
+    (void)MEM_HSSPI_BYTE(mem_hsspi)[0];
+
+    hsspi_quad_io_fast_read(reg_hsspi, 0x00, 1);
+    m_nXipModeBits = -1;
+}
+#endif /* CONFIG_SCB_USE_QUAD_IO_XIP */
+
 static void hsspi_wait_status_register_for_wip(
     volatile REG_ST_HSSPI_t *reg_hsspi,
     volatile void *mem_hsspi)
@@ -432,18 +523,23 @@ static void hsspi_enter_to_quad_for_macronix(
     hsspi_wait_status_register_for_wip(reg_hsspi, mem_hsspi);
 }
 
-static int hsspi_enter_to_quad_by_jedec_id(
+/*
+ * Mode bits of the Quad I/O Fast Read requesting the continuous read mode,
+ * -1 if the flash is not used in that mode.
+ */
+static const HSSPI_ST_INIT_t m_astcHsspiInitTable[] = {
+    { HSSPI_EN_JEDEC_MID_SPANSION, hsspi_enter_to_quad_for_spansion, 0xA0 },
+    { HSSPI_EN_JEDEC_MID_MICRON, hsspi_enter_to_quad_for_micron, -1 },
+    { HSSPI_EN_JEDEC_MID_MACRONIX, hsspi_enter_to_quad_for_macronix, 0xA5 },
+    { HSSPI_EN_JEDEC_MID_WINBOND, hsspi_enter_to_quad_for_winbond, 0x20 },
+    { HSSPI_EN_JEDEC_MID_UNKNOWN, NULL, -1 }
+};
+
+static const HSSPI_ST_INIT_t *hsspi_enter_to_quad_by_jedec_id(
     volatile REG_ST_HSSPI_t *reg_hsspi,
     volatile void *mem_hsspi,
     int nJedecMID)
 {
-    static const HSSPI_ST_INIT_t m_astcHsspiInitTable[] = {
-        { HSSPI_EN_JEDEC_MID_SPANSION, hsspi_enter_to_quad_for_spansion },
-        { HSSPI_EN_JEDEC_MID_MICRON, hsspi_enter_to_quad_for_micron },
-        { HSSPI_EN_JEDEC_MID_MACRONIX, hsspi_enter_to_quad_for_macronix },
-        { HSSPI_EN_JEDEC_MID_WINBOND, hsspi_enter_to_quad_for_winbond },
-        { HSSPI_EN_JEDEC_MID_UNKNOWN, NULL }
-    };
     const HSSPI_ST_INIT_t *pstcIndex;
 
     for (pstcIndex = m_astcHsspiInitTable;
@@ -456,7 +552,7 @@ static int hsspi_enter_to_quad_by_jedec_id(
         }
     }
 
-    return pstcIndex->MID;
+    return pstcIndex;
 }
 
 static void hsspi_software_reset(
@@ -522,7 +618,7 @@ void hsspi_command_switch(
     HSSPI_UN_PCC_t unPCC;
     HSSPI_UN_CSCFG_t unCSCFG;
 
-    int known_jedec_id;
+    const HSSPI_ST_INIT_t *pstcFlash;
 
     hsspi_stop(reg_hsspi, clk_sel, syncon);
 
@@ -549,10 +645,10 @@ void hsspi_command_switch(
         m_abyJEDEC_ID[1],
         m_abyJEDEC_ID[2]);
 
-    known_jedec_id =
+    pstcFlash =
         hsspi_enter_to_quad_by_jedec_id(reg_hsspi, mem_hsspi, m_abyJEDEC_ID[0]);
 
-    if (known_jedec_id < 0) {
+    if (pstcFlash->MID == HSSPI_EN_JEDEC_MID_UNKNOWN) {
         FWK_LOG_INFO(
             "[HS-SPI] Unknown manufacturer ID:%02x,"
             " default to Dual-Output-Fast-Read mode",
@@ -592,6 +688,18 @@ void hsspi_command_switch(
     (*reg_hsspi).PCC[0].DATA = unPCC.DATA;
 
     hsspi_csen(reg_hsspi, clk_sel, syncon);
+
+#ifdef CONFIG_SCB_USE_QUAD_IO_XIP
+    /*
+     * Switch to continuous reads once the flash no longer needs commands, as
+     * it takes any command for the address of the next read in that mode.
+     */
+    if (pstcFlash->XIP_MODE_BITS >= 0) {
+        FWK_LOG_INFO("[HS-SPI] Configuring Quad-IO continuous read mode");
+
+        hsspi_enter_xip(reg_hsspi, mem_hsspi, pstcFlash->XIP_MODE_BITS);
+    }
+#endif /* CONFIG_SCB_USE_QUAD_IO_XIP */
 }
 
 void hsspi_set_window_size(
@@ -651,6 +759,11 @@ void hsspi_exit(
     HSSPI_UN_PCC_t unPCC;
     HSSPI_UN_CSCFG_t unCSCFG;
 
+#ifdef CONFIG_SCB_USE_QUAD_IO_XIP
+    /* The flash must accept the reset commands below */
+    hsspi_exit_xip(reg_hsspi, mem_hsspi);
+#endif /* CONFIG_SCB_USE_QUAD_IO_XIP */
+
     hsspi_stop(reg_hsspi, clk_sel, syncon);
 
     unCSCFG.DATA = (*reg_hsspi).CSCFG.DATA;
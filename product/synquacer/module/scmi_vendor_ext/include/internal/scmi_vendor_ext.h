@@ -41,6 +41,10 @@
 enum scmi_vendor_ext_command_id {
     /*! Retrieve DRAM mapping information */
     SCMI_VENDOR_EXT_MEMORY_INFO_GET = 0x003,
+    /*! Get the QoS priority of a CCN512 port */
+    SCMI_VENDOR_EXT_QOS_PRIORITY_GET = 0x004,
+    /*! Set the QoS priority of a CCN512 port */
+    SCMI_VENDOR_EXT_QOS_PRIORITY_SET = 0x005,
 };
 
 /*!
@@ -98,6 +102,46 @@ struct scmi_vendor_ext_memory_info_get_resp {
     struct synquacer_memory_info meminfo;
 };
 
+/*
+ * QoS priority get and set structures
+ */
+
+/*!
+ * \brief QoS priority get request.
+ */
+struct FWK_PACKED scmi_vendor_ext_qos_priority_get_a2p {
+    /*! index of the CCN512 port. */
+    uint32_t port_id;
+};
+
+/*!
+ * \brief QoS priority get response.
+ */
+struct FWK_PACKED scmi_vendor_ext_qos_priority_get_p2a {
+    /*! SCMI status. */
+    int32_t status;
+    /*! QoS priority of the port. */
+    uint32_t priority;
+};
+
+/*!
+ * \brief QoS priority set request.
+ */
+struct FWK_PACKED scmi_vendor_ext_qos_priority_set_a2p {
+    /*! index of the CCN512 port. */
+    uint32_t port_id;
+    /*! QoS priority of the port. */
+    uint32_t priority;
+};
+
+/*!
+ * \brief QoS priority set response.
+ */
+struct FWK_PACKED scmi_vendor_ext_qos_priority_set_p2a {
+    /*! SCMI status. */
+    int32_t status;
+};
+
 /*!
  * \}
  */
@@ -11,6 +11,7 @@
 
 #include <internal/scmi_vendor_ext.h>
 
+#include <mod_ccn512.h>
 #include <mod_scmi.h>
 
 #include <fwk_assert.h>
@@ -28,6 +29,7 @@
 struct scmi_vendor_ext_ctx {
     const struct mod_scmi_from_protocol_api *scmi_api;
     const struct mod_vendor_ext_api *vendor_ext_api;
+    const struct mod_ccn512_api *ccn512_api;
     uint32_t vendor_ext_count;
 };
 
@@ -43,6 +45,12 @@ static int scmi_vendor_ext_protocol_msg_attributes_handler(
 static int scmi_vendor_ext_protocol_memory_info_get_handler(
     fwk_id_t service_id,
     const uint32_t *payload);
+static int scmi_vendor_ext_protocol_qos_priority_get_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_vendor_ext_protocol_qos_priority_set_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
 
 /*
  * Internal variables.
@@ -57,6 +65,10 @@ static int (*handler_table[])(fwk_id_t, const uint32_t *) = {
         scmi_vendor_ext_protocol_msg_attributes_handler,
     [SCMI_VENDOR_EXT_MEMORY_INFO_GET] =
         scmi_vendor_ext_protocol_memory_info_get_handler,
+    [SCMI_VENDOR_EXT_QOS_PRIORITY_GET] =
+        scmi_vendor_ext_protocol_qos_priority_get_handler,
+    [SCMI_VENDOR_EXT_QOS_PRIORITY_SET] =
+        scmi_vendor_ext_protocol_qos_priority_set_handler,
 };
 
 static unsigned int payload_size_table[] = {
@@ -65,6 +77,10 @@ static unsigned int payload_size_table[] = {
     [MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
         sizeof(struct scmi_protocol_message_attributes_a2p),
     [SCMI_VENDOR_EXT_MEMORY_INFO_GET] = 0,
+    [SCMI_VENDOR_EXT_QOS_PRIORITY_GET] =
+        sizeof(struct scmi_vendor_ext_qos_priority_get_a2p),
+    [SCMI_VENDOR_EXT_QOS_PRIORITY_SET] =
+        sizeof(struct scmi_vendor_ext_qos_priority_set_a2p),
 };
 
 /*
@@ -208,6 +224,71 @@ static int scmi_vendor_ext_protocol_memory_info_get_handler(
     return FWK_SUCCESS;
 }
 
+static int32_t qos_status_to_scmi(int status)
+{
+    switch (status) {
+    case FWK_SUCCESS:
+        return SCMI_SUCCESS;
+
+    case FWK_E_PARAM:
+        return SCMI_INVALID_PARAMETERS;
+
+    case FWK_E_SUPPORT:
+        return SCMI_NOT_SUPPORTED;
+
+    default:
+        return SCMI_GENERIC_ERROR;
+    }
+}
+
+static int scmi_vendor_ext_protocol_qos_priority_get_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    const struct scmi_vendor_ext_qos_priority_get_a2p *parameters;
+    struct scmi_vendor_ext_qos_priority_get_p2a return_values = { 0 };
+    unsigned int priority;
+    int status;
+
+    parameters = (const struct scmi_vendor_ext_qos_priority_get_a2p *)payload;
+
+    status = scmi_vendor_ext_ctx.ccn512_api->get_qos_priority(
+        parameters->port_id, &priority);
+
+    return_values.status = qos_status_to_scmi(status);
+    if (status == FWK_SUCCESS)
+        return_values.priority = priority;
+
+    scmi_vendor_ext_ctx.scmi_api->respond(
+        service_id,
+        &return_values,
+        (return_values.status == SCMI_SUCCESS) ? sizeof(return_values) :
+                                                 sizeof(return_values.status));
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_vendor_ext_protocol_qos_priority_set_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    const struct scmi_vendor_ext_qos_priority_set_a2p *parameters;
+    struct scmi_vendor_ext_qos_priority_set_p2a return_values;
+    int status;
+
+    parameters = (const struct scmi_vendor_ext_qos_priority_set_a2p *)payload;
+
+    status = scmi_vendor_ext_ctx.ccn512_api->set_qos_priority(
+        parameters->port_id, parameters->priority);
+
+    return_values.status = qos_status_to_scmi(status);
+
+    scmi_vendor_ext_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
 /*
  * SCMI module -> SCMI vendor_ext module interface
  */
@@ -295,6 +376,16 @@ static int scmi_vendor_ext_bind(fwk_id_t id, unsigned int round)
         return status;
     }
 
+    status = fwk_module_bind(
+        FWK_ID_MODULE(FWK_MODULE_IDX_CCN512),
+        FWK_ID_API(FWK_MODULE_IDX_CCN512, 0),
+        &scmi_vendor_ext_ctx.ccn512_api);
+    if (status != FWK_SUCCESS) {
+        /* Failed to bind to CCN512 module */
+        fwk_unexpected();
+        return status;
+    }
+
     return FWK_SUCCESS;
 }
 
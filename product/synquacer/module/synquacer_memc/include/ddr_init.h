@@ -41,6 +41,10 @@
 #define DDR_TRAINING_ON
 #define DDR_WAIT_TIMEOUT_US UINT32_C(1000000)
 
+/* t_refi_next values for the nominal and the doubled refresh rates */
+#define DDR_T_REFI_NORMAL UINT32_C(0x0009040F)
+#define DDR_T_REFI_2X UINT32_C(0x00090207)
+
 /**
  * Wait until BUSY_COND becomes false or timeouts.
  * Return from the caller function with ERR_CODE if timeout occurs.
@@ -63,5 +67,9 @@ extern int ddr_dual_ch_init_mp(void);
 extern int ddr_ch0_init_mp(void);
 extern int ddr_ch1_init_mp(void);
 extern uint8_t ddr_is_secure_dram_enabled(void);
+extern int ddr_update_power_control_mp(
+    REG_ST_DMC520 *REG_DMC520,
+    uint32_t low_power_control,
+    uint32_t t_refi);
 
 #endif /*DDR_INIT_H */
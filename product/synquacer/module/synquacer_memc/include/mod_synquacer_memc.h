@@ -24,10 +24,56 @@
  * \brief SynQuacer MEMC device driver
  *
  * \details This module implements a device driver for the memory controller
+ *      and manages the power of the DRAM at runtime: the controllers enter
+ *      power-down and self-refresh on their own after the idle intervals
+ *      configured, and the refresh rate is doubled while the DIMMs are hot.
  *
  * \{
  */
 
+/*!
+ * \brief Module configuration.
+ */
+struct mod_synquacer_memc_config {
+    /*!
+     * \brief Value of the low_power_control register of the controllers.
+     *
+     * \details Selects the automatic entry to power-down and self-refresh
+     *      and the idle intervals after which the controllers enter them.
+     */
+    uint32_t low_power_control;
+
+    /*!
+     * \brief Identifier of the sensor element reading the DIMM temperature.
+     *
+     * \details May be ::FWK_ID_NONE, in which case the refresh rate is left
+     *      nominal.
+     */
+    fwk_id_t sensor_id;
+
+    /*!
+     * \brief Identifier of the alarm for reading the temperature periodically.
+     */
+    fwk_id_t alarm_id;
+
+    /*!
+     * \brief The alarm interval in milliseconds.
+     */
+    unsigned int period_ms;
+
+    /*!
+     * \brief Temperature above which the refresh rate is doubled, in
+     *      millidegrees celsius.
+     */
+    uint64_t refresh_2x_threshold_mdc;
+
+    /*!
+     * \brief Temperature drop below the threshold, in millidegrees celsius,
+     *      for the refresh rate to go back to nominal.
+     */
+    uint64_t refresh_hysteresis_mdc;
+};
+
 /*!
  * \}
  */
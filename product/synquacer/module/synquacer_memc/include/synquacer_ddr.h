@@ -63,6 +63,7 @@
 #define SPD_STORE_ADDR (NONTRUSTED_RAM_BASE + SPD_STORE_AREA_OFFSET)
 
 void fw_ddr_init(void);
+int fw_ddr_set_power_control(uint32_t low_power_control, bool double_refresh);
 int fw_ddr_spd_param_check(void);
 bool fw_get_ddr4_sdram_ecc_available(void);
 uint8_t fw_get_used_memory_ch(void);
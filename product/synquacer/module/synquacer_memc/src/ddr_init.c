@@ -173,6 +173,34 @@ int ddr_ch0_init_mp(void)
     return 0;
 }
 
+/*
+ * Update the low power and refresh settings of an initialized controller.
+ * The controller goes through the CONFIG state for the update, holding the
+ * traffic for the time being.
+ */
+int ddr_update_power_control_mp(
+    REG_ST_DMC520 *REG_DMC520,
+    uint32_t low_power_control,
+    uint32_t t_refi)
+{
+    REG_DMC520->memc_cmd = 0x00000000;
+
+    ddr_wait(
+        (REG_DMC520->memc_status & 0x7) != 0x0, DDR_WAIT_TIMEOUT_US, 0x1005);
+
+    REG_DMC520->low_power_control_next = low_power_control;
+    REG_DMC520->t_refi_next = t_refi;
+    REG_DMC520->memc_status;
+    REG_DMC520->memc_cmd = 0x00000003;
+    REG_DMC520->memc_status;
+    REG_DMC520->memc_cmd = 0x00000004;
+
+    ddr_wait(
+        (REG_DMC520->memc_status & 0x7) != 0x3, DDR_WAIT_TIMEOUT_US, 0x1006);
+
+    return 0;
+}
+
 /* ch1 : DMC 1 + PHY 1 */
 int ddr_ch1_init_mp(void)
 {
@@ -322,7 +350,7 @@ int ddr_init_mc0_mp(REG_ST_DMC520 *REG_DMC520)
         (ddr_memory_type == UDIMM_8GBPERSLOT_1SLOTPERCH))
         REG_DMC520->rank_remap_control_next = 0xFEDC90BA;
 
-    REG_DMC520->t_refi_next = 0x0009040F;
+    REG_DMC520->t_refi_next = DDR_T_REFI_NORMAL;
     REG_DMC520->t_rfc_next = 0x0005D976;
     REG_DMC520->t_mrr_next = 0x00000001;
     REG_DMC520->t_mrw_next = 0x00180018;
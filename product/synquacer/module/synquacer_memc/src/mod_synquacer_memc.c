@@ -8,22 +8,125 @@
 #include "synquacer_ddr.h"
 
 #include <mod_synquacer_memc.h>
+#include <mod_timer.h>
 
+#ifdef BUILD_HAS_MOD_SENSOR
+#    include <mod_sensor.h>
+#endif
+
+#include <fwk_assert.h>
+#include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_log.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
+#include <fwk_thread.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+static struct synquacer_memc_ctx {
+    const struct mod_synquacer_memc_config *config;
+#ifdef BUILD_HAS_MOD_SENSOR
+    const struct mod_sensor_api *sensor_api;
+    const struct mod_timer_alarm_api *alarm_api;
+#endif
+
+    /* The refresh rate is currently doubled */
+    bool double_refresh;
+} ctx;
 
 const struct mod_f_i2c_api *f_i2c_api;
 static int synquacer_memc_config(void);
 
+static int synquacer_memc_set_power_control(bool double_refresh)
+{
+    int result;
+
+    result = fw_ddr_set_power_control(
+        ctx.config->low_power_control, double_refresh);
+    if (result != 0) {
+        FWK_LOG_ERR(
+            "[SYNQUACER MEMC] Power control update failed.(0x%x)", result);
+        return FWK_E_DEVICE;
+    }
+
+    ctx.double_refresh = double_refresh;
+
+    return FWK_SUCCESS;
+}
+
+#ifdef BUILD_HAS_MOD_SENSOR
+enum mod_synquacer_memc_event_idx {
+    MOD_SYNQUACER_MEMC_EVENT_IDX_TIMER,
+    MOD_SYNQUACER_MEMC_EVENT_IDX_COUNT,
+};
+
+static const fwk_id_t mod_synquacer_memc_event_id_timer = FWK_ID_EVENT_INIT(
+    FWK_MODULE_IDX_SYNQUACER_MEMC,
+    MOD_SYNQUACER_MEMC_EVENT_IDX_TIMER);
+
+static bool has_sensor(void)
+{
+    return fwk_id_is_type(ctx.config->sensor_id, FWK_ID_TYPE_ELEMENT);
+}
+
+static int synquacer_memc_check_temperature(uint64_t temperature)
+{
+    uint64_t threshold = ctx.config->refresh_2x_threshold_mdc;
+    bool double_refresh = ctx.double_refresh;
+
+    if (temperature > threshold)
+        double_refresh = true;
+    else if ((temperature + ctx.config->refresh_hysteresis_mdc) <= threshold)
+        double_refresh = false;
+
+    if (double_refresh == ctx.double_refresh)
+        return FWK_SUCCESS;
+
+    FWK_LOG_INFO(
+        "[SYNQUACER MEMC] %s refresh rate",
+        double_refresh ? "Doubled" : "Nominal");
+
+    return synquacer_memc_set_power_control(double_refresh);
+}
+
+/*
+ * Periodical alarm callback
+ */
+static void synquacer_memc_alarm_callback(uintptr_t param)
+{
+    int status;
+    struct fwk_event event = {
+        .source_id = fwk_module_id_synquacer_memc,
+        .target_id = fwk_module_id_synquacer_memc,
+        .id = mod_synquacer_memc_event_id_timer,
+    };
+
+    status = fwk_thread_put_event(&event);
+    fwk_assert(status == FWK_SUCCESS);
+}
+#endif
+
 /* Framework API */
 static int mod_synquacer_memc_init(
     fwk_id_t module_id,
     unsigned int element_count,
     const void *config)
 {
+    if (config == NULL)
+        return FWK_E_PARAM;
+
+    ctx.config = config;
+
+#ifdef BUILD_HAS_MOD_SENSOR
+    if (has_sensor() &&
+        (fwk_id_get_module_idx(ctx.config->sensor_id) !=
+         FWK_MODULE_IDX_SENSOR))
+        return FWK_E_DATA;
+#endif
+
     return FWK_SUCCESS;
 }
 
@@ -54,12 +157,43 @@ static int mod_synquacer_memc_bind(fwk_id_t id, unsigned int round)
     if (status != FWK_SUCCESS)
         return status;
 
+#ifdef BUILD_HAS_MOD_SENSOR
+    if (!has_sensor())
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(
+        ctx.config->alarm_id, MOD_TIMER_API_ID_ALARM, &ctx.alarm_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_module_bind(
+        ctx.config->sensor_id, mod_sensor_api_id_sensor, &ctx.sensor_api);
+    if (status != FWK_SUCCESS)
+        return status;
+#endif
+
     return FWK_SUCCESS;
 }
 
 static int mod_synquacer_memc_start(fwk_id_t id)
 {
-    synquacer_memc_config();
+    int status;
+
+    status = synquacer_memc_config();
+    if (status != FWK_SUCCESS)
+        return status;
+
+#ifdef BUILD_HAS_MOD_SENSOR
+    if (has_sensor()) {
+        return ctx.alarm_api->start(
+            ctx.config->alarm_id,
+            ctx.config->period_ms,
+            MOD_TIMER_ALARM_TYPE_PERIODIC,
+            synquacer_memc_alarm_callback,
+            0);
+    }
+#endif
+
     return FWK_SUCCESS;
 }
 
@@ -69,8 +203,41 @@ static int synquacer_memc_config(void)
 
     FWK_LOG_INFO("[SYNQUACER MEMC] DMC init done.");
 
-    return FWK_SUCCESS;
+    return synquacer_memc_set_power_control(false);
+}
+
+#ifdef BUILD_HAS_MOD_SENSOR
+static int mod_synquacer_memc_process_event(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    int status;
+    uint64_t value;
+    const struct mod_sensor_event_params *params;
+
+    /* Event from timer callback */
+    if (fwk_id_is_equal(event->id, mod_synquacer_memc_event_id_timer)) {
+        status = ctx.sensor_api->get_value(ctx.config->sensor_id, &value);
+        if (status == FWK_PENDING)
+            return FWK_SUCCESS;
+        if (status != FWK_SUCCESS)
+            return status;
+
+        return synquacer_memc_check_temperature(value);
+    }
+
+    /* Response event from sensor HAL */
+    if (fwk_id_is_equal(event->id, mod_sensor_event_id_read_request)) {
+        params = (const struct mod_sensor_event_params *)event->params;
+        if (params->status != FWK_SUCCESS)
+            return params->status;
+
+        return synquacer_memc_check_temperature(params->value);
+    }
+
+    return FWK_E_PARAM;
 }
+#endif
 
 const struct fwk_module module_synquacer_memc = {
     .name = "synquacer_memc",
@@ -80,5 +247,8 @@ const struct fwk_module module_synquacer_memc = {
     .bind = mod_synquacer_memc_bind,
     .start = mod_synquacer_memc_start,
     .api_count = 0,
-    .event_count = 0,
+#ifdef BUILD_HAS_MOD_SENSOR
+    .process_event = mod_synquacer_memc_process_event,
+    .event_count = MOD_SYNQUACER_MEMC_EVENT_IDX_COUNT,
+#endif
 };
@@ -133,6 +133,28 @@ void fw_ddr_init(void)
     store_spd_to_nssram();
 }
 
+int fw_ddr_set_power_control(uint32_t low_power_control, bool double_refresh)
+{
+    uint32_t t_refi = double_refresh ? DDR_T_REFI_2X : DDR_T_REFI_NORMAL;
+    int result;
+
+    if (spd_ddr_info.ddr_memory_used_ch & DDR_USE_CH0) {
+        result = ddr_update_power_control_mp(
+            (REG_ST_DMC520 *)REG_DMC520_0_BA, low_power_control, t_refi);
+        if (result != 0)
+            return result;
+    }
+
+    if (spd_ddr_info.ddr_memory_used_ch & DDR_USE_CH1) {
+        result = ddr_update_power_control_mp(
+            (REG_ST_DMC520 *)REG_DMC520_1_BA, low_power_control, t_refi);
+        if (result != 0)
+            return result;
+    }
+
+    return 0;
+}
+
 static void fw_ddr_change_freq(ddr_freq_t freq)
 {
     uint32_t value = 0;
@@ -5,9 +5,20 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <mod_synquacer_memc.h>
+
+#include <fwk_id.h>
 #include <fwk_module.h>
 
 #include <stddef.h>
 
 /* Configuration of the SynQuacerMEMC module. */
-const struct fwk_module_config config_synquacer_memc = { 0 };
+const struct fwk_module_config config_synquacer_memc = {
+    .data = &((struct mod_synquacer_memc_config){
+        /* Automatic power-down and self-refresh entry left disabled */
+        .low_power_control = 0x00000000,
+        /* No DIMM temperature sensor, the refresh rate stays nominal */
+        .sensor_id = FWK_ID_NONE_INIT,
+        .alarm_id = FWK_ID_NONE_INIT,
+    }),
+};
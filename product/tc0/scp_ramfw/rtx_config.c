@@ -10,6 +10,8 @@
 #include <rtx_lib.c>
 #include <rtx_os.h>
 
+#include <arch_tickless.h>
+
 #include <fwk_mm.h>
 
 #include <fmw_cmsis.h>
@@ -27,8 +29,18 @@ uint32_t SystemCoreClock = CLOCK_RATE_REFCLK;
  */
 __NO_RETURN void osRtxIdleThread(void *argument)
 {
-    while (true)
-        __WFI();
+    uint32_t ticks;
+
+    (void)argument;
+
+    /*
+     * The kernel tick is suppressed until the next kernel timeout, or until
+     * an interrupt wakes one of the framework threads.
+     */
+    while (true) {
+        ticks = osKernelSuspend();
+        osKernelResume(arch_tickless_sleep(ticks));
+    }
 }
 
 /*
@@ -36,7 +48,9 @@ __NO_RETURN void osRtxIdleThread(void *argument)
  */
 uint32_t osRtxErrorNotify(uint32_t code, void *object_id)
 {
-    osRtxIdleThread(object_id);
+    /* The kernel cannot be suspended from the error handler */
+    while (true)
+        __WFI();
 }
 
 uint32_t osRtxMemoryInit(void *mem, uint32_t size)
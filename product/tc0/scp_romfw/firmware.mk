@@ -11,6 +11,7 @@ BS_FIRMWARE_HAS_NOTIFICATION := yes
 BS_FIRMWARE_USE_NEWLIB_NANO_SPECS := yes
 
 BS_FIRMWARE_MODULE_HEADERS_ONLY := \
+    cmn_core \
     power_domain \
     timer
 
@@ -85,6 +85,7 @@ TARGET := $(BIN_DIR)/$(FIRMWARE)
 TARGET_BIN := $(TARGET).bin
 TARGET_ELF := $(TARGET).elf
 TARGET_SREC := $(TARGET).srec
+TARGET_LZ4 := $(TARGET).lz4
 
 ifeq ($(BS_LINKER),ARM)
     TARGET_GOAL := $(TARGET_BIN)
@@ -101,6 +102,10 @@ vpath %.S $(PRODUCT_DIR)/src
 
 goal: $(TARGET_GOAL)
 
+ifeq ($(BS_FIRMWARE_COMPRESS),yes)
+    goal: $(TARGET_LZ4)
+endif
+
 ifneq ($(BS_ARCH_CPU),host)
     ifeq ($(BS_LINKER),ARM)
         SCATTER_SRC = $(ARCH_DIR)/$(BS_ARCH_VENDOR)/$(BS_ARCH_ARCH)/src/arch.scatter.S
@@ -358,4 +363,14 @@ $(TARGET_BIN): $(TARGET_ELF) | $$(@D)/
 $(TARGET_SREC): $(TARGET_BIN)
 	$(call show-action,SREC,$@)
 	$(OBJCOPY) -O srec $(TARGET_ELF) $(basename $@).srec
+
+$(TARGET_LZ4): $(TARGET_BIN) $(TOOLS_DIR)/compress_image.py
+	$(call show-action,LZ4,$@)
+	$(TOOLS_DIR)/compress_image.py $< $@
+
+.PHONY: footprint
+footprint: $(TARGET_ELF) $(TOOLS_DIR)/size_report.py
+	$(TOOLS_DIR)/size_report.py $(TARGET).map \
+	    $(if $(HEAP_LOG),--heap-log $(HEAP_LOG)) \
+	    $(addprefix --budget ,$(BS_FIRMWARE_BUDGETS))
 endif
@@ -41,6 +41,12 @@ $(foreach api, \
           $($(DISABLED_APIS_LIST_NAME)), \
           $(eval DEFINES += BUILD_DISABLE_API_$(api)))
 
+# Define BUILD_MODULE_IDX in modules so their log messages can be filtered
+ifneq ($(filter module/%,$(LIB_BASE)),)
+    LIB_MODULE_IDX := FWK_MODULE_IDX_$(call to_upper,$(notdir $(LIB_BASE)))
+    DEFINES += BUILD_MODULE_IDX=$(LIB_MODULE_IDX)
+endif
+
 
 ifeq ($(BS_FIRMWARE_HAS_MULTITHREADING),yes)
     LIB_BASE := $(LIB_BASE)$(MULTHREADING_SUFFIX)
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Description:
+#     Compress a firmware binary into an image decompressed by the lz4 module.
+#     The image is made of a header (see mod_lz4.h) followed by a single LZ4
+#     block.
+#
+
+import argparse
+import struct
+import sys
+
+IMAGE_MAGIC = 0x345A4C53
+
+MIN_MATCH = 4
+MAX_OFFSET = 0xFFFF
+
+# The end of a block is made of literals only
+LAST_LITERALS = 5
+MATCH_FIND_LIMIT = 12
+
+HASH_LOG = 16
+
+
+def hash_sequence(sequence):
+    return ((sequence * 2654435761) & 0xFFFFFFFF) >> (32 - HASH_LOG)
+
+
+def encode_length(output, length):
+    while length >= 255:
+        output.append(255)
+        length -= 255
+    output.append(length)
+
+
+def emit_sequence(output, literals, offset, match_length):
+    literal_length = len(literals)
+    token = min(literal_length, 15) << 4
+    if offset is not None:
+        token |= min(match_length - MIN_MATCH, 15)
+
+    output.append(token)
+    if literal_length >= 15:
+        encode_length(output, literal_length - 15)
+    output += literals
+
+    if offset is not None:
+        output += struct.pack('<H', offset)
+        if match_length - MIN_MATCH >= 15:
+            encode_length(output, match_length - MIN_MATCH - 15)
+
+
+def compress_block(data):
+    output = bytearray()
+    table = {}
+    size = len(data)
+    match_limit = size - LAST_LITERALS
+    anchor = 0
+    position = 0
+
+    while position < size - MATCH_FIND_LIMIT:
+        sequence = struct.unpack_from('<I', data, position)[0]
+        key = hash_sequence(sequence)
+        candidate = table.get(key)
+        table[key] = position
+
+        if (candidate is None or position - candidate > MAX_OFFSET or
+                data[candidate:candidate + MIN_MATCH] !=
+                data[position:position + MIN_MATCH]):
+            position += 1
+            continue
+
+        # Extend the match backwards over the pending literals
+        while (position > anchor and candidate > 0 and
+               data[position - 1] == data[candidate - 1]):
+            position -= 1
+            candidate -= 1
+
+        length = MIN_MATCH
+        while (position + length < match_limit and
+               data[candidate + length] == data[position + length]):
+            length += 1
+
+        emit_sequence(output, data[anchor:position], position - candidate,
+                      length)
+        position += length
+        anchor = position
+
+    emit_sequence(output, data[anchor:], None, 0)
+
+    return bytes(output)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compress a firmware binary into an LZ4 image.')
+    parser.add_argument('input', help='Firmware binary')
+    parser.add_argument('output', help='Compressed image')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    block = compress_block(data)
+
+    with open(args.output, 'wb') as f:
+        f.write(struct.pack('<IIII', IMAGE_MAGIC, len(data), len(block), 0))
+        f.write(block)
+
+    print('{}: {} -> {} bytes'.format(args.output, len(data),
+                                       len(block) + 16))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
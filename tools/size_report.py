@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2021, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Description:
+#     Report the memory footprint of a firmware per module from its GNU linker
+#     map, optionally with the heap usage logged by the firmware at boot, and
+#     check it against memory budgets.
+#
+
+import argparse
+import re
+import sys
+
+KINDS = ['code', 'rodata', 'data', 'bss']
+
+# Input section name prefixes, by kind of memory
+SECTION_PREFIXES = {
+    'code': ['.text', '.init', '.fini', '.plt', '.glue_7', '.vectors'],
+    'rodata': ['.rodata', '.srodata', '.eh_frame', '.gcc_except_table',
+               '.ARM.exidx', '.ARM.extab'],
+    'data': ['.data', '.sdata', '.tdata', '.init_array', '.fini_array',
+             '.preinit_array', '.ctors', '.dtors', '.got'],
+    'bss': ['.bss', '.sbss', '.tbss', 'COMMON'],
+}
+
+# Kinds summed into the derived columns
+DERIVED_KINDS = {
+    'rom': ['code', 'rodata', 'data'],
+    'ram': ['data', 'bss'],
+}
+
+# Owners of the objects, from the path of their library or object file
+OWNER_PATTERNS = [
+    (re.compile(r'/module/([^/]+?)(?:_mt)?(?:_nt)?/'), None),
+    (re.compile(r'/(framework|arch|debugger)(?:_mt)?(?:_nt)?/'), None),
+    (re.compile(r'/obj/'), 'firmware'),
+]
+
+INPUT_SECTION = re.compile(
+    r'^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+INPUT_SECTION_NAME = re.compile(r'^ (\S+)$')
+INPUT_SECTION_TAIL = re.compile(
+    r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+
+HEAP_USAGE = re.compile(r'\[MM\] (.+): (\d+) bytes in (\d+) allocations')
+
+BUDGET = re.compile(r'^([^=]+)\.(code|rodata|data|bss|rom|ram|heap)=(\w+)$')
+
+
+def section_kind(name):
+    for kind, prefixes in SECTION_PREFIXES.items():
+        for prefix in prefixes:
+            if name == prefix or name.startswith(prefix + '.'):
+                return kind
+    return None
+
+
+def section_owner(path):
+    for pattern, owner in OWNER_PATTERNS:
+        match = pattern.search(path)
+        if match:
+            return owner if owner is not None else match.group(1)
+    return 'toolchain'
+
+
+def normalize(name):
+    return re.sub(r'[^a-z0-9]+', '_', name.lower()).strip('_')
+
+
+def parse_map(path):
+    sizes = {}
+    pending = None
+    in_memory_map = False
+
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip('\n')
+
+            if not in_memory_map:
+                in_memory_map = line.startswith('Linker script and memory map')
+                continue
+
+            section = None
+            match = INPUT_SECTION.match(line)
+            if match:
+                section = match.groups()
+            elif pending is not None:
+                match = INPUT_SECTION_TAIL.match(line)
+                if match:
+                    section = (pending,) + match.groups()
+
+            pending = None
+            if section is None:
+                match = INPUT_SECTION_NAME.match(line)
+                if match:
+                    pending = match.group(1)
+                continue
+
+            name, _, size, source = section
+            kind = section_kind(name)
+            if kind is None:
+                continue
+
+            owner = section_owner(source)
+            entry = sizes.setdefault(owner, dict.fromkeys(KINDS, 0))
+            entry[kind] += int(size, 16)
+
+    if not in_memory_map:
+        raise ValueError('{}: not a GNU linker map'.format(path))
+
+    return sizes
+
+
+def add_heap_usage(sizes, path):
+    owners = {normalize(owner): owner for owner in sizes}
+
+    with open(path) as f:
+        for line in f:
+            match = HEAP_USAGE.search(line)
+            if not match:
+                continue
+
+            name = normalize(match.group(1))
+            owner = owners.get(name, name)
+            entry = sizes.setdefault(owner, dict.fromkeys(KINDS, 0))
+            entry['heap'] = entry.get('heap', 0) + int(match.group(2))
+
+
+def totals(sizes):
+    total = {}
+    for entry in sizes.values():
+        for kind, size in entry.items():
+            total[kind] = total.get(kind, 0) + size
+    return total
+
+
+def size_of(entry, kind):
+    if kind in DERIVED_KINDS:
+        return sum(entry.get(k, 0) for k in DERIVED_KINDS[kind])
+    return entry.get(kind, 0)
+
+
+def print_report(sizes, has_heap):
+    columns = KINDS + list(DERIVED_KINDS) + (['heap'] if has_heap else [])
+    width = max([len(owner) for owner in sizes] + [len('total')])
+
+    print('{:<{}}'.format('module', width) +
+          ''.join('{:>10}'.format(column) for column in columns))
+
+    rows = sorted(sizes.items(), key=lambda item: -size_of(item[1], 'ram'))
+    rows.append(('total', totals(sizes)))
+    for owner, entry in rows:
+        print('{:<{}}'.format(owner, width) +
+              ''.join('{:>10}'.format(size_of(entry, column))
+                      for column in columns))
+
+
+def check_budgets(sizes, budgets):
+    total = totals(sizes)
+    status = 0
+
+    for budget in budgets:
+        match = BUDGET.match(budget)
+        if not match:
+            raise ValueError('invalid budget: {}'.format(budget))
+
+        owner, kind, limit = match.groups()
+        limit = int(limit, 0)
+        entry = total if owner == 'total' else sizes.get(owner, {})
+        size = size_of(entry, kind)
+
+        if size > limit:
+            print('error: {} {} is {} bytes, over its budget of {} bytes'
+                  .format(owner, kind, size, limit), file=sys.stderr)
+            status = 1
+
+    return status
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Report the memory footprint of a firmware per module.')
+    parser.add_argument('map', help='GNU linker map of the firmware')
+    parser.add_argument(
+        '--heap-log', metavar='LOG',
+        help='Firmware log holding the heap usage per module')
+    parser.add_argument(
+        '--budget', action='append', default=[], metavar='MODULE.KIND=BYTES',
+        help='Fail when the KIND (code, rodata, data, bss, rom, ram or heap) '
+             'of MODULE, or of the whole firmware when MODULE is "total", is '
+             'over BYTES')
+    args = parser.parse_args()
+
+    try:
+        sizes = parse_map(args.map)
+        if args.heap_log:
+            add_heap_usage(sizes, args.heap_log)
+
+        print_report(sizes, args.heap_log is not None)
+
+        return check_budgets(sizes, args.budget)
+    except (OSError, ValueError) as error:
+        print('error: {}'.format(error), file=sys.stderr)
+        return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())